@@ -36,6 +36,16 @@
 
 #define ARIEL_MAX_PAYLOAD_SIZE 64
 
+/*
+ * Size of the record area of an ARIEL_PERFORM_BATCH command. This is sized so
+ * that an ArielCommand is exactly two 64-byte cache lines, which keeps the
+ * slots of the tunnel buffers from sharing a line with their neighbours.
+ */
+#define ARIEL_BATCH_DATA_SIZE 104
+
+/* Largest encoded batch record: a header byte, a 10 byte address and a 5 byte size */
+#define ARIEL_BATCH_MAX_RECORD_SIZE 16
+
 namespace SST {
 namespace ArielComponent {
 
@@ -58,6 +68,24 @@ enum ArielShmemCmd_t {
     ARIEL_ISSUE_RTL = 150,
     ARIEL_FLUSHLINE_INSTRUCTION = 154,
     ARIEL_FENCE_INSTRUCTION = 155,
+    ARIEL_PERFORM_BATCH = 160,
+    ARIEL_END_OF_STREAM = 170,
+};
+
+/*
+ * Record types carried in an ARIEL_PERFORM_BATCH command. Each record starts
+ * with a header byte holding the type in bits 0-2 and, for reads and writes,
+ * log2 of the access size in bits 3-5 (7 means the size follows as a varint).
+ * Read and write addresses are zigzag varint deltas from the previous address
+ * in the same batch (the first one is relative to zero), start records carry
+ * the instruction class and SIMD element count as varints.
+ */
+enum ArielBatchRecord_t {
+    ARIEL_BATCH_START_INSTRUCTION = 0,
+    ARIEL_BATCH_READ = 1,
+    ARIEL_BATCH_WRITE = 2,
+    ARIEL_BATCH_END_INSTRUCTION = 3,
+    ARIEL_BATCH_NOOP = 4,
 };
 
 struct ArielCommand {
@@ -105,6 +133,11 @@ struct ArielCommand {
         struct {
             uint64_t vaddr;
         } flushline;
+        struct {
+            uint32_t count;
+            uint32_t length;
+            uint8_t  data[ARIEL_BATCH_DATA_SIZE];
+        } batch;
         struct {
             void* inp_ptr;
             void* ctrl_ptr;
@@ -116,6 +149,139 @@ struct ArielCommand {
     };
 };
 
+/*
+ * Builds and walks the record area of an ARIEL_PERFORM_BATCH command. The
+ * frontend keeps one batch per thread, appends records while hasSpace() holds
+ * and sends getCommand() once the batch is full. Ariel copies a received
+ * command into a batch and decodes the records back with next().
+ */
+class ArielCommandBatch {
+public:
+    ArielCommandBatch() : offset(0), lastAddr(0) {
+        reset();
+    }
+
+    ArielCommandBatch(const ArielCommand& batchCmd) : cmd(batchCmd), offset(0), lastAddr(0) { }
+
+    void reset() {
+        cmd.command = ARIEL_PERFORM_BATCH;
+        cmd.instPtr = 0;
+        cmd.batch.count = 0;
+        cmd.batch.length = 0;
+        offset = 0;
+        lastAddr = 0;
+    }
+
+    const ArielCommand& getCommand() const { return cmd; }
+
+    bool empty() const { return cmd.batch.count == 0; }
+
+    bool hasSpace() const {
+        return (cmd.batch.length + ARIEL_BATCH_MAX_RECORD_SIZE) <= ARIEL_BATCH_DATA_SIZE;
+    }
+
+    void addStart(uint32_t instClass, uint32_t simdElemCount) {
+        put(ARIEL_BATCH_START_INSTRUCTION);
+        putVarint(instClass);
+        putVarint(simdElemCount);
+        cmd.batch.count++;
+    }
+
+    void addEnd() {
+        put(ARIEL_BATCH_END_INSTRUCTION);
+        cmd.batch.count++;
+    }
+
+    void addNoOp() {
+        put(ARIEL_BATCH_NOOP);
+        cmd.batch.count++;
+    }
+
+    void addAccess(ArielBatchRecord_t type, uint64_t addr, uint32_t size) {
+        uint32_t sizeCode = 7;
+        for (uint32_t i = 0; i < 7; i++) {
+            if (size == (((uint32_t) 1) << i)) {
+                sizeCode = i;
+                break;
+            }
+        }
+
+        put((uint8_t) (type | (sizeCode << 3)));
+
+        /* zigzag so that small negative strides stay short */
+        const int64_t delta = (int64_t) (addr - lastAddr);
+        putVarint((((uint64_t) delta) << 1) ^ ((uint64_t) (delta >> 63)));
+        lastAddr = addr;
+
+        if (7 == sizeCode) {
+            putVarint(size);
+        }
+        cmd.batch.count++;
+    }
+
+    /* Decode the next record, returns false once all records have been read */
+    bool next(ArielBatchRecord_t* type, uint64_t* addr, uint32_t* size,
+              uint32_t* instClass, uint32_t* simdElemCount) {
+        if (offset >= cmd.batch.length) {
+            return false;
+        }
+
+        const uint8_t header = cmd.batch.data[offset++];
+        *type = (ArielBatchRecord_t) (header & 0x7);
+
+        switch (*type) {
+        case ARIEL_BATCH_START_INSTRUCTION:
+            *instClass = (uint32_t) getVarint();
+            *simdElemCount = (uint32_t) getVarint();
+            break;
+        case ARIEL_BATCH_READ:
+        case ARIEL_BATCH_WRITE:
+            {
+                const uint64_t zigzag = getVarint();
+                const uint64_t delta = (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+                lastAddr += delta;
+                *addr = lastAddr;
+
+                const uint32_t sizeCode = (header >> 3) & 0x7;
+                *size = (7 == sizeCode) ? (uint32_t) getVarint() : (((uint32_t) 1) << sizeCode);
+            }
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+private:
+    void put(uint8_t value) {
+        cmd.batch.data[cmd.batch.length++] = value;
+    }
+
+    void putVarint(uint64_t value) {
+        while (value >= 0x80) {
+            put((uint8_t) (value | 0x80));
+            value >>= 7;
+        }
+        put((uint8_t) value);
+    }
+
+    uint64_t getVarint() {
+        uint64_t value = 0;
+        uint32_t shift = 0;
+        uint8_t byte;
+        do {
+            byte = cmd.batch.data[offset++];
+            value |= ((uint64_t) (byte & 0x7f)) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        return value;
+    }
+
+    ArielCommand cmd;
+    uint32_t offset;
+    uint64_t lastAddr;
+};
+
 struct ArielSharedData {
     size_t numCores;
     uint64_t simTime;
@@ -0,0 +1,145 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_COMMAND_TRACE
+#define _H_SST_ARIEL_COMMAND_TRACE
+
+#include <climits>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "zlib.h"
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * A command trace holds the ArielCommands one core read from the tunnel, so
+ * that ariel.frontend.replay can feed them back without running the
+ * application. Each core has its own compressed file, <prefix>-<core>.cmdtrace.gz,
+ * that starts with a magic number, a version and the core id, followed by one
+ * record per command: the command, the instruction pointer, the length of the
+ * body and the body, which is the used part of the command union.
+ */
+#define ARIEL_CMD_TRACE_MAGIC   0x434c5241
+#define ARIEL_CMD_TRACE_VERSION 1
+
+static inline std::string arielCommandTracePath(const std::string& prefix, const uint32_t core) {
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s-%" PRIu32 ".cmdtrace.gz", prefix.c_str(), core);
+    return std::string(path);
+}
+
+static inline uint32_t arielCommandBodySize(const ArielCommand& ac) {
+    const uint32_t unionOffset = (uint32_t) (((const char*) &ac.inst) - ((const char*) &ac));
+
+    if(ARIEL_PERFORM_BATCH == ac.command) {
+        return (uint32_t) (2 * sizeof(uint32_t)) + ac.batch.length;
+    }
+    return (uint32_t) sizeof(ArielCommand) - unionOffset;
+}
+
+class ArielCommandTraceWriter {
+    public:
+        ArielCommandTraceWriter(const std::string& prefix, const uint32_t core) {
+            traceFile = gzopen(arielCommandTracePath(prefix, core).c_str(), "wb");
+
+            if(NULL != traceFile) {
+                const uint32_t header[3] = { ARIEL_CMD_TRACE_MAGIC, ARIEL_CMD_TRACE_VERSION, core };
+                gzwrite(traceFile, header, sizeof(header));
+            }
+        }
+
+        ~ArielCommandTraceWriter() {
+            if(NULL != traceFile) {
+                gzclose(traceFile);
+            }
+        }
+
+        bool isOpen() const { return NULL != traceFile; }
+
+        void write(const ArielCommand& ac) {
+            const uint32_t command = (uint32_t) ac.command;
+            const uint32_t bodySize = arielCommandBodySize(ac);
+
+            gzwrite(traceFile, &command, sizeof(command));
+            gzwrite(traceFile, &ac.instPtr, sizeof(ac.instPtr));
+            gzwrite(traceFile, &bodySize, sizeof(bodySize));
+            gzwrite(traceFile, &ac.inst, bodySize);
+        }
+
+    private:
+        gzFile traceFile;
+};
+
+class ArielCommandTraceReader {
+    public:
+        ArielCommandTraceReader(const std::string& prefix, const uint32_t core, const uint32_t bufferSize) :
+            path(arielCommandTracePath(prefix, core)), valid(false) {
+
+            traceFile = gzopen(path.c_str(), "rb");
+
+            if(NULL != traceFile) {
+                // A large buffer lets each gzread decompress well ahead of the replay
+                gzbuffer(traceFile, bufferSize);
+
+                uint32_t header[3];
+                valid = (gzread(traceFile, header, sizeof(header)) == (int) sizeof(header)) &&
+                    (ARIEL_CMD_TRACE_MAGIC == header[0]) && (ARIEL_CMD_TRACE_VERSION == header[1]) &&
+                    (core == header[2]);
+            }
+        }
+
+        ~ArielCommandTraceReader() {
+            if(NULL != traceFile) {
+                gzclose(traceFile);
+            }
+        }
+
+        bool isValid() const { return valid; }
+        const std::string& getPath() const { return path; }
+
+        /* Read the next command, returns false at the end of the trace */
+        bool read(ArielCommand* ac) {
+            const uint32_t maxBodySize = (uint32_t) (sizeof(ArielCommand) - (((char*) &ac->inst) - ((char*) ac)));
+            uint32_t command;
+            uint32_t bodySize;
+
+            if(gzread(traceFile, &command, sizeof(command)) != (int) sizeof(command) ||
+               gzread(traceFile, &ac->instPtr, sizeof(ac->instPtr)) != (int) sizeof(ac->instPtr) ||
+               gzread(traceFile, &bodySize, sizeof(bodySize)) != (int) sizeof(bodySize) ||
+               bodySize > maxBodySize ||
+               gzread(traceFile, &ac->inst, bodySize) != (int) bodySize) {
+                return false;
+            }
+
+            ac->command = (ArielShmemCmd_t) command;
+            return true;
+        }
+
+    private:
+        std::string path;
+        gzFile traceFile;
+        bool valid;
+};
+
+}
+}
+
+#endif
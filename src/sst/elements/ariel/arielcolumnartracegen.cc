@@ -0,0 +1,53 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+#include <sst_config.h>
+
+#include "arielcolumnartracegen.h"
+
+using namespace SST::ArielComponent;
+
+ArielColumnarTraceGenerator::ArielColumnarTraceGenerator(Params& params) :
+    ArielTraceGenerator() {
+
+    tracePrefix = params.find<std::string>("trace_prefix", "ariel-core");
+    blockRecords = params.find<uint32_t>("block_records", 65536);
+    traceFile = NULL;
+    coreID = 0;
+}
+
+ArielColumnarTraceGenerator::~ArielColumnarTraceGenerator() {
+    // Closing the trace writes its last block and the block index
+    delete traceFile;
+}
+
+void ArielColumnarTraceGenerator::publishEntry(const uint64_t picoS,
+    const uint64_t physAddr, const uint32_t reqLength,
+    const ArielTraceEntryOperation op) {
+
+    traceFile->addRecord(picoS, physAddr, reqLength,
+            (op == READ) ? COLUMNAR_TRACE_OP_READ : COLUMNAR_TRACE_OP_WRITE, coreID);
+}
+
+void ArielColumnarTraceGenerator::setCoreID(const uint32_t core) {
+    coreID = core;
+
+    size_t size = sizeof(char) * PATH_MAX;
+    char* tracePath = (char*) malloc(size);
+    snprintf(tracePath, size, "%s-%" PRIu32 ".ctrace", tracePrefix.c_str(), core);
+
+    traceFile = new SST::Prospero::ColumnarTraceWriter(tracePath, blockRecords);
+
+    free(tracePath);
+}
@@ -40,6 +40,8 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     output->verbose(CALL_INFO, 2, 0, "Creating core with ID %" PRIu32 ", maximum queue length=%" PRIu32 ", max issue is: %" PRIu32 "\n", thisCoreID, maxQLen, maxIssuePerCyc);
     inst_count = 0;
     coreID = thisCoreID;
+    tunnelCoreID = thisCoreID;
+    addressTag = 0;
     maxPendingTransactions = maxPendTrans;
     isHalted = false;
     isStalled = false;
@@ -107,6 +109,27 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
         traceGen->setCoreID(coreID);
     }
 
+    blockingReads = false;
+    streamEnded = false;
+    memProfile = NULL;
+
+    std::string capturePrefix = params.find<std::string>("capturetrace", "");
+#ifdef HAVE_LIBZ
+    captureTrace = NULL;
+    if("" != capturePrefix) {
+        captureTrace = new ArielCommandTraceWriter(capturePrefix, coreID);
+
+        if(!captureTrace->isOpen()) {
+            output->fatal(CALL_INFO, -1, "Unable to open command trace %s for writing\n",
+                    arielCommandTracePath(capturePrefix, coreID).c_str());
+        }
+    }
+#else
+    if("" != capturePrefix) {
+        output->fatal(CALL_INFO, -1, "Capturing a command trace (capturetrace) requires SST to be built with libz\n");
+    }
+#endif
+
     currentCycles = 0;
 }
 
@@ -119,6 +142,10 @@ ArielCore::~ArielCore() {
         delete traceGen;
     }
 
+#ifdef HAVE_LIBZ
+    delete captureTrace;
+#endif
+
     delete stdMemHandlers;
 }
 
@@ -144,12 +171,12 @@ void ArielCore::printTraceEntry(const bool isRead,
 }
 
 void ArielCore::commitReadEvent(const uint64_t address,
-            const uint64_t virtAddress, const uint32_t length) {
+            const uint64_t virtAddress, const uint32_t length, const uint64_t instPtr) {
     if(length > 0) {
         StandardMem::Read *req = new StandardMem::Read(address, length, 0, virtAddress);
 
         pending_transaction_count++;
-        pendingTransactions->insert( std::pair<StandardMem::Request::id_t, RequestInfo>(req->getID(), {req, getCurrentSimTime(timeconverter)}) );
+        pendingTransactions->insert( std::pair<StandardMem::Request::id_t, RequestInfo>(req->getID(), {req, getCurrentSimTime(timeconverter), instPtr, virtAddress}) );
 
         if(enableTracing) {
             printTraceEntry(true, (const uint64_t) req->pAddr, (const uint32_t) length);
@@ -161,7 +188,7 @@ void ArielCore::commitReadEvent(const uint64_t address,
 }
 
 void ArielCore::commitWriteEvent(const uint64_t address,
-        const uint64_t virtAddress, const uint32_t length, const uint8_t* payload) {
+        const uint64_t virtAddress, const uint32_t length, const uint8_t* payload, const uint64_t instPtr) {
 
     if(length > 0) {
         std::vector<uint8_t> data;
@@ -189,7 +216,7 @@ void ArielCore::commitWriteEvent(const uint64_t address,
         StandardMem::Write *req = new StandardMem::Write(address, length, data, false, 0, virtAddress);
 
         pending_transaction_count++;
-        pendingTransactions->insert( std::pair<StandardMem::Request::id_t, RequestInfo>(req->getID(), {req, getCurrentSimTime(timeconverter)}) );
+        pendingTransactions->insert( std::pair<StandardMem::Request::id_t, RequestInfo>(req->getID(), {req, getCurrentSimTime(timeconverter), instPtr, virtAddress}) );
 
         if(enableTracing) {
             printTraceEntry(false, (const uint64_t) req->pAddr, (const uint32_t) length);
@@ -211,7 +238,7 @@ void ArielCore::commitFlushEvent(const uint64_t address,
         /*  Todo: should the request specify the physical address, or the virtual address? */
         StandardMem::Request *req = new StandardMem::FlushAddr( address, length, true, std::numeric_limits<uint32_t>::max());
         pending_transaction_count++;
-        pendingTransactions->insert( std::pair<StandardMem::Request::id_t, RequestInfo>(req->getID(), {req, getCurrentSimTime(timeconverter)}) );
+        pendingTransactions->insert( std::pair<StandardMem::Request::id_t, RequestInfo>(req->getID(), {req, getCurrentSimTime(timeconverter), 0, virtAddress}) );
 
         cacheLink->send(req);
         statFlushRequests->addData(1);
@@ -224,10 +251,13 @@ void ArielCore::handleEvent(StandardMem::Request* event) {
     auto find_entry = pendingTransactions->find(mev_id);
 
     if(find_entry != pendingTransactions->end()) {
+        const uint64_t latency = getCurrentSimTime(timeconverter) - find_entry->second.start;
         if (dynamic_cast<StandardMem::ReadResp*>(event)) {
-            statReadLatency->addData(getCurrentSimTime(timeconverter) - find_entry->second.start);
+            statReadLatency->addData(latency);
+            if (memProfile) memProfile->recordAccess(find_entry->second.instPtr, find_entry->second.virtAddr, false, latency);
         } else if (dynamic_cast<StandardMem::WriteResp*>(event)) {
-            statWriteLatency->addData(getCurrentSimTime(timeconverter) - find_entry->second.start);
+            statWriteLatency->addData(latency);
+            if (memProfile) memProfile->recordAccess(find_entry->second.instPtr, find_entry->second.virtAddr, true, latency);
         }
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Correctly identified event in pending transactions, removing from list, before there are: %" PRIu32 " transactions pending.\n",
                             (uint32_t) pendingTransactions->size()));
@@ -265,6 +295,12 @@ void ArielCore::finishCore() {
         delete traceGen;
         traceGen = NULL;
     }
+
+#ifdef HAVE_LIBZ
+    // Close the command trace so everything captured is flushed
+    delete captureTrace;
+    captureTrace = NULL;
+#endif
 }
 
 void ArielCore::halt(){
@@ -312,15 +348,15 @@ void ArielCore::createNoOpEvent() {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a No Op event on core %" PRIu32 "\n", coreID));
 }
 
-void ArielCore::createReadEvent(uint64_t address, uint32_t length) {
-    ArielReadEvent* ev = new ArielReadEvent(address, length);
+void ArielCore::createReadEvent(uint64_t address, uint32_t length, uint64_t instPtr) {
+    ArielReadEvent* ev = new ArielReadEvent(address | addressTag, length, instPtr);
     coreQ->push(ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a READ event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
-    ArielAllocateEvent* ev = new ArielAllocateEvent(vAddr, length, level, instPtr);
+    ArielAllocateEvent* ev = new ArielAllocateEvent(vAddr | addressTag, length, level, instPtr);
     coreQ->push(ev);
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an allocate event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
@@ -328,7 +364,7 @@ void ArielCore::createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t le
 }
 
 void ArielCore::createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
-    ArielMmapEvent* ev = new ArielMmapEvent(fileID, vAddr, length, level, instPtr);
+    ArielMmapEvent* ev = new ArielMmapEvent(fileID, vAddr | addressTag, length, level, instPtr);
     coreQ->push(ev);
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an mmap event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
@@ -336,21 +372,21 @@ void ArielCore::createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length
 }
 
 void ArielCore::createFreeEvent(uint64_t vAddr) {
-    ArielFreeEvent* ev = new ArielFreeEvent(vAddr);
+    ArielFreeEvent* ev = new ArielFreeEvent(vAddr | addressTag);
     coreQ->push(ev);
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated a free event for virtual address=%" PRIu64 "\n", vAddr));
 }
 
-void ArielCore::createWriteEvent(uint64_t address, uint32_t length, const uint8_t* payload) {
-    ArielWriteEvent* ev = new ArielWriteEvent(address, length, payload);
+void ArielCore::createWriteEvent(uint64_t address, uint32_t length, const uint8_t* payload, uint64_t instPtr) {
+    ArielWriteEvent* ev = new ArielWriteEvent(address | addressTag, length, payload, instPtr);
     coreQ->push(ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a WRITE event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createFlushEvent(uint64_t vAddr){
-    ArielFlushEvent *ev = new ArielFlushEvent(vAddr, cacheLineSize);
+    ArielFlushEvent *ev = new ArielFlushEvent(vAddr | addressTag, cacheLineSize);
     coreQ->push(ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO,4,0, "Generated a FLUSH event.\n"));
@@ -404,15 +440,60 @@ bool ArielCore::hasDrainCompleted() const {
         return false;
 }
 
+void ArielCore::countInstruction(const uint32_t instClass, const uint32_t simdElemCount) {
+    if(ARIEL_INST_SP_FP == instClass) {
+        statFPSPIns->addData(1);
+
+        if(simdElemCount > 1) {
+            statFPSPSIMDIns->addData(1);
+        } else {
+            statFPSPScalarIns->addData(1);
+        }
+
+        if(simdElemCount < 32)
+            statFPSPOps->addData(simdElemCount);
+    } else if(ARIEL_INST_DP_FP == instClass) {
+        statFPDPIns->addData(1);
+
+        if(simdElemCount > 1) {
+            statFPDPSIMDIns->addData(1);
+        } else {
+            statFPDPScalarIns->addData(1);
+        }
+
+        if(simdElemCount < 16)
+            statFPDPOps->addData(simdElemCount);
+    }
+}
+
+bool ArielCore::readCommand(ArielCommand* ac, const bool wait) {
+    if(wait || blockingReads) {
+        *ac = tunnel->readMessage(tunnelCoreID);
+    } else if(!tunnel->readMessageNB(tunnelCoreID, ac)) {
+        return false;
+    }
+
+#ifdef HAVE_LIBZ
+    if(NULL != captureTrace && ARIEL_END_OF_STREAM != ac->command) {
+        captureTrace->write(*ac);
+    }
+#endif
+    return true;
+}
+
 bool ArielCore::refillQueue() {
     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Refilling event queue for core %" PRIu32 "...\n", coreID));
 
+    if(streamEnded) {
+        return false;
+    }
+
     while(coreQ->size() < maxQLength) {
         ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Attempting to fill events for core: %" PRIu32 " current queue size=%" PRIu32 ", max length=%" PRIu32 "\n",
                             coreID, (uint32_t) coreQ->size(), (uint32_t) maxQLength));
 
         ArielCommand ac;
-        const bool avail = tunnel->readMessageNB(coreID, &ac);
+        const bool avail = readCommand(&ac, false);
 
         if ( !avail ) {
                 ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Tunnel claims no data on core: %" PRIu32 "\n", coreID));
@@ -429,40 +510,18 @@ bool ArielCore::refillQueue() {
                 break;
 
             case ARIEL_START_INSTRUCTION:
-                if(ARIEL_INST_SP_FP == ac.inst.instClass) {
-                        statFPSPIns->addData(1);
-
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPSPSIMDIns->addData(1);
-                        } else {
-                            statFPSPScalarIns->addData(1);
-                        }
-
-                        if(ac.inst.simdElemCount < 32)
-                            statFPSPOps->addData(ac.inst.simdElemCount);
-                } else if(ARIEL_INST_DP_FP == ac.inst.instClass) {
-                        statFPDPIns->addData(1);
-
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPDPSIMDIns->addData(1);
-                        } else {
-                            statFPDPScalarIns->addData(1);
-                        }
-
-                        if(ac.inst.simdElemCount < 16)
-                            statFPDPOps->addData(ac.inst.simdElemCount);
-                }
+                countInstruction(ac.inst.instClass, ac.inst.simdElemCount);
 
                 while(ac.command != ARIEL_END_INSTRUCTION) {
-                        ac = tunnel->readMessage(coreID);
+                        readCommand(&ac, true);
 
                         switch(ac.command) {
                             case ARIEL_PERFORM_READ:
-                                    createReadEvent(ac.inst.addr, ac.inst.size);
+                                    createReadEvent(ac.inst.addr, ac.inst.size, ac.instPtr);
                                     break;
 
                             case ARIEL_PERFORM_WRITE:
-                                    createWriteEvent(ac.inst.addr, ac.inst.size, &ac.inst.payload[0]);
+                                    createWriteEvent(ac.inst.addr, ac.inst.size, &ac.inst.payload[0], ac.instPtr);
                                     break;
 
                             case ARIEL_END_INSTRUCTION:
@@ -480,6 +539,10 @@ bool ArielCore::refillQueue() {
 
                 break;
 
+            case ARIEL_PERFORM_BATCH:
+                refillFromBatch(&ac);
+                break;
+
             case ARIEL_NOOP:
                 createNoOpEvent();
                 break;
@@ -512,6 +575,11 @@ bool ArielCore::refillQueue() {
                 createExitEvent();
                 break;
 
+            case ARIEL_END_OF_STREAM:
+                ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Core %" PRIu32 " reached the end of its command stream\n", coreID));
+                streamEnded = true;
+                return false;
+
             case ARIEL_ISSUE_RTL:
                 createRtlEvent(ac.shmem.inp_ptr, ac.shmem.ctrl_ptr, ac.shmem.updated_rtl_params, ac.shmem.inp_size, ac.shmem.ctrl_size, ac.shmem.updated_rtl_params_size);
                 break;
@@ -527,10 +595,46 @@ bool ArielCore::refillQueue() {
     return true;
 }
 
+void ArielCore::refillFromBatch(ArielCommand* ac) {
+    ArielCommandBatch batch(*ac);
+    ArielBatchRecord_t type;
+    uint64_t addr = 0;
+    uint32_t size = 0;
+    uint32_t instClass = 0;
+    uint32_t simdElemCount = 0;
+
+    ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Core %" PRIu32 " unpacking a batch of %" PRIu32 " records\n", coreID, ac->batch.count));
+
+    while(batch.next(&type, &addr, &size, &instClass, &simdElemCount)) {
+        switch(type) {
+            case ARIEL_BATCH_START_INSTRUCTION:
+                countInstruction(instClass, simdElemCount);
+                break;
+
+            case ARIEL_BATCH_READ:
+                createReadEvent(addr, size);
+                break;
+
+            case ARIEL_BATCH_WRITE:
+                // Batched writes never carry a payload
+                createWriteEvent(addr, size, NULL);
+                break;
+
+            case ARIEL_BATCH_END_INSTRUCTION:
+                break;
+
+            case ARIEL_BATCH_NOOP:
+                createNoOpEvent();
+                break;
+        }
+    }
+}
+
 void ArielCore::handleFreeEvent(ArielFreeEvent* rFE) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a free event (for virtual address=%" PRIu64 ")\n", coreID, rFE->getVirtualAddress()));
 
     memmgr->freeMalloc(rFE->getVirtualAddress());
+    if (memProfile) memProfile->recordFree(rFE->getVirtualAddress());
 }
 
 void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
@@ -562,7 +666,7 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " issuing read, VAddr=%" PRIu64 ", Size=%" PRIu64 ", PhysAddr=%" PRIu64 "\n",
                             coreID, readAddress, readLength, physAddr));
 
-        commitReadEvent(physAddr, readAddress, (uint32_t) readLength);
+        commitReadEvent(physAddr, readAddress, (uint32_t) readLength, rEv->getInstructionPointer());
     } else {
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " generating a split read request: Addr=%" PRIu64 " Length=%" PRIu64 "\n",
                             coreID, readAddress, readLength));
@@ -597,8 +701,8 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
                 }*/
         }
 
-        commitReadEvent(physLeftAddr, leftAddr, (uint32_t) leftSize);
-        commitReadEvent(physRightAddr, rightAddr, (uint32_t) rightSize);
+        commitReadEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, rEv->getInstructionPointer());
+        commitReadEvent(physRightAddr, rightAddr, (uint32_t) rightSize, rEv->getInstructionPointer());
 
         statSplitReadRequests->addData(1);
     }
@@ -635,9 +739,9 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
 
         if( writePayloads ) {
             uint8_t* payloadPtr = wEv->getPayload();
-            commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, payloadPtr);
+            commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, payloadPtr, wEv->getInstructionPointer());
         } else {
-            commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, NULL);
+            commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, NULL, wEv->getInstructionPointer());
         }
     } else {
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " generating a split write request: Addr=%" PRIu64 " Length=%" PRIu64 "\n",
@@ -675,11 +779,11 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
 
         if( writePayloads ) {
             uint8_t* payloadPtr = wEv->getPayload();
-            commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, payloadPtr);
-            commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, &payloadPtr[leftSize]);
+            commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, payloadPtr, wEv->getInstructionPointer());
+            commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, &payloadPtr[leftSize], wEv->getInstructionPointer());
         } else {
-            commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, NULL);
-            commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, NULL);
+            commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, NULL, wEv->getInstructionPointer());
+            commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, NULL, wEv->getInstructionPointer());
         }
         statSplitWriteRequests->addData(1);
     }
@@ -700,6 +804,7 @@ void ArielCore::handleAllocationEvent(ArielAllocateEvent* aEv) {
                 aEv->getVirtualAddress(), aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getInstructionPointer());
 
     memmgr->allocateMalloc(aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getVirtualAddress(), aEv->getInstructionPointer(), coreID);
+    if (memProfile) memProfile->recordMalloc(aEv->getVirtualAddress(), aEv->getAllocationLength(), aEv->getInstructionPointer());
 }
 
 void ArielCore::handleFlushEvent(ArielFlushEvent *flEv) {
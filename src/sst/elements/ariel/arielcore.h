@@ -47,18 +47,27 @@
 #include "arielfenceev.h"
 #include "arielswitchpool.h"
 #include "arielrtlev.h"
+#include "arielmemprofile.h"
 #include "tb_header.h"
 
 #include "ariel_shmem.h"
 #include "arieltracegen.h"
+#ifdef HAVE_LIBZ
+#include "arielcmdtrace.h"
+#endif
 
 using namespace SST;
 using namespace SST::Interfaces;
 using namespace SST::ArielComponent;
 
+// x86-64 user space addresses fit in 47 bits, the traced rank goes above them
+#define ARIEL_RANK_ADDRESS_SHIFT 48
+
 struct RequestInfo {
         StandardMem::Request *req;
         uint64_t start;
+        uint64_t instPtr;   // For the memory profile
+        uint64_t virtAddr;
 };
 
 namespace SST {
@@ -85,8 +94,8 @@ class ArielCore : public ComponentExtension {
         void fence();
         void unfence();
         void finishCore();
-        void createReadEvent(uint64_t addr, uint32_t size);
-        void createWriteEvent(uint64_t addr, uint32_t size, const uint8_t* payload);
+        void createReadEvent(uint64_t addr, uint32_t size, uint64_t instPtr = 0);
+        void createWriteEvent(uint64_t addr, uint32_t size, const uint8_t* payload, uint64_t instPtr = 0);
         void createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t level, uint64_t ip);
         void createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr);
         void createNoOpEvent();
@@ -106,6 +115,17 @@ class ArielCore : public ComponentExtension {
       }
 
         void setCacheLink(StandardMem* newCacheLink);
+        void setBlockingReads(bool blocking) { blockingReads = blocking; }
+        void setMemoryProfile(ArielMemoryProfile* profile) { memProfile = profile; }
+
+        /** Place this core in one of several traced ranks: its commands come from
+         * core tunnelCore of the rank's tunnel and its virtual addresses are tagged
+         * with the rank, so a shared memory manager maps each rank's pages apart.
+         */
+        void setRank(uint32_t rank, uint32_t tunnelCore) {
+            tunnelCoreID = tunnelCore;
+            addressTag = ((uint64_t) rank) << ARIEL_RANK_ADDRESS_SHIFT;
+        }
         void createRtlEvent(void*, void*, void*, size_t, size_t, size_t);
         void setRtlLink(Link* rtllink);
 
@@ -135,8 +155,8 @@ class ArielCore : public ComponentExtension {
         // interrupt handlers
         bool handleInterrupt(ArielMemoryManager::InterruptAction action);
 
-        void commitReadEvent(const uint64_t address, const uint64_t virtAddr, const uint32_t length);
-        void commitWriteEvent(const uint64_t address, const uint64_t virtAddr, const uint32_t length, const uint8_t* payload);
+        void commitReadEvent(const uint64_t address, const uint64_t virtAddr, const uint32_t length, const uint64_t instPtr = 0);
+        void commitWriteEvent(const uint64_t address, const uint64_t virtAddr, const uint32_t length, const uint8_t* payload, const uint64_t instPtr = 0);
         void commitFlushEvent(const uint64_t address, const uint64_t virtAddr, const uint32_t length);
 
         // Setting the max number of instructions to be simulated
@@ -148,8 +168,13 @@ class ArielCore : public ComponentExtension {
     private:
         bool processNextEvent();
         bool refillQueue();
+        bool readCommand(ArielCommand* ac, const bool wait);
+        void refillFromBatch(ArielCommand* ac);
+        void countInstruction(const uint32_t instClass, const uint32_t simdElemCount);
         bool writePayloads;
         uint32_t coreID;
+        uint32_t tunnelCoreID; // Core index in the tunnel, coreID unless several ranks are traced
+        uint64_t addressTag;   // Rank in the bits above the traced process's virtual addresses
         uint32_t maxPendingTransactions;
 
         Output* output;
@@ -185,6 +210,16 @@ class ArielCore : public ComponentExtension {
 
         ArielTraceGenerator* traceGen;
 
+        // Per-instruction and per-malloc-site memory profile shared by all cores, NULL when off
+        ArielMemoryProfile* memProfile;
+
+        // Wait on an empty tunnel instead of idling, until the frontend ends the stream
+        bool blockingReads;
+        bool streamEnded;
+#ifdef HAVE_LIBZ
+        ArielCommandTraceWriter* captureTrace;
+#endif
+
         Statistic<uint64_t>* statReadRequests;
         Statistic<uint64_t>* statWriteRequests;
         Statistic<uint64_t>* statReadLatency;
@@ -45,6 +45,15 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
     uint32_t perform_checks = (uint32_t) params.find<uint32_t>("checkaddresses", 0);
     output->verbose(CALL_INFO, 1, 0, "Configuring for check addresses = %s\n", (perform_checks > 0) ? "yes" : "no");
 
+    memProfile = NULL;
+    std::string profileFile = params.find<std::string>("profilememory", "");
+    if (profileFile != "") {
+        uint64_t missLatency = params.find<uint64_t>("profilemisslatency", 10);
+        output->verbose(CALL_INFO, 1, 0, "Writing a memory profile to %s, counting requests slower than %" PRIu64 " cycles as misses\n",
+                profileFile.c_str(), missLatency);
+        memProfile = new ArielMemoryProfile(output, profileFile, missLatency);
+    }
+
 /** This section of code preserves backward compability from the old memorymanager parameters to the new subcomponent structure. */
     // Warn about the parameters that have moved to the subcomponent
     bool found;
@@ -151,7 +160,17 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
     if (!frontend)
         output->fatal(CALL_INFO, -1, "%s, Error: Loading frontend subcomponent failed. If Ariel was not built with Pin, user must supply a custom frontend in the input file.\n", getName().c_str());
 
-    tunnel = frontend->getTunnel();
+    // Each traced rank has its own tunnel and core_count cores, the cores of all ranks are numbered in turn
+    const uint32_t rank_core_count = core_count;
+    rank_count = frontend->getTracedRankCount();
+    for (uint32_t i = 0; i < rank_count; i++) {
+        tunnels.push_back(frontend->getRankTunnel(i));
+    }
+    core_count = rank_core_count * rank_count;
+
+    if (rank_count > 1) {
+        output->verbose(CALL_INFO, 1, 0, "Tracing %" PRIu32 " ranks, %" PRIu32 " cores in total\n", rank_count, core_count);
+    }
 
     /////////////////////////////////////////////////////////////////////////////////////
 
@@ -168,12 +187,18 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
 
     output->verbose(CALL_INFO, 1, 0, "Configuring cores and cache links...\n");
     for(uint32_t i = 0; i < core_count; ++i) {
-        cpu_cores.push_back(loadComponentExtension<ArielCore>(tunnel,
+        cpu_cores.push_back(loadComponentExtension<ArielCore>(tunnels[i / rank_core_count],
                  i, maxPendingTransCore, output, maxIssuesPerCycle, maxCoreQueueLen,
                  cacheLineSize, memmgr, perform_checks, params, timeconverter));
 
+        if (rank_count > 1) {
+            cpu_cores[i]->setRank(i / rank_core_count, i % rank_core_count);
+        }
+
         // Set max number of instructions
         cpu_cores[i]->setMaxInsts(max_insts);
+        cpu_cores[i]->setBlockingReads(frontend->blockingReads());
+        cpu_cores[i]->setMemoryProfile(memProfile);
     }
 
     // Find all the components loaded into the "memory" slot
@@ -243,23 +268,48 @@ void ArielCPU::finish() {
 
     memmgr->printStats();
     frontend->finish();
+
+    if (memProfile) {
+        memProfile->write();
+    }
 }
 
 bool ArielCPU::tick( SST::Cycle_t cycle) {
     stopTicking = false;
     output->verbose(CALL_INFO, 16, 0, "Main processor tick, will issue to individual cores...\n");
 
-    tunnel->updateTime(getCurrentSimTimeNano());
-    tunnel->incrementCycles();
+    for (uint32_t i = 0; i < rank_count; i++) {
+        tunnels[i]->updateTime(getCurrentSimTimeNano());
+        tunnels[i]->incrementCycles();
+    }
 
     // Keep ticking unless one of the cores says it is time to stop.
-    for(uint32_t i = 0; i < core_count; ++i) {
-        cpu_cores[i]->tick();
-
-        if(cpu_cores[i]->isCoreHalted()) {
-                stopTicking = true;
-                break;
+    if (1 == rank_count) {
+        for(uint32_t i = 0; i < core_count; ++i) {
+            cpu_cores[i]->tick();
+
+            if(cpu_cores[i]->isCoreHalted()) {
+                    stopTicking = true;
+                    break;
+            }
         }
+    } else {
+        // Ranks exit at different times, stop once a core of every rank has halted
+        const uint32_t rank_core_count = core_count / rank_count;
+        uint32_t ranks_halted = 0;
+
+        for (uint32_t r = 0; r < rank_count; r++) {
+            bool rank_halted = false;
+            for (uint32_t i = r * rank_core_count; i < (r + 1) * rank_core_count; i++) {
+                if (!cpu_cores[i]->isCoreHalted()) {
+                    cpu_cores[i]->tick();
+                }
+                rank_halted = rank_halted || cpu_cores[i]->isCoreHalted();
+            }
+            ranks_halted += rank_halted ? 1 : 0;
+        }
+
+        stopTicking = (ranks_halted == rank_count);
     }
 
     // Its time to end, that's all folks
@@ -270,7 +320,9 @@ bool ArielCPU::tick( SST::Cycle_t cycle) {
     return stopTicking;
 }
 
-ArielCPU::~ArielCPU() { }
+ArielCPU::~ArielCPU() {
+    delete memProfile;
+}
 
 void ArielCPU::emergencyShutdown() {
     /* Ask the cores to finish up.  This should flush logging */
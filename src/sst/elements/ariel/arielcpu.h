@@ -46,8 +46,10 @@ class ArielCPU : public SST::Component {
     SST_ELI_DOCUMENT_PARAMS(
         {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
         {"profilefunctions", "Profile functions for Ariel execution, 0 = none, >0 = enable", "0" },
+        {"profilememory", "Write a binary per-instruction and per-malloc-site memory profile (request counts, misses, latency) to this file, empty disables. Turns off batchmemoryops, since batched records carry no instruction pointer", ""},
+        {"profilemisslatency", "Memory profile: requests that take more than this many cycles count as cache misses", "10"},
         {"corecount", "Number of CPU cores to emulate", "1"},
-        {"frontend", "Specify an ariel frontend to use, set to ariel.frontend.pin for PIN3 (default), set to ariel.frontend.epa for PEBIL or EPAX", "ariel.frontend.pin"},
+        {"frontend", "Specify an ariel frontend to use, set to ariel.frontend.pin for PIN3 (default), set to ariel.frontend.epa for PEBIL or EPAX, set to ariel.frontend.replay to replay a captured command trace", "ariel.frontend.pin"},
         {"checkaddresses", "Verify that addresses are valid with respect to cache lines", "0"},
         {"maxissuepercycle", "Maximum number of requests to issue per cycle, per core", "1"},
         {"maxcorequeue", "Maximum queue depth per core", "64"},
@@ -68,6 +70,7 @@ class ArielCPU : public SST::Component {
         {"mpilauncher", "Specify a launcher to be used for MPI executables in conjuction with <launcher>", STRINGIZE(MPILAUNCHER_EXECUTABLE)},
         {"mpiranks", "Number of ranks to be launched by <mpilauncher>. Only <mpitracerank> will be traced by <launcher>.", "1" },
         {"mpitracerank", "Rank to be traced by <launcher>.", "0" },
+        {"mpitraceranks", "Number of consecutive ranks, starting at <mpitracerank>, to be traced by <launcher>. Each traced rank gets <corecount> cores, numbered after those of the previous rank, and they share the memory manager.", "1" },
         {"envparamcount", "Number of environment parameters to supply to the Ariel executable, default=-1 (use SST environment)", "-1"},
         {"envparamname%(envparamcount)d", "Sets the environment parameter name", ""},
         {"envparamval%(envparamcount)d", "Sets the environment parameter value", ""},
@@ -80,11 +83,13 @@ class ArielCPU : public SST::Component {
         {"tracePrefix", "Prefix when tracing is enable", ""},
         {"clock", "Clock rate at which events are generated and processed", "1GHz"},
         {"tracegen", "Select the trace generator for Ariel (which records traced memory operations", ""},
+        {"capturetrace", "Prefix of the per-core command traces (prefix-core.cmdtrace.gz) to capture for ariel.frontend.replay, empty disables capture. Requires libz", ""},
         {"memmgr", "Memory manager to use for address translation", "ariel.MemoryManagerSimple"},
         {"writepayloadtrace", "Trace write payloads and put real memory contents into the memory system", "0"},
-        {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"})
+        {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"},
+        {"batchmemoryops", "Batch memory operations into compact records in the tunnel instead of one command each, ignored when writepayloadtrace is set", "1"})
 
-    SST_ELI_DOCUMENT_PORTS( {"cache_link_%(corecount)d", "Each core's link to its cache", {}},
+    SST_ELI_DOCUMENT_PORTS( {"cache_link_%(corecount)d", "Each core's link to its cache, core c of traced rank r is corecount*r+c", {}},
        {"rtl_link_%(corecount)d", "Each core's link to the RTL", {}})
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -135,9 +140,11 @@ class ArielCPU : public SST::Component {
         std::vector<SST::Link*> cpu_to_rtl_links;
 
         uint32_t core_count;
+        uint32_t rank_count;
 
         ArielFrontend* frontend;
-        ArielTunnel* tunnel;
+        std::vector<ArielTunnel*> tunnels; // One per traced rank
+        ArielMemoryProfile* memProfile;   // NULL unless profilememory is set
         bool stopTicking;
 };
 
@@ -48,6 +48,18 @@ public:
 
     virtual ArielTunnel* getTunnel() = 0;
 
+    /** Number of processes traced, each through its own tunnel with
+     * coreCount cores. Frontends tracing a single process return 1.
+     */
+    virtual uint32_t getTracedRankCount() { return 1; }
+    virtual ArielTunnel* getRankTunnel(uint32_t rank) { return getTunnel(); }
+
+    /** True if the cores should wait for the next command when the tunnel is
+     * empty. A frontend that returns true ends every core's stream with
+     * ARIEL_END_OF_STREAM.
+     */
+    virtual bool blockingReads() { return false; }
+
     virtual void init(unsigned int phase) = 0;
     virtual void setup() { }
     virtual void finish() { }
@@ -59,6 +59,14 @@ ArielTunnel* ArielFrontendCommon::getTunnel() {
     return tunnel;
 }
 
+uint32_t ArielFrontendCommon::getTracedRankCount() {
+    return rank_tunnels.empty() ? 1 : rank_tunnels.size();
+}
+
+ArielTunnel* ArielFrontendCommon::getRankTunnel(uint32_t rank) {
+    return rank_tunnels.empty() ? tunnel : rank_tunnels[rank];
+}
+
 void ArielFrontendCommon::init(unsigned int phase)
 {
     if ( phase == 0 ) {
@@ -69,7 +77,13 @@ void ArielFrontendCommon::init(unsigned int phase)
         child_pid = forkChildProcess(app_name.c_str(), execute_args,
             execute_env, redirect_info);
         output->verbose(CALL_INFO, 1, 0, "Waiting for child to attach.\n");
-        tunnel->waitForChild();
+        if (rank_tunnels.empty()) {
+            tunnel->waitForChild();
+        } else {
+            for (uint32_t i = 0; i < rank_tunnels.size(); i++) {
+                rank_tunnels[i]->waitForChild();
+            }
+        }
         output->verbose(CALL_INFO, 1, 0, "Child has attached!\n");
     }
 }
@@ -105,6 +119,7 @@ void ArielFrontendCommon::parseCommonSubComponentParams(Params& params) {
     mpilauncher = params.find<std::string>("mpilauncher",  ARIEL_STRINGIZE(MPILAUNCHER_EXECUTABLE));
     mpiranks = params.find<int>("mpiranks", 1);
     mpitracerank = params.find<int>("mpitracerank", 0);
+    mpitraceranks = params.find<int>("mpitraceranks", 1);
 
     // MPI Launcher error checking
     if (mpimode == 1) {
@@ -124,12 +139,20 @@ void ArielFrontendCommon::parseCommonSubComponentParams(Params& params) {
             output->fatal(CALL_INFO, -1, "The value of `mpitracerank` must be in [0,mpiranks) Got %d.\n", mpitracerank);
         }
 
+        if (mpitraceranks < 1 || mpitracerank + mpitraceranks > mpiranks) {
+            output->fatal(CALL_INFO, -1, "The value of `mpitraceranks` must be in [1,mpiranks-mpitracerank] Got %d.\n", mpitraceranks);
+        }
+
+    } else {
+        // Without a launcher there is only the one process to trace
+        mpitraceranks = 1;
     }
 
     if (mpimode == 1) {
         output->verbose(CALL_INFO, 1, 0, "Ariel-MPI: MPI launcher: %s\n", mpilauncher.c_str());
         output->verbose(CALL_INFO, 1, 0, "Ariel-MPI: MPI ranks: %d\n", mpiranks);
         output->verbose(CALL_INFO, 1, 0, "Ariel-MPI: MPI trace rank: %d\n", mpitracerank);
+        output->verbose(CALL_INFO, 1, 0, "Ariel-MPI: MPI traced ranks: %d\n", mpitraceranks);
     }
 
     // Parse application information
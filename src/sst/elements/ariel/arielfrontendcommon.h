@@ -61,6 +61,7 @@ class ArielFrontendCommon : public ArielFrontend {
         {"mpilauncher", "Specify a launcher to be used for MPI executables in conjuction with <launcher>", STRINGIZE(MPILAUNCHER_EXECUTABLE)},
         {"mpiranks", "Number of ranks to be launched by <mpilauncher>. Only <mpitracerank> will be traced by <launcher>.", "1" },
         {"mpitracerank", "Rank to be traced by <launcher>.", "0" },
+        {"mpitraceranks", "Number of consecutive ranks, starting at <mpitracerank>, to be traced by <launcher>. Each traced rank gets its own tunnel and <corecount> cores.", "1" },
         {"appargcount", "Number of arguments to the traced executable", "0"},
         {"apparg%(appargcount)d", "Arguments for the traced executable", ""},
         {"envparamcount", "Number of environment parameters to supply to the Ariel executable, default=-1 (use SST environment)", "-1"},
@@ -74,6 +75,8 @@ class ArielFrontendCommon : public ArielFrontend {
         // Common Functions
         virtual void finish();
         virtual ArielTunnel* getTunnel();
+        virtual uint32_t getTracedRankCount();
+        virtual ArielTunnel* getRankTunnel(uint32_t rank);
         virtual void init(unsigned int phase);
 
         // Functions that should be implemented by derived classes
@@ -87,6 +90,7 @@ class ArielFrontendCommon : public ArielFrontend {
         uint32_t def_mem_pool;
         SST::Output* output;
         ArielTunnel* tunnel;
+        std::vector<ArielTunnel*> rank_tunnels; // One per traced rank when tracing several, tunnel is the first
 
         // SubComponenent parameters
         int verbosemode; // "verbosity"
@@ -97,6 +101,7 @@ class ArielFrontendCommon : public ArielFrontend {
         std::string mpilauncher;
         int mpiranks;
         int mpitracerank;
+        int mpitraceranks;
         uint32_t appargcount;
         std::vector<std::string> app_arguments; // "apparg*"
 
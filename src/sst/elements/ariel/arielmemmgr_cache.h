@@ -21,6 +21,7 @@
 #include <sst/core/rng/marsaglia.h>
 
 #include <stdint.h>
+#include <algorithm>
 #include <deque>
 #include <vector>
 #include <unordered_map>
@@ -47,7 +48,8 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
     #define ARIEL_ELI_MEMMGR_CACHE_PARAMS {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},\
         {"vtop_translate",  "Set to yes to perform virt-phys translation (TLB) or no to disable", "yes"},\
         {"pagemappolicy",   "Select the page mapping policy for Ariel [LINEAR|RANDOMIZED]", "LINEAR"},\
-        {"translatecacheentries", "Keep a translation cache of this many entries to improve emulated core performance", "4096"}
+        {"translatecacheentries", "Keep a direct-mapped translation cache of this many entries (rounded up to a power of two) to improve emulated core performance. 0 disables it.", "4096"},\
+        {"hugepagesize", "Cache translations for physically contiguous runs of a malloc this large or larger as one entry of up to this many bytes (a power of two, e.g., 2097152). Runs are only contiguous with the LINEAR page mapping policy. 0 disables.", "0"}
 
     #define ARIEL_ELI_MEMMGR_CACHE_STATS { "tlb_hits", "Hits in the simple Ariel TLB", "hits", 2 },\
         { "tlb_evicts",           "Number of evictions in the simple Ariel TLB", "evictions", 2 },\
@@ -83,15 +85,39 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             }
 
             // Set up translation cache
-            translationCache = new std::unordered_map<uint64_t, uint64_t>();
             translationCacheEntries = (uint32_t) params.find<uint32_t>("translatecacheentries", 4096);
+            if (translationCacheEntries > 0) {
+                uint32_t entries = 1;
+                while (entries < translationCacheEntries) entries <<= 1;
+                translationCacheEntries = entries;
+            }
+            translationCache.resize(translationCacheEntries);
+            translationCacheShift = 12;
+            maxCachedSize = 0;
+            maxHugeCachedSize = 0;
+
+            hugePageSize = params.find<uint64_t>("hugepagesize", 0);
+            hugePageShift = 0;
+            if (hugePageSize != 0) {
+                if ((hugePageSize & (hugePageSize - 1)) != 0) {
+                    output->fatal(CALL_INFO, -1, "Ariel memory manager - hugepagesize must be a power of two, got %" PRIu64 "\n", hugePageSize);
+                }
+                if (mapPolicy != ArielPageMappingPolicy::LINEAR) {
+                    output->verbose(CALL_INFO, 1, 0, "Note: hugepagesize is set, but pages are rarely contiguous under the RANDOMIZED page mapping policy\n");
+                }
+                while ((1ULL << hugePageShift) < hugePageSize) hugePageShift++;
+                hugeTranslationCache.resize(translationCacheEntries);
+            }
 
             /* Statistics used by all memory managers; managers may also have their own */
         } // End constructor
 
         ~ArielMemoryManagerCache() {};
         void get_tlb_info(std::unordered_map<uint64_t, uint64_t>* translationcache, uint32_t& translationcacheentries, bool& translationenabled) {
-            memcpy((void*)translationcache, (void*)translationCache, sizeof(*translationCache));
+            translationcache->clear();
+            for (auto& entry : translationCache) {
+                if (entry.size != 0) translationcache->insert(std::make_pair(entry.virtBase, entry.physBase));
+            }
             translationcacheentries = translationCacheEntries;
             translationenabled = translationEnabled;
 
@@ -106,8 +132,25 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
         Statistic<uint64_t>* statTranslationShootdown;
         Statistic<uint64_t>* statPageAllocationCount;
 
-        std::unordered_map<uint64_t, uint64_t>* translationCache;
+        /* A cached translation covers [virtBase, virtBase + size); size 0 is an empty slot */
+        struct TranslationEntry {
+            uint64_t virtBase;
+            uint64_t size;
+            uint64_t physBase;
+            TranslationEntry() : virtBase(0), size(0), physBase(0) {}
+        };
+
+        /* Direct-mapped, indexed by the page number of the address. Runs
+         * larger than a page live in hugeTranslationCache, indexed by the
+         * huge page number, so one entry serves the whole run. */
+        std::vector<TranslationEntry> translationCache;
+        std::vector<TranslationEntry> hugeTranslationCache;
         uint32_t translationCacheEntries;
+        uint32_t translationCacheShift;
+        uint64_t hugePageSize;
+        uint32_t hugePageShift;
+        uint64_t maxCachedSize;     // Largest entry installed in each cache, bounds invalidation
+        uint64_t maxHugeCachedSize;
         bool translationEnabled;
         ArielPageMappingPolicy mapPolicy;
 
@@ -183,15 +226,78 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             fclose(popFile);
         }
 
-        void cacheTranslation(uint64_t virtualA, uint64_t physicalA) {
-            // Remove the oldest entry if we do not have enough slots TODO is begin() really the oldest...?
-            if(translationCache->size() == translationCacheEntries) {
-            statTranslationCacheEvict->addData(1);
-            translationCache->erase(translationCache->begin());
+        /* Index the direct-mapped cache by the smallest page size in use */
+        void setTranslationPageSize(uint64_t pageSize) {
+            translationCacheShift = 0;
+            while ((2ULL << translationCacheShift) <= pageSize) translationCacheShift++;
+        }
+
+        inline bool lookupTranslation(uint64_t virtualA, uint64_t& physicalA) {
+            if (translationCacheEntries == 0) return false;
+
+            const uint64_t mask = translationCacheEntries - 1;
+            const TranslationEntry* entry = &translationCache[(virtualA >> translationCacheShift) & mask];
+            if (virtualA - entry->virtBase >= entry->size && hugePageSize != 0) {
+                entry = &hugeTranslationCache[(virtualA >> hugePageShift) & mask];
             }
+            if (virtualA - entry->virtBase < entry->size) {
+                physicalA = entry->physBase + (virtualA - entry->virtBase);
+                return true;
+            }
+            return false;
+        }
 
-            // Insert the translated entry into the cache
-            translationCache->insert(std::pair<uint64_t, uint64_t>(virtualA, physicalA));
+        void cacheTranslation(uint64_t virtualA, uint64_t virtualBase, uint64_t size, uint64_t physicalBase) {
+            if (translationCacheEntries == 0) return;
+
+            // Install in the slot the missing address indexes to, replacing whatever was there
+            const uint64_t mask = translationCacheEntries - 1;
+            const bool huge = size > (1ULL << translationCacheShift) && hugePageSize != 0;
+            TranslationEntry& entry = huge ?
+                hugeTranslationCache[(virtualA >> hugePageShift) & mask] :
+                translationCache[(virtualA >> translationCacheShift) & mask];
+            uint64_t& maxSize = huge ? maxHugeCachedSize : maxCachedSize;
+            maxSize = std::max(maxSize, size);
+            if (entry.size != 0) {
+                statTranslationCacheEvict->addData(1);
+            }
+            entry.virtBase = virtualBase;
+            entry.size = size;
+            entry.physBase = physicalBase;
+        }
+
+        /* Drop every cached translation that overlaps [virtualA, virtualA + size) */
+        void invalidateTranslations(uint64_t virtualA, uint64_t size) {
+            bool invalidated = invalidateCacheRange(translationCache, translationCacheShift, maxCachedSize, virtualA, size);
+            if (hugePageSize != 0) {
+                invalidated |= invalidateCacheRange(hugeTranslationCache, hugePageShift, maxHugeCachedSize, virtualA, size);
+            }
+            if (invalidated) {
+                statTranslationShootdown->addData(1);
+            }
+        }
+
+    private:
+        /* An overlapping entry was installed from an address within its own
+         * range, so only the slots of blocks within maxSize of the freed
+         * range can hold one; scan those, or the whole cache if that is fewer */
+        bool invalidateCacheRange(std::vector<TranslationEntry>& cache, uint32_t shift, uint64_t maxSize, uint64_t virtualA, uint64_t size) {
+            if (cache.empty() || maxSize == 0 || size == 0) return false;
+
+            const uint64_t first = (virtualA > maxSize ? virtualA - maxSize : 0) >> shift;
+            const uint64_t last = (virtualA + size - 1 + maxSize) >> shift;
+            const uint64_t mask = cache.size() - 1;
+            const uint64_t slots = std::min<uint64_t>(last - first + 1, cache.size());
+
+            bool invalidated = false;
+            for (uint64_t i = 0; i < slots; i++) {
+                TranslationEntry& entry = cache[(first + i) & mask];
+                if (entry.size != 0 && entry.virtBase < virtualA + size && virtualA < entry.virtBase + entry.size) {
+                    entry.size = 0;
+                    invalidated = true;
+                }
+            }
+            return invalidated;
         }
 
 };
@@ -82,6 +82,12 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
     }
 
     free(level_buffer);
+
+    uint64_t minPageSize = pageSizes[0];
+    for (uint32_t i = 1; i < memoryLevels; ++i) {
+        minPageSize = std::min(minPageSize, pageSizes[i]);
+    }
+    setTranslationPageSize(minPageSize);
 }
 
 ArielMemoryManagerMalloc::~ArielMemoryManagerMalloc() {
@@ -219,6 +225,9 @@ bool ArielMemoryManagerMalloc::allocateMalloc(const uint64_t size, const uint32_
     // Record malloc
     mallocInformation.insert(std::make_pair(virtualAddress, mallocInfo(size, level, virtualPages)));
 
+    // Earlier demand-paged translations of this range are now shadowed by the malloc
+    invalidateTranslations(virtualAddress, pageCount * pageSizes[level]);
+
     statBytesAlloc[level]->addData(size);
     return true;
 }
@@ -232,6 +241,7 @@ void ArielMemoryManagerMalloc::freeMalloc(const uint64_t virtualAddress) {
     if (it == mallocInformation.end()) return;
 
     statBytesFree[it->second.level]->addData(it->second.size);
+    invalidateTranslations(virtualAddress, it->second.VAKeys->size() * pageSizes[it->second.level]);
 
     // Free each VA in mallocInformation from mallocTranslations & mallocPrimaryVAMap TODO fix so that mapping stays but address is available for future mallocs
     std::unordered_set<uint64_t>* myKeys = (it->second.VAKeys);
@@ -262,11 +272,11 @@ uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
     output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
 
     // Check the translation cache otherwise carry on
-    auto checkCache = translationCache->find(virtAddr);
-    if(checkCache != translationCache->end()) {
+    if(lookupTranslation(virtAddr, physAddr)) {
         statTranslationCacheHits->addData(1);
-        return checkCache->second;
+        return physAddr;
     }
+    uint64_t cacheBase, cacheSize, cachePhys;
 
     // Check malloc mappings
     if (!mallocTranslations.empty()) {
@@ -276,10 +286,12 @@ uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
 
         if (it != mallocTranslations.end() && (it->first <= virtAddr)) {
             uint64_t primaryAddr = mallocPrimaryVAMap.find(it->first)->second;
-            if (virtAddr < (primaryAddr + (mallocInformation.find(primaryAddr)->second).size)) {
+            const mallocInfo& info = mallocInformation.find(primaryAddr)->second;
+            if (virtAddr < (primaryAddr + info.size)) {
                 uint64_t offset = virtAddr - it->first;
                 physAddr = offset + it->second;
                 found = true;
+                mallocRunTranslation(it, virtAddr, primaryAddr, info, cacheBase, cacheSize, cachePhys);
             }
         }
     }
@@ -297,6 +309,9 @@ uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
             if (page_itr != pageTables[i]->end()) {
                 // Located
             physAddr = page_itr->second + page_offset;
+            cacheBase = page_start;
+            cacheSize = pageSize;
+            cachePhys = page_itr->second;
 
                 output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit in level: %" PRIu32 ", virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
                     virtAddr, i, page_itr->first, page_itr->first + pageSize, page_itr->second, physAddr, page_offset);
@@ -310,7 +325,7 @@ uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
     }
 
     if(found) {
-        cacheTranslation(virtAddr, physAddr);
+        cacheTranslation(virtAddr, cacheBase, cacheSize, cachePhys);
         return physAddr;
     } else {
         output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
@@ -347,6 +362,46 @@ uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
     }
 }
 
+/*
+ *  Find the range a translation cache entry for virtAddr can cover within a malloc.
+ *  Normally that is the page, clipped to the end of the malloc. Mallocs of at least
+ *  hugePageSize are split into hugePageSize-aligned runs from their start, and the
+ *  physically contiguous part of the run holding virtAddr is cached as one entry.
+ */
+void ArielMemoryManagerMalloc::mallocRunTranslation(std::map<uint64_t, uint64_t>::iterator page, const uint64_t virtAddr,
+        const uint64_t primaryAddr, const mallocInfo& info, uint64_t& virtBase, uint64_t& size, uint64_t& physBase) {
+    const uint64_t pageSize = pageSizes[info.level];
+    const uint64_t mallocEnd = primaryAddr + info.size;
+
+    virtBase = page->first;
+    physBase = page->second;
+    size = std::min(pageSize, mallocEnd - virtBase);
+
+    if (hugePageSize == 0 || info.size < hugePageSize || pageSize >= hugePageSize) return;
+
+    const uint64_t runStart = primaryAddr + ((virtAddr - primaryAddr) / hugePageSize) * hugePageSize;
+    const uint64_t runEnd = std::min(runStart + hugePageSize, mallocEnd);
+
+    // Walk the run's pages, restarting the segment wherever physical pages are not contiguous
+    std::map<uint64_t, uint64_t>::iterator it = mallocTranslations.find(runStart);
+    uint64_t segVirt = runStart, segPhys = 0, segLen = 0;
+    for (; it != mallocTranslations.end() && it->first < runEnd; ++it) {
+        if (segLen == 0 || it->first != segVirt + segLen || it->second != segPhys + segLen) {
+            if (segLen != 0 && virtAddr < segVirt + segLen) break;
+            segVirt = it->first;
+            segPhys = it->second;
+            segLen = 0;
+        }
+        segLen += pageSize;
+    }
+
+    if (segLen != 0 && segVirt <= virtAddr && virtAddr < segVirt + segLen) {
+        virtBase = segVirt;
+        physBase = segPhys;
+        size = std::min(segLen, runEnd - segVirt);
+    }
+}
+
 void ArielMemoryManagerMalloc::printStats() {
     output->output("\n");
     output->output("Ariel Memory Management Statistics:\n");
@@ -83,6 +83,9 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
             mallocInfo(uint64_t size, uint32_t level, std::unordered_set<uint64_t>* VAKeys) : size(size), level(level), VAKeys(VAKeys) {};
         };
 
+        void mallocRunTranslation(std::map<uint64_t, uint64_t>::iterator page, const uint64_t virtAddr, const uint64_t primaryAddr,
+                const mallocInfo& info, uint64_t& virtBase, uint64_t& size, uint64_t& physBase);
+
         std::map<uint64_t, uint64_t> mallocPrimaryVAMap;    // Map VA of each PA to the primary VA of the malloc -> used to find the mallocInfo
         std::map<uint64_t, uint64_t> mallocTranslations;    // Map VA to PA for mallocs -> primary lookup
         std::map<uint64_t, mallocInfo> mallocInformation;   // Map mallocID to information about the malloc -> use for frees/allocs
@@ -25,6 +25,7 @@ ArielMemoryManagerSimple::ArielMemoryManagerSimple(ComponentId_t id, Params& par
 
     pageSize = (uint64_t) params.find<uint64_t>("pagesize0", 4096);
     output->verbose(CALL_INFO, 2, 0, "Page size is %" PRIu64 "\n", pageSize);
+    setTranslationPageSize(pageSize);
 
     uint64_t pageCount = (uint64_t) params.find<uint64_t>("pagecount0", 131072);
     output->verbose(CALL_INFO, 2, 0, "Page count is %" PRIu64 "\n", pageCount);
@@ -106,10 +107,10 @@ uint64_t ArielMemoryManagerSimple::translateAddress(uint64_t virtAddr) {
     output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
 
     // Check the translation cache otherwise carry on
-    auto checkCache = translationCache->find(virtAddr);
-    if(checkCache != translationCache->end()) {
+    uint64_t cachedAddr;
+    if(lookupTranslation(virtAddr, cachedAddr)) {
         statTranslationCacheHits->addData(1);
-        return checkCache->second;
+        return cachedAddr;
     }
 
     std::unordered_map<uint64_t, uint64_t>::iterator page_itr;
@@ -125,7 +126,7 @@ uint64_t ArielMemoryManagerSimple::translateAddress(uint64_t virtAddr) {
         output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit, virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
                 virtAddr, page_itr->first, page_itr->first + pageSize, page_itr->second, physAddr, page_offset);
 
-        cacheTranslation(virtAddr, physAddr);
+        cacheTranslation(virtAddr, page_start, pageSize, page_itr->second);
         return physAddr;
 
     } else {
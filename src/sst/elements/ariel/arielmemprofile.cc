@@ -0,0 +1,51 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <stdio.h>
+
+#include "arielmemprofile.h"
+
+using namespace SST::ArielComponent;
+
+static const char memprofile_magic[8] = { 'A', 'R', 'I', 'E', 'L', 'M', 'P', '1' };
+
+void ArielMemoryProfile::write() const {
+    FILE* profile = fopen(fileName.c_str(), "wb");
+    if (NULL == profile) {
+        output->fatal(CALL_INFO, -1, "Unable to open memory profile file %s for writing\n", fileName.c_str());
+    }
+
+    const uint64_t recordCount = instructions.size() + mallocSites.size();
+    fwrite(memprofile_magic, sizeof(memprofile_magic), 1, profile);
+    fwrite(&missLatency, sizeof(missLatency), 1, profile);
+    fwrite(&recordCount, sizeof(recordCount), 1, profile);
+
+    const std::unordered_map<uint64_t, Counters>* tables[2] = { &instructions, &mallocSites };
+    const uint64_t kinds[2] = { ARIEL_MEMPROFILE_INSTRUCTION, ARIEL_MEMPROFILE_MALLOC_SITE };
+
+    for (int i = 0; i < 2; i++) {
+        for (auto& entry : *tables[i]) {
+            const uint64_t record[6] = { entry.first, kinds[i], entry.second.requests, entry.second.writes,
+                entry.second.misses, entry.second.totalLatency };
+            fwrite(record, sizeof(record), 1, profile);
+        }
+    }
+
+    fclose(profile);
+
+    output->verbose(CALL_INFO, 1, 0, "Wrote memory profile of %" PRIu64 " instructions and %" PRIu64 " malloc sites to %s\n",
+            (uint64_t) instructions.size(), (uint64_t) mallocSites.size(), fileName.c_str());
+}
@@ -0,0 +1,116 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_MEM_PROFILE
+#define _H_SST_ARIEL_MEM_PROFILE
+
+#include <sst/core/output.h>
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Binary memory profile, written at the end of simulation:
+ *
+ *   char     magic[8]          "ARIELMP1"
+ *   uint64_t missLatency       responses slower than this (in cycles) were counted as misses
+ *   uint64_t recordCount
+ *   record   records[recordCount]
+ *
+ * Each record is six little-endian uint64_t words:
+ *
+ *   key, kind, requests, writes, misses, totalLatency
+ *
+ * kind is ARIEL_MEMPROFILE_INSTRUCTION, keyed by the instruction pointer of the
+ * access, or ARIEL_MEMPROFILE_MALLOC_SITE, keyed by the ID the frontend gave the
+ * allocation the access fell in (its call site, or its index in the arielstack
+ * backtrace file). requests counts cache-line requests, reads and writes.
+ * tools/arielmemprofile.py folds a profile and the frontend's func.symbols into
+ * flamegraph input.
+ */
+#define ARIEL_MEMPROFILE_INSTRUCTION 0
+#define ARIEL_MEMPROFILE_MALLOC_SITE 1
+
+class ArielMemoryProfile {
+
+    public:
+        ArielMemoryProfile(Output* out, const std::string& file, uint64_t missLat) :
+            output(out), fileName(file), missLatency(missLat) {}
+
+        /* A cache-line request issued at instPtr for virtAddr completed after latency cycles */
+        void recordAccess(uint64_t instPtr, uint64_t virtAddr, bool isWrite, uint64_t latency) {
+            addAccess(instructions[instPtr], isWrite, latency);
+
+            if (!allocations.empty()) {
+                auto alloc = allocations.upper_bound(virtAddr);
+                if (alloc != allocations.begin()) {
+                    --alloc;
+                    if (virtAddr < alloc->first + alloc->second.length) {
+                        addAccess(mallocSites[alloc->second.site], isWrite, latency);
+                    }
+                }
+            }
+        }
+
+        void recordMalloc(uint64_t virtAddr, uint64_t length, uint64_t site) {
+            if (length > 0) allocations[virtAddr] = { length, site };
+        }
+
+        void recordFree(uint64_t virtAddr) {
+            allocations.erase(virtAddr);
+        }
+
+        void write() const;
+
+    private:
+        struct Counters {
+            uint64_t requests;
+            uint64_t writes;
+            uint64_t misses;
+            uint64_t totalLatency;
+            Counters() : requests(0), writes(0), misses(0), totalLatency(0) {}
+        };
+
+        struct Allocation {
+            uint64_t length;
+            uint64_t site;
+        };
+
+        inline void addAccess(Counters& counters, bool isWrite, uint64_t latency) {
+            counters.requests++;
+            if (isWrite) counters.writes++;
+            if (latency > missLatency) counters.misses++;
+            counters.totalLatency += latency;
+        }
+
+        Output* output;
+        std::string fileName;
+        uint64_t missLatency;
+
+        std::unordered_map<uint64_t, Counters> instructions;
+        std::unordered_map<uint64_t, Counters> mallocSites;
+        std::map<uint64_t, Allocation> allocations;
+};
+
+}
+}
+
+#endif
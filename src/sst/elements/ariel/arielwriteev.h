@@ -27,13 +27,13 @@ namespace ArielComponent {
 class ArielWriteEvent : public ArielEvent {
 
     public:
-        ArielWriteEvent(uint64_t wAddr, uint32_t length, const uint8_t* payloadData) :
-                writeAddress(wAddr), writeLength(length) {
+        ArielWriteEvent(uint64_t wAddr, uint32_t length, const uint8_t* payloadData, uint64_t ip = 0) :
+                writeAddress(wAddr), writeLength(length), instPtr(ip) {
 
                 payload = new uint8_t[length];
 
                 for( int i = 0; i < length; ++i ) {
-                	payload[i] = payloadData[i];
+                	payload[i] = (NULL == payloadData) ? 0 : payloadData[i];
                 }
         }
 
@@ -57,9 +57,14 @@ class ArielWriteEvent : public ArielEvent {
         		return payload;
         }
 
+        uint64_t getInstructionPointer() const {
+                return instPtr;
+        }
+
     private:
         const uint64_t writeAddress;
         const uint32_t writeLength;
+        const uint64_t instPtr;
               uint8_t* payload;
 
 };
@@ -40,6 +40,10 @@ EPAFrontend::EPAFrontend(ComponentId_t id, Params& params, uint32_t cores,
     // Parse parameters that all frontends have
     parseCommonSubComponentParams(params);
 
+    if (mpitraceranks > 1) {
+        output->fatal(CALL_INFO, -1, "The EPA frontend traces a single rank, `mpitraceranks` must be 1. Got %d.\n", mpitraceranks);
+    }
+
     output->verbose(CALL_INFO, 1, 0, "Completed processing application arguments.\n");
 
     // Create Tunnel Manager and set the tunnel
@@ -80,12 +80,14 @@ using namespace std;
 
 // General
 KNOB<string> SSTNamedPipe           (KNOB_MODE_WRITEONCE, "pintool", "p", "",  "Named pipe to connect to SST simulator");
+KNOB<UINT32> FirstTracedRank        (KNOB_MODE_WRITEONCE, "pintool", "r", "0", "MPI rank that connects to the first of several named pipes");
 KNOB<UINT32> SSTVerbosity           (KNOB_MODE_WRITEONCE, "pintool", "v", "0", "SST verbosity level");
 KNOB<UINT32> MaxCoreCount           (KNOB_MODE_WRITEONCE, "pintool", "c", "1", "Maximum core count to use for data pipes.");
 KNOB<UINT32> StartupMode            (KNOB_MODE_WRITEONCE, "pintool", "s", "1", "Mode for configuring profile behavior, 1 = start enabled, 0 = start disabled, 2 = attempt auto detect");
 // Instrumentation control
 KNOB<UINT32> InstrumentInstructions (KNOB_MODE_WRITEONCE, "pintool", "E", "1", "Enable instruction instrumentation");
 KNOB<UINT32> PerformWriteTrace      (KNOB_MODE_WRITEONCE, "pintool", "w", "0", "Perform write tracing (i.e copy values directly into SST memory operations) (0 = disabled, 1 = enabled)");
+KNOB<UINT32> BatchMemoryOps         (KNOB_MODE_WRITEONCE, "pintool", "b", "1", "Batch memory operations into compact tunnel records (0 = disabled, 1 = enabled, ignored when write tracing)");
 KNOB<UINT32> TrapFunctionProfile    (KNOB_MODE_WRITEONCE, "pintool", "t", "0", "Function profiling level (0 = disabled, 1 = enabled)");
 // Memory/malloc/etc. tracking
 KNOB<UINT32> InterceptMemAllocations(KNOB_MODE_WRITEONCE, "pintool", "m", "1", "Should intercept multi-level memory allocations, mallocs, and frees, 1 = start enabled, 0 = start disabled");
@@ -110,9 +112,13 @@ PIN_LOCK mainLock;
 // Instrumentation control
 UINT32 instrument_instructions;
 bool writeTrace;
+bool batchOps;
+std::vector<ArielCommandBatch*> batches;
 UINT32 funcProfileLevel;
 typedef struct {
     int64_t insExecuted;
+    ADDRINT start;      // Address range of the routine, written to func.symbols
+    USIZE size;
 } ArielFunctionRecord;
 std::map<std::string, ArielFunctionRecord*> funcProfile;
 
@@ -293,12 +299,57 @@ VOID InstrumentTrace (TRACE trace, VOID* args)
 /******************** END SHADOW STACK **************************/
 /****************************************************************/
 
+/* Send the partly filled batch of a thread so its records are not held back */
+VOID FlushBatch(UINT32 thr)
+{
+    if(batchOps && !batches[thr]->empty()) {
+        tunnel->writeMessage(thr, batches[thr]->getCommand());
+        batches[thr]->reset();
+    }
+}
+
+/* Send a command that is not batched, after the records queued before it */
+inline VOID WriteCommand(UINT32 thr, const ArielCommand& ac)
+{
+    FlushBatch(thr);
+    tunnel->writeMessage(thr, ac);
+}
+
+/* Make room for one more record in the batch of a thread */
+inline ArielCommandBatch* GetBatch(UINT32 thr)
+{
+    ArielCommandBatch* batch = batches[thr];
+    if(!batch->hasSpace()) {
+        tunnel->writeMessage(thr, batch->getCommand());
+        batch->reset();
+    }
+    return batch;
+}
+
+VOID FlushThreadBatch(THREADID thr, const CONTEXT* ctx, INT32 code, VOID* v)
+{
+    if(thr < core_count) {
+        FlushBatch(thr);
+    }
+}
+
+VOID FlushSyscallBatch(THREADID thr, CONTEXT* ctx, SYSCALL_STANDARD std, VOID* v)
+{
+    if(thr < core_count) {
+        FlushBatch(thr);
+    }
+}
+
 VOID Fini(INT32 code, VOID* v)
 {
     if(SSTVerbosity.Value() > 0) {
         std::cout << "SSTARIEL: Execution completed, shutting down." << std::endl;
     }
 
+    for(UINT32 i = 0; i < batches.size(); i++) {
+        FlushBatch(i);
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_PERFORM_EXIT;
     ac.instPtr = (uint64_t) 0;
@@ -316,6 +367,19 @@ VOID Fini(INT32 code, VOID* v)
         }
 
         fclose(funcProfileOutput);
+
+        // Address ranges of the profiled routines, to resolve the instruction pointers of an Ariel memory profile
+        FILE* funcSymbolOutput = fopen("func.symbols", "wt");
+
+        for(std::map<std::string, ArielFunctionRecord*>::iterator funcItr = funcProfile.begin();
+                                                    funcItr != funcProfile.end(); funcItr++) {
+            if(funcItr->second->size > 0) {
+                fprintf(funcSymbolOutput, "%" PRIx64 " %" PRIu64 " %s\n", (uint64_t) funcItr->second->start,
+                        (uint64_t) funcItr->second->size, funcItr->first.c_str());
+            }
+        }
+
+        fclose(funcSymbolOutput);
     }
 
     // Close backtrace files if needed
@@ -346,7 +410,7 @@ VOID WriteFlushInstructionMarker(UINT32 thr, ADDRINT ip, ADDRINT vaddr)
     ac.instPtr = (uint64_t) ip;
     ac.flushline.vaddr = (uint32_t) vaddr;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
@@ -355,7 +419,7 @@ VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
     ac.command = ARIEL_FENCE_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRINT ip,
@@ -364,6 +428,11 @@ VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRI
 
     const uint64_t addr64 = (uint64_t) address;
 
+    if(batchOps) {
+        GetBatch(thr)->addAccess(ARIEL_BATCH_READ, addr64, readSize);
+        return;
+    }
+
     ArielCommand ac;
 
     ac.command = ARIEL_PERFORM_READ;
@@ -373,7 +442,7 @@ VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRI
     ac.inst.instClass = instClass;
     ac.inst.simdElemCount = simdOpWidth;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADDRINT ip,
@@ -381,6 +450,12 @@ VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADD
 {
 
     const uint64_t addr64 = (uint64_t) address;
+
+    if(batchOps) {
+        GetBatch(thr)->addAccess(ARIEL_BATCH_WRITE, addr64, writeSize);
+        return;
+    }
+
     ArielCommand ac;
 
     ac.command = ARIEL_PERFORM_WRITE;
@@ -405,25 +480,35 @@ VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADD
     }
     printf("\n");
 */
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip, UINT32 instClass, UINT32 simdOpWidth)
 {
+    if(batchOps) {
+        GetBatch(thr)->addStart(instClass, simdOpWidth);
+        return;
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_START_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
     ac.inst.simdElemCount = simdOpWidth;
     ac.inst.instClass = instClass;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteEndInstructionMarker(UINT32 thr, ADDRINT ip)
 {
+    if(batchOps) {
+        GetBatch(thr)->addEnd();
+        return;
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_END_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
@@ -463,10 +548,15 @@ VOID WriteNoOp(THREADID thr, ADDRINT ip)
 {
     if(enable_output) {
         if(thr < core_count) {
+            if(batchOps) {
+                GetBatch(thr)->addNoOp();
+                return;
+            }
+
             ArielCommand ac;
             ac.command = ARIEL_NOOP;
             ac.instPtr = (uint64_t) ip;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         }
     }
 }
@@ -658,6 +748,9 @@ VOID InstrumentInstruction(INS ins, VOID *v)
 
         if(checkExists == funcProfile.end()) {
             funcRecord = new ArielFunctionRecord();
+            funcRecord->insExecuted = 0;
+            funcRecord->start = RTN_Valid(rtn) ? RTN_Address(rtn) : 0;
+            funcRecord->size = RTN_Valid(rtn) ? RTN_Size(rtn) : 0;
             funcProfile.insert( std::pair<std::string, ArielFunctionRecord*>(rtn_name,
                 funcRecord) );
         } else {
@@ -744,6 +837,10 @@ void mapped_ariel_disable()
     /* UNLOCK */
     PIN_ReleaseLock(&mainLock);
 
+    if(thr < core_count) {
+        FlushBatch(thr);
+    }
+
     fprintf(stderr, "ARIEL: Disabling memory and instruction tracing from program control at simulated Ariel cycle %" PRIu64 ".\n",
             tunnel->getCycles());
     fflush(stdout);
@@ -819,7 +916,7 @@ void mapped_ariel_output_stats()
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) 0;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 // same effect as mapped_ariel_output_stats(), but it also sends a user-defined reference number back
@@ -829,7 +926,7 @@ void mapped_ariel_output_stats_buoy(uint64_t marker)
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) marker; //user the instruction pointer slot to send the marker number
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 void mapped_ariel_flushline(void *virtualAddress)
@@ -895,7 +992,7 @@ int ariel_mlm_memcpy(void* dest, void* source, size_t size) {
     ac.dma_start.dest = ariel_dest;
     ac.dma_start.len = length;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "Done with ariel memcpy.\n");
@@ -923,7 +1020,7 @@ void ariel_mlm_set_pool(int new_pool)
     ArielCommand ac;
     ac.command = ARIEL_SWITCH_POOL;
     ac.switchPool.pool = newDefaultPool;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     // Keep track of the default pool
     default_pool = (UINT32) new_pool;
@@ -975,7 +1072,7 @@ void* ariel_mmap_mlm(int fileID, size_t size, int level)
     std::cout<<"File ID at FESIMPLE IS : "<<ac.mlm_mmap.fileID<<std::endl;
     std::cout<<"After ******"<<std::endl;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mmap_mlm call allocates data at address: 0x%llx\n",
@@ -1030,7 +1127,7 @@ void* ariel_mlm_malloc(size_t size, int level) {
         ac.mlm_map.alloc_level = allocationLevel;
     }
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mlm_malloc call allocates data at address: 0x%llx\n",
@@ -1075,7 +1172,7 @@ void ariel_mlm_free(void* ptr)
         ArielCommand ac;
         ac.command = ARIEL_ISSUE_TLM_FREE;
         ac.mlm_free.vaddr = virtAddr;
-        tunnel->writeMessage(thr, ac);
+        WriteCommand(thr, ac);
 
     } else {
         fprintf(stderr, "ARIEL: Call to free in Ariel did not find a matching local allocation, this memory will be leaked.\n");
@@ -1113,7 +1210,8 @@ VOID ariel_postmalloc_instrument(ADDRINT allocLocation)
 
         ArielCommand ac;
         ac.command = ARIEL_ISSUE_TLM_MAP;
-        ac.instPtr = myIndex;
+        // Without a backtrace index, identify the allocation by its call site
+        ac.instPtr = (KeepMallocStackTrace.Value() == 1) ? myIndex : lastMallocLoc[thr];
         ac.mlm_map.vaddr = virtualAddress;
         ac.mlm_map.alloc_len = allocationLength;
 
@@ -1127,14 +1225,14 @@ VOID ariel_postmalloc_instrument(ADDRINT allocLocation)
                 if (toFast[thr].count == 0) {
                     toFast[thr].valid = false;
                 }
-                tunnel->writeMessage(thr, ac);
+                WriteCommand(thr, ac);
             }
         } else if (shouldOverride) {
             ac.mlm_map.alloc_level = overridePool;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         } else if (InterceptMemAllocations.Value()) {
             ac.mlm_map.alloc_level = allocationLevel;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         }
 
         /*printf("ARIEL: Created a malloc of size: %" PRIu64 " in Ariel\n",
@@ -1152,7 +1250,7 @@ VOID ariel_postfree_instrument(ADDRINT allocLocation)
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_TLM_FREE;
     ac.mlm_free.vaddr = virtAddr;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 void mapped_ariel_malloc_flag_fortran(int* mallocLocId, int* count, int* level)
@@ -1199,7 +1297,7 @@ void ariel_start_RTL_sim(RTL_shmem_info* rtl_shmem) {
 
     THREADID thr = PIN_ThreadId();
     const uint32_t thrID = (uint32_t) thr;
-    tunnel->writeMessage(thrID, acRtl);
+    WriteCommand(thrID, acRtl);
     #ifdef ARIEL_DEBUG
     fprintf(stderr, "\nMessage to add RTL Event into Ariel Event Queue successfully delivered via ArielTunnel");
     #endif
@@ -1220,7 +1318,7 @@ void ariel_update_RTL_signals(RTL_shmem_info* rtl_shmem) {
 
     THREADID thr = PIN_ThreadId();
     const uint32_t thrID = (uint32_t) thr;
-    tunnel->writeMessage(thrID, acRtl);
+    WriteCommand(thrID, acRtl);
     #ifdef ARIEL_DEBUG
     fprintf(stderr, "\nMessage to add RTL Event into Ariel Event Queue to update RTL signals successfully delivered via ArielTunnel");
     #endif
@@ -1320,7 +1418,7 @@ VOID InstrumentRoutine(RTN rtn, VOID* args)
         RTN_InsertCall(rtn, IPOINT_BEFORE,
             (AFUNPTR) ariel_premalloc_instrument,
                 IARG_FUNCARG_ENTRYPOINT_VALUE, 0,
-                IARG_INST_PTR,
+                IARG_RETURN_IP,
                 IARG_END);
 
         RTN_InsertCall(rtn, IPOINT_AFTER,
@@ -1409,6 +1507,43 @@ INT32 Usage()
     return -1;
 }
 
+/* When several MPI ranks are traced SST passes one pipe per rank,
+   each rank connects to the one matching its place in the launcher's rank order */
+std::string SelectNamedPipe(const std::string& pipes)
+{
+    if (pipes.find(',') == std::string::npos) {
+        return pipes;
+    }
+
+    const char* rank_vars[] = { "OMPI_COMM_WORLD_RANK", "PMI_RANK", "PMIX_RANK", "SLURM_PROCID" };
+    const char* rank_str = NULL;
+    for (unsigned int i = 0; i < sizeof(rank_vars) / sizeof(rank_vars[0]) && NULL == rank_str; i++) {
+        rank_str = getenv(rank_vars[i]);
+    }
+
+    if (NULL == rank_str) {
+        fprintf(stderr, "ARIEL-SST: Several MPI ranks are traced but the rank of this process is not in the environment\n");
+        exit(-1);
+    }
+
+    const int index = atoi(rank_str) - (int) FirstTracedRank.Value();
+    size_t start = 0;
+    for (int i = 0; i < index && start != std::string::npos; i++) {
+        start = pipes.find(',', start);
+        if (start != std::string::npos) {
+            start++;
+        }
+    }
+
+    if (index < 0 || start == std::string::npos) {
+        fprintf(stderr, "ARIEL-SST: Rank %s is not one of the traced ranks\n", rank_str);
+        exit(-1);
+    }
+
+    const size_t end = pipes.find(',', start);
+    return pipes.substr(start, (end == std::string::npos) ? std::string::npos : end - start);
+}
+
 /* ===================================================================== */
 /* Main                                                                  */
 /* ===================================================================== */
@@ -1421,6 +1556,8 @@ int main(int argc, char *argv[])
     //PIN_InitSymbolsAlt(IFUNC_SYMBOLS);
     PIN_InitSymbols();
     PIN_AddFiniFunction(Fini, 0);
+    PIN_AddThreadFiniFunction(FlushThreadBatch, 0);
+    PIN_AddSyscallEntryFunction(FlushSyscallBatch, 0);
 
     PIN_InitLock(&mainLock);
     PIN_InitLock(&mallocIndexLock);
@@ -1462,8 +1599,14 @@ int main(int argc, char *argv[])
     core_count = MaxCoreCount.Value();
     instrument_instructions = InstrumentInstructions.Value();
 
+    // Write payloads do not fit the compact records, so write tracing sends one command per operation
+    batchOps = (BatchMemoryOps.Value() > 0) && !writeTrace;
+    for(unsigned int i = 0; i < core_count; i++) {
+        batches.push_back(new ArielCommandBatch());
+    }
+
 // Pin version specific tunnel attach
-    tunnelmgr = new SST::Core::Interprocess::MMAPChild_Pin3<ArielTunnel>(SSTNamedPipe.Value());
+    tunnelmgr = new SST::Core::Interprocess::MMAPChild_Pin3<ArielTunnel>(SelectNamedPipe(SSTNamedPipe.Value()));
     tunnel = tunnelmgr->getTunnel();
     lastMallocSize = (UINT64*) malloc(sizeof(UINT64) * core_count);
     lastMallocLoc = (UINT64*) malloc(sizeof(UINT64) * core_count);
@@ -63,6 +63,18 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores,
     tunnel = tunnelmgr->getTunnel();
     output->verbose(CALL_INFO, 1, 0, "Base pipe name: %s\n", shmem_region_name.c_str());
 
+    // Each further traced rank attaches to a tunnel of its own
+    if (mpitraceranks > 1) {
+        rank_tunnels.push_back(tunnel);
+        for (int i = 1; i < mpitraceranks; i++) {
+            SST::Core::Interprocess::MMAPParent<ArielTunnel>* rank_mgr =
+                new SST::Core::Interprocess::MMAPParent<ArielTunnel>(id, core_count, max_core_queue_len);
+            rank_tunnelmgrs.push_back(rank_mgr);
+            rank_tunnels.push_back(rank_mgr->getTunnel());
+            output->verbose(CALL_INFO, 1, 0, "Pipe name for rank %d: %s\n", mpitracerank + i, rank_mgr->getRegionName().c_str());
+        }
+    }
+
     // Put together execute_args for fork
     setForkArguments();
     // If mpi, use mpi launcher. Otherwise launch pin
@@ -79,10 +91,17 @@ Pin3Frontend::~Pin3Frontend() {
     // Everything loaded by calls to the core are deleted by the core
     // (subcomponents, component extension, etc.)
     delete tunnelmgr;
+    for (uint32_t i = 0; i < rank_tunnelmgrs.size(); i++) {
+        delete rank_tunnelmgrs[i];
+    }
 }
 
 void Pin3Frontend::emergencyShutdown() {
     delete tunnelmgr; // Clean up tmp file
+    for (uint32_t i = 0; i < rank_tunnelmgrs.size(); i++) {
+        delete rank_tunnelmgrs[i];
+    }
+    rank_tunnelmgrs.clear();
     ArielFrontendCommon::emergencyShutdown();
 }
 
@@ -272,7 +291,7 @@ void Pin3Frontend::setForkArguments() {
         mpi_arg_count = 3;
 
     // PIN: magic number 37 + the arguments for pin
-    const uint32_t pin_arg_count = 37 + launch_param_count;
+    const uint32_t pin_arg_count = 41 + launch_param_count;
 
     // Allocate
     execute_args = (char**) malloc(sizeof(char*) * (mpi_arg_count +
@@ -287,7 +306,11 @@ void Pin3Frontend::setForkArguments() {
         // Prepend mpilauncher to execute_args
         output->verbose(CALL_INFO, 1, 0, "Processing mpilauncher arguments...\n");
         std::string mpiranks_str = std::to_string(mpiranks);
+        // Several traced ranks are passed to the launcher as first:count
         std::string mpitracerank_str = std::to_string(mpitracerank);
+        if (mpitraceranks > 1) {
+            mpitracerank_str += ":" + std::to_string(mpitraceranks);
+        }
 
         size_t mpilauncher_size = sizeof(char) * (mpilauncher.size() + 2);
         execute_args[arg] = (char*) malloc(mpilauncher_size);
@@ -341,11 +364,25 @@ void Pin3Frontend::setForkArguments() {
     execute_args[arg++] = (char*) malloc(buff8size);
     snprintf(execute_args[arg-1], buff8size, "%d", instrument_instructions);
 
+    execute_args[arg++] = const_cast<char*>("-b");
+    execute_args[arg++] = (char*) malloc(buff8size);
+    snprintf(execute_args[arg-1], buff8size, "%" PRIu32, batch_memory_ops);
+
+    // Traced ranks pick their own tunnel from a comma separated list
     std::string shmem_region_name = tunnelmgr->getRegionName();
+    for (uint32_t i = 0; i < rank_tunnelmgrs.size(); i++) {
+        shmem_region_name += "," + rank_tunnelmgrs[i]->getRegionName();
+    }
     execute_args[arg++] = const_cast<char*>("-p");
     execute_args[arg++] = (char*) malloc(sizeof(char) * (shmem_region_name.length() + 1));
     strcpy(execute_args[arg-1], shmem_region_name.c_str());
 
+    if (!rank_tunnelmgrs.empty()) {
+        execute_args[arg++] = const_cast<char*>("-r");
+        execute_args[arg++] = (char*) malloc(buff8size);
+        snprintf(execute_args[arg-1], buff8size, "%d", mpitracerank);
+    }
+
     execute_args[arg++] = const_cast<char*>("-v");
     execute_args[arg++] = (char*) malloc(buff8size);
     snprintf(execute_args[arg-1], buff8size, "%d", verbosemode);
@@ -440,6 +477,11 @@ void Pin3Frontend::parsePin3Params(Params& params) {
     else
         writepayloadtrace = 1;
     instrument_instructions = params.find<int>("instrument_instructions", 1);
+    batch_memory_ops = (uint32_t) params.find<uint32_t>("batchmemoryops", 1);
+    if (batch_memory_ops > 0 && params.find<std::string>("profilememory", "") != "") {
+        output->verbose(CALL_INFO, 1, 0, "Memory profiling needs the instruction pointer of each access, turning off batchmemoryops\n");
+        batch_memory_ops = 0;
+    }
     profilefunctions = (uint32_t) params.find<uint32_t>("profilefunctions", 0);
     intercept_mem_allocations = (uint32_t) params.find<uint32_t>("arielinterceptcalls", 0);
 
@@ -49,7 +49,9 @@ class Pin3Frontend : public ArielFrontendCommon {
         {"arieltool", "Path to the Ariel PIN-tool shared library", ""},
         {"writepayloadtrace", "Trace write payloads and put real memory contents into the memory system", "0"},
         {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"},
+        {"batchmemoryops", "Batch memory operations into compact records in the tunnel instead of one command each, ignored when writepayloadtrace is set", "1"},
         {"profilefunctions", "Profile functions for Ariel execution, 0 = none, >0 = enable", "0" },
+        {"profilememory", "If set, ariel writes a memory profile to this file and batchmemoryops is turned off", ""},
         {"arielinterceptcalls", "Toggle intercepting library calls", "0"},
         {"arielstack", "Dump stack on malloc calls (also requires enabling arielinterceptcalls). May increase overhead due to keeping a shadow stack.", "0"},
         {"mallocmapfile", "File with valid 'ariel_malloc_flag' ids", ""})
@@ -64,6 +66,7 @@ class Pin3Frontend : public ArielFrontendCommon {
     private:
 
         SST::Core::Interprocess::MMAPParent<ArielTunnel>* tunnelmgr;
+        std::vector<SST::Core::Interprocess::MMAPParent<ArielTunnel>*> rank_tunnelmgrs; // Further traced ranks
 
         // SubComponent parameters
         // - pin
@@ -75,6 +78,7 @@ class Pin3Frontend : public ArielFrontendCommon {
         // - pintool arguments
         int writepayloadtrace;
         int instrument_instructions;
+        uint32_t batch_memory_ops; // "batchmemoryops"
         uint32_t profilefunctions;
         uint32_t intercept_mem_allocations;  // "arielinterceptcalls"
         uint32_t keep_malloc_stack_trace; // "arielstack"
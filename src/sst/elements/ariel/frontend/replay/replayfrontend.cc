@@ -0,0 +1,141 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "replayfrontend.h"
+
+#include <sched.h>
+#include <stdlib.h>
+
+using namespace SST::ArielComponent;
+
+ReplayFrontend::ReplayFrontend(ComponentId_t id, Params& params, uint32_t cores,
+    uint32_t maxCoreQueueLen, uint32_t defMemPool) :
+    ArielFrontend(id, params, cores, maxCoreQueueLen, defMemPool),
+    core_count(cores), stop_feeding(false), feeders_running(0), skipped_rtl(0) {
+
+    int verbosemode = params.find<int>("verbose", 0);
+    output = new SST::Output("ReplayFrontend[@f:@l:@p] ", verbosemode, 0, SST::Output::STDERR);
+
+    std::string prefix = params.find<std::string>("replayprefix", "");
+    if ("" == prefix) {
+        output->fatal(CALL_INFO, -1, "The replayprefix parameter naming the command traces to replay was not specified\n");
+    }
+
+    const uint32_t replay_buffer = params.find<uint32_t>("replaybuffer", 16384);
+    const uint32_t read_buffer = params.find<uint32_t>("readbuffer", 1048576);
+
+    for (uint32_t i = 0; i < core_count; i++) {
+        ArielCommandTraceReader* reader = new ArielCommandTraceReader(prefix, i, read_buffer);
+
+        if (!reader->isValid()) {
+            output->fatal(CALL_INFO, -1, "Unable to read command trace %s for core %" PRIu32 ", it is missing or was not captured with this version of Ariel\n",
+                    reader->getPath().c_str(), i);
+        }
+        readers.push_back(reader);
+    }
+
+    // The tunnel is not shared with another process, so it is placed in ordinary memory
+    tunnel = new ArielTunnel(core_count, replay_buffer);
+    tunnel_region = calloc(1, tunnel->getTunnelSize());
+    tunnel->initialize(tunnel_region);
+
+    output->verbose(CALL_INFO, 1, 0, "Replaying %" PRIu32 " command traces from %s with %" PRIu32 " buffered commands per core\n",
+            core_count, prefix.c_str(), replay_buffer);
+}
+
+ReplayFrontend::~ReplayFrontend() {
+    stopFeeders();
+
+    for (uint32_t i = 0; i < readers.size(); i++) {
+        delete readers[i];
+    }
+
+    delete tunnel;
+    free(tunnel_region);
+    delete output;
+}
+
+void ReplayFrontend::init(unsigned int phase) {
+    if (0 == phase && feeders.empty()) {
+        feeders_running = core_count;
+
+        for (uint32_t i = 0; i < core_count; i++) {
+            feeders.push_back(std::thread(&ReplayFrontend::feed, this, i));
+        }
+    }
+}
+
+void ReplayFrontend::finish() {
+    stopFeeders();
+
+    if (skipped_rtl > 0) {
+        output->output("ReplayFrontend: skipped %" PRIu64 " RTL commands, these refer to memory of the captured process and cannot be replayed\n",
+                (uint64_t) skipped_rtl);
+    }
+}
+
+void ReplayFrontend::emergencyShutdown() {
+    stopFeeders();
+}
+
+void ReplayFrontend::feed(uint32_t core) {
+    ArielCommandTraceReader* reader = readers[core];
+    ArielCommand ac;
+    bool exit_seen = false;
+
+    while (!stop_feeding && reader->read(&ac)) {
+        if (ARIEL_ISSUE_RTL == ac.command) {
+            skipped_rtl++;
+            continue;
+        }
+
+        exit_seen = exit_seen || (ARIEL_PERFORM_EXIT == ac.command);
+        tunnel->writeMessage(core, ac);
+    }
+
+    if (!stop_feeding) {
+        // A capture that was cut short has no exit, end the replay after the last command
+        if (0 == core && !exit_seen) {
+            ac.command = ARIEL_PERFORM_EXIT;
+            ac.instPtr = 0;
+            tunnel->writeMessage(core, ac);
+        }
+
+        ac.command = ARIEL_END_OF_STREAM;
+        ac.instPtr = 0;
+        tunnel->writeMessage(core, ac);
+    }
+
+    feeders_running--;
+}
+
+void ReplayFrontend::stopFeeders() {
+    stop_feeding = true;
+
+    // Feeders blocked on a full buffer only return once there is room again
+    while (feeders_running > 0) {
+        for (uint32_t i = 0; i < core_count; i++) {
+            tunnel->clearBuffer(i);
+        }
+        sched_yield();
+    }
+
+    for (uint32_t i = 0; i < feeders.size(); i++) {
+        feeders[i].join();
+    }
+    feeders.clear();
+}
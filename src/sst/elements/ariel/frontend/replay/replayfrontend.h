@@ -0,0 +1,87 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_REPLAY_FRONTEND
+#define _H_REPLAY_FRONTEND
+
+#include <sst/core/sst_config.h>
+#include <sst/core/params.h>
+#include <sst/core/output.h>
+
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arielfrontend.h"
+#include "arielcmdtrace.h"
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Replays the per-core command traces written by an Ariel run with the
+ * capturetrace parameter. There is no child process: the tunnel lives in this
+ * process and one thread per core decompresses its trace and keeps that
+ * core's buffer full, so the cores wait for commands instead of idling and
+ * the replay is deterministic.
+ */
+class ReplayFrontend : public ArielFrontend {
+    public:
+
+    /* SST ELI */
+    SST_ELI_REGISTER_SUBCOMPONENT(ReplayFrontend, "ariel", "frontend.replay", SST_ELI_ELEMENT_VERSION(1,0,0), "Ariel frontend that replays command traces captured with the capturetrace parameter", SST::ArielComponent::ArielFrontend)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
+        {"replayprefix", "Prefix of the per-core command traces (prefix-core.cmdtrace.gz) to replay", ""},
+        {"replaybuffer", "Number of commands buffered in the tunnel for each core", "16384"},
+        {"readbuffer", "Size in bytes of the decompression buffer of each trace", "1048576"})
+
+        ReplayFrontend(ComponentId_t id, Params& params, uint32_t cores,
+            uint32_t qSize, uint32_t memPool);
+        ~ReplayFrontend();
+
+        virtual ArielTunnel* getTunnel() { return tunnel; }
+        virtual bool blockingReads() { return true; }
+
+        virtual void init(unsigned int phase);
+        virtual void finish();
+        virtual void emergencyShutdown();
+
+    private:
+        void feed(uint32_t core);
+        void stopFeeders();
+
+        SST::Output* output;
+        uint32_t core_count;
+
+        ArielTunnel* tunnel;
+        void* tunnel_region;
+
+        std::vector<ArielCommandTraceReader*> readers;
+        std::vector<std::thread> feeders;
+        std::atomic<bool> stop_feeding;
+        std::atomic<uint32_t> feeders_running;
+        std::atomic<uint64_t> skipped_rtl;
+};
+
+} // namespace ArielComponent
+} // namespace SST
+
+#endif // _H_REPLAY_FRONTEND
@@ -38,8 +38,9 @@ void signalHandler(int signum) {
 int main(int argc, char *argv[]) {
     // PIN Example:  mpilauncher 8 3 /path/to/pin -t fesimple -- ./myapp -i input1 --otherarg input2
     // EPA Example:  mpilauncher 8 3 -- ./myapp.arielinst -i input1 --otherarg input2
+    // Tracing ranks 3 to 6 with pin:  mpilauncher 8 3:4 /path/to/pin -t fesimple -- ./myapp
     if (argc < 4 || std::string(argv[1]).compare("-H") == 0) {
-        std::cout << "Usage: " << argv[0] << " <nprocs> <tracerank> [<pin-binary> [pin args]] -- <program-binary> [program args]\n";
+        std::cout << "Usage: " << argv[0] << " <nprocs> <tracerank>[:<tracecount>] [<pin-binary> [pin args]] -- <program-binary> [program args]\n";
         exit(1);
     }
 
@@ -55,6 +56,11 @@ int main(int argc, char *argv[]) {
     // Check inputs
     int procs = atoi(argv[1]);
     int tracerank = atoi(argv[2]);
+    int tracecount = 1;
+    const char* tracecount_str = strchr(argv[2], ':');
+    if (tracecount_str != NULL) {
+        tracecount = atoi(tracecount_str + 1);
+    }
 
     if (procs < 1) {
         printf("Error: %s: <nprocs> must be positive\n", argv[0]);
@@ -66,6 +72,11 @@ int main(int argc, char *argv[]) {
         exit(1);
     }
 
+    if (tracecount < 1 || tracerank + tracecount > procs) {
+        printf("Error: %s: <tracecount> must be in [1,nprocs-tracerank]\n", argv[0]);
+        exit(1);
+    }
+
     // To make it easier to build the final command, check if we are using
     // pin or an EPA tool.
     bool instrument_with_pin = true;
@@ -104,7 +115,7 @@ int main(int argc, char *argv[]) {
 
     if (instrument_with_pin) {
         // For PIN instrumentation, we need to run the regular binary, but
-        // instrument the trace rank with the pintool (fesimple). Do this by
+        // instrument the traced ranks with the pintool (fesimple). Do this by
         // starting the ranks before the tracerank, adding the tracerank, and
         // adding the remaining ranks
         // e.g. mpirun -np M ./myapp -i input1 --anotherarg input2 :
@@ -116,7 +127,7 @@ int main(int argc, char *argv[]) {
         // should launch before the traced rank, and how many should launch
         // after
         int ranks_before = tracerank;
-        int ranks_after = procs - tracerank - 1;
+        int ranks_after = procs - tracerank - tracecount;
         if (ranks_after < 0) {
             ranks_after = 0;
         }
@@ -129,9 +140,9 @@ int main(int argc, char *argv[]) {
                     << " : ";
         }
 
-        // Add the traced process
+        // Add the traced processes
         mpi_cmd << " -H " << host
-                << " -np 1"
+                << " -np " << tracecount
                 << " " << pin_cmd // Should include "--"
                 << " " << target_cmd;
 
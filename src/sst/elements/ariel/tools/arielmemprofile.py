@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+# Copyright 2009-2025 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2025, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+"""
+Convert an Ariel memory profile (the 'profilememory' parameter) to folded
+stacks for flamegraph.pl, or print a per-function summary.
+
+Instruction pointers are resolved to functions with the func.symbols file the
+pin frontend writes when 'profilefunctions' is enabled.
+
+    arielmemprofile.py profile.bin -s func.symbols -m misses > misses.folded
+    flamegraph.pl misses.folded > misses.svg
+    arielmemprofile.py profile.bin -s func.symbols --summary
+"""
+
+import argparse
+import bisect
+import struct
+import sys
+
+MAGIC = b"ARIELMP1"
+KIND_INSTRUCTION = 0
+KIND_MALLOC_SITE = 1
+
+def read_profile(path):
+    with open(path, "rb") as f:
+        if f.read(8) != MAGIC:
+            sys.exit("%s is not an Ariel memory profile" % path)
+        miss_latency, count = struct.unpack("<QQ", f.read(16))
+        records = [struct.unpack("<6Q", f.read(48)) for _ in range(count)]
+    return miss_latency, records
+
+def read_symbols(path):
+    symbols = []
+    with open(path) as f:
+        for line in f:
+            start, size, name = line.rstrip("\n").split(" ", 2)
+            symbols.append((int(start, 16), int(size), name))
+    symbols.sort()
+    return symbols
+
+def resolve(symbols, starts, ip):
+    i = bisect.bisect_right(starts, ip) - 1
+    if i >= 0 and ip < symbols[i][0] + symbols[i][1]:
+        return symbols[i][2]
+    return "0x%x" % ip
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert an Ariel memory profile to flamegraph input")
+    parser.add_argument("profile", help="Binary profile written by ariel")
+    parser.add_argument("-s", "--symbols", help="func.symbols written by the pin frontend")
+    parser.add_argument("-m", "--metric", choices=["requests", "writes", "misses", "latency"], default="misses",
+                        help="Value to weight each stack by (default: misses)")
+    parser.add_argument("--summary", action="store_true", help="Print a per-function table instead of folded stacks")
+    args = parser.parse_args()
+
+    miss_latency, records = read_profile(args.profile)
+    symbols = read_symbols(args.symbols) if args.symbols else []
+    starts = [s[0] for s in symbols]
+    column = { "requests": 2, "writes": 3, "misses": 4, "latency": 5 }[args.metric]
+
+    if args.summary:
+        funcs = {}
+        for rec in records:
+            if rec[1] != KIND_INSTRUCTION:
+                continue
+            name = resolve(symbols, starts, rec[0])
+            totals = funcs.setdefault(name, [0, 0, 0, 0])
+            for i in range(4):
+                totals[i] += rec[2 + i]
+        print("# misses are requests slower than %d cycles" % miss_latency)
+        print("%12s %12s %12s %10s  %s" % ("requests", "writes", "misses", "avg_lat", "function"))
+        for name, t in sorted(funcs.items(), key=lambda f: f[1][column - 2], reverse=True):
+            print("%12d %12d %12d %10.1f  %s" % (t[0], t[1], t[2], t[3] / float(t[0]) if t[0] else 0.0, name))
+        return
+
+    for rec in records:
+        if rec[column] == 0:
+            continue
+        if rec[1] == KIND_INSTRUCTION:
+            print("%s;0x%x %d" % (resolve(symbols, starts, rec[0]), rec[0], rec[column]))
+        else:
+            print("[malloc site];%s %d" % (resolve(symbols, starts, rec[0]), rec[column]))
+
+if __name__ == "__main__":
+    main()
@@ -59,6 +59,42 @@ BalarMMIO::BalarMMIO(ComponentId_t id, Params &params) : SST::Component(id) {
                 "(SI prefixes ok). You specified '%s'\n", getName().c_str(), clockfreq.c_str());
     }
     TimeConverter* tc = getTimeConverter(clockfreq);
+    clock_hz = clock_ua.getDoubleValue();
+
+    // Managed memory, latencies are kept in balar cycles
+    UnitAlgebra uvm_page_size = params.find<UnitAlgebra>("uvm_page_size", "4KiB");
+    UnitAlgebra uvm_window = params.find<UnitAlgebra>("uvm_fault_batch_window", "1us");
+    UnitAlgebra uvm_latency = params.find<UnitAlgebra>("uvm_fault_latency", "20us");
+    UnitAlgebra uvm_bandwidth = params.find<UnitAlgebra>("uvm_link_bandwidth", "16GB/s");
+    uint32_t uvm_batch_size = params.find<uint32_t>("uvm_fault_batch_size", 256);
+    if (!uvm_page_size.hasUnits("B") || uvm_page_size.getRoundedValue() == 0) {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: uvm_page_size. Must have units of B and be > 0. You specified '%s'\n",
+                getName().c_str(), uvm_page_size.toString().c_str());
+    }
+    if (!uvm_window.hasUnits("s") || !uvm_latency.hasUnits("s")) {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: uvm_fault_batch_window and uvm_fault_latency must have units of s\n",
+                getName().c_str());
+    }
+    if (!uvm_bandwidth.hasUnits("B/s") || uvm_bandwidth.getDoubleValue() <= 0) {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: uvm_link_bandwidth. Must have units of B/s and be > 0. You specified '%s'\n",
+                getName().c_str(), uvm_bandwidth.toString().c_str());
+    }
+    if (uvm_batch_size == 0) {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: uvm_fault_batch_size must be > 0\n", getName().c_str());
+    }
+
+    BalarUVM::Stats uvm_stats;
+    uvm_stats.gpuFaults = registerStatistic<uint64_t>("uvm_gpu_faults");
+    uvm_stats.faultBatches = registerStatistic<uint64_t>("uvm_fault_batches");
+    uvm_stats.pagesToDevice = registerStatistic<uint64_t>("uvm_pages_to_device");
+    uvm_stats.pagesToHost = registerStatistic<uint64_t>("uvm_pages_to_host");
+    uvm_stats.prefetchedPages = registerStatistic<uint64_t>("uvm_prefetched_pages");
+    uvm_stats.faultStallCycles = registerStatistic<uint64_t>("uvm_fault_stall_cycles");
+
+    uvm = new BalarUVM(&out, uvm_page_size.getRoundedValue(), uvm_batch_size,
+            (uint64_t) (uvm_window.getDoubleValue() * clock_hz), (uint64_t) (uvm_latency.getDoubleValue() * clock_hz),
+            uvm_bandwidth.getDoubleValue() / clock_hz, uvm_stats);
+    current_cycle = 0;
 
     // Bind tick function
     registerClock(tc, new Clock::Handler2<BalarMMIO,&BalarMMIO::clockTic>(this));
@@ -120,10 +156,19 @@ BalarMMIO::BalarMMIO(ComponentId_t id, Params &params) : SST::Component(id) {
         numPendingCacheTransPerCore[i] = 0;
     }
 
+    // GPGPU-Sim simulates one device per process and reports back through
+    // the global callbacks below, so a second instance would steal the first one's callbacks
+    if (g_balarmmio_component != NULL) {
+        out.fatal(CALL_INFO, -1, "%s, Error: only one balarMMIO per process is supported, '%s' is already loaded. "
+                "Use DMA engines with the SST_TO_SST direction to model peer copies between GPU memories.\n",
+                getName().c_str(), g_balarmmio_component->getName().c_str());
+    }
     g_balarmmio_component = this;
 
     // Initial values
     has_blocked_response = false;
+    has_dma_blocked_sync = false;
+    dma_blocked_sync_stream = 0;
 
     // Initialize pending packets queue with default stream
     pending_packets_per_stream.insert({0, std::queue<BalarCudaCallPacket_t*>()});
@@ -141,6 +186,15 @@ void BalarMMIO::setup() {
         gpu_to_cache_links[i]->setup();
 }
 
+void BalarMMIO::finish() {
+    uint64_t bytes = uvm->getBytesMigrated();
+    if (bytes) {
+        double seconds = uvm->getLinkBusyCycles() / clock_hz;
+        out.verbose(CALL_INFO, 1, 0, "%s: migrated %" PRIu64 " bytes of managed memory at %.2f GB/s while the link was busy\n",
+                getName().c_str(), bytes, bytes / seconds / 1e9);
+    }
+}
+
 bool BalarMMIO::is_SST_buffer_full(unsigned core_id) {
     return (numPendingCacheTransPerCore[core_id] == maxPendingCacheTrans);
 }
@@ -162,6 +216,10 @@ void BalarMMIO::send_read_request_SST(unsigned core_id, uint64_t address, uint64
     cache_req_params crp(core_id, mem_req, req);
     gpuCachePendingTransactions->insert(std::pair<StandardMem::Request::id_t, cache_req_params>(req->getID(), crp));
     numPendingCacheTransPerCore[core_id]++;
+    if (!uvm->access(address, { core_id, req }, current_cycle)) {
+        out.verbose(CALL_INFO, 1, 0, "Read request with id (%ld) to addr %lx waits on a managed page\n", req->getID(), address);
+        return;
+    }
     gpu_to_cache_links[core_id]->send(req);
 
     out.verbose(CALL_INFO, 1, 0, "Sent a read request with id (%ld) to addr %lx\n", req->getID(), req->pAddr);
@@ -184,6 +242,10 @@ void BalarMMIO::send_write_request_SST(unsigned core_id, uint64_t address, uint6
     req->vAddr = address;
     gpuCachePendingTransactions->insert(std::pair<StandardMem::Request::id_t, cache_req_params>(req->getID(), cache_req_params(core_id, mem_req, req)));
     numPendingCacheTransPerCore[core_id]++;
+    if (!uvm->access(address, { core_id, req }, current_cycle)) {
+        out.verbose(CALL_INFO, 1, 0, "Write request with id (%ld) to addr %lx waits on a managed page\n", req->getID(), address);
+        return;
+    }
     gpu_to_cache_links[core_id]->send(req);
     out.verbose(CALL_INFO, 1, 0, "Sent a write request with id (%ld) to addr: %lx\n", req->getID(), req->pAddr);
 }
@@ -330,6 +392,9 @@ void BalarMMIO::SST_callback_event_done(const char* event_name, cudaStream_t str
                 // on the same NIC
                 out.verbose(CALL_INFO, 1, 0, "Sending Issue_DMA_memcpy_D2H_async request to DMA\n");
                 mmio_iface->send(dma_req);
+
+                // Data is not in host memory until the DMA is done
+                startPendingDMA(stream);
             }
         } else {
             // Check that payload's memcpy params matches
@@ -476,11 +541,8 @@ void BalarMMIO::SST_callback_event_done(const char* event_name, cudaStream_t str
             out.fatal(CALL_INFO, -1, "cudaThreadSynchronize_done: another cuda call (%s) get in the way of thread sync\n", CudaAPIEnumToString(last_packet.cuda_call_id));
         }
 
-        mmio_iface->send(blocked_response);
-        has_blocked_response = false;
-
-        // Mark the CUDA call as done
-        cuda_ret.is_cuda_call_done = true;
+        // Device sync also covers the async DMA of every stream
+        completeSync(0);
     } else if (event_string == "cudaStreamSynchronize_done") { // Handle a requested stream sync
         // Check if the head packet is a cudaThreadSynchronize call
         if (head_packet->cuda_call_id != CUDA_STREAM_SYNC) {
@@ -500,11 +562,7 @@ void BalarMMIO::SST_callback_event_done(const char* event_name, cudaStream_t str
             out.fatal(CALL_INFO, -1, "cudaStreamSynchronize_done: another cuda call (%s) get in the way of stream sync\n", CudaAPIEnumToString(last_packet.cuda_call_id));
         }
 
-        mmio_iface->send(blocked_response);
-        has_blocked_response = false;
-
-        // Mark the CUDA call as done
-        cuda_ret.is_cuda_call_done = true;
+        completeSync(stream);
     } else if (event_string == "cudaEventSynchronize_done") { // Handle cudaEventSynchronize_done
         if (payload_size != sizeof(BalarCudaCallPacket_t)) {
             out.fatal(CALL_INFO, -1, "cudaEventSynchronize_done: Invalid payload size %ld\n", payload_size);
@@ -536,11 +594,9 @@ void BalarMMIO::SST_callback_event_done(const char* event_name, cudaStream_t str
 
         // For the event we are waiting for
         // Send the blocked response to stop Vanadis from polling
-        mmio_iface->send(blocked_response);
-        has_blocked_response = false;
-
-        // Mark the CUDA call as done
-        cuda_ret.is_cuda_call_done = true;
+        // once the DMA of the recording stream is done as well
+        auto event_stream = event_record_stream.find(head_packet->cudaEventSynchronize.event);
+        completeSync(event_stream == event_record_stream.end() ? 0 : event_stream->second);
     } else if (event_string == "Kernel_done") {
         // Check if the head packet is a cudaLaunch call
         if (head_packet->cuda_call_id != CUDA_LAUNCH) {
@@ -562,6 +618,14 @@ void BalarMMIO::SST_callback_event_done(const char* event_name, cudaStream_t str
 }
 
 bool BalarMMIO::clockTic(Cycle_t cycle) {
+    // Release GPU requests whose managed pages have arrived
+    current_cycle = cycle;
+    std::vector<BalarUVM::HeldRequest> ready;
+    uvm->tick(cycle, ready);
+    for (auto& held : ready) {
+        gpu_to_cache_links[held.core_id]->send(held.req);
+    }
+
     bool done = SST_gpu_core_cycle();
     return done;
 }
@@ -798,6 +862,12 @@ void BalarMMIO::BalarHandlers::handle(SST::Interfaces::StandardMem::WriteResp* r
                         BalarCudaCallPacket_t * packet_copy = new BalarCudaCallPacket_t(*packet);
                         balar->pending_packets_per_stream.at(0).push(packet_copy);
 
+                        // The host touching managed memory pulls its pages back from the GPU
+                        if (packet->cuda_memcpy.kind == cudaMemcpyHostToDevice)
+                            balar->uvm->hostAccess(packet->cuda_memcpy.dst, packet->cuda_memcpy.count);
+                        else if (packet->cuda_memcpy.kind == cudaMemcpyDeviceToHost)
+                            balar->uvm->hostAccess(packet->cuda_memcpy.src, packet->cuda_memcpy.count);
+
                         // Handle a special case where we have a memcpy
                         // within SST memory space
                         balar->has_blocked_response = true;
@@ -1045,6 +1115,7 @@ void BalarMMIO::BalarHandlers::handle(SST::Interfaces::StandardMem::WriteResp* r
                     }
                     break;
                 case CUDA_FREE:
+                    balar->uvm->removeRange((uint64_t) packet->cuda_free.devPtr);
                     balar->cuda_ret.cuda_error = cudaFree(packet->cuda_free.devPtr);
                     break;
                 case CUDA_GET_LAST_ERROR:
@@ -1109,6 +1180,11 @@ void BalarMMIO::BalarHandlers::handle(SST::Interfaces::StandardMem::WriteResp* r
                             balar->has_blocked_response = true;
                             // Mark this so that vanadis can poll for completion
                             balar->cuda_ret.is_cuda_call_done = false;
+                        } else if (balar->hasPendingDMA(0)) {
+                            // GPGPU-Sim is idle but async DMA transfers are not done
+                            balar->has_blocked_response = true;
+                            balar->cuda_ret.is_cuda_call_done = false;
+                            balar->completeSync(0);
                         }
                     }
                     break;
@@ -1184,15 +1260,20 @@ void BalarMMIO::BalarHandlers::handle(SST::Interfaces::StandardMem::WriteResp* r
                         BalarCudaCallPacket_t * packet_copy = new BalarCudaCallPacket_t(*packet);
                         balar->pending_packets_per_stream.at(packet_copy->cudaMemcpyAsync.stream).push(packet_copy);
 
+                        if (packet->cudaMemcpyAsync.kind == cudaMemcpyHostToDevice)
+                            balar->uvm->hostAccess(packet->cudaMemcpyAsync.dst, packet->cudaMemcpyAsync.count);
+                        else if (packet->cudaMemcpyAsync.kind == cudaMemcpyDeviceToHost)
+                            balar->uvm->hostAccess(packet->cudaMemcpyAsync.src, packet->cudaMemcpyAsync.count);
+
                         if (packet->isSSTmem) {
                             if (packet->cudaMemcpyAsync.kind == cudaMemcpyHostToDevice) {
-                                // Assign device buffer
+                                // Assign a buffer to hold the src data
                                 size_t data_size = packet_copy->cudaMemcpyAsync.count;
-                                packet_copy->cudaMemcpyAsync.dst = (uint64_t)(uint8_t *) calloc(data_size, sizeof(uint8_t));
+                                packet_copy->cudaMemcpyAsync.src_buf = (uint8_t *) calloc(data_size, sizeof(uint8_t));
 
                                 DMAEngine::DMAEngineControlRegisters dma_registers;
                                 dma_registers.sst_mem_addr = packet->cudaMemcpyAsync.src;
-                                dma_registers.simulator_mem_addr = (uint8_t *) packet_copy->cudaMemcpyAsync.dst;
+                                dma_registers.simulator_mem_addr = packet_copy->cudaMemcpyAsync.src_buf;
                                 dma_registers.data_size = data_size;
                                 dma_registers.transfer_size = 4;    // 4 bytes per transfer
                                 dma_registers.dir = DMAEngine::DMA_DIR::SST_TO_SIM; // From SST memspace to simulator memspace
@@ -1214,6 +1295,10 @@ void BalarMMIO::BalarHandlers::handle(SST::Interfaces::StandardMem::WriteResp* r
                                 // Send the DMA request to the engine
                                 // Since we used MMIO for DMA engine, one interface is enough
                                 balar->mmio_iface->send(dma_req);
+
+                                // The copy is handed to GPGPU-Sim once the DMA is done,
+                                // meanwhile kernels and copies on other streams keep going
+                                balar->startPendingDMA(packet->cudaMemcpyAsync.stream);
                             } else if (packet->cudaMemcpyAsync.kind == cudaMemcpyDeviceToHost) {
                                 // Create a dst buffer to hold the dst data
                                 packet_copy->cudaMemcpyAsync.dst_buf = (uint8_t *) calloc(packet->cudaMemcpyAsync.count, sizeof(uint8_t));
@@ -1281,6 +1366,11 @@ void BalarMMIO::BalarHandlers::handle(SST::Interfaces::StandardMem::WriteResp* r
                             balar->has_blocked_response = true;
                             // Mark this so that vanadis can poll for completion
                             balar->cuda_ret.is_cuda_call_done = false;
+                        } else if (balar->hasPendingDMA(packet->cudaStreamSynchronize.stream)) {
+                            // Stream is drained in GPGPU-Sim but its DMA transfers are not done
+                            balar->has_blocked_response = true;
+                            balar->cuda_ret.is_cuda_call_done = false;
+                            balar->completeSync(packet->cudaStreamSynchronize.stream);
                         }
                     }
                     break;
@@ -1303,6 +1393,7 @@ void BalarMMIO::BalarHandlers::handle(SST::Interfaces::StandardMem::WriteResp* r
 
                         // Remove stream queue
                         balar->pending_packets_per_stream.erase(packet->cudaStreamDestroy.stream);
+                        balar->pending_dma_per_stream.erase(packet->cudaStreamDestroy.stream);
                     }
                     break;
                 case CUDA_EVENT_CREATE: {
@@ -1332,6 +1423,7 @@ void BalarMMIO::BalarHandlers::handle(SST::Interfaces::StandardMem::WriteResp* r
                             packet->cudaEventRecord.event,
                             packet->cudaEventRecord.stream
                         );
+                        balar->event_record_stream[packet->cudaEventRecord.event] = packet->cudaEventRecord.stream;
                     }
                     break;
                 case CUDA_EVENT_SYNCHRONIZE: {
@@ -1349,6 +1441,15 @@ void BalarMMIO::BalarHandlers::handle(SST::Interfaces::StandardMem::WriteResp* r
                             balar->has_blocked_response = true;
                             // Mark this so that vanadis can poll for completion
                             balar->cuda_ret.is_cuda_call_done = false;
+                        } else {
+                            // Event is reached in GPGPU-Sim, wait for the DMA of its stream
+                            auto event_stream = balar->event_record_stream.find(packet->cudaEventSynchronize.event);
+                            cudaStream_t stream = event_stream == balar->event_record_stream.end() ? 0 : event_stream->second;
+                            if (balar->hasPendingDMA(stream)) {
+                                balar->has_blocked_response = true;
+                                balar->cuda_ret.is_cuda_call_done = false;
+                                balar->completeSync(stream);
+                            }
                         }
                     }
                     break;
@@ -1364,6 +1465,7 @@ void BalarMMIO::BalarHandlers::handle(SST::Interfaces::StandardMem::WriteResp* r
                         balar->cuda_ret.cuda_error = cudaEventDestroy(
                             packet->cudaEventDestroy.event
                         );
+                        balar->event_record_stream.erase(packet->cudaEventDestroy.event);
                     }
                     break;
                 case CUDA_DEVICE_GET_ATTRIBUTE: {
@@ -1374,6 +1476,26 @@ void BalarMMIO::BalarHandlers::handle(SST::Interfaces::StandardMem::WriteResp* r
                         );
                     }
                     break;
+                case CUDA_MALLOC_MANAGED: {
+                        // Backed by a regular GPGPU-Sim allocation, the UVM model
+                        // only decides when GPU accesses to it may proceed
+                        balar->cuda_ret.cudamalloc.devptr_addr = (uint64_t) packet->cuda_malloc_managed.devPtr;
+                        balar->cuda_ret.cuda_error = cudaSuccess;
+                        balar->cuda_ret.cudamalloc.malloc_addr = cudaMallocSST(
+                            packet->cuda_malloc_managed.devPtr,
+                            packet->cuda_malloc_managed.size
+                        );
+                        balar->uvm->addRange(balar->cuda_ret.cudamalloc.malloc_addr, packet->cuda_malloc_managed.size);
+                    }
+                    break;
+                case CUDA_MEM_PREFETCH_ASYNC: {
+                        // Migrations are not ordered with the stream's other work
+                        balar->uvm->prefetch(packet->cudaMemPrefetchAsync.devPtr,
+                                packet->cudaMemPrefetchAsync.count,
+                                packet->cudaMemPrefetchAsync.dstDevice != cudaCpuDeviceId);
+                        balar->cuda_ret.cuda_error = cudaSuccess;
+                    }
+                    break;
                 default:
                     out->fatal(CALL_INFO, -1, "Received unknown GPU enum API: %d\n", packet->cuda_call_id);
                     break;
@@ -1447,10 +1569,11 @@ void BalarMMIO::BalarHandlers::handle(SST::Interfaces::StandardMem::WriteResp* r
         } else if (request_type.compare("Issue_DMA_memcpy_D2H_async") == 0) {
             // Free temp buffer to hold memcpyD2HAsync data
             out->verbose(_INFO_, "%s: done with a memcpyD2HAsync\n", balar->getName().c_str());
-            free(request_associated_packet->cuda_memcpy.dst_buf);
+            free(request_associated_packet->cudaMemcpyAsync.dst_buf);
 
             // Dont need to send any pending response back to vanadis as
-            // this is an async memcpy
+            // this is an async memcpy, unless a sync is waiting on it
+            balar->finishPendingDMA(request_associated_packet->cudaMemcpyAsync.stream);
 
             delete request_associated_packet;
             delete resp;
@@ -1490,12 +1613,19 @@ void BalarMMIO::BalarHandlers::handle(SST::Interfaces::StandardMem::WriteResp* r
             delete resp;
         } else if (request_type.compare("Issue_DMA_memcpy_H2D_async") == 0) {
             // Perform the cudaMemcpyAsync
-            balar->cuda_ret.cuda_error = cudaMemcpyAsync(
+            // The call has long returned to the CPU, so do not touch cuda_ret
+            cudaError_t error = cudaMemcpyAsync(
                     (void *) request_associated_packet->cudaMemcpyAsync.dst,
                     (const void*) request_associated_packet->cudaMemcpyAsync.src_buf,
                     request_associated_packet->cudaMemcpyAsync.count,
                     request_associated_packet->cudaMemcpyAsync.kind,
                     request_associated_packet->cudaMemcpyAsync.stream);
+            if (error != cudaSuccess) {
+                out->verbose(_INFO_, "%s: cudaMemcpyAsync H2D on stream %p failed with error %d\n", balar->getName().c_str(), request_associated_packet->cudaMemcpyAsync.stream, error);
+            }
+
+            // Later calls on this stream can now be issued after it
+            balar->finishPendingDMA(request_associated_packet->cudaMemcpyAsync.stream);
 
             delete request_associated_packet;
             delete resp;
@@ -1596,10 +1726,59 @@ bool BalarMMIO::isStreamBlocking(cudaStream_t stream) {
                 return true;
             }
         }
+        if (hasPendingDMA(0)) {
+            return true;
+        }
+    }
+    // Calls are issued to GPGPU-Sim in stream order, so a call cannot
+    // pass an async memcpy of its stream that is still in the DMA engine
+    return hasPendingDMA(stream);
+}
+
+bool BalarMMIO::hasPendingDMA(cudaStream_t stream) {
+    for (auto& [dma_stream, count] : pending_dma_per_stream) {
+        if (count && (!stream || dma_stream == stream)) {
+            return true;
+        }
     }
     return false;
 }
 
+void BalarMMIO::startPendingDMA(cudaStream_t stream) {
+    pending_dma_per_stream[stream]++;
+}
+
+void BalarMMIO::finishPendingDMA(cudaStream_t stream) {
+    auto dma = pending_dma_per_stream.find(stream);
+    if (dma == pending_dma_per_stream.end() || dma->second == 0) {
+        out.fatal(CALL_INFO, -1, "%s: DMA done for stream %p without a pending transfer\n", getName().c_str(), stream);
+    }
+    dma->second--;
+
+    // Release a sync that only waited on DMA transfers
+    if (has_dma_blocked_sync && !hasPendingDMA(dma_blocked_sync_stream)) {
+        has_dma_blocked_sync = false;
+        mmio_iface->send(blocked_response);
+        has_blocked_response = false;
+        cuda_ret.is_cuda_call_done = true;
+    }
+}
+
+void BalarMMIO::completeSync(cudaStream_t stream) {
+    if (hasPendingDMA(stream)) {
+        // The response is sent in finishPendingDMA()
+        out.verbose(CALL_INFO, 1, 0, "Sync on stream %p waits on pending DMA transfers\n", stream);
+        has_dma_blocked_sync = true;
+        dma_blocked_sync_stream = stream;
+        return;
+    }
+    mmio_iface->send(blocked_response);
+    has_blocked_response = false;
+
+    // Mark the CUDA call as done
+    cuda_ret.is_cuda_call_done = true;
+}
+
 extern bool is_SST_buffer_full(unsigned core_id) {
     assert(g_balarmmio_component);
     return g_balarmmio_component->is_SST_buffer_full(core_id);
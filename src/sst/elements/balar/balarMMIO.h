@@ -24,6 +24,7 @@
 
 #include "sst/elements/memHierarchy/util.h"
 #include "balar_packet.h"
+#include "balarUVM.h"
 
 // Other Includes, from original balar file
 #include "mempool.h"
@@ -65,6 +66,19 @@ public:
         {"mmio_size",               "(uint) Size of the MMIO memory range (Bytes)", "512"},
         {"dma_addr",                "(uint) Starting addr mapped to the DMA Engine", "512"},
         {"cuda_executable",         "(string) CUDA executable file path to extract PTX info", ""},
+        {"uvm_page_size",           "(UnitAlgebra/string) Migration granularity of managed memory", "4KiB"},
+        {"uvm_fault_batch_size",    "(uint) Maximum number of GPU page faults serviced together", "256"},
+        {"uvm_fault_batch_window",  "(UnitAlgebra/string) Time GPU page faults are collected before a batch is serviced", "1us"},
+        {"uvm_fault_latency",       "(UnitAlgebra/string) Fixed cost of servicing a fault batch, before its pages move", "20us"},
+        {"uvm_link_bandwidth",      "(UnitAlgebra/string) Bandwidth of the CPU-GPU link managed pages migrate over", "16GB/s"},
+    )
+    SST_ELI_DOCUMENT_STATISTICS(
+        {"uvm_gpu_faults",          "GPU page faults on managed memory", "faults", 1},
+        {"uvm_fault_batches",       "Fault batches serviced", "batches", 1},
+        {"uvm_pages_to_device",     "Managed pages migrated to the GPU, on faults or prefetches", "pages", 1},
+        {"uvm_pages_to_host",       "Managed pages migrated back to the host", "pages", 1},
+        {"uvm_prefetched_pages",    "Managed pages moved by cudaMemPrefetchAsync", "pages", 1},
+        {"uvm_fault_stall_cycles",  "Cycles from a GPU page fault until the page arrived, summed over faulted pages", "cycles", 1},
     )
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
         {"mmio_iface", "Command packet MMIO interface", "SST::Interfaces::StandardMem"},
@@ -80,7 +94,7 @@ public:
 
     virtual void init(unsigned int);
     virtual void setup();
-    void finish() {};
+    void finish();
 
     // Copy from original balar
     bool is_SST_buffer_full(unsigned core_id);
@@ -179,6 +193,18 @@ private:
     // and are removed from the queue on receiving the corresponding callback
     // TL;DR: This is a lightweight stream manager for CUDA API calls
     std::map<cudaStream_t, std::queue<BalarCudaCallPacket_t*>> pending_packets_per_stream;
+    // Number of DMA transfers still staging an async memcpy of each stream
+    // A H2D copy is only handed to GPGPU-Sim once its DMA is done, and a D2H
+    // copy is only visible to the CPU once its DMA is done, so later calls on
+    // the stream and syncs covering it have to wait for these as well
+    // Transfers on different streams overlap with each other and with kernels
+    std::map<cudaStream_t, uint32_t> pending_dma_per_stream;
+    // Stream recorded by each event, so that event syncs can wait on the DMA
+    std::map<cudaEvent_t, cudaStream_t> event_record_stream;
+    // A sync GPGPU-Sim is done with that still waits on async DMA transfers
+    // of dma_blocked_sync_stream (0 for all streams)
+    bool has_dma_blocked_sync;
+    cudaStream_t dma_blocked_sync_stream;
     // CUDA Launch config stream stack
     std::stack<cudaStream_t> cudalaunch_stream_stack;
 
@@ -203,6 +229,13 @@ private:
 
     // For checking if the stream operation will be blocking
     bool isStreamBlocking(cudaStream_t);
+    // Whether async DMA transfers of a stream (or any stream for 0) are pending
+    bool hasPendingDMA(cudaStream_t);
+    // Count a DMA transfer for an async memcpy as started or done
+    void startPendingDMA(cudaStream_t);
+    void finishPendingDMA(cudaStream_t);
+    // Complete a sync, or defer it until the DMA transfers it covers are done
+    void completeSync(cudaStream_t);
 
     // The command mmio interface into the memory system
     StandardMem* mmio_iface;
@@ -220,6 +253,11 @@ private:
     uint32_t* numPendingCacheTransPerCore;
     bool isLaunchBlocking;
 
+    // Managed memory model, GPU requests to pages not yet migrated are held here
+    BalarUVM* uvm;
+    Cycle_t current_cycle;
+    double clock_hz;
+
     Output* output;
 
 }; // end BalarMMIO
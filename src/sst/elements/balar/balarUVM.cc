@@ -0,0 +1,190 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include "balarUVM.h"
+
+#include <cmath>
+
+using namespace SST;
+using namespace SST::BalarComponent;
+
+BalarUVM::BalarUVM(Output* out, uint64_t pageSize, uint32_t batchSize, uint64_t batchWindow,
+        uint64_t faultLatency, double linkBytesPerCycle, Stats stats) :
+    out(out), pageSize(pageSize), batchSize(batchSize), batchWindow(batchWindow),
+    faultLatency(faultLatency), linkBytesPerCycle(linkBytesPerCycle), stats(stats),
+    faultWindowEnd(0), inFlightDone(0), bytesMigrated(0), linkBusyCycles(0) {}
+
+void BalarUVM::addRange(uint64_t base, uint64_t size) {
+    if (size == 0)
+        return;
+    ranges[base] = size;
+    out->verbose(CALL_INFO, 1, 0, "UVM: managed range 0x%" PRIx64 " - 0x%" PRIx64 "\n", base, base + size);
+}
+
+void BalarUVM::removeRange(uint64_t base) {
+    auto range = ranges.find(base);
+    if (range == ranges.end())
+        return;
+
+    // Queued and in-flight migrations of these pages are dropped when they are reached
+    for (uint64_t page = base / pageSize; page <= (base + range->second - 1) / pageSize; page++) {
+        pages.erase(page);
+    }
+    ranges.erase(range);
+}
+
+bool BalarUVM::isManaged(uint64_t addr) const {
+    auto range = ranges.upper_bound(addr);
+    if (range == ranges.begin())
+        return false;
+    --range;
+    return addr < range->first + range->second;
+}
+
+bool BalarUVM::access(uint64_t addr, const HeldRequest& held, uint64_t cycle) {
+    if (ranges.empty() || !isManaged(addr))
+        return true;
+
+    Page& page = pages[addr / pageSize];
+    switch (page.state) {
+        case PageState::Device:
+            return true;
+        case PageState::Host:
+            // First touch, the page migrates with the next fault batch
+            page.state = PageState::Faulted;
+            page.faultCycle = cycle;
+            if (faultQueue.empty())
+                faultWindowEnd = cycle + batchWindow;
+            faultQueue.push_back(addr / pageSize);
+            stats.gpuFaults->addData(1);
+            break;
+        default:
+            // Already on its way
+            break;
+    }
+    page.waiting.push_back(held);
+    return false;
+}
+
+void BalarUVM::hostAccess(uint64_t addr, uint64_t size) {
+    if (pages.empty() || size == 0)
+        return;
+
+    for (uint64_t page = addr / pageSize; page <= (addr + size - 1) / pageSize; page++) {
+        auto entry = pages.find(page);
+        if (entry != pages.end() && entry->second.state == PageState::Device) {
+            entry->second.state = PageState::Host;
+            migrationQueue.push_back({ page, false, false });
+        }
+    }
+}
+
+void BalarUVM::prefetch(uint64_t addr, uint64_t size, bool toDevice) {
+    if (ranges.empty() || size == 0)
+        return;
+
+    for (uint64_t page = addr / pageSize; page <= (addr + size - 1) / pageSize; page++) {
+        if (!isManaged(page * pageSize))
+            continue;
+
+        Page& entry = pages[page];
+        if (toDevice && entry.state == PageState::Host) {
+            entry.state = PageState::Queued;
+        } else if (!toDevice && entry.state == PageState::Device) {
+            entry.state = PageState::Host;
+        } else {
+            continue;
+        }
+        migrationQueue.push_back({ page, toDevice, false });
+        stats.prefetchedPages->addData(1);
+    }
+}
+
+uint64_t BalarUVM::transferCycles(uint64_t count) const {
+    uint64_t cycles = (uint64_t) std::ceil((double) (count * pageSize) / linkBytesPerCycle);
+    return cycles ? cycles : 1;
+}
+
+void BalarUVM::startMigration(uint64_t cycle) {
+    // Faults are serviced ahead of prefetches and evictions
+    if (!faultQueue.empty() && cycle >= faultWindowEnd) {
+        while (!faultQueue.empty() && inFlight.size() < batchSize) {
+            uint64_t page = faultQueue.front();
+            faultQueue.pop_front();
+            auto entry = pages.find(page);
+            if (entry == pages.end() || entry->second.state != PageState::Faulted)
+                continue;
+            entry->second.state = PageState::Migrating;
+            inFlight.push_back({ page, true, true });
+        }
+        if (!inFlight.empty()) {
+            stats.faultBatches->addData(1);
+            stats.pagesToDevice->addData(inFlight.size());
+            uint64_t transfer = transferCycles(inFlight.size());
+            inFlightDone = cycle + faultLatency + transfer;
+            linkBusyCycles += transfer;
+            bytesMigrated += inFlight.size() * pageSize;
+            return;
+        }
+    }
+
+    while (!migrationQueue.empty() && inFlight.size() < batchSize) {
+        Migration migration = migrationQueue.front();
+        migrationQueue.pop_front();
+        auto entry = pages.find(migration.page);
+        if (entry == pages.end())
+            continue;
+        if (migration.toDevice) {
+            if (entry->second.state != PageState::Queued)
+                continue;
+            entry->second.state = PageState::Migrating;
+            stats.pagesToDevice->addData(1);
+        } else {
+            stats.pagesToHost->addData(1);
+        }
+        inFlight.push_back(migration);
+    }
+    if (!inFlight.empty()) {
+        uint64_t transfer = transferCycles(inFlight.size());
+        inFlightDone = cycle + transfer;
+        linkBusyCycles += transfer;
+        bytesMigrated += inFlight.size() * pageSize;
+    }
+}
+
+void BalarUVM::tick(uint64_t cycle, std::vector<HeldRequest>& ready) {
+    if (!inFlight.empty()) {
+        if (cycle < inFlightDone)
+            return;
+
+        for (auto& migration : inFlight) {
+            if (!migration.toDevice)
+                continue;
+            auto entry = pages.find(migration.page);
+            if (entry == pages.end())
+                continue;
+            entry->second.state = PageState::Device;
+            if (migration.faulted)
+                stats.faultStallCycles->addData(cycle - entry->second.faultCycle);
+            ready.insert(ready.end(), entry->second.waiting.begin(), entry->second.waiting.end());
+            entry->second.waiting.clear();
+        }
+        inFlight.clear();
+    }
+
+    if (!faultQueue.empty() || !migrationQueue.empty())
+        startMigration(cycle);
+}
@@ -0,0 +1,129 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef BALAR_UVM_H
+#define BALAR_UVM_H
+
+#include <sst/core/output.h>
+#include <sst/core/component.h>
+#include <sst/core/interfaces/stdMem.h>
+
+#include <stdint.h>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+namespace BalarComponent {
+
+/*
+ * Timing model of unified (managed) memory for balar
+ *
+ * Pages of a cudaMallocManaged range start out resident on the host. The first
+ * GPU access to a host-resident page raises a fault and is held, together with
+ * any later access to the same page, until the page has migrated. Faults are
+ * collected for 'batchWindow' cycles and serviced in batches of at most
+ * 'batchSize' pages; each batch pays 'faultLatency' and then moves its pages
+ * over the CPU-GPU link. cudaMemPrefetchAsync moves pages either way over the
+ * same link without the fault overhead, and copies from or to a managed range
+ * (the host touching it) send its GPU-resident pages back.
+ *
+ * The link is modelled as a bandwidth, one migration at a time. Data contents
+ * are not moved, they live in the GPGPU-Sim allocation backing the range.
+ */
+class BalarUVM {
+public:
+    struct HeldRequest {
+        unsigned core_id;
+        SST::Interfaces::StandardMem::Request* req;
+    };
+
+    struct Stats {
+        Statistic<uint64_t>* gpuFaults;
+        Statistic<uint64_t>* faultBatches;
+        Statistic<uint64_t>* pagesToDevice;
+        Statistic<uint64_t>* pagesToHost;
+        Statistic<uint64_t>* prefetchedPages;
+        Statistic<uint64_t>* faultStallCycles;
+    };
+
+    BalarUVM(Output* out, uint64_t pageSize, uint32_t batchSize, uint64_t batchWindow,
+            uint64_t faultLatency, double linkBytesPerCycle, Stats stats);
+
+    void addRange(uint64_t base, uint64_t size);
+    void removeRange(uint64_t base);
+
+    /* Returns false and holds 'held' if the GPU access at addr has to wait for its page */
+    bool access(uint64_t addr, const HeldRequest& held, uint64_t cycle);
+
+    /* The host read or wrote [addr, addr + size), pages of it on the GPU move back */
+    void hostAccess(uint64_t addr, uint64_t size);
+
+    void prefetch(uint64_t addr, uint64_t size, bool toDevice);
+
+    /* Advance migrations and append requests whose page has arrived to 'ready' */
+    void tick(uint64_t cycle, std::vector<HeldRequest>& ready);
+
+    uint64_t getBytesMigrated() const { return bytesMigrated; }
+    uint64_t getLinkBusyCycles() const { return linkBusyCycles; }
+
+private:
+    enum class PageState { Host, Faulted, Queued, Migrating, Device };
+
+    struct Page {
+        PageState state = PageState::Host;
+        uint64_t faultCycle = 0;
+        std::vector<HeldRequest> waiting;
+    };
+
+    struct Migration {
+        uint64_t page;
+        bool toDevice;
+        bool faulted;
+    };
+
+    bool isManaged(uint64_t addr) const;
+    uint64_t transferCycles(uint64_t pages) const;
+    void startMigration(uint64_t cycle);
+
+    Output* out;
+    uint64_t pageSize;
+    uint32_t batchSize;
+    uint64_t batchWindow;
+    uint64_t faultLatency;
+    double linkBytesPerCycle;
+    Stats stats;
+
+    // Managed ranges by base address, and the pages of them that are not on the host
+    std::map<uint64_t, uint64_t> ranges;
+    std::unordered_map<uint64_t, Page> pages;
+
+    std::deque<uint64_t> faultQueue;
+    uint64_t faultWindowEnd;
+    std::deque<Migration> migrationQueue;
+
+    // Batch currently on the link
+    std::vector<Migration> inFlight;
+    uint64_t inFlightDone;
+
+    uint64_t bytesMigrated;
+    uint64_t linkBusyCycles;
+};
+
+}
+}
+
+#endif /* BALAR_UVM_H */
@@ -65,6 +65,8 @@ namespace BalarComponent {
         CUDA_EVENT_ELAPSED_TIME,
         CUDA_EVENT_DESTROY,
         CUDA_DEVICE_GET_ATTRIBUTE,
+        CUDA_MALLOC_MANAGED,
+        CUDA_MEM_PREFETCH_ASYNC,
     };
 
     // Function to get the string representation of the enum values
@@ -107,6 +109,8 @@ namespace BalarComponent {
             case CUDA_EVENT_ELAPSED_TIME: return "CUDA_EVENT_ELAPSED_TIME";
             case CUDA_EVENT_DESTROY: return "CUDA_EVENT_DESTROY";
             case CUDA_DEVICE_GET_ATTRIBUTE: return "CUDA_DEVICE_GET_ATTRIBUTE";
+            case CUDA_MALLOC_MANAGED: return "CUDA_MALLOC_MANAGED";
+            case CUDA_MEM_PREFETCH_ASYNC: return "CUDA_MEM_PREFETCH_ASYNC";
             default: return "Unknown CudaAPI_t";
         }
     }
@@ -303,6 +307,19 @@ namespace BalarComponent {
                 cudaDeviceAttr attr;
                 int device;
             } cudaDeviceGetAttribute;
+
+            struct {
+                void** devPtr;
+                uint64_t size;
+                unsigned int flags;
+            } cuda_malloc_managed;
+
+            struct {
+                uint64_t devPtr;
+                uint64_t count;
+                int dstDevice;
+                cudaStream_t stream;
+            } cudaMemPrefetchAsync;
         };
     } BalarCudaCallPacket_t;
 
@@ -487,6 +504,17 @@ namespace BalarComponent {
                 res &= p1->cudaDeviceGetAttribute.attr == p2->cudaDeviceGetAttribute.attr;
                 res &= p1->cudaDeviceGetAttribute.device == p2->cudaDeviceGetAttribute.device;
                 break;
+            case CUDA_MALLOC_MANAGED:
+                res &= p1->cuda_malloc_managed.devPtr == p2->cuda_malloc_managed.devPtr;
+                res &= p1->cuda_malloc_managed.size == p2->cuda_malloc_managed.size;
+                res &= p1->cuda_malloc_managed.flags == p2->cuda_malloc_managed.flags;
+                break;
+            case CUDA_MEM_PREFETCH_ASYNC:
+                res &= p1->cudaMemPrefetchAsync.devPtr == p2->cudaMemPrefetchAsync.devPtr;
+                res &= p1->cudaMemPrefetchAsync.count == p2->cudaMemPrefetchAsync.count;
+                res &= p1->cudaMemPrefetchAsync.dstDevice == p2->cudaMemPrefetchAsync.dstDevice;
+                res &= p1->cudaMemPrefetchAsync.stream == p2->cudaMemPrefetchAsync.stream;
+                break;
             default:
                 // For calls with no input args, as long
                 // as their cuda_call_id matches, we consider them the same
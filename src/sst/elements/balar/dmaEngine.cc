@@ -128,8 +128,9 @@ bool DMAEngine::tick(SST::Cycle_t x) {
                 memory_requests[req->getID()] = dma_req;
 
                 mem_iface->send(req);
-            } else if (dma_req->dir == SST_TO_SIM) {
+            } else if (dma_req->dir == SST_TO_SIM || dma_req->dir == SST_TO_SST) {
                 // Need to first read it and get copy done inside readresp handler
+                // For SST_TO_SST the readresp handler writes the data to the destination
                 StandardMem::Read* req = new StandardMem::Read(
                     dma_req->sst_mem_addr + dma_req->offset, actual_transfer_size, 0, dma_req->sst_mem_addr + dma_req->offset);
 
@@ -207,11 +208,26 @@ void DMAEngine::DMAHandlers::handle(StandardMem::Write* write) {
         return (start1 <= end2 && end1 >= start2);
     };
 
+    // Peer to peer requests have a second SST range instead of a simulator range
     auto isDMAReqOverlap = [&](DMAEngineControlRegisters* incoming, DMAEngineControlRegisters* existing) {
-        return isAddrRangeOverlap(incoming->sst_mem_addr, incoming->sst_mem_addr + incoming->data_size,
-                                  existing->sst_mem_addr, existing->sst_mem_addr + existing->data_size) ||
-               isAddrRangeOverlap((uint64_t) incoming->simulator_mem_addr, (uint64_t) incoming->simulator_mem_addr + incoming->data_size,
+        bool overlap = isAddrRangeOverlap(incoming->sst_mem_addr, incoming->sst_mem_addr + incoming->data_size,
+                                  existing->sst_mem_addr, existing->sst_mem_addr + existing->data_size);
+        if (incoming->dir == SST_TO_SST) {
+            overlap = overlap || isAddrRangeOverlap(incoming->sst_dst_addr, incoming->sst_dst_addr + incoming->data_size,
+                                  existing->sst_mem_addr, existing->sst_mem_addr + existing->data_size);
+            if (existing->dir == SST_TO_SST)
+                overlap = overlap || isAddrRangeOverlap(incoming->sst_dst_addr, incoming->sst_dst_addr + incoming->data_size,
+                                  existing->sst_dst_addr, existing->sst_dst_addr + existing->data_size);
+        }
+        if (existing->dir == SST_TO_SST) {
+            overlap = overlap || isAddrRangeOverlap(incoming->sst_mem_addr, incoming->sst_mem_addr + incoming->data_size,
+                                  existing->sst_dst_addr, existing->sst_dst_addr + existing->data_size);
+        }
+        if (incoming->dir != SST_TO_SST && existing->dir != SST_TO_SST) {
+            overlap = overlap || isAddrRangeOverlap((uint64_t) incoming->simulator_mem_addr, (uint64_t) incoming->simulator_mem_addr + incoming->data_size,
                                   (uint64_t) existing->simulator_mem_addr, (uint64_t) existing->simulator_mem_addr + existing->data_size);
+        }
+        return overlap;
     };
 
     for (auto& it: dma->dma_requests) {
@@ -247,10 +263,25 @@ void DMAEngine::DMAHandlers::handle(StandardMem::ReadResp* resp) {
         dma->out.fatal(CALL_INFO, -1, "%s: DMA request not found for read response! ID: %ld\n", dma->getName().c_str(), resp->getID());
     }
     DMAEngineRequest_t *dma_req = it->second;
+    size_t offset = resp->pAddr - dma_req->sst_mem_addr;
+
+    if (dma_req->dir == SST_TO_SST) {
+        // Forward the data to the destination, the request stays
+        // ongoing until the write is done
+        StandardMem::Write* req = new StandardMem::Write(
+            dma_req->sst_dst_addr + offset, resp->size,
+            resp->data, false, 0, dma_req->sst_dst_addr + offset);
+        dma->out.verbose(_INFO_, "%s: peer to peer copy, reqid (%ld) writing vaddr: %lx paddr: %lx size: %ld!\n",
+                    dma->getName().c_str(), req->getID(), req->vAddr, req->pAddr, req->size);
+        dma->memory_requests[req->getID()] = dma_req;
+        dma->memory_requests.erase(it);
+        dma->mem_iface->send(req);
+        delete resp;
+        return;
+    }
 
     // Find the simulator buffer pointer value by offset
     // of the sst mem space addr
-    size_t offset = resp->pAddr - dma_req->sst_mem_addr;
     uint8_t * offseted_ptr = dma_req->simulator_mem_addr + offset;
 
     // Perform copy from response
@@ -313,6 +344,10 @@ void DMAEngine::DMAHandlers::handle(StandardMem::WriteResp* resp) {
 std::string DMAEngine::dmaRegToString(DMAEngineControlRegisters* reg_ptr) {
     std::stringstream ss;
     std::string dir = reg_ptr->dir == SIM_TO_SST ? "<<" : "<<";
+    if (reg_ptr->dir == SST_TO_SST) {
+        ss << "Request size: 0x" << std::hex << reg_ptr->data_size << " sst: [0x" << std::hex << reg_ptr->sst_dst_addr << ", 0x" << std::hex << reg_ptr->sst_dst_addr + reg_ptr->data_size << "] << sst: [0x" << std::hex << reg_ptr->sst_mem_addr << ", 0x" << std::hex << reg_ptr->sst_mem_addr + reg_ptr->data_size << "]";
+        return ss.str();
+    }
     ss << "Request size: 0x" << std::hex << reg_ptr->data_size << " sim: [0x" << std::hex << (uint64_t) reg_ptr->simulator_mem_addr << ", 0x" << std::hex << (uint64_t) reg_ptr->simulator_mem_addr + reg_ptr->data_size << "] " << dir << " sst: [0x" << std::hex << reg_ptr->sst_mem_addr << ", 0x" << std::hex << reg_ptr->sst_mem_addr + reg_ptr->data_size << "]";
     return ss.str();
 }
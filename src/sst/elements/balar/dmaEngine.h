@@ -61,6 +61,7 @@ public:
     enum DMA_DIR {
         SIM_TO_SST = 0,
         SST_TO_SIM,
+        SST_TO_SST,     // Peer to peer, e.g., between the memories of two GPUs
     };
 
     enum DMA_Status {
@@ -99,6 +100,8 @@ public:
         // Offset for sending the request to memory
         size_t offset;
         enum DMA_DIR dir;
+        // Destination for SST_TO_SST, sst_mem_addr is the source
+        Addr sst_dst_addr;
 
         // Rest are status regs
         enum DMA_Status status;
@@ -24,6 +24,8 @@
 #include <string>
 #include <iostream>
 #include <map>
+#include <cstring>
+#include <sys/stat.h>
 #include "util.h"
 
 using namespace SST;
@@ -81,7 +83,8 @@ BalarTestCPU::BalarTestCPU(ComponentId_t id, Params& params) :
     gpuHandler = new mmioHandlers(this, &out);
 
     // Bind trace parser
-    trace_parser = new CudaAPITraceParser(this, &out, traceFile, cudaExecutable);
+    bool traceCache = params.find<bool>("trace_cache", false);
+    trace_parser = new CudaAPITraceParser(this, &out, traceFile, cudaExecutable, traceCache);
 }
 
 void BalarTestCPU::init(unsigned int phase)
@@ -373,14 +376,35 @@ void BalarTestCPU::mmioHandlers::handle(Interfaces::StandardMem::WriteResp* resp
  * @param out               : SST Output object to log info
  * @param traceFile         : Path to the CUDA API trace file
  * @param cudaExecutable    : Path to the CUDA executable, which will be used by GPGPU-Sim
+ * @param useCache          : Replay from the pre-parsed trace cache, creating it if needed
  */
-BalarTestCPU::CudaAPITraceParser::CudaAPITraceParser(BalarTestCPU* cpu, SST::Output* out, std::string& traceFile, std::string& cudaExecutable) {
+BalarTestCPU::CudaAPITraceParser::CudaAPITraceParser(BalarTestCPU* cpu, SST::Output* out, std::string& traceFile, std::string& cudaExecutable, bool useCache) {
     this->cpu = cpu;
     this->out = out;
     this->cudaExecutable = cudaExecutable;
-    traceStream.open(traceFile, std::ifstream::in);
-    if (!traceStream.is_open()) {
-        out->fatal(CALL_INFO, -1,"Error: trace file: '%s' not exist\n", traceFile.c_str());
+    useRecords = false;
+    nextRecordIdx = 0;
+
+    std::string cacheFile = traceFile + ".cache";
+    if (useCache && loadCache(cacheFile, traceFile)) {
+        out->verbose(CALL_INFO, 1, 0, "Replaying %zu calls from trace cache '%s'\n", records.size(), cacheFile.c_str());
+        useRecords = true;
+    } else {
+        traceStream.open(traceFile, std::ifstream::in);
+        if (!traceStream.is_open()) {
+            out->fatal(CALL_INFO, -1,"Error: trace file: '%s' not exist\n", traceFile.c_str());
+        }
+        if (useCache) {
+            // Parse the whole trace once and keep it for the next runs
+            std::string line;
+            TraceRecord record;
+            while (std::getline(traceStream, line)) {
+                if (parseLine(line, record))
+                    records.push_back(record);
+            }
+            writeCache(cacheFile);
+            useRecords = true;
+        }
     }
 
     // Extract base path
@@ -422,30 +446,12 @@ Interfaces::StandardMem::Request* BalarTestCPU::CudaAPITraceParser::getNextCall(
     } else {
         // Iterate through lines of trace file
         req = nullptr;
-        if (!traceStream.eof()) {
+        TraceRecord record;
+        if (nextRecord(record)) {
             BalarCudaCallPacket_t pack;
             pack.isSSTmem = false;
-            std::string line;
-            std::getline(traceStream, line);
-            out->verbose(CALL_INFO, 2, 0, "Trace info: %s\n", line.c_str());
-
-            // Parse the trace
-            // Before first colon: api type
-            // Search every colon for individual argument
-            size_t firstColIdx = line.find(":");
-            std::string cudaCallType = line.substr(0, firstColIdx);
-            line = line.substr(firstColIdx + 1);
-            line = trim(line);
-
-            // Extract parameters as a map
-            std::vector<std::string> params = split(line, std::string(","));
-
-            // Trim whitespaces
-            for (auto it = params.begin(); it < params.end(); it++)
-                *it = trim(*it);
-
-            // Params map
-            std::map<std::string, std::string> params_map = map_from_vec(params, std::string(":"));
+            std::string& cudaCallType = record.type;
+            std::map<std::string, std::string>& params_map = record.params;
 
             // Branch to different api calls
             if (cudaCallType.find("memalloc") != std::string::npos) {
@@ -692,3 +698,126 @@ Interfaces::StandardMem::Request* BalarTestCPU::CudaAPITraceParser::getNextCall(
         return req;
     }
 }
+
+/**
+ * @brief Parse a trace line into its api type and parameters
+ *
+ * @param line      : Trace line
+ * @param record    : Parsed line
+ * @return false if the line is empty
+ */
+bool BalarTestCPU::CudaAPITraceParser::parseLine(std::string line, TraceRecord& record) {
+    out->verbose(CALL_INFO, 2, 0, "Trace info: %s\n", line.c_str());
+    if (trim(line).empty())
+        return false;
+
+    // Parse the trace
+    // Before first colon: api type
+    // Search every colon for individual argument
+    size_t firstColIdx = line.find(":");
+    record.type = line.substr(0, firstColIdx);
+    line = line.substr(firstColIdx + 1);
+    line = trim(line);
+
+    // Extract parameters as a map
+    std::vector<std::string> params = split(line, std::string(","));
+
+    // Trim whitespaces
+    for (auto it = params.begin(); it < params.end(); it++)
+        *it = trim(*it);
+
+    // Params map
+    record.params = map_from_vec(params, std::string(":"));
+    return true;
+}
+
+bool BalarTestCPU::CudaAPITraceParser::nextRecord(TraceRecord& record) {
+    if (useRecords) {
+        if (nextRecordIdx == records.size())
+            return false;
+        record = records[nextRecordIdx++];
+        return true;
+    }
+
+    std::string line;
+    while (std::getline(traceStream, line)) {
+        if (parseLine(line, record))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Trace cache format: "BALARTC1", uint64 record count, then for each
+ *        record its type and uint64 parameter count followed by the key and
+ *        value of each parameter. Strings are a uint64 length and the bytes.
+ */
+static void writeCacheString(std::ofstream& stream, const std::string& str) {
+    uint64_t len = str.size();
+    stream.write((const char*) &len, sizeof(len));
+    stream.write(str.data(), len);
+}
+
+static bool readCacheString(std::ifstream& stream, std::string& str) {
+    uint64_t len;
+    if (!stream.read((char*) &len, sizeof(len)))
+        return false;
+    str.resize(len);
+    return (bool) stream.read(&str[0], len);
+}
+
+/**
+ * @brief Load the trace cache if it is at least as new as the trace
+ *
+ * @return false if there is no valid cache
+ */
+bool BalarTestCPU::CudaAPITraceParser::loadCache(std::string& cacheFile, std::string& traceFile) {
+    struct stat traceStat, cacheStat;
+    if (stat(cacheFile.c_str(), &cacheStat) != 0)
+        return false;
+    if (stat(traceFile.c_str(), &traceStat) == 0 && traceStat.st_mtime > cacheStat.st_mtime)
+        return false;
+
+    std::ifstream stream(cacheFile, std::ifstream::in | std::ifstream::binary);
+    char magic[8];
+    uint64_t count;
+    if (!stream.read(magic, 8) || memcmp(magic, "BALARTC1", 8) != 0 || !stream.read((char*) &count, sizeof(count)))
+        return false;
+
+    records.clear();
+    for (uint64_t i = 0; i < count; i++) {
+        TraceRecord record;
+        uint64_t numParams;
+        if (!readCacheString(stream, record.type) || !stream.read((char*) &numParams, sizeof(numParams)))
+            return false;
+        for (uint64_t p = 0; p < numParams; p++) {
+            std::string key, value;
+            if (!readCacheString(stream, key) || !readCacheString(stream, value))
+                return false;
+            record.params[key] = value;
+        }
+        records.push_back(record);
+    }
+    return true;
+}
+
+void BalarTestCPU::CudaAPITraceParser::writeCache(std::string& cacheFile) {
+    std::ofstream stream(cacheFile, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!stream.is_open()) {
+        out->verbose(CALL_INFO, 1, 0, "Warning: cannot write trace cache '%s'\n", cacheFile.c_str());
+        return;
+    }
+
+    uint64_t count = records.size();
+    stream.write("BALARTC1", 8);
+    stream.write((const char*) &count, sizeof(count));
+    for (auto& record : records) {
+        uint64_t numParams = record.params.size();
+        writeCacheString(stream, record.type);
+        stream.write((const char*) &numParams, sizeof(numParams));
+        for (auto& param : record.params) {
+            writeCacheString(stream, param.first);
+            writeCacheString(stream, param.second);
+        }
+    }
+}
@@ -57,6 +57,7 @@ public:
         {"scratch_mem_addr",        "(uint) Base address of the scratch memory to pass balarMMIO packets", "0"},
         {"trace_file",              "(string) CUDA API calls trace file path"},
         {"cuda_executable",         "(string) CUDA executable file path to extract PTX info"},
+        {"trace_cache",             "(bool) Keep a pre-parsed binary copy of the trace next to it (trace_file.cache) and replay from it when it is up to date", "false"},
         {"enable_memcpy_dump",      "(bool) Enable memD2Hcpy dump or not", "false"} )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -138,16 +139,36 @@ private:
     class CudaAPITraceParser {
         public:
             friend class BalarTestCPU;
-            CudaAPITraceParser(BalarTestCPU* cpu, SST::Output* out, std::string& traceFile, std::string& cudaExecutable);
+            CudaAPITraceParser(BalarTestCPU* cpu, SST::Output* out, std::string& traceFile, std::string& cudaExecutable, bool useCache);
             virtual ~CudaAPITraceParser() {}
 
             Interfaces::StandardMem::Request* getNextCall();
 
+            /**
+             * @brief A parsed trace line, api type and its parameters
+             *
+             */
+            struct TraceRecord {
+                std::string type;
+                std::map<std::string, std::string> params;
+            };
+
+            // Next call from the parsed records or the trace file, false at the end
+            bool nextRecord(TraceRecord& record);
+            bool parseLine(std::string line, TraceRecord& record);
+            bool loadCache(std::string& cacheFile, std::string& traceFile);
+            void writeCache(std::string& cacheFile);
+
             BalarTestCPU* cpu;
             SST::Output* out;
             std::string cudaExecutable;
             std::string traceFileBasePath;
             std::ifstream traceStream;
+
+            // Whole trace, when replaying from the cache
+            bool useRecords;
+            std::vector<TraceRecord> records;
+            size_t nextRecordIdx;
             std::queue<Interfaces::StandardMem::Request*>* initReqs;
 
             /**
@@ -1228,6 +1228,64 @@ __host__ cudaError_t CUDARTAPI cudaDeviceGetAttribute(int *value,
     return response_packet_ptr->cuda_error;
 }
 
+// Managed memory is allocated on the GPU and its contents only live there,
+// so the CPU still reaches it with cudaMemcpy; balar models the fault-driven
+// migration timing of its pages
+__host__ cudaError_t CUDARTAPI cudaMallocManaged(void **devPtr, size_t size, unsigned int flags) {
+    if (g_debug_level >= LOG_LEVEL_DEBUG) {
+        printf("Start cudaMallocManaged with size %lu\n", size);
+        fflush(stdout);
+    }
+
+    BalarCudaCallPacket_t *call_packet_ptr = (BalarCudaCallPacket_t *) g_scratch_mem;
+    call_packet_ptr->isSSTmem = true;
+    call_packet_ptr->cuda_call_id = CUDA_MALLOC_MANAGED;
+    call_packet_ptr->cuda_malloc_managed.devPtr = devPtr;
+    call_packet_ptr->cuda_malloc_managed.size = size;
+    call_packet_ptr->cuda_malloc_managed.flags = flags;
+
+    // Make cuda call
+    BalarCudaCallReturnPacket_t *response_packet_ptr = makeCudaCall(call_packet_ptr);
+
+    if (g_debug_level >= LOG_LEVEL_DEBUG) {
+        printf("CUDA API ID: %d with error: %d\nMalloc addr: %lx Dev addr: %lx\n",
+                response_packet_ptr->cuda_call_id, response_packet_ptr->cuda_error,
+                response_packet_ptr->cudamalloc.malloc_addr, response_packet_ptr->cudamalloc.devptr_addr);
+        fflush(stdout);
+    }
+
+    *devPtr = (void *)response_packet_ptr->cudamalloc.malloc_addr;
+
+    return response_packet_ptr->cuda_error;
+}
+
+__host__ cudaError_t CUDARTAPI cudaMemPrefetchAsync(const void *devPtr, size_t count,
+                                                    int dstDevice, cudaStream_t stream) {
+    if (g_debug_level >= LOG_LEVEL_DEBUG) {
+        printf("Start cudaMemPrefetchAsync of %p with size %lu to device %d\n", devPtr, count, dstDevice);
+        fflush(stdout);
+    }
+
+    BalarCudaCallPacket_t *call_packet_ptr = (BalarCudaCallPacket_t *) g_scratch_mem;
+    call_packet_ptr->isSSTmem = true;
+    call_packet_ptr->cuda_call_id = CUDA_MEM_PREFETCH_ASYNC;
+    call_packet_ptr->cudaMemPrefetchAsync.devPtr = (uint64_t) devPtr;
+    call_packet_ptr->cudaMemPrefetchAsync.count = count;
+    call_packet_ptr->cudaMemPrefetchAsync.dstDevice = dstDevice;
+    call_packet_ptr->cudaMemPrefetchAsync.stream = stream;
+
+    // Make cuda call
+    BalarCudaCallReturnPacket_t *response_packet_ptr = makeCudaCall(call_packet_ptr);
+
+    if (g_debug_level >= LOG_LEVEL_DEBUG) {
+        printf("CUDA API ID: %d with error: %d\n",
+                response_packet_ptr->cuda_call_id, response_packet_ptr->cuda_error);
+        fflush(stdout);
+    }
+
+    return response_packet_ptr->cuda_error;
+}
+
 // Required by the cuda-samples, but haven't been implemented yet
 // in GPGPU-Sim
 __host__ cudaError_t cudaHostRegister(void *ptr, size_t size,
@@ -15,6 +15,7 @@
 
 #include "sst_config.h"
 #include <cmath>
+#include <algorithm>
 
 #include "cacheTracer.h"
 
@@ -51,6 +52,14 @@ cacheTracer::cacheTracer( ComponentId_t id, Params& params ): Component( id ) {
     out->debug(CALL_INFO, 1, 0, "Clock registered\n");
 
     string tracePrefix = params.find<std::string>("tracePrefix", "");
+    string traceFormat = params.find<std::string>("traceFormat", "text");
+    if("text" != traceFormat && "binary" != traceFormat && "columnar" != traceFormat){
+        out->fatal(CALL_INFO, -1, "cacheTracer traceFormat must be text, binary or columnar, not %s\n", traceFormat.c_str());
+    }
+    traceFile = NULL;
+    columnarTrace = NULL;
+    traceWriter = NULL;
+    binaryTrace = ("binary" == traceFormat);
     if("" == tracePrefix){
         out->debug(CALL_INFO, 1, 0, "Tracing Not Enabled.\n");
         writeTrace = false;
@@ -59,7 +68,23 @@ cacheTracer::cacheTracer( ComponentId_t id, Params& params ): Component( id ) {
         char* traceFilePath = (char*) malloc( sizeof(char) * (tracePrefix.size()+ 20) );
         snprintf(traceFilePath, (tracePrefix.size()+ 20), "%s", tracePrefix.c_str());
         out->output("Writing trace to file: %s\n", traceFilePath);
-        traceFile = fopen(traceFilePath, "wt");
+        if("columnar" == traceFormat){
+            columnarTrace = new SST::Prospero::ColumnarTraceWriter(traceFilePath);
+            if(!columnarTrace->isOpen()){
+                out->fatal(CALL_INFO, -1, "cacheTracer could not open trace file %s\n", traceFilePath);
+            }
+        } else {
+            traceFile = fopen(traceFilePath, binaryTrace ? "wb" : "wt");
+            if(NULL == traceFile){
+                out->fatal(CALL_INFO, -1, "cacheTracer could not open trace file %s\n", traceFilePath);
+            }
+            // The trace is written on a separate thread so file I/O does not hold up the simulation
+            traceWriter = new CacheTracerWriter(traceFile, params.find<size_t>("traceBufferSize", 4194304));
+            if(binaryTrace){
+                const uint32_t header[3] = { CACHETRACER_BINARY_MAGIC, CACHETRACER_BINARY_VERSION, (uint32_t) sizeof(CacheTracerRecord) };
+                traceWriter->write(header, sizeof(header));
+            }
+        }
         free(traceFilePath);
         writeTrace = true;
     }
@@ -82,6 +107,26 @@ cacheTracer::cacheTracer( ComponentId_t id, Params& params ): Component( id ) {
     writeDebug_8 = false;
     if (debug >= 8) { writeDebug_8 = true; }
 
+    sampleInterval = params.find<uint64_t>("sampleInterval", 1);
+    samplePeriod = params.find<uint64_t>("samplePeriod", 0);
+    sampleWindow = params.find<uint64_t>("sampleWindow", 0);
+    if(0 == sampleInterval){
+        out->fatal(CALL_INFO, -1, "cacheTracer sampleInterval must be at least 1\n");
+    }
+    sampling = (sampleInterval > 1) || (samplePeriod > 0);
+    sampleCount = 0;
+    if(sampling){
+        out->debug(CALL_INFO, 1, 0, "Tracing one in %" PRIu64 " events, in the first %" PRIu64 " of every %" PRIu64 " cycles\n",
+            sampleInterval, sampleWindow, samplePeriod);
+    }
+
+    reuseTracker = NULL;
+    coldAccesses = 0;
+    if(params.find<unsigned int>("reuseDistance", 0)){
+        reuseTracker = new ReuseDistanceTracker(params.find<uint64_t>("reuseLineSize", 64));
+        out->debug(CALL_INFO, 1, 0, "Reuse distance histogram is enabled\n");
+    }
+
     // check links
     northBus = configureLink("northBus");
     southBus = configureLink("southBus");
@@ -97,7 +142,11 @@ cacheTracer::cacheTracer( ComponentId_t id, Params& params ): Component( id ) {
 } // constructor
 
 // destructor
-cacheTracer::~cacheTracer() {}
+cacheTracer::~cacheTracer() {
+    delete columnarTrace;
+    delete traceWriter;
+    delete reuseTracker;
+}
 
 void cacheTracer::init(unsigned int phase) {
     // Since cacheTracer can sit between memH components, it needs to forward init events
@@ -109,6 +158,45 @@ void cacheTracer::init(unsigned int phase) {
     }
 }
 
+bool cacheTracer::sampleRequest(){
+    if(!sampling){
+        return true;
+    }
+    if(samplePeriod > 0 && (timestamp % samplePeriod) >= sampleWindow){
+        return false;
+    }
+    return 0 == (sampleCount++ % sampleInterval);
+}
+
+void cacheTracer::writeTraceEvent(const char* bus, MemEvent* me, uint64_t nanoseconds){
+    if(binaryTrace){
+        CacheTracerRecord record;
+        record.timestamp = timestamp;
+        record.nanoseconds = nanoseconds;
+        record.addr = me->getAddr();
+        record.id = me->getID().first;
+        record.responseId = me->getResponseToID().first;
+        record.idNode = me->getID().second;
+        record.responseNode = me->getResponseToID().second;
+        record.size = me->getSize();
+        record.cmd = (uint16_t) me->getCmd();
+        record.bus = ('N' == bus[0]) ? CACHETRACER_BUS_NORTH : CACHETRACER_BUS_SOUTH;
+        record.reserved = 0;
+        traceWriter->write(&record, sizeof(record));
+        return;
+    }
+
+    if(!writeDebug_8){
+        return;
+    }
+
+    char line[256];
+    int length = snprintf(line, sizeof(line), "%s: Addr: 0x%" PRIu64 " timestamp: %" PRIu64 " Cmd: %d ID: %" PRIu64 "-%d ResponseID: %" PRIu64 "-%d @%" PRIu64 " ns\n",
+        bus, me->getAddr(), timestamp, (int) me->getCmd(), me->getID().first, me->getID().second,
+        me->getResponseToID().first, me->getResponseToID().second, nanoseconds);
+    traceWriter->write(line, std::min((size_t) length, sizeof(line) - 1));
+}
+
 bool cacheTracer::clock(Cycle_t current){
     timestamp++;
 
@@ -138,15 +226,35 @@ bool cacheTracer::clock(Cycle_t current){
         //InFlightReqQueue[me->getID()] = timestamp;
         InFlightReqQueue[me->getID()] = nanoseconds;
 
-        if(writeDebug_8 & writeTrace){
-             fprintf(traceFile,"NB: Addr: 0x%" PRIu64, addr);
-             fprintf(traceFile, " timestamp: %" PRIu64, timestamp);
-             fprintf(traceFile, " Cmd: %d", (int) me->getCmd());
-             fprintf(traceFile, " ID: %" PRIu64 "-%d", me->getID().first, me->getID().second);
-             fprintf(traceFile, " ResponseID: %" PRIu64 "-%d", me->getResponseToID().first, me->getResponseToID().second);
-             //fprintf(traceFile, " @%" PRIu64, picoseconds);
-             fprintf(traceFile, " @%" PRIu64 " ns", nanoseconds);
-             fprintf(traceFile, "\n");
+        if(reuseTracker && me->isDataRequest()){
+            uint64_t distance = reuseTracker->access(addr);
+            if(CACHETRACER_REUSE_COLD == distance){
+                coldAccesses++;
+            } else {
+                // Bin 0 holds a distance of 0, bin b holds distances [2^(b-1), 2^b - 1]
+                unsigned int bin = 0;
+                while(distance > 0){ distance >>= 1; bin++; }
+                if(bin >= ReuseDistHist.size()){
+                    ReuseDistHist.resize(bin + 1);
+                }
+                ReuseDistHist[bin] += 1;
+            }
+        }
+
+        bool traced = sampleRequest();
+        if(traced && sampling && traceWriter && me->isDataRequest()){
+            SampledReqs.insert(me->getID());
+        }
+
+        if(traced && columnarTrace && BasicCommandClass::Request == BasicCommandClassArr[(int) me->getCmd()]){
+             Command cmd = me->getCmd();
+             bool isWrite = (Command::GetX == cmd || Command::Write == cmd || Command::PutM == cmd);
+             columnarTrace->addRecord(timestamp, addr, me->getSize(),
+                 isWrite ? COLUMNAR_TRACE_OP_WRITE : COLUMNAR_TRACE_OP_READ, 0);
+        }
+
+        if(traced && writeTrace && (NULL != traceWriter)){
+             writeTraceEvent("NB", me, nanoseconds);
         }
 
         // Send the request to south-bus
@@ -181,15 +289,9 @@ bool cacheTracer::clock(Cycle_t current){
            InFlightReqQueue.erase(me->getResponseToID());
         }
 
-        if(writeDebug_8 & writeTrace){
-             fprintf(traceFile,"SB: Addr: 0x%" PRIu64, me->getAddr());
-             fprintf(traceFile, " timestamp: %" PRIu64, timestamp);
-             fprintf(traceFile, " Cmd: %d", (int) me->getCmd());
-             fprintf(traceFile, " ID: %" PRIu64 "-%d", me->getID().first, me->getID().second);
-             fprintf(traceFile, " ResponseID: %" PRIu64 "-%d", me->getResponseToID().first, me->getResponseToID().second);
-             //fprintf(traceFile, " @%" PRIu64, picoseconds);
-             fprintf(traceFile, " @%" PRIu64 " ns", nanoseconds);
-             fprintf(traceFile, "\n");
+        // While sampling, only the responses to traced requests are traced
+        if(writeTrace && (NULL != traceWriter) && (!sampling || SampledReqs.erase(me->getResponseToID()) > 0)){
+             writeTraceEvent("SB", me, nanoseconds);
         }
 
        // Send the request to north-bus
@@ -208,8 +310,17 @@ void cacheTracer::finish(){
            FinalStats(stdout, accessLatBins);
         }
     } // if stats()
-    if(writeTrace){
+    if(traceWriter){
+       // Wait for the writer thread to write out the buffered trace
+       traceWriter->close();
+    }
+    if(traceFile){
        fclose(traceFile);
+       traceFile = NULL;
+    }
+    if(columnarTrace){
+       // Closing the trace writes its last block and the block index
+       columnarTrace->close();
     }
 } // finish()
 
@@ -226,6 +337,9 @@ void cacheTracer::FinalStats(FILE *fp, unsigned int numBins){
     //fprintf(fp, "- InFlightReqQueue Size              : %" PRIu64 "\n", InFlightReqQueue.size() );
     PrintAddrHistogram(fp, AddrHist);
     PrintAccessLatencyDistribution(fp, numBins);
+    if(reuseTracker){
+        PrintReuseDistanceHistogram(fp);
+    }
 }
 
 void cacheTracer::PrintAddrHistogram(FILE *fp, vector<SST::MemHierarchy::Addr> bucketList){
@@ -296,3 +410,22 @@ void cacheTracer::PrintAccessLatencyDistribution(FILE* fp, unsigned int numBins)
     fprintf(fp, "- Total_Events_Latency: %u\n", count);
     fprintf(fp, "-----------------------------------------------------------------\n\n");
 }
+
+void cacheTracer::PrintReuseDistanceHistogram(FILE* fp){
+// Prints the reuse distances of north bus requests in log2 bins
+    uint64_t count = coldAccesses;
+
+    fprintf(fp, "Reuse Distance Histogram (distinct lines between accesses to a line):\n");
+    fprintf(fp, "-----------------------------------------------------------------\n");
+    fprintf(fp, "Distance Range: Count\n");
+    for (unsigned int i=0; i<ReuseDistHist.size(); i++){
+        uint64_t low = (0 == i) ? 0 : (1ULL << (i-1));
+        uint64_t high = (0 == i) ? 0 : ((1ULL << i) - 1);
+        fprintf(fp, "- [%" PRIu64 "-%" PRIu64 "]: %" PRIu64 "\n", low, high, ReuseDistHist[i]);
+        count += ReuseDistHist[i];
+    }
+    fprintf(fp, "- Cold: %" PRIu64 "\n", coldAccesses);
+    fprintf(fp, "-----------------------------------------------------------------\n");
+    fprintf(fp, "- Total_Events_Reuse: %" PRIu64 "  Distinct_Lines: %" PRIu64 "\n", count, reuseTracker->distinctLines());
+    fprintf(fp, "-----------------------------------------------------------------\n\n");
+}
@@ -25,6 +25,9 @@
 #include <sst/core/link.h>
 #include <sst/core/timeConverter.h>
 #include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/prospero/prostraceformat.h>
+#include "cacheTracerWriter.h"
+#include "reuseDistance.h"
 #include <assert.h>
 #include <errno.h>
 #include <execinfo.h>
@@ -32,6 +35,7 @@
 #include <iostream>
 #include <fstream>
 #include <map>
+#include <set>
 
 using namespace std;
 using namespace SST;
@@ -60,6 +64,13 @@ public:
 	{ "clock", "Frequency, same as system clock frequency", "1 GHz" },
     	{ "statsPrefix", "writes stats to statsPrefix file", "" },
     	{ "tracePrefix", "writes trace to tracePrefix tracing is enable", "" },
+    	{ "traceFormat", "Format of the trace, text (written when debug is 8 or more), binary (CacheTracerRecords of both buses) or columnar (the requests from the north bus, replayable by prospero.ProsperoColumnarTraceReader)", "text" },
+    	{ "traceBufferSize", "Size in bytes of each buffer handed to the thread writing a text or binary trace", "4194304" },
+    	{ "sampleInterval", "Trace one in every sampleInterval events from the north bus, and their responses", "1" },
+    	{ "samplePeriod", "If non-zero, only trace during the first sampleWindow cycles of every samplePeriod cycles", "0" },
+    	{ "sampleWindow", "Length in cycles of each traced window when samplePeriod is set", "0" },
+    	{ "reuseDistance", "1 to report a histogram of the reuse distances of north bus requests with the statistics", "0" },
+    	{ "reuseLineSize", "Size in bytes of the lines reuse distances are counted in", "64" },
     	{ "debug", "Print debug statements with increasing verbosity [0-10]", "0" },
     	{ "statistics", "0-No-stats, 1-print-stats", "0" },
     	{ "pageSize", "Page Size (bytes), used for selecting number of bins for address histogram ", "4096" },
@@ -77,10 +88,16 @@ private:
     void FinalStats(FILE*, unsigned int);
     void PrintAddrHistogram(FILE*, vector<SST::MemHierarchy::Addr>);
     void PrintAccessLatencyDistribution(FILE*, unsigned int);
+    void PrintReuseDistanceHistogram(FILE*);
+    bool sampleRequest();
+    void writeTraceEvent(const char* bus, MemEvent* me, uint64_t nanoseconds);
 
     Output* out;
     FILE* traceFile;
     FILE* statsFile;
+    SST::Prospero::ColumnarTraceWriter* columnarTrace;
+    CacheTracerWriter* traceWriter;
+    bool binaryTrace;
 
     // Links
     SST::Link *northBus;
@@ -90,11 +107,15 @@ private:
     unsigned int stats;
     unsigned int pageSize;
     unsigned int accessLatBins;
+    uint64_t sampleInterval;
+    uint64_t samplePeriod;
+    uint64_t sampleWindow;
 
     // Flags
     bool writeTrace;
     bool writeStats;
     bool writeDebug_8;
+    bool sampling;
 
     unsigned int nbCount;
     unsigned int sbCount;
@@ -105,6 +126,14 @@ private:
 
     map<MemEvent::id_type,uint64_t>InFlightReqQueue;
 
+    // Requests whose responses are traced while sampling
+    uint64_t sampleCount;
+    set<MemEvent::id_type> SampledReqs;
+
+    ReuseDistanceTracker* reuseTracker;
+    vector<uint64_t> ReuseDistHist;            // Reuse Distance Histogram, log2 bins
+    uint64_t coldAccesses;
+
     TimeConverter picoTimeConv;
     TimeConverter nanoTimeConv;
 
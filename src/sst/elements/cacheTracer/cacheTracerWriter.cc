@@ -0,0 +1,127 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include <string.h>
+
+#include "cacheTracerWriter.h"
+
+using namespace SST::CACHETRACER;
+
+CacheTracerWriter::CacheTracerWriter(FILE* file, size_t bufferSize, unsigned int bufferCount) :
+    output(file), bufferLength(bufferSize), stopping(false) {
+
+    if(0 == bufferLength) { bufferLength = 1; }
+    if(bufferCount < 2) { bufferCount = 2; }
+
+    for(unsigned int i = 0; i < bufferCount; i++){
+        std::vector<char>* buffer = new std::vector<char>();
+        buffer->reserve(bufferLength);
+        freeBuffers.push_back(buffer);
+    }
+
+    current = freeBuffers.back();
+    freeBuffers.pop_back();
+
+    writer = std::thread(&CacheTracerWriter::writeBuffers, this);
+}
+
+CacheTracerWriter::~CacheTracerWriter() {
+    close();
+
+    for(size_t i = 0; i < freeBuffers.size(); i++){
+        delete freeBuffers[i];
+    }
+}
+
+void CacheTracerWriter::write(const void* data, size_t length) {
+    const char* bytes = (const char*) data;
+
+    while(length > 0){
+        const size_t room = bufferLength - current->size();
+        const size_t copyLength = (length < room) ? length : room;
+
+        current->insert(current->end(), bytes, bytes + copyLength);
+        bytes += copyLength;
+        length -= copyLength;
+
+        if(current->size() == bufferLength){
+            queueCurrent();
+
+            std::unique_lock<std::mutex> lock(bufferLock);
+            bufferFree.wait(lock, [this] { return !freeBuffers.empty(); });
+            current = freeBuffers.back();
+            freeBuffers.pop_back();
+        }
+    }
+}
+
+void CacheTracerWriter::queueCurrent() {
+    std::lock_guard<std::mutex> lock(bufferLock);
+    fullBuffers.push_back(current);
+    current = NULL;
+    bufferFull.notify_one();
+}
+
+void CacheTracerWriter::close() {
+    if(!writer.joinable()){
+        return;
+    }
+
+    // Write whatever is left, then wait for the writer to drain the queue
+    if(NULL != current){
+        if(current->empty()){
+            std::lock_guard<std::mutex> lock(bufferLock);
+            freeBuffers.push_back(current);
+            current = NULL;
+        } else {
+            queueCurrent();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(bufferLock);
+        stopping = true;
+        bufferFull.notify_one();
+    }
+
+    writer.join();
+    fflush(output);
+}
+
+void CacheTracerWriter::writeBuffers() {
+    while(true){
+        std::vector<char>* buffer = NULL;
+
+        {
+            std::unique_lock<std::mutex> lock(bufferLock);
+            bufferFull.wait(lock, [this] { return stopping || !fullBuffers.empty(); });
+
+            if(fullBuffers.empty()){
+                return;
+            }
+
+            buffer = fullBuffers.front();
+            fullBuffers.pop_front();
+        }
+
+        fwrite(buffer->data(), 1, buffer->size(), output);
+        buffer->clear();
+
+        std::lock_guard<std::mutex> lock(bufferLock);
+        freeBuffers.push_back(buffer);
+        bufferFree.notify_one();
+    }
+}
@@ -0,0 +1,90 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _CACHETRACER_WRITER_H
+#define _CACHETRACER_WRITER_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SST{
+namespace CACHETRACER {
+
+/*
+ * Record of the binary trace, one per event seen on either bus. The file
+ * starts with CACHETRACER_BINARY_MAGIC, the version and the record size.
+ */
+#define CACHETRACER_BINARY_MAGIC   0x42525443
+#define CACHETRACER_BINARY_VERSION 1
+
+#define CACHETRACER_BUS_NORTH 0
+#define CACHETRACER_BUS_SOUTH 1
+
+struct CacheTracerRecord {
+    uint64_t timestamp;
+    uint64_t nanoseconds;
+    uint64_t addr;
+    uint64_t id;
+    uint64_t responseId;
+    uint32_t idNode;
+    uint32_t responseNode;
+    uint32_t size;
+    uint16_t cmd;
+    uint8_t  bus;
+    uint8_t  reserved;
+};
+
+/*
+ * Buffers trace output and writes it to the file on a separate thread, so
+ * the simulation only copies into memory. Full buffers are queued for the
+ * writer and handed back once written, when all are in use the simulation
+ * waits for one.
+ */
+class CacheTracerWriter {
+public:
+    CacheTracerWriter(FILE* file, size_t bufferSize, unsigned int bufferCount = 4);
+    ~CacheTracerWriter();
+
+    void write(const void* data, size_t length);
+    void close();
+
+private:
+    void writeBuffers();
+    void queueCurrent();
+
+    FILE* output;
+    size_t bufferLength;
+
+    std::thread writer;
+    std::mutex bufferLock;
+    std::condition_variable bufferFull;
+    std::condition_variable bufferFree;
+    std::deque<std::vector<char>*> fullBuffers;
+    std::vector<std::vector<char>*> freeBuffers;
+    bool stopping;
+
+    std::vector<char>* current;
+};
+
+} // namespace CACHETRACER
+} // namespace SST
+
+#endif //_CACHETRACER_WRITER_H
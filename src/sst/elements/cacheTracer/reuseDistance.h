@@ -0,0 +1,108 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _CACHETRACER_REUSE_DISTANCE_H
+#define _CACHETRACER_REUSE_DISTANCE_H
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SST{
+namespace CACHETRACER {
+
+#define CACHETRACER_REUSE_COLD UINT64_MAX
+
+/*
+ * Computes the reuse (stack) distance of each access online: the number of
+ * distinct lines touched since the last access to the same line. Every line
+ * keeps a marker at the time of its last access in a Fenwick tree, so the
+ * distance is the number of markers after it, found in O(log n). When the
+ * tree is full the markers are renumbered to the front, so its size follows
+ * the number of distinct lines rather than the number of accesses.
+ */
+class ReuseDistanceTracker {
+public:
+    ReuseDistanceTracker(uint64_t lineBytes) :
+        lineSize(lineBytes > 0 ? lineBytes : 1), now(0), tree(65537, 0) {}
+
+    uint64_t access(uint64_t addr) {
+        if(now + 1 >= tree.size()){
+            compact();
+        }
+
+        const uint64_t line = addr / lineSize;
+        uint64_t distance = CACHETRACER_REUSE_COLD;
+
+        std::unordered_map<uint64_t, uint64_t>::iterator last = lastAccess.find(line);
+        if(last != lastAccess.end()){
+            distance = prefix(now) - prefix(last->second + 1);
+            update(last->second + 1, -1);
+            last->second = now;
+        } else {
+            lastAccess[line] = now;
+        }
+
+        update(now + 1, 1);
+        now++;
+        return distance;
+    }
+
+    uint64_t distinctLines() const { return lastAccess.size(); }
+
+private:
+    void update(uint64_t pos, int64_t delta) {
+        for(; pos < tree.size(); pos += pos & (~pos + 1)){
+            tree[pos] += delta;
+        }
+    }
+
+    uint64_t prefix(uint64_t pos) const {
+        int64_t sum = 0;
+        for(; pos > 0; pos -= pos & (~pos + 1)){
+            sum += tree[pos];
+        }
+        return (uint64_t) sum;
+    }
+
+    void compact() {
+        std::vector<std::pair<uint64_t, uint64_t> > order;
+        order.reserve(lastAccess.size());
+
+        for(std::unordered_map<uint64_t, uint64_t>::iterator it = lastAccess.begin(); it != lastAccess.end(); it++){
+            order.push_back(std::make_pair(it->second, it->first));
+        }
+        std::sort(order.begin(), order.end());
+
+        tree.assign(std::max(tree.size(), (size_t) (2 * order.size()) + 1), 0);
+        for(now = 0; now < order.size(); now++){
+            lastAccess[order[now].second] = now;
+            update(now + 1, 1);
+        }
+    }
+
+    const uint64_t lineSize;
+    uint64_t now;
+    std::vector<int64_t> tree;
+    std::unordered_map<uint64_t, uint64_t> lastAccess;
+};
+
+} // namespace CACHETRACER
+} // namespace SST
+
+#endif //_CACHETRACER_REUSE_DISTANCE_H
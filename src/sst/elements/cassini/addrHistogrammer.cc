@@ -38,6 +38,56 @@ AddrHistogrammer::AddrHistogrammer(ComponentId_t id, Params& params) : CacheList
     rdHisto = registerStatistic<Addr>("histogram_reads");
     wrHisto = registerStatistic<Addr>("histogram_writes");
 
+    sampleInterval = params.find<uint64_t>("sample_interval", 1);
+    pageSize = params.find<uint64_t>("page_size", 4096);
+    if (sampleInterval == 0 || pageSize == 0)
+        getSimulationOutput().fatal(CALL_INFO, -1, "%s, Error: sample_interval and page_size must be at least 1\n", getName().c_str());
+
+    UnitAlgebra interval(params.find<std::string>("snapshot_interval", "0ns"));
+    snapshotInterval = (interval / UnitAlgebra("1ns")).getRoundedValue();
+    nextSnapshot = snapshotInterval;
+    snapshotFile = nullptr;
+    if (snapshotInterval) {
+        std::string fileName = params.find<std::string>("snapshot_file", "addrHistogrammer.bin");
+        snapshotFile = fopen(fileName.c_str(), "wb");
+        if (!snapshotFile)
+            getSimulationOutput().fatal(CALL_INFO, -1, "%s, Error: cannot open snapshot_file '%s'\n", getName().c_str(), fileName.c_str());
+        fwrite("ADDRHIST", 1, 8, snapshotFile);
+        fwrite(&pageSize, sizeof(uint64_t), 1, snapshotFile);
+    }
+}
+
+AddrHistogrammer::~AddrHistogrammer() {
+    if (snapshotFile)
+        fclose(snapshotFile);
+}
+
+// Write out the counts since the last snapshot and move them into the histograms
+void AddrHistogrammer::writeSnapshot(SimTime_t now) {
+    struct {
+        uint64_t page;
+        uint32_t reads;
+        uint32_t writes;
+    } record;
+    uint64_t header[2] = { now, pages.size() };
+
+    fwrite(header, sizeof(uint64_t), 2, snapshotFile);
+    pages.forEach([&](Addr page, const PageCounts& counts) {
+        record.page = page;
+        record.reads = counts.reads;
+        record.writes = counts.writes;
+        fwrite(&record, sizeof(record), 1, snapshotFile);
+        if (counts.reads)
+            rdHisto->addDataNTimes(counts.reads, page);
+        if (counts.writes)
+            wrHisto->addDataNTimes(counts.writes, page);
+    });
+    pages.clear();
+}
+
+void AddrHistogrammer::finish() {
+    if (snapshotFile)
+        writeSnapshot(getCurrentSimTimeNano());
 }
 
 
@@ -56,6 +106,23 @@ void AddrHistogrammer::notifyAccess(const CacheListenerNotification& notify) {
 
     if(notifyType == EVICT || notifyResType != MISS || vaddr >= cutoff) return;
 
+    Addr page = vaddr - (vaddr % pageSize);
+    if ((page / pageSize) % sampleInterval != 0) return;
+
+    if (snapshotInterval) {
+        SimTime_t ns = getCurrentSimTimeNano();
+        if (ns >= nextSnapshot) {
+            writeSnapshot(ns);
+            nextSnapshot = (ns / snapshotInterval + 1) * snapshotInterval;
+        }
+        if (notifyType == READ || notifyType == WRITE) {
+            PageCounts& counts = pages.insert(page, PageCounts{ 0, 0 });
+            uint32_t& count = (notifyType == READ) ? counts.reads : counts.writes;
+            if (count != UINT32_MAX) count++;
+        }
+        return;
+    }
+
     // // Remove the offset within a bin
     // Addr baseAddr = vaddr & binMask;
     switch (notifyType) {
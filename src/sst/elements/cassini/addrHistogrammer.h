@@ -17,6 +17,8 @@
 #ifndef _H_SST_ADDR_HISTOGRAMMER
 #define _H_SST_ADDR_HISTOGRAMMER
 
+#include <stdio.h>
+
 #include <sst/core/event.h>
 #include <sst/core/sst_types.h>
 #include <sst/core/component.h>
@@ -26,6 +28,7 @@
 #include <sst/elements/memHierarchy/memEvent.h>
 #include <sst/elements/memHierarchy/cacheListener.h>
 
+#include "addrTable.h"
 
 using namespace SST;
 using namespace SST::MemHierarchy;
@@ -37,10 +40,11 @@ namespace Cassini {
 class AddrHistogrammer : public SST::MemHierarchy::CacheListener {
 public:
     AddrHistogrammer(ComponentId_t, Params& params);
-    AddrHistogrammer() : SST::MemHierarchy::CacheListener() {}
-    ~AddrHistogrammer() {};
+    AddrHistogrammer() : SST::MemHierarchy::CacheListener(), snapshotFile(nullptr) {}
+    ~AddrHistogrammer();
 
     void notifyAccess(const CacheListenerNotification& notify) override;
+    void finish() override;
     void registerResponseCallback(Event::HandlerBase *handler) override;
 
     SST_ELI_REGISTER_SUBCOMPONENT(
@@ -54,7 +58,11 @@ public:
 
     SST_ELI_DOCUMENT_PARAMS(
                             { "addr_cutoff", "Addresses above this cutoff won't be recorded", "1TB" },
-                            { "virtual_addr", "Record virtual addresses (1) or physical (0)", 0}
+                            { "virtual_addr", "Record virtual addresses (1) or physical (0)", 0},
+                            { "sample_interval", "Record only 1 in this many pages (every Nth page address)", "1" },
+                            { "page_size", "Size of the pages counted between snapshots. The histograms' bin width should be a multiple of it", "4096" },
+                            { "snapshot_interval", "If non-zero, count accesses per page in a table instead of adding each one to the histograms, and every interval (e.g., 10us) write the counts to snapshot_file and add them to the histograms", "0ns" },
+                            { "snapshot_file", "Binary snapshot file. Header: char[8] \"ADDRHIST\", uint64 page size; then per snapshot: uint64 time (ns), uint64 count, count records of uint64 page address, uint32 reads, uint32 writes", "addrHistogrammer.bin" }
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -63,11 +71,24 @@ public:
     )
 
 private:
+    struct PageCounts {
+        uint32_t reads;     // saturating
+        uint32_t writes;    // saturating
+    };
+
+    void writeSnapshot(SimTime_t now);
+
     std::vector<Event::HandlerBase*> registeredCallbacks;
     bool captureVirtual;
     Addr cutoff; // Don't bin addresses above the cutoff. Helps avoid creating
                 //  histogram entries for the vast address range between the
                 //  heap and the stack.
+    uint64_t sampleInterval;
+    uint64_t pageSize;
+    SimTime_t snapshotInterval; // ns, 0 if off
+    SimTime_t nextSnapshot;
+    FILE* snapshotFile;
+    AddrTable<PageCounts> pages;
     Statistic<Addr>* rdHisto;
     Statistic<Addr>* wrHisto;
 };
@@ -0,0 +1,141 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_CASSINI_ADDR_TABLE
+#define _H_SST_CASSINI_ADDR_TABLE
+
+#include <vector>
+
+#include <sst/elements/memHierarchy/memEvent.h>
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Open addressing table from line or page addresses to small records, for
+ * listeners that look up every cache access. Keys and values sit in two
+ * flat arrays probed linearly, and erase shifts the rest of a probe run
+ * back instead of leaving tombstones. Grows by doubling at 3/4 load. Keys
+ * are aligned addresses, so the all ones address marks an empty slot.
+ */
+template<typename V>
+class AddrTable {
+public:
+    typedef SST::MemHierarchy::Addr Addr;
+
+    AddrTable(size_t capacity = 1024) : count(0) {
+        size_t size = 16;
+        while (size < capacity)
+            size *= 2;
+        keys.assign(size, Empty);
+        values.resize(size);
+        mask = size - 1;
+    }
+
+    size_t size() const { return count; }
+
+    V* find(Addr key) {
+        size_t i = slotOf(key);
+        return keys[i] == key ? &values[i] : nullptr;
+    }
+
+    // Returns the record for key, adding init if it is not there yet
+    V& insert(Addr key, const V& init) {
+        size_t i = slotOf(key);
+        if (keys[i] != key) {
+            if ((count + 1) * 4 > keys.size() * 3) {
+                grow();
+                i = slotOf(key);
+            }
+            keys[i] = key;
+            values[i] = init;
+            count++;
+        }
+        return values[i];
+    }
+
+    void erase(Addr key) {
+        size_t i = slotOf(key);
+        if (keys[i] != key)
+            return;
+        for (size_t j = (i + 1) & mask; keys[j] != Empty; j = (j + 1) & mask) {
+            // Move back entries whose home is not cyclically within (i, j]
+            size_t home = hash(keys[j]);
+            bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+            if (!stays) {
+                keys[i] = keys[j];
+                values[i] = values[j];
+                i = j;
+            }
+        }
+        keys[i] = Empty;
+        count--;
+    }
+
+    void clear() {
+        keys.assign(keys.size(), Empty);
+        count = 0;
+    }
+
+    // Calls f(key, value) for every entry, in no particular order
+    template<typename F>
+    void forEach(F f) const {
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (keys[i] != Empty)
+                f(keys[i], values[i]);
+        }
+    }
+
+private:
+    static constexpr Addr Empty = ~((Addr) 0);
+
+    size_t hash(Addr key) const {
+        key *= 0x9E3779B97F4A7C15ULL;
+        return (size_t) (key ^ (key >> 32)) & mask;
+    }
+
+    size_t slotOf(Addr key) const {
+        size_t i = hash(key);
+        while (keys[i] != Empty && keys[i] != key)
+            i = (i + 1) & mask;
+        return i;
+    }
+
+    void grow() {
+        std::vector<Addr> oldKeys(keys.size() * 2, Empty);
+        std::vector<V> oldValues(values.size() * 2);
+        oldKeys.swap(keys);
+        oldValues.swap(values);
+        mask = keys.size() - 1;
+        for (size_t i = 0; i < oldKeys.size(); i++) {
+            if (oldKeys[i] != Empty) {
+                size_t j = slotOf(oldKeys[i]);
+                keys[j] = oldKeys[i];
+                values[j] = oldValues[i];
+            }
+        }
+    }
+
+    std::vector<Addr> keys;
+    std::vector<V> values;
+    size_t mask;
+    size_t count;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
@@ -0,0 +1,119 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "boprefetch.h"
+
+#include <algorithm>
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace SST::Cassini;
+
+BestOffsetPrefetcher::BestOffsetPrefetcher(ComponentId_t id, Params& params) : FeedbackPrefetcher(id, params, "BestOffsetPrefetcher") {
+    uint32_t maxOffset = params.find<uint32_t>("max_offset", 256);
+    uint32_t rrCount = params.find<uint32_t>("rr_entries", 256);
+    degree = params.find<uint32_t>("degree", 1);
+    rrLatency = params.find<SimTime_t>("rr_latency", 50);
+    scoreMax = params.find<uint32_t>("score_max", 31);
+    roundMax = params.find<uint32_t>("round_max", 100);
+    badScore = params.find<uint32_t>("bad_score", 1);
+
+    if (rrCount == 0 || roundMax == 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: rr_entries and round_max must be at least 1\n", getName().c_str());
+
+    // Offsets whose only prime factors are 2, 3 and 5, as in the original design
+    for (uint32_t n = 1; n <= maxOffset; n++) {
+        uint32_t m = n;
+        while (m % 2 == 0) m /= 2;
+        while (m % 3 == 0) m /= 3;
+        while (m % 5 == 0) m /= 5;
+        if (m == 1)
+            offsets.push_back(n);
+    }
+    if (offsets.empty())
+        output->fatal(CALL_INFO, -1, "%s, Error: max_offset must be at least 1\n", getName().c_str());
+
+    scores.resize(offsets.size(), 0);
+    recentRequests.resize(rrCount, { (Addr) -1, 0 });
+    testIndex = 0;
+    round = 0;
+    bestOffset = 1;
+
+    output->verbose(CALL_INFO, 1, 0, "BestOffsetPrefetcher created, %zu offsets, cache line: %" PRIu64 ", page size: %" PRIu64 "\n",
+        offsets.size(), blockSize, pageSize);
+
+    statLearningPhases = registerStatistic<uint64_t>("learning_phases");
+    statPhasesOff = registerStatistic<uint64_t>("phases_off");
+}
+
+BestOffsetPrefetcher::~BestOffsetPrefetcher() {}
+
+void BestOffsetPrefetcher::train(const CacheListenerNotification& notify, Addr line, bool miss, bool prefetchHit) {
+    // Learn and prefetch on the accesses a prefetch could have saved
+    if (!miss && !prefetchHit)
+        return;
+
+    const SimTime_t now = getCurrentSimTimeNano();
+    const Addr lineNum = line / blockSize;
+
+    // Would the offset under test have prefetched this line in time
+    const int64_t testOffset = offsets[testIndex];
+    if (lineNum >= (Addr) testOffset) {
+        const Addr base = (lineNum - testOffset) * blockSize;
+        RecentRequest& rr = rrEntry(base);
+        if (rr.line == base && now - rr.time >= rrLatency)
+            scores[testIndex]++;
+    }
+
+    bool phaseDone = scores[testIndex] >= scoreMax;
+    testIndex++;
+    if (testIndex == offsets.size()) {
+        testIndex = 0;
+        round++;
+        phaseDone |= round == roundMax;
+    }
+    if (phaseDone)
+        endPhase();
+
+    rrEntry(line) = { line, now };
+
+    for (uint32_t k = 1; bestOffset != 0 && k <= degree; k++)
+        issuePrefetch(line + k * bestOffset * blockSize, line);
+}
+
+void BestOffsetPrefetcher::endPhase() {
+    uint32_t best = 0;
+    for (uint32_t i = 1; i < scores.size(); i++) {
+        if (scores[i] > scores[best])
+            best = i;
+    }
+
+    statLearningPhases->addData(1);
+    if (scores[best] > badScore) {
+        bestOffset = offsets[best];
+    } else {
+        bestOffset = 0;
+        statPhasesOff->addData(1);
+    }
+    output->verbose(CALL_INFO, 2, 0, "Learning phase done, best offset %" PRId64 " score %" PRIu32 ", accuracy %.3f\n",
+        offsets[best], scores[best], getAccuracy());
+
+    std::fill(scores.begin(), scores.end(), 0);
+    testIndex = 0;
+    round = 0;
+}
@@ -0,0 +1,98 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_BEST_OFFSET_PREFETCH
+#define _H_SST_BEST_OFFSET_PREFETCH
+
+#include <vector>
+
+#include "feedbackprefetch.h"
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Best-Offset prefetcher [Michaud, HPCA 2016]. Candidate offsets are tested
+ * one at a time against a table of recent requests: offset d scores when
+ * line X - d was requested at least rr_latency ago, i.e. a prefetch with
+ * offset d triggered then would have arrived in time for X. After a
+ * learning phase the best scoring offset is used, or prefetching is turned
+ * off if no offset scored above bad_score.
+ */
+class BestOffsetPrefetcher : public FeedbackPrefetcher {
+public:
+    BestOffsetPrefetcher(ComponentId_t id, Params& params);
+    ~BestOffsetPrefetcher();
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        BestOffsetPrefetcher,
+            "cassini",
+            "BestOffsetPrefetcher",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Best-Offset Prefetcher [Michaud 2016]",
+            SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        CASSINI_FEEDBACK_ELI_PARAMS,
+        { "max_offset", "Largest offset in lines tested, offsets are the numbers up to this with no prime factor above 5", "256" },
+        { "degree", "Number of lines prefetched per trigger, at offset, 2*offset, ...", "1" },
+        { "rr_entries", "Entries in the recent requests table", "256" },
+        { "rr_latency", "Age in ns a recent request must reach before it can score an offset, about the latency of a prefetch", "50" },
+        { "score_max", "A learning phase ends early once an offset reaches this score", "31" },
+        { "round_max", "Maximum number of rounds over all offsets in a learning phase", "100" },
+        { "bad_score", "Prefetching is off until the next phase if the best offset scores this or less", "1" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        CASSINI_FEEDBACK_ELI_STATS,
+        { "learning_phases", "Number of completed learning phases", "phases", 1 },
+        { "phases_off", "Learning phases after which prefetching was turned off", "phases", 1 }
+    )
+
+protected:
+    void train(const CacheListenerNotification& notify, Addr line, bool miss, bool prefetchHit) override;
+
+private:
+    struct RecentRequest {
+        Addr line;
+        SimTime_t time;
+    };
+
+    void endPhase();
+    RecentRequest& rrEntry(Addr line) { return recentRequests[(line / blockSize) % recentRequests.size()]; }
+
+    std::vector<int64_t> offsets;
+    std::vector<uint32_t> scores;
+    std::vector<RecentRequest> recentRequests;
+    uint32_t testIndex;
+    uint32_t round;
+    uint32_t scoreMax;
+    uint32_t roundMax;
+    uint32_t badScore;
+    uint32_t degree;
+    SimTime_t rrLatency;
+
+    int64_t bestOffset;     // 0 when prefetching is off
+
+    Statistic<uint64_t>* statLearningPhases;
+    Statistic<uint64_t>* statPhasesOff;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
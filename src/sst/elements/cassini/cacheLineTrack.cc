@@ -20,6 +20,7 @@
 #include "cacheLineTrack.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include "sst/core/params.h"
 #include <sst/core/unitAlgebra.h>
@@ -60,6 +61,49 @@ cacheLineTrack::cacheLineTrack(ComponentId_t id, Params& params) : CacheListener
     ageHisto = registerStatistic<SimTime_t>("hist_age_log2");
     evicts = registerStatistic<unsigned int>("evicts");
 
+    sampleInterval = params.find<uint64_t>("sample_interval", 1);
+    if (sampleInterval == 0)
+        getSimulationOutput().fatal(CALL_INFO, -1, "%s, Error: sample_interval must be at least 1\n", getName().c_str());
+
+    UnitAlgebra interval(params.find<std::string>("snapshot_interval", "0ns"));
+    snapshotInterval = (interval / UnitAlgebra("1ns")).getRoundedValue();
+    nextSnapshot = snapshotInterval;
+    snapshotFile = nullptr;
+    if (snapshotInterval) {
+        std::string fileName = params.find<std::string>("snapshot_file", "cacheLineTrack.bin");
+        snapshotFile = fopen(fileName.c_str(), "wb");
+        if (!snapshotFile)
+            getSimulationOutput().fatal(CALL_INFO, -1, "%s, Error: cannot open snapshot_file '%s'\n", getName().c_str(), fileName.c_str());
+        fwrite("CLTRACK1", 1, 8, snapshotFile);
+    }
+}
+
+cacheLineTrack::~cacheLineTrack() {
+    if (snapshotFile)
+        fclose(snapshotFile);
+}
+
+void cacheLineTrack::writeSnapshot(SimTime_t now) {
+    struct {
+        uint64_t line;
+        uint64_t entered;
+        uint16_t reads;
+        uint16_t writes;
+        uint8_t touched;
+        uint8_t pad[3];
+    } record;
+    uint64_t header[2] = { now, cacheLines.size() };
+
+    fwrite(header, sizeof(uint64_t), 2, snapshotFile);
+    memset(&record, 0, sizeof(record));
+    cacheLines.forEach([&](Addr line, const lineTrack& track) {
+        record.line = line;
+        record.entered = track.entered;
+        record.reads = track.reads;
+        record.writes = track.writes;
+        record.touched = track.touched;
+        fwrite(&record, sizeof(record), 1, snapshotFile);
+    });
 }
 
 void cacheLineTrack::notifyAccess(const CacheListenerNotification& notify) {
@@ -71,6 +115,15 @@ void cacheLineTrack::notifyAccess(const CacheListenerNotification& notify) {
 
     // if get a MISS notification, do we get a HIT later?
     if(addr >= cutoff) return;
+    if ((cacheAddr / 64) % sampleInterval != 0) return;
+
+    if (snapshotInterval) {
+        SimTime_t ns = getCurrentSimTimeNano();
+        if (ns >= nextSnapshot) {
+            writeSnapshot(ns);
+            nextSnapshot = (ns / snapshotInterval + 1) * snapshotInterval;
+        }
+    }
 
     // size
 
@@ -78,40 +131,36 @@ void cacheLineTrack::notifyAccess(const CacheListenerNotification& notify) {
     case READ:
     case WRITE:
         {
-            auto iter = cacheLines.find(cacheAddr);
-            if (iter == cacheLines.end()) {
-                // insert a new one
-                SimTime_t now = getCurrentSimCycle();
-                iter = (cacheLines.insert({cacheAddr, lineTrack(now)})).first;
-            }
+            // insert a new one if needed
+            lineTrack& track = cacheLines.insert(cacheAddr, lineTrack(getCurrentSimCycle()));
             // update
             if (notify.getSize() > 8) {
 	      //printf("Not sure what to do here. access size > 8, %d\n", notify.getSize());
             }
             Addr offset = (addr - cacheAddr) / 8;
-            iter->second.touched[offset] = 1;
+            track.touched |= 1 << offset;
             if (notifyType == READ) {
-                iter->second.reads++;
+                if (track.reads != UINT16_MAX) track.reads++;
             } else {
-                iter->second.writes++;
+                if (track.writes != UINT16_MAX) track.writes++;
             }
         }
         break;
     case EVICT:
         // find the cacheline record
         {
-            auto iter = cacheLines.find(cacheAddr);
-            if (iter != cacheLines.end()) {
+            lineTrack* track = cacheLines.find(cacheAddr);
+            if (track) {
                 // record it
-                rdHisto->addData(log2_64(iter->second.reads));
-                wrHisto->addData(log2_64(iter->second.writes));
+                rdHisto->addData(log2_64(track->reads));
+                wrHisto->addData(log2_64(track->writes));
                 SimTime_t now = getCurrentSimCycle();
-                ageHisto->addData(log2_64(now - iter->second.entered));
-                unsigned int touched = iter->second.touched.count();
+                ageHisto->addData(log2_64(now - track->entered));
+                unsigned int touched = __builtin_popcount(track->touched);
                 useHisto->addData(touched);
 		evicts->addData(1);
                 //delete it
-                cacheLines.erase(iter);
+                cacheLines.erase(cacheAddr);
             } else {
                 // couldn't find record?
                 printf("Not sure what to do here. Couldn't find record\n");
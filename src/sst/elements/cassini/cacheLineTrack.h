@@ -17,7 +17,7 @@
 #ifndef _H_SST_ADDR_HISTOGRAMMER
 #define _H_SST_ADDR_HISTOGRAMMER
 
-#include <bitset>
+#include <stdio.h>
 
 #include <sst/core/event.h>
 #include <sst/core/sst_types.h>
@@ -28,6 +28,7 @@
 #include <sst/elements/memHierarchy/memEvent.h>
 #include <sst/elements/memHierarchy/cacheListener.h>
 
+#include "addrTable.h"
 
 using namespace SST;
 using namespace SST::MemHierarchy;
@@ -37,19 +38,20 @@ namespace SST {
 namespace Cassini {
 
 struct lineTrack {
-    bitset<8> touched; // currently hardcoded for 64B (8-word) lines
     SimTime_t entered; // when the line entered the cache
-    uint64_t reads;
-    uint64_t writes;
+    uint16_t reads;    // saturating
+    uint16_t writes;   // saturating
+    uint8_t touched;   // one bit per word, currently hardcoded for 64B (8-word) lines
 
-    lineTrack(SimTime_t now) : touched(0), entered(now), reads(0), writes(0) {;}
+    lineTrack() {;}
+    lineTrack(SimTime_t now) : entered(now), reads(0), writes(0), touched(0) {;}
 };
 
 class cacheLineTrack : public SST::MemHierarchy::CacheListener {
 public:
     cacheLineTrack(ComponentId_t, Params& params);
-    cacheLineTrack() : SST::MemHierarchy::CacheListener() { }
-    ~cacheLineTrack() {};
+    cacheLineTrack() : SST::MemHierarchy::CacheListener(), snapshotFile(nullptr) { }
+    ~cacheLineTrack();
 
     void notifyAccess(const CacheListenerNotification& notify) override;
     void registerResponseCallback(Event::HandlerBase *handler) override;
@@ -64,7 +66,10 @@ public:
     )
 
     SST_ELI_DOCUMENT_PARAMS(
-                            { "addr_cutoff", "Addresses above this cutoff won't be recorded", "1TB" }
+                            { "addr_cutoff", "Addresses above this cutoff won't be recorded", "1TB" },
+                            { "sample_interval", "Track only 1 in this many cache lines (every Nth line address, so whole sets are sampled when N divides the set count)", "1" },
+                            { "snapshot_interval", "If non-zero, write the tracked lines to snapshot_file this often (e.g., 10us)", "0ns" },
+                            { "snapshot_file", "Binary snapshot file. Header: char[8] \"CLTRACK1\"; then per snapshot: uint64 time (ns), uint64 count, count records of uint64 line address, uint64 entry time (cycles), uint16 reads, uint16 writes, uint8 touched words mask, 3 pad bytes", "cacheLineTrack.bin" }
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -76,13 +81,18 @@ public:
     )
 
 private:
-    typedef unordered_map<Addr, lineTrack> cacheTrack_t;
-    cacheTrack_t cacheLines;
+    void writeSnapshot(SimTime_t now);
+
+    AddrTable<lineTrack> cacheLines;
     std::vector<Event::HandlerBase*> registeredCallbacks;
     bool captureVirtual;
     Addr cutoff; // Don't bin addresses above the cutoff. Helps avoid creating
                 //  histogram entries for the vast address range between the
                 //  heap and the stack.
+    uint64_t sampleInterval;
+    SimTime_t snapshotInterval; // ns, 0 if off
+    SimTime_t nextSnapshot;
+    FILE* snapshotFile;
     Statistic<Addr>* rdHisto;
     Statistic<Addr>* wrHisto;
     Statistic<unsigned int>* useHisto;
@@ -0,0 +1,190 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "feedbackprefetch.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace SST::Cassini;
+
+// Halve the accuracy window once this many prefetches resolved so it follows phase changes
+#define CASSINI_FEEDBACK_WINDOW 1024
+
+FeedbackPrefetcher::FeedbackPrefetcher(ComponentId_t id, Params& params, const std::string& name) : CacheListener(id, params) {
+    requireLibrary("memHierarchy");
+
+    uint32_t verbosity = params.find<uint32_t>("verbose", 0);
+    output = new Output(name + "[" + getName() + " | @f:@p:@l] ", verbosity, 0, Output::STDOUT);
+
+    blockSize = params.find<uint64_t>("cache_line_size", 64);
+    pageSize = params.find<uint64_t>("page_size", 4096);
+    overrunPageBoundary = params.find<uint32_t>("overrun_page_boundaries", 0) != 0;
+    trackedCount = params.find<uint32_t>("tracked_prefetches", 256);
+
+    if (blockSize == 0 || pageSize < blockSize)
+        output->fatal(CALL_INFO, -1, "%s, Error: cache_line_size must be non-zero and no larger than page_size\n", getName().c_str());
+    if (trackedCount == 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: tracked_prefetches must be at least 1\n", getName().c_str());
+
+    trackedSeq = 0;
+    issued = useful = late = unused = redundant = dropped = misses = 0;
+    windowUsed = windowResolved = 0;
+
+    statPrefetchEventsIssued = registerStatistic<uint64_t>("prefetches_issued");
+    statPrefetchFiltered = registerStatistic<uint64_t>("prefetches_filtered");
+    statPrefetchIssueCanceledByPageBoundary = registerStatistic<uint64_t>("prefetches_canceled_by_page_boundary");
+    statPrefetchUseful = registerStatistic<uint64_t>("prefetches_useful");
+    statPrefetchLate = registerStatistic<uint64_t>("prefetches_late");
+    statPrefetchUnused = registerStatistic<uint64_t>("prefetches_unused");
+    statPrefetchRedundant = registerStatistic<uint64_t>("prefetches_redundant");
+    statPrefetchDropped = registerStatistic<uint64_t>("prefetches_dropped");
+    statDemandAccesses = registerStatistic<uint64_t>("demand_accesses");
+    statDemandMisses = registerStatistic<uint64_t>("demand_misses");
+}
+
+FeedbackPrefetcher::~FeedbackPrefetcher() {
+    delete output;
+}
+
+void FeedbackPrefetcher::notifyAccess(const CacheListenerNotification& notify) {
+    const NotifyAccessType notifyType = notify.getAccessType();
+    const NotifyResultType notifyResType = notify.getResultType();
+    const Addr line = lineOf(notify.getPhysicalAddress());
+
+    std::unordered_map<Addr, TrackedPrefetch>::iterator entry = tracked.find(line);
+
+    switch (notifyType) {
+    case READ:
+    case WRITE:
+        {
+            bool prefetchHit = false;
+            statDemandAccesses->addData(1);
+            if (entry != tracked.end()) {
+                if (notifyResType == MISS) {
+                    statPrefetchLate->addData(1);
+                    late++;
+                } else {
+                    statPrefetchUseful->addData(1);
+                    useful++;
+                    prefetchHit = true;
+                }
+                resolve(true);
+                tracked.erase(entry);
+            } else if (notifyResType == MISS) {
+                statDemandMisses->addData(1);
+                misses++;
+            }
+            train(notify, line, notifyResType == MISS, prefetchHit);
+        }
+        break;
+    case PREFETCH:
+        // The cache reports each prefetch it takes, with NA for those it dropped
+        if (entry != tracked.end()) {
+            if (notifyResType == MISS) {
+                entry->second.accepted = true;
+            } else {
+                if (notifyResType == HIT) {
+                    statPrefetchRedundant->addData(1);
+                    redundant++;
+                } else {
+                    statPrefetchDropped->addData(1);
+                    dropped++;
+                }
+                tracked.erase(entry);
+            }
+        }
+        break;
+    case EVICT:
+        if (entry != tracked.end() && entry->second.accepted) {
+            statPrefetchUnused->addData(1);
+            unused++;
+            resolve(false);
+            tracked.erase(entry);
+        }
+        break;
+    }
+}
+
+bool FeedbackPrefetcher::issuePrefetch(Addr addr, Addr trigger) {
+    const Addr line = lineOf(addr);
+
+    if (!overrunPageBoundary && (line / pageSize) != (trigger / pageSize)) {
+        output->verbose(CALL_INFO, 4, 0, "Cancel prefetch of 0x%" PRIx64 ", trigger 0x%" PRIx64 " is on another page\n", line, trigger);
+        statPrefetchIssueCanceledByPageBoundary->addData(1);
+        return false;
+    }
+
+    if (tracked.find(line) != tracked.end()) {
+        statPrefetchFiltered->addData(1);
+        return false;
+    }
+
+    // Forget the oldest issued prefetch if it is still waiting
+    if (trackedOrder.size() == trackedCount) {
+        std::unordered_map<Addr, TrackedPrefetch>::iterator oldest = tracked.find(trackedOrder.front().first);
+        if (oldest != tracked.end() && oldest->second.seq == trackedOrder.front().second)
+            tracked.erase(oldest);
+        trackedOrder.pop_front();
+    }
+    tracked[line] = { trackedSeq, false };
+    trackedOrder.push_back(std::make_pair(line, trackedSeq));
+    trackedSeq++;
+
+    output->verbose(CALL_INFO, 2, 0, "Issue prefetch of 0x%" PRIx64 ", trigger 0x%" PRIx64 "\n", line, trigger);
+    statPrefetchEventsIssued->addData(1);
+    issued++;
+
+    // Read requests only, a write would overwrite the line's data
+    for (std::vector<Event::HandlerBase*>::iterator callbackItr = registeredCallbacks.begin(); callbackItr != registeredCallbacks.end(); callbackItr++) {
+        MemEvent* newEv = new MemEvent(getName(), line, line, Command::GetS);
+        newEv->setSize(blockSize);
+        newEv->setPrefetchFlag(true);
+        (*(*callbackItr))(newEv);
+    }
+    return true;
+}
+
+void FeedbackPrefetcher::resolve(bool used) {
+    if (used)
+        windowUsed++;
+    windowResolved++;
+    if (windowResolved == CASSINI_FEEDBACK_WINDOW) {
+        windowUsed /= 2;
+        windowResolved /= 2;
+    }
+}
+
+double FeedbackPrefetcher::getAccuracy() const {
+    return windowResolved ? ((double) windowUsed / (double) windowResolved) : 1.0;
+}
+
+void FeedbackPrefetcher::registerResponseCallback(Event::HandlerBase* handler) {
+    registeredCallbacks.push_back(handler);
+}
+
+void FeedbackPrefetcher::printStats(Output& out) {
+    const uint64_t used = useful + late;
+    const uint64_t demandMisses = useful + late + misses;
+
+    out.output("%s: prefetches issued %" PRIu64 ", useful %" PRIu64 ", late %" PRIu64 ", unused %" PRIu64 ", redundant %" PRIu64 ", dropped %" PRIu64 "\n",
+        getName().c_str(), issued, useful, late, unused, redundant, dropped);
+    out.output("%s: accuracy %.3f, coverage %.3f, lateness %.3f\n", getName().c_str(),
+        issued ? (double) used / (double) issued : 0.0,
+        demandMisses ? (double) useful / (double) demandMisses : 0.0,
+        used ? (double) late / (double) used : 0.0);
+}
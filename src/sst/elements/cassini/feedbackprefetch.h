@@ -0,0 +1,126 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_FEEDBACK_PREFETCH
+#define _H_SST_FEEDBACK_PREFETCH
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/memHierarchy/cacheListener.h>
+
+#include <sst/core/output.h>
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace std;
+
+namespace SST {
+namespace Cassini {
+
+#define CASSINI_FEEDBACK_ELI_PARAMS { "verbose", "Controls the verbosity of the prefetcher", "0" },\
+            { "cache_line_size", "Size of the cache line the prefetcher is attached to", "64" },\
+            { "page_size", "Page size, prefetches do not cross pages unless overrun_page_boundaries is set", "4096" },\
+            { "overrun_page_boundaries", "Allow prefetches to cross page boundaries, 0 is no, 1 is yes", "0" },\
+            { "tracked_prefetches", "Number of most recently issued prefetches followed for accuracy, coverage and lateness", "256" }
+
+#define CASSINI_FEEDBACK_ELI_STATS { "prefetches_issued", "Number of prefetch requests issued", "prefetches", 1 },\
+            { "prefetches_filtered", "Prefetch candidates not issued because the line was already prefetched and not yet used", "prefetches", 1 },\
+            { "prefetches_canceled_by_page_boundary", "Prefetch candidates not issued because they are on another page", "prefetches", 1 },\
+            { "prefetches_useful", "Prefetched lines that a demand request hit", "prefetches", 1 },\
+            { "prefetches_late", "Prefetched lines that a demand request missed on before the cache accepted the prefetch", "prefetches", 1 },\
+            { "prefetches_unused", "Prefetched lines evicted before any demand request used them", "prefetches", 1 },\
+            { "prefetches_redundant", "Prefetches for lines the cache already held", "prefetches", 1 },\
+            { "prefetches_dropped", "Prefetches the cache dropped instead of handling (its Prefetch_drops)", "prefetches", 1 },\
+            { "demand_accesses", "Demand reads and writes seen", "accesses", 1 },\
+            { "demand_misses", "Demand misses to lines that were not prefetched", "misses", 1 }
+
+/*
+ * Base for prefetchers that learn from how their prefetches turn out.
+ * Each issued line is followed until a demand request uses it (useful, or
+ * late if the demand missed first), it is evicted unused, or the cache
+ * reports it redundant or dropped. Subclasses see every demand access
+ * through train() and issue through issuePrefetch(), the running accuracy
+ * is available to throttle on. Accuracy, coverage and lateness are printed
+ * at the end of simulation.
+ */
+class FeedbackPrefetcher : public SST::MemHierarchy::CacheListener {
+public:
+    FeedbackPrefetcher(ComponentId_t id, Params& params, const std::string& name);
+    virtual ~FeedbackPrefetcher();
+
+    void notifyAccess(const CacheListenerNotification& notify) override;
+    void registerResponseCallback(Event::HandlerBase *handler) override;
+    void printStats(Output& out) override;
+
+protected:
+    /* A demand read or write to line. prefetchHit is set if it hit a line this prefetcher brought in */
+    virtual void train(const CacheListenerNotification& notify, Addr line, bool miss, bool prefetchHit) = 0;
+
+    /* Prefetch the line holding addr unless it is on another page than trigger; returns whether it was issued */
+    bool issuePrefetch(Addr addr, Addr trigger);
+
+    /* Fraction of recently resolved prefetches that were used, 1 before any resolved */
+    double getAccuracy() const;
+
+    Addr lineOf(Addr addr) const { return addr - (addr % blockSize); }
+
+    Output* output;
+    uint64_t blockSize;
+    uint64_t pageSize;
+    bool overrunPageBoundary;
+
+private:
+    struct TrackedPrefetch {
+        uint64_t seq;
+        bool accepted;  // the cache has started the fetch
+    };
+
+    void resolve(bool used);
+
+    std::vector<Event::HandlerBase*> registeredCallbacks;
+
+    std::unordered_map<Addr, TrackedPrefetch> tracked;
+    std::deque<std::pair<Addr, uint64_t> > trackedOrder;   // issue order, entries may already be resolved
+    uint32_t trackedCount;
+    uint64_t trackedSeq;
+
+    // Totals for printStats and a decaying window for getAccuracy
+    uint64_t issued, useful, late, unused, redundant, dropped, misses;
+    uint32_t windowUsed, windowResolved;
+
+    Statistic<uint64_t>* statPrefetchEventsIssued;
+    Statistic<uint64_t>* statPrefetchFiltered;
+    Statistic<uint64_t>* statPrefetchIssueCanceledByPageBoundary;
+    Statistic<uint64_t>* statPrefetchUseful;
+    Statistic<uint64_t>* statPrefetchLate;
+    Statistic<uint64_t>* statPrefetchUnused;
+    Statistic<uint64_t>* statPrefetchRedundant;
+    Statistic<uint64_t>* statPrefetchDropped;
+    Statistic<uint64_t>* statDemandAccesses;
+    Statistic<uint64_t>* statDemandMisses;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
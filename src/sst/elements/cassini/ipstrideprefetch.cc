@@ -0,0 +1,78 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "ipstrideprefetch.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace SST::Cassini;
+
+IPStridePrefetcher::IPStridePrefetcher(ComponentId_t id, Params& params) : FeedbackPrefetcher(id, params, "IPStridePrefetcher") {
+    uint32_t tableCount = params.find<uint32_t>("table_entries", 64);
+    confidenceMax = params.find<uint32_t>("confidence_max", 3);
+    confidenceThreshold = params.find<uint32_t>("confidence_threshold", 2);
+    distance = params.find<uint32_t>("distance", 2);
+    degree = params.find<uint32_t>("degree", 1);
+
+    if (tableCount == 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: table_entries must be at least 1\n", getName().c_str());
+    if (confidenceThreshold == 0 || confidenceThreshold > confidenceMax)
+        output->fatal(CALL_INFO, -1, "%s, Error: confidence_threshold must be between 1 and confidence_max (%" PRIu32 "), got %" PRIu32 "\n",
+            getName().c_str(), confidenceMax, confidenceThreshold);
+
+    table.resize(tableCount, { 0, 0, 0, 0, false });
+
+    output->verbose(CALL_INFO, 1, 0, "IPStridePrefetcher created, %" PRIu32 " entries, cache line: %" PRIu64 ", page size: %" PRIu64 "\n",
+        tableCount, blockSize, pageSize);
+
+    statTableReplacements = registerStatistic<uint64_t>("table_replacements");
+}
+
+IPStridePrefetcher::~IPStridePrefetcher() {}
+
+void IPStridePrefetcher::train(const CacheListenerNotification& notify, Addr line, bool miss, bool prefetchHit) {
+    const Addr ip = notify.getInstructionPointer();
+    StrideEntry& entry = table[ip % table.size()];
+
+    if (!entry.valid || entry.ip != ip) {
+        if (entry.valid)
+            statTableReplacements->addData(1);
+        entry = { ip, line, 0, 0, true };
+        return;
+    }
+
+    const int64_t stride = (int64_t) (line - entry.lastLine);
+    if (stride == 0)
+        return;
+    entry.lastLine = line;
+
+    if (stride == entry.stride) {
+        if (entry.confidence < confidenceMax)
+            entry.confidence++;
+    } else if (entry.confidence > 0) {
+        entry.confidence--;
+    } else {
+        entry.stride = stride;
+    }
+
+    if (entry.confidence < confidenceThreshold)
+        return;
+
+    for (uint32_t k = 0; k < degree; k++)
+        issuePrefetch(line + (int64_t) (distance + k) * entry.stride, line);
+}
@@ -0,0 +1,87 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_IP_STRIDE_PREFETCH
+#define _H_SST_IP_STRIDE_PREFETCH
+
+#include <vector>
+
+#include "feedbackprefetch.h"
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Stride prefetcher indexed by the instruction pointer of the access. Each
+ * entry keeps the last line and stride of its instruction and a saturating
+ * confidence counter: a repeated stride raises it, another stride lowers
+ * it and replaces the stride once it reaches 0. Entries at or above
+ * confidence_threshold prefetch 'degree' lines, 'distance' strides ahead.
+ * Accesses without an instruction pointer all share one entry.
+ */
+class IPStridePrefetcher : public FeedbackPrefetcher {
+public:
+    IPStridePrefetcher(ComponentId_t id, Params& params);
+    ~IPStridePrefetcher();
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        IPStridePrefetcher,
+            "cassini",
+            "IPStridePrefetcher",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Instruction pointer stride prefetcher with confidence",
+            SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        CASSINI_FEEDBACK_ELI_PARAMS,
+        { "table_entries", "Entries in the stride table, indexed by instruction pointer", "64" },
+        { "confidence_max", "Saturation value of the confidence counters", "3" },
+        { "confidence_threshold", "Confidence needed to prefetch", "2" },
+        { "distance", "How many strides ahead the first prefetch is", "2" },
+        { "degree", "Number of strides prefetched per access", "1" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        CASSINI_FEEDBACK_ELI_STATS,
+        { "table_replacements", "Stride table entries taken over by another instruction", "entries", 1 }
+    )
+
+protected:
+    void train(const CacheListenerNotification& notify, Addr line, bool miss, bool prefetchHit) override;
+
+private:
+    struct StrideEntry {
+        Addr ip;
+        Addr lastLine;
+        int64_t stride;
+        uint32_t confidence;
+        bool valid;
+    };
+
+    std::vector<StrideEntry> table;
+    uint32_t confidenceMax;
+    uint32_t confidenceThreshold;
+    uint32_t distance;
+    uint32_t degree;
+
+    Statistic<uint64_t>* statTableReplacements;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
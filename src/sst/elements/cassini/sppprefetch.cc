@@ -0,0 +1,143 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sppprefetch.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace SST::Cassini;
+
+SignaturePathPrefetcher::SignaturePathPrefetcher(ComponentId_t id, Params& params) : FeedbackPrefetcher(id, params, "SignaturePathPrefetcher") {
+    uint32_t stCount = params.find<uint32_t>("st_entries", 256);
+    uint32_t ptCount = params.find<uint32_t>("pt_entries", 512);
+    uint32_t ptDeltas = params.find<uint32_t>("pt_deltas", 4);
+    uint32_t signatureBits = params.find<uint32_t>("signature_bits", 12);
+    counterMax = params.find<uint32_t>("counter_max", 15);
+    prefetchThreshold = params.find<double>("prefetch_threshold", 0.25);
+    maxDepth = params.find<uint32_t>("max_depth", 8);
+
+    if (stCount == 0 || ptCount == 0 || ptDeltas == 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: st_entries, pt_entries and pt_deltas must be at least 1\n", getName().c_str());
+    if (signatureBits == 0 || signatureBits > 31)
+        output->fatal(CALL_INFO, -1, "%s, Error: signature_bits must be between 1 and 31, got %" PRIu32 "\n", getName().c_str(), signatureBits);
+    if (counterMax < 2)
+        output->fatal(CALL_INFO, -1, "%s, Error: counter_max must be at least 2\n", getName().c_str());
+    if (prefetchThreshold <= 0.0)
+        output->fatal(CALL_INFO, -1, "%s, Error: prefetch_threshold must be greater than 0\n", getName().c_str());
+
+    signatureMask = (1u << signatureBits) - 1;
+    linesPerPage = pageSize / blockSize;
+
+    signatures.resize(stCount, { 0, 0, 0, false });
+    PatternEntry empty = { 0, std::vector<int32_t>(ptDeltas, 0), std::vector<uint32_t>(ptDeltas, 0) };
+    patterns.resize(ptCount, empty);
+
+    output->verbose(CALL_INFO, 1, 0, "SignaturePathPrefetcher created, cache line: %" PRIu64 ", page size: %" PRIu64 "\n",
+        blockSize, pageSize);
+
+    statLookaheadDepth = registerStatistic<uint64_t>("lookahead_depth");
+}
+
+SignaturePathPrefetcher::~SignaturePathPrefetcher() {}
+
+uint32_t SignaturePathPrefetcher::nextSignature(uint32_t signature, int32_t delta) const {
+    // Deltas enter the signature as 7 bit sign-magnitude values
+    uint32_t encoded = delta < 0 ? (((uint32_t) -delta) & 0x3F) | 0x40 : ((uint32_t) delta) & 0x3F;
+    return ((signature << 3) ^ encoded) & signatureMask;
+}
+
+void SignaturePathPrefetcher::updatePattern(uint32_t signature, int32_t delta) {
+    PatternEntry& entry = patternEntry(signature);
+
+    uint32_t slot = 0;
+    for (uint32_t i = 0; i < entry.deltas.size(); i++) {
+        if (entry.counts[i] != 0 && entry.deltas[i] == delta) {
+            slot = i;
+            break;
+        }
+        if (entry.counts[i] < entry.counts[slot])
+            slot = i;
+    }
+    if (entry.counts[slot] == 0 || entry.deltas[slot] != delta) {
+        entry.deltas[slot] = delta;
+        entry.counts[slot] = 0;
+    }
+
+    entry.counts[slot]++;
+    entry.sigCount++;
+    if (entry.sigCount >= counterMax || entry.counts[slot] >= counterMax) {
+        entry.sigCount /= 2;
+        for (uint32_t i = 0; i < entry.counts.size(); i++)
+            entry.counts[i] /= 2;
+    }
+}
+
+void SignaturePathPrefetcher::train(const CacheListenerNotification& notify, Addr line, bool miss, bool prefetchHit) {
+    const Addr page = line / pageSize;
+    const int32_t offset = (line % pageSize) / blockSize;
+
+    SignatureEntry& st = signatures[page % signatures.size()];
+    if (!st.valid || st.page != page) {
+        st = { page, offset, 0, true };
+        return;
+    }
+
+    const int32_t delta = offset - st.lastOffset;
+    if (delta == 0)
+        return;
+
+    updatePattern(st.signature, delta);
+    st.signature = nextSignature(st.signature, delta);
+    st.lastOffset = offset;
+
+    // Follow the most likely deltas ahead while the path stays confident
+    const Addr pageBase = line - (line % pageSize);
+    uint32_t signature = st.signature;
+    int32_t current = offset;
+    double confidence = 1.0;
+    uint32_t depth = 0;
+
+    while (depth < maxDepth) {
+        PatternEntry& entry = patternEntry(signature);
+        if (entry.sigCount == 0)
+            break;
+
+        uint32_t best = 0;
+        for (uint32_t i = 0; i < entry.deltas.size(); i++) {
+            if (entry.counts[i] == 0)
+                continue;
+            if (entry.counts[i] > entry.counts[best])
+                best = i;
+
+            int32_t target = current + entry.deltas[i];
+            if (target >= 0 && target < linesPerPage && confidence * entry.counts[i] / entry.sigCount >= prefetchThreshold)
+                issuePrefetch(pageBase + target * blockSize, line);
+        }
+        if (entry.counts[best] == 0)
+            break;
+
+        depth++;
+        confidence *= (double) entry.counts[best] / entry.sigCount * getAccuracy();
+        current += entry.deltas[best];
+        if (confidence < prefetchThreshold || current < 0 || current >= linesPerPage)
+            break;
+        signature = nextSignature(signature, entry.deltas[best]);
+    }
+
+    statLookaheadDepth->addData(depth);
+}
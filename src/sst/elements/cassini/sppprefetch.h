@@ -0,0 +1,102 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_SIGNATURE_PATH_PREFETCH
+#define _H_SST_SIGNATURE_PATH_PREFETCH
+
+#include <vector>
+
+#include "feedbackprefetch.h"
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Signature Path Prefetcher [Kim et al., MICRO 2016]. The signature table
+ * compresses the last few line deltas seen in each page into a signature,
+ * the pattern table counts which delta followed each signature. On an
+ * access the prefetcher walks the most likely path of deltas ahead,
+ * multiplying the confidence of every step, and prefetches each delta whose
+ * confidence stays above prefetch_threshold. Deeper steps are also scaled by
+ * the measured prefetch accuracy, so an inaccurate phase looks less far
+ * ahead. Prefetches stay within the page of the access.
+ */
+class SignaturePathPrefetcher : public FeedbackPrefetcher {
+public:
+    SignaturePathPrefetcher(ComponentId_t id, Params& params);
+    ~SignaturePathPrefetcher();
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        SignaturePathPrefetcher,
+            "cassini",
+            "SignaturePathPrefetcher",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Signature Path Prefetcher [Kim 2016]",
+            SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        CASSINI_FEEDBACK_ELI_PARAMS,
+        { "st_entries", "Entries in the signature table, one page each", "256" },
+        { "pt_entries", "Entries in the pattern table, indexed by signature", "512" },
+        { "pt_deltas", "Deltas counted per pattern table entry", "4" },
+        { "signature_bits", "Width of a signature", "12" },
+        { "counter_max", "Saturation value of the pattern counters, all counters of an entry are halved on reaching it", "15" },
+        { "prefetch_threshold", "Minimum path confidence to prefetch and to keep looking ahead", "0.25" },
+        { "max_depth", "Maximum number of deltas looked ahead", "8" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        CASSINI_FEEDBACK_ELI_STATS,
+        { "lookahead_depth", "Number of deltas looked ahead per access", "deltas", 2 }
+    )
+
+protected:
+    void train(const CacheListenerNotification& notify, Addr line, bool miss, bool prefetchHit) override;
+
+private:
+    struct SignatureEntry {
+        Addr page;
+        int32_t lastOffset;
+        uint32_t signature;
+        bool valid;
+    };
+
+    struct PatternEntry {
+        uint32_t sigCount;
+        std::vector<int32_t> deltas;
+        std::vector<uint32_t> counts;
+    };
+
+    uint32_t nextSignature(uint32_t signature, int32_t delta) const;
+    PatternEntry& patternEntry(uint32_t signature) { return patterns[signature % patterns.size()]; }
+    void updatePattern(uint32_t signature, int32_t delta);
+
+    std::vector<SignatureEntry> signatures;
+    std::vector<PatternEntry> patterns;
+    uint32_t signatureMask;
+    uint32_t counterMax;
+    uint32_t maxDepth;
+    double prefetchThreshold;
+    int32_t linesPerPage;
+
+    Statistic<uint64_t>* statLookaheadDepth;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
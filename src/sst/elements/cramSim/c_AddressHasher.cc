@@ -84,6 +84,8 @@ void c_AddressHasher::build(Params &params) {
 
   // pull config file sizes
   k_pBurstSize = (uint32_t)params.find<uint32_t>("numBytesPerTransaction", 1,l_found);
+  k_bankXorHash = params.find<bool>("boolBankXorHash", false);
+  k_channelXorHash = params.find<bool>("boolChannelXorHash", false);
   assert(k_pNumPseudoChannels>0);
 
   // check for simple version address map
@@ -267,132 +269,81 @@ void c_AddressHasher::build(Params &params) {
     }
   } // else found in map
 
-} // c_AddressHasher(SST::Params)
-
+  compileFields();
 
-void c_AddressHasher::fillHashedAddress(c_HashedAddress *x_hashAddr, const ulong x_address) {
-  ulong l_cur=0;
-  ulong l_cnt=0;
-
-  //channel
-  auto l_bitPos = m_bitPositions.find("C");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setChannel(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
-
-      l_cur |= l_tmp;
-    }
-    x_hashAddr->setChannel(l_cur);
+  if((k_bankXorHash || k_channelXorHash) &&
+     m_structureSizes["r"] < (k_bankXorHash ? m_bankBits : 0) + (k_channelXorHash ? m_channelBits : 0)) {
+    output->fatal(CALL_INFO, -1, "%s, Error!: XOR hashing needs at least %u row bits in the address map, but only %u are mapped. Aborting!\n",
+            getName().c_str(), (k_bankXorHash ? m_bankBits : 0) + (k_channelXorHash ? m_channelBits : 0), m_structureSizes["r"]);
   }
 
-  //pseudo channel
-   l_bitPos = m_bitPositions.find("c");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setPChannel(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
-
-      l_cur |= l_tmp;
-    }
-    x_hashAddr->setPChannel(l_cur);
-  }
+} // c_AddressHasher(SST::Params)
 
-  //rank
-  l_bitPos = m_bitPositions.find("R");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setRank(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
 
-      l_cur |= l_tmp;
-    }
-    x_hashAddr->setRank(l_cur);
-  }
+// compileFields
+// turns the bit positions of each field into runs of consecutive address
+// bits so that decoding a field is a few mask and shift operations
+void c_AddressHasher::compileFields() {
+  static const char *l_fieldNames[k_numFields] = { "C", "c", "R", "B", "b", "r", "l", "h" };
 
-  //bankGroup
-  l_bitPos = m_bitPositions.find("B");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setBankGroup(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
+  for(unsigned l_field = 0; l_field < k_numFields; l_field++) {
+    m_fieldRuns[l_field].clear();
 
-      l_cur |= l_tmp;
+    auto l_bitPos = m_bitPositions.find(l_fieldNames[l_field]);
+    if(l_bitPos == m_bitPositions.end()) {
+      continue;
     }
-    x_hashAddr->setBankGroup(l_cur);
-  }
-
-  //bank
-  l_bitPos = m_bitPositions.find("b");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setBank(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
 
-      l_cur |= l_tmp;
-    }
-    x_hashAddr->setBank(l_cur);
-  }
+    const vector<uint> &l_positions = l_bitPos->second;
+    ulong l_cnt = 0;
+    while(l_cnt < l_positions.size()) {
+      // extend the run while the address bits stay consecutive
+      ulong l_len = 1;
+      while(l_cnt + l_len < l_positions.size() && l_positions[l_cnt + l_len] == l_positions[l_cnt] + l_len) {
+        l_len++;
+      }
 
-  //row
-  l_bitPos = m_bitPositions.find("r");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setRow(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
+      c_BitRun l_run;
+      l_run.mask = ((l_len >= 64) ? ~(ulong)0 : (((ulong)1 << l_len) - 1)) << l_positions[l_cnt];
+      l_run.shift = l_positions[l_cnt] - l_cnt;
+      m_fieldRuns[l_field].push_back(l_run);
 
-      l_cur |= l_tmp;
+      l_cnt += l_len;
     }
-    x_hashAddr->setRow(l_cur);
   }
 
-  //col
-  l_bitPos = m_bitPositions.find("l");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setCol(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
-
-      l_cur |= l_tmp;
-    }
-    x_hashAddr->setCol(l_cur);
-  }
+  m_bankBits = (uint32_t)log2(k_pNumBanks) + (uint32_t)log2(k_pNumBankGroups);
+  m_channelBits = (uint32_t)log2(k_pNumChannels) + (uint32_t)log2(k_pNumPseudoChannels);
+} // compileFields()
 
-  //cacheline
-  l_bitPos = m_bitPositions.find("h");
-  if(l_bitPos == m_bitPositions.end()) { // not found
-    x_hashAddr->setCacheline(0);
-  } else {
-    l_cur=0;
-    for(l_cnt=0;l_cnt<l_bitPos->second.size();l_cnt++) {
-      ulong l_val = l_bitPos->second[l_cnt];
-      ulong l_tmp = (((ulong)1 << l_val) & x_address) >> (l_val - l_cnt);
 
-      l_cur |= l_tmp;
-    }
-    x_hashAddr->setCacheline(l_cur);
+void c_AddressHasher::fillHashedAddress(c_HashedAddress *x_hashAddr, const ulong x_address) {
+  ulong l_channel   = extractField(k_fieldChannel, x_address);
+  ulong l_pChannel  = extractField(k_fieldPChannel, x_address);
+  ulong l_bankGroup = extractField(k_fieldBankGroup, x_address);
+  ulong l_bank      = extractField(k_fieldBank, x_address);
+  ulong l_row       = extractField(k_fieldRow, x_address);
+
+  // XOR hashing permutes the banks (and channels) seen by each row, so
+  // it stays a one to one mapping of addresses
+  if(k_bankXorHash) {
+    l_bank      ^= l_row & (k_pNumBanks - 1);
+    l_bankGroup ^= (l_row / k_pNumBanks) & (k_pNumBankGroups - 1);
   }
+  if(k_channelXorHash) {
+    ulong l_rowBits = k_bankXorHash ? (l_row >> m_bankBits) : l_row;
+    l_pChannel ^= l_rowBits & (k_pNumPseudoChannels - 1);
+    l_channel  ^= (l_rowBits / k_pNumPseudoChannels) & (k_pNumChannels - 1);
+  }
+
+  x_hashAddr->setChannel(l_channel);
+  x_hashAddr->setPChannel(l_pChannel);
+  x_hashAddr->setRank(extractField(k_fieldRank, x_address));
+  x_hashAddr->setBankGroup(l_bankGroup);
+  x_hashAddr->setBank(l_bank);
+  x_hashAddr->setRow(l_row);
+  x_hashAddr->setCol(extractField(k_fieldCol, x_address));
+  x_hashAddr->setCacheline(extractField(k_fieldCacheline, x_address));
 
   unsigned l_bankId =
     x_hashAddr->getBank()
@@ -70,6 +70,8 @@ namespace SST {
             SST_ELI_DOCUMENT_PARAMS(
                 {"numBytesPerTransaction", "Number of bytes retrieved for every transaction", "1"},
                 {"strAddressMapStr","String defining the address mapping scheme","_r_l_b_R_B_h_"},
+                {"boolBankXorHash","XOR the bank and bankgroup bits with the low row bits to spread row conflicts across banks","0"},
+                {"boolChannelXorHash","XOR the channel and pseudo channel bits with the low row bits above those used by the bank hash","0"},
             )
 
             SST_ELI_DOCUMENT_PORTS(
@@ -113,6 +115,30 @@ namespace SST {
             std::map<std::string, std::vector<uint> > m_bitPositions;
             std::map<std::string, uint> m_structureSizes;  // Used for checking that params agree
 
+            // m_bitPositions compiled for decode. Each field is the sum of
+            // (address & mask) >> shift over runs of consecutive bits.
+            enum { k_fieldChannel, k_fieldPChannel, k_fieldRank, k_fieldBankGroup,
+                   k_fieldBank, k_fieldRow, k_fieldCol, k_fieldCacheline, k_numFields };
+            struct c_BitRun {
+                ulong mask;
+                unsigned shift;
+            };
+            std::vector<c_BitRun> m_fieldRuns[k_numFields];
+
+            bool k_bankXorHash;
+            bool k_channelXorHash;
+            unsigned m_bankBits;        // bank plus bankgroup bits used by the bank hash
+            unsigned m_channelBits;     // channel plus pseudo channel bits
+
+            void compileFields();
+            inline ulong extractField(unsigned x_field, const ulong x_address) const {
+              ulong l_val = 0;
+              for(const c_BitRun &l_run : m_fieldRuns[x_field]) {
+                l_val |= (x_address & l_run.mask) >> l_run.shift;
+              }
+              return l_val;
+            }
+
             // regex replacement stuff
             void parsePattern(std::string *x_inStr, std::pair<std::string, uint> *x_outPair);
 
@@ -56,6 +56,11 @@ public:
     void handleCommand(c_BankCommand* x_bankCommandPtr, SimTime_t x_simCycle);
 
     void clockTic(SimTime_t x_cycle);
+    // same as x_cycles calls to clockTic, only valid while isSettled()
+    void skipCycles(SimTime_t x_cycles);
+    bool isSettled() {
+        return (m_bankState->isSettled());
+    }
 
     std::list<e_BankCommandType> getAllowedCommands();
 
@@ -76,6 +76,15 @@ public:
         return m_currentState;
     }
 
+    // true if clockTic has nothing left to do but count down, so cycles can
+    // be skipped with skipCycles instead of being ticked one by one
+    virtual bool isSettled() {
+        return false;
+    }
+
+    virtual void skipCycles(SimTime_t x_cycles) {
+    }
+
 //private:
 protected:
     std::map<std::string, unsigned>* m_bankParams;
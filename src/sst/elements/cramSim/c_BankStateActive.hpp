@@ -61,6 +61,9 @@ public:
     virtual bool isCommandAllowed(c_BankCommand* x_cmdPtr,
             c_BankInfo* x_bankPtr);
 
+    virtual bool isSettled();
+    virtual void skipCycles(SimTime_t x_cycles);
+
 private:
 
     std::list<e_BankCommandType> m_allowedCommands;
@@ -31,6 +31,7 @@
 
 #include <memory>
 #include <iostream>
+#include <limits>
 #include <assert.h>
 
 #include "c_BankStateIdle.hpp"
@@ -175,3 +176,14 @@ bool c_BankStateIdle::isCommandAllowed(c_BankCommand* x_cmdPtr,
     return false;
 
 }
+
+// Once the timer is below 2 the previous command has been responded to, from
+// there clockTic only keeps decrementing it while no command is received
+bool c_BankStateIdle::isSettled() {
+    return (nullptr == m_receivedCommandPtr)
+            && ((2 > m_timer) || (m_timer > std::numeric_limits<SimTime_t>::max() / 2));
+}
+
+void c_BankStateIdle::skipCycles(SimTime_t x_cycles) {
+    m_timer -= x_cycles;
+}
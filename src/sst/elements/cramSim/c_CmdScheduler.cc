@@ -133,6 +133,15 @@ void c_CmdScheduler::run(SimTime_t simCycle){
 }
 
 
+bool c_CmdScheduler::isIdle() {
+    for (auto &l_chQueues : m_cmdQueues)
+        for (auto &l_cmdQueue : l_chQueues)
+            if (!l_cmdQueue.empty())
+                return false;
+    return true;
+}
+
+
 bool c_CmdScheduler::push(c_BankCommand* x_cmd) {
     unsigned l_ch=x_cmd->getHashedAddress()->getChannel();
     unsigned l_bank=x_cmd->getHashedAddress()->getBankId() % m_numBanksPerChannel;
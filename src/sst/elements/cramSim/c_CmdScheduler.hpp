@@ -71,7 +71,9 @@ namespace SST{
 
             void run(SimTime_t simCycle);
             bool push(c_BankCommand* x_cmd);
+            bool isIdle();
             unsigned getToken(const c_HashedAddress &x_addr);
+            unsigned getNumBanksPerChannel() const { return m_numBanksPerChannel; }
 
 
         private:
@@ -27,6 +27,8 @@
 
 #include "sst_config.h"
 
+#include <limits>
+
 #include "c_Controller.hpp"
 #include "c_TxnReqEvent.hpp"
 #include "c_TxnResEvent.hpp"
@@ -116,6 +118,8 @@ c_Controller::c_Controller(ComponentId_t id, Params &params) :
         output->output("boolEnableQuickRes param value is missing... disabled\n");
     }
 
+    k_enableIdleClockGating = (uint32_t)params.find<uint32_t>("boolEnableIdleClockGating", 0);
+
     // get configured clock frequency
     k_controllerClockFreqStr = (std::string)params.find<std::string>("strControllerClockFrequency", "1GHz", l_found);
 
@@ -123,8 +127,10 @@ c_Controller::c_Controller(ComponentId_t id, Params &params) :
     configure_link();
 
     //set our clock
-    registerClock(k_controllerClockFreqStr,
-                  new Clock::Handler2<c_Controller,&c_Controller::clockTic>(this));
+    m_clockHandler = new Clock::Handler2<c_Controller,&c_Controller::clockTic>(this);
+    m_clockTC = registerClock(k_controllerClockFreqStr, m_clockHandler);
+    m_lastClockCycle = 0;
+    m_isClockGated = false;
 
 
 
@@ -145,12 +151,16 @@ void c_Controller::configure_link() {
     // Controller <-> Device (Cmd)
     m_memLink = configureLink("memLink",
                               new Event::Handler2<c_Controller,&c_Controller::handleInDeviceResPtrEvent>(this));
+    // Controller -> Controller (refresh wake up while the clock is gated)
+    m_wakeLink = configureSelfLink("wakeLink", k_controllerClockFreqStr,
+                              new Event::Handler2<c_Controller,&c_Controller::handleWakeEvent>(this));
 }
 
 
 // clock event handler
 bool c_Controller::clockTic(SST::Cycle_t clock) {
 
+    m_lastClockCycle = clock;
     m_simCycle++;
 
     sendResponse();
@@ -217,11 +227,49 @@ bool c_Controller::clockTic(SST::Cycle_t clock) {
     // 6. run device driver
     m_deviceDriver->run();
 
+    // 7. stop the clock until there is something to do again
+    if (k_enableIdleClockGating && isIdle()) {
+        SimTime_t l_cyclesToRefresh = m_deviceDriver->getCyclesToRefresh();
+        if (l_cyclesToRefresh > 0) {
+            if (l_cyclesToRefresh != std::numeric_limits<SimTime_t>::max())
+                m_wakeLink->send(l_cyclesToRefresh, new c_ControllerWakeEvent());
+            m_isClockGated = true;
+            return true;
+        }
+    }
 
     return false;
 }
 
 
+bool c_Controller::isIdle() {
+    return m_ReqQ.empty() && m_ResQ.empty() && m_txnScheduler->isIdle() && m_txnConverter->isIdle()
+            && m_cmdScheduler->isIdle() && m_deviceDriver->isIdle();
+}
+
+
+// restart the clock and bring the per-cycle state up to the cycle before the next tick
+void c_Controller::wakeUp() {
+    if (!m_isClockGated)
+        return;
+
+    SST::Cycle_t l_nextCycle = reregisterClock(m_clockTC, m_clockHandler);
+    SimTime_t l_skipped = l_nextCycle - m_lastClockCycle - 1;
+
+    m_simCycle += l_skipped;
+    m_deviceDriver->skipCycles(l_skipped);
+    m_txnConverter->skipCycles(l_skipped);
+    m_isClockGated = false;
+}
+
+
+void c_Controller::handleWakeEvent(SST::Event *ev) {
+    // a transaction may have restarted the clock already
+    wakeUp();
+    delete ev;
+}
+
+
 void c_Controller::sendCommand(c_BankCommand* cmd)
 {
      c_CmdReqEvent *l_cmdReqEventPtr = new c_CmdReqEvent();
@@ -273,6 +321,8 @@ void c_Controller::handleIncomingTransaction(SST::Event *ev){
         newTxn->print(debug,"[c_Controller.handleIncommingTransaction]",m_simCycle);
         #endif
 
+        wakeUp();
+
         m_ReqQ.push_back(newTxn);
         m_ResQ.push_back(newTxn);
 
@@ -287,6 +337,8 @@ void c_Controller::handleIncomingTransaction(SST::Event *ev){
 void c_Controller::handleInDeviceResPtrEvent(SST::Event *ev){
     c_CmdResEvent* l_cmdResEventPtr = dynamic_cast<c_CmdResEvent*>(ev);
     if (l_cmdResEventPtr) {
+        wakeUp();
+
         ulong l_resSeqNum = l_cmdResEventPtr->m_payload->getSeqNum();
         // need to find which txn matches the command seq number in the txnResQ
         c_Transaction* l_txnRes = nullptr;
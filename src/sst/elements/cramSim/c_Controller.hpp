@@ -50,6 +50,14 @@ namespace SST {
         class c_TxnConverter;
         class c_CmdScheduler;
 
+        // Wakes a clock gated controller up when the next refresh is due
+        class c_ControllerWakeEvent : public SST::Event {
+        public:
+            c_ControllerWakeEvent() : SST::Event() {}
+
+            ImplementSerializable(SST::CramSim::c_ControllerWakeEvent);
+        };
+
         class c_Controller : public SST::Component {
 
         public:
@@ -65,7 +73,8 @@ namespace SST {
 
             SST_ELI_DOCUMENT_PARAMS(
                 {"verbose", "Output verbosity", "0"},
-                {"strControllerClockFrequency", "Controller clock frequency, with units", "1GHz" }
+                {"strControllerClockFrequency", "Controller clock frequency, with units", "1GHz" },
+                {"boolEnableIdleClockGating", "Unregister the clock while no transaction is in flight and every bank only counts down its timers, waking up for the next refresh or transaction", "0" }
             )
 
             SST_ELI_DOCUMENT_PORTS(
@@ -105,6 +114,11 @@ namespace SST {
             void sendResponse();
             void sendRequest();
             void configure_link();
+
+            // clock gating while the controller is idle
+            bool isIdle();
+            void wakeUp();
+            void handleWakeEvent(SST::Event *ev);
             // Transaction Generator <-> Controller Handlers
             void handleIncomingTransaction(SST::Event *ev);
 
@@ -128,9 +142,17 @@ namespace SST {
 
             // params for system configuration
             int k_enableQuickResponse;
+            int k_enableIdleClockGating;
 
             // clock frequency
             std::string k_controllerClockFreqStr;
+            TimeConverter m_clockTC;
+            Clock::HandlerBase* m_clockHandler;
+            SST::Cycle_t m_lastClockCycle;
+            bool m_isClockGated;
+
+            // Controller -> Controller wake up for the next refresh
+            SST::Link *m_wakeLink;
 
             // Transaction Generator <-> Controller Links
             SST::Link *m_txngenLink;
@@ -33,6 +33,7 @@
 #include <vector>
 #include <list>
 #include <algorithm>
+#include <limits>
 #include <assert.h>
 
 // CramSim includes
@@ -379,6 +380,79 @@ void c_DeviceDriver::build(Params& params) {
     m_isACTIssued.resize(m_numRanks, false);
 }
 
+
+/*!
+ * true if no command is waiting to issue or to be sent and every bank only
+ * counts down its timers, so that update() and run() can be skipped
+ */
+bool c_DeviceDriver::isIdle() {
+    if (!m_inputQ.empty() || !m_outputQ.empty())
+        return false;
+
+    for (auto &l_cmdQ : m_refreshCmdQ)
+        if (!l_cmdQ.empty())
+            return false;
+
+    for (auto &l_bank : m_banks)
+        if (!l_bank->isSettled())
+            return false;
+
+    return true;
+}
+
+
+/*!
+ * number of cycles that can be skipped before run() creates the next refresh
+ */
+SimTime_t c_DeviceDriver::getCyclesToRefresh() {
+    SimTime_t l_cycles = std::numeric_limits<SimTime_t>::max();
+    if (k_useRefresh)
+        for (unsigned l_id = 0; l_id < m_numRanks; l_id++)
+            l_cycles = std::min(l_cycles, (SimTime_t) m_currentREFICount[l_id]);
+    return l_cycles;
+}
+
+
+/*!
+ * advance the per-cycle state as x_cycles calls to update() and run() would
+ * while idle, x_cycles must not be more than getCyclesToRefresh()
+ */
+void c_DeviceDriver::skipCycles(SimTime_t x_cycles) {
+    if (0 == x_cycles)
+        return;
+
+    for (auto &l_bank : m_banks)
+        l_bank->skipCycles(x_cycles);
+
+    for (int l_rankNum = 0; l_rankNum < m_numRanks; l_rankNum++) {
+        std::list<unsigned> &l_tracker = m_cmdACTFAWtrackers[l_rankNum];
+        SimTime_t l_shift = std::min(x_cycles, (SimTime_t) l_tracker.size());
+        for (SimTime_t l_i = 0; l_i < l_shift; l_i++) {
+            l_tracker.push_back((0 == l_i && m_isACTIssued[l_rankNum]) ? 1 : 0);
+            l_tracker.pop_front();
+        }
+    }
+
+    m_inflightWrites.clear();
+    m_blockBank.clear();
+    m_blockBank.resize(m_numBanks, false);
+    m_isACTIssued.clear();
+    m_isACTIssued.resize(m_numRanks, false);
+
+    // the command bus is released in both update() and run()
+    for (auto &value : m_blockColCmd)
+        value = (value > 2 * x_cycles) ? value - 2 * x_cycles : 0;
+    for (auto &value : m_blockRowCmd)
+        value = (value > 2 * x_cycles) ? value - 2 * x_cycles : 0;
+
+    if (k_useRefresh) {
+        for (unsigned l_id = 0; l_id < m_numRanks; l_id++) {
+            assert(m_currentREFICount[l_id] >= x_cycles);
+            m_currentREFICount[l_id] -= x_cycles;
+        }
+    }
+}
+
 /*!
  *
  */
@@ -136,6 +136,9 @@ public:
     virtual bool isCmdAllowed(c_BankCommand* x_bankCommandPtr);
     virtual c_BankInfo* getBankInfo(unsigned x_bankId);
     void update(SimTime_t simCycle);
+    bool isIdle();
+    SimTime_t getCyclesToRefresh();
+    void skipCycles(SimTime_t x_cycles);
 
     unsigned getNumChannel(){return k_numChannels;}
     unsigned getNumPChPerChannel(){return k_numPChannelsPerChannel;}
@@ -47,12 +47,6 @@ c_TraceFileReader::c_TraceFileReader(SST::ComponentId_t x_id, SST::Params& x_par
     {
         output->output("TraceFileReader: tracefile name is %s\n", m_traceFileName.c_str());
     }
-    m_traceFileStream = new std::ifstream(m_traceFileName, std::ifstream::in);
-    if(!(*m_traceFileStream))
-    {
-        output->fatal(CALL_INFO, -1, "Unable to open trace file %s Aborting!\n", m_traceFileName.c_str());
-    }
-
     // get trace file type
     std::string l_traceFileType= x_params.find<std::string>("traceFileType", "DEFAULT", l_found);
     if (!l_found)
@@ -67,11 +61,41 @@ c_TraceFileReader::c_TraceFileReader(SST::ComponentId_t x_id, SST::Params& x_par
     {
         m_traceType=e_TracefileType ::USIMM;
     }
+    else if(l_traceFileType=="COLUMNAR")
+    {
+        m_traceType=e_TracefileType::COLUMNAR;
+    }
     else
     {
         output->fatal(CALL_INFO, -1, "TraceFileReader: trace file type error!!\n");
     }
 
+    m_traceFileStream = NULL;
+    m_columnarTrace = NULL;
+    m_traceStartCycle = x_params.find<uint64_t>("traceStartCycle", 0);
+    m_traceEndCycle = x_params.find<uint64_t>("traceEndCycle", 0);
+
+    if(m_traceType==e_TracefileType::COLUMNAR)
+    {
+        m_columnarTrace = new SST::Prospero::ColumnarTraceReader();
+        if(!m_columnarTrace->open(m_traceFileName))
+        {
+            output->fatal(CALL_INFO, -1, "Unable to open trace file %s, %s Aborting!\n", m_traceFileName.c_str(), m_columnarTrace->getError().c_str());
+        }
+        if(m_traceStartCycle > 0 && !m_columnarTrace->seekToTime(m_traceStartCycle))
+        {
+            output->fatal(CALL_INFO, -1, "Unable to seek to cycle %" PRIu64 " of trace file %s, %s Aborting!\n", m_traceStartCycle, m_traceFileName.c_str(), m_columnarTrace->getError().c_str());
+        }
+    }
+    else
+    {
+        m_traceFileStream = new std::ifstream(m_traceFileName, std::ifstream::in);
+        if(!(*m_traceFileStream))
+        {
+            output->fatal(CALL_INFO, -1, "Unable to open trace file %s Aborting!\n", m_traceFileName.c_str());
+        }
+    }
+
     // tell the simulator not to end without us
     registerAsPrimaryComponent();
     primaryComponentDoNotEndSim();
@@ -79,11 +103,62 @@ c_TraceFileReader::c_TraceFileReader(SST::ComponentId_t x_id, SST::Params& x_par
 }
 
 
+c_TraceFileReader::~c_TraceFileReader()
+{
+    delete m_traceFileStream;
+    delete m_columnarTrace;
+}
+
+
+bool c_TraceFileReader::readColumnarTxn(e_TransactionType* x_txnType, ulong* x_txnAddress, unsigned* x_txnInterval)
+{
+    SST::Prospero::ColumnarTraceRecord l_record;
+
+    if(!m_columnarTrace->next(&l_record))
+    {
+        if(!m_columnarTrace->getError().empty())
+        {
+            output->fatal(CALL_INFO, -1, "TraceFileReader: error reading trace file %s, %s\n", m_traceFileName.c_str(), m_columnarTrace->getError().c_str());
+        }
+        return false;
+    }
+
+    if(m_traceEndCycle > 0 && l_record.time >= m_traceEndCycle)
+    {
+        return false;
+    }
+
+    *x_txnType = (COLUMNAR_TRACE_OP_WRITE == l_record.op) ? e_TransactionType::WRITE : e_TransactionType::READ;
+    *x_txnAddress = (ulong) l_record.address;
+    *x_txnInterval = (unsigned) (l_record.time - m_traceStartCycle);
+    return true;
+}
+
+
 void c_TraceFileReader::createTxn()
 {
 // check if txn can fit inside Req q
     while(m_txnReqQ.size()<k_numTxnPerCycle)
     {
+        if(m_traceType==e_TracefileType::COLUMNAR)
+        {
+            e_TransactionType l_txnType;
+            ulong l_txnAddress = 0;
+            unsigned l_txnInterval = 0;
+
+            if(!readColumnarTxn(&l_txnType, &l_txnAddress, &l_txnInterval))
+            {
+                primaryComponentOKToEndSim();
+                output->output("TraceFileReader: Ran out of txn's to read\n");
+                break;
+            }
+
+            c_Transaction* l_txn = new c_Transaction(m_seqNum, l_txnType, l_txnAddress, 1);
+            m_txnReqQ.push_back(std::make_pair(l_txn, l_txnInterval));
+            m_seqNum++;
+            continue;
+        }
+
         std::string l_line;
         if (std::getline(*m_traceFileStream, l_line)) {
             char_delimiter sep(" ");
@@ -27,6 +27,8 @@
 #include <sst/core/component.h>
 #include <sst/core/link.h>
 
+#include <sst/elements/prospero/prostraceformat.h>
+
 //local includes
 #include "c_Transaction.hpp"
 #include "c_TxnGen.hpp"
@@ -50,7 +52,9 @@ namespace SST {
                 {"maxOutstandingReqs", "Maximum number of the outstanding requests", NULL},
                 {"numTxnPerCycle", "The number of transactions generated per cycle", NULL},
                 {"traceFile", "Location of trace file to read", NULL},
-                {"traceFileType", "Trace file type (DEFAULT or USIMM)",NULL},
+                {"traceFileType", "Trace file type (DEFAULT, USIMM or COLUMNAR)",NULL},
+                {"traceStartCycle", "COLUMNAR traces only, replay the records from this cycle on, relative to it", "0"},
+                {"traceEndCycle", "COLUMNAR traces only, stop before the first record at or after this cycle, 0 replays to the end", "0"},
             )
 
             SST_ELI_DOCUMENT_PORTS(
@@ -69,17 +73,22 @@ namespace SST {
             )
 
             c_TraceFileReader(SST::ComponentId_t x_id, SST::Params& x_params);
-            ~c_TraceFileReader(){}
+            ~c_TraceFileReader();
         private:
             enum e_TracefileType{
                 DEFAULT,   //DRAMsim2 type
-                USIMM
+                USIMM,
+                COLUMNAR   //block compressed, shared with prospero
             };
             virtual void createTxn();
+            bool readColumnarTxn(e_TransactionType* x_txnType, ulong* x_txnAddress, unsigned* x_txnInterval);
 
             //params for internal microarcitecture
             std::string m_traceFileName;
             std::ifstream *m_traceFileStream;
+            SST::Prospero::ColumnarTraceReader *m_columnarTrace;
+            uint64_t m_traceStartCycle;
+            uint64_t m_traceEndCycle;
 
             e_TracefileType m_traceType;
         };
@@ -42,7 +42,7 @@ c_Transaction::c_Transaction(ulong x_seqNum, e_TransactionType x_txnMnemonic,
                     ulong x_addr, unsigned x_dataWidth) :
         m_seqNum(x_seqNum), m_txnMnemonic(x_txnMnemonic), m_addr(x_addr), m_isResponseReady(
                 false), m_numWaitingCommands(0), m_dataWidth(x_dataWidth), m_processed(
-                false) {
+                false), m_threadId(0) {
 
     m_hasHashedAddr= false;
 
@@ -103,6 +103,14 @@ unsigned c_Transaction::getDataWidth() const {
     return (m_dataWidth);
 }
 
+unsigned c_Transaction::getThreadId() const {
+    return (m_threadId);
+}
+
+void c_Transaction::setThreadId(unsigned x_threadId) {
+    m_threadId = x_threadId;
+}
+
 bool c_Transaction::isProcessed() const {
     return (m_processed);
 }
@@ -152,5 +160,6 @@ void c_Transaction::serialize_order(SST::Core::Serialization::serializer &ser)
   SST_SER(m_numWaitingCommands);
   SST_SER(m_dataWidth);
   SST_SER(m_processed);
+  SST_SER(m_threadId);
   SST_SER(m_hasHashedAddr);
 }
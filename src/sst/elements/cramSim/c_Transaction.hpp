@@ -69,6 +69,7 @@ private:
   unsigned m_numWaitingCommands;
   unsigned m_dataWidth;
   bool m_processed; //<! flag that is set when this transaction is split into commands
+  unsigned m_threadId; //<! id of the requesting thread, used by the fairness aware schedulers
 
   //std::list<c_BankCommand*> m_cmdPtrList; //<! list of c_BankCommand shared_ptrs that compose this c_Transaction
   std::list<ulong> m_cmdSeqNumList; //<! list of c_BankCommand Sequence numbers that compose this c_Transaction
@@ -101,7 +102,8 @@ public:
   ulong getSeqNum() const;
 
   unsigned getDataWidth() const;
-  unsigned getThreadId() const; // FIXME
+  unsigned getThreadId() const; //<! returns the id of the requesting thread, 0 if unknown
+  void setThreadId(unsigned x_threadId);
   bool isProcessed() const;
   void isProcessed(bool x_processed);
   void print() const;
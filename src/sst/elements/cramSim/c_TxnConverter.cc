@@ -161,6 +161,17 @@ void c_TxnConverter::run(SimTime_t simCycle){
 }
 
 
+// advance the auto precharge timers of the pseudo open page policy as
+// x_cycles calls to run() with no transaction would
+void c_TxnConverter::skipCycles(SimTime_t x_cycles) {
+    if(k_bankPolicy==2) {
+        for (auto &it:m_bankInfo)
+            if(it->isRowOpen())
+                it->skipCycles(x_cycles);
+    }
+}
+
+
 
 void c_TxnConverter::push(c_Transaction* newTxn) {
 
@@ -94,6 +94,8 @@ public:
 
     void run(SimTime_t simCycle);
     void push(c_Transaction* newTxn); // receive txns from txnGen into req q
+    bool isIdle() { return m_inputQ.empty(); }
+    void skipCycles(SimTime_t x_cycles);
     c_BankInfo* getBankInfo(unsigned x_bankId);
 
 private:
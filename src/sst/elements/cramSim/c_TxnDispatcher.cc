@@ -53,8 +53,21 @@ c_TxnDispatcher::c_TxnDispatcher(ComponentId_t x_id, Params &params):Component(x
     }
     assert(k_numLanes>0);
 
+    params.find_array<uint32_t>("laneIdxBits", m_laneIdxBits);
+    if(!m_laneIdxBits.empty()) {
+        if(((uint64_t)1 << m_laneIdxBits.size()) != k_numLanes) {
+            output->fatal(CALL_INFO, -1, "laneIdxBits has %zu bits, which does not select between %" PRIu32 " lanes\n",
+                    m_laneIdxBits.size(), k_numLanes);
+        }
+        for(uint32_t l_bit : m_laneIdxBits) {
+            if(l_bit > 63) {
+                output->fatal(CALL_INFO, -1, "laneIdxBits error! bit %" PRIu32 " is not an address bit\n", l_bit);
+            }
+        }
+    }
+
     string l_laneIdxString = (string) params.find<string>("laneIdxPos", "13:12", l_found);
-    if(k_numLanes>1) {
+    if(k_numLanes>1 && m_laneIdxBits.empty()) {
         if (!l_found) {
             output->fatal(CALL_INFO, -1, "the bit position of lane index is not specified... it should be \"end:start\"\n");
         } else {
@@ -158,6 +171,13 @@ uint32_t c_TxnDispatcher::getLaneIdx(uint64_t x_addr)
 {
     if(k_numLanes==1)
         return 0;
+    else if(!m_laneIdxBits.empty()) {
+        uint32_t l_laneIdx = 0;
+        for(size_t i = 0; i < m_laneIdxBits.size(); i++) {
+            l_laneIdx |= ((x_addr >> m_laneIdxBits[i]) & 1) << i;
+        }
+        return l_laneIdx;
+    }
     else
         return (m_laneIdxMask & x_addr) >> m_laneIdxStart;
 }
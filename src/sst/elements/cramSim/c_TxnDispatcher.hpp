@@ -53,7 +53,8 @@ namespace SST{
 
             SST_ELI_DOCUMENT_PARAMS(
                 {"numLanes", "Total number of lanes", NULL},
-                {"laneIdxPosition", "Bit posiiton of the lane index in the address.. [End:Start]", NULL},
+                {"laneIdxPos", "Bit position of the lane index in the address.. [End:Start]", NULL},
+                {"laneIdxBits", "Array of address bits forming the lane index, lowest lane bit first. Overrides laneIdxPos and lets each lane own the (possibly non-contiguous) channel or pseudo channel bits of the address map. Must hold log2(numLanes) bits.", "[]"},
             )
 
             SST_ELI_DOCUMENT_PORTS(
@@ -86,6 +87,7 @@ namespace SST{
              uint32_t m_laneIdxStart;
              uint32_t m_laneIdxEnd;
              uint64_t m_laneIdxMask;
+             std::vector<uint32_t> m_laneIdxBits;
 
              uint32_t k_numLanes;
              Output dbg;
@@ -32,6 +32,7 @@
 
 // std includes
 #include <iostream>
+#include <algorithm>
 #include <assert.h>
 
 // local includes
@@ -68,6 +69,18 @@ void c_TxnScheduler::build(Params& x_params) {
     else if(l_txnSchedulingPolicy=="FRFCFS")
     {
         k_txnSchedulingPolicy=e_txnSchedulingPolicy::FRFCFS;
+    }
+    else if(l_txnSchedulingPolicy=="BLISS")
+    {
+        k_txnSchedulingPolicy=e_txnSchedulingPolicy::BLISS;
+    }
+    else if(l_txnSchedulingPolicy=="ATLAS")
+    {
+        k_txnSchedulingPolicy=e_txnSchedulingPolicy::ATLAS;
+    }
+    else if(l_txnSchedulingPolicy=="PARBS")
+    {
+        k_txnSchedulingPolicy=e_txnSchedulingPolicy::PARBS;
     } else
     {
         m_out->fatal(CALL_INFO, 1, "unsupported txnSchedulingPolicy (%s),, exit\n", l_txnSchedulingPolicy.c_str());
@@ -114,15 +127,56 @@ void c_TxnScheduler::build(Params& x_params) {
         m_minNumPendingWrite = (unsigned) ((float) k_numTxnQEntries * k_minPendingWriteThreshold);
         m_flushWriteQueue = false;
     }
+
+    //parameters of the fairness aware policies
+    k_numSources = (unsigned) x_params.find<unsigned>("numTxnSources", 1);
+    if (k_numSources == 0) {
+        m_out->fatal(CALL_INFO, 1, "numTxnSources should be greater than 0\n");
+    }
+    k_sourceAddrShift = (unsigned) x_params.find<unsigned>("txnSourceAddrShift", 0);
+    k_blissBlacklistThreshold = (unsigned) x_params.find<unsigned>("blissBlacklistThreshold", 4);
+    k_blissClearingInterval = (SimTime_t) x_params.find<SimTime_t>("blissClearingInterval", 10000);
+    k_atlasQuantum = (SimTime_t) x_params.find<SimTime_t>("atlasQuantum", 10000);
+    k_atlasAlpha = (double) x_params.find<double>("atlasAlpha", 0.875);
+    k_atlasStarvationThreshold = (SimTime_t) x_params.find<SimTime_t>("atlasStarvationThreshold", 100000);
+    k_parbsMarkingCap = (unsigned) x_params.find<unsigned>("parbsMarkingCap", 5);
+    if (k_parbsMarkingCap == 0 || k_blissClearingInterval == 0 || k_atlasQuantum == 0) {
+        m_out->fatal(CALL_INFO, 1, "parbsMarkingCap, blissClearingInterval and atlasQuantum should be greater than 0\n");
+    }
+
+    m_simCycle = 0;
+    m_blacklisted.resize(k_numSources, false);
+    m_lastServedSource = 0;
+    m_numConsecutiveServed = 0;
+    m_nextBlacklistClear = k_blissClearingInterval;
+    m_attainedService.resize(k_numSources, 0);
+    m_totalAttainedService.resize(k_numSources, 0);
+    m_atlasRank.resize(k_numSources, 0);
+    m_nextQuantum = k_atlasQuantum;
+
+    m_profiler = nullptr;
+    m_numBanksPerChannel = m_cmdScheduler->getNumBanksPerChannel();
+    string l_profileFile = (string) x_params.find<std::string>("profileFile", "");
+    if (!l_profileFile.empty()) {
+        m_profiler = new SST::MemHierarchy::MemProfiler((SimTime_t) x_params.find<SimTime_t>("profileWindow", 1000),
+                m_numChannels, m_numBanksPerChannel,
+                (unsigned) x_params.find<unsigned>("profileDelayBins", 16),
+                (SimTime_t) x_params.find<SimTime_t>("profileDelayBinWidth", 8));
+        if (!m_profiler->open(l_profileFile)) {
+            m_out->fatal(CALL_INFO, 1, "profileFile %s cannot be opened\n", l_profileFile.c_str());
+        }
+    }
 }
 
 c_TxnScheduler::~c_TxnScheduler() {
-
+    delete m_profiler;
 }
 
 
 void c_TxnScheduler::run(SimTime_t simCycle){
 
+    m_simCycle = simCycle;
+    updateSourceState();
 
     for(int l_channelID=0; l_channelID<m_numChannels; l_channelID++) {
 
@@ -172,6 +226,12 @@ void c_TxnScheduler::run(SimTime_t simCycle){
                 l_nextTxn->print(output, "[c_TxnScheduler]",simCycle);
                 #endif
 
+                if (m_profiler) {
+                    unsigned l_bank = l_nextTxn->getHashedAddress().getBankId() % m_numBanksPerChannel;
+                    m_profiler->schedule(simCycle, l_channelID, l_bank, isRowHit(l_nextTxn), simCycle - l_queue->getArrival(l_nextTxn));
+                    m_profiler->access(simCycle, l_channelID, l_bank, !l_nextTxn->isRead(), l_nextTxn->getDataWidth());
+                }
+
                 // pop it from inputQ
                 popTxn(*l_queue, l_nextTxn);
 
@@ -191,27 +251,32 @@ c_Transaction* c_TxnScheduler::getNextTxn(TxnQueue& x_queue, int x_ch)
 
         //FCFS
         if(k_txnSchedulingPolicy == e_txnSchedulingPolicy::FCFS) {
-            if(m_cmdScheduler->getToken(x_queue.front()->getHashedAddress())>=3) {
-                if(hasDependancy(x_queue.front(), x_ch)==false)
-                    l_nxtTxn = x_queue.front();
-            }
-        }//FRFCFS
+            if(isIssuable(x_queue.front(), x_ch))
+                l_nxtTxn = x_queue.front();
+        }//FRFCFS: the oldest row hit, otherwise the youngest issuable transaction
         else if(k_txnSchedulingPolicy == e_txnSchedulingPolicy::FRFCFS) {
-            for (auto &l_txn: x_queue) {
-                if (m_cmdScheduler->getToken(l_txn->getHashedAddress()) >= 3) {
-                    if(hasDependancy(l_txn, x_ch)==false)
-                        l_nxtTxn = l_txn;
-                    else
-                        continue;
-
-                    c_BankInfo *l_bankInfo = m_txnConverter->getBankInfo(l_txn->getHashedAddress().getBankId());
-
-                    if (l_bankInfo->isRowOpen()
-                        && l_bankInfo->getOpenRowNum() == l_txn->getHashedAddress().getRow()) {
+            l_nxtTxn = getNextRowHitTxn(x_queue, x_ch);
+            if (l_nxtTxn == nullptr) {
+                for (TxnQueue::reverse_iterator l_txnItr = x_queue.rbegin(); l_txnItr != x_queue.rend(); ++l_txnItr) {
+                    if (isIssuable(*l_txnItr, x_ch)) {
+                        l_nxtTxn = *l_txnItr;
                         break;
                     }
                 }
             }
+        }//BLISS, ATLAS and PARBS
+        else if(k_txnSchedulingPolicy == e_txnSchedulingPolicy::BLISS
+                || k_txnSchedulingPolicy == e_txnSchedulingPolicy::ATLAS
+                || k_txnSchedulingPolicy == e_txnSchedulingPolicy::PARBS) {
+            if (k_txnSchedulingPolicy == e_txnSchedulingPolicy::PARBS && x_queue.getNumMarked() == 0)
+                formBatch(x_queue);
+
+            for (auto &l_txn: x_queue) {
+                if (!isIssuable(l_txn, x_ch))
+                    continue;
+                if (l_nxtTxn == nullptr || isHigherPriority(x_queue, l_txn, l_nxtTxn))
+                    l_nxtTxn = l_txn;
+            }
         }
         else
         {
@@ -222,11 +287,213 @@ c_Transaction* c_TxnScheduler::getNextTxn(TxnQueue& x_queue, int x_ch)
 }
 
 
+bool c_TxnScheduler::isIssuable(c_Transaction* x_txn, int x_ch)
+{
+    return m_cmdScheduler->getToken(x_txn->getHashedAddress())>=3 && hasDependancy(x_txn, x_ch)==false;
+}
+
+
+bool c_TxnScheduler::isRowHit(c_Transaction* x_txn)
+{
+    c_BankInfo *l_bankInfo = m_txnConverter->getBankInfo(x_txn->getHashedAddress().getBankId());
+
+    return l_bankInfo->isRowOpen() && l_bankInfo->getOpenRowNum() == x_txn->getHashedAddress().getRow();
+}
+
+
+// Only the queues of banks with an open row are searched
+c_Transaction* c_TxnScheduler::getNextRowHitTxn(TxnQueue& x_queue, int x_ch)
+{
+    c_Transaction* l_nxtTxn = nullptr;
+
+    for (auto &l_bank: x_queue.banks()) {
+        c_BankInfo *l_bankInfo = m_txnConverter->getBankInfo(l_bank.first);
+        if (!l_bankInfo->isRowOpen() || l_bank.second.empty())
+            continue;
+        if (m_cmdScheduler->getToken(l_bank.second.front()->getHashedAddress()) < 3)
+            continue;
+
+        for (auto &l_txn: l_bank.second) {
+            if (l_txn->getHashedAddress().getRow() == l_bankInfo->getOpenRowNum() && hasDependancy(l_txn, x_ch)==false) {
+                if (l_nxtTxn == nullptr || x_queue.getOrder(l_txn) < x_queue.getOrder(l_nxtTxn))
+                    l_nxtTxn = l_txn;
+                break;
+            }
+        }
+    }
+
+    return l_nxtTxn;
+}
+
+
+unsigned c_TxnScheduler::getSource(c_Transaction* x_txn)
+{
+    if (k_sourceAddrShift != 0)
+        return (x_txn->getAddress() >> k_sourceAddrShift) % k_numSources;
+    return x_txn->getThreadId() % k_numSources;
+}
+
+
+// Ties on the policy specific criteria go to the row hit, then to the oldest
+bool c_TxnScheduler::isHigherPriority(TxnQueue& x_queue, c_Transaction* x_txn, c_Transaction* x_other)
+{
+    unsigned l_src = x_queue.getSource(x_txn);
+    unsigned l_otherSrc = x_queue.getSource(x_other);
+
+    if (k_txnSchedulingPolicy == e_txnSchedulingPolicy::BLISS) {
+        //non-blacklisted sources first
+        if (m_blacklisted[l_src] != m_blacklisted[l_otherSrc])
+            return !m_blacklisted[l_src];
+    } else if (k_txnSchedulingPolicy == e_txnSchedulingPolicy::ATLAS) {
+        //starving transactions first, then the sources with the least attained service
+        bool l_starving = m_simCycle - x_queue.getArrival(x_txn) > k_atlasStarvationThreshold;
+        bool l_otherStarving = m_simCycle - x_queue.getArrival(x_other) > k_atlasStarvationThreshold;
+        if (l_starving != l_otherStarving)
+            return l_starving;
+        if (m_atlasRank[l_src] != m_atlasRank[l_otherSrc])
+            return m_atlasRank[l_src] < m_atlasRank[l_otherSrc];
+    } else if (k_txnSchedulingPolicy == e_txnSchedulingPolicy::PARBS) {
+        //marked transactions first, then row hits, then the sources with the shortest job
+        bool l_marked = x_queue.isMarked(x_txn);
+        if (l_marked != x_queue.isMarked(x_other))
+            return l_marked;
+        bool l_rowHit = isRowHit(x_txn);
+        if (l_rowHit != isRowHit(x_other))
+            return l_rowHit;
+        std::vector<unsigned> &l_rank = x_queue.batchRank();
+        if (!l_rank.empty() && l_rank[l_src] != l_rank[l_otherSrc])
+            return l_rank[l_src] < l_rank[l_otherSrc];
+        return x_queue.getOrder(x_txn) < x_queue.getOrder(x_other);
+    }
+
+    bool l_rowHit = isRowHit(x_txn);
+    if (l_rowHit != isRowHit(x_other))
+        return l_rowHit;
+    return x_queue.getOrder(x_txn) < x_queue.getOrder(x_other);
+}
+
+
+// clear the BLISS blacklist and rank the sources for ATLAS at the end of their intervals
+void c_TxnScheduler::updateSourceState()
+{
+    if (k_txnSchedulingPolicy == e_txnSchedulingPolicy::BLISS && m_simCycle >= m_nextBlacklistClear) {
+        m_blacklisted.assign(k_numSources, false);
+        m_nextBlacklistClear = m_simCycle + k_blissClearingInterval;
+    }
+
+    if (k_txnSchedulingPolicy == e_txnSchedulingPolicy::ATLAS && m_simCycle >= m_nextQuantum) {
+        std::vector<unsigned> l_sources(k_numSources);
+        for (unsigned l_src = 0; l_src < k_numSources; l_src++) {
+            m_totalAttainedService[l_src] = k_atlasAlpha * m_totalAttainedService[l_src]
+                                            + (1 - k_atlasAlpha) * m_attainedService[l_src];
+            m_attainedService[l_src] = 0;
+            l_sources[l_src] = l_src;
+        }
+        std::stable_sort(l_sources.begin(), l_sources.end(), [this](unsigned a, unsigned b) {
+            return m_totalAttainedService[a] < m_totalAttainedService[b];
+        });
+        for (unsigned l_i = 0; l_i < k_numSources; l_i++)
+            m_atlasRank[l_sources[l_i]] = l_i;
+        m_nextQuantum = m_simCycle + k_atlasQuantum;
+    }
+}
+
+
+// Mark up to parbsMarkingCap of the oldest transactions of each source to each
+// bank, and rank the sources by the most marked transactions they have to a bank
+void c_TxnScheduler::formBatch(TxnQueue& x_queue)
+{
+    std::vector<unsigned> l_maxBankLoad(k_numSources, 0);
+    std::vector<unsigned> l_totalLoad(k_numSources, 0);
+
+    for (auto &l_bank: x_queue.banks()) {
+        std::vector<unsigned> l_bankLoad(k_numSources, 0);
+        for (auto &l_txn: l_bank.second) {
+            unsigned l_src = x_queue.getSource(l_txn);
+            if (l_bankLoad[l_src] < k_parbsMarkingCap) {
+                l_bankLoad[l_src]++;
+                x_queue.mark(l_txn);
+            }
+        }
+        for (unsigned l_src = 0; l_src < k_numSources; l_src++) {
+            l_maxBankLoad[l_src] = std::max(l_maxBankLoad[l_src], l_bankLoad[l_src]);
+            l_totalLoad[l_src] += l_bankLoad[l_src];
+        }
+    }
+
+    std::vector<unsigned> l_sources(k_numSources);
+    for (unsigned l_src = 0; l_src < k_numSources; l_src++)
+        l_sources[l_src] = l_src;
+    std::stable_sort(l_sources.begin(), l_sources.end(), [&](unsigned a, unsigned b) {
+        if (l_maxBankLoad[a] != l_maxBankLoad[b])
+            return l_maxBankLoad[a] < l_maxBankLoad[b];
+        return l_totalLoad[a] < l_totalLoad[b];
+    });
+
+    std::vector<unsigned> &l_rank = x_queue.batchRank();
+    l_rank.resize(k_numSources);
+    for (unsigned l_i = 0; l_i < k_numSources; l_i++)
+        l_rank[l_sources[l_i]] = l_i;
+}
+
+
 void c_TxnScheduler::popTxn(TxnQueue &x_txnQ, c_Transaction* x_Txn)
 {
+    unsigned l_src = x_txnQ.getSource(x_Txn);
+
+    if (k_txnSchedulingPolicy == e_txnSchedulingPolicy::BLISS) {
+        if (l_src == m_lastServedSource) {
+            if (++m_numConsecutiveServed > k_blissBlacklistThreshold)
+                m_blacklisted[l_src] = true;
+        } else {
+            m_lastServedSource = l_src;
+            m_numConsecutiveServed = 1;
+        }
+    } else if (k_txnSchedulingPolicy == e_txnSchedulingPolicy::ATLAS) {
+        m_attainedService[l_src] += 1;
+    }
+
     x_txnQ.remove(x_Txn);
 }
 
+
+void TxnQueue::push_back(c_Transaction* x_txn, unsigned x_source, SimTime_t x_arrival)
+{
+    Entry l_entry;
+    l_entry.pos = m_txns.insert(m_txns.end(), x_txn);
+    List &l_bank = m_banks[x_txn->getHashedAddress().getBankId()];
+    l_entry.bankPos = l_bank.insert(l_bank.end(), x_txn);
+    l_entry.order = m_nextOrder++;
+    l_entry.source = x_source;
+    l_entry.arrival = x_arrival;
+    l_entry.marked = false;
+    m_entries[x_txn] = l_entry;
+}
+
+
+void TxnQueue::remove(c_Transaction* x_txn)
+{
+    std::unordered_map<c_Transaction*, Entry>::iterator l_it = m_entries.find(x_txn);
+    if (l_it == m_entries.end())
+        return;
+
+    m_txns.erase(l_it->second.pos);
+    m_banks[x_txn->getHashedAddress().getBankId()].erase(l_it->second.bankPos);
+    if (l_it->second.marked)
+        m_numMarked--;
+    m_entries.erase(l_it);
+}
+
+
+void TxnQueue::mark(c_Transaction* x_txn)
+{
+    Entry &l_entry = m_entries.at(x_txn);
+    if (!l_entry.marked) {
+        l_entry.marked = true;
+        m_numMarked++;
+    }
+}
+
 bool c_TxnScheduler::push(c_Transaction* newTxn)
 {
     int l_channelId=newTxn->getHashedAddress().getChannel();
@@ -234,7 +501,7 @@ bool c_TxnScheduler::push(c_Transaction* newTxn)
     if(!k_isReadFirstScheduling)
     {
         if (m_txnQ.at(l_channelId).size() < k_numTxnQEntries) {
-            m_txnQ.at(l_channelId).push_back(newTxn);
+            m_txnQ.at(l_channelId).push_back(newTxn, getSource(newTxn), m_simCycle);
             l_success=true;
         } else
             l_success=false;
@@ -243,7 +510,7 @@ bool c_TxnScheduler::push(c_Transaction* newTxn)
         if(newTxn->isRead())
         {
             if(m_txnReadQ[l_channelId].size()< k_numTxnQEntries) {
-                m_txnReadQ[l_channelId].push_back(newTxn);
+                m_txnReadQ[l_channelId].push_back(newTxn, getSource(newTxn), m_simCycle);
                 l_success = true;
             }
             else
@@ -252,7 +519,7 @@ bool c_TxnScheduler::push(c_Transaction* newTxn)
         {
             if(m_txnWriteQ[l_channelId].size()< k_numTxnQEntries) {
                 l_success=true;
-                m_txnWriteQ[l_channelId].push_back(newTxn);
+                m_txnWriteQ[l_channelId].push_back(newTxn, getSource(newTxn), m_simCycle);
             }else
                 l_success=false;
         }
@@ -261,6 +528,21 @@ bool c_TxnScheduler::push(c_Transaction* newTxn)
 }
 
 
+bool c_TxnScheduler::isIdle()
+{
+    for(auto &l_queue : m_txnQ)
+        if(!l_queue.empty())
+            return false;
+    for(auto &l_queue : m_txnReadQ)
+        if(!l_queue.empty())
+            return false;
+    for(auto &l_queue : m_txnWriteQ)
+        if(!l_queue.empty())
+            return false;
+    return true;
+}
+
+
 //Check if read transactions get data from the transaction queue
 bool c_TxnScheduler::isHit(c_Transaction* x_txn)
 {
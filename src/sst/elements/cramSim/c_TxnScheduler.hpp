@@ -31,9 +31,15 @@
 #ifndef C_TXNSCHEDULER_HPP
 #define C_TXNSCHEDULER_HPP
 
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
 #include "c_Transaction.hpp"
 #include "c_TxnConverter.hpp"
 #include "c_Controller.hpp"
+#include "sst/elements/memHierarchy/membackend/memProfiler.h"
 
 
 namespace SST {
@@ -42,8 +48,59 @@ namespace SST {
         class c_TxnConverter;
         class c_Controller;
 
-        enum class e_txnSchedulingPolicy {FCFS, FRFCFS};
-        typedef std::list<c_Transaction*> TxnQueue;
+        enum class e_txnSchedulingPolicy {FCFS, FRFCFS, BLISS, ATLAS, PARBS};
+
+        // Transaction queue in arrival order, also indexed by bank so that
+        // row hits can be found without walking the whole queue
+        class TxnQueue {
+        public:
+            typedef std::list<c_Transaction*> List;
+            typedef List::iterator iterator;
+            typedef List::reverse_iterator reverse_iterator;
+
+            TxnQueue() : m_nextOrder(0), m_numMarked(0) {}
+
+            void push_back(c_Transaction* x_txn, unsigned x_source, SimTime_t x_arrival);
+            void remove(c_Transaction* x_txn);
+
+            c_Transaction* front() { return m_txns.front(); }
+            size_t size() const { return m_txns.size(); }
+            bool empty() const { return m_txns.empty(); }
+            iterator begin() { return m_txns.begin(); }
+            iterator end() { return m_txns.end(); }
+            reverse_iterator rbegin() { return m_txns.rbegin(); }
+            reverse_iterator rend() { return m_txns.rend(); }
+
+            // per-bank queues, oldest first
+            std::map<unsigned, List>& banks() { return m_banks; }
+
+            uint64_t getOrder(c_Transaction* x_txn) { return m_entries.at(x_txn).order; }
+            unsigned getSource(c_Transaction* x_txn) { return m_entries.at(x_txn).source; }
+            SimTime_t getArrival(c_Transaction* x_txn) { return m_entries.at(x_txn).arrival; }
+
+            // PAR-BS batch
+            bool isMarked(c_Transaction* x_txn) { return m_entries.at(x_txn).marked; }
+            void mark(c_Transaction* x_txn);
+            unsigned getNumMarked() const { return m_numMarked; }
+            std::vector<unsigned>& batchRank() { return m_batchRank; }
+
+        private:
+            struct Entry {
+                iterator pos;
+                iterator bankPos;
+                uint64_t order;
+                unsigned source;
+                SimTime_t arrival;
+                bool marked;
+            };
+
+            List m_txns;
+            std::map<unsigned, List> m_banks;
+            std::unordered_map<c_Transaction*, Entry> m_entries;
+            uint64_t m_nextOrder;
+            unsigned m_numMarked;
+            std::vector<unsigned> m_batchRank;
+        };
 
         class c_TxnScheduler: public SubComponent{
         public:
@@ -60,11 +117,23 @@ namespace SST {
             )
 
             SST_ELI_DOCUMENT_PARAMS(
-                {"txnSchedulingPolicy", "Transaction scheduling policy", "FCFS"},
+                {"txnSchedulingPolicy", "Transaction scheduling policy: FCFS, FRFCFS, BLISS, ATLAS or PARBS", "FCFS"},
                 {"numTxnQEntries", "The number of transaction queue entries", "32"},
                 {"boolReadFirstTxnScheduling", "", "0"},
                 {"maxPendingWriteThreshold", "", "1.0"},
                 {"minPendingWriteThreshold", "", "0.2"},
+                {"numTxnSources", "Number of sources (cores) tracked by the BLISS, ATLAS and PARBS policies", "1"},
+                {"txnSourceAddrShift", "When not 0, the source of a transaction is (address >> txnSourceAddrShift) % numTxnSources instead of its thread id", "0"},
+                {"blissBlacklistThreshold", "BLISS: consecutive transactions served from one source before it is blacklisted", "4"},
+                {"blissClearingInterval", "BLISS: cycles between clearings of the blacklist", "10000"},
+                {"atlasQuantum", "ATLAS: cycles between rankings of the sources by attained service", "10000"},
+                {"atlasAlpha", "ATLAS: weight of the attained service of past quanta", "0.875"},
+                {"atlasStarvationThreshold", "ATLAS: cycles after which a waiting transaction is served first", "100000"},
+                {"parbsMarkingCap", "PARBS: transactions marked per source and bank when a batch is formed", "5"},
+                {"profileFile", "File to write the per channel and bank profile to (see memHierarchy memProfiler.h for the format). No profile if empty.", ""},
+                {"profileWindow", "Profile window in cycles", "1000"},
+                {"profileDelayBins", "Number of bins of the profile queueing delay histograms", "16"},
+                {"profileDelayBinWidth", "Width in cycles of the bins of the profile queueing delay histograms", "8"},
             )
 
             SST_ELI_DOCUMENT_PORTS(
@@ -80,6 +149,7 @@ namespace SST {
             virtual void run(SimTime_t simCycle);
             virtual bool push(c_Transaction* newTxn);
             virtual bool isHit(c_Transaction* newTxn);
+            virtual bool isIdle();
 
 
         private:
@@ -87,6 +157,14 @@ namespace SST {
             virtual bool hasDependancy(c_Transaction* x_txn, int x_ch);
             virtual void popTxn(TxnQueue& x_queue, c_Transaction* x_txn);
 
+            unsigned getSource(c_Transaction* x_txn);
+            bool isRowHit(c_Transaction* x_txn);
+            bool isIssuable(c_Transaction* x_txn, int x_ch);
+            c_Transaction* getNextRowHitTxn(TxnQueue& x_queue, int x_ch);
+            bool isHigherPriority(TxnQueue& x_queue, c_Transaction* x_txn, c_Transaction* x_other);
+            void updateSourceState();
+            void formBatch(TxnQueue& x_queue);
+
             //**transaction converter
             c_TxnConverter* m_txnConverter;
             //**command Scheduler
@@ -104,6 +182,20 @@ namespace SST {
             Output *m_out;
             unsigned m_numChannels;
             bool m_flushWriteQueue;
+            SimTime_t m_simCycle;
+
+            //**per-source state of the fairness aware policies
+            std::vector<bool> m_blacklisted;         // BLISS
+            unsigned m_lastServedSource;             // BLISS
+            unsigned m_numConsecutiveServed;         // BLISS
+            SimTime_t m_nextBlacklistClear;          // BLISS
+            std::vector<double> m_attainedService;   // ATLAS, in this quantum
+            std::vector<double> m_totalAttainedService; // ATLAS, over past quanta
+            std::vector<unsigned> m_atlasRank;       // ATLAS, 0 is the highest
+            SimTime_t m_nextQuantum;                 // ATLAS
+
+            SST::MemHierarchy::MemProfiler* m_profiler;
+            unsigned m_numBanksPerChannel;
 
             //parameters
             e_txnSchedulingPolicy k_txnSchedulingPolicy;
@@ -111,6 +203,14 @@ namespace SST {
             float k_maxPendingWriteThreshold;
             float k_minPendingWriteThreshold;
             bool k_isReadFirstScheduling;
+            unsigned k_numSources;
+            unsigned k_sourceAddrShift;
+            unsigned k_blissBlacklistThreshold;
+            SimTime_t k_blissClearingInterval;
+            SimTime_t k_atlasQuantum;
+            double k_atlasAlpha;
+            SimTime_t k_atlasStarvationThreshold;
+            unsigned k_parbsMarkingCap;
 
         };
     }
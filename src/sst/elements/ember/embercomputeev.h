@@ -45,6 +45,10 @@ public:
 
     std::string getName() { return "Compute"; }
 
+    // a fixed delay can take on the delay of a compute queued right after it
+    bool fixedDelay() { return ! m_calcFunc; }
+    void addDelay( uint64_t nanoSecondDelay ) { m_nanoSecondDelay += nanoSecondDelay; }
+
     void issue( uint64_t time, FOO* functor ) {
 
         EmberEvent::issue( time );
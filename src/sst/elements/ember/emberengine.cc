@@ -31,7 +31,8 @@ EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
     Component( id ),
 	currentMotif(0),
 	m_motifDone(false),
-	m_detailedCompute(NULL)
+	m_detailedCompute(NULL),
+	m_completeFunctor( this, &EmberEngine::completeFunctor )
 {
 	// Get the level of verbosity the user is asking to print out, default is 1
 	// which means don't print much.
@@ -57,7 +58,8 @@ EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
 
     std::string motifLogFile = params.find<std::string>("motifLog", "");
     if("" != motifLogFile) {
-        m_motifLogger = loadComponentExtension<EmberMotifLog>(motifLogFile, m_jobId);
+        m_motifLogger = loadComponentExtension<EmberMotifLog>(motifLogFile, m_jobId,
+                                params.find<bool>("motifProfile", false));
     } else {
         m_motifLogger = nullptr;
     }
@@ -297,6 +299,10 @@ bool EmberEngine::completeFunctor( int retval, EmberEvent* ev )
     output.debug(CALL_INFO, 2, ENGINE_MASK, "%s %s Event\n",
               ev->stateName( ev->state() ).c_str(), ev->getName().c_str());
 
+    if ( NULL != m_motifLogger ) {
+        m_motifLogger->logEvent( ev, getCurrentSimTimeNano() );
+    }
+
     if ( ev->complete( getCurrentSimTimeNano(), retval ) ) {
         delete ev;
     }
@@ -324,14 +330,21 @@ void EmberEngine::handleEvent(Event* ev) {
         break;
 
       case EmberEvent::IssueFunctor:
-        eEv->issue( getCurrentSimTimeNano(),
+        // events complete one at a time so the engine's functor is normally free
+        if ( ! m_completeFunctor.busy() ) {
+            m_completeFunctor.bind( eEv );
+            eEv->issue( getCurrentSimTimeNano(), &m_completeFunctor );
+        } else {
+            eEv->issue( getCurrentSimTimeNano(),
                 new ArgStatic_Functor< EmberEngine, int, EmberEvent*, bool >(
                             this, &EmberEngine::completeFunctor, eEv ) );
+        }
         break;
 
       case EmberEvent::IssueCallback:
+        // two pointers fit in std::function's local storage, std::bind does not
         eEv->issue( getCurrentSimTimeNano(),
-                    std::bind( &EmberEngine::completeCallback, this, eEv, std::placeholders::_1 ) );
+                    [this, eEv]( int retval ) { completeCallback( eEv, retval ); } );
         break;
 
       case EmberEvent::IssueCallbackPtr:
@@ -343,6 +356,9 @@ void EmberEngine::handleEvent(Event* ev) {
         break;
 
       case EmberEvent::Complete:
+        if ( NULL != m_motifLogger ) {
+            m_motifLogger->logEvent( eEv, getCurrentSimTimeNano() );
+        }
         if ( eEv->complete( getCurrentSimTimeNano() ) ) {
             delete ev;
         }
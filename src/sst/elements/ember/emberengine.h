@@ -51,6 +51,7 @@ public:
         { "verboseMask", "Sets the output mask of the component", "0" },
         { "jobId", "Sets the job id", "-1"},
         { "motifLog", "Sets a file path to a file where motif execution details are written, empty = no log", "" },
+        { "motifProfile", "Also write a binary profile of each motif, time per call, messages and bytes to each peer and a message size histogram, to the motifLog path with a .prof suffix", "0" },
         { "motif_count", "Sets the number of motifs which will be run in this simulation, default is 1", "1"},
         { "rankmapper", "Sets the rank mapping SST module to load to rank translations, default is linear mapping", "ember.LinearMap" },
         { "mapFile", "Sets the name of the input file for custom map", "mapFile.txt" },
@@ -152,6 +153,8 @@ private:
 	Thornhill::DetailedCompute* m_detailedCompute;
 	Thornhill::MemoryHeapLink*  m_memHeapLink;
 
+	Reusable_ArgStatic_Functor< EmberEngine, int, EmberEvent*, bool > m_completeFunctor;
+
 	EmberEngine();			    		// For serialization
 	EmberEngine(const EmberEngine&);    // Do not implement
 	void operator=(const EmberEngine&); // Do not implement
@@ -106,6 +106,12 @@ public:
         return true;
     }
 
+    uint64_t issueTime() { return m_issueTime; }
+
+    // a point to point send names its peer and its size in bytes for the
+    // motif profile
+    virtual bool commPeer( int& peer, uint64_t& bytes ) { return false; }
+
     virtual uint64_t completeDelayNS() {
         m_output->debug(CALL_INFO, 2, EVENT_MASK, "delay=%" PRIu64 " ns\n",
                                                 m_completeDelayNS);
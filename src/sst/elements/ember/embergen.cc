@@ -28,6 +28,7 @@ EmberGenerator::EmberGenerator( ComponentId_t id, Params& params, std::string na
     m_curVirtAddr( 0x1000 )
 {
     m_primary = params.find<bool>("primary",true);
+    m_coalesceCompute = params.find<bool>("coalesceCompute",false);
     m_motifNum = params.find<int>( "_motifNum", -1 );
     m_jobId = params.find<int>( "_jobId", -1 );
     uint64_t parentPtr = params.find<uint64_t>("_enginePtr",0 );
@@ -61,6 +61,7 @@ class EmberGenerator : public SubComponent {
         { "_jobId", "used internally", "-1"},
         { "_enginePtr", "used internally", "-1"},
 		{ "distribModule", "Sets the distribution SST module for compute modeling, default is a constant distribution of mean 1", "1.0"},
+		{ "coalesceCompute", "Merge a fixed compute with the fixed compute queued just before it so they take one timed event, the distribution is sampled once for the pair", "0"},
 	)
 
     EmberGenerator( ComponentId_t id, Params& params ) : SubComponent(id) { assert(0); }
@@ -130,6 +131,7 @@ class EmberGenerator : public SubComponent {
     inline void enQ_memAlloc( Queue&, Hermes::MemAddr* addr, size_t length  );
     inline void enQ_compute( Queue&, uint64_t nanoSecondDelay );
     inline void enQ_compute( Queue& q, std::function<uint64_t()> func );
+    inline void enQ_compute( Queue& q, double flops, double bytes, double workingSet );
     inline void enQ_detailedCompute( Queue& q, std::string, Params&, std::function<int()> func );
 
   private:
@@ -142,6 +144,7 @@ class EmberGenerator : public SubComponent {
     int                     m_jobId;
     int                     m_motifNum;
     bool                    m_primary;
+    bool                    m_coalesceCompute;
     EmberComputeDistribution*           m_computeDistrib;
     uint64_t m_curVirtAddr;
 };
@@ -152,6 +155,13 @@ void EmberGenerator::enQ_getTime( Queue& q, uint64_t* time ) {
 
 void EmberGenerator::enQ_compute( Queue& q, uint64_t delay )
 {
+    if ( m_coalesceCompute && ! q.empty() ) {
+        EmberComputeEvent* prev = dynamic_cast<EmberComputeEvent*>( q.back() );
+        if ( prev && prev->fixedDelay() ) {
+            prev->addDelay( delay );
+            return;
+        }
+    }
     q.push( new EmberComputeEvent( &getOutput(), delay, m_computeDistrib ) );
 }
 
@@ -160,6 +170,15 @@ void EmberGenerator::enQ_compute( Queue& q, std::function<uint64_t()> func )
     q.push( new EmberComputeEvent( &getOutput(), func, m_computeDistrib ) );
 }
 
+// the time comes from the roofline of the node's NodePerf when the event issues
+void EmberGenerator::enQ_compute( Queue& q, double flops, double bytes, double workingSet )
+{
+    Hermes::NodePerf* perf = m_nodePerf;
+    enQ_compute( q, [=]() {
+        return (uint64_t) perf->calcTimeNS_roofline( flops, bytes, workingSet );
+    } );
+}
+
 void EmberGenerator::enQ_detailedCompute( Queue& q, std::string name,
         Params& params, std::function<int()> fini = NULL )
 {
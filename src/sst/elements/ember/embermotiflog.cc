@@ -19,6 +19,7 @@
 #include <mutex>
 #endif
 
+#include <string.h>
 #include <unordered_map>
 #include "embermotiflog.h"
 
@@ -30,12 +31,148 @@ static std::unordered_map<std::string, EmberMotifLogRecord*>* logHandles = NULL;
 static std::mutex mapLock;
 #endif
 
-EmberMotifLog::EmberMotifLog(SST::ComponentId_t cid, const std::string logPathPrefix, const uint32_t jobID) :
+// The profile file starts with the magic "EMBP" and a uint32_t version,
+// then holds one record per motif of each rank and one record per rank with
+// motif -1 for the whole run. All values are in host byte order:
+//
+//   int32 job, int32 rank, int32 motif, uint32 length + name,
+//   uint64 start ns, uint64 end ns,
+//   uint32 number of calls,   each uint32 length + name, uint64 count, uint64 ns
+//   uint32 number of peers,   each int32 peer, uint64 messages, uint64 bytes
+//   uint32 used size buckets, each uint32 bucket, uint64 messages
+//
+// A record is written with a single fwrite so ranks sharing the file do not
+// interleave.
+static const uint32_t ProfileVersion = 1;
+
+template< class T >
+static void packValue( std::vector<char>& buf, T value )
+{
+    size_t pos = buf.size();
+    buf.resize( pos + sizeof(value) );
+    memcpy( &buf[pos], &value, sizeof(value) );
+}
+
+static void packString( std::vector<char>& buf, const std::string& str )
+{
+    packValue<uint32_t>( buf, str.size() );
+    buf.insert( buf.end(), str.begin(), str.end() );
+}
+
+FILE* EmberMotifLogRecord::openProfileFile(const char* filePath) {
+	if(NULL == profileFile) {
+		profileFile = fopen(filePath, "wb");
+		if(NULL != profileFile) {
+			std::vector<char> header;
+			header.insert( header.end(), "EMBP", "EMBP" + 4 );
+			packValue<uint32_t>( header, ProfileVersion );
+			fwrite( &header[0], 1, header.size(), profileFile );
+		}
+	}
+	return profileFile;
+}
+
+void EmberCommProfile::clear()
+{
+    calls.clear();
+    peers.clear();
+    memset( sizeHist, 0, sizeof(sizeHist) );
+}
+
+int EmberCommProfile::sizeBucket( uint64_t bytes )
+{
+    int bucket = 0;
+    while ( bytes ) {
+        ++bucket;
+        bytes >>= 1;
+    }
+    return bucket;
+}
+
+void EmberCommProfile::addEvent( EmberEvent* ev, uint64_t time )
+{
+    std::unordered_map<std::type_index, Call>::iterator iter = calls.find( typeid(*ev) );
+    if ( iter == calls.end() ) {
+        Call call = { ev->getName(), 0, 0 };
+        iter = calls.insert( std::make_pair( std::type_index( typeid(*ev) ), call ) ).first;
+    }
+    ++iter->second.count;
+    iter->second.timeNS += time - ev->issueTime();
+
+    int peer;
+    uint64_t bytes;
+    if ( ev->commPeer( peer, bytes ) ) {
+        Peer& entry = peers[peer];
+        ++entry.msgs;
+        entry.bytes += bytes;
+        ++sizeHist[ sizeBucket( bytes ) ];
+    }
+}
+
+void EmberCommProfile::add( const EmberCommProfile& other )
+{
+    std::unordered_map<std::type_index, Call>::const_iterator call = other.calls.begin();
+    for ( ; call != other.calls.end(); ++call ) {
+        std::unordered_map<std::type_index, Call>::iterator iter = calls.find( call->first );
+        if ( iter == calls.end() ) {
+            calls.insert( *call );
+        } else {
+            iter->second.count += call->second.count;
+            iter->second.timeNS += call->second.timeNS;
+        }
+    }
+
+    std::map<int, Peer>::const_iterator peer = other.peers.begin();
+    for ( ; peer != other.peers.end(); ++peer ) {
+        Peer& entry = peers[peer->first];
+        entry.msgs += peer->second.msgs;
+        entry.bytes += peer->second.bytes;
+    }
+
+    for ( int i = 0; i < SizeBuckets; i++ ) {
+        sizeHist[i] += other.sizeHist[i];
+    }
+}
+
+void EmberCommProfile::pack( std::vector<char>& buf ) const
+{
+    packValue<uint32_t>( buf, calls.size() );
+    std::unordered_map<std::type_index, Call>::const_iterator call = calls.begin();
+    for ( ; call != calls.end(); ++call ) {
+        packString( buf, call->second.name );
+        packValue<uint64_t>( buf, call->second.count );
+        packValue<uint64_t>( buf, call->second.timeNS );
+    }
+
+    packValue<uint32_t>( buf, peers.size() );
+    std::map<int, Peer>::const_iterator peer = peers.begin();
+    for ( ; peer != peers.end(); ++peer ) {
+        packValue<int32_t>( buf, peer->first );
+        packValue<uint64_t>( buf, peer->second.msgs );
+        packValue<uint64_t>( buf, peer->second.bytes );
+    }
+
+    uint32_t used = 0;
+    for ( int i = 0; i < SizeBuckets; i++ ) {
+        used += sizeHist[i] ? 1 : 0;
+    }
+    packValue<uint32_t>( buf, used );
+    for ( int i = 0; i < SizeBuckets; i++ ) {
+        if ( sizeHist[i] ) {
+            packValue<uint32_t>( buf, i );
+            packValue<uint64_t>( buf, sizeHist[i] );
+        }
+    }
+}
+
+EmberMotifLog::EmberMotifLog(SST::ComponentId_t cid, const std::string logPathPrefix, const uint32_t jobID, const bool profile) :
     ComponentExtension(cid),
     jobID(jobID),
     rank(-1),
     start_time("0 ns"),
-    currentMotifNum(0)
+    currentMotifNum(0),
+    profiling(profile),
+    motifStartNS(0)
 {
 
 #ifndef _SST_EMBER_DISABLE_PARALLEL
@@ -68,6 +205,18 @@ EmberMotifLog::EmberMotifLog(SST::ComponentId_t cid, const std::string logPathPr
 		logRecord = logHandleFind->second;
 		logRecord->increment();
 	}
+
+	if(profiling) {
+        std::ostringstream profileFile;
+        profileFile << logPathPrefix;
+
+        if ( getNumRanks().rank > 1 ) {
+            profileFile << "-" << getRank().rank;
+        }
+        profileFile << ".prof";
+
+		logRecord->openProfileFile(profileFile.str().c_str());
+	}
 }
 
 EmberMotifLog::~EmberMotifLog() {
@@ -77,17 +226,23 @@ EmberMotifLog::~EmberMotifLog() {
         std::lock_guard<std::mutex> lock(mapLock);
 #endif
 
+	if(profiling) {
+		writeProfile("all", -1, 0, getCurrentSimTimeNano(), totalProfile);
+	}
+
 	logRecord->decrement();
 
 	if(0 == logRecord->getCount()) {
 		fclose(logRecord->getFile());
 		logRecord->invalidateFile();
+		logRecord->closeProfileFile();
 	}
 }
 
 void EmberMotifLog::logMotifStart(int motifNum) {
     start_time = getElapsedSimTime().toStringBestSI();
     currentMotifNum = motifNum;
+    motifStartNS = getCurrentSimTimeNano();
 }
 
 void EmberMotifLog::logMotifEnd(const std::string& name, const int motifNum) {
@@ -108,4 +263,30 @@ void EmberMotifLog::logMotifEnd(const std::string& name, const int motifNum) {
 		fflush(logFile);
 
 	}
+
+	if(profiling) {
+		writeProfile(name, motifNum, motifStartNS, getCurrentSimTimeNano(), motifProfile);
+		totalProfile.add(motifProfile);
+		motifProfile.clear();
+	}
+}
+
+void EmberMotifLog::writeProfile(const std::string& name, int motifNum, uint64_t start, uint64_t end,
+        const EmberCommProfile& profile) {
+
+	FILE* profileFile = logRecord->getProfileFile();
+	if(NULL == profileFile) {
+		return;
+	}
+
+	std::vector<char> buf;
+	packValue<int32_t>( buf, jobID );
+	packValue<int32_t>( buf, rank );
+	packValue<int32_t>( buf, motifNum );
+	packString( buf, name );
+	packValue<uint64_t>( buf, start );
+	packValue<uint64_t>( buf, end );
+	profile.pack( buf );
+
+	fwrite( &buf[0], 1, buf.size(), profileFile );
 }
@@ -17,14 +17,19 @@
 #define _H_SST_EMBER_MOTIF_LOG
 
 #include <stdio.h>
+#include <map>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
 #include <sst/core/componentExtension.h>
+#include "emberevent.h"
 
 namespace SST {
 namespace Ember {
 
 class EmberMotifLogRecord {
 	public:
-		EmberMotifLogRecord(const char* filePath) {
+		EmberMotifLogRecord(const char* filePath) : profileFile(NULL) {
 			loggerFile = fopen(filePath, "wt");
 		}
 
@@ -32,6 +37,9 @@ class EmberMotifLogRecord {
 			if(NULL != loggerFile) {
 				fclose(loggerFile);
 			}
+			if(NULL != profileFile) {
+				fclose(profileFile);
+			}
 		}
 
 		void increment() {
@@ -62,25 +70,90 @@ class EmberMotifLogRecord {
 			loggerFile = NULL;
 		}
 
+		// the profile is opened by the first log that asks for it
+		FILE* openProfileFile(const char* filePath);
+
+		FILE* getProfileFile() {
+			return profileFile;
+		}
+
+		void closeProfileFile() {
+			if(NULL != profileFile) {
+				fclose(profileFile);
+				profileFile = NULL;
+			}
+		}
+
 	protected:
 		FILE* loggerFile;
+		FILE* profileFile;
 		uint32_t motifCount;
 };
 
+// What a rank did over a motif: time and count of each kind of event, the
+// messages it sent to each peer and a histogram of their sizes where bucket
+// i counts the messages whose size has i significant bits
+class EmberCommProfile {
+	public:
+    static const int SizeBuckets = 65;
+
+    struct Call {
+        std::string name;
+        uint64_t count;
+        uint64_t timeNS;
+    };
+
+    struct Peer {
+        uint64_t msgs;
+        uint64_t bytes;
+    };
+
+    EmberCommProfile() { clear(); }
+
+    void clear();
+    void add( const EmberCommProfile& other );
+    void addEvent( EmberEvent* ev, uint64_t time );
+
+    // appends the profile to buf in the layout described in embermotiflog.cc
+    void pack( std::vector<char>& buf ) const;
+
+	private:
+    static int sizeBucket( uint64_t bytes );
+
+    std::unordered_map<std::type_index, Call> calls;
+    std::map<int, Peer> peers;
+    uint64_t sizeHist[SizeBuckets];
+};
+
 class EmberMotifLog : public ComponentExtension {
 	public:
-    EmberMotifLog(SST::ComponentId_t cid, const std::string logPathPrefix, const uint32_t jobID);
+    EmberMotifLog(SST::ComponentId_t cid, const std::string logPathPrefix, const uint32_t jobID, const bool profile = false);
     ~EmberMotifLog();
     void logMotifStart(int motifNum);
     void logMotifEnd(const std::string& name, const int motifNum);
     void setRank(int r) { rank = r; }
+
+    // called by the engine as each event completes, a no-op unless profiling
+    void logEvent(EmberEvent* ev, uint64_t time) {
+        if ( profiling ) {
+            motifProfile.addEvent( ev, time );
+        }
+    }
 	protected:
 		EmberMotifLogRecord* logRecord;
     private:
+        void writeProfile(const std::string& name, int motifNum, uint64_t start, uint64_t end,
+                const EmberCommProfile& profile);
+
         int jobID;
         int rank;
         std::string start_time;
         int currentMotifNum;
+
+        bool profiling;
+        uint64_t motifStartNS;
+        EmberCommProfile motifProfile;
+        EmberCommProfile totalProfile;
 };
 
 }
@@ -44,6 +44,7 @@
 #include "shmem/emberShmemSwapEv.h"
 #include "shmem/emberShmemFaddEv.h"
 #include "shmem/emberShmemAddEv.h"
+#include "shmem/emberShmemTriggeredPutEv.h"
 
 #include "shmem/emberFamGet_Ev.h"
 #include "shmem/emberFamPut_Ev.h"
@@ -344,6 +345,13 @@ class EmberShmemLib : public EmberLib {
 		q.push( new EmberPutShmemEvent( api(), m_output,  dest.getSimVAddr(), src.getSimVAddr(), length, pe, false ) );
 	}
 
+	template <class TYPE>
+	void triggered_put( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src, size_t length, int pe,
+			Hermes::MemAddr counter, TYPE threshold ) {
+		q.push( new EmberTriggeredPutShmemEvent( api(), m_output,  dest.getSimVAddr(), src.getSimVAddr(), length, pe,
+					counter.getSimVAddr(), Hermes::Value( (TYPE) threshold ) ) );
+	}
+
 	template <class TYPE>
 	void putv( Queue& q, Hermes::MemAddr addr, TYPE value, int pe ) {
 		q.push( new EmberPutvShmemEvent( api(), m_output,  addr.getSimVAddr(), Hermes::Value( (TYPE) value ), pe ) );
@@ -43,6 +43,12 @@ class EmberSendEvent : public EmberMPIEvent {
 
 	std::string getName() { return "Send"; }
 
+    bool commPeer( int& peer, uint64_t& bytes ) {
+        peer = m_dest;
+        bytes = (uint64_t) m_count * m_api.sizeofDataType( m_dtype );
+        return true;
+    }
+
     void issue( uint64_t time, FOO* functor ) {
 
         EmberEvent::issue( time );
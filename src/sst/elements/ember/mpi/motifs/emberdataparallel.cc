@@ -0,0 +1,121 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <algorithm>
+
+#include "emberdataparallel.h"
+
+using namespace SST::Ember;
+
+#define TAG 0xD1A1
+
+EmberDataParallelGenerator::EmberDataParallelGenerator(SST::ComponentId_t id, Params& params) :
+	EmberDLGenerator(id, params, "DataParallel"),
+    m_loopIndex(0),
+    m_bucketBytes(0)
+{
+	m_iterations = (uint32_t) params.find("arg.iterations", 1);
+	m_layers = (uint32_t) params.find("arg.layers", 24);
+	m_layerBytes = params.find<uint64_t>("arg.parameters", 1048576) * params.find<uint64_t>("arg.bytesperparam", 4);
+	m_bucketSize = params.find<uint64_t>("arg.bucketsize", 26214400);
+	m_forwardTime = params.find<uint64_t>("arg.forwardtime", 1000);
+	m_backwardTime = params.find<uint64_t>("arg.backwardtime", 2000);
+	m_ranksPerNode = (uint32_t) params.find("arg.ranksPerNode", 1);
+	m_overlap = params.find<bool>("arg.overlap", true);
+
+	std::string algorithm = params.find<std::string>("arg.algorithm", "ring");
+	if ( algorithm != "ring" && algorithm != "hierarchical" ) {
+		fatal(CALL_INFO, -1, "Error: DataParallel motif unknown allreduce algorithm %s\n", algorithm.c_str());
+	}
+	m_hierarchical = algorithm == "hierarchical";
+
+	if ( m_hierarchical && ( 0 == m_ranksPerNode || size() % m_ranksPerNode ) ) {
+		fatal(CALL_INFO, -1, "Error: DataParallel motif ranksPerNode %" PRIu32 " does not divide %d ranks\n",
+			m_ranksPerNode, size());
+	}
+}
+
+void EmberDataParallelGenerator::flushBucket()
+{
+    if ( 0 == m_bucketBytes ) {
+        return;
+    }
+
+    if ( m_hierarchical ) {
+        hierarchicalAllreduce( m_ranksPerNode, m_bucketBytes, m_pending );
+    } else {
+        std::vector<int> world = contiguousGroup( size() );
+        ringAllreduce( world, m_bucketBytes, m_pending );
+    }
+    m_bucketBytes = 0;
+}
+
+bool EmberDataParallelGenerator::generate( std::queue<EmberEvent*>& evQ)
+{
+    if ( m_loopIndex == m_iterations ) {
+        if ( 0 == rank()) {
+            double totalTime = (double)(m_stopTime - m_startTime)/1000000000.0;
+
+            output("%s total time %.3f us, loop %d, model %" PRIu64 " bytes"
+                    ", time per step %.3f us\n",
+                                getMotifName().c_str(),
+                                totalTime * 1000000.0, m_iterations,
+                                m_layerBytes * m_layers,
+                                totalTime * 1000000.0 / m_iterations );
+        }
+        return true;
+    }
+
+    if ( 0 == m_loopIndex ) {
+        verbose( CALL_INFO, 1, 0, "rank=%d size=%d\n", rank(), size());
+        allocBuffers( std::max( m_bucketSize, m_layerBytes ) );
+        enQ_getTime( evQ, &m_startTime );
+    }
+
+    enQ_compute( evQ, m_forwardTime * m_layers );
+
+    for ( uint32_t layer = 0; layer < m_layers; layer++ ) {
+
+        // split the layer's compute across the steps in flight, each waits
+        // for its step before the next is posted as the ring requires
+        if ( ! m_overlap || m_pending.empty() ) {
+            enQ_compute( evQ, m_backwardTime );
+        } else {
+            uint64_t slice = m_backwardTime / m_pending.size();
+            while ( ! m_pending.empty() ) {
+                enQ_step( evQ, m_pending.front(), slice, TAG );
+                m_pending.pop_front();
+            }
+        }
+
+        m_bucketBytes += m_layerBytes;
+        if ( m_bucketBytes >= m_bucketSize ) {
+            flushBucket();
+        }
+    }
+    flushBucket();
+
+    while ( ! m_pending.empty() ) {
+        enQ_step( evQ, m_pending.front(), 0, TAG );
+        m_pending.pop_front();
+    }
+
+    if ( ++m_loopIndex == m_iterations ) {
+        enQ_getTime( evQ, &m_stopTime );
+    }
+    return false;
+}
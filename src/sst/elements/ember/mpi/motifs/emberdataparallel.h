@@ -0,0 +1,105 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_DATA_PARALLEL
+#define _H_EMBER_DATA_PARALLEL
+
+#include "mpi/motifs/emberdlgen.h"
+
+namespace SST {
+namespace Ember {
+
+// Data parallel training step: forward through the layers, then backward
+// through them in reverse, allreducing the gradients in buckets the way
+// PyTorch DDP does. With overlap a bucket's allreduce runs during the
+// backward compute of the layers that follow, otherwise after all of it.
+class EmberDataParallelGenerator : public EmberDLGenerator {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        EmberDataParallelGenerator,
+        "ember",
+        "DataParallelMotif",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Performs data parallel deep learning training steps",
+        SST::Ember::EmberDataParallelGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {   "arg.iterations",       "Sets the number of training steps",            "1"},
+        {   "arg.layers",           "Sets the number of layers of the model",       "24"},
+        {   "arg.parameters",       "Sets the number of parameters of each layer",  "1048576"},
+        {   "arg.bytesperparam",    "Sets the size of each gradient in bytes",      "4"},
+        {   "arg.bucketsize",       "Sets the bytes of gradients allreduced together", "26214400"},
+        {   "arg.forwardtime",      "Sets the forward compute time of a layer in nanoseconds", "1000"},
+        {   "arg.backwardtime",     "Sets the backward compute time of a layer in nanoseconds", "2000"},
+        {   "arg.algorithm",        "Sets the allreduce algorithm, ring or hierarchical", "ring"},
+        {   "arg.ranksPerNode",     "Sets the ranks of a node for the hierarchical allreduce", "1"},
+        {   "arg.overlap",          "Overlap the allreduce of a bucket with the backward compute", "1"},
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "time-Init", "Time spent in Init event",          "ns",  0},
+        { "time-Finalize", "Time spent in Finalize event",  "ns", 0},
+        { "time-Rank", "Time spent in Rank event",          "ns", 0},
+        { "time-Size", "Time spent in Size event",          "ns", 0},
+        { "time-Send", "Time spent in Recv event",          "ns", 0},
+        { "time-Recv", "Time spent in Recv event",          "ns", 0},
+        { "time-Irecv", "Time spent in Irecv event",        "ns", 0},
+        { "time-Isend", "Time spent in Isend event",        "ns", 0},
+        { "time-Wait", "Time spent in Wait event",          "ns", 0},
+        { "time-Waitall", "Time spent in Waitall event",    "ns", 0},
+        { "time-Waitany", "Time spent in Waitany event",    "ns", 0},
+        { "time-Compute", "Time spent in Compute event",    "ns", 0},
+        { "time-Barrier", "Time spent in Barrier event",    "ns", 0},
+        { "time-Alltoallv", "Time spent in Alltoallv event", "ns", 0},
+        { "time-Alltoall", "Time spent in Alltoall event",  "ns", 0},
+        { "time-Allreduce", "Time spent in Allreduce event", "ns", 0},
+        { "time-Reduce", "Time spent in Reduce event",      "ns", 0},
+        { "time-Bcast", "Time spent in Bcast event",        "ns", 0},
+        { "time-Gettime", "Time spent in Gettime event",    "ns", 0},
+        { "time-Commsplit", "Time spent in Commsplit event", "ns", 0},
+        { "time-Commcreate", "Time spent in Commcreate event", "ns", 0},
+    )
+
+public:
+	EmberDataParallelGenerator(SST::ComponentId_t id, Params& params);
+    bool generate( std::queue<EmberEvent*>& evQ);
+
+private:
+    void flushBucket();
+
+    uint32_t m_iterations;
+    uint32_t m_layers;
+    uint64_t m_layerBytes;
+    uint64_t m_bucketSize;
+    uint64_t m_forwardTime;
+    uint64_t m_backwardTime;
+    bool     m_hierarchical;
+    uint32_t m_ranksPerNode;
+    bool     m_overlap;
+
+    uint32_t m_loopIndex;
+    uint64_t m_bucketBytes;
+    Steps    m_pending;
+    uint64_t m_startTime;
+    uint64_t m_stopTime;
+};
+
+}
+}
+
+#endif
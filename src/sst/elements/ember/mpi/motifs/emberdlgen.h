@@ -0,0 +1,125 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_DL_GENERATOR
+#define _H_EMBER_DL_GENERATOR
+
+#include <deque>
+#include <vector>
+
+#include "mpi/embermpigen.h"
+
+namespace SST {
+namespace Ember {
+
+// Common parts of the deep learning training motifs. Collectives are built
+// from ring steps of point to point messages, so that a motif can put
+// compute between posting a step and waiting for it and overlap the two.
+class EmberDLGenerator : public EmberMessagePassingGenerator {
+
+public:
+    EmberDLGenerator(SST::ComponentId_t id, Params& params, std::string name) :
+        EmberMessagePassingGenerator(id, params, name) {}
+
+protected:
+    // One exchange of a ring, send bytes to rank to while receiving as many from rank from
+    struct Step {
+        Step( int to, int from, uint32_t bytes ) : to(to), from(from), bytes(bytes) {}
+        int to;
+        int from;
+        uint32_t bytes;
+    };
+    typedef std::deque<Step> Steps;
+
+    // group holds the world ranks of the ring in order, bytes is the whole buffer
+    void ringReduceScatter( const std::vector<int>& group, uint64_t bytes, Steps& steps ) {
+        ringPass( group, bytes, steps );
+    }
+    void ringAllgather( const std::vector<int>& group, uint64_t bytes, Steps& steps ) {
+        ringPass( group, bytes, steps );
+    }
+    void ringAllreduce( const std::vector<int>& group, uint64_t bytes, Steps& steps ) {
+        ringReduceScatter( group, bytes, steps );
+        ringAllgather( group, bytes, steps );
+    }
+
+    // Reduce-scatter within a node, allreduce the shards across nodes between
+    // the ranks with the same local index, then allgather within the node
+    void hierarchicalAllreduce( int ranksPerNode, uint64_t bytes, Steps& steps ) {
+        int node = rank() / ranksPerNode;
+        int local = rank() % ranksPerNode;
+        std::vector<int> intra, inter;
+        for ( int i = 0; i < ranksPerNode; i++ ) {
+            intra.push_back( node * ranksPerNode + i );
+        }
+        for ( int i = 0; i < size() / ranksPerNode; i++ ) {
+            inter.push_back( i * ranksPerNode + local );
+        }
+        uint64_t shard = ( bytes + ranksPerNode - 1 ) / ranksPerNode;
+
+        ringReduceScatter( intra, bytes, steps );
+        ringAllreduce( inter, shard, steps );
+        ringAllgather( intra, bytes, steps );
+    }
+
+    // the world ranks of the contiguous block of groupSize ranks this rank is in
+    std::vector<int> contiguousGroup( int groupSize ) {
+        std::vector<int> group;
+        int first = rank() - rank() % groupSize;
+        for ( int i = 0; i < groupSize; i++ ) {
+            group.push_back( first + i );
+        }
+        return group;
+    }
+
+    void allocBuffers( uint64_t bytes ) {
+        m_sendBuf = memAlloc( bytes );
+        m_recvBuf = memAlloc( bytes );
+    }
+
+    // post a step, compute for computeNs while it is in flight then wait for it
+    void enQ_step( std::queue<EmberEvent*>& evQ, const Step& step, uint64_t computeNs, uint32_t tag ) {
+        enQ_irecv( evQ, m_recvBuf, step.bytes, CHAR, step.from, tag, GroupWorld, &m_stepReq[0] );
+        enQ_isend( evQ, m_sendBuf, step.bytes, CHAR, step.to, tag, GroupWorld, &m_stepReq[1] );
+        if ( computeNs ) {
+            enQ_compute( evQ, computeNs );
+        }
+        enQ_waitall( evQ, 2, m_stepReq );
+    }
+
+    void*          m_sendBuf;
+    void*          m_recvBuf;
+
+private:
+    void ringPass( const std::vector<int>& group, uint64_t bytes, Steps& steps ) {
+        int n = group.size();
+        int me = 0;
+        while ( me < n && group[me] != rank() ) {
+            me++;
+        }
+        uint32_t chunk = ( bytes + n - 1 ) / n;
+        for ( int i = 0; i < n - 1; i++ ) {
+            steps.push_back( Step( group[ (me + 1) % n ], group[ (me + n - 1) % n ], chunk ) );
+        }
+    }
+
+    MessageRequest m_stepReq[2];
+};
+
+}
+}
+
+#endif
@@ -44,6 +44,13 @@ EmberHalo3DGenerator::EmberHalo3DGenerator(SST::ComponentId_t id, Params& params
 	// Converts FLOP/s into nano seconds of compute
 	const double compute_seconds = ( (double) total_flops / ( (double) pe_flops / 1000000000.0 ) );
 	nsCompute  = params.find<uint64_t>("arg.computetime", (uint64_t) compute_seconds);
+
+	// a sweep over the cells reads and writes bytespercell for each field
+	uint64_t bytes_per_cell = params.find<uint64_t>("arg.bytespercell", 0);
+	useRoofline  = bytes_per_cell && ! params.contains("arg.computetime");
+	computeFlops = (double) total_flops;
+	computeBytes = (double) total_grid_points * items_per_cell * bytes_per_cell;
+	workingSet   = (double) total_grid_points * items_per_cell * sizeof_cell;
 	nsCopyTime = params.find<uint32_t>("arg.copytime", 0);
 
 	iterations = params.find<uint32_t>("arg.iterations", 1);
@@ -170,7 +177,11 @@ bool EmberHalo3DGenerator::generate( std::queue<EmberEvent*>& evQ )
     	*/
         //end->NetworkSim
 
-		enQ_compute( evQ, nsCompute);
+		if ( useRoofline ) {
+			enQ_compute( evQ, computeFlops, computeBytes, workingSet );
+		} else {
+			enQ_compute( evQ, nsCompute);
+		}
 
 		std::vector<MessageRequest*> requests;
 
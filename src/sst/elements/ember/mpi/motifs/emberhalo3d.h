@@ -49,6 +49,7 @@ public:
         {   "arg.computetime",      "Sets the number of nanoseconds to compute for",    "10"},
         {   "arg.copytime",     "Sets the time spent copying data between messages",    "5"},
         {   "arg.iterations",       "Sets the number of halo3d operations to perform",  "10"},
+        {   "arg.bytespercell",     "Sets the bytes of memory traffic per cell and field, if not 0 and computetime is not set the compute time comes from the roofline of the node's NodePerf", "0"},
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -96,6 +97,10 @@ private:
 
 	uint32_t nsCompute;
 	uint32_t nsCopyTime;
+	bool     useRoofline;
+	double   computeFlops;
+	double   computeBytes;
+	double   workingSet;
 
 	uint32_t nx;
 	uint32_t ny;
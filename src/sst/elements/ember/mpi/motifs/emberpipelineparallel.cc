@@ -0,0 +1,132 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include "emberpipelineparallel.h"
+
+using namespace SST::Ember;
+
+#define FORWARD_TAG  0xD1A3
+#define BACKWARD_TAG 0xD1A4
+
+EmberPipelineParallelGenerator::EmberPipelineParallelGenerator(SST::ComponentId_t id, Params& params) :
+	EmberDLGenerator(id, params, "PipelineParallel"),
+    m_loopIndex(0)
+{
+	m_iterations = (uint32_t) params.find("arg.iterations", 1);
+	m_stages = (uint32_t) params.find("arg.stages", 0);
+	m_microbatches = (uint32_t) params.find("arg.microbatches", 8);
+	m_activationSize = (uint32_t) params.find("arg.activationsize", 1048576);
+	m_forwardTime = params.find<uint64_t>("arg.forwardtime", 1000);
+	m_backwardTime = params.find<uint64_t>("arg.backwardtime", 2000);
+
+	std::string schedule = params.find<std::string>("arg.schedule", "1f1b");
+	if ( schedule != "gpipe" && schedule != "1f1b" ) {
+		fatal(CALL_INFO, -1, "Error: PipelineParallel motif unknown schedule %s\n", schedule.c_str());
+	}
+	m_gpipe = schedule == "gpipe";
+
+	if ( 0 == m_stages ) {
+		m_stages = size();
+	}
+	if ( size() % m_stages ) {
+		fatal(CALL_INFO, -1, "Error: PipelineParallel motif stages %" PRIu32 " does not divide %d ranks\n",
+			m_stages, size());
+	}
+	m_stage = rank() % m_stages;
+
+	// every microbatch sends at most an activation forward and a gradient back
+	m_reqs.resize( 2 * m_microbatches );
+}
+
+void EmberPipelineParallelGenerator::enQ_forward( std::queue<EmberEvent*>& evQ )
+{
+    if ( m_stage > 0 ) {
+        enQ_recv( evQ, m_recvBuf, m_activationSize, CHAR, rank() - 1, FORWARD_TAG, GroupWorld );
+    }
+    enQ_compute( evQ, m_forwardTime );
+    if ( m_stage < (int) m_stages - 1 ) {
+        enQ_isend( evQ, m_sendBuf, m_activationSize, CHAR, rank() + 1, FORWARD_TAG, GroupWorld, &m_reqs[m_numReqs++] );
+    }
+}
+
+void EmberPipelineParallelGenerator::enQ_backward( std::queue<EmberEvent*>& evQ )
+{
+    if ( m_stage < (int) m_stages - 1 ) {
+        enQ_recv( evQ, m_recvBuf, m_activationSize, CHAR, rank() + 1, BACKWARD_TAG, GroupWorld );
+    }
+    enQ_compute( evQ, m_backwardTime );
+    if ( m_stage > 0 ) {
+        enQ_isend( evQ, m_sendBuf, m_activationSize, CHAR, rank() - 1, BACKWARD_TAG, GroupWorld, &m_reqs[m_numReqs++] );
+    }
+}
+
+bool EmberPipelineParallelGenerator::generate( std::queue<EmberEvent*>& evQ)
+{
+    if ( m_loopIndex == m_iterations ) {
+        if ( 0 == rank()) {
+            double totalTime = (double)(m_stopTime - m_startTime)/1000000000.0;
+
+            output("%s total time %.3f us, loop %d, stages %" PRIu32 ", microbatches %" PRIu32
+                    ", time per step %.3f us\n",
+                                getMotifName().c_str(),
+                                totalTime * 1000000.0, m_iterations,
+                                m_stages, m_microbatches,
+                                totalTime * 1000000.0 / m_iterations );
+        }
+        return true;
+    }
+
+    if ( 0 == m_loopIndex ) {
+        verbose( CALL_INFO, 1, 0, "rank=%d size=%d stage=%d\n", rank(), size(), m_stage);
+        allocBuffers( m_activationSize );
+        enQ_getTime( evQ, &m_startTime );
+    }
+
+    m_numReqs = 0;
+
+    // the sends only complete at the end of the step, a stage never blocks
+    // on anything but the receive of the data it needs next
+    if ( m_gpipe ) {
+        for ( uint32_t i = 0; i < m_microbatches; i++ ) {
+            enQ_forward( evQ );
+        }
+        for ( uint32_t i = 0; i < m_microbatches; i++ ) {
+            enQ_backward( evQ );
+        }
+    } else {
+        uint32_t warmup = std::min( m_stages - m_stage - 1, m_microbatches );
+        for ( uint32_t i = 0; i < warmup; i++ ) {
+            enQ_forward( evQ );
+        }
+        for ( uint32_t i = warmup; i < m_microbatches; i++ ) {
+            enQ_forward( evQ );
+            enQ_backward( evQ );
+        }
+        for ( uint32_t i = 0; i < warmup; i++ ) {
+            enQ_backward( evQ );
+        }
+    }
+
+    if ( m_numReqs ) {
+        enQ_waitall( evQ, m_numReqs, &m_reqs[0] );
+    }
+
+    if ( ++m_loopIndex == m_iterations ) {
+        enQ_getTime( evQ, &m_stopTime );
+    }
+    return false;
+}
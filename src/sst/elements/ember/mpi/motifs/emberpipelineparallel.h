@@ -0,0 +1,103 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_PIPELINE_PARALLEL
+#define _H_EMBER_PIPELINE_PARALLEL
+
+#include "mpi/motifs/emberdlgen.h"
+
+namespace SST {
+namespace Ember {
+
+// Pipeline parallel training step. The ranks are split into contiguous
+// pipelines of the given number of stages, activations of each microbatch
+// go forward from stage to stage and their gradients come back. The gpipe
+// schedule runs all forwards then all backwards, 1f1b starts a backward as
+// soon as it can and keeps fewer microbatches in flight.
+class EmberPipelineParallelGenerator : public EmberDLGenerator {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        EmberPipelineParallelGenerator,
+        "ember",
+        "PipelineParallelMotif",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Performs pipeline parallel deep learning training steps",
+        SST::Ember::EmberPipelineParallelGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {   "arg.iterations",       "Sets the number of training steps",            "1"},
+        {   "arg.stages",           "Sets the number of stages of a pipeline, 0 for all the ranks", "0"},
+        {   "arg.microbatches",     "Sets the number of microbatches of a training step", "8"},
+        {   "arg.activationsize",   "Sets the bytes passed between stages for a microbatch", "1048576"},
+        {   "arg.forwardtime",      "Sets the forward compute time of a stage for a microbatch in nanoseconds", "1000"},
+        {   "arg.backwardtime",     "Sets the backward compute time of a stage for a microbatch in nanoseconds", "2000"},
+        {   "arg.schedule",         "Sets the pipeline schedule, gpipe or 1f1b", "1f1b"},
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "time-Init", "Time spent in Init event",          "ns",  0},
+        { "time-Finalize", "Time spent in Finalize event",  "ns", 0},
+        { "time-Rank", "Time spent in Rank event",          "ns", 0},
+        { "time-Size", "Time spent in Size event",          "ns", 0},
+        { "time-Send", "Time spent in Recv event",          "ns", 0},
+        { "time-Recv", "Time spent in Recv event",          "ns", 0},
+        { "time-Irecv", "Time spent in Irecv event",        "ns", 0},
+        { "time-Isend", "Time spent in Isend event",        "ns", 0},
+        { "time-Wait", "Time spent in Wait event",          "ns", 0},
+        { "time-Waitall", "Time spent in Waitall event",    "ns", 0},
+        { "time-Waitany", "Time spent in Waitany event",    "ns", 0},
+        { "time-Compute", "Time spent in Compute event",    "ns", 0},
+        { "time-Barrier", "Time spent in Barrier event",    "ns", 0},
+        { "time-Alltoallv", "Time spent in Alltoallv event", "ns", 0},
+        { "time-Alltoall", "Time spent in Alltoall event",  "ns", 0},
+        { "time-Allreduce", "Time spent in Allreduce event", "ns", 0},
+        { "time-Reduce", "Time spent in Reduce event",      "ns", 0},
+        { "time-Bcast", "Time spent in Bcast event",        "ns", 0},
+        { "time-Gettime", "Time spent in Gettime event",    "ns", 0},
+        { "time-Commsplit", "Time spent in Commsplit event", "ns", 0},
+        { "time-Commcreate", "Time spent in Commcreate event", "ns", 0},
+    )
+
+public:
+	EmberPipelineParallelGenerator(SST::ComponentId_t id, Params& params);
+    bool generate( std::queue<EmberEvent*>& evQ);
+
+private:
+    void enQ_forward( std::queue<EmberEvent*>& evQ );
+    void enQ_backward( std::queue<EmberEvent*>& evQ );
+
+    uint32_t m_iterations;
+    uint32_t m_stages;
+    uint32_t m_microbatches;
+    uint32_t m_activationSize;
+    uint64_t m_forwardTime;
+    uint64_t m_backwardTime;
+    bool     m_gpipe;
+
+    uint32_t m_loopIndex;
+    int      m_stage;
+    std::vector<MessageRequest> m_reqs;
+    int      m_numReqs;
+    uint64_t m_startTime;
+    uint64_t m_stopTime;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,94 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include "embertensorparallel.h"
+
+using namespace SST::Ember;
+
+#define TAG 0xD1A2
+
+EmberTensorParallelGenerator::EmberTensorParallelGenerator(SST::ComponentId_t id, Params& params) :
+	EmberDLGenerator(id, params, "TensorParallel"),
+    m_loopIndex(0)
+{
+	m_iterations = (uint32_t) params.find("arg.iterations", 1);
+	m_layers = (uint32_t) params.find("arg.layers", 24);
+	m_activationSize = params.find<uint64_t>("arg.activationsize", 1048576);
+	m_forwardTime = params.find<uint64_t>("arg.forwardtime", 1000);
+	m_backwardTime = params.find<uint64_t>("arg.backwardtime", 2000);
+	m_tpSize = (uint32_t) params.find("arg.tpsize", 0);
+
+	if ( 0 == m_tpSize ) {
+		m_tpSize = size();
+	}
+	if ( size() % m_tpSize ) {
+		fatal(CALL_INFO, -1, "Error: TensorParallel motif tpsize %" PRIu32 " does not divide %d ranks\n",
+			m_tpSize, size());
+	}
+	m_group = contiguousGroup( m_tpSize );
+}
+
+void EmberTensorParallelGenerator::enQ_layer( std::queue<EmberEvent*>& evQ, uint64_t computeTime )
+{
+    Steps steps;
+    ringAllgather( m_group, m_activationSize, steps );
+    for ( unsigned i = 0; i < steps.size(); i++ ) {
+        enQ_step( evQ, steps[i], 0, TAG );
+    }
+
+    enQ_compute( evQ, computeTime );
+
+    steps.clear();
+    ringReduceScatter( m_group, m_activationSize, steps );
+    for ( unsigned i = 0; i < steps.size(); i++ ) {
+        enQ_step( evQ, steps[i], 0, TAG );
+    }
+}
+
+bool EmberTensorParallelGenerator::generate( std::queue<EmberEvent*>& evQ)
+{
+    if ( m_loopIndex == m_iterations ) {
+        if ( 0 == rank()) {
+            double totalTime = (double)(m_stopTime - m_startTime)/1000000000.0;
+
+            output("%s total time %.3f us, loop %d, tpsize %" PRIu32
+                    ", time per step %.3f us\n",
+                                getMotifName().c_str(),
+                                totalTime * 1000000.0, m_iterations, m_tpSize,
+                                totalTime * 1000000.0 / m_iterations );
+        }
+        return true;
+    }
+
+    if ( 0 == m_loopIndex ) {
+        verbose( CALL_INFO, 1, 0, "rank=%d size=%d\n", rank(), size());
+        allocBuffers( m_activationSize );
+        enQ_getTime( evQ, &m_startTime );
+    }
+
+    for ( uint32_t layer = 0; layer < m_layers; layer++ ) {
+        enQ_layer( evQ, m_forwardTime );
+    }
+    for ( uint32_t layer = 0; layer < m_layers; layer++ ) {
+        enQ_layer( evQ, m_backwardTime );
+    }
+
+    if ( ++m_loopIndex == m_iterations ) {
+        enQ_getTime( evQ, &m_stopTime );
+    }
+    return false;
+}
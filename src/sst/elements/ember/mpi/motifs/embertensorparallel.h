@@ -0,0 +1,97 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_TENSOR_PARALLEL
+#define _H_EMBER_TENSOR_PARALLEL
+
+#include "mpi/motifs/emberdlgen.h"
+
+namespace SST {
+namespace Ember {
+
+// Tensor (and sequence) parallel training step in the style of Megatron-LM.
+// The ranks are split into contiguous groups of tpsize, each layer all-gathers
+// its input activations over the group before computing and reduce-scatters
+// its output after, in the forward and again in the backward pass.
+class EmberTensorParallelGenerator : public EmberDLGenerator {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        EmberTensorParallelGenerator,
+        "ember",
+        "TensorParallelMotif",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Performs tensor parallel deep learning training steps",
+        SST::Ember::EmberTensorParallelGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {   "arg.iterations",       "Sets the number of training steps",            "1"},
+        {   "arg.layers",           "Sets the number of layers of the model",       "24"},
+        {   "arg.activationsize",   "Sets the bytes of the full activation of a layer", "1048576"},
+        {   "arg.forwardtime",      "Sets the forward compute time of a layer in nanoseconds", "1000"},
+        {   "arg.backwardtime",     "Sets the backward compute time of a layer in nanoseconds", "2000"},
+        {   "arg.tpsize",           "Sets the number of ranks a layer is split across, 0 for all of them", "0"},
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "time-Init", "Time spent in Init event",          "ns",  0},
+        { "time-Finalize", "Time spent in Finalize event",  "ns", 0},
+        { "time-Rank", "Time spent in Rank event",          "ns", 0},
+        { "time-Size", "Time spent in Size event",          "ns", 0},
+        { "time-Send", "Time spent in Recv event",          "ns", 0},
+        { "time-Recv", "Time spent in Recv event",          "ns", 0},
+        { "time-Irecv", "Time spent in Irecv event",        "ns", 0},
+        { "time-Isend", "Time spent in Isend event",        "ns", 0},
+        { "time-Wait", "Time spent in Wait event",          "ns", 0},
+        { "time-Waitall", "Time spent in Waitall event",    "ns", 0},
+        { "time-Waitany", "Time spent in Waitany event",    "ns", 0},
+        { "time-Compute", "Time spent in Compute event",    "ns", 0},
+        { "time-Barrier", "Time spent in Barrier event",    "ns", 0},
+        { "time-Alltoallv", "Time spent in Alltoallv event", "ns", 0},
+        { "time-Alltoall", "Time spent in Alltoall event",  "ns", 0},
+        { "time-Allreduce", "Time spent in Allreduce event", "ns", 0},
+        { "time-Reduce", "Time spent in Reduce event",      "ns", 0},
+        { "time-Bcast", "Time spent in Bcast event",        "ns", 0},
+        { "time-Gettime", "Time spent in Gettime event",    "ns", 0},
+        { "time-Commsplit", "Time spent in Commsplit event", "ns", 0},
+        { "time-Commcreate", "Time spent in Commcreate event", "ns", 0},
+    )
+
+public:
+	EmberTensorParallelGenerator(SST::ComponentId_t id, Params& params);
+    bool generate( std::queue<EmberEvent*>& evQ);
+
+private:
+    void enQ_layer( std::queue<EmberEvent*>& evQ, uint64_t computeTime );
+
+    uint32_t m_iterations;
+    uint32_t m_layers;
+    uint64_t m_activationSize;
+    uint64_t m_forwardTime;
+    uint64_t m_backwardTime;
+    uint32_t m_tpSize;
+
+    uint32_t m_loopIndex;
+    std::vector<int> m_group;
+    uint64_t m_startTime;
+    uint64_t m_stopTime;
+};
+
+}
+}
+
+#endif
@@ -47,6 +47,10 @@
 #include <cmath>
 #include <cstring>
 #include <climits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace SST;
 using namespace SST::Ember;
@@ -96,6 +100,8 @@ EmberTriCountGenerator::init_vertices() {
 
   // Read in precomputed Vertices (start index of vertex i's edges)
   std::string vertices_filename( (std::string) params_.find<std::string>("arg.vertices_filename") );
+  if (init_vertices_binary(vertices_filename)) return;
+
   std::ifstream infile;
   infile.open(vertices_filename);
   if (!infile.is_open()) { printf("File open failed\n"); abort(); }
@@ -124,6 +130,42 @@ EmberTriCountGenerator::init_vertices() {
   }
 }
 
+// Binary files written by embertricount_setup are mapped instead of parsed:
+// magic, number of edges, number of vertices, then the Vertices array
+bool
+EmberTriCountGenerator::init_vertices_binary(const std::string& filename) {
+  static const char magic[8] = { 'E', 'M', 'B', 'R', 'T', 'R', 'I', '1' };
+  const size_t header = sizeof(magic) + 2 * sizeof(uint64_t);
+
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) { printf("File open failed\n"); abort(); }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t) st.st_size < header) { close(fd); return false; }
+
+  char* file = (char*) mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (file == MAP_FAILED) { printf("File map failed\n"); abort(); }
+  if (memcmp(file, magic, sizeof(magic)) != 0) { munmap(file, st.st_size); return false; }
+
+  memcpy(&num_edges_, file + sizeof(magic), sizeof(uint64_t));
+  memcpy(&num_vertices_, file + sizeof(magic) + sizeof(uint64_t), sizeof(uint64_t));
+  if ((size_t) st.st_size < header + num_vertices_ * sizeof(uint64_t) || num_vertices_ == 0) {
+    printf("Vertices file is truncated\n"); abort();
+  }
+
+  Vertices_.resize(num_vertices_ + 1);
+  memcpy(Vertices_.data(), file + header, num_vertices_ * sizeof(uint64_t));
+  // Repeat the last entry so the last vertex has zero edges by difference
+  Vertices_[num_vertices_] = Vertices_[num_vertices_ - 1];
+  munmap(file, st.st_size);
+
+  if (rank_ == 0 && debug_ > 2) {
+    for (int i=0; i<Vertices_.size(); ++i)
+      std::cerr << i << " " << Vertices_[i] << std::endl;
+  }
+  return true;
+}
+
 void
 EmberTriCountGenerator::first_edges() {
   // Compute first edge that each rank holds in distributed array
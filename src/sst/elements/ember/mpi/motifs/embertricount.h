@@ -40,12 +40,13 @@ public:
       )
 
   SST_ELI_DOCUMENT_PARAMS(
-      {   "arg.vertices_filename", "Filename for precomputed Vertices", "vertices.txt"}
+      {   "arg.vertices_filename", "Filename for precomputed Vertices, text or binary as written by embertricount_setup", "vertices.txt"}
       )
 
   EmberTriCountGenerator(SST::ComponentId_t id, Params& prms);
   ~EmberTriCountGenerator() {}
   void init_vertices();
+  bool init_vertices_binary(const std::string& filename);
   void first_edges();
   void starts();
   bool generate(std::queue<EmberEvent*>& evQ);
@@ -18,6 +18,7 @@
 import sys
 import sst
 from sst.merlin.base import *
+from sst.merlin.endpoint import *
 from sst.firefly import *
 
 class EmberJob(Job):
@@ -195,6 +196,46 @@ class EmberMPIJob(EmberJob):
         self._lockVariable("nic")
 
 
+# Rank-symmetry folding of an MPI job too big to build rank by rank. Only
+# representative_nodes of the num_nodes nodes run the motifs in detail, as an
+# EmberMPIJob of that size, so the motifs are given arguments for that many
+# ranks. They are spread evenly over the nodes left when allocate() is called
+# and the rest of the nodes are a merlin BackgroundTrafficJob, which stands in
+# for the traffic of the folded ranks with background.offered_load and
+# background.pattern. This fits motifs where every rank does the same thing,
+# e.g. Halo3D, Allreduce and Sweep3D.
+class EmberFoldedMPIJob(object):
+    def __init__(self, job_id, num_nodes, representative_nodes, numCores = 1, nicsPerNode = 1, background_job_id = None):
+        if representative_nodes < 1 or representative_nodes > num_nodes:
+            print("ERROR: EmberFoldedMPIJob needs between 1 and %d representative nodes, got %d"%(num_nodes,representative_nodes))
+            sst.exit()
+
+        self.detailed = EmberMPIJob(job_id,representative_nodes,numCores,nicsPerNode)
+        self.background = None
+        if representative_nodes < num_nodes:
+            if background_job_id is None:
+                background_job_id = job_id + 1
+            self.background = BackgroundTrafficJob(background_job_id,(num_nodes - representative_nodes) * nicsPerNode)
+
+    def addMotif(self,motif):
+        self.detailed.addMotif(motif)
+
+    def setNetworkInterface(self,networkif):
+        self.detailed.network_interface = networkif
+        if self.background:
+            self.background.network_interface = networkif
+
+    def allocate(self,system):
+        block_size = system.allocation_block_size
+        if not block_size: block_size = 1
+        units = -(-self.detailed.getSize() // block_size)
+        available = len(system._available_nodes)
+
+        system.allocateNodes(self.detailed,"indexed",[ i * available // units for i in range(units) ])
+        if self.background:
+            system.allocateNodes(self.background,"linear")
+
+
 class EmberSimpleMemoryJob(EmberJob):
     def __init__(self, job_id, num_nodes, apis, numCores = 1, nicsPerNode = 1):
         EmberJob.__init__(self,job_id,num_nodes,apis,numCores,nicsPerNode)
@@ -29,6 +29,7 @@
 #define enQ_getv shmem().getv
 #define enQ_put_nbi shmem().put_nbi
 #define enQ_get_nbi shmem().get_nbi
+#define enQ_triggered_put shmem().triggered_put
 #define enQ_add shmem().add
 #define enQ_fadd shmem().fadd
 #define enQ_swap shmem().swap
@@ -37,13 +37,18 @@
 // information, see the LICENSE file in the top level directory of the
 // distribution.
 
-#include <map>
-#include <set>
+#include <algorithm>
+#include <cstring>
 #include <random>
 #include <fstream>
 #include <iostream>
+#include <thread>
+#include <vector>
 
-int scale;
+// Binary Vertices files start with this word, followed by the number of
+// edges, the number of vertices and the Vertices array, all uint64_t.
+// The motif maps these directly (see EmberTriCountGenerator::init_vertices).
+static const char binary_magic[8] = { 'E', 'M', 'B', 'R', 'T', 'R', 'I', '1' };
 
 struct RMAT_args_t {
   uint64_t seed;
@@ -54,10 +59,10 @@ struct RMAT_args_t {
   double D;
 };
 
-using edges_t = std::map< uint64_t, std::set<uint64_t> >;
-edges_t edges;
+using edge_t = std::pair<uint64_t, uint64_t>;
+using edges_t = std::vector<edge_t>;
 
-void RMAT(const RMAT_args_t & args, uint64_t ndx) {
+void RMAT(const RMAT_args_t & args, uint64_t ndx, edges_t & edges) {
   std::mt19937_64 gen64(args.seed + ndx);
   uint64_t max_rand = gen64.max();
   uint64_t src = 0, dst = 0;
@@ -72,20 +77,52 @@ void RMAT(const RMAT_args_t & args, uint64_t ndx) {
 
   if (src != dst) {                          // do not include self edges
     if (src > dst) std::swap(src, dst);     // make src less than dst
-    edges[src].insert( dst );
+    edges.push_back( edge_t(src, dst) );
   }
 }
 
+// Generate edges [first, last) and bin them by the thread that will count their source
+void generate(const RMAT_args_t & args, uint64_t first, uint64_t last, std::vector<edges_t> & bins) {
+  edges_t edges;
+  edges.reserve(last - first);
+  for (uint64_t i = first; i < last; ++i)
+    RMAT(args, i, edges);
+  for (auto& e: edges)
+    bins[e.first % bins.size()].push_back(e);
+}
+
+// Count the unique edges of every source vertex owned by this thread
+void count(std::vector< std::vector<edges_t> > & bins, size_t owner, std::vector<int64_t> & degree) {
+  edges_t edges;
+  for (auto& thread_bins: bins) {
+    edges.insert(edges.end(), thread_bins[owner].begin(), thread_bins[owner].end());
+    edges_t().swap(thread_bins[owner]);
+  }
+  std::sort(edges.begin(), edges.end());
+  auto end = std::unique(edges.begin(), edges.end());
+  for (auto it = edges.begin(); it != end; ++it)
+    ++degree[it->first];
+}
+
 int main(int argc, char **argv){
-  if (argc != 8) {printf("Usage: <seed> <scale> <edge ratio> <A> <B> <C> <filename>\n"); return 1;}
+  if (argc < 8 || argc > 10) {
+    printf("Usage: <seed> <scale> <edge ratio> <A> <B> <C> <filename> [threads] [text|binary]\n");
+    return 1;
+  }
 
   uint64_t seed = std::stoll(argv[1]);
   uint64_t scale = std::stoll(argv[2]);
-  uint64_t num_vertices = 1 << std::stoll(argv[2]);
+  uint64_t num_vertices = uint64_t(1) << scale;
   uint64_t target_edges = num_vertices * std::stoll(argv[3]);
   uint64_t num_edges = 0;
   std::string filename(argv[7]);
 
+  unsigned num_threads = (argc > 8) ? std::stoul(argv[8]) : std::thread::hardware_concurrency();
+  if (num_threads == 0) num_threads = 1;
+  std::string format = (argc > 9) ? argv[9] : "text";
+  if (format != "text" && format != "binary")
+     {printf("output format must be text or binary\n"); return 1;}
+
   double A = std::stod(argv[4]) / 100.0;
   double B = std::stod(argv[5]) / 100.0;
   double C = std::stod(argv[6]) / 100.0;
@@ -96,33 +133,45 @@ int main(int argc, char **argv){
 
   RMAT_args_t rmat_args = {seed, scale, A, B, C, D};
 
-  for (int i=0; i<target_edges; ++i)
-    RMAT(rmat_args,i);
-
-  // Compute total number of edges
-  for (auto& it: edges) {
-    num_edges += it.second.size();
+  // Each edge is seeded by its index, so the graph does not depend on the thread count
+  std::vector< std::vector<edges_t> > bins(num_threads, std::vector<edges_t>(num_threads));
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < num_threads; ++t) {
+    uint64_t first = (target_edges * t) / num_threads;
+    uint64_t last = (target_edges * (t + 1)) / num_threads;
+    threads.emplace_back(generate, std::cref(rmat_args), first, last, std::ref(bins[t]));
   }
+  for (auto& thread: threads) thread.join();
+  threads.clear();
 
-//  for (auto& it: edges) {
-//    std::cout << it.first;
-//    for (auto& it2: it.second)
-//      std::cout << " " << it2;
-//    std::cout << std::endl;
-//  }
+  // Sources are binned by thread, so each degree entry has one writer
+  std::vector<int64_t> degree(num_vertices, 0);
+  for (unsigned t = 0; t < num_threads; ++t)
+    threads.emplace_back(count, std::ref(bins), t, std::ref(degree));
+  for (auto& thread: threads) thread.join();
 
   // Set Vertices[i] to start index of vertex i's edges
   std::vector<int64_t> Vertices(num_vertices);
   Vertices[0]=0;
-  for (int i=1; i<num_vertices; ++i) {
-    Vertices[i] = Vertices[i-1] + edges[i-1].size();
+  for (uint64_t i=1; i<num_vertices; ++i) {
+    Vertices[i] = Vertices[i-1] + degree[i-1];
   }
+  // Compute total number of edges
+  num_edges = Vertices[num_vertices-1] + degree[num_vertices-1];
 
   std::ofstream outfile;
-  outfile.open(filename, std::ios::out);
-  outfile << num_edges << std::endl;
-  for (int i=0; i < num_vertices; ++i) {
-    outfile << i << " " << Vertices[i] << std::endl;
+  if (format == "binary") {
+    outfile.open(filename, std::ios::out | std::ios::binary);
+    outfile.write(binary_magic, sizeof(binary_magic));
+    outfile.write((const char*) &num_edges, sizeof(num_edges));
+    outfile.write((const char*) &num_vertices, sizeof(num_vertices));
+    outfile.write((const char*) Vertices.data(), num_vertices * sizeof(int64_t));
+  } else {
+    outfile.open(filename, std::ios::out);
+    outfile << num_edges << "\n";
+    for (uint64_t i=0; i < num_vertices; ++i) {
+      outfile << i << " " << Vertices[i] << "\n";
+    }
   }
   outfile.close();
 
@@ -18,59 +18,81 @@
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
-#include <map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <vector>
+
+// Output layout, read by Ember3DAMRBinaryFile:
+//   header    uint32 ranks, uint32 blocks, uint8 max refine level,
+//             uint32 blocks x, uint32 blocks y, uint32 blocks z
+//   index     uint64 file offset of each rank's block list
+//   per rank  uint32 block count, then per block uint32 id followed by
+//             int8 refine level, x down, x up, y down, y up, z down, z up
+static const size_t headerSize = 3 * sizeof(uint32_t) + sizeof(uint8_t) + 2 * sizeof(uint32_t);
+static const size_t blockSize  = sizeof(uint32_t) + 7 * sizeof(int8_t);
 
 void usage() {
-	printf("Usage: meshconverter <number ranks> <file in> <file out>\n");
+	printf("Usage: meshconverter <number ranks> <file in> <file out> [threads]\n");
 	printf("<no ranks>       Is the number of ranks represented by the mesh\n");
 	printf("<file in>        Is the input mesh definition in text\n");
 	printf("<file out>       Is the output mesh definition to be written in binary\n");
+	printf("[threads]        Is the number of threads used to convert blocks (default: all cores)\n");
 	exit(-1);
 }
 
-char* readLine(FILE* input) {
-	char* theLine = (char*) malloc(sizeof(char) * 256);
+const char* nextLine(const char* pos, const char* end) {
+	const char* eol = (const char*) memchr(pos, '\n', end - pos);
+	return (NULL == eol) ? end : eol + 1;
+}
 
-	int nextIndex = 0;
-	char nextChar;
+// The input is mapped read-only and is not terminated, so numbers are
+// parsed here rather than with strtol
+long readValue(const char** pos, const char* end) {
+	const char* p = *pos;
+	while(p < end && (*p == ' ' || *p == '\t')) p++;
 
-	while( (nextChar = fgetc(input)) != '\n' &&
-		(nextChar != EOF) ) {
+	bool negative = false;
+	if(p < end && (*p == '-' || *p == '+')) {
+		negative = (*p == '-');
+		p++;
+	}
 
-		theLine[nextIndex] = nextChar;
-		nextIndex++;
+	long value = 0;
+	while(p < end && *p >= '0' && *p <= '9') {
+		value = (value * 10) + (*p - '0');
+		p++;
 	}
 
-	theLine[nextIndex] = '\0';
-	return theLine;
+	*pos = p;
+	return negative ? -value : value;
 }
 
-void readNextMeshLine(FILE* mesh, uint32_t* blockID, uint32_t* refineLev,
-                int8_t* xDown, int8_t* xUp,
-                int8_t* yDown, int8_t* yUp,
-                int8_t* zDown, int8_t* zUp) {
-
-        char* nextLine = readLine(mesh);
-
-        char* blockIDStr     = strtok(nextLine, " ");
-        char* refineLevelStr = strtok(NULL, " ");
-        char* xDStr          = strtok(NULL, " ");
-        char* xUStr          = strtok(NULL, " ");
-        char* yDStr          = strtok(NULL, " ");
-        char* yUStr          = strtok(NULL, " ");
-        char* zDStr          = strtok(NULL, " ");
-        char* zUStr          = strtok(NULL, " ");
-
-        *blockID   = (uint32_t) atoi(blockIDStr);
-        *refineLev = (uint32_t) atoi(refineLevelStr);
-        *xDown     = (int8_t) atoi(xDStr);
-        *xUp       = (int8_t) atoi(xUStr);
-        *yDown     = (int8_t) atoi(yDStr);
-        *yUp       = (int8_t) atoi(yUStr);
-        *zDown     = (int8_t) atoi(zDStr);
-        *zUp       = (int8_t) atoi(zUStr);
-
-	free(nextLine);
+void convertRanks(const char* const* rankStart, const uint32_t* rankBlocks, const uint64_t* rankOffset,
+		uint32_t first, uint32_t last, const char* end, char* out) {
+
+	for(uint32_t i = first; i < last; i++) {
+		char* next = out + rankOffset[i];
+		memcpy(next, &rankBlocks[i], sizeof(uint32_t));
+		next += sizeof(uint32_t);
+
+		const char* line = rankStart[i];
+		for(uint32_t j = 0; j < rankBlocks[i]; j++) {
+			const char* pos = line;
+			uint32_t blockID = (uint32_t) readValue(&pos, end);
+			memcpy(next, &blockID, sizeof(blockID));
+			next += sizeof(blockID);
+
+			// Refinement level followed by the six neighbor directions
+			for(int k = 0; k < 7; k++) {
+				*next++ = (char) (int8_t) readValue(&pos, end);
+			}
+
+			line = nextLine(line, end);
+		}
+	}
 }
 
 int main(int argc, char* argv[]) {
@@ -80,112 +102,115 @@ int main(int argc, char* argv[]) {
 		usage();
 	}
 
-	std::map<uint32_t, uint64_t> rankIndexMap;
 	uint32_t rankCount = (uint32_t) atoi(argv[1]);
+	uint32_t threadCount = (argc > 4) ? (uint32_t) atoi(argv[4]) : std::thread::hardware_concurrency();
+	if(0 == threadCount) {
+		threadCount = 1;
+	}
 
-	FILE* inMesh = fopen(argv[2], "rt");
-	if(NULL == inMesh) {
+	int inFD = open(argv[2], O_RDONLY);
+	struct stat inStat;
+	if(inFD < 0 || fstat(inFD, &inStat) != 0) {
 		fprintf(stderr, "Unable to open input mesh: %s\n", argv[2]);
 		exit(-1);
 	}
 
-	FILE* outMesh = fopen(argv[3], "wb");
-	if(NULL == outMesh) {
-		fprintf(stderr, "Unable to open output mesh: %s\n", argv[3]);
+	const size_t inSize = inStat.st_size;
+	const char* inMesh = (const char*) mmap(NULL, inSize, PROT_READ, MAP_PRIVATE, inFD, 0);
+	if(0 == inSize || MAP_FAILED == inMesh) {
+		fprintf(stderr, "Unable to read input mesh: %s\n", argv[2]);
 		exit(-1);
 	}
+	madvise((void*) inMesh, inSize, MADV_SEQUENTIAL);
+	const char* inEnd = inMesh + inSize;
 
-	char* meshHeader = readLine(inMesh);
+	const char* pos = inMesh;
+	uint32_t blockCount         = (uint32_t) readValue(&pos, inEnd);
+	uint8_t maxRefinementLevel  = (uint8_t)  readValue(&pos, inEnd);
+	uint32_t blocksX            = (uint32_t) readValue(&pos, inEnd);
+	uint32_t blocksY            = (uint32_t) readValue(&pos, inEnd);
+	uint32_t blocksZ            = (uint32_t) readValue(&pos, inEnd);
 
-	char* blockCountStr  = strtok(meshHeader, " ");
-        char* refineLevelStr = strtok(NULL, " ");
-        char* blocksXStr     = strtok(NULL, " ");
-        char* blocksYStr     = strtok(NULL, " ");
-        char* blocksZStr     = strtok(NULL, " ");
+	// Find where each rank's blocks start; the lines themselves are parsed in parallel
+	std::vector<const char*> rankStart(rankCount);
+	std::vector<uint32_t> rankBlocks(rankCount);
+	std::vector<uint64_t> rankOffset(rankCount);
 
-	uint32_t blockCount         = (uint32_t) atoi(blockCountStr);
-	uint8_t maxRefinementLevel  = (uint8_t)  atoi(refineLevelStr);
-	uint32_t blocksX            = (uint32_t) atoi(blocksXStr);
-	uint32_t blocksY            = (uint32_t) atoi(blocksYStr);
-	uint32_t blocksZ            = (uint32_t) atoi(blocksZStr);
+	const char* line = nextLine(inMesh, inEnd);
+	uint64_t nextFileIndex = headerSize + (rankCount * sizeof(uint64_t));
+	uint64_t totalBlocks = 0;
 
-	fwrite(&rankCount, sizeof(rankCount), 1, outMesh);
-	fwrite(&blockCount, sizeof(blockCount), 1, outMesh);
-	fwrite(&maxRefinementLevel, sizeof(maxRefinementLevel), 1, outMesh);
-	fwrite(&blocksX, sizeof(blocksX), 1, outMesh);
-	fwrite(&blocksY, sizeof(blocksY), 1, outMesh);
-	fwrite(&blocksZ, sizeof(blocksZ), 1, outMesh);
+	for(uint32_t i = 0; i < rankCount; i++) {
+		if(line >= inEnd) {
+			fprintf(stderr, "Input mesh ends before rank %" PRIu32 "\n", i);
+			exit(-1);
+		}
 
-	const size_t  rankIndexOffset = ftell(outMesh);
-	const uint64_t defaultIndex = (uint64_t) -1;
-	uint64_t nextFileIndex = rankIndexOffset;
+		pos = line;
+		rankBlocks[i] = (uint32_t) readValue(&pos, inEnd);
+		rankOffset[i] = nextFileIndex;
+		nextFileIndex += sizeof(uint32_t) + (rankBlocks[i] * blockSize);
+		totalBlocks += rankBlocks[i];
 
-	// Output the initial rank start index, all set to (uint64_t) -1
-	for(uint32_t i = 0; i < rankCount; i++) {
-		fwrite(&defaultIndex, sizeof(defaultIndex), 1, outMesh);
-		nextFileIndex += sizeof(defaultIndex);
+		line = nextLine(line, inEnd);
+		rankStart[i] = line;
+		for(uint32_t j = 0; j < rankBlocks[i]; j++) {
+			line = nextLine(line, inEnd);
+		}
 	}
 
-	printf("Generating block information at index: %" PRIu64 "\n",
-		(uint64_t) ftell(outMesh));
+	printf("Converting %" PRIu64 " blocks for %" PRIu32 " ranks using %" PRIu32 " threads\n",
+		totalBlocks, rankCount, threadCount);
 
-	uint32_t blocksOnNode = 0;
-	uint32_t nextBlockID = 0;
-	uint32_t nextBlockRefineLevel = 0;
-	int8_t  blockXDown = 0;
-	int8_t  blockXUp = 0;
-	int8_t  blockYDown = 0;
-	int8_t  blockYUp = 0;
-	int8_t  blockZDown = 0;
-	int8_t  blockZUp = 0;
+	int outFD = open(argv[3], O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if(outFD < 0 || ftruncate(outFD, nextFileIndex) != 0) {
+		fprintf(stderr, "Unable to open output mesh: %s\n", argv[3]);
+		exit(-1);
+	}
 
-	for(uint32_t i = 0; i < rankCount; i++) {
-		printf("Processing rank %" PRIu32 "...\n", i);
-
-		char* strBlocksOnNode = readLine(inMesh);
-		blocksOnNode = (uint32_t) atoi(strBlocksOnNode);
-
-		// Update the rank index
-		fseek(outMesh, rankIndexOffset + (i * sizeof(uint64_t)), SEEK_SET);
-		fwrite(&nextFileIndex, sizeof(nextFileIndex), 1, outMesh);
-
-		// Return back to original position
-		fseek(outMesh, nextFileIndex, SEEK_SET);
-
-		fwrite(&blocksOnNode, sizeof(blocksOnNode), 1, outMesh);
-		nextFileIndex += sizeof(blocksOnNode);
-
-		for(uint32_t j = 0; j < blocksOnNode; j++) {
-			readNextMeshLine(inMesh, &nextBlockID,
-				&nextBlockRefineLevel,
-				&blockXDown,
-				&blockXUp,
-				&blockYDown,
-				&blockYUp,
-				&blockZDown,
-				&blockZUp);
-
-			fwrite(&nextBlockID, sizeof(nextBlockID), 1, outMesh);
-			nextFileIndex += sizeof(nextBlockID);
-
-			int8_t nextBlockRefineLevel_8 = (int8_t) nextBlockRefineLevel;
-			fwrite(&nextBlockRefineLevel_8, sizeof(nextBlockRefineLevel_8), 1, outMesh);
-			fwrite(&blockXDown, sizeof(blockXDown), 1, outMesh);
-			fwrite(&blockXUp, sizeof(blockXUp), 1, outMesh);
-			fwrite(&blockYDown, sizeof(blockYDown), 1, outMesh);
-			fwrite(&blockYUp, sizeof(blockYUp), 1, outMesh);
-			fwrite(&blockZDown, sizeof(blockZDown), 1, outMesh);
-			fwrite(&blockZUp, sizeof(blockZUp), 1, outMesh);
-
-			nextFileIndex += sizeof(nextBlockRefineLevel_8) +
-				sizeof(blockXDown) + sizeof(blockXUp) +
-				sizeof(blockYDown) + sizeof(blockYUp) +
-				sizeof(blockZDown) + sizeof(blockZUp);
+	char* outMesh = (char*) mmap(NULL, nextFileIndex, PROT_READ | PROT_WRITE, MAP_SHARED, outFD, 0);
+	if(MAP_FAILED == outMesh) {
+		fprintf(stderr, "Unable to map output mesh: %s\n", argv[3]);
+		exit(-1);
+	}
+
+	char* next = outMesh;
+	memcpy(next, &rankCount, sizeof(rankCount));                   next += sizeof(rankCount);
+	memcpy(next, &blockCount, sizeof(blockCount));                 next += sizeof(blockCount);
+	memcpy(next, &maxRefinementLevel, sizeof(maxRefinementLevel)); next += sizeof(maxRefinementLevel);
+	memcpy(next, &blocksX, sizeof(blocksX));                       next += sizeof(blocksX);
+	memcpy(next, &blocksY, sizeof(blocksY));                       next += sizeof(blocksY);
+	memcpy(next, &blocksZ, sizeof(blocksZ));                       next += sizeof(blocksZ);
+	memcpy(next, rankOffset.data(), rankCount * sizeof(uint64_t));
+
+	// Give each thread a contiguous range of ranks holding about the same number of blocks
+	std::vector<std::thread> threads;
+	uint32_t first = 0;
+	uint64_t assigned = 0;
+	for(uint32_t t = 0; t < threadCount && first < rankCount; t++) {
+		const uint64_t target = (totalBlocks * (t + 1)) / threadCount;
+		uint32_t last = first;
+		while(last < rankCount && (assigned < target || t == threadCount - 1)) {
+			assigned += rankBlocks[last];
+			last++;
+		}
+		if(last == first) {
+			continue;
 		}
+
+		threads.emplace_back(convertRanks, rankStart.data(), rankBlocks.data(), rankOffset.data(),
+			first, last, inEnd, outMesh);
+		first = last;
+	}
+
+	for(auto& thread : threads) {
+		thread.join();
 	}
 
-	fclose(inMesh);
-	fclose(outMesh);
+	munmap(outMesh, nextFileIndex);
+	munmap((void*) inMesh, inSize);
+	close(outFD);
+	close(inFD);
 
 	return 0;
 }
@@ -0,0 +1,183 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_FIREFLY_CTRLMSGMATCHQUEUE_H
+#define COMPONENTS_FIREFLY_CTRLMSGMATCHQUEUE_H
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include "ctrlMsgCommReq.h"
+
+namespace SST {
+namespace Firefly {
+namespace CtrlMsg {
+
+// A queue of posted receives or unexpected messages kept in the order they
+// were queued. A search either walks the whole queue in order or, when
+// hashed, only the bin of entries with the same (group, rank, tag) and the
+// entries that can match more than one, so the oldest match is still found
+// first as MPI requires. The count returned by a search is the number of
+// entries examined, which is what matching is charged for.
+template< class T >
+class MatchQueue {
+
+    struct Key {
+        MP::Communicator group;
+        MP::RankID       rank;
+        uint64_t         tag;
+
+        bool operator==( const Key& other ) const {
+            return group == other.group && rank == other.rank && tag == other.tag;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()( const Key& key ) const {
+            uint64_t hash = key.tag * 0x9e3779b97f4a7c15ULL;
+            hash ^= ( (uint64_t) key.rank << 32 | key.group ) + 0x632be59bd9b4e019ULL + ( hash << 6 ) + ( hash >> 2 );
+            return hash;
+        }
+    };
+
+    struct Entry;
+    typedef std::list< Entry* > EntryList;
+
+    struct Entry {
+        T*        item;
+        uint64_t  seq;
+        Key       key;
+        EntryList* bin;
+        typename EntryList::iterator binPos;
+        typename EntryList::iterator orderPos;
+    };
+
+  public:
+    typedef std::function<bool(T*)> MatchFunc;
+
+    MatchQueue() : m_hashed( false ), m_nextSeq( 0 ) {}
+    ~MatchQueue() {
+        for ( typename EntryList::iterator iter = m_order.begin(); iter != m_order.end(); ++iter ) {
+            delete *iter;
+        }
+    }
+
+    void setHashed( bool hashed ) { m_hashed = hashed; }
+    bool isHashed() { return m_hashed; }
+
+    size_t size() { return m_order.size(); }
+    bool empty() { return m_order.empty(); }
+
+    // a receive header with a wildcard can match more than one bin
+    static bool isWild( MatchHdr& hdr, uint64_t ignore ) {
+        return MP::AnySrc == hdr.rank || AnyTag == hdr.tag || 0 != ignore;
+    }
+
+    void push_back( T* item, MatchHdr& hdr, bool wild ) {
+        Entry* entry = new Entry;
+        entry->item = item;
+        entry->seq = m_nextSeq++;
+        entry->key = key( hdr );
+        entry->bin = NULL;
+        entry->orderPos = m_order.insert( m_order.end(), entry );
+
+        if ( m_hashed ) {
+            entry->bin = wild ? &m_wild : &m_bins[ entry->key ];
+            entry->binPos = entry->bin->insert( entry->bin->end(), entry );
+        }
+    }
+
+    // Take the oldest entry that matches. hdr is the header being matched,
+    // wild says whether it has a wildcard, then every entry may match it.
+    T* match( MatchHdr& hdr, bool wild, MatchFunc func, int& count ) {
+        if ( ! m_hashed || wild ) {
+            return take( search( m_order, func, count, UINT64_MAX ) );
+        }
+
+        Entry* found = NULL;
+        typename std::unordered_map< Key, EntryList, KeyHash >::iterator bin = m_bins.find( key( hdr ) );
+        if ( bin != m_bins.end() ) {
+            found = search( bin->second, func, count, UINT64_MAX );
+        }
+
+        // a wild entry queued before the binned match wins
+        Entry* wildFound = search( m_wild, func, count, found ? found->seq : UINT64_MAX );
+        if ( wildFound ) {
+            found = wildFound;
+        }
+
+        return take( found );
+    }
+
+    bool remove( T* item ) {
+        for ( typename EntryList::iterator iter = m_order.begin(); iter != m_order.end(); ++iter ) {
+            if ( (*iter)->item == item ) {
+                take( *iter );
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+
+    Key key( MatchHdr& hdr ) {
+        Key key = { hdr.group, hdr.rank, hdr.tag };
+        return key;
+    }
+
+    Entry* search( EntryList& list, MatchFunc& func, int& count, uint64_t before ) {
+        for ( typename EntryList::iterator iter = list.begin(); iter != list.end(); ++iter ) {
+            if ( (*iter)->seq >= before ) {
+                break;
+            }
+            ++count;
+            if ( func( (*iter)->item ) ) {
+                return *iter;
+            }
+        }
+        return NULL;
+    }
+
+    T* take( Entry* entry ) {
+        if ( NULL == entry ) {
+            return NULL;
+        }
+
+        T* item = entry->item;
+        m_order.erase( entry->orderPos );
+
+        if ( entry->bin ) {
+            entry->bin->erase( entry->binPos );
+            if ( entry->bin->empty() && entry->bin != &m_wild ) {
+                m_bins.erase( entry->key );
+            }
+        }
+        delete entry;
+        return item;
+    }
+
+    bool        m_hashed;
+    uint64_t    m_nextSeq;
+    EntryList   m_order;
+    EntryList   m_wild;
+    std::unordered_map< Key, EntryList, KeyHash > m_bins;
+};
+
+}
+}
+}
+
+#endif
@@ -50,8 +50,18 @@ ProcessQueuesState::ProcessQueuesState( ComponentId_t id, Params& params ) :
 
     m_dbg.init("", level, mask, Output::STDOUT );
 
+    std::string matchEngine = params.find<std::string>("pqs.matchEngine","list");
+    if ( matchEngine == "hashed" ) {
+        m_pstdRcvQ.setHashed( true );
+        m_unexpectedMatchQ.setHashed( true );
+    } else if ( matchEngine != "list" ) {
+        m_dbg.fatal(CALL_INFO,-1, "pqs.matchEngine must be list or hashed, got %s\n", matchEngine.c_str() );
+    }
+
     m_statPstdRcv = registerStatistic<uint64_t>("posted_receive_list");
     m_statRcvdMsg = registerStatistic<uint64_t>("received_msg_list");
+    m_statPstdMatch = registerStatistic<uint64_t>("posted_match_length");
+    m_statUnexpectedMatch = registerStatistic<uint64_t>("unexpected_match_length");
 
     m_msgTiming = loadAnonymousSubComponent< MsgTiming >( "firefly.msgTiming", "", 0, ComponentInfo::SHARE_NONE, params );
 
@@ -328,7 +338,25 @@ void ProcessQueuesState::processRecv_0( _CommReq* req )
 
 void ProcessQueuesState::processRecv_1( _CommReq* req )
 {
-    if ( ! m_unexpectedMsgQ.empty() ) {
+    if ( m_unexpectedMatchQ.isHashed() ) {
+        if ( m_unexpectedMatchQ.empty() ) {
+            processRecv_3( req, NULL );
+        } else {
+            int count = 0;
+            Msg* msg = m_unexpectedMatchQ.match( req->hdr(), MatchQueue<Msg>::isWild( req->hdr(), req->ignore() ),
+                [this,req]( Msg* unexpected ) { return checkMatchHdr( unexpected->hdr(), req->hdr(), req->ignore() ); },
+                count );
+
+            dbg().debug(CALL_INFO,2,DBG_MSK_PQS_APP_SIDE,"examined %d unexpected messages, msg=%p\n", count, msg);
+            m_statUnexpectedMatch->addData( count );
+
+            // the matched message is checked again, and charged for, as it is processed
+            m_mem->walk(
+                std::bind( &ProcessQueuesState::processRecv_3, this, req, msg ),
+                msg ? count - 1 : count
+            );
+        }
+    } else if ( ! m_unexpectedMsgQ.empty() ) {
 
         dbg().debug(CALL_INFO,2,DBG_MSK_PQS_APP_SIDE,"check unexpected queue\n");
 
@@ -343,7 +371,31 @@ void ProcessQueuesState::processRecv_1( _CommReq* req )
         processShortList_0( &m_funcStack );
     } else {
         dbg().debug(CALL_INFO,2,DBG_MSK_PQS_APP_SIDE,"post receive\n");
-        m_pstdRcvQ.push_back( req );
+        m_pstdRcvQ.push_back( req, req->hdr(), MatchQueue<_CommReq>::isWild( req->hdr(), req->ignore() ) );
+        processRecv_2( NULL, req );
+    }
+}
+
+void ProcessQueuesState::processRecv_3( _CommReq* req, Msg* msg )
+{
+    if ( msg ) {
+        dbg().debug(CALL_INFO,2,DBG_MSK_PQS_APP_SIDE,"process matched unexpected message\n");
+
+        assert( m_unexpectedMsgQ.empty() );
+        m_unexpectedMsgQ.push_back( msg );
+
+        assert( m_pstdRcvPreQ.empty() );
+        m_pstdRcvPreQ.push_back( req );
+
+        ProcessQueuesCtx* ctx = new ProcessQueuesCtx(
+            std::bind( &ProcessQueuesState::processRecv_2, this, &m_funcStack, req )
+        );
+
+        m_funcStack.push_back( ctx );
+        processShortList_0( &m_funcStack );
+    } else {
+        dbg().debug(CALL_INFO,2,DBG_MSK_PQS_APP_SIDE,"post receive\n");
+        m_pstdRcvQ.push_back( req, req->hdr(), MatchQueue<_CommReq>::isWild( req->hdr(), req->ignore() ) );
         processRecv_2( NULL, req );
     }
 }
@@ -358,7 +410,8 @@ void ProcessQueuesState::processRecv_2( Stack* stack, _CommReq* req )
 
     if ( ! m_pstdRcvPreQ.empty() ) {
         dbg().debug(CALL_INFO,2,DBG_MSK_PQS_APP_SIDE,"no match against unexpected queue move to pstRecvQ\n");
-        m_pstdRcvQ.push_back( m_pstdRcvPreQ.front() );
+        _CommReq* pre = m_pstdRcvPreQ.front();
+        m_pstdRcvQ.push_back( pre, pre->hdr(), MatchQueue<_CommReq>::isWild( pre->hdr(), pre->ignore() ) );
         m_pstdRcvPreQ.clear();
     }
 
@@ -408,15 +461,10 @@ void ProcessQueuesState::processMakeProgress( Stack* stack )
 
 void ProcessQueuesState::enterCancel( MP::MessageRequest req, uint64_t exitDelay ) {
 
-    std::deque< _CommReq* >:: iterator iter = m_pstdRcvQ.begin();
-    for ( ; iter != m_pstdRcvQ.end(); ++iter ) {
-
-		if ( *iter == req ) {
-    		dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"found req=%p\n",*iter);
-			delete( *iter );
-        	m_pstdRcvQ.erase(iter);
-			break;
-		}
+    _CommReq* commReq = static_cast<_CommReq*>( req );
+    if ( m_pstdRcvQ.remove( commReq ) ) {
+        dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"found req=%p\n",commReq);
+        delete commReq;
     }
     enterMakeProgress(m_exitDelay);
 }
@@ -630,7 +678,9 @@ void ProcessQueuesState::processShortList_1( Stack* stack )
         ctx->req = searchPostedRecv( m_pstdRcvPreQ, ctx->hdr(), count );
     } else {
         ctx->req = searchPostedRecv( m_pstdRcvQ, ctx->hdr(), count );
+        m_statPstdMatch->addData( count );
     }
+    ctx->examined += count;
 
     m_mem->walk(
         std::bind( &ProcessQueuesState::processShortList_2, this, stack ),
@@ -654,7 +704,7 @@ void ProcessQueuesState::processShortList_2( Stack* stack )
         if ( m_intStack.empty() ) {
             ctx->incPos();
         } else {
-            m_unexpectedMsgQ.push_back( ctx->msg() );
+            pushUnexpected( ctx->msg() );
             ctx->unlinkMsg();
         }
         processShortList_5( stack );
@@ -744,6 +794,11 @@ void ProcessQueuesState::processShortList_5( Stack* stack )
     if ( ctx->isDone() ) {
         dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"return up the stack\n");
 
+        // the hashed engine records its search of the unexpected messages as it makes it
+        if ( m_intStack.empty() && ! m_unexpectedMatchQ.isHashed() ) {
+            m_statUnexpectedMatch->addData( ctx->examined );
+        }
+
         delete stack->back();
         stack->pop_back();
         schedCallback( stack->back()->getCallback() );
@@ -1007,6 +1062,28 @@ _CommReq* ProcessQueuesState::searchPostedRecv( std::deque< _CommReq* >& pstd, M
     return req;
 }
 
+_CommReq* ProcessQueuesState::searchPostedRecv( MatchQueue< _CommReq >& pstd, MatchHdr& hdr, int& count )
+{
+    dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"posted size %lu\n",pstd.size());
+
+    _CommReq* req = pstd.match( hdr, false,
+        [this,&hdr]( _CommReq* posted ) { return checkMatchHdr( hdr, posted->hdr(), posted->ignore() ); },
+        count );
+
+    dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"req=%p\n",req);
+
+    return req;
+}
+
+void ProcessQueuesState::pushUnexpected( Msg* msg )
+{
+    if ( m_unexpectedMatchQ.isHashed() ) {
+        m_unexpectedMatchQ.push_back( msg, msg->hdr(), false );
+    } else {
+        m_unexpectedMsgQ.push_back( msg );
+    }
+}
+
 bool ProcessQueuesState::checkMatchHdr( MatchHdr& hdr, MatchHdr& wantHdr,
                                     uint64_t ignore )
 {
@@ -28,6 +28,7 @@
 
 #include "ctrlMsgCommReq.h"
 #include "ctrlMsgWaitReq.h"
+#include "ctrlMsgMatchQueue.h"
 
 #define DBG_MSK_PQS_APP_SIDE 1 << 0
 #define DBG_MSK_PQS_INT 1 << 1
@@ -74,6 +75,7 @@ class ProcessQueuesState : public SubComponent
         {"pqs.maxUnexpectedMsg","Sets the maximum unexpected messages","32" },
         {"pqs.maxPostedShortBuffers","Sets the maximum posted short buffers","512" },
         {"pqs.minPostedShortBuffers","Sets the minimum posted short buffers","5"},
+        {"pqs.matchEngine","How receives are matched, list walks the queues in order, hashed only searches the entries with the same (comm, src, tag) and the wildcards","list"},
         {"loopBackPortName","Sets port name to use when connecting to the loopBack component","loop"},
         {"ackVN","Sets the VN to use for acks","0"},
         {"rendezvousVN","Sets the VN to use for rendezvous","0"},
@@ -100,7 +102,9 @@ class ProcessQueuesState : public SubComponent
 
     SST_ELI_DOCUMENT_STATISTICS(
         { "posted_receive_list", "", "count", 1 },
-        { "received_msg_list", "", "count", 1 }
+        { "received_msg_list", "", "count", 1 },
+        { "posted_match_length", "Posted receives examined to match each received message", "count", 1 },
+        { "unexpected_match_length", "Unexpected messages examined to match each posted receive", "count", 1 }
     )
 
   private:
@@ -282,7 +286,7 @@ class ProcessQueuesState : public SubComponent
       public:
 
         ProcessShortListCtx( std::deque<Msg*>* msgQ ) :
-			m_msgQ(msgQ), m_iter( msgQ->begin() ), m_done(false) {}
+			examined(0), m_msgQ(msgQ), m_iter( msgQ->begin() ), m_done(false) {}
 
         MatchHdr&   hdr() { return (*m_iter)->hdr(); }
         std::vector<IoVec>& ioVec() { return (*m_iter)->ioVec(); }
@@ -290,6 +294,7 @@ class ProcessQueuesState : public SubComponent
         Msg* msg() { return *m_iter; }
 
         _CommReq*    req;
+        int          examined;
 
         void removeMsg() {
             delete *m_iter;
@@ -342,6 +347,7 @@ class ProcessQueuesState : public SubComponent
     void processRecv_0( _CommReq* );
     void processRecv_1( _CommReq* );
     void processRecv_2( Stack*,_CommReq* );
+    void processRecv_3( _CommReq*, Msg* );
 
     void processMakeProgress( Stack* );
 
@@ -380,6 +386,8 @@ class ProcessQueuesState : public SubComponent
 
     bool        checkMatchHdr( MatchHdr& hdr, MatchHdr& wantHdr, uint64_t ignore );
     _CommReq*	searchPostedRecv( std::deque< _CommReq* >& pstd, MatchHdr& hdr, int& delay );
+    _CommReq*	searchPostedRecv( MatchQueue< _CommReq >& pstd, MatchHdr& hdr, int& delay );
+    void        pushUnexpected( Msg* );
 
     void exit( int delay = 0 ) {
         dbg().debug(CALL_INFO,2,DBG_MSK_PQS_APP_SIDE,"exit ProcessQueuesState\n");
@@ -480,11 +488,12 @@ class ProcessQueuesState : public SubComponent
     int     m_numRecvLooped;
     bool    m_missedInt;
 
-    std::deque< _CommReq* >         m_pstdRcvQ;
+    MatchQueue< _CommReq >          m_pstdRcvQ;
     std::deque< _CommReq* >         m_pstdRcvPreQ;
     std::vector<std::deque< Msg* >> m_recvdMsgQ;
 	int m_recvdMsgQpos;
     std::deque< Msg* >              m_unexpectedMsgQ;
+    MatchQueue< Msg >               m_unexpectedMatchQ; // hashed matching, m_unexpectedMsgQ then only holds the message being matched
 
     std::deque< _CommReq* >         m_longGetFiniQ;
     std::deque< GetInfo* >          m_longAckQ;
@@ -506,6 +515,8 @@ class ProcessQueuesState : public SubComponent
 
     Statistic<uint64_t>* m_statRcvdMsg;
     Statistic<uint64_t>* m_statPstdRcv;
+    Statistic<uint64_t>* m_statPstdMatch;
+    Statistic<uint64_t>* m_statUnexpectedMatch;
     int m_numSent;
     int m_numRecv;
     int m_nicsPerNode;
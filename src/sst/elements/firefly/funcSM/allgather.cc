@@ -28,13 +28,17 @@ const char* AllgatherFuncSM::m_enumName[] = {
     FOREACH_ENUM(GENERATE_STRING)
 };
 
+static const char* algorithms[] = { "bruck", "ring", "recursive_doubling", NULL };
+
 AllgatherFuncSM::AllgatherFuncSM( SST::Params& params ) :
     FunctionSMInterface( params ),
     m_event( NULL ),
-    m_seq( 0 )
+    m_seq( 0 ),
+    m_schedule( m_dbg )
 {
         m_smallCollectiveVN = params.find<int>( "smallCollectiveVN", 0);
         m_smallCollectiveSize = params.find<int>( "smallCollectiveSize", 0);
+        m_schedule.configure( params, "bruck", algorithms );
 }
 
 void AllgatherFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
@@ -47,6 +51,17 @@ void AllgatherFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
     m_rank = m_info->getGroup(m_event->group)->getMyRank();
     m_size = m_info->getGroup(m_event->group)->getSize();
 
+    size_t bytes = 0;
+    for ( int i = 0; i < m_size; i++ ) {
+        bytes += chunkSize( i );
+    }
+    std::string algorithm = m_schedule.select( m_size, bytes );
+    if ( algorithm != "bruck" ) {
+        startSchedule( algorithm );
+        handleEnterEvent( retval );
+        return;
+    }
+
     int numStages = ceil( log2(m_size) );
     m_dbg.debug(CALL_INFO,1,0,"numStages=%d rank=%d size=%d\n",
                                         numStages, m_rank, m_size );
@@ -63,6 +78,35 @@ void AllgatherFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
     handleEnterEvent( retval );
 }
 
+void AllgatherFuncSM::startSchedule( const std::string& algorithm )
+{
+    std::vector<CollectiveSegment> chunks( m_size );
+    for ( int i = 0; i < m_size; i++ ) {
+        chunks[i] = CollectiveSegment( chunkOffset( i ), chunkSize( i ) );
+    }
+
+    CollectiveSchedulePlan& plan = m_schedule.plan();
+    plan.clear();
+    if ( algorithm != "recursive_doubling" ||
+            ! CollectiveAlgorithms::allgatherRecursiveDoubling( m_rank, chunks, plan ) ) {
+        CollectiveAlgorithms::allgatherRing( m_rank, chunks, plan );
+    }
+
+    m_dbg.debug(CALL_INFO,1,0,"%s rank=%d size=%d steps=%zu\n",
+                        algorithm.c_str(), m_rank, m_size, plan.size() );
+
+    void* buf = NULL;
+    if ( m_event->sendbuf.getBacking() && m_event->recvbuf.getBacking() ) {
+        buf = m_event->recvbuf.getBacking();
+        memcpy( chunkPtr(m_rank), m_event->sendbuf.getBacking(), chunkSize(m_rank) );
+    }
+
+    m_schedule.start( proto(), m_event->group, genTag(), buf, m_event->recvtype,
+                m_info->sizeofDataType( m_event->recvtype ), NULL,
+                m_smallCollectiveVN, m_smallCollectiveSize );
+    m_state = Schedule;
+}
+
 bool AllgatherFuncSM::setup( Retval& retval )
 {
 	Hermes::MemAddr addr;
@@ -188,6 +232,11 @@ void AllgatherFuncSM::handleEnterEvent( Retval& retval )
         }
         return;
 
+    case Schedule:
+        if ( m_schedule.advance() ) {
+            return;
+        }
+
     case Exit:
         m_dbg.debug(CALL_INFO,1,0,"leave\n");
         retval.setExit( 0 );
@@ -18,6 +18,7 @@
 
 #include "funcSM/api.h"
 #include "funcSM/event.h"
+#include "funcSM/collectiveSchedule.h"
 #include "ctrlMsg.h"
 #include "info.h"
 
@@ -32,6 +33,7 @@ namespace Firefly {
     NAME(SendData) \
     NAME(WaitRecvData) \
     NAME(Exit) \
+    NAME(Schedule) \
 
 #define GENERATE_ENUM(ENUM) ENUM,
 #define GENERATE_STRING(STRING) #STRING,
@@ -50,6 +52,13 @@ class AllgatherFuncSM :  public FunctionSMInterface
         SST::Firefly::AllgatherFuncSM
     )
 
+    SST_ELI_DOCUMENT_PARAMS(
+        {"smallCollectiveVN","Sets the VN to use for small collectives","0"},
+        {"smallCollectiveSize","Sets the size of small collectives","0"},
+        {"algorithm","Allgather algorithm: bruck, ring or recursive_doubling, which needs a power of two ranks and uses ring otherwise","bruck"},
+        {"algorithmRules","Comma separated ranks:bytes:algorithm rules, the last rule with ranks and bytes at most those of the gathered data picks its algorithm, otherwise algorithm is used",""},
+    )
+
   private:
     enum StateEnum {
         FOREACH_ENUM(GENERATE_ENUM)
@@ -82,6 +91,7 @@ class AllgatherFuncSM :  public FunctionSMInterface
   private:
 
     bool setup( Retval& );
+    void startSchedule( const std::string& algorithm );
     void initIoVec(std::vector<IoVec>& ioVec, int startChunk, int numChunks, bool backed );
 
     std::string stateName( StateEnum i ) { return m_enumName[i]; }
@@ -97,13 +107,17 @@ class AllgatherFuncSM :  public FunctionSMInterface
         return  src < 0 ? m_size + src : src;
     }
 
-    unsigned char* chunkPtr( int rank ) {
-        unsigned char* ptr = (unsigned char*) m_event->recvbuf.getBacking();
+    size_t chunkOffset( int rank ) {
         if ( m_event->recvcntPtr ) {
-            ptr += ((int*)m_event->displsPtr)[rank];
+            return ((int*)m_event->displsPtr)[rank];
         } else {
-            ptr += rank * chunkSize( rank );
+            return rank * chunkSize( rank );
         }
+    }
+
+    unsigned char* chunkPtr( int rank ) {
+        unsigned char* ptr = (unsigned char*) m_event->recvbuf.getBacking();
+        ptr += chunkOffset( rank );
         m_dbg.debug(CALL_INFO,2,0,"rank %d, ptr %p\n", rank, ptr);
 
         return ptr;
@@ -136,6 +150,7 @@ class AllgatherFuncSM :  public FunctionSMInterface
     int                 m_size;
     unsigned int        m_currentStage;
     static const char*  m_enumName[];
+    CollectiveSchedule  m_schedule;
 
     int m_smallCollectiveVN;
     int m_smallCollectiveSize;
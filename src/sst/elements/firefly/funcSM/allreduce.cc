@@ -0,0 +1,103 @@
+// Copyright 2013-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include <string.h>
+
+#include "funcSM/allreduce.h"
+#include "info.h"
+
+using namespace SST::Firefly;
+
+static const char* algorithms[] = { "tree", "recursive_doubling", "rabenseifner", "ring", NULL };
+
+AllreduceFuncSM::AllreduceFuncSM( SST::Params& params ) :
+    CollectiveTreeFuncSM( params ),
+    m_schedule( m_dbg ),
+    m_event( NULL ),
+    m_seq( 0 )
+{
+    m_smallCollectiveVN = params.find<int>( "smallCollectiveVN", 0);
+    m_smallCollectiveSize = params.find<int>( "smallCollectiveSize", 0);
+    m_schedule.configure( params, "tree", algorithms );
+}
+
+void AllreduceFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
+{
+    CollectiveStartEvent* event = static_cast< CollectiveStartEvent* >(e);
+
+    if ( event->type != CollectiveStartEvent::Allreduce ) {
+        CollectiveTreeFuncSM::handleStartEvent( e, retval );
+        return;
+    }
+
+    int rank = m_info->getGroup( event->group )->getMyRank();
+    int size = m_info->getGroup( event->group )->getSize();
+    size_t dtypeSize = m_info->sizeofDataType( event->dtype );
+    std::string algorithm = m_schedule.select( size, event->count * dtypeSize );
+
+    if ( algorithm == "tree" ) {
+        CollectiveTreeFuncSM::handleStartEvent( e, retval );
+        return;
+    }
+
+    assert( NULL == m_event );
+    m_event = event;
+    ++m_seq;
+
+    m_dbg.debug(CALL_INFO,1,0,"%s group %d, size %d, rank %d, count %d\n",
+                algorithm.c_str(), m_event->group, size, rank, m_event->count );
+
+    CollectiveSchedulePlan& plan = m_schedule.plan();
+    plan.clear();
+    if ( algorithm == "recursive_doubling" ) {
+        CollectiveAlgorithms::allreduceRecursiveDoubling( rank, size, m_event->count, dtypeSize, plan );
+    } else if ( algorithm == "rabenseifner" ) {
+        CollectiveAlgorithms::allreduceRabenseifner( rank, size, m_event->count, dtypeSize, plan );
+    } else {
+        CollectiveAlgorithms::allreduceRing( rank, size, m_event->count, dtypeSize, plan );
+    }
+
+    // the schedule reduces in place in result
+    void* buf = NULL;
+    if ( m_event->mydata.getBacking() && m_event->result.getBacking() ) {
+        buf = m_event->result.getBacking();
+        if ( buf != m_event->mydata.getBacking() ) {
+            memcpy( buf, m_event->mydata.getBacking(), m_event->count * dtypeSize );
+        }
+    }
+
+    m_schedule.start( proto(), m_event->group, genTag(), buf, m_event->dtype, dtypeSize,
+                m_event->op, m_smallCollectiveVN, m_smallCollectiveSize );
+
+    handleEnterEvent( retval );
+}
+
+void AllreduceFuncSM::handleEnterEvent( Retval& retval )
+{
+    if ( NULL == m_event ) {
+        CollectiveTreeFuncSM::handleEnterEvent( retval );
+        return;
+    }
+
+    if ( ! m_schedule.advance() ) {
+        m_dbg.debug(CALL_INFO,1,0,"Exit\n" );
+        retval.setExit( 0 );
+        delete m_event;
+        m_event = NULL;
+    }
+}
@@ -17,6 +17,7 @@
 #define COMPONENTS_FIREFLY_FUNCSM_ALLREDUCE_H
 
 #include "funcSM/collectiveTree.h"
+#include "funcSM/collectiveSchedule.h"
 
 namespace SST {
 namespace Firefly {
@@ -33,18 +34,35 @@ class AllreduceFuncSM :  public CollectiveTreeFuncSM
         SST::Firefly::CollectiveTreeFuncSM
     )
 
+    SST_ELI_DOCUMENT_PARAMS(
+        {"smallCollectiveVN","Sets the VN to use for small collectives","0"},
+        {"smallCollectiveSize","Sets the size of small collectives","0"},
+        {"algorithm","Allreduce algorithm: tree, recursive_doubling, rabenseifner or ring. Reduce and Bcast always use the tree","tree"},
+        {"algorithmRules","Comma separated ranks:bytes:algorithm rules, the last rule with ranks and bytes at most those of the allreduce picks its algorithm, otherwise algorithm is used",""},
+    )
+
   public:
-    AllreduceFuncSM( SST::Params& params ) : CollectiveTreeFuncSM( params ) { }
+    AllreduceFuncSM( SST::Params& params );
 
-    virtual void handleStartEvent( SST::Event* e, Retval& retval ) {
-        CollectiveTreeFuncSM::handleStartEvent( e, retval );
-    }
+    virtual void handleStartEvent( SST::Event* e, Retval& retval );
+    virtual void handleEnterEvent( Retval& retval);
+
+    virtual std::string protocolName() { return "CtrlMsgProtocol"; }
+
+  private:
 
-    virtual void handleEnterEvent( Retval& retval) {
-        CollectiveTreeFuncSM::handleEnterEvent( retval );
+    // kept apart from the tags of the tree
+    uint32_t    genTag() {
+        return CtrlMsg::CollectiveTag | 0x10000 | (m_seq & 0xffff);
     }
 
-    virtual std::string protocolName() { return "CtrlMsgProtocol"; }
+    CtrlMsg::API* proto() { return static_cast<CtrlMsg::API*>(m_proto); }
+
+    CollectiveSchedule      m_schedule;
+    CollectiveStartEvent*   m_event;
+    int                     m_seq;
+    int                     m_smallCollectiveVN;
+    int                     m_smallCollectiveSize;
 };
 
 }
@@ -32,6 +32,19 @@ const char* AlltoallvFuncSM::m_enumName[] = {
     FOREACH_ENUM(GENERATE_STRING)
 };
 
+static const char* algorithms[] = { "pairwise", "bruck", NULL };
+
+AlltoallvFuncSM::AlltoallvFuncSM( SST::Params& params ) :
+    FunctionSMInterface( params ),
+    m_event( NULL ),
+    m_seq( 0 ),
+    m_schedule( m_dbg )
+{
+    m_smallCollectiveVN = params.find<int>( "smallCollectiveVN", 0);
+    m_smallCollectiveSize = params.find<int>( "smallCollectiveSize", 0);
+    m_schedule.configure( params, "pairwise", algorithms );
+}
+
 void AlltoallvFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
 {
     assert( NULL == m_event );
@@ -52,9 +65,58 @@ void AlltoallvFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
         memcpy( recv, send, recvChunkSize(m_rank));
     }
 
+    if ( m_schedule.select( m_size, sendChunkSize(m_rank) ) == "bruck" && startBruck() ) {
+        m_state = Schedule;
+    }
+
     retval.setDelay( 0 );
 }
 
+// Bruck's algorithm moves every block in log2(size) messages instead of
+// size - 1, which only works out when all the blocks are the same size
+bool AlltoallvFuncSM::startBruck()
+{
+    if ( m_event->sendcnts || m_event->recvcnts || sendChunkSize(m_rank) != recvChunkSize(m_rank) ) {
+        return false;
+    }
+
+    size_t blockSize = sendChunkSize(m_rank);
+
+    CollectiveSchedulePlan& plan = m_schedule.plan();
+    plan.clear();
+    CollectiveAlgorithms::alltoallBruck( m_rank, m_size, blockSize, plan );
+
+    m_dbg.debug(CALL_INFO,1,0,"bruck block=%zu steps=%zu\n", blockSize, plan.size() );
+
+    // the schedule works on the blocks rotated by our rank
+    void* buf = NULL;
+    if ( sendChunkPtr(m_rank) && recvChunkPtr(m_rank) ) {
+        m_blocks.resize( m_size * blockSize );
+        for ( unsigned int i = 0; i < m_size; i++ ) {
+            memcpy( &m_blocks[ i * blockSize ], sendChunkPtr( mod( m_rank + i, m_size ) ), blockSize );
+        }
+        buf = m_blocks.data();
+    }
+
+    m_schedule.start( proto(), m_event->group, genTag(), buf, m_event->sendtype,
+                m_info->sizeofDataType( m_event->sendtype ), NULL,
+                m_smallCollectiveVN, m_smallCollectiveSize );
+    return true;
+}
+
+void AlltoallvFuncSM::finishBruck()
+{
+    if ( m_blocks.empty() ) {
+        return;
+    }
+
+    size_t blockSize = recvChunkSize(m_rank);
+    for ( unsigned int i = 1; i < m_size; i++ ) {
+        memcpy( recvChunkPtr( mod( (long) m_rank - i, m_size ) ), &m_blocks[ i * blockSize ], blockSize );
+    }
+    m_blocks.clear();
+}
+
 void AlltoallvFuncSM::handleEnterEvent( Retval& retval )
 {
 	Hermes::MemAddr addr;
@@ -107,5 +169,16 @@ void AlltoallvFuncSM::handleEnterEvent( Retval& retval )
         ++m_count;
         m_state = PostRecv;
         break;
+
+      case Schedule:
+        if ( m_schedule.advance() ) {
+            break;
+        }
+        finishBruck();
+        m_dbg.debug(CALL_INFO,1,0,"leave\n");
+        retval.setExit(0);
+        delete m_event;
+        m_event = NULL;
+        break;
     }
 }
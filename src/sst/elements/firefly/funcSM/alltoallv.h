@@ -18,6 +18,7 @@
 
 #include "funcSM/api.h"
 #include "funcSM/event.h"
+#include "funcSM/collectiveSchedule.h"
 #include "info.h"
 #include "ctrlMsg.h"
 
@@ -30,6 +31,7 @@ namespace Firefly {
     NAME( PostRecv ) \
     NAME( Send ) \
     NAME( WaitRecv ) \
+    NAME( Schedule ) \
 
 #define GENERATE_ENUM(ENUM) ENUM,
 #define GENERATE_STRING(STRING) #STRING,
@@ -49,6 +51,8 @@ class AlltoallvFuncSM :  public FunctionSMInterface
 	SST_ELI_DOCUMENT_PARAMS(
 		{"smallCollectiveVN","Sets the VN to use for small collectives","0"},
 		{"smallCollectiveSize","Sets the size of small collectives","0"},
+		{"algorithm","Alltoall algorithm: pairwise or bruck, bruck is only used when every rank exchanges the same size of block","pairwise"},
+		{"algorithmRules","Comma separated ranks:bytes:algorithm rules, the last rule with ranks and bytes at most those of a block picks the algorithm, otherwise algorithm is used",""},
 	)
   private:
 
@@ -63,14 +67,7 @@ class AlltoallvFuncSM :  public FunctionSMInterface
     }
 
   public:
-    AlltoallvFuncSM( SST::Params& params ) :
-        FunctionSMInterface( params ),
-        m_event( NULL ),
-        m_seq( 0 )
-    {
-       m_smallCollectiveVN = params.find<int>( "smallCollectiveVN", 0);
-        m_smallCollectiveSize = params.find<int>( "smallCollectiveSize", 0);
-    }
+    AlltoallvFuncSM( SST::Params& params );
 
     virtual void handleStartEvent( SST::Event*, Retval& );
     virtual void handleEnterEvent( Retval& );
@@ -79,6 +76,9 @@ class AlltoallvFuncSM :  public FunctionSMInterface
 
   private:
 
+    bool startBruck();
+    void finishBruck();
+
     uint32_t    genTag() {
         return CtrlMsg::AlltoallvTag | (( m_seq & 0xff) << 8 );
     }
@@ -145,6 +145,8 @@ class AlltoallvFuncSM :  public FunctionSMInterface
     int                 m_seq;
     unsigned int        m_size;
     MP::RankID          m_rank;
+    CollectiveSchedule  m_schedule;
+    std::vector<unsigned char> m_blocks;
 
     int m_smallCollectiveVN;
     int m_smallCollectiveSize;
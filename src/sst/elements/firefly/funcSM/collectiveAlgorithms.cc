@@ -0,0 +1,341 @@
+// Copyright 2013-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include <stdlib.h>
+#include <sstream>
+
+#include "funcSM/collectiveAlgorithms.h"
+
+using namespace SST::Firefly;
+
+bool CollectiveAlgorithmRules::parse( const std::string& rules, std::string& error )
+{
+    std::stringstream list( rules );
+    std::string item;
+
+    m_rules.clear();
+    while ( std::getline( list, item, ',' ) ) {
+        size_t first = item.find( ':' );
+        size_t second = first == std::string::npos ? first : item.find( ':', first + 1 );
+        if ( second == std::string::npos ) {
+            error = item;
+            return false;
+        }
+
+        Rule rule;
+        char* end;
+        std::string field = item.substr( 0, first );
+        rule.ranks = strtol( field.c_str(), &end, 0 );
+        if ( field.empty() || *end != '\0' ) {
+            error = item;
+            return false;
+        }
+
+        field = item.substr( first + 1, second - first - 1 );
+        rule.bytes = strtoull( field.c_str(), &end, 0 );
+        if ( field.empty() || *end != '\0' ) {
+            error = item;
+            return false;
+        }
+
+        rule.algorithm = item.substr( second + 1 );
+        size_t trim = rule.algorithm.find_last_not_of( " \t" );
+        rule.algorithm.erase( trim == std::string::npos ? 0 : trim + 1 );
+        rule.algorithm.erase( 0, rule.algorithm.find_first_not_of( " \t" ) );
+        if ( rule.algorithm.empty() ) {
+            error = item;
+            return false;
+        }
+        m_rules.push_back( rule );
+    }
+    return true;
+}
+
+std::string CollectiveAlgorithmRules::select( int ranks, size_t bytes, const std::string& def ) const
+{
+    std::string algorithm = def;
+    for ( unsigned i = 0; i < m_rules.size(); i++ ) {
+        if ( m_rules[i].ranks <= ranks && m_rules[i].bytes <= bytes ) {
+            algorithm = m_rules[i].algorithm;
+        }
+    }
+    return algorithm;
+}
+
+int CollectiveAlgorithms::largestPowerOfTwo( int size )
+{
+    int pof2 = 1;
+    while ( pof2 * 2 <= size ) {
+        pof2 *= 2;
+    }
+    return pof2;
+}
+
+void CollectiveAlgorithms::splitCounts( size_t count, int parts, size_t dtypeSize,
+                                        std::vector<CollectiveSegment>& chunks )
+{
+    chunks.resize( parts );
+    size_t offset = 0;
+    for ( int i = 0; i < parts; i++ ) {
+        size_t elements = count / parts + ( (size_t) i < count % parts ? 1 : 0 );
+        chunks[i] = CollectiveSegment( offset, elements * dtypeSize );
+        offset += chunks[i].length;
+    }
+}
+
+CollectiveSegment CollectiveAlgorithms::span( const std::vector<CollectiveSegment>& chunks, int first, int last )
+{
+    if ( first >= last ) {
+        return CollectiveSegment( first < (int) chunks.size() ? chunks[first].offset : 0, 0 );
+    }
+    return CollectiveSegment( chunks[first].offset,
+                chunks[last-1].offset + chunks[last-1].length - chunks[first].offset );
+}
+
+// With a size that is not a power of two the first 2 * rem ranks pair up,
+// the even one hands its data to the odd one and sits out until the end
+void CollectiveAlgorithms::foldNonPowerOfTwo( int rank, int size, size_t bytes, int& newRank,
+                                            CollectiveSchedulePlan& plan )
+{
+    int rem = size - largestPowerOfTwo( size );
+
+    if ( rank < 2 * rem ) {
+        CollectiveStep step;
+        if ( rank % 2 == 0 ) {
+            step.sendPeer = rank + 1;
+            step.send.push_back( CollectiveSegment( 0, bytes ) );
+            newRank = -1;
+        } else {
+            step.recvPeer = rank - 1;
+            step.recv.push_back( CollectiveSegment( 0, bytes ) );
+            step.reduce = true;
+            newRank = rank / 2;
+        }
+        plan.push_back( step );
+    } else {
+        newRank = rank - rem;
+    }
+}
+
+void CollectiveAlgorithms::unfoldNonPowerOfTwo( int rank, int size, size_t bytes,
+                                            CollectiveSchedulePlan& plan )
+{
+    int rem = size - largestPowerOfTwo( size );
+
+    if ( rank < 2 * rem ) {
+        CollectiveStep step;
+        if ( rank % 2 == 0 ) {
+            step.recvPeer = rank + 1;
+            step.recv.push_back( CollectiveSegment( 0, bytes ) );
+        } else {
+            step.sendPeer = rank - 1;
+            step.send.push_back( CollectiveSegment( 0, bytes ) );
+        }
+        plan.push_back( step );
+    }
+}
+
+void CollectiveAlgorithms::allreduceRecursiveDoubling( int rank, int size, size_t count,
+                                        size_t dtypeSize, CollectiveSchedulePlan& plan )
+{
+    size_t bytes = count * dtypeSize;
+    int pof2 = largestPowerOfTwo( size );
+    int rem = size - pof2;
+    int newRank;
+
+    foldNonPowerOfTwo( rank, size, bytes, newRank, plan );
+
+    if ( newRank != -1 ) {
+        for ( int mask = 1; mask < pof2; mask <<= 1 ) {
+            CollectiveStep step;
+            step.sendPeer = step.recvPeer = realRank( newRank ^ mask, rem );
+            step.send.push_back( CollectiveSegment( 0, bytes ) );
+            step.recv.push_back( CollectiveSegment( 0, bytes ) );
+            step.reduce = true;
+            plan.push_back( step );
+        }
+    }
+
+    unfoldNonPowerOfTwo( rank, size, bytes, plan );
+}
+
+// Reduce-scatter by recursive halving then allgather by recursive doubling,
+// so each rank sends about twice the buffer whatever the number of ranks
+void CollectiveAlgorithms::allreduceRabenseifner( int rank, int size, size_t count,
+                                        size_t dtypeSize, CollectiveSchedulePlan& plan )
+{
+    size_t bytes = count * dtypeSize;
+    int pof2 = largestPowerOfTwo( size );
+    int rem = size - pof2;
+    int newRank;
+
+    foldNonPowerOfTwo( rank, size, bytes, newRank, plan );
+
+    if ( newRank != -1 && pof2 > 1 ) {
+        std::vector<CollectiveSegment> chunks;
+        splitCounts( count, pof2, dtypeSize, chunks );
+
+        int sendIdx = 0, recvIdx = 0, lastIdx = pof2;
+        int mask = 1;
+
+        while ( mask < pof2 ) {
+            int newDst = newRank ^ mask;
+            int half = pof2 / ( mask * 2 );
+            CollectiveStep step;
+            step.sendPeer = step.recvPeer = realRank( newDst, rem );
+            step.reduce = true;
+
+            if ( newRank < newDst ) {
+                sendIdx = recvIdx + half;
+                step.send.push_back( span( chunks, sendIdx, lastIdx ) );
+                step.recv.push_back( span( chunks, recvIdx, sendIdx ) );
+            } else {
+                recvIdx = sendIdx + half;
+                step.send.push_back( span( chunks, sendIdx, recvIdx ) );
+                step.recv.push_back( span( chunks, recvIdx, lastIdx ) );
+            }
+            plan.push_back( step );
+
+            sendIdx = recvIdx;
+            mask <<= 1;
+            if ( mask < pof2 ) {
+                lastIdx = recvIdx + pof2 / mask;
+            }
+        }
+
+        mask >>= 1;
+        while ( mask > 0 ) {
+            int newDst = newRank ^ mask;
+            int half = pof2 / ( mask * 2 );
+            CollectiveStep step;
+            step.sendPeer = step.recvPeer = realRank( newDst, rem );
+
+            if ( newRank < newDst ) {
+                if ( mask != pof2 / 2 ) {
+                    lastIdx = lastIdx + half;
+                }
+                recvIdx = sendIdx + half;
+                step.send.push_back( span( chunks, sendIdx, recvIdx ) );
+                step.recv.push_back( span( chunks, recvIdx, lastIdx ) );
+            } else {
+                recvIdx = sendIdx - half;
+                step.send.push_back( span( chunks, sendIdx, lastIdx ) );
+                step.recv.push_back( span( chunks, recvIdx, sendIdx ) );
+            }
+            plan.push_back( step );
+
+            if ( newRank > newDst ) {
+                sendIdx = recvIdx;
+            }
+            mask >>= 1;
+        }
+    }
+
+    unfoldNonPowerOfTwo( rank, size, bytes, plan );
+}
+
+// Reduce-scatter around the ring then allgather around it, bandwidth optimal
+// for large buffers at the cost of 2 * (size - 1) steps
+void CollectiveAlgorithms::allreduceRing( int rank, int size, size_t count,
+                                        size_t dtypeSize, CollectiveSchedulePlan& plan )
+{
+    std::vector<CollectiveSegment> chunks;
+    splitCounts( count, size, dtypeSize, chunks );
+
+    int next = ( rank + 1 ) % size;
+    int prev = ( rank - 1 + size ) % size;
+
+    for ( int s = 0; s < size - 1; s++ ) {
+        CollectiveStep step;
+        step.sendPeer = next;
+        step.send.push_back( chunks[ ( rank - s + size ) % size ] );
+        step.recvPeer = prev;
+        step.recv.push_back( chunks[ ( rank - s - 1 + 2 * size ) % size ] );
+        step.reduce = true;
+        plan.push_back( step );
+    }
+
+    for ( int s = 0; s < size - 1; s++ ) {
+        CollectiveStep step;
+        step.sendPeer = next;
+        step.send.push_back( chunks[ ( rank + 1 - s + size ) % size ] );
+        step.recvPeer = prev;
+        step.recv.push_back( chunks[ ( rank - s + size ) % size ] );
+        plan.push_back( step );
+    }
+}
+
+void CollectiveAlgorithms::allgatherRing( int rank, const std::vector<CollectiveSegment>& chunks,
+                                        CollectiveSchedulePlan& plan )
+{
+    int size = chunks.size();
+    int next = ( rank + 1 ) % size;
+    int prev = ( rank - 1 + size ) % size;
+
+    for ( int s = 0; s < size - 1; s++ ) {
+        CollectiveStep step;
+        step.sendPeer = next;
+        step.send.push_back( chunks[ ( rank - s + size ) % size ] );
+        step.recvPeer = prev;
+        step.recv.push_back( chunks[ ( rank - s - 1 + 2 * size ) % size ] );
+        plan.push_back( step );
+    }
+}
+
+bool CollectiveAlgorithms::allgatherRecursiveDoubling( int rank, const std::vector<CollectiveSegment>& chunks,
+                                        CollectiveSchedulePlan& plan )
+{
+    int size = chunks.size();
+    if ( largestPowerOfTwo( size ) != size ) {
+        return false;
+    }
+
+    // after the step with mask, each rank holds the chunks of its aligned group of 2 * mask ranks
+    for ( int mask = 1; mask < size; mask <<= 1 ) {
+        int peer = rank ^ mask;
+        int mine = rank & ~( mask - 1 );
+        int theirs = peer & ~( mask - 1 );
+
+        CollectiveStep step;
+        step.sendPeer = step.recvPeer = peer;
+        for ( int i = 0; i < mask; i++ ) {
+            step.send.push_back( chunks[ mine + i ] );
+            step.recv.push_back( chunks[ theirs + i ] );
+        }
+        plan.push_back( step );
+    }
+    return true;
+}
+
+void CollectiveAlgorithms::alltoallBruck( int rank, int size, size_t blockBytes, CollectiveSchedulePlan& plan )
+{
+    for ( int dist = 1; dist < size; dist <<= 1 ) {
+        CollectiveStep step;
+        step.sendPeer = ( rank + dist ) % size;
+        step.recvPeer = ( rank - dist + size ) % size;
+
+        // the blocks still to travel a distance with this bit set move on together
+        for ( int i = 1; i < size; i++ ) {
+            if ( i & dist ) {
+                step.send.push_back( CollectiveSegment( i * blockBytes, blockBytes ) );
+                step.recv.push_back( CollectiveSegment( i * blockBytes, blockBytes ) );
+            }
+        }
+        plan.push_back( step );
+    }
+}
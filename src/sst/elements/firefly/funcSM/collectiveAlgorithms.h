@@ -0,0 +1,114 @@
+// Copyright 2013-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_FIREFLY_FUNCSM_COLLECTIVEALGORITHMS_H
+#define COMPONENTS_FIREFLY_FUNCSM_COLLECTIVEALGORITHMS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Firefly {
+
+// A contiguous part, in bytes, of the buffer a collective works in
+struct CollectiveSegment {
+    CollectiveSegment( size_t offset = 0, size_t length = 0 ) : offset( offset ), length( length ) {}
+    size_t offset;
+    size_t length;
+};
+
+// One exchange of a collective, the receive is posted before the send so
+// both partners of a pairwise exchange can send at the same time. The
+// segments of a message are packed one after the other.
+struct CollectiveStep {
+    CollectiveStep() : sendPeer( -1 ), recvPeer( -1 ), reduce( false ) {}
+
+    size_t sendLength() const { return length( send ); }
+    size_t recvLength() const { return length( recv ); }
+
+    int sendPeer;
+    std::vector<CollectiveSegment> send;
+    int recvPeer;
+    std::vector<CollectiveSegment> recv;
+    bool reduce;    // combine what is received with the buffer instead of replacing it
+
+  private:
+    static size_t length( const std::vector<CollectiveSegment>& segs ) {
+        size_t total = 0;
+        for ( unsigned i = 0; i < segs.size(); i++ ) {
+            total += segs[i].length;
+        }
+        return total;
+    }
+};
+
+typedef std::vector<CollectiveStep> CollectiveSchedulePlan;
+
+// Picks an algorithm from the size of the communicator and of the data, like
+// the tuned collectives of Open MPI. Rules are "ranks:bytes:algorithm" separated
+// by commas, the last rule whose ranks and bytes are at most those of the
+// collective applies, e.g. "0:0:recursive_doubling,0:65536:rabenseifner,64:1048576:ring".
+class CollectiveAlgorithmRules {
+  public:
+    // returns false naming the bad rule in error if rules does not parse
+    bool parse( const std::string& rules, std::string& error );
+    bool empty() const { return m_rules.empty(); }
+    size_t size() const { return m_rules.size(); }
+    const std::string& algorithm( int i ) const { return m_rules[i].algorithm; }
+    std::string select( int ranks, size_t bytes, const std::string& def ) const;
+
+  private:
+    struct Rule {
+        int ranks;
+        size_t bytes;
+        std::string algorithm;
+    };
+    std::vector<Rule> m_rules;
+};
+
+// Schedules of the point to point exchanges of each algorithm, every rank
+// builds its own and the exchanges of a pair of ranks line up.
+class CollectiveAlgorithms {
+  public:
+    // Allreduce of count elements of dtypeSize bytes held in one buffer
+    static void allreduceRecursiveDoubling( int rank, int size, size_t count, size_t dtypeSize, CollectiveSchedulePlan& );
+    static void allreduceRabenseifner( int rank, int size, size_t count, size_t dtypeSize, CollectiveSchedulePlan& );
+    static void allreduceRing( int rank, int size, size_t count, size_t dtypeSize, CollectiveSchedulePlan& );
+
+    // Allgather into one buffer where each rank's contribution is chunks[rank],
+    // recursive doubling needs a power of two ranks
+    static void allgatherRing( int rank, const std::vector<CollectiveSegment>& chunks, CollectiveSchedulePlan& );
+    static bool allgatherRecursiveDoubling( int rank, const std::vector<CollectiveSegment>& chunks, CollectiveSchedulePlan& );
+
+    // Bruck's alltoall of blocks of blockBytes, on a buffer holding the blocks
+    // rotated so that block i is for rank (rank + i) % size; afterwards block i
+    // is the one from rank (rank - i) % size
+    static void alltoallBruck( int rank, int size, size_t blockBytes, CollectiveSchedulePlan& );
+
+  private:
+    static int largestPowerOfTwo( int size );
+    static void splitCounts( size_t count, int parts, size_t dtypeSize, std::vector<CollectiveSegment>& chunks );
+    static void foldNonPowerOfTwo( int rank, int size, size_t bytes, int& newRank, CollectiveSchedulePlan& );
+    static void unfoldNonPowerOfTwo( int rank, int size, size_t bytes, CollectiveSchedulePlan& );
+    static int realRank( int newRank, int rem ) { return newRank < rem ? newRank * 2 + 1 : newRank + rem; }
+    static CollectiveSegment span( const std::vector<CollectiveSegment>& chunks, int first, int last );
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,198 @@
+// Copyright 2013-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include <string.h>
+
+#include "funcSM/collectiveSchedule.h"
+#include "funcSM/collectiveOps.h"
+
+using namespace SST::Firefly;
+
+static bool isValid( const std::string& name, const char* valid[] )
+{
+    for ( int i = 0; valid[i]; i++ ) {
+        if ( name == valid[i] ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CollectiveSchedule::configure( SST::Params& params, const std::string& def, const char* valid[] )
+{
+    m_algorithm = params.find<std::string>( "algorithm", def );
+    if ( ! isValid( m_algorithm, valid ) ) {
+        m_dbg.fatal(CALL_INFO, -1, "unknown algorithm `%s`\n", m_algorithm.c_str() );
+    }
+
+    std::string error;
+    if ( ! m_rules.parse( params.find<std::string>( "algorithmRules", "" ), error ) ) {
+        m_dbg.fatal(CALL_INFO, -1, "bad algorithmRules entry `%s`, expected ranks:bytes:algorithm\n",
+                    error.c_str() );
+    }
+    for ( size_t i = 0; i < m_rules.size(); i++ ) {
+        if ( ! isValid( m_rules.algorithm( i ), valid ) ) {
+            m_dbg.fatal(CALL_INFO, -1, "unknown algorithm `%s` in algorithmRules\n",
+                    m_rules.algorithm( i ).c_str() );
+        }
+    }
+}
+
+void CollectiveSchedule::start( CtrlMsg::API* proto, MP::Communicator group, uint32_t tag, void* buf,
+                MP::PayloadDataType dtype, size_t dtypeSize, MP::ReductionOperation op,
+                int smallCollectiveVN, int smallCollectiveSize )
+{
+    m_proto = proto;
+    m_group = group;
+    m_tag = tag;
+    m_buf = (unsigned char*) buf;
+    m_dtype = dtype;
+    m_dtypeSize = dtypeSize;
+    m_op = op;
+    m_smallCollectiveVN = smallCollectiveVN;
+    m_smallCollectiveSize = smallCollectiveSize;
+    m_step = 0;
+    m_state = PostRecv;
+
+    m_dbg.debug(CALL_INFO,1,0,"%zu steps, tag %#x\n", m_plan.size(), m_tag );
+}
+
+bool CollectiveSchedule::advance()
+{
+    std::vector<IoVec> ioVec;
+
+    while ( m_step < m_plan.size() ) {
+        CollectiveStep& step = m_plan[m_step];
+
+        switch ( m_state ) {
+          case PostRecv:
+            m_state = Send;
+            m_reqs.clear();
+            if ( -1 != step.recvPeer ) {
+
+                // a reduction needs what is received next to what is held, as
+                // does a copy into blocks this step is also sending from
+                m_staged = step.reduce || overlaps( step );
+                if ( m_staged ) {
+                    IoVec tmp;
+                    tmp.addr.setSimVAddr( 1 );
+                    if ( m_buf ) {
+                        m_stage.resize( step.recvLength() );
+                        tmp.addr.setBacking( m_stage.data() );
+                    }
+                    tmp.len = step.recvLength();
+                    ioVec.push_back( tmp );
+                } else {
+                    initIoVec( ioVec, step.recv );
+                }
+
+                m_dbg.debug(CALL_INFO,1,0,"step %u irecv src=%d len=%zu\n",
+                                m_step, step.recvPeer, step.recvLength() );
+                m_proto->irecvv( ioVec, step.recvPeer, m_tag, m_group, &m_recvReq );
+                m_reqs.push_back( &m_recvReq );
+                return true;
+            }
+
+          case Send:
+            m_state = Wait;
+            if ( -1 != step.sendPeer ) {
+                int vn = 0;
+                if ( step.sendLength() <= m_smallCollectiveSize ) {
+                    vn = m_smallCollectiveVN;
+                }
+                initIoVec( ioVec, step.send );
+
+                m_dbg.debug(CALL_INFO,1,0,"step %u isend dest=%d len=%zu vn=%d\n",
+                                m_step, step.sendPeer, step.sendLength(), vn );
+                m_proto->isendv( ioVec, step.sendPeer, m_tag, m_group, &m_sendReq, vn );
+                m_reqs.push_back( &m_sendReq );
+                return true;
+            }
+
+          case Wait:
+            m_state = Finish;
+            if ( ! m_reqs.empty() ) {
+                m_dbg.debug(CALL_INFO,1,0,"step %u wait\n", m_step );
+                m_proto->waitAll( m_reqs );
+                return true;
+            }
+
+          case Finish:
+            finishStep( step );
+            ++m_step;
+            m_state = PostRecv;
+        }
+    }
+    return false;
+}
+
+void CollectiveSchedule::initIoVec( std::vector<IoVec>& ioVec, std::vector<CollectiveSegment>& segs )
+{
+    for ( unsigned i = 0; i < segs.size(); i++ ) {
+        if ( 0 == segs[i].length ) {
+            continue;
+        }
+        IoVec tmp;
+        tmp.addr.setSimVAddr( 1 );
+        if ( m_buf ) {
+            tmp.addr.setBacking( m_buf + segs[i].offset );
+        }
+        tmp.len = segs[i].length;
+        ioVec.push_back( tmp );
+    }
+
+    // a rank can have nothing to exchange when there are fewer elements than ranks
+    if ( ioVec.empty() ) {
+        IoVec tmp;
+        tmp.addr.setSimVAddr( 1 );
+        tmp.len = 0;
+        ioVec.push_back( tmp );
+    }
+}
+
+void CollectiveSchedule::finishStep( CollectiveStep& step )
+{
+    if ( -1 == step.recvPeer || ! m_staged || ! m_buf ) {
+        return;
+    }
+
+    unsigned char* ptr = m_stage.data();
+    for ( unsigned i = 0; i < step.recv.size(); i++ ) {
+        CollectiveSegment& seg = step.recv[i];
+        if ( step.reduce ) {
+            void* input[2] = { m_buf + seg.offset, ptr };
+            collectiveOp( input, 2, m_buf + seg.offset, seg.length / m_dtypeSize, m_dtype, m_op );
+        } else {
+            memcpy( m_buf + seg.offset, ptr, seg.length );
+        }
+        ptr += seg.length;
+    }
+}
+
+bool CollectiveSchedule::overlaps( CollectiveStep& step )
+{
+    for ( unsigned i = 0; i < step.recv.size(); i++ ) {
+        for ( unsigned j = 0; j < step.send.size(); j++ ) {
+            if ( step.recv[i].offset < step.send[j].offset + step.send[j].length &&
+                    step.send[j].offset < step.recv[i].offset + step.recv[i].length ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,82 @@
+// Copyright 2013-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_FIREFLY_FUNCSM_COLLECTIVESCHEDULE_H
+#define COMPONENTS_FIREFLY_FUNCSM_COLLECTIVESCHEDULE_H
+
+#include <sst/core/output.h>
+#include <sst/core/params.h>
+
+#include "funcSM/collectiveAlgorithms.h"
+#include "ctrlMsg.h"
+
+namespace SST {
+namespace Firefly {
+
+// Runs a CollectiveSchedulePlan for a collective FuncSM. Each call to advance()
+// makes at most one call into the CtrlMsg protocol, the FuncSM calls it again
+// from handleEnterEvent() until it returns false. A NULL buffer simulates the
+// messages without moving or reducing any data.
+class CollectiveSchedule {
+
+    enum { PostRecv, Send, Wait, Finish } m_state;
+
+  public:
+    CollectiveSchedule( Output& dbg ) : m_dbg( dbg ), m_proto( NULL ), m_buf( NULL ) {}
+
+    // read "algorithm" and "algorithmRules", valid is a NULL terminated list
+    // of the algorithms the FuncSM knows
+    void configure( SST::Params&, const std::string& def, const char* valid[] );
+    std::string select( int ranks, size_t bytes ) { return m_rules.select( ranks, bytes, m_algorithm ); }
+
+    CollectiveSchedulePlan& plan() { return m_plan; }
+
+    void start( CtrlMsg::API*, MP::Communicator group, uint32_t tag, void* buf,
+                MP::PayloadDataType dtype, size_t dtypeSize, MP::ReductionOperation op,
+                int smallCollectiveVN, int smallCollectiveSize );
+    bool advance();
+
+  private:
+    void initIoVec( std::vector<IoVec>&, std::vector<CollectiveSegment>& );
+    void finishStep( CollectiveStep& );
+    bool overlaps( CollectiveStep& );
+
+    Output&                 m_dbg;
+    std::string             m_algorithm;
+    CollectiveAlgorithmRules m_rules;
+
+    CollectiveSchedulePlan  m_plan;
+    CtrlMsg::API*           m_proto;
+    MP::Communicator        m_group;
+    uint32_t                m_tag;
+    unsigned char*          m_buf;
+    MP::PayloadDataType     m_dtype;
+    size_t                  m_dtypeSize;
+    MP::ReductionOperation  m_op;
+    int                     m_smallCollectiveVN;
+    int                     m_smallCollectiveSize;
+
+    unsigned int            m_step;
+    bool                    m_staged;
+    std::vector<unsigned char> m_stage;
+    CtrlMsg::CommReq        m_recvReq;
+    CtrlMsg::CommReq        m_sendReq;
+    std::vector<CtrlMsg::CommReq*> m_reqs;
+};
+
+}
+}
+
+#endif
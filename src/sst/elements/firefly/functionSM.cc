@@ -46,6 +46,7 @@ class DriverEvent : public SST::Event {
 FunctionSM::FunctionSM( ComponentId_t id, SST::Params& params, ProtocolAPI* proto ) :
 	SubComponent(id),
     m_sm( NULL ),
+    m_driverEvent( NULL ),
     m_params( params ),
     m_proto( proto )
 {
@@ -73,6 +74,7 @@ FunctionSM::~FunctionSM()
     for ( unsigned int i=0; i < m_smV.size(); i++ ) {
         delete m_smV[i];
     }
+    delete m_driverEvent;
 }
 
 void FunctionSM::printStatus( Output& out )
@@ -212,7 +214,15 @@ void FunctionSM::processRetval(  Retval& retval )
     if ( retval.isExit() ) {
         m_dbg.debug(CALL_INFO,3,0,"Exit %" PRIu64 "\n", retval.value() );
         if ( m_retFunc ) {
-            DriverEvent* x = new DriverEvent( m_retFunc, retval.value() );
+            // one function runs at a time, so the return event is reused
+            DriverEvent* x = static_cast<DriverEvent*>( m_driverEvent );
+            if ( x ) {
+                m_driverEvent = NULL;
+                x->retFunc = m_retFunc;
+                x->retval = retval.value();
+            } else {
+                x = new DriverEvent( m_retFunc, retval.value() );
+            }
             m_toDriverLink->send( m_sm->returnLatency(), x );
         } else {
             m_callback();
@@ -233,6 +243,10 @@ void FunctionSM::handleToDriver( Event* e )
         delete event->retFunc;
     }
     m_sm = NULL;
-    delete e;
+    if ( m_driverEvent ) {
+        delete e;
+    } else {
+        m_driverEvent = e;
+    }
 }
 
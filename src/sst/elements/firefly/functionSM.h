@@ -124,6 +124,7 @@ class FunctionSM : public SubComponent {
     FunctionSMInterface*    m_sm;
     MP::Functor*    m_retFunc;
     Callback        m_callback;
+    SST::Event*     m_driverEvent;  // spare DriverEvent
 
     SST::Link*          m_fromDriverLink;
     SST::Link*          m_toDriverLink;
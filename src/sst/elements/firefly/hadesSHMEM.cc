@@ -769,6 +769,26 @@ void HadesSHMEM::fadd( Fadd* info )
             );
 }
 
+void HadesSHMEM::triggered_put( Hermes::Vaddr dest, Hermes::Vaddr src, size_t length, int pe,
+            Hermes::Vaddr counter, Hermes::Value& threshold, Shmem::Callback callback )
+{
+	TriggeredPut* info = new TriggeredPut( dest, src, length, pe, counter, threshold, callback );
+
+	delayEnter( DO( triggered_put, info ) );
+}
+
+void HadesSHMEM::triggered_put( TriggeredPut* info )
+{
+    std::stringstream tmp;
+    tmp << info->threshold;
+    dbg().debug(CALL_INFO,1,SHMEM_BASE,"counter=%#" PRIx64 " threshold=%s\n",info->counter, tmp.str().c_str());
+
+    nic().shmemTriggeredPut( calcNetPE(info->pe), info->dest, info->src, info->nelems, info->counter, info->threshold );
+
+    delayReturn( info->callback );
+    delete info;
+}
+
 void HadesSHMEM::fam_add( Shmem::Fam_Descriptor fd, uint64_t offset, Hermes::Value& value, Shmem::Callback& callback )
 {
 	uint64_t localOffset;
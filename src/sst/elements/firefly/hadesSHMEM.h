@@ -402,6 +402,16 @@ class HadesSHMEM : public Shmem::Interface
 		Value value;
 	   	int pe;
 	};
+	struct TriggeredPut : public Base {
+		TriggeredPut( Vaddr dest, Vaddr src, size_t nelems, int pe, Vaddr counter, Value& threshold, Shmem::Callback callback ) :
+			Base(callback), dest(dest), src(src), nelems(nelems), pe(pe), counter(counter), threshold(threshold) {}
+		Vaddr dest;
+		Vaddr src;
+		size_t nelems;
+		int pe;
+		Vaddr counter;
+		Value threshold;
+	};
 	struct Fam_Get : public Base {
 		Fam_Get( Hermes::Vaddr dest, Shmem::Fam_Descriptor rd, uint64_t offset, uint64_t nbytes,
 				bool blocking, Shmem::Callback callback ) :
@@ -478,6 +488,8 @@ class HadesSHMEM : public Shmem::Interface
     virtual void swap( Hermes::Value& result, Hermes::Vaddr, Hermes::Value& value, int pe, Shmem::Callback);
     virtual void add(  Hermes::Vaddr, Hermes::Value&, int pe, Shmem::Callback);
     virtual void fadd( Hermes::Value&, Hermes::Vaddr, Hermes::Value&, int pe, Shmem::Callback);
+    virtual void triggered_put( Hermes::Vaddr dest, Hermes::Vaddr src, size_t nelems, int pe,
+            Hermes::Vaddr counter, Hermes::Value& threshold, Shmem::Callback );
 
 	virtual void fam_add( Shmem::Fam_Descriptor fd, uint64_t, Hermes::Value&, Shmem::Callback& );
     virtual void fam_cswap( Hermes::Value& result, Shmem::Fam_Descriptor fd, uint64_t, Hermes::Value& oldValue , Hermes::Value& newValue, Shmem::Callback);
@@ -541,6 +553,7 @@ class HadesSHMEM : public Shmem::Interface
 	void swap( Swap* );
 	void fadd( Fadd* );
 	void add( Add* );
+	void triggered_put( TriggeredPut* );
 	void fam_get( Fam_Get* );
 	void fam_add( Fam_Add* );
 
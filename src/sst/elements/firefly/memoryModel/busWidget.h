@@ -103,7 +103,7 @@ class BusLoadWidget : public Unit {
         assert( m_blocked == false );
         m_scheduled = false;
 
-		MemReq* req = new MemReq( entry.getAddr(), m_width );
+		MemReq* req = new MemReq( entry.getAddr(), m_width, -1, true );
 		entry.inc();
 		m_dbg.verbosePrefix(prefix(),CALL_INFO,1,BUS_WIDGET_MASK,"addr=%#" PRIx64 " length=%lu\n",req->addr,req->length);
 
@@ -250,7 +250,7 @@ class BusStoreWidget : public Unit {
 		m_scheduled = false;
 
 		WidgetEntry& entry= *m_pendingQ.front();
-		MemReq* req = new MemReq( entry.getAddr(), m_width );
+		MemReq* req = new MemReq( entry.getAddr(), m_width, -1, true );
 		entry.inc();
 
 		m_dbg.verbosePrefix(prefix(),CALL_INFO,1,BUS_WIDGET_MASK,"addr=%#" PRIx64 " length=%lu entry=%p\n",req->addr,req->length,&entry);
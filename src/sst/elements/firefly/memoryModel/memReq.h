@@ -18,12 +18,14 @@
 #define COMPONENTS_FIREFLY_SIMPLE_MEMORY_MODEL_MEM_REQ_H
 
 struct MemReq {
-    MemReq( Hermes::Vaddr addr, size_t length, int pid = -1) :
-        addr(addr), length(length), pid(pid) {}
+    MemReq( Hermes::Vaddr addr, size_t length, int pid = -1, bool nic = false ) :
+        addr(addr), length(length), pid(pid), nic(nic) {}
 
 	Hermes::Vaddr addr;
 	size_t length;
     int     pid;
+    // issued on behalf of the NIC, the memory controller arbitrates on this
+    bool    nic;
 };
 
 #endif
@@ -15,15 +15,30 @@
 
     class MemUnit : public Unit {
         enum Op { Read, Write };
+        enum Requester { Host, Nic };
       public:
-        MemUnit( SimpleMemoryModel& model, Output& dbg, int id, int readLat_ns, int writeLat_ns, int numSlots ) :
-            Unit( model, dbg ), m_pending(0), m_readLat_ns(readLat_ns), m_writeLat_ns(writeLat_ns), m_numSlots(numSlots)
+        MemUnit( SimpleMemoryModel& model, Output& dbg, int id, int readLat_ns, int writeLat_ns, int numSlots,
+                double bandwidth_GBs = 0, double nicShare = 0.5, bool nicPriority = false ) :
+            Unit( model, dbg ), m_pending(0), m_readLat_ns(readLat_ns), m_writeLat_ns(writeLat_ns), m_numSlots(numSlots),
+            m_bytesPerNs(bandwidth_GBs), m_nicPriority(nicPriority), m_channelBusy(false), m_channelFree(0)
         {
             m_prefix = "@t:" + std::to_string(id) + ":SimpleMemoryModel::MemUnit::@p():@l ";
 			m_latency = model.registerStatistic<uint64_t>("mem_blocked_time");
 			m_loads = model.registerStatistic<uint64_t>("mem_num_loads");
 			m_stores = model.registerStatistic<uint64_t>("mem_num_stores");
 			m_addrs = model.registerStatistic<uint64_t>("mem_addrs");
+
+            // the channel is shared in proportion to these weights when both want it
+            m_weight[Host] = 1.0 - nicShare;
+            m_weight[Nic] = nicShare;
+            m_virtTime[Host] = m_virtTime[Nic] = 0;
+            if ( m_bytesPerNs > 0 ) {
+                m_bytes[Host] = model.registerStatistic<uint64_t>("mem_host_bytes");
+                m_bytes[Nic] = model.registerStatistic<uint64_t>("mem_nic_bytes");
+                m_queued[Host] = model.registerStatistic<uint64_t>("mem_host_queue_ns");
+                m_queued[Nic] = model.registerStatistic<uint64_t>("mem_nic_queue_ns");
+                m_walks = model.registerStatistic<uint64_t>("mem_tlb_walk_reads");
+            }
         }
 
         bool store( UnitBase* src, MemReq* req ) {
@@ -38,12 +53,25 @@
             return work( m_readLat_ns, Read, req, src, m_model.getCurrentSimTimeNano(), callback );
         }
 
+        // A read by the NIC's page walker. It does not take a slot, the walkers
+        // are limited by the SharedTlb, but it does compete for the channel.
+        void walk( MemReq* req, Callback* callback ) {
+            m_dbg.verbosePrefix(prefix(),CALL_INFO,1,MEM_MASK,"addr=%#" PRIx64 " length=%lu\n",req->addr,req->length);
+            if ( m_bytesPerNs > 0 ) {
+                m_walks->addData( 1 );
+                enqueue( Entry( m_readLat_ns, Read, req, NULL, callback, m_model.getCurrentSimTimeNano(), false ) );
+            } else {
+                delete req;
+                m_model.schedCallback( m_readLat_ns, callback );
+            }
+        }
+
       private:
 
         struct Entry {
 
-			Entry( SimTime_t delay, Op op, MemReq* memReq, UnitBase* src, Callback* callback, SimTime_t qTime ) :
-                delay(delay), op(op), memReq(memReq), src(src), callback( callback ), qTime(qTime)
+			Entry( SimTime_t delay, Op op, MemReq* memReq, UnitBase* src, Callback* callback, SimTime_t qTime, bool slot = true ) :
+                delay(delay), op(op), memReq(memReq), src(src), callback( callback ), qTime(qTime), slot(slot)
             { }
             SimTime_t delay;
             Op op;
@@ -51,57 +79,126 @@
             UnitBase* src;
 			Callback* callback;
             SimTime_t qTime;
+            bool slot;
         };
 
+        // Without a controller bandwidth everything waits in one FIFO, as before
+        Requester requester( MemReq* req ) {
+            return m_bytesPerNs > 0 && req->nic ? Nic : Host;
+        }
+
         bool work( SimTime_t delay, Op op, MemReq* req,  UnitBase* src, SimTime_t qTime, Callback* callback = NULL ) {
 
 			m_addrs->addData( req->addr  );
             if ( m_pending == m_numSlots ) {
 
 				m_dbg.verbosePrefix(prefix(),CALL_INFO,1,MEM_MASK,"blocking src\n");
-				m_blocked.push( Entry( delay, op, req, src, callback, m_model.getCurrentSimTimeNano() ) );
+				m_blocked[requester(req)].push( Entry( delay, op, req, src, callback, m_model.getCurrentSimTimeNano() ) );
 				m_blockedTime = m_model.getCurrentSimTimeNano();
                 return true;
             }
 
             ++m_pending;
 
-			Callback* cb = new Callback;
+            if ( m_bytesPerNs > 0 ) {
+                enqueue( Entry( delay, op, req, src, callback, qTime ) );
+            } else {
+                SimTime_t issueTime  = m_model.getCurrentSimTimeNano();
+                Callback* cb = new Callback;
+                *cb = std::bind( &MemUnit::complete, this, Entry( delay, op, req, src, callback, qTime ), issueTime );
+                m_model.schedCallback( delay, cb );
+            }
 
-            SimTime_t issueTime  = m_model.getCurrentSimTimeNano();
+			return false;
+        }
 
-            *cb = [=]()
-                {
-                    --m_pending;
+        void complete( Entry entry, SimTime_t issueTime ) {
+            MemReq* req = entry.memReq;
+            SimTime_t latency = m_model.getCurrentSimTimeNano() - issueTime;
 
-                    SimTime_t latency = m_model.getCurrentSimTimeNano() - issueTime;
+            m_dbg.verbosePrefix(prefix(),CALL_INFO,1,MEM_MASK,"%s complete latency=%" PRIu64 " qLatency=%" PRIu64 " addr=%#" PRIx64 " length=%lu\n",
+                                                entry.op == Read ? "Read":"Write" ,latency, issueTime-entry.qTime, req->addr, req->length);
 
-                    m_dbg.verbosePrefix(prefix(),CALL_INFO,1,MEM_MASK,"%s complete latency=%" PRIu64 " qLatency=%" PRIu64 " addr=%#" PRIx64 " length=%lu\n",
-                                                        op == Read ? "Read":"Write" ,latency, issueTime-qTime, req->addr, req->length);
+            if ( entry.callback ) {
+                m_model.schedCallback( 0, entry.callback );
+            }
 
-                    if ( callback ) {
-                        m_model.schedCallback( 0, callback);
-                    }
+            delete req;
 
-					delete req;
+            if ( ! entry.slot ) {
+                return;
+            }
+            --m_pending;
 
-                    if ( ! m_blocked.empty() ) {
+            if ( ! m_blocked[Host].empty() || ! m_blocked[Nic].empty() ) {
 
-						SimTime_t latency = m_model.getCurrentSimTimeNano() - m_blockedTime;
-						if ( latency ) {
-							m_latency->addData( latency );
-						}
-						Entry& entry = m_blocked.front( );
+                SimTime_t latency = m_model.getCurrentSimTimeNano() - m_blockedTime;
+                if ( latency ) {
+                    m_latency->addData( latency );
+                }
+                // the freed slot goes to whoever the channel would serve next
+                std::queue< Entry >& blocked = m_blocked[ pick( ! m_blocked[Host].empty(), ! m_blocked[Nic].empty() ) ];
+                Entry& next = blocked.front( );
 
-                        work( entry.delay, entry.op, entry.memReq, entry.src, entry.qTime, entry.callback );
-                		m_model.schedResume( 0, entry.src );
-						m_blocked.pop();
-                    }
-                };
+                work( next.delay, next.op, next.memReq, next.src, next.qTime, next.callback );
+                m_model.schedResume( 0, next.src );
+                blocked.pop();
+            }
+        }
 
-            m_model.schedCallback( delay, cb );
+        // Choose between the two requesters. NIC priority always favours the
+        // NIC, otherwise the one furthest behind its share of the bytes moved.
+        Requester pick( bool host, bool nic ) {
+            if ( ! nic ) return Host;
+            if ( ! host ) return Nic;
+            if ( m_nicPriority ) return Nic;
+            return m_virtTime[Nic] <= m_virtTime[Host] ? Nic : Host;
+        }
 
-			return false;
+        void enqueue( Entry entry ) {
+            Requester who = requester( entry.memReq );
+            if ( m_channelQ[who].empty() ) {
+                // an idle requester does not bank bandwidth it did not use
+                Requester other = who == Host ? Nic : Host;
+                m_virtTime[who] = std::max( m_virtTime[who], m_virtTime[other] );
+            }
+            m_channelQ[who].push( entry );
+            if ( ! m_channelBusy ) {
+                transfer( (double) m_model.getCurrentSimTimeNano() );
+            }
+        }
+
+        // Move the next request over the channel, back to back with the last one
+        // when there is a queue. The access latency follows the transfer.
+        void transfer( double start ) {
+            Requester who = pick( ! m_channelQ[Host].empty(), ! m_channelQ[Nic].empty() );
+            Entry entry = m_channelQ[who].front();
+            m_channelQ[who].pop();
+
+            SimTime_t now = m_model.getCurrentSimTimeNano();
+            size_t bytes = entry.memReq->length;
+            m_bytes[who]->addData( bytes );
+            m_queued[who]->addData( now - entry.qTime );
+            m_virtTime[who] += bytes / m_weight[who];
+
+            m_channelBusy = true;
+            m_channelFree = std::max( start, (double) now ) + bytes / m_bytesPerNs;
+            SimTime_t done = (SimTime_t) ceil( m_channelFree );
+
+            Callback* cb = new Callback;
+            *cb = std::bind( &MemUnit::complete, this, entry, now );
+            m_model.schedCallback( done - now + entry.delay, cb );
+
+            cb = new Callback;
+            *cb = std::bind( &MemUnit::channelFree, this );
+            m_model.schedCallback( done - now, cb );
+        }
+
+        void channelFree() {
+            m_channelBusy = false;
+            if ( ! m_channelQ[Host].empty() || ! m_channelQ[Nic].empty() ) {
+                transfer( m_channelFree );
+            }
         }
 
 		SimTime_t m_blockedTime;
@@ -109,9 +206,20 @@
         Statistic<uint64_t>* m_loads;
         Statistic<uint64_t>* m_stores;
         Statistic<uint64_t>* m_addrs;
-        std::queue< Entry > m_blocked;
+        Statistic<uint64_t>* m_bytes[2];
+        Statistic<uint64_t>* m_queued[2];
+        Statistic<uint64_t>* m_walks;
+        std::queue< Entry > m_blocked[2];
+        std::queue< Entry > m_channelQ[2];
         int m_pending;
         int m_numSlots;
         int m_readLat_ns;
         int m_writeLat_ns;
+
+        double m_bytesPerNs;
+        double m_weight[2];
+        double m_virtTime[2];
+        bool m_nicPriority;
+        bool m_channelBusy;
+        double m_channelFree;
     };
@@ -19,14 +19,14 @@ class SharedTlb {
 
     typedef std::function<void(MemReq*, uint64_t)> Callback;
 public:
-    SharedTlb( SimpleMemoryModel& model, Output& dbg, int id, int size, int pageSize, int tlbMissLat_ns, int numWalkers ) :
-        m_model(model), m_dbg(dbg), m_tlbMissLat_ns(tlbMissLat_ns), m_numWalkers(numWalkers), m_pageMask( ~(pageSize - 1) ),
+    SharedTlb( SimpleMemoryModel& model, Output& dbg, int id, int size, int pageSize, int tlbMissLat_ns, int numWalkers, int walkLevels = 0 ) :
+        m_model(model), m_dbg(dbg), m_tlbMissLat_ns(tlbMissLat_ns), m_numWalkers(numWalkers), m_walkLevels(walkLevels), m_pageMask( ~(pageSize - 1) ),
         m_cache(size), m_numLookups(0), m_maxNumLookups(numWalkers), m_cacheSize(size)
     {
         m_prefix = "@t:" + std::to_string(id) + ":SimpleMemoryModel::SharedTlb::@p():@l ";
 
-        m_dbg.verbosePrefix(prefix(),CALL_INFO,1,SHARED_TLB_MASK,"tlbSize=%d, pageMask=%#" PRIx64 ", numWalkers=%d\n",
-                        size, m_pageMask, numWalkers );
+        m_dbg.verbosePrefix(prefix(),CALL_INFO,1,SHARED_TLB_MASK,"tlbSize=%d, pageMask=%#" PRIx64 ", numWalkers=%d, walkLevels=%d\n",
+                        size, m_pageMask, numWalkers, walkLevels );
 		m_hitCnt = model.registerStatistic<uint64_t>("nic_TLB_hits");
 		m_totalCnt = model.registerStatistic<uint64_t>("nic_TLB_total");
     }
@@ -57,9 +57,7 @@ public:
                 if ( m_numLookups < m_maxNumLookups ) {
                     ++m_numLookups;
                     m_pendingMap[pageAddr];
-					MemoryModel::Callback* cb =  new MemoryModel::Callback;
-					*cb = std::bind( &SharedTlb::resolved, this, req, callback );
-                    m_model.schedCallback( m_tlbMissLat_ns, cb );
+                    walk( req, callback );
                     m_dbg.verbosePrefix(prefix(),CALL_INFO,1,SHARED_TLB_MASK, "Schedule: virtAddr=%#" PRIx64 " physAddr=%#" PRIx64 " pageAddr=%#" PRIx64"\n",
                         req->addr, physAddr, pageAddr );
                 } else {
@@ -80,6 +78,30 @@ private:
     int m_numLookups;
     int m_maxNumLookups;
 
+    // A miss costs tlbMissLat_ns and then, if walkLevels is set, one dependent
+    // read of host memory per level of the page table
+    void walk( MemReq* req, Callback callback ) {
+		MemoryModel::Callback* cb = new MemoryModel::Callback;
+        if ( 0 == m_walkLevels ) {
+			*cb = std::bind( &SharedTlb::resolved, this, req, callback );
+        } else {
+			*cb = std::bind( &SharedTlb::walkRead, this, req, callback, m_walkLevels );
+        }
+        m_model.schedCallback( m_tlbMissLat_ns, cb );
+    }
+
+    void walkRead( MemReq* req, Callback callback, int level ) {
+		MemoryModel::Callback* cb = new MemoryModel::Callback;
+        if ( 1 == level ) {
+			*cb = std::bind( &SharedTlb::resolved, this, req, callback );
+        } else {
+			*cb = std::bind( &SharedTlb::walkRead, this, req, callback, level - 1 );
+        }
+        // page tables are not modelled, the address is only used for the mem_addrs statistic
+        Hermes::Vaddr entryAddr = ( processPageAddr(req) >> ( 9 * level ) ) & ~(Hermes::Vaddr)7;
+        m_model.tlbWalkRead( new MemReq( entryAddr, 8, req->pid, true ), cb );
+    }
+
     void resolved( MemReq* req, Callback callback  ) {
         uint64_t pageAddr = processPageAddr(req);
         uint64_t physAddr = processPhysAddr(req);
@@ -116,9 +138,7 @@ private:
             } else {
                 ++m_numLookups;
                 m_pendingMap[pageAddr];
-				MemoryModel::Callback* cb = new MemoryModel::Callback;
-				*cb = std::bind( &SharedTlb::resolved, this, req, callback );
-                m_model.schedCallback( m_tlbMissLat_ns, cb );
+                walk( req, callback );
                 m_dbg.verbosePrefix(prefix(),CALL_INFO,1,SHARED_TLB_MASK, "Schedule: virtAddr=%#" PRIx64 " physAddr=%#" PRIx64 " pageAddr=%#" PRIx64"\n",
                 req->addr, physAddr, pageAddr );
                 break;
@@ -142,6 +162,7 @@ private:
     Output& m_dbg;
     int m_tlbMissLat_ns;
     int m_numWalkers;
+    int m_walkLevels;
     uint64_t m_pageMask;
     Cache       m_cache;
 	Statistic<uint64_t>* m_hitCnt;
@@ -51,6 +51,9 @@ public:
 		{"memReadLat_ns",       "Sets the latency for a read of host memory","150"},
 		{"memWriteLat_ns",     	"Sets the latency for a write of host memory","150"},
 		{"memNumSlots",        	"Sets the number of operations the memory control can do in parallel","10"},
+		{"memBandwidth_GBs",    "Sets the bandwidth of the memory channel shared by the NIC and the cores, 0 for no bandwidth limit","0"},
+		{"memNicShare",         "Sets the fraction of the memory bandwidth NIC DMA gets when the cores also want it","0.5"},
+		{"memNicPriority",      "Sets whether NIC DMA always goes ahead of core requests at the memory controller","no"},
 		{"nicNumLoadSlots",     "Sets the number of loads the NIC can do in parallel","32"},
 		{"nicNumStoreSlots",    "Sets the number of stores the NIC can do in parallel","32"},
 		{"hostNumLoadSlots",    "Sets the number of loads the Host can do in parallel","32"},
@@ -69,6 +72,7 @@ public:
 		{"tlbMissLat_ns",       "Sets the TLB miss latency","0"},
 		{"numWalkers",          "Sets the number of TLB page walkers","1"},
 		{"numTlbSlots",         "Sets the number of loads and store the TLB can do in parallel","1"},
+		{"tlbWalkLevels",       "Sets the number of host memory reads a TLB miss makes after tlbMissLat_ns","0"},
 		{"nicToHostMTU",        "Set the size of the PCIe MTU","256"},
 		{"useHostCache",        "Sets whether or not to use a host cache","yes"},
 		{"useDetailedModel",    "Sets whether or not a detailed memory model is used","no"},
@@ -100,6 +104,11 @@ public:
         { "mem_num_loads",                     "total number of loads", "count", 1},
         { "mem_num_stores",                    "total number of stores", "count", 1},
         { "mem_addrs",                         "addresses accesed", "value", 1},
+        { "mem_host_bytes",                    "bytes the cores moved over the memory channel", "bytes", 1},
+        { "mem_nic_bytes",                     "bytes the NIC moved over the memory channel", "bytes", 1},
+        { "mem_host_queue_ns",                 "time core requests waited for the memory channel", "nanoseconds", 1},
+        { "mem_nic_queue_ns",                  "time NIC requests waited for the memory channel", "nanoseconds", 1},
+        { "mem_tlb_walk_reads",                "number of memory reads made by TLB page walks", "count", 1},
 	)
 
 
@@ -165,6 +174,11 @@ public:
 		int memReadLat_ns = params.find<int>( "memReadLat_ns", 150 );
 		int memWriteLat_ns = params.find<int>( "memWriteLat_ns", 150 );
 		int memNumSlots = params.find<int>( "memNumSlots", 10 );
+		double memBandwidth = params.find<double>( "memBandwidth_GBs", 0 );
+		double memNicShare = params.find<double>( "memNicShare", 0.5 );
+		if ( memNicShare <= 0 || memNicShare >= 1 ) {
+			m_dbg.fatal(CALL_INFO,0,"memNicShare must be between 0 and 1, got %f\n",memNicShare);
+		}
 
 		int nicNumLoadSlots = params.find<int>( "nicNumLoadSlots", 32 );
 		int nicNumStoreSlots = params.find<int>( "nicNumStoreSlots", 32 );
@@ -188,6 +202,7 @@ public:
 		int tlbMissLat_ns = params.find<int>( "tlbMissLat_ns", 0 );
 		int numWalkers = params.find<int>( "numWalkers", 1 );
 		int numTlbSlots = params.find<int>( "numTlbSlots", 1 );
+		int tlbWalkLevels = params.find<int>( "tlbWalkLevels", 0 );
         int nicToHostMTU = params.find<int>( "nicToHostMTU", 256 );
 		std::string tmp = params.find<std::string>( "useHostCache", "yes" );
 		bool useHostCache;
@@ -216,12 +231,27 @@ public:
 			m_dbg.fatal(CALL_INFO,0,"unknown value for parameter useBusBridge '%s'\n",tmp.c_str());
 		}
 
+		bool memNicPriority;
+		tmp = params.find<std::string>( "memNicPriority", "no" );
+		if ( 0 == tmp.compare("yes" ) ) {
+			memNicPriority = true;
+		} else if ( 0 == tmp.compare("no" ) ) {
+			memNicPriority = false;
+		} else {
+			m_dbg.fatal(CALL_INFO,0,"unknown value for parameter memNicPriority '%s'\n",tmp.c_str());
+		}
+
+		if ( m_detailedUnit && ( memBandwidth > 0 || tlbWalkLevels > 0 ) ) {
+			m_dbg.fatal(CALL_INFO,0,"memBandwidth_GBs and tlbWalkLevels are not supported with useDetailedModel\n");
+		}
+
 		if ( 0 == params.find<std::string>( "printConfig", "no" ).compare("yes" ) ) {
 			m_dbg.output("Node id=%d is using SimpleMemoryModel, useBusBridge=%d, useHostCache=%d\n", id, useBusBridge, useHostCache);
 		}
 
 		if ( ! m_detailedUnit ) {
-			m_memUnit = new MemUnit( *this, m_dbg, id, memReadLat_ns, memWriteLat_ns, memNumSlots );
+			m_memUnit = new MemUnit( *this, m_dbg, id, memReadLat_ns, memWriteLat_ns, memNumSlots,
+										memBandwidth, memNicShare, memNicPriority );
 		} else {
 			m_memUnit = static_cast<MemUnit*>(m_detailedUnit);
 		}
@@ -244,7 +274,7 @@ public:
 	    	nicMuxUnit = m_muxUnit;
 		}
 
-        m_sharedTlb = new SharedTlb( *this, m_dbg, id, tlbSize, tlbPageSize, tlbMissLat_ns, numWalkers );
+        m_sharedTlb = new SharedTlb( *this, m_dbg, id, tlbSize, tlbPageSize, tlbMissLat_ns, numWalkers, tlbWalkLevels );
 
 		m_nicUnit = new NicUnit( *this, m_dbg, id );
 
@@ -364,6 +394,10 @@ public:
 
 	NicUnit& nicUnit() { return *m_nicUnit; }
 
+	void tlbWalkRead( MemReq* req, Callback* callback ) {
+		m_memUnit->walk( req, callback );
+	}
+
 	bool busUnitWrite( UnitBase* src, MemReq* req, Callback* callback ) {
 		if ( m_busBridgeUnit ) {
 			return m_busBridgeUnit->write( src, req, callback );
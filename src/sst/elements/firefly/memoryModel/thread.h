@@ -96,7 +96,8 @@ class Thread : public UnitBase {
   public:
      Thread( SimpleMemoryModel& model, std::string name, Output& output, int id, int thread_id , int accessSize, Unit* load, Unit* store ) :
 			m_model(model), m_name(name), m_dbg(output), m_id(id), m_loadUnit(load), m_storeUnit(store),
-			m_maxAccessSize( accessSize ), m_nextOp(NULL), m_waitingOnOp(NULL), m_blocked(false), m_curWorkNum(0),m_lastDelete(0)
+			m_maxAccessSize( accessSize ), m_nextOp(NULL), m_waitingOnOp(NULL), m_blocked(false), m_curWorkNum(0),m_lastDelete(0),
+			m_isNic( 0 == name.compare("nic") )
 	{
 		m_prefix = "@t:" + std::to_string(id) + ":SimpleMemoryModel::" + name +"::@p():@l ";
         m_dbg.verbosePrefix( prefix(), CALL_INFO,1,THREAD_MASK,"this=%p\n",this );
@@ -215,14 +216,14 @@ class Thread : public UnitBase {
           case MemOp::BusStore:
           case MemOp::BusDmaToHost:
             addr |= (uint64_t) pid << 56;
-			m_blocked = m_storeUnit->storeCB( this, new MemReq( addr, length, pid ), callback );
+			m_blocked = m_storeUnit->storeCB( this, new MemReq( addr, length, pid, m_isNic ), callback );
             break;
 
           case MemOp::HostLoad:
           case MemOp::BusLoad:
           case MemOp::BusDmaFromHost:
             addr |= (uint64_t) pid << 56;
-			m_blocked = m_loadUnit->load( this, new MemReq( addr, length, pid ), callback );
+			m_blocked = m_loadUnit->load( this, new MemReq( addr, length, pid, m_isNic ), callback );
             break;
 
           default:
@@ -332,6 +333,7 @@ class Thread : public UnitBase {
     int                 m_curWorkNum;
     int                 m_lastDelete;
     int                 m_id;
+    bool                m_isNic;
     std::map<int,Work*> m_OOOwork;
 	Statistic<uint64_t>* m_workQdepth;
 };
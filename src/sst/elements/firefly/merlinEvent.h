@@ -68,6 +68,9 @@ class FireflyNetworkEvent : public Event {
         destPid = pid;
     }
 
+    void setSeq( uint16_t _seq ) { seq = _seq; }
+    uint16_t getSeq() { return seq; }
+
     int getSrcNode() { return srcNode; }
     int getSrcPid() { return srcPid; }
     int getSrcStream() { return srcStream; }
@@ -166,6 +166,8 @@ Nic::Nic(ComponentId_t id, Params &params) :
         }, m_numVN
     );
 
+    initRails( params );
+
     m_selfLink = configureSelfLink("Nic::selfLink", "1 ns",
         new Event::Handler2<Nic,&Nic::handleSelfEvent>(this));
     assert( m_selfLink );
@@ -318,6 +320,8 @@ Nic::Nic(ComponentId_t id, Params &params) :
 
 	m_recvStreamPending = registerStatistic<uint64_t>("recvStreamPending");
 	m_sendStreamPending = registerStatistic<uint64_t>("sendStreamPending");
+	m_hostHandlerNs =     registerStatistic<uint64_t>("host_handler_ns");
+	m_hostHandlerCalls =  registerStatistic<uint64_t>("host_handler_calls");
 
     Statistic<uint64_t>* m_sentByteCount;
     Statistic<uint64_t>* m_rcvdByteCount;
@@ -331,6 +335,12 @@ Nic::~Nic()
 	delete m_unitPool;
  	delete m_linkSendWidget;
 	delete m_linkRecvWidget;
+	for ( unsigned i = 1; i < m_rails.size(); i++ ) {
+		delete m_rails[i].sendWidget;
+		delete m_rails[i].recvWidget;
+		delete m_rails[i].sendFunctor;
+		delete m_rails[i].recvFunctor;
+	}
 
 #if 0
     int numRcvd = m_recvMachine->getNumReceived();
@@ -355,6 +365,83 @@ Nic::~Nic()
 	delete m_arbitrateDMA;
 }
 
+void Nic::initRails( Params& params )
+{
+    m_railStripeSize = params.find<SST::UnitAlgebra>( "railStripeSize", "8192B" ).getRoundedValue();
+    m_nextRail = 0;
+
+    std::string policy = params.find<std::string>( "railPolicy", "roundrobin" );
+    if ( 0 == policy.compare( "roundrobin" ) ) {
+        m_railPolicy = RailRoundRobin;
+    } else if ( 0 == policy.compare( "hash" ) ) {
+        m_railPolicy = RailHash;
+    } else {
+        m_dbg.fatal(CALL_INFO,-1,"Error: unknown railPolicy `%s`, use roundrobin or hash\n", policy.c_str() );
+    }
+
+    int numRails = params.find<int>( "numRails", 1 );
+    if ( numRails < 1 ) {
+        m_dbg.fatal(CALL_INFO,-1,"Error: numRails must be at least 1, requested %d\n", numRails );
+    }
+    if ( numRails > 1 && 0 == m_railStripeSize ) {
+        m_dbg.fatal(CALL_INFO,-1,"Error: railStripeSize must be greater than 0\n" );
+    }
+
+    Rail rail = { m_linkControl, m_recvNotifyFunctor, m_sendNotifyFunctor, m_linkRecvWidget, m_linkSendWidget };
+    m_rails.push_back( rail );
+
+    SubComponentSlotInfo* slots = getSubComponentSlotInfo( "rtrLink" );
+    for ( int i = 1; i < numRails; i++ ) {
+        if ( ! slots || ! slots->isPopulated( i ) ) {
+            m_dbg.fatal(CALL_INFO,-1,"Error: numRails is %d but slot %d of rtrLink is not populated\n", numRails, i );
+        }
+        SimpleNetwork* link = slots->create<SimpleNetwork>( i, ComponentInfo::SHARE_NONE, m_numVN );
+        assert( link );
+
+        SimpleNetwork::HandlerBase* recvFunctor = new SimpleNetwork::Handler2<Nic,&Nic::railRecvNotify,int>( this, i );
+        SimpleNetwork::HandlerBase* sendFunctor = new SimpleNetwork::Handler2<Nic,&Nic::railSendNotify,int>( this, i );
+
+        rail.link = link;
+        rail.recvFunctor = recvFunctor;
+        rail.sendFunctor = sendFunctor;
+        rail.recvWidget = new LinkControlWidget( m_dbg, [=]() { link->setNotifyOnReceive( recvFunctor ); }, m_numVN );
+        rail.sendWidget = new LinkControlWidget( m_dbg, [=]() { link->setNotifyOnSend( sendFunctor ); }, m_numVN );
+        m_rails.push_back( rail );
+    }
+
+    m_nextRecvRail.resize( m_numVN, 0 );
+    m_railStreams.resize( m_numVN );
+}
+
+// Picks the rail for a packet the first time it is at the head of the send
+// queue, the packets to a peer process stay on a rail for railStripeSize bytes
+int Nic::selectRail( X& x, int vn )
+{
+    if ( 1 == m_rails.size() ) {
+        return 0;
+    }
+
+    RailStream& stream = railStream( x.dest, x.pkt, vn );
+
+    if ( stream.rail < 0 || stream.bytes >= m_railStripeSize ) {
+        if ( stream.rail >= 0 ) {
+            ++stream.chunk;
+        }
+        stream.bytes = 0;
+
+        if ( RailRoundRobin == m_railPolicy ) {
+            stream.rail = m_nextRail;
+            m_nextRail = ( m_nextRail + 1 ) % m_rails.size();
+        } else {
+            uint64_t hash = ( (uint64_t) x.dest << 32 | x.pkt->getSrcPid() << NUM_PID_BITS | x.pkt->getDestPid() ) * 0x9e3779b97f4a7c15ULL;
+            hash ^= ( stream.chunk + 0x632be59bd9b4e019ULL ) * 0xc2b2ae3d27d4eb4fULL;
+            stream.rail = ( hash >> 32 ) % m_rails.size();
+        }
+    }
+    stream.bytes += x.pkt->payloadSize();
+    return stream.rail;
+}
+
 void Nic::init( unsigned int phase )
 {
     m_dbg.debug(CALL_INFO,1,1,"phase=%d\n",phase);
@@ -364,7 +451,9 @@ void Nic::init( unsigned int phase )
             m_vNicV[i]->init( phase );
         }
     }
-    m_linkControl->init(phase);
+    for ( unsigned i = 0; i < m_rails.size(); i++ ) {
+        m_rails[i].link->init(phase);
+    }
 	if ( m_memoryModel ) {
 		m_memoryModel->init(phase);
 	}
@@ -378,6 +467,7 @@ void Nic::init( unsigned int phase )
 
 void Nic::handleVnicEvent( Event* ev, int id )
 {
+    HostTime hostTime( this );
     NicCmdBaseEvent* event = static_cast<NicCmdBaseEvent*>(ev);
 
     m_dbg.debug(CALL_INFO,1,1,"got message from the host\n");
@@ -425,6 +515,7 @@ void Nic::handleMsgEvent( NicCmdEvent* event, int id )
 
 void Nic::handleSelfEvent( Event *e )
 {
+    HostTime hostTime( this );
     SelfEvent* event = static_cast<SelfEvent*>(e);
 
 	switch ( event->type ) {
@@ -581,13 +672,18 @@ void Nic::feedTheNetwork( int vn )
 		PriorityX* entry = pq.top();
 		X& x = *entry->data();
 
-		bool ret = m_linkControl->spaceToSend( vn, x.pkt->calcPayloadSizeInBits() );
+		if ( x.rail < 0 ) {
+			x.rail = selectRail( x, vn );
+		}
+		Rail& rail = m_rails[x.rail];
+
+		bool ret = rail.link->spaceToSend( vn, x.pkt->calcPayloadSizeInBits() );
 		if ( ! ret ) {
 
 			m_dbg.debug(CALL_INFO,1,NIC_DBG_SEND_NETWORK,"blocking on network\n" );
             schedCallback(
                 [=](){
-                    m_linkSendWidget->setNotify( [=]() {
+                    rail.sendWidget->setNotify( [=]() {
 						SimTime_t curTime = getCurrentSimCycle();
 						if ( curTime > m_predNetIdleTime ) {
 							m_dbg.debug(CALL_INFO,1,NIC_DBG_SEND_NETWORK,"network stalled latency=%" PRI_SIMTIME "\n",
@@ -602,7 +698,7 @@ void Nic::feedTheNetwork( int vn )
 		} else {
 
 			SimTime_t curTime = getCurrentSimCycle();
-			SimTime_t latPS = ( (double) x.pkt->payloadSize() / (double) m_linkBytesPerSec ) * 1000000000000;
+			SimTime_t latPS = ( (double) x.pkt->payloadSize() / (double) m_linkBytesPerSec ) * 1000000000000 / m_rails.size();
 
 			if ( curTime > m_predNetIdleTime ) {
 				m_predNetIdleTime = curTime;
@@ -612,7 +708,7 @@ void Nic::feedTheNetwork( int vn )
 			m_dbg.debug(CALL_INFO,1,NIC_DBG_SEND_NETWORK,"predNetIdleTime=%" PRI_SIMTIME "\n",m_predNetIdleTime );
 			m_dbg.debug(CALL_INFO,1,NIC_DBG_SEND_NETWORK,"p1=%" PRI_SIMTIME " p2=%d\n", entry->p1(), entry->p2() );
 
-			sendPkt( x.pkt, x.dest, vn );
+			sendPkt( x.pkt, x.dest, vn, x.rail );
 
 			x.callback();
 
@@ -623,10 +719,14 @@ void Nic::feedTheNetwork( int vn )
 	}
 }
 
-void Nic::sendPkt( FireflyNetworkEvent* ev, int dest, int vn )
+void Nic::sendPkt( FireflyNetworkEvent* ev, int dest, int vn, int rail )
 {
     assert( ev->bufSize() );
 
+    if ( m_rails.size() > 1 ) {
+        ev->setSeq( railStream( dest, ev, vn ).seq++ );
+    }
+
     m_sentPkts->addData(1);
 
 
@@ -651,7 +751,7 @@ void Nic::sendPkt( FireflyNetworkEvent* ev, int dest, int vn )
 
 	m_sentByteCount->addData( ev->payloadSize() );
 
-    bool sent = m_linkControl->send( req, vn );
+    bool sent = m_rails[rail].link->send( req, vn );
     assert( sent );
 }
 
@@ -17,10 +17,14 @@
 #ifndef COMPONENTS_FIREFLY_NIC_H
 #define COMPONENTS_FIREFLY_NIC_H
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <list>
+#include <map>
 #include <sstream>
 #include <queue>
+#include <unordered_map>
 #include <sst/core/module.h>
 #include <sst/core/component.h>
 #include <sst/core/output.h>
@@ -105,11 +109,18 @@ public:
         { "nicAllocationPolicy", "Allocation policy for Nic", "RoundRobin"},
         { "packetOverhead", "Sets the overhead of a network packet", "0"},
         { "packetSize", "Sets the size of the network packet in bits or bytes" },
+        { "numRails", "Number of network rails, rail i is a link on network plane i loaded in slot i of rtrLink", "1"},
+        { "railStripeSize", "Bytes sent to a peer on one rail before moving to the next rail", "8192"},
+        { "railPolicy", "How the next rail is picked, roundrobin or hash", "roundrobin"},
 
         { "corePortName", "Port connected to the core", "core"},
 
         { "shmem.nicCmdLatency", "Latency for posting shmem command on NIC", "10"},
         { "shmem.hostCmdLatency", "Host latency for posting shmem command", "10"},
+        { "shmem.atomicUnit.entries", "Number of words the NIC atomic unit holds, 0 has no atomic unit and local atomics run on the host", "0"},
+        { "shmem.atomicUnit.interval", "Nanoseconds between the start of atomics on the NIC atomic unit", "1"},
+        { "shmem.atomicUnit.hitLatency", "Latency in ns of an atomic on a word the atomic unit holds", "2"},
+        { "shmem.atomicUnit.missLatency", "Latency in ns added to the memory access of an atomic that misses", "0"},
 
         { "FAM_memsize", "", "0"},
         { "FAM_backed", "Controls whether FAM memory is backed in the simlation", "yes"},
@@ -142,6 +153,8 @@ public:
 
         { "recvStreamPending",   "number of pending receive stream memory operations", "depth", 1},
         { "sendStreamPending",   "number of pending send stream memory operations", "depth", 1},
+        { "host_handler_ns",     "host (wall clock) nanoseconds spent in the NIC's link, self and network handlers, only measured while enabled", "nanoseconds", 5},
+        { "host_handler_calls",  "number of handler calls included in host_handler_ns", "calls", 5},
 
         { "detailed_num_reads",                "total number of loads", "count", 1},
         { "detailed_num_writes",               "total number of stores", "count", 1},
@@ -179,6 +192,10 @@ private:
 			return m_num[vn] > 0;
 		}
 
+		inline bool isSet( int vn ) {
+			return m_notifiers[vn] != NULL;
+		}
+
 		inline void setNotify( std::function<void()> notifier, int vn ) {
         	m_dbg.debug(CALL_INFO,1, NIC_DBG_LINK_CTRL,"Widget vn=%d, number now installed %d\n",vn,m_num[vn] + 1);
 			if ( m_num[vn] == 0 ) {
@@ -364,6 +381,28 @@ public:
 	Statistic<uint64_t>* m_hostStall;
 	Statistic<uint64_t>* m_recvStreamPending;
 	Statistic<uint64_t>* m_sendStreamPending;
+	Statistic<uint64_t>* m_hostHandlerNs;
+	Statistic<uint64_t>* m_hostHandlerCalls;
+
+    // times the enclosing handler into host_handler_ns when it is enabled
+    class HostTime {
+      public:
+        HostTime( Nic* nic ) : m_nic( nic ),
+            m_on( ! nic->m_hostHandlerNs->isNullStatistic() && nic->m_hostHandlerNs->isEnabled() )
+        {
+            if ( m_on ) m_start = std::chrono::steady_clock::now();
+        }
+        ~HostTime() {
+            if ( ! m_on ) return;
+            m_nic->m_hostHandlerNs->addData( std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - m_start ).count() );
+            m_nic->m_hostHandlerCalls->addData( 1 );
+        }
+      private:
+        Nic* m_nic;
+        bool m_on;
+        std::chrono::steady_clock::time_point m_start;
+    };
 
     void detailedMemOp( Thornhill::DetailedCompute* detailed,
             std::vector<MemOp>& vec, std::string op, Callback callback );
@@ -460,6 +499,7 @@ public:
 
     bool sendNotify(int vn)
     {
+        HostTime hostTime( this );
         m_dbg.debug(CALL_INFO,2,1,"network can send on vn=%d\n",vn);
         return m_linkSendWidget->notify( vn );
     }
@@ -467,6 +507,7 @@ public:
 
     bool recvNotify(int vn)
     {
+        HostTime hostTime( this );
         m_dbg.debug(CALL_INFO,2,1,"network event available vn=%d\n",vn);
         return m_linkRecvWidget->notify( vn );
     }
@@ -475,11 +516,12 @@ public:
     int IdToNet( int x ) { return x; }
 
 struct X {
-	X( Callback callback, FireflyNetworkEvent* pkt, int dest) : callback(callback), pkt(pkt), dest(dest) {}
+	X( Callback callback, FireflyNetworkEvent* pkt, int dest) : callback(callback), pkt(pkt), dest(dest), rail(-1) {}
 
 	Callback			 callback;
 	FireflyNetworkEvent* pkt;
 	int                  dest;
+	int                  rail;
 };
 
 	typedef PriorityEntry<X*> PriorityX;
@@ -503,6 +545,89 @@ struct X {
 
 	uint64_t m_linkBytesPerSec;
 
+    // With more than one rail the packets to a peer process are striped over
+    // the rails in railStripeSize chunks and carry a sequence number so the
+    // receiver can put them back in the order they were sent. Rail 0 is
+    // m_linkControl.
+    struct Rail {
+        SST::Interfaces::SimpleNetwork* link;
+        SST::Interfaces::SimpleNetwork::HandlerBase* recvFunctor;
+        SST::Interfaces::SimpleNetwork::HandlerBase* sendFunctor;
+        LinkControlWidget* recvWidget;
+        LinkControlWidget* sendWidget;
+    };
+
+    struct RailStream {
+        RailStream() : rail(-1), bytes(0), chunk(0), seq(0) {}
+        int      rail;
+        size_t   bytes;
+        uint32_t chunk;
+        uint16_t seq;
+    };
+
+    enum { RailRoundRobin, RailHash } m_railPolicy;
+    size_t m_railStripeSize;
+    int m_nextRail;
+    std::vector<Rail> m_rails;
+    std::vector<int> m_nextRecvRail;
+    std::vector< std::unordered_map<uint64_t, RailStream> > m_railStreams;
+
+    int numRails() { return m_rails.size(); }
+    void initRails( Params& );
+    int selectRail( X&, int vn );
+    RailStream& railStream( int dest, FireflyNetworkEvent* ev, int vn ) {
+        uint64_t key = ev->getDestPid();
+        key |= ev->getSrcPid() << NUM_PID_BITS;
+        key |= (uint64_t) dest << (NUM_PID_BITS * 2);
+        return m_railStreams[vn][key];
+    }
+
+    bool railRecvNotify( int vn, int rail ) {
+        m_dbg.debug(CALL_INFO,2,1,"network event available vn=%d rail=%d\n",vn,rail);
+        return m_rails[rail].recvWidget->notify( vn );
+    }
+
+    bool railSendNotify( int vn, int rail ) {
+        m_dbg.debug(CALL_INFO,2,1,"network can send on vn=%d rail=%d\n",vn,rail);
+        return m_rails[rail].sendWidget->notify( vn );
+    }
+
+    void setRecvNotify( std::function<void()> notifier, int vn ) {
+        if ( 1 == m_rails.size() ) {
+            m_linkRecvWidget->setNotify( notifier, vn );
+        } else {
+            for ( unsigned i = 0; i < m_rails.size(); i++ ) {
+                if ( ! m_rails[i].recvWidget->isSet( vn ) ) {
+                    m_rails[i].recvWidget->setNotify( notifier, vn );
+                }
+            }
+        }
+    }
+
+    bool requestToReceive( int vn ) {
+        for ( unsigned i = 0; i < m_rails.size(); i++ ) {
+            if ( m_rails[i].link->requestToReceive( vn ) ) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    SST::Interfaces::SimpleNetwork::Request* recv( int vn ) {
+        if ( 1 == m_rails.size() ) {
+            return m_linkControl->recv( vn );
+        }
+        for ( unsigned i = 0; i < m_rails.size(); i++ ) {
+            int rail = m_nextRecvRail[vn];
+            m_nextRecvRail[vn] = ( rail + 1 ) % m_rails.size();
+            SST::Interfaces::SimpleNetwork::Request* req = m_rails[rail].link->recv( vn );
+            if ( req ) {
+                return req;
+            }
+        }
+        return NULL;
+    }
+
     std::vector< int >      m_sendStreamNum;
 
     int getSendStreamNum( int pid ) {
@@ -525,7 +650,7 @@ struct X {
     UnitPool* m_unitPool;
 
     void feedTheNetwork( int vn );
-    void sendPkt( FireflyNetworkEvent*, int dest, int vn );
+    void sendPkt( FireflyNetworkEvent*, int dest, int vn, int rail = 0 );
     void notifySendDone( SendMachine* mach, SendEntryBase* entry );
 
     void qSendEntry( SendEntryBase* entry );
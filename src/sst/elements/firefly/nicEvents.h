@@ -61,7 +61,7 @@ class NicCmdBaseEvent : public Event {
 class NicShmemCmdEvent : public NicCmdBaseEvent {
   public:
 
-    enum Type { Init, RegMem, Fence, Put, Putv, Get, Getv, Wait, Add, Fadd, Swap, Cswap } type;
+    enum Type { Init, RegMem, Fence, Put, Putv, Get, Getv, Wait, Add, Fadd, Swap, Cswap, Trigger } type;
     std::string getTypeStr( ) {
         switch( type ) {
             case Init:
@@ -88,6 +88,8 @@ class NicShmemCmdEvent : public NicCmdBaseEvent {
             return "Swap";
             case Cswap:
             return "Cswap";
+            case Trigger:
+            return "Trigger";
         }
         return "";
     }
@@ -373,6 +375,21 @@ class NicShmemOpCmdEvent : public NicShmemCmdEvent {
 };
 
 
+// A put held on the NIC until the counter at addr is at least threshold
+class NicShmemTriggerCmdEvent : public NicShmemCmdEvent {
+  public:
+    NicShmemTriggerCmdEvent( Hermes::Vaddr addr, Hermes::Value& threshold, NicShmemPutCmdEvent* put ) :
+        NicShmemCmdEvent( Trigger ), addr(addr), threshold(threshold), put(put) {}
+
+    virtual int getNode() { return -1; }
+
+    Hermes::Vaddr   addr;
+    Hermes::Value   threshold;
+    NicShmemPutCmdEvent* put;
+
+	NotSerializable(NicShmemTriggerCmdEvent)
+};
+
 class NicCmdEvent : public NicCmdBaseEvent {
   public:
     enum Type { PioSend, DmaSend, DmaRecv, Put, Get, RegMemRgn } type;
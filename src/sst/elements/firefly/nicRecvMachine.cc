@@ -83,12 +83,12 @@ void Nic::RecvMachine::processStdPkt( FireflyNetworkEvent* ev ) {
 
 void Nic::RecvMachine::printStatus( Output& out ) {
 #ifdef NIC_RECV_DEBUG
-    if ( m_nic.m_linkControl->requestToReceive( 0 ) ) {
+    if ( m_nic.requestToReceive( 0 ) ) {
         out.output( "%lu: %d: RecvMachine `%s` msgCount=%d runCount=%d,"
             " net event avail %d\n",
             Simulation::getSimulation()->getCurrentSimCycle(),
             m_nic. m_myNodeId, state( m_state), m_msgCount, m_runCount,
-            m_nic.m_linkControl->requestToReceive( 0 ) );
+            m_nic.requestToReceive( 0 ) );
     }
 #endif
 }
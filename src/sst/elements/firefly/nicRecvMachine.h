@@ -106,7 +106,7 @@ class RecvMachine {
 
         void setNotify( ) {
             m_dbg.debug(CALL_INFO,2,NIC_DBG_RECV_MACHINE, "\n");
-            m_nic.m_linkRecvWidget->setNotify( std::bind(&Nic::RecvMachine::networkHasPkt, this), m_vn );
+            m_nic.setRecvNotify( std::bind(&Nic::RecvMachine::networkHasPkt, this), m_vn );
         }
 
         void networkHasPkt() {
@@ -123,7 +123,9 @@ class RecvMachine {
             if ( m_numPendingPkts < m_maxPendingPkts ) {
 
                 FireflyNetworkEvent* ev = getNetworkEvent( m_vn );
-                if ( ev ) {
+                if ( ev && m_nic.numRails() > 1 ) {
+                    reorderPkt( ev );
+                } else if ( ev ) {
                     ++m_numPendingPkts;
                     m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "got packet numPendingPkts=%d\n", m_numPendingPkts );
                     m_pktBuf[ getPPI(ev) ].push( ev );
@@ -173,7 +175,7 @@ class RecvMachine {
 				}
 			}
 
-			if ( m_pktBuf.empty() && ! m_nic.m_linkControl->requestToReceive( m_vn )) {
+			if ( m_pktBuf.empty() && ! m_nic.requestToReceive( m_vn )) {
 				m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "pktBuf is empty\n");
                 setNotify();
                 m_clocking = false;
@@ -184,8 +186,37 @@ class RecvMachine {
         }
 
 
+        // packets from a process that come over more than one rail are held
+        // back until the ones sent before them have arrived, they are not
+        // pending packets until then so they can't stop the missing one
+        // being taken from the network
+        void reorderPkt( FireflyNetworkEvent* ev ) {
+            ProcessPairId ppi = getPPI( ev );
+            RailReorder& reorder = m_railReorder[ ppi ];
+
+            if ( ev->getSeq() != reorder.next ) {
+                m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "hold packet seq=%d want=%d\n", ev->getSeq(), reorder.next );
+                reorder.held[ ev->getSeq() ] = ev;
+                return;
+            }
+
+            while ( ev ) {
+                ++m_numPendingPkts;
+                m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "got packet seq=%d numPendingPkts=%d\n", ev->getSeq(), m_numPendingPkts );
+                m_pktBuf[ ppi ].push( ev );
+                ++reorder.next;
+
+                ev = NULL;
+                std::unordered_map<uint16_t, FireflyNetworkEvent*>::iterator iter = reorder.held.find( reorder.next );
+                if ( iter != reorder.held.end() ) {
+                    ev = iter->second;
+                    reorder.held.erase( iter );
+                }
+            }
+        }
+
         FireflyNetworkEvent* getNetworkEvent(int vn ) {
-            SST::Interfaces::SimpleNetwork::Request* req = m_nic.m_linkControl->recv(vn);
+            SST::Interfaces::SimpleNetwork::Request* req = m_nic.recv(vn);
 
             if ( req ) {
 
@@ -224,6 +255,13 @@ class RecvMachine {
         SimTime_t   m_clockLat;
         bool        m_clocking;
 
+        struct RailReorder {
+            RailReorder() : next(0) {}
+            uint16_t next;
+            std::unordered_map<uint16_t, FireflyNetworkEvent*> held;
+        };
+
         std::unordered_map<ProcessPairId, std::queue<FireflyNetworkEvent*> > m_pktBuf;
+        std::unordered_map<ProcessPairId, RailReorder> m_railReorder;
         std::unordered_map<StreamKey, StreamBase* >  m_streamMap;
 };
@@ -33,11 +33,20 @@ void Nic::Shmem::handleEvent( NicShmemCmdEvent* event, int id )
     case NicShmemCmdEvent::Cswap:
     case NicShmemCmdEvent::Swap:
     case NicShmemCmdEvent::Fence:
+    case NicShmemCmdEvent::Trigger:
         handleNicEvent( event, id );
         break;
 
+    // with an atomic unit the NIC does local atomics as well
     case NicShmemCmdEvent::Fadd:
     case NicShmemCmdEvent::Add:
+        if ( event->getNode() == m_nic.getNodeId() && ! m_atomicUnit.enabled() )  {
+			handleHostEvent( event, id );
+        } else {
+            handleNicEvent( event, id );
+        }
+        break;
+
     case NicShmemCmdEvent::Put:
     case NicShmemCmdEvent::Putv:
     case NicShmemCmdEvent::Get:
@@ -136,6 +145,7 @@ void Nic::Shmem::handleNicEvent( NicShmemCmdEvent* event, int id )
       case NicShmemCmdEvent::RegMem:
       case NicShmemCmdEvent::Wait:
       case NicShmemCmdEvent::Fence:
+      case NicShmemCmdEvent::Trigger:
 		break;
 
       default:
@@ -207,10 +217,21 @@ void Nic::Shmem::handleNicEvent3( NicShmemCmdEvent* event, int id )
         getv( static_cast<NicShmemGetvCmdEvent*>(event), id );
         break;
     case NicShmemCmdEvent::Add:
-        add( static_cast< NicShmemAddCmdEvent*>(event), id );
+        if ( event->getNode() == m_nic.getNodeId() )  {
+            sameNodeAdd( static_cast< NicShmemAddCmdEvent*>(event), id );
+        } else {
+            add( static_cast< NicShmemAddCmdEvent*>(event), id );
+        }
         break;
     case NicShmemCmdEvent::Fadd:
-        fadd( static_cast< NicShmemFaddCmdEvent*>(event), id );
+        if ( event->getNode() == m_nic.getNodeId() )  {
+            sameNodeFadd( static_cast< NicShmemFaddCmdEvent*>(event), id );
+        } else {
+            fadd( static_cast< NicShmemFaddCmdEvent*>(event), id );
+        }
+        break;
+    case NicShmemCmdEvent::Trigger:
+        trigger( static_cast< NicShmemTriggerCmdEvent*>(event), id );
         break;
     case NicShmemCmdEvent::Cswap:
         if ( event->getNode() == m_nic.getNodeId() )  {
@@ -275,7 +296,7 @@ void Nic::Shmem::regMem( NicShmemRegMemCmdEvent* event, int id )
 }
 
 
-void Nic::Shmem::put( NicShmemPutCmdEvent* event, int id )
+void Nic::Shmem::put( NicShmemPutCmdEvent* event, int id, bool notify )
 {
     m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"core=%d targetNode=%d farAddr=%" PRIx64" len=%lu\n",
                             id, event->getNode(), event->getFarAddr(), event->getLength() );
@@ -293,7 +314,9 @@ void Nic::Shmem::put( NicShmemPutCmdEvent* event, int id )
     ShmemPutSendEntry* entry = new ShmemPutbSendEntry( id, m_nic.getSendStreamNum(id), event, getBacking( id, event->getMyAddr(), event->getLength() ), vn,
 					[=]() {
                         m_dbg.verbosePrefix( prefix(),CALL_INFO_LAMBDA,"put",1,NIC_DBG_SHMEM,"finished\n");
-        			   	m_nic.getVirtNic(id)->notifyShmem( 0, callback );
+						if ( notify ) {
+        			   		m_nic.getVirtNic(id)->notifyShmem( 0, callback );
+						}
 						decActivePuts(id);
 					}
     );
@@ -649,7 +672,7 @@ void Nic::Shmem::sameNodeCswap( NicShmemCswapCmdEvent* event, int id )
    		vec->push_back( MemOp( event->getFarAddr(), event->getLength(), MemOp::Op::BusStore ));
     }
 
-	m_nic.calcNicMemDelay( m_nic.allocNicRecvUnit(id), id, vec,
+	atomicMemDelay( m_nic.allocNicRecvUnit(id), id, event->getFarAddr(), vec,
 		[=]() {
 			Hermes::Value _save = save;
             m_dbg.verbosePrefix( prefix(),CALL_INFO_LAMBDA,"sameNodeCswap",1,NIC_DBG_SHMEM,"core=%d finished\n",id);
@@ -679,7 +702,7 @@ void Nic::Shmem::sameNodeSwap( NicShmemSwapCmdEvent* event, int id )
    	vec->push_back( MemOp( event->getFarAddr(), event->getLength(), MemOp::Op::BusLoad ));
    	vec->push_back( MemOp( event->getFarAddr(), event->getLength(), MemOp::Op::BusStore ));
 
-	m_nic.calcNicMemDelay(m_nic.allocNicRecvUnit(id), id, vec,
+	atomicMemDelay( m_nic.allocNicRecvUnit(id), id, event->getFarAddr(), vec,
 		[=](){
 			Hermes::Value _save = save;
             m_dbg.verbosePrefix( prefix(),CALL_INFO_LAMBDA,"sameNodeSwap",1,NIC_DBG_SHMEM,"core=%d finished\n",id);
@@ -690,6 +713,129 @@ void Nic::Shmem::sameNodeSwap( NicShmemSwapCmdEvent* event, int id )
 
 }
 
+void Nic::Shmem::sameNodeAdd( NicShmemAddCmdEvent* event, int id )
+{
+    m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"core=%d\n",id);
+    Hermes::Value local( event->getDataType(),
+                getBacking( event->getVnic(), event->getFarAddr(), event->getLength() ) );
+	std::vector<MemOp>* vec = new std::vector<MemOp>;
+
+    if ( local.getPtr() ) {
+        local += event->getValue();
+    }
+
+    checkWaitOps( event->getVnic(), event->getFarAddr(), local.getLength() );
+
+   	vec->push_back( MemOp( event->getFarAddr(), event->getLength(), MemOp::Op::BusLoad ));
+   	vec->push_back( MemOp( event->getFarAddr(), event->getLength(), MemOp::Op::BusStore ));
+
+	atomicMemDelay( m_nic.allocNicRecvUnit(id), id, event->getFarAddr(), vec,
+		[=](){
+            m_dbg.verbosePrefix( prefix(),CALL_INFO_LAMBDA,"sameNodeAdd",1,NIC_DBG_SHMEM,"core=%d finished\n",id);
+           	m_nic.getVirtNic(id)->notifyShmem( getNic2HostDelay_ns() );
+			decActivePuts(id);
+			decPendingPuts(id);
+    		delete event;
+		}
+	);
+}
+
+void Nic::Shmem::sameNodeFadd( NicShmemFaddCmdEvent* event, int id )
+{
+    m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"core=%d\n",id);
+    Hermes::Value local( event->getDataType(),
+                getBacking( event->getVnic(), event->getFarAddr(), event->getLength() ) );
+
+    Hermes::Value save = Hermes::Value( event->getDataType() );
+	std::vector<MemOp>* vec = new std::vector<MemOp>;
+
+    if ( local.getPtr() ) {
+        save = local;
+        local += event->getValue();
+    }
+
+    checkWaitOps( event->getVnic(), event->getFarAddr(), local.getLength() );
+
+   	vec->push_back( MemOp( event->getFarAddr(), event->getLength(), MemOp::Op::BusLoad ));
+   	vec->push_back( MemOp( event->getFarAddr(), event->getLength(), MemOp::Op::BusStore ));
+
+	atomicMemDelay( m_nic.allocNicRecvUnit(id), id, event->getFarAddr(), vec,
+		[=](){
+			Hermes::Value _save = save;
+            m_dbg.verbosePrefix( prefix(),CALL_INFO_LAMBDA,"sameNodeFadd",1,NIC_DBG_SHMEM,"core=%d finished\n",id);
+    		m_nic.getVirtNic(id)->notifyShmem( 0, event->getCallback(), _save );
+    		delete event;
+		}
+	);
+}
+
+void Nic::Shmem::atomicMemDelay( int unit, int core, Hermes::Vaddr addr, std::vector< MemOp >* vec, std::function<void()> callback )
+{
+    if ( ! m_atomicUnit.enabled() ) {
+        m_nic.calcNicMemDelay( unit, core, vec, callback );
+        return;
+    }
+
+    bool hit;
+    SimTime_t delay = m_atomicUnit.issue( m_nic.getCurrentSimTimeNano(), core, addr, hit );
+    m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"core=%d addr=%#" PRIx64 " %s delay=%" PRIu64 "\n",
+            core, addr, hit ? "hit" : "miss", delay );
+
+    if ( hit ) {
+        // the word is on the NIC, only the completions of the memory ops happen
+        m_nic.schedCallback(
+            [=]() {
+                for ( unsigned i = 0; i < vec->size(); i++ ) {
+                    if ( (*vec)[i].callback ) {
+                        (*vec)[i].callback();
+                    }
+                }
+                delete vec;
+                callback();
+            }, delay );
+    } else {
+        m_nic.schedCallback(
+            [=]() {
+                m_nic.calcNicMemDelay( unit, core, vec, callback );
+            }, delay );
+    }
+}
+
+void Nic::Shmem::trigger( NicShmemTriggerCmdEvent* event, int id )
+{
+    std::stringstream tmp;
+    tmp << event->threshold;
+    m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"core=%d counter=%" PRIx64 " threshold=%s\n", id, event->addr,
+			tmp.str().c_str() );
+
+    NicShmemPutCmdEvent* put = event->put;
+    if ( put->getNode() == m_nic.getNodeId() ) {
+        m_dbg.fatal(CALL_INFO,-1,"core %d triggered put to the local node is not supported\n", id );
+    }
+
+    NicShmemOpCmdEvent* cond = new NicShmemOpCmdEvent( event->addr, Hermes::Shmem::GTE, event->threshold, NULL );
+    Op* op = new WaitOp( cond, getBacking( id, event->addr, event->threshold.getLength() ),
+            [=]() {
+                m_dbg.verbosePrefix( prefix(),CALL_INFO_LAMBDA,"trigger",1,NIC_DBG_SHMEM,"core=%d fire put\n",id);
+                incActivePuts(id);
+                incPendingPuts(id);
+                this->put( put, id, false );
+            },
+            Op::Trigger
+        );
+    delete event;
+
+    // the host only waits for the put to be posted
+    m_nic.getVirtNic(id)->notifyShmem( getNic2HostDelay_ns() );
+
+    if ( ! op->checkOp( m_dbg, id ) ) {
+        m_pendingOps[id].push_back( op );
+    } else {
+        m_nic.schedCallback( op->callback() );
+        delete op;
+    }
+}
+
 
 void Nic::Shmem::doReduction( Hermes::Shmem::ReduOp op, int destCore, Hermes::Vaddr destAddr,
 			int srcCore, Hermes::Vaddr srcAddr, size_t length, Hermes::Value::Type type, std::vector<MemOp>& vec )
@@ -751,7 +897,8 @@ void Nic::Shmem::checkWaitOps( int core, Hermes::Vaddr addr, size_t length )
         if ( op->inRange( addr, length ) && op->checkOp( m_dbg, core ) ) {
 
         	m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"op valid, notify\n");
-			m_nic.schedCallback( op->callback(), m_nic2HostDelay_ns );
+			// a triggered operation runs on the NIC, a wait notifies the host
+			m_nic.schedCallback( op->callback(), op->m_type == Op::Trigger ? 0 : m_nic2HostDelay_ns );
             delete op;
             iter = m_pendingOps[core].erase(iter);
         } else {
@@ -20,7 +20,7 @@ class Shmem {
     class Op {
       public:
         typedef std::function<void()> Callback;
-        enum Type { Wait } m_type;
+        enum Type { Wait, Trigger } m_type;
         Op( Type type, NicShmemOpCmdEvent* cmd, Callback callback ) : m_type(type), m_cmd(cmd), m_callback(callback) {}
         virtual ~Op() {
 			delete m_cmd;
@@ -40,8 +40,8 @@ class Shmem {
 
     class WaitOp : public Op {
       public:
-        WaitOp( NicShmemOpCmdEvent* cmd, void* backing, Callback callback ) :
-            Op( Wait, cmd, callback ),
+        WaitOp( NicShmemOpCmdEvent* cmd, void* backing, Callback callback, Type type = Wait ) :
+            Op( type, cmd, callback ),
             m_value( cmd->value.getType(), backing )
         {}
 
@@ -77,6 +77,50 @@ class Shmem {
         Hermes::Value m_value;
     };
 
+    // Atomics executed on the NIC go through a unit that starts one every
+    // interval ns and keeps the most recently used words, an atomic on a
+    // word it holds does not touch memory.
+    class AtomicUnit {
+        typedef std::pair< int, Hermes::Vaddr > Key;
+      public:
+        AtomicUnit( Params& params ) : m_freeAt(0) {
+            m_entries = params.find<int>( "atomicUnit.entries", 0 );
+            m_interval = params.find<SimTime_t>( "atomicUnit.interval", 1 );
+            m_hitLatency = params.find<SimTime_t>( "atomicUnit.hitLatency", 2 );
+            m_missLatency = params.find<SimTime_t>( "atomicUnit.missLatency", 0 );
+        }
+
+        bool enabled() { return m_entries > 0; }
+
+        // returns how long the atomic waits for the unit and its cache
+        SimTime_t issue( SimTime_t now, int core, Hermes::Vaddr addr, bool& hit ) {
+            SimTime_t start = std::max( now, m_freeAt );
+            m_freeAt = start + m_interval;
+
+            Key key( core, addr );
+            std::map< Key, std::list< Key >::iterator >::iterator iter = m_lookup.find( key );
+            hit = iter != m_lookup.end();
+            if ( hit ) {
+                m_lru.erase( iter->second );
+            } else if ( (int) m_lru.size() == m_entries ) {
+                m_lookup.erase( m_lru.back() );
+                m_lru.pop_back();
+            }
+            m_lookup[key] = m_lru.insert( m_lru.begin(), key );
+
+            return start - now + ( hit ? m_hitLatency : m_missLatency );
+        }
+
+      private:
+        int         m_entries;
+        SimTime_t   m_interval;
+        SimTime_t   m_hitLatency;
+        SimTime_t   m_missLatency;
+        SimTime_t   m_freeAt;
+        std::list< Key > m_lru;
+        std::map< Key, std::list< Key >::iterator > m_lookup;
+    };
+
 	struct RegionEntry {
 		RegionEntry( Hermes::MemAddr addr, Hermes::Vaddr realAddr, size_t length ) : addr(addr), realAddr(addr.getSimVAddr(),addr.getBacking() ), length(length) { }
 		Hermes::MemAddr addr;
@@ -90,7 +134,8 @@ class Shmem {
   public:
     Shmem( Nic& nic, Params& params, int id, int numVnics, Output& output, SimTime_t nic2HostDelay_ns, SimTime_t host2NicDelay_ns ) :
 		m_nic( nic ), m_dbg(output), m_one( (long) 1 ),
-    	m_nic2HostDelay_ns(nic2HostDelay_ns), m_host2NicDelay_ns(host2NicDelay_ns), m_engineBusy(false),m_hostBusy(false)
+    	m_nic2HostDelay_ns(nic2HostDelay_ns), m_host2NicDelay_ns(host2NicDelay_ns), m_engineBusy(false),m_hostBusy(false),
+		m_atomicUnit( params )
     {
         m_prefix = "@t:" + std::to_string(id) + ":Nic::Shmem::@p():@l ";
         m_dbg.verbosePrefix( prefix(), CALL_INFO,1,NIC_DBG_SHMEM,"this=%p\n",this );
@@ -171,6 +216,9 @@ class Shmem {
 
     void checkWaitOps( int core, Hermes::Vaddr addr, size_t length );
 
+    bool atomicUnitEnabled() { return m_atomicUnit.enabled(); }
+    void atomicMemDelay( int unit, int core, Hermes::Vaddr addr, std::vector< MemOp >* vec, std::function<void()> callback );
+
 private:
 	SimTime_t getNic2HostDelay_ns() { return m_nic2HostDelay_ns; }
 	SimTime_t getHost2NicDelay_ns() { return m_host2NicDelay_ns; }
@@ -188,8 +236,11 @@ private:
     void hostFadd( NicShmemFaddCmdEvent*, int id );
     void sameNodeCswap( NicShmemCswapCmdEvent*, int id );
     void sameNodeSwap( NicShmemSwapCmdEvent*, int id );
+    void sameNodeAdd( NicShmemAddCmdEvent*, int id );
+    void sameNodeFadd( NicShmemFaddCmdEvent*, int id );
 
-    void put( NicShmemPutCmdEvent*, int id );
+    void trigger( NicShmemTriggerCmdEvent*, int id );
+    void put( NicShmemPutCmdEvent*, int id, bool notify = true );
     void putv( NicShmemPutvCmdEvent*, int id );
     void get( NicShmemGetCmdEvent*, int id );
     void getv( NicShmemGetvCmdEvent*, int id );
@@ -223,6 +274,7 @@ private:
 	bool m_hostBusy;
 	SimTime_t m_nicCmdLatency;
 	SimTime_t m_hostCmdLatency;
+	AtomicUnit m_atomicUnit;
 
 	// number of puts that are not sent
 	struct ActivePuts {
@@ -203,7 +203,7 @@ void Nic::RecvMachine::ShmemStream::processAdd( ShmemMsgHdr& hdr, FireflyNetwork
 	) );
 
     int srcNode = ev->getSrcNode();
-   	m_ctx->calcNicMemDelay( m_unit, memOps,
+   	m_ctx->getShmem()->atomicMemDelay( m_unit, local_pid, addr.getSimVAddr(), memOps,
 			[=]() {
 				m_dbg.debug(CALL_INFO_LAMBDA, "processAdd",1,NIC_DBG_RECV_STREAM,"send Ack to %d\n",srcNode);
 				m_sendEntry = new ShmemAckSendEntry( local_pid, m_ctx->nic().getSendStreamNum(local_pid), srcNode, dest_pid, m_ctx->nic().m_shmemAckVN );
@@ -248,7 +248,7 @@ void Nic::RecvMachine::ShmemStream::processFadd( ShmemMsgHdr& hdr, FireflyNetwor
         vn = m_ctx->nic().m_shmemGetLargeVN;
     }
     int srcNode = ev->getSrcNode();
-   	m_ctx->calcNicMemDelay( m_unit, memOps,
+   	m_ctx->getShmem()->atomicMemDelay( m_unit, local_pid, addr.getSimVAddr(), memOps,
 			[=]() {
     			m_ctx->runSend( 0, new ShmemPut2SendEntry( local_pid, m_ctx->nic().getSendStreamNum(local_pid), srcNode, dest_pid, save, hdr.respKey, vn ) );
                 m_ctx->deleteStream( this );
@@ -284,7 +284,7 @@ void Nic::RecvMachine::ShmemStream::processSwap( ShmemMsgHdr& hdr, FireflyNetwor
     }
 
     int srcNode = ev->getSrcNode();
-   	m_ctx->calcNicMemDelay( m_unit, memOps,
+   	m_ctx->getShmem()->atomicMemDelay( m_unit, local_pid, addr.getSimVAddr(), memOps,
 			[=]() {
     			m_ctx->runSend( 0, new ShmemPut2SendEntry( local_pid, m_ctx->nic().getSendStreamNum(local_pid), srcNode, dest_pid, save, hdr.respKey, vn ) );
                 m_ctx->deleteStream( this );
@@ -325,7 +325,7 @@ void Nic::RecvMachine::ShmemStream::processCswap( ShmemMsgHdr& hdr, FireflyNetwo
         vn = m_ctx->nic().m_shmemGetLargeVN;
     }
     int srcNode = ev->getSrcNode();
-   	m_ctx->calcNicMemDelay( m_unit, memOps,
+   	m_ctx->getShmem()->atomicMemDelay( m_unit, local_pid, addr.getSimVAddr(), memOps,
 		    [=]() {
     			m_ctx->runSend( 0, new ShmemPut2SendEntry( local_pid, m_ctx->nic().getSendStreamNum(local_pid), srcNode, dest_pid, save, hdr.respKey, vn ) );
                 m_ctx->deleteStream( this );
@@ -16,6 +16,9 @@
 #ifndef COMPONENTS_FIREFLY_NODE_PERF_H
 #define COMPONENTS_FIREFLY_NODE_PERF_H
 
+#include <sst/core/output.h>
+#include <sst/core/unitAlgebra.h>
+
 #include "sst/elements/hermes/hermes.h"
 
 namespace SST {
@@ -58,6 +61,114 @@ class SimpleNodePerf : public NodePerf {
     double m_bandwidth;
 };
 
+// A roofline with a ceiling for each level of the memory hierarchy. A kernel
+// is served by the first level its working set fits in and is limited by the
+// peak flops and by the bandwidth of every level down to that one. Levels
+// marked shared are split evenly between the ranks of the node, both their
+// capacity and their bandwidth.
+class RooflineNodePerf : public SimpleNodePerf {
+
+  public:
+    SST_ELI_REGISTER_MODULE(
+        RooflineNodePerf,
+        "firefly",
+        "RooflineNodePerf",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Multi-level roofline compute model",
+        SST::Hermes::NodePerf
+    )
+	SST_ELI_DOCUMENT_PARAMS(
+		{"flops","Sets the peak FLOPS of a rank","0"},
+		{"bandwidth","Sets the bandwidth for the node, used when no levels are given","0"},
+		{"ranksPerNode","Sets the number of ranks sharing the node","1"},
+		{"level_names","Array of names of the memory levels, nearest first e.g. [L1,L2,HBM,DDR]",""},
+		{"level_capacity","Array of the capacity of each level e.g. 48KiB, the last level is taken to hold everything",""},
+		{"level_bandwidth","Array of the bandwidth of each level seen by one rank e.g. 200GB/s",""},
+		{"level_shared","Array of 0/1, 1 if a level is shared by the ranks of the node",""},
+	)
+
+  private:
+    struct Level {
+        std::string name;
+        double capacity;
+        double bandwidth;
+    };
+
+  public:
+    RooflineNodePerf( Params& params ) : SimpleNodePerf( params ) {
+        int ranksPerNode = params.find<int>("ranksPerNode",1);
+        std::vector<std::string> names;
+        std::vector<std::string> capacity;
+        std::vector<std::string> bandwidth;
+        std::vector<int> shared;
+
+        params.find_array<std::string>("level_names",names);
+        params.find_array<std::string>("level_capacity",capacity);
+        params.find_array<std::string>("level_bandwidth",bandwidth);
+        params.find_array<int>("level_shared",shared);
+
+        if ( capacity.size() != bandwidth.size() ||
+                ( ! names.empty() && names.size() != capacity.size() ) ||
+                ( ! shared.empty() && shared.size() != capacity.size() ) ) {
+            Output::getDefaultObject().fatal(CALL_INFO, -1,
+                "RooflineNodePerf: level_names, level_capacity, level_bandwidth and level_shared must be the same length\n");
+        }
+        if ( ranksPerNode < 1 || getFlops() <= 0 ) {
+            Output::getDefaultObject().fatal(CALL_INFO, -1,
+                "RooflineNodePerf: flops and ranksPerNode must be positive\n");
+        }
+
+        for ( unsigned i = 0; i < capacity.size(); i++ ) {
+            UnitAlgebra bytes( capacity[i] );
+            UnitAlgebra bw( bandwidth[i] );
+            if ( bw.hasUnits("b/s") ) bw /= UnitAlgebra("8b/B");
+
+            Level level;
+            level.name = names.empty() ? std::to_string(i) : names[i];
+            level.capacity = bytes.getValue().convert_to<double>();
+            level.bandwidth = bw.getValue().convert_to<double>();
+            if ( ! shared.empty() && shared[i] ) {
+                level.capacity /= ranksPerNode;
+                level.bandwidth /= ranksPerNode;
+            }
+            if ( level.bandwidth <= 0 ) {
+                Output::getDefaultObject().fatal(CALL_INFO, -1,
+                    "RooflineNodePerf: level %s needs a bandwidth\n", level.name.c_str() );
+            }
+            m_levels.push_back( level );
+        }
+
+        if ( m_levels.empty() ) {
+            if ( getBandwidth() <= 0 ) {
+                Output::getDefaultObject().fatal(CALL_INFO, -1,
+                    "RooflineNodePerf: needs levels or a bandwidth\n");
+            }
+            Level level;
+            level.name = "memory";
+            level.capacity = 0;
+            level.bandwidth = getBandwidth();
+            m_levels.push_back( level );
+        }
+    }
+
+    virtual double calcTimeNS_roofline( double flops, double bytes, double workingSet ) {
+        double time = flops / getFlops();
+        for ( unsigned i = 0; i < m_levels.size(); i++ ) {
+            double levelTime = bytes / m_levels[i].bandwidth;
+            if ( levelTime > time ) {
+                time = levelTime;
+            }
+            if ( workingSet <= m_levels[i].capacity ) {
+                break;
+            }
+        }
+        return time * 1000 * 1000 * 1000;
+    }
+
+  private:
+    std::vector<Level> m_levels;
+};
+
 }
 }
 
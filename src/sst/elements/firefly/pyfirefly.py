@@ -155,13 +155,14 @@ class SimpleMemoryNicConfiguration(BasicNicConfiguration):
               "verboseMask","useBusBridge","useHostCache","useDetailedModel",
               "printConfig",
               "memReadLat_ns", "memWriteLat_ns", "memNumSlots",
+              "memBandwidth_GBs", "memNicShare", "memNicPriority",
               "nicNumLoadSlots", "nicNumStoreSlots",
               "hostNumLoadSlots", "hostNumStoreSlots",
               "busBandwidth_Gbs", "busNumLinks", "busLatency",
               "DLL_bytes", "TLP_overhead",
               "hostCacheUnitSize", "hostCacheNumMSHR", "hostCacheLineSize",
               "widgetSlots", "tlbPageSize", "tlbSize", "tlbMissLat_ns",
-              "numTlbSlots", "nicToHostMTU",
+              "numTlbSlots", "tlbWalkLevels", "nicToHostMTU",
               "numWalkers=32",
               ],
             "simpleMemoryModel."
@@ -224,6 +224,14 @@ void VirtNic::shmemPutOp( int node, Hermes::Vaddr dest, Hermes::Vaddr src, size_
     sendCmd(0, new NicShmemPutCmdEvent( calcCoreId(node), calcRealNicId(node), dest, src, len, op, dataType, callback ) );
 }
 
+void VirtNic::shmemTriggeredPut( int node, Hermes::Vaddr dest, Hermes::Vaddr src, size_t len,
+            Hermes::Vaddr counter, Hermes::Value& threshold )
+{
+    m_dbg.debug(CALL_INFO,2,0,"\n");
+    sendCmd(0, new NicShmemTriggerCmdEvent( counter, threshold,
+                new NicShmemPutCmdEvent( calcCoreId(node), calcRealNicId(node), dest, src, len, [](){} ) ) );
+}
+
 void VirtNic::shmemPutv( int node, Hermes::Vaddr dest, Hermes::Value& value )
 {
     m_dbg.debug(CALL_INFO,2,0,"\n");
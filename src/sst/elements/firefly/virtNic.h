@@ -195,6 +195,7 @@ class VirtNic : public SST::SubComponent {
     void shmemCswap( int node, Hermes::Vaddr dest, Hermes::Value& cond, Hermes::Value& value, CallbackV );
     void shmemAdd( int node, Hermes::Vaddr dest, Hermes::Value& );
     void shmemFadd( int node, Hermes::Vaddr dest, Hermes::Value&, CallbackV );
+    void shmemTriggeredPut( int node, Hermes::Vaddr dest, Hermes::Vaddr src, size_t len, Hermes::Vaddr counter, Hermes::Value& threshold );
 
     void setNotifyOnRecvDmaDone(
         VirtNic::HandlerBase4Args<int,int,size_t,void*>* functor);
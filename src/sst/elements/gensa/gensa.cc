@@ -16,6 +16,7 @@
 #include <sst_config.h>
 #include "gensa.h"
 
+#include <algorithm>
 #include <fstream>
 
 #include <sst/core/params.h>
@@ -38,6 +39,9 @@ gensa::gensa (ComponentId_t id, Params & params)
     syncSent       = false;
     numFirings     = 0;
     numDeliveries  = 0;
+    numUpdates     = 0;
+    currentNeuron  = -1;
+    maxDelay       = 0;
 
     uint32_t outputLevel = params.find<uint32_t> ("verbose", 0);
     out.init ("gensa:@p:@l: ", outputLevel, 0, Output::STDOUT);
@@ -47,6 +51,7 @@ gensa::gensa (ComponentId_t id, Params & params)
     steps           = params.find<int>   ("steps",           1000);
     Neuron::dt      = params.find<float> ("dt",              1);  // In seconds. Don't bother with UnitAlgebra because this is usually specified by wrapper script.
     maxRequestDepth = params.find<int>   ("maxRequestDepth", 2);
+    eventDriven     = params.find<bool>  ("eventDriven",     false);
 
     //set our clock
     string clockFreq = params.find<string> ("clock", "1GHz");
@@ -250,6 +255,7 @@ gensa::init (unsigned int phase)
             float weight = atof(piece);
             piece = strtok(0, ",");
             int delay = atoi(piece);
+            if (delay > (int) maxDelay) maxDelay = delay;
 
             if (n->synapseBase == 0)
             {
@@ -271,6 +277,16 @@ gensa::init (unsigned int phase)
 
     int numNeurons = neurons.size ();
     printf("Constructed %d neurons with %d links\n", numNeurons, countLinks);
+
+    if (eventDriven) {
+        deliveries.resize (maxDelay + 1);
+        input   .resize (numNeurons, 0);
+        hasInput.resize (numNeurons, 0);
+        queued  .resize (numNeurons, 0);
+        for (int i = 0; i < numNeurons; i++) {
+            if (neurons[i]) wakes.push (wake_t (0, i));  // Every neuron gets its first update
+        }
+    }
 }
 
 void
@@ -278,6 +294,7 @@ gensa::setup ()
 {
 	memory->setup ();
 	link->setup ();
+    if (eventDriven) beginStep ();
 }
 
 void
@@ -296,6 +313,43 @@ gensa::finish ()
 
 	printf ("Completed %d neuron firings\n", numFirings);
     printf ("Completed %d spike deliveries\n", numDeliveries);
+    if (eventDriven) printf ("Completed %d neuron updates\n", numUpdates);
+}
+
+// In event-driven mode only neurons that have input this step, or that asked to be woken
+// (over threshold, probed, or an input neuron with a scheduled spike), are updated.
+// Spikes wait in a ring of per-step buckets rather than in each neuron's temporal buffer.
+void
+gensa::beginStep ()
+{
+    active.clear ();
+
+    vector<Delivery> & bucket = deliveries[now % deliveries.size ()];
+    for (auto & d : bucket) {
+        if (! queued[d.target]) {
+            queued[d.target] = 1;
+            active.push_back (d.target);
+        }
+        if (! hasInput[d.target]) {
+            hasInput[d.target] = 1;
+            input[d.target]    = 0;
+        }
+        input[d.target] += d.weight;
+    }
+    bucket.clear ();
+
+    while (! wakes.empty ()  &&  wakes.top ().first <= now) {
+        uint32_t id = wakes.top ().second;
+        wakes.pop ();
+        if (! queued[id]) {
+            queued[id] = 1;
+            active.push_back (id);
+        }
+    }
+
+    // Same processing order as stepping through every neuron
+    sort (active.begin (), active.end ());
+    for (auto id : active) queued[id] = 0;
 }
 
 // We simulate a von Nuemann style neuromorphic processor, working through our list of nuerons serially.
@@ -316,7 +370,7 @@ gensa::clockTic (Cycle_t t)
 
     if (synapseIndex < 0)  // Ready for next neuron.
     {
-        int count = neurons.size ();
+        int count = eventDriven ? active.size () : neurons.size ();
         if (neuronIndex >= count)  // Waiting for sync
         {
             if (syncSent) return false;
@@ -338,8 +392,22 @@ gensa::clockTic (Cycle_t t)
         neuronIndex++;
         if (neuronIndex < count)
         {
-            Neuron * n = neurons[neuronIndex];
-            if (n->update (now))
+            currentNeuron = eventDriven ? active[neuronIndex] : neuronIndex;
+            Neuron * n = neurons[currentNeuron];
+            bool fired;
+            if (eventDriven)
+            {
+                fired = n->updateEvent (now, hasInput[currentNeuron] ? &input[currentNeuron] : nullptr);
+                hasInput[currentNeuron] = 0;
+                numUpdates++;
+                uint32_t wake = n->nextWake (now);
+                if (wake < steps) wakes.push (wake_t (wake, currentNeuron));
+            }
+            else
+            {
+                fired = n->update (now);
+            }
+            if (fired)
             {
                 numFirings++;
                 if (n->synapseCount) synapseIndex = 0;  // Start iterating through synapses.
@@ -352,7 +420,7 @@ gensa::clockTic (Cycle_t t)
         if (networkRequests.size () >= maxRequestDepth) return false;
         if (memoryRequests.size () >= maxRequestDepth) return false;
 
-        Neuron * n = neurons[neuronIndex];
+        Neuron * n = neurons[currentNeuron];
         uint64_t address = n->synapseBase + synapseIndex * sizeof (Synapse);
         StandardMem::Read * req = new StandardMem::Read (address, sizeof (Synapse));
         memory->send (req);  // Unlike network, it seems that memory has unlimited capacity for requests.
@@ -397,13 +465,23 @@ gensa::handleNetwork (int vn)
         if (SpikeEvent * spike = dynamic_cast<SpikeEvent *> (event))
         {
             if (spike->neuron >= neurons.size ()) out.fatal (CALL_INFO, -1, "Invalid Neuron Address\n");
-            neurons[spike->neuron]->deliverSpike (spike->weight, spike->delay+now);
+            if (eventDriven)
+            {
+                if (spike->delay > maxDelay) out.fatal (CALL_INFO, -1, "Spike delay %" PRIu16 " exceeds the largest delay in the model\n", spike->delay);
+                uint32_t when = max<uint32_t> (spike->delay + now, now + 1);  // The current step's bucket has already been collected
+                deliveries[when % deliveries.size ()].push_back ({spike->neuron, spike->weight});
+            }
+            else
+            {
+                neurons[spike->neuron]->deliverSpike (spike->weight, spike->delay+now);
+            }
             numDeliveries++;
         }
         else if (SyncEvent * sync = dynamic_cast<SyncEvent *> (event))
         {
             now++;
             neuronIndex = -1;
+            if (eventDriven) beginStep ();
             if (now >= steps) primaryComponentOKToEndSim ();
         }
         delete req;
@@ -23,6 +23,7 @@
 #include <inttypes.h>
 #include <vector>
 #include <queue>
+#include <functional>
 
 #include <sst/core/event.h>
 #include <sst/core/sst_types.h>
@@ -51,7 +52,8 @@ public:
         {"clock",          "(string) Clock frequency",                                           "1GHz"},
         {"modelPath",      "(string) Path to neuron file",                                       "model"},
         {"steps",          "(uint) how many ticks the simulation should last",                   "1000"},
-        {"dt",             "(float) duration of one tick in sim time; used for output",          "1"}
+        {"dt",             "(float) duration of one tick in sim time; used for output",          "1"},
+        {"eventDriven",    "(bool) only update neurons with input or pending activity each step; spikes with delay 0 arrive next step", "0"}
     )
 
     SST_ELI_DOCUMENT_PORTS( {"mem_link", "Connection to memory", { "memHierarchy.MemEventBase" } } )
@@ -73,9 +75,26 @@ public:
     int         synapseIndex;    ///< Current downstream synapse (associated with current neuron) being sent a spike
     bool        syncSent;
     uint32_t    maxRequestDepth; ///< Shared by memory and network. Should be a pretty small number like 2 or 3.
+    int         currentNeuron;   ///< Neuron whose synapses are being sent
 
     std::vector<Neuron*> neurons;
 
+    // Event-driven mode
+    struct Delivery {
+        uint32_t target;
+        float    weight;
+    };
+    typedef std::pair<uint32_t,uint32_t> wake_t;  ///< step, neuron
+    bool                               eventDriven;
+    uint32_t                           maxDelay;      ///< Largest synapse delay in the model
+    uint32_t                           numUpdates;    ///< Statistics
+    std::vector<std::vector<Delivery>> deliveries;    ///< Ring of maxDelay+1 buckets, one per step
+    std::vector<uint32_t>              active;        ///< Neurons to update this step, in index order
+    std::vector<float>                 input;         ///< Summed input of each active neuron
+    std::vector<char>                  hasInput;
+    std::vector<char>                  queued;
+    std::priority_queue<wake_t, std::vector<wake_t>, std::greater<wake_t>> wakes;
+
     TimeConverter *             clockTC;
     Interfaces::StandardMem *   memory;
     Interfaces::SimpleNetwork * link;
@@ -96,6 +115,7 @@ public:
 
     virtual bool clockTic (SST::Cycle_t);
     void send ();  ///< Try to send next network request in queue.
+    void beginStep ();  ///< Event-driven mode: collect the neurons to update in the current step.
     void handleMemory (SST::Interfaces::StandardMem::Request * req);
     bool handleNetwork (int vn);
 };
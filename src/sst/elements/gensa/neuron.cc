@@ -17,6 +17,8 @@
 #include <sst_config.h>
 #include "neuron.h"
 
+#include <algorithm>
+
 using namespace SST::gensaComponent;
 using namespace std;
 
@@ -61,6 +63,16 @@ void Neuron::deliverSpike(float str, uint when)
     // Do nothing
 }
 
+bool Neuron::updateEvent(const uint32_t now, const float * input)
+{
+    return update(now);
+}
+
+uint32_t Neuron::nextWake(const uint32_t now)
+{
+    return std::numeric_limits<uint32_t>::max();
+}
+
 
 // NeuronLIF -----------------------------------------------------------------
 
@@ -71,7 +83,8 @@ NeuronLIF::NeuronLIF(float Vinit, float Vthreshold, float Vreset, float leak, fl
     Vthreshold (Vthreshold),
     Vreset     (Vreset),
     leak       (leak),
-    p          (p)
+    p          (p),
+    lastUpdate (0)
 {
 }
 
@@ -89,6 +102,36 @@ bool NeuronLIF::update(const uint now)
         temporalBuffer.erase(i);
     }
 
+    return fire(now);
+}
+
+bool NeuronLIF::updateEvent(const uint now, const float * input)
+{
+    // Apply the leak of the steps we were skipped. nextWake() only lets us
+    // idle while V stays at or below threshold, so those steps only leaked.
+    for (uint step = lastUpdate + 1; step < now  &&  V != 0  &&  leak != 1; step++) V *= leak;
+
+    if (input) V += *input;
+    return fire(now);
+}
+
+uint32_t NeuronLIF::nextWake(const uint now)
+{
+    // Over threshold (possibly firing with p < 1), or probed every step
+    if (V > Vthreshold) return now + 1;
+    for (Trace * t = traces; t; t = t->next) {
+        if (t->probe == 1) return now + 1;
+    }
+
+    // Otherwise we may idle while leak can only take V toward 0 and 0 is not over threshold
+    if (V == 0  ||  leak == 1  ||  (leak >= 0  &&  leak < 1  &&  Vthreshold >= 0)) return std::numeric_limits<uint32_t>::max();
+    return now + 1;
+}
+
+bool NeuronLIF::fire(const uint now)
+{
+    lastUpdate = now;
+
     // Check for spike
     bool spiked = false;
     if (V > Vthreshold) {
@@ -138,6 +181,12 @@ bool NeuronInput::update(const uint now)
     return true;
 }
 
+uint32_t NeuronInput::nextWake(const uint now)
+{
+    if (nextSpike >= spikes.size()) return std::numeric_limits<uint32_t>::max();
+    return std::max<uint32_t>(spikes[nextSpike], now + 1);
+}
+
 
 // class SpikeEvent ----------------------------------------------------------
 
@@ -17,6 +17,7 @@
 #define _NEURON_H
 
 #include <map>
+#include <limits>
 #include <cstdint>
 
 #include <sst/core/interfaces/stdMem.h>  // supplies type uint
@@ -57,8 +58,10 @@ public:
     Neuron();
     virtual ~Neuron();
 
-    virtual void deliverSpike(float str, uint32_t when);
-    virtual bool update      (const uint32_t now) = 0;  ///< performs Leaky Integrate and Fire. Returns true if fired.
+    virtual void     deliverSpike(float str, uint32_t when);
+    virtual bool     update      (const uint32_t now) = 0;  ///< performs Leaky Integrate and Fire. Returns true if fired.
+    virtual bool     updateEvent (const uint32_t now, const float * input);  ///< Event-driven form of update(). input is the sum of spikes arriving now, or null if none.
+    virtual uint32_t nextWake    (const uint32_t now);  ///< Earliest step after now that needs an update even without input. UINT32_MAX if none.
 };
 
 class NeuronLIF : public Neuron {
@@ -68,6 +71,7 @@ public:
     float Vreset;     // value of V immediately after a spike
     float leak;       // fraction of V to retain after present cycle, in [0,1]
     float p;          // probability of firing when over threshold, in [0,1]
+    uint32_t lastUpdate; // step of the most recent update, for catching up on leak in event-driven mode
 
     static SST::RNG::MarsagliaRNG rng;
 
@@ -77,8 +81,13 @@ public:
 
     NeuronLIF (float Vinit = 0, float Vthreshold = 1, float Vreset = 0, float leak = 1, float p = 1);
 
-    virtual void deliverSpike(float str, uint32_t when);
-    virtual bool update      (const uint32_t now);
+    virtual void     deliverSpike(float str, uint32_t when);
+    virtual bool     update      (const uint32_t now);
+    virtual bool     updateEvent (const uint32_t now, const float * input);
+    virtual uint32_t nextWake    (const uint32_t now);
+
+protected:
+    bool fire (const uint32_t now);  ///< Threshold, leak and outputs, once inputs are added to V
 };
 
 class NeuronInput : public Neuron {
@@ -88,7 +97,8 @@ public:
 
     NeuronInput();
 
-    virtual bool update(const uint32_t now);
+    virtual bool     update  (const uint32_t now);
+    virtual uint32_t nextWake(const uint32_t now);
 };
 
 class SpikeEvent : public SST::Event
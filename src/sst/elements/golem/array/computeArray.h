@@ -92,6 +92,7 @@ public:
     virtual void setVectorItem(int32_t arrayID, int32_t index, double value) = 0;
     virtual void compute(uint32_t arrayID) = 0;
     virtual void moveOutputToInput(uint32_t srcArrayID, uint32_t destArrayID) = 0;
+    // Contiguous arrayInputSize/arrayOutputSize values of the array's type
     virtual void* getInputVector(uint32_t arrayID) = 0;
     virtual void* getOutputVector(uint32_t arrayID) = 0;
 
@@ -21,6 +21,7 @@
 #include <sst/elements/golem/array/computeArray.h>
 #include <Python.h>
 #include "numpy/arrayobject.h"
+#include <algorithm>
 #include <string>
 #include <type_traits>
 #include <iostream>
@@ -65,25 +66,30 @@ public:
         cores = new PyObject*[numArrays];
         setMatrixFunction = new PyObject*[numArrays];
         computeMVM = new PyObject*[numArrays];
-
-        // Initialize input/output vector storage
-        inputVectors.resize(numArrays);
-        outputVectors.resize(numArrays);
-        for (uint32_t i = 0; i < numArrays; i++) {
-            inputVectors[i].resize(inputArraySize, T());
-            outputVectors[i].resize(outputArraySize, T());
-        }
+        computeMVMArgs = new PyObject*[numArrays];
     }
 
     virtual ~CrossSimComputeArray() {
-        // Decrement references to Python objects
-        for (uint32_t i = 0; i < numArrays; i++) {
-            Py_DECREF(pyMatrix[i]);
-            Py_DECREF(pyArrayIn[i]);
-            Py_DECREF(pyArrayOut[i]);
-            Py_DECREF(cores[i]);
-            Py_DECREF(setMatrixFunction[i]);
-            Py_DECREF(computeMVM[i]);
+        {
+            // Decrement references to Python objects
+            PythonLock lock;
+            for (uint32_t i = 0; i < numArrays; i++) {
+                Py_DECREF(pyMatrix[i]);
+                Py_DECREF(pyArrayIn[i]);
+                Py_DECREF(pyArrayOut[i]);
+                Py_DECREF(cores[i]);
+                Py_DECREF(setMatrixFunction[i]);
+                Py_DECREF(computeMVM[i]);
+                Py_DECREF(computeMVMArgs[i]);
+            }
+            Py_DECREF(pyInputBlock);
+            Py_DECREF(pyOutputBlock);
+
+            // Decrement other references
+            Py_DECREF(crossSim);
+            Py_DECREF(paramsConstructor);
+            Py_DECREF(AnalogCoreConstructor);
+            Py_DECREF(crossSim_params);
         }
 
         // Free our arrays
@@ -96,17 +102,14 @@ public:
         delete[] cores;
         delete[] setMatrixFunction;
         delete[] computeMVM;
+        delete[] computeMVMArgs;
 
-        // Decrement other references
-        Py_DECREF(crossSim);
-        Py_DECREF(paramsConstructor);
-        Py_DECREF(AnalogCoreConstructor);
-        Py_DECREF(crossSim_params);
         finalizePython();
     }
 
     virtual void init(unsigned int phase) override {
         if (phase == 0) {
+            PythonLock lock;
             uint64_t inputSize = inputArraySize;
             uint64_t outputSize = outputArraySize;
 
@@ -117,24 +120,34 @@ public:
                 static_cast<npy_intp>(inputSize)
             };
 
-            int arrayInNumDims = 1;
-            npy_intp arrayInDim[1] = { static_cast<npy_intp>(inputSize) };
-
-            int arrayOutNumDims = 1;
-            npy_intp arrayOutDim[1] = { static_cast<npy_intp>(outputSize) };
-
             int numpyType = getNumpyType();
 
+            // Inputs and outputs of all arrays are rows of two contiguous blocks,
+            // allocated once; each array sees its row as a 1D NumPy view
+            npy_intp inputBlockDims[2] = {
+                static_cast<npy_intp>(numArrays),
+                static_cast<npy_intp>(inputSize)
+            };
+            npy_intp outputBlockDims[2] = {
+                static_cast<npy_intp>(numArrays),
+                static_cast<npy_intp>(outputSize)
+            };
+            pyInputBlock = PyArray_ZEROS(2, inputBlockDims, numpyType, 0);
+            pyOutputBlock = PyArray_ZEROS(2, outputBlockDims, numpyType, 0);
+
             // Create Numpy arrays
             for (uint32_t i = 0; i < numArrays; i++) {
                 pyMatrix[i] = PyArray_SimpleNew(matrixNumDims, matrixDims, numpyType);
                 npMatrix[i] = reinterpret_cast<PyArrayObject*>(pyMatrix[i]);
 
-                pyArrayIn[i] = PyArray_SimpleNew(arrayInNumDims, arrayInDim, numpyType);
+                pyArrayIn[i] = createRowView(pyInputBlock, i, inputSize, numpyType);
                 npArrayIn[i] = reinterpret_cast<PyArrayObject*>(pyArrayIn[i]);
 
-                pyArrayOut[i] = PyArray_SimpleNew(arrayOutNumDims, arrayOutDim, numpyType);
+                pyArrayOut[i] = createRowView(pyOutputBlock, i, outputSize, numpyType);
                 npArrayOut[i] = reinterpret_cast<PyArrayObject*>(pyArrayOut[i]);
+
+                // matvec always takes the same input view, build its argument tuple once
+                computeMVMArgs[i] = PyTuple_Pack(1, pyArrayIn[i]);
             }
 
             // Import CrossSim (simulator.py) module
@@ -234,13 +247,15 @@ public:
 
         // Once matrix is fully populated, call "set_matrix"
         if (index == inputArraySize * outputArraySize - 1) {
+            PythonLock lock;
             PyObject* status = PyObject_CallFunctionObjArgs(setMatrixFunction[arrayID],
                                                             npMatrix[arrayID],
                                                             NULL);
             if (!status) {
-                out.fatal(CALL_INFO, -1, "Call to core.set_matrix failed\n");
                 PyErr_Print();
+                out.fatal(CALL_INFO, -1, "Call to core.set_matrix failed\n");
             }
+            Py_DECREF(status);
         }
     }
 
@@ -250,21 +265,26 @@ public:
     }
 
     virtual void compute(uint32_t arrayID) override {
-        // Perform the MVM
-        pyArrayOut[arrayID] = PyObject_CallFunctionObjArgs(computeMVM[arrayID],
-                                                           npArrayIn[arrayID],
-                                                           NULL);
-        if (!pyArrayOut[arrayID]) {
-            out.fatal(CALL_INFO, -1, "Run MVM Call Failed\n");
-            PyErr_Print();
+        T* resultData = getOutput(arrayID);
+        {
+            // Perform the MVM and copy the result into the array's output row;
+            // the GIL is only held for the call and the copy
+            PythonLock lock;
+            PyObject* result = PyObject_Call(computeMVM[arrayID], computeMVMArgs[arrayID], NULL);
+            if (!result) {
+                PyErr_Print();
+                out.fatal(CALL_INFO, -1, "Run MVM Call Failed\n");
+            }
+            PyArrayObject* npResult = reinterpret_cast<PyArrayObject*>(result);
+            uint64_t len = std::min<uint64_t>(PyArray_SIZE(npResult), outputArraySize);
+            T* data = reinterpret_cast<T*>(PyArray_DATA(npResult));
+            std::copy(data, data + len, resultData);
+            Py_DECREF(result);
         }
-        npArrayOut[arrayID] = reinterpret_cast<PyArrayObject*>(pyArrayOut[arrayID]);
 
-        // Copy output for later retrieval
-        int len = PyArray_SIZE(npArrayOut[arrayID]);
-        outputVectors[arrayID].resize(len);
-        T* outputData = reinterpret_cast<T*>(PyArray_DATA(npArrayOut[arrayID]));
-        std::copy(outputData, outputData + len, outputVectors[arrayID].begin());
+        if (out.getVerboseLevel() < 2) {
+            return;
+        }
 
         // Optional debug printing
         out.verbose(CALL_INFO, 2, 0, "CrossSim MVM on array %u:\n", arrayID);
@@ -283,7 +303,7 @@ public:
                 printValue(matrixData[row * inputArraySize + col]);
             }
             out.verbose(CALL_INFO, 2, 0, "  ");
-            printValue(outputData[row]);
+            printValue(resultData[row]);
             out.verbose(CALL_INFO, 2, 0, "\n");
         }
         out.verbose(CALL_INFO, 2, 0, "\n\n");
@@ -294,22 +314,17 @@ public:
     }
 
     virtual void moveOutputToInput(uint32_t srcArrayID, uint32_t destArrayID) override {
-        T* src = reinterpret_cast<T*>(PyArray_DATA(npArrayOut[srcArrayID]));
+        T* src = getOutput(srcArrayID);
         T* dst = reinterpret_cast<T*>(PyArray_DATA(npArrayIn[destArrayID]));
         std::copy(src, src + outputArraySize, dst);
     }
 
     virtual void* getInputVector(uint32_t arrayID) override {
-        // Convert NumPy array data to std::vector (if needed)
-        T* data = reinterpret_cast<T*>(PyArray_DATA(npArrayIn[arrayID]));
-        int len = PyArray_SIZE(npArrayIn[arrayID]);
-        inputVectors[arrayID].resize(len);
-        std::copy(data, data + len, inputVectors[arrayID].begin());
-        return static_cast<void*>(&inputVectors[arrayID]);
+        return PyArray_DATA(npArrayIn[arrayID]);
     }
 
     virtual void* getOutputVector(uint32_t arrayID) override {
-        return static_cast<void*>(&outputVectors[arrayID]);
+        return static_cast<void*>(getOutput(arrayID));
     }
 
 protected:
@@ -320,6 +335,8 @@ protected:
     PyObject* paramsConstructor   = nullptr;
     PyObject* AnalogCoreConstructor = nullptr;
     PyObject* crossSim_params     = nullptr;
+    PyObject* pyInputBlock        = nullptr;
+    PyObject* pyOutputBlock       = nullptr;
 
     // Arrays of references
     PyObject** pyMatrix          = nullptr;
@@ -331,10 +348,19 @@ protected:
     PyObject** cores             = nullptr;
     PyObject** setMatrixFunction = nullptr;
     PyObject** computeMVM        = nullptr;
-
-    // Local copy of input/output
-    std::vector<std::vector<T>> inputVectors;
-    std::vector<std::vector<T>> outputVectors;
+    PyObject** computeMVMArgs    = nullptr;
+
+    T* getOutput(uint32_t arrayID) { return reinterpret_cast<T*>(PyArray_DATA(npArrayOut[arrayID])); }
+
+    // 1D view of row 'row' of a contiguous 2D block, keeping the block alive
+    PyObject* createRowView(PyObject* block, uint32_t row, uint64_t length, int numpyType) {
+        npy_intp dim[1] = { static_cast<npy_intp>(length) };
+        T* data = reinterpret_cast<T*>(PyArray_DATA(reinterpret_cast<PyArrayObject*>(block))) + row * length;
+        PyObject* view = PyArray_SimpleNewFromData(1, dim, numpyType, data);
+        Py_INCREF(block);
+        PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(view), block);
+        return view;
+    }
 
     int getNumpyType() {
         if constexpr (std::is_same<T, int64_t>::value) {
@@ -357,6 +383,14 @@ protected:
 
 private:
 
+    // Holds the GIL for its scope; Python is otherwise released so that
+    // arrays on other threads are not serialized behind an idle interpreter
+    struct PythonLock {
+        PyGILState_STATE state;
+        PythonLock() : state(PyGILState_Ensure()) {}
+        ~PythonLock() { PyGILState_Release(state); }
+    };
+
     static std::atomic<int>& getInstanceCount() {
         static std::atomic<int> count{0};
         return count;
@@ -370,7 +404,14 @@ private:
     // This function is called only once, by the first instance constructed.
     static void doPythonInitialization() {
         Py_Initialize();
-        import_array1();  // NumPy C-API init
+        importNumpy();
+        // Drop the GIL taken by Py_Initialize, PythonLock reacquires it per call
+        PyEval_SaveThread();
+    }
+
+    static int importNumpy() {
+        import_array1(-1);  // NumPy C-API init
+        return 0;
     }
 
     // Called in the constructor.
@@ -384,6 +425,7 @@ private:
     void finalizePython() {
         // Decrease instance count.
         if (--getInstanceCount() == 0) {
+            PyGILState_Ensure();
             Py_Finalize();
         }
     }
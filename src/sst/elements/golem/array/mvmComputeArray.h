@@ -17,6 +17,7 @@
 #define _MVMCOMPUTEARRAY_H
 
 #include <sst/elements/golem/array/computeArray.h>
+#include <algorithm>
 #include <type_traits>
 
 namespace SST {
@@ -40,15 +41,11 @@ public:
         selfLink = configureSelfLink("Self", *tc, new Event::Handler2<MVMComputeArray,&MVMComputeArray::handleSelfEvent>(this));
         selfLink->setDefaultTimeBase(*latencyTC);
 
-        // Initialize vectors
-        inputVectors.resize(numArrays);
-        outputVectors.resize(numArrays);
-        matrixData.resize(numArrays);
-        for (uint32_t i = 0; i < numArrays; i++) {
-            inputVectors[i].resize(inputArraySize, T());
-            outputVectors[i].resize(outputArraySize, T());
-            matrixData[i].resize(inputArraySize * outputArraySize, T());
-        }
+        // One contiguous tile per array, the matrix is kept column-major
+        // so each column scales into the output vector with unit stride
+        inputData.resize(numArrays * inputArraySize, T());
+        outputData.resize(numArrays * outputArraySize, T());
+        matrixData.resize(numArrays * inputArraySize * outputArraySize, T());
     }
 
     virtual void beginComputation(uint32_t arrayID) override {
@@ -67,23 +64,31 @@ public:
     }
 
     virtual void setMatrixItem(int32_t arrayID, int32_t index, double value) override {
-        matrixData[arrayID][index] = static_cast<T>(value);
+        // index is row-major, as the matrix is laid out in memory
+        uint64_t row = index / inputArraySize;
+        uint64_t col = index % inputArraySize;
+        getMatrix(arrayID)[col * outputArraySize + row] = static_cast<T>(value);
     }
 
     virtual void setVectorItem(int32_t arrayID, int32_t index, double value) override {
-        inputVectors[arrayID][index] = static_cast<T>(value);
+        getInput(arrayID)[index] = static_cast<T>(value);
     }
 
     virtual void compute(uint32_t arrayID) override {
-        auto& inputVector = inputVectors[arrayID];
-        auto& outputVector = outputVectors[arrayID];
-        auto& matrix = matrixData[arrayID];
-
-        // Ensure output vector is correctly sized
-        outputVector.resize(outputArraySize);
+        const T* inputVector = getInput(arrayID);
+        const T* matrix = getMatrix(arrayID);
+        T* outputVector = getOutput(arrayID);
+
+        // Every row accumulates in column order, as a row by row dot product
+        // would, but the inner loop is unit stride and vectorizes
+        std::fill(outputVector, outputVector + outputArraySize, T());
+        for (uint64_t col = 0; col < inputArraySize; col++) {
+            mvmColumn(outputVector, matrix + col * outputArraySize, inputVector[col], outputArraySize);
+        }
 
-        // Initialize output vector to zero
-        std::fill(outputVector.begin(), outputVector.end(), T());
+        if (out.getVerboseLevel() < 2) {
+            return;
+        }
 
         // Print input vector
         out.verbose(CALL_INFO, 2, 0, "MVM for array %u:\n\n", arrayID);
@@ -92,11 +97,9 @@ public:
         }
         out.verbose(CALL_INFO, 2, 0, "\n\n");
 
-        // Perform matrix-vector multiplication
         for (uint32_t row = 0; row < outputArraySize; row++) {
             for (uint32_t col = 0; col < inputArraySize; col++) {
-                outputVector[row] += matrix[row * inputArraySize + col] * inputVector[col];
-                printValue(matrix[row * inputArraySize + col]);
+                printValue(matrix[col * outputArraySize + row]);
             }
             out.verbose(CALL_INFO, 2, 0, "  ");
             printValue(outputVector[row]);
@@ -110,21 +113,32 @@ public:
     }
 
     virtual void moveOutputToInput(uint32_t srcArrayID, uint32_t destArrayID) override {
-        std::copy(outputVectors[srcArrayID].begin(), outputVectors[srcArrayID].end(), inputVectors[destArrayID].begin());
+        const T* src = getOutput(srcArrayID);
+        std::copy(src, src + std::min(inputArraySize, outputArraySize), getInput(destArrayID));
     }
 
     virtual void* getInputVector(uint32_t arrayID) override {
-        return static_cast<void*>(&inputVectors[arrayID]);
+        return static_cast<void*>(getInput(arrayID));
     }
 
     virtual void* getOutputVector(uint32_t arrayID) override {
-        return static_cast<void*>(&outputVectors[arrayID]);
+        return static_cast<void*>(getOutput(arrayID));
     }
 
 protected:
-    std::vector<std::vector<T>> inputVectors;
-    std::vector<std::vector<T>> outputVectors;
-    std::vector<std::vector<T>> matrixData;
+    std::vector<T> inputData;
+    std::vector<T> outputData;
+    std::vector<T> matrixData;
+
+    T* getInput(uint32_t arrayID) { return &inputData[arrayID * inputArraySize]; }
+    T* getOutput(uint32_t arrayID) { return &outputData[arrayID * outputArraySize]; }
+    T* getMatrix(uint32_t arrayID) { return &matrixData[arrayID * inputArraySize * outputArraySize]; }
+
+    static void mvmColumn(T* __restrict__ output, const T* __restrict__ column, T value, uint64_t rows) {
+        for (uint64_t row = 0; row < rows; row++) {
+            output[row] += column[row] * value;
+        }
+    }
 
     void printValue(const T& value) {
         if constexpr (std::is_same<T, int64_t>::value) {
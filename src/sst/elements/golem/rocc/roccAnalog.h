@@ -266,7 +266,7 @@ public:
         outputPayload.resize(vector_total_size);
 
         // Reference to the output vector we need to store
-        auto& outputVector = *static_cast<std::vector<T>*>(array->getOutputVector(rs2));
+        const T* outputVector = static_cast<T*>(array->getOutputVector(rs2));
 
         // Fill the output payload with the vector data
         for (size_t i = 0; i < static_cast<size_t>(arrayOutputSize); i++) {
@@ -315,7 +315,7 @@ public:
         uint64_t rs2 = curr_cmd->rs2;
         array->moveOutputToInput(rs1, rs2);
 
-        auto& inputVector = *static_cast<std::vector<T>*>(array->getInputVector(rs2));
+        const T* inputVector = static_cast<T*>(array->getInputVector(rs2));
 
         output->verbose(CALL_INFO, 9, 0,
                       "Moved array %" PRIu64 " to array %" PRIu64 ". Array %" PRIu64 ":\n", rs1, rs2, rs2);
@@ -340,7 +340,7 @@ public:
 
         roccCmd_q.pop_front();
         busy = false;
-        curr_resp = new SST::Vanadis::RoCCResponse(curr_cmd->inst->rd, rd_val);
+        curr_resp = new SST::Vanadis::RoCCResponse(curr_cmd->inst->rd, rd_val, curr_cmd->tag);
         delete curr_cmd;
         curr_cmd = nullptr;
     }
@@ -95,4 +95,39 @@ class ArgStatic_Functor : public Arg_FunctorBase< TArg1, TRetval >
     virtual ~ArgStatic_Functor() {}
 };
 
+// Owned by the caller and reused for every call instead of being allocated
+// per call. operator() always returns false so the callee never deletes it.
+// Only one call can hold it at a time, bind() it before handing it out.
+template <class TClass, class TArg1, class TArg2, class TRetval = bool >
+class Reusable_ArgStatic_Functor : public Arg_FunctorBase< TArg1, bool >
+{
+  private:
+    TClass* m_obj;
+    TRetval ( TClass::*m_fptr )( TArg1, TArg2 );
+    TArg2 m_arg2;
+    bool m_busy;
+
+  public:
+    Reusable_ArgStatic_Functor( TClass* obj, TRetval ( TClass::*fptr )( TArg1, TArg2 ) ):
+        m_obj( obj ),
+        m_fptr( fptr ),
+        m_busy( false )
+    { }
+    Reusable_ArgStatic_Functor() : m_obj( nullptr ), m_fptr( nullptr ), m_busy( false ) {}
+
+    bool busy() { return m_busy; }
+
+    void bind( TArg2 arg ) {
+        m_arg2 = arg;
+        m_busy = true;
+    }
+
+    virtual bool operator()( TArg1 arg ) {
+        m_busy = false;
+        (*m_obj.*m_fptr)(arg, m_arg2 );
+        return false;
+    }
+    virtual ~Reusable_ArgStatic_Functor() {}
+};
+
 #endif
@@ -370,6 +370,14 @@ class NodePerf : public Module {
     virtual double getBandwidth() { assert(0); }
     virtual double calcTimeNS_flops( int instructions ) { assert(0); }
     virtual double calcTimeNS_bandwidth( int bytes ) { assert(0); }
+
+    // time for a kernel doing flops and moving bytes with a working set of
+    // workingSet bytes, by default the slower of compute and memory
+    virtual double calcTimeNS_roofline( double flops, double bytes, double workingSet ) {
+        double flopTime = flops / getFlops();
+        double byteTime = bytes / getBandwidth();
+        return ( flopTime > byteTime ? flopTime : byteTime ) * 1000 * 1000 * 1000;
+    }
 };
 
 class OS : public SubComponent {
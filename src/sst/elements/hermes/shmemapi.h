@@ -96,6 +96,10 @@ class Interface : public Hermes::Interface {
     virtual void fadd( Value& result, Vaddr, Value&, int pe, Callback) { assert(0); }
     virtual void add( Vaddr, Value&, int pe, Callback) { assert(0); }
 
+    // post a put that the NIC starts once the local counter is at least
+    // threshold, returns once it is posted and quiet() waits for it once started
+    virtual void triggered_put( Vaddr dest, Vaddr src, size_t nelems, int pe, Vaddr counter, Value& threshold, Callback) { assert(0); }
+
     virtual void fam_get( Hermes::Vaddr dest, Fam_Descriptor fd, uint64_t offset, uint64_t nbytes,
 			bool blocking, Callback &) { assert(0); }
     virtual void fam_put( Fam_Descriptor fd, uint64_t offset, Hermes::Vaddr dest, uint64_t nbytes,
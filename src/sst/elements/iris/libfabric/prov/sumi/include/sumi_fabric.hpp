@@ -94,6 +94,15 @@ class FabricMessage : public SST::Iris::sumi::Message {
     return context_;
   }
 
+  /** Completions of posted receives report the receiver's context and flags */
+  void setContext(void* ctx) {
+    context_ = ctx;
+  }
+
+  void setFlags(uint64_t flags) {
+    flags_ = flags;
+  }
+
  private:
   uint64_t flags_;
   uint64_t imm_data_;
@@ -160,6 +160,7 @@ struct sumi_mem_handle_t {
 #define SUMI_CACHELINE_SIZE (64)
 #define SUMI_INJECT_SIZE 64
 #define SUMI_MAX_INJECT_SIZE 64
+#define SUMI_MIN_MULTI_RECV_DEFAULT 64
 
 #define SUMI_FAB_MODES	0
 
@@ -338,6 +339,7 @@ struct sumi_fid_ep {
 	struct sumi_fid_stx *stx_ctx;
 	struct sumi_fid_eq *eq;
   int qos;
+  size_t min_multi_recv;
 };
 
 struct sumi_fid_sep {
@@ -505,6 +507,8 @@ void _sumi_init(void);
 }
 
 #include <mercury/operating_system/process/progress_queue.h>
+#include <functional>
+#include <list>
 #include <sumi/message.h>
 #include <sumi_fabric.hpp>
 
@@ -527,13 +531,63 @@ struct ErrorDeallocate {
   std::function<void(void*)> dealloc;
 };
 
+/**
+ * An operation posted with FI_TRIGGER, run once its counter reaches the threshold
+ */
+struct TriggeredOp {
+  uint64_t threshold;
+  std::function<void()> op;
+};
+
+struct sumi_fid_cntr {
+  struct fid_cntr cntr_fid;
+  struct sumi_fid_domain *domain;
+  struct fi_cntr_attr attr;
+  uint64_t cnt;
+  uint64_t cnt_err;
+  SST::Hg::ProgressQueue blocker;
+  std::list<SST::Hg::Thread*> waiters;
+  std::list<TriggeredOp> triggers;
+
+  sumi_fid_cntr(SST::Hg::OperatingSystem* os) :
+    domain(nullptr), cnt(0), cnt_err(0), blocker(os)
+  {
+  }
+};
+
+/**
+ * Add to a counter and wake any waiting threads. This is called from
+ * completion handlers, so triggered operations are not started here.
+ */
+void sstmaci_cntr_add(sumi_fid_cntr* cntr, uint64_t value);
+
+/**
+ * Start the triggered operations whose threshold the counter has reached,
+ * must be called from an application thread
+ */
+void sstmaci_cntr_progress(sumi_fid_cntr* cntr);
+
+/**
+ * Run op now if the counter is already at threshold, otherwise when it gets there
+ */
+void sstmaci_cntr_defer(sumi_fid_cntr* cntr, uint64_t threshold, std::function<void()>&& op);
+
 struct RecvQueue {
 
   struct Recv {
     uint32_t size;
     void* buf;
+    //multi-receive buffers take messages until less than min_free is left
+    bool multi;
+    uint32_t offset;
+    uint32_t min_free;
+    void* context;
     Recv(uint32_t s, void* b) :
-      size(s), buf(b)
+      size(s), buf(b), multi(false), offset(0), min_free(0), context(nullptr)
+    {
+    }
+    Recv(uint32_t s, void* b, uint32_t min, void* ctx) :
+      size(s), buf(b), multi(true), offset(0), min_free(min), context(ctx)
     {
     }
   };
@@ -550,7 +604,10 @@ struct RecvQueue {
   };
 
   RecvQueue(SST::Hg::OperatingSystem* os) :
-    progress(os)
+    progress(os),
+    send_cntr(nullptr), recv_cntr(nullptr),
+    write_cntr(nullptr), read_cntr(nullptr),
+    rwrite_cntr(nullptr), rread_cntr(nullptr)
   {
   }
 
@@ -565,8 +622,24 @@ struct RecvQueue {
 
   SST::Hg::SingleProgressQueue<SST::Iris::sumi::Message> progress;
 
+  sumi_fid_cntr* send_cntr;
+  sumi_fid_cntr* recv_cntr;
+  sumi_fid_cntr* write_cntr;
+  sumi_fid_cntr* read_cntr;
+  sumi_fid_cntr* rwrite_cntr;
+  sumi_fid_cntr* rread_cntr;
+
+  void bindCounters(sumi_fid_ep* ep);
+
+  void complete(FabricMessage* fmsg);
+
   void finishMatch(void* buf, uint32_t size, FabricMessage* fmsg);
 
+  /** Match an untagged message to the oldest posted receive */
+  void matchUntaggedRecv(FabricMessage* fmsg);
+
+  void postMultiRecv(uint32_t size, void* buf, uint32_t min_free, void* context);
+
   void matchTaggedRecv(FabricMessage* msg);
 
   void postRecv(uint32_t size, void* buf, uint64_t tag, uint64_t tag_ignore, bool tagged);
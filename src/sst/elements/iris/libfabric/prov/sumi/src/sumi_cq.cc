@@ -116,6 +116,18 @@ static int sumi_cq_close(fid_t fid)
 	return FI_SUCCESS;
 }
 
+//completions only bump the counters, the operations they trigger start from the reading thread
+static void sstmaci_cq_progress_counters(RecvQueue* rq)
+{
+  sumi_fid_cntr* cntrs[] = { rq->send_cntr, rq->recv_cntr, rq->write_cntr,
+                             rq->read_cntr, rq->rwrite_cntr, rq->rread_cntr };
+  for (sumi_fid_cntr* cntr : cntrs){
+    if (cntr){
+      sstmaci_cntr_progress(cntr);
+    }
+  }
+}
+
 static ssize_t sstmaci_cq_read(bool blocking,
                         struct fid_cq *cq, void *buf,
                         size_t count, fi_addr_t *src_addr,
@@ -125,6 +137,7 @@ static ssize_t sstmaci_cq_read(bool blocking,
   FabricTransport* tport = (FabricTransport*) cq_impl->domain->fabric->tport;
   RecvQueue* rq = (RecvQueue*) cq_impl->queue;
 
+  sstmaci_cq_progress_counters(rq);
   size_t done = 0;
   while (done < count){
     double timeout_s = (blocking && timeout > 0) ? timeout*1e-3 : -1;
@@ -136,8 +149,10 @@ static ssize_t sstmaci_cq_read(bool blocking,
       src_addr[done] = msg->sender();
     }
     buf = sstmaci_fill_cq_entry(cq_impl->format, buf, static_cast<FabricMessage*>(msg));
+    rq->progress.pop();
     done++;
   }
+  sstmaci_cq_progress_counters(rq);
   return done ? done : -FI_EAGAIN;
 }
 
@@ -231,6 +246,48 @@ extern "C" DIRECT_FN  int sumi_cq_open(struct fid_domain *domain, struct fi_cq_a
   return FI_SUCCESS;
 }
 
+void RecvQueue::bindCounters(sumi_fid_ep* ep)
+{
+  if (ep->send_cntr) send_cntr = ep->send_cntr;
+  if (ep->recv_cntr) recv_cntr = ep->recv_cntr;
+  if (ep->write_cntr) write_cntr = ep->write_cntr;
+  if (ep->read_cntr) read_cntr = ep->read_cntr;
+  if (ep->rwrite_cntr) rwrite_cntr = ep->rwrite_cntr;
+  if (ep->rread_cntr) rread_cntr = ep->rread_cntr;
+}
+
+void RecvQueue::complete(FabricMessage* msg)
+{
+  sumi_fid_cntr* cntr = nullptr;
+  switch (msg->SST::Hg::NetworkMessage::type()){
+    case SST::Hg::NetworkMessage::posted_send:
+    case SST::Hg::NetworkMessage::smsg_send:
+      cntr = recv_cntr;
+      break;
+    case SST::Hg::NetworkMessage::payload_sent_ack:
+      cntr = send_cntr;
+      break;
+    case SST::Hg::NetworkMessage::rdma_put_sent_ack:
+      cntr = write_cntr;
+      break;
+    case SST::Hg::NetworkMessage::rdma_get_payload:
+      cntr = read_cntr;
+      break;
+    case SST::Hg::NetworkMessage::rdma_put_payload:
+      cntr = rwrite_cntr;
+      break;
+    case SST::Hg::NetworkMessage::rdma_get_sent_ack:
+      cntr = rread_cntr;
+      break;
+    default:
+      break;
+  }
+  progress.incoming(msg);
+  if (cntr){
+    sstmaci_cntr_add(cntr, 1);
+  }
+}
+
 void RecvQueue::finishMatch(void* buf, uint32_t size, FabricMessage *msg)
 {
   //found a match
@@ -238,19 +295,63 @@ void RecvQueue::finishMatch(void* buf, uint32_t size, FabricMessage *msg)
     if (buf && msg->localBuffer()){
       msg->matchRecv(buf);
     }
-    progress.incoming(msg);
+    complete(msg);
   } else {
     delete msg;
   }
 }
 
+void RecvQueue::matchUntaggedRecv(FabricMessage* msg)
+{
+  while (!recvs.empty()){
+    Recv& r = recvs.front();
+    if (!r.multi){
+      Recv posted = r;
+      recvs.pop_front();
+      finishMatch(posted.buf, posted.size, msg);
+      return;
+    }
+
+    if (msg->payloadBytes() > r.size - r.offset){
+      //the sender ignored min_free, retire the buffer and try the next one
+      recvs.pop_front();
+      continue;
+    }
+
+    void* buf = ((char*)r.buf) + r.offset;
+    if (r.buf && msg->localBuffer()){
+      msg->matchRecv(buf);
+    }
+    r.offset += msg->payloadBytes();
+    bool released = r.size - r.offset < r.min_free;
+    msg->setContext(r.context);
+    msg->setFlags((msg->flags() & FI_REMOTE_CQ_DATA) | FI_MSG | FI_RECV
+                  | (released ? FI_MULTI_RECV : 0));
+    if (released){
+      recvs.pop_front();
+    }
+    complete(msg);
+    return;
+  }
+  unexp_recvs.push_back(msg);
+}
+
+void RecvQueue::postMultiRecv(uint32_t size, void* buf, uint32_t min_free, void* context){
+  recvs.emplace_back(size, buf, min_free, context);
+  //unexpected messages only wait when nothing was posted, so they all go to the new buffer
+  while (!unexp_recvs.empty() && !recvs.empty()){
+    FabricMessage* msg = unexp_recvs.front();
+    unexp_recvs.pop_front();
+    matchUntaggedRecv(msg);
+  }
+}
+
 void RecvQueue::matchTaggedRecv(FabricMessage* msg){
   for (auto it = tagged_recvs.begin(); it != tagged_recvs.end(); ++it){
-    auto tmp = it++;
-    TaggedRecv& r = *tmp;
+    TaggedRecv& r = *it;
     if (matches(msg, r.tag, r.tag_ignore)){
       finishMatch(r.buf, r.size, msg);
-      tagged_recvs.erase(tmp);
+      tagged_recvs.erase(it);
       return;
     }
   }
@@ -263,9 +364,9 @@ void RecvQueue::postRecv(uint32_t size, void* buf, uint64_t tag, uint64_t tag_ig
       tagged_recvs.emplace_back(size, buf, tag, tag_ignore);
     } else {
       for (auto it = unexp_tagged_recvs.begin(); it != unexp_tagged_recvs.end(); ++it){
-        auto tmp = it++;
-        FabricMessage* msg = *tmp;
+        FabricMessage* msg = *it;
         if (matches(msg, tag, tag_ignore)){
+          unexp_tagged_recvs.erase(it);
           finishMatch(buf, size, msg);
           return;
         }
@@ -293,14 +394,12 @@ void RecvQueue::incoming(SST::Iris::sumi::Message* msg){
       if (recvs.empty()){
         unexp_recvs.push_back(fmsg);
       } else {
-        Recv& r = recvs.front();
-        finishMatch(r.buf, r.size, fmsg);
-        recvs.pop_front();
+        matchUntaggedRecv(fmsg);
       }
     }
   } else {
     //all other messages go right through
-    progress.incoming(fmsg);
+    complete(fmsg);
   }
 }
 
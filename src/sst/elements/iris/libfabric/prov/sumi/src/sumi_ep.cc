@@ -301,6 +301,18 @@ struct fi_ops_atomic sumi_ep_atomic_ops = {
   .compwritevalid = sumi_ep_cmp_atomic_valid,
 };
 
+//triggered operations are issued by the application thread once the counter is reached
+static ssize_t sstmaci_ep_trigger(void* context, std::function<void()>&& op)
+{
+  fi_triggered_context* trig = (fi_triggered_context*) context;
+  if (trig->event_type != FI_TRIGGER_THRESHOLD){
+    return -FI_ENOSYS;
+  }
+  sstmaci_cntr_defer((sumi_fid_cntr*) trig->trigger.threshold.cntr,
+                     trig->trigger.threshold.threshold, std::move(op));
+  return 0;
+}
+
 static ssize_t sstmaci_ep_recv(struct fid_ep* ep, void* buf, size_t len, fi_addr_t src_addr, void* context,
                                uint64_t tag, uint64_t tag_ignore, uint64_t flags)
 {
@@ -343,7 +355,34 @@ DIRECT_FN STATIC ssize_t sumi_ep_recvmsg(struct fid_ep *ep,
 					 const struct fi_msg *msg,
 					 uint64_t flags)
 {
-  return -FI_ENOSYS;
+  sumi_fid_ep* ep_impl = (sumi_fid_ep*) ep;
+  if (msg->iov_count > 1){
+    return -FI_ENOSYS;
+  }
+
+  void* buf = msg->iov_count ? msg->msg_iov[0].iov_base : nullptr;
+  size_t len = msg->iov_count ? msg->msg_iov[0].iov_len : 0;
+  void* context = msg->context;
+  fi_addr_t src_addr = msg->addr;
+  uint64_t ignore = 0;
+  flags |= ep_impl->op_flags & FI_MULTI_RECV;
+
+  auto op = [=]{
+    if (flags & FI_MULTI_RECV){
+      if (src_addr != FI_ADDR_UNSPEC){
+        return -FI_EINVAL;
+      }
+      RecvQueue* rq = (RecvQueue*) ep_impl->recv_cq->queue;
+      rq->postMultiRecv(len, buf, ep_impl->min_multi_recv, context);
+      return 0;
+    }
+    return (int) sstmaci_ep_recv(ep, buf, len, src_addr, context, 0, ~ignore, 0);
+  };
+
+  if (flags & FI_TRIGGER){
+    return sstmaci_ep_trigger(context, [op]{ op(); });
+  }
+  return op();
 }
 
 static ssize_t sstmaci_ep_send(struct fid_ep* ep, const void* buf, size_t len,
@@ -392,7 +431,23 @@ DIRECT_FN STATIC ssize_t sumi_ep_sendmsg(struct fid_ep *ep,
 					 const struct fi_msg *msg,
 					 uint64_t flags)
 {
-  return -FI_ENOSYS;
+  if (msg->iov_count > 1){
+    return -FI_ENOSYS;
+  }
+
+  const void* buf = msg->iov_count ? msg->msg_iov[0].iov_base : nullptr;
+  size_t len = msg->iov_count ? msg->msg_iov[0].iov_len : 0;
+  fi_addr_t dest_addr = msg->addr;
+  void* context = msg->context;
+  uint64_t data = (flags & FI_REMOTE_CQ_DATA) ? msg->data : FabricMessage::no_imm_data;
+  uint64_t send_flags = flags & FI_REMOTE_CQ_DATA;
+
+  if (flags & FI_TRIGGER){
+    return sstmaci_ep_trigger(context, [=]{
+      sstmaci_ep_send(ep, buf, len, dest_addr, context, FabricMessage::no_tag, data, send_flags);
+    });
+  }
+  return sstmaci_ep_send(ep, buf, len, dest_addr, context, FabricMessage::no_tag, data, send_flags);
 }
 
 DIRECT_FN STATIC ssize_t sumi_ep_msg_inject(struct fid_ep *ep, const void *buf,
@@ -463,7 +518,22 @@ sumi_ep_readv(struct fid_ep *ep, const struct iovec *iov, void **desc,
 DIRECT_FN STATIC ssize_t
 sumi_ep_readmsg(struct fid_ep *ep, const struct fi_msg_rma *msg, uint64_t flags)
 {
-  return -FI_ENOSYS;
+  if (msg->iov_count > 1 || msg->rma_iov_count > 1){
+    return -FI_ENOSYS;
+  }
+
+  void* buf = msg->iov_count ? msg->msg_iov[0].iov_base : nullptr;
+  size_t len = msg->iov_count ? msg->msg_iov[0].iov_len : 0;
+  uint64_t addr = msg->rma_iov_count ? msg->rma_iov[0].addr : 0;
+  fi_addr_t src_addr = msg->addr;
+  void* context = msg->context;
+
+  if (flags & FI_TRIGGER){
+    return sstmaci_ep_trigger(context, [=]{
+      sstmaci_ep_read(ep, buf, len, src_addr, addr, context);
+    });
+  }
+  return sstmaci_ep_read(ep, buf, len, src_addr, addr, context);
 }
 
 static ssize_t sstmaci_ep_write(struct fid_ep *ep, const void *buf, size_t len,
@@ -513,7 +583,24 @@ sumi_ep_writev(struct fid_ep *ep, const struct iovec *iov, void **desc,
 DIRECT_FN STATIC ssize_t sumi_ep_writemsg(struct fid_ep *ep, const struct fi_msg_rma *msg,
 				uint64_t flags)
 {
-  return -FI_ENOSYS;
+  if (msg->iov_count > 1 || msg->rma_iov_count > 1){
+    return -FI_ENOSYS;
+  }
+
+  const void* buf = msg->iov_count ? msg->msg_iov[0].iov_base : nullptr;
+  size_t len = msg->iov_count ? msg->msg_iov[0].iov_len : 0;
+  uint64_t addr = msg->rma_iov_count ? msg->rma_iov[0].addr : 0;
+  fi_addr_t dest_addr = msg->addr;
+  void* context = msg->context;
+  uint64_t data = (flags & FI_REMOTE_CQ_DATA) ? msg->data : FabricMessage::no_imm_data;
+  uint64_t write_flags = flags & FI_REMOTE_CQ_DATA;
+
+  if (flags & FI_TRIGGER){
+    return sstmaci_ep_trigger(context, [=]{
+      sstmaci_ep_write(ep, buf, len, dest_addr, addr, context, data, write_flags);
+    });
+  }
+  return sstmaci_ep_write(ep, buf, len, dest_addr, addr, context, data, write_flags);
 }
 
 DIRECT_FN STATIC ssize_t sumi_ep_rma_inject(struct fid_ep *ep, const void *buf,
@@ -596,7 +683,24 @@ DIRECT_FN STATIC ssize_t sumi_ep_tsendmsg(struct fid_ep *ep,
 					  const struct fi_msg_tagged *msg,
 					  uint64_t flags)
 {
-  return -FI_ENOSYS;
+  if (msg->iov_count > 1){
+    return -FI_ENOSYS;
+  }
+
+  const void* buf = msg->iov_count ? msg->msg_iov[0].iov_base : nullptr;
+  size_t len = msg->iov_count ? msg->msg_iov[0].iov_len : 0;
+  fi_addr_t dest_addr = msg->addr;
+  void* context = msg->context;
+  uint64_t tag = msg->tag;
+  uint64_t data = (flags & FI_REMOTE_CQ_DATA) ? msg->data : FabricMessage::no_imm_data;
+  uint64_t send_flags = FI_TAGGED | (flags & FI_REMOTE_CQ_DATA);
+
+  if (flags & FI_TRIGGER){
+    return sstmaci_ep_trigger(context, [=]{
+      sstmaci_ep_send(ep, buf, len, dest_addr, context, tag, data, send_flags);
+    });
+  }
+  return sstmaci_ep_send(ep, buf, len, dest_addr, context, tag, data, send_flags);
 }
 
 
@@ -809,6 +913,7 @@ extern "C" DIRECT_FN  int sumi_ep_bind(fid_t fid, struct fid *bfid, uint64_t fla
       }
 
       RecvQueue* rq = new RecvQueue(SST::Hg::OperatingSystem::currentOs());
+      rq->bindCounters(ep);
       cq->queue = (sumi_progress_queue*) rq;
       tport->allocateCq(cq->id, std::bind(&RecvQueue::incoming, rq, std::placeholders::_1));
       break;
@@ -820,8 +925,26 @@ extern "C" DIRECT_FN  int sumi_ep_bind(fid_t fid, struct fid *bfid, uint64_t fla
       }
       break;
     }
-    case FI_CLASS_CNTR: //TODO
-      return -FI_EINVAL;
+    case FI_CLASS_CNTR: {
+      sumi_fid_cntr* cntr = (sumi_fid_cntr*) bfid;
+      if (ep->domain != cntr->domain) {
+        return -FI_EINVAL;
+      }
+      if (flags & FI_SEND) ep->send_cntr = cntr;
+      if (flags & FI_RECV) ep->recv_cntr = cntr;
+      if (flags & FI_WRITE) ep->write_cntr = cntr;
+      if (flags & FI_READ) ep->read_cntr = cntr;
+      if (flags & FI_REMOTE_WRITE) ep->rwrite_cntr = cntr;
+      if (flags & FI_REMOTE_READ) ep->rread_cntr = cntr;
+      //counters may be bound before or after the CQs
+      if (ep->send_cq && ep->send_cq->queue){
+        ((RecvQueue*) ep->send_cq->queue)->bindCounters(ep);
+      }
+      if (ep->recv_cq && ep->recv_cq->queue){
+        ((RecvQueue*) ep->recv_cq->queue)->bindCounters(ep);
+      }
+      break;
+    }
     case FI_CLASS_MR: //TODO
       return -FI_EINVAL;
     case FI_CLASS_SRX_CTX:
@@ -853,6 +976,7 @@ extern "C" DIRECT_FN  int sumi_ep_open(struct fid_domain *domain, struct fi_info
   ep_impl->ep_fid.atomic = &sumi_ep_atomic_ops;
   ep_impl->domain = (sumi_fid_domain*) domain;
   ep_impl->caps = info->caps;
+  ep_impl->min_multi_recv = SUMI_MIN_MULTI_RECV_DEFAULT;
   if (info->tx_attr){
     ep_impl->op_flags = info->tx_attr->op_flags;
   }
@@ -901,7 +1025,21 @@ EXTERN_C DIRECT_FN STATIC  int sumi_ep_getopt(fid_t fid, int level, int optname,
 extern "C" int sumi_getopt(fid_t fid, int level, int optname,
 				    void *optval, size_t *optlen)
 {
-  return -FI_ENOSYS;
+  sumi_fid_ep* ep = (sumi_fid_ep*) fid;
+  if (level != FI_OPT_ENDPOINT){
+    return -FI_ENOPROTOOPT;
+  }
+  switch (optname){
+    case FI_OPT_MIN_MULTI_RECV:
+      if (!optval || !optlen || *optlen < sizeof(size_t)){
+        return -FI_EINVAL;
+      }
+      *(size_t*) optval = ep->min_multi_recv;
+      *optlen = sizeof(size_t);
+      return FI_SUCCESS;
+    default:
+      return -FI_ENOPROTOOPT;
+  }
 }
 
 EXTERN_C DIRECT_FN STATIC  int sumi_ep_setopt(fid_t fid, int level, int optname,
@@ -913,7 +1051,20 @@ EXTERN_C DIRECT_FN STATIC  int sumi_ep_setopt(fid_t fid, int level, int optname,
 extern "C" int sumi_setopt(fid_t fid, int level, int optname,
 				    const void *optval, size_t optlen)
 {
-  return -FI_EINVAL;
+  sumi_fid_ep* ep = (sumi_fid_ep*) fid;
+  if (level != FI_OPT_ENDPOINT){
+    return -FI_ENOPROTOOPT;
+  }
+  switch (optname){
+    case FI_OPT_MIN_MULTI_RECV:
+      if (!optval || optlen != sizeof(size_t)){
+        return -FI_EINVAL;
+      }
+      ep->min_multi_recv = *(const size_t*) optval;
+      return FI_SUCCESS;
+    default:
+      return -FI_ENOPROTOOPT;
+  }
 }
 
 DIRECT_FN STATIC ssize_t sumi_ep_rx_size_left(struct fid_ep *ep)
@@ -195,7 +195,8 @@ static void sumi_fini(void)
 #define SUMI_EP_CAPS   \
   (FI_MSG | FI_RMA | FI_TAGGED | FI_ATOMICS | \
   FI_DIRECTED_RECV | FI_READ | FI_NAMED_RX_CTX | \
-  FI_WRITE | FI_SEND | FI_RECV | FI_REMOTE_READ | FI_REMOTE_WRITE)
+  FI_WRITE | FI_SEND | FI_RECV | FI_REMOTE_READ | FI_REMOTE_WRITE | \
+  SUMI_EP_SEC_CAPS | FI_HMEM)
 
 static struct fi_info *sumi_allocinfo(void)
 {
@@ -453,6 +454,9 @@ static int sumi_ep_getinfo(enum fi_ep_type ep_type, uint32_t version,
           //out how to implement this in the simulator
           return -FI_ENODATA;
       }
+      if (hints->domain_attr->mr_mode & FI_MR_HMEM){
+        info->domain_attr->mr_mode |= FI_MR_HMEM;
+      }
 
       // AFAICT, the hints don't really matter for threading here
       // the only thing we really need to be aware of is whether
@@ -197,38 +197,44 @@ RingAllgatherActor::initDag()
 {
   int send_partner = (dom_me_ + 1) % dom_nproc_;
   int recv_partner = (dom_me_ + dom_nproc_ - 1) % dom_nproc_;
-  Action *prev_send = nullptr, *prev_recv = nullptr;
-  int last_recved = dom_me_;
-  for (int i=1; i < dom_nproc_; ++i){
-    //the chunk rotates in a ring
-    /**
-     * 0->1->2->3->0
-     * Rank 1 would exchange the following "segments"
-     * receive 0, send 1
-     * receive 3, send 0
-     * receive 2, send 3
-     */
-    int recv_chunk = (last_recved - 1 + dom_nproc_) % dom_nproc_;
-    int send_chunk  = last_recved;
-
-    Action* send_ac = new SendAction(i, send_partner, SendAction::in_place);
-    send_ac->offset = send_chunk * nelems_;
-    send_ac->nelems = nelems_;
-    Action* recv_ac = new RecvAction(i, recv_partner, RecvAction::in_place);
-    recv_ac->offset = recv_chunk * nelems_;
-    recv_ac->nelems = nelems_;
-
-    addDependency(prev_send, send_ac);
-    addDependency(prev_send, recv_ac);
-    addDependency(prev_recv, send_ac);
-    addDependency(prev_recv, recv_ac);
-
-    last_recved = recv_chunk;
-    prev_send = send_ac;
-    prev_recv = recv_ac;
+  //large chunks are split into segments that go around the ring independently
+  int num_segments = PipelineSegments::count(nelems_, nelems_, type_size_,
+                                             engine_->segmentSize(), dom_nproc_);
+  for (int seg=0; seg < num_segments; ++seg){
+    int seg_offset, seg_nelems;
+    PipelineSegments::split(nelems_, num_segments, seg, seg_offset, seg_nelems);
+    Action *prev_send = nullptr, *prev_recv = nullptr;
+    int last_recved = dom_me_;
+    for (int i=1; i < dom_nproc_; ++i){
+      //the chunk rotates in a ring
+      /**
+       * 0->1->2->3->0
+       * Rank 1 would exchange the following "segments"
+       * receive 0, send 1
+       * receive 3, send 0
+       * receive 2, send 3
+       */
+      int recv_chunk = (last_recved - 1 + dom_nproc_) % dom_nproc_;
+      int send_chunk  = last_recved;
+      int round = (i - 1)*num_segments + seg + 1;
+
+      Action* send_ac = new SendAction(round, send_partner, SendAction::in_place);
+      send_ac->offset = send_chunk * nelems_ + seg_offset;
+      send_ac->nelems = seg_nelems;
+      Action* recv_ac = new RecvAction(round, recv_partner, RecvAction::in_place);
+      recv_ac->offset = recv_chunk * nelems_ + seg_offset;
+      recv_ac->nelems = seg_nelems;
+
+      addDependency(prev_send, send_ac);
+      addDependency(prev_send, recv_ac);
+      addDependency(prev_recv, send_ac);
+      addDependency(prev_recv, recv_ac);
+
+      last_recved = recv_chunk;
+      prev_send = send_ac;
+      prev_recv = recv_ac;
+    }
   }
 }
 
-
-
 }
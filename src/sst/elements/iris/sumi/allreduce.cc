@@ -211,4 +211,90 @@ WilkeAllreduceActor::bufferAction(void *dst_buffer, void *msg_buffer, Action* ac
   }
 }
 
+void
+RingAllreduceActor::finalizeBuffers()
+{
+  long buffer_size = nelems_ * type_size_;
+  my_api_->freeWorkspace(recv_buffer_, buffer_size);
+}
+
+void
+RingAllreduceActor::initBuffers()
+{
+  void* dst = result_buffer_;
+  void* src = send_buffer_;
+  int size = nelems_ * type_size_;
+  //same as the halving allreduce, everything happens in the dst buffer
+  //with a temporary buffer for receiving partial reductions
+  if (src != dst)
+    my_api_->memcopy(dst, src, size);
+  recv_buffer_ = my_api_->allocateWorkspace(size, src);
+  send_buffer_ = result_buffer_;
+}
+
+void
+RingAllreduceActor::initDag()
+{
+  slicer_->fxn = fxn_;
+
+  int nproc = dom_nproc_;
+  int send_partner = (dom_me_ + 1) % nproc;
+  int recv_partner = (dom_me_ + nproc - 1) % nproc;
+  int num_steps = 2*(nproc - 1);
+
+  //the buffer is cut into one chunk per rank, rank r ends the
+  //reduce-scatter half owning the fully reduced chunk r
+  int max_chunk = nelems_ / nproc + (nelems_ % nproc ? 1 : 0);
+  int min_chunk = nelems_ / nproc;
+  num_segments_ = PipelineSegments::count(max_chunk, min_chunk, type_size_,
+                                          engine_->segmentSize(), num_steps);
+
+  output.output("Rank %s configured ring allreduce for tag=%d for nproc=%d over %d steps of %d segments",
+    rankStr().c_str(), tag_, nproc, num_steps, num_segments_);
+
+  for (int seg=0; seg < num_segments_; ++seg){
+    Action *prev_send = nullptr, *prev_recv = nullptr;
+    for (int step=0; step < num_steps; ++step){
+      bool reducing = step < (nproc - 1);
+      int shift = reducing ? step + 1 : step - (nproc - 1);
+      int send_chunk = ((dom_me_ - shift) % nproc + nproc) % nproc;
+      int recv_chunk = (send_chunk - 1 + nproc) % nproc;
+      int round = step*num_segments_ + seg;
+
+      int chunk_offset, chunk_nelems, seg_offset, seg_nelems;
+      Action* send_ac = new SendAction(round, send_partner, SendAction::in_place);
+      PipelineSegments::split(nelems_, nproc, send_chunk, chunk_offset, chunk_nelems);
+      PipelineSegments::split(chunk_nelems, num_segments_, seg, seg_offset, seg_nelems);
+      send_ac->offset = chunk_offset + seg_offset;
+      send_ac->nelems = seg_nelems;
+
+      Action* recv_ac = new RecvAction(round, recv_partner,
+                              reducing ? RecvAction::reduce : RecvAction::in_place);
+      PipelineSegments::split(nelems_, nproc, recv_chunk, chunk_offset, chunk_nelems);
+      PipelineSegments::split(chunk_nelems, num_segments_, seg, seg_offset, seg_nelems);
+      recv_ac->offset = chunk_offset + seg_offset;
+      recv_ac->nelems = seg_nelems;
+
+      addDependency(prev_send, send_ac);
+      addDependency(prev_send, recv_ac);
+      addDependency(prev_recv, send_ac);
+      addDependency(prev_recv, recv_ac);
+
+      prev_send = send_ac;
+      prev_recv = recv_ac;
+    }
+  }
+}
+
+void
+RingAllreduceActor::bufferAction(void *dst_buffer, void *msg_buffer, Action* ac)
+{
+  int step = ac->round / num_segments_;
+  if (step < (dom_nproc_ - 1)){
+    (fxn_)(dst_buffer, msg_buffer, ac->nelems);
+  } else {
+    my_api_->memcopy(dst_buffer, msg_buffer, ac->nelems * type_size_);
+  }
+}
+
 }
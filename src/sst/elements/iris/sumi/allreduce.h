@@ -60,6 +60,73 @@ class WilkeAllreduceActor :
 
 };
 
+/**
+ * Reduce-scatter then allgather around a ring. Each rank sends about twice
+ * the buffer whatever the number of ranks, and every chunk is split into
+ * segments that pipeline through the ring independently.
+ */
+class RingAllreduceActor :
+  public DagCollectiveActor
+{
+
+ public:
+  RingAllreduceActor(CollectiveEngine* engine, void* dst, void* src,
+                     int nelems, int type_size, int tag, reduce_fxn fxn,
+                     int cq_id, Communicator* comm) :
+    DagCollectiveActor(Collective::allreduce, engine, dst, src, type_size, tag, cq_id, comm, fxn),
+    fxn_(fxn), nelems_(nelems), num_segments_(1)
+  {
+  }
+
+  std::string toString() const override {
+    return "ring allreduce actor";
+  }
+
+  void bufferAction(void *dst_buffer, void *msg_buffer, Action* ac) override;
+
+  Output output;
+
+ private:
+  void finalizeBuffers() override;
+  void initBuffers() override;
+  void initDag() override;
+
+ private:
+  reduce_fxn fxn_;
+
+  int nelems_;
+
+  int num_segments_;
+
+};
+
+class RingAllreduce :
+  public DagCollective
+{
+ public:
+  RingAllreduce(CollectiveEngine* engine, void* dst, void* src,
+                int nelems, int type_size, int tag, reduce_fxn fxn,
+                int cq_id, Communicator* comm)
+    : DagCollective(allreduce, engine, dst, src, type_size, tag, cq_id, comm),
+      fxn_(fxn), nelems_(nelems)
+  {
+  }
+
+  std::string toString() const override {
+    return "ring allreduce";
+  }
+
+  DagCollectiveActor* newActor() const override {
+    return new RingAllreduceActor(engine_, dst_buffer_, src_buffer_,
+                                  nelems_, type_size_, tag_, fxn_, cq_id_, comm_);
+  }
+
+ private:
+  reduce_fxn fxn_;
+  int nelems_;
+
+};
+
 class WilkeHalvingAllreduce :
   public DagCollective
 {
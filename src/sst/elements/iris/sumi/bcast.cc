@@ -140,5 +140,62 @@ BinaryTreeBcastActor::initBuffers()
   result_buffer_ = send_buffer_;
 }
 
+void
+PipelinedBcastActor::bufferAction(void *dst_buffer, void *msg_buffer, Action *ac)
+{
+  ::memcpy(dst_buffer, msg_buffer, ac->nelems*type_size_);
+}
+
+void
+PipelinedBcastActor::finalizeBuffers()
+{
+}
+
+void
+PipelinedBcastActor::initBuffers()
+{
+  send_buffer_ = result_buffer_;
+  recv_buffer_ = result_buffer_;
+}
+
+void
+PipelinedBcastActor::initDag()
+{
+  int nproc = comm_->nproc();
+  int offsetMe = (comm_->myCommRank() - root_ + nproc) % nproc;
+  int parent = (offsetMe - 1 + root_ + nproc) % nproc; //everything offset by root
+  int child = (offsetMe + 1 + root_) % nproc;
+
+  //each segment is its own round, the partners already tell sends and recvs apart
+  int num_segments = PipelineSegments::count(nelems_, nelems_, type_size_,
+                                             engine_->segmentSize(), 1);
+
+  output.output("Rank %s configured pipelined bcast from root=%d tag=%d with %d segments",
+    rankStr().c_str(), root_, tag_, num_segments);
+
+  for (int seg=0; seg < num_segments; ++seg){
+    int offset, seg_nelems;
+    PipelineSegments::split(nelems_, num_segments, seg, offset, seg_nelems);
+
+    Action* recv = nullptr;
+    if (offsetMe != 0){
+      recv = new RecvAction(seg, parent, RecvAction::in_place);
+      recv->offset = offset;
+      recv->nelems = seg_nelems;
+      addAction(recv);
+    }
+
+    if (offsetMe != (nproc - 1)){
+      Action* send = new SendAction(seg, child, SendAction::in_place);
+      send->offset = offset;
+      send->nelems = seg_nelems;
+      if (recv){
+        addDependency(recv, send);
+      } else {
+        addAction(send);
+      }
+    }
+  }
+}
 
 }
@@ -54,6 +54,61 @@ class BinaryTreeBcastActor :
   int nelems_;
 };
 
+/**
+ * Broadcast down a chain of ranks starting at the root. The buffer is split
+ * into segments and each rank forwards a segment as soon as it arrives, so
+ * for large messages the time approaches one transfer of the buffer.
+ */
+class PipelinedBcastActor :
+  public DagCollectiveActor
+{
+ public:
+  PipelinedBcastActor(CollectiveEngine* engine, int root, void *buf, int nelems,
+                      int type_size, int tag, int cq_id, Communicator* comm)
+    : DagCollectiveActor(Collective::bcast, engine, buf, buf, type_size, tag, cq_id, comm),
+      root_(root), nelems_(nelems)
+  {}
+
+  std::string toString() const override {
+    return "pipelined bcast actor";
+  }
+
+  Output output;
+
+ private:
+  void finalizeBuffers() override;
+  void initBuffers() override;
+  void initDag() override;
+  void bufferAction(void *dst_buffer, void *msg_buffer, Action *ac) override;
+
+  int root_;
+  int nelems_;
+};
+
+class PipelinedBcastCollective :
+  public DagCollective
+{
+ public:
+  PipelinedBcastCollective(CollectiveEngine* engine, int root, void* buf,
+                           int nelems, int type_size, int tag, int cq_id, Communicator* comm)
+    : DagCollective(Collective::bcast, engine, buf, buf, type_size, tag, cq_id, comm),
+      root_(root), nelems_(nelems) {}
+
+  std::string toString() const override {
+    return "pipelined bcast";
+  }
+
+  DagCollectiveActor* newActor() const override {
+    return new PipelinedBcastActor(engine_, root_, dst_buffer_, nelems_,
+                                   type_size_, tag_, cq_id_, comm_);
+  }
+
+ private:
+  int root_;
+  int nelems_;
+
+};
+
 class BinaryTreeBcastCollective :
   public DagCollective
 {
@@ -818,6 +818,20 @@ RecursiveDoubling::computeTree(int nproc, int &log2nproc, int &midpoint, int &po
   midpoint = pow2nproc / 2;
 }
 
+int
+PipelineSegments::count(int nelems, int min_nelems, int type_size,
+                        uint64_t segment_bytes, int rounds_per_segment)
+{
+  uint64_t bytes = uint64_t(nelems) * type_size;
+  if (segment_bytes == 0 || bytes <= segment_bytes){
+    return 1;
+  }
+  uint64_t nsegments = (bytes + segment_bytes - 1) / segment_bytes;
+  nsegments = std::min<uint64_t>(nsegments, std::max(min_nelems, 1));
+  nsegments = std::min<uint64_t>(nsegments, std::max<int>(int(Action::max_round) / std::max(rounds_per_segment, 1), 1));
+  return std::max<int>(nsegments, 1);
+}
+
 int
 VirtualRankMap::realToVirtual(int rank, int* ret) const
 {
@@ -22,6 +22,7 @@
 #include <set>
 #include <map>
 #include <stdint.h>
+#include <algorithm>
 //#include <sstmac/common/sstmac_config.h>
 #include <mercury/common/allocator.h>
 
@@ -503,6 +504,27 @@ struct RecursiveDoubling {
   static void computeTree(int nproc, int &log2nproc, int &midpoint, int &pow2nproc);
 };
 
+/**
+ * @brief Splits the elements a pipelined algorithm moves in each step
+ * into segments so later steps of one segment overlap earlier steps of the next.
+ */
+struct PipelineSegments {
+  /**
+   * @param nelems The most elements moved in one step
+   * @param min_nelems The fewest elements moved in one step, no segment is left empty
+   * @param segment_bytes The target segment size, 0 for no segmenting
+   * @param rounds_per_segment The number of rounds each segment takes
+   * @return The number of segments, keeping all rounds below Action::max_round
+   */
+  static int count(int nelems, int min_nelems, int type_size,
+                   uint64_t segment_bytes, int rounds_per_segment);
+
+  static void split(int nelems, int nsegments, int segment, int& offset, int& seg_nelems){
+    offset = segment * (nelems / nsegments) + std::min(segment, nelems % nsegments);
+    seg_nelems = nelems / nsegments + (segment < nelems % nsegments ? 1 : 0);
+  }
+};
+
 /**
  * @class virtual_rank_map
  * Maps a given number of live processors
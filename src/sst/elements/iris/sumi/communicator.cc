@@ -61,21 +61,36 @@ Communicator::createSmpCommunicator(const std::set<int>& neighbors, CollectiveEn
                         int(neighbors.size()), int(neighbors_subset.size()));
     }
 
-    std::vector<int> smp_ranks(this->nproc());
+    //every rank learns the SMP rank of every other rank and
+    //which rank owns its node
+    std::vector<int> smp_ranks(2*this->nproc());
+    int my_smp_info[2] = { my_smp_rank, globalToCommRank(smp_comm_->commToGlobalRank(0)) };
     int tag = -2;
 // FIXME
-    engine->allgather(smp_ranks.data(), &my_smp_rank, 1, sizeof(int), tag, cq_id, this);
+    engine->allgather(smp_ranks.data(), my_smp_info, 2, sizeof(int), tag, cq_id, this);
     engine->blockUntilNext(cq_id);
 
     std::map<int,int> rank_counts;
+    std::map<int,int> owner_index;
+    for (int rank=0; rank < this->nproc(); ++rank){
+      int local_smp_rank = smp_ranks[2*rank];
+      rank_counts[local_smp_rank]++;
+      if (local_smp_rank == 0){
+        int next_index = owner_index.size();
+        owner_index[rank] = next_index;
+      }
+    }
+    smp_owners_.resize(this->nproc());
+    for (int rank=0; rank < this->nproc(); ++rank){
+      smp_owners_[rank] = owner_index[smp_ranks[2*rank+1]];
+    }
+
     int my_owner_rank = -1;
     if (my_smp_rank == 0){
       std::vector<int> owner_to_global;
       idx = 0;
       for (int rank=0; rank < this->nproc(); ++rank){
-        int local_smp_rank = smp_ranks[rank];
-        rank_counts[local_smp_rank]++;
-        if (local_smp_rank == 0){
+        if (smp_ranks[2*rank] == 0){
           owner_to_global.push_back(commToGlobalRank(rank));
           if (rank == this->myCommRank()){
             my_owner_rank = idx;
@@ -72,6 +72,16 @@ class Communicator {
     return owner_comm_;
   }
 
+  /**
+   * @brief smpOwner
+   * @param comm_rank
+   * @return The rank in the owner communicator of the rank that owns
+   *         the node comm_rank is on, -1 if there is no SMP communicator
+   */
+  int smpOwner(int comm_rank) const {
+    return smp_owners_.empty() ? -1 : smp_owners_[comm_rank];
+  }
+
   void registerRankCallback(RankCallback* cback){
     rank_callbacks_.insert(cback);
   }
@@ -101,6 +111,7 @@ class Communicator {
 
   Communicator* smp_comm_;
   Communicator* owner_comm_;
+  std::vector<int> smp_owners_;
   bool smp_balanced_;
 
 };
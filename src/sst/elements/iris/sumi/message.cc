@@ -90,6 +90,10 @@ Message::serialize_order(SST::Core::Serialization::serializer& ser)
   SST_SER(class_);
   SST_SER(send_cq_);
   SST_SER(recv_cq_);
+  SST_SER(cp_rank_);
+  SST_SER(cp_sent_);
+  SST_SER(cp_compute_);
+  SST_SER(cp_comm_);
   NetworkMessage::serialize_order(ser);
 }
 
@@ -243,6 +243,41 @@ class Message : public SST::Hg::NetworkMessage
     send_sync_delay_ = delay;
   }
 
+  /**
+   * @brief stampCriticalPath
+   * Piggyback the longest chain of compute and network time ending at the send
+   * @param rank The rank sending the message
+   * @param sent The time the message was sent
+   * @param compute The compute time on the chain
+   * @param comm The network time on the chain
+   */
+  void stampCriticalPath(int rank, SST::Hg::Timestamp sent,
+                         SST::Hg::TimeDelta compute, SST::Hg::TimeDelta comm) {
+    cp_rank_ = rank;
+    cp_sent_ = sent;
+    cp_compute_ = compute;
+    cp_comm_ = comm;
+  }
+
+  /**
+   * @return The rank that stamped the critical path, -1 if not stamped
+   */
+  int criticalPathRank() const {
+    return cp_rank_;
+  }
+
+  SST::Hg::Timestamp criticalPathSent() const {
+    return cp_sent_;
+  }
+
+  SST::Hg::TimeDelta criticalPathCompute() const {
+    return cp_compute_;
+  }
+
+  SST::Hg::TimeDelta criticalPathComm() const {
+    return cp_comm_;
+  }
+
  private:
   SST::Hg::Timestamp arrived_;
 
@@ -250,6 +285,13 @@ class Message : public SST::Hg::NetworkMessage
 
   SST::Hg::TimeDelta send_sync_delay_;
 
+  int cp_rank_ = -1;
+
+  SST::Hg::Timestamp cp_sent_;
+
+  SST::Hg::TimeDelta cp_compute_;
+
+  SST::Hg::TimeDelta cp_comm_;
 
 };
 
@@ -84,4 +84,77 @@ HalvingReduceScatterActor::bufferAction(void * /*dst_buffer*/, void * /*msg_buff
 {
 }
 
+void
+RingReduceScatterActor::initBuffers()
+{
+  //the whole input is reduced in a workspace and the
+  //chunk this rank owns is copied out at the end
+  final_buffer_ = result_buffer_;
+  int size = nelems_ * type_size_ * dom_nproc_;
+  result_buffer_ = my_api_->allocateWorkspace(size, send_buffer_);
+  my_api_->memcopy(result_buffer_, send_buffer_, size);
+  recv_buffer_ = my_api_->allocateWorkspace(size, send_buffer_);
+  send_buffer_ = result_buffer_;
+}
+
+void
+RingReduceScatterActor::finalizeBuffers()
+{
+  int size = nelems_ * type_size_ * dom_nproc_;
+  int chunk_size = nelems_ * type_size_;
+  my_api_->memcopy(final_buffer_, Message::offset_ptr(result_buffer_, dom_me_ * chunk_size), chunk_size);
+  my_api_->freeWorkspace(recv_buffer_, size);
+  my_api_->freeWorkspace(result_buffer_, size);
+  result_buffer_ = final_buffer_;
+}
+
+void
+RingReduceScatterActor::initDag()
+{
+  slicer_->fxn = fxn_;
+
+  int nproc = dom_nproc_;
+  int send_partner = (dom_me_ + 1) % nproc;
+  int recv_partner = (dom_me_ + nproc - 1) % nproc;
+  int num_steps = nproc - 1;
+  int num_segments = PipelineSegments::count(nelems_, nelems_, type_size_,
+                                             engine_->segmentSize(), num_steps);
+
+  output.output("Rank %s configured ring reduce scatter for tag=%d for nproc=%d over %d steps of %d segments",
+    rankStr().c_str(), tag_, nproc, num_steps, num_segments);
+
+  for (int seg=0; seg < num_segments; ++seg){
+    int seg_offset, seg_nelems;
+    PipelineSegments::split(nelems_, num_segments, seg, seg_offset, seg_nelems);
+    Action *prev_send = nullptr, *prev_recv = nullptr;
+    for (int step=0; step < num_steps; ++step){
+      //what I reduced in the last step moves on, I finish with my own chunk
+      int send_chunk = ((dom_me_ - step - 1) % nproc + nproc) % nproc;
+      int recv_chunk = (send_chunk - 1 + nproc) % nproc;
+      int round = step*num_segments + seg;
+
+      Action* send_ac = new SendAction(round, send_partner, SendAction::in_place);
+      send_ac->offset = send_chunk * nelems_ + seg_offset;
+      send_ac->nelems = seg_nelems;
+      Action* recv_ac = new RecvAction(round, recv_partner, RecvAction::reduce);
+      recv_ac->offset = recv_chunk * nelems_ + seg_offset;
+      recv_ac->nelems = seg_nelems;
+
+      addDependency(prev_send, send_ac);
+      addDependency(prev_send, recv_ac);
+      addDependency(prev_recv, send_ac);
+      addDependency(prev_recv, recv_ac);
+
+      prev_send = send_ac;
+      prev_recv = recv_ac;
+    }
+  }
+}
+
+void
+RingReduceScatterActor::bufferAction(void *dst_buffer, void *msg_buffer, Action* ac)
+{
+  (fxn_)(dst_buffer, msg_buffer, ac->nelems);
+}
+
 }
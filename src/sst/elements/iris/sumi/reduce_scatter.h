@@ -42,7 +42,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 Questions? Contact sst-macro-help@sandia.gov
 */
 
-#pragma
+#pragma once
 
 #include <iris/sumi/collective.h>
 #include <iris/sumi/collective_actor.h>
@@ -79,6 +79,68 @@ class HalvingReduceScatterActor :
   reduce_fxn fxn_;
 };
 
+/**
+ * Reduce-scatter around a ring, the input holds one chunk of nelems for each
+ * rank and rank r is left with the reduced chunk r. The chunks are split into
+ * segments that pipeline through the ring independently.
+ */
+class RingReduceScatterActor :
+  public DagCollectiveActor
+{
+
+ public:
+  RingReduceScatterActor(CollectiveEngine* engine, void* dst, void* src,
+                         int nelems, int type_size, int tag, reduce_fxn fxn, int cq_id, Communicator* comm) :
+    DagCollectiveActor(Collective::reduce_scatter, engine, dst, src, type_size, tag, cq_id, comm, fxn),
+    fxn_(fxn), nelems_(nelems), final_buffer_(nullptr)
+  {
+  }
+
+  std::string toString() const override {
+    return "ring reduce scatter actor";
+  }
+
+  void bufferAction(void *dst_buffer, void *msg_buffer, Action* ac) override;
+
+  Output output;
+
+ private:
+  void finalizeBuffers() override;
+  void initBuffers() override;
+  void initDag() override;
+
+ private:
+  reduce_fxn fxn_;
+  int nelems_;
+  void* final_buffer_;
+};
+
+class RingReduceScatter :
+  public DagCollective
+{
+ public:
+  RingReduceScatter(CollectiveEngine* engine, void* dst, void* src,
+                    int nelems, int type_size, int tag, reduce_fxn fxn, int cq_id, Communicator* comm)
+    : DagCollective(reduce_scatter, engine, dst, src, type_size, tag, cq_id, comm),
+      fxn_(fxn), nelems_(nelems)
+  {
+  }
+
+  std::string toString() const override {
+    return "ring reduce scatter";
+  }
+
+  DagCollectiveActor* newActor() const override {
+    return new RingReduceScatterActor(engine_, dst_buffer_, src_buffer_,
+                                      nelems_, type_size_, tag_, fxn_, cq_id_, comm_);
+  }
+
+ private:
+  reduce_fxn fxn_;
+  int nelems_;
+
+};
+
 class HalvingReduceScatter :
   public DagCollective
 {
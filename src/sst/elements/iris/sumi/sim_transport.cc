@@ -35,16 +35,19 @@
 #include <iris/sumi/message.h>
 #include <mercury/common/stl_string.h>
 #include <mercury/common/component.h>
+#include <mercury/common/events.h>
 #include <mercury/common/util.h>
 #include <mercury/common/request.h>
 #include <mercury/common/errors.h>
 #include <mercury/common/output.h>
 #include <mercury/components/operating_system.h>
+#include <mercury/components/operating_system_CL.h>
 #include <mercury/components/node.h>
 #include <mercury/operating_system/libraries/library.h>
 #include <mercury/operating_system/process/app.h>
 #include <mercury/operating_system/launch/app_launcher.h>
 
+#include <algorithm>
 #include <cstring>
 
 using SST::Hg::TimeDelta;
@@ -162,6 +165,11 @@ Transport::logMessageDelay(Message * /*msg*/, uint64_t /*bytes*/, int /*stage*/,
 {
 }
 
+void
+Transport::logMessageSend(Message * /*msg*/)
+{
+}
+
 //void
 //Transport::startCollectiveMessageLog()
 //{
@@ -204,6 +212,19 @@ SimTransport::SimTransport(SST::Params& params, SST::Hg::App* parent) :
   post_header_delay_ = TimeDelta(params.find<SST::UnitAlgebra>("post_header_delay", "0s").getValue().toDouble());
   poll_delay_ = TimeDelta(params.find<SST::UnitAlgebra>("poll_delay", "0s").getValue().toDouble());
 
+  //poll_delay is the CPU time to process one completion. Without progress threads the
+  //application pays it when it polls, otherwise dedicated cores process completions
+  //as they arrive, overlapped with the application's compute
+  int progress_threads = params.find<int>("progress_threads", 0);
+  progress_stats_ = params.find<bool>("progress_stats", false);
+  if (progress_threads > 0){
+    progress_free_.resize(progress_threads);
+    auto* os_cl = dynamic_cast<SST::Hg::OperatingSystemCL*>(os_);
+    if (os_cl){
+      os_cl->computeScheduler()->dedicateCores(progress_threads);
+    }
+  }
+
   rdma_pin_latency_ = TimeDelta(params.find<SST::UnitAlgebra>("rdma_pin_latency", "0s").getValue().toDouble());
   rdma_page_delay_ = TimeDelta(params.find<SST::UnitAlgebra>("rdma_page_delay", "0s").getValue().toDouble());
   pin_delay_ = rdma_pin_latency_.ticks() || rdma_page_delay_.ticks();
@@ -267,6 +288,10 @@ SimTransport::finish()
 {
   //this should really loop through and kill off all the pings
   //so none of them execute
+  if (progress_stats_){
+    out_->output("Rank %d spent %12.8fs processing completions%s\n", rank_, progress_time_.sec(),
+                 progress_free_.empty() ? "" : " on progress threads");
+  }
 }
 
 SimTransport::~SimTransport()
@@ -329,6 +354,7 @@ SimTransport::compute(SST::Hg::TimeDelta t)
 void
 SimTransport::send(Message* m)
 {
+  logMessageSend(m);
   switch(m->SST::Hg::NetworkMessage::type()){
     case SST::Hg::NetworkMessage::smsg_send:
       if (m->recver() == rank_){
@@ -426,10 +452,38 @@ SimTransport::allocateFlowId()
   return id;
 }
 
+void
+SimTransport::chargeProgress()
+{
+  if (progress_free_.empty() && poll_delay_.ticks()){
+    progress_time_ += poll_delay_;
+    compute_api_->compute(poll_delay_);
+  }
+}
+
 void
 SimTransport::incomingMessage(Message *msg)
+{
+  if (progress_free_.empty() || poll_delay_.ticks() == 0){
+    deliverMessage(msg);
+    return;
+  }
+
+  //the first progress thread to be free processes the completion
+  auto core = std::min_element(progress_free_.begin(), progress_free_.end());
+  SST::Hg::Timestamp start = std::max(now(), *core);
+  *core = start + poll_delay_;
+  progress_time_ += poll_delay_;
+  os_->sendExecutionEvent(*core, SST::Hg::newCallback(this, &SimTransport::deliverMessage, msg));
+}
+
+void
+SimTransport::deliverMessage(Message *msg)
 {
   msg->writeSyncValue();
+  if (msg->criticalPathRank() >= 0){
+    msg->setTimeArrived(now());
+  }
   int cq = msg->isNicAck() ? msg->sendCQ() : msg->recvCQ();
   if (cq != Message::no_ack){
     if (cq >= completion_queues_.size()){
@@ -482,6 +536,17 @@ CollectiveEngine::CollectiveEngine(SST::Params& params, Transport *tport) :
   use_put_protocol_ = params.find<bool>("use_put_protocol", false);
   alltoall_type_ = params.find<std::string>("alltoall", "bruck");
   allgather_type_ = params.find<std::string>("allgather", "bruck");
+  allreduce_type_ = params.find<std::string>("allreduce", "wilke");
+  bcast_type_ = params.find<std::string>("bcast", "btree");
+  reduce_scatter_type_ = params.find<std::string>("reduce_scatter", "ring");
+
+  //collectives moving at least this many bytes switch to the large algorithms
+  large_cutoff_ = params.find<SST::UnitAlgebra>("large_collective_cutoff", "0 B").getRoundedValue();
+  large_allgather_type_ = params.find<std::string>("large_allgather", "ring");
+  large_allreduce_type_ = params.find<std::string>("large_allreduce", "ring");
+  large_bcast_type_ = params.find<std::string>("large_bcast", "pipeline");
+  large_reduce_scatter_type_ = params.find<std::string>("large_reduce_scatter", "ring");
+  segment_size_ = params.find<SST::UnitAlgebra>("collective_segment_size", "0 B").getRoundedValue();
 
   int default_qos = params.find<int>("default_qos", 0);
   rdma_get_qos_ = params.find<int>("collective_rdma_get_qos", default_qos);
@@ -543,6 +608,24 @@ CollectiveEngine::skipCollective(Collective::type_t ty,
   return nullptr;
 }
 
+DagCollective*
+CollectiveEngine::newAllreduce(void* dst, void *src, int nelems, int type_size, int tag, reduce_fxn fxn,
+                               int cq_id, Communicator* comm)
+{
+  const std::string& type = selectAlgorithm(allreduce_type_, large_allreduce_type_,
+                                            uint64_t(nelems) * type_size);
+  if (type == "wilke") {
+    return new WilkeHalvingAllreduce(this, dst, src, nelems, type_size, tag, fxn, cq_id, comm);
+  }
+  else if (type == "ring") {
+    return new RingAllreduce(this, dst, src, nelems, type_size, tag, fxn, cq_id, comm);
+  }
+  else {
+    sst_hg_abort_printf("unrecognized allreduce type %s", type.c_str());
+  }
+  return nullptr;
+}
+
 CollectiveDoneMessage*
 CollectiveEngine::allreduce(void* dst, void *src, int nelems, int type_size, int tag, reduce_fxn fxn,
                             int cq_id, Communicator* comm)
@@ -558,19 +641,18 @@ CollectiveEngine::allreduce(void* dst, void *src, int nelems, int type_size, int
   if (comm->smpComm()){
     //tags are restricted to 28 bits - the front 4 bits are mine for various internal operations
     int intra_reduce_tag = 1<<28 | tag;
-    auto* intra_reduce = new WilkeHalvingAllreduce(this, dst, src, nelems,
-                                   type_size, intra_reduce_tag, fxn, cq_id, comm->smpComm());
+    auto* intra_reduce = newAllreduce(dst, src, nelems, type_size, intra_reduce_tag, fxn,
+                                      cq_id, comm->smpComm());
 
-    int root = comm->smpComm()->commToGlobalRank(0);
     Collective* prev;
-    if (comm->myCommRank() == root){
+    if (comm->smpComm()->myCommRank() == 0){
       if (!comm->ownerComm()){
         sst_hg_abort_printf("Bad owner comm configuration - rank 0 in SMP comm should 'own' node");
       }
       //I am the owner!
       int inter_reduce_tag = 2<<28 | tag;
-      auto* inter_reduce = new WilkeHalvingAllreduce(this, dst, dst, nelems,
-                                     type_size, inter_reduce_tag, fxn, cq_id, comm->ownerComm());
+      auto* inter_reduce = newAllreduce(dst, dst, nelems, type_size, inter_reduce_tag, fxn,
+                                        cq_id, comm->ownerComm());
 
 
       intra_reduce->setSubsequent(inter_reduce);
@@ -578,14 +660,14 @@ CollectiveEngine::allreduce(void* dst, void *src, int nelems, int type_size, int
     } else {
       prev = intra_reduce;
     }
-    auto* intra_bcast = new BinaryTreeBcastCollective(this, root, dst, nelems, type_size, tag,
-                                                      cq_id, comm->smpComm());
+    auto* intra_bcast = newBcast(0, dst, nelems, type_size, tag, cq_id, comm->smpComm());
     prev->setSubsequent(intra_bcast);
     //this should report back as done on the original communicator!
     coll = new DoNothingCollective(this, tag, cq_id, comm);
     intra_bcast->setSubsequent(coll);
+    return startCollective(intra_reduce);
   } else {
-    coll = new WilkeHalvingAllreduce(this, dst, src, nelems, type_size, tag, fxn, cq_id, comm);
+    coll = newAllreduce(dst, src, nelems, type_size, tag, fxn, cq_id, comm);
   }
 
   return startCollective(coll);
@@ -599,7 +681,18 @@ CollectiveEngine::reduceScatter(void* dst, void *src, int nelems, int type_size,
   if (msg) return msg;
 
   if (!comm) comm = global_domain_;
-  DagCollective* coll = new HalvingReduceScatter(this, dst, src, nelems, type_size, tag, fxn, cq_id, comm);
+  DagCollective* coll = nullptr;
+  const std::string& type = selectAlgorithm(reduce_scatter_type_, large_reduce_scatter_type_,
+                                            uint64_t(nelems) * type_size * comm->nproc());
+  if (type == "ring") {
+    coll = new RingReduceScatter(this, dst, src, nelems, type_size, tag, fxn, cq_id, comm);
+  }
+  else if (type == "halving") {
+    coll = new HalvingReduceScatter(this, dst, src, nelems, type_size, tag, fxn, cq_id, comm);
+  }
+  else {
+    sst_hg_abort_printf("unrecognized reduce_scatter type %s", type.c_str());
+  }
   return startCollective(coll);
 }
 
@@ -628,6 +721,24 @@ CollectiveEngine::reduce(int root, void* dst, void *src, int nelems, int type_si
   return startCollective(coll);
 }
 
+DagCollective*
+CollectiveEngine::newBcast(int root, void *buf, int nelems, int type_size, int tag,
+                           int cq_id, Communicator* comm)
+{
+  const std::string& type = selectAlgorithm(bcast_type_, large_bcast_type_,
+                                            uint64_t(nelems) * type_size);
+  if (type == "btree") {
+    return new BinaryTreeBcastCollective(this, root, buf, nelems, type_size, tag, cq_id, comm);
+  }
+  else if (type == "pipeline") {
+    return new PipelinedBcastCollective(this, root, buf, nelems, type_size, tag, cq_id, comm);
+  }
+  else {
+    sst_hg_abort_printf("unrecognized bcast type %s", type.c_str());
+  }
+  return nullptr;
+}
+
 CollectiveDoneMessage*
 CollectiveEngine::bcast(int root, void *buf, int nelems, int type_size, int tag,
                          int cq_id, Communicator* comm)
@@ -636,7 +747,35 @@ CollectiveEngine::bcast(int root, void *buf, int nelems, int type_size, int tag,
   if (msg) return msg;
 
   if (!comm) comm = global_domain_;
-  DagCollective* coll = new BinaryTreeBcastCollective(this, root, buf, nelems, type_size, tag, cq_id, comm);
+
+  if (comm->smpComm()){
+    //the root's node gets the data first, then the node owners, then everyone else
+    int root_owner = comm->smpOwner(root);
+    bool on_root_node = root_owner == comm->smpOwner(comm->myCommRank());
+    Collective* first = nullptr;
+    Collective* prev = nullptr;
+    if (on_root_node){
+      int smp_root = comm->smpComm()->globalToCommRank(comm->commToGlobalRank(root));
+      first = prev = newBcast(smp_root, buf, nelems, type_size, 1<<28 | tag, cq_id, comm->smpComm());
+    }
+    if (comm->ownerComm()){
+      auto* inter = newBcast(root_owner, buf, nelems, type_size, 2<<28 | tag, cq_id, comm->ownerComm());
+      if (prev) prev->setSubsequent(inter);
+      else first = inter;
+      prev = inter;
+    }
+    if (!on_root_node){
+      auto* intra = newBcast(0, buf, nelems, type_size, 3<<28 | tag, cq_id, comm->smpComm());
+      if (prev) prev->setSubsequent(intra);
+      else first = intra;
+      prev = intra;
+    }
+    auto* final = new DoNothingCollective(this, tag, cq_id, comm);
+    prev->setSubsequent(final);
+    return startCollective(first);
+  }
+
+  DagCollective* coll = newBcast(root, buf, nelems, type_size, tag, cq_id, comm);
   return startCollective(coll);
 }
 
@@ -766,6 +905,24 @@ CollectiveEngine::alltoallv(void *dst, void *src, int* send_counts, int* recv_co
   return startCollective(coll);
 }
 
+AllgatherCollective*
+CollectiveEngine::newAllgather(void *dst, void *src, int nelems, int type_size, int tag,
+                               int cq_id, Communicator* comm)
+{
+  const std::string& type = selectAlgorithm(allgather_type_, large_allgather_type_,
+                                            uint64_t(nelems) * type_size * comm->nproc());
+  if (type == "bruck") {
+    return new BruckAllgatherCollective(this, dst, src, nelems, type_size, tag, cq_id, comm);
+  }
+  else if (type == "ring") {
+    return new RingAllgatherCollective(this, dst, src, nelems, type_size, tag, cq_id, comm);
+  }
+  else {
+    sst_hg_abort_printf("unrecognized allgather type %s", type.c_str());
+  }
+  return nullptr;
+}
+
 CollectiveDoneMessage*
 CollectiveEngine::allgather(void *dst, void *src, int nelems, int type_size, int tag,
                              int cq_id, Communicator* comm)
@@ -781,58 +938,28 @@ CollectiveEngine::allgather(void *dst, void *src, int nelems, int type_size, int
 
     int intra_tag = 1<<28 | tag;
 
-    AllgatherCollective* intra;
-    if (allgather_type_ == "bruck") {
-      intra = (AllgatherCollective*) new BruckAllgatherCollective(this, intraDst, src, nelems, type_size,
-                                                                intra_tag, cq_id, comm->smpComm());
-    }
-    else if (allgather_type_ == "ring") {
-      intra = (AllgatherCollective*) new RingAllgatherCollective(this, intraDst, src, nelems, type_size,
-                                                                intra_tag, cq_id, comm->smpComm());
-    }
-    else {
-      sst_hg_abort_printf("unrecognized allgather type");
-    }
+    AllgatherCollective* intra = newAllgather(intraDst, src, nelems, type_size,
+                                              intra_tag, cq_id, comm->smpComm());
 
     DagCollective* prev;
     if (comm->ownerComm()){
       int inter_tag = 2<<28 | tag;
-      AllgatherCollective* inter;
-      if (allgather_type_ == "bruck") {
-        intra = (AllgatherCollective*) new BruckAllgatherCollective(this, dst, intraDst, smpSize*nelems, type_size,
-                                                                  inter_tag, cq_id, comm->ownerComm());
-      }
-      else if (allgather_type_ == "ring") {
-        intra = (AllgatherCollective*) new RingAllgatherCollective(this, dst, intraDst, smpSize*nelems, type_size,
-                                                                 inter_tag, cq_id, comm->ownerComm());
-      }
-      else {
-        sst_hg_abort_printf("unrecognized allgather type");
-      }
+      AllgatherCollective* inter = newAllgather(dst, intraDst, smpSize*nelems, type_size,
+                                                inter_tag, cq_id, comm->ownerComm());
       intra->setSubsequent(inter);
       prev = inter;
     } else {
       prev = intra;
     }
     int bcast_tag = 3<<28 | tag;
-    auto* bcast = new BinaryTreeBcastCollective(this, 0, dst, comm->nproc()*nelems,
-                                                type_size, bcast_tag, cq_id, comm->smpComm());
+    auto* bcast = newBcast(0, dst, comm->nproc()*nelems, type_size, bcast_tag, cq_id, comm->smpComm());
     prev->setSubsequent(bcast);
     auto* final = new DoNothingCollective(this, tag, cq_id, comm);
     bcast->setSubsequent(final);
     return startCollective(intra);
   }
   else {
-    AllgatherCollective* coll;
-    if (allgather_type_ == "bruck") {
-      coll = (AllgatherCollective*) new BruckAllgatherCollective(this, dst, src, nelems, type_size, tag, cq_id, comm);
-    }
-    else if (allgather_type_ == "ring") {
-      coll = (AllgatherCollective*) new RingAllgatherCollective(this, dst, src, nelems, type_size, tag, cq_id, comm);
-    }
-    else {
-      sst_hg_abort_printf("unrecognized allgather type");
-    }
+    AllgatherCollective* coll = newAllgather(dst, src, nelems, type_size, tag, cq_id, comm);
     return startCollective(coll);
   }
   return nullptr;
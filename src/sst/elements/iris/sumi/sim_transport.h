@@ -193,6 +193,14 @@ class SimTransport : public Transport, public SST::Hg::Library {
 
   void incomingMessage(Message* msg);
 
+  /**
+   * @return The CPU time this rank has spent processing completions,
+   *         on the application thread or on its progress threads
+   */
+  SST::Hg::TimeDelta progressTime() const {
+    return progress_time_;
+  }
+
   void shutdownServer(int dest_rank, SST::Hg::NodeId dest_node, int dest_app);
 
   void pinRdma(uint64_t bytes);
@@ -216,7 +224,9 @@ class SimTransport : public Transport, public SST::Hg::Library {
   */
   Message* poll(bool blocking, int cq_id, double timeout = -1) override {
     configureNextPoll(blocking, timeout);
-    return default_progress_queue_.find(cq_id, blocking, timeout);
+    Message* m = default_progress_queue_.find(cq_id, blocking, timeout);
+    if (m) chargeProgress();
+    return m;
   }
 
   /**
@@ -229,7 +239,9 @@ class SimTransport : public Transport, public SST::Hg::Library {
   */
   Message* poll(bool blocking, double timeout = -1) override {
     configureNextPoll(blocking, timeout);
-    return default_progress_queue_.find_any(blocking, timeout);
+    Message* m = default_progress_queue_.find_any(blocking, timeout);
+    if (m) chargeProgress();
+    return m;
   }
 
   void setPragmaBlocking(bool cond, double timeout = -1){
@@ -280,6 +292,10 @@ class SimTransport : public Transport, public SST::Hg::Library {
   void send(Message* m) override;
   void send_packets(Message* m);
 
+  void deliverMessage(Message* m);
+
+  void chargeProgress();
+
   uint64_t allocateFlowId() override;
 
   std::vector<std::function<void(Message*)>> completion_queues_;
@@ -291,6 +307,11 @@ class SimTransport : public Transport, public SST::Hg::Library {
   SST::Hg::TimeDelta post_header_delay_;
   SST::Hg::TimeDelta poll_delay_;
 
+  /** With progress threads, when each of their cores is next free */
+  std::vector<SST::Hg::Timestamp> progress_free_;
+  SST::Hg::TimeDelta progress_time_;
+  bool progress_stats_;
+
 //  sstmac::StatSpyplot<int,uint64_t>* spy_bytes_;
 
   SST::Hg::TimeDelta rdma_pin_latency_;
@@ -281,6 +281,13 @@ class Transport {
                                SST::Hg::TimeDelta sync_delay, SST::Hg::TimeDelta active_delay,
                                SST::Hg::TimeDelta time_since_quiesce = SST::Hg::TimeDelta());
 
+  /**
+   * @brief logMessageSend
+   * Called for every message this rank puts on the network, before it leaves
+   * @param msg
+   */
+  virtual void logMessageSend(Message* msg);
+
 //  void startCollectiveMessageLog();
 
   SST::Hg::TimeDelta activeDelay(SST::Hg::Timestamp time);
@@ -319,6 +326,8 @@ class Transport {
 
 };
 
+class AllgatherCollective;
+
 class CollectiveEngine
 {
  public:
@@ -373,6 +382,15 @@ class CollectiveEngine
     use_put_protocol_ = flag;
   }
 
+  /**
+   * The size in bytes pipelined algorithms split their transfers into,
+   * 0 if every transfer is sent whole
+   * @return
+   */
+  uint64_t segmentSize() const {
+    return segment_size_;
+  }
+
   CollectiveDoneMessage* blockUntilNext(int cq_id);
 
   /**
@@ -533,6 +551,25 @@ class CollectiveEngine
 
   CollectiveDoneMessage* deliverPending(Collective* coll, int tag, Collective::type_t ty);
 
+  /**
+   * @brief The algorithm for a collective moving bytes in total
+   * @param small The algorithm below the large message cutoff
+   * @param large The algorithm at or above it
+   */
+  const std::string& selectAlgorithm(const std::string& small, const std::string& large,
+                                     uint64_t bytes) const {
+    return large_cutoff_ && bytes >= large_cutoff_ ? large : small;
+  }
+
+  DagCollective* newAllreduce(void* dst, void* src, int nelems, int type_size, int tag, reduce_fxn fxn,
+                              int cq_id, Communicator* comm);
+
+  DagCollective* newBcast(int root, void* buf, int nelems, int type_size, int tag,
+                          int cq_id, Communicator* comm);
+
+  AllgatherCollective* newAllgather(void* dst, void* src, int nelems, int type_size, int tag,
+                                    int cq_id, Communicator* comm);
+
  private:
   Transport* tport_;
 
@@ -559,6 +596,17 @@ class CollectiveEngine
 
   std::string alltoall_type_;
   std::string allgather_type_;
+  std::string allreduce_type_;
+  std::string bcast_type_;
+  std::string reduce_scatter_type_;
+
+  std::string large_allgather_type_;
+  std::string large_allreduce_type_;
+  std::string large_bcast_type_;
+  std::string large_reduce_scatter_type_;
+
+  uint64_t large_cutoff_;
+  uint64_t segment_size_;
 
   int rdma_header_qos_;
   int rdma_get_qos_;
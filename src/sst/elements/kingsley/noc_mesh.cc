@@ -21,6 +21,7 @@
 #include <sst/core/unitAlgebra.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <sstream>
 #include <string>
 
@@ -92,13 +93,40 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
 
     route_y_first = params.find<bool>("route_y_first",false);
 
+    std::string routing = params.find<std::string>("routing","dor");
+    if ( routing == "dor" ) {
+        route_odd_even = false;
+    }
+    else if ( routing == "odd_even" ) {
+        route_odd_even = true;
+    }
+    else {
+        output.fatal(CALL_INFO, -1, "noc_mesh: unknown routing algorithm: %s\n", routing.c_str());
+    }
+
+    express_hops = params.find<int>("express_hops",0);
+    if ( express_hops < 0 || express_hops == 1 ) {
+        output.fatal(CALL_INFO, -1, "noc_mesh: express_hops must be 0 or at least 2, got %d\n", express_hops);
+    }
+    if ( express_hops > 0 && route_odd_even ) {
+        output.fatal(CALL_INFO, -1, "noc_mesh: express links are only supported with dor routing\n");
+    }
+
+    smart_max_hops = params.find<int>("smart_max_hops",0);
+    if ( smart_max_hops < 0 ) {
+        output.fatal(CALL_INFO, -1, "noc_mesh: smart_max_hops must not be negative, got %d\n", smart_max_hops);
+    }
+    smart_bypass_turns = params.find<bool>("smart_bypass_turns",false);
+
     // Register the clock
     my_clock_handler = new Clock::Handler2<noc_mesh,&noc_mesh::clock_handler>(this);
     clock_tc = registerClock( clock_freq, my_clock_handler);
     clock_is_off = false;
 
     // Configure the ports
-    ports = new Link*[local_port_start + local_ports];
+    express_port_start = local_port_start + local_ports;
+    num_ports = express_port_start + num_express_ports;
+    ports = new Link*[num_ports];
 
     // Configure directional ports
     Event::HandlerBase* dummy_handler = new Event::Handler2<noc_mesh,&noc_mesh::handle_input_r2r,int>(this,-1);
@@ -106,9 +134,11 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
     last_time = 0;
 
     // Configure all the links and add all the statistics
-    send_bit_count = new Statistic<uint64_t>*[local_ports + 4];
-    output_port_stalls = new Statistic<uint64_t>*[local_ports + 4];
-    xbar_stalls = new Statistic<uint64_t>*[local_ports + 4];
+    send_bit_count = new Statistic<uint64_t>*[num_ports];
+    output_port_stalls = new Statistic<uint64_t>*[num_ports];
+    xbar_stalls = new Statistic<uint64_t>*[num_ports];
+    send_packet_count = new Statistic<uint64_t>*[num_ports];
+    bypass_packet_count = new Statistic<uint64_t>*[num_ports];
 
 
     // North port
@@ -117,6 +147,8 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
     send_bit_count[north_port] = registerStatistic<uint64_t>("send_bit_count","north");
     output_port_stalls[north_port] = registerStatistic<uint64_t>("output_port_stalls","north");
     xbar_stalls[north_port] = registerStatistic<uint64_t>("xbar_stalls","north");
+    send_packet_count[north_port] = registerStatistic<uint64_t>("send_packet_count","north");
+    bypass_packet_count[north_port] = registerStatistic<uint64_t>("bypass_packet_count","north");
 
     // South port
     ports[south_port] = configureLink("south", dummy_handler);
@@ -124,6 +156,8 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
     send_bit_count[south_port] = registerStatistic<uint64_t>("send_bit_count","south");
     output_port_stalls[south_port] = registerStatistic<uint64_t>("output_port_stalls","south");
     xbar_stalls[south_port] = registerStatistic<uint64_t>("xbar_stalls","south");
+    send_packet_count[south_port] = registerStatistic<uint64_t>("send_packet_count","south");
+    bypass_packet_count[south_port] = registerStatistic<uint64_t>("bypass_packet_count","south");
 
     // East port
     ports[east_port] = configureLink("east", dummy_handler);
@@ -131,6 +165,8 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
     send_bit_count[east_port] = registerStatistic<uint64_t>("send_bit_count","east");
     output_port_stalls[east_port] = registerStatistic<uint64_t>("output_port_stalls","east");
     xbar_stalls[east_port] = registerStatistic<uint64_t>("xbar_stalls","east");
+    send_packet_count[east_port] = registerStatistic<uint64_t>("send_packet_count","east");
+    bypass_packet_count[east_port] = registerStatistic<uint64_t>("bypass_packet_count","east");
 
     // West port
     ports[west_port] = configureLink("west", dummy_handler);
@@ -138,6 +174,8 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
     send_bit_count[west_port] = registerStatistic<uint64_t>("send_bit_count","west");
     output_port_stalls[west_port] = registerStatistic<uint64_t>("output_port_stalls","west");
     xbar_stalls[west_port] = registerStatistic<uint64_t>("xbar_stalls","west");
+    send_packet_count[west_port] = registerStatistic<uint64_t>("send_packet_count","west");
+    bypass_packet_count[west_port] = registerStatistic<uint64_t>("bypass_packet_count","west");
 
     // Configure local ports
     for ( int i = 0; i < local_ports; ++i ) {
@@ -152,18 +190,39 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
         send_bit_count[local_port_start + i] = registerStatistic<uint64_t>("send_bit_count",port_name.str());
         output_port_stalls[local_port_start + i] = registerStatistic<uint64_t>("output_port_stalls",port_name.str());
         xbar_stalls[local_port_start + i] = registerStatistic<uint64_t>("xbar_stalls",port_name.str());
+        send_packet_count[local_port_start + i] = registerStatistic<uint64_t>("send_packet_count",port_name.str());
+        bypass_packet_count[local_port_start + i] = registerStatistic<uint64_t>("bypass_packet_count",port_name.str());
+    }
+
+    // Configure express ports, in the same order as the mesh ports
+    const char* express_names[num_express_ports] = { "express_north", "express_south", "express_east", "express_west" };
+    for ( int i = 0; i < num_express_ports; ++i ) {
+        int port = express_port_start + i;
+        ports[port] = configureLink(express_names[i], dummy_handler);
+
+        // stats
+        send_bit_count[port] = registerStatistic<uint64_t>("send_bit_count",express_names[i]);
+        output_port_stalls[port] = registerStatistic<uint64_t>("output_port_stalls",express_names[i]);
+        xbar_stalls[port] = registerStatistic<uint64_t>("xbar_stalls",express_names[i]);
+        send_packet_count[port] = registerStatistic<uint64_t>("send_packet_count",express_names[i]);
+        bypass_packet_count[port] = registerStatistic<uint64_t>("bypass_packet_count",express_names[i]);
     }
 
 
-    // Allocate space for all the input buffers
-    port_queues = new port_queue_t[local_port_start + local_ports];
-    port_busy = new int[local_port_start + local_ports];
-    for ( int i = 0; i < local_port_start + local_ports; ++i ) {
+    // Allocate space for all the input buffers.  A packet is at least
+    // one flit, so the credits bound the number of queued packets
+    port_queues = new port_queue_t[num_ports];
+    for ( int i = 0; i < num_ports; ++i ) {
+        port_queues[i].reserve(input_buf_size/flit_size);
+    }
+    queued_packets = 0;
+    port_busy = new int[num_ports];
+    for ( int i = 0; i < num_ports; ++i ) {
         port_busy[i] = 0;
     }
 
-    port_credits = new int[local_port_start + local_ports];
-    for ( int i = 0; i < local_port_start + local_ports; ++i ) {
+    port_credits = new int[num_ports];
+    for ( int i = 0; i < num_ports; ++i ) {
         port_credits[i] = 0;
     }
 }
@@ -171,6 +230,12 @@ noc_mesh::noc_mesh(ComponentId_t cid, Params& params) :
 void
 noc_mesh::route(noc_mesh_event* event)
 {
+    event->alt_port = -1;
+    if ( route_odd_even ) {
+        route_odd_even_turn(event);
+        return;
+    }
+
     if ( route_y_first ) {
         // Compute next port
         if ( event->dest_mesh_loc.second > my_y ) {
@@ -212,6 +277,151 @@ noc_mesh::route(noc_mesh_event* event)
             }
         }
     }
+
+    // Use the express link in the direction of travel if there are
+    // enough hops left in this dimension
+    if ( express_hops > 0 && event->next_port < local_port_start ) {
+        int hops_left;
+        if ( event->next_port == north_port || event->next_port == south_port ) {
+            hops_left = abs(event->dest_mesh_loc.second - my_y);
+        }
+        else {
+            hops_left = abs(event->dest_mesh_loc.first - my_x);
+        }
+        if ( hops_left >= express_hops && ports[express_port_start + event->next_port] != NULL ) {
+            event->next_port = express_port_start + event->next_port;
+        }
+    }
+}
+
+// Minimal adaptive routing with the odd-even turn model [Chiu, TPDS
+// 2000]: east to north/south turns are not taken in even columns and
+// north/south to west turns are not taken in odd columns, which keeps
+// the network deadlock free without virtual channels.  When two
+// productive ports are allowed the second one is put in alt_port and
+// the choice is made when the packet reaches the head of its queue.
+void
+noc_mesh::route_odd_even_turn(noc_mesh_event* event)
+{
+    int dx = event->dest_mesh_loc.first - my_x;
+    int dy = event->dest_mesh_loc.second - my_y;
+    int y_port = dy > 0 ? north_port : south_port;
+
+    if ( dx == 0 ) {
+        event->next_port = dy == 0 ? event->egress_port : y_port;
+    }
+    else if ( dx > 0 ) {
+        if ( dy == 0 ) {
+            event->next_port = east_port;
+            return;
+        }
+        bool turn_ok = ( my_x % 2 == 1 ) || ( my_x == event->src_x );
+        bool east_ok = ( event->dest_mesh_loc.first % 2 == 1 ) || ( dx != 1 );
+        if ( turn_ok ) {
+            event->next_port = y_port;
+            if ( east_ok ) event->alt_port = east_port;
+        }
+        else {
+            event->next_port = east_port;
+        }
+    }
+    else {
+        event->next_port = west_port;
+        if ( dy != 0 && my_x % 2 == 0 ) event->alt_port = y_port;
+    }
+}
+
+bool
+noc_mesh::can_send(noc_mesh_event* event, int port)
+{
+    return port_busy[port] == 0 && port_credits[port] >= event->encap_ev->getSizeInFlits();
+}
+
+// Returns the direction of a mesh or express port, -1 for local ports
+int
+noc_mesh::port_direction(int port)
+{
+    if ( port < local_port_start ) return port;
+    if ( port >= express_port_start ) return port - express_port_start;
+    return -1;
+}
+
+void
+noc_mesh::send_event(noc_mesh_event* event, int in_port, int port)
+{
+    int trace_id = event->encap_ev->request->getTraceID();
+    int vn = event->encap_ev->vn;
+    SST::Interfaces::SimpleNetwork::nid_t src = event->encap_ev->request->src;
+    SST::Interfaces::SimpleNetwork::nid_t dest = event->encap_ev->request->dest;
+    SST::Interfaces::SimpleNetwork::Request::TraceType ttype = event->encap_ev->request->getTraceType();
+    int flits = event->encap_ev->getSizeInFlits();
+
+    port_credits[port] -= flits;
+    port_busy[port] = flits;
+    send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
+    send_packet_count[port]->addData(1);
+    if ( edge_status & ( 1 << port) ) {
+        ports[port]->send(event->encap_ev);
+        event->encap_ev = NULL;
+        delete event;
+    }
+    else {
+        ports[port]->send(event);
+    }
+    if ( ttype == SimpleNetwork::Request::FULL ) {
+        output.output("TRACE(%d): %" PRIu64 " ns: Sent an event to router from router: (%d,%d)"
+                      " (%s) on VC %d from src %" PRIu64 " to dest %" PRIu64 ".\n",
+                      trace_id,
+                      getCurrentSimTimeNano(),
+                      my_x, my_y,
+                      getName().c_str(),
+                      vn,
+                      src,
+                      dest);
+    }
+    // Need to send credit event back to last router
+    credit_event* cr_ev = new credit_event(0, flits);
+    ports[in_port]->send(cr_ev);
+}
+
+// SMART style bypass: a packet arriving from another router is sent on
+// right away, without waiting in the input buffer for the next clock,
+// if its output port is free and no buffered packet is waiting for it.
+// After smart_max_hops bypassed routers the packet has to be buffered.
+bool
+noc_mesh::try_bypass(noc_mesh_event* event, int in_port)
+{
+    if ( event->bypass_hops >= smart_max_hops ) return false;
+
+    // Keep packets from the same input in order
+    if ( !port_queues[in_port].empty() ) return false;
+
+    // Bring the busy counts up to date
+    if ( clock_is_off ) clock_wakeup();
+
+    int port = event->next_port;
+    if ( !can_send(event, port) ) {
+        if ( event->alt_port == -1 || !can_send(event, event->alt_port) ) return false;
+        port = event->alt_port;
+    }
+
+    bool ejecting = event->dest_mesh_loc.first == my_x && event->dest_mesh_loc.second == my_y;
+    bool straight = port_direction(in_port) != -1 && port_direction(port) == ( port_direction(in_port) ^ 1 );
+    if ( !straight && !ejecting && !smart_bypass_turns ) return false;
+
+    // Buffered packets go first
+    for ( int i = 0; i < num_ports; ++i ) {
+        if ( !port_queues[i].empty() ) {
+            noc_mesh_event* head = port_queues[i].front();
+            if ( head->next_port == port || head->alt_port == port ) return false;
+        }
+    }
+
+    event->next_port = port;
+    event->bypass_hops++;
+    bypass_packet_count[port]->addData(1);
+    send_event(event, in_port, port);
+    return true;
 }
 
 
@@ -228,6 +438,9 @@ noc_mesh::handle_input_r2r(Event* ev, int port)
         port_credits[port] += credit_ret->credits;
         // output.output("(%d,%d): Got credit event for VN %d with %d credits\n",my_x,my_y,credit_ret->vn,credit_ret->credits);
         delete ev;
+        // Packets may have been waiting for these credits
+        if (clock_is_off && queued_packets > 0)
+            clock_wakeup();
         break;
     }
     case BaseNocEvent::INTERNAL:
@@ -236,8 +449,12 @@ noc_mesh::handle_input_r2r(Event* ev, int port)
 
         route(event);
 
+        if ( smart_max_hops > 0 && try_bypass(event, port) ) break;
+        event->bypass_hops = 0;
+
         // Put the event into the proper queue
         port_queues[port].push(event);
+        queued_packets++;
         if (clock_is_off)
             clock_wakeup();
         break;
@@ -252,6 +469,7 @@ noc_mesh_event*
 noc_mesh::wrap_incoming_packet(NocPacket* packet) {
     // Wrap the incoming NocPacket in a noc_mesh_event
     noc_mesh_event* event = new noc_mesh_event(packet);
+    event->src_x = my_x;
 
     // Compute the destination router
     int dest = packet->request->dest;
@@ -319,6 +537,9 @@ noc_mesh::handle_input_ep2r(Event* ev, int port)
         credit_event* credit_ret = static_cast<credit_event*>(ev);
         port_credits[port] += credit_ret->credits;
         delete ev;
+        // Packets may have been waiting for these credits
+        if (clock_is_off && queued_packets > 0)
+            clock_wakeup();
         break;
     }
     case BaseNocEvent::PACKET:
@@ -331,6 +552,7 @@ noc_mesh::handle_input_ep2r(Event* ev, int port)
 
         // Need to put the event into the proper queue
         port_queues[port].push(event);
+        queued_packets++;
         if (clock_is_off)
             clock_wakeup();
         break;
@@ -355,10 +577,17 @@ void noc_mesh::clock_wakeup() {
     Cycle_t time = reregisterClock(clock_tc, my_clock_handler);
     Cycle_t cyclesOff = time - last_time - 1;
     // Update busy values
-    for ( int i = 0; i < local_port_start + local_ports; ++i) {
+    for ( int i = 0; i < num_ports; ++i) {
         port_busy[i] = (port_busy[i] < cyclesOff) ? 0 : port_busy[i] - cyclesOff;
     }
 
+    // Heads that were waiting for credits stalled through all the
+    // cycles the clock was off
+    for ( int port : credit_stalled_ports ) {
+        output_port_stalls[port]->addData(cyclesOff);
+    }
+    credit_stalled_ports.clear();
+
     // unsigned int local_progress = (cyclesOff * local_lru.size()) % (local_lru.size() * 2);
     // unsigned int mesh_progress = (cyclesOff * mesh_lru.size()) % (mesh_lru.size() * 2);
     // // Update lru info
@@ -376,7 +605,7 @@ noc_mesh::clock_handler(Cycle_t cycle)
     last_time = cycle;
     // TraceFunction trace(CALL_INFO);
     // Decrement all the busy values
-    for ( int i = 0; i < local_port_start + local_ports; ++i ) {
+    for ( int i = 0; i < num_ports; ++i ) {
         port_busy[i]--;
         if (port_busy[i] < 0) port_busy[i] = 0;
     }
@@ -394,8 +623,13 @@ noc_mesh::clock_handler(Cycle_t cycle)
                 // noc_mesh_event* event = port_queues[local_port_start + i].front();
                 noc_mesh_event* event = port_queues[lru_port].front();
 
-                // Get the next port
+                // Get the next port.  With adaptive routing, use the
+                // other productive port if the first can't send now
                 int port = event->next_port;
+                if ( event->alt_port != -1 && !can_send(event, port) && can_send(event, event->alt_port) ) {
+                    port = event->alt_port;
+                    event->next_port = port;
+                }
 
                 // Check to see if the port is busy
                 if ( port_busy[port] > 0 ) {
@@ -408,47 +642,22 @@ noc_mesh::clock_handler(Cycle_t cycle)
                 // Check to see if there are enough credits to send on
                 // that port
                 if ( port_credits[port] >= event->encap_ev->getSizeInFlits() ) {
-                    int trace_id = event->encap_ev->request->getTraceID();
-                    int vn = event->encap_ev->vn;
-                    SST::Interfaces::SimpleNetwork::nid_t src = event->encap_ev->request->src;
-                    SST::Interfaces::SimpleNetwork::nid_t dest = event->encap_ev->request->dest;
-                    SST::Interfaces::SimpleNetwork::Request::TraceType ttype = event->encap_ev->request->getTraceType();
-                    int flits = event->encap_ev->getSizeInFlits();
-
                     // port_queues[local_port_start + i].pop();
                     port_queues[lru_port].pop();
-                    port_credits[port] -= event->encap_ev->getSizeInFlits();
-                    port_busy[port] = event->encap_ev->getSizeInFlits();
-                    if ( edge_status & ( 1 << port) ) {
-                        ports[port]->send(event->encap_ev);
-                        send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
-                        event->encap_ev = NULL;
-                        delete event;
-                    }
-                    else {
-                        ports[port]->send(event);
-                        send_bit_count[port]->addData(event->encap_ev->request->size_in_bits);
-                    }
-                    if ( ttype == SimpleNetwork::Request::FULL ) {
-                        output.output("TRACE(%d): %" PRIu64 " ns: Sent an event to router from router: (%d,%d)"
-                                      " (%s) on VC %d from src %" PRIu64 " to dest %" PRIu64 ".\n",
-                                      trace_id,
-                                      getCurrentSimTimeNano(),
-                                      my_x, my_y,
-                                      getName().c_str(),
-                                      vn,
-                                      src,
-                                      dest);
-                    }
-                    // Need to send credit event back to last router
-                    credit_event* cr_ev = new credit_event(0, flits);
-                    // ports[local_port_start + i]->send(cr_ev);
-                    ports[lru_port]->send(cr_ev);
+                    queued_packets--;
+                    send_event(event, lru_port, port);
                     lru.satisfied(true);
                 }
                 else {
                     output_port_stalls[port]->addData(1);
                     lru.satisfied(false);
+                    // Only a credit event can unblock this head, so it
+                    // does not need the clock unless it can route
+                    // around the port
+                    if ( event->alt_port == -1 ) {
+                        credit_stalled_ports.push_back(port);
+                        continue;
+                    }
                 }
                 if (!port_queues[lru_port].empty())
                     keepClockOn = true;
@@ -461,6 +670,7 @@ noc_mesh::clock_handler(Cycle_t cycle)
 
     // }
     clock_is_off = !keepClockOn;
+    if ( keepClockOn ) credit_stalled_ports.clear();
 
     // Stay on clock list
     return !keepClockOn;
@@ -500,6 +710,11 @@ void noc_mesh::setup()
             lru_units.back().insert(i);
         }
     }
+    for ( int i = express_port_start; i < num_ports; ++i ) {
+        if ( ports[i] != NULL ) {
+            lru_units.back().insert(i);
+        }
+    }
     lru_units.back().finalize();
 }
 
@@ -561,7 +776,7 @@ noc_mesh::init(unsigned int phase)
     {
         // Look through all the links to see which have endpoints
         // attached or have no links attached
-        for ( int i = 0; i < local_port_start + local_ports; ++i ) {
+        for ( int i = 0; i < num_ports; ++i ) {
             if ( ports[i] == NULL ) {
                 edge_status |=  ( 1 << i );
             }
@@ -1047,7 +1262,7 @@ noc_mesh::init(unsigned int phase)
     case 9:
     {
 
-        for ( int i = 0; i < local_port_start + local_ports; ++i ) {
+        for ( int i = 0; i < num_ports; ++i ) {
             if ( ports[i] != NULL ) {
                 credit_event* cr_ev = new credit_event(0,input_buf_size/flit_size);
                 ports[i]->sendUntimedData(cr_ev);
@@ -1060,7 +1275,7 @@ noc_mesh::init(unsigned int phase)
     case 10:
     {
         // Receive credits
-        for ( int i = 0; i < local_port_start + local_ports; ++i ) {
+        for ( int i = 0; i < num_ports; ++i ) {
             if ( ports[i] != NULL ) {
                 credit_event* cr_ev = static_cast<credit_event*>(ports[i]->recvUntimedData());
                 port_credits[i] += cr_ev->credits;
@@ -1072,7 +1287,7 @@ noc_mesh::init(unsigned int phase)
     }
     default:
         // Simply route messages that are sent by the endpoints
-        for ( int i = 0; i < local_port_start + local_ports; ++i ) {
+        for ( int i = 0; i < num_ports; ++i ) {
             if ( ports[i] != NULL ) {
                 bool endpoint = (1 << i) & endpoint_locations;
                 while ( true ) { // Go until there are no more events
@@ -1200,7 +1415,7 @@ void
 noc_mesh::complete(unsigned int phase)
 {
     // Simply route messages that are sent by the endpoints
-    for ( int i = 0; i < local_port_start + local_ports; ++i ) {
+    for ( int i = 0; i < num_ports; ++i ) {
         if ( ports[i] != NULL ) {
             bool endpoint = (1 << i) & endpoint_locations;
             while ( true ) { // Go until there are no more events
@@ -1341,6 +1556,11 @@ noc_mesh::printStatus(Output& out)
         vec.push_back(std::make_pair(str,i+local_port_start));
     }
 
+    for ( int i = 0; i < num_express_ports; ++i ) {
+        std::string str = "express_port" + std::to_string(i);
+        vec.push_back(std::make_pair(str,i+express_port_start));
+    }
+
     // Add local ports
 
     for ( auto& pinfo : vec ) {
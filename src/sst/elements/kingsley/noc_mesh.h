@@ -31,6 +31,7 @@
 
 #include "sst/elements/kingsley/nocEvents.h"
 #include "sst/elements/kingsley/lru_unit.h"
+#include "sst/elements/kingsley/ring_queue.h"
 
 using namespace SST;
 
@@ -60,6 +61,10 @@ public:
         {"port_priority_equal","Set to true to have all port have equal priority (usually endpoint ports have higher priority).","false"},
         {"route_y_first",      "Set to true to rout Y-dimension first.","false"},
         {"use_dense_map",      "Set to true to have a dense network id map instead of the sparse map normally used.","false"},
+        {"routing",            "Routing algorithm: dor (dimension order, see route_y_first) or odd_even (minimal adaptive odd-even turn model).","dor"},
+        {"express_hops",       "Number of routers spanned by the express links, 0 for no express links. A packet with at least that many hops left in its current dimension takes the express link if it is connected. Only used with dor routing.","0"},
+        {"smart_max_hops",     "Maximum number of consecutive routers a packet can bypass without being buffered (SMART style), 0 disables bypass.","0"},
+        {"smart_bypass_turns", "Set to true to let packets that change direction bypass a router, otherwise only packets going straight bypass.","false"},
         // {"network_inspectors", "Comma separated list of network inspectors to put on output ports.", ""},
     )
 
@@ -68,12 +73,17 @@ public:
         { "south", "South port", {} },
         { "east",  "East port",  {} },
         { "west",  "West port",  {} },
-        {"local%(local_ports)d",  "Ports which connect to endpoints.", { } }
+        {"local%(local_ports)d",  "Ports which connect to endpoints.", { } },
+        { "express_north", "North express port, connects to the router express_hops to the north", {} },
+        { "express_south", "South express port, connects to the router express_hops to the south", {} },
+        { "express_east",  "East express port, connects to the router express_hops to the east",  {} },
+        { "express_west",  "West express port, connects to the router express_hops to the west",  {} }
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
         { "send_bit_count",     "Count number of bits sent on link", "bits", 1},
-        // { "send_packet_count",  "Count number of packets sent on link", "packets", 1},
+        { "send_packet_count",  "Count number of packets sent on link", "packets", 1},
+        { "bypass_packet_count", "Count number of packets sent on link that bypassed the router buffers", "packets", 1},
         { "output_port_stalls", "Time output port is stalled (in units of core timebase)", "time in stalls", 1},
         { "xbar_stalls",        "Count number of cycles the xbar is stalled", "cycles", 1},
         // { "idle_time",          "Amount of time spent idle for a given port", "units of core timebase", 1},
@@ -90,6 +100,10 @@ public:
     static const int east_mask = 1 << east_port;
     static const int west_mask = 1 << west_port;
 
+    // Express ports follow the local ports and are in the same order as
+    // the mesh ports
+    static const int num_express_ports = 4;
+
 private:
 
     int init_state;
@@ -109,15 +123,28 @@ private:
     int my_y;
 
     bool route_y_first;
+    bool route_odd_even;
+    int express_hops;
+    int smart_max_hops;
+    bool smart_bypass_turns;
+
+    // Index of the first express port and total number of ports
+    int express_port_start;
+    int num_ports;
 
 
-    typedef std::queue<noc_mesh_event*> port_queue_t;
+    typedef ring_queue<noc_mesh_event*> port_queue_t;
 
     Clock::HandlerBase* my_clock_handler;
     TimeConverter clock_tc;
     void clock_wakeup();
     bool clock_is_off;
     Cycle_t last_time = 0;
+    // Packets in all the input queues
+    int queued_packets;
+    // Output ports the queue heads were waiting on for credits when the
+    // clock turned off, one entry per head
+    std::vector<int> credit_stalled_ports;
 
     Link** ports;
     port_queue_t* port_queues;
@@ -142,11 +169,18 @@ private:
     void handle_input_ep2r(Event* ev, int port);
 
     void route(noc_mesh_event* event);
+    void route_odd_even_turn(noc_mesh_event* event);
+    int port_direction(int port);
+    bool can_send(noc_mesh_event* event, int port);
+    void send_event(noc_mesh_event* event, int in_port, int port);
+    bool try_bypass(noc_mesh_event* event, int in_port);
 
 
     Statistic<uint64_t>** send_bit_count;
     Statistic<uint64_t>** output_port_stalls;
     Statistic<uint64_t>** xbar_stalls;
+    Statistic<uint64_t>** send_packet_count;
+    Statistic<uint64_t>** bypass_packet_count;
     // Statistic<uint64_t>** xbar_stalls_prioirty;
     // Statistic<uint64_t>** xbar_stalls_normal;
     // Statistic<uint64_t>** output_idle;
@@ -178,16 +212,28 @@ public:
     int egress_port;
 
     int next_port;
+    // Second productive port allowed by adaptive routing, -1 if none
+    int alt_port;
+    // Column of the first router, used by odd-even routing
+    int src_x;
+    // Routers bypassed since the packet was last buffered
+    int bypass_hops;
     NocPacket* encap_ev;
 
     noc_mesh_event() :
-        BaseNocEvent(BaseNocEvent::INTERNAL)
+        BaseNocEvent(BaseNocEvent::INTERNAL),
+        alt_port(-1),
+        src_x(0),
+        bypass_hops(0)
     {
         encap_ev = NULL;
     }
 
     noc_mesh_event(NocPacket* ev) :
-        BaseNocEvent(BaseNocEvent::INTERNAL)
+        BaseNocEvent(BaseNocEvent::INTERNAL),
+        alt_port(-1),
+        src_x(0),
+        bypass_hops(0)
     {encap_ev = ev;}
 
     virtual ~noc_mesh_event() {
@@ -199,6 +245,9 @@ public:
         ret->dest_mesh_loc = dest_mesh_loc;
         ret->egress_port = egress_port;
         ret->next_port = next_port;
+        ret->alt_port = alt_port;
+        ret->src_x = src_x;
+        ret->bypass_hops = bypass_hops;
         ret->encap_ev = encap_ev->clone();
         return ret;
     }
@@ -208,6 +257,9 @@ public:
         SST_SER(dest_mesh_loc);
         SST_SER(egress_port);
         SST_SER(next_port);
+        SST_SER(alt_port);
+        SST_SER(src_x);
+        SST_SER(bypass_hops);
         SST_SER(encap_ev);
     }
 
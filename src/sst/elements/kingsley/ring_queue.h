@@ -0,0 +1,83 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_KINGSLEY_RING_QUEUE_H
+#define COMPONENTS_KINGSLEY_RING_QUEUE_H
+
+#include <vector>
+
+namespace SST {
+namespace Kingsley {
+
+// FIFO in a fixed size ring buffer.  Input buffers are bounded by
+// the credits handed out, so the capacity is set once from the buffer
+// size and the ring only grows if it is ever pushed past it.
+template<typename T>
+class ring_queue {
+
+    std::vector<T> data;
+    size_t head;
+    size_t count;
+
+    void grow() {
+        std::vector<T> bigger(data.empty() ? 4 : data.size() * 2);
+        for ( size_t i = 0; i < count; ++i ) {
+            bigger[i] = data[(head + i) % data.size()];
+        }
+        data.swap(bigger);
+        head = 0;
+    }
+
+public:
+    ring_queue() : head(0), count(0)
+    {
+    }
+
+    // Sets the capacity, only valid while the queue is empty
+    void reserve(size_t capacity) {
+        data.resize(capacity);
+        head = 0;
+    }
+
+    void push(const T& value) {
+        if ( count == data.size() ) grow();
+        data[(head + count) % data.size()] = value;
+        count++;
+    }
+
+    void pop() {
+        head = (head + 1) % data.size();
+        count--;
+    }
+
+    T& front() {
+        return data[head];
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+};
+
+}
+}
+
+#endif // COMPONENTS_KINGSLEY_RING_QUEUE_H
@@ -24,6 +24,7 @@
 #include "vertex.h"
 
 #include <map>
+#include <queue>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -41,6 +42,16 @@ private:
     uint32_t vertices_;
     std::map< uint32_t, Vertex< T > >* vertex_map_;
 
+    // Compact (CSR) copy of the graph for walking it every cycle
+    // Vertices are renumbered densely in id order, the out edges of dense
+    // vertex i are csr_edges_[csr_offsets_[i]] to csr_edges_[csr_offsets_[i + 1]]
+    bool csr_valid_;
+    std::vector< uint32_t > csr_offsets_;
+    std::vector< uint32_t > csr_edges_;
+    std::vector< uint32_t > csr_ids_;
+    std::vector< Vertex< T >* > csr_vertices_;
+    std::map< uint32_t, uint32_t > csr_index_;
+
 protected:
 
 public:
@@ -70,6 +81,16 @@ public:
 
     std::map< uint32_t, Vertex<T> >* getVertexMap( void ) const;
 
+    // CSR view, rebuild after the graph has been changed
+    void buildCSR();
+    bool hasCSR() const { return csr_valid_; }
+    uint32_t csrIndex( uint32_t vertexNum ) const { return csr_index_.at(vertexNum); }
+    uint32_t csrId( uint32_t index ) const { return csr_ids_[index]; }
+    Vertex<T>* csrVertex( uint32_t index ) const { return csr_vertices_[index]; }
+    const uint32_t* csrBegin( uint32_t index ) const { return csr_edges_.data() + csr_offsets_[index]; }
+    const uint32_t* csrEnd( uint32_t index ) const { return csr_edges_.data() + csr_offsets_[index + 1]; }
+    std::vector< uint32_t > csrBfsOrder( uint32_t rootVertex ) const;
+
 };
 
 template<class T>
@@ -77,6 +98,7 @@ LlyrGraph<T>::LlyrGraph()
 {
     vertex_map_ = new std::map< uint32_t, Vertex<T> >;
     vertices_ = 0;
+    csr_valid_ = 0;
 }
 
 template<class T>
@@ -233,6 +255,7 @@ bool LlyrGraph<T>::addEdge( uint32_t beginVertex, uint32_t endVertex )
     Edge* edge = new Edge( endVertex );
 
     if( vertex_map_->at(beginVertex).addEdge(edge) ) {
+        csr_valid_ = 0;
         #ifdef GRAPH_DEBUG
         std::cout << "add edge:  " << beginVertex << " --> " << endVertex << "\n" << std::endl;
         #endif
@@ -251,6 +274,7 @@ bool LlyrGraph<T>::addEdge( uint32_t beginVertex, uint32_t endVertex, EdgeProper
     Edge* edge = new Edge( properties, endVertex );
 
     if( vertex_map_->at(beginVertex).addEdge(edge) ) {
+        csr_valid_ = 0;
         #ifdef GRAPH_DEBUG
         std::cout << "add edge:  " << beginVertex << " --> " << endVertex << "\n" << std::endl;
         #endif
@@ -278,6 +302,7 @@ uint32_t LlyrGraph<T>::addVertex(T type)
         ///TODO
     }
 
+    csr_valid_ = 0;
     vertices_ = vertices_ + 1;
     return vertexNum;
 }
@@ -297,6 +322,7 @@ uint32_t LlyrGraph<T>::addVertex(uint32_t vertexNum, T type)
         ///TODO
     }
 
+    csr_valid_ = 0;
     vertices_ = vertices_ + 1;
     return vertexNum;
 }
@@ -311,6 +337,7 @@ template<class T>
 void LlyrGraph<T>::setVertex( uint32_t vertexNum, const Vertex<T> &vertex )
 {
     vertex_map_->at(vertexNum) = vertex;
+    csr_valid_ = 0;
 }
 
 template<class T>
@@ -329,6 +356,63 @@ std::map< uint32_t, Vertex<T> >* LlyrGraph<T>::getVertexMap( void ) const
     return vertex_map_;
 }
 
+template<class T>
+void LlyrGraph<T>::buildCSR( void )
+{
+    csr_offsets_.clear();
+    csr_edges_.clear();
+    csr_ids_.clear();
+    csr_vertices_.clear();
+    csr_index_.clear();
+
+    csr_offsets_.reserve(vertex_map_->size() + 1);
+    csr_ids_.reserve(vertex_map_->size());
+    csr_vertices_.reserve(vertex_map_->size());
+    for( auto vertexIterator = vertex_map_->begin(); vertexIterator != vertex_map_->end(); ++vertexIterator ) {
+        csr_index_.emplace( vertexIterator->first, csr_ids_.size() );
+        csr_ids_.push_back(vertexIterator->first);
+        csr_vertices_.push_back(&vertexIterator->second);
+    }
+
+    for( auto vertexIterator = vertex_map_->begin(); vertexIterator != vertex_map_->end(); ++vertexIterator ) {
+        csr_offsets_.push_back(csr_edges_.size());
+        std::vector< Edge* >* adjacencyList = vertexIterator->second.getAdjacencyList();
+        for( auto it = adjacencyList->begin(); it != adjacencyList->end(); ++it ) {
+            csr_edges_.push_back(csr_index_.at((*it)->getDestination()));
+        }
+    }
+    csr_offsets_.push_back(csr_edges_.size());
+
+    csr_valid_ = 1;
+}
+
+// Dense indices of the vertices reachable from rootVertex, in BFS order
+template<class T>
+std::vector< uint32_t > LlyrGraph<T>::csrBfsOrder( uint32_t rootVertex ) const
+{
+    std::vector< uint32_t > order;
+    std::vector< bool > visited(csr_ids_.size(), 0);
+    std::queue< uint32_t > nodeQueue;
+
+    uint32_t root = csrIndex(rootVertex);
+    visited[root] = 1;
+    nodeQueue.push(root);
+    while( nodeQueue.empty() == 0 ) {
+        uint32_t currentNode = nodeQueue.front();
+        nodeQueue.pop();
+        order.push_back(currentNode);
+
+        for( const uint32_t* it = csrBegin(currentNode); it != csrEnd(currentNode); ++it ) {
+            if( visited[*it] == 0 ) {
+                visited[*it] = 1;
+                nodeQueue.push(*it);
+            }
+        }
+    }
+
+    return order;
+}
+
 } // namespace LLyr
 } // namespace SST
 
@@ -113,13 +113,17 @@ LlyrComponent::LlyrComponent(ComponentId_t id, Params& params) :
     constructSoftwareGraph(swFileName);
 
     //do the mapping
-    Params mapperParams;    //empty but needed for loadModule API
+    Params mapperParams = params.get_scoped_params("mapper");
     std::string mapperName = params.find<std::string>("mapper", "llyr.mapper.simple");
     llyr_mapper_ = loadModule<LlyrMapper>(mapperName, mapperParams);
     output_->verbose(CALL_INFO, 1, 0, "Mapping application to hardware with %s\n", mapperName.c_str());
     llyr_mapper_->mapGraph(hardwareGraph_, applicationGraph_, mappedGraph_, configData_);
     mappedGraph_.printDotHardware("llyr_mapped.dot");
 
+    //the mapped graph is fixed from here on, so the order PEs are visited in is as well
+    mappedGraph_.buildCSR();
+    tick_order_ = mappedGraph_.csrBfsOrder(0);
+
     //init stats
     zeroEventCycles_ = registerStatistic< uint64_t >("cycles_zero_events");
     eventCycles_ = registerStatistic< uint64_t >("cycles_events");
@@ -220,53 +224,27 @@ bool LlyrComponent::tick(SST::Cycle_t currentCycle)
     }
 
     compute_complete = 0;
-    //On each tick perform BFS on graph and compute based on operand availability
-    //NOTE node0 is a dummy node to simplify the algorithm
-    std::queue< uint32_t > nodeQueue;
-
+    //On each tick visit the PE graph in BFS order and compute based on operand availability
+    //NOTE node0 is a dummy node to simplify the algorithm, it is always the entry point
+    //The BFS order was computed once from the CSR graph after mapping
     output_->verbose(CALL_INFO, 1, 0, "Device clock tick\n");
 
-    //Mark all nodes in the PE graph un-visited
-    std::map< uint32_t, Vertex< ProcessingElement* > >* vertex_map_ = mappedGraph_.getVertexMap();
-    typename std::map< uint32_t, Vertex< ProcessingElement* > >::iterator vertexIterator;
-    for(vertexIterator = vertex_map_->begin(); vertexIterator != vertex_map_->end(); ++vertexIterator) {
-        vertexIterator->second.setVisited(0);
-    }
-
-    //Node 0 is a dummy node and is always the entry point
-    nodeQueue.push(0);
-
-    //BFS and do operations if values available in input queues
-    while( nodeQueue.empty() == 0 ) {
-        uint32_t currentNode = nodeQueue.front();
-        nodeQueue.pop();
-
-        std::vector< Edge* >* adjacencyList = vertex_map_->at(currentNode).getAdjacencyList();
-
-        //set visited for bfs
-        vertex_map_->at(currentNode).setVisited(1);
+    //do operations if values available in input queues
+    for( auto it = tick_order_.begin(); it != tick_order_.end(); ++it ) {
+        ProcessingElement* currentPe = mappedGraph_.csrVertex(*it)->getValue();
 
         //send n responses from L/S unit to destination
         doLoadStoreOps(ls_entries_);
 
         //Let the PE decide whether or not it can do the compute
-        vertex_map_->at(currentNode).getValue()->doCompute();
+        currentPe->doCompute();
 
         //send one item from each output queue to destination
-        vertex_map_->at(currentNode).getValue()->doSend();
+        currentPe->doSend();
 
-        compute_complete = compute_complete | vertex_map_->at(currentNode).getValue()->getPendingOp();
+        compute_complete = compute_complete | currentPe->getPendingOp();
         output_->verbose(CALL_INFO, 1, 0, "PE(%" PRIu32 ") pending: %" PRIu32 " status: %" PRIu32 "\n\n",
-                        currentNode, vertex_map_->at(currentNode).getValue()->getPendingOp(), compute_complete );
-
-        //add the destination vertices from this node to the node queue
-        for( auto it = adjacencyList->begin(); it != adjacencyList->end(); it++ ) {
-            uint32_t destinationVertx = (*it)->getDestination();
-            if( vertex_map_->at(destinationVertx).getVisited() == 0 ) {
-                vertex_map_->at(destinationVertx).setVisited(1);
-                nodeQueue.push(destinationVertx);
-            }
-        }
+                        mappedGraph_.csrId(*it), currentPe->getPendingOp(), compute_complete );
     }
 
     // return false so we keep going
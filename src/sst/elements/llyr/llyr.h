@@ -59,6 +59,7 @@ public:
         { "application",    "Application in affine IR", "app.in" },
         { "hardware_graph", "Hardware connectivity graph", "grid.cfg" },
         { "mapping_tool",   "External mapping tool", "" },
+        { "mapper",         "Mapper module, parameters are scoped as mapper.*", "llyr.mapper.simple" },
         { "mem_init",       "Memory initialization file", "" },
         { "ls_entries",     "Number of L/S entries to process each tick", "1" },
         { "queue_depth",    "Number of buffer elements", "256" },
@@ -148,6 +149,7 @@ private:
     LlyrGraph< opType > hardwareGraph_;
     LlyrGraph< AppNode > applicationGraph_;
     LlyrGraph< ProcessingElement* > mappedGraph_;
+    std::vector< uint32_t > tick_order_;    // dense mapped graph vertices in BFS order from node 0
 
     LlyrMapper* llyr_mapper_;
 
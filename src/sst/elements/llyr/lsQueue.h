@@ -23,6 +23,7 @@
 #include <map>
 #include <queue>
 #include <bitset>
+#include <unordered_map>
 #include <utility>
 #include <cstdint>
 
@@ -109,6 +110,7 @@ public:
         memory_queue_.pop();
         auto entry = pending_.find( id );
         if( entry != pending_.end() ) {
+            delete entry->second;
             pending_.erase(entry);
         }
     }
@@ -155,7 +157,7 @@ private:
     SST::Output* output_;
 
     std::queue< StandardMem::Request::id_t > memory_queue_;
-    std::map< StandardMem::Request::id_t, LSEntry* > pending_;
+    std::unordered_map< StandardMem::Request::id_t, LSEntry* > pending_;
 
 }; // LSQueue
 
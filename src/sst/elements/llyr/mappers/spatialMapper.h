@@ -0,0 +1,600 @@
+// Copyright 2013-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _SPATIAL_MAPPER_H
+#define _SPATIAL_MAPPER_H
+
+#include <set>
+#include <cmath>
+#include <queue>
+#include <random>
+#include <limits>
+#include <vector>
+#include <sstream>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+
+#include "mappers/llyrMapper.h"
+
+namespace SST {
+namespace Llyr {
+
+/*
+ * Places the application on the hardware graph with simulated annealing,
+ * minimizing the hop distance of the application edges. Then routes every
+ * edge over the hardware links with a congestion aware shortest path.
+ * Each hop of a route becomes a BUFFER PE, so distance costs a cycle per
+ * hop. Reconvergent paths are optionally padded with extra hops so their
+ * tokens arrive together, which is how a modulo schedule keeps a pipelined
+ * loop at its initiation interval without relying on deep queues.
+ *
+ * Nodes are numbered and their queues bound in the same order as the simple
+ * mapper, so applications written for it keep their operand order.
+ */
+class SpatialMapper : public LlyrMapper
+{
+
+public:
+    explicit SpatialMapper(Params& params) :
+        LlyrMapper()
+    {
+        moves_per_node_    = params.find< uint32_t >("moves_per_node", 200);
+        start_temperature_ = params.find< double >("start_temperature", 4.0);
+        cooling_           = params.find< double >("cooling", 0.999);
+        congestion_weight_ = params.find< double >("congestion_weight", 2.0);
+        balance_paths_     = params.find< bool >("balance_paths", 1);
+        max_balance_       = params.find< uint32_t >("max_balance", 8);
+        seed_              = params.find< uint32_t >("seed", 1);
+    }
+    ~SpatialMapper() { }
+
+    SST_ELI_REGISTER_MODULE(
+        SpatialMapper,
+        "llyr",
+        "mapper.spatial",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "App to HW, annealed placement with routing on the hardware graph",
+        SST::Llyr::LlyrMapper
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "moves_per_node",     "Annealing moves per application node, 0 keeps the greedy placement", "200" },
+        { "start_temperature",  "Initial annealing temperature, in hops", "4.0" },
+        { "cooling",            "Temperature multiplier applied after every move", "0.999" },
+        { "congestion_weight",  "Extra route cost per route already using a link", "2.0" },
+        { "balance_paths",      "Pad reconvergent paths with hops so their tokens arrive together", "1" },
+        { "max_balance",        "Maximum number of padding hops added to one edge", "8" },
+        { "seed",               "Seed for the annealing moves", "1" }
+    )
+
+    void mapGraph(LlyrGraph< opType > hardwareGraph, LlyrGraph< AppNode > appGraph,
+                  LlyrGraph< ProcessingElement* > &graphOut,
+                  LlyrConfig* llyr_config);
+
+private:
+    static constexpr uint16_t unreachable_ = std::numeric_limits< uint16_t >::max();
+    static constexpr uint32_t unplaced_ = std::numeric_limits< uint32_t >::max();
+
+    uint32_t moves_per_node_;
+    double   start_temperature_;
+    double   cooling_;
+    double   congestion_weight_;
+    bool     balance_paths_;
+    uint32_t max_balance_;
+    uint32_t seed_;
+
+    SST::Output* output_;
+
+    // hardware graph, dense
+    uint32_t num_hw_;
+    std::vector< uint16_t > distance_;
+
+    // logical (application) graph, numbered like the simple mapper, 0 is the dummy
+    std::vector< opType > node_op_;
+    std::vector< uint32_t > node_app_;
+    std::vector< std::pair< uint32_t, uint32_t > > edges_;          // without the dummy edges
+    std::vector< std::vector< uint32_t > > node_edges_;              // edges_ touching each node
+    std::vector< uint32_t > place_;                                  // node -> dense hw vertex
+    std::vector< uint32_t > occupant_;                               // dense hw vertex -> node
+
+    static bool canHost( opType hardware, opType app );
+    uint32_t distance( uint32_t src, uint32_t dst ) const;
+    uint32_t edgeCost( uint32_t edge ) const;
+    uint32_t nodeCost( uint32_t node ) const;
+    void computeDistances( LlyrGraph< opType > &hardwareGraph );
+    void placeGreedy( LlyrGraph< opType > &hardwareGraph, const std::vector< uint32_t > &order );
+    void anneal( LlyrGraph< opType > &hardwareGraph );
+    std::vector< uint32_t > route( LlyrGraph< opType > &hardwareGraph, uint32_t src, uint32_t dst,
+                                   std::vector< uint32_t > &linkUsage );
+
+};
+
+bool SpatialMapper::canHost( opType hardware, opType app )
+{
+    if( hardware == ANY || hardware == app ) {
+        return 1;
+    }
+
+    // control PEs need a generic PE
+    if( app >= DUMMY ) {
+        return 0;
+    }
+
+    switch( hardware ) {
+        case ANY_MEM :
+            return app > ANY_MEM && app < ANY_LOGIC;
+        case ANY_LOGIC :
+            return app > ANY_LOGIC && app < ANY_TEST;
+        case ANY_TEST :
+            return app > ANY_TEST && app < ANY_INT;
+        case ANY_INT :
+            return app > ANY_INT && app < ANY_FP;
+        case ANY_FP :
+            return app > ANY_FP && app < ANY_CP;
+        case ANY_CP :
+            return app > ANY_CP && app < DUMMY;
+        default :
+            return 0;
+    }
+}
+
+uint32_t SpatialMapper::distance( uint32_t src, uint32_t dst ) const
+{
+    uint16_t hops = distance_[src * num_hw_ + dst];
+    // make unroutable placements expensive rather than impossible so annealing can leave them
+    return hops == unreachable_ ? 4 * num_hw_ : hops;
+}
+
+uint32_t SpatialMapper::edgeCost( uint32_t edge ) const
+{
+    return distance( place_[edges_[edge].first], place_[edges_[edge].second] );
+}
+
+uint32_t SpatialMapper::nodeCost( uint32_t node ) const
+{
+    uint32_t cost = 0;
+    for( auto it = node_edges_[node].begin(); it != node_edges_[node].end(); ++it ) {
+        cost = cost + edgeCost(*it);
+    }
+    return cost;
+}
+
+void SpatialMapper::computeDistances( LlyrGraph< opType > &hardwareGraph )
+{
+    distance_.assign( num_hw_ * num_hw_, unreachable_ );
+    std::queue< uint32_t > nodeQueue;
+    for( uint32_t src = 0; src < num_hw_; ++src ) {
+        uint16_t* row = &distance_[src * num_hw_];
+        row[src] = 0;
+        nodeQueue.push(src);
+        while( nodeQueue.empty() == 0 ) {
+            uint32_t currentNode = nodeQueue.front();
+            nodeQueue.pop();
+            for( const uint32_t* it = hardwareGraph.csrBegin(currentNode); it != hardwareGraph.csrEnd(currentNode); ++it ) {
+                if( row[*it] == unreachable_ ) {
+                    row[*it] = row[currentNode] + 1;
+                    nodeQueue.push(*it);
+                }
+            }
+        }
+    }
+}
+
+void SpatialMapper::placeGreedy( LlyrGraph< opType > &hardwareGraph, const std::vector< uint32_t > &order )
+{
+    for( auto node = order.begin(); node != order.end(); ++node ) {
+        uint32_t best = unplaced_;
+        uint32_t bestCost = 0;
+        for( uint32_t hw = 0; hw < num_hw_; ++hw ) {
+            if( occupant_[hw] != unplaced_ || !canHost(hardwareGraph.csrVertex(hw)->getValue(), node_op_[*node]) ) {
+                continue;
+            }
+
+            // cost to the neighbors placed so far
+            uint32_t cost = 0;
+            for( auto it = node_edges_[*node].begin(); it != node_edges_[*node].end(); ++it ) {
+                uint32_t other = edges_[*it].first == *node ? edges_[*it].second : edges_[*it].first;
+                if( place_[other] != unplaced_ ) {
+                    cost = cost + (edges_[*it].first == *node ? distance(hw, place_[other]) : distance(place_[other], hw));
+                }
+            }
+            if( best == unplaced_ || cost < bestCost ) {
+                best = hw;
+                bestCost = cost;
+            }
+        }
+
+        if( best == unplaced_ ) {
+            output_->fatal(CALL_INFO, -1, "Error: no free hardware vertex can host node %" PRIu32 " (%s)\n",
+                           node_app_[*node], getOpString(node_op_[*node]).c_str());
+        }
+        place_[*node] = best;
+        occupant_[best] = *node;
+    }
+}
+
+void SpatialMapper::anneal( LlyrGraph< opType > &hardwareGraph )
+{
+    uint32_t numNodes = node_op_.size() - 1;
+    uint64_t moves = uint64_t(moves_per_node_) * numNodes;
+    if( moves == 0 || num_hw_ < 2 ) {
+        return;
+    }
+
+    std::mt19937 rng(seed_);
+    std::uniform_int_distribution< uint32_t > pickNode(1, numNodes);
+    std::uniform_int_distribution< uint32_t > pickHw(0, num_hw_ - 1);
+    std::uniform_real_distribution< double > pickProb(0.0, 1.0);
+
+    uint64_t accepted = 0;
+    double temperature = start_temperature_;
+    for( uint64_t move = 0; move < moves; ++move ) {
+        uint32_t node = pickNode(rng);
+        uint32_t target = pickHw(rng);
+        uint32_t source = place_[node];
+        uint32_t other = occupant_[target];
+
+        if( target == source || !canHost(hardwareGraph.csrVertex(target)->getValue(), node_op_[node]) ) {
+            continue;
+        }
+        if( other != unplaced_ && !canHost(hardwareGraph.csrVertex(source)->getValue(), node_op_[other]) ) {
+            continue;
+        }
+
+        // move the node, swapping with the occupant if there is one
+        int64_t before = nodeCost(node) + (other != unplaced_ ? nodeCost(other) : 0);
+        place_[node] = target;
+        occupant_[target] = node;
+        occupant_[source] = other;
+        if( other != unplaced_ ) {
+            place_[other] = source;
+        }
+        int64_t after = nodeCost(node) + (other != unplaced_ ? nodeCost(other) : 0);
+
+        int64_t delta = after - before;
+        if( delta <= 0 || (temperature > 0 && pickProb(rng) < std::exp(-double(delta) / temperature)) ) {
+            accepted = accepted + 1;
+        } else {
+            place_[node] = source;
+            occupant_[source] = node;
+            occupant_[target] = other;
+            if( other != unplaced_ ) {
+                place_[other] = target;
+            }
+        }
+
+        temperature = temperature * cooling_;
+    }
+
+    output_->verbose(CALL_INFO, 1, 0, "Annealing accepted %" PRIu64 " of %" PRIu64 " moves\n", accepted, moves);
+}
+
+// Congestion aware shortest path, returns the hardware vertices between src and dst
+std::vector< uint32_t > SpatialMapper::route( LlyrGraph< opType > &hardwareGraph, uint32_t src, uint32_t dst,
+                                              std::vector< uint32_t > &linkUsage )
+{
+    std::vector< uint32_t > path;
+    if( src == dst ) {
+        return path;
+    }
+
+    const uint32_t* links = hardwareGraph.csrBegin(0);
+    std::vector< double > cost(num_hw_, std::numeric_limits< double >::max());
+    std::vector< uint32_t > previous(num_hw_, unplaced_);
+    std::vector< uint32_t > previousLink(num_hw_, unplaced_);
+    std::priority_queue< std::pair< double, uint32_t >, std::vector< std::pair< double, uint32_t > >,
+                         std::greater< std::pair< double, uint32_t > > > frontier;
+
+    cost[src] = 0;
+    frontier.push(std::make_pair(0.0, src));
+    while( frontier.empty() == 0 ) {
+        auto current = frontier.top();
+        frontier.pop();
+        if( current.second == dst ) {
+            break;
+        }
+        if( current.first > cost[current.second] ) {
+            continue;
+        }
+
+        for( const uint32_t* it = hardwareGraph.csrBegin(current.second); it != hardwareGraph.csrEnd(current.second); ++it ) {
+            uint32_t link = it - links;
+            double next = current.first + 1.0 + congestion_weight_ * linkUsage[link];
+            if( next < cost[*it] ) {
+                cost[*it] = next;
+                previous[*it] = current.second;
+                previousLink[*it] = link;
+                frontier.push(std::make_pair(next, *it));
+            }
+        }
+    }
+
+    if( previous[dst] == unplaced_ ) {
+        output_->fatal(CALL_INFO, -1, "Error: no route from hardware vertex %" PRIu32 " to %" PRIu32 "\n",
+                       hardwareGraph.csrId(src), hardwareGraph.csrId(dst));
+    }
+
+    for( uint32_t hw = dst; hw != src; hw = previous[hw] ) {
+        linkUsage[previousLink[hw]]++;
+        if( previous[hw] != src ) {
+            path.push_back(previous[hw]);
+        }
+    }
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
+
+void SpatialMapper::mapGraph(LlyrGraph< opType > hardwareGraph, LlyrGraph< AppNode > appGraph,
+                             LlyrGraph< ProcessingElement* > &graphOut,
+                             LlyrConfig* llyr_config)
+{
+    //setup up i/o for messages
+    char prefix[256];
+    sprintf(prefix, "[t=@t][spatialMapper]: ");
+    output_ = new SST::Output(prefix, llyr_config->verbosity_, 0, Output::STDOUT);
+
+    output_->verbose(CALL_INFO, 32, 0, "Starting mapping\n");
+    std::map< uint32_t, Vertex< AppNode > >* app_vertex_map_ = appGraph.getVertexMap();
+
+    //-------------- Number nodes like the simple mapper ---------------------------------
+    std::queue< uint32_t > nodeQueue;
+    std::set< uint32_t > visited;
+    for( auto appIterator = app_vertex_map_->begin(); appIterator != app_vertex_map_->end(); ++appIterator ) {
+        if( appIterator->second.getInDegree() == 0 ) {
+            nodeQueue.push(appIterator->first);
+        }
+    }
+
+    std::map< uint32_t, uint32_t > mapping;
+    node_op_.assign(1, DUMMY);
+    node_app_.assign(1, 0);
+    while( nodeQueue.empty() == 0 ) {
+        uint32_t currentAppNode = nodeQueue.front();
+        nodeQueue.pop();
+        visited.insert(currentAppNode);
+
+        mapping.emplace( currentAppNode, node_op_.size() );
+        node_op_.push_back( app_vertex_map_->at(currentAppNode).getValue().optype_ );
+        node_app_.push_back( currentAppNode );
+
+        std::vector< Edge* >* adjacencyList = app_vertex_map_->at(currentAppNode).getAdjacencyList();
+        for( auto it = adjacencyList->begin(); it != adjacencyList->end(); it++ ) {
+            uint32_t destinationVertex = (*it)->getDestination();
+            if( visited.insert(destinationVertex).second ) {
+                nodeQueue.push(destinationVertex);
+            }
+        }
+    }
+    uint32_t numNodes = node_op_.size();
+
+    // logical graph, dummy root edges to nodes without inputs so far as the simple mapper adds them
+    std::vector< std::vector< uint32_t > > adjacency(numNodes);
+    std::vector< uint32_t > inDegree(numNodes, 0);
+    for( uint32_t node = 1; node < numNodes; ++node ) {
+        std::vector< Edge* >* adjacencyList = app_vertex_map_->at(node_app_[node]).getAdjacencyList();
+        for( auto it = adjacencyList->begin(); it != adjacencyList->end(); it++ ) {
+            auto destination = mapping.find((*it)->getDestination());
+            if( destination == mapping.end() ) {
+                output_->fatal(CALL_INFO, -1, "Error: node %" PRIu32 " cannot be reached from an input\n", (*it)->getDestination());
+            }
+            adjacency[node].push_back(destination->second);
+            inDegree[destination->second]++;
+        }
+        if( inDegree[node] == 0 ) {
+            adjacency[0].push_back(node);
+            inDegree[node]++;
+        }
+    }
+
+    // BFS order from the dummy, which is also the order queues are bound in
+    std::vector< uint32_t > order;
+    std::vector< uint32_t > rank(numNodes, unplaced_);
+    rank[0] = 0;
+    nodeQueue.push(0);
+    while( nodeQueue.empty() == 0 ) {
+        uint32_t currentNode = nodeQueue.front();
+        nodeQueue.pop();
+        order.push_back(currentNode);
+        for( auto it = adjacency[currentNode].begin(); it != adjacency[currentNode].end(); ++it ) {
+            if( rank[*it] == unplaced_ ) {
+                rank[*it] = order.size() + nodeQueue.size();
+                nodeQueue.push(*it);
+            }
+        }
+    }
+
+    node_edges_.assign(numNodes, std::vector< uint32_t >());
+    for( uint32_t node = 1; node < numNodes; ++node ) {
+        for( auto it = adjacency[node].begin(); it != adjacency[node].end(); ++it ) {
+            node_edges_[node].push_back(edges_.size());
+            if( *it != node ) {
+                node_edges_[*it].push_back(edges_.size());
+            }
+            edges_.push_back(std::make_pair(node, *it));
+        }
+    }
+
+    //-------------- Place ---------------------------------
+    hardwareGraph.buildCSR();
+    num_hw_ = hardwareGraph.numVertices();
+    if( numNodes - 1 > num_hw_ ) {
+        output_->fatal(CALL_INFO, -1, "Error: %" PRIu32 " nodes do not fit in %" PRIu32 " hardware vertices\n", numNodes - 1, num_hw_);
+    }
+    computeDistances(hardwareGraph);
+
+    place_.assign(numNodes, unplaced_);
+    occupant_.assign(num_hw_, unplaced_);
+    placeGreedy(hardwareGraph, std::vector< uint32_t >(order.begin() + 1, order.end()));
+
+    uint64_t wirelength = 0;
+    for( uint32_t edge = 0; edge < edges_.size(); ++edge ) {
+        wirelength = wirelength + edgeCost(edge);
+    }
+    output_->verbose(CALL_INFO, 1, 0, "Greedy placement wirelength %" PRIu64 " hops\n", wirelength);
+
+    anneal(hardwareGraph);
+
+    wirelength = 0;
+    for( uint32_t edge = 0; edge < edges_.size(); ++edge ) {
+        wirelength = wirelength + edgeCost(edge);
+    }
+    output_->verbose(CALL_INFO, 1, 0, "Final placement wirelength %" PRIu64 " hops\n", wirelength);
+
+    //-------------- Route, longest edges first ---------------------------------
+    std::vector< uint32_t > routeOrder(edges_.size());
+    for( uint32_t edge = 0; edge < edges_.size(); ++edge ) {
+        routeOrder[edge] = edge;
+    }
+    std::stable_sort(routeOrder.begin(), routeOrder.end(),
+                     [this](uint32_t a, uint32_t b){ return edgeCost(a) > edgeCost(b); });
+
+    uint32_t numLinks = hardwareGraph.csrEnd(num_hw_ - 1) - hardwareGraph.csrBegin(0);
+    std::vector< uint32_t > linkUsage(numLinks, 0);
+    std::vector< std::vector< uint32_t > > routes(edges_.size());
+    for( auto it = routeOrder.begin(); it != routeOrder.end(); ++it ) {
+        routes[*it] = route(hardwareGraph, place_[edges_[*it].first], place_[edges_[*it].second], linkUsage);
+    }
+
+    uint32_t maxUsage = 0;
+    for( auto it = linkUsage.begin(); it != linkUsage.end(); ++it ) {
+        maxUsage = std::max(maxUsage, *it);
+    }
+    output_->verbose(CALL_INFO, 1, 0, "Routed %" PRIu64 " edges, most used link carries %" PRIu32 " routes\n",
+                     (uint64_t) edges_.size(), maxUsage);
+
+    //-------------- Balance reconvergent paths ---------------------------------
+    // ASAP arrival over forward edges (in BFS order), every PE and hop takes a cycle
+    std::vector< uint32_t > padding(edges_.size(), 0);
+    std::vector< uint32_t > arrival(numNodes, 0);
+    std::vector< uint32_t > byRank(order.begin() + 1, order.end());
+    for( auto node = byRank.begin(); node != byRank.end(); ++node ) {
+        for( auto it = node_edges_[*node].begin(); it != node_edges_[*node].end(); ++it ) {
+            uint32_t src = edges_[*it].first;
+            if( edges_[*it].second == *node && rank[src] < rank[*node] ) {
+                arrival[*node] = std::max< uint32_t >(arrival[*node], arrival[src] + 1 + routes[*it].size());
+            }
+        }
+    }
+
+    uint32_t recurrence = 1;
+    uint64_t padHops = 0;
+    for( uint32_t edge = 0; edge < edges_.size(); ++edge ) {
+        uint32_t src = edges_[edge].first;
+        uint32_t dst = edges_[edge].second;
+        uint32_t ready = arrival[src] + 1 + routes[edge].size();
+        if( rank[src] < rank[dst] ) {
+            if( balance_paths_ ) {
+                padding[edge] = std::min(max_balance_, arrival[dst] - ready);
+                padHops = padHops + padding[edge];
+            }
+        } else {
+            // back edge closes a recurrence, a token must go around it before the next starts
+            recurrence = std::max(recurrence, ready - arrival[dst]);
+        }
+    }
+    output_->verbose(CALL_INFO, 1, 0, "Estimated initiation interval %" PRIu32 ", %" PRIu64 " padding hops\n", recurrence, padHops);
+
+    //-------------- Build the PE graph ---------------------------------
+    // PE ids are the hardware vertex + 1, 0 is the dummy, routing hops follow the fabric
+    addNode( DUMMY, 0, graphOut, llyr_config );
+    uint32_t maxHwId = 0;
+    for( uint32_t hw = 0; hw < num_hw_; ++hw ) {
+        maxHwId = std::max(maxHwId, hardwareGraph.csrId(hw));
+    }
+
+    std::vector< uint32_t > peId(numNodes, 0);
+    for( uint32_t node = 1; node < numNodes; ++node ) {
+        peId[node] = hardwareGraph.csrId(place_[node]) + 1;
+
+        // simple assumes some things about queues
+        QueueArgMap* arguments = new QueueArgMap;
+        arguments->emplace( 0, app_vertex_map_->at(node_app_[node]).getValue().argument_[0] );
+
+        opType tempOp = node_op_[node];
+        if( tempOp == ADDCONST || tempOp == SUBCONST || tempOp == MULCONST || tempOp == DIVCONST || tempOp == REMCONST ) {
+            addNode( tempOp, arguments, peId[node], graphOut, llyr_config );
+        } else if( tempOp == INC || tempOp == INC_RST || tempOp == ACC ) {
+            addNode( tempOp, arguments, peId[node], graphOut, llyr_config );
+        } else if( tempOp == LDADDR || tempOp == STREAM_LD || tempOp == STADDR || tempOp == STREAM_ST ) {
+            addNode( tempOp, arguments, peId[node], graphOut, llyr_config );
+        } else {
+            addNode( tempOp, peId[node], graphOut, llyr_config );
+        }
+        output_->verbose(CALL_INFO, 32, 0, "-- App %" PRIu32 " placed on %" PRIu32 "\n", node_app_[node], peId[node] - 1);
+    }
+
+    // chain of BUFFER PEs for each routed edge
+    uint32_t nextBufferId = maxHwId + 2;
+    std::vector< std::vector< uint32_t > > hops(edges_.size());
+    for( uint32_t edge = 0; edge < edges_.size(); ++edge ) {
+        uint32_t total = routes[edge].size() + padding[edge];
+        for( uint32_t hop = 0; hop < total; ++hop ) {
+            addNode( BUFFER, nextBufferId, graphOut, llyr_config );
+            hops[edge].push_back(nextBufferId);
+            nextBufferId = nextBufferId + 1;
+        }
+    }
+
+    std::map< std::pair< uint32_t, uint32_t >, uint32_t > edgeIndex;
+    for( uint32_t edge = 0; edge < edges_.size(); ++edge ) {
+        edgeIndex.emplace(edges_[edge], edge);
+    }
+
+    // bind in the simple mapper's order, one logical edge at a time
+    std::map< uint32_t, Vertex< ProcessingElement* > >* vertex_map_ = graphOut.getVertexMap();
+    for( auto node = order.begin(); node != order.end(); ++node ) {
+        for( auto it = adjacency[*node].begin(); it != adjacency[*node].end(); ++it ) {
+            std::vector< uint32_t > chain;
+            chain.push_back(peId[*node]);
+            if( *node != 0 ) {
+                std::vector< uint32_t > &edgeHops = hops[edgeIndex.at(std::make_pair(*node, *it))];
+                chain.insert(chain.end(), edgeHops.begin(), edgeHops.end());
+            }
+            chain.push_back(peId[*it]);
+
+            for( uint32_t link = 0; link + 1 < chain.size(); ++link ) {
+                ProcessingElement* srcNode = vertex_map_->at(chain[link]).getValue();
+                ProcessingElement* dstNode = vertex_map_->at(chain[link + 1]).getValue();
+                graphOut.addEdge( chain[link], chain[link + 1] );
+                srcNode->bindOutputQueue(dstNode);
+                dstNode->bindInputQueue(srcNode);
+            }
+        }
+
+        //FIXME Need to use a fake init on ST for now
+        opType tempOp = node_op_[*node];
+        if( tempOp == ST || tempOp == LDADDR || tempOp == STADDR || tempOp == STREAM_LD || tempOp == STREAM_ST || tempOp == ACC ) {
+            vertex_map_->at(peId[*node]).getValue()->inputQueueInit();
+        }
+    }
+
+    //FIXME Fake init for now, need to read values from stack
+    //Initialize any L/S PEs at the top of the graph
+    for( auto it = adjacency[0].begin(); it != adjacency[0].end(); ++it ) {
+        vertex_map_->at(peId[*it]).getValue()->inputQueueInit();
+    }
+
+    output_->verbose(CALL_INFO, 1, 0, "Mapped %" PRIu32 " nodes with %" PRIu32 " routing hops\n",
+                     numNodes - 1, nextBufferId - maxHwId - 2);
+}// mapGraph
+
+}// namespace Llyr
+}// namespace SST
+
+#endif // _SPATIAL_MAPPER_H
@@ -35,6 +35,7 @@ public:
     {
         do_forward_ = 0;
         timeout_ = 5;
+        buffer_valid_ = 0;
     }
 
     virtual bool doReceive(LlyrData data) { return 0; };
@@ -44,6 +45,11 @@ public:
         // TraceFunction trace(CALL_INFO_LONG);
         output_->verbose(CALL_INFO, 4, 0, ">> Compute %s\n", getOpString(op_binding_).c_str());
 
+        // BUFFER is a routing hop, it does not wait for a full set of inputs
+        if( op_binding_ == BUFFER ) {
+            return doBuffer();
+        }
+
         uint64_t intResult = 0x0F;
 
         std::vector< QueueData > argList(3);
@@ -263,6 +269,39 @@ public:
 protected:
     uint16_t do_forward_;
 
+    // BUFFER holds one token for a cycle, so a route of n hops takes n cycles
+    // but still passes one token per cycle
+    bool     buffer_valid_;
+    LlyrData buffer_data_;
+
+    bool doBuffer()
+    {
+        bool fired = 0;
+        if( buffer_valid_ == 1 ) {
+            for( uint32_t i = 0; i < output_queues_->size(); ++i ) {
+                if( output_queues_->at(i)->data_queue_->size() >= queue_depth_ ) {
+                    output_->verbose(CALL_INFO, 4, 0, "-Buffer -- No room in output queue %" PRIu32 "\n", i);
+                    pending_op_ = 1;
+                    return false;
+                }
+            }
+            for( uint32_t i = 0; i < output_queues_->size(); ++i ) {
+                output_queues_->at(i)->data_queue_->push(buffer_data_);
+            }
+            buffer_valid_ = 0;
+            fired = 1;
+        }
+
+        if( input_queues_->size() > 0 && input_queues_->at(0)->data_queue_->size() > 0 ) {
+            buffer_data_ = input_queues_->at(0)->data_queue_->front();
+            input_queues_->at(0)->data_queue_->pop();
+            buffer_valid_ = 1;
+        }
+
+        pending_op_ = buffer_valid_ | fired;
+        return fired;
+    }
+
     HelperReturn helperFunction( opType op, QueueData arg0, QueueData arg1, QueueData arg2 )
     {
 
@@ -156,6 +156,7 @@ public:
         if( retVal.second == false ) {
             return 0;
         }
+        send_routes_.clear();
 
         LlyrQueue* tempQueue = new LlyrQueue;
         tempQueue->forwarded_ = 0;
@@ -176,6 +177,7 @@ public:
         if( retVal.second == false ) {
             return 0;
         }
+        send_routes_.clear();
 
         while( output_queues_->size() <= queueId ) {
             LlyrQueue* tempQueue = new LlyrQueue;
@@ -357,22 +359,33 @@ public:
         uint32_t queueId;
         LlyrData sendVal;
         ProcessingElement* dstPe;
+        int32_t dstQueueId;
 
-        for(auto it = output_queue_map_.begin() ; it != output_queue_map_.end(); ++it ) {
-            queueId = it->first;
-            dstPe = it->second;
+        //bindings are fixed once the simulation runs, so resolve them once
+        if( send_routes_.size() != output_queue_map_.size() ) {
+            buildSendRoutes();
+        }
+
+        for(auto it = send_routes_.begin() ; it != send_routes_.end(); ++it ) {
+            queueId = it->queue_id_;
+            dstPe = it->dst_pe_;
+            dstQueueId = it->dst_queue_id_;
 
             if( output_queues_->at(queueId)->data_queue_->size() > 0 ) {
+                if( dstQueueId < 0 ) {
+                    output_->fatal(CALL_INFO, -1, "Error: PE-%" PRIu32 " has no input queue from PE-%" PRIu32 "\n",
+                                   dstPe->getProcessorId(), processor_id_);
+                }
                 // std::cout << " Input Queue Depth at PE-" << dstPe->getProcessorId();
-                // std::cout << "(" << queueId << ") " << dstPe->getInputQueueSize(dstPe->getInputQueueId(processor_id_));
+                // std::cout << "(" << queueId << ") " << dstPe->getInputQueueSize(dstQueueId);
                 // std::cout << ", max is " << queue_depth_ << std::endl;
-                if( dstPe->getInputQueueSize(dstPe->getInputQueueId(processor_id_)) < queue_depth_ ) {
+                if( dstPe->getInputQueueSize(dstQueueId) < queue_depth_ ) {
                     output_->verbose(CALL_INFO, 8, 0, ">> Sending (%llu)...%" PRIu32 "-%" PRIu32 " to %" PRIu32 "\n",
                                 output_queues_->at(queueId)->data_queue_->front().to_ullong(), processor_id_, queueId,
                                 dstPe->getProcessorId());
 
                     sendVal = output_queues_->at(queueId)->data_queue_->front();
-                    dstPe->pushInputQueue(dstPe->getInputQueueId(processor_id_), sendVal);
+                    dstPe->pushInputQueue(dstQueueId, sendVal);
                     output_queues_->at(queueId)->data_queue_->pop();
                 } else {
                     output_->verbose(CALL_INFO, 8, 0, ">> Sending failed...%" PRIu32 "-%" PRIu32 " to %" PRIu32 "\n",
@@ -417,6 +430,23 @@ protected:
     std::map< uint32_t, ProcessingElement* > input_queue_map_;
     std::map< uint32_t, ProcessingElement* > output_queue_map_;
 
+    // output_queue_map_ flattened, with the input queue each output feeds
+    typedef struct {
+        uint32_t queue_id_;
+        ProcessingElement* dst_pe_;
+        int32_t dst_queue_id_;
+    } SendRoute;
+    std::vector< SendRoute > send_routes_;
+
+    void buildSendRoutes()
+    {
+        send_routes_.clear();
+        send_routes_.reserve(output_queue_map_.size());
+        for( auto it = output_queue_map_.begin(); it != output_queue_map_.end(); ++it ) {
+            send_routes_.push_back( SendRoute{ it->first, it->second, it->second->getInputQueueId(processor_id_) } );
+        }
+    }
+
     // track outstanding L/S requests (passed from top-level)
     LSQueue* lsqueue_;
 
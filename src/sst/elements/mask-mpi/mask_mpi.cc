@@ -303,6 +303,54 @@ extern "C" int mask_mpi_mpi_put(const void *origin_addr, int origin_count, MPI_D
                                  target_datatype, win);
 }
 
+extern "C" int mask_mpi_accumulate(const void *origin_addr, int origin_count, MPI_Datatype
+            origin_datatype, int target_rank, MPI_Aint target_disp,
+            int target_count, MPI_Datatype target_datatype, MPI_Op op, MPI_Win win){
+  return SST::MASKMPI::mask_mpi()->accumulate(origin_addr, origin_count, origin_datatype,
+                                 target_rank, target_disp, target_count,
+                                 target_datatype, op, win);
+}
+
+extern "C" int mask_mpi_win_fence(int assert, MPI_Win win){
+  return SST::MASKMPI::mask_mpi()->winFence(assert, win);
+}
+
+extern "C" int mask_mpi_win_post(MPI_Group group, int assert, MPI_Win win){
+  return SST::MASKMPI::mask_mpi()->winPost(group, assert, win);
+}
+
+extern "C" int mask_mpi_win_start(MPI_Group group, int assert, MPI_Win win){
+  return SST::MASKMPI::mask_mpi()->winStart(group, assert, win);
+}
+
+extern "C" int mask_mpi_win_complete(MPI_Win win){
+  return SST::MASKMPI::mask_mpi()->winComplete(win);
+}
+
+extern "C" int mask_mpi_win_wait(MPI_Win win){
+  return SST::MASKMPI::mask_mpi()->winWait(win);
+}
+
+extern "C" int mask_mpi_win_test(MPI_Win win, int *flag){
+  return SST::MASKMPI::mask_mpi()->winTest(win, flag);
+}
+
+extern "C" int mask_mpi_win_lock_all(int assert, MPI_Win win){
+  return SST::MASKMPI::mask_mpi()->winLockAll(assert, win);
+}
+
+extern "C" int mask_mpi_win_unlock_all(MPI_Win win){
+  return SST::MASKMPI::mask_mpi()->winUnlockAll(win);
+}
+
+extern "C" int mask_mpi_win_flush_all(MPI_Win win){
+  return SST::MASKMPI::mask_mpi()->winFlushAll(win);
+}
+
+extern "C" int mask_mpi_win_flush_local_all(MPI_Win win){
+  return SST::MASKMPI::mask_mpi()->winFlushLocalAll(win);
+}
+
 extern "C" int mask_mpi_group_range_incl(MPI_Group group, int n, int ranges[][3], MPI_Group *newgroup){
   return SST::MASKMPI::mask_mpi()->groupRangeIncl(group, n, ranges, newgroup);
 }
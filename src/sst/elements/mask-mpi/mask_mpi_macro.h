@@ -205,8 +205,20 @@ Questions? Contact sst-macro-help@sandia.gov
 #define MPI_Win_create mask_mpi_win_create
 #define MPI_Win_free mask_mpi_win_free
 
+#define MPI_Win_flush_all mask_mpi_win_flush_all
+#define MPI_Win_flush_local_all mask_mpi_win_flush_local_all
+#define MPI_Win_lock_all mask_mpi_win_lock_all
+#define MPI_Win_unlock_all mask_mpi_win_unlock_all
+#define MPI_Win_fence mask_mpi_win_fence
+#define MPI_Win_post mask_mpi_win_post
+#define MPI_Win_start mask_mpi_win_start
+#define MPI_Win_complete mask_mpi_win_complete
+#define MPI_Win_wait mask_mpi_win_wait
+#define MPI_Win_test mask_mpi_win_test
+
 #define MPI_Get mask_mpi_mpi_get
 #define MPI_Put mask_mpi_mpi_put
+#define MPI_Accumulate mask_mpi_accumulate
 
 #define MPI_Intercomm_create error not yet implemented
 #define MPI_Comm_remote_size error not yet implemented
@@ -238,14 +250,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #define MPI_Open_port error not yet implemented
 #define MPI_Publish_name error not yet implemented
 #define MPI_Unpublish_name error not yet implemented
-#define MPI_Accumulate error not yet implemented
-#define MPI_Win_complete error not yet implemented
-#define MPI_Win_fence error not yet implemented
 #define MPI_Win_get_group error not yet implemented
-#define MPI_Win_post error not yet implemented
-#define MPI_Win_start error not yet implemented
-#define MPI_Win_test error not yet implemented
-#define MPI_Win_wait error not yet implemented
 #define MPI_Add_error_class error not yet implemented
 #define MPI_Add_error_code error not yet implemented
 #define MPI_Add_error_string error not yet implemented
@@ -129,6 +129,7 @@ MpiApi::MpiApi(SST::Params& params, SST::Hg::App* app) :
   OTF2Writer_(nullptr),
 #endif
   req_counter_(0),
+  win_counter_(0),
   generate_ids_(true)
 {
   verbose_ = params.find<unsigned int>("verbose", 0);
@@ -147,6 +148,9 @@ MpiApi::MpiApi(SST::Params& params, SST::Hg::App* app) :
   double test_delay_s = params.find<SST::UnitAlgebra>("test_delay", "1us").getValue().toDouble();
   test_delay_us_ = test_delay_s * 1e6;
 
+  crit_path_on_ = params.find<bool>("critical_path", false);
+  crit_path_top_ = params.find<int>("critical_path_top", 5);
+
 #ifdef SST_HG_OTF2_ENABLED
 #if !SST_HG_INTEGRATED_SST_CORE
   auto subname = sprockit::sprintf("App%d-Rank%d", app->sid().app_, app->sid().task_);
@@ -237,6 +241,11 @@ out_->debug(CALL_INFO, 1, 0,
 
   Iris::sumi::SimTransport::init();
 
+  if (crit_path_on_){
+    crit_path_.reset(new MpiCriticalPath(rank_, nproc_));
+    crit_path_->start(now());
+  }
+
   comm_factory_->init(rank_, nproc_);
 
   worldcomm_ = comm_factory_->world();
@@ -307,6 +316,10 @@ MpiApi::finalize()
   }
 #endif
 
+  if (crit_path_){
+    reportCriticalPath();
+  }
+
   status_ = is_finalized;
 
   int rank = commWorld()->rank();
@@ -603,6 +616,38 @@ MpiApi::logMessageDelay(  Iris::sumi::Message *msg,
 {
 }
 
+void
+MpiApi::logMessageSend(Iris::sumi::Message* msg)
+{
+  if (crit_path_){
+    crit_path_->stamp(msg, now());
+  }
+}
+
+void
+MpiApi::reportCriticalPath()
+{
+  //stop tracking so the collectives below are not on the path
+  std::unique_ptr<MpiCriticalPath> tracker = std::move(crit_path_);
+  tracker->finish(now());
+
+  std::vector<double> summary = tracker->summary();
+  std::vector<double> waits = tracker->waits();
+  std::vector<double> summaries;
+  std::vector<double> total_waits;
+  if (rank_ == 0){
+    summaries.resize(summary.size() * nproc_);
+    total_waits.resize(waits.size());
+  }
+  gather(summary.data(), int(summary.size()), MPI_DOUBLE,
+         summaries.data(), int(summary.size()), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  reduce(waits.data(), total_waits.data(), int(waits.size()), MPI_DOUBLE, MPI_SUM,
+         0, MPI_COMM_WORLD);
+  if (rank_ == 0){
+    out_->output("%s", MpiCriticalPath::report(summaries, total_waits, crit_path_top_).c_str());
+  }
+}
+
 void
 MpiApi::finishCurrentMpiCall()
 {
@@ -59,6 +59,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <mpi_comm/mpi_comm.h>
 #include <mpi_types/mpi_type_fwd.h>
 #include <mpi_request.h>
+#include <mpi_window.h>
 #include <mpi_status.h>
 #include <mpi_call.h>
 #include <mpi_comm/mpi_comm_factory.h>
@@ -114,6 +115,13 @@ class MpiApi : public SST::Iris::sumi::SimTransport
     return worldcomm_;
   }
 
+  /**
+   * @return The critical path tracker, null unless critical_path is on
+   */
+  MpiCriticalPath* criticalPath() const {
+    return crit_path_.get();
+  }
+
   MpiComm* commSelf() const {
     return selfcomm_;
   }
@@ -545,6 +553,32 @@ class MpiApi : public SST::Iris::sumi::SimTransport
               origin_datatype, int target_rank, MPI_Aint target_disp,
               int target_count, MPI_Datatype target_datatype, MPI_Win win);
 
+  int accumulate(const void *origin_addr, int origin_count, MPI_Datatype
+              origin_datatype, int target_rank, MPI_Aint target_disp,
+              int target_count, MPI_Datatype target_datatype, MPI_Op op, MPI_Win win);
+
+  int winFence(int assert, MPI_Win win);
+
+  int winPost(MPI_Group group, int assert, MPI_Win win);
+
+  int winStart(MPI_Group group, int assert, MPI_Win win);
+
+  int winComplete(MPI_Win win);
+
+  int winWait(MPI_Win win);
+
+  int winTest(MPI_Win win, int *flag);
+
+  int winLockAll(int assert, MPI_Win win);
+
+  int winUnlockAll(MPI_Win win);
+
+  int winFlushAll(MPI_Win win);
+
+  int winFlushLocalAll(MPI_Win win);
+
+  void incomingRmaMessage(MpiMessage* msg);
+
  public:
   int opCreate(MPI_User_function* user_fn, int commute, MPI_Op* op);
 
@@ -672,6 +706,23 @@ class MpiApi : public SST::Iris::sumi::SimTransport
 
   void freeRequests(int nreqs, MPI_Request* reqs, int* inds);
 
+  MpiWindow* getWindow(MPI_Win win);
+
+  void rmaSend(MpiWindow* win, int rank, MpiWindow::rma_t ty,
+               uint64_t bytes = 64, void* buffer = nullptr);
+
+  void rmaIssue(MpiWindow* win, int rank, MpiWindow::rma_t ty, void* origin_addr,
+               int origin_count, MPI_Datatype origin_datatype, MPI_Aint target_disp,
+               int target_count, MPI_Datatype target_datatype, MPI_Op op, const char* fxn);
+
+  void rmaFlush(MpiWindow* win, int rank, bool remote);
+
+  void rmaGroup(MpiWindow* win, MPI_Group group, std::vector<int>& ranks);
+
+  void rmaTargetLock(MpiWindow* win, MpiMessage* msg);
+
+  void rmaTargetAccumulate(MpiWindow* win, MpiMessage* msg);
+
   void commitBuiltinTypes();
 
   void commitBuiltinType(MpiType* type, MPI_Datatype id);
@@ -853,6 +904,12 @@ class MpiApi : public SST::Iris::sumi::SimTransport
   req_ptr_map req_map_;
   MPI_Request req_counter_;
 
+  typedef std::unordered_map<MPI_Win, MpiWindow*> win_ptr_map;
+  win_ptr_map win_map_;
+  MPI_Win win_counter_;
+  /** The copies of accumulate data, by flow, until the target is done */
+  std::unordered_map<uint64_t, char*> rma_send_buffers_;
+
   SST::Statistics::MultiStatistic<int, //sender
                                   int, //recver
                                   int, //type
@@ -885,7 +942,15 @@ class MpiApi : public SST::Iris::sumi::SimTransport
                        SST::Hg::TimeDelta sync_delay, SST::Hg::TimeDelta active_delay,
                        SST::Hg::TimeDelta time_since_quiesce) override;
 
+  void logMessageSend(SST::Iris::sumi::Message* msg) override;
+
  private:
+  void reportCriticalPath();
+
+  bool crit_path_on_;
+  int crit_path_top_;
+  std::unique_ptr<MpiCriticalPath> crit_path_;
+
   MPI_Call current_call_;
   unsigned int verbose_;
   std::unique_ptr<SST::Output> out_;
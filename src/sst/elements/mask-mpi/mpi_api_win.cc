@@ -43,70 +43,489 @@ Questions? Contact sst-macro-help@sandia.gov
 */
 
 #include <mpi_api.h>
+#include <mpi_comm/mpi_group.h>
+#include <mpi_queue/mpi_queue.h>
+#include <mpi_types/mpi_type.h>
+#include <mercury/common/null_buffer.h>
 #include <mercury/common/stl_string.h>
 
+#include <cstring>
+
 namespace SST::MASKMPI {
 
+struct win_info {
+  uint64_t base;
+  int disp_unit;
+  MPI_Win id;
+};
+
+MpiWindow*
+MpiApi::getWindow(MPI_Win win)
+{
+  auto it = win_map_.find(win);
+  if (it == win_map_.end()) {
+    sst_hg_throw_printf(SST::Hg::HgError,
+        "could not find mpi window %d for rank %d",
+        win, int(rank_));
+  }
+  return it->second;
+}
+
 int
-MpiApi::winFlush(int  /*rank*/, MPI_Win  /*win*/)
+MpiApi::winCreate(void *base, MPI_Aint size, int disp_unit, MPI_Info  /*info*/,
+               MPI_Comm comm, MPI_Win *win)
 {
-  sst_hg_abort_printf("unimplemented error: MPI_Win_flush");
+  MpiComm* commPtr = getComm(comm);
+  MpiWindow* w = new MpiWindow(commPtr, win_counter_++, base, size, disp_unit);
+  // ranks done with the exchange may already send to this one
+  w->targets.resize(commPtr->size());
+  win_map_[w->id] = w;
+
+  // every origin needs the base, unit and id of the window at each target
+  win_info mine;
+  mine.base = isNonNullBuffer(base) ? uint64_t(base) : 0;
+  mine.disp_unit = disp_unit;
+  mine.id = w->id;
+  std::vector<win_info> all(commPtr->size());
+  waitCollective(startAllgather("MPI_Win_create", comm, sizeof(win_info), MPI_BYTE,
+                                sizeof(win_info), MPI_BYTE, &mine, all.data()));
+
+  for (size_t i=0; i < all.size(); ++i){
+    w->targets[i].base = all[i].base;
+    w->targets[i].disp_unit = all[i].disp_unit;
+    w->targets[i].id = all[i].id;
+  }
+
+  *win = w->id;
   return MPI_SUCCESS;
 }
 
 int
-MpiApi::winFlushLocal(int  /*rank*/, MPI_Win  /*win*/)
+MpiApi::winFree(MPI_Win *win)
 {
-  sst_hg_abort_printf("unimplemented error: MPI_Win_flush_local");
+  MpiWindow* w = getWindow(*win);
+  for (int r=0; r < (int) w->targets.size(); ++r){
+    rmaFlush(w, r, true);
+  }
+  // no one may still be working on this rank's memory
+  waitCollective(startBarrier("MPI_Win_free", w->comm->id()));
+  win_map_.erase(w->id);
+  delete w;
+  *win = MPI_WIN_NULL;
   return MPI_SUCCESS;
 }
 
+void
+MpiApi::rmaSend(MpiWindow* w, int rank, MpiWindow::rma_t ty, uint64_t bytes, void* buffer)
+{
+  smsgSend<MpiMessage>(w->comm->peerTask(rank), bytes, buffer,
+                       Iris::sumi::Message::no_ack, queue_->rmaCqId(), Iris::sumi::Message::pt2pt,
+                       queue_->rmaQos(),
+                       w->comm->rank(), rank, MPI_BYTE, w->targets[rank].id, MPI_Comm(w->id), 0,
+                       int(bytes), 1, nullptr, int(ty));
+}
+
+void
+MpiApi::rmaIssue(MpiWindow* w, int rank, MpiWindow::rma_t ty, void *origin_addr,
+                 int origin_count, MPI_Datatype origin_datatype, MPI_Aint target_disp,
+                 int  /*target_count*/, MPI_Datatype target_datatype, MPI_Op op, const char* fxn)
+{
+  MpiType* otype = typeFromId(origin_datatype);
+  MpiType* ttype = typeFromId(target_datatype);
+  if (!otype->contiguous() || !ttype->contiguous()){
+    sst_hg_abort_printf("unimplemented error: %s with non-contiguous datatypes", fxn);
+  }
+
+  MpiWindow::Target& t = w->targets[rank];
+  uint64_t bytes = uint64_t(origin_count) * otype->packed_size();
+  void* remote = t.base ? (void*)(t.base + target_disp * t.disp_unit) : nullptr;
+  void* local = isNonNullBuffer(origin_addr) ? origin_addr : nullptr;
+  SST::Hg::TaskId tid = w->comm->peerTask(rank);
+  int qos = queue_->rmaQos();
+  int cq = queue_->rmaCqId();
+
+  ++t.pending;
+  switch (ty){
+  case MpiWindow::rma_put:
+    t.dirty = true;
+    rdmaPut<MpiMessage>(tid, bytes, local, remote, cq, Iris::sumi::Message::no_ack,
+                        Iris::sumi::Message::pt2pt, qos,
+                        w->comm->rank(), rank, origin_datatype, t.id, MPI_Comm(w->id), 0,
+                        origin_count, otype->packed_size(), remote, int(ty));
+    break;
+  case MpiWindow::rma_get:
+    rdmaGet<MpiMessage>(tid, bytes, local, remote, cq, Iris::sumi::Message::no_ack,
+                        Iris::sumi::Message::pt2pt, qos,
+                        w->comm->rank(), rank, origin_datatype, t.id, MPI_Comm(w->id), 0,
+                        origin_count, otype->packed_size(), remote, int(ty));
+    break;
+  case MpiWindow::rma_accumulate: {
+    // the origin buffer may be reused as soon as the call returns
+    char* copy = nullptr;
+    if (local){
+      copy = new char[bytes];
+      ::memcpy(copy, local, bytes);
+    }
+    queue_->memcopy(bytes);
+    auto* msg = smsgSend<MpiMessage>(tid, bytes, copy, Iris::sumi::Message::no_ack, cq,
+                        Iris::sumi::Message::pt2pt, qos,
+                        w->comm->rank(), rank, origin_datatype, t.id, MPI_Comm(w->id), int(op),
+                        origin_count, otype->packed_size(), remote, int(ty));
+    if (copy){
+      rma_send_buffers_[msg->flowId()] = copy;
+    }
+    break;
+  }
+  default:
+    sst_hg_abort_printf("invalid RMA operation %d issued", int(ty));
+  }
+}
+
+void
+MpiApi::rmaFlush(MpiWindow* w, int rank, bool remote)
+{
+  MpiWindow::Target& t = w->targets[rank];
+  queue_->progressUntil([&t]{ return t.pending == 0; });
+  if (remote && t.dirty){
+    // a put is only known to be done at the origin, reading from the target
+    // after it returns once the data has landed
+    t.dirty = false;
+    ++t.pending;
+    rdmaGet<MpiMessage>(w->comm->peerTask(rank), 8, nullptr, nullptr,
+                        queue_->rmaCqId(), Iris::sumi::Message::no_ack,
+                        Iris::sumi::Message::pt2pt, queue_->rmaQos(),
+                        w->comm->rank(), rank, MPI_BYTE, t.id, MPI_Comm(w->id), 0,
+                        8, 1, nullptr, int(MpiWindow::rma_flush));
+    queue_->progressUntil([&t]{ return t.pending == 0; });
+  }
+}
+
+void
+MpiApi::rmaGroup(MpiWindow* w, MPI_Group group, std::vector<int>& ranks)
+{
+  MpiGroup* grp = getGroup(group);
+  ranks.resize(grp->size());
+  for (int i=0; i < (int) grp->size(); ++i){
+    ranks[i] = w->comm->group()->rankOfTask(grp->at(i));
+    if (ranks[i] == MPI_UNDEFINED){
+      sst_hg_abort_printf("MPI window group member %d is not in the window communicator", i);
+    }
+  }
+}
+
+void
+MpiApi::rmaTargetLock(MpiWindow* w, MpiMessage* msg)
+{
+  bool exclusive = msg->protocol() == MpiWindow::rma_lock_exclusive;
+  bool granted = exclusive
+      ? (w->exclusive_holder < 0 && w->shared_holders == 0)
+      : w->exclusive_holder < 0;
+  if (!granted){
+    w->lock_waiters.push_back(msg);
+    return;
+  }
+
+  if (exclusive){
+    w->exclusive_holder = msg->srcRank();
+  } else {
+    ++w->shared_holders;
+  }
+  msg->advanceStage();
+  smsgSendResponse(msg, 64, nullptr, Iris::sumi::Message::no_ack, queue_->rmaCqId(), queue_->rmaQos());
+}
+
+void
+MpiApi::rmaTargetAccumulate(MpiWindow*  /*w*/, MpiMessage* msg)
+{
+  void* dst = msg->partnerBuffer();
+  void* src = msg->smsgBuffer();
+  if (isNonNullBuffer(dst) && isNonNullBuffer(src)){
+    MPI_Op op = msg->seqnum();
+    if (op == MPI_REPLACE){
+      ::memcpy(dst, src, msg->byteLength());
+    } else if (op >= first_custom_op_id){
+      auto iter = custom_ops_.find(op);
+      if (iter == custom_ops_.end()){
+        sst_hg_throw_printf(SST::Hg::ValueError, "Got invalid MPI_Op %ld", op);
+      }
+      int count = msg->count();
+      MPI_Datatype dtype = msg->type();
+      (*iter->second)(src, dst, &count, &dtype);
+    } else {
+      typeFromId(msg->type())->op(op)(dst, src, msg->count());
+    }
+  }
+  queue_->memcopy(msg->byteLength());
+
+  // a message from another rank holds its own copy of the data
+  if (msg->sender() != rank_ && isNonNullBuffer(src)){
+    delete[] (char*) src;
+  }
+  msg->advanceStage();
+  smsgSendResponse(msg, 64, nullptr, Iris::sumi::Message::no_ack, queue_->rmaCqId(), queue_->rmaQos());
+}
+
+void
+MpiApi::incomingRmaMessage(MpiMessage* msg)
+{
+  switch (msg->SST::Hg::NetworkMessage::type()){
+  case SST::Hg::NetworkMessage::rdma_put_sent_ack:
+  case SST::Hg::NetworkMessage::rdma_get_payload: {
+    // puts, gets and flush reads completing at the origin
+    MpiWindow* w = getWindow(MPI_Win(msg->comm()));
+    --w->targets[msg->dstRank()].pending;
+    delete msg;
+    return;
+  }
+  case SST::Hg::NetworkMessage::smsg_send:
+    break;
+  default:
+    sst_hg_abort_printf("Invalid message type %s for MPI RMA",
+                      SST::Hg::NetworkMessage::tostr(msg->SST::Hg::NetworkMessage::type()));
+  }
+
+  if (msg->stage() > 0){
+    // responses come back to the origin
+    MpiWindow* w = getWindow(MPI_Win(msg->comm()));
+    MpiWindow::Target& t = w->targets[msg->dstRank()];
+    switch (msg->protocol()){
+    case MpiWindow::rma_accumulate: {
+      auto iter = rma_send_buffers_.find(msg->flowId());
+      if (iter != rma_send_buffers_.end()){
+        delete[] iter->second;
+        rma_send_buffers_.erase(iter);
+      }
+      --t.pending;
+      break;
+    }
+    case MpiWindow::rma_lock_shared:
+    case MpiWindow::rma_lock_exclusive:
+      t.locked = true;
+      break;
+    default:
+      sst_hg_abort_printf("Invalid RMA response %s", msg->toString().c_str());
+    }
+    delete msg;
+    return;
+  }
+
+  auto iter = win_map_.find(MPI_Win(msg->tag()));
+  if (iter == win_map_.end()){
+    // a notice that raced the freeing of the window
+    delete msg;
+    return;
+  }
+  MpiWindow* w = iter->second;
+  switch (msg->protocol()){
+  case MpiWindow::rma_accumulate:
+    rmaTargetAccumulate(w, msg);
+    return; //message goes back as the response
+  case MpiWindow::rma_lock_shared:
+  case MpiWindow::rma_lock_exclusive:
+    rmaTargetLock(w, msg);
+    return;
+  case MpiWindow::rma_unlock: {
+    if (w->exclusive_holder == msg->srcRank()){
+      w->exclusive_holder = -1;
+    } else {
+      --w->shared_holders;
+    }
+    std::list<MpiMessage*> waiters;
+    waiters.swap(w->lock_waiters);
+    for (MpiMessage* waiter : waiters){
+      rmaTargetLock(w, waiter);
+    }
+    break;
+  }
+  case MpiWindow::rma_post:
+    ++w->targets[msg->srcRank()].posts;
+    break;
+  case MpiWindow::rma_complete:
+    ++w->completes;
+    break;
+  default:
+    sst_hg_abort_printf("Invalid RMA message %s", msg->toString().c_str());
+  }
+  delete msg;
+}
+
 int
-MpiApi::winCreate(void * /*base*/, MPI_Aint  /*size*/, int  /*disp_unit*/, MPI_Info  /*info*/,
-               MPI_Comm  /*comm*/, MPI_Win * /*win*/)
+MpiApi::put(const void *origin_addr, int origin_count, MPI_Datatype origin_datatype,
+             int target_rank, MPI_Aint target_disp, int target_count, MPI_Datatype target_datatype,
+             MPI_Win win)
 {
-  sst_hg_abort_printf("unimplemented error: MPI_Win_flush_local");
+  rmaIssue(getWindow(win), target_rank, MpiWindow::rma_put, const_cast<void*>(origin_addr),
+           origin_count, origin_datatype, target_disp, target_count, target_datatype,
+           MPI_OP_NULL, "MPI_Put");
   return MPI_SUCCESS;
 }
 
 int
-MpiApi::winFree(MPI_Win * /*win*/)
+MpiApi::get(void *origin_addr, int origin_count, MPI_Datatype origin_datatype,
+             int target_rank, MPI_Aint target_disp, int target_count, MPI_Datatype target_datatype,
+             MPI_Win win)
 {
-  sst_hg_abort_printf("unimplemented error: MPI_Win_flush_local");
+  rmaIssue(getWindow(win), target_rank, MpiWindow::rma_get, origin_addr,
+           origin_count, origin_datatype, target_disp, target_count, target_datatype,
+           MPI_OP_NULL, "MPI_Get");
   return MPI_SUCCESS;
 }
 
 int
-MpiApi::winLock(int  /*lock_type*/, int  /*rank*/, int  /*assert*/, MPI_Win  /*win*/)
+MpiApi::accumulate(const void *origin_addr, int origin_count, MPI_Datatype origin_datatype,
+             int target_rank, MPI_Aint target_disp, int target_count, MPI_Datatype target_datatype,
+             MPI_Op op, MPI_Win win)
 {
-  sst_hg_abort_printf("unimplemented error: MPI_Win_flush_local");
+  rmaIssue(getWindow(win), target_rank, MpiWindow::rma_accumulate, const_cast<void*>(origin_addr),
+           origin_count, origin_datatype, target_disp, target_count, target_datatype,
+           op, "MPI_Accumulate");
   return MPI_SUCCESS;
 }
 
 int
-MpiApi::winUnlock(int  /*rank*/, MPI_Win  /*win*/)
+MpiApi::winFence(int  /*assert*/, MPI_Win win)
 {
-  sst_hg_abort_printf("unimplemented error: MPI_Win_flush_local");
+  MpiWindow* w = getWindow(win);
+  for (int r=0; r < (int) w->targets.size(); ++r){
+    rmaFlush(w, r, true);
+  }
+  waitCollective(startBarrier("MPI_Win_fence", w->comm->id()));
   return MPI_SUCCESS;
 }
 
 int
-MpiApi::get(void * /*origin_addr*/, int  /*origin_count*/, MPI_Datatype  /*origin_datatype*/,
-             int  /*target_rank*/, MPI_Aint  /*target_disp*/, int  /*target_count*/, MPI_Datatype  /*target_datatype*/,
-             MPI_Win  /*win*/)
+MpiApi::winPost(MPI_Group group, int  /*assert*/, MPI_Win win)
 {
-  sst_hg_abort_printf("unimplemented error: MPI_Get");
+  MpiWindow* w = getWindow(win);
+  rmaGroup(w, group, w->exposure_group);
+  w->completes = 0;
+  for (int origin : w->exposure_group){
+    rmaSend(w, origin, MpiWindow::rma_post);
+  }
   return MPI_SUCCESS;
 }
 
 int
-MpiApi::put(const void * /*origin_addr*/, int  /*origin_count*/, MPI_Datatype  /*origin_datatype*/,
-             int  /*target_rank*/, MPI_Aint  /*target_disp*/, int  /*target_count*/, MPI_Datatype  /*target_datatype*/,
-             MPI_Win  /*win*/)
+MpiApi::winStart(MPI_Group group, int  /*assert*/, MPI_Win win)
 {
-  sst_hg_abort_printf("unimplemented error: MPI_Put");
+  MpiWindow* w = getWindow(win);
+  rmaGroup(w, group, w->access_group);
+  for (int target : w->access_group){
+    MpiWindow::Target& t = w->targets[target];
+    queue_->progressUntil([&t]{ return t.posts > 0; });
+    --t.posts;
+  }
   return MPI_SUCCESS;
 }
 
+int
+MpiApi::winComplete(MPI_Win win)
+{
+  MpiWindow* w = getWindow(win);
+  for (int target : w->access_group){
+    rmaFlush(w, target, true);
+    rmaSend(w, target, MpiWindow::rma_complete);
+  }
+  w->access_group.clear();
+  return MPI_SUCCESS;
 }
 
+int
+MpiApi::winWait(MPI_Win win)
+{
+  MpiWindow* w = getWindow(win);
+  queue_->progressUntil([w]{ return w->completes >= (int) w->exposure_group.size(); });
+  w->completes -= w->exposure_group.size();
+  w->exposure_group.clear();
+  return MPI_SUCCESS;
+}
+
+int
+MpiApi::winTest(MPI_Win win, int *flag)
+{
+  MpiWindow* w = getWindow(win);
+  queue_->nonblockingProgress();
+  *flag = w->completes >= (int) w->exposure_group.size();
+  if (*flag){
+    w->completes -= w->exposure_group.size();
+    w->exposure_group.clear();
+  }
+  return MPI_SUCCESS;
+}
+
+int
+MpiApi::winLock(int lock_type, int rank, int  /*assert*/, MPI_Win win)
+{
+  MpiWindow* w = getWindow(win);
+  MpiWindow::Target& t = w->targets[rank];
+  rmaSend(w, rank, lock_type == MPI_LOCK_EXCLUSIVE
+          ? MpiWindow::rma_lock_exclusive : MpiWindow::rma_lock_shared);
+  queue_->progressUntil([&t]{ return t.locked; });
+  return MPI_SUCCESS;
+}
+
+int
+MpiApi::winUnlock(int rank, MPI_Win win)
+{
+  MpiWindow* w = getWindow(win);
+  rmaFlush(w, rank, true);
+  w->targets[rank].locked = false;
+  rmaSend(w, rank, MpiWindow::rma_unlock);
+  return MPI_SUCCESS;
+}
+
+int
+MpiApi::winLockAll(int assert, MPI_Win win)
+{
+  MpiWindow* w = getWindow(win);
+  for (int r=0; r < (int) w->targets.size(); ++r){
+    winLock(MPI_LOCK_SHARED, r, assert, win);
+  }
+  return MPI_SUCCESS;
+}
+
+int
+MpiApi::winUnlockAll(MPI_Win win)
+{
+  MpiWindow* w = getWindow(win);
+  for (int r=0; r < (int) w->targets.size(); ++r){
+    winUnlock(r, win);
+  }
+  return MPI_SUCCESS;
+}
+
+int
+MpiApi::winFlush(int rank, MPI_Win win)
+{
+  rmaFlush(getWindow(win), rank, true);
+  return MPI_SUCCESS;
+}
+
+int
+MpiApi::winFlushLocal(int rank, MPI_Win win)
+{
+  rmaFlush(getWindow(win), rank, false);
+  return MPI_SUCCESS;
+}
+
+int
+MpiApi::winFlushAll(MPI_Win win)
+{
+  MpiWindow* w = getWindow(win);
+  for (int r=0; r < (int) w->targets.size(); ++r){
+    rmaFlush(w, r, true);
+  }
+  return MPI_SUCCESS;
+}
+
+int
+MpiApi::winFlushLocalAll(MPI_Win win)
+{
+  MpiWindow* w = getWindow(win);
+  for (int r=0; r < (int) w->targets.size(); ++r){
+    rmaFlush(w, r, false);
+  }
+  return MPI_SUCCESS;
+}
+
+}
@@ -42,3 +42,244 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 Questions? Contact sst-macro-help@sandia.gov
 */
 #include <mpi_delay_stats.h>
+#include <mpi_request.h>
+#include <iris/sumi/message.h>
+#include <mercury/common/errors.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace SST::MASKMPI {
+
+MpiCriticalPath::MpiCriticalPath(int rank, int nproc) :
+  rank_(rank),
+  nproc_(nproc),
+  is_blocked_(false),
+  wait_(recv_wait),
+  caused_by_(nproc),
+  wait_in_(num_waits)
+{
+}
+
+void
+MpiCriticalPath::start(SST::Hg::Timestamp now)
+{
+  start_ = now;
+  mark_ = now;
+}
+
+void
+MpiCriticalPath::advance(SST::Hg::Timestamp now)
+{
+  //time the rank is blocked is on no chain
+  if (!is_blocked_ && now > mark_){
+    compute_ += now - mark_;
+  }
+  mark_ = now;
+}
+
+void
+MpiCriticalPath::stamp(SST::Iris::sumi::Message* msg, SST::Hg::Timestamp now)
+{
+  advance(now);
+  msg->stampCriticalPath(rank_, now, compute_, comm_);
+}
+
+void
+MpiCriticalPath::receive(SST::Iris::sumi::Message* msg, SST::Hg::Timestamp now)
+{
+  advance(now);
+  int from = msg->criticalPathRank();
+  if (from >= 0){
+    SST::Hg::TimeDelta transfer;
+    if (msg->timeArrived() > msg->criticalPathSent()){
+      transfer = msg->timeArrived() - msg->criticalPathSent();
+    }
+    SST::Hg::TimeDelta remote_comm = msg->criticalPathComm() + transfer;
+    if (msg->criticalPathCompute() + remote_comm > compute_ + comm_){
+      compute_ = msg->criticalPathCompute();
+      comm_ = remote_comm;
+    }
+  }
+
+  if (from < 0 || from >= nproc_){
+    from = rank_;
+  }
+  if (pending_.ticks()){
+    caused_by_[from] += pending_;
+    wait_in_[wait_] += pending_;
+    pending_ = SST::Hg::TimeDelta();
+  }
+}
+
+void
+MpiCriticalPath::waitStart(MpiRequest* req)
+{
+  switch (req->optype()){
+    case MpiRequest::Send:
+      wait_ = send_wait;
+      break;
+    case MpiRequest::Recv:
+      wait_ = recv_wait;
+      break;
+    case MpiRequest::Probe:
+      wait_ = probe_wait;
+      break;
+    case MpiRequest::Collective:
+      if (req->collectiveData()){
+        wait_ = first_collective_wait + req->collectiveData()->ty;
+      }
+      break;
+  }
+}
+
+void
+MpiCriticalPath::blockStart(SST::Hg::Timestamp now)
+{
+  advance(now);
+  is_blocked_ = true;
+  blocked_since_ = now;
+}
+
+void
+MpiCriticalPath::blockEnd(SST::Hg::Timestamp now)
+{
+  if (!is_blocked_){
+    return;
+  }
+  is_blocked_ = false;
+  if (now > blocked_since_){
+    pending_ += now - blocked_since_;
+    total_blocked_ += now - blocked_since_;
+  }
+  mark_ = now;
+}
+
+void
+MpiCriticalPath::finish(SST::Hg::Timestamp now)
+{
+  blockEnd(now);
+  advance(now);
+  if (pending_.ticks()){
+    caused_by_[rank_] += pending_;
+    wait_in_[wait_] += pending_;
+    pending_ = SST::Hg::TimeDelta();
+  }
+}
+
+std::vector<double>
+MpiCriticalPath::summary() const
+{
+  std::vector<double> ret(num_summary);
+  ret[0] = compute_.sec();
+  ret[1] = comm_.sec();
+  ret[2] = total_blocked_.sec();
+  ret[3] = (mark_ - start_).sec();
+  return ret;
+}
+
+std::vector<double>
+MpiCriticalPath::waits() const
+{
+  std::vector<double> ret;
+  ret.reserve(caused_by_.size() + wait_in_.size());
+  for (auto& t : caused_by_){
+    ret.push_back(t.sec());
+  }
+  for (auto& t : wait_in_){
+    ret.push_back(t.sec());
+  }
+  return ret;
+}
+
+const char*
+MpiCriticalPath::waitName(int wait)
+{
+  switch (wait){
+    case send_wait: return "send";
+    case recv_wait: return "recv";
+    case probe_wait: return "probe";
+    case rma_wait: return "rma";
+  }
+  if (wait < first_collective_wait || wait >= num_waits){
+    sst_hg_abort_printf("MpiCriticalPath: invalid wait %d", wait);
+  }
+  return SST::Iris::sumi::Collective::tostr(
+        SST::Iris::sumi::Collective::type_t(wait - first_collective_wait));
+}
+
+static double
+percent(double part, double whole)
+{
+  return whole > 0 ? 100.0 * part / whole : 0;
+}
+
+static void
+reportTop(std::stringstream& sstr, const std::vector<std::pair<double,int>>& entries,
+          double total, int top, bool ranks)
+{
+  std::vector<std::pair<double,int>> sorted(entries);
+  std::sort(sorted.begin(), sorted.end(),
+            [](const std::pair<double,int>& a, const std::pair<double,int>& b){
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+  });
+  int num = std::min(top, int(sorted.size()));
+  for (int i=0; i < num && sorted[i].first > 0; ++i){
+    sstr << "  ";
+    if (ranks){
+      sstr << "rank " << sorted[i].second;
+    } else {
+      sstr << MpiCriticalPath::waitName(sorted[i].second);
+    }
+    sstr << ": " << sorted[i].first << " s ("
+         << percent(sorted[i].first, total) << "%)\n";
+  }
+}
+
+std::string
+MpiCriticalPath::report(const std::vector<double>& summaries,
+                        const std::vector<double>& waits, int top)
+{
+  int nproc = summaries.size() / num_summary;
+  int critical = 0;
+  double length = -1;
+  double runtime = 0;
+  double blocked = 0;
+  for (int r=0; r < nproc; ++r){
+    const double* sum = &summaries[r*num_summary];
+    if (sum[0] + sum[1] > length){
+      length = sum[0] + sum[1];
+      critical = r;
+    }
+    runtime = std::max(runtime, sum[3]);
+    blocked += sum[2];
+  }
+  double compute = summaries[critical*num_summary];
+  double comm = summaries[critical*num_summary + 1];
+
+  std::stringstream sstr;
+  sstr << "critical path: " << length << " s of " << runtime << " s run time ("
+       << percent(length, runtime) << "%), ending on rank " << critical << "\n";
+  sstr << "  compute " << compute << " s (" << percent(compute, length) << "%), network "
+       << comm << " s (" << percent(comm, length) << "%)\n";
+  sstr << "  2x faster compute saves at most " << compute / 2
+       << " s, 2x faster network saves at most " << comm / 2 << " s\n";
+  sstr << "blocked in MPI: " << blocked << " s over all ranks\n";
+
+  std::vector<std::pair<double,int>> entries;
+  for (int r=0; r < nproc; ++r){
+    entries.emplace_back(waits[r], r);
+  }
+  sstr << "blocked time by the rank whose message ended it:\n";
+  reportTop(sstr, entries, blocked, top, true);
+
+  entries.clear();
+  for (int w=0; w < num_waits; ++w){
+    entries.emplace_back(waits[nproc + w], w);
+  }
+  sstr << "blocked time by wait:\n";
+  reportTop(sstr, entries, blocked, top, false);
+  return sstr.str();
+}
+
+}
@@ -46,4 +46,104 @@ Questions? Contact sst-macro-help@sandia.gov
 
 #include <sst/core/statapi/statbase.h>
 #include <sst/core/statapi/statoutput.h>
+#include <mercury/common/timestamp.h>
+#include <iris/sumi/message_fwd.h>
+#include <iris/sumi/collective.h>
+#include <mpi_request_fwd.h>
+
+#include <string>
+#include <vector>
+
+namespace SST::MASKMPI {
+
+/**
+ * @brief The MpiCriticalPath class
+ * Online critical path of an MPI run. Every message carries the compute and
+ * network time of the longest chain of events ending at its send. A receive
+ * extends the local chain with the remote one when that is longer, so at the end
+ * the longest chain over all ranks is the critical path. Time a rank spends
+ * blocked in MPI is on no chain, it is charged to the wait it happened in
+ * and to the rank whose message ended it.
+ */
+class MpiCriticalPath
+{
+ public:
+  typedef enum {
+    send_wait,
+    recv_wait,
+    probe_wait,
+    rma_wait,
+    first_collective_wait
+  } wait_t;
+
+  static const int num_waits = first_collective_wait + SST::Iris::sumi::Collective::donothing + 1;
+
+  /** The values per rank gathered by summary() */
+  static const int num_summary = 4;
+
+  MpiCriticalPath(int rank, int nproc);
+
+  void start(SST::Hg::Timestamp now);
+
+  void stamp(SST::Iris::sumi::Message* msg, SST::Hg::Timestamp now);
+
+  void receive(SST::Iris::sumi::Message* msg, SST::Hg::Timestamp now);
+
+  /**
+   * @brief waitStart
+   * @param req The request the rank is about to block on
+   */
+  void waitStart(MpiRequest* req);
+
+  void waitStart(wait_t wait) {
+    wait_ = wait;
+  }
+
+  void blockStart(SST::Hg::Timestamp now);
+
+  void blockEnd(SST::Hg::Timestamp now);
+
+  void finish(SST::Hg::Timestamp now);
+
+  /**
+   * @return compute, network, blocked and run time in seconds
+   */
+  std::vector<double> summary() const;
+
+  /**
+   * @return Blocked time in seconds caused by each rank, then spent in each wait
+   */
+  std::vector<double> waits() const;
+
+  /**
+   * @brief report
+   * @param summaries The summary() of every rank one after the other
+   * @param waits The waits() summed over all ranks
+   * @param top How many ranks and waits to list
+   * @return The report, one line per entry
+   */
+  static std::string report(const std::vector<double>& summaries,
+                            const std::vector<double>& waits, int top);
+
+  static const char* waitName(int wait);
+
+ private:
+  void advance(SST::Hg::Timestamp now);
+
+  int rank_;
+  int nproc_;
+  bool is_blocked_;
+  int wait_;
+  SST::Hg::Timestamp start_;
+  SST::Hg::Timestamp mark_;
+  SST::Hg::Timestamp blocked_since_;
+  SST::Hg::TimeDelta compute_;
+  SST::Hg::TimeDelta comm_;
+  SST::Hg::TimeDelta total_blocked_;
+  SST::Hg::TimeDelta pending_;
+  std::vector<SST::Hg::TimeDelta> caused_by_;
+  std::vector<SST::Hg::TimeDelta> wait_in_;
+};
+
+}
 
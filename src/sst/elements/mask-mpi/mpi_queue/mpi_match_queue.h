@@ -0,0 +1,218 @@
+/**
+Copyright 2009-2025 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2025, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <mpi_types.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#pragma once
+
+namespace SST::MASKMPI {
+
+/**
+ * A queue of unexpected messages, posted receives or probes kept in the
+ * order they were queued. Entries are also binned by (comm, source, tag)
+ * and entries with a wildcard go on a side list. A search with a full
+ * signature looks only at its bin and the wild entries queued before the
+ * match there, so the oldest match is still found first as MPI requires.
+ * A search with a wildcard walks the whole queue in order.
+ */
+template <class T>
+class MpiMatchQueue
+{
+  struct Key {
+    MPI_Comm comm;
+    int source;
+    int tag;
+
+    bool operator==(const Key& other) const {
+      return comm == other.comm && source == other.source && tag == other.tag;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      uint64_t hash = uint64_t(key.tag) * 0x9e3779b97f4a7c15ULL;
+      hash ^= (uint64_t(uint32_t(key.source)) << 32 | uint32_t(key.comm))
+              + 0x632be59bd9b4e019ULL + (hash << 6) + (hash >> 2);
+      return hash;
+    }
+  };
+
+  struct Entry;
+  using EntryList = std::list<Entry*>;
+
+  struct Entry {
+    T* item;
+    uint64_t seq;
+    Key key;
+    EntryList* bin;
+    typename EntryList::iterator bin_pos;
+    typename EntryList::iterator order_pos;
+  };
+
+ public:
+  using MatchFunc = std::function<bool(T*)>;
+
+  MpiMatchQueue() : next_seq_(0) {}
+
+  ~MpiMatchQueue() {
+    for (Entry* entry : order_){
+      delete entry;
+    }
+  }
+
+  size_t size() const {
+    return order_.size();
+  }
+
+  bool empty() const {
+    return order_.empty();
+  }
+
+  static bool isWild(int source, int tag) {
+    return source == MPI_ANY_SOURCE || tag == MPI_ANY_TAG;
+  }
+
+  void push_back(T* item, MPI_Comm comm, int source, int tag) {
+    Entry* entry = new Entry;
+    entry->item = item;
+    entry->seq = next_seq_++;
+    entry->key = Key{comm, source, tag};
+    entry->bin = isWild(source, tag) ? &wild_ : &bins_[entry->key];
+    entry->bin_pos = entry->bin->insert(entry->bin->end(), entry);
+    entry->order_pos = order_.insert(order_.end(), entry);
+  }
+
+  /**
+   * @brief find The oldest entry that matches a signature
+   * @param remove Whether to take the entry off the queue
+   */
+  T* find(MPI_Comm comm, int source, int tag, const MatchFunc& match, bool remove) {
+    Entry* found = nullptr;
+    if (isWild(source, tag)){
+      found = search(order_, match, UINT64_MAX);
+    } else {
+      auto bin = bins_.find(Key{comm, source, tag});
+      if (bin != bins_.end()){
+        found = search(bin->second, match, UINT64_MAX);
+      }
+      // a wild entry queued before the binned match wins
+      Entry* wild_found = search(wild_, match, found ? found->seq : UINT64_MAX);
+      if (wild_found){
+        found = wild_found;
+      }
+    }
+
+    if (!found){
+      return nullptr;
+    }
+    T* item = found->item;
+    if (remove){
+      take(found);
+    }
+    return item;
+  }
+
+  /**
+   * @brief takeAll Take every entry that matches a full signature,
+   *        oldest first
+   */
+  void takeAll(MPI_Comm comm, int source, int tag, const MatchFunc& match, std::vector<T*>& items) {
+    std::vector<Entry*> found;
+    auto bin = bins_.find(Key{comm, source, tag});
+    if (bin != bins_.end()){
+      collect(bin->second, match, found);
+    }
+    collect(wild_, match, found);
+    std::sort(found.begin(), found.end(),
+              [](Entry* a, Entry* b){ return a->seq < b->seq; });
+    for (Entry* entry : found){
+      items.push_back(entry->item);
+      take(entry);
+    }
+  }
+
+ private:
+  Entry* search(EntryList& list, const MatchFunc& match, uint64_t before) {
+    for (Entry* entry : list){
+      if (entry->seq >= before){
+        break;
+      }
+      if (match(entry->item)){
+        return entry;
+      }
+    }
+    return nullptr;
+  }
+
+  void collect(EntryList& list, const MatchFunc& match, std::vector<Entry*>& found) {
+    for (Entry* entry : list){
+      if (match(entry->item)){
+        found.push_back(entry);
+      }
+    }
+  }
+
+  void take(Entry* entry) {
+    order_.erase(entry->order_pos);
+    entry->bin->erase(entry->bin_pos);
+    if (entry->bin->empty() && entry->bin != &wild_){
+      bins_.erase(entry->key);
+    }
+    delete entry;
+  }
+
+  uint64_t next_seq_;
+  EntryList order_;
+  EntryList wild_;
+  std::unordered_map<Key, EntryList, KeyHash> bins_;
+};
+
+}
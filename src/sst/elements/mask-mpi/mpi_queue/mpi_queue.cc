@@ -93,6 +93,24 @@ MpiQueue::MpiQueue(SST::Params& params, int task_id, MpiApi* api, Iris::sumi::Co
   max_vshort_msg_size_ = params.find<SST::UnitAlgebra>("max_vshort_msg_size", "512B").getRoundedValue();
   max_eager_msg_size_ = params.find<SST::UnitAlgebra>("max_eager_msg_size", "8192B").getRoundedValue();
   use_put_window_ = params.find<bool>("use_put_window", false);
+  rma_qos_ = params.find<int>("rma_qos", params.find<int>("default_qos", 0));
+
+  std::string transfer = params.find<std::string>("datatype_transfer", "none");
+  if (transfer == "none"){
+    datatype_transfer_ = DATATYPE_NONE;
+  } else if (transfer == "pack"){
+    datatype_transfer_ = DATATYPE_PACK;
+  } else if (transfer == "iov"){
+    datatype_transfer_ = DATATYPE_IOV;
+  } else if (transfer == "auto"){
+    datatype_transfer_ = DATATYPE_AUTO;
+  } else {
+    sst_hg_abort_printf("invalid datatype_transfer %s: must be none, pack, iov or auto", transfer.c_str());
+  }
+  iov_max_entries_ = params.find<uint64_t>("iov_max_entries", 64);
+  iov_min_block_size_ = params.find<SST::UnitAlgebra>("iov_min_block_size", "256B").getRoundedValue();
+  iov_setup_delay_ = SST::Hg::TimeDelta(params.find<SST::UnitAlgebra>("iov_setup_delay", "200ns").getValue().toDouble());
+  iov_entry_delay_ = SST::Hg::TimeDelta(params.find<SST::UnitAlgebra>("iov_entry_delay", "10ns").getValue().toDouble());
 
   protocols_.resize(MpiProtocol::NUM_PROTOCOLS);
   protocols_[MpiProtocol::EAGER0] = new Eager0(params, this);
@@ -105,11 +123,15 @@ MpiQueue::MpiQueue(SST::Params& params, int task_id, MpiApi* api, Iris::sumi::Co
 
   api_->allocateCq(pt2pt_cq_, std::bind(&progress_queue::incoming, &queue_, pt2pt_cq_, _1));
   api_->allocateCq(coll_cq_, std::bind(&progress_queue::incoming, &queue_, coll_cq_, _1));
+
+  rma_cq_ = api_->allocateCqId();
+  api_->allocateCq(rma_cq_, std::bind(&progress_queue::incoming, &queue_, rma_cq_, _1));
 }
 
 struct init_struct {
   int pt2pt_cq_id;
   int coll_cq_id;
+  int rma_cq_id;
   bool all_equal;
 };
 
@@ -124,12 +146,14 @@ MpiQueue::init()
       auto& src = srcs[i];
       out.all_equal = src.all_equal
           && out.pt2pt_cq_id == src.pt2pt_cq_id
-          && out.coll_cq_id == src.coll_cq_id;
+          && out.coll_cq_id == src.coll_cq_id
+          && out.rma_cq_id == src.rma_cq_id;
     }
   };
   init_struct init;
   init.coll_cq_id = coll_cq_;
   init.pt2pt_cq_id = pt2pt_cq_;
+  init.rma_cq_id = rma_cq_;
   init.all_equal = true;
   auto cmsg = api_->engine()->allreduce(&init, &init, 1, sizeof(init_struct), 0, init_fxn,
                                         MpiMessage::Message::default_cq);
@@ -192,6 +216,11 @@ MpiQueue::send(MpiRequest *key, int count, MPI_Datatype type,
 //    int(tag), api_->commStr(comm).c_str(),
 //    prot->toString().c_str());
 
+  //eager0 already copies through a bounce buffer, packing folds into that copy
+  if (prot_id != MpiProtocol::EAGER0){
+    datatypeDelay(count, typeobj);
+  }
+
   TaskId dst_tid = comm->peerTask(dest);
   prot->start(buffer, comm->rank(), dest, dst_tid, count, typeobj,
               tag, comm->id(), next_outbound_[dst_tid]++, key);
@@ -201,18 +230,16 @@ MpiQueue::send(MpiRequest *key, int count, MPI_Datatype type,
 MpiMessage*
 MpiQueue::findMatchingRecv(MpiQueueRecvRequest* req)
 {
-  for (auto it = need_recv_match_.begin(); it != need_recv_match_.end(); ++it) {
-    MpiMessage* mess = *it;
-    if (req->matches(mess)) {
+  MpiMessage* mess = need_recv_match_.find(req->comm_, req->source_, req->tag_,
+                        [req](MpiMessage* m){ return req->matches(m); }, true);
+  if (mess) {
 //      mpi_queue_debug("matched recv tag=%s,src=%s on comm=%s to send %s",
 //        api_->tagStr(req->tag_).c_str(),
 //        api_->srcStr(req->source_).c_str(),
 //        api_->commStr(req->comm_).c_str(),
 //        mess->toString().c_str());
 
-      need_recv_match_.erase(it);
-      return mess;
-    }
+    return mess;
   }
 //  mpi_queue_debug("could not match recv tag=%s, src=%s to any of %d sends on comm=%s",
 //    api_->tagStr(req->tag_).c_str(),
@@ -220,7 +247,7 @@ MpiQueue::findMatchingRecv(MpiQueueRecvRequest* req)
 //    need_recv_match_.size(),
 //    api_->commStr(req->comm_).c_str());
 
-  need_send_match_.push_back(req);
+  need_send_match_.push_back(req, req->comm_, req->source_, req->tag_);
   return nullptr;
 }
 
@@ -251,6 +278,10 @@ void
 MpiQueue::finalizeRecv(MpiMessage* msg, MpiQueueRecvRequest* req)
 {
   req->key_->complete(msg);
+  //both eager protocols already copy out of a bounce buffer, unpacking folds into that copy
+  if (msg->protocol() != MpiProtocol::EAGER0 && msg->protocol() != MpiProtocol::EAGER1){
+    datatypeDelay(msg->count(), req->type_);
+  }
   if (req->recv_buffer_ != req->final_buffer_){
     req->type_->unpack_recv(req->recv_buffer_, req->final_buffer_, msg->count());
     delete[] req->recv_buffer_;
@@ -271,16 +302,15 @@ MpiQueue::probe(MpiRequest* key, MpiComm* comm,
 
   mpi_queue_probe_request* req = new mpi_queue_probe_request(key, comm->id(), source, tag);
   // Figure out whether we already have a matching message.
-  for (auto it = need_recv_match_.begin(); it != need_recv_match_.end(); ++it) {
-    MpiMessage* mess = *it;
-    if (req->matches(mess)){
-      // We're good to go.
-      req->complete(mess);
-      return;
-    }
+  MpiMessage* mess = need_recv_match_.find(comm->id(), source, tag,
+                        [req](MpiMessage* m){ return req->matches(m); }, false);
+  if (mess){
+    // We're good to go.
+    req->complete(mess);
+    return;
   }
   // If we get here, we still need to wait for the message.
-  probelist_.push_back(req);
+  probelist_.push_back(req, comm->id(), source, tag);
 }
 
 //
@@ -297,13 +327,12 @@ MpiQueue::iprobe(MpiComm* comm,
 //    api_->commStr(comm).c_str());
 
   mpi_queue_probe_request req(NULL, comm->id(), source, tag);
-  for (auto it = need_recv_match_.begin(); it != need_recv_match_.end(); ++it) {
-    MpiMessage* mess = *it;
-    if (req.matches(mess)) {
-      // This is it
-      if (stat != MPI_STATUS_IGNORE) mess->buildStatus(stat);
-      return true;
-    }
+  MpiMessage* mess = need_recv_match_.find(comm->id(), source, tag,
+                        [&req](MpiMessage* m){ return req.matches(m); }, false);
+  if (mess) {
+    // This is it
+    if (stat != MPI_STATUS_IGNORE) mess->buildStatus(stat);
+    return true;
   }
   return false;
 }
@@ -311,18 +340,18 @@ MpiQueue::iprobe(MpiComm* comm,
 MpiQueueRecvRequest*
 MpiQueue::findMatchingRecv(MpiMessage* message)
 {
-  auto end = need_send_match_.end();
-  for (auto it = need_send_match_.begin(); it != end;) {
-    auto* req = *it;
-    auto tmp = it++;
-    if (req->isCancelled()) {
-      need_send_match_.erase(tmp);
-    } else if (req->matches(message)) {
-      need_send_match_.erase(tmp);
+  // cancelled receives found on the way are dropped
+  auto match = [message](MpiQueueRecvRequest* req){
+    return req->isCancelled() || req->matches(message);
+  };
+  MpiQueueRecvRequest* req;
+  while ((req = need_send_match_.find(message->comm(), message->srcRank(),
+                                      message->tag(), match, true))) {
+    if (!req->isCancelled()) {
       return req;
     }
   }
-  need_recv_match_.push_back(message);
+  need_recv_match_.push_back(message, message->comm(), message->srcRank(), message->tag());
   return nullptr;
 }
 
@@ -400,16 +429,13 @@ MpiQueue::incomingPt2ptMessage(Iris::sumi::Message* m)
 void
 MpiQueue::notifyProbes(MpiMessage* message)
 {
-  auto pit = probelist_.begin();
-  auto pend = probelist_.end();
-  while (pit != pend) {
-    auto tmp = pit++;
-    mpi_queue_probe_request* preq = *tmp;
-    if (preq->matches(message)){
-      probelist_.erase(tmp);
-      preq->complete(message);
-      delete preq;
-    }
+  std::vector<mpi_queue_probe_request*> matched;
+  probelist_.takeAll(message->comm(), message->srcRank(), message->tag(),
+                     [message](mpi_queue_probe_request* preq){ return preq->matches(message); },
+                     matched);
+  for (mpi_queue_probe_request* preq : matched) {
+    preq->complete(message);
+    delete preq;
   }
 }
 
@@ -423,10 +449,17 @@ MpiQueue::handlePt2ptMessage(MpiMessage* message)
 void
 MpiQueue::incomingMessage(Iris::sumi::Message* msg)
 {
+  MpiCriticalPath* crit_path = api_->criticalPath();
+  if (crit_path){
+    crit_path->receive(msg, api_->now());
+  }
+
   if (msg->cqId() == pt2pt_cq_){
     incomingPt2ptMessage(msg);
   } else if (msg->cqId() == coll_cq_){
     incomingCollectiveMessage(msg);
+  } else if (msg->cqId() == rma_cq_){
+    api_->incomingRmaMessage(safe_cast(MpiMessage, msg));
   } else {
     sst_hg_abort_printf("Got bad completion queue %d for %s",
                       msg->cqId(), msg->toString().c_str());
@@ -453,9 +486,15 @@ MpiQueue::progressLoop(MpiRequest* req)
   //mpi_queue_debug("entering progress loop");
 
   SST::Hg::Timestamp wait_start = api_->now();
+  MpiCriticalPath* crit_path = api_->criticalPath();
+  if (crit_path){
+    crit_path->waitStart(req);
+  }
   while (!req->isComplete()) {
     //mpi_queue_debug("blocking on progress loop");
+    if (crit_path) crit_path->blockStart(api_->now());
     Iris::sumi::Message* msg = queue_.find_any();
+    if (crit_path) crit_path->blockEnd(api_->now());
     if (!msg){
       sst_hg_abort_printf("polling returned null message");
     }
@@ -467,6 +506,24 @@ MpiQueue::progressLoop(MpiRequest* req)
   return api_->now();
 }
 
+void
+MpiQueue::progressUntil(const std::function<bool()>& done)
+{
+  MpiCriticalPath* crit_path = api_->criticalPath();
+  if (crit_path){
+    crit_path->waitStart(MpiCriticalPath::rma_wait);
+  }
+  while (!done()) {
+    if (crit_path) crit_path->blockStart(api_->now());
+    Iris::sumi::Message* msg = queue_.find_any();
+    if (crit_path) crit_path->blockEnd(api_->now());
+    if (!msg){
+      sst_hg_abort_printf("polling returned null message");
+    }
+    incomingMessage(msg);
+  }
+}
+
 bool
 MpiQueue::atLeastOneComplete(const std::vector<MpiRequest*>& req)
 {
@@ -524,6 +581,29 @@ MpiQueue::memcopy(uint64_t bytes)
   api_->memcopyDelay(bytes);
 }
 
+void
+MpiQueue::datatypeDelay(int count, MpiType* type)
+{
+  if (datatype_transfer_ == DATATYPE_NONE || type->contiguous() || count <= 0){
+    return;
+  }
+
+  uint64_t bytes = count * uint64_t(type->packed_size());
+  uint64_t iovs = count * uint64_t(type->iovCount());
+  bool gather = datatype_transfer_ == DATATYPE_IOV;
+  if (datatype_transfer_ == DATATYPE_AUTO){
+    //NICs take a bounded gather list, and many tiny pieces are cheaper to copy
+    gather = iovs <= iov_max_entries_ && bytes >= iovs * iov_min_block_size_;
+  }
+
+  if (gather){
+    //building the descriptors, the NIC then moves the data in place
+    api_->compute(iov_setup_delay_ + double(iovs) * iov_entry_delay_);
+  } else {
+    api_->memcopyDelay(bytes);
+  }
+}
+
 void
 MpiQueue::bufferUnexpected(MpiMessage* msg)
 {
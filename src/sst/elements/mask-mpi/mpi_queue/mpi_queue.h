@@ -60,9 +60,11 @@ Questions? Contact sst-macro-help@sandia.gov
 
 #include <mpi_queue/mpi_queue_recv_request_fwd.h>
 #include <mpi_queue/mpi_queue_probe_request.h>
+#include <mpi_queue/mpi_match_queue.h>
 
 #include <sst/core/params.h>
 
+#include <functional>
 #include <queue>
 #include <mercury/common/timestamp.h>
 
@@ -112,6 +114,13 @@ class MpiQueue
 
   void memcopy(uint64_t bytes);
 
+  /**
+   * @brief datatypeDelay Charge moving count elements of a noncontiguous
+   *        type between the user buffer and the wire, either as a pack/unpack
+   *        copy or as a NIC gather/scatter over its IOVs
+   */
+  void datatypeDelay(int count, MpiType* type);
+
   SST::Hg::Timestamp now() const;
 
   void finalizeRecv(MpiMessage* msg,
@@ -146,6 +155,19 @@ class MpiQueue
     return coll_cq_;
   }
 
+  int rmaCqId() const {
+    return rma_cq_;
+  }
+
+  int rmaQos() const {
+    return rma_qos_;
+  }
+
+  /**
+   * @brief progressUntil Handle incoming messages until done returns true
+   */
+  void progressUntil(const std::function<bool()>& done);
+
  private:
   struct sortbyseqnum {
     bool operator()(MpiMessage* a, MpiMessage*b) const;
@@ -190,13 +212,13 @@ class MpiQueue
   std::unordered_map<TaskId, hold_list_t> held_;
 
   /// Inbound messages waiting for a matching receive request.
-  std::list<MpiMessage*> need_recv_match_;
-  std::list<MpiQueueRecvRequest*> need_send_match_;
+  MpiMatchQueue<MpiMessage> need_recv_match_;
+  MpiMatchQueue<MpiQueueRecvRequest> need_send_match_;
 
   std::vector<MpiProtocol*> protocols_;
 
   /// Probe requests watching
-  std::list<SST::MASKMPI::mpi_queue_probe_request*> probelist_;
+  MpiMatchQueue<SST::MASKMPI::mpi_queue_probe_request> probelist_;
 
   progress_queue queue_;
 
@@ -210,8 +232,22 @@ class MpiQueue
   int max_eager_msg_size_;
   bool use_put_window_;
 
+  enum DatatypeTransfer {
+    DATATYPE_NONE, //no cost beyond the protocol's own copies
+    DATATYPE_PACK,
+    DATATYPE_IOV,
+    DATATYPE_AUTO
+  };
+  DatatypeTransfer datatype_transfer_;
+  uint64_t iov_max_entries_;
+  uint64_t iov_min_block_size_;
+  SST::Hg::TimeDelta iov_setup_delay_;
+  SST::Hg::TimeDelta iov_entry_delay_;
+
   int pt2pt_cq_;
   int coll_cq_;
+  int rma_cq_;
+  int rma_qos_;
 
 };
 
@@ -64,6 +64,7 @@ MpiType::MpiType() :
   vdata_(nullptr),
   idata_(nullptr),
   builtin_(false),
+  iovs_(1),
   size_(-1)
 {
 }
@@ -157,6 +158,7 @@ MpiType::init_primitive(const char* labelit, MpiType* b1, MpiType* b2, int s)
   type_ = PAIR;
   extent_ = s;
   size_ = b1->size_ + b2->size_;
+  iovs_ = size_ == extent_ ? 1 : 2;
   pdata_ = new pairdata;
   pdata_->base1 = b1;
   pdata_->base2 = b2;
@@ -206,6 +208,11 @@ MpiType::init_vector(const std::string &labelit, MpiType* base,
   //and the underlying type is contiguous
   //then this type is again contiguous
   contiguous_ = byte_stride == block_extent && base->contiguous();
+  if (contiguous_){
+    iovs_ = 1;
+  } else {
+    iovs_ = base->contiguous() ? count : count * block * base->iovCount();
+  }
 
 }
 
@@ -219,6 +226,14 @@ MpiType::init_indexed(const std::string &labelit,
   extent_ = ext;
   idata_ = dat;
   contiguous_ = extent_ == size_;
+  iovs_ = 0;
+  if (contiguous_){
+    iovs_ = 1;
+  } else {
+    for (const ind_block& blk : idata_->blocks){
+      iovs_ += blk.base->contiguous() ? 1 : blk.num * blk.base->iovCount();
+    }
+  }
 }
 
 MpiType::~MpiType()
@@ -156,6 +156,14 @@ class MpiType
     return contiguous_;
   }
 
+  /**
+   * @return The number of contiguous pieces one element of this type is
+   *         made of, i.e. the IOV entries a NIC needs to gather it in place
+   */
+  int iovCount() const {
+    return iovs_;
+  }
+
   std::unordered_map<MPI_Op, SST::Iris::sumi::reduce_fxn> fxns_;
 
   template <typename data_t>
@@ -291,6 +299,8 @@ class MpiType
 
   bool builtin_;
 
+  int iovs_;
+
   int size_; //this is the packed size !!!
   size_t extent_; //holds the extent, as defined by the MPI standard
 };
@@ -0,0 +1,123 @@
+/**
+Copyright 2009-2025 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2025, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <mpi_integers.h>
+#include <mpi_types.h>
+#include <mpi_comm/mpi_comm_fwd.h>
+#include <mpi_message.h>
+
+#include <cstdint>
+#include <list>
+#include <vector>
+
+#pragma once
+
+namespace SST::MASKMPI {
+
+/**
+ * The state of one rank in an MPI_Win. Puts and gets are RDMA operations
+ * issued straight to the transport, the target takes no part in them.
+ * Accumulates, locks and PSCW notices are small messages handled by the
+ * target when it progresses, since SUMI has no network atomics.
+ *
+ * RMA messages carry the target's window id in the tag, the origin's in
+ * the comm field, the MPI_Op of an accumulate in the sequence number and
+ * the target address in the partner buffer. Responses are stage 1.
+ */
+struct MpiWindow
+{
+  enum rma_t {
+    rma_put,
+    rma_get,
+    rma_flush,
+    rma_accumulate,
+    rma_lock_shared,
+    rma_lock_exclusive,
+    rma_unlock,
+    rma_post,
+    rma_complete
+  };
+
+  struct Target {
+    Target() : base(0), disp_unit(1), id(MPI_WIN_NULL),
+      pending(0), dirty(false), posts(0), locked(false) {}
+    uint64_t base;
+    int disp_unit;
+    MPI_Win id;
+    /** Operations not yet complete at the origin */
+    int pending;
+    /** Puts done since the last flush, which only complete locally */
+    bool dirty;
+    /** Posts seen from the target not yet used by a start */
+    int posts;
+    bool locked;
+  };
+
+  MpiWindow(MpiComm* comm, MPI_Win id, void* base, MPI_Aint size, int disp_unit) :
+    comm(comm), id(id), base(base), size(size), disp_unit(disp_unit),
+    completes(0), exclusive_holder(-1), shared_holders(0)
+  {
+  }
+
+  MpiComm* comm;
+  MPI_Win id;
+  void* base;
+  MPI_Aint size;
+  int disp_unit;
+
+  std::vector<Target> targets;
+
+  /** The targets of a PSCW access epoch */
+  std::vector<int> access_group;
+  /** The origins of a PSCW exposure epoch */
+  std::vector<int> exposure_group;
+  int completes;
+
+  /** Passive target lock held on this rank's memory */
+  int exclusive_holder;
+  int shared_holders;
+  std::list<MpiMessage*> lock_waiters;
+};
+
+}
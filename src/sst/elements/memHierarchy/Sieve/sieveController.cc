@@ -21,6 +21,9 @@
 #include <sst/core/sst_config.h>
 #include <sst/core/interfaces/stringEvent.h>
 
+#include <algorithm>
+#include <set>
+
 #include "sieveController.h"
 #include "../memEvent.h"
 
@@ -28,6 +31,16 @@ using namespace SST;
 using namespace SST::MemHierarchy;
 
 void Sieve::recordMiss(Addr addr, bool isRead) {
+    if (classify_) {
+        missCount_++;
+        if (classifyInterval_ != 0 && missCount_ % classifyInterval_ == 0) {
+            stringstream fileName;
+            fileName << outFileName << "-interval-" << intervalCount_ << ".txt";
+            intervalCount_++;
+            outputClassification(fileName.str());
+        }
+    }
+
     allocMap_t::iterator allocI = activeAllocMap.lower_bound(addr);
 
     // lower_bound returns iterator to address just above or equal to addr
@@ -54,6 +67,8 @@ void Sieve::recordMiss(Addr addr, bool isRead) {
                 evI->second.second++;
                 statWriteMisses->addData(1);
             }
+            if (classify_)
+                classifyMiss(allocID, addr);
             return;
         }
     }
@@ -75,6 +90,8 @@ void Sieve::processAllocEvent(SST::Event* event) {
         // add to the list of active allocations (i.e. not FREEd)
         mallocEntry entry = {ev->getInstructionPointer(), ev->getAllocateLength()};
         activeAllocMap[ev->getVirtualAddress()] = entry;
+        if (classify_)
+            patternMap[entry.id].bytes += entry.size;
 
 #ifdef __SST_DEBUG_OUTPUT__
         if (activeAllocMap.find(ev->getVirtualAddress()) != activeAllocMap.end()) {
@@ -112,6 +129,51 @@ void Sieve::processAllocEvent(SST::Event* event) {
     }
 }
 
+void Sieve::classifyMiss(uint64_t allocID, Addr addr) {
+    sitePattern &site = patternMap[allocID];
+    Addr line = toBaseAddr(addr);
+
+    if (site.misses != 0) {
+        int64_t stride = (int64_t)(line - site.lastLine);
+        if (stride == (int64_t)lineSize_ || stride == -(int64_t)lineSize_)
+            site.sequential++;
+        else if (stride != 0 && stride == site.lastStride)
+            site.strided++;
+        site.lastStride = stride;
+    }
+    site.lastLine = line;
+    site.misses++;
+
+    // Reuse distance on a hash-sampled subset of lines keeps the per-site table small
+    uint64_t hash = ((line / lineSize_) * 0x9E3779B97F4A7C15ULL) >> 32;
+    if (hash % sampleRate_ != 0)
+        return;
+
+    site.sampledRefs++;
+    std::unordered_map<Addr, uint64_t>::iterator sample = site.sampledLines.find(line);
+    if (sample != site.sampledLines.end()) {
+        uint64_t distance = missCount_ - sample->second;
+        int bucket = 0;
+        while (bucket < REUSE_BUCKETS - 1 && (distance >> (bucket + 1)) != 0)
+            bucket++;
+        site.reuseHist[bucket]++;
+        sample->second = missCount_;
+        return;
+    }
+
+    if (sampleLines_ == 0)
+        return;
+    if (site.sampledLines.size() >= sampleLines_) {
+        std::unordered_map<Addr, uint64_t>::iterator oldest = site.sampledLines.begin();
+        for (sample = site.sampledLines.begin(); sample != site.sampledLines.end(); sample++) {
+            if (sample->second < oldest->second)
+                oldest = sample;
+        }
+        site.sampledLines.erase(oldest);
+    }
+    site.sampledLines[line] = missCount_;
+}
+
 void Sieve::processEvent(SST::Event* ev, int link) {
     MemEvent* event = static_cast<MemEvent*>(ev);
     Command cmd     = event->getCmd();
@@ -202,6 +264,11 @@ void Sieve::outputStats(int marker) {
     if (-1 != marker)  {
         fileName << "-" << marker;
     }
+    if (classify_) {
+        outputClassification(fileName.str() + "-classify.txt");
+        if (resetStatsOnOutput)
+            patternMap.clear();
+    }
     fileName << ".txt";
 
     // create new file
@@ -239,6 +306,61 @@ void Sieve::outputStats(int marker) {
     delete output_file;
 }
 
+void Sieve::outputClassification(const std::string& fileName) {
+    Output* output_file = new Output("",0,0,SST::Output::FILE, fileName);
+
+    // Placement: sites with the most misses per allocated byte go to the fast tier until it is full
+    vector<pair<double, uint64_t> > density;
+    for (patternMap_t::iterator i = patternMap.begin(); i != patternMap.end(); i++) {
+        if (i->second.misses != 0)
+            density.push_back(make_pair((double)i->second.misses / std::max(i->second.bytes, lineSize_), i->first));
+    }
+    std::sort(density.rbegin(), density.rend());
+    std::set<uint64_t> fastSites;
+    uint64_t fastUsed = 0;
+    for (vector<pair<double, uint64_t> >::iterator it = density.begin(); it != density.end(); it++) {
+        uint64_t bytes = patternMap[it->second].bytes;
+        if (fastUsed + bytes <= fastBytes_) {
+            fastUsed += bytes;
+            fastSites.insert(it->second);
+        }
+    }
+
+    output_file->output(CALL_INFO, "#Allocation miss patterns (mallocID, misses, bytes, sequential, strided, random, last stride, reuse fraction, median reuse distance, pattern, placement):\n");
+    for (vector<pair<double, uint64_t> >::iterator it = density.begin(); it != density.end(); it++) {
+        sitePattern &site = patternMap[it->second];
+        double pairs = site.misses > 1 ? site.misses - 1 : 1;
+        double sequential = site.sequential / pairs;
+        double strided = site.strided / pairs;
+        double random = site.misses > 1 ? 1.0 - sequential - strided : 0.0;
+
+        uint64_t reused = 0;
+        for (int b = 0; b < REUSE_BUCKETS; b++)
+            reused += site.reuseHist[b];
+        double reuseFraction = site.sampledRefs ? (double)reused / site.sampledRefs : 0.0;
+        uint64_t median = 0;
+        uint64_t seen = 0;
+        for (int b = 0; b < REUSE_BUCKETS && reused != 0; b++) {
+            seen += site.reuseHist[b];
+            if (2 * seen >= reused) {
+                median = 1ULL << b;
+                break;
+            }
+        }
+
+        const char* pattern = "random";
+        if (site.misses < 2)        pattern = "unknown";
+        else if (sequential >= 0.5) pattern = "streaming";
+        else if (strided >= 0.5)    pattern = "strided";
+        else if (reuseFraction >= 0.5) pattern = "reuse";
+
+        output_file->output(CALL_INFO, "%" PRIu64 " %" PRIu64 " %" PRIu64 " %.3f %.3f %.3f %" PRId64 " %.3f %" PRIu64 " %s %s\n",
+                            it->second, site.misses, site.bytes, sequential, strided, random, site.lastStride,
+                            reuseFraction, median, pattern, fastSites.count(it->second) ? "fast" : "slow");
+    }
+    delete output_file;
+}
+
 void Sieve::finish(){
     outputStats(-1);
 }
@@ -55,7 +55,12 @@ public:
             {"debug",                   "(uint) Print debug information. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
             {"debug_level",             "(uint) Debugging/verbosity level. Between 0 and 10", "0"},
             {"output_file",             "(string) Name of file to output malloc information to. Will have sequence number (and optional marker number) and .txt appended to it. E.g. sieveMallocRank-3.txt", "sieveMallocRank"},
-            {"reset_stats_at_buoy",     "(bool) Whether to reset allocation hit/miss stats when a buoy is found (i.e., when a new output file is dumped). Any value other than 0 is true." "0"} )
+            {"reset_stats_at_buoy",     "(bool) Whether to reset allocation hit/miss stats when a buoy is found (i.e., when a new output file is dumped). Any value other than 0 is true." "0"},
+            {"classify",                "(bool) Classify each allocation site's misses online (streaming, strided, random, reuse) and write a classification with placement hints next to each output file", "0"},
+            {"classify_interval",       "(uint) Also write the classification every this many misses, to <output_file>-interval-<n>.txt. 0 to disable", "0"},
+            {"classify_sample_rate",    "(uint) Reuse distance is sampled on one in this many lines, chosen by address hash", "16"},
+            {"classify_sample_lines",   "(uint) Sampled lines remembered per allocation site for reuse distance. The oldest is dropped when full", "64"},
+            {"placement_fast_bytes",    "(string) Capacity of the fast memory tier (e.g. HBM) for placement hints. Sites with the most misses per allocated byte are placed there first", "0B"} )
 
     SST_ELI_DOCUMENT_PORTS(
             {"cpu_link_%(port)d", "Ports connected to the CPUs", {"memHierarchy.MemEventBase"}},
@@ -113,6 +118,37 @@ private:
 
     void recordMiss(Addr addr, bool isRead);
 
+    /** Online access pattern of one allocation site's misses. Memory is bounded by the sampled line table */
+    static const int REUSE_BUCKETS = 32;
+    struct sitePattern {
+        uint64_t misses;
+        uint64_t bytes;             // Bytes allocated by this site
+        Addr lastLine;
+        int64_t lastStride;
+        uint64_t sequential;        // Misses one line from the previous miss
+        uint64_t strided;           // Misses repeating the previous (non-unit) stride
+        uint64_t sampledRefs;       // Misses to sampled lines
+        uint64_t reuseHist[REUSE_BUCKETS]; // log2(misses since last miss to the same sampled line)
+        std::unordered_map<Addr, uint64_t> sampledLines; // Sampled line -> miss count at its last miss
+
+        sitePattern() : misses(0), bytes(0), lastLine(0), lastStride(0), sequential(0), strided(0), sampledRefs(0) {
+            for (int i = 0; i < REUSE_BUCKETS; i++) reuseHist[i] = 0;
+        }
+    };
+    typedef std::unordered_map<uint64_t, sitePattern> patternMap_t;
+
+    bool classify_;
+    uint64_t classifyInterval_;
+    uint64_t sampleRate_;
+    size_t sampleLines_;
+    uint64_t fastBytes_;
+    uint64_t missCount_;        // Misses seen, the clock for reuse distance
+    uint64_t intervalCount_;
+    patternMap_t patternMap;
+
+    void classifyMiss(uint64_t allocID, Addr addr);
+    void outputClassification(const std::string& fileName);
+
     /** Destructor for Sieve Component */
     ~Sieve();
 
@@ -161,7 +197,8 @@ private:
         Similar to Cache Array, this class is OO-based so different replacement policies are simply
         subclasses of the main based abstract class (ReplacementMgr), therefore they need to implement
         certain functions in order for them to work properly. Implemented policies are: least-recently-used (lru),
-        least-frequently-used (lfu), most-recently-used (mru), random, and not-most-recently-used (nmru).
+        least-frequently-used (lfu), most-recently-used (mru), random, not-most-recently-used (nmru),
+        and the re-reference interval prediction family (srrip, brrip, drrip, ship).
 
         - Hash:  Class implements common hashing functions.  These functions are used by the Cache Array
         class.  For instance, a typical set associative array uses a simple hash function, whereas
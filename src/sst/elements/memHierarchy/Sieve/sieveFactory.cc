@@ -75,6 +75,22 @@ Sieve::Sieve(ComponentId_t id, Params &params) : Component(id) {
 
     resetStatsOnOutput = params.find<bool>("reset_stats_at_buoy", 0) != 0;
 
+    /* online classification */
+    classify_ = params.find<bool>("classify", false);
+    classifyInterval_ = params.find<uint64_t>("classify_interval", 0);
+    sampleRate_ = params.find<uint64_t>("classify_sample_rate", 16);
+    sampleLines_ = params.find<size_t>("classify_sample_lines", 64);
+    if (sampleRate_ == 0) output_->fatal(CALL_INFO, -1, "Invalid param: classify_sample_rate - must be at least 1\n");
+    string fastStr = params.find<std::string>("placement_fast_bytes", "0B");
+    fixByteUnits(fastStr);
+    UnitAlgebra fastUA(fastStr);
+    if (!fastUA.hasUnits("B")) {
+        output_->fatal(CALL_INFO, -1, "Invalid param: placement_fast_bytes - must have units of bytes (e.g., B, KB,etc.)\n");
+    }
+    fastBytes_ = fastUA.getRoundedValue();
+    missCount_ = 0;
+    intervalCount_ = 0;
+
     // optional link for allocation / free tracking
     configureLinks();
 
@@ -41,21 +41,36 @@ Bus::Bus(ComponentId_t id, Params& params) : Component(id) {
     configureLinks();
     idleCount_ = 0;
     busOn_ = true;
+
+    lanes_.resize(split_ ? 2 : 1);
+    credits_.assign(numHighPorts_ + numLowPorts_, portCredits_);
+
+    stat_creditStalls_ = registerStatistic<uint64_t>("credit_stalls");
+    stat_widthStalls_.push_back(registerStatistic<uint64_t>("width_stalls", "request"));
+    if (split_)
+        stat_widthStalls_.push_back(registerStatistic<uint64_t>("width_stalls", "response"));
 }
 
 
 void Bus::processIncomingEvent(SST::Event* ev) {
-    eventQueue_.push(ev);
+    bool response = split_ && static_cast<MemEventBase*>(ev)->isResponse();
+    lanes_[response ? 1 : 0].push_back(ev);
     if (!busOn_) {
         reregisterClock(defaultTimeBase_, clockHandler_);
         busOn_ = true;
         idleCount_ = 0;
+        // Ports drained while the clock was off
+        credits_.assign(credits_.size(), portCredits_);
     }
 }
 
 bool Bus::clockTick(Cycle_t time) {
 
-    if (eventQueue_.empty())
+    bool empty = true;
+    for (auto& lane : lanes_)
+        empty = empty && lane.empty();
+
+    if (empty)
         idleCount_++;
 
     if (idleCount_ > idleMax_) {
@@ -64,22 +79,51 @@ bool Bus::clockTick(Cycle_t time) {
         return true;
     }
 
-    while (!eventQueue_.empty()) {
-        SST::Event* event = eventQueue_.front();
+    if (portCredits_) {
+        for (auto& credit : credits_) {
+            if (credit < portCredits_)
+                credit++;
+        }
+    }
+
+    for (unsigned int lane = 0; lane < lanes_.size(); lane++)
+        forwardLane(lane);
+
+    return false;
+}
+
+
+void Bus::forwardLane(unsigned int lane) {
+    std::deque<SST::Event*>& queue = lanes_[lane];
+    uint64_t sent = 0;
+    std::deque<SST::Event*>::iterator it = queue.begin();
+    while (it != queue.end()) {
+        if (!drain_ && sent == busWidth_) {
+            stat_widthStalls_[lane]->addData(1);
+            break;
+        }
+
+        // A port out of credits stays out for the rest of the cycle, so
+        // skipping its messages keeps them in order
+        if (portCredits_) {
+            unsigned int port = portIndex(lookupNode(static_cast<MemEventBase*>(*it)->getDst()));
+            if (credits_[port] == 0) {
+                stat_creditStalls_->addData(1);
+                it++;
+                continue;
+            }
+            credits_[port]--;
+        }
 
         if (broadcast_)
-            broadcastEvent(event);
+            broadcastEvent(*it);
         else
-            sendSingleEvent(event);
+            sendSingleEvent(*it);
 
-        eventQueue_.pop();
+        it = queue.erase(it);
+        sent++;
         idleCount_ = 0;
-
-        if (!drain_ )
-            break;
     }
-
-    return false;
 }
 
 
@@ -131,6 +175,17 @@ void Bus::mapNodeEntry(const std::string& name, SST::Link* link) {
     nameMap_[name] = link;
 }
 
+unsigned int Bus::portIndex(SST::Link* link) {
+    for (int i = 0; i < numHighPorts_; i++) {
+        if (highNetPorts_[i] == link) return i;
+    }
+    for (int i = 0; i < numLowPorts_; i++) {
+        if (lowNetPorts_[i] == link) return numHighPorts_ + i;
+    }
+    dbg_.fatal(CALL_INFO, -1, "%s, Error: Bus lookup of port index for an unknown link\n", getName().c_str());
+    return 0;
+}
+
 SST::Link* Bus::lookupNode(const std::string& name) {
     std::map<std::string, SST::Link*>::iterator it = nameMap_.find(name);
     if (nameMap_.end() == it) {
@@ -193,8 +248,13 @@ void Bus::configureParameters(SST::Params& params) {
     std::string frequency = params.find<std::string>("bus_frequency", "Invalid");
     broadcast_    = params.find<bool>("broadcast", 0);
     drain_        = params.find<bool>("drain_bus", false);
+    split_        = params.find<bool>("split_transaction", false);
+    busWidth_     = params.find<uint64_t>("bus_width", 1);
+    portCredits_  = params.find<uint64_t>("port_credits", 0);
 
     if (frequency == "Invalid") dbg_.fatal(CALL_INFO, -1, "Bus Frequency was not specified\n");
+    if (busWidth_ == 0) dbg_.fatal(CALL_INFO, -1, "%s, Error: bus_width must be at least 1\n", getName().c_str());
+    if (portCredits_ != 0 && broadcast_) dbg_.fatal(CALL_INFO, -1, "%s, Error: port_credits is not supported with broadcast\n", getName().c_str());
 
      /* Multiply Frequency times two.  This is because an SST Bus components has
         2 SST Links (highNEt & LowNet) and thus it takes a least 2 cycles for any
@@ -337,10 +397,16 @@ void Bus::serialize_order(SST::Core::Serialization::serializer& ser) {
     SST_SER(broadcast_);
     SST_SER(busOn_);
     SST_SER(drain_);
+    SST_SER(split_);
+    SST_SER(busWidth_);
+    SST_SER(portCredits_);
     SST_SER(clockHandler_);
     SST_SER(defaultTimeBase_);
     SST_SER(highNetPorts_);
     SST_SER(lowNetPorts_);
     SST_SER(nameMap_);
-    SST_SER(eventQueue_);
+    SST_SER(lanes_);
+    SST_SER(credits_);
+    SST_SER(stat_creditStalls_);
+    SST_SER(stat_widthStalls_);
 }
@@ -16,7 +16,7 @@
 #ifndef SST_MEMHIERARCHY_BUS_H
 #define SST_MEMHIERARCHY_BUS_H
 
-#include <queue>
+#include <deque>
 #include <map>
 
 #include <sst/core/event.h>
@@ -40,6 +40,13 @@ class BusEvent;
  *
  *  Connects one or more upper level components to one or more lower level components
  *  over a bus like interface
+ *
+ *  By default all messages share one lane and the bus forwards one per cycle. With
+ *  'split_transaction' requests and responses travel on separate lanes, so responses
+ *  are never queued behind requests. Each lane forwards up to 'bus_width' messages a
+ *  cycle. With 'port_credits' each destination port accepts at most that many messages
+ *  before draining one per cycle; messages to a port without credits wait while later
+ *  messages to other ports go ahead, keeping order per destination.
  */
 
 class Bus : public SST::Component {
@@ -53,6 +60,9 @@ public:
             {"broadcast",           "(bool) If set, messages are broadcast to all other ports", "0"},
             {"idle_max",            "(uint) Bus temporarily turns off clock after this number of idle cycles", "6"},
             {"drain_bus",           "(bool) Drain bus on every cycle", "0"},
+            {"split_transaction",   "(bool) Carry requests and responses on separate lanes", "0"},
+            {"bus_width",           "(uint) Messages each lane forwards per cycle. Ignored if drain_bus is set.", "1"},
+            {"port_credits",        "(uint) Messages a destination port can accept before it must drain; ports drain one message per cycle. 0 disables credit flow control. Not supported with broadcast.", "0"},
             {"debug",               "(uint) Output location for debug statements. Requires core configuration flag '--enable-debug'. --0[None], 1[STDOUT], 2[STDERR], 3[FILE]--", "0"},
             {"debug_level",         "(uint) Debugging level: 0 to 10", "0"},
             {"debug_addr",          "(comma separated uints) Address(es) to be debugged. Leave empty for all, otherwise specify one or more comma separated values. Start and end string with brackets", ""} )
@@ -63,6 +73,10 @@ public:
             {"lowlink%(lowlink_ports)d", "Ports connected to components on the lower/memory side of the bus (i.e., lower level caches, directories, memory, etc.)", {"memHierarchy.MemEventBase"} },
             {"highlink%(highlink_ports)d", "Ports connected to components on the upper/processor side of the bus (i.e., upper level caches, processors, etc.)", {"memHierarchy.MemEventBase"} } )
 
+    SST_ELI_DOCUMENT_STATISTICS(
+            {"credit_stalls",       "Number of cycles a message waited because its destination port had no credits", "count", 2},
+            {"width_stalls",        "Number of cycles a lane had more ready messages than 'bus_width'. Statistic subID is the lane: 'request' or 'response' ('request' carries everything if split_transaction is off).", "count", 2} )
+
 /* Class definition */
 
     Bus(SST::ComponentId_t id, SST::Params& params);
@@ -84,6 +98,12 @@ private:
     /** Broadcast event to all ports */
     void broadcastEvent(SST::Event *ev);
 
+    /** Forward up to bus_width events from a lane, skipping ones whose destination is out of credits */
+    void forwardLane(unsigned int lane);
+
+    /** Index of a port link into credits_ */
+    unsigned int portIndex(SST::Link*);
+
     /**  Clock Handler */
     bool clockTick(Cycle_t);
 
@@ -104,13 +124,20 @@ private:
     bool                        broadcast_;
     bool                        busOn_;
     bool                        drain_;
+    bool                        split_;
+    uint64_t                    busWidth_;
+    uint64_t                    portCredits_;
     Clock::HandlerBase*         clockHandler_;
     TimeConverter               defaultTimeBase_;
 
     std::vector<SST::Link*>     highNetPorts_;
     std::vector<SST::Link*>     lowNetPorts_;
     std::map<string,SST::Link*> nameMap_;
-    std::queue<SST::Event*>     eventQueue_;
+    std::vector<std::deque<SST::Event*>> lanes_;   // Request lane, then response lane if split
+    std::vector<uint64_t>       credits_;               // Per port: high ports, then low ports
+
+    Statistic<uint64_t>*        stat_creditStalls_;
+    std::vector<Statistic<uint64_t>*> stat_widthStalls_;
 
 };
 
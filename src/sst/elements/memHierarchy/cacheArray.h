@@ -50,8 +50,11 @@ class CacheArray {
         Addr            slice_step_; // For cache slices
         unsigned int    banks_;
         vector<T*>      lines_; // The actual cache
+        vector<Addr>    tags_;  // Packed copy of each line's address, indexed like lines_, so a set scan touches one contiguous block
+        bool            identity_hash_; // hash_ is hash.none; skip the virtual call on lookups
+        unsigned int    set_mask_;      // num_sets_ - 1 when num_sets_ is a power of two, 0 otherwise
         State* setStates;
-        std::map<unsigned int, std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID
+        std::vector<std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID
     public:
 
         CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash);
@@ -70,6 +73,9 @@ class CacheArray {
         /** Return bank num */
         Addr getBank(Addr addr) { return (toLineAddr(addr) % banks_); }
 
+        /** Return the set that line address 'laddr' maps to */
+        unsigned int getSet(Addr laddr);
+
     /**** Cache queries & maintenance */
 
         /** Function returns the cacheline if found, otherwise a null pointer.
@@ -136,6 +142,9 @@ CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int assoc
 
     line_offset_ = log2Of(line_size_);
     lines_.resize(num_lines_);
+    tags_.resize(num_lines_);
+    identity_hash_ = (dynamic_cast<NoHashFunction*>(hash_) != nullptr);
+    set_mask_ = ((num_sets_ & (num_sets_ - 1)) == 0) ? num_sets_ - 1 : 0;
 
     // Set later using setter functions
     slice_step_ = 1;
@@ -144,16 +153,16 @@ CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int assoc
 
     for (unsigned int i = 0; i < num_lines_; i++) {
         lines_[i] = new T(line_size_, i);
+        tags_[i] = lines_[i]->getAddr();
     }
 
     // Construct rInfo
+    rInfo.resize(num_sets_);
     for (unsigned int i = 0; i < num_sets_; i++) {
-        std::vector<ReplacementInfo*> setInfo;
         for (unsigned int j = 0; j < associativity; j++)
-            setInfo.push_back(lines_[i*associativity + j]->getReplacementInfo());
-        rInfo.insert(std::make_pair(i, setInfo));
+            rInfo[i].push_back(lines_[i*associativity + j]->getReplacementInfo());
     }
-    ReplacementInfo * info = rInfo.find(0)->second.front();
+    ReplacementInfo * info = rInfo[0].front();
     if (!replacement_mgr_->checkCompatibility(info))
         debug_->fatal(CALL_INFO, -1, "CacheArray, Error: The replacement policy expects cache line state that is not provided by the cache line type of this cache. Check the type of the ReplacementInfo returned by the coherence protocol's line type and the ReplacementInfo type expected by the replacement policy.\n");
 
@@ -175,15 +184,24 @@ Addr CacheArray<T>::toLineAddr(Addr addr) {
     return step * slice_size_ + offset;
 }
 
+template <class T>
+unsigned int CacheArray<T>::getSet(Addr laddr) {
+    uint64_t hashed = identity_hash_ ? laddr : hash_->hash(0, laddr);
+    if (set_mask_ != 0 || num_sets_ == 1)
+        return hashed & set_mask_;
+    return hashed % num_sets_;
+}
+
 template <class T>
 T* CacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
     Addr laddr = toLineAddr(addr);
-    int set = hash_->hash(0, laddr) % num_sets_;
-    int setBegin = set * associativity_;
-    int setEnd = setBegin + associativity_;
+    unsigned int setBegin = getSet(laddr) * associativity_;
 
-    for (int i = setBegin; i < setEnd; i++) {
-        if (lines_[i]->getAddr() == addr) {
+    // Tag compare over the packed tag array; tags_ mirrors lines_[i]->getAddr()
+    const Addr* tags = tags_.data() + setBegin;
+    for (unsigned int way = 0; way < associativity_; way++) {
+        if (tags[way] == addr) {
+            unsigned int i = setBegin + way;
             if (updateReplacement)
                 replacement_mgr_->update(i, lines_[i]->getReplacementInfo());
             return lines_[i];
@@ -195,7 +213,7 @@ T* CacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
 template <class T>
 T * CacheArray<T>::findReplacementCandidate(Addr addr) {
     Addr laddr = toLineAddr(addr);
-    int set = hash_->hash(0, laddr) % num_sets_;
+    unsigned int set = getSet(laddr);
 
     unsigned int id = replacement_mgr_->findBestCandidate(rInfo[set]);
 
@@ -208,6 +226,8 @@ void CacheArray<T>::replace(Addr addr, T* candidate) {
     replacement_mgr_->replaced(index);
     candidate->reset();
     candidate->setAddr(addr);
+    tags_[index] = addr;
+    replacement_mgr_->inserted(index, addr);
     replacement_mgr_->update(index, lines_[index]->getReplacementInfo());
 }
 
@@ -216,6 +236,7 @@ void CacheArray<T>::deallocate(T* candidate) {
     unsigned int index = candidate->getIndex();
     replacement_mgr_->replaced(index);
     candidate->reset();
+    tags_[index] = NO_ADDR;
 }
 
 template <class T>
@@ -253,6 +274,9 @@ void CacheArray<T>::serialize_order(SST::Core::Serialization::serializer& ser)
     SST_SER(slice_step_);
     SST_SER(banks_);
     SST_SER(lines_);
+    SST_SER(tags_);
+    SST_SER(identity_hash_);
+    SST_SER(set_mask_);
     SST_SER(setStates);
     SST_SER(rInfo);
 }
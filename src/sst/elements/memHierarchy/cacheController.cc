@@ -58,6 +58,23 @@ void Cache::handleEvent(SST::Event * ev) {
         fflush(stdout);
     }
 
+    if (CommandClassArr[(int)event->getCmd()] == CommandClass::Request) {
+        statSliceRequests->addData(1);
+
+        // NUCA: delay requests by their round trip over the mesh
+        if (nucaSelfLink_) {
+            auto src = nucaSourceTiles_.find(event->getSrc());
+            if (src != nucaSourceTiles_.end()) {
+                uint64_t hops = nucaHops(src->second);
+                statNUCAHops->addData(hops);
+                if (hops != 0) {
+                    nucaSelfLink_->send(2 * hops * nucaHopLatency_, event);
+                    return;
+                }
+            }
+        }
+    }
+
     eventBuffer_.push_back(event);
     //printf("DBG: %s, inserted <%" PRIu64 ", %d>, size=%zu\n", getName().c_str(), event->getID().first, event->getID().second, eventBuffer_.size());
 
@@ -73,6 +90,20 @@ void Cache::handlePrefetchEvent(SST::Event * ev) {
     prefetchSelfLink_->send(prefetchDelay_, ev);
 }
 
+/* Handle event from NUCA self link */
+void Cache::processNUCAEvent(SST::Event * ev) {
+    if (!clockIsOn_)
+        turnClockOn();
+    eventBuffer_.push_back(static_cast<MemEventBase*>(ev));
+}
+
+/* Manhattan distance between this cache's tile and another on the NUCA mesh */
+uint64_t Cache::nucaHops(uint64_t tile) const {
+    uint64_t x = tile % nucaMeshWidth_, y = tile / nucaMeshWidth_;
+    uint64_t myX = nucaTile_ % nucaMeshWidth_, myY = nucaTile_ / nucaMeshWidth_;
+    return (x > myX ? x - myX : myX - x) + (y > myY ? y - myY : myY - y);
+}
+
 /* Handle event from prefetch self link */
 void Cache::processPrefetchEvent(SST::Event * ev) {
     MemEvent * event = static_cast<MemEvent*>(ev);
@@ -99,17 +130,20 @@ void Cache::processPrefetchEvent(SST::Event * ev) {
 
 /* Clock handler */
 bool Cache::clockTick(Cycle_t time) {
+    HostTimeProfile profile(statHostClockNs, statHostClockCalls);
     timestamp_++;
 
     // Drain any outgoing messages
     bool idle = coherenceMgr_->sendOutgoingEvents();
 
+    bool linksIdle = true;
     if (clockUpLink_) {
-        idle &= linkUp_->clock();
+        linksIdle &= linkUp_->clock();
     }
     if (clockDownLink_) {
-        idle &= linkDown_->clock();
+        linksIdle &= linkDown_->clock();
     }
+    idle &= linksIdle;
 
     // MSHR occupancy
     statMSHROccupancy->addData(mshr_->getSize());
@@ -186,6 +220,12 @@ bool Cache::clockTick(Cycle_t time) {
             coherenceMgr_->removeRequestRecord(prefetchBuffer_.front()->getID());
 	    MemEventBase* ev = prefetchBuffer_.front();
 	    prefetchBuffer_.pop();
+            // Tell the prefetchers so they can account for the drop
+            MemEvent* pev = static_cast<MemEvent*>(ev);
+            CacheListenerNotification notify(pev->getAddr(), pev->getBaseAddr(), pev->getVirtualAddress(),
+                    pev->getInstructionPointer(), pev->getSize(), NotifyAccessType::PREFETCH, NotifyResultType::NA);
+            for (int i = 0; i < listeners_.size(); i++)
+                listeners_[i]->notifyAccess(notify);
 	    delete ev;
         }
     }
@@ -203,6 +243,21 @@ bool Cache::clockTick(Cycle_t time) {
         return true;
     }
 
+    // If we are only waiting to send events, skip ahead to the cycle the first one is due
+    // Any event that arrives in the meantime turns the clock back on as usual
+    if (clockSkip_ && eventBuffer_.empty() && retryBuffer_.empty() && linksIdle) {
+        uint64_t sendTime = coherenceMgr_->getNextSendTime();
+        if (sendTime > timestamp_ + 1) {
+            if (clockWakeCycle_ <= timestamp_ || clockWakeCycle_ > sendTime) {
+                // Wake one cycle early so that the next tick is the one at sendTime
+                clockWakeSelfLink_->send(sendTime - timestamp_ - 1, nullptr);
+                clockWakeCycle_ = sendTime;
+            }
+            turnClockOff();
+            return true;
+        }
+    }
+
     // Keep the clock on
     return false;
 }
@@ -218,6 +273,12 @@ void Cache::turnClockOn() {
     clockIsOn_ = true;
 }
 
+/* Handler for clockWakeSelfLink_ */
+void Cache::clockWakeup(SST::Event * ev) {
+    if (!clockIsOn_)
+        turnClockOn();
+}
+
 void Cache::turnClockOff() {
     //dbg_->debug(_L3_, "%s turning clock OFF at cycle %" PRIu64 ", timestamp %" PRIu64 ", ns %" PRIu64 "\n", this->getName().c_str(), getCurrentSimCycle(), timestamp_, getCurrentSimTimeNano());
     clockIsOn_ = false;
@@ -238,6 +299,9 @@ void Cache::turnClockOff() {
  *   Returns: whether event was accepted/can be popped off event queue
  */
 bool Cache::processEvent(MemEventBase* ev, bool retry) {
+    // Anything sent while handling a functional (warm-up) event is functional too
+    coherenceMgr_->setFunctional(ev->queryFlag(MemEventBase::F_FUNCTIONAL));
+
     // Global noncacheable request flag
     if (allNoncacheableRequests_) {
         ev->setFlag(MemEvent::F_NONCACHEABLE);
@@ -686,6 +750,8 @@ void Cache::serialize_order(SST::Core::Serialization::serializer& ser) {
     SST_SER(linkDown_);
     SST_SER(prefetchSelfLink_);
     SST_SER(timeoutSelfLink_);
+    SST_SER(clockWakeSelfLink_);
+    SST_SER(nucaSelfLink_);
     SST_SER(mshr_);
     SST_SER(coherenceMgr_);
     SST_SER(init_requests_);
@@ -697,6 +763,10 @@ void Cache::serialize_order(SST::Core::Serialization::serializer& ser) {
     SST_SER(timeout_);
     SST_SER(maxOutstandingPrefetch_);
     SST_SER(banked_);
+    SST_SER(nucaHopLatency_);
+    SST_SER(nucaMeshWidth_);
+    SST_SER(nucaTile_);
+    SST_SER(nucaSourceTiles_);
 
     SST_SER(clockHandler_);
     SST_SER(defaultTimeBase_);
@@ -704,6 +774,8 @@ void Cache::serialize_order(SST::Core::Serialization::serializer& ser) {
     SST_SER(clockUpLink_);
     SST_SER(clockDownLink_);
     SST_SER(lastActiveClockCycle_);
+    SST_SER(clockSkip_);
+    SST_SER(clockWakeCycle_);
 
     SST_SER(timestamp_);
     SST_SER(requestsThisCycle_);
@@ -77,8 +77,14 @@ public:
             {"drop_prefetch_mshr_level","(uint) Drop/NACK prefetches if the number of in-use mshrs is greater than or equal to this number. Default is mshr_num_entries - 2.", "mshr_num_entries-2"},
             {"num_cache_slices",        "(uint) For a distributed, shared cache, total number of cache slices", "1"},
             {"slice_id",                "(uint) For distributed, shared caches, unique ID for this cache slice", "0"},
-            {"slice_allocation_policy", "(string) Policy for allocating addresses among distributed shared cache. Options: rr[round-robin]", "rr"},
+            {"slice_allocation_policy", "(string) Policy for allocating addresses among distributed shared cache. Options: rr[round-robin], xor[hash of the line address, like complex addressing; num_cache_slices must be a power of 2 and the cache must use the highlink/lowlink subcomponent slots]", "rr"},
+            {"slice_hash_masks",        "(array of uint) For 'xor' slice allocation, one address mask per slice ID bit. Bit i of an address's slice is the parity of (address & mask i). Every slice must be given the same masks. Default folds the line address into log2(num_cache_slices) bits.", ""},
+            {"nuca_hop_latency_cycles", "(uint) NUCA latency per mesh hop between a requester and this cache. Requests pay the round trip (2 * hops * latency) on arrival. 0 disables NUCA latency.", "0"},
+            {"nuca_mesh_width",         "(uint) NUCA mesh width in tiles. Tile t is at (t % width, t / width).", "1"},
+            {"nuca_tile",               "(uint) NUCA tile of this cache", "slice_id"},
+            {"nuca_source_tiles",       "(array of string) NUCA tiles of the requesters as 'name:tile', named as the requester's events' source. Requests from other sources are not delayed.", ""},
             {"maxRequestDelay",         "(uint) Set an error timeout if memory requests take longer than this in ns (0: disable)", "0"},
+            {"clock_skip",              "(bool) If the only pending work is outgoing events waiting out their latency, turn the clock off and wake it on the cycle the first one can be sent instead of ticking in between. Options: 0[off], 1[on]", "false"},
             {"snoop_l1_invalidations",  "(bool) Forward invalidations from L1s to processors. Options: 0[off], 1[on]", "false"},
             {"llsc_block_cycles",       "(uint64_t) Number of cycles to prevent competing access to an LL/LR line. Encourages forward progress", "0"},
             {"debug",                   "(uint) Where to send output. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
@@ -119,8 +125,12 @@ public:
     SST_ELI_DOCUMENT_STATISTICS(
             /* Cache hits and misses */
             {"TotalEventsReceived",     "Total number of events received by this cache", "events", 1},
+            {"slice_requests",          "Requests received by this cache. For sliced caches, compare across slices for load balance.", "events", 1},
+            {"nuca_hops",               "Mesh hops between the requester and this cache, per request from a source in nuca_source_tiles", "hops", 2},
             {"TotalEventsReplayed",     "Total number of events that were initially blocked and then were replayed", "events", 1},
             {"MSHR_occupancy",          "Number of events in MSHR each cycle", "events", 1},
+            {"host_clock_ns",           "Host (wall clock) time spent in the clock handler", "nanoseconds", 5},
+            {"host_clock_calls",        "Calls to the clock handler, for host_clock_ns", "calls", 5},
             {"Bank_conflicts",          "Total number of bank conflicts detected", "count", 1},
             {"Prefetch_requests",       "Number of prefetches received from prefetcher at this cache", "events", 1},
             {"Prefetch_drops",          "Number of prefetches that were cancelled. Reasons: too many prefetches outstanding, cache can't handle prefetch this cycle, currently handling another event for the address.", "events", 1},
@@ -249,6 +259,9 @@ private:
 
     // Self-Event prefetch handler for this component
     void processPrefetchEvent(SST::Event *event);
+    void processNUCAEvent(SST::Event *event);
+    uint64_t nucaHops(uint64_t tile) const;
+    void configureNUCA(Params &params);
 
     // Clock handler
     bool clockTick(Cycle_t time);
@@ -257,6 +270,9 @@ private:
     void turnClockOn();
     void turnClockOff();
 
+    // Clock skipping - turn the clock back on when the next outgoing event is due
+    void clockWakeup(SST::Event * ev);
+
     // Trigger timeouts if events sit in MSHR for too long
     void timeoutWakeup(SST::Event * ev);
     void checkTimeout();
@@ -275,12 +291,20 @@ private:
     MemLinkBase* linkDown_ = nullptr;       // link manager down (towards memory)
     Link* prefetchSelfLink_ = nullptr;      // link to delay prefetch request receive
     Link* timeoutSelfLink_ = nullptr;       // link to check for timeouts (possible deadlock)
+    Link* clockWakeSelfLink_ = nullptr;     // link to wake the clock when clock skipping
+    Link* nucaSelfLink_ = nullptr;          // link to delay requests by their NUCA latency
     MSHR* mshr_;                            // MSHR
     CoherenceController* coherenceMgr_;     // Coherence protocol - where most of the event handling happens
     std::map<MemEventBase::id_type, std::string> init_requests_;    // Event response routing for untimed/init events
 
     /** Latencies **************************************************************/
     SimTime_t   prefetchDelay_;
+    SimTime_t   nucaHopLatency_ = 0;
+
+    /** NUCA placement *********************************************************/
+    uint64_t                        nucaMeshWidth_ = 1;
+    uint64_t                        nucaTile_ = 0;
+    std::map<std::string, uint64_t> nucaSourceTiles_;   // Requester name -> tile
 
     /** Cache configuration ****************************************************/
     uint64_t            lineSize_;
@@ -298,6 +322,8 @@ private:
     bool                    clockUpLink_;   // Whether link actually needs clock() called or not
     bool                    clockDownLink_; // Whether link actually needs clock() called or not
     SimTime_t               lastActiveClockCycle_;  // Cycle we turned the clock off at - for re-syncing stats
+    bool                    clockSkip_;     // Whether to turn the clock off while waiting on outgoing event latencies
+    uint64_t                clockWakeCycle_;    // Cycle of the pending clock wakeup, if any
 
     /** Cache state ************************************************************/
     uint64_t                    timestamp_;
@@ -325,7 +351,11 @@ private:
 
     // Event counts
     Statistic<uint64_t>* statRecvEvents;
+    Statistic<uint64_t>* statSliceRequests;
+    Statistic<uint64_t>* statNUCAHops;
     Statistic<uint64_t>* statRetryEvents;
+    Statistic<uint64_t>* statHostClockNs;
+    Statistic<uint64_t>* statHostClockCalls;
     Statistic<uint64_t>* statUncacheRecv[(int)Command::LAST_CMD];
     Statistic<uint64_t>* statCacheRecv[(int)Command::LAST_CMD];
 };
@@ -86,6 +86,7 @@ Cache::Cache(ComponentId_t id, Params &params) : Component(id) {
 
     /* Configure links */
     configureLinks(params, &defaultTimeBase_); // Must be called after createClock so timeebase is initialized
+    configureNUCA(params);
 
     createCoherenceManager(params);
 
@@ -277,9 +278,12 @@ void Cache::configureLinks(Params &params, TimeConverter* tc) {
             if (sliceID >= sliceCount)
                 out_->fatal(CALL_INFO,-1, "%s, Invalid param: slice_id - should be between 0 and num_cache_slices-1. You specified %" PRIu64 ".\n",
                         getName().c_str(), sliceID);
-            if (slicePolicy != "rr")
-                out_->fatal(CALL_INFO,-1, "%s, Invalid param: slice_allocation_policy - supported policy is 'rr' (round-robin). You specified '%s'.\n",
+            if (slicePolicy != "rr" && slicePolicy != "xor")
+                out_->fatal(CALL_INFO,-1, "%s, Invalid param: slice_allocation_policy - supported policies are 'rr' (round-robin) and 'xor' (address hash). You specified '%s'.\n",
                         getName().c_str(), slicePolicy.c_str());
+            if (slicePolicy == "xor" && (sliceCount & (sliceCount - 1)) != 0)
+                out_->fatal(CALL_INFO,-1, "%s, Invalid param: num_cache_slices - 'xor' slice allocation requires a power of 2. You specified %" PRIu64 ".\n",
+                        getName().c_str(), sliceCount);
         } else {
             out_->fatal(CALL_INFO, -1, "%s, Invalid param: num_cache_slices - should be 1 or greater. You specified %" PRIu64 ".\n",
                     getName().c_str(), sliceCount);
@@ -329,6 +333,31 @@ void Cache::configureLinks(Params &params, TimeConverter* tc) {
             }
         }
 
+        // XOR slices hash the line address and are applied on top of any range given
+        if (sliceCount > 1 && slicePolicy == "xor") {
+            uint32_t sliceBits = log2Of(sliceCount);
+            std::vector<Addr> masks;
+            params.find_array<Addr>("slice_hash_masks", masks);
+            if (masks.empty()) {
+                // Default folds the line address above the line offset into sliceBits bits
+                masks.resize(sliceBits, 0);
+                for (uint32_t i = 0; i < sliceBits; i++) {
+                    for (uint32_t bit = log2Of(lineSize_) + i; bit < 64; bit += sliceBits)
+                        masks[i] |= ((Addr)1 << bit);
+                }
+            } else if (masks.size() != sliceBits) {
+                out_->fatal(CALL_INFO, -1, "%s, Invalid param: slice_hash_masks - need one mask per slice ID bit (%" PRIu32 " for %" PRIu64 " slices). You specified %zu.\n",
+                        getName().c_str(), sliceBits, sliceCount, masks.size());
+            }
+            for (size_t i = 0; i < masks.size(); i++) {
+                if (masks[i] & (lineSize_ - 1))
+                    out_->fatal(CALL_INFO, -1, "%s, Invalid param: slice_hash_masks - masks may not include line offset bits or a line would be split across slices. Mask %zu is %" PRIx64 ".\n",
+                            getName().c_str(), i, masks[i]);
+            }
+            region_.sliceMasks = masks;
+            region_.sliceId = sliceID;
+        }
+
         // Little bit of error checking
         if (region_.end < region_.start) {
             out_->fatal(CALL_INFO, -1, "Invalid params(%s): addr_range_start and addr_range_end - addr_range_end is less than addr_range start. You specified start = %" PRIu64 " and end = %" PRIu64 ".\n",
@@ -793,6 +822,12 @@ void Cache::createClock(Params &params) {
     timestamp_ = 0;
     lastActiveClockCycle_ = 0;
 
+    // Clock skipping
+    clockSkip_ = params.find<bool>("clock_skip", false);
+    clockWakeCycle_ = 0;
+    if (clockSkip_)
+        clockWakeSelfLink_ = configureSelfLink("clockwake", frequency, new Event::Handler2<Cache, &Cache::clockWakeup>(this));
+
     // Deadlock timeout
     timeout_ = params.find<SimTime_t>("maxRequestDelay", 0);
     if (timeout_ > 0) {
@@ -826,6 +861,34 @@ void Cache::checkDeprecatedParams(Params &params) {
     }
 }
 
+/*
+ * NUCA latency: this cache sits on a tile of a 2D mesh. Requests from
+ * requesters with a known tile are delayed by the round trip over
+ * the mesh (2 * Manhattan distance * nuca_hop_latency_cycles).
+ */
+void Cache::configureNUCA(Params &params) {
+    nucaHopLatency_ = params.find<SimTime_t>("nuca_hop_latency_cycles", 0);
+    if (nucaHopLatency_ == 0)
+        return;
+
+    nucaMeshWidth_ = params.find<uint64_t>("nuca_mesh_width", 1);
+    nucaTile_ = params.find<uint64_t>("nuca_tile", params.find<uint64_t>("slice_id", 0));
+    if (nucaMeshWidth_ == 0)
+        out_->fatal(CALL_INFO, -1, "%s, Invalid param: nuca_mesh_width - must be at least 1.\n", getName().c_str());
+
+    std::vector<std::string> sources;
+    params.find_array<std::string>("nuca_source_tiles", sources);
+    for (auto& src : sources) {
+        size_t pos = src.find_last_of(':');
+        if (pos == std::string::npos || pos == 0 || pos == src.size() - 1)
+            out_->fatal(CALL_INFO, -1, "%s, Invalid param: nuca_source_tiles - entries must be 'name:tile'. You specified '%s'.\n", getName().c_str(), src.c_str());
+        nucaSourceTiles_[src.substr(0, pos)] = std::stoull(src.substr(pos + 1));
+    }
+
+    std::string frequency = params.find<std::string>("cache_frequency", "");
+    nucaSelfLink_ = configureSelfLink("nucalink", frequency, new Event::Handler2<Cache, &Cache::processNUCAEvent>(this));
+}
+
 void Cache::registerStatistics() {
     Statistic<uint64_t>* def_stat = registerStatistic<uint64_t>("default_stat");
     for (int i = 0; i < (int)Command::LAST_CMD; i++) {
@@ -834,7 +897,11 @@ void Cache::registerStatistics() {
     }
 
     statRecvEvents  = registerStatistic<uint64_t>("TotalEventsReceived");
+    statSliceRequests = registerStatistic<uint64_t>("slice_requests");
+    statNUCAHops = registerStatistic<uint64_t>("nuca_hops");
     statRetryEvents = registerStatistic<uint64_t>("TotalEventsReplayed");
+    statHostClockNs = registerStatistic<uint64_t>("host_clock_ns");
+    statHostClockCalls = registerStatistic<uint64_t>("host_clock_calls");
 
     statUncacheRecv[(int)Command::Put]      = registerStatistic<uint64_t>("Put_uncache_recv");
     statUncacheRecv[(int)Command::Get]      = registerStatistic<uint64_t>("Get_uncache_recv");
@@ -35,6 +35,8 @@ class Output;
 
 namespace MemHierarchy {
 
+    /* PREFETCH notifications are a prefetch the cache handled (HIT if it
+     * already held the line, MISS if it started a fetch) or dropped (NA) */
     enum NotifyAccessType{ READ, WRITE, EVICT, PREFETCH };
     enum NotifyResultType{ HIT, MISS, NA };
 
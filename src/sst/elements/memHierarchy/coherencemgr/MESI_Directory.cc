@@ -785,7 +785,7 @@ void MESIDirectory::handleFetchResp(MemEvent * ev, bool keepEvent) {
             dbg.fatal(CALL_INFO, -1, "%s, Error: Directory received %s but state is %s. Event: %s. Time = %" PRIu64 "ns, %" PRIu64 " cycles\n",
                     getName().c_str(), CommandString[(int)ev->getCmd()], StateString[state], ev->getVerboseString().c_str(), getCurrentSimTimeNano(), timestamp);
     }
-    respEv->setPayload(ev->getPayload());
+    respEv->sharePayload(ev);
     profileResponseSent(respEv);
     if (reqEv->getCmd() == Command::FetchInv || reqEv->getCmd() == Command::ForceInv)
         memMsgQueue.insert(std::make_pair(timestamp + mshrLatency, respEv));
@@ -825,7 +825,7 @@ void MESIDirectory::handleFetchXResp(MemEvent * ev, bool keepEvent) {
     MemEvent * respEv = reqEv->makeResponse();
     entry->addSharer(node_id(reqEv->getSrc()));
 
-    respEv->setPayload(ev->getPayload());
+    respEv->sharePayload(ev);
     profileResponseSent(respEv);
     sendEventToCaches(respEv, timestamp + mshrLatency);
 
@@ -1084,7 +1084,7 @@ void MESIDirectory::handleDataResponse(MemEvent * ev) {
     }
 
     respEv->setSize(cacheLineSize);
-    respEv->setPayload(ev->getPayload());
+    respEv->sharePayload(ev);
     respEv->setMemFlags(ev->getMemFlags());
     profileResponseSent(respEv);
     sendEventToCaches(respEv, timestamp + mshrLatency);
@@ -1418,8 +1418,7 @@ MemEvent::id_type MESIDirectory::writebackData(MemEvent *data_event, Command wbC
                 getName().c_str(), cacheLineSize, ev->getVerboseString().c_str(), getCurrentSimTimeNano());
     }
 
-    ev->setSize(data_event->getPayload().size());
-    ev->setPayload(data_event->getPayload());
+    ev->sharePayload(data_event);
     ev->setDst(memoryName);
     profileRequestSent(ev);
 
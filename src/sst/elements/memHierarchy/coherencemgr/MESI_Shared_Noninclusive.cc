@@ -59,6 +59,8 @@ MESISharNoninclusive::MESISharNoninclusive(ComponentId_t id, Params& params, Par
     ReplacementPolicy *drmgr = createReplacementPolicy(dir_lines, dir_assoc, params, false, 1);
     dir_array_ = new CacheArray<DirectoryLine>(debug_, dir_lines, dir_assoc, line_size_, drmgr, ht);
     dir_array_->setBanked(params.find<uint64_t>("banks", 0));
+    for (auto line : *dir_array_)
+        line->setSharerIds(&sharer_ids_);
 
     flush_state_ = FlushState::Ready;
     shutdown_flush_counter_ = 0;
@@ -390,7 +392,7 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool in_mshr) {
                 }
                 if (status == MemEventStatus::OK) {
                     recordLatencyType(event->getID(), LatType::INV);
-                    send_time = sendFetch(Command::Fetch, event, *(tag->getSharers()->begin()), in_mshr, tag->getTimestamp());
+                    send_time = sendFetch(Command::Fetch, event, tag->getFirstSharer(), in_mshr, tag->getTimestamp());
                     tag->setState(S_D);
                     tag->setTimestamp(send_time - 1);
                     if (mem_h_is_debug_event(event))
@@ -456,7 +458,7 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool in_mshr) {
                         mshr_->setProfiled(addr, event->getID());
                 }
                 if (status == MemEventStatus::OK) {
-                    send_time = sendFetch(Command::Fetch, event, *(tag->getSharers()->begin()), in_mshr, tag->getTimestamp());
+                    send_time = sendFetch(Command::Fetch, event, tag->getFirstSharer(), in_mshr, tag->getTimestamp());
                     state == E ? tag->setState(E_D) : tag->setState(M_D);
                     tag->setTimestamp(send_time - 1);
                     if (mem_h_is_debug_event(event))
@@ -857,7 +859,7 @@ bool MESISharNoninclusive::handleFlushLineInv(MemEvent* event, bool in_mshr) {
         case SM_D:
         case SB_D:
             if (event->getEvict()) {
-                if (*(tag->getSharers()->begin()) == event->getSrc()) {
+                if (tag->getFirstSharer() == event->getSrc()) {
                     removeSharerViaInv(event, tag, data, true);
                     mshr_->decrementAcksNeeded(addr);
                     tag->setState(NextState[tag->getState()]);
@@ -1192,7 +1194,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool in_mshr) {
         case E_D:
         case M_D:
         case SB_D:
-            if (event->getSrc() == *(tag->getSharers()->begin())) { // Sent fetch to this requestor
+            if (event->getSrc() == tag->getFirstSharer()) { // Sent fetch to this requestor
                 // Retry the pending fetch
                 mshr_->decrementAcksNeeded(addr);
                 mshr_->setData(addr, event->getPayload());
@@ -1619,7 +1621,7 @@ bool MESISharNoninclusive::handleFetch(MemEvent * event, bool in_mshr) {
                     mshr_->setProfiled(addr);
                     tag->setState(S_D);
                     if (!applyPendingReplacement(addr))
-                        send_time = sendFetch(Command::Fetch, event, *(tag->getSharers()->begin()), in_mshr, tag->getTimestamp());
+                        send_time = sendFetch(Command::Fetch, event, tag->getFirstSharer(), in_mshr, tag->getTimestamp());
                 }
             }
             break;
@@ -1645,7 +1647,7 @@ bool MESISharNoninclusive::handleFetch(MemEvent * event, bool in_mshr) {
                 if (status == MemEventStatus::OK) {
                     mshr_->setProfiled(addr);
                     tag->setState(SM_D);
-                    send_time = sendFetch(Command::Fetch, event, *(tag->getSharers()->begin()), in_mshr, tag->getTimestamp());
+                    send_time = sendFetch(Command::Fetch, event, tag->getFirstSharer(), in_mshr, tag->getTimestamp());
                 }
             }
             break;
@@ -1669,7 +1671,7 @@ bool MESISharNoninclusive::handleFetch(MemEvent * event, bool in_mshr) {
                 if (status == MemEventStatus::OK) {
                     mshr_->setProfiled(addr);
                     tag->setState(SB_D);
-                    send_time = sendFetch(Command::Fetch, event, *(tag->getSharers()->begin()), in_mshr, tag->getTimestamp());
+                    send_time = sendFetch(Command::Fetch, event, tag->getFirstSharer(), in_mshr, tag->getTimestamp());
                 }
             }
             break;
@@ -2300,7 +2302,7 @@ bool MESISharNoninclusive::handleFetchInvX(MemEvent * event, bool in_mshr) {
                 mshr_->setProfiled(addr);
             } else if (!data && !mshr_->hasData(addr)) {
                 if (!applyPendingReplacement(addr)) {
-                    send_time = sendFetch(Command::Fetch, event, *(tag->getSharers()->begin()), in_mshr, tag->getTimestamp());
+                    send_time = sendFetch(Command::Fetch, event, tag->getFirstSharer(), in_mshr, tag->getTimestamp());
                     tag->setTimestamp(send_time-1);
                 }
                 state == E ? tag->setState(E_D) : tag->setState(M_D);
@@ -3593,7 +3595,9 @@ bool MESISharNoninclusive::invalidateExceptRequestor(MemEvent * event, Directory
     if (getData && tag->isSharer(event->getSrc()))
         getData = false;
 
-    for (set<std::string>::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
+    std::vector<std::string> sharers;
+    tag->getSharers(sharers);
+    for (std::vector<std::string>::iterator it = sharers.begin(); it != sharers.end(); it++) {
         if (*it == rqstr) continue;
 
         if (getData) { // FetchInv
@@ -3616,7 +3620,9 @@ bool MESISharNoninclusive::invalidateAll(MemEvent * event, DirectoryLine * tag,
         return true;
     } else {
         bool data_requested = !needData;
-        for (std::set<std::string>::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
+        std::vector<std::string> sharers;
+        tag->getSharers(sharers);
+        for (std::vector<std::string>::iterator it = sharers.begin(); it != sharers.end(); it++) {
             if (!data_requested) {
                 delivery_time = invalidateSharer(*it, event, tag, in_mshr, Command::FetchInv);
                 data_requested = true;
@@ -3634,7 +3640,9 @@ bool MESISharNoninclusive::invalidateAll(MemEvent * event, DirectoryLine * tag,
 
 void MESISharNoninclusive::invalidateSharers(MemEvent * event, DirectoryLine * tag, bool in_mshr, bool needData, Command cmd) {
     uint64_t delivery_time = 0;
-    for (std::set<std::string>::iterator it = tag->getSharers()->begin(); it != tag->getSharers()->end(); it++) {
+    std::vector<std::string> sharers;
+    tag->getSharers(sharers);
+    for (std::vector<std::string>::iterator it = sharers.begin(); it != sharers.end(); it++) {
         if (needData) {
             delivery_time = invalidateSharer(*it, event, tag, in_mshr, Command::FetchInv);
             needData = false;
@@ -3990,6 +3998,11 @@ void MESISharNoninclusive::serialize_order(SST::Core::Serialization::serializer&
 
     SST_SER(data_array_);
     SST_SER(dir_array_);
+    SST_SER(sharer_ids_);
+    if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
+        for (auto line : *dir_array_)
+            line->setSharerIds(&sharer_ids_);
+    }
     SST_SER(protocol_);
     SST_SER(protocol_state_);
     SST_SER(responses_);
@@ -377,6 +377,7 @@ private:
 /* Private data members */
     CacheArray<DataLine>* data_array_;
     CacheArray<DirectoryLine>* dir_array_;
+    SharerIdMap sharer_ids_;    // Dense IDs for the sharer/owner names recorded in dir_array_
 
     bool protocol_;  // True for MESI, false for MSI
     State protocol_state_;
@@ -70,6 +70,7 @@ CoherenceController::CoherenceController(ComponentId_t id, Params &params, Param
 
     /* Initialize variables */
     timestamp_ = 0;
+    functional_ = false;
     outstanding_prefetch_count_ = 0;
 
     /* Default values for cache parameters */
@@ -152,8 +153,12 @@ ReplacementPolicy* CoherenceController::createReplacementPolicy(uint64_t lines,
     }
     if (policy == "random") return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.random", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
     if (policy == "nmru")   return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.nmru", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "srrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.srrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "brrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.brrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "drrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.drrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "ship")   return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.ship", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
 
-    debug_->fatal(CALL_INFO, -1, "%s, Invalid param: replacement_policy - supported policies are 'lru', 'lfu', 'random', 'mru', and 'nmru'. You specified '%s'.\n", getName().c_str(), policy.c_str());
+    debug_->fatal(CALL_INFO, -1, "%s, Invalid param: replacement_policy - supported policies are 'lru', 'lfu', 'random', 'mru', 'nmru', 'srrip', 'brrip', 'drrip', and 'ship'. You specified '%s'.\n", getName().c_str(), policy.c_str());
     return nullptr;
 }
 
@@ -428,6 +433,15 @@ bool CoherenceController::checkIdle() {
     return outgoing_event_queue_down_.empty() && outgoing_event_queue_up_.empty();
 }
 
+/* Queues are drained in order so only the front of each can be sent next */
+uint64_t CoherenceController::getNextSendTime() {
+    if (outgoing_event_queue_down_.empty())
+        return outgoing_event_queue_up_.front().delivery_time;
+    if (outgoing_event_queue_up_.empty())
+        return outgoing_event_queue_down_.front().delivery_time;
+    return std::min(outgoing_event_queue_down_.front().delivery_time, outgoing_event_queue_up_.front().delivery_time);
+}
+
 
 /* Forward an event using memory address to locate a destination. */
 void CoherenceController::forwardByAddress(MemEventBase * event) {
@@ -435,6 +449,10 @@ void CoherenceController::forwardByAddress(MemEventBase * event) {
 }
 
 void CoherenceController::forwardByAddress(MemEventBase * event, Cycle_t ts) {
+    if (functional_) {
+        event->setFlag(MemEventBase::F_FUNCTIONAL);
+        ts = timestamp_ + 1;
+    }
     event->setSrc(cachename_);
     std::string dst = link_down_->findTargetDestination(event->getRoutingAddress());
     if (dst != "") { /* Common case */
@@ -464,6 +482,10 @@ void CoherenceController::forwardByDestination(MemEventBase * event) {
 
 /* Forward an event to a specific destination */
 void CoherenceController::forwardByDestination(MemEventBase * event, Cycle_t ts) {
+    if (functional_) {
+        event->setFlag(MemEventBase::F_FUNCTIONAL);
+        ts = timestamp_ + 1;
+    }
     event->setSrc(cachename_);
     Response forward_request = {event, ts, packet_header_bytes_ + event->getPayloadSize()};
 
@@ -937,6 +959,7 @@ void CoherenceController::serialize_order(SST::Core::Serialization::serializer&
     SST_SER(debug_addr_filter_);
     SST_SER(debug_level_);
     SST_SER(timestamp_);
+    SST_SER(functional_);
     SST_SER(access_latency_);
     SST_SER(tag_latency_);
     SST_SER(mshr_latency_);
@@ -114,9 +114,16 @@ public:
     /* For clock handling = parent updates timestamp when the clock is re-enabled */
     void updateTimestamp(uint64_t new_timestamp) { timestamp_ = new_timestamp; }
 
+    /* Parent sets this from each event it processes. While set, every event sent is
+     * flagged functional and scheduled for the next cycle instead of after the modeled latency */
+    void setFunctional(bool functional) { functional_ = functional; }
+
     /* Check whether the event queues are empty/subcomponent is doing anything */
     bool checkIdle();
 
+    /* Earliest cycle at which a queued outgoing event can be sent. Only valid if !checkIdle() */
+    uint64_t getNextSendTime();
+
     /* Get which bank an address maps to (call through to cache array) */
     virtual Addr getBank(Addr addr) = 0;
 
@@ -318,6 +325,7 @@ protected:
 
     /* Latencies amd timing */
     uint64_t timestamp_;        // Local timestamp (cycles)
+    bool functional_;           // Handling a functional (warm-up) event
     uint64_t access_latency_;   // Data/tag access latency
     uint64_t tag_latency_;      // Tag only access latency
     uint64_t mshr_latency_;     // MSHR lookup latency
@@ -36,6 +36,9 @@ using namespace SST::MemHierarchy;
  *      For a directory, a replacement is not synonymous with eviction
  */
 CoherentMemController::CoherentMemController(ComponentId_t id, Params &params) : MemController(id, params) {
+    if (channels_.size() > 1) {
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: num_channels - CoherentMemController supports a single channel. Use MemController for a multi-channel memory.\n", getName().c_str());
+    }
     directory_ = false; /* Updated during init */
     timestamp_ = 0;
 }
@@ -297,7 +300,7 @@ void CoherentMemController::handleFlush(MemEvent * ev) {
                     MemEvent * resp = new MemEvent(ev->getSrc(), ev->getBaseAddr(), ev->getBaseAddr(), Command::AckInv);
                     if (ev->getPayloadSize() != 0) {
                         resp->setDirty(ev->getDirty());
-                        resp->setPayload(ev->getPayload());
+                        resp->sharePayload(ev);
                         ev->setPayload(0, nullptr);
                         ev->setDirty(false);
                         handleFetchResp(resp);
@@ -0,0 +1,123 @@
+// Copyright 2013-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _MEMHIERARCHY_PIMCUSTOMCMD_H_
+#define _MEMHIERARCHY_PIMCUSTOMCMD_H_
+
+#include <sstream>
+#include <string>
+
+#include <sst/core/interfaces/stdMem.h>
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Processing-in-memory command, executed next to the banks by
+ * pimCustomCmdHandler (function) and pimMemory (timing). Only the
+ * result travels back to the requestor, operands stay in memory.
+ *
+ *  ReduceSum/Min/Max: combine 'count' elements at 'addr' (every 'stride'
+ *      bytes) into 'result'
+ *  Gather:  copy 'count' elements at 'addr' (every 'stride' bytes) to 'dst', packed
+ *  Scatter: copy 'count' packed elements at 'addr' to 'dst' (every 'stride' bytes)
+ *  Memcpy:  copy 'count' elements at 'addr' to 'dst'
+ *  Memset:  write 'value' to 'count' elements at 'addr'
+ *
+ * Elements are 'elemSize' (1, 2, 4 or 8) byte unsigned integers, or
+ * doubles/floats for reductions if 'fp' is set. A stride of 0 means packed.
+ */
+class PIMCustomData : public Interfaces::StandardMem::CustomData {
+public:
+    typedef uint64_t Addr;
+
+    enum class Op : uint32_t { ReduceSum = 0, ReduceMin, ReduceMax, Gather, Scatter, Memcpy, Memset };
+
+    PIMCustomData(Op op, Addr addr, uint64_t count, uint32_t elemSize = 8, Addr dst = 0, uint64_t stride = 0, uint64_t value = 0, bool fp = false) :
+        CustomData(), op_(op), addr_(addr), dst_(dst), count_(count), elemSize_(elemSize), stride_(stride), value_(value), fp_(fp), result_(0) { }
+
+    virtual ~PIMCustomData() { }
+
+    virtual Addr getRoutingAddress() override { return addr_; }
+
+    /* Command and result are about the size of a coherence message */
+    virtual uint64_t getSize() override { return 8; }
+
+    virtual CustomData* makeResponse() override { return new PIMCustomData(*this); }
+
+    virtual bool needsResponse() override { return true; }
+
+    virtual std::string getString() override {
+        std::ostringstream str;
+        str << "PIM Op: " << (uint32_t) op_;
+        str << std::hex << " Addr: 0x" << addr_ << " Dst: 0x" << dst_;
+        str << std::dec << " Count: " << count_ << " ElemSize: " << elemSize_ << " Stride: " << stride_;
+        return str.str();
+    }
+
+    Op getOp() { return op_; }
+    Addr getAddr() { return addr_; }
+    Addr getDst() { return dst_; }
+    uint64_t getCount() { return count_; }
+    uint32_t getElemSize() { return elemSize_; }
+    uint64_t getValue() { return value_; }
+    bool isFP() { return fp_; }
+
+    /* Bytes between consecutive strided elements */
+    uint64_t getStride() { return stride_ ? stride_ : elemSize_; }
+
+    /* Bytes between consecutive source and destination elements */
+    uint64_t getSrcStep() { return (op_ == Op::Scatter || op_ == Op::Memcpy) ? elemSize_ : getStride(); }
+    uint64_t getDstStep() { return op_ == Op::Scatter ? getStride() : elemSize_; }
+
+    bool readsSource() { return op_ != Op::Memset; }
+    bool writesDestination() { return op_ == Op::Gather || op_ == Op::Scatter || op_ == Op::Memcpy || op_ == Op::Memset; }
+    bool isReduction() { return op_ == Op::ReduceSum || op_ == Op::ReduceMin || op_ == Op::ReduceMax; }
+
+    /* Reductions return their result here, as the bits of a double if fp */
+    void setResult(uint64_t result) { result_ = result; }
+    uint64_t getResult() { return result_; }
+
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        SST_SER(op_);
+        SST_SER(addr_);
+        SST_SER(dst_);
+        SST_SER(count_);
+        SST_SER(elemSize_);
+        SST_SER(stride_);
+        SST_SER(value_);
+        SST_SER(fp_);
+        SST_SER(result_);
+    }
+    ImplementSerializable(SST::MemHierarchy::PIMCustomData);
+
+protected:
+    PIMCustomData() { } /* For serialization only */
+
+    Op op_;
+    Addr addr_;
+    Addr dst_;
+    uint64_t count_;
+    uint32_t elemSize_;
+    uint64_t stride_;
+    uint64_t value_;
+    bool fp_;
+    uint64_t result_;
+};
+
+} // namespace MemHierarchy
+} // namespace SST
+
+#endif
@@ -0,0 +1,154 @@
+// Copyright 2013-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "customcmd/pimCustomCmdHandler.h"
+#include "memEventCustom.h"
+
+using namespace std;
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+PIMCustomCmdMemHandler::PIMCustomCmdMemHandler(ComponentId_t id, Params &params, std::function<void(Addr,size_t,std::vector<uint8_t>&)> read, std::function<void(Addr,std::vector<uint8_t>*)> write)
+    : CustomCmdMemHandler(id, params, read, write) {
+    lineSize_ = params.find<uint64_t>("line_size", 64);
+    if (lineSize_ == 0)
+        dbg.fatal(CALL_INFO, -1, "%s, Error: line_size must be greater than 0\n", getName().c_str());
+}
+
+CustomCmdMemHandler::MemEventInfo PIMCustomCmdMemHandler::receive(MemEventBase* ev){
+    PIMCustomData * data = dynamic_cast<PIMCustomData*>(static_cast<CustomMemEvent*>(ev)->getCustomData());
+    if (!data)
+        dbg.fatal(CALL_INFO, -1, "%s, Error: received a custom command that is not a PIM command. Ev = %s\n", getName().c_str(), ev->getVerboseString().c_str());
+
+    uint32_t size = data->getElemSize();
+    if ((size != 1 && size != 2 && size != 4 && size != 8) || (data->isFP() && size != 4 && size != 8))
+        dbg.fatal(CALL_INFO, -1, "%s, Error: PIM command with unsupported element size %" PRIu32 ". Ev = %s\n", getName().c_str(), size, ev->getVerboseString().c_str());
+
+    // Caches must give up every line the command reads or writes,
+    // 'addr' is the source, or the destination of a memset
+    std::set<Addr> lines;
+    for (uint64_t i = 0; i < data->getCount(); i++) {
+        lines.insert((data->getAddr() + i * data->getSrcStep()) & ~(lineSize_ - 1));
+        if (data->writesDestination() && data->getOp() != PIMCustomData::Op::Memset)
+            lines.insert((data->getDst() + i * data->getDstStep()) & ~(lineSize_ - 1));
+    }
+    if (lines.empty())
+        lines.insert(data->getAddr() & ~(lineSize_ - 1));
+
+    CustomCmdMemHandler::MemEventInfo MEI(lines, true);
+    return MEI;
+}
+
+Interfaces::StandardMem::CustomData* PIMCustomCmdMemHandler::ready(MemEventBase* ev){
+    // The backend times the command from the unmodified data structure
+    return static_cast<CustomMemEvent*>(ev)->getCustomData();
+}
+
+MemEventBase* PIMCustomCmdMemHandler::finish(MemEventBase *ev, uint32_t flags){
+    CustomMemEvent * cme = static_cast<CustomMemEvent*>(ev);
+    PIMCustomData * data = static_cast<PIMCustomData*>(cme->getCustomData());
+    execute(data);
+
+    if(ev->queryFlag(MemEventBase::F_NORESPONSE)||
+         ((flags & MemEventBase::F_NORESPONSE)>0)){
+        // posted request
+        delete data;
+        cme->setCustomData(nullptr);
+        return nullptr;
+    }
+
+    // The response carries the same data structure, and so the result
+    return ev->makeResponse();
+}
+
+uint64_t PIMCustomCmdMemHandler::loadElement(std::vector<uint8_t>& buf, uint64_t offset, uint32_t size) {
+    uint64_t value = 0;
+    for (uint32_t i = 0; i < size; i++)
+        value |= ((uint64_t) buf[offset + i]) << (8 * i);
+    return value;
+}
+
+void PIMCustomCmdMemHandler::execute(PIMCustomData* data) {
+    uint32_t size = data->getElemSize();
+    uint64_t count = data->getCount();
+    std::vector<uint8_t> buf;
+
+    switch (data->getOp()) {
+        case PIMCustomData::Op::Memset:
+            buf.resize(size * count);
+            for (uint64_t i = 0; i < count; i++) {
+                for (uint32_t b = 0; b < size; b++)
+                    buf[i * size + b] = (data->getValue() >> (8 * b)) & 0xFF;
+            }
+            writeData(data->getAddr(), &buf);
+            return;
+        case PIMCustomData::Op::Memcpy:
+            readData(data->getAddr(), size * count, buf);
+            writeData(data->getDst(), &buf);
+            return;
+        case PIMCustomData::Op::Gather:
+        case PIMCustomData::Op::Scatter:
+            for (uint64_t i = 0; i < count; i++) {
+                readData(data->getAddr() + i * data->getSrcStep(), size, buf);
+                writeData(data->getDst() + i * data->getDstStep(), &buf);
+            }
+            return;
+        default:
+            break;
+    }
+
+    // Reductions
+    uint64_t iresult = data->getOp() == PIMCustomData::Op::ReduceMin ? std::numeric_limits<uint64_t>::max() : 0;
+    double fresult = data->getOp() == PIMCustomData::Op::ReduceMin ? std::numeric_limits<double>::max() :
+        (data->getOp() == PIMCustomData::Op::ReduceMax ? std::numeric_limits<double>::lowest() : 0.0);
+    for (uint64_t i = 0; i < count; i++) {
+        readData(data->getAddr() + i * data->getSrcStep(), size, buf);
+        uint64_t bits = loadElement(buf, 0, size);
+        if (data->isFP()) {
+            double value;
+            if (size == sizeof(float)) {
+                uint32_t bits32 = (uint32_t) bits;
+                float f;
+                memcpy(&f, &bits32, sizeof(float));
+                value = f;
+            } else {
+                memcpy(&value, &bits, sizeof(double));
+            }
+            if (data->getOp() == PIMCustomData::Op::ReduceSum) fresult += value;
+            else if (data->getOp() == PIMCustomData::Op::ReduceMin) fresult = std::min(fresult, value);
+            else fresult = std::max(fresult, value);
+        } else {
+            if (data->getOp() == PIMCustomData::Op::ReduceSum) iresult += bits;
+            else if (data->getOp() == PIMCustomData::Op::ReduceMin) iresult = std::min(iresult, bits);
+            else iresult = std::max(iresult, bits);
+        }
+    }
+
+    if (data->isFP()) {
+        uint64_t bits;
+        memcpy(&bits, &fresult, sizeof(double));
+        data->setResult(count ? bits : 0);
+    } else {
+        data->setResult(count ? iresult : 0);
+    }
+}
+
+// EOF
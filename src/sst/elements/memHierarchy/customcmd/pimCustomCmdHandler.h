@@ -0,0 +1,73 @@
+// Copyright 2013-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _MEMHIERARCHY_PIMCUSTOMCMDHANDLER_H_
+#define _MEMHIERARCHY_PIMCUSTOMCMDHANDLER_H_
+
+#include <string>
+
+#include <sst/core/event.h>
+#include <sst/core/output.h>
+#include <sst/core/subcomponent.h>
+#include <sst/core/interfaces/stdMem.h>
+
+#include "sst/elements/memHierarchy/memEventBase.h"
+#include "sst/elements/memHierarchy/customcmd/customCmdMemory.h"
+#include "sst/elements/memHierarchy/customcmd/pimCustomCmd.h"
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Functional half of processing-in-memory commands (PIMCustomData): reads the
+ * operands from the backing store, writes back copies and fills in the result
+ * of reductions when the backend (e.g., memHierarchy.pimMemory) completes the
+ * command. Addresses are used as they are, so they must be controller-local,
+ * i.e., the controller's region starts at 0 and is not interleaved.
+ */
+class PIMCustomCmdMemHandler : public CustomCmdMemHandler {
+public:
+/* Element Library Info */
+    SST_ELI_REGISTER_SUBCOMPONENT(PIMCustomCmdMemHandler, "memHierarchy", "pimCustomCmdHandler", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Custom command handler that executes processing-in-memory reductions, gather/scatter and memcpy/memset on the backing store", SST::MemHierarchy::CustomCmdMemHandler)
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"line_size", "Cache line size, used to find the lines a command touches for coherence", "64"},
+            {"debug", "Where to print debug output. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
+            {"debug_level", "Debug verbosity level. Between 0 and 10", "0"} )
+
+/* Begin class defintion */
+
+  PIMCustomCmdMemHandler(ComponentId_t id, Params &params, std::function<void(Addr,size_t,std::vector<uint8_t>&)> read, std::function<void(Addr,std::vector<uint8_t>*)> write);
+
+  ~PIMCustomCmdMemHandler() {}
+
+  CustomCmdMemHandler::MemEventInfo receive(MemEventBase* ev) override;
+
+  Interfaces::StandardMem::CustomData* ready(MemEventBase* ev) override;
+
+  MemEventBase* finish(MemEventBase *ev, uint32_t flags) override;
+
+protected:
+private:
+  void execute(PIMCustomData* data);
+  uint64_t loadElement(std::vector<uint8_t>& buf, uint64_t offset, uint32_t size);
+
+  uint64_t lineSize_;
+};    // class PIMCustomCmdMemHandler
+}     // namespace MemHierarchy
+}     // namespace SST
+
+#endif
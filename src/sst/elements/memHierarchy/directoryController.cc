@@ -262,6 +262,7 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
 
     // Timestamp - aka cycle count
     timestamp = 0;
+    functional = false;
 
     // Coherence protocol configuration
     waitWBAck = false; // Don't expect WB Acks
@@ -318,6 +319,7 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     stat_eventSent[(int)Command::Inv]           = registerStatistic<uint64_t>("eventSent_Inv");
     stat_eventSent[(int)Command::FetchInv]      = registerStatistic<uint64_t>("eventSent_FetchInv");
     stat_eventSent[(int)Command::FetchInvX]     = registerStatistic<uint64_t>("eventSent_FetchInvX");
+    stat_eventSent[(int)Command::Fetch]         = registerStatistic<uint64_t>("eventSent_Fetch");
     stat_eventSent[(int)Command::ForceInv]      = registerStatistic<uint64_t>("eventSent_ForceInv");
     stat_eventSent[(int)Command::ForwardFlush]  = registerStatistic<uint64_t>("eventSent_ForwardFlush");
     stat_eventSent[(int)Command::NACK]          = registerStatistic<uint64_t>("eventSent_NACK");
@@ -335,6 +337,10 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     // Memory writes from directory
     stat_dirEntryReads              = registerStatistic<uint64_t>("eventSent_read_directory_entry");
     stat_dirEntryWrites             = registerStatistic<uint64_t>("eventSent_write_directory_entry");
+    stat_dirEvictions               = registerStatistic<uint64_t>("directory_evictions");
+    stat_dirBackInvalidations       = registerStatistic<uint64_t>("directory_back_invalidations");
+    stat_cleanForwards              = registerStatistic<uint64_t>("clean_forwards");
+    stat_cleanForwardFallbacks      = registerStatistic<uint64_t>("clean_forward_fallbacks");
     stat_MSHROccupancy              = registerStatistic<uint64_t>("MSHR_occupancy");
 
     // Coherence part
@@ -347,11 +353,25 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     entryCacheSize = 0;
     entrySize = 4; // Bytes, TODO parameterize
 
+    /* A sparse directory keeps every entry on chip, so it replaces the entry cache */
+    uint64_t sparseEntries = params.find<uint64_t>("sparse_entries", 0);
+    sparseWays = params.find<uint64_t>("sparse_associativity", 16);
+    if (sparseEntries != 0) {
+        if (sparseWays == 0 || sparseWays > sparseEntries || sparseEntries % sparseWays != 0)
+            dbg.fatal(CALL_INFO, -1, "Invalid param(%s): sparse_associativity - must be at least 1 and divide sparse_entries (%" PRIu64 "). You specified: %" PRIu64 "\n",
+                    getName().c_str(), sparseEntries, sparseWays);
+        sparseSets.resize(sparseEntries / sparseWays);
+        sparseEvicting.resize(sparseSets.size(), false);
+        entryCacheMaxSize = 0;
+    }
+
     string protstr  = params.find<std::string>("coherence_protocol", "MESI");
     if (protstr == "mesi" || protstr == "MESI") protocol = CoherenceProtocol::MESI;
     else if (protstr == "msi" || protstr == "MSI") protocol = CoherenceProtocol::MSI;
     else dbg.fatal(CALL_INFO, -1, "Invalid param(%s): coherence_protocol - must be 'MESI' or 'MSI'. You specified: %s\n", getName().c_str(), protstr.c_str());
 
+    forwardClean = params.find<bool>("forward_clean_data", false);
+
     int mshrSize    = params.find<int>("mshr_num_entries",-1);
     if (mshrSize == 0) dbg.fatal(CALL_INFO, -1, "Invalid param(%s): mshr_num_entries - must be at least 1 or else negative to indicate an unlimited size MSHR\n", getName().c_str());
     mshr                = loadComponentExtension<MSHR>(&dbg, mshrSize, getName(), debug_addr_filter_);
@@ -389,6 +409,7 @@ void DirectoryController::handlePacket(SST::Event *event){
                     getCurrentSimCycle(), timestamp, getName().c_str(), evb->getVerboseString(dlevel).c_str());
         }
 
+        functional = evb->queryFlag(MemEventBase::F_FUNCTIONAL);
         if (BasicCommandClassArr[(int)evb->getCmd()] == BasicCommandClass::Request)
             handleNoncacheableRequest(evb);
         else
@@ -486,6 +507,9 @@ bool DirectoryController::processPacket(MemEvent * ev, bool replay) {
 
     Addr addr = ev->getBaseAddr();
 
+    // Anything sent while handling a functional (warm-up) event is functional too
+    functional = ev->queryFlag(MemEventBase::F_FUNCTIONAL);
+
     /* Disallow more than one access to a given line per cycle */
     if (!arbitrateAccess(addr)) {
         if (mem_h_is_debug_addr(addr)) {
@@ -498,6 +522,18 @@ bool DirectoryController::processPacket(MemEvent * ev, bool replay) {
         return false;
     }
 
+    /* A full sparse set has to evict before a new line can be tracked */
+    if (!sparseSets.empty() && !reserveSparseEntry(ev)) {
+        if (mem_h_is_debug_addr(addr)) {
+            std::stringstream id;
+            id << "<" << ev->getID().first << "," << ev->getID().second << ">";
+            dbg.debug(_L5_, "A: %-20" PRIu64 " %-20" PRIu64 " %-20s %-13s 0x%-16" PRIx64 " %-15s %-6s %-6s %-10s %-15s\n",
+                    getCurrentSimCycle(), timestamp, getName().c_str(), CommandString[(int)ev->getCmd()],
+                    addr, id.str().c_str(), "", "", "Stall", "(directory set full)");
+        }
+        return false;
+    }
+
     bool retval = false;
     Command cmd = ev->getCmd();
 
@@ -630,6 +666,8 @@ void DirectoryController::handleNoncacheableResponse(MemEventBase * ev) {
 void DirectoryController::printStatus(Output &statusOut) {
     statusOut.output("MemHierarchy::DirectoryController %s\n", getName().c_str());
     statusOut.output("  Cached entries: %" PRIu64 "\n", entryCacheSize);
+    if (!sparseSets.empty())
+        statusOut.output("  Sparse directory: %zu entries in %zu sets of %" PRIu64 "\n", directory.size(), sparseSets.size(), sparseWays);
     statusOut.output("  Requests waiting to be handled:  %zu\n", eventBuffer.size());
 //    for(std::list<std::pair<MemEvent*,bool> >::iterator i = workQueue.begin() ; i != workQueue.end() ; ++i){
 //        statusOut.output("    %s, %s\n", i->first->getVerboseString(dlevel).c_str(), i->second ? "replay" : "new");
@@ -930,7 +968,11 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
             }
             status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, false);
             if (status == MemEventStatus::OK) {
-                issueMemoryRequest(event, entry, true);
+                if (forwardClean && entry->hasForwarder() && entry->getForwarder() != event->getSrc()
+                        && incoherentSrc.find(event->getSrc()) == incoherentSrc.end())
+                    issueCleanForward(event, entry);
+                else
+                    issueMemoryRequest(event, entry, true);
                 entry->setState(S_D);
             }
             if (mem_h_is_debug_event(event))
@@ -1350,6 +1392,8 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             if (event->getEvict()) {
                 entry->removeSharer(event->getSrc());
                 event->setEvict(false);
+                if (isCleanForwardPending(addr, event->getSrc()))
+                    cleanForwardFallback(addr);
                 if (!entry->hasSharers())
                     entry->setState(IS);
             }
@@ -1380,6 +1424,8 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             if (event->getEvict()) {
                 entry->removeSharer(event->getSrc());
                 event->setEvict(false);
+                if (isCleanForwardPending(addr, event->getSrc()))
+                    cleanForwardFallback(addr);
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
                 if (mshr->decrementAcksNeeded(addr)) {
@@ -1525,6 +1571,9 @@ bool DirectoryController::handlePutS(MemEvent * event, bool inMSHR) {
     entry->removeSharer(event->getSrc());
     sendAckPut(event);
 
+    if (isCleanForwardPending(addr, event->getSrc())) // Forwarder evicted before it saw our Fetch
+        cleanForwardFallback(addr);
+
     if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrc()) != responses.find(addr)->second.end()) {
         responses.find(addr)->second.erase(event->getSrc());
         if (responses.find(addr)->second.empty()) responses.erase(addr);
@@ -1779,6 +1828,11 @@ bool DirectoryController::handleFetchInv(MemEvent * event, bool inMSHR) {
     if (!inMSHR)
         stat_cacheHits->addData(1);
 
+    if (state == I && isSparseEviction(event)) {
+        finishSparseEviction(event);
+        return true;
+    }
+
     switch (state) {
         case I:
             if (!(mshr->pendingWriteback(addr) || (mshr->exists(addr) && mshr->getFrontEvent(addr)->getCmd() == Command::FlushLineInv))) {
@@ -2266,6 +2320,29 @@ bool DirectoryController::handleFetchResp(MemEvent* event, bool inMSHR) {
     if (mem_h_is_debug_addr(addr))
         eventDI.prefill(event->getID(), Command::FetchResp, false, addr, state);
 
+    if (isCleanForwardPending(addr, event->getSrc())) {
+        if (state == S_D) {
+            cleanForwards.erase(addr);
+            MemEvent * reqEv = static_cast<MemEvent*>(mshr->getFrontEvent(addr));
+            entry->setState(S);
+            entry->addSharer(reqEv->getSrc());
+            sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
+            mshr->setData(addr, event->getPayload(), false); // So subsequent GetS can get data
+            stat_cleanForwards->addData(1);
+            cleanUpAfterResponse(event, inMSHR);
+        } else {
+            /* An invalidation from below raced with the forward (SD_Inv). Memory orders our request after it. */
+            cleanForwardFallback(addr);
+            delete event;
+        }
+
+        if (mem_h_is_debug_addr(addr)) {
+            eventDI.newst = entry->getState();
+            eventDI.verboseline = entry->getString();
+        }
+        return true;
+    }
+
     if (state != S_Inv && state != M_Inv)
         out.fatal(CALL_INFO, -1, "%s, Error: Received FetchResp in unhandled state '%s'. Event: %s. Time: %" PRIu64 "ns\n",
                 getName().c_str(), StateString[state], event->getVerboseString(dlevel).c_str(), getCurrentSimTimeNano());
@@ -2327,6 +2404,12 @@ bool DirectoryController::handleNACK(MemEvent* event, bool inMSHR) {
                 break;
             delete nackedEvent;
             return true;
+        case Command::Fetch:
+            // Retry the clean forward unless the forwarder has since dropped the line
+            if (cleanForwards.find(addr) != cleanForwards.end() && cleanForwards.find(addr)->second.second == nackedEvent->getID())
+                break;
+            delete nackedEvent;
+            return true;
         default:
             out.fatal(CALL_INFO, -1, "%s, Error: Received NACK in unhandled state '%s'. Event: %s. Time: %" PRIu64 "ns\n",
                     getName().c_str(), StateString[state], nackedEvent->getVerboseString(dlevel).c_str(), getCurrentSimTimeNano());
@@ -2388,15 +2471,143 @@ DirectoryController::DirEntry* DirectoryController::getDirEntry(Addr addr) {
     std::unordered_map<Addr,DirEntry*>::iterator i = directory.find(addr);
 
     if (directory.end() == i) {
-        directory[addr] = new DirEntry(addr);
+        directory[addr] = new DirEntry(addr, &sharerIds);
         i = directory.find(addr);
         i->second->cacheIter = entryCache.end();
         i->second->setCached(true);
 
+        if (!sparseSets.empty()) {
+            std::list<DirEntry*>& set = sparseSets[sparseSetIndex(addr)];
+            set.push_front(i->second);
+            i->second->cacheIter = set.begin();
+        }
+    } else if (!sparseSets.empty()) {
+        std::list<DirEntry*>& set = sparseSets[sparseSetIndex(addr)];
+        set.splice(set.begin(), set, i->second->cacheIter);
     }
     return i->second;
 }
 
+uint64_t DirectoryController::sparseSetIndex(Addr addr) {
+    /* Index by this directory's own lines so interleaving does not leave sets unused */
+    Addr offset = addr - region.start;
+    uint64_t line;
+    if (region.interleaveSize == 0)
+        line = offset / lineSize;
+    else
+        line = (offset / region.interleaveStep) * (region.interleaveSize / lineSize) + (offset % region.interleaveStep) / lineSize;
+    return line % sparseSets.size();
+}
+
+/*
+ * Make room for a request's line in the sparse directory. Returns false if the
+ * request must wait, either for a free way or for a back-invalidation to finish.
+ */
+bool DirectoryController::reserveSparseEntry(MemEvent* event) {
+    Addr addr = event->getBaseAddr();
+    switch (event->getCmd()) {
+        case Command::GetS:
+        case Command::GetX:
+        case Command::GetSX:
+        case Command::Write:
+        case Command::FlushLine:
+        case Command::FlushLineInv:
+            break;
+        default:
+            return true; // Only requests that bring lines into caches allocate
+    }
+    if (directory.find(addr) != directory.end())
+        return true;
+
+    uint64_t index = sparseSetIndex(addr);
+    std::list<DirEntry*>& set = sparseSets[index];
+    if (set.size() < sparseWays)
+        return true;
+    if (sparseEvicting[index])
+        return false;
+
+    /* Least recently used entry that is stable and not busy */
+    DirEntry* victim = nullptr;
+    for (std::list<DirEntry*>::reverse_iterator it = set.rbegin(); it != set.rend(); it++) {
+        State vstate = (*it)->getState();
+        if ((vstate == I || vstate == S || vstate == M) && !mshr->exists((*it)->getBaseAddr())) {
+            victim = *it;
+            break;
+        }
+    }
+    if (!victim)
+        return false;
+
+    stat_dirEvictions->addData(1);
+    bool cachedCopies = (victim->getState() == S && victim->hasSharers()) || (victim->getState() == M && victim->hasOwner());
+    if (!cachedCopies) {
+        freeSparseEntry(victim);
+        return true;
+    }
+
+    /* Recall the line with a FetchInv from ourselves; handleFetchInv does the rest */
+    Addr vaddr = victim->getBaseAddr();
+    MemEvent* recall = new MemEvent(getName(), vaddr, vaddr, Command::FetchInv, lineSize);
+    recall->setRqstr(getName());
+    if (allocateMSHR(recall, true) != MemEventStatus::OK) {
+        delete recall;
+        return false;
+    }
+    stat_dirBackInvalidations->addData(1);
+    sparseEvicting[index] = true;
+    handleFetchInv(recall, true);
+    return false;
+}
+
+void DirectoryController::finishSparseEviction(MemEvent* event) {
+    /* Dirty data was written back when the owner's FetchResp arrived */
+    Addr addr = event->getBaseAddr();
+    if (mshr->hasData(addr))
+        mshr->clearData(addr);
+    sparseEvicting[sparseSetIndex(addr)] = false;
+    cleanUpAfterRequest(event, true);
+
+    /* Requests for the line that arrived during the recall keep the entry */
+    if (!mshr->exists(addr))
+        freeSparseEntry(getDirEntry(addr));
+}
+
+void DirectoryController::freeSparseEntry(DirEntry* entry) {
+    sparseSets[sparseSetIndex(entry->getBaseAddr())].erase(entry->cacheIter);
+    directory.erase(entry->getBaseAddr());
+    delete entry;
+}
+
+/* Ask the line's forwarder for a copy instead of reading memory. The request stays in progress until the FetchResp arrives */
+void DirectoryController::issueCleanForward(MemEvent* event, DirEntry* entry) {
+    Addr addr = entry->getBaseAddr();
+    MemEvent * fetch = new MemEvent(getName(), event->getAddr(), addr, Command::Fetch, lineSize);
+    fetch->copyMetadata(event);
+    fetch->setDst(entry->getForwarder());
+
+    cleanForwards[addr] = std::make_pair(entry->getForwarder(), fetch->getID());
+    mshr->setInProgress(addr);
+
+    forwardByDestination(fetch, timestamp + accessLatency);
+}
+
+bool DirectoryController::isCleanForwardPending(Addr addr, const std::string& src) {
+    std::map<Addr, std::pair<std::string, MemEventBase::id_type> >::iterator it = cleanForwards.find(addr);
+    return it != cleanForwards.end() && it->second.first == src;
+}
+
+/* The forwarder dropped the line so it will ignore our Fetch; read memory for the waiting GetS instead */
+void DirectoryController::cleanForwardFallback(Addr addr) {
+    cleanForwards.erase(addr);
+    stat_cleanForwardFallbacks->addData(1);
+
+    MemEvent * reqEv = static_cast<MemEvent*>(mshr->getFirstEventEntry(addr, Command::GetS));
+    MemEvent * memReq = new MemEvent(*reqEv);
+    memReq->setSrc(getName());
+    memReq->setSize(lineSize);
+    forwardByAddress(memReq, timestamp + accessLatency); // GetS is already in progress
+}
+
 bool DirectoryController::retrieveDirEntry(DirEntry* entry, MemEvent* event, bool inMSHR) {
     MemEventStatus status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, false);
     if (status == MemEventStatus::Reject)
@@ -2429,7 +2640,7 @@ bool DirectoryController::retrieveDirEntry(DirEntry* entry, MemEvent* event, boo
     me->setSize(entrySize);
     dirMemAccesses.insert(std::make_pair(me->getID(), event->getBaseAddr()));
 
-    uint64_t deliveryTime = timestamp + accessLatency;
+    uint64_t deliveryTime = functionalTime(me, timestamp + accessLatency);
 
     // Bypass destination lookup
     memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(me, true)));
@@ -2495,7 +2706,11 @@ void DirectoryController::cleanUpAfterResponse(MemEvent * event, bool inMSHR) {
 }
 
 void DirectoryController::updateCache(DirEntry * entry) { // TODO replace with a proper cache!
-    if (0 == entryCacheMaxSize) {
+    if (!sparseSets.empty()) {
+        /* Entries live on chip until evicted; idle invalid ones are dropped right away */
+        if (entry->getState() == I && !mshr->exists(entry->getBaseAddr()))
+            freeSparseEntry(entry);
+    } else if (0 == entryCacheMaxSize) {
         sendEntryToMemory(entry);
     } else {
         if (entry->cacheIter != entryCache.end()) {
@@ -2534,7 +2749,7 @@ void DirectoryController::sendEntryToMemory(DirEntry *entry) {
     me->setSize(entrySize);
     me->setFlag(MemEventBase::F_NORESPONSE);
 
-    uint64_t deliveryTime = timestamp + accessLatency;
+    uint64_t deliveryTime = functionalTime(me, timestamp + accessLatency);
     me->setDst(linkDown_->getTargetDestination(0));
     memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(me, true)));
 }
@@ -2596,7 +2811,9 @@ void DirectoryController::issueFetch(MemEvent* event, DirEntry* entry, Command c
 void DirectoryController::issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd) {
     std::string rqstr = (event->getSrc());
 
-    for (set<std::string>::iterator it = entry->getSharers()->begin(); it != entry->getSharers()->end(); it++) {
+    std::vector<std::string> sharers;
+    entry->getSharers(sharers);
+    for (std::vector<std::string>::iterator it = sharers.begin(); it != sharers.end(); it++) {
         if (*it == rqstr) continue;
         issueInvalidation(*it, event, entry, cmd);
     }
@@ -2645,7 +2862,7 @@ void DirectoryController::sendResponse(MemEvent* event, uint32_t flags, uint32_t
 void DirectoryController::writebackData(MemEvent* event) {
     MemEvent * wb = new MemEvent(getName(), event->getBaseAddr(), event->getBaseAddr(), Command::PutM, lineSize);
     wb->copyMetadata(event);
-    wb->setPayload(event->getPayload());
+    wb->sharePayload(event);
     wb->setDirty(event->getDirty());
 
     if (waitWBAck)
@@ -2755,6 +2972,7 @@ void DirectoryController::sendOutgoingEvents() {
  * dirAccess has default value of false
  */
 void DirectoryController::forwardByAddress(MemEventBase * ev, Cycle_t ts, bool dirAccess) {
+    ts = functionalTime(ev, ts);
     std::string dst = linkDown_->findTargetDestination(ev->getRoutingAddress());
     if (dst != "") { /* Common case */
         ev->setDst(dst);
@@ -2777,6 +2995,7 @@ void DirectoryController::forwardByAddress(MemEventBase * ev, Cycle_t ts, bool d
  * dirAccess has default value of false
  */
 void DirectoryController::forwardByDestination(MemEventBase* ev, Cycle_t ts, bool dirAccess) {
+    ts = functionalTime(ev, ts);
     if (linkUp_->isReachable(ev->getDst())) {
         cpuMsgQueue.insert(std::make_pair(ts, ev));
     } else if (linkDown_->isReachable(ev->getDst())) {
@@ -2787,6 +3006,14 @@ void DirectoryController::forwardByDestination(MemEventBase* ev, Cycle_t ts, boo
     }
 }
 
+/* In functional mode, flag the event and send it next cycle instead of at 'ts' */
+Cycle_t DirectoryController::functionalTime(MemEventBase* ev, Cycle_t ts) {
+    if (!functional)
+        return ts;
+    ev->setFlag(MemEventBase::F_FUNCTIONAL);
+    return timestamp + 1;
+}
+
 void DirectoryController::recordStartLatency(MemEventBase* ev) {
     startTimes.insert(std::make_pair(ev->getID(), timestamp));
 }
@@ -2853,18 +3080,29 @@ void DirectoryController::serialize_order(SST::Core::Serialization::serializer&
     SST_SER(dlevel);
     SST_SER(mshr);
     SST_SER(directory);
+    SST_SER(sharerIds);
     SST_SER(cpuMsgQueue);
     SST_SER(memMsgQueue);
     SST_SER(entryCacheMaxSize);
     SST_SER(entryCacheSize);
     SST_SER(entrySize);
     SST_SER(entryCache);
+    SST_SER(sparseWays);
+    SST_SER(sparseSets);
+    SST_SER(sparseEvicting);
+    SST_SER(stat_dirEvictions);
+    SST_SER(stat_dirBackInvalidations);
+    SST_SER(stat_cleanForwards);
+    SST_SER(stat_cleanForwardFallbacks);
     SST_SER(lineSize);
     SST_SER(accessLatency);
+    SST_SER(functional);
     SST_SER(mshrLatency);
     SST_SER(flush_state_);
     SST_SER(responses);
     SST_SER(dirMemAccesses);
+    SST_SER(forwardClean);
+    SST_SER(cleanForwards);
     SST_SER(protocol);
     SST_SER(waitWBAck);
     SST_SER(sendWBAck);
@@ -2875,6 +3113,11 @@ void DirectoryController::serialize_order(SST::Core::Serialization::serializer&
     if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
         for (auto& x : directory) {
             x.second->cacheIter = std::find(entryCache.begin(), entryCache.end(), x.second);
+            x.second->ids = &sharerIds;
+        }
+        for (auto& set : sparseSets) {
+            for (std::list<DirEntry*>::iterator it = set.begin(); it != set.end(); it++)
+                (*it)->cacheIter = it;
         }
     }
 }
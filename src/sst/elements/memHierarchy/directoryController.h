@@ -36,6 +36,7 @@
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/mshr.h"
+#include "sst/elements/memHierarchy/sharerSet.h"
 
 using namespace std;
 
@@ -50,12 +51,15 @@ public:
     SST_ELI_DOCUMENT_PARAMS(
             {"clock",                   "Clock rate of controller.", "1GHz"},
             {"entry_cache_size",        "Size (in # of entries) the controller will cache.", "0"},
+            {"sparse_entries",          "If non-zero, track at most this many lines in a set-associative sparse directory. Evicting an entry back-invalidates its sharers/owner. Replaces entry_cache_size.", "0"},
+            {"sparse_associativity",    "Associativity of the sparse directory. Must divide sparse_entries.", "16"},
             {"debug",                   "Where to send debug output. 0: No debugging, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},
             {"debug_level",             "Debugging level: 0 to 10. Must configure sst-core with '--enable-debug'. 1=info, 2-10=debug output", "0"},
             {"debug_addr",              "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""},
             {"verbose",                 "Output verbosity for warnings/errors. 0[fatal error only], 1[warnings], 2[full state dump on fatal error]","1"},
             {"cache_line_size",         "Size of a cache line [aka cache block] in bytes.", "64"},
             {"coherence_protocol",      "Coherence protocol.  Supported --MESI, MSI--", "MESI"},
+            {"forward_clean_data",      "MESIF-style forwarding: serve a GetS to a shared line from the most recent sharer (Fetch) instead of memory. Falls back to memory if that sharer has dropped the line.", "false"},
             {"mshr_num_entries",        "Number of MSHRs. Set to -1 for almost unlimited number.", "-1"},
             {"access_latency_cycles",   "Latency of directory access in cycles", "0"},
             {"mshr_latency_cycles",     "Latency of mshr access in cycles", "0"},
@@ -89,6 +93,10 @@ public:
             {"get_request_latency",         "Total latency in ns of all get* requests handled",                 "nanoseconds",  1},
             {"directory_cache_hits",        "Number of requests that hit in the directory cache",               "requests",     1},
             {"mshr_hits",                   "Number of requests that hit in the MSHRs",                         "requests",     1},
+            {"directory_evictions",         "Sparse directory: entries evicted to make room for a new line",    "count",        1},
+            {"directory_back_invalidations","Sparse directory: evictions that had to invalidate cached copies", "count",        1},
+            {"clean_forwards",              "Clean forwarding: GetS requests served from a sharer instead of memory", "count", 1},
+            {"clean_forward_fallbacks",     "Clean forwarding: forwards that went to memory because the sharer dropped the line", "count", 1},
             /* Event received */
             {"GetS_recv",           "Event received: GetS (read-shared)", "count", 1},
             {"GetX_recv",           "Event received: GetX (write-exclusive)", "count", 1},
@@ -131,6 +139,7 @@ public:
             {"eventSent_Inv",           "Event sent: Inv", "count", 2},
             {"eventSent_FetchInv",      "Event sent: FetchInv", "count", 2},
             {"eventSent_FetchInvX",     "Event sent: FetchInvX","count", 2},
+            {"eventSent_Fetch",         "Event sent: Fetch (clean forwarding)", "count", 2},
             {"eventSent_ForceInv",      "Event sent: ForceInv", "count", 2},
             {"eventSent_ForwardFlush",  "Event sent: ForwardFlush", "count", 2},
             {"eventSent_NACK",          "Event sent: NACK", "count", 2},
@@ -168,6 +177,7 @@ private:
 
     /* Timestamp & latencies */
     uint64_t    timestamp;
+    bool        functional;     // Handling a functional (warm-up) event - send everything next cycle
     int         maxRequestsPerCycle;
 
     /* Turn clocks off when idle */
@@ -190,6 +200,10 @@ private:
     Statistic<uint64_t> * stat_eventSent[(int)Command::LAST_CMD];
     Statistic<uint64_t> * stat_dirEntryReads;
     Statistic<uint64_t> * stat_dirEntryWrites;
+    Statistic<uint64_t> * stat_dirEvictions;
+    Statistic<uint64_t> * stat_dirBackInvalidations;
+    Statistic<uint64_t> * stat_cleanForwards;
+    Statistic<uint64_t> * stat_cleanForwardFallbacks;
 
     Statistic<uint64_t> * stat_MSHROccupancy;
 
@@ -324,11 +338,13 @@ private:
         bool                  cached;         // whether block is cached or not
         Addr                  addr;           // block address
         State                 state;          // state
-        std::list<DirEntry*>::iterator cacheIter; // Location in cache (or end() if not cached)
-        std::set<std::string> sharers;        // set of sharers for block
-        std::string           owner;          // Owner of block
+        std::list<DirEntry*>::iterator cacheIter; // Location in cache (or end() if not cached), or in its sparse set
+        SharerIdMap*          ids;            // Directory-wide sharer name <-> ID map
+        SharerSet             sharers;        // IDs of sharers for block
+        int32_t               owner;          // ID of owner of block, or NO_ID
+        int32_t               forwarder;      // ID of the sharer that forwards clean data (newest sharer), or NO_ID
 
-        DirEntry(Addr a) {
+        DirEntry(Addr a, SharerIdMap* idMap) : ids(idMap) {
             clearEntry();
             addr = a;
             state = I;
@@ -339,7 +355,8 @@ private:
             cached = true;
             addr = 0;
             sharers.clear();
-            owner = "";
+            owner = SharerIdMap::NO_ID;
+            forwarder = SharerIdMap::NO_ID;
         }
 
         std::string getString() {
@@ -347,13 +364,15 @@ private:
             str << "State: " << StateString[state];
             str << " Sharers: [";
             bool comma = false;
-            for (std::set<std::string>::iterator it = sharers.begin(); it != sharers.end(); it++) {
+            std::vector<std::string> names;
+            getSharers(names);
+            for (std::vector<std::string>::iterator it = names.begin(); it != names.end(); it++) {
                 if (comma)
                     str << ",";
                 str << *it;
                 comma = true;
             }
-            str << "] Owner: " << owner;
+            str << "] Owner: " << getOwner();
             str << " Cached: " << (cached ? "y" : "n");
             return str.str();
         }
@@ -366,25 +385,54 @@ private:
 
         size_t getSharerCount() { return sharers.size(); }
 
-        void clearSharers() { sharers.clear(); }
+        void clearSharers() {
+            sharers.clear();
+            forwarder = SharerIdMap::NO_ID;
+        }
 
-        void addSharer(std::string shr) { sharers.insert(shr); }
+        /* The newest sharer becomes the forwarder (the MESIF F state) */
+        void addSharer(const std::string& shr) {
+            uint32_t id = ids->getId(shr);
+            sharers.insert(id);
+            forwarder = (int32_t)id;
+        }
 
-        bool isSharer(std::string shr) { return sharers.find(shr) != sharers.end(); }
+        bool isSharer(const std::string& shr) {
+            int32_t id = ids->findId(shr);
+            return id != SharerIdMap::NO_ID && sharers.contains(id);
+        }
 
         bool hasSharers() { return !(sharers.empty()); }
 
-        std::set<std::string>* getSharers() { return &sharers; }
+        /* Fill 'names' with the sharers' names in sorted order (the order invalidations are sent in) */
+        void getSharers(std::vector<std::string>& names) {
+            std::vector<uint32_t> sharerIds;
+            sharers.getIds(sharerIds);
+            names.clear();
+            for (uint32_t id : sharerIds)
+                names.push_back(ids->getName(id));
+            std::sort(names.begin(), names.end());
+        }
+
+        void removeSharer(const std::string& shr) {
+            int32_t id = ids->findId(shr);
+            if (id != SharerIdMap::NO_ID)
+                sharers.erase(id);
+            if (id == forwarder)
+                forwarder = SharerIdMap::NO_ID;
+        }
+
+        std::string getForwarder() { return hasForwarder() ? ids->getName(forwarder) : ""; }
 
-        void removeSharer(std::string shr) { sharers.erase(shr); }
+        bool hasForwarder() { return forwarder != SharerIdMap::NO_ID; }
 
-        std::string getOwner() { return owner; }
+        std::string getOwner() { return hasOwner() ? ids->getName(owner) : ""; }
 
-        bool hasOwner() { return owner != ""; }
+        bool hasOwner() { return owner != SharerIdMap::NO_ID; }
 
-        void removeOwner() { owner = ""; }
+        void removeOwner() { owner = SharerIdMap::NO_ID; }
 
-        void setOwner(std::string own) { owner = own; }
+        void setOwner(const std::string& own) { owner = own.empty() ? SharerIdMap::NO_ID : (int32_t)ids->getId(own); }
 
         void setState(State nState) { state = nState; }
 
@@ -398,8 +446,10 @@ private:
             SST_SER(state);
             SST_SER(sharers);
             SST_SER(owner);
+            SST_SER(forwarder);
             // Serialization of iterators isn't supported
             // Skip serializing and reconstruct on deserialization
+            // 'ids' is restored by the controller
         }
     };
 
@@ -417,6 +467,18 @@ private:
     void updateCache(DirEntry * entry);
     void sendEntryToMemory(DirEntry* entry);
 
+    /* Sparse directory */
+    uint64_t sparseSetIndex(Addr addr);
+    bool reserveSparseEntry(MemEvent* event);
+    bool isSparseEviction(MemEvent* event) { return event->getSrc() == getName(); }
+    void finishSparseEviction(MemEvent* event);
+    void freeSparseEntry(DirEntry* entry);
+
+    /* Clean forwarding */
+    void issueCleanForward(MemEvent* event, DirEntry* entry);
+    bool isCleanForwardPending(Addr addr, const std::string& src);
+    void cleanForwardFallback(Addr addr);
+
     void issueMemoryRequest(MemEvent* event, DirEntry* entry, bool lineGranularity);
     void issueFlush(MemEvent* event);
     void issueFetch(MemEvent* event, DirEntry* entry, Command cmd);
@@ -435,6 +497,7 @@ private:
 
     MSHR * mshr;
     std::unordered_map<Addr, DirEntry*> directory; // Master list of all directory entries, including noncached ones
+    SharerIdMap sharerIds;  // Dense IDs for the caches recorded as sharers/owners in 'directory'
 
 
     struct MemMsg {
@@ -454,6 +517,7 @@ private:
 
     void forwardByDestination(MemEventBase* ev, Cycle_t timestamp, bool dirAccess = false);
     void forwardByAddress(MemEventBase* ev, Cycle_t timestamp, bool dirAccess = false);
+    Cycle_t functionalTime(MemEventBase* ev, Cycle_t timestamp);
 
     std::multimap<uint64_t,MemEventBase*>   cpuMsgQueue;
     std::multimap<uint64_t,MemMsg>   memMsgQueue;
@@ -463,6 +527,11 @@ private:
     uint32_t    entrySize;
     std::list<DirEntry*> entryCache;
 
+    /* Sparse directory: each set lists its entries, most recently used first */
+    uint64_t    sparseWays;
+    std::vector<std::list<DirEntry*> > sparseSets;
+    std::vector<bool> sparseEvicting;   // Set has a back-invalidation in progress
+
     uint64_t lineSize;
 
     uint64_t accessLatency;
@@ -474,6 +543,10 @@ private:
 
     std::map<MemEventBase::id_type, Addr> dirMemAccesses;
 
+    /* Clean forwarding: lines waiting on a Fetch to their forwarder, with the forwarder and the Fetch's ID */
+    bool forwardClean;
+    std::map<Addr, std::pair<std::string, MemEventBase::id_type> > cleanForwards;
+
     CoherenceProtocol protocol;
     bool waitWBAck;
     bool sendWBAck;
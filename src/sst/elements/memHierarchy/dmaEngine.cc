@@ -15,73 +15,77 @@
 
 #include <sst/core/sst_config.h>
 #include "dmaEngine.h"
+#include "util.h"
+
+#include <algorithm>
 
 #include <sst/core/component.h>
 #include <sst/core/params.h>
 
 using namespace SST;
 using namespace SST::MemHierarchy;
+using namespace SST::Interfaces;
 
 uint64_t DMACommand::main_id = 0;
 
 DMAEngine::DMAEngine(ComponentId_t id, Params &params) :
-    Component(id)
+    Component(id), numTransfers(0), bytesTransferred(0)
 {
-    dbg.init("@t:DMAEngine::@p():@l " + getName() + ": ", 0, 0,
+    dbg.init("@t:DMAEngine::@p():@l " + getName() + ": ", params.find<int>("debug_level", 0), 0,
             (Output::output_location_t)params.find<int>("debug", 0));
     statsOutputTarget = (Output::output_location_t)params.find<int>("printStats", 0);
 
+    uint32_t numChannels = params.find<uint32_t>("num_channels", 1);
+    maxOutstanding = params.find<uint32_t>("max_outstanding", 8);
+    lineSize = params.find<uint64_t>("line_size", 64);
+    ringBase = params.find<Addr>("ring_base", 0);
+    ringEntries = params.find<uint64_t>("ring_entries", 0);
+    descriptorPrefetch = params.find<uint32_t>("descriptor_prefetch", 4);
+
+    if ( numChannels == 0 )
+        dbg.fatal(CALL_INFO, -1, "%s, Error: num_channels must be at least 1\n", getName().c_str());
+    if ( maxOutstanding == 0 )
+        dbg.fatal(CALL_INFO, -1, "%s, Error: max_outstanding must be at least 1\n", getName().c_str());
+    if ( lineSize == 0 )
+        dbg.fatal(CALL_INFO, -1, "%s, Error: line_size must be greater than 0\n", getName().c_str());
+    if ( ringEntries != 0 && descriptorPrefetch == 0 )
+        dbg.fatal(CALL_INFO, -1, "%s, Error: descriptor_prefetch must be at least 1 when ring_entries is set\n", getName().c_str());
+    channels.resize(numChannels);
+
     TimeConverter tc = registerClock(params.find<std::string>("clockRate", "1 GHz"),
             new Clock::Handler2<DMAEngine, &DMAEngine::clock>(this));
     commandLink = configureLink("cmdLink", tc, NULL);
     if ( NULL == commandLink ) dbg.fatal(CALL_INFO, 1, "Missing cmdLink\n");
 
-    if ( !isPortConnected("netLink") ) dbg.fatal(CALL_INFO, 1, "Missing netLink\n");
-/*
-    MemNIC::ComponentInfo myInfo;
-    myInfo.link_port = "netLink";
-    myInfo.link_bandwidth = "1GiB/s";
-	myInfo.num_vcs = params.find<int>("network_num_vc", 1);
-    myInfo.name = getName();
-    myInfo.type = MemNIC::TypeDMAEngine;
-    networkLink = new MemNIC(this, &dbg, -1, myInfo);
-*/
-    blocksize = 0;
+    memory = loadUserSubComponent<StandardMem>("memory", ComponentInfo::SHARE_NONE, registerTimeBase("1ns"),
+            new StandardMem::Handler2<DMAEngine, &DMAEngine::handleMemResponse>(this));
+    if ( NULL == memory )
+        dbg.fatal(CALL_INFO, -1, "%s, Error: No interface found loaded into 'memory' subcomponent slot. Please check input file\n", getName().c_str());
+
+    stat_bytesTransferred = registerStatistic<uint64_t>("bytes_transferred");
+    stat_transfers = registerStatistic<uint64_t>("transfers");
+    stat_transferLatency = registerStatistic<uint64_t>("transfer_latency");
+    stat_descriptorsFetched = registerStatistic<uint64_t>("descriptors_fetched");
+    stat_fenceStallCycles = registerStatistic<uint64_t>("fence_stall_cycles");
 }
 
 
 void DMAEngine::init(unsigned int phase)
 {
-    networkLink->init(phase);
+    memory->init(phase);
 }
 
 
 void DMAEngine::setup(void)
 {
-    networkLink->setup();
-    bool blocksizeSet = false;
-
-/*    const std::vector<MemNIC::PeerInfo_t> &peers = networkLink->getPeerInfo();
-    for ( std::vector<MemNIC::PeerInfo_t>::const_iterator i = peers.begin() ; i != peers.end() ; ++i ) {
-        switch (i->first.type) {
-        case MemNIC::TypeDirectoryCtrl:
-            break;
-        case MemNIC::TypeCache:
-            if ( !blocksizeSet ) {
-                blocksize = i->second.blocksize;
-                blocksizeSet = true;
-            }
-        default:
-            ;
-        }
-    }
-
-    networkLink->clearPeerInfo();*/
+    memory->setup();
 }
 
 
 void DMAEngine::finish(void)
 {
+    memory->finish();
+
     Output out("", 0, 0, statsOutputTarget);
     out.output("DMA Controller %s stats:\n"
             "\t # Transfers:        %" PRIu64 "\n"
@@ -94,144 +98,272 @@ void DMAEngine::finish(void)
 
 bool DMAEngine::clock(Cycle_t cycle)
 {
-    /* Process Network
-     * Check Command link
-     * If new command, check overlap, and delay if needed, otherwise process
-     */
-
-    //networkLink->clock();
-
-    MemEventBase *me = NULL;
     SST::Event *se = NULL;
-
-//    while ( NULL != (me = networkLink->recv()) ) {
-        /* Process network packet */
-/*        Request* req = findRequest(me->getResponseToID());
-#ifdef __SST_DEBUG_OUTPUT__
-        if ( NULL == req ) {
-            dbg.debug(_L10_, "Received Packet for which we have no response ID waiting.  ID received: (%" PRIx64 ", %d)\n", me->getResponseToID().first, me->getResponseToID().second);
-        }
-#endif
-        processPacket(req, me);
-    }
-*/
-
     while ( NULL != (se = commandLink->recv()) ) {
-        /* Process new commands */
-        DMACommand* cmd = static_cast<DMACommand*>(se);
-        commandQueue.push_back(cmd);
+        if ( DMACommand *cmd = dynamic_cast<DMACommand*>(se) ) {
+            handleCommand(cmd);
+        } else if ( DMADoorbell *bell = dynamic_cast<DMADoorbell*>(se) ) {
+            handleDoorbell(bell);
+        } else {
+            dbg.fatal(CALL_INFO, -1, "%s, Error: Received unrecognized event on cmdLink\n", getName().c_str());
+        }
     }
 
-    /* See if we can process the next command */
-    if ( !commandQueue.empty() ) {
-        DMACommand *cmd = commandQueue.front();
-        if ( isIssuable(cmd) ) {
-            commandQueue.pop_front();
-            Request *req = new Request(cmd);
-            startRequest(req);
+    /* Each channel issues at most one line read per cycle. The line comes
+     * from the oldest started transfer that still has data to read; once all
+     * started transfers are fully issued, the next queued one may start. */
+    for ( uint32_t ch = 0; ch < channels.size(); ch++ ) {
+        Channel &chan = channels[ch];
+        fetchDescriptors(ch);
+
+        if ( chan.outstanding >= maxOutstanding )
+            continue;
+
+        Transfer *issuing = NULL;
+        for ( std::deque<Transfer*>::iterator it = chan.active.begin(); it != chan.active.end(); it++ ) {
+            if ( !(*it)->issued() ) {
+                issuing = *it;
+                break;
+            }
         }
+        if ( issuing == NULL && startTransfer(ch) )
+            issuing = chan.active.back();
+        if ( issuing != NULL && !issuing->issued() )
+            issueLine(issuing);
     }
 
     return false;
 }
 
 
-bool DMAEngine::isIssuable(DMACommand *cmd) const
+void DMAEngine::handleCommand(DMACommand *cmd)
 {
-    bool isOK = true;
-    /* Cycle through current requests.  If any overlap, then we should wait. */
-    for ( std::set<Request*>::iterator i = activeRequests.begin() ; isOK && i != activeRequests.end() ; ++i ) {
-        Request *req = (*i);
-        isOK = !findOverlap(req->command, cmd);
+    if ( cmd->channel >= channels.size() )
+        dbg.fatal(CALL_INFO, -1, "%s, Error: Received command for channel %" PRIu32 " but there are only %zu channels\n",
+                getName().c_str(), cmd->channel, channels.size());
+
+    Transfer *t = new Transfer(cmd, cmd->channel, cmd->fence);
+    if ( cmd->segments.empty() ) {
+        t->segments.push_back(DMASegment(cmd->dst, cmd->src, cmd->size));
+    } else {
+        t->segments = cmd->segments;
     }
 
-    return isOK;
+    dbg.debug(_L10_, "Received command with %zu segments on channel %" PRIu32 "%s\n", t->segments.size(), cmd->channel, cmd->fence ? " (fence)" : "");
+    channels[cmd->channel].queue.push_back(t);
+}
+
+
+void DMAEngine::handleDoorbell(DMADoorbell *bell)
+{
+    if ( ringEntries == 0 )
+        dbg.fatal(CALL_INFO, -1, "%s, Error: Received a doorbell but ring_entries is 0\n", getName().c_str());
+    if ( bell->channel >= channels.size() )
+        dbg.fatal(CALL_INFO, -1, "%s, Error: Received doorbell for channel %" PRIu32 " but there are only %zu channels\n",
+                getName().c_str(), bell->channel, channels.size());
+
+    Channel &chan = channels[bell->channel];
+    if ( bell->tail > chan.tail )
+        chan.tail = bell->tail;
+    dbg.debug(_L10_, "Doorbell on channel %" PRIu32 ", tail %" PRIu64 "\n", bell->channel, chan.tail);
+    delete bell;
 }
 
 
-void DMAEngine::startRequest(Request *req)
+void DMAEngine::fetchDescriptors(uint32_t ch)
 {
-    assert(0);
-    /*  Needs to be updated with current MemHierarchy Commands/States, MemHierarchyInterface
-    dbg.debug(_L10_, "Received request to transfer from %#" PRIx64 " to 0x%" PRIx64 "\n",
-            req->getSrc(), req->getDst());
-    ++numTransfers;
-    Addr ptr = req->getSrc();
-    while ( ptr < (req->getSrc() + req->getSize()) ) {
-        MemEvent *ev = new MemEvent(this, ptr, ptr, GetS);
-        ev->setSize(blocksize);
-        ev->setFlag(MemEvent::F_NONCACHEABLE);
-        ev->setDst(networkLink->findTargetDestination(ptr));
-        req->loadKeys.insert(ev->getID());
-        networkLink->send(ev);
-        ptr += blocksize;
+    Channel &chan = channels[ch];
+    while ( chan.fetchIndex < chan.tail && chan.fetchesOutstanding < descriptorPrefetch ) {
+        Addr addr = ringBase + (ch * ringEntries + (chan.fetchIndex % ringEntries)) * DMA_DESCRIPTOR_SIZE;
+        StandardMem::Read *read = new StandardMem::Read(addr, DMA_DESCRIPTOR_SIZE);
+        descriptorReads[read->getID()] = std::make_pair(ch, chan.fetchIndex);
+        memory->send(read);
+        chan.fetchIndex++;
+        chan.fetchesOutstanding++;
     }
-    activeRequests.insert(req);
-    */
 }
 
 
-void DMAEngine::processPacket(Request *req, MemEventBase *ev)
+/* Turns fetched descriptors into transfers in ring order. A chain of
+ * descriptors with DMA_DESC_CHAIN set, ended by one without it, forms a
+ * single scatter-gather transfer. */
+void DMAEngine::assembleDescriptors(uint32_t ch)
 {
-    assert(0);
-    /*  Needs to be updated with current MemHierarchy Commands/States, MemHierarchyInterface
-    if ( ev->getCmd() == GetSResp) {
-        if ( !req->loadKeys.count(ev->getResponseToID()) ) {
-            dbg.fatal(CALL_INFO, 1, "Received GetSResp, but we don't have a corresponding request in loadKeys!\n");
+    Channel &chan = channels[ch];
+    std::map<uint64_t, std::vector<uint64_t> >::iterator it;
+    while ( (it = chan.fetched.find(chan.assembleIndex)) != chan.fetched.end() ) {
+        std::vector<uint64_t> &desc = it->second;
+        uint64_t flags = desc[3];
+
+        if ( chan.assembling == NULL )
+            chan.assembling = new Transfer(NULL, ch, flags & DMA_DESC_FENCE);
+        chan.assembling->segments.push_back(DMASegment(desc[1], desc[0], desc[2]));
+        chan.assembleIndex++;
+
+        if ( !(flags & DMA_DESC_CHAIN) ) {
+            chan.assembling->interrupt = flags & DMA_DESC_INTERRUPT;
+            chan.assembling->ringIndex = chan.assembleIndex;
+            chan.queue.push_back(chan.assembling);
+            chan.assembling = NULL;
         }
-        size_t offset = ev->getAddr() - req->getSrc();
-        req->loadKeys.erase(ev->getResponseToID());
-        MemEvent *storeEV = new MemEvent(this, (req->getDst() + offset), (req->getDst() + offset), GetX);
-        storeEV->setFlag(MemEvent::F_NONCACHEABLE);
-        storeEV->setPayload(ev->getPayload());
-        storeEV->setDst(networkLink->findTargetDestination(req->getDst() + offset));
-        req->storeKeys.insert(storeEV->getID());
-        networkLink->send(storeEV);
-    } else if ( ev->getCmd() == GetXResp ) {
-        bytesTransferred += ev->getSize();
-        req->storeKeys.erase(ev->getResponseToID());
-        if ( req->storeKeys.empty() ) {
-            // Done with this request.
-            activeRequests.erase(req);
-            commandLink->send(req->command);
-            dbg.debug(_L10_, "Request to transfer 0x%" PRIx64 " to 0x%" PRIx64 " is complete.\n", req->getSrc(), req->getDst());
+        chan.fetched.erase(it);
+    }
+}
+
+
+bool DMAEngine::startTransfer(uint32_t ch)
+{
+    Channel &chan = channels[ch];
+    if ( chan.queue.empty() )
+        return false;
+
+    Transfer *t = chan.queue.front();
+    if ( !isIssuable(chan, t) ) {
+        stat_fenceStallCycles->addData(1);
+        return false;
+    }
+
+    chan.queue.pop_front();
+    chan.active.push_back(t);
+    t->startTime = getCurrentSimTimeNano();
+
+    /* Zero-length segments carry nothing to read */
+    while ( !t->issued() && t->segments[t->segment].size == 0 )
+        t->segment++;
+    if ( t->done() ) {
+        retire(ch);
+        return false;
+    }
+    return true;
+}
+
+
+void DMAEngine::issueLine(Transfer *t)
+{
+    DMASegment &seg = t->segments[t->segment];
+    Addr src = seg.src + t->offset;
+    uint64_t size = std::min(lineSize - (src % lineSize), seg.size - t->offset);
+
+    StandardMem::Read *read = new StandardMem::Read(src, size);
+    LineRead line = { t, seg.dst + t->offset };
+    lineReads[read->getID()] = line;
+    memory->send(read);
+
+    t->inflight++;
+    channels[t->channel].outstanding++;
+    t->offset += size;
+    while ( !t->issued() && t->offset == t->segments[t->segment].size ) {
+        t->segment++;
+        t->offset = 0;
+    }
+}
+
+
+void DMAEngine::handleMemResponse(StandardMem::Request *req)
+{
+    StandardMem::Request::id_t id = req->getID();
+
+    if ( StandardMem::ReadResp *resp = dynamic_cast<StandardMem::ReadResp*>(req) ) {
+        std::unordered_map<StandardMem::Request::id_t, std::pair<uint32_t, uint64_t> >::iterator dit = descriptorReads.find(id);
+        if ( dit != descriptorReads.end() ) {
+            uint32_t ch = dit->second.first;
+            std::vector<uint64_t> desc(4, 0);
+            for ( size_t i = 0; i < resp->data.size() && i < DMA_DESCRIPTOR_SIZE; i++ )
+                desc[i / 8] |= (uint64_t)resp->data[i] << (8 * (i % 8));
+            channels[ch].fetched[dit->second.second] = desc;
+            channels[ch].fetchesOutstanding--;
+            descriptorReads.erase(dit);
+            stat_descriptorsFetched->addData(1);
+            assembleDescriptors(ch);
             delete req;
+            return;
         }
+
+        std::unordered_map<StandardMem::Request::id_t, LineRead>::iterator lit = lineReads.find(id);
+        if ( lit == lineReads.end() )
+            dbg.fatal(CALL_INFO, -1, "%s, Error: Received read response with no matching request\n", getName().c_str());
+        StandardMem::Write *write = new StandardMem::Write(lit->second.dst, resp->data.size(), resp->data, false);
+        lineWrites[write->getID()] = lit->second.transfer;
+        memory->send(write);
+        lineReads.erase(lit);
+    } else if ( StandardMem::WriteResp *resp = dynamic_cast<StandardMem::WriteResp*>(req) ) {
+        std::unordered_map<StandardMem::Request::id_t, Transfer*>::iterator wit = lineWrites.find(id);
+        if ( wit == lineWrites.end() )
+            dbg.fatal(CALL_INFO, -1, "%s, Error: Received write response with no matching request\n", getName().c_str());
+        Transfer *t = wit->second;
+        lineWrites.erase(wit);
+
+        bytesTransferred += resp->size;
+        stat_bytesTransferred->addData(resp->size);
+        t->inflight--;
+        channels[t->channel].outstanding--;
+        if ( t->done() )
+            retire(t->channel);
     } else {
-	dbg.fatal(CALL_INFO, 1, "Received unexpected message %s 0x%" PRIx64 " from %s\n", CommandString[ev->getCmd()], ev->getAddr(), ev->getSrc().c_str());
+        dbg.fatal(CALL_INFO, -1, "%s, Error: Received unexpected response: %s\n", getName().c_str(), req->getString().c_str());
     }
-    */
+    delete req;
 }
 
 
-/* Returns true if there is overlap */
-bool DMAEngine::findOverlap(DMACommand *c1, DMACommand *c2) const
+/* Transfers may finish out of order but complete in the order they started */
+void DMAEngine::retire(uint32_t ch)
 {
-    return (findOverlap(c1->src, c1->size, c2->src, c2->size) ||
-            findOverlap(c1->src, c1->size, c2->dst, c2->size) ||
-            findOverlap(c1->dst, c1->size, c2->src, c2->size) ||
-            findOverlap(c1->dst, c1->size, c2->dst, c2->size));
+    Channel &chan = channels[ch];
+    while ( !chan.active.empty() && chan.active.front()->done() ) {
+        Transfer *t = chan.active.front();
+        chan.active.pop_front();
+
+        numTransfers++;
+        stat_transfers->addData(1);
+        stat_transferLatency->addData(getCurrentSimTimeNano() - t->startTime);
+
+        if ( t->command ) {
+            dbg.debug(_L10_, "Command on channel %" PRIu32 " is complete.\n", ch);
+            commandLink->send(t->command);
+        } else if ( t->interrupt ) {
+            dbg.debug(_L10_, "Descriptors on channel %" PRIu32 " up to %" PRIu64 " are complete.\n", ch, t->ringIndex);
+            commandLink->send(new DMACompletion(ch, t->ringIndex));
+        }
+        delete t;
+    }
 }
 
 
-/* Returns true if there is overlap */
-bool DMAEngine::findOverlap(Addr a1, size_t s1, Addr a2, size_t s2) const
+bool DMAEngine::isIssuable(Channel &chan, Transfer *t) const
 {
-    Addr end1 = a1 + s1;
-    Addr end2 = a2 + s2;
+    if ( t->fence )
+        return chan.active.empty();
 
-    return (( a1 <= end2 ) || ( a2 <= end1 ));
+    /* Cycle through current transfers.  If any overlap, then we should wait. */
+    for ( std::deque<Transfer*>::const_iterator i = chan.active.begin(); i != chan.active.end(); ++i ) {
+        if ( findOverlap(*i, t) )
+            return false;
+    }
+    return true;
 }
 
 
-DMAEngine::Request* DMAEngine::findRequest(SST::Event::id_type id)
+/* Returns true if either transfer writes a range the other one touches */
+bool DMAEngine::findOverlap(Transfer *t1, Transfer *t2) const
 {
-    for ( std::set<Request*>::iterator i = activeRequests.begin() ; i != activeRequests.end() ; ++i ) {
-        Request *req = (*i);
-        if ( req->loadKeys.count(id) || req->storeKeys.count(id) )
-            return req;
+    for ( std::vector<DMASegment>::const_iterator a = t1->segments.begin(); a != t1->segments.end(); ++a ) {
+        for ( std::vector<DMASegment>::const_iterator b = t2->segments.begin(); b != t2->segments.end(); ++b ) {
+            if ( findOverlap(a->dst, a->size, b->src, b->size) ||
+                 findOverlap(a->dst, a->size, b->dst, b->size) ||
+                 findOverlap(a->src, a->size, b->dst, b->size) )
+                return true;
+        }
     }
-    return NULL;
+    return false;
 }
 
 
+/* Returns true if there is overlap */
+bool DMAEngine::findOverlap(Addr a1, uint64_t s1, Addr a2, uint64_t s2) const
+{
+    Addr end1 = a1 + s1;
+    Addr end2 = a2 + s2;
+
+    return ( a1 < end2 ) && ( a2 < end1 );
+}
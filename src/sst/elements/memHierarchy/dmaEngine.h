@@ -16,23 +16,41 @@
 #ifndef _MEMHIERARCHY_DMAENGINE_H_
 #define _MEMHIERARCHY_DMAENGINE_H_
 
-
-
+#include <deque>
+#include <map>
+#include <unordered_map>
 #include <vector>
 
 #include <sst/core/event.h>
 #include <sst/core/component.h>
 #include <sst/core/link.h>
 #include <sst/core/output.h>
-
-#include "sst/elements/memHierarchy/memEvent.h"
-#include "sst/elements/memHierarchy/memNIC.h"
-
+#include <sst/core/interfaces/stdMem.h>
 
 namespace SST {
 namespace MemHierarchy {
 
-/* Send this to the DMAEngine to cause a DMA.  Returned when complete. */
+typedef uint64_t Addr;
+
+/* One contiguous piece of a scatter-gather transfer */
+struct DMASegment {
+    Addr src;
+    Addr dst;
+    uint64_t size;
+
+    DMASegment() : src(0), dst(0), size(0) { }
+    DMASegment(Addr dst, Addr src, uint64_t size) : src(src), dst(dst), size(size) { }
+
+    void serialize_order(SST::Core::Serialization::serializer &ser) {
+        SST_SER(src);
+        SST_SER(dst);
+        SST_SER(size);
+    }
+};
+
+/* Send this to the DMAEngine to cause a DMA.  Returned when complete.
+ * Commands on the same channel start in order; a fenced command waits until
+ * every earlier command on its channel has completed. */
 class DMACommand : public Event {
 private:
     static uint64_t main_id;
@@ -41,62 +59,186 @@ public:
     Addr dst;
     Addr src;
     size_t size;
-    DMACommand(const Component *origin, Addr dst, Addr src, size_t size) :
-        Event(), dst(dst), src(src), size(size)
+    std::vector<DMASegment> segments; /* If not empty, used instead of dst/src/size */
+    uint32_t channel;
+    bool fence;
+
+    DMACommand(const Component *origin, Addr dst, Addr src, size_t size, uint32_t channel = 0, bool fence = false) :
+        Event(), dst(dst), src(src), size(size), channel(channel), fence(fence)
+    {
+      event_id = std::make_pair(main_id++, origin->getId());
+    }
+    DMACommand(const Component *origin, const std::vector<DMASegment> &segments, uint32_t channel = 0, bool fence = false) :
+        Event(), dst(0), src(0), size(0), segments(segments), channel(channel), fence(fence)
     {
       event_id = std::make_pair(main_id++, origin->getId());
     }
     SST::Event::id_type getID(void) const { return event_id; }
 
+    void serialize_order(SST::Core::Serialization::serializer &ser) override {
+        Event::serialize_order(ser);
+        SST_SER(event_id);
+        SST_SER(dst);
+        SST_SER(src);
+        SST_SER(size);
+        SST_SER(segments);
+        SST_SER(channel);
+        SST_SER(fence);
+    }
+
 private:
     DMACommand() {} // For serialization
+
+    ImplementSerializable(SST::MemHierarchy::DMACommand);
+};
+
+/* Descriptor ring interface. Each channel owns 'ring_entries' descriptors of
+ * DMA_DESCRIPTOR_SIZE bytes at ring_base + channel * ring_entries * DMA_DESCRIPTOR_SIZE.
+ * A descriptor holds four little-endian 64-bit words: src, dst, size, flags.
+ * Software writes descriptors to memory and then rings the doorbell with the
+ * number of descriptors it has posted so far (a free-running index). */
+#define DMA_DESCRIPTOR_SIZE 32
+#define DMA_DESC_FENCE      0x1 /* Wait for earlier transfers on the channel to complete */
+#define DMA_DESC_INTERRUPT  0x2 /* Send a DMACompletion when this transfer retires */
+#define DMA_DESC_CHAIN      0x4 /* The next descriptor is another segment of this transfer */
+
+class DMADoorbell : public Event {
+public:
+    uint32_t channel;
+    uint64_t tail;
+
+    DMADoorbell(uint32_t channel, uint64_t tail) : Event(), channel(channel), tail(tail) { }
+
+    void serialize_order(SST::Core::Serialization::serializer &ser) override {
+        Event::serialize_order(ser);
+        SST_SER(channel);
+        SST_SER(tail);
+    }
+
+private:
+    DMADoorbell() {} // For serialization
+
+    ImplementSerializable(SST::MemHierarchy::DMADoorbell);
+};
+
+/* Completion interrupt for descriptor transfers. 'index' is the ring index
+ * following the last retired descriptor, i.e., the channel's new head. */
+class DMACompletion : public Event {
+public:
+    uint32_t channel;
+    uint64_t index;
+
+    DMACompletion(uint32_t channel, uint64_t index) : Event(), channel(channel), index(index) { }
+
+    void serialize_order(SST::Core::Serialization::serializer &ser) override {
+        Event::serialize_order(ser);
+        SST_SER(channel);
+        SST_SER(index);
+    }
+
+private:
+    DMACompletion() {} // For serialization
+
+    ImplementSerializable(SST::MemHierarchy::DMACompletion);
 };
 
 
 class DMAEngine : public Component {
 public:
 /* Element Library Info */
-   /* SST_ELI_REGISTER_COMPONENT(DMAEngine, "memHierarchy", "DMAEngine", SST_ELI_ELEMENT_VERSION(1,0,0),
-            "DMA Engine", COMPONENT_CATEGORY_MEMORY)
+    SST_ELI_REGISTER_COMPONENT(DMAEngine, "memHierarchy", "DMAEngine", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "DMA Engine with scatter-gather commands, multiple channels, and an optional descriptor ring per channel", COMPONENT_CATEGORY_MEMORY)
 
     SST_ELI_DOCUMENT_PARAMS(
-            {"debug",           "0 (default): No debugging, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},
-            {"debug_level",     "Debugging level: 0 to 10", "0"},
-            {"clockRate",       "Clock Rate for processing DMAs.", "1GHz"},
-            {"netAddr",         "Network address of component.", NULL},
-            {"network_num_vc",  "DEPRECATED. Number of virtual channels (VCs) on the on-chip network. memHierarchy only uses one VC.", "1"},
-            {"printStats",      "0 (default): Don't print, 1: STDOUT, 2: STDERR, 3: FILE.", "0"} )
-
-    SST_ELI_DOCUMENT_PORTS( {"netLink", "Network Link", {"memHierarchy.MemRtrEvent"} } )
-*/
+            {"debug",               "0 (default): No debugging, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},
+            {"debug_level",         "Debugging level: 0 to 10", "0"},
+            {"clockRate",           "Clock Rate for processing DMAs.", "1GHz"},
+            {"num_channels",        "(uint) Number of independent DMA channels.", "1"},
+            {"max_outstanding",     "(uint) Maximum number of line requests in flight per channel.", "8"},
+            {"line_size",           "(uint) Size in bytes of each read/write the engine issues. Transfers are split on source line boundaries.", "64"},
+            {"ring_base",           "(uint) Base address of the descriptor rings.", "0"},
+            {"ring_entries",        "(uint) Descriptors per channel ring. 0 disables the descriptor rings.", "0"},
+            {"descriptor_prefetch", "(uint) Maximum number of descriptor reads in flight per channel.", "4"},
+            {"printStats",          "0 (default): Don't print, 1: STDOUT, 2: STDERR, 3: FILE.", "0"} )
+
+    SST_ELI_DOCUMENT_PORTS( {"cmdLink", "Polled link for DMACommand and DMADoorbell events. Completed commands and DMACompletions are returned on it.",
+            {"memHierarchy.DMACommand", "memHierarchy.DMADoorbell", "memHierarchy.DMACompletion"} } )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( {"memory", "Interface to the memory system", "SST::Interfaces::StandardMem"} )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+            {"bytes_transferred",       "Bytes copied", "bytes", 1},
+            {"transfers",               "Transfers completed", "count", 1},
+            {"transfer_latency",        "Time from start to retirement of a transfer", "ns", 1},
+            {"descriptors_fetched",     "Descriptors read from the rings", "count", 1},
+            {"fence_stall_cycles",      "Cycles a channel waited on a fence or an overlapping transfer", "cycles", 2} )
+
 /* Begin class definition */
 private:
-    struct Request {
-        DMACommand *command;
-        std::set<SST::Event::id_type> loadKeys;
-        std::set<SST::Event::id_type> storeKeys;
+    struct Transfer {
+        DMACommand *command;    /* NULL for ring descriptors */
+        uint32_t channel;
+        bool fence;
+        bool interrupt;
+        uint64_t ringIndex;     /* Ring index following this transfer's last descriptor */
+        std::vector<DMASegment> segments;
+        size_t segment;         /* Issue cursor */
+        uint64_t offset;
+        uint32_t inflight;
+        SimTime_t startTime;
 
-        Addr getDst() const { return command->dst; }
-        Addr getSrc() const { return command->src; }
-        size_t getSize() const { return command->size; }
+        bool issued() const { return segment == segments.size(); }
+        bool done() const { return issued() && inflight == 0; }
 
-        Request(DMACommand *cmd) :
-            command(cmd)
+        Transfer(DMACommand *cmd, uint32_t channel, bool fence) :
+            command(cmd), channel(channel), fence(fence), interrupt(false), ringIndex(0),
+            segment(0), offset(0), inflight(0), startTime(0)
         { }
     };
 
-    std::deque<DMACommand*> commandQueue;
-    std::set<Request*> activeRequests;
+    struct Channel {
+        std::deque<Transfer*> queue;    /* Not yet started */
+        std::deque<Transfer*> active;   /* Started, retired in order */
+        uint32_t outstanding;
+        uint64_t tail;                  /* Last doorbell */
+        uint64_t fetchIndex;            /* Next descriptor to read */
+        uint64_t assembleIndex;         /* Next descriptor to add to a transfer */
+        uint32_t fetchesOutstanding;
+        std::map<uint64_t, std::vector<uint64_t> > fetched; /* Descriptors returned out of order */
+        Transfer *assembling;
+
+        Channel() : outstanding(0), tail(0), fetchIndex(0), assembleIndex(0), fetchesOutstanding(0), assembling(NULL) { }
+    };
+
+    struct LineRead {
+        Transfer *transfer;
+        Addr dst;
+    };
 
     Output dbg;
-    uint64_t blocksize;
     Output::output_location_t statsOutputTarget;
     uint64_t numTransfers;
     uint64_t bytesTransferred;
 
+    uint64_t lineSize;
+    uint32_t maxOutstanding;
+    Addr ringBase;
+    uint64_t ringEntries;
+    uint32_t descriptorPrefetch;
+
+    std::vector<Channel> channels;
+    std::unordered_map<Interfaces::StandardMem::Request::id_t, LineRead> lineReads;
+    std::unordered_map<Interfaces::StandardMem::Request::id_t, Transfer*> lineWrites;
+    std::unordered_map<Interfaces::StandardMem::Request::id_t, std::pair<uint32_t, uint64_t> > descriptorReads;
 
     Link *commandLink;
-    MemNIC *networkLink;
+    Interfaces::StandardMem *memory;
+
+    Statistic<uint64_t>* stat_bytesTransferred;
+    Statistic<uint64_t>* stat_transfers;
+    Statistic<uint64_t>* stat_transferLatency;
+    Statistic<uint64_t>* stat_descriptorsFetched;
+    Statistic<uint64_t>* stat_fenceStallCycles;
 
 public:
     DMAEngine(ComponentId_t id, Params& params);
@@ -107,15 +249,19 @@ public:
 
 private:
     bool clock(Cycle_t cycle);
+    void handleMemResponse(Interfaces::StandardMem::Request *req);
 
-    bool isIssuable(DMACommand *cmd) const;
-    void startRequest(Request *req);
-    void processPacket(Request *req, MemEventBase *ev);
+    void handleCommand(DMACommand *cmd);
+    void handleDoorbell(DMADoorbell *bell);
+    void fetchDescriptors(uint32_t ch);
+    void assembleDescriptors(uint32_t ch);
+    bool startTransfer(uint32_t ch);
+    void issueLine(Transfer *t);
+    void retire(uint32_t ch);
 
-    bool findOverlap(DMACommand *c1, DMACommand *c2) const;
-    bool findOverlap(Addr a1, size_t s1, Addr a2, size_t s2) const;
-    Request* findRequest(SST::Event::id_type id);
-    //std::string findTargetDirectory(Addr addr); Moved to MemNIC
+    bool isIssuable(Channel &chan, Transfer *t) const;
+    bool findOverlap(Transfer *t1, Transfer *t2) const;
+    bool findOverlap(Addr a1, uint64_t s1, Addr a2, uint64_t s2) const;
 };
 
 }
@@ -25,6 +25,7 @@
 
 #include <stdint.h>
 #include <sst/core/subcomponent.h>
+#include <sst/core/output.h>
 
 namespace SST {
 namespace MemHierarchy {
@@ -115,6 +116,47 @@ public:
     ImplementSerializable(SST::MemHierarchy::XorHashFunction)
 };
 
+/* Permutation-based XOR hash. XORs the value with copies of itself shifted right
+ * by multiples of 'shift' bits so that higher-order (e.g., row) bits are folded
+ * onto the low-order (e.g., channel or bank) bits. */
+class XorFoldHashFunction : public HashFunction {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(XorFoldHashFunction, "memHierarchy", "hash.xor_fold", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "XOR-fold hash: folds higher-order bits onto the low-order bits, e.g., for XOR row/bank or channel interleaving", SST::MemHierarchy::HashFunction)
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"shift", "(uint) Distance in bits between the folded fields. Typically the log2 of the number of channels/banks being selected, or the distance to the row bits", "8"},
+            {"folds", "(uint) Number of higher-order fields to XOR onto the low-order field", "1"} )
+
+    XorFoldHashFunction(ComponentId_t id, Params& params) : HashFunction(id, params) {
+        shift_ = params.find<uint32_t>("shift", 8);
+        folds_ = params.find<uint32_t>("folds", 1);
+        if (shift_ == 0 || shift_ > 63) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: shift - must be between 1 and 63. You specified %" PRIu32 "\n", getName().c_str(), shift_);
+        }
+    }
+
+    uint64_t hash(uint32_t ID, uint64_t x) override {
+        uint64_t result = x;
+        for (uint32_t i = 1; i <= folds_ && (uint64_t)i * shift_ < 64; i++)
+            result ^= x >> (i * shift_);
+        return result;
+    }
+
+    XorFoldHashFunction() = default;
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        HashFunction::serialize_order(ser);
+        SST_SER(shift_);
+        SST_SER(folds_);
+    }
+    ImplementSerializable(SST::MemHierarchy::XorFoldHashFunction)
+
+private:
+    uint32_t shift_;
+    uint32_t folds_;
+};
+
 }}
 #endif
 /* HASH_H */
@@ -23,6 +23,7 @@
 #include "sst/elements/memHierarchy/memTypes.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
+#include "sst/elements/memHierarchy/sharerSet.h"
 
 using namespace std;
 
@@ -40,30 +41,45 @@ namespace SST { namespace MemHierarchy {
 
 
 
-/* Line which only holds coherence state - no data */
+/* Checkpoint a line's data only if the line is valid, invalid lines just keep their size */
+inline void serializeLineData(SST::Core::Serialization::serializer& ser, vector<uint8_t> &data, bool valid) {
+    size_t size = data.size();
+    SST_SER(size);
+    if (valid)
+        SST_SER(data);
+    else if (ser.mode() == SST::Core::Serialization::serializer::UNPACK)
+        data.resize(size);
+}
+
+/* Line which only holds coherence state - no data
+ * Sharers and owner are stored as IDs from a SharerIdMap shared by all
+ * lines in the array; the owning coherence manager sets it with setSharerIds() */
 class DirectoryLine {
     private:
         const unsigned int index_;
         Addr addr_;
         State state_;
-        std::set<std::string> sharers_;
-        std::string owner_;
+        SharerIdMap* ids_;
+        SharerSet sharers_;
+        int32_t owner_;
         uint64_t last_send_timestamp_;
         CoherenceReplacementInfo* info_;
         bool was_prefetch_;
 
     public:
-        DirectoryLine(uint32_t size, unsigned int index) : index_(index) {
+        DirectoryLine(uint32_t size, unsigned int index) : index_(index), ids_(nullptr) {
             info_ = new CoherenceReplacementInfo(index, I, false, false);
             reset();
         }
         ~DirectoryLine() = default;
 
+        void setSharerIds(SharerIdMap* ids) { ids_ = ids; }
+
         void reset() {
             addr_ = NO_ADDR;
             state_ = I;
             sharers_.clear();
-            owner_ = "";
+            owner_ = SharerIdMap::NO_ID;
             last_send_timestamp_ = 0;
             was_prefetch_ = false;
             info_->reset();
@@ -81,29 +97,48 @@ class DirectoryLine {
         void setState(State state) { state_ = state; }
 
         // Sharers
-        set<std::string>* getSharers() { return &sharers_; }
-        bool isSharer(std::string shr) {   return sharers_.find(shr) != sharers_.end(); }
+        /* Fill 'names' with the sharers' names in sorted order */
+        void getSharers(std::vector<std::string>& names) {
+            std::vector<uint32_t> ids;
+            sharers_.getIds(ids);
+            names.clear();
+            for (uint32_t id : ids)
+                names.push_back(ids_->getName(id));
+            std::sort(names.begin(), names.end());
+        }
+        /* Return the sharer whose name sorts first */
+        std::string getFirstSharer() {
+            std::vector<std::string> names;
+            getSharers(names);
+            return names.empty() ? "" : names.front();
+        }
+        bool isSharer(const std::string& shr) {
+            int32_t id = ids_->findId(shr);
+            return id != SharerIdMap::NO_ID && sharers_.contains(id);
+        }
         size_t numSharers() { return sharers_.size(); }
         bool hasSharers() { return !sharers_.empty(); }
-        bool hasOtherSharers(std::string shr) { return !(sharers_.empty() || (sharers_.size() == 1 && sharers_.find(shr) != sharers_.end())); }
-        void addSharer(std::string shr) {
-            sharers_.insert(shr);
+        bool hasOtherSharers(const std::string& shr) { return !(sharers_.empty() || (sharers_.size() == 1 && isSharer(shr))); }
+        void addSharer(const std::string& shr) {
+            sharers_.insert(ids_->getId(shr));
             info_->setShared(true);
         }
-        void removeSharer(std::string shr) {
-            sharers_.erase(shr);
+        void removeSharer(const std::string& shr) {
+            int32_t id = ids_->findId(shr);
+            if (id != SharerIdMap::NO_ID)
+                sharers_.erase(id);
             info_->setShared(!sharers_.empty());
         }
 
         // Owner
-        std::string getOwner() { return owner_; }
-        bool hasOwner() { return !owner_.empty(); }
-        void setOwner(std::string owner) {
-            owner_ = owner;
+        std::string getOwner() { return hasOwner() ? ids_->getName(owner_) : ""; }
+        bool hasOwner() { return owner_ != SharerIdMap::NO_ID; }
+        void setOwner(const std::string& owner) {
+            owner_ = owner.empty() ? SharerIdMap::NO_ID : (int32_t)ids_->getId(owner);
             info_->setOwned(true);
         }
         void removeOwner() {
-            owner_.clear();
+            owner_ = SharerIdMap::NO_ID;
             info_->setOwned(false);
         }
 
@@ -125,22 +160,24 @@ class DirectoryLine {
         // String-ify for debugging
         std::string getString() {
             std::ostringstream str;
-            str << "O: " << (owner_.empty() ? "-" : owner_);
+            str << "O: " << (hasOwner() ? getOwner() : "-");
             str << " S: [";
-            for (std::set<std::string>::iterator it = sharers_.begin(); it != sharers_.end(); it++) {
-                if (it != sharers_.begin()) str << ",";
+            std::vector<std::string> names;
+            getSharers(names);
+            for (std::vector<std::string>::iterator it = names.begin(); it != names.end(); it++) {
+                if (it != names.begin()) str << ",";
                 str << *it;
             }
             str << "]";
             return str.str();
         }
 
-        DirectoryLine() : index_(0) {}
+        DirectoryLine() : index_(0), ids_(nullptr) {}
         void serialize_order(SST::Core::Serialization::serializer& ser) {
             SST_SER(const_cast<unsigned int&>(index_));
             SST_SER(addr_);
             SST_SER(state_);
-            SST_SER(sharers_);
+            SST_SER(sharers_);      // ids_ is restored by the coherence manager
             SST_SER(owner_);
             SST_SER(last_send_timestamp_);
             SST_SER(info_);
@@ -205,8 +242,8 @@ class DataLine {
         void serialize_order(SST::Core::Serialization::serializer& ser) {
             SST_SER(const_cast<unsigned int&>(index_));
             SST_SER(addr_);
-            SST_SER(data_);
             SST_SER(tag_);
+            serializeLineData(ser, data_, tag_ != nullptr);
             SST_SER(info_);
         }
 };
@@ -283,7 +320,7 @@ class CacheLine : public SST::Core::Serialization::serializable {
             SST_SER(const_cast<unsigned int&>(index_));
             SST_SER(addr_);
             SST_SER(state_);
-            SST_SER(data_);
+            serializeLineData(ser, data_, state_ != I);
             SST_SER(lastSendTimestamp_);
             SST_SER(wasPrefetch_);
         }
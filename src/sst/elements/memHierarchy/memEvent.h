@@ -16,6 +16,7 @@
 #ifndef MEMHIERARCHY_MEMEVENT_H
 #define MEMHIERARCHY_MEMEVENT_H
 
+#include <algorithm>
 #include <utility>
 
 #include <sst/core/sst_types.h>
@@ -26,6 +27,7 @@
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memEventBase.h"
 #include "sst/elements/memHierarchy/memTypes.h"
+#include "sst/elements/memHierarchy/payload.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -57,7 +59,7 @@ public:
         size_ = size;
     }
     /* Constructor - Events that carry data */
-    MemEvent(std::string src, Addr addr, Addr baseAddr, Command cmd, std::vector<uint8_t>& data) : MemEventBase(src, cmd) {
+    MemEvent(std::string src, Addr addr, Addr baseAddr, Command cmd, const std::vector<uint8_t>& data) : MemEventBase(src, cmd) {
         initialize();
         addr_ = addr;
         baseAddr_ = baseAddr;
@@ -182,20 +184,26 @@ public:
     void setSuccess(bool b) { b ? clearFlag(MemEventBase::F_FAIL) : setFlag(MemEventBase::F_FAIL); }
     bool success() { return !queryFlag(MemEventBase::F_FAIL); }
 
-    /** @return  the data payload. */
+    /** @return  the data payload, for writing. If the payload is shared with
+     * another event, it is copied first. Use readPayload() to read only. */
     dataVec& getPayload(void) {
+        dataVec& payload = payload_.write();
         /* Lazily allocate space for payload */
-        if ( payload_.size() < size_ )  payload_.resize(size_);
-        return payload_;
+        if ( payload.size() < size_ )  payload.resize(size_);
+        return payload;
     }
 
+    /** @return  the data payload, read-only. Does not copy a shared payload. */
+    const dataVec& readPayload(void) const {
+        return payload_.read();
+    }
 
     /** Sets the data payload and payload size.
      * @param[in] data  Vector from which to copy data
      */
-    void setPayload(std::vector<uint8_t>& data) {
+    void setPayload(const std::vector<uint8_t>& data) {
         setSize(data.size());
-        payload_ = data;
+        payload_.assign(data);
     }
 
     /** Sets the data payload and payload size.
@@ -204,16 +212,24 @@ public:
      */
     void setPayload(uint32_t size, uint8_t* data) {
         setSize(size);
-        payload_.resize(size);
-        for ( uint32_t i = 0 ; i < size ; i++ ) {
-            payload_[i] = data[i];
-        }
+        if (size == 0)
+            payload_.clear();
+        else
+            payload_.assign(size, data);
+    }
+
+    /** Shares another event's payload and payload size without copying.
+     * The data is copied only if either event later writes to it.
+     * @param[in] ev  Event whose payload to share
+     */
+    void sharePayload(const MemEvent* ev) {
+        setSize(std::max<size_t>(ev->payload_.size(), ev->getSize()));
+        payload_ = ev->payload_;
     }
 
     void setZeroPayload(uint32_t size) {
         setSize(size);
-        payload_.clear();
-        payload_.resize(size, 0);
+        payload_.assign(size, (uint8_t)0);
     }
 
     size_t getPayloadSize() override {
@@ -255,10 +271,11 @@ public:
         if (payload_.empty() || level < 11)
             str << " Data: " << (payload_.empty() ? "F" : "T");
         else {
+            const dataVec& payload = payload_.read();
             std::stringstream value;
             value << std::hex << std::setfill('0');
-            for (unsigned int i = 0; i < payload_.size(); i++)
-                value << std::hex << std::setw(2) << (int)payload_[i];
+            for (unsigned int i = 0; i < payload.size(); i++)
+                value << std::hex << std::setw(2) << (int)payload[i];
             str << " Data: 0x" << value.str();
         }
         str << " VA: 0x" << vAddr_ << " IP: 0x" << instPtr_;
@@ -304,7 +321,7 @@ private:
     bool      addrGlobal_;        // Whether address is a local or global address
     MemEvent* NACKedEvent_;       // For a NACK, pointer to the NACKed event
     int       retries_;           // For NACKed events, how many times a retry has been sent
-    dataVec   payload_;           // Data
+    SharedPayload payload_;       // Data, shared copy-on-write between events
     bool      prefetch_;          // Whether this request came from a prefetcher
     bool      dirty_;             // For a replacement, whether the data is dirty or not
     bool      isEvict_;           // Whether an event is an eviction
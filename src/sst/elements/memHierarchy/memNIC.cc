@@ -53,8 +53,19 @@ MemNIC::MemNIC(ComponentId_t id, Params &params, TimeConverter* tc) : MemNICBase
     // Packet size
     packetHeaderBytes = extractPacketHeaderSize(params, "min_packet_size");
 
+    // Batching
+    batchWindow = params.find<uint32_t>("batch_window", 0);
+    batchMaxEvents = params.find<uint32_t>("batch_max_events", 8);
+    batchMaxPayload = extractPacketHeaderSize(params, "batch_max_payload", "0B");
+    batchMessageBytes = params.contains("batch_message_size") ? extractPacketHeaderSize(params, "batch_message_size") : packetHeaderBytes;
+    if (batchWindow != 0 && batchMaxEvents < 2) {
+        dbg.fatal(CALL_INFO, -1, "%s, Invalid param: batch_max_events - must be at least 2 when batching is enabled. You specified %" PRIu32 "\n",
+                getName().c_str(), batchMaxEvents);
+    }
+
     clockHandler = new Clock::Handler2<MemNIC, &MemNIC::clock>(this);
     clockTC = registerClock(*tc, clockHandler);
+    clockOn = true;
 }
 
 void MemNIC::init(unsigned int phase) {
@@ -72,11 +83,30 @@ void MemNIC::complete(unsigned int phase) {
  * Returns whether anything sent this cycle
  */
 bool MemNIC::clock(SimTime_t cycle) {
+    /* Send batches whose window has closed */
+    std::map<uint64_t, SendBatch>::iterator it = sendBatches.begin();
+    while (it != sendBatches.end()) {
+        if (--(it->second.cyclesLeft) == 0)
+            sendBatch(it++);
+        else
+            it++;
+    }
+
     drainQueue(&sendQueue, link_control);
-    if (sendQueue.empty()) return true; /* turn off clock */
+    if (sendQueue.empty() && sendBatches.empty()) { /* turn off clock */
+        clockOn = false;
+        return true;
+    }
     return false;
 }
 
+void MemNIC::enableClock() {
+    if (!clockOn) {
+        reregisterClock(clockTC, clockHandler);
+        clockOn = true;
+    }
+}
+
 /*
  * Event handler called by link control on event receive
  * Return whether event can be received
@@ -84,26 +114,49 @@ bool MemNIC::clock(SimTime_t cycle) {
 bool MemNIC::recvNotify(int) {
     MemRtrEvent * mre = doRecv(link_control);
     if (mre) {
-        MemEventBase* ev = mre->takeEvent();
-        delete mre;
-        if (ev) {
-            if (mem_h_is_debug_event(ev)) {
-                dbg.debug(_L5_, "E: %-40" PRIu64 "  %-20s NIC:Recv      (%s)\n",
-                    getCurrentSimCycle(), getName().c_str(), ev->getBriefString().c_str());
-            }
-            (*recvHandler)(ev);
+        if (mre->isBatch()) {
+            std::vector<MemEventBase*> events;
+            static_cast<MemRtrBatchEvent*>(mre)->takeEvents(events);
+            delete mre;
+            for (MemEventBase* ev : events)
+                deliver(ev);
+        } else {
+            MemEventBase* ev = mre->takeEvent();
+            delete mre;
+            if (ev)
+                deliver(ev);
         }
     }
     return true;
 }
 
+void MemNIC::deliver(MemEventBase* ev) {
+    if (mem_h_is_debug_event(ev)) {
+        dbg.debug(_L5_, "E: %-40" PRIu64 "  %-20s NIC:Recv      (%s)\n",
+            getCurrentSimCycle(), getName().c_str(), ev->getBriefString().c_str());
+    }
+    (*recvHandler)(ev);
+}
+
 
 /* Send event to memNIC */
 void MemNIC::send(MemEventBase *ev) {
+    uint64_t dest = lookupNetworkAddress(ev->getDst());
+
+    if (batchWindow != 0 && ev->getPayloadSize() <= batchMaxPayload) {
+        batchEvent(ev, dest);
+        return;
+    }
+
+    /* Keep messages to a destination in order */
+    std::map<uint64_t, SendBatch>::iterator it = sendBatches.find(dest);
+    if (it != sendBatches.end())
+        sendBatch(it);
+
     SimpleNetwork::Request *req = new SimpleNetwork::Request();
     MemRtrEvent * mre = new MemRtrEvent(ev);
     req->src = info.addr;
-    req->dest = lookupNetworkAddress(ev->getDst());
+    req->dest = dest;
     req->size_in_bits = getSizeInBits(ev);
     req->vn = 0;
 
@@ -113,12 +166,60 @@ void MemNIC::send(MemEventBase *ev) {
     }
 
     req->givePayload(mre);
+    enqueue(req);
+}
+
+void MemNIC::enqueue(SimpleNetwork::Request* req) {
     sendQueue.push(req);
-    //printf("%s, %" PRIu64 ", Receive %s, 0x%" PRIx64 "\n", getName().c_str(), getCurrentSimTime("1ps"), CommandString[(int)ev->getCmd()], ev->getRoutingAddress() );
     if (sendQueue.size() == 1)
         drainQueue(&sendQueue, link_control);
-    if (sendQueue.size() == 1) /* Attempt again in 1 cycle */
-        reregisterClock(clockTC, clockHandler);
+    if (!sendQueue.empty()) /* Attempt again in 1 cycle */
+        enableClock();
+}
+
+/* Add an event to the open batch for its destination, opening one if needed */
+void MemNIC::batchEvent(MemEventBase* ev, uint64_t dest) {
+    std::map<uint64_t, SendBatch>::iterator it = sendBatches.find(dest);
+    if (it == sendBatches.end()) {
+        SendBatch batch = { new MemRtrBatchEvent(), 8 * packetHeaderBytes, batchWindow };
+        it = sendBatches.insert(std::make_pair(dest, batch)).first;
+    } else {
+        it->second.bits += 8 * batchMessageBytes;
+    }
+    it->second.bits += 8 * ev->getPayloadSize();
+    it->second.batch->addEvent(ev);
+
+    if (mem_h_is_debug_event(ev)) {
+        dbg.debug(_L5_, "N: %-40" PRI_NID "  %-20s Batch         Dst: %" PRI_NID ", count: %zu, (%s)\n",
+            getCurrentSimCycle(), getName().c_str(), dest, it->second.batch->size(), ev->getBriefString().c_str());
+    }
+
+    if (it->second.batch->size() >= batchMaxEvents)
+        sendBatch(it);
+    else
+        enableClock();
+}
+
+/* Move a batch to the send queue. A batch of one is sent as a regular event. */
+void MemNIC::sendBatch(std::map<uint64_t, SendBatch>::iterator it) {
+    SimpleNetwork::Request *req = new SimpleNetwork::Request();
+    req->src = info.addr;
+    req->dest = it->first;
+    req->vn = 0;
+
+    MemRtrBatchEvent* batch = it->second.batch;
+    if (batch->size() == 1) {
+        std::vector<MemEventBase*> events;
+        batch->takeEvents(events);
+        delete batch;
+        req->size_in_bits = getSizeInBits(events.front());
+        req->givePayload(new MemRtrEvent(events.front()));
+    } else {
+        req->size_in_bits = it->second.bits;
+        req->givePayload(batch);
+    }
+    sendBatches.erase(it);
+    enqueue(req);
 }
 
 
@@ -142,12 +243,22 @@ void MemNIC::printStatus(Output &out) {
     // Since this is just debug/fatal we're just going to read out the queue & re-populate it
     std::queue<SST::Interfaces::SimpleNetwork::Request*> tmpQ;
     while (!sendQueue.empty()) {
-        MemEventBase * ev = static_cast<MemRtrEvent*>(sendQueue.front()->inspectPayload())->inspectEvent();
-        out.output("      %s\n", ev->getVerboseString(out.getVerboseLevel()).c_str());
+        MemRtrEvent * mre = static_cast<MemRtrEvent*>(sendQueue.front()->inspectPayload());
+        if (mre->isBatch()) {
+            for (MemEventBase* ev : static_cast<MemRtrBatchEvent*>(mre)->inspectEvents())
+                out.output("      (batch) %s\n", ev->getVerboseString(out.getVerboseLevel()).c_str());
+        } else {
+            out.output("      %s\n", mre->inspectEvent()->getVerboseString(out.getVerboseLevel()).c_str());
+        }
         tmpQ.push(sendQueue.front());
         sendQueue.pop();
     }
     tmpQ.swap(sendQueue);
+    for (std::map<uint64_t, SendBatch>::iterator it = sendBatches.begin(); it != sendBatches.end(); it++) {
+        out.output("    Open batch to %" PRIu64 " (%zu entries):\n", it->first, it->second.batch->size());
+        for (MemEventBase* ev : it->second.batch->inspectEvents())
+            out.output("      %s\n", ev->getVerboseString(out.getVerboseLevel()).c_str());
+    }
     out.output("    Link status: \n");
     link_control->printStatus(out);
     out.output("  End MemHierarchy::MemNIC\n");
@@ -157,9 +268,14 @@ void MemNIC::emergencyShutdownDebug(Output &out) {
     out.output(" Draining link control...\n");
     MemRtrEvent * mre = doRecv(link_control);
     while (mre != nullptr) {
-        MemEventBase * ev = mre->takeEvent();
+        std::vector<MemEventBase*> events;
+        if (mre->isBatch()) {
+            static_cast<MemRtrBatchEvent*>(mre)->takeEvents(events);
+        } else if (MemEventBase * ev = mre->takeEvent()) {
+            events.push_back(ev);
+        }
         delete mre;
-        if (ev) {
+        for (MemEventBase* ev : events) {
             out.output("      Undelivered message: %s\n", ev->getVerboseString(out.getVerboseLevel()).c_str());
         }
         mre = doRecv(link_control);
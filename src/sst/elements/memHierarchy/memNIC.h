@@ -18,6 +18,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <map>
 #include <queue>
 
 #include <sst/core/event.h>
@@ -54,7 +55,11 @@ public:
         { "network_input_buffer_size",   "(string) Size of input buffer. Not used if linkcontrol subcomponent slot is filled", "1KiB"},\
         { "network_output_buffer_size",  "(string) Size of output buffer. Not used if linkcontrol subcomponent slot is filled.", "1KiB"},\
         { "port",                        "Deprecated. Used by parent component if the NIC is not loaded as a named subcomponent.", ""}, \
-        { "network_link_control",        "Deprecated. Specify link control type by using named subcomponents", "merlin.linkcontrol" }
+        { "network_link_control",        "Deprecated. Specify link control type by using named subcomponents", "merlin.linkcontrol" },\
+        { "batch_window",                "(uint) Number of cycles to hold small messages for the same destination so that they share one network packet. 0 disables batching.", "0"},\
+        { "batch_max_events",            "(uint) Maximum number of messages in one batched packet. A full batch is sent immediately.", "8"},\
+        { "batch_max_payload",           "(string) Messages with a data payload larger than this are never batched", "0B"},\
+        { "batch_message_size",          "(string) Bytes added to a batched packet for each message after the first. Defaults to min_packet_size so that batching does not change the bytes sent.", "min_packet_size"}
 
 
     SST_ELI_REGISTER_SUBCOMPONENT(MemNIC, "memHierarchy", "MemNIC", SST_ELI_ELEMENT_VERSION(1,0,0),
@@ -87,6 +92,9 @@ public:
 
     /* Helper functions */
     size_t getSizeInBits(MemEventBase * ev);
+    void enqueue(SST::Interfaces::SimpleNetwork::Request* req);
+    void enableClock();
+    void deliver(MemEventBase* ev);
 
     /* Initialization and finish */
     void init(unsigned int phase) override;
@@ -104,6 +112,21 @@ private:
     // Other parameters
     size_t packetHeaderBytes;
 
+    // Batching
+    struct SendBatch {
+        MemRtrBatchEvent* batch;
+        size_t bits;            // Network size of the batched packet
+        uint32_t cyclesLeft;    // Until the batch is sent
+    };
+    uint32_t batchWindow;
+    uint32_t batchMaxEvents;
+    size_t batchMaxPayload;
+    size_t batchMessageBytes;
+    std::map<uint64_t, SendBatch> sendBatches; // Open batch for each network destination
+
+    void batchEvent(MemEventBase* ev, uint64_t dest);
+    void sendBatch(std::map<uint64_t, SendBatch>::iterator it);
+
     // Handlers and network
     SST::Interfaces::SimpleNetwork *link_control;
 
@@ -113,6 +136,7 @@ private:
     // Clocks
     Clock::HandlerBase* clockHandler;
     TimeConverter clockTC;
+    bool clockOn;
 };
 
 } //namespace memHierarchy
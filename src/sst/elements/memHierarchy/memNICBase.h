@@ -92,6 +92,8 @@ class MemNICBase : public MemLinkBase {
 
                 virtual bool hasClientData() const { return true; }
 
+                virtual bool isBatch() const { return false; }
+
                 virtual std::string toString() const override {
                     return event->toString();
                 }
@@ -104,6 +106,55 @@ class MemNICBase : public MemLinkBase {
                 ImplementSerializable(SST::MemHierarchy::MemNICBase::MemRtrEvent);
         };
 
+        /* Several events for the same destination packed into one network packet */
+        class MemRtrBatchEvent : public MemRtrEvent {
+            public:
+                MemRtrBatchEvent() : MemRtrEvent() { }
+                ~MemRtrBatchEvent() {
+                    for (MemEventBase* ev : events)
+                        delete ev;
+                }
+
+                virtual Event* clone(void) override {
+                    MemRtrBatchEvent * mrbe = new MemRtrBatchEvent();
+                    for (MemEventBase* ev : events)
+                        mrbe->events.push_back(ev->clone());
+                    return mrbe;
+                }
+
+                void addEvent(MemEventBase* ev) { events.push_back(ev); }
+
+                size_t size() const { return events.size(); }
+
+                /* Remove the events from the batch, in the order they were added */
+                void takeEvents(std::vector<MemEventBase*>& evs) {
+                    evs.swap(events);
+                    events.clear();
+                }
+
+                const std::vector<MemEventBase*>& inspectEvents() const { return events; }
+
+                virtual bool isBatch() const override { return true; }
+
+                virtual std::string toString() const override {
+                    std::ostringstream str;
+                    str << "Batch (" << events.size() << " events)";
+                    for (MemEventBase* ev : events)
+                        str << "; " << ev->toString();
+                    return str.str();
+                }
+
+                void serialize_order(SST::Core::Serialization::serializer &ser) override {
+                    MemRtrEvent::serialize_order(ser);
+                    SST_SER(events);
+                }
+
+                ImplementSerializable(SST::MemHierarchy::MemNICBase::MemRtrBatchEvent);
+
+            private:
+                std::vector<MemEventBase*> events;
+        };
+
         class InitMemRtrEvent : public MemRtrEvent {
             public:
                 EndpointInfo info;
@@ -560,7 +611,8 @@ class MemNICBase : public MemLinkBase {
             while (!(queue->empty())) {
                 SST::Interfaces::SimpleNetwork::Request* head = queue->front();
 #ifdef __SST_DEBUG_OUTPUT__
-                MemEventBase* ev = (static_cast<MemRtrEvent*>(head->inspectPayload()))->inspectEvent();
+                MemRtrEvent* mre = static_cast<MemRtrEvent*>(head->inspectPayload());
+                MemEventBase* ev = mre->isBatch() ? static_cast<MemRtrBatchEvent*>(mre)->inspectEvents().front() : mre->inspectEvent();
                 std::string debugEvStr = ev ? ev->getBriefString() : "";
                 uint64_t dst = head->dest;
                 bool doDebug = ev ? mem_h_is_debug_event(ev) : false;
@@ -19,6 +19,7 @@
 #include <sst/core/sst_types.h>
 #include <limits>
 #include <numeric>
+#include <vector>
 
 #include <sst/core/eli/elibase.h>   // For ElementInfoStatistic
 #include <sst/core/serialization/serializable.h> // For serializable MemRegion
@@ -242,6 +243,8 @@ public:
     SST::MemHierarchy::Addr end;               // Last address that is part of the region
     SST::MemHierarchy::Addr interleaveSize;    // Size of each interleaved chunk
     SST::MemHierarchy::Addr interleaveStep;    // Distance between the start of each interleaved chunk
+    std::vector<SST::MemHierarchy::Addr> sliceMasks; // If not empty, addresses are hashed to slices and bit i of an address's slice is the parity of (addr & sliceMasks[i])
+    uint32_t sliceId = 0;                           // Slice that this region holds when sliceMasks is not empty
     static const SST::MemHierarchy::Addr REGION_MAX = std::numeric_limits<SST::MemHierarchy::Addr>::max();
 
     void setDefault() {
@@ -249,6 +252,7 @@ public:
         interleaveSize = 0;
         interleaveStep = 0;
         end = REGION_MAX;
+        clearSlice();
     }
 
     void setEmpty() {
@@ -256,10 +260,24 @@ public:
         interleaveSize = 0;
         interleaveStep = 0;
         end = 0;
+        clearSlice();
+    }
+
+    void clearSlice() {
+        sliceMasks.clear();
+        sliceId = 0;
+    }
+
+    uint32_t sliceOf(uint64_t addr) const {
+        uint32_t slice = 0;
+        for (size_t i = 0; i < sliceMasks.size(); i++)
+            slice |= (uint32_t)(__builtin_popcountll(addr & sliceMasks[i]) & 1) << i;
+        return slice;
     }
 
     bool contains(uint64_t addr) const {
         if (addr >= start && addr <= end) {
+            if (!sliceMasks.empty() && sliceOf(addr) != sliceId) return false;
             if (interleaveSize == 0) return true;
             SST::MemHierarchy::Addr offset = (addr - start) % interleaveStep;
             return (offset < interleaveSize);
@@ -297,6 +315,28 @@ public:
             return regions; // Empty
         }
 
+        // Hashed slices: intersect the unhashed regions and then apply the hash.
+        // Slices of the same hash are disjoint. If both are hashed differently,
+        // this region's hash is kept, which may overestimate the intersection.
+        if (!sliceMasks.empty() || !o.sliceMasks.empty()) {
+            if (sliceMasks == o.sliceMasks && sliceId != o.sliceId) {
+                intersect_cache_.insert(std::make_pair(cache_key, regions));
+                return regions;
+            }
+            MemRegion base = *this;
+            MemRegion obase = o;
+            base.clearSlice();
+            obase.clearSlice();
+            const MemRegion &hashed = sliceMasks.empty() ? o : *this;
+            for (MemRegion reg : base.intersect(obase)) {
+                reg.sliceMasks = hashed.sliceMasks;
+                reg.sliceId = hashed.sliceId;
+                regions.insert(reg);
+            }
+            intersect_cache_.insert(std::make_pair(cache_key, regions));
+            return regions;
+        }
+
         // Easy case, they're equal
         if (*this == o) {
             regions.insert(*this);
@@ -414,6 +454,17 @@ public:
             return true;
         }
 
+        // Hashed slices: same hash and different slices never intersect, otherwise check the unhashed regions
+        if (!sliceMasks.empty() || !o.sliceMasks.empty()) {
+            if (sliceMasks == o.sliceMasks && sliceId != o.sliceId)
+                return false;
+            MemRegion base = *this;
+            MemRegion obase = o;
+            base.clearSlice();
+            obase.clearSlice();
+            return base.doesIntersect(obase);
+        }
+
         // No interleaving
         if (interleaveStep == 0 && o.interleaveStep == 0) {
             return true;
@@ -450,6 +501,7 @@ public:
         // else return false
         if ( o.interleaveStep != interleaveStep ) return false;
         if ( o.end != end ) return false;
+        if ( o.sliceMasks != sliceMasks || o.sliceId != sliceId ) return false;
 
         if ( o.start == (start + interleaveSize) || start == (o.start + o.interleaveSize) ) {
             // Mergeable
@@ -466,11 +518,16 @@ public:
             return (start < o.start);
         if (end != o.end)
             return (end < o.end);
-        return (interleaveSize * o.interleaveStep) < (interleaveStep * o.interleaveSize);
+        if ((interleaveSize * o.interleaveStep) != (interleaveStep * o.interleaveSize))
+            return (interleaveSize * o.interleaveStep) < (interleaveStep * o.interleaveSize);
+        if (sliceMasks != o.sliceMasks)
+            return (sliceMasks < o.sliceMasks);
+        return (sliceId < o.sliceId);
     }
 
     bool operator==(const MemRegion &o) const {
-        return (start == o.start && end == o.end && interleaveSize == o.interleaveSize && interleaveStep == o.interleaveStep);
+        return (start == o.start && end == o.end && interleaveSize == o.interleaveSize && interleaveStep == o.interleaveStep &&
+                sliceMasks == o.sliceMasks && sliceId == o.sliceId);
     }
 
     bool operator!=(const MemRegion &o) const {
@@ -484,6 +541,12 @@ public:
         str << std::noshowbase << dec;
         str << " InterleaveSize: " << interleaveSize;
         str << " InterleaveStep: " << interleaveStep;
+        if (!sliceMasks.empty()) {
+            str << " Slice: " << sliceId << " SliceMasks:" << std::showbase << hex;
+            for (size_t i = 0; i < sliceMasks.size(); i++)
+                str << " " << sliceMasks[i];
+            str << std::noshowbase << dec;
+        }
         return str.str();
     }
 
@@ -493,6 +556,8 @@ public:
         SST_SER(end);
         SST_SER(interleaveSize);
         SST_SER(interleaveStep);
+        SST_SER(sliceMasks);
+        SST_SER(sliceId);
         // Thread local vars are *only* used during setup and are only for performance - do not need to be saved
     }
 };
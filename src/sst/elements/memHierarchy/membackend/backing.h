@@ -19,6 +19,11 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/mman.h>
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <sst/core/serialization/serializable.h>
 #include <sst/core/util/filesystem.h>
 #include "sst/elements/memHierarchy/util.h"
@@ -261,12 +266,18 @@ private:
 };
 
 /*
+ * Sparse backing store. Memory is tracked in pages of 'alloc_unit_' bytes
+ * that are allocated on first touch. Pages are carved out of large
+ * anonymous mmap'd arena chunks (optionally backed by transparent huge
+ * pages) and looked up through a hashed page table, with the most recently
+ * used page cached since accesses are usually clustered.
+ *
  * Throws:
  * 1: Unable to open infile
  */
 class BackingMalloc : public Backing {
 public:
-    BackingMalloc( size_t size, bool init = false ) : init_(init) {
+    BackingMalloc( size_t size, bool init = false, bool huge_pages = false ) : init_(init), huge_pages_(huge_pages) {
         alloc_unit_ = size;
         /* Alloc unit needs to be pwr-2 */
         if (!isPowerOfTwo(alloc_unit_)) {
@@ -274,9 +285,10 @@ public:
             out.fatal(CALL_INFO, -1, "BackingMalloc, ERROR: Size must be a power of two. Got: %zu.\n", size);
         }
         shift_ = log2Of(alloc_unit_);
+        setChunkSize();
     }
 
-    BackingMalloc( std::string infile ) {
+    BackingMalloc( std::string infile, bool huge_pages = false ) : huge_pages_(huge_pages) {
         auto fp = fopen(infile.c_str(),"rb");
         if (!fp) throw 1;
 
@@ -285,71 +297,71 @@ public:
         (void) !fread(&alloc_unit_, sizeof(unsigned int), 1, fp);
         (void) !fread(&shift_, sizeof(unsigned int), 1, fp);
         (void) !fread(&init_, sizeof(bool), 1, fp);
+        setChunkSize();
+        buffer_.reserve(buffer_size);
         Addr addr;
         for ( size_t i = 0; i < buffer_size; i++ ) {
-            auto buf = (uint8_t*) malloc( alloc_unit_);
             (void) !fread(&addr, sizeof(addr), 1, fp);
-            (void) !fread(buf, sizeof(uint8_t), alloc_unit_, fp);
-            buffer_[addr] = buf;
+            (void) !fread(getPage(addr), sizeof(uint8_t), alloc_unit_, fp);
         }
+        fclose(fp);
+    }
+
+    ~BackingMalloc() {
+        for (uint8_t* chunk : chunks_)
+            munmap(chunk, chunk_size_);
+        if (store_fp_)
+            fclose(store_fp_);
+    }
+
+    /* Checkpoint pages to an append-only page store instead of into the checkpoint.
+     * Each checkpoint appends only the pages written since the previous one and
+     * records where each page's latest contents are. The store must be kept
+     * alongside the checkpoints. */
+    void setCheckpointStore( std::string path ) {
+        store_path_ = path;
+        track_dirty_ = !store_path_.empty();
+        for (Addr page : page_order_)
+            dirty_.insert(page);
     }
 
     void set( Addr addr, uint8_t value ) override {
         Addr bAddr = addr >> shift_;
         Addr offset = addr - (bAddr << shift_);
-        allocIfNeeded(bAddr);
-        buffer_[bAddr][offset] = value;
+        getPage(bAddr)[offset] = value;
+        if (track_dirty_) markDirty(bAddr);
     }
 
     void set( Addr addr, size_t size, std::vector<uint8_t> &data ) override {
         /* Account for size exceeding alloc unit size */
-        Addr bAddr = addr >> shift_;
-        Addr offset = addr - (bAddr << shift_);
         size_t dataOffset = 0;
-
-        allocIfNeeded(bAddr);
-
         while (dataOffset != size) {
-            buffer_[bAddr][offset] = data[dataOffset];
-            offset++;
-            dataOffset++;
-
-            if (offset == alloc_unit_) {
-                offset = 0;
-                bAddr++;
-                allocIfNeeded(bAddr);
-            }
+            Addr bAddr = (addr + dataOffset) >> shift_;
+            Addr offset = (addr + dataOffset) - (bAddr << shift_);
+            size_t count = std::min(size - dataOffset, (size_t)(alloc_unit_ - offset));
+            memcpy(getPage(bAddr) + offset, data.data() + dataOffset, count);
+            if (track_dirty_) markDirty(bAddr);
+            dataOffset += count;
         }
     }
 
     void get( Addr addr, size_t size, std::vector<uint8_t> &data ) override {
-        Addr bAddr = addr >> shift_;
-        Addr offset = addr - (bAddr << shift_);
-        size_t dataOffset = 0;
-
-        allocIfNeeded(bAddr);
         assert( data.size() == size );
 
-        assert( buffer_.find(bAddr) != buffer_.end() );
-        auto buf = buffer_[bAddr];
+        size_t dataOffset = 0;
         while (dataOffset != size) {
-
-            data[dataOffset] = buf[offset];
-            offset++;
-            dataOffset++;
-            if (offset == alloc_unit_) {
-                bAddr++;
-                offset = 0;
-                allocIfNeeded(bAddr);
-            }
+            Addr bAddr = (addr + dataOffset) >> shift_;
+            Addr offset = (addr + dataOffset) - (bAddr << shift_);
+            size_t count = std::min(size - dataOffset, (size_t)(alloc_unit_ - offset));
+            memcpy(data.data() + dataOffset, getPage(bAddr) + offset, count);
+            dataOffset += count;
         }
     }
 
     uint8_t get( Addr addr ) override {
         Addr bAddr = addr >> shift_;
         Addr offset = addr - (bAddr << shift_);
-        allocIfNeeded(bAddr);
-        return buffer_[bAddr][offset];
+        return getPage(bAddr)[offset];
     }
 
 
@@ -362,10 +374,11 @@ public:
         fwrite(&shift_, sizeof(shift_), 1, fp);
         fwrite(&init_, sizeof(init_), 1, fp);
 
-        for ( auto const& x : buffer_ ) {
-            fwrite(&(x.first), sizeof(Addr), 1, fp);
-            fwrite(x.second, sizeof(uint8_t), alloc_unit_, fp);
+        for ( Addr page : getSortedPages() ) {
+            fwrite(&page, sizeof(Addr), 1, fp);
+            fwrite(buffer_[page], sizeof(uint8_t), alloc_unit_, fp);
         }
+        fclose(fp);
     }
 
     void printToScreen(Addr addr_offset, Addr addr_start, Addr addr_interleave_size, Addr addr_interleave_step) override {
@@ -380,9 +393,9 @@ public:
         Addr output_unit = (alloc_unit_ % 64 == 0) ? 64 : (alloc_unit_ % 32 == 0) ? 32 : alloc_unit_;
         Addr units_per_buffer = alloc_unit_ / output_unit;
 
-        for ( auto const& x : buffer_ ) {
-            Addr local_addr = x.first << shift_;
-            uint8_t* value_ptr = x.second;
+        for ( Addr page : getSortedPages() ) {
+            Addr local_addr = page << shift_;
+            uint8_t* value_ptr = buffer_[page];
             for (Addr line = 0; line < units_per_buffer; line++) {
                 Addr global_addr = local_addr - addr_offset;
                 if (addr_interleave_size == 0) {
@@ -417,31 +430,60 @@ public:
         SST_SER(alloc_unit_);
         SST_SER(shift_);
         SST_SER(init_);
-
-        // Manually serialize buffer_ because the uint8_t* array isn't automatically serializable
+        SST_SER(huge_pages_);
+        SST_SER(page_order_);
+        SST_SER(store_path_);
+
+        // Pages are laid out in arena chunks in allocation order (page_order_).
+        // Zero pages are skipped, a page identical to an earlier one refers to it,
+        // and only the non-zero blocks of the remaining pages are stored.
+        // With a page store, only where each page lives is checkpointed.
         switch (ser.mode()) {
         case SST::Core::Serialization::serializer::SIZER:
         case SST::Core::Serialization::serializer::PACK:
-            SST_SER(buffer_.size());
-            for ( auto& x : buffer_ ) { // Serialize each key/value pair
-                Addr key = x.first;
-                uint8_t* value = x.second;
-                SST_SER(key);
-                SST_SER(SST::Core::Serialization::array(value, alloc_unit_));
+            if (!store_path_.empty()) {
+                appendDirtyPages();
+                SST_SER(store_offset_);
+            } else {
+                std::vector<uint64_t> refs;
+                std::vector<uint64_t> masks;
+                encodePages(refs, masks);
+                SST_SER(refs);
+                SST_SER(masks);
+                size_t literal = 0;
+                for (size_t i = 0; i < refs.size(); i++) {
+                    if (refs[i] == PAGE_LITERAL)
+                        serializeBlocks(ser, pageAt(i), masks[literal++]);
+                }
             }
             break;
         case SST::Core::Serialization::serializer::UNPACK:
-            size_t buffer_size;
-            Addr key;
-
-            SST_SER(buffer_size);
-            for ( size_t i = 0; i < buffer_size; i++ ) {
-                uint8_t* value = (uint8_t*) malloc(sizeof(uint8_t)*alloc_unit_);
-                SST_SER(key);
-                SST_SER(SST::Core::Serialization::array(value, alloc_unit_));
-                buffer_[key] = value;
+        {
+            setChunkSize();
+            std::vector<Addr> pages;
+            pages.swap(page_order_);
+            buffer_.reserve(pages.size());
+            for (Addr page : pages)
+                getPage(page);
+            track_dirty_ = !store_path_.empty();
+            if (track_dirty_) {
+                SST_SER(store_offset_);
+                readStore();
+            } else {
+                std::vector<uint64_t> refs;
+                std::vector<uint64_t> masks;
+                SST_SER(refs);
+                SST_SER(masks);
+                size_t literal = 0;
+                for (size_t i = 0; i < refs.size(); i++) {
+                    if (refs[i] == PAGE_LITERAL)
+                        serializeBlocks(ser, pageAt(i), masks[literal++]);
+                    else if (refs[i] != PAGE_ZERO)
+                        memcpy(pageAt(i), pageAt(refs[i] - PAGE_DUPLICATE), alloc_unit_);
+                }
             }
             break;
+        }
         case SST::Core::Serialization::serializer::MAP:
             break; // Nothing to do
         }
@@ -450,24 +492,239 @@ public:
     ImplementSerializable(SST::MemHierarchy::Backend::BackingMalloc)
 
 private:
-    void allocIfNeeded( Addr bAddr ) {
-        if (buffer_.find(bAddr) == buffer_.end()) {
-            uint8_t* data = (uint8_t*) malloc(sizeof(uint8_t)*alloc_unit_);
-            if ( init_ ) {
-                bzero( data, alloc_unit_ );
+    static constexpr size_t ARENA_CHUNK_SIZE = 64 * 1024 * 1024;    // Pages per chunk = ARENA_CHUNK_SIZE / alloc_unit_
+
+    void setChunkSize() {
+        chunk_size_ = std::max((size_t)alloc_unit_, ARENA_CHUNK_SIZE);
+        chunk_used_ = chunk_size_;  // Forces a chunk on the first allocation
+        last_page_ = 0;
+        last_buf_ = nullptr;
+    }
+
+    /* Return the storage for page 'bAddr', allocating it on first touch */
+    uint8_t* getPage( Addr bAddr ) {
+        if (last_buf_ && bAddr == last_page_)
+            return last_buf_;
+
+        uint8_t* buf;
+        auto it = buffer_.find(bAddr);
+        if (it == buffer_.end()) {
+            buf = allocPage();
+            buffer_.emplace(bAddr, buf);
+            page_order_.push_back(bAddr);
+        } else {
+            buf = it->second;
+        }
+        last_page_ = bAddr;
+        last_buf_ = buf;
+        return buf;
+    }
+
+    uint8_t* allocPage() {
+        if (chunk_used_ == chunk_size_) {
+            // Anonymous mappings are zero-filled and only consume memory once touched
+            void* chunk = mmap(NULL, chunk_size_, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON, -1, 0);
+            if (chunk == MAP_FAILED) {
+                Output out("", 1, 0, Output::STDOUT);
+                out.fatal(CALL_INFO, -1, "BackingMalloc: Error - unable to allocate a %zu byte arena chunk: %s.\n", chunk_size_, strerror(errno));
+            }
+#ifdef MADV_HUGEPAGE
+            if (huge_pages_)
+                madvise(chunk, chunk_size_, MADV_HUGEPAGE);
+#endif
+            chunks_.push_back((uint8_t*)chunk);
+            chunk_used_ = 0;
+        }
+        uint8_t* page = chunks_.back() + chunk_used_;
+        chunk_used_ += alloc_unit_;
+        return page;
+    }
+
+    size_t chunkBytesUsed( size_t index ) {
+        return (index + 1 == chunks_.size()) ? chunk_used_ : chunk_size_;
+    }
+
+    /* Checkpoint encoding: page references and block masks */
+    static constexpr uint64_t PAGE_ZERO = 0;
+    static constexpr uint64_t PAGE_LITERAL = 1;
+    static constexpr uint64_t PAGE_DUPLICATE = 2;   // PAGE_DUPLICATE + index of the earlier page
+
+    uint8_t* pageAt( size_t index ) {
+        size_t offset = index * alloc_unit_;
+        return chunks_[offset / chunk_size_] + (offset % chunk_size_);
+    }
+
+    size_t blockSize() const { return alloc_unit_ < 64 ? 1 : alloc_unit_ / 64; }
+
+    static bool isZero( const uint8_t* data, size_t size ) {
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+            uint64_t word;
+            memcpy(&word, data + i, sizeof(word));
+            if (word) return false;
+        }
+        for (; i < size; i++)
+            if (data[i]) return false;
+        return true;
+    }
+
+    /* Bit b is set if block b of the page holds a non-zero byte */
+    uint64_t blockMask( const uint8_t* page ) const {
+        size_t bsize = blockSize();
+        uint64_t mask = 0;
+        for (size_t b = 0; b * bsize < alloc_unit_; b++) {
+            if (!isZero(page + b * bsize, bsize))
+                mask |= ((uint64_t)1 << b);
+        }
+        return mask;
+    }
+
+    static uint64_t hashPage( const uint8_t* page, size_t size ) {
+        uint64_t hash = 14695981039346656037ULL; // FNV-1a
+        for (size_t i = 0; i < size; i++) {
+            hash ^= page[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    void encodePages( std::vector<uint64_t> &refs, std::vector<uint64_t> &masks ) {
+        std::unordered_map<uint64_t, std::vector<size_t> > seen; // Content hash -> literal pages
+        refs.resize(page_order_.size());
+        for (size_t i = 0; i < page_order_.size(); i++) {
+            uint8_t* page = pageAt(i);
+            uint64_t mask = blockMask(page);
+            if (mask == 0) {
+                refs[i] = PAGE_ZERO;
+                continue;
+            }
+            refs[i] = PAGE_LITERAL;
+            std::vector<size_t> &same = seen[hashPage(page, alloc_unit_)];
+            for (size_t j : same) {
+                if (memcmp(page, pageAt(j), alloc_unit_) == 0) {
+                    refs[i] = PAGE_DUPLICATE + j;
+                    break;
+                }
             }
-            if (!data) {
+            if (refs[i] == PAGE_LITERAL) {
+                same.push_back(i);
+                masks.push_back(mask);
+            }
+        }
+    }
+
+    /* Serialize each run of non-zero blocks as one array */
+    void serializeBlocks( SST::Core::Serialization::serializer& ser, uint8_t* page, uint64_t mask ) {
+        size_t bsize = blockSize();
+        size_t blocks = alloc_unit_ / bsize;
+        for (size_t b = 0; b < blocks; b++) {
+            if (!(mask & ((uint64_t)1 << b))) continue;
+            size_t end = b;
+            while (end < blocks && (mask & ((uint64_t)1 << end))) end++;
+            uint8_t* run = page + b * bsize;
+            SST_SER(SST::Core::Serialization::array(run, (end - b) * bsize));
+            b = end;
+        }
+    }
+
+    void markDirty( Addr page ) {
+        if (last_dirty_valid_ && page == last_dirty_) return;
+        dirty_.insert(page);
+        last_dirty_ = page;
+        last_dirty_valid_ = true;
+    }
+
+    /* Page store records are a block mask followed by the non-zero blocks.
+     * Zero pages have no record and identical pages share one. */
+    void appendDirtyPages() {
+        if (dirty_.empty()) return;
+        if (!store_fp_) {
+            store_fp_ = fopen(store_path_.c_str(), "ab");
+            if (!store_fp_) {
                 Output out("", 1, 0, Output::STDOUT);
-                out.fatal(CALL_INFO, -1, "BackingMalloc: Error - malloc failed.\n");
+                out.fatal(CALL_INFO, -1, "BackingMalloc: Error - unable to open checkpoint page store '%s'.\n", store_path_.c_str());
+            }
+        }
+        fseek(store_fp_, 0, SEEK_END);
+        size_t bsize = blockSize();
+        std::unordered_map<uint64_t, std::vector<Addr> > seen; // Content hash -> pages appended now
+        for (Addr page : dirty_) {
+            uint8_t* data = buffer_[page];
+            uint64_t mask = blockMask(data);
+            if (mask == 0) {
+                store_offset_.erase(page);
+                continue;
+            }
+            std::vector<Addr> &same = seen[hashPage(data, alloc_unit_)];
+            bool duplicate = false;
+            for (Addr other : same) {
+                if (memcmp(data, buffer_[other], alloc_unit_) == 0) {
+                    store_offset_[page] = store_offset_[other];
+                    duplicate = true;
+                    break;
+                }
             }
-            buffer_[bAddr] = data;
+            if (duplicate) continue;
+            same.push_back(page);
+            store_offset_[page] = ftell(store_fp_);
+            fwrite(&mask, sizeof(mask), 1, store_fp_);
+            for (size_t b = 0; b * bsize < alloc_unit_; b++) {
+                if (mask & ((uint64_t)1 << b))
+                    fwrite(data + b * bsize, 1, bsize, store_fp_);
+            }
+        }
+        fflush(store_fp_);
+        dirty_.clear();
+        last_dirty_valid_ = false;
+    }
+
+    void readStore() {
+        if (store_offset_.empty()) return;
+        FILE* fp = fopen(store_path_.c_str(), "rb");
+        if (!fp) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingMalloc: Error - unable to open checkpoint page store '%s'.\n", store_path_.c_str());
         }
+        size_t bsize = blockSize();
+        for (auto& entry : store_offset_) {
+            uint8_t* data = getPage(entry.first);
+            uint64_t mask;
+            fseek(fp, entry.second, SEEK_SET);
+            (void) !fread(&mask, sizeof(mask), 1, fp);
+            for (size_t b = 0; b * bsize < alloc_unit_; b++) {
+                if (mask & ((uint64_t)1 << b))
+                    (void) !fread(data + b * bsize, 1, bsize, fp);
+            }
+        }
+        fclose(fp);
+    }
+
+    std::vector<Addr> getSortedPages() {
+        std::vector<Addr> pages(page_order_);
+        std::sort(pages.begin(), pages.end());
+        return pages;
     }
 
-    std::map<Addr,uint8_t*> buffer_;
+    std::unordered_map<Addr,uint8_t*> buffer_;  // Page number -> page storage
+    std::vector<Addr> page_order_;              // Page numbers in allocation order
+    std::vector<uint8_t*> chunks_;              // Arena chunks, each chunk_size_ bytes
+    size_t chunk_size_;
+    size_t chunk_used_;                         // Bytes handed out from the last chunk
+    Addr last_page_;
+    uint8_t* last_buf_;
     unsigned int alloc_unit_;
     unsigned int shift_;
-    bool init_;
+    bool init_;         // Kept for the file format; arena memory is always zero-initialized
+    bool huge_pages_;
+
+    /* Incremental checkpoints */
+    std::string store_path_;                        // Page store, empty if pages go in the checkpoint
+    FILE* store_fp_ = nullptr;
+    bool track_dirty_ = false;
+    std::unordered_set<Addr> dirty_;                // Pages written since the last checkpoint
+    Addr last_dirty_ = 0;
+    bool last_dirty_valid_ = false;
+    std::unordered_map<Addr, uint64_t> store_offset_;   // Page -> record in the page store, absent if zero
 };
 
 }
@@ -0,0 +1,169 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst/core/sst_config.h>
+#include <sst/core/link.h>
+#include <cmath>
+#include "membackend/cxlMemory.h"
+#include "sst/elements/memHierarchy/util.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+#define CXL_SLOT_BYTES 16
+
+/*------------------------------- CXL Memory ------------------------------- */
+CXLMemory::CXLMemory(ComponentId_t id, Params &params) : SimpleMemBackend(id, params),
+    inDevice(0), m2sFree(0), s2mFree(0)
+{
+    // Get parameters
+    fixupParams( params, "clock", "backend.clock" );
+
+    unsigned lanes = params.find<unsigned>("link_width", 16);
+    double rate = params.find<double>("link_rate", 32);
+    unsigned flitSize = params.find<unsigned>("flit_size", 68);
+    UnitAlgebra linkLat = params.find<UnitAlgebra>("link_latency", UnitAlgebra("25ns"));
+    UnitAlgebra ctrlLat = params.find<UnitAlgebra>("controller_latency", UnitAlgebra("40ns"));
+    maxInDevice = params.find<unsigned>("device_queue_depth", 64);
+
+    if (lanes == 0 || rate <= 0) {
+        output->fatal(CALL_INFO, -1, "Invalid param(%s): link_width and link_rate must be greater than 0. You specified %u and %f.\n", getName().c_str(), lanes, rate);
+    }
+    // A 68B flit carries 4 slots behind its header and CRC, a 256B flit carries 15 and a slot of header and CRC
+    if (flitSize == 68) {
+        wireBytesPerSlot = 68.0 / 4;
+    } else if (flitSize == 256) {
+        wireBytesPerSlot = 256.0 / 15;
+    } else {
+        output->fatal(CALL_INFO, -1, "Invalid param(%s): flit_size - must be 68 or 256. You specified %u.\n", getName().c_str(), flitSize);
+    }
+    if (!(linkLat.hasUnits("s")) || !(ctrlLat.hasUnits("s"))) {
+        output->fatal(CALL_INFO, -1, "Invalid param(%s): link_latency and controller_latency - must have units of 's' (seconds). You specified %s and %s.\n",
+                getName().c_str(), linkLat.toString().c_str(), ctrlLat.toString().c_str());
+    }
+    if (maxInDevice == 0) {
+        output->fatal(CALL_INFO, -1, "Invalid param(%s): device_queue_depth must be at least 1.\n", getName().c_str());
+    }
+
+    // GT/s per lane is Gb/s per lane, one direction of the link moves lanes * rate / 8 bytes per ns
+    linkBytesPerPs = lanes * rate / 8.0 / 1000.0;
+    linkLatency = (linkLat * UnitAlgebra("1THz")).getRoundedValue();
+    controllerLatency = (ctrlLat * UnitAlgebra("1THz")).getRoundedValue();
+
+    // Create our backend
+    backend = loadUserSubComponent<SimpleMemBackend>("backend");
+    if (!backend) {
+        std::string backendName = params.find<std::string>("backend", "memHierarchy.simpleDRAM");
+        Params backendParams = params.get_scoped_params("backend");
+        backendParams.insert("mem_size", params.find<std::string>("mem_size"));
+        backend = loadAnonymousSubComponent<SimpleMemBackend>(backendName, "backend", 0, ComponentInfo::SHARE_PORTS | ComponentInfo::INSERT_STATS, backendParams);
+    }
+    using std::placeholders::_1;
+    backend->setResponseHandler( std::bind( &CXLMemory::handleBackendResponse, this, _1 )  );
+
+    m_memSize = backend->getMemSize(); // inherit from backend
+
+    // Set up self links, one per direction of the link
+    m2sLink = configureSelfLink("M2SLink", "1ps", new Event::Handler2<CXLMemory, &CXLMemory::handleDeviceArrival>(this));
+    s2mLink = configureSelfLink("S2MLink", "1ps", new Event::Handler2<CXLMemory, &CXLMemory::handleHostArrival>(this));
+
+    stat_m2sSlots = registerStatistic<uint64_t>("m2s_slots");
+    stat_s2mSlots = registerStatistic<uint64_t>("s2m_slots");
+    stat_linkQueueLatency = registerStatistic<uint64_t>("link_queue_latency");
+    stat_deviceQueueLatency = registerStatistic<uint64_t>("device_queue_latency");
+}
+
+SimTime_t CXLMemory::sendOnLink( SimTime_t& linkFree, unsigned dataBytes, Statistic<uint64_t>* slots ) {
+    SimTime_t now = getCurrentSimTime("1ps");
+    SimTime_t start = std::max(now, linkFree);
+    stat_linkQueueLatency->addData(start - now);
+
+    // Slots of back to back messages share flits, so a message occupies its share of the flits
+    unsigned numSlots = 1 + (dataBytes + CXL_SLOT_BYTES - 1) / CXL_SLOT_BYTES;
+    slots->addData(numSlots);
+    linkFree = start + (SimTime_t) std::ceil(numSlots * wireBytesPerSlot / linkBytesPerPs);
+    return linkFree;
+}
+
+bool CXLMemory::issueRequest( ReqId req, Addr addr, bool isWrite, unsigned numBytes) {
+    if (inDevice >= maxInDevice)
+        return false;
+    inDevice++;
+
+    // Writes carry their data to the device, reads get it back with the response
+    SimTime_t now = getCurrentSimTime("1ps");
+    SimTime_t arrival = sendOnLink(m2sFree, isWrite ? numBytes : 0, stat_m2sSlots) + linkLatency + controllerLatency;
+    m2sQueue.push(Req(req, addr, isWrite, numBytes, arrival));
+    m2sLink->send(arrival - now, NULL);
+    return true;
+}
+
+void CXLMemory::handleDeviceArrival(SST::Event *event) {
+    deviceQueue.push_back(m2sQueue.front());
+    m2sQueue.pop();
+    issueToBackend();
+}
+
+void CXLMemory::issueToBackend() {
+    while (!deviceQueue.empty()) {
+        Req& req = deviceQueue.front();
+        if (!backend->issueRequest(req.id, req.addr, req.isWrite, req.numBytes))
+            return;
+        stat_deviceQueueLatency->addData(getCurrentSimTime("1ps") - req.time);
+        backendReqs.insert(std::make_pair(req.id, req));
+        deviceQueue.pop_front();
+    }
+}
+
+void CXLMemory::handleBackendResponse( ReqId id ) {
+    std::map<ReqId, Req>::iterator it = backendReqs.find(id);
+    if (it == backendReqs.end()) {
+        output->fatal(CALL_INFO, -1, "%s, Error: response from backend for unknown request %" PRIu64 "\n", getName().c_str(), (uint64_t) id);
+    }
+    bool isWrite = it->second.isWrite;
+    unsigned numBytes = it->second.numBytes;
+    backendReqs.erase(it);
+
+    SimTime_t now = getCurrentSimTime("1ps");
+    SimTime_t arrival = sendOnLink(s2mFree, isWrite ? 0 : numBytes, stat_s2mSlots) + linkLatency;
+    s2mQueue.push(id);
+    s2mLink->send(arrival - now, NULL);
+}
+
+void CXLMemory::handleHostArrival(SST::Event *event) {
+    ReqId id = s2mQueue.front();
+    s2mQueue.pop();
+    inDevice--;
+    handleMemResponse(id);
+}
+
+/*
+ * Retry requests the backend rejected, the clock has to stay
+ * on while requests are on their way to the device
+ */
+bool CXLMemory::clock(Cycle_t cycle) {
+    issueToBackend();
+    bool unclock = backend->clock(cycle);
+    return unclock && deviceQueue.empty() && m2sQueue.empty();
+}
+
+void CXLMemory::setup() {
+    backend->setup();
+}
+
+void CXLMemory::finish() {
+    backend->finish();
+}
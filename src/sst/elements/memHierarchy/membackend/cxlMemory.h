@@ -0,0 +1,118 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MEMH_CXL_MEMORY
+#define _H_SST_MEMH_CXL_MEMORY
+
+#include "sst/elements/memHierarchy/membackend/memBackend.h"
+#include <deque>
+#include <map>
+#include <queue>
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * CXL.mem expander in front of another backend. Requests cross the link to
+ * the device as M2S messages, wait in the device controller queue for the
+ * backend, and come back as S2M messages. Messages are made of 16B slots
+ * packed into flits, so each direction of the link is a serializer whose
+ * bytes on the wire include the flit overhead.
+ */
+class CXLMemory : public SimpleMemBackend {
+public:
+/* Element Library Info */
+    SST_ELI_REGISTER_SUBCOMPONENT(CXLMemory, "memHierarchy", "cxlMemory", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "CXL.mem expander, adds a CXL link and device controller to another backend", SST::MemHierarchy::SimpleMemBackend)
+
+    SST_ELI_DOCUMENT_PARAMS( MEMBACKEND_ELI_PARAMS,
+            /* Own parameters */
+            {"verbose", "Sets the verbosity of the backend output", "0"},
+            {"backend", "Backend memory system of the device", "memHierarchy.simpleDRAM"},
+            {"link_width", "Number of lanes of the link, e.g., 8 or 16", "16"},
+            {"link_rate", "Transfer rate of a lane in GT/s (32 for PCIe 5.0, 64 for PCIe 6.0)", "32"},
+            {"flit_size", "Flit format in bytes, 68 (4 slots of 16B) or 256 (15 slots of 16B)", "68"},
+            {"link_latency", "One way latency of the link, port and PHY, with units", "25ns"},
+            {"controller_latency", "Latency of the device controller for each request, with units", "40ns"},
+            {"device_queue_depth", "Requests the device accepts before the host is backpressured", "64"} )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+            {"m2s_slots", "16B slots sent from host to device, headers and data", "slots", 1},
+            {"s2m_slots", "16B slots sent from device to host, headers and data", "slots", 1},
+            {"link_queue_latency", "Time a message waited for the link", "ps", 1},
+            {"device_queue_latency", "Time a request waited for the device backend", "ps", 1} )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( {"backend", "Backend memory model of the device", "SST::MemHierarchy::SimpleMemBackend"} )
+
+/* Begin class definition */
+    CXLMemory(ComponentId_t id, Params &params);
+    virtual bool issueRequest( ReqId, Addr, bool isWrite, unsigned numBytes );
+    void setup();
+    void finish();
+    virtual bool clock(Cycle_t cycle);
+    virtual bool isClocked() { return true; }
+
+private:
+    struct Req {
+        Req( ReqId id, Addr addr, bool isWrite, unsigned numBytes, SimTime_t time = 0 ) :
+            id(id), addr(addr), isWrite(isWrite), numBytes(numBytes), time(time)
+        { }
+        ReqId id;
+        Addr addr;
+        bool isWrite;
+        unsigned numBytes;
+        SimTime_t time;
+    };
+
+    void handleBackendResponse( ReqId id );
+    void handleDeviceArrival( SST::Event* ev );
+    void handleHostArrival( SST::Event* ev );
+    void issueToBackend();
+
+    // Serializes a header slot and dataBytes of data slots on one direction of the link, returns when the last one is sent
+    SimTime_t sendOnLink( SimTime_t& linkFree, unsigned dataBytes, Statistic<uint64_t>* slots );
+
+    SimpleMemBackend* backend;
+
+    double      linkBytesPerPs;     // one direction of the link
+    double      wireBytesPerSlot;   // flit bytes over data slots per flit
+    SimTime_t   linkLatency;        // ps
+    SimTime_t   controllerLatency;  // ps
+    unsigned    maxInDevice;
+    unsigned    inDevice;           // requests accepted and not yet responded to
+
+    SimTime_t   m2sFree;            // time the host to device direction is free
+    SimTime_t   s2mFree;            // time the device to host direction is free
+
+    // messages in flight on the link, each direction delivers in order
+    Link*       m2sLink;
+    Link*       s2mLink;
+    std::queue<Req> m2sQueue;
+    std::queue<ReqId> s2mQueue;
+
+    std::deque<Req> deviceQueue;    // requests waiting for the backend
+    std::map<ReqId, Req> backendReqs;  // requests issued to the backend
+
+    Statistic<uint64_t>* stat_m2sSlots;
+    Statistic<uint64_t>* stat_s2mSlots;
+    Statistic<uint64_t>* stat_linkQueueLatency;
+    Statistic<uint64_t>* stat_deviceQueueLatency;
+};
+
+}
+}
+
+#endif
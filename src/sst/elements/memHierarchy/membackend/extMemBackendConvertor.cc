@@ -52,7 +52,7 @@ bool ExtMemBackendConvertor::issue( BaseReq *req ) {
       // issue standard request
       MemReq * mreq = static_cast<MemReq*>(req);
       return static_cast<ExtMemBackend*>(m_backend)->issueRequest( mreq->id(),
-                                                                   mreq->addr(),
+                                                                   channelAddr(mreq->addr()),
                                                                    mreq->isWrite(),
                                                                    NULLVEC, // this is null for normal requests
                                                                    mreq->getMemEvent()->getFlags(),
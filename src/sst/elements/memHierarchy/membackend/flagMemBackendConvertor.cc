@@ -42,7 +42,7 @@ bool FlagMemBackendConvertor::issue( BaseReq *breq ) {
     if (breq->isMemEv()) {
         MemReq * req = static_cast<MemReq*>(breq);
         MemEvent* event = req->getMemEvent();
-        return static_cast<FlagMemBackend*>(m_backend)->issueRequest( req->id(), req->addr(), req->isWrite(), event->getFlags(), m_backendRequestWidth );
+        return static_cast<FlagMemBackend*>(m_backend)->issueRequest( req->id(), channelAddr(req->addr()), req->isWrite(), event->getFlags(), m_backendRequestWidth );
     } else {
         CustomReq * req = static_cast<CustomReq*>(breq);
         return static_cast<FlagMemBackend*>(m_backend)->issueCustomRequest(req->id(), req->getInfo());
@@ -31,7 +31,7 @@ using namespace SST::MemHierarchy;
 
 
 MemBackendConvertor::MemBackendConvertor(ComponentId_t id, Params& params, MemBackend* backend, uint32_t request_width) :
-    SubComponent(id), m_cycleCount(0), m_reqId(0), m_backend(backend)
+    SubComponent(id), m_cycleCount(0), m_reqId(0), m_backend(backend), m_numChannels(1), m_channelInterleave(0)
 {
     m_dbg.init("",
             params.find<uint32_t>("debug_level", 0),
@@ -253,6 +253,8 @@ void MemBackendConvertor::serialize_order(SST::Core::Serialization::serializer&
     SST_SER(m_backend);
     SST_SER(m_backendRequestWidth);
     SST_SER(m_clockBackend);
+    SST_SER(m_numChannels);
+    SST_SER(m_channelInterleave);
     SST_SER(m_dbg);
     SST_SER(m_cycleCount);
     SST_SER(m_clockOn);
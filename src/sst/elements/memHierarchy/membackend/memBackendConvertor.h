@@ -201,6 +201,13 @@ class MemBackendConvertor : public SubComponent {
 
     virtual void setCallbackHandlers(std::function<void(Event::id_type,uint32_t)> responseCB, std::function<Cycle_t()> clockenableCB);
 
+    /* Called by a multi-channel MemController so that this convertor's backend
+     * sees a dense channel-local address space instead of every Nth chunk */
+    void setChannelMapping(uint32_t numChannels, uint64_t interleaveSize) {
+        m_numChannels = numChannels;
+        m_channelInterleave = interleaveSize;
+    }
+
     // generates a MemReq for the target custom command
     // this is utilized by inherited ExtMemBackendConvertor's
     // such that all the requests are consolidated in one place
@@ -221,11 +228,22 @@ protected:
     void doResponse( ReqId reqId, uint32_t flags = 0 );
     inline void sendResponse( SST::Event::id_type id, uint32_t flags );
 
+    /* Translate a controller-local address to this convertor's channel-local address */
+    Addr channelAddr( Addr addr ) {
+        if (m_numChannels <= 1)
+            return addr;
+        Addr chunk = addr / m_channelInterleave;
+        return (chunk / m_numChannels) * m_channelInterleave + (addr % m_channelInterleave);
+    }
+
     MemBackend* m_backend;
     uint32_t    m_backendRequestWidth;
 
     bool m_clockBackend;
 
+    uint32_t    m_numChannels;
+    uint64_t    m_channelInterleave;
+
   private:
     virtual bool issue(BaseReq*) = 0;
 
@@ -0,0 +1,149 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MEMH_MEM_PROFILER
+#define _H_SST_MEMH_MEM_PROFILER
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <sst/core/sst_types.h>
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Windowed time series of a memory controller, per channel and bank, for
+ * finding where a configuration saturates. Header only so that backends
+ * outside memHierarchy (e.g., cramSim) can use it too. Counters are kept in
+ * one flat array and written as fixed size binary records, in host byte
+ * order, at the end of each window that saw any activity:
+ *
+ *  header: char magic[8] "MEMPROF1", uint32 channels, banks, delayBins, 0,
+ *          uint64 window (cycles), uint64 delayBinWidth (cycles)
+ *  record: uint64 window index, then for each channel
+ *          uint32 read/write turnarounds, then for each bank of the channel
+ *          uint32 readBytes, writeBytes, rowHits, rowMisses, delay[delayBins]
+ *
+ * delay[] is a histogram of the cycles requests waited before being
+ * scheduled to their bank, the last bin counts everything beyond it.
+ */
+class MemProfiler {
+public:
+    MemProfiler( SimTime_t window, unsigned channels, unsigned banks, unsigned delayBins, SimTime_t delayBinWidth ) :
+        m_file(NULL), m_window(window ? window : 1), m_channels(channels), m_banks(banks),
+        m_delayBins(delayBins ? delayBins : 1), m_delayBinWidth(delayBinWidth ? delayBinWidth : 1),
+        m_bankWords(BankCounters + m_delayBins), m_chanWords(1 + m_banks * m_bankWords),
+        m_current(0), m_active(false),
+        m_counters(m_channels * m_chanWords, 0), m_lastWrite(m_channels, -1)
+    { }
+
+    ~MemProfiler() { close(); }
+
+    // returns false if the file cannot be written
+    bool open( const std::string& fileName ) {
+        m_file = fopen( fileName.c_str(), "wb" );
+        if ( ! m_file ) {
+            return false;
+        }
+        uint32_t header32[4] = { m_channels, m_banks, m_delayBins, 0 };
+        uint64_t header64[2] = { m_window, m_delayBinWidth };
+        fwrite( "MEMPROF1", 1, 8, m_file );
+        fwrite( header32, sizeof(uint32_t), 4, m_file );
+        fwrite( header64, sizeof(uint64_t), 2, m_file );
+        return true;
+    }
+
+    // a read or write moved bytes over the data bus of chan
+    void access( SimTime_t cycle, unsigned chan, unsigned bank, bool isWrite, unsigned bytes ) {
+        advance( cycle );
+        uint32_t* b = bankCounters( chan, bank );
+        b[ isWrite ? WriteBytes : ReadBytes ] += bytes;
+        int dir = isWrite ? 1 : 0;
+        if ( m_lastWrite[chan] != -1 && m_lastWrite[chan] != dir ) {
+            m_counters[ chan * m_chanWords ]++;
+        }
+        m_lastWrite[chan] = dir;
+        m_active = true;
+    }
+
+    // a request was scheduled to its bank after waiting queueDelay cycles
+    void schedule( SimTime_t cycle, unsigned chan, unsigned bank, bool rowHit, SimTime_t queueDelay ) {
+        advance( cycle );
+        uint32_t* b = bankCounters( chan, bank );
+        b[ rowHit ? RowHits : RowMisses ]++;
+        SimTime_t bin = queueDelay / m_delayBinWidth;
+        b[ BankCounters + ( bin < m_delayBins ? bin : m_delayBins - 1 ) ]++;
+        m_active = true;
+    }
+
+    // write out the windows that ended before cycle
+    void advance( SimTime_t cycle ) {
+        SimTime_t window = cycle / m_window;
+        if ( window != m_current ) {
+            flush();
+            m_current = window;
+        }
+    }
+
+    void close() {
+        if ( m_file ) {
+            flush();
+            fclose( m_file );
+            m_file = NULL;
+        }
+    }
+
+private:
+    enum { ReadBytes, WriteBytes, RowHits, RowMisses, BankCounters };
+
+    uint32_t* bankCounters( unsigned chan, unsigned bank ) {
+        return &m_counters[ chan * m_chanWords + 1 + bank * m_bankWords ];
+    }
+
+    void flush() {
+        if ( ! m_active ) {
+            return;
+        }
+        if ( m_file ) {
+            uint64_t window = m_current;
+            fwrite( &window, sizeof(uint64_t), 1, m_file );
+            fwrite( &m_counters[0], sizeof(uint32_t), m_counters.size(), m_file );
+        }
+        memset( &m_counters[0], 0, m_counters.size() * sizeof(uint32_t) );
+        m_active = false;
+    }
+
+    FILE*       m_file;
+    SimTime_t   m_window;
+    unsigned    m_channels;
+    unsigned    m_banks;
+    unsigned    m_delayBins;
+    SimTime_t   m_delayBinWidth;
+    unsigned    m_bankWords;
+    unsigned    m_chanWords;
+    SimTime_t   m_current;
+    bool        m_active;
+    std::vector<uint32_t>   m_counters;
+    std::vector<int>        m_lastWrite;    // direction of the last access of each channel, -1 before the first
+};
+
+}
+}
+
+#endif
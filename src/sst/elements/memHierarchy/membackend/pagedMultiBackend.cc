@@ -16,7 +16,9 @@
 
 #include <sst_config.h>
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 #include <sst/core/link.h>
 #include <sst/core/timeConverter.h>
@@ -86,6 +88,27 @@ pagedMultiMemory::pagedMultiMemory(ComponentId_t id, Params &params) : DRAMSimMe
         dbg.fatal(CALL_INFO, -1, "Invalid page addition Strategy (page_add_strategy)\n");
     }
 
+    // determine migration engine policy
+    stratStr = params.find<std::string>("migration_policy", "none");
+    if (stratStr == "none") {
+        migPolicy = migNONE;
+    } else if (stratStr == "HeMem") {
+        migPolicy = migHeMem;
+    } else if (stratStr == "TPP") {
+        migPolicy = migTPP;
+    } else {
+        dbg.fatal(CALL_INFO, -1, "Invalid migration policy (migration_policy)\n");
+    }
+    samplePeriod = params.find<uint32_t>("sample_period", 1);
+    if (samplePeriod == 0) {
+        dbg.fatal(CALL_INFO, -1, "sample_period must be at least 1\n");
+    }
+    sampleCount = 0;
+    migrationLimit = params.find<uint32_t>("migration_limit", 64);
+    freeFastPages = params.find<uint32_t>("free_fast_pages", 8);
+    epochAccesses = 0;
+    epochFastHits = 0;
+
     if (addStrat == addMFU) {
       if ((replaceStrat != LFU) && (replaceStrat != LFU8)) {
 	dbg.fatal(CALL_INFO, -1, "MFU page addition strategy requires LFU page replacement strategy\n");
@@ -119,6 +142,10 @@ pagedMultiMemory::pagedMultiMemory(ComponentId_t id, Params &params) : DRAMSimMe
     tPages = registerStatistic<uint64_t>("t_pages","1");
     cantSwapOut = registerStatistic<uint64_t>("cant_swap","1");
     swapDelays = registerStatistic<uint64_t>("swap_delays","1");
+    promotions = registerStatistic<uint64_t>("promotions","1");
+    demotions = registerStatistic<uint64_t>("demotions","1");
+    migrationBytes = registerStatistic<uint64_t>("migration_bytes","1");
+    epochFastHitRate = registerStatistic<double>("epoch_fast_hit_rate","1");
 
     if (modelSwaps) {
         // use our own callbacks
@@ -372,11 +399,15 @@ bool pagedMultiMemory::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned
     auto &page = pageMap[pageAddr];
 
     page.record(addr, isWrite, getRequestor(id), collectStats, pageAddr, replaceStrat == LFU8);
+    if (migPolicy != migNONE) sampleAccess(page);
 
     if (maxFastPages > 0) {
         if (modelSwaps && pageIsSwapping(page)) {
             // don't try to swap if we're already swapping that page
             inFast = page.inFast;
+        } else if (migPolicy != migNONE) {
+            // the migration engine moves pages at the end of the epoch
+            inFast = page.inFast;
         } else {
             if (replaceStrat == LFU || replaceStrat == LFU8) {
                 do_LFU( addr, page, inFast, swapping);
@@ -388,6 +419,9 @@ bool pagedMultiMemory::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned
 
     Req* req = new Req(id,addr,isWrite,numBytes );
 
+    epochAccesses++;
+    if (inFast) epochFastHits++;
+
     if (modelSwaps) {
         fastAccesses->addData(1);
         if (pageIsSwapping(page)) {
@@ -519,6 +553,8 @@ void pagedMultiMemory::handleSelfEvent(SST::Event *event){
 bool pagedMultiMemory::quantaClock(SST::Cycle_t _cycle) {
     if (collectStats) printAccStats();
 
+    if (migPolicy != migNONE) migrate();
+
     lastMin = 0;
 
     for (auto p = pageMap.begin(); p != pageMap.end(); ++p) {
@@ -528,6 +564,96 @@ bool pagedMultiMemory::quantaClock(SST::Cycle_t _cycle) {
     return false;
 }
 
+// count one in samplePeriod accesses, like PEBS sampling, in a saturating counter
+void pagedMultiMemory::sampleAccess(pageInfo &page) {
+    page.lastTouch = getCurrentSimTimeNano();
+    if (++sampleCount < samplePeriod) return;
+    sampleCount = 0;
+    if (page.heat < std::numeric_limits<uint8_t>::max()) page.heat++;
+}
+
+/*
+ * End of an epoch: pick pages to migrate from their heat, at most
+ * migrationLimit in each direction, and cool the heat. The swaps are
+ * issued to both memories like the ones of the per access strategies.
+ */
+void pagedMultiMemory::migrate() {
+    if (epochAccesses > 0) {
+        epochFastHitRate->addData(double(epochFastHits) / double(epochAccesses));
+    }
+    epochAccesses = 0;
+    epochFastHits = 0;
+
+    if (maxFastPages > 0) {
+        std::vector<pageInfo*> hot; // slow pages at or above threshold, hottest first
+        std::vector<pageInfo*> cold; // fast pages below threshold, coldest first
+        for (auto p = pageMap.begin(); p != pageMap.end(); ++p) {
+            pageInfo &page = p->second;
+            if (pageIsSwapping(page)) continue;
+            if (page.inFast) {
+                if (page.heat < threshold) cold.push_back(&page);
+            } else if (page.heat >= threshold) {
+                hot.push_back(&page);
+            }
+        }
+        std::sort(hot.begin(), hot.end(), [](const pageInfo *a, const pageInfo *b) {
+            return a->heat > b->heat;
+        });
+        std::sort(cold.begin(), cold.end(), [](const pageInfo *a, const pageInfo *b) {
+            return (a->heat != b->heat) ? (a->heat < b->heat) : (a->lastTouch < b->lastTouch);
+        });
+
+        uint32_t promoted = 0;
+        uint32_t demoted = 0;
+        auto c = cold.begin();
+        if (migPolicy == migTPP) {
+            // demote ahead of time so promotions never wait for a victim
+            while (demoted < migrationLimit && c != cold.end() && (maxFastPages - pagesInFast) < freeFastPages) {
+                demote(*c++);
+                demoted++;
+            }
+            for (auto h = hot.begin(); h != hot.end() && promoted < migrationLimit && pagesInFast < maxFastPages; ++h) {
+                promote(*h);
+                promoted++;
+            }
+        } else {
+            for (auto h = hot.begin(); h != hot.end() && promoted < migrationLimit; ++h) {
+                if (pagesInFast == maxFastPages) {
+                    if (c == cold.end() || demoted == migrationLimit || (*c)->heat >= (*h)->heat) break;
+                    demote(*c++);
+                    demoted++;
+                }
+                promote(*h);
+                promoted++;
+            }
+        }
+        dbg.debug(_L10_, "epoch migration: %" PRIu32 " promoted, %" PRIu32 " demoted, %" PRIu32 " fast pages\n",
+                  promoted, demoted, pagesInFast);
+    }
+
+    for (auto p = pageMap.begin(); p != pageMap.end(); ++p) {
+        if (migPolicy == migHeMem) {
+            p->second.heat >>= 1;
+        } else {
+            p->second.heat = 0;
+        }
+    }
+}
+
+void pagedMultiMemory::promote(pageInfo *page) {
+    page->inFast = 1;
+    pagesInFast++;
+    promotions->addData(1);
+    moveToFast(*page);
+}
+
+void pagedMultiMemory::demote(pageInfo *page) {
+    page->inFast = 0;
+    pagesInFast--;
+    demotions->addData(1);
+    moveToSlow(page);
+}
+
 void pagedMultiMemory::moveToFast(pageInfo &page) {
     assert(page.swapDir == pageInfo::NONE);
 
@@ -537,6 +663,7 @@ void pagedMultiMemory::moveToFast(pageInfo &page) {
     // mark page as swapping
     page.swapDir = pageInfo::StoF;
     page.swapsOut = numTransfers;
+    migrationBytes->addData(numTransfers * 64);
 
     dbg.debug(_L10_, "moveToFast(%p addr:%p) sO:%d\n", &page, (void*)(addr),
               page.swapsOut);
@@ -563,6 +690,7 @@ void pagedMultiMemory::moveToSlow(pageInfo *page) {
     // mark page as swapping
     page->swapDir = pageInfo::FtoS;
     page->swapsOut = numTransfers;
+    migrationBytes->addData(numTransfers * 64);
 
     // issue reads to fast mem
     for (int i = 0; i < numTransfers; ++i) {
@@ -48,6 +48,7 @@ struct pageInfo {
     uint64_t lastRef; // used in scan detection
     uint32_t scanLeng; // number of consecutive unit-1-stride accesses
     SimTime_t pageDelay; // time when page will be in fast mem
+    uint8_t heat; // sampled accesses, cooled every epoch (used by the migration engine)
 
     typedef enum {NONE, FtoS, StoF} swapDir_t;
     swapDir_t swapDir;
@@ -138,7 +139,7 @@ struct pageInfo {
     }
 
     pageInfo() : pageAddr(0), touched(0), inFast(0), lastTouch(0), lastRef(0), scanLeng(0),
-                 pageDelay(0), swapDir(NONE), swapsOut(0) {
+                 pageDelay(0), heat(0), swapDir(NONE), swapsOut(0) {
         for (int i = 0; i < LAST_CASE; ++i) {
             accPat[i] = 0;
         }
@@ -165,7 +166,11 @@ public:
             {"max_fast_pages",      "Number of \"fast\" (constant time) pages", "256"},
             {"page_shift",          "Size of page (2^x bytes)", "12"},
             {"quantum",             "time period for when page access counts is shifted", "5ms"},
-            {"accStatsPrefix",      "File name for acces pattern statistics",""} )
+            {"accStatsPrefix",      "File name for acces pattern statistics",""},
+            {"migration_policy",    "Epoch based migration engine used instead of the page addition and replacement strategies: none, HeMem or TPP. An epoch is one quantum", "none"},
+            {"sample_period",       "Migration engine: one in this many accesses is counted in the page heat", "1"},
+            {"migration_limit",     "Migration engine: pages promoted and pages demoted per epoch, bounds the migration bandwidth", "64"},
+            {"free_fast_pages",     "TPP: fast pages kept free for promotions by demoting cold pages", "8"} )
 
     SST_ELI_DOCUMENT_STATISTICS(
             {"fast_hits", "Number of accesses that 'hit' a fast page", "count", 1},
@@ -173,7 +178,11 @@ public:
             {"fast_acc", "Number of total accesses to the memory backend", "count", 1},
             {"t_pages", "Number of total pages", "count", 1},
             {"cant_swap", "Number of times a page could not be swapped in because no victim page could be found because all candidates were swapping", "count", 1},
-            {"swap_delays", "Number of an access is delayed because the page is swapping", "count", 1} )
+            {"swap_delays", "Number of an access is delayed because the page is swapping", "count", 1},
+            {"promotions", "Number of pages the migration engine moved to 'fast' memory", "count", 1},
+            {"demotions", "Number of pages the migration engine moved to 'slow' memory", "count", 1},
+            {"migration_bytes", "Bytes moved between 'fast' and 'slow' memory by page swaps", "bytes", 1},
+            {"epoch_fast_hit_rate", "Fraction of the accesses of an epoch that 'hit' a fast page", "ratio", 1} )
 
 /* Begin class definition */
     pagedMultiMemory(ComponentId_t id, Params &params);
@@ -229,6 +238,24 @@ private:
 
     bool dramBackpressure;
 
+    // epoch based migration engine, runs from quantaClock()
+    typedef enum {migNONE,
+                  migHeMem, // promote the hottest pages, swapping out colder ones, halve heat every epoch
+                  migTPP // keep free fast pages by demoting cold ones, promote into them, clear heat every epoch
+    } migrationPolicy_t;
+    migrationPolicy_t migPolicy;
+    uint32_t samplePeriod;
+    uint32_t sampleCount;
+    uint32_t migrationLimit;
+    uint32_t freeFastPages;
+    uint64_t epochAccesses;
+    uint64_t epochFastHits;
+
+    void sampleAccess(pageInfo &page);
+    void migrate();
+    void promote(pageInfo *page);
+    void demote(pageInfo *page);
+
     bool checkAdd(pageInfo &page);
     void do_FIFO_LRU( pageInfo &page, bool &inFast, bool &swapping);
     void do_LFU( Addr, pageInfo &page, bool &inFast, bool &swapping);
@@ -305,6 +332,10 @@ public:
     Statistic<uint64_t> *tPages;
     Statistic<uint64_t> *cantSwapOut;
     Statistic<uint64_t> *swapDelays;
+    Statistic<uint64_t> *promotions;
+    Statistic<uint64_t> *demotions;
+    Statistic<uint64_t> *migrationBytes;
+    Statistic<double> *epochFastHitRate;
 };
 
 }
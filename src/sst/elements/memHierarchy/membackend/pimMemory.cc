@@ -0,0 +1,185 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst/core/sst_config.h>
+#include <algorithm>
+#include "membackend/pimMemory.h"
+#include "sst/elements/memHierarchy/util.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+/*------------------------------- PIM Memory ------------------------------- */
+PIMMemory::PIMMemory(ComponentId_t id, Params &params) : SimpleMemBackend(id, params),
+    currentCycle(0), nextAccessId(((ReqId) 1) << 32)
+{
+    // Get parameters
+    fixupParams( params, "clock", "backend.clock" );
+
+    pimUnits = params.find<unsigned>("pim_units", 1);
+    aluBytesPerCycle = params.find<unsigned>("alu_bytes_per_cycle", 32);
+    maxOutstanding = params.find<unsigned>("max_outstanding", 16);
+
+    if (pimUnits == 0 || aluBytesPerCycle == 0 || maxOutstanding == 0) {
+        output->fatal(CALL_INFO, -1, "Invalid param(%s): pim_units, alu_bytes_per_cycle and max_outstanding must be greater than 0. You specified %u, %u and %u.\n",
+                getName().c_str(), pimUnits, aluBytesPerCycle, maxOutstanding);
+    }
+
+    // Create our backend
+    backend = loadUserSubComponent<SimpleMemBackend>("backend");
+    if (!backend) {
+        std::string backendName = params.find<std::string>("backend", "memHierarchy.simpleDRAM");
+        Params backendParams = params.get_scoped_params("backend");
+        backendParams.insert("mem_size", params.find<std::string>("mem_size"));
+        backend = loadAnonymousSubComponent<SimpleMemBackend>(backendName, "backend", 0, ComponentInfo::SHARE_PORTS | ComponentInfo::INSERT_STATS, backendParams);
+    }
+    using std::placeholders::_1;
+    backend->setResponseHandler( std::bind( &PIMMemory::handleBackendResponse, this, _1 )  );
+
+    m_memSize = backend->getMemSize(); // inherit from backend
+
+    stat_commands = registerStatistic<uint64_t>("pim_commands");
+    stat_bytesRead = registerStatistic<uint64_t>("pim_bytes_read");
+    stat_bytesWritten = registerStatistic<uint64_t>("pim_bytes_written");
+    stat_latency = registerStatistic<uint64_t>("pim_latency");
+    stat_aluCycles = registerStatistic<uint64_t>("pim_alu_cycles");
+}
+
+bool PIMMemory::issueRequest( ReqId req, Addr addr, bool isWrite, unsigned numBytes) {
+    return backend->issueRequest(req, addr, isWrite, numBytes);
+}
+
+void PIMMemory::addAccesses( std::vector<Addr>& list, Addr base, uint64_t step, uint64_t count, uint32_t elemSize ) {
+    for (uint64_t i = 0; i < count; i++) {
+        Addr first = base + i * step;
+        for (Addr addr = first - (first % m_reqWidth); addr < first + elemSize; addr += m_reqWidth) {
+            Addr local = m_memSize ? addr % m_memSize : addr;
+            if (list.empty() || list.back() != local)
+                list.push_back(local);
+        }
+    }
+}
+
+bool PIMMemory::issueCustomRequest( ReqId req, Interfaces::StandardMem::CustomData* info ) {
+    PIMCustomData* data = dynamic_cast<PIMCustomData*>(info);
+    if (!data) {
+        output->fatal(CALL_INFO, -1, "%s, Error: received a custom request that is not a PIM command: %s\n", getName().c_str(), info->getString().c_str());
+    }
+    if (commands.size() >= pimUnits)
+        return false;
+
+    Command* cmd = new Command();
+    cmd->id = req;
+    cmd->nextRead = cmd->nextWrite = cmd->readsDone = cmd->writesDone = 0;
+    cmd->outstanding = 0;
+    cmd->aluFree = cmd->start = currentCycle;
+
+    if (data->readsSource())
+        addAccesses(cmd->reads, data->getAddr(), data->getSrcStep(), data->getCount(), data->getElemSize());
+    if (data->getOp() == PIMCustomData::Op::Memset)
+        addAccesses(cmd->writes, data->getAddr(), data->getStride(), data->getCount(), data->getElemSize());
+    else if (data->writesDestination())
+        addAccesses(cmd->writes, data->getDst(), data->getDstStep(), data->getCount(), data->getElemSize());
+
+    stat_commands->addData(1);
+    commands.push_back(cmd);
+    issueAccesses(cmd);
+    return true;
+}
+
+/*
+ * Reads go out first, a write only once the share of the reads it depends
+ * on is back, so copies stream through the unit
+ */
+void PIMMemory::issueAccesses( Command* cmd ) {
+    while (cmd->outstanding < maxOutstanding) {
+        bool isWrite;
+        Addr addr;
+        if (cmd->nextRead < cmd->reads.size()) {
+            isWrite = false;
+            addr = cmd->reads[cmd->nextRead];
+        } else if (cmd->nextWrite < cmd->writes.size() &&
+                (cmd->reads.empty() || (cmd->nextWrite + 1) * cmd->reads.size() <= cmd->readsDone * cmd->writes.size())) {
+            isWrite = true;
+            addr = cmd->writes[cmd->nextWrite];
+        } else {
+            return;
+        }
+
+        ReqId id = nextAccessId;
+        if (!backend->issueRequest(id, addr, isWrite, m_reqWidth))
+            return;
+        nextAccessId++;
+        accesses.insert(std::make_pair(id, std::make_pair(cmd, isWrite)));
+        cmd->outstanding++;
+        if (isWrite) {
+            cmd->nextWrite++;
+            stat_bytesWritten->addData(m_reqWidth);
+        } else {
+            cmd->nextRead++;
+            stat_bytesRead->addData(m_reqWidth);
+        }
+    }
+}
+
+void PIMMemory::handleBackendResponse( ReqId id ) {
+    std::map<ReqId, std::pair<Command*, bool> >::iterator it = accesses.find(id);
+    if (it == accesses.end()) {
+        handleMemResponse(id);
+        return;
+    }
+
+    Command* cmd = it->second.first;
+    cmd->outstanding--;
+    if (it->second.second) {
+        cmd->writesDone++;
+    } else {
+        cmd->readsDone++;
+        Cycle_t aluCycles = (m_reqWidth + aluBytesPerCycle - 1) / aluBytesPerCycle;
+        cmd->aluFree = std::max(cmd->aluFree, currentCycle) + aluCycles;
+        stat_aluCycles->addData(aluCycles);
+    }
+    accesses.erase(it);
+}
+
+bool PIMMemory::clock(Cycle_t cycle) {
+    currentCycle = cycle;
+
+    std::list<Command*>::iterator it = commands.begin();
+    while (it != commands.end()) {
+        Command* cmd = *it;
+        issueAccesses(cmd);
+        if (cmd->readsDone == cmd->reads.size() && cmd->writesDone == cmd->writes.size() && cmd->aluFree <= cycle) {
+            stat_latency->addData(cycle - cmd->start);
+            handleMemResponse(cmd->id);
+            delete cmd;
+            it = commands.erase(it);
+        } else {
+            it++;
+        }
+    }
+
+    bool unclock = backend->clock(cycle);
+    return unclock && commands.empty();
+}
+
+void PIMMemory::setup() {
+    backend->setup();
+}
+
+void PIMMemory::finish() {
+    backend->finish();
+}
@@ -0,0 +1,109 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MEMH_PIM_MEMORY
+#define _H_SST_MEMH_PIM_MEMORY
+
+#include "sst/elements/memHierarchy/membackend/memBackend.h"
+#include "sst/elements/memHierarchy/customcmd/pimCustomCmd.h"
+#include <list>
+#include <map>
+#include <vector>
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Near-bank processing units in front of another backend. Regular requests
+ * pass through, PIMCustomData commands are broken into request_width
+ * accesses to the backend, so they occupy its banks like any other traffic,
+ * and their operands go through an ALU of limited throughput. Use with
+ * memHierarchy.pimCustomCmdHandler, which does the functional part.
+ */
+class PIMMemory : public SimpleMemBackend {
+public:
+/* Element Library Info */
+    SST_ELI_REGISTER_SUBCOMPONENT(PIMMemory, "memHierarchy", "pimMemory", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Processing-in-memory units executing custom commands next to another backend", SST::MemHierarchy::SimpleMemBackend)
+
+    SST_ELI_DOCUMENT_PARAMS( MEMBACKEND_ELI_PARAMS,
+            /* Own parameters */
+            {"verbose", "Sets the verbosity of the backend output", "0"},
+            {"backend", "Backend memory system", "memHierarchy.simpleDRAM"},
+            {"pim_units", "Number of PIM commands executed at the same time", "1"},
+            {"alu_bytes_per_cycle", "Bytes of operands each PIM unit processes per cycle", "32"},
+            {"max_outstanding", "Accesses to the backend each PIM unit can have in flight", "16"} )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+            {"pim_commands", "PIM commands executed", "commands", 1},
+            {"pim_bytes_read", "Bytes read from the backend by PIM commands", "bytes", 1},
+            {"pim_bytes_written", "Bytes written to the backend by PIM commands", "bytes", 1},
+            {"pim_latency", "Cycles from the start to the end of a PIM command", "cycles", 1},
+            {"pim_alu_cycles", "Cycles the PIM ALUs were busy", "cycles", 1} )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( {"backend", "Backend memory model", "SST::MemHierarchy::SimpleMemBackend"} )
+
+/* Begin class definition */
+    PIMMemory(ComponentId_t id, Params &params);
+    virtual bool issueRequest( ReqId, Addr, bool isWrite, unsigned numBytes );
+    virtual bool issueCustomRequest( ReqId, Interfaces::StandardMem::CustomData* );
+    void setup();
+    void finish();
+    virtual bool clock(Cycle_t cycle);
+    virtual bool isClocked() { return true; }
+
+private:
+    struct Command {
+        ReqId id;
+        std::vector<Addr> reads;    // backend accesses, in order
+        std::vector<Addr> writes;
+        size_t nextRead;
+        size_t nextWrite;
+        size_t readsDone;
+        size_t writesDone;
+        unsigned outstanding;
+        Cycle_t aluFree;            // cycle the ALU is done with the operands read so far
+        Cycle_t start;
+    };
+
+    void handleBackendResponse( ReqId id );
+    void issueAccesses( Command* cmd );
+
+    // Adds the backend access of each element to accesses unless it is the same as the last one
+    void addAccesses( std::vector<Addr>& accesses, Addr base, uint64_t step, uint64_t count, uint32_t elemSize );
+
+    SimpleMemBackend* backend;
+
+    unsigned    pimUnits;
+    unsigned    aluBytesPerCycle;
+    unsigned    maxOutstanding;
+
+    Cycle_t     currentCycle;
+    ReqId       nextAccessId;       // ids of our own accesses, above the convertor's
+    std::list<Command*> commands;
+    std::map<ReqId, std::pair<Command*, bool> > accesses;  // access -> command, isWrite
+
+    Statistic<uint64_t>* stat_commands;
+    Statistic<uint64_t>* stat_bytesRead;
+    Statistic<uint64_t>* stat_bytesWritten;
+    Statistic<uint64_t>* stat_latency;
+    Statistic<uint64_t>* stat_aluCycles;
+};
+
+}
+}
+
+#endif
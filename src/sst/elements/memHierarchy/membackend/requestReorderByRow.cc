@@ -32,6 +32,7 @@ RequestReorderRow::RequestReorderRow(ComponentId_t id, Params &params) : SimpleM
     banks = params.find<unsigned int>("banks", 8);
     UnitAlgebra rowSize(params.find<std::string>("row_size", "8KiB"));
     maxReqsPerRow = params.find<unsigned int>("reorder_limit", 1);    // No re-ordering
+    starvationLimit = params.find<Cycle_t>("starvation_limit", 0);
     UnitAlgebra requestSize(params.find<std::string>("bank_interleave_granularity", "64B"));
 
     // Check parameters
@@ -66,12 +67,12 @@ RequestReorderRow::RequestReorderRow(ComponentId_t id, Params &params) : SimpleM
 
     // Set up local variables
     nextBank = 0;
+    currentCycle = 0;
     bankMask = banks - 1;
     rowOffset = log2Of(rowSize.getRoundedValue());
     lineOffset = log2Of(requestSize.getRoundedValue());
+    requestQueue.resize(banks);
     for (unsigned int i = 0; i < banks; i++) {
-        std::list<Req >* bankList = new std::list<Req>;
-        requestQueue.push_back(bankList);
         lastRow.push_back(-1);  // No last request to this bank
         reorderCount.push_back(maxReqsPerRow);  // No requests reordered to this row
     }
@@ -84,7 +85,7 @@ bool RequestReorderRow::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned
 #endif
     int bank = (addr >> lineOffset) & bankMask;
 
-    requestQueue[bank]->push_back(Req(id,addr,isWrite,numBytes));
+    requestQueue[bank].push(Req(id,addr,isWrite,numBytes,currentCycle), addr >> rowOffset);
     return true;
 }
 
@@ -94,6 +95,8 @@ bool RequestReorderRow::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned
  */
 bool RequestReorderRow::clock(Cycle_t cycle) {
 
+    currentCycle = cycle;
+
     if (!requestQueue.empty()) {
 
         int reqsIssuedThisCycle = 0;
@@ -101,44 +104,39 @@ bool RequestReorderRow::clock(Cycle_t cycle) {
         // For current bank
         unsigned int bank = nextBank;
         for (unsigned int i = 0; i < banks; i++) {
-            if (requestQueue[bank]->empty()) {
+            BankQueue& bankQueue = requestQueue[bank];
+            if (bankQueue.reqs.empty()) {
                 bank = (bank + 1) % banks;
                 continue;
             }
 
             // Decide whether to try to re-order a request to this bank or issue a new row
             bool reorderIssued = false;
-            if (reorderCount[bank] != maxReqsPerRow) {
-                std::list<Req>* bankList = requestQueue[bank];
-                for (std::list<Req>::iterator it = bankList->begin(); it != bankList->end(); it++) {
-                    unsigned int row = (*it).addr >> rowOffset;
-
-                    if (row == lastRow[bank]) {
-                        // Attempt issue, if we're blocked, this bank is busy & move to next bank
-                        bool issued = backend->issueRequest((*it).id,(*it).addr,(*it).isWrite,(*it).numBytes);
-                        reorderIssued = true;
-                        if (issued) {
-                            reqsIssuedThisCycle++;
-                            nextBank = (bank + 1) % banks;
-                            reorderCount[bank]++;
-                            bankList->erase(it);
-                            break;
-                        } else {
-                            break;
-                        }
+            bool starved = starvationLimit != 0 && bankQueue.reqs.front().arrival + starvationLimit <= cycle;
+            if (reorderCount[bank] != maxReqsPerRow && !starved) {
+                std::list<Req>::iterator it = bankQueue.findRow(lastRow[bank]);
+                if (it != bankQueue.reqs.end()) {
+                    // Attempt issue, if we're blocked, this bank is busy & move to next bank
+                    bool issued = backend->issueRequest((*it).id,(*it).addr,(*it).isWrite,(*it).numBytes);
+                    reorderIssued = true;
+                    if (issued) {
+                        reqsIssuedThisCycle++;
+                        nextBank = (bank + 1) % banks;
+                        reorderCount[bank]++;
+                        bankQueue.erase(it, lastRow[bank]);
                     }
                 }
             }
 
             if (!reorderIssued) {
                 // Try to issue oldest request
-				Req& req = *requestQueue[bank]->begin();
+				Req& req = bankQueue.reqs.front();
                 if (backend->issueRequest( req.id, req.addr, req.isWrite, req.numBytes ) ) {
                     reqsIssuedThisCycle++;
                     nextBank = (bank + 1) % banks;
                     reorderCount[bank] = 1;
                     lastRow[bank] = req.addr >> rowOffset;
-                    requestQueue[bank]->erase(requestQueue[bank]->begin());
+                    bankQueue.erase(bankQueue.reqs.begin(), lastRow[bank]);
                 }
             }
 
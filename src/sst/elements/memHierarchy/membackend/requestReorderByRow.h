@@ -19,6 +19,7 @@
 
 #include "sst/elements/memHierarchy/membackend/memBackend.h"
 #include <list>
+#include <unordered_map>
 #include <vector>
 
 namespace SST {
@@ -38,6 +39,7 @@ public:
             {"bank_interleave_granularity", "Granularity of interleaving in bytes (B), generally a cache line. Must be a power of 2.", "64B"},
             {"row_size",                    "Size of a row in bytes (B). Must be a power of 2.", "8KiB"},
             {"reorder_limit",               "Maximum number of request to reorder to a rwo before changing rows.", "1"},
+            {"starvation_limit",            "Cycles the oldest request to a bank may wait before row hits stop bypassing it. 0 is unlimited.", "0"},
             {"backend",                     "Backend memory system.", "memHierarchy.simpleDRAM"} )
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( {"backend", "Backend memory model.", "SST::MemHierarchy::SimpleMemBackend"} )
@@ -57,14 +59,39 @@ private:
         SimpleMemBackend::handleMemResponse( id );
     }
 	struct Req {
-        Req( ReqId id, Addr addr, bool isWrite, unsigned numBytes ) :
-            id(id), addr(addr), isWrite(isWrite), numBytes(numBytes)
+        Req( ReqId id, Addr addr, bool isWrite, unsigned numBytes, Cycle_t arrival ) :
+            id(id), addr(addr), isWrite(isWrite), numBytes(numBytes), arrival(arrival)
         { }
 		ReqId id;
 		Addr addr;
 		bool isWrite;
 		unsigned numBytes;
+        Cycle_t arrival;
 	};
+
+    // Requests to a bank in arrival order, plus the requests to each row of the
+    // bank so that a hit to the open row is found without a search
+    struct BankQueue {
+        std::list<Req> reqs;
+        std::unordered_map<unsigned int, std::list<std::list<Req>::iterator> > rows;
+
+        void push( const Req& req, unsigned int row ) {
+            rows[row].push_back( reqs.insert( reqs.end(), req ) );
+        }
+        std::list<Req>::iterator findRow( unsigned int row ) {
+            std::unordered_map<unsigned int, std::list<std::list<Req>::iterator> >::iterator it = rows.find( row );
+            return it == rows.end() ? reqs.end() : it->second.front();
+        }
+        // The request is the oldest to its row, either from findRow or the oldest to the bank
+        void erase( std::list<Req>::iterator req, unsigned int row ) {
+            std::unordered_map<unsigned int, std::list<std::list<Req>::iterator> >::iterator it = rows.find( row );
+            it->second.pop_front();
+            if ( it->second.empty() )
+                rows.erase( it );
+            reqs.erase( req );
+        }
+    };
+
     SimpleMemBackend* backend;
     unsigned int maxReqsPerRow; // Maximum number of requests to issue per row before moving to a new row
     unsigned int banks;         // Number of banks we're issuing to
@@ -73,7 +100,9 @@ private:
     unsigned int rowOffset;     // Offset for determining request row
     unsigned int lineOffset;    // Offset for determining line (needed for finding bank)
     int reqsPerCycle;           // Number of requests to issue per cycle (max) -> memCtrl limits how many we accept
-    std::vector< std::list<Req>* > requestQueue;
+    Cycle_t starvationLimit;    // Cycles the oldest request to a bank can be bypassed for, 0 is unlimited
+    Cycle_t currentCycle;
+    std::vector<BankQueue> requestQueue;
     std::vector<unsigned int> reorderCount;
     std::vector<unsigned int> lastRow;
 
@@ -34,7 +34,7 @@ SimpleMemBackendConvertor::SimpleMemBackendConvertor(ComponentId_t id, Params &p
 bool SimpleMemBackendConvertor::issue( BaseReq* req ) {
     if (req->isMemEv()) {
         MemReq * mreq = static_cast<MemReq*>(req);
-        return static_cast<SimpleMemBackend*>(m_backend)->issueRequest( mreq->id(), mreq->addr(), mreq->isWrite(), m_backendRequestWidth );
+        return static_cast<SimpleMemBackend*>(m_backend)->issueRequest( mreq->id(), channelAddr(mreq->addr()), mreq->isWrite(), m_backendRequestWidth );
     } else {
         CustomReq * creq = static_cast<CustomReq*>(req);
         return static_cast<SimpleMemBackend*>(m_backend)->issueCustomRequest( creq->id(), creq->getInfo() );
@@ -24,7 +24,7 @@ bool TimingDRAM::Channel::m_printConfig = true;
 bool TimingDRAM::Rank::m_printConfig = true;
 bool TimingDRAM::Bank::m_printConfig = true;
 
-TimingDRAM::TimingDRAM(ComponentId_t id, Params &params) : SimpleMemBackend(id, params), m_cycle(0) {
+TimingDRAM::TimingDRAM(ComponentId_t id, Params &params) : SimpleMemBackend(id, params), m_cycle(0), m_profiler(nullptr) {
 
     int dram_id = params.find<int>("id", -1);
     assert( dram_id != -1 );
@@ -58,10 +58,27 @@ TimingDRAM::TimingDRAM(ComponentId_t id, Params &params) : SimpleMemBackend(id,
 
     m_mapper->setNumChannels( numChannels );
 
+    m_stats.refreshes = registerStatistic<uint64_t>("refreshes");
+    m_stats.refreshCycles = registerStatistic<uint64_t>("refreshCycles");
+    m_stats.rfmCommands = registerStatistic<uint64_t>("rfmCommands");
+    m_stats.rfmCycles = registerStatistic<uint64_t>("rfmCycles");
+    m_stats.victimRowRefreshes = registerStatistic<uint64_t>("victimRowRefreshes");
+    m_stats.mitigationCycles = registerStatistic<uint64_t>("mitigationCycles");
+
+    std::string profileFile = params.find<std::string>("profile_file", "");
+    if ( ! profileFile.empty() ) {
+        unsigned banks = params.find<unsigned>("channel.numRanks", 1) * params.find<unsigned>("channel.rank.numBanks", 8);
+        m_profiler = new MemProfiler( params.find<SimTime_t>("profile_window", 1000), numChannels, banks,
+                params.find<unsigned>("profile_delay_bins", 16), params.find<SimTime_t>("profile_delay_bin_width", 8) );
+        if ( ! m_profiler->open( profileFile ) ) {
+            output->fatal(CALL_INFO, -1, "Invalid param(%s): profile_file, cannot open '%s'.\n", getName().c_str(), profileFile.c_str());
+        }
+    }
+
     tmpParams = params.get_scoped_params("channel" );
     for ( unsigned i=0; i < numChannels; i++ ) {
         using std::placeholders::_1;
-        m_channels.push_back(loadComponentExtension<Channel>( std::bind(&TimingDRAM::handleResponse, this, _1), tmpParams, dram_id, i, output, m_mapper ));
+        m_channels.push_back(loadComponentExtension<Channel>( std::bind(&TimingDRAM::handleResponse, this, _1), tmpParams, dram_id, i, output, m_mapper, &m_stats, m_profiler ));
     }
 }
 
@@ -93,8 +110,9 @@ bool TimingDRAM::clock(Cycle_t cycle)
 // Channel
 //==================================================================================
 
-TimingDRAM::Channel::Channel( ComponentId_t id, std::function<void(ReqId)> handler, Params& params, unsigned mc, unsigned myNum, Output* output, AddrMapper* mapper ) :
-    ComponentExtension(id), m_responseHandler(handler), m_output( output ), m_mapper( mapper ), m_nextRankUp(0), m_dataBusAvailCycle(0)
+TimingDRAM::Channel::Channel( ComponentId_t id, std::function<void(ReqId)> handler, Params& params, unsigned mc, unsigned myNum, Output* output, AddrMapper* mapper, MaintenanceStats* stats, MemProfiler* profiler ) :
+    ComponentExtension(id), m_responseHandler(handler), m_output( output ), m_mapper( mapper ), m_nextRankUp(0), m_dataBusAvailCycle(0),
+    m_profiler( profiler ), m_chan( myNum )
 {
     std::ostringstream tmp;
     tmp << "@t:TimingDRAM:Channel:@p():@l:mc=" << mc << ":chan=" << myNum << ": ";
@@ -117,7 +135,7 @@ TimingDRAM::Channel::Channel( ComponentId_t id, std::function<void(ReqId)> handl
 
     Params tmpParams = params.get_scoped_params("rank" );
     for ( unsigned i=0; i<numRanks; i++ ) {
-        m_ranks.push_back( loadComponentExtension<Rank>( tmpParams, mc, myNum, i, output, mapper ) );
+        m_ranks.push_back( loadComponentExtension<Rank>( tmpParams, mc, myNum, i, output, mapper, stats, profiler ) );
     }
 }
 
@@ -170,6 +188,10 @@ void TimingDRAM::Channel::clock( SimTime_t cycle )
 
         m_dataBusAvailCycle = cmd->issue();
 
+        if ( m_profiler && cmd->getTrans() ) {
+            m_profiler->access( cycle, m_chan, cmd->getProfileBank(), cmd->getTrans()->isWrite, cmd->getTrans()->numBytes );
+        }
+
         m_issuedCmds.push_back(cmd);
     }
 }
@@ -180,6 +202,8 @@ TimingDRAM::Cmd* TimingDRAM::Channel::popCmd( SimTime_t cycle, SimTime_t dataBus
     unsigned current = m_nextRankUp;
     for ( unsigned i = 0; i < m_ranks.size(); i++ ) {
 
+        m_ranks[current]->checkRefresh( cycle );
+
         if (m_ranks[current]->hasActiveBanks()) {
             cmd = m_ranks[current]->popCmd( cycle, m_dataBusAvailCycle );
 
@@ -206,8 +230,8 @@ TimingDRAM::Cmd* TimingDRAM::Channel::popCmd( SimTime_t cycle, SimTime_t dataBus
 // Rank
 //==================================================================================
 
-TimingDRAM::Rank::Rank( ComponentId_t id, Params& params, unsigned mc, unsigned chan, unsigned myNum, Output* output, AddrMapper* mapper ) :
-    ComponentExtension(id), m_output( output ), m_mapper( mapper ), m_nextBankUp(0)
+TimingDRAM::Rank::Rank( ComponentId_t id, Params& params, unsigned mc, unsigned chan, unsigned myNum, Output* output, AddrMapper* mapper, MaintenanceStats* stats, MemProfiler* profiler ) :
+    ComponentExtension(id), m_output( output ), m_mapper( mapper ), m_nextBankUp(0), m_nextRefresh(0)
 {
     std::ostringstream tmp;
     tmp << "@t:TimingDRAM:Rank:@p():@l:mc=" << mc << ":chan=" << chan << ":rank=" << myNum <<": ";
@@ -226,7 +250,7 @@ TimingDRAM::Rank::Rank( ComponentId_t id, Params& params, unsigned mc, unsigned
 
     Params tmpParams = params.get_scoped_params("bank" );
     for ( unsigned i=0; i<banks; i++ ) {
-        m_banks.push_back( loadComponentExtension<Bank>( tmpParams, mc, chan, myNum, i, output ) );
+        m_banks.push_back( loadComponentExtension<Bank>( tmpParams, mc, chan, myNum, i, banks, output, stats, profiler ) );
     }
 }
 
@@ -264,8 +288,10 @@ TimingDRAM::Cmd* TimingDRAM::Rank::popCmd( SimTime_t cycle, SimTime_t dataBusAva
 // Bank
 //==================================================================================
 
-TimingDRAM::Bank::Bank( ComponentId_t id, Params& params, unsigned mc, unsigned chan, unsigned rank, unsigned myNum, Output* output ) :
-    ComponentExtension(id), m_output( output ), m_lastCmd(nullptr), m_bank(myNum), m_rank(rank), m_row( -1 )
+TimingDRAM::Bank::Bank( ComponentId_t id, Params& params, unsigned mc, unsigned chan, unsigned rank, unsigned myNum, unsigned numBanks, Output* output, MaintenanceStats* stats, MemProfiler* profiler ) :
+    ComponentExtension(id), m_output( output ), m_lastCmd(nullptr), m_bank(myNum), m_rank(rank), m_row( -1 ),
+    m_stats( stats ), m_mitigation( nullptr ), m_refreshPending( false ), m_raa( 0 ), m_victimRows( 0 ),
+    m_profiler( profiler ), m_chan( chan ), m_profileBank( rank * numBanks + myNum )
 {
     std::ostringstream tmp;
     tmp << "@t:TimingDRAM:Bank:@p():@l:mc=" << mc << ":chan=" << chan << ":rank=" << rank << ":bank=" << myNum <<": ";
@@ -285,6 +311,34 @@ TimingDRAM::Bank::Bank( ComponentId_t id, Params& params, unsigned mc, unsigned
     tmpParams = params.get_scoped_params("pagePolicy" );
     m_pagePolicy = loadAnonymousSubComponent<PagePolicy>(ppName, "pagePolicy", 0, ComponentInfo::INSERT_STATS, tmpParams);
 
+    std::string refreshMode = params.find<std::string>("refreshMode", "none");
+    m_tREFI = params.find<SimTime_t>("tREFI", 7800);
+    unsigned tRFCsb = params.find<unsigned>("tRFCsb", 130);
+    m_nextRefresh = std::numeric_limits<SimTime_t>::max();
+    if ( refreshMode == "allBank" ) {
+        m_tRFC = params.find<unsigned>("tRFC", 350);
+        m_nextRefresh = m_tREFI;
+    } else if ( refreshMode == "sameBank" ) {
+        // each bank takes its turn within the refresh interval
+        m_tRFC = tRFCsb;
+        m_nextRefresh = m_tREFI * (myNum + 1) / numBanks;
+    } else if ( refreshMode != "none" ) {
+        m_output->fatal(CALL_INFO, -1, "Invalid param: refreshMode - must be 'none', 'allBank' or 'sameBank'. You specified '%s'.\n", refreshMode.c_str());
+    }
+    if ( refreshMode != "none" && 0 == m_tREFI ) {
+        m_output->fatal(CALL_INFO, -1, "Invalid param: tREFI - must be at least 1.\n");
+    }
+
+    m_rfmThreshold = params.find<unsigned>("rfmThreshold", 0);
+    m_tRFM = params.find<unsigned>("tRFM", tRFCsb);
+    m_tVRR = params.find<unsigned>("tVRR", m_rcd_lat + m_trp_lat);
+
+    std::string rhName = params.find<std::string>("rowHammerMitigation", "");
+    if ( ! rhName.empty() ) {
+        tmpParams = params.get_scoped_params("rowHammerMitigation" );
+        m_mitigation = loadAnonymousSubComponent<RowHammerMitigation>(rhName, "rowHammerMitigation", 0, ComponentInfo::INSERT_STATS, tmpParams);
+    }
+
     if (m_printConfig)
         m_printConfig = params.find<bool>("printconfig", true);
     if ( m_printConfig ) {
@@ -295,6 +349,9 @@ TimingDRAM::Bank::Bank( ComponentId_t id, Params& params, unsigned mc, unsigned
         m_output->verbosePrefix(prefix(),CALL_INFO, 1, DBG_MASK, "dataCycles:   %d\n",m_data_lat);
         m_output->verbosePrefix(prefix(),CALL_INFO, 1, DBG_MASK, "transactionQ: %s\n",name.c_str());
         m_output->verbosePrefix(prefix(),CALL_INFO, 1, DBG_MASK, "pagePolicy:   %s\n",  ppName.c_str());
+        m_output->verbosePrefix(prefix(),CALL_INFO, 1, DBG_MASK, "refreshMode:  %s\n",  refreshMode.c_str());
+        if ( ! rhName.empty() )
+            m_output->verbosePrefix(prefix(),CALL_INFO, 1, DBG_MASK, "rowHammer:    %s\n",  rhName.c_str());
         m_printConfig = false;
     }
 }
@@ -316,6 +373,57 @@ TimingDRAM::Cmd* TimingDRAM::Bank::popCmd( SimTime_t cycle, SimTime_t dataBusAva
     return cmd;
 }
 
+/*
+ * Once the commands of the current transaction are queued, a due REF, RFM or
+ * victim row refresh closes the row and goes ahead of the next transaction.
+ * Returns true while one of them holds back the transaction queue.
+ */
+bool TimingDRAM::Bank::updateMaintenance( SimTime_t current )
+{
+    if ( current >= m_nextRefresh ) {
+        m_refreshPending = true;
+    }
+
+    if ( ! m_refreshPending && 0 == m_victimRows && ! isRFMDue() ) {
+        return false;
+    }
+    if ( ! m_cmdQ.empty() ) {
+        return true;
+    }
+
+    if ( m_row != -1 ) {
+        m_cmdQ.push_back( new Cmd( this, Cmd::PRE, m_trp_lat ) );
+        m_row = -1;
+    }
+
+    if ( m_refreshPending ) {
+        unsigned victims = m_mitigation ? m_mitigation->refresh( current ) : 0;
+        unsigned cycles = m_tRFC + victims * m_tVRR;
+        m_cmdQ.push_back( new Cmd( this, Cmd::REF, cycles ) );
+        m_stats->refreshes->addData(1);
+        m_stats->refreshCycles->addData(m_tRFC);
+        if ( victims ) {
+            m_stats->victimRowRefreshes->addData(victims);
+            m_stats->mitigationCycles->addData(victims * m_tVRR);
+        }
+        m_raa = m_raa > m_rfmThreshold ? m_raa - m_rfmThreshold : 0;
+        m_nextRefresh += m_tREFI;
+        m_refreshPending = false;
+    } else if ( isRFMDue() ) {
+        m_cmdQ.push_back( new Cmd( this, Cmd::RFM, m_tRFM ) );
+        m_stats->rfmCommands->addData(1);
+        m_stats->rfmCycles->addData(m_tRFM);
+        m_raa -= m_rfmThreshold;
+    } else {
+        unsigned cycles = m_victimRows * m_tVRR;
+        m_cmdQ.push_back( new Cmd( this, Cmd::VRR, cycles ) );
+        m_stats->victimRowRefreshes->addData(m_victimRows);
+        m_stats->mitigationCycles->addData(cycles);
+        m_victimRows = 0;
+    }
+    return true;
+}
+
 void TimingDRAM::Bank::update( SimTime_t current )
 {
     if ( nullptr == m_lastCmd && m_row != -1 && m_pagePolicy->shouldClose( current ) ) {
@@ -325,6 +433,10 @@ void TimingDRAM::Bank::update( SimTime_t current )
         return;
     }
 
+    if ( updateMaintenance( current ) ) {
+        return;
+    }
+
     Transaction* trans = m_transQ->pop(m_row);
 
     if ( ! trans ) {
@@ -335,6 +447,10 @@ void TimingDRAM::Bank::update( SimTime_t current )
         m_output->verbosePrefix(prefix(),CALL_INFO, 2, DBG_MASK, "addr=%#" PRIx64 " current row=%d trans row=%d, time=%" PRIu64 "\n",
                 trans->addr, m_row, trans->row, trans->createTime );
 
+    if ( m_profiler ) {
+        m_profiler->schedule( current, m_chan, m_profileBank, trans->row == m_row, current - trans->createTime );
+    }
+
     Cmd* cmd;
 
     if ( trans->row != m_row ) {
@@ -346,6 +462,13 @@ void TimingDRAM::Bank::update( SimTime_t current )
         cmd = new Cmd( this, Cmd::ACT, m_rcd_lat, trans->row );
         m_cmdQ.push_back(cmd);
         m_row = trans->row;
+
+        if ( m_rfmThreshold ) {
+            ++m_raa;
+        }
+        if ( m_mitigation ) {
+            m_victimRows += m_mitigation->activate( trans->row, current );
+        }
     }
 
     unsigned val = trans->isWrite ? m_col_wr_lat :  m_col_rd_lat;
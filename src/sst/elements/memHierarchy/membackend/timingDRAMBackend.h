@@ -13,6 +13,8 @@
 #ifndef _H_SST_MEMH_TIMING_DRAM_BACKEND
 #define _H_SST_MEMH_TIMING_DRAM_BACKEND
 
+#include <algorithm>
+#include <limits>
 #include <queue>
 
 #include <sst/core/componentExtension.h>
@@ -21,6 +23,8 @@
 #include "sst/elements/memHierarchy/membackend/timingAddrMapper.h"
 #include "sst/elements/memHierarchy/membackend/timingTransaction.h"
 #include "sst/elements/memHierarchy/membackend/timingPagePolicy.h"
+#include "sst/elements/memHierarchy/membackend/timingRowHammer.h"
+#include "sst/elements/memHierarchy/membackend/memProfiler.h"
 #include "sst/elements/memHierarchy/util.h"
 
 namespace SST {
@@ -53,11 +57,32 @@ public:
             {"channel.rank.bank.TRP", "Precharge delay in cycles", "11"},
             {"channel.rank.bank.dataCycles", "", "4"},
             {"channel.rank.bank.transactionQ", "Transaction queue model (subcomponent)", "memHierarchy.fifoTransactionQ"},
-            {"channel.rank.bank.pagePolicy", "Policy subcomponent for managing row buffer", "memHierarchy.simplePagePolicy"})
+            {"channel.rank.bank.pagePolicy", "Policy subcomponent for managing row buffer", "memHierarchy.simplePagePolicy"},
+            {"channel.rank.bank.refreshMode", "Refresh: 'none', 'allBank' (every bank of a rank every tREFI) or 'sameBank' (DDR5 REFsb, banks staggered over tREFI)", "none"},
+            {"channel.rank.bank.tREFI", "Refresh interval in cycles", "7800"},
+            {"channel.rank.bank.tRFC", "All-bank refresh time in cycles", "350"},
+            {"channel.rank.bank.tRFCsb", "Same-bank refresh time in cycles", "130"},
+            {"channel.rank.bank.rfmThreshold", "RFM: ACTs (RAAIMT) after which the bank gets a refresh management command. 0 disables RFM.", "0"},
+            {"channel.rank.bank.tRFM", "RFM command time in cycles", "tRFCsb"},
+            {"channel.rank.bank.tVRR", "Time in cycles to refresh one victim row for the RowHammer mitigation", "RCD+TRP"},
+            {"channel.rank.bank.rowHammerMitigation", "RowHammer mitigation subcomponent, e.g. memHierarchy.paraRowHammer, memHierarchy.grapheneRowHammer or memHierarchy.trrRowHammer. None if empty.", ""},
+            {"profile_file", "File to write the per channel and bank profile to (see memProfiler.h for the format). No profile if empty.", ""},
+            {"profile_window", "Profile window in cycles", "1000"},
+            {"profile_delay_bins", "Number of bins of the profile queueing delay histograms", "16"},
+            {"profile_delay_bin_width", "Width in cycles of the bins of the profile queueing delay histograms", "8"} )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+            {"refreshes", "REF commands issued", "commands", 1},
+            {"refreshCycles", "Bank cycles spent in REF", "cycles", 1},
+            {"rfmCommands", "RFM commands issued", "commands", 1},
+            {"rfmCycles", "Bank cycles spent in RFM", "cycles", 1},
+            {"victimRowRefreshes", "Victim rows refreshed by the RowHammer mitigation", "rows", 1},
+            {"mitigationCycles", "Bank cycles spent refreshing victim rows", "cycles", 1} )
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
             {"transactionQ", "Transaction queue model", "SST::MemHierarchy::TimingDRAM_NS::TransactionQ"},
-            {"pagePolicy", "Policy subcomponent for managing row buffer", "SST::MemHierarchy::TimingDRAM_NS::PagePolicy"} )
+            {"pagePolicy", "Policy subcomponent for managing row buffer", "SST::MemHierarchy::TimingDRAM_NS::PagePolicy"},
+            {"rowHammerMitigation", "RowHammer mitigation", "SST::MemHierarchy::TimingDRAM_NS::RowHammerMitigation"} )
 
 /* Begin class definition */
 private:
@@ -65,13 +90,23 @@ private:
 
     class Cmd;
 
+    // Bandwidth lost to refresh and RowHammer mitigation, shared by all banks
+    struct MaintenanceStats {
+        Statistic<uint64_t>* refreshes;
+        Statistic<uint64_t>* refreshCycles;
+        Statistic<uint64_t>* rfmCommands;
+        Statistic<uint64_t>* rfmCycles;
+        Statistic<uint64_t>* victimRowRefreshes;
+        Statistic<uint64_t>* mitigationCycles;
+    };
+
     class Bank : public ComponentExtension {
 
         static bool m_printConfig;
 
       public:
         static const uint64_t DBG_MASK = (1 << 3);
-        Bank( ComponentId_t, Params&, unsigned mc, unsigned chan, unsigned rank, unsigned bank, Output* );
+        Bank( ComponentId_t, Params&, unsigned mc, unsigned chan, unsigned rank, unsigned bank, unsigned numBanks, Output*, MaintenanceStats*, MemProfiler* );
 
         void pushTrans( Transaction* trans ) {
             m_transQ->push(trans);
@@ -102,14 +137,21 @@ private:
         }
 
         bool isIdle() {
-            return (m_row == -1 || !m_pagePolicy->canClose()) && m_cmdQ.empty() && m_transQ->empty();
+            return (m_row == -1 || !m_pagePolicy->canClose()) && m_cmdQ.empty() && m_transQ->empty()
+                && !m_refreshPending && 0 == m_victimRows && !isRFMDue();
         }
 
+        // cycle the next REF is due, the bank must be clocked from then on
+        SimTime_t getNextRefresh() { return m_nextRefresh; }
+
         unsigned getRank() { return m_rank; }
         unsigned getBank() { return m_bank; }
+        unsigned getProfileBank() { return m_profileBank; }
 
       private:
         void update( SimTime_t );
+        bool updateMaintenance( SimTime_t );
+        bool isRFMDue() { return 0 != m_rfmThreshold && m_raa >= m_rfmThreshold; }
         const char* prefix() { return m_pre.c_str(); }
 
         Output*             m_output;
@@ -128,11 +170,28 @@ private:
         std::deque<Cmd*>    m_cmdQ;
         TransactionQ*       m_transQ;
         PagePolicy*         m_pagePolicy;
+
+        // refresh, RFM and RowHammer mitigation
+        MaintenanceStats*   m_stats;
+        RowHammerMitigation* m_mitigation;
+        SimTime_t           m_tREFI;
+        unsigned            m_tRFC;
+        unsigned            m_tRFM;
+        unsigned            m_tVRR;
+        unsigned            m_rfmThreshold;
+        SimTime_t           m_nextRefresh;
+        bool                m_refreshPending;
+        unsigned            m_raa;          // rolling accumulated ACTs for RFM
+        unsigned            m_victimRows;   // victim rows waiting to be refreshed
+
+        MemProfiler*        m_profiler;
+        unsigned            m_chan;
+        unsigned            m_profileBank;  // bank within the channel
     };
 
     class Cmd {
       public:
-        enum Op { PRE, ACT, COL } m_op;
+        enum Op { PRE, ACT, COL, REF, RFM, VRR } m_op;
         Cmd( Bank* bank, Op op, unsigned cycles, unsigned row = -1, unsigned dataCycles = 0, Transaction* trans  = NULL  ) :
             m_bank(bank), m_op(op), m_cycles(cycles), m_row(row), m_dataCycles(dataCycles), m_trans(trans)
         {
@@ -146,6 +205,15 @@ private:
               case COL:
                 m_name = "COL";
                 break;
+              case REF:
+                m_name = "REF";
+                break;
+              case RFM:
+                m_name = "RFM";
+                break;
+              case VRR:
+                m_name = "VRR";
+                break;
             }
             if (mem_h_is_debug)
                 m_bank->verbose(__LINE__,__FUNCTION__,"new %s for rank=%d bank=%d row=%d\n",
@@ -193,6 +261,11 @@ private:
             m_finiTime = currentCycle + m_cycles;
             m_dataBusAvailCycle = dataBusAvailCycle;
 
+            // refresh and victim row refresh keep the bank busy but not the data bus
+            if ( m_op == REF || m_op == RFM || m_op == VRR ) {
+                return true;
+            }
+
             if ( m_finiTime >= dataBusAvailCycle ) {
                 m_finiTime += m_dataCycles;
                 m_dataBusAvailCycle = m_finiTime;
@@ -215,6 +288,7 @@ private:
         std::string& getName()  { return m_name; }
         unsigned getRank()      { return m_bank->getRank(); }
         unsigned getBank()      { return m_bank->getBank(); }
+        unsigned getProfileBank() { return m_bank->getProfileBank(); }
         unsigned getRow()       { return m_row; }
         Transaction* getTrans() { return m_trans; }
       private:
@@ -238,7 +312,7 @@ private:
       public:
         static const uint64_t DBG_MASK = (1 << 2);
 
-        Rank( ComponentId_t, Params&, unsigned mc, unsigned chan, unsigned rank, Output*, AddrMapper* );
+        Rank( ComponentId_t, Params&, unsigned mc, unsigned chan, unsigned rank, Output*, AddrMapper*, MaintenanceStats*, MemProfiler* );
 
         Cmd* popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle );
 
@@ -258,6 +332,22 @@ private:
             return !m_banksActive.empty();
         }
 
+        // wake up the banks that are due a refresh
+        void checkRefresh( SimTime_t cycle ) {
+            if ( cycle < m_nextRefresh ) {
+                return;
+            }
+            m_nextRefresh = std::numeric_limits<SimTime_t>::max();
+            for ( unsigned i = 0; i < m_banks.size(); i++ ) {
+                SimTime_t next = m_banks[i]->getNextRefresh();
+                if ( next <= cycle ) {
+                    m_banksActive.insert(i);
+                    next = cycle + 1;
+                }
+                m_nextRefresh = std::min( m_nextRefresh, next );
+            }
+        }
+
       private:
 
         const char* prefix() { return m_pre.c_str(); }
@@ -268,6 +358,7 @@ private:
         unsigned            m_nextBankUp;
         std::vector<Bank*>  m_banks;
         std::set<unsigned>  m_banksActive;
+        SimTime_t           m_nextRefresh;
     };
 
     class Channel : public ComponentExtension {
@@ -277,7 +368,7 @@ private:
       public:
         static const uint64_t DBG_MASK = (1 << 1);
 
-        Channel( ComponentId_t, std::function<void(ReqId)>, Params&, unsigned mc, unsigned chan, Output*, AddrMapper* );
+        Channel( ComponentId_t, std::function<void(ReqId)>, Params&, unsigned mc, unsigned chan, Output*, AddrMapper*, MaintenanceStats*, MemProfiler* );
 
         bool issue( SimTime_t createTime, ReqId id, Addr addr, bool isWrite, unsigned numBytes ) {
 
@@ -317,6 +408,9 @@ private:
         std::queue<Transaction*> m_retiredTrans;
 
         std::function<void(ReqId)> m_responseHandler;
+
+        MemProfiler*        m_profiler;
+        unsigned            m_chan;
     };
 
     static bool m_printConfig;
@@ -330,12 +424,18 @@ public:
         handleMemResponse( id );
     }
     virtual bool clock(Cycle_t cycle);
-    virtual void finish() {}
+    virtual void finish() {
+        if ( m_profiler ) {
+            m_profiler->close();
+        }
+    }
 
 private:
     std::vector<Channel*> m_channels;
     AddrMapper* m_mapper;
     SimTime_t   m_cycle;
+    MaintenanceStats m_stats;
+    MemProfiler* m_profiler;
 
 };
 
@@ -0,0 +1,215 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MEMH_TIMING_ROWHAMMER
+#define _H_SST_MEMH_TIMING_ROWHAMMER
+
+#include <unordered_map>
+
+#include <sst/core/subcomponent.h>
+#include <sst/core/rng/marsaglia.h>
+
+namespace SST {
+namespace MemHierarchy {
+namespace TimingDRAM_NS {
+
+/*
+ * RowHammer mitigation of a bank. The bank tells the mitigation about every
+ * ACT and REF, the mitigation answers with the number of victim rows to
+ * refresh, which the bank charges as victim row refresh time.
+ */
+class RowHammerMitigation : public SST::SubComponent {
+  public:
+    SST_ELI_REGISTER_SUBCOMPONENT_API(SST::MemHierarchy::TimingDRAM_NS::RowHammerMitigation)
+
+    RowHammerMitigation( ComponentId_t id, Params& params ) : SubComponent( id )  { }
+
+    // An ACT to row, returns the number of victim rows to refresh before the next ACT
+    virtual unsigned activate( unsigned row, SimTime_t current ) = 0;
+
+    // A REF, returns the number of victim rows refreshed along with it
+    virtual unsigned refresh( SimTime_t current ) { return 0; }
+};
+
+class PARA : public RowHammerMitigation {
+  public:
+/* Element Library Info */
+    SST_ELI_REGISTER_SUBCOMPONENT(PARA, "memHierarchy", "paraRowHammer", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "PARA, refreshes the neighbours of an activated row with a fixed probability", SST::MemHierarchy::TimingDRAM_NS::RowHammerMitigation)
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"probability", "Probability that an ACT refreshes the two neighbouring rows", "0.001"},
+            {"seed", "Seed of the random number generator", "1"} )
+
+/* Begin class definition */
+    PARA( ComponentId_t id, Params& params ) : RowHammerMitigation( id, params ),
+        m_rng( params.find<unsigned>("seed", 1), 1 ) {
+        m_probability = params.find<double>("probability", 0.001);
+    }
+
+    unsigned activate( unsigned row, SimTime_t current ) {
+        return m_rng.nextUniform() < m_probability ? 2 : 0;
+    }
+
+  protected:
+    double m_probability;
+    SST::RNG::MarsagliaRNG m_rng;
+};
+
+/*
+ * Graphene, counts ACTs with a Misra-Gries table, whose estimate is never
+ * below the real count, and refreshes the neighbours of a row every
+ * threshold ACTs. The table is reset once per refresh window.
+ */
+class Graphene : public RowHammerMitigation {
+  public:
+/* Element Library Info */
+    SST_ELI_REGISTER_SUBCOMPONENT(Graphene, "memHierarchy", "grapheneRowHammer", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Graphene, Misra-Gries counting of aggressor rows", SST::MemHierarchy::TimingDRAM_NS::RowHammerMitigation)
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"entries", "Number of counters in the table", "32"},
+            {"threshold", "ACTs to a row between refreshes of its neighbours", "1000"},
+            {"resetRefreshes", "REF commands per refresh window, the table is reset after each window", "8192"} )
+
+/* Begin class definition */
+    Graphene( ComponentId_t id, Params& params ) : RowHammerMitigation( id, params ),
+        m_spill(0), m_numRefreshes(0) {
+        m_entries = params.find<unsigned>("entries", 32);
+        m_threshold = params.find<uint64_t>("threshold", 1000);
+        m_resetRefreshes = params.find<unsigned>("resetRefreshes", 8192);
+        if ( 0 == m_entries || 0 == m_threshold ) {
+            getSimulationOutput().fatal(CALL_INFO, -1, "Invalid param(%s): entries and threshold must be at least 1.\n", getName().c_str());
+        }
+    }
+
+    unsigned activate( unsigned row, SimTime_t current ) {
+        std::unordered_map<unsigned, uint64_t>::iterator it = m_table.find( row );
+        if ( it == m_table.end() ) {
+            if ( m_table.size() < m_entries ) {
+                it = m_table.insert( std::make_pair( row, m_spill ) ).first;
+            } else {
+                // replace an entry that is no larger than the spill count
+                for ( it = m_table.begin(); it != m_table.end(); ++it ) {
+                    if ( it->second == m_spill ) {
+                        break;
+                    }
+                }
+                if ( it == m_table.end() ) {
+                    ++m_spill;
+                    return 0;
+                }
+                uint64_t count = it->second;
+                m_table.erase( it );
+                it = m_table.insert( std::make_pair( row, count ) ).first;
+            }
+        }
+        ++it->second;
+        return 0 == it->second % m_threshold ? 2 : 0;
+    }
+
+    unsigned refresh( SimTime_t current ) {
+        if ( ++m_numRefreshes >= m_resetRefreshes ) {
+            m_table.clear();
+            m_spill = 0;
+            m_numRefreshes = 0;
+        }
+        return 0;
+    }
+
+  protected:
+    unsigned m_entries;
+    uint64_t m_threshold;
+    unsigned m_resetRefreshes;
+    uint64_t m_spill;
+    unsigned m_numRefreshes;
+    std::unordered_map<unsigned, uint64_t> m_table;
+};
+
+/*
+ * In-DRAM target row refresh, samples the most activated rows and refreshes
+ * the neighbours of the most activated ones along with each REF.
+ */
+class TRR : public RowHammerMitigation {
+  public:
+/* Element Library Info */
+    SST_ELI_REGISTER_SUBCOMPONENT(TRR, "memHierarchy", "trrRowHammer", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Target row refresh, mitigates sampled aggressor rows on REF", SST::MemHierarchy::TimingDRAM_NS::RowHammerMitigation)
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"entries", "Number of rows the sampler tracks", "16"},
+            {"rowsPerRefresh", "Aggressor rows whose neighbours are refreshed with each REF", "1"},
+            {"threshold", "ACTs a sampled row needs before it is mitigated", "1"} )
+
+/* Begin class definition */
+    TRR( ComponentId_t id, Params& params ) : RowHammerMitigation( id, params ) {
+        m_entries = params.find<unsigned>("entries", 16);
+        m_rowsPerRefresh = params.find<unsigned>("rowsPerRefresh", 1);
+        m_threshold = params.find<uint64_t>("threshold", 1);
+        if ( 0 == m_entries ) {
+            getSimulationOutput().fatal(CALL_INFO, -1, "Invalid param(%s): entries must be at least 1.\n", getName().c_str());
+        }
+    }
+
+    unsigned activate( unsigned row, SimTime_t current ) {
+        std::unordered_map<unsigned, uint64_t>::iterator it = m_sampler.find( row );
+        if ( it != m_sampler.end() ) {
+            ++it->second;
+        } else {
+            if ( m_sampler.size() == m_entries ) {
+                m_sampler.erase( findMin() );
+            }
+            m_sampler[row] = 1;
+        }
+        return 0;
+    }
+
+    unsigned refresh( SimTime_t current ) {
+        unsigned rows = 0;
+        for ( unsigned i = 0; i < m_rowsPerRefresh && ! m_sampler.empty(); i++ ) {
+            std::unordered_map<unsigned, uint64_t>::iterator max = m_sampler.begin();
+            for ( std::unordered_map<unsigned, uint64_t>::iterator it = m_sampler.begin(); it != m_sampler.end(); ++it ) {
+                if ( it->second > max->second ) {
+                    max = it;
+                }
+            }
+            if ( max->second < m_threshold ) {
+                break;
+            }
+            m_sampler.erase( max );
+            rows += 2;
+        }
+        return rows;
+    }
+
+  protected:
+    std::unordered_map<unsigned, uint64_t>::iterator findMin() {
+        std::unordered_map<unsigned, uint64_t>::iterator min = m_sampler.begin();
+        for ( std::unordered_map<unsigned, uint64_t>::iterator it = m_sampler.begin(); it != m_sampler.end(); ++it ) {
+            if ( it->second < min->second ) {
+                min = it;
+            }
+        }
+        return min;
+    }
+
+    unsigned m_entries;
+    unsigned m_rowsPerRefresh;
+    uint64_t m_threshold;
+    std::unordered_map<unsigned, uint64_t> m_sampler;
+};
+
+}
+}
+}
+
+#endif
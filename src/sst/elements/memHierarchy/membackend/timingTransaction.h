@@ -14,6 +14,7 @@
 #define _H_SST_MEMH_TIMING_TRANSACTION
 
 #include <list>
+#include <unordered_map>
 
 #include <sst/core/subcomponent.h>
 
@@ -135,6 +136,72 @@ class ReorderTransactionQ : public TransactionQ {
     unsigned  windowCycles;
 };
 
+// Keeps the transactions of each row in their own bucket so the oldest hit to
+// the open row is found without walking the queue. A hit can bypass older
+// transactions while it arrived within windowCycles of the oldest one and
+// fewer than maxRowHits hits have bypassed it in a row.
+class RowBucketTransactionQ : public TransactionQ {
+
+  public:
+/* Element Library Info */
+    SST_ELI_REGISTER_SUBCOMPONENT(RowBucketTransactionQ, "memHierarchy", "rowBucketTransactionQ", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "row hit first transaction queue indexed by row", SST::MemHierarchy::TimingDRAM_NS::TransactionQ)
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"windowCycles", "Cycles a row hit may have arrived after the oldest transaction to bypass it", "10" },
+            {"maxRowHits", "Row hits in a row that may bypass the oldest transaction. 0 is unlimited.", "4" } )
+
+/* Begin class definition */
+
+    RowBucketTransactionQ( ComponentId_t id, Params& params ) : TransactionQ( id, params ), m_numBypass(0) {
+        windowCycles = params.find<unsigned int>("windowCycles", 10);
+        maxRowHits = params.find<unsigned int>("maxRowHits", 4);
+    }
+
+    virtual void push( Transaction* trans ) {
+        m_rows[trans->row].push_back( m_transQ.insert( m_transQ.end(), trans ) );
+    }
+
+    virtual Transaction* pop( unsigned row ) {
+
+        if ( m_transQ.empty() ) {
+            return NULL;
+        }
+
+        std::list<Transaction*>::iterator oldest = m_transQ.begin();
+        std::list<Transaction*>::iterator pick = oldest;
+
+        if ( (*oldest)->row != row && ( 0 == maxRowHits || m_numBypass < maxRowHits ) ) {
+            std::unordered_map<unsigned, std::list<std::list<Transaction*>::iterator> >::iterator bucket = m_rows.find( row );
+            if ( bucket != m_rows.end() && (*oldest)->createTime + windowCycles > (*bucket->second.front())->createTime ) {
+                pick = bucket->second.front();
+            }
+        }
+
+        if ( pick == oldest ) {
+            m_numBypass = 0;
+        } else {
+            ++m_numBypass;
+        }
+
+        Transaction* trans = *pick;
+        std::unordered_map<unsigned, std::list<std::list<Transaction*>::iterator> >::iterator bucket = m_rows.find( trans->row );
+        bucket->second.pop_front();
+        if ( bucket->second.empty() ) {
+            m_rows.erase( bucket );
+        }
+        m_transQ.erase( pick );
+        return trans;
+    }
+
+  private:
+
+    unsigned  windowCycles;
+    unsigned  maxRowHits;
+    unsigned  m_numBypass;
+    std::unordered_map<unsigned, std::list<std::list<Transaction*>::iterator> > m_rows;
+};
+
 }
 }
 }
@@ -192,11 +192,41 @@ MemCacheController::MemCacheController(ComponentId_t id, Params &params) : Compo
                 getName().c_str(), memSize_, lineSize_);
     cache_.resize(cachesize, CacheState(0,I));
 
+    /* Organisation */
+    std::string organization = params.find<std::string>("organization", "alloy");
+    tagBytes_ = params.find<uint64_t>("tag_bytes", 8);
+    sectorLines_ = 1;
+    if (organization == "alloy") {
+        organization_ = Organization::ALLOY;
+    } else if (organization == "sector") {
+        organization_ = Organization::SECTOR;
+        uint64_t sectorSize = params.find<uint64_t>("sector_size", 2048);
+        sectorLines_ = sectorSize / lineSize_;
+        if (sectorSize % lineSize_ != 0 || sectorLines_ == 0 || sectorLines_ > 64 || cachesize % sectorLines_ != 0)
+            out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: sector_size. Must be a multiple of cache_line_size (%" PRIu64 "), at most 64 lines, and divide the cache size. You specified: %" PRIu64 "\n",
+                    getName().c_str(), lineSize_, sectorSize);
+        footprintTable_.resize(params.find<size_t>("footprint_table_entries", 0), std::make_pair(0, 0));
+    } else {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: organization. Must be 'alloy' or 'sector'. You specified: %s\n",
+                getName().c_str(), organization.c_str());
+    }
+    sectors_.resize(cachesize / sectorLines_);
+    tagCacheSize_ = params.find<size_t>("tag_cache_entries", 0);
+
     /* Statistics */
     statReadHit = registerStatistic<uint64_t>("CacheHits_Read");
     statReadMiss = registerStatistic<uint64_t>("CacheMisses_Read");
     statWriteHit = registerStatistic<uint64_t>("CacheHits_Write");
     statWriteMiss = registerStatistic<uint64_t>("CacheMisses_Write");
+    statDemandBytes = registerStatistic<uint64_t>("DemandBytes");
+    statLocalRead = registerStatistic<uint64_t>("LocalBytes_Read");
+    statLocalWrite = registerStatistic<uint64_t>("LocalBytes_Write");
+    statRemoteRead = registerStatistic<uint64_t>("RemoteBytes_Read");
+    statRemoteWrite = registerStatistic<uint64_t>("RemoteBytes_Write");
+    statTagCacheHit = registerStatistic<uint64_t>("TagCache_Hits");
+    statTagCacheMiss = registerStatistic<uint64_t>("TagCache_Misses");
+    statSectorEvict = registerStatistic<uint64_t>("SectorEvictions");
+    statFootprintFill = registerStatistic<uint64_t>("FootprintFills");
 
 }
 
@@ -247,7 +277,10 @@ void MemCacheController::handleEvent(SST::Event* event) {
             break;
         case Command::GetXResp:
         case Command::GetSResp:
-            handleDataResponse(ev);
+            if (fills_.find(ev->getID()) != fills_.end())
+                handleFootprintFill(ev);
+            else
+                handleDataResponse(ev);
             break;
         default:
             out.fatal(CALL_INFO,-1,"Memory cache controller received unrecognized command: %s", CommandString[(int)cmd]);
@@ -271,15 +304,17 @@ void MemCacheController::handleRead(MemEvent* event, bool replay) {
                 StateString[blockState]);
     }
 
+    Addr unit = tagUnit(cacheIndex);
     if (!replay) {
         MemAccessRecord rec;
         rec.event = event;
         outstandingEvents_.insert(std::make_pair(event->getID(), rec));
-        mshr_[cacheIndex].push(event->getID());
+        mshr_[unit].push(event->getID());
+        statDemandBytes->addData(event->getSize());
     }
     std::map<SST::Event::id_type, MemAccessRecord>::iterator it = outstandingEvents_.find(event->getID());
 
-    if (mshr_.find(cacheIndex)->second.front() != event->getID()) {         // Transition
+    if (mshr_.find(unit)->second.front() != event->getID()) {               // Transition
         it->second.status = AccessStatus::STALL;
         if (mem_h_is_debug_event(event))
             mem_h_debug_output(_L3_, "%" PRIu64 " (%s) StateTransition %" PRIu64 ", STALL\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
@@ -292,10 +327,18 @@ void MemCacheController::handleRead(MemEvent* event, bool replay) {
     } else {                                                                // HIT
         statReadHit->addData(1);
         it->second.status = AccessStatus::HIT;
+        sectors_[unit].touched |= sectorBit(cacheIndex);
         if (mem_h_is_debug_event(event))
             mem_h_debug_output(_L3_, "%" PRIu64 " (%s) StateTransition %" PRIu64 ", HIT\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
     }
 
+    /* A clean miss whose tag is on chip goes straight to remote memory */
+    if (probeTagCache(unit) && it->second.status == AccessStatus::MISS) {
+        issueMiss(it);
+        return;
+    }
+
+    statLocalRead->addData(lineSize_ + tagBytes_);
     it->second.reqev = new MemEvent(*event);
     it->second.reqev->setBaseAddr(cacheIndex);
     it->second.reqev->setAddr(event->getAddr() - event->getBaseAddr() + cacheIndex);
@@ -312,15 +355,17 @@ void MemCacheController::handleWrite(MemEvent* event, bool replay) {
     if (mem_h_is_debug_event(event))
         mem_h_debug_output(_L3_, "\n%" PRIu64 " (%s) handleWrite, Line: %" PRIu64 ", 0x%" PRIx64 ", %s\n", getCurrentSimTimeNano(), getName().c_str(), cacheIndex, blockAddr, StateString[blockState]);
 
+    Addr unit = tagUnit(cacheIndex);
     if (!replay) {
         MemAccessRecord rec;
         rec.event = event;
         outstandingEvents_.insert(std::make_pair(event->getID(), rec));
-        mshr_[cacheIndex].push(event->getID());
+        mshr_[unit].push(event->getID());
+        statDemandBytes->addData(event->getSize());
     }
     std::map<SST::Event::id_type, MemAccessRecord>::iterator it = outstandingEvents_.find(event->getID());
 
-    if (mshr_.find(cacheIndex)->second.front() != event->getID()) {         // Transition
+    if (mshr_.find(unit)->second.front() != event->getID()) {               // Transition
         it->second.status = AccessStatus::STALL;
         if (mem_h_is_debug_event(event))
             mem_h_debug_output(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", STALL\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
@@ -334,11 +379,28 @@ void MemCacheController::handleWrite(MemEvent* event, bool replay) {
     } else {                                                                // HIT
         statWriteHit->addData(1);
         it->second.status = AccessStatus::HIT_TAG;
+        sectors_[unit].touched |= sectorBit(cacheIndex);
         if (mem_h_is_debug_event(event))
             mem_h_debug_output(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", HIT\n", getCurrentSimTimeNano(), getName().c_str(), event->getID().first);
     }
 
+    /* With the tag on chip a write hit is a single write and a clean miss goes straight to remote memory */
+    if (probeTagCache(unit)) {
+        if (it->second.status == AccessStatus::HIT_TAG) {
+            it->second.reqev = new MemEvent(*event);
+            it->second.status = AccessStatus::HIT;
+            cache_[cacheIndex].state = M;
+            statLocalWrite->addData(lineSize_ + tagBytes_);
+            memBackendConvertor_->handleMemEvent(event);
+            return;
+        } else if (it->second.status == AccessStatus::MISS) {
+            issueMiss(it);
+            return;
+        }
+    }
+
     /* Lookup tag data -> required whether or not this is a hit */
+    statLocalRead->addData(lineSize_ + tagBytes_);
     it->second.reqev = new MemEvent(*event);
     it->second.reqev->setBaseAddr(cacheIndex);
     it->second.reqev->setAddr(event->getAddr() - event->getBaseAddr() + cacheIndex);
@@ -374,12 +436,13 @@ void MemCacheController::handleDataResponse(MemEvent* event) {
     it->second.reqev->setAddr(cacheIndex);
     it->second.reqev->setBaseAddr(cacheIndex);
     it->second.reqev->setCmd(Command::PutM);
-    it->second.reqev->setPayload(event->getPayload());
+    it->second.reqev->sharePayload(event);
     it->second.reqev->clearFlag();
     it->second.reqev->setFlag(MemEvent::F_NORESPONSE);
     it->second.status = AccessStatus::FIN;
     if (mem_h_is_debug_event(event))
         mem_h_debug_output(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", FIN\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
+    statLocalWrite->addData(lineSize_ + tagBytes_);
     memBackendConvertor_->handleMemEvent(it->second.reqev);
 
     // Update backing store from the request that missed if it was a write
@@ -400,6 +463,12 @@ void MemCacheController::handleDataResponse(MemEvent* event) {
 
 /* Response from memory cache */
 void MemCacheController::handleLocalMemResponse( Event::id_type id, uint32_t flags) {
+    std::map<SST::Event::id_type, std::pair<SST::Event::id_type, MemEvent*> >::iterator fill = fills_.find(id);
+    if (fill != fills_.end()) {
+        finishFootprintFill(fill);
+        return;
+    }
+
     std::map<SST::Event::id_type,MemAccessRecord>::iterator it = outstandingEvents_.find(id);
     if (it == outstandingEvents_.end())
         out.fatal(CALL_INFO, -1, "%s, MemoryCache received unrecognized response ID: %" PRIu64 ", %" PRIu32 "", getName().c_str(), id.first, id.second);
@@ -432,37 +501,17 @@ void MemCacheController::handleLocalMemResponse( Event::id_type id, uint32_t fla
         mem_h_debug_output(_L3_, "\n%" PRIu64 " (%s) handleLocalResponse, Line: %" PRIu64 ", 0x%" PRIx64 ", %s\n",
                 getCurrentSimTimeNano(), getName().c_str(), cacheIndex, blockAddr, StateString[blockState]);
 
-    MemEvent * remoteRd, *remoteWr;
-    Addr localIndex;
     switch (it->second.status) {
         case AccessStatus::MISS_WB:
-            /* Write back data to memory */
-            remoteWr = new MemEvent(getName(), blockAddr, blockAddr, Command::PutM, lineSize_);
-            readData(remoteWr);
-            remoteWr->setFlag(MemEvent::F_NORESPONSE); // Don't send a response to this
-            remoteWr->setDst(link_->getTargetDestination(remoteWr->getBaseAddr()));
-            link_->send(remoteWr);
         case AccessStatus::MISS:
-            /* Read new data from memory */
-            remoteRd = new MemEvent(*ev);
-            remoteRd->setCmd(Command::GetS);
-            remoteRd->setSrc(getName());
-            remoteRd->setDst(link_->getTargetDestination(remoteRd->getBaseAddr()));
-            if (remoteRd->queryFlag(MemEvent::F_NORESPONSE))
-                remoteRd->clearFlag(MemEvent::F_NORESPONSE);
-            it->second.reqev = remoteRd;
-            link_->send(remoteRd);
-            it->second.status = AccessStatus::DATA; // We've request data, waiting for response
-            if (mem_h_is_debug_event(it->second.event))
-                mem_h_debug_output(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", DATA\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
-            cache_[cacheIndex].addr = ev->getBaseAddr();
-            cache_[cacheIndex].state = IM;
+            issueMiss(it);
             break;
         case AccessStatus::HIT_TAG: // tag hit, issue write
             it->second.reqev = new MemEvent(*ev);
             it->second.status = AccessStatus::HIT;
             if (mem_h_is_debug_event(it->second.event))
                 mem_h_debug_output(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", HIT\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
+            statLocalWrite->addData(lineSize_ + tagBytes_);
             memBackendConvertor_->handleMemEvent(ev);
             cache_[cacheIndex].state = M;
             break;
@@ -475,15 +524,13 @@ void MemCacheController::handleLocalMemResponse( Event::id_type id, uint32_t fla
                 sendResponse(ev, flags);
             }
         case AccessStatus::FIN: // Just finished updating the cache, ready for new requests now
-            if (mem_h_is_debug_event(it->second.event))
-                mem_h_debug_output(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", ERASE\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
-            delete ev;
-            mshr_[cacheIndex].pop();
-            outstandingEvents_.erase(it);
-            if (mshr_[cacheIndex].empty())
-                mshr_.erase(cacheIndex);
-            else
-                retry(cacheIndex);
+            if (it->second.pendingFills != 0) {
+                it->second.status = AccessStatus::FOOTPRINT; // Rest of the sector is still filling
+                if (mem_h_is_debug_event(it->second.event))
+                    mem_h_debug_output(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", FOOTPRINT\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
+                break;
+            }
+            releaseAccess(it);
             break;
         default:
             out.fatal(CALL_INFO, -1, "%s, MemoryCache encountered unhandled record status. Event is %s\n",
@@ -491,8 +538,175 @@ void MemCacheController::handleLocalMemResponse( Event::id_type id, uint32_t fla
     }
 }
 
-void MemCacheController::retry(uint64_t cacheIndex) {
-    MemEvent* ev = outstandingEvents_.find(mshr_[cacheIndex].front())->second.event;
+/* Read the line from remote memory, writing back the victim first if it is dirty */
+void MemCacheController::issueMiss(std::map<SST::Event::id_type, MemAccessRecord>::iterator it) {
+    MemEvent * ev = it->second.event;
+    Addr cacheIndex = toLocalAddr(ev->getBaseAddr());
+
+    if (it->second.status == AccessStatus::MISS_WB)
+        writebackLine(cache_[cacheIndex].addr);
+
+    if (organization_ == Organization::SECTOR)
+        allocateSector(it, cacheIndex);
+
+    /* Read new data from memory */
+    MemEvent * remoteRd = new MemEvent(*ev);
+    remoteRd->setCmd(Command::GetS);
+    remoteRd->setSrc(getName());
+    remoteRd->setDst(link_->getTargetDestination(remoteRd->getBaseAddr()));
+    if (remoteRd->queryFlag(MemEvent::F_NORESPONSE))
+        remoteRd->clearFlag(MemEvent::F_NORESPONSE);
+    it->second.reqev = remoteRd;
+    statRemoteRead->addData(lineSize_);
+    link_->send(remoteRd);
+    it->second.status = AccessStatus::DATA; // We've request data, waiting for response
+    if (mem_h_is_debug_event(it->second.event))
+        mem_h_debug_output(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", DATA\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
+    cache_[cacheIndex].addr = ev->getBaseAddr();
+    cache_[cacheIndex].state = IM;
+}
+
+void MemCacheController::writebackLine(Addr blockAddr) {
+    MemEvent * remoteWr = new MemEvent(getName(), blockAddr, blockAddr, Command::PutM, lineSize_);
+    readData(remoteWr);
+    remoteWr->setFlag(MemEvent::F_NORESPONSE); // Don't send a response to this
+    remoteWr->setDst(link_->getTargetDestination(remoteWr->getBaseAddr()));
+    statRemoteWrite->addData(lineSize_);
+    link_->send(remoteWr);
+}
+
+/*
+ * Make the demand line's sector resident. Replacing another sector writes back its dirty lines and
+ * invalidates the rest, and records which lines it used so the footprint can be fetched next time.
+ * The demand access holds the sector (its MSHR queue) until the footprint fills finish.
+ */
+void MemCacheController::allocateSector(std::map<SST::Event::id_type, MemAccessRecord>::iterator it, Addr cacheIndex) {
+    Addr unit = tagUnit(cacheIndex);
+    Addr tag = sectorTag(it->second.event->getBaseAddr());
+    SectorState& sector = sectors_[unit];
+
+    if (!sector.valid || sector.tag != tag) {
+        if (sector.valid) {
+            statSectorEvict->addData(1);
+            if (!footprintTable_.empty())
+                footprintTable_[sector.tag % footprintTable_.size()] = std::make_pair(sector.tag, sector.touched);
+            for (Addr index = unit * sectorLines_; index < (unit + 1) * sectorLines_; index++) {
+                if (index == cacheIndex) // Written back by the miss itself
+                    continue;
+                if (cache_[index].state == M) {
+                    statLocalRead->addData(lineSize_); // Victim read, not timed
+                    writebackLine(cache_[index].addr);
+                }
+                cache_[index].state = I;
+            }
+        }
+        sector.valid = true;
+        sector.tag = tag;
+        sector.touched = 0;
+
+        if (!footprintTable_.empty()) {
+            std::pair<Addr, uint64_t>& history = footprintTable_[tag % footprintTable_.size()];
+            uint64_t predicted = (history.first == tag) ? history.second & ~sectorBit(cacheIndex) : 0;
+            for (uint64_t line = 0; line < sectorLines_; line++) {
+                Addr lineAddr = (tag * sectorLines_ + line) << lineOffset_;
+                if ((predicted & (1ULL << line)) && isRequestAddressValid(lineAddr))
+                    issueFootprintFill(it, lineAddr);
+            }
+        }
+    }
+    sector.touched |= sectorBit(cacheIndex);
+}
+
+void MemCacheController::issueFootprintFill(std::map<SST::Event::id_type, MemAccessRecord>::iterator it, Addr lineAddr) {
+    Addr cacheIndex = toLocalAddr(lineAddr);
+    MemEvent * fill = new MemEvent(getName(), lineAddr, lineAddr, Command::GetS, lineSize_);
+    fill->setDst(link_->getTargetDestination(lineAddr));
+
+    fills_.insert(std::make_pair(fill->getID(), std::make_pair(it->first, (MemEvent*)nullptr)));
+    it->second.pendingFills++;
+    cache_[cacheIndex].addr = lineAddr;
+    cache_[cacheIndex].state = IM;
+
+    statFootprintFill->addData(1);
+    statRemoteRead->addData(lineSize_);
+    link_->send(fill);
+}
+
+/* Footprint data arrived from remote memory, write it into the cache */
+void MemCacheController::handleFootprintFill(MemEvent* event) {
+    std::map<SST::Event::id_type, std::pair<SST::Event::id_type, MemEvent*> >::iterator fill = fills_.find(event->getID());
+    Addr cacheIndex = toLocalAddr(event->getBaseAddr());
+
+    if (mem_h_is_debug_event(event))
+        mem_h_debug_output(_L3_, "\n%" PRIu64 " (%s) handleFootprintFill, Line: %" PRIu64 ", 0x%" PRIx64 "\n",
+                getCurrentSimTimeNano(), getName().c_str(), cacheIndex, event->getBaseAddr());
+
+    if (backing_)
+        writeData(event);
+
+    MemEvent * local = new MemEvent(*event);
+    local->setAddr(cacheIndex);
+    local->setBaseAddr(cacheIndex);
+    local->setCmd(Command::PutM);
+    local->sharePayload(event);
+    local->clearFlag();
+    local->setFlag(MemEvent::F_NORESPONSE);
+    fill->second.second = local;
+    cache_[cacheIndex].state = E;
+
+    statLocalWrite->addData(lineSize_ + tagBytes_);
+    memBackendConvertor_->handleMemEvent(local);
+    delete event;
+}
+
+void MemCacheController::finishFootprintFill(std::map<SST::Event::id_type, std::pair<SST::Event::id_type, MemEvent*> >::iterator fill) {
+    std::map<SST::Event::id_type, MemAccessRecord>::iterator it = outstandingEvents_.find(fill->second.first);
+    delete fill->second.second;
+    fills_.erase(fill);
+
+    it->second.pendingFills--;
+    if (it->second.pendingFills == 0 && it->second.status == AccessStatus::FOOTPRINT)
+        releaseAccess(it);
+}
+
+/* Access is complete, let the next one for the same tag unit go */
+void MemCacheController::releaseAccess(std::map<SST::Event::id_type, MemAccessRecord>::iterator it) {
+    Addr unit = tagUnit(toLocalAddr(it->second.event->getBaseAddr()));
+    if (mem_h_is_debug_event(it->second.event))
+        mem_h_debug_output(_L3_, "\n%" PRIu64 " (%s) StateTransition %" PRIu64 ", ERASE\n", getCurrentSimTimeNano(), getName().c_str(), it->second.event->getID().first);
+    delete it->second.event;
+    mshr_[unit].pop();
+    outstandingEvents_.erase(it);
+    if (mshr_[unit].empty())
+        mshr_.erase(unit);
+    else
+        retry(unit);
+}
+
+/* Look up the SRAM tag cache, inserting the unit on a miss since the probe that follows brings its tag on chip */
+bool MemCacheController::probeTagCache(Addr unit) {
+    if (tagCacheSize_ == 0)
+        return false;
+
+    std::unordered_map<Addr, std::list<Addr>::iterator>::iterator entry = tagCacheMap_.find(unit);
+    if (entry != tagCacheMap_.end()) {
+        tagCache_.splice(tagCache_.begin(), tagCache_, entry->second);
+        statTagCacheHit->addData(1);
+        return true;
+    }
+
+    if (tagCache_.size() == tagCacheSize_) {
+        tagCacheMap_.erase(tagCache_.back());
+        tagCache_.pop_back();
+    }
+    tagCache_.push_front(unit);
+    tagCacheMap_[unit] = tagCache_.begin();
+    statTagCacheMiss->addData(1);
+    return false;
+}
+
+void MemCacheController::retry(uint64_t unit) {
+    MemEvent* ev = outstandingEvents_.find(mshr_[unit].front())->second.event;
 
     if (mem_h_is_debug_event(ev)) {
         mem_h_debug_output(_L3_, "\n%" PRIu64 " (%s) Retrying: %s\n", getCurrentSimTimeNano(), getName().c_str(), ev->getVerboseString(dlevel).c_str());
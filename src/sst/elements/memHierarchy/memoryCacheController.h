@@ -16,6 +16,9 @@
 #ifndef MEMHIERARCHY_MEMORYCACHECONTROLLER_H
 #define MEMHIERARCHY_MEMORYCACHECONTROLLER_H
 
+#include <list>
+#include <unordered_map>
+
 #include <sst/core/sst_types.h>
 
 #include <sst/core/component.h>
@@ -45,6 +48,11 @@ public:
             {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
+            {"organization",        "(string) Cache organisation. 'alloy': direct-mapped, tag and data read together in one access. 'sector': lines are grouped into sectors that share one tag and are filled one line at a time", "alloy"},\
+            {"tag_bytes",           "(uint) Tag bytes transferred with each line on a cache access. Only affects the bandwidth statistics", "8"},\
+            {"sector_size",         "(uint) Sector organisation: bytes per sector. Must be a multiple of cache_line_size, at most 64 lines, and divide the cache size", "2048"},\
+            {"footprint_table_entries", "(uint) Sector organisation: remember which lines of a sector were used during its last residency and fetch them all when it is reallocated. 0 fetches only the demand line", "0"},\
+            {"tag_cache_entries",   "(uint) Entries in an SRAM tag cache (one per line for alloy, per sector for sector). A hit lets clean misses and write hits skip the tag probe. 0 disables", "0"},\
             {"verbose",             "(uint) Output verbosity for warnings/errors. 0[fatal error only], 1[warnings], 2[full state dump on fatal error]","1"},\
             {"debug",               "(uint) 0: No debugging, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},\
             {"debug_level",         "(uint) Debugging level: 0 to 10. Must configure sst-core with '--enable-debug'. 1=info, 2-10=debug output", "0"},\
@@ -57,6 +65,15 @@ public:
             {"CacheHits_Write",  "Number of write hits", "count", 1},
             {"CacheMisses_Read",  "Number of read misses", "count", 1},
             {"CacheMisses_Write",  "Number of write misses", "count", 1},
+            {"DemandBytes",        "Bytes requested by the CPU side. Total traffic divided by this is the bandwidth bloat", "bytes", 1},
+            {"LocalBytes_Read",    "Bytes read from the cache (tag probes and victim reads)", "bytes", 1},
+            {"LocalBytes_Write",   "Bytes written to the cache (fills and write hits)", "bytes", 1},
+            {"RemoteBytes_Read",   "Bytes read from remote memory (demand and footprint fills)", "bytes", 1},
+            {"RemoteBytes_Write",  "Bytes written back to remote memory", "bytes", 1},
+            {"TagCache_Hits",      "Accesses whose tag was found in the SRAM tag cache", "count", 1},
+            {"TagCache_Misses",    "Accesses that had to probe the tag in the cache", "count", 1},
+            {"SectorEvictions",    "Sector organisation: resident sectors replaced by a new one", "count", 1},
+            {"FootprintFills",     "Sector organisation: lines fetched because the footprint predicted them", "count", 1},
             )
 
 #define MEMCACHE_ELI_SUBCOMPONENTSLOTS {"backend", "Memory controller and/or memory timing model.", "SST::MemHierarchy::MemBackend"},\
@@ -97,21 +114,23 @@ protected:
      *  MISS_WB: The lookup will be a miss and require a writeback; the current access is to check the tag
      *  STALL: Another access for the same line is outstanding, stall until it finishes -> may not actually be how MCDRAM works...
      *  DATA: Sent a request for data to the remote memroy
+     *  FOOTPRINT: Done, but footprint fills for the sector are still outstanding so hold the sector until they finish
      */
-    enum class AccessStatus { HIT, HIT_TAG, MISS, MISS_WB, DATA, STALL, FIN };
+    enum class AccessStatus { HIT, HIT_TAG, MISS, MISS_WB, DATA, STALL, FIN, FOOTPRINT };
 
     struct MemAccessRecord {
         MemEvent* event;
         AccessStatus status;
         MemEvent* reqev;
+        uint32_t pendingFills;
 
-        MemAccessRecord() : event(nullptr), status(AccessStatus::MISS), reqev(nullptr) { }
-        MemAccessRecord(MemEvent* ev, AccessStatus stat) : event(ev), status(stat), reqev(nullptr) { }
+        MemAccessRecord() : event(nullptr), status(AccessStatus::MISS), reqev(nullptr), pendingFills(0) { }
+        MemAccessRecord(MemEvent* ev, AccessStatus stat) : event(ev), status(stat), reqev(nullptr), pendingFills(0) { }
     };
 
     std::map<SST::Event::id_type, MemAccessRecord> outstandingEvents_;
 
-    std::map<uint64_t, std::queue<SST::Event::id_type> > mshr_;
+    std::map<uint64_t, std::queue<SST::Event::id_type> > mshr_; // Indexed by tag unit: a line for alloy, a sector for sector
 
     struct CacheState {
         Addr addr;
@@ -123,6 +142,35 @@ protected:
     Addr lineSize_;
     Addr lineOffset_;
 
+    /* Organisation */
+    enum class Organization { ALLOY, SECTOR };
+    Organization organization_;
+    uint64_t tagBytes_;
+    uint64_t sectorLines_;  // Lines that share a tag; 1 for alloy
+
+    struct SectorState {
+        Addr tag;           // Sector number of the resident sector
+        bool valid;
+        uint64_t touched;   // Lines accessed during this residency
+        SectorState() : tag(0), valid(false), touched(0) { }
+    };
+    std::vector<SectorState> sectors_;
+
+    /* Footprint predictor, direct-mapped by sector number: (sector, lines used during its last residency) */
+    std::vector<std::pair<Addr, uint64_t> > footprintTable_;
+
+    /* Outstanding footprint fills: fill ID -> (demand access that allocated the sector, local write once data arrives) */
+    std::map<SST::Event::id_type, std::pair<SST::Event::id_type, MemEvent*> > fills_;
+
+    /* SRAM tag cache: tag units whose tag is held on chip, most recently used first */
+    size_t tagCacheSize_;
+    std::list<Addr> tagCache_;
+    std::unordered_map<Addr, std::list<Addr>::iterator> tagCacheMap_;
+
+    Addr tagUnit(Addr cacheIndex) { return cacheIndex / sectorLines_; }
+    Addr sectorTag(Addr addr) { return (addr >> lineOffset_) / sectorLines_; }
+    uint64_t sectorBit(Addr cacheIndex) { return 1ULL << (cacheIndex % sectorLines_); }
+
     void notifyListeners( MemEvent* ev ) {
         if (  ! listeners_.empty()) {
             // AFR: should this pass the base Addr?
@@ -144,7 +192,16 @@ protected:
     void handleWrite(MemEvent* ev, bool replay);
     void handleFlush(MemEvent* ev);
     void handleDataResponse(MemEvent* ev);
-    void retry(Addr cacheIndex);
+    void retry(Addr unit);
+
+    void issueMiss(std::map<SST::Event::id_type, MemAccessRecord>::iterator it);
+    void writebackLine(Addr blockAddr);
+    void allocateSector(std::map<SST::Event::id_type, MemAccessRecord>::iterator it, Addr cacheIndex);
+    void issueFootprintFill(std::map<SST::Event::id_type, MemAccessRecord>::iterator it, Addr lineAddr);
+    void handleFootprintFill(MemEvent* ev);
+    void finishFootprintFill(std::map<SST::Event::id_type, std::pair<SST::Event::id_type, MemEvent*> >::iterator fill);
+    void releaseAccess(std::map<SST::Event::id_type, MemAccessRecord>::iterator it);
+    bool probeTagCache(Addr unit);
 
     void sendResponse(MemEvent* ev, uint32_t flags);
 
@@ -188,6 +245,15 @@ protected:
     Statistic<uint64_t>* statReadMiss;
     Statistic<uint64_t>* statWriteHit;
     Statistic<uint64_t>* statWriteMiss;
+    Statistic<uint64_t>* statDemandBytes;
+    Statistic<uint64_t>* statLocalRead;
+    Statistic<uint64_t>* statLocalWrite;
+    Statistic<uint64_t>* statRemoteRead;
+    Statistic<uint64_t>* statRemoteWrite;
+    Statistic<uint64_t>* statTagCacheHit;
+    Statistic<uint64_t>* statTagCacheMiss;
+    Statistic<uint64_t>* statSectorEvict;
+    Statistic<uint64_t>* statFootprintFill;
 
 private:
     void handleCustomEvent(MemEventBase* ev);
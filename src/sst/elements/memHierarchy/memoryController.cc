@@ -75,6 +75,7 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
     }
 
     bool initBacking = params.find<bool>("backing_init_zero", false);
+    bool hugePages = params.find<bool>("backing_huge_pages", false);
     // Debug address
     std::vector<Addr> addrArr;
     params.find_array<Addr>("debug_addr", addrArr);
@@ -112,39 +113,64 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
      *
      */
 
-    MemBackend * memory = loadUserSubComponent<MemBackend>("backend");
-    if (!memory) {  /* Try to load from our parameters (legacy mode 1) */
-        /* Check if there's an error with the subcomponent the user specified */
-        SubComponentSlotInfo * info = getSubComponentSlotInfo("backend");
-        if (info && info->isPopulated(0)) {
-            out.fatal(CALL_INFO, -1, "%s, ERROR: Unable to load the subcomponent in the 'backend' slot. Check that the requested subcomponent is registered with the SST core.\n",
-                    getName().c_str());
-        } else {
-            out.output("%s, WARNING: Loaded backend in legacy mode (from parameter set). Instead, load backend into this controller's 'backend' slot via ctrl.setSubComponent() in configuration.\n", getName().c_str());
-        }
-        Params tmpParams = params.get_scoped_params("backendConvertor.backend");
-        std::string name = params.find<std::string>("backendConvertor.backend", "memHierarchy.simpleMem");
-        memory = loadAnonymousSubComponent<MemBackend>(name, "backend", 0, ComponentInfo::INSERT_STATS | ComponentInfo::SHARE_PORTS, tmpParams);
-        if (!memory) {
-            out.fatal(CALL_INFO, -1, "%s, ERROR: Unable to load backend '%s'. Use setSubComponent() on this controller to specify backend in your input configuration; check for valid backend name.\n",
-                    getName().c_str(), name.c_str());
-        }
+    uint32_t numChannels = params.find<uint32_t>("num_channels", 1);
+    if (numChannels == 0) {
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: num_channels - must be at least 1.\n", getName().c_str());
     }
 
-    std::string convertortype = memory->getBackendConvertorType();
-    Params tmpParams = params.get_scoped_params("backendConvertor");
-    memBackendConvertor_ = loadAnonymousSubComponent<MemBackendConvertor>(convertortype, "backendConvertor", 0, ComponentInfo::INSERT_STATS, tmpParams, memory, requestWidth);
+    std::string chSize = params.find<std::string>("channel_interleave_size", "256B");
+    fixByteUnits(chSize);
+    UnitAlgebra chSize_ua(chSize);
+    uint64_t channelInterleave = chSize_ua.getRoundedValue();
+    if (!chSize_ua.hasUnits("B") || channelInterleave == 0 || (channelInterleave & (channelInterleave - 1)) != 0) {
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: channel_interleave_size - must be a power of two and specified in bytes with units (SI units OK). For example, '256B'. You specified '%s'\n",
+                getName().c_str(), chSize.c_str());
+    }
+    if (numChannels > 1 && channelInterleave < requestWidth) {
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: channel_interleave_size - must be at least request_width (%" PRIu32 "B) so that a request does not span channels. You specified '%s'\n",
+                getName().c_str(), requestWidth, chSize.c_str());
+    }
+    channelShift_ = log2Of(channelInterleave);
 
-    if (memBackendConvertor_ == nullptr) {
-        out.fatal(CALL_INFO, -1, "%s, ERROR: Unable to load MemBackendConvertor.", getName().c_str());
+    channelHash_ = loadUserSubComponent<HashFunction>("channel_hash");
+    if (!channelHash_) {
+        Params hparams;
+        channelHash_ = loadAnonymousSubComponent<HashFunction>("memHierarchy.hash.none", "channel_hash", 0, ComponentInfo::SHARE_NONE, hparams);
     }
 
     using std::placeholders::_1;
     using std::placeholders::_2;
-    memBackendConvertor_->setCallbackHandlers(std::bind(&MemController::handleMemResponse, this, _1, _2), std::bind(&MemController::turnClockOn, this));
-    memSize_ = memBackendConvertor_->getMemSize();
-    if (memSize_ == 0)
-        out.fatal(CALL_INFO, -1, "%s, ERROR: Tried to get memory size from backend but size is 0B. Either backend is missing a 'mem_size' parameter or value is invalid.\n", getName().c_str());
+    memSize_ = 0;
+    for (uint32_t i = 0; i < numChannels; i++) {
+        MemBackend * memory = loadBackend(params, i, numChannels);
+
+        std::string convertortype = memory->getBackendConvertorType();
+        Params tmpParams = params.get_scoped_params("backendConvertor");
+        uint64_t flags = (numChannels == 1) ? ComponentInfo::INSERT_STATS : ComponentInfo::SHARE_NONE;
+        MemBackendConvertor * convertor = loadAnonymousSubComponent<MemBackendConvertor>(convertortype, "backendConvertor", i, flags, tmpParams, memory, requestWidth);
+
+        if (convertor == nullptr) {
+            out.fatal(CALL_INFO, -1, "%s, ERROR: Unable to load MemBackendConvertor.", getName().c_str());
+        }
+
+        convertor->setCallbackHandlers(std::bind(&MemController::handleMemResponse, this, _1, _2), std::bind(&MemController::turnClockOn, this));
+        convertor->setChannelMapping(numChannels, channelInterleave);
+        size_t channelSize = convertor->getMemSize();
+        if (channelSize == 0)
+            out.fatal(CALL_INFO, -1, "%s, ERROR: Tried to get memory size from backend but size is 0B. Either backend is missing a 'mem_size' parameter or value is invalid.\n", getName().c_str());
+        if (i != 0 && channelSize != channels_[0]->getMemSize())
+            out.fatal(CALL_INFO, -1, "%s, ERROR: All channels must have the same 'mem_size'. Channel 0 has %zuB but channel %" PRIu32 " has %zuB.\n",
+                    getName().c_str(), channels_[0]->getMemSize(), i, channelSize);
+        memSize_ += channelSize;
+        channels_.push_back(convertor);
+
+        stat_channelRequests_.push_back(registerStatistic<uint64_t>("channel_requests", std::to_string(i)));
+        stat_channelBytes_.push_back(registerStatistic<uint64_t>("channel_bytes", std::to_string(i)));
+        stat_channelBusyCycles_.push_back(registerStatistic<uint64_t>("channel_busy_cycles", std::to_string(i)));
+    }
+    memBackendConvertor_ = channels_[0];
+    channelOutstanding_.resize(numChannels, 0);
+    channelBusyStart_.resize(numChannels, 0);
 
     // Load listeners (profilers/tracers/etc.)
     SubComponentSlotInfo* lists = getSubComponentSlotInfo("listener"); // Find all listeners specified in the configuration
@@ -281,10 +307,10 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
     }
     size_t sizeBytes = size_ua.getRoundedValue();
 
-    if (sizeBytes > memBackendConvertor_->getMemSize()) {
-        sizeBytes = memBackendConvertor_->getMemSize();
+    if (sizeBytes > memSize_) {
+        sizeBytes = memSize_;
         // Since getMemSize() might not be a power of 2, but malloc store needs it....get a reasonably close power of 2
-        sizeBytes = 1 << log2Of(memBackendConvertor_->getMemSize());
+        sizeBytes = 1 << log2Of(memSize_);
     }
 
     /* Create the backing store */
@@ -306,7 +332,7 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
             if ( backing_outfile_ != infile && infile != "")
                 backing_outfile_ = SST::Util::Filesystem::getAbsolutePath(backing_outfile_, getOutputDirectory());
         try {
-            backing_ = new Backend::BackingMMAP( backing_outfile_, infile, memBackendConvertor_->getMemSize() );
+            backing_ = new Backend::BackingMMAP( backing_outfile_, infile, memSize_ );
         }
         catch ( int e ) {
             if ( e == 1 )
@@ -316,7 +342,7 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
             else if ( e == 2 ) {
                 if ( backing_outfile_ == "" && infile == "" ) {
                     out.verbose(CALL_INFO, 1, 0, "%s, WARNING: Could not MMAP backing store (likely, simulated memory exceeds available memory space). Creating malloc based store instead.\n", getName().c_str());
-                    backing_ = new Backend::BackingMalloc(sizeBytes,initBacking);
+                    backing_ = new Backend::BackingMalloc(sizeBytes,initBacking,hugePages);
                 } else if ( infile != "" ) {
                     out.fatal(CALL_INFO, -1, "%s, ERROR: Could not MMAP backing store (likely, simulated memory exceeds available memory). Cannot initialize malloc based store from provided mmap input file %s.\n", getName().c_str(), infile.c_str());
                 } else {
@@ -330,7 +356,7 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
     } else if ( backingType == "malloc" ) {
         if ( infile != "" ) {
             try {
-                backing_ = new Backend::BackingMalloc(infile);
+                backing_ = new Backend::BackingMalloc(infile,hugePages);
             } catch (int e) {
                 if ( e == 1 ) {
                     out.fatal(CALL_INFO, -1, "%s, ERROR: Unable to open 'backing_in_file'. Does file exist? Filename='%s'\n", getName().c_str(), infile.c_str());
@@ -338,8 +364,11 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
                     out.fatal(CALL_INFO, -1, "%s, ERROR: Unable to create backing store. Exception thrown is %d.\n", getName().c_str(), e);
             }
         } else {
-            backing_ = new Backend::BackingMalloc(sizeBytes,initBacking);
+            backing_ = new Backend::BackingMalloc(sizeBytes,initBacking,hugePages);
         }
+        std::string checkpointStore = params.find<std::string>("backing_checkpoint_store", "");
+        if (!checkpointStore.empty())
+            static_cast<Backend::BackingMalloc*>(backing_)->setCheckpointStore(SST::Util::Filesystem::getAbsolutePath(checkpointStore, getOutputDirectory()));
         // Test outfile to find issues before simulation begins
         if ( backing_outfile_ != "" ) {
             auto fp = fopen(backing_outfile_.c_str(),"wb+");
@@ -366,10 +395,47 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
     }
 }
 
+/*
+ * Load the timing backend for 'channel'. The 'backend' slot is filled at
+ * indices 0..numChannels-1, or else every channel loads the backend
+ * described by the (legacy) parameter set.
+ */
+MemBackend* MemController::loadBackend(Params& params, uint32_t channel, uint32_t numChannels) {
+    MemBackend * memory = nullptr;
+    SubComponentSlotInfo * info = getSubComponentSlotInfo("backend");
+    if (numChannels == 1) {
+        memory = loadUserSubComponent<MemBackend>("backend");
+    } else if (info && info->isPopulated(channel)) {
+        memory = info->create<MemBackend>(channel, ComponentInfo::SHARE_NONE);
+    }
+    if (memory)
+        return memory;
+
+    /* Try to load from our parameters (legacy mode 1) */
+    /* Check if there's an error with the subcomponent the user specified */
+    if (info && info->isPopulated(channel)) {
+        out.fatal(CALL_INFO, -1, "%s, ERROR: Unable to load the subcomponent in the 'backend' slot. Check that the requested subcomponent is registered with the SST core.\n",
+                getName().c_str());
+    } else if (info && info->isPopulated(0)) {
+        out.fatal(CALL_INFO, -1, "%s, ERROR: 'num_channels' is %" PRIu32 " but the 'backend' slot is not filled for channel %" PRIu32 ". Fill the slot at indices 0 to %" PRIu32 ".\n",
+                getName().c_str(), numChannels, channel, numChannels - 1);
+    } else if (channel == 0) {
+        out.output("%s, WARNING: Loaded backend in legacy mode (from parameter set). Instead, load backend into this controller's 'backend' slot via ctrl.setSubComponent() in configuration.\n", getName().c_str());
+    }
+    Params tmpParams = params.get_scoped_params("backendConvertor.backend");
+    std::string name = params.find<std::string>("backendConvertor.backend", "memHierarchy.simpleMem");
+    uint64_t flags = (numChannels == 1) ? (ComponentInfo::INSERT_STATS | ComponentInfo::SHARE_PORTS) : ComponentInfo::SHARE_PORTS;
+    memory = loadAnonymousSubComponent<MemBackend>(name, "backend", channel, flags, tmpParams);
+    if (!memory) {
+        out.fatal(CALL_INFO, -1, "%s, ERROR: Unable to load backend '%s'. Use setSubComponent() on this controller to specify backend in your input configuration; check for valid backend name.\n",
+                getName().c_str(), name.c_str());
+    }
+    return memory;
+}
+
 void MemController::handleEvent(SST::Event* event) {
     if (!clockOn_) {
-        Cycle_t cycle = turnClockOn();
-        memBackendConvertor_->turnClockOn(cycle);
+        turnClockOn();
     }
 
     MemEventBase *meb = static_cast<MemEventBase*>(event);
@@ -435,13 +501,7 @@ void MemController::handleEvent(SST::Event* event) {
         case Command::GetX:
         case Command::GetSX:
         case Command::Write:
-            outstandingEvents_.insert(std::make_pair(ev->getID(), ev));
-            if (mem_h_is_debug_event(ev)) {
-                mem_h_debug_output(_L4_, "B: %-20" PRIu64 " %-20" PRIu64 " %-20s Bkend:Send    (%s)\n",
-                        getCurrentSimCycle(), getNextClockCycle(clockTimeBase_) - 1, getName().c_str(),
-                        ev->getVerboseString().c_str());
-            }
-            memBackendConvertor_->handleMemEvent( ev );
+            issueToBackend(ev);
             break;
 
         case Command::FlushLine:
@@ -449,25 +509,16 @@ void MemController::handleEvent(SST::Event* event) {
             {
                 MemEvent* put = NULL;
                 if ( ev->getPayloadSize() != 0 ) {
-                    put = new MemEvent(getName(), ev->getBaseAddr(), ev->getBaseAddr(), Command::PutM, ev->getPayload());
+                    put = new MemEvent(getName(), ev->getBaseAddr(), ev->getBaseAddr(), Command::PutM);
+                    put->sharePayload(ev);
                     put->setFlag(MemEvent::F_NORESPONSE);
-                    outstandingEvents_.insert(std::make_pair(put->getID(), put));
-                    if (mem_h_is_debug_event(put)) {
-                        mem_h_debug_output(_L4_, "B: %-20" PRIu64 " %-20" PRIu64 " %-20s Bkend:Send    (%s)\n",
-                                getCurrentSimCycle(), getNextClockCycle(clockTimeBase_) - 1, getName().c_str(),
-                                put->getVerboseString().c_str());
-                    }
-                    memBackendConvertor_->handleMemEvent( put );
+                    if (ev->queryFlag(MemEvent::F_FUNCTIONAL))
+                        put->setFlag(MemEvent::F_FUNCTIONAL);
+                    issueToBackend(put);
                 }
 
-                outstandingEvents_.insert(std::make_pair(ev->getID(), ev));
                 ev->setCmd(Command::FlushLine);
-                if (mem_h_is_debug_event(ev)) {
-                    mem_h_debug_output(_L4_, "B: %-20" PRIu64 " %-20" PRIu64 " %-20s Bkend:Send    (%s)\n",
-                            getCurrentSimCycle(), getNextClockCycle(clockTimeBase_) - 1, getName().c_str(),
-                            ev->getVerboseString().c_str());
-                }
-                memBackendConvertor_->handleMemEvent( ev );
+                issueToBackend(ev);
 
             }
             break;
@@ -493,16 +544,61 @@ void MemController::handleEvent(SST::Event* event) {
     }
 }
 
+/*
+ * Send a request to the backend. Functional (warm-up) requests skip the
+ * backend and are completed immediately so that only the backing store is updated.
+ */
+void MemController::issueToBackend(MemEvent* ev) {
+    outstandingEvents_.insert(std::make_pair(ev->getID(), ev));
+    if (ev->queryFlag(MemEvent::F_FUNCTIONAL)) {
+        handleMemResponse(ev->getID(), ev->getFlags());
+        return;
+    }
+    if (mem_h_is_debug_event(ev)) {
+        mem_h_debug_output(_L4_, "B: %-20" PRIu64 " %-20" PRIu64 " %-20s Bkend:Send    (%s)\n",
+                getCurrentSimCycle(), getNextClockCycle(clockTimeBase_) - 1, getName().c_str(),
+                ev->getVerboseString().c_str());
+    }
+    uint32_t channel = getChannel(ev);
+    channelIssue(channel, ev);
+    channels_[channel]->handleMemEvent( ev );
+}
+
+uint32_t MemController::getChannel(MemEventBase* ev) {
+    if (ev->getCmd() == Command::CustomReq)
+        return getChannel(translateToLocal(ev->getRoutingAddress()));
+    return getChannel(static_cast<MemEvent*>(ev)->getBaseAddr());
+}
+
+/* Record a new request for a channel's statistics */
+void MemController::channelIssue(uint32_t channel, MemEventBase* ev) {
+    stat_channelRequests_[channel]->addData(1);
+    Command cmd = ev->getCmd();
+    if (cmd != Command::CustomReq && cmd != Command::FlushLine)
+        stat_channelBytes_[channel]->addData(static_cast<MemEvent*>(ev)->getSize());
+
+    if (channelOutstanding_[channel]++ == 0)
+        channelBusyStart_[channel] = getNextClockCycle(clockTimeBase_) - 1;
+}
+
+void MemController::channelRetire(uint32_t channel) {
+    if (--channelOutstanding_[channel] == 0)
+        stat_channelBusyCycles_[channel]->addData(getNextClockCycle(clockTimeBase_) - 1 - channelBusyStart_[channel]);
+}
+
 bool MemController::clock(Cycle_t cycle) {
     bool unclockLink = true;
     if (clockLink_) {
         unclockLink = link_->clock();
     }
 
-    bool unclockBack = memBackendConvertor_->clock( cycle );
+    bool unclockBack = true;
+    for (auto& channel : channels_)
+        unclockBack &= channel->clock( cycle );
 
     if (unclockLink && unclockBack) {
-        memBackendConvertor_->turnClockOff();
+        for (auto& channel : channels_)
+            channel->turnClockOff();
         clockOn_ = false;
         return true;
     }
@@ -510,10 +606,13 @@ bool MemController::clock(Cycle_t cycle) {
     return false;
 }
 
+/* Channels share the controller's clock so all are turned back on together */
 Cycle_t MemController::turnClockOn() {
     Cycle_t cycle = reregisterClock(clockTimeBase_, clockHandler_);
     cycle--;
     clockOn_ = true;
+    for (auto& channel : channels_)
+        channel->turnClockOn(cycle);
     return cycle;
 }
 
@@ -534,7 +633,9 @@ void MemController::handleCustomEvent(MemEventBase * ev) {
                 getCurrentSimCycle(), getNextClockCycle(clockTimeBase_) - 1, getName().c_str(),
                 ev->getVerboseString().c_str());
     }
-    memBackendConvertor_->handleCustomEvent(info, ev->getID(), ev->getRqstr());
+    uint32_t channel = getChannel(ev);
+    channelIssue(channel, ev);
+    channels_[channel]->handleCustomEvent(info, ev->getID(), ev->getRqstr());
 }
 
 
@@ -552,6 +653,9 @@ void MemController::handleMemResponse( Event::id_type id, uint32_t flags ) {
                     getCurrentSimCycle(), getNextClockCycle(clockTimeBase_) - 1, getName().c_str(), id.first, id.second);
     }
 
+    if (!evb->queryFlag(MemEvent::F_FUNCTIONAL))
+        channelRetire(getChannel(evb));
+
     /* Handle custom events */
     if (evb->getCmd() == Command::CustomReq) {
         MemEventBase * resp = customCommandHandler_->finish(evb, flags);
@@ -618,12 +722,14 @@ void MemController::init(unsigned int phase) {
 }
 
 void MemController::setup(void) {
-    memBackendConvertor_->setup();
+    for (auto& channel : channels_)
+        channel->setup();
     link_->setup();
 }
 
 void MemController::complete(unsigned int phase) {
-    memBackendConvertor_->complete(phase);
+    for (auto& channel : channels_)
+        channel->complete(phase);
     link_->complete(phase);
 
     // Initiate flush here if configured to do so
@@ -641,7 +747,11 @@ void MemController::complete(unsigned int phase) {
 void MemController::finish(void) {
     Cycle_t cycle = getNextClockCycle(clockTimeBase_); // Get finish time
     cycle--;
-    memBackendConvertor_->finish(cycle);
+    for (uint32_t i = 0; i < channels_.size(); i++) {
+        channels_[i]->finish(cycle);
+        if (channelOutstanding_[i] != 0)
+            stat_channelBusyCycles_[i]->addData(cycle - channelBusyStart_[i]);
+    }
     link_->finish();
     if ( backing_outfile_ != "" ) {
         try {
@@ -845,6 +955,10 @@ void MemController::printStatus(Output &statusOut) {
     statusOut.output("MemHierarchy::MemoryController %s\n", getName().c_str());
 
     statusOut.output("  Outstanding events: %zu\n", outstandingEvents_.size());
+    if (channels_.size() > 1) {
+        for (uint32_t i = 0; i < channels_.size(); i++)
+            statusOut.output("    Channel %" PRIu32 ": %" PRIu32 " outstanding\n", i, channelOutstanding_[i]);
+    }
     for (std::map<SST::Event::id_type, MemEventBase*>::iterator it = outstandingEvents_.begin(); it != outstandingEvents_.end(); it++) {
         statusOut.output("    %s\n", it->second->getVerboseString(dlevel).c_str());
     }
@@ -902,15 +1016,26 @@ void MemController::serialize_order(SST::Core::Serialization::serializer& ser) {
     SST_SER(dlevel);
 
     SST_SER(memBackendConvertor_);
+    SST_SER(channels_);
 
     if ( ser.mode() == SST::Core::Serialization::serializer::UNPACK ) {
         using std::placeholders::_1;
         using std::placeholders::_2;
-        memBackendConvertor_->setCallbackHandlers(
-            std::bind(&MemController::handleMemResponse, this, _1, _2),
-            std::bind(&MemController::turnClockOn, this));
+        for (auto& channel : channels_) {
+            channel->setCallbackHandlers(
+                std::bind(&MemController::handleMemResponse, this, _1, _2),
+                std::bind(&MemController::turnClockOn, this));
+        }
     }
 
+    SST_SER(channelHash_);
+    SST_SER(channelShift_);
+    SST_SER(channelOutstanding_);
+    SST_SER(channelBusyStart_);
+    SST_SER(stat_channelRequests_);
+    SST_SER(stat_channelBytes_);
+    SST_SER(stat_channelBusyCycles_);
+
     SST_SER(backing_);
     SST_SER(backing_outfile_);
 
@@ -26,11 +26,13 @@
 #include "sst/elements/memHierarchy/memLinkBase.h"
 #include "sst/elements/memHierarchy/membackend/backing.h"
 #include "sst/elements/memHierarchy/customcmd/customCmdMemory.h"
+#include "sst/elements/memHierarchy/hash.h"
 
 namespace SST {
 namespace MemHierarchy {
 
 class MemBackendConvertor;
+class MemBackend;
 
 class MemController : public SST::Component {
 public:
@@ -56,14 +58,24 @@ public:
             {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
             {"backing_init_zero",   "(string) For 'malloc' backing stores, whether to initialize memory values to 0", "false"},\
+            {"backing_huge_pages",  "(bool) For 'malloc' backing stores, request transparent huge pages for the backing arena (Linux only)", "false"},\
+            {"backing_checkpoint_store", "(string) For 'malloc' backing stores, file that checkpoints keep backing pages in. Each checkpoint appends only the pages written since the previous one. Keep the file with the checkpoints. If empty, every checkpoint holds all non-zero pages.", ""},\
             {"memory_file",         "(string) DEPRECATED: Use 'backing_in_file' and/or 'backing_out_file' instead. Optional backing-store file to pre-load memory and/or store resulting state. If file does not exist, the backing-store will create it.", "N/A"},\
             {"backing_in_file",     "(string) An optional file to pre-load memory contents from.", ""},\
             {"backing_out_file",    "(string) An optional file to write out memory contents to. Setting this will also trigger a flush of cache contents prior to writing the file. May be the same as 'backing_in_file'.", ""},\
             {"backing_out_screen",  "(bool) Write out memory contents to screen at end of simulation. Setting this will also trigger a flush of cache contents prior to writing to screen.", "false"},\
-            {"customCmdMemHandler", "(string) Name of the custom command handler to load", ""}
+            {"customCmdMemHandler", "(string) Name of the custom command handler to load", ""},\
+            {"num_channels",        "(uint) Number of independent channels behind this controller (MemController only). Each channel has its own backend and request queue; fill the 'backend' slot at indices 0 to num_channels-1, or give the legacy backend parameters which are then used for every channel. 'mem_size' is per channel.", "1"},\
+            {"channel_interleave_size", "(string) With num_channels > 1, size of the chunks interleaved across channels. Must be a power of two and at least 'request_width'.", "256B"}
 
     SST_ELI_DOCUMENT_PARAMS( MEMCONTROLLER_ELI_PARAMS )
 
+#define MEMCONTROLLER_ELI_STATS { "channel_requests",    "Number of requests issued to each channel. Statistic subID is the channel number.", "requests", 2 },\
+            { "channel_bytes",       "Number of bytes read or written by each channel. Divide by total cycles for bandwidth utilisation.", "bytes", 2 },\
+            { "channel_busy_cycles", "Number of cycles each channel had at least one request outstanding", "cycles", 2 }
+
+    SST_ELI_DOCUMENT_STATISTICS( MEMCONTROLLER_ELI_STATS )
+
 #define MEMCONTROLLER_ELI_PORTS {"highlink", "Direct connection to another memHierarchy component or subcomponent. If a network port is needed, fill the 'highlink' subcomponent slot instead.", {"memHierarchy.MemEventBase"} },\
             {"direct_link", "DEPRECATED: Use 'highlink' subcomponent or port instead. Direct connection to a cache/directory controller", {"memHierarchy.MemEventBase"} },\
             {"network",     "DEPRECATED: Set 'highlink' subcomponent slot to memHierarchy.MemNIC or memHierarchy.MemNICFour instead. Network connection to a cache/directory controller; also request network for split networks", {"memHierarchy.MemRtrEvent"} },\
@@ -77,6 +89,7 @@ public:
 
 #define MEMCONTROLLER_ELI_SUBCOMPONENTSLOTS {"backend", "Backend memory model to use for timing. Defaults to simpleMem", "SST::MemHierarchy::MemBackend"},\
             {"customCmdHandler", "Optional handler for custom command types", "SST::MemHierarchy::CustomCmdMemHandler"}, \
+            {"channel_hash", "Optional hash applied to the chunk number (address / channel_interleave_size) before selecting a channel, e.g., memHierarchy.hash.xor_fold for XOR row/channel interleaving. Defaults to none (modulo interleaving)", "SST::MemHierarchy::HashFunction"}, \
             {"listener", "Optional listeners to gather statistics, create traces, etc. Multiple listeners supported.", "SST::MemHierarchy::CacheListener"}, \
             {"highlink", "CPU-side port manager (e.g., link to caches/cpu). If used, do not connect the 'highlink' port and connect the subcomponent's port(s) instead. Defaults to 'memHierarchy.MemLink' if the 'highlink' port is used instead.", "SST::MemHierarchy.MemLinkBase"},\
             {"cpulink", "DEPRECATED: Renamed to 'highlink' for naming consistency. CPU-side link manager (e.g., towards caches/cpu). A common setting for network connections is 'memHierarchy.MemNIC'.", "SST::MemHierarchy::MemLinkBase"}
@@ -135,7 +148,15 @@ protected:
     std::set<Addr> debug_addr_filter_;
     int dlevel;
 
-    MemBackendConvertor*    memBackendConvertor_;
+    MemBackendConvertor*    memBackendConvertor_;   // Channel 0
+    std::vector<MemBackendConvertor*> channels_;    // One convertor/backend per channel
+
+    /* Map a controller-local address to a channel */
+    uint32_t getChannel(Addr addr) {
+        if (channels_.size() == 1)
+            return 0;
+        return channelHash_->hash(0, addr >> channelShift_) % channels_.size();
+    }
 
     Backend::Backing*       backing_;
     std::string backing_outfile_;
@@ -180,6 +201,23 @@ private:
     std::map<SST::Event::id_type, MemEventBase*> outstandingEvents_; // For sending responses. Expect backend to respond to ALL requests so that we know the execution order
 
     void handleCustomEvent(MemEventBase* ev);
+    void issueToBackend(MemEvent* ev);
+
+    MemBackend* loadBackend(Params& params, uint32_t channel, uint32_t numChannels);
+
+    /* Per-channel accounting */
+    uint32_t getChannel(MemEventBase* ev);
+    void channelIssue(uint32_t channel, MemEventBase* ev);
+    void channelRetire(uint32_t channel);
+
+    HashFunction* channelHash_;
+    uint32_t channelShift_;     // log2(channel_interleave_size)
+    std::vector<uint32_t> channelOutstanding_;
+    std::vector<Cycle_t> channelBusyStart_;
+
+    std::vector<Statistic<uint64_t>*> stat_channelRequests_;
+    std::vector<Statistic<uint64_t>*> stat_channelBytes_;
+    std::vector<Statistic<uint64_t>*> stat_channelBusyCycles_;
 
     bool backing_outscreen_;
 };
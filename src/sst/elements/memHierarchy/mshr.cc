@@ -36,6 +36,9 @@ MSHR::MSHR(ComponentId_t cid, Output* debug, int maxSize, string cacheName, std:
 
     flush_acks_needed_ = 0;
     flush_all_in_mshr_count_ = 0;
+
+    // Unbounded MSHRs (maxSize < 0) start small and grow
+    mshr_ = MSHRBlock(maxSize > 0 ? maxSize : 16);
 }
 
 int MSHR::getMaxSize() {
@@ -47,10 +50,8 @@ int MSHR::getSize() {
 }
 
 unsigned int MSHR::getSize(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
-        return 0;
-    else
-        return mshr_.find(addr)->second.entries_.size();
+    MSHRRegister * reg = mshr_.find(addr);
+    return reg ? reg->entries_.size() : 0;
 }
 
 int MSHR::getFlushSize() {
@@ -58,43 +59,42 @@ int MSHR::getFlushSize() {
 }
 
 bool MSHR::exists(Addr addr) {
-    return mshr_.find(addr) != mshr_.end();
+    return mshr_.find(addr) != nullptr;
 }
 
 MSHREntry MSHR::getEntry(Addr addr, size_t index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", owner_name_.c_str(), addr, index);
     }
-    if (mshr_.find(addr)->second.entries_.size() <= index) {
-        dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Entry list size is %zu.\n", owner_name_.c_str(), addr, index, mshr_.find(addr)->second.entries_.size());
+    if (reg->entries_.size() <= index) {
+        dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Entry list size is %zu.\n", owner_name_.c_str(), addr, index, reg->entries_.size());
     }
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries_.begin();
-    std::advance(it, index);
-    return *it;
+    return reg->entries_[index];
 }
 
 MSHREntry MSHR::getFront(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", owner_name_.c_str(), addr);
     }
 
-    if (mshr_.find(addr)->second.entries_.empty()) {
+    if (reg->entries_.empty()) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Entry list is empty.\n", owner_name_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.entries_.front();
+    return reg->entries_.front();
 }
 
 void MSHR::removeEntry(Addr addr, size_t index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", owner_name_.c_str(), addr, index);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
     if (reg->entries_.size() <= index) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Entry list is shorter than requested index.\n", owner_name_.c_str(), addr, index);
     }
 
-    std::list<MSHREntry>::iterator entry = reg->entries_.begin();
-    std::advance(entry, index);
+    MSHREntryQueue::iterator entry = reg->entries_.begin() + index;
 
     if (entry->getType() == MSHREntryType::Event)
         size_--;
@@ -106,100 +106,82 @@ void MSHR::removeEntry(Addr addr, size_t index) {
     if (reg->entries_.empty()) {
         if (mem_h_is_debug_addr(addr))
             printDebug(10, "Erase", addr, "");
-            //dbg_->debug(_L10_, "M: %-41" PRIu64 " %-20s Erase        0x%-16" PRIx64 " %-10d\n",
-            //        getCurrentSimCycle(), owner_name_.c_str(), addr, size_);
-            //dbg_->debug(_L10_, "    MSHR: erasing 0x%" PRIx64 " from MSHR\n", addr);
         mshr_.erase(addr);
     }
 }
 
 void MSHR::removeFront(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeFront(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", owner_name_.c_str(), addr);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
     if (reg->entries_.empty()) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeFront(0x%" PRIx64 "). Entry list is empty.\n", owner_name_.c_str(), addr);
     }
 
-   // if (mem_h_is_debug_addr(addr))
-   //     dbg_->debug(_L10_, "    MSHR::removeFront(0x%" PRIx64 ", %s)\n", addr, reg->entries_.front().getString().c_str());
-
-    if (getFrontType(addr) == MSHREntryType::Event)
+    if (reg->entries_.front().getType() == MSHREntryType::Event)
         size_--;
 
     if (mem_h_is_debug_addr(addr))
         printDebug(10, "RemFr", addr, (reg->entries_.front()).getString().c_str());
 
-    reg->entries_.pop_front();
+    reg->entries_.erase(reg->entries_.begin());
     if (reg->entries_.empty()) {
         if (mem_h_is_debug_addr(addr))
             printDebug(10, "Erase", addr, "");
-            //dbg_->debug(_L10_, "    MSHR: erasing 0x%" PRIx64 " from MSHR\n", addr);
         mshr_.erase(addr);
     }
 }
 
 MSHREntryType MSHR::getEntryType(Addr addr, size_t index) {
-    //if (mem_h_is_debug_addr(addr))
-    //    dbg_->debug(_L20_, "    MSHR::getEntryType(0x%" PRIx64 ", %zu)\n", addr, index);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", owner_name_.c_str(), addr, index);
     }
-    if (mshr_.find(addr)->second.entries_.size() <= index) {
+    if (reg->entries_.size() <= index) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Entry list is shoerter than index.\n", owner_name_.c_str(), addr, index);
     }
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries_.begin();
-    std::advance(it, index);
-    return it->getType();
+    return reg->entries_[index].getType();
 }
 
 MSHREntryType MSHR::getFrontType(Addr addr) {
-    //if (mem_h_is_debug_addr(addr))
-    //    dbg_->debug(_L20_, "    MSHR::getFrontType(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", owner_name_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries_.empty()) {
+    if (reg->entries_.empty()) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Entry list is empty.\n", owner_name_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.entries_.front().getType();
+    return reg->entries_.front().getType();
 }
 
 MemEventBase* MSHR::getEntryEvent(Addr addr, size_t index) {
-    //if (mem_h_is_debug_addr(addr))
-    //    dbg_->debug(_L20_, "    MSHR::getEntryEvent(0x%" PRIx64 ", %zu)\n", addr, index);
-
-    if (mshr_.find(addr) == mshr_.end() || mshr_.find(addr)->second.entries_.size() <= index)
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg || reg->entries_.size() <= index)
         return nullptr;
 
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries_.begin();
-    std::advance(it, index);
-    if (it->getType() != MSHREntryType::Event)
+    MSHREntry& entry = reg->entries_[index];
+    if (entry.getType() != MSHREntryType::Event)
         return nullptr;
-    return it->getEvent();
+    return entry.getEvent();
 }
 
 
 MemEventBase* MSHR::getFrontEvent(Addr addr) {
-    //if (mem_h_is_debug_addr(addr))
-    //    dbg_->debug(_L20_, "    MSHR::getFrontEvent(0x%" PRIx64 ")\n", addr);
     if (getFrontType(addr) != MSHREntryType::Event) {
         return nullptr;
     }
-    return mshr_.find(addr)->second.entries_.front().getEvent();
+    return mshr_.find(addr)->entries_.front().getEvent();
 }
 
 MemEventBase* MSHR::getFirstEventEntry(Addr addr, Command cmd) {
-//    if (mem_h_is_debug_addr(addr))
-//        dbg_->debug(_L20_, "    MSHR::getFirstEventEntry(0x%" PRIx64 ", %s)\n", addr, CommandString[(int)cmd]);
-
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg)
         return nullptr;
 
-    for (std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries_.begin(); it != mshr_.find(addr)->second.entries_.end(); it++) {
-        if (it->getType() == MSHREntryType::Event && it->getEvent()->getCmd() == cmd)
-            return it->getEvent();
+    for (MSHREntry& entry : reg->entries_) {
+        if (entry.getType() == MSHREntryType::Event && entry.getEvent()->getCmd() == cmd)
+            return entry.getEvent();
     }
     return nullptr;
 }
@@ -224,7 +206,7 @@ std::list<Addr>* MSHR::getEvictPointers(Addr addr) {
     if (getFrontType(addr) != MSHREntryType::Evict)
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEvictPointers(0x%" PRIx64 "). Entry type is not Evict.\n", owner_name_.c_str(), addr);
 
-    return mshr_.find(addr)->second.entries_.front().getPointers();
+    return mshr_.find(addr)->entries_.front().getPointers();
 }
 
 // Return whether we should retry a new event or not
@@ -238,21 +220,22 @@ bool MSHR::removeEvictPointer(Addr addr, Addr addrPtr) {
         printDebug(10, "RemPtr", addr, reason.str());
     }
 
+    MSHRRegister * reg = mshr_.find(addr);
+
     // Sometimes we insert a WB before the Evict & then remove the Evict pointer, othertimes the Evict is front
-    if (getFrontType(addr) == MSHREntryType::Evict) {
-        MSHREntry * entry = &(mshr_.find(addr)->second.entries_.front());
+    if (reg->entries_.front().getType() == MSHREntryType::Evict) {
+        MSHREntry * entry = &(reg->entries_.front());
         entry->getPointers()->remove(addrPtr);
         if (entry->getPointers()->empty()) {
             removeFront(addr);
             return true;
         }
     } else {
-        std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries_.begin();
-        it++;
-        if (it->getType() != MSHREntryType::Evict)
+        if (reg->entries_.size() < 2 || reg->entries_[1].getType() != MSHREntryType::Evict)
             dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEvictPointer(0x%" PRIx64 ", 0x%" PRIx64 "). Entry type is not Evict.\n", owner_name_.c_str(), addr, addrPtr);
-        it->getPointers()->remove(addrPtr);
-        if (it->getPointers()->empty()) {
+        MSHREntry * entry = &(reg->entries_[1]);
+        entry->getPointers()->remove(addrPtr);
+        if (entry->getPointers()->empty()) {
             removeEntry(addr, 1);
         }
     }
@@ -265,7 +248,7 @@ bool MSHR::pendingWriteback(Addr addr) {
 
 bool MSHR::pendingWritebackIsDowngrade(Addr addr) {
     if (pendingWriteback(addr))
-        return mshr_.find(addr)->second.entries_.front().getDowngrade();
+        return mshr_.find(addr)->entries_.front().getDowngrade();
     return false;
 }
 
@@ -282,40 +265,20 @@ int MSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest,
     // Success
     size_++;
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        reg.entries_.push_back(MSHREntry(event, stallEvict, getCurrentSimCycle()));
-
-        mshr_.insert(std::make_pair(addr, reg));
-        if (mem_h_is_debug_addr(addr)) {
-            stringstream reason;
-            reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=0";
-            printDebug(10, "InsEv", addr, reason.str());
-
-        }
-
-        return 0;
+    MSHREntryQueue& entries = mshr_.insert(addr).entries_;
+    if (pos == -1 || pos >= (int)entries.size()) {
+        entries.push_back(MSHREntry(event, stallEvict, getCurrentSimCycle()));
+        pos = entries.size() - 1;
     } else {
-        if (pos == -1 || pos > mshr_.find(addr)->second.entries_.size()) {
-            mshr_.find(addr)->second.entries_.push_back(MSHREntry(event, stallEvict, getCurrentSimCycle()));
-            if (mem_h_is_debug_addr(addr)) {
-                stringstream reason;
-                reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (mshr_.find(addr)->second.entries_.size() - 1);
-                printDebug(10, "InsEv", addr, reason.str());
-            }
-            return (mshr_.find(addr)->second.entries_.size() - 1);
-        } else {
-            std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries_.begin();
-            std::advance(it, pos);
-            mshr_.find(addr)->second.entries_.insert(it, MSHREntry(event, stallEvict, getCurrentSimCycle()));
-            if (mem_h_is_debug_addr(addr)) {
-                stringstream reason;
-                reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << pos;
-                printDebug(10, "InsEv", addr, reason.str());
-            }
-            return pos;
-        }
+        entries.insert(entries.begin() + pos, MSHREntry(event, stallEvict, getCurrentSimCycle()));
+    }
+
+    if (mem_h_is_debug_addr(addr)) {
+        stringstream reason;
+        reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << pos;
+        printDebug(10, "InsEv", addr, reason.str());
     }
+    return pos;
 }
 
 /*
@@ -326,7 +289,8 @@ int MSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest,
  *      -1 = conflict, not inserted
  */
 int MSHR::insertEventIfConflict(Addr addr, MemEventBase* event) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg)
         return 0;
 
     if (size_ == max_size_-1) { /* Assuming fwdEvent == false */
@@ -338,88 +302,68 @@ int MSHR::insertEventIfConflict(Addr addr, MemEventBase* event) {
         return -1;
     }
     size_++;
-    mshr_.find(addr)->second.entries_.push_back(MSHREntry(event, false, getCurrentSimCycle()));
+    reg->entries_.push_back(MSHREntry(event, false, getCurrentSimCycle()));
     if (mem_h_is_debug_addr(addr)) {
         stringstream reason;
-        reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (mshr_.find(addr)->second.entries_.size() - 1);
+        reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (reg->entries_.size() - 1);
         printDebug(10, "InsEv", addr, reason.str());
     }
-    return (mshr_.find(addr)->second.entries_.size() - 1);
+    return (reg->entries_.size() - 1);
 }
 
 MemEventBase* MSHR::swapFrontEvent(Addr addr, MemEventBase* event) {
     if (mem_h_is_debug_addr(addr))
         printDebug(10, "SwpEv", addr, "");
 
-    if (mshr_.find(addr)->second.entries_.empty())
+    MSHRRegister * reg = mshr_.find(addr);
+    if (reg->entries_.empty())
         return nullptr;
 
-    return  mshr_.find(addr)->second.entries_.front().swapEvent(event, getCurrentSimCycle());
+    return reg->entries_.front().swapEvent(event, getCurrentSimCycle());
 }
 
 void MSHR::moveEntryToFront(Addr addr, unsigned int index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Address doesn't exist in MSHR.\n", owner_name_.c_str(), addr, index);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
     if (reg->entries_.size() <= index) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Entry list is shorter than requested index.\n", owner_name_.c_str(), addr, index);
     }
 
-    std::list<MSHREntry>::iterator entry = reg->entries_.begin();
-    std::advance(entry, index);
-
-    MSHREntry tmpEntry = *entry;
+    MSHREntryQueue::iterator entry = reg->entries_.begin() + index;
 
     if (mem_h_is_debug_addr(addr))
         printDebug(10, "MvEnt", addr, entry->getString());
-    reg->entries_.erase(entry);
-    reg->entries_.push_front(tmpEntry);
+    std::rotate(reg->entries_.begin(), entry, entry + 1);
 }
 
 bool MSHR::insertWriteback(Addr addr, bool downgrade) {
-//    if (mem_h_is_debug_addr(addr))
-//        dbg_->debug(_L10_, "    MSHR::insertWriteback(0x%" PRIx64 ")\n", addr);
-
     if (mem_h_is_debug_addr(addr)) {
         stringstream reason;
         reason << "Downgrade: " << (downgrade ? "T" : "F");
         printDebug(10, "InsWB", addr, reason.str());
     }
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        reg.entries_.push_back(MSHREntry(downgrade, getCurrentSimCycle()));
-        mshr_.insert(std::make_pair(addr, reg));
-    } else {
-        mshr_.find(addr)->second.entries_.push_front(MSHREntry(downgrade, getCurrentSimCycle()));
-    }
+    MSHREntryQueue& entries = mshr_.insert(addr).entries_;
+    entries.insert(entries.begin(), MSHREntry(downgrade, getCurrentSimCycle()));
 
     return true;
 }
 
 
 bool MSHR::insertEviction(Addr oldAddr, Addr newAddr) {
-//    if (mem_h_is_debug_addr(oldAddr) || mem_h_is_debug_addr(newAddr))
-//        dbg_->debug(_L10_, "    MSHR::insertEviction(0x%" PRIx64 ", 0x%" PRIx64 ")\n", oldAddr, newAddr);
-
     if (mem_h_is_debug_addr(oldAddr) || mem_h_is_debug_addr(newAddr)) {
         stringstream reason;
         reason << "to 0x" << std::hex << newAddr;
         printDebug(10, "InsPtr", oldAddr, reason.str());
     }
 
-    if (mshr_.find(oldAddr) == mshr_.end()) {  // No MSHR entry for oldAddr
-        MSHRRegister reg;
-        reg.entries_.push_back(MSHREntry(newAddr, getCurrentSimCycle()));
-        mshr_.insert(std::make_pair(oldAddr, reg));
-    } else {
-        list<MSHREntry>* entries = &(mshr_.find(oldAddr)->second.entries_);
-        if (!entries->empty() && entries->back().getType() == MSHREntryType::Evict) { // MSHR entry for oldAddr is an Evict
-            entries->back().getPointers()->push_back(newAddr);
-        } else { // MSHR entry for oldAddr is not an Evict (or no entry exists)
-            entries->push_back(MSHREntry(newAddr, getCurrentSimCycle()));
-        }
+    MSHREntryQueue& entries = mshr_.insert(oldAddr).entries_;
+    if (!entries.empty() && entries.back().getType() == MSHREntryType::Evict) { // MSHR entry for oldAddr is an Evict
+        entries.back().getPointers()->push_back(newAddr);
+    } else { // MSHR entry for oldAddr is not an Evict (or no entry exists)
+        entries.push_back(MSHREntry(newAddr, getCurrentSimCycle()));
     }
     return true;
 }
@@ -468,53 +412,50 @@ void MSHR::addPendingRetry(Addr addr) {
     if (mem_h_is_debug_addr(addr))
         printDebug(20, "IncRetry", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::addPendingRetry(0x%" PRIx64 "). Address does not exist in MSHR.\n", owner_name_.c_str(), addr);
     }
-    mshr_.find(addr)->second.addPendingRetry();
+    reg->addPendingRetry();
 }
 
 void MSHR::removePendingRetry(Addr addr) {
     if (mem_h_is_debug_addr(addr))
         printDebug(20, "DecRetry", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removePendingRetry(0x%" PRIx64 "). Address does not exist in MSHR.\n", owner_name_.c_str(), addr);
     }
-    mshr_.find(addr)->second.removePendingRetry();
+    reg->removePendingRetry();
 }
 
 uint32_t MSHR::getPendingRetries(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
-        return 0;
-
-    return mshr_.find(addr)->second.getPendingRetries();
+    MSHRRegister * reg = mshr_.find(addr);
+    return reg ? reg->getPendingRetries() : 0;
 }
 
 
 void MSHR::setInProgress(Addr addr, bool value) {
-//    if (mem_h_is_debug_addr(addr))
-//        dbg_->debug(_L10_, "    MSHR::setInProgress(0x%" PRIx64 ")\n", addr);
     if (mem_h_is_debug_addr(addr))
         printDebug(20, "InProg", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setInProgress(0x%" PRIx64 "). Address does not exist in MSHR.\n", owner_name_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries_.empty()) {
+    if (reg->entries_.empty()) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setInProgress(0x%" PRIx64 "). Entry list is empty.\n", owner_name_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries_.front().setInProgress(value);
+    reg->entries_.front().setInProgress(value);
 }
 
 bool MSHR::getInProgress(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg || reg->entries_.empty()) {
         return false;
     }
-    if (mshr_.find(addr)->second.entries_.empty()) {
-        return false;
-    }
-    return mshr_.find(addr)->second.entries_.front().getInProgress();
+    return reg->entries_.front().getInProgress();
 }
 
 void MSHR::setStalledForEvict(Addr addr, bool set) {
@@ -525,58 +466,58 @@ void MSHR::setStalledForEvict(Addr addr, bool set) {
             printDebug(20, "Unstall", addr, "");
     }
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setStalledForEvict(0x%" PRIx64 "). Address does not exist in MSHR.\n", owner_name_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries_.empty()) {
+    if (reg->entries_.empty()) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setStalledForEvict(0x%" PRIx64 "). Entry list is empty.\n", owner_name_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries_.front().setStalledForEvict(set);
+    reg->entries_.front().setStalledForEvict(set);
 }
 
 bool MSHR::getStalledForEvict(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg || reg->entries_.empty()) {
         return false;
     }
-    if (mshr_.find(addr)->second.entries_.empty()) {
-        return false;
-    }
-    return mshr_.find(addr)->second.entries_.front().getStalledForEvict();
+    return reg->entries_.front().getStalledForEvict();
 }
 
 void MSHR::setProfiled(Addr addr) {
     if (mem_h_is_debug_addr(addr))
         printDebug(20, "Profile", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setProfiled(0x%" PRIx64 "). Address does not exist in MSHR.\n", owner_name_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries_.empty()) {
+    if (reg->entries_.empty()) {
         dbg_->fatal(CALL_INFO, -1, "%s Error: MSHR::setProfiled(0x%" PRIx64 "). Entry list is empty.\n", owner_name_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries_.front().setProfiled();
+    reg->entries_.front().setProfiled();
 }
 
 bool MSHR::getProfiled(Addr addr) {
-//    if (mem_h_is_debug_addr(addr))
-//        dbg_->debug(_L20_, "    MSHR::getProfiled(0x%" PRIx64 "\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 "). Address does not exist in MSHR.\n", owner_name_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries_.empty()) {
+    if (reg->entries_.empty()) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 "). Entry list is empty.\n", owner_name_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.entries_.front().getProfiled();
+    return reg->entries_.front().getProfiled();
 }
 
 bool MSHR::getProfiled(Addr addr, SST::Event::id_type id) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg)
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Address does not exist in MSHR.\n", owner_name_.c_str(), addr, id.first, id.second);
-    if (mshr_.find(addr)->second.entries_.empty())
+    if (reg->entries_.empty())
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Entry list is empty.\n", owner_name_.c_str(), addr, id.first, id.second);
-    for (list<MSHREntry>::iterator jt = mshr_.find(addr)->second.entries_.begin(); jt != mshr_.find(addr)->second.entries_.end(); jt++) {
-        if (jt->getType() == MSHREntryType::Event && jt->getEvent()->getID() == id) {
-            return jt->getProfiled();
+    for (MSHREntry& entry : reg->entries_) {
+        if (entry.getType() == MSHREntryType::Event && entry.getEvent()->getID() == id) {
+            return entry.getProfiled();
         }
     }
     return true; // default so we don't attempt to profile what isn't there
@@ -586,34 +527,32 @@ void MSHR::setProfiled(Addr addr, SST::Event::id_type id) {
     if (mem_h_is_debug_addr(addr))
         printDebug(20, "Profile", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Address does not exist in MSHR.\n", owner_name_.c_str(), addr, id.first, id.second);
     }
-    if (mshr_.find(addr)->second.entries_.empty()) {
+    if (reg->entries_.empty()) {
         dbg_->fatal(CALL_INFO, -1, "%s Error: MSHR::setProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Entry list is empty.\n", owner_name_.c_str(), addr, id.first, id.second);
     }
-    for (list<MSHREntry>::iterator jt = mshr_.find(addr)->second.entries_.begin(); jt != mshr_.find(addr)->second.entries_.end(); jt++) {
-        if (jt->getType() == MSHREntryType::Event && jt->getEvent()->getID() == id) {
-            jt->setProfiled();
+    for (MSHREntry& entry : reg->entries_) {
+        if (entry.getType() == MSHREntryType::Event && entry.getEvent()->getID() == id) {
+            entry.setProfiled();
             return;
         }
     }
 }
 
 MSHREntry* MSHR::getOldestEntry() {
-    bool first = false;
     MSHREntry* entry = nullptr;
-    uint64_t time;
-
-    for (MSHRBlock::iterator it = mshr_.begin(); it != mshr_.end(); it++) {
-        for (list<MSHREntry>::iterator jt = it->second.entries_.begin(); jt != it->second.entries_.end(); jt++) {
-            if (jt->getType() == MSHREntryType::Event) {
-                if (!first) {
-                    entry = &(*jt);
-                    time = jt->getStartTime();
-                } else if (jt->getStartTime() < time) {
-                    entry = &(*jt);
-                    time = jt->getStartTime();
+    uint64_t time = 0;
+
+    // Ties go to the lowest address so the result does not depend on table layout
+    for (Addr addr : mshr_.getAddrs()) {
+        for (MSHREntry& candidate : mshr_.find(addr)->entries_) {
+            if (candidate.getType() == MSHREntryType::Event) {
+                if (!entry || candidate.getStartTime() < time) {
+                    entry = &candidate;
+                    time = candidate.getStartTime();
                 }
             }
         }
@@ -622,110 +561,93 @@ MSHREntry* MSHR::getOldestEntry() {
 }
 
 void MSHR::incrementAcksNeeded(Addr addr) {
-   // if (mem_h_is_debug_addr(addr))
-   //     dbg_->debug(_L10_, "    MSHR::incrementAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        mshr_.insert(std::make_pair(addr, reg));
-    }
-    mshr_.find(addr)->second.acks_needed_++;
+    MSHRRegister& reg = mshr_.insert(addr);
+    reg.acks_needed_++;
 
     if (mem_h_is_debug_addr(addr)) {
         std::stringstream reason;
-        reason << mshr_.find(addr)->second.acks_needed_ << " acks";
+        reason << reg.acks_needed_ << " acks";
         printDebug(10, "IncAck", addr, reason.str());
     }
 }
 
 /* Decrement acks needed and return if we're done waiting (acks_needed_ == 0) */
 bool MSHR::decrementAcksNeeded(Addr addr) {
-   // if (mem_h_is_debug_addr(addr))
-   //     dbg_->debug(_L10_, "    MSHR::decrementAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::decrementAcksNeeded(0x%" PRIx64 "). Address does not exist in MSHR.\n", owner_name_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.acks_needed_ == 0) {
+    if (reg->acks_needed_ == 0) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::decrementAcksNeeded(0x%" PRIx64 "). AcksNeeded is already 0.\n", owner_name_.c_str(), addr);
     }
-    mshr_.find(addr)->second.acks_needed_--;
+    reg->acks_needed_--;
 
     if (mem_h_is_debug_addr(addr)) {
         std::stringstream reason;
-        reason << mshr_.find(addr)->second.acks_needed_ << " acks";
+        reason << reg->acks_needed_ << " acks";
         printDebug(10, "DecAck", addr, reason.str());
     }
 
-    return (mshr_.find(addr)->second.acks_needed_ == 0);
+    return (reg->acks_needed_ == 0);
 }
 
 uint32_t MSHR::getAcksNeeded(Addr addr) {
-//    if (mem_h_is_debug_addr(addr))
-//        dbg_->debug(_L20_, "    MSHR::getAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        return 0;
-    }
-    return (mshr_.find(addr)->second.acks_needed_);
+    MSHRRegister * reg = mshr_.find(addr);
+    return reg ? reg->acks_needed_ : 0;
 }
 
 void MSHR::setData(Addr addr, vector<uint8_t>& data, bool dirty) {
-//    if (mem_h_is_debug_addr(addr))
-//        dbg_->debug(_L10_, "    MSHR::setData(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setData(0x%" PRIx64 "). Address does not exist in MSHR.\n", owner_name_.c_str(), addr);
     }
 
     if (mem_h_is_debug_addr(addr))
         printDebug(10, "SetData", addr, (dirty ? "Dirty" : "Clean"));
 
-    mshr_.find(addr)->second.data_buffer_ = data;
-    mshr_.find(addr)->second.data_dirty_ = dirty;
+    reg->data_buffer_ = data;
+    reg->data_dirty_ = dirty;
 }
 
 void MSHR::clearData(Addr addr) {
-//    if (mem_h_is_debug_addr(addr))
-//        dbg_->debug(_L10_, "    MSHR::clearData(0x%" PRIx64 ")\n", addr);
     if (mem_h_is_debug_addr(addr))
         printDebug(10, "ClrData", addr, "");
 
-    mshr_.find(addr)->second.data_buffer_.clear();
-    mshr_.find(addr)->second.data_dirty_ = false;
+    MSHRRegister * reg = mshr_.find(addr);
+    reg->data_buffer_.clear();
+    reg->data_dirty_ = false;
 }
 
 vector<uint8_t>& MSHR::getData(Addr addr) {
-//    if (mem_h_is_debug_addr(addr))
-//        dbg_->debug(_L20_, "    MSHR::getData(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getData(0x%" PRIx64 "). Address does not exist in MSHR.\n", owner_name_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.data_buffer_;
+    return reg->data_buffer_;
 }
 
 bool MSHR::hasData(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
-        return false;
-    return !(mshr_.find(addr)->second.data_buffer_.empty());
+    MSHRRegister * reg = mshr_.find(addr);
+    return reg && !(reg->data_buffer_.empty());
 }
 
 bool MSHR::getDataDirty(Addr addr) {
-//    if (mem_h_is_debug_addr(addr))
-//        dbg_->debug(_L20_, "    MSHR::getDataDirty(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getDataDirty(0x%" PRIx64 "). Address does not exist in MSHR.\n", owner_name_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.data_dirty_;
+    return reg->data_dirty_;
 }
 
 void MSHR::setDataDirty(Addr addr, bool dirty) {
-//    if (mem_h_is_debug_addr(addr))
-//        dbg_->debug(_L10_, "    MSHR::setDataDirty(0x%" PRIx64 ")\n", addr);
-
     if (mem_h_is_debug_addr(addr))
         printDebug(20, "SetDirt", addr, (dirty ? "Dirty" : "Clean"));
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = mshr_.find(addr);
+    if (!reg) {
         dbg_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setDataDirty(0x%" PRIx64 "). Address does not exist in MSHR.\n", owner_name_.c_str(), addr);
     }
-    mshr_.find(addr)->second.data_dirty_ = dirty;
+    reg->data_dirty_ = dirty;
 
 }
 
@@ -751,10 +673,10 @@ void MSHR::printDebug(uint32_t lev, std::string action, Addr addr, std::string r
 // Print status. Called by cache controller on EmergencyShutdown and printStatus()
 void MSHR::printStatus(Output &out) {
     out.output("    MSHR Status for %s. Size: %u. Prefetches: %u\b", owner_name_.c_str(), size_, prefetch_count_);
-    for (std::map<Addr,MSHRRegister>::iterator it = mshr_.begin(); it != mshr_.end(); it++) {   // Iterate over addresses
-        out.output("      Entry: Addr = 0x%" PRIx64 "\n", (it->first));
-        for (std::list<MSHREntry>::iterator it2 = it->second.entries_.begin(); it2 != it->second.entries_.end(); it2++) { // Iterate over entries for each address
-            out.output("        %s\n", it2->getString().c_str());
+    for (Addr addr : mshr_.getAddrs()) {   // Iterate over addresses
+        out.output("      Entry: Addr = 0x%" PRIx64 "\n", addr);
+        for (MSHREntry& entry : mshr_.find(addr)->entries_) { // Iterate over entries for each address
+            out.output("        %s\n", entry.getString().c_str());
         }
     }
     out.output("    End MSHR Status for %s\n", owner_name_.c_str());
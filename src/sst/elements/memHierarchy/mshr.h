@@ -16,11 +16,14 @@
 #ifndef _MSHR_H_
 #define _MSHR_H_
 
+#include <algorithm>
+#include <deque>
 #include <list>
 
 #include <map>
 #include <string>
 #include <sstream>
+#include <vector>
 
 #include <sst/core/event.h>
 #include <sst/core/sst_types.h>
@@ -84,16 +87,10 @@ public:
         downgrade_ = false;
     }
 
-    MSHREntry(const MSHREntry& entry) {
-        entry_type_ = entry.entry_type_;
-        evict_ptrs_ = entry.evict_ptrs_;
-        event_ = entry.event_;
-        time_ = entry.time_;
-        in_progress_ = entry.in_progress_;
-        need_evict_ = entry.need_evict_;
-        profiled_ = entry.profiled_;
-        downgrade_ = entry.downgrade_;
-    }
+    MSHREntry(const MSHREntry& entry) = default;
+    MSHREntry(MSHREntry&& entry) = default;     // Entry queues shift entries on insert/remove
+    MSHREntry& operator=(const MSHREntry& entry) = default;
+    MSHREntry& operator=(MSHREntry&& entry) = default;
 
     MSHREntry() { } // For serialization only
 
@@ -180,9 +177,13 @@ public:
         bool downgrade_ = false;        // Specific to Writeback type
 };
 
+/* Per-address entry queue. A vector so that a recycled register keeps its
+ * storage; queues are short, so shifting on a front/middle insert is cheap. */
+typedef std::vector<MSHREntry> MSHREntryQueue;
+
 struct MSHRRegister {
     MSHRRegister() { }
-    list<MSHREntry> entries_;
+    MSHREntryQueue entries_;
     uint32_t acks_needed_ = 0;
     vector<uint8_t> data_buffer_;
     bool data_dirty_ = false;
@@ -199,9 +200,163 @@ struct MSHRRegister {
         SST_SER(data_dirty_);
         SST_SER(pending_retries_);
     }
+
+    /* Return to the empty state, keeping entries_ storage unless it grew past 'max_keep' */
+    void reset(size_t max_keep) {
+        entries_.clear();
+        if (entries_.capacity() > max_keep)
+            MSHREntryQueue().swap(entries_);
+        acks_needed_ = 0;
+        data_buffer_.clear();
+        data_dirty_ = false;
+        pending_retries_ = 0;
+    }
 };
 
-typedef map<Addr, MSHRRegister> MSHRBlock;
+/*
+ * Maps each address to its MSHRRegister.
+ * Registers live in a pool (std::deque, so references stay valid as it grows)
+ * and are recycled when an address leaves the MSHR. Addresses map to pool
+ * slots through an open-addressing table with linear probing and
+ * backward-shift deletion, kept at most half full. Sized from the MSHR's
+ * entry limit so a bounded MSHR never rehashes in steady state.
+ */
+class MSHRBlock {
+public:
+    MSHRBlock(size_t expected_addrs = 16) : count_(0) {
+        size_t cap = 16;
+        while (cap < expected_addrs * 2) cap <<= 1;
+        buckets_.assign(cap, Bucket());
+    }
+
+    /* Return the register for 'addr' or nullptr if the address is not in the MSHR */
+    MSHRRegister* find(Addr addr) {
+        size_t idx = probe(addr);
+        return buckets_[idx].used ? &pool_[buckets_[idx].slot] : nullptr;
+    }
+
+    /* Return the register for 'addr', creating an empty one if needed */
+    MSHRRegister& insert(Addr addr) {
+        if ((count_ + 1) * 2 > buckets_.size())
+            grow();
+        size_t idx = probe(addr);
+        if (!buckets_[idx].used) {
+            buckets_[idx].used = true;
+            buckets_[idx].addr = addr;
+            buckets_[idx].slot = allocate();
+            count_++;
+        }
+        return pool_[buckets_[idx].slot];
+    }
+
+    void erase(Addr addr) {
+        size_t idx = probe(addr);
+        if (!buckets_[idx].used)
+            return;
+        pool_[buckets_[idx].slot].reset(MAX_POOLED_ENTRIES);
+        free_slots_.push_back(buckets_[idx].slot);
+        buckets_[idx].used = false;
+        count_--;
+
+        // Backward-shift the rest of the probe run so lookups never need tombstones
+        size_t mask = buckets_.size() - 1;
+        size_t hole = idx;
+        size_t next = (idx + 1) & mask;
+        while (buckets_[next].used) {
+            size_t home = hash(buckets_[next].addr) & mask;
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                buckets_[hole] = buckets_[next];
+                buckets_[next].used = false;
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+    }
+
+    size_t size() const { return count_; }
+
+    /* Addresses currently in the MSHR, in ascending order */
+    std::vector<Addr> getAddrs() const {
+        std::vector<Addr> addrs;
+        addrs.reserve(count_);
+        for (const Bucket& b : buckets_) {
+            if (b.used) addrs.push_back(b.addr);
+        }
+        std::sort(addrs.begin(), addrs.end());
+        return addrs;
+    }
+
+    /* Registers are (de)serialized by address so slot assignment need not match across restart */
+    void serialize_order(SST::Core::Serialization::serializer& ser) {
+        std::vector<Addr> addrs;
+        std::vector<MSHRRegister> regs;
+        if (ser.mode() != SST::Core::Serialization::serializer::UNPACK) {
+            addrs = getAddrs();
+            for (Addr addr : addrs)
+                regs.push_back(*find(addr));
+        }
+        SST_SER(addrs);
+        SST_SER(regs);
+        if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
+            for (size_t i = 0; i < addrs.size(); i++)
+                insert(addrs[i]) = regs[i];
+        }
+    }
+
+private:
+    static const size_t MAX_POOLED_ENTRIES = 16;   // Larger queues are freed when their address leaves the MSHR
+
+    struct Bucket {
+        Bucket() : addr(0), slot(0), used(false) {}
+        Addr addr;
+        uint32_t slot;
+        bool used;
+    };
+
+    static size_t hash(Addr addr) {
+        // splitmix64 finalizer - line addresses share their low bits
+        addr ^= addr >> 30;
+        addr *= 0xBF58476D1CE4E5B9ULL;
+        addr ^= addr >> 27;
+        addr *= 0x94D049BB133111EBULL;
+        addr ^= addr >> 31;
+        return (size_t)addr;
+    }
+
+    /* Index of the bucket holding 'addr', or the empty bucket where it belongs */
+    size_t probe(Addr addr) const {
+        size_t mask = buckets_.size() - 1;
+        size_t idx = hash(addr) & mask;
+        while (buckets_[idx].used && buckets_[idx].addr != addr)
+            idx = (idx + 1) & mask;
+        return idx;
+    }
+
+    void grow() {
+        std::vector<Bucket> old;
+        old.swap(buckets_);
+        buckets_.assign(old.size() * 2, Bucket());
+        for (const Bucket& b : old) {
+            if (b.used)
+                buckets_[probe(b.addr)] = b;
+        }
+    }
+
+    uint32_t allocate() {
+        if (!free_slots_.empty()) {
+            uint32_t slot = free_slots_.back();
+            free_slots_.pop_back();
+            return slot;
+        }
+        pool_.emplace_back();
+        return pool_.size() - 1;
+    }
+
+    std::vector<Bucket> buckets_;
+    std::deque<MSHRRegister> pool_;
+    std::vector<uint32_t> free_slots_;
+    size_t count_;
+};
 
 /**
  *  Implements an MSHR with entries of type mshrEntry
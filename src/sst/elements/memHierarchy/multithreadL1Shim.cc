@@ -68,12 +68,43 @@ MultiThreadL1::MultiThreadL1(ComponentId_t id, Params &params) : Component(id) {
     /* Setup throughput limiting */
     requestsPerCycle = params.find<uint64_t>("requests_per_cycle", 0);
     responsesPerCycle = params.find<uint64_t>("responses_per_cycle", 0);
+
+    /* Setup arbitration between threads */
+    std::string arb = params.find<std::string>("arbitration", "fifo");
+    if (arb == "fifo") arbitration = Arbitration::FIFO;
+    else if (arb == "round_robin") arbitration = Arbitration::ROUND_ROBIN;
+    else if (arb == "icount") arbitration = Arbitration::ICOUNT;
+    else if (arb == "priority") arbitration = Arbitration::PRIORITY;
+    else
+        output.fatal(CALL_INFO, -1, "%s, Error: invalid param 'arbitration'. Options are 'fifo', 'round_robin', 'icount', and 'priority'. You specified '%s'\n",
+                getName().c_str(), arb.c_str());
+
+    params.find_array<uint64_t>("thread_priority", threadPriority);
+    if (threadPriority.size() > threadLinks.size())
+        output.fatal(CALL_INFO, -1, "%s, Error: param 'thread_priority' lists %zu priorities but only %zu threads are connected\n",
+                getName().c_str(), threadPriority.size(), threadLinks.size());
+    threadPriority.resize(threadLinks.size(), 0);
+
+    threadMaxOutstanding = params.find<uint64_t>("thread_max_outstanding", 0);
+    threadOutstanding.resize(threadLinks.size(), 0);
+    requestQueues.resize(threadLinks.size());
+    requestsWaiting = 0;
+    rrNext = 0;
+
+    for (unsigned int i = 0; i < threadLinks.size(); i++) {
+        stat_threadRequests.push_back(registerStatistic<uint64_t>("thread_requests", std::to_string(i)));
+        stat_threadLatency.push_back(registerStatistic<uint64_t>("thread_latency", std::to_string(i)));
+        stat_threadStallCycles.push_back(registerStatistic<uint64_t>("thread_stall_cycles", std::to_string(i)));
+        stat_threadMSHRFull.push_back(registerStatistic<uint64_t>("thread_mshr_full", std::to_string(i)));
+    }
 }
 
 MultiThreadL1::~MultiThreadL1() {
-    while (requestQueue.size()) {
-        delete requestQueue.front();
-        requestQueue.pop();
+    for (unsigned int i = 0; i < requestQueues.size(); i++) {
+        while (requestQueues[i].size()) {
+            delete requestQueues[i].front();
+            requestQueues[i].pop();
+        }
     }
     while (responseQueue.size()) {
         delete responseQueue.front();
@@ -84,8 +115,11 @@ MultiThreadL1::~MultiThreadL1() {
 void MultiThreadL1::handleRequest(SST::Event * ev, unsigned int threadid) {
     MemEventBase *event = static_cast<MemEventBase*>(ev);
     if (!clockOn) enableClock();
-    threadRequestMap.insert(std::make_pair(event->getID(), threadid));
-    requestQueue.push(event);
+    threadRequestMap.insert(std::make_pair(event->getID(), std::make_pair(threadid, timestamp)));
+    requestQueues[threadid].push(event);
+    if (arbitration == Arbitration::FIFO)
+        arrivalOrder.push(threadid);
+    requestsWaiting++;
 }
 
 void MultiThreadL1::handleResponse(SST::Event * ev) {
@@ -97,15 +131,38 @@ void MultiThreadL1::handleResponse(SST::Event * ev) {
 bool MultiThreadL1::tick(SST::Cycle_t cycle) {
     timestamp++;
 
-    uint64_t sendcount = (requestsPerCycle == 0) ? requestQueue.size() : requestsPerCycle;
+    uint64_t sendcount = (requestsPerCycle == 0) ? requestsWaiting : requestsPerCycle;
 
-    /* Drain request queue */
-    while (!requestQueue.empty() && sendcount > 0) {
-        cacheLink->send(requestQueue.front());
-        requestQueue.pop();
+    /* Drain request queues in the order chosen by the arbitration policy */
+    std::vector<bool> sent(threadLinks.size(), false);
+    while (sendcount > 0) {
+        int thread = selectThread();
+        if (thread < 0)
+            break;
+
+        MemEventBase * event = requestQueues[thread].front();
+        requestQueues[thread].pop();
+        if (arbitration == Arbitration::FIFO)
+            arrivalOrder.pop();
+        requestsWaiting--;
+
+        if (!event->queryFlag(MemEventBase::F_NORESPONSE))
+            threadOutstanding[thread]++;
+        stat_threadRequests[thread]->addData(1);
+        sent[thread] = true;
+
+        cacheLink->send(event);
         sendcount--;
     }
 
+    for (unsigned int i = 0; i < threadLinks.size(); i++) {
+        if (!sent[i] && !requestQueues[i].empty()) {
+            stat_threadStallCycles[i]->addData(1);
+            if (!canSend(i))
+                stat_threadMSHRFull[i]->addData(1);
+        }
+    }
+
     sendcount = (responsesPerCycle == 0) ? responseQueue.size() : responsesPerCycle;
 
     /* Drain response queue */
@@ -113,15 +170,19 @@ bool MultiThreadL1::tick(SST::Cycle_t cycle) {
         MemEventBase * event = responseQueue.front();
         responseQueue.pop();
 
-        unsigned int linkid = threadRequestMap.find(event->getResponseToID())->second;
-        threadRequestMap.erase(event->getResponseToID());
+        std::map<Event::id_type, std::pair<unsigned int, uint64_t> >::iterator req = threadRequestMap.find(event->getResponseToID());
+        unsigned int linkid = req->second.first;
+        stat_threadLatency[linkid]->addData(timestamp - req->second.second);
+        threadRequestMap.erase(req);
+        if (threadOutstanding[linkid] > 0)
+            threadOutstanding[linkid]--;
         threadLinks[linkid]->send(event);
 
         sendcount--;
     }
 
     /* Turn off clock if queues are empty */
-    if (requestQueue.empty() && responseQueue.empty()) {
+    if (requestsWaiting == 0 && responseQueue.empty()) {
         clockOn = false;
         return true;
     }
@@ -134,6 +195,45 @@ inline void MultiThreadL1::enableClock() {
     timestamp--;
 }
 
+/* Whether a thread's MSHR partition has room for another request */
+bool MultiThreadL1::canSend(unsigned int thread) {
+    return threadMaxOutstanding == 0 || threadOutstanding[thread] < threadMaxOutstanding;
+}
+
+/*
+ * Pick the thread whose oldest waiting request is forwarded next, or -1 if none can go.
+ * fifo stays in arrival order, so a thread at its MSHR limit blocks the threads behind it.
+ * The other policies skip such threads. Ties in icount and priority go to the thread
+ * after the last one picked so that equal threads alternate.
+ */
+int MultiThreadL1::selectThread() {
+    if (arbitration == Arbitration::FIFO) {
+        if (arrivalOrder.empty() || !canSend(arrivalOrder.front()))
+            return -1;
+        return arrivalOrder.front();
+    }
+
+    unsigned int threads = threadLinks.size();
+    int best = -1;
+    for (unsigned int i = 0; i < threads; i++) {
+        unsigned int thread = (rrNext + i) % threads;
+        if (requestQueues[thread].empty() || !canSend(thread))
+            continue;
+        if (best < 0) {
+            best = thread;
+            if (arbitration == Arbitration::ROUND_ROBIN)
+                break;
+        } else if (arbitration == Arbitration::ICOUNT && threadOutstanding[thread] < threadOutstanding[best]) {
+            best = thread;
+        } else if (arbitration == Arbitration::PRIORITY && threadPriority[thread] > threadPriority[best]) {
+            best = thread;
+        }
+    }
+    if (best >= 0)
+        rrNext = (best + 1) % threads;
+    return best;
+}
+
 /** SST init/finish */
 void MultiThreadL1::setup() {}
 
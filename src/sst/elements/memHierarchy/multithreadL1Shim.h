@@ -43,6 +43,11 @@ public:
             {"clock",               "(string) Clock frequency or period with units (Hz or s; SI units OK).", NULL},
             {"requests_per_cycle",  "(uint) Number of requests to forward to L1 each cycle (for all threads combined). 0 indicates unlimited", "0"},
             {"responses_per_cycle", "(uint) Number of responses to forward to threads each cycle (for all threads combined). 0 indicates unlimited", "0"},
+            {"arbitration",         "(string) Policy for choosing which thread's request to forward next. Options: 'fifo' - arrival order across all threads, "
+                                    "'round_robin' - rotate between threads with waiting requests, 'icount' - thread with the fewest requests outstanding at the L1 first, "
+                                    "'priority' - highest 'thread_priority' first, round robin among equal priorities", "fifo"},
+            {"thread_priority",     "(comma separated uint) For 'priority' arbitration, priority of each thread, higher is served first. Threads not listed get 0. Start and end with brackets", ""},
+            {"thread_max_outstanding", "(uint) Per-thread partition of the L1 MSHR: maximum requests a thread may have outstanding at the L1. 0 indicates unlimited", "0"},
             {"debug",               "(uint) Where to print debug output. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
             {"debug_level",         "(uint) Debug verbosity level. Between 0 and 10", "0"},
             {"debug_addr",          "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""} )
@@ -51,6 +56,12 @@ public:
           {"cache", "Link to L1 cache", {"memHierarchy.MemEventBase"} },
           {"thread%(port)d", "Links to threads/cores", {"memHierarchy.MemEventBase"} } )
 
+    SST_ELI_DOCUMENT_STATISTICS(
+          {"thread_requests",     "Requests forwarded to the L1, one statistic per thread", "count", 1},
+          {"thread_latency",      "Time from a request's arrival at the shim to its response being forwarded, one statistic per thread", "cycles", 1},
+          {"thread_stall_cycles", "Cycles in which a thread had a request waiting that was not forwarded, one statistic per thread", "cycles", 1},
+          {"thread_mshr_full",    "Cycles in which a thread's request was held back by thread_max_outstanding, one statistic per thread", "cycles", 2} )
+
 /* Begin class definition */
     /** Constructor & destructor */
     MultiThreadL1(ComponentId_t id, Params &params);
@@ -86,16 +97,34 @@ private:
     Clock::HandlerBase* clockHandler;
     TimeConverter       clock;
 
-    /** Track outstanding requests for routing responses correctly */
-    std::map<Event::id_type, unsigned int> threadRequestMap;
+    /** Track outstanding requests for routing responses correctly and for latency */
+    std::map<Event::id_type, std::pair<unsigned int, uint64_t> > threadRequestMap;
 
     /** Throughput control */
     uint64_t requestsPerCycle;
     uint64_t responsesPerCycle;
-    std::queue<MemEventBase*> requestQueue;
+    std::vector<std::queue<MemEventBase*> > requestQueues;  // Waiting requests, per thread
+    std::queue<unsigned int> arrivalOrder;                  // For fifo arbitration, thread of each waiting request in arrival order
     std::queue<MemEventBase*> responseQueue;
 
+    /** Arbitration */
+    enum class Arbitration { FIFO, ROUND_ROBIN, ICOUNT, PRIORITY };
+    Arbitration arbitration;
+    std::vector<uint64_t> threadPriority;
+    std::vector<uint64_t> threadOutstanding;   // Requests at the L1 that expect a response, per thread
+    uint64_t threadMaxOutstanding;
+    unsigned int rrNext;                        // Next thread to consider for round robin & priority ties
+    uint64_t requestsWaiting;
+
+    /** Per-thread statistics */
+    std::vector<Statistic<uint64_t>*> stat_threadRequests;
+    std::vector<Statistic<uint64_t>*> stat_threadLatency;
+    std::vector<Statistic<uint64_t>*> stat_threadStallCycles;
+    std::vector<Statistic<uint64_t>*> stat_threadMSHRFull;
+
     inline void enableClock();
+    bool canSend(unsigned int thread);
+    int selectThread();
 };
 
 }
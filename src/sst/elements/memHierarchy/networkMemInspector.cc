@@ -22,7 +22,7 @@
 namespace SST { namespace MemHierarchy {
 
 networkMemInspector::networkMemInspector(ComponentId_t id, Params &params, const std::string& sub_id)
-    : NetworkInspector(id) {
+    : NetworkInspector(id), traceFile_(nullptr), ringHead_(0), ringCount_(0) {
     // should fix to have this be a param
     dbg.init("@R:netMemInspect::@p():@l " + getName() + ": ", 0, 0,
              Output::STDOUT);
@@ -31,15 +31,116 @@ networkMemInspector::networkMemInspector(ComponentId_t id, Params &params, const
     for (int i = 0; i < (int)Command::LAST_CMD; ++i) {
         memCmdStat[i] = registerStatistic<uint64_t>(CommandString[i],sub_id);
     }
+
+    std::string tracePrefix = params.find<std::string>("trace_file", "");
+    if (tracePrefix.empty())
+        return;
+
+    std::vector<std::string> ranges;
+    params.find_array<std::string>("trace_ranges", ranges);
+    for (auto& range : ranges) {
+        size_t pos = range.find('-');
+        if (pos == std::string::npos)
+            dbg.fatal(CALL_INFO, -1, "%s, Invalid param: trace_ranges - entries must be 'start-end'. You specified '%s'.\n", getName().c_str(), range.c_str());
+        Addr start = std::stoull(range.substr(0, pos), nullptr, 0);
+        Addr end = std::stoull(range.substr(pos + 1), nullptr, 0);
+        if (end < start)
+            dbg.fatal(CALL_INFO, -1, "%s, Invalid param: trace_ranges - end is less than start in '%s'.\n", getName().c_str(), range.c_str());
+        traceRanges_.push_back(std::make_pair(start, end));
+    }
+
+    size_t entries = params.find<size_t>("ring_entries", 4096);
+    if (entries == 0)
+        dbg.fatal(CALL_INFO, -1, "%s, Invalid param: ring_entries - must be at least 1.\n", getName().c_str());
+    ring_.resize(entries);
+
+    std::string traceName = getParentComponentName() + "." + sub_id;
+    std::string path = tracePrefix + "." + traceName + ".nmt";
+    traceFile_ = fopen(path.c_str(), "wb");
+    if (!traceFile_)
+        dbg.fatal(CALL_INFO, -1, "%s, Error: unable to open trace file '%s'.\n", getName().c_str(), path.c_str());
+    uint32_t nameLength = traceName.size();
+    fwrite("MHNETTR1", 1, 8, traceFile_);
+    fwrite(&nameLength, sizeof(nameLength), 1, traceFile_);
+    fwrite(traceName.c_str(), 1, nameLength, traceFile_);
+
+    registerClock(params.find<std::string>("flush_period", "10us"),
+            new Clock::Handler2<networkMemInspector, &networkMemInspector::flushTick>(this));
+}
+
+networkMemInspector::~networkMemInspector() {
+    if (traceFile_)
+        fclose(traceFile_);
 }
 
 void networkMemInspector::inspectNetworkData(SimpleNetwork::Request* req) {
     MemNIC::MemRtrEvent *mre = dynamic_cast<MemNIC::MemRtrEvent*>(req->inspectPayload());
-    if (mre) {
-        memCmdStat[(int)mre->inspectEvent()->getCmd()]->addData(1);
-    } else {
+    if (!mre) {
         dbg.output(CALL_INFO,"Unexpected payload encountered. Ignoring.\n");
+        return;
+    }
+
+    MemEventBase* ev = mre->inspectEvent();
+    memCmdStat[(int)ev->getCmd()]->addData(1);
+    if (!traceFile_)
+        return;
+
+    if (!traceRanges_.empty()) {
+        Addr addr = ev->getRoutingAddress();
+        bool inRange = false;
+        for (auto& range : traceRanges_) {
+            if (addr >= range.first && addr <= range.second) {
+                inRange = true;
+                break;
+            }
+        }
+        if (!inRange)
+            return;
     }
+
+    uint32_t cmdClass = (uint32_t)CommandClassArr[(int)ev->getCmd()];
+    auto key = std::make_tuple(req->src, req->dest, cmdClass);
+    auto it = flowIndex_.find(key);
+    if (it == flowIndex_.end()) {
+        if (ringCount_ == ring_.size()) { // Full, write out the oldest flow
+            FlowRecord &oldest = ring_[ringHead_];
+            flowIndex_.erase(std::make_tuple(oldest.src, oldest.dst, oldest.cmdClass));
+            writeRecord(oldest);
+            ringHead_ = (ringHead_ + 1) % ring_.size();
+            ringCount_--;
+        }
+        size_t slot = (ringHead_ + ringCount_) % ring_.size();
+        ring_[slot] = { 0, req->src, req->dest, cmdClass, 0, 0, 0 };
+        it = flowIndex_.insert(std::make_pair(key, slot)).first;
+        ringCount_++;
+    }
+    ring_[it->second].packets++;
+    ring_[it->second].bytes += req->size_in_bits / 8;
+}
+
+void networkMemInspector::writeRecord(FlowRecord &rec) {
+    rec.time = getCurrentSimTimeNano();
+    fwrite(&rec, sizeof(FlowRecord), 1, traceFile_);
+}
+
+void networkMemInspector::flushAll() {
+    for (size_t i = 0; i < ringCount_; i++)
+        writeRecord(ring_[(ringHead_ + i) % ring_.size()]);
+    ringHead_ = 0;
+    ringCount_ = 0;
+    flowIndex_.clear();
+    fflush(traceFile_);
+}
+
+bool networkMemInspector::flushTick(Cycle_t cycle) {
+    if (ringCount_ != 0)
+        flushAll();
+    return false;
+}
+
+void networkMemInspector::finish() {
+    if (traceFile_)
+        flushAll();
 }
 
 }} // close sst::memhierarchy namespace
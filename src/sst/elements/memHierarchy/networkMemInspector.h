@@ -18,6 +18,10 @@
 #ifndef NETWORKMEMINSECTOR_H_
 #define NETWORKMEMINSECTOR_H_
 
+#include <map>
+#include <tuple>
+#include <vector>
+
 #include <sst/core/output.h>
 #include <sst/core/interfaces/simpleNetwork.h>
 
@@ -41,18 +45,55 @@ public:
         SST::Interfaces::SimpleNetwork::NetworkInspector
     )
 
+    /* Routers pass parameters to their inspectors as 'portcontrol.inspector.<param>' */
+    SST_ELI_DOCUMENT_PARAMS(
+        {"trace_file",      "(string) Prefix of the binary flow trace files, one per inspected port: <prefix>.<router>.<port>.nmt. Empty disables tracing.", ""},
+        {"trace_ranges",    "(array of string) Only trace events whose routing address is in one of these 'start-end' ranges (inclusive). Empty traces all addresses.", ""},
+        {"ring_entries",    "(uint) Number of flow records held before the oldest is written out", "4096"},
+        {"flush_period",    "(UnitAlgebra) Period at which all flow records are written out, e.g., '10us'", "10us"} )
+
     SST_ELI_DOCUMENT_STATISTICS( networkMemoryInspector_statistics ) // Defined in memTypes.h via x macro
 
 /* Begin class definition */
     networkMemInspector(ComponentId_t, Params &params, const std::string& sub_id);
 
-    virtual ~networkMemInspector() {}
+    virtual ~networkMemInspector();
 
     virtual void inspectNetworkData(SimpleNetwork::Request* req);
+    virtual void finish();
 
     Output dbg;
     // statistics
     Statistic<uint64_t>*  memCmdStat[(int)Command::LAST_CMD];
+
+private:
+    /* Trace file format (host byte order):
+     *   Header: char magic[8] = "MHNETTR1", uint32_t name length, char name[] (router.port)
+     *   Records: FlowRecord
+     * A flow's counts cover the time since its previous record
+     */
+    struct FlowRecord {
+        uint64_t time;          // ns, time the record was written
+        int64_t src;            // Network source endpoint
+        int64_t dst;            // Network destination endpoint
+        uint32_t cmdClass;      // CommandClass
+        uint32_t pad;
+        uint64_t packets;
+        uint64_t bytes;
+    };
+
+    bool flushTick(Cycle_t cycle);
+    void writeRecord(FlowRecord &rec);
+    void flushAll();
+
+    FILE* traceFile_;
+    std::vector<std::pair<Addr,Addr> > traceRanges_;
+
+    /* Flow records in a fixed ring, indexed by flow */
+    std::vector<FlowRecord> ring_;
+    size_t ringHead_;
+    size_t ringCount_;
+    std::map<std::tuple<int64_t,int64_t,uint32_t>, size_t> flowIndex_;
 };
 
 }}
@@ -0,0 +1,171 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_PAYLOAD_H
+#define MEMHIERARCHY_PAYLOAD_H
+
+#include <atomic>
+#include <vector>
+
+#include <sst/core/serialization/serializable.h>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Reference-counted, copy-on-write data payload.
+ *
+ * Copying a SharedPayload (e.g., when an event is copied to make its response,
+ * or when data is forwarded from one event to the next) only adds a reference.
+ * The data is copied when a holder asks for write access while the buffer is
+ * shared. References returned by write() are therefore only valid until the
+ * payload is next copied.
+ *
+ * Released buffers are kept on a per-thread free list and reused, so the
+ * vector's storage is not reallocated for each new event.
+ */
+class SharedPayload {
+public:
+    typedef std::vector<uint8_t> dataVec;
+
+    SharedPayload() : buf_(nullptr) { }
+    SharedPayload(const SharedPayload& rhs) : buf_(rhs.buf_) {
+        if (buf_) buf_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    SharedPayload& operator=(const SharedPayload& rhs) {
+        Buffer* buf = rhs.buf_;
+        if (buf) buf->refs.fetch_add(1, std::memory_order_relaxed);
+        release();
+        buf_ = buf;
+        return *this;
+    }
+    ~SharedPayload() { release(); }
+
+    /* Read-only access, never copies */
+    const dataVec& read() const { return buf_ ? buf_->data : emptyVec(); }
+
+    /* Writable access, copies the data first if the buffer is shared */
+    dataVec& write() {
+        if (!buf_) {
+            buf_ = acquire();
+        } else if (buf_->refs.load(std::memory_order_acquire) > 1) {
+            Buffer* copy = acquire();
+            copy->data = buf_->data;
+            release();
+            buf_ = copy;
+        }
+        return buf_->data;
+    }
+
+    /* Replace the contents. Does not copy the old data even if shared. */
+    void assign(const dataVec& data) {
+        makeExclusive();
+        buf_->data = data;
+    }
+
+    void assign(size_t size, const uint8_t* data) {
+        makeExclusive();
+        buf_->data.assign(data, data + size);
+    }
+
+    void assign(size_t size, uint8_t value) {
+        makeExclusive();
+        buf_->data.assign(size, value);
+    }
+
+    void clear() { release(); }
+
+    size_t size() const { return buf_ ? buf_->data.size() : 0; }
+    bool empty() const { return size() == 0; }
+    bool isShared() const { return buf_ && buf_->refs.load(std::memory_order_relaxed) > 1; }
+
+    void serialize_order(SST::Core::Serialization::serializer& ser) {
+        dataVec data;
+        if (ser.mode() != SST::Core::Serialization::serializer::UNPACK)
+            data = read();
+        SST_SER(data);
+        if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
+            release();
+            if (!data.empty())
+                assign(data);
+        }
+    }
+
+private:
+    static constexpr size_t MAX_POOLED = 4096; // Per-thread cap on the free list
+
+    struct Buffer {
+        std::atomic<uint32_t> refs;
+        dataVec data;
+    };
+
+    struct Pool {
+        std::vector<Buffer*> free;
+        ~Pool() {
+            for (Buffer* buf : free)
+                delete buf;
+        }
+    };
+
+    static Pool& pool() {
+        thread_local Pool p;
+        return p;
+    }
+
+    static const dataVec& emptyVec() {
+        static const dataVec empty;
+        return empty;
+    }
+
+    static Buffer* acquire() {
+        Pool& p = pool();
+        Buffer* buf;
+        if (p.free.empty()) {
+            buf = new Buffer();
+        } else {
+            buf = p.free.back();
+            p.free.pop_back();
+            buf->data.clear(); // Keeps capacity
+        }
+        buf->refs.store(1, std::memory_order_relaxed);
+        return buf;
+    }
+
+    void release() {
+        if (!buf_)
+            return;
+        if (buf_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Pool& p = pool();
+            if (p.free.size() < MAX_POOLED)
+                p.free.push_back(buf_);
+            else
+                delete buf_;
+        }
+        buf_ = nullptr;
+    }
+
+    /* Get a buffer that no one else references, without preserving its contents */
+    void makeExclusive() {
+        if (buf_ && buf_->refs.load(std::memory_order_acquire) == 1)
+            return;
+        release();
+        buf_ = acquire();
+    }
+
+    Buffer* buf_;
+};
+
+}}
+
+#endif /* MEMHIERARCHY_PAYLOAD_H */
@@ -17,6 +17,8 @@
 #define	MEMHIERARCHY_REPLACEMENT_POLICY_H
 
 #include "sst/core/subcomponent.h"
+#include "sst/core/output.h"
+#include "sst/core/unitAlgebra.h"
 #include "sst/core/rng/marsaglia.h"
 
 #include "memEvent.h"
@@ -100,6 +102,10 @@ class ReplacementPolicy : public SubComponent{
         virtual void update(uint64_t id, ReplacementInfo * rInfo) = 0;
         virtual void replaced(uint64_t id) = 0;
 
+        /* Called when line 'id' is filled with the block at 'addr', before the update() for that fill.
+         * Only policies that treat insertions differently from hits need to override this. */
+        virtual void inserted(uint64_t id, Addr addr) { }
+
         // Get replacement candidates
         virtual uint64_t getBestCandidate() = 0;
         virtual uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) = 0;
@@ -818,6 +824,326 @@ public:
     ImplementSerializable(SST::MemHierarchy::NMRU)
 };
 
+/* ------------------------------------------------------------------------------------------
+ *  Re-reference interval prediction (RRIP) family
+ *  - Each line holds a small re-reference prediction value (RRPV), 0 = re-referenced soon and
+ *    max = re-referenced in the distant future. Hits set the RRPV to 0, the victim is the
+ *    first line in the set at max and the set is aged when no line is at max.
+ *  - The policies differ only in the RRPV given to a newly inserted line
+ *  - Replacement algorithm assumes indices are contiguous for the set
+ * ------------------------------------------------------------------------------------------*/
+class RRIPBase : public ReplacementPolicy {
+public:
+    RRIPBase(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), bestCandidate(0) {
+        ways = associativity;
+        uint32_t bits = params.find<uint32_t>("rrpv_bits", 2);
+        if (bits == 0 || bits > 7) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: rrpv_bits - must be between 1 and 7. You specified %" PRIu32 ".\n", getName().c_str(), bits);
+        }
+        max_rrpv = (1 << bits) - 1;
+        array.resize(lines, max_rrpv);
+    }
+
+    virtual ~RRIPBase() = default;
+
+    /* Too expensive to constantly dynamic_cast. Check once during construction instead. */
+    bool checkCompatibility(ReplacementInfo * rInfo) override { return true; } // No cast
+
+    /* The update() that follows a fill is not a re-reference, the RRPV was set by inserted() */
+    void update(uint64_t id, ReplacementInfo * rInfo) override {
+        if (array[id] & FILL_PENDING) {
+            array[id] &= ~FILL_PENDING;
+            return;
+        }
+        array[id] = 0;
+        hit(id);
+    }
+
+    void replaced(uint64_t id) override {
+        evicted(id);
+        array[id] = max_rrpv;
+    }
+
+    void inserted(uint64_t id, Addr addr) override { array[id] = insertionRRPV(id, addr) | FILL_PENDING; }
+
+    /** Lines are selected for replacement according to the following criteria (and in this order):
+     * 1. If invalid (always replace these)
+     * 2. The first line whose RRPV is max, after aging the set until at least one line is
+     */
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) override {
+        uint8_t oldest = 0;
+        bestCandidate = rInfo[0]->getIndex();
+        for (uint64_t i = 0; i < rInfo.size(); i++) {
+            uint64_t index = rInfo[i]->getIndex();
+            if (rInfo[i]->getState() == I) {
+                bestCandidate = index;
+                return bestCandidate;
+            }
+            uint8_t rrpv = array[index] & ~FILL_PENDING;
+            if (rrpv > oldest) {
+                oldest = rrpv;
+                bestCandidate = index;
+            }
+        }
+        if (oldest < max_rrpv) {
+            uint8_t age = max_rrpv - oldest;
+            for (uint64_t i = 0; i < rInfo.size(); i++)
+                array[rInfo[i]->getIndex()] += age;
+        }
+        return bestCandidate;
+    }
+
+    uint64_t getBestCandidate() override { return bestCandidate; }
+
+    RRIPBase() = default;
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        ReplacementPolicy::serialize_order(ser);
+        SST_SER(bestCandidate);
+        SST_SER(ways);
+        SST_SER(max_rrpv);
+        SST_SER(array);
+    }
+
+protected:
+    /* RRPV for a line that is being filled with 'addr' */
+    virtual uint8_t insertionRRPV(uint64_t id, Addr addr) = 0;
+
+    /* Hooks for policies that learn from hits and evictions */
+    virtual void hit(uint64_t id) { }
+    virtual void evicted(uint64_t id) { }
+
+    uint64_t bestCandidate;
+    uint64_t ways;
+    uint8_t max_rrpv;
+
+private:
+    static constexpr uint8_t FILL_PENDING = 0x80;   // Set between inserted() and the update() for the fill
+
+    std::vector<uint8_t> array;     // RRPV per line
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Static RRIP (srrip)
+ *  - Insert with a long re-reference interval (max - 1) so that a scan does not
+ *    displace lines that have been re-referenced
+ * ------------------------------------------------------------------------------------------*/
+class SRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(SRRIP, "memHierarchy", "replacement.srrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "static re-reference interval prediction, lines are inserted with a long predicted re-reference interval", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits", "Bits of re-reference prediction state per line (1-7)", "2"} )
+
+    SRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity) { }
+    virtual ~SRRIP() = default;
+
+    SRRIP() = default;
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        RRIPBase::serialize_order(ser);
+    }
+    ImplementSerializable(SST::MemHierarchy::SRRIP)
+
+protected:
+    uint8_t insertionRRPV(uint64_t id, Addr addr) override { return max_rrpv - 1; }
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Bimodal RRIP (brrip)
+ *  - Insert with a distant re-reference interval (max), except for one in every
+ *    'bimodal_throttle' insertions which gets a long interval (max - 1).
+ *    Protects the cache from working sets larger than the cache.
+ * ------------------------------------------------------------------------------------------*/
+class BRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(BRRIP, "memHierarchy", "replacement.brrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "bimodal re-reference interval prediction, most lines are inserted with a distant predicted re-reference interval", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",           "Bits of re-reference prediction state per line (1-7)", "2"},
+            {"bimodal_throttle",    "One in every 'bimodal_throttle' insertions is given a long instead of a distant re-reference interval", "32"} )
+
+    BRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity), insertions(0) {
+        throttle = params.find<uint64_t>("bimodal_throttle", 32);
+        if (throttle == 0) throttle = 1;
+    }
+    virtual ~BRRIP() = default;
+
+    BRRIP() = default;
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        RRIPBase::serialize_order(ser);
+        SST_SER(throttle);
+        SST_SER(insertions);
+    }
+    ImplementSerializable(SST::MemHierarchy::BRRIP)
+
+protected:
+    uint8_t insertionRRPV(uint64_t id, Addr addr) override {
+        return (++insertions % throttle == 0) ? max_rrpv - 1 : max_rrpv;
+    }
+
+    uint64_t throttle;
+    uint64_t insertions;
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Dynamic RRIP (drrip)
+ *  - Set dueling between SRRIP and BRRIP. A few leader sets always use one policy or the other
+ *    and a saturating counter (PSEL) counts which of them misses more. The remaining
+ *    (follower) sets insert using whichever policy is currently missing less.
+ *  - Leader sets are spread evenly over the cache: with stride = sets / leader_sets, set s is an
+ *    SRRIP leader if s % stride == 0 and a BRRIP leader if s % stride == stride / 2
+ * ------------------------------------------------------------------------------------------*/
+class DRRIP : public BRRIP {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(DRRIP, "memHierarchy", "replacement.drrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "dynamic re-reference interval prediction, set dueling between SRRIP and BRRIP insertion", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",           "Bits of re-reference prediction state per line (1-7)", "2"},
+            {"bimodal_throttle",    "BRRIP: one in every 'bimodal_throttle' insertions is given a long instead of a distant re-reference interval", "32"},
+            {"leader_sets",         "Number of leader sets dedicated to each of SRRIP and BRRIP", "32"},
+            {"psel_bits",           "Width of the policy selection counter in bits", "10"} )
+
+    DRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : BRRIP(id, params, lines, associativity) {
+        uint64_t sets = lines / associativity;
+        uint64_t leaders = params.find<uint64_t>("leader_sets", 32);
+        stride = (leaders == 0) ? sets : sets / leaders;
+        if (stride < 2) stride = 2;
+
+        uint32_t bits = params.find<uint32_t>("psel_bits", 10);
+        if (bits == 0 || bits > 31) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: psel_bits - must be between 1 and 31. You specified %" PRIu32 ".\n", getName().c_str(), bits);
+        }
+        psel_max = (1u << bits) - 1;
+        psel = psel_max >> 1;
+    }
+    virtual ~DRRIP() = default;
+
+    DRRIP() = default;
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        BRRIP::serialize_order(ser);
+        SST_SER(stride);
+        SST_SER(psel_max);
+        SST_SER(psel);
+    }
+    ImplementSerializable(SST::MemHierarchy::DRRIP)
+
+protected:
+    /* Insertions are misses, so this is where the leader sets train PSEL */
+    uint8_t insertionRRPV(uint64_t id, Addr addr) override {
+        uint64_t offset = (id / ways) % stride;
+        bool useBRRIP;
+        if (offset == 0) {              // SRRIP leader
+            if (psel < psel_max) psel++;
+            useBRRIP = false;
+        } else if (offset == stride / 2) { // BRRIP leader
+            if (psel > 0) psel--;
+            useBRRIP = true;
+        } else {                        // Follower - SRRIP leaders missing more means use BRRIP
+            useBRRIP = psel > (psel_max >> 1);
+        }
+        return useBRRIP ? BRRIP::insertionRRPV(id, addr) : max_rrpv - 1;
+    }
+
+    uint64_t stride;
+    uint32_t psel_max;
+    uint32_t psel;
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Signature-based hit prediction (ship)
+ *  - SRRIP whose insertion RRPV is predicted from a signature of the block. Caches do not see
+ *    the PC, so the signature is the memory region containing the block (SHiP-Mem).
+ *  - A table of saturating counters (SHCT) indexed by signature is incremented on each hit and
+ *    decremented when a line is evicted without having been re-referenced. Blocks whose
+ *    signature counter is zero are inserted with a distant interval, others with a long one.
+ * ------------------------------------------------------------------------------------------*/
+class SHiP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(SHiP, "memHierarchy", "replacement.ship", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "signature-based hit prediction on top of SRRIP, using the block's memory region as the signature", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",       "Bits of re-reference prediction state per line (1-7)", "2"},
+            {"shct_entries",    "Number of entries in the signature history counter table. Must be a power of two between 2 and 65536.", "16384"},
+            {"shct_bits",       "Width of each signature history counter in bits (1-8)", "2"},
+            {"region_size",     "Size of the memory region that forms a signature. Must be a power of two.", "16KiB"} )
+
+    SHiP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity) {
+        Output out("", 1, 0, Output::STDOUT);
+        uint64_t entries = params.find<uint64_t>("shct_entries", 16384);
+        if (entries < 2 || entries > 65536 || !isPowerOfTwo(entries))
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: shct_entries - must be a power of two between 2 and 65536. You specified %" PRIu64 ".\n", getName().c_str(), entries);
+        sig_shift = 64 - log2Of(entries);
+
+        uint32_t bits = params.find<uint32_t>("shct_bits", 2);
+        if (bits == 0 || bits > 8)
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: shct_bits - must be between 1 and 8. You specified %" PRIu32 ".\n", getName().c_str(), bits);
+        shct_max = (1u << bits) - 1;
+
+        UnitAlgebra region = UnitAlgebra(params.find<std::string>("region_size", "16KiB"));
+        if (!region.hasUnits("B"))
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: region_size - must have units of bytes (B). SI units OK. You specified '%s'.\n", getName().c_str(), region.toString().c_str());
+        uint64_t regionBytes = region.getRoundedValue();
+        if (regionBytes == 0 || (regionBytes & (regionBytes - 1)))
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: region_size - must be a power of two. You specified '%s'.\n", getName().c_str(), region.toString().c_str());
+        region_shift = 0;
+        while ((regionBytes >> region_shift) > 1) region_shift++;
+
+        // Start weakly predicting reuse so new regions are not immediately treated as scans
+        shct.resize(entries, 1);
+        signature.resize(lines, 0);
+        outcome.resize(lines, EMPTY);
+    }
+    virtual ~SHiP() = default;
+
+    SHiP() = default;
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        RRIPBase::serialize_order(ser);
+        SST_SER(sig_shift);
+        SST_SER(region_shift);
+        SST_SER(shct_max);
+        SST_SER(shct);
+        SST_SER(signature);
+        SST_SER(outcome);
+    }
+    ImplementSerializable(SST::MemHierarchy::SHiP)
+
+protected:
+    uint8_t insertionRRPV(uint64_t id, Addr addr) override {
+        uint16_t sig = (uint16_t)(((addr >> region_shift) * 0x9E3779B97F4A7C15ULL) >> sig_shift);
+        signature[id] = sig;
+        outcome[id] = NOT_REUSED;
+        return shct[sig] == 0 ? max_rrpv : max_rrpv - 1;
+    }
+
+    void hit(uint64_t id) override {
+        if (outcome[id] == EMPTY) return;
+        outcome[id] = REUSED;
+        if (shct[signature[id]] < shct_max) shct[signature[id]]++;
+    }
+
+    void evicted(uint64_t id) override {
+        if (outcome[id] == NOT_REUSED && shct[signature[id]] > 0)
+            shct[signature[id]]--;
+        outcome[id] = EMPTY;
+    }
+
+private:
+    enum : uint8_t { EMPTY, NOT_REUSED, REUSED };
+
+    uint32_t sig_shift;     // Signature is the top log2(shct_entries) bits of the hashed region number
+    uint32_t region_shift;
+    uint8_t shct_max;
+    std::vector<uint8_t> shct;          // Signature history counter table
+    std::vector<uint16_t> signature;    // Signature per line
+    std::vector<uint8_t> outcome;       // Per line: EMPTY, NOT_REUSED or REUSED since its fill
+};
+
+
 
 }}
 
@@ -97,6 +97,10 @@ Scratchpad::Scratchpad(ComponentId_t id, Params &params) : Component(id) {
     // Remote address computation
     remoteAddrOffset_ = params.find<uint64_t>("memory_addr_offset", scratchSize_);
 
+    // Get pipelining - each remote read covers whole scratch lines so that lines complete independently
+    moveOutstanding_ = params.find<uint32_t>("move_outstanding", 0);
+    moveChunkSize_ = ((remoteLineSize_ + scratchLineSize_ - 1) / scratchLineSize_) * scratchLineSize_;
+
     // Create backend
     scratch_ = loadUserSubComponent<ScratchBackendConvertor>("backendConvertor");
 
@@ -190,6 +194,9 @@ Scratchpad::Scratchpad(ComponentId_t id, Params &params) : Component(id) {
     stat_ScratchPutReceived       = registerStatistic<uint64_t>("request_received_scratch_put");
     stat_ScratchReadIssued        = registerStatistic<uint64_t>("request_issued_scratch_read");
     stat_ScratchWriteIssued       = registerStatistic<uint64_t>("request_issued_scratch_write");
+    stat_RemoteMoveReadIssued     = registerStatistic<uint64_t>("request_issued_remote_move_read");
+    stat_MoveCycles               = registerStatistic<uint64_t>("move_cycles");
+    stat_MoveOverlapCycles        = registerStatistic<uint64_t>("move_overlap_cycles");
 
     // Figure out port connections and set up links
     // Options: cpu and network; or cpu and memory;
@@ -300,6 +307,8 @@ Scratchpad::Scratchpad(ComponentId_t id, Params &params) : Component(id) {
 
     // Initialize local variables
     timestamp_ = 0;
+    activeMoves_ = 0;
+    scratchAccessed_ = false;
 }
 
 /* Init
@@ -495,6 +504,14 @@ bool Scratchpad::clock(Cycle_t cycle) {
         memMsgQueue_.erase(memMsgQueue_.begin());
     }
 
+    // Track how much of the move time is overlapped with scratch accesses
+    if (activeMoves_ != 0) {
+        stat_MoveCycles->addData(1);
+        if (scratchAccessed_)
+            stat_MoveOverlapCycles->addData(1);
+    }
+    scratchAccessed_ = false;
+
     linkDown_->clock();
     if (linkUp_ != linkDown_) linkUp_->clock();
     scratch_->clock(cycle); // Clock backend
@@ -547,6 +564,7 @@ void Scratchpad::handleScratchRead(MemEvent * ev) {
 
     Addr addr = ev->getBaseAddr();
     stat_ScratchReadReceived->addData(1);
+    scratchAccessed_ = true;
 
     if (mem_h_is_debug_addr(addr))
         eventDI.prefill(ev->getID(), ev->getCmd(), addr);
@@ -645,6 +663,7 @@ void Scratchpad::handleScratchWrite(MemEvent * ev) {
     }
 
     stat_ScratchWriteReceived->addData(1);
+    scratchAccessed_ = true;
 
     MemEvent * response = nullptr;
     response = ev->makeResponse();
@@ -701,7 +720,9 @@ void Scratchpad::handleScratchWrite(MemEvent * ev) {
  * srcAddr to scratch address dstAddr. 'Size' may exceed the scratch
  * line size.
  *
- * 1. Issue read to remote for 'size' bytes from srcAddr
+ * 1. Issue read to remote for 'size' bytes from srcAddr. If move_outstanding
+ *    is set, the read is split into memory-line-sized pieces with up to
+ *    move_outstanding in flight, each written to scratch as it returns.
  * 2. If caching, send shootdowns for any cached blocks between
  *    dstAddr & dstAddr+size. All dirty data is discarded.
  * 3. Once the remote read returns, issue writes to the local scratch
@@ -712,29 +733,16 @@ void Scratchpad::handleScratchWrite(MemEvent * ev) {
  */
 void Scratchpad::handleScratchGet(MemEventBase * event) {
     MoveEvent * ev = static_cast<MoveEvent*>(event);
-    Addr saddr = ev->getSrcBaseAddr();
-    Addr daddr = ev->getDstBaseAddr();
 
     stat_ScratchGetReceived->addData(1);
+    activeMoves_++;
 
     MoveEvent * response = ev->makeResponse();
     outstandingEventList_.insert(std::make_pair(ev->getID(),OutstandingEvent(ev,response)));
 
-    // Issue remote read
+    // Issue remote read(s)
     ev->setSrcBaseAddr((ev->getSrcAddr() - remoteAddrOffset_) & ~(remoteLineSize_ - 1));
-    MemEvent * remoteRead = new MemEvent(getName(), ev->getSrcAddr() - remoteAddrOffset_, ev->getSrcBaseAddr(), Command::GetS, ev->getSize());
-    remoteRead->MemEventBase::copyMetadata(ev);
-    remoteRead->setFlag(MemEvent::F_NONCACHEABLE);
-    remoteRead->setVirtualAddress(ev->getSrcVirtualAddress());
-    remoteRead->setInstructionPointer(ev->getInstructionPointer());
-    responseIDMap_.insert(std::make_pair(remoteRead->getID(), ev->getID()));
-
-    if (mem_h_is_debug_event(remoteRead)) {
-        dbg.debug(_L10_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Get           0x%-16" PRIx64 " 0x%-16" PRIx64 " Remote Read (<%" PRIu64 ", %" PRIu32 ">, 0x%" PRIx64 ")\n",
-                getCurrentSimCycle(), timestamp_, getName().c_str(), saddr, daddr, remoteRead->getID().first, remoteRead->getID().second, remoteRead->getBaseAddr());
-    }
-
-    memMsgQueue_.insert(std::make_pair(timestamp_, remoteRead));
+    issueGetReads(ev->getID());
 
     // Insert into mshr and send inv if needed
     // start base addr -> end base addr
@@ -775,6 +783,7 @@ void Scratchpad::handleScratchPut(MemEventBase * event) {
     MoveEvent *ev = static_cast<MoveEvent*>(event);
 
     stat_ScratchPutReceived->addData(1);
+    activeMoves_++;
 
     MoveEvent * response = ev->makeResponse();
     ev->setDstBaseAddr((ev->getDstBaseAddr() - remoteAddrOffset_) & ~(remoteLineSize_ - 1));
@@ -1061,12 +1070,20 @@ void Scratchpad::handleRemoteWrite(MemEvent * event) {
  */
 void Scratchpad::handleRemoteGetResponse(MemEvent * response, SST::Event::id_type requestID) {
 
-    MoveEvent * request = static_cast<MoveEvent*>(outstandingEventList_.find(requestID)->second.request);
+    OutstandingEvent * outstanding = &(outstandingEventList_.find(requestID)->second);
+    MoveEvent * request = static_cast<MoveEvent*>(outstanding->request);
 
-    uint32_t bytesLeft = request->getSize();
-    Addr addr = request->getDstAddr();
-    Addr baseAddr = request->getDstBaseAddr();
+    // Determine which part of the Get this response covers
+    std::map<SST::Event::id_type,std::pair<uint32_t,uint32_t> >::iterator chunk = getChunks_.find(response->getResponseToID());
+    uint32_t bytesLeft = chunk->second.second;
+    Addr addr = request->getDstAddr() + chunk->second.first;
+    Addr baseAddr = request->getDstBaseAddr() + ((addr - request->getDstBaseAddr()) / scratchLineSize_) * scratchLineSize_;
     uint32_t payloadOffset = 0;
+    getChunks_.erase(chunk);
+
+    // Keep the pipeline full before writing this piece, the Get may complete below
+    outstanding->moveInflight--;
+    issueGetReads(requestID);
 
     while (bytesLeft != 0) {
         // Create write
@@ -1118,7 +1135,7 @@ void Scratchpad::handleRemoteGetResponse(MemEvent * response, SST::Event::id_typ
 void Scratchpad::handleRemoteReadResponse(MemEvent * response, SST::Event::id_type requestID) {
     // Update response with payload and finish request
     MemEvent * fwdResponse = static_cast<MemEvent*>(outstandingEventList_.find(requestID)->second.response);
-    fwdResponse->setPayload(response->getPayload());
+    fwdResponse->sharePayload(response);
 
     finishRequest(requestID);
 
@@ -1230,6 +1247,44 @@ void Scratchpad::sendResponse(MemEventBase * event) {
 }
 
 
+/* Send remote reads for a Get until it is fully requested or
+ * move_outstanding reads are in flight. Pieces after the first
+ * start on a moveChunkSize_ boundary relative to the destination base.
+ */
+void Scratchpad::issueGetReads(SST::Event::id_type getID) {
+    OutstandingEvent * outstanding = &(outstandingEventList_.find(getID)->second);
+    MoveEvent * get = static_cast<MoveEvent*>(outstanding->request);
+
+    while (outstanding->moveIssued < get->getSize() && (moveOutstanding_ == 0 || outstanding->moveInflight < moveOutstanding_)) {
+        uint32_t offset = outstanding->moveIssued;
+        uint32_t size = get->getSize() - offset;
+        if (moveOutstanding_ != 0) {
+            uint32_t chunkLeft = moveChunkSize_ - ((get->getDstAddr() + offset - get->getDstBaseAddr()) % moveChunkSize_);
+            if (size > chunkLeft) size = chunkLeft;
+        }
+
+        Addr srcAddr = get->getSrcAddr() - remoteAddrOffset_ + offset;
+        MemEvent * remoteRead = new MemEvent(getName(), srcAddr, srcAddr & ~(remoteLineSize_ - 1), Command::GetS, size);
+        remoteRead->MemEventBase::copyMetadata(get);
+        remoteRead->setFlag(MemEvent::F_NONCACHEABLE);
+        remoteRead->setVirtualAddress(get->getSrcVirtualAddress() + offset);
+        remoteRead->setInstructionPointer(get->getInstructionPointer());
+        responseIDMap_.insert(std::make_pair(remoteRead->getID(), getID));
+        getChunks_.insert(std::make_pair(remoteRead->getID(), std::make_pair(offset, size)));
+
+        if (mem_h_is_debug_event(remoteRead)) {
+            dbg.debug(_L10_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Get           0x%-16" PRIx64 " 0x%-16" PRIx64 " Remote Read (<%" PRIu64 ", %" PRIu32 ">, 0x%" PRIx64 ")\n",
+                    getCurrentSimCycle(), timestamp_, getName().c_str(), get->getSrcBaseAddr(), get->getDstBaseAddr(), remoteRead->getID().first, remoteRead->getID().second, remoteRead->getBaseAddr());
+        }
+
+        memMsgQueue_.insert(std::make_pair(timestamp_, remoteRead));
+        stat_RemoteMoveReadIssued->addData(1);
+
+        outstanding->moveIssued += size;
+        outstanding->moveInflight++;
+    }
+}
+
 /* Start a Get request for a particular line by
  * determining whether an inv for that line is needed
  * Return whether inv was sent or not
@@ -1306,6 +1361,7 @@ void Scratchpad::updatePut(SST::Event::id_type putID) {
 //                getCurrentSimCycle(), timestamp_, getName().c_str(), outstandingEventList_.find(putID)->second.remoteWrite->getBaseAddr(), baseAddr, responseID.first, responseID.second);
         memMsgQueue_.insert(std::make_pair(timestamp_, outstandingEventList_.find(putID)->second.remoteWrite));
         sendResponse(outstandingEventList_.find(putID)->second.response);
+        activeMoves_--;
         delete outstandingEventList_.find(putID)->second.request;
         outstandingEventList_.erase(putID);
     }
@@ -1315,6 +1371,7 @@ void Scratchpad::updatePut(SST::Event::id_type putID) {
 void Scratchpad::updateGet(SST::Event::id_type getID) {
     uint32_t count = outstandingEventList_.find(getID)->second.decrementCount();
     if (count == 0) {
+        activeMoves_--;
         sendResponse(outstandingEventList_.find(getID)->second.response);
         delete outstandingEventList_.find(getID)->second.request;
         outstandingEventList_.erase(getID);
@@ -50,6 +50,7 @@ public:
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
             {"memory_addr_offset",  "(uint) Amount to offset remote addresses by. Default is 'size' so that remote memory addresses start at 0", "size"},
             {"response_per_cycle",  "(uint) Maximum number of responses to return to processor each cycle. 0 is unlimited", "0"},
+            {"move_outstanding",    "(uint) Maximum number of remote reads in flight per Get (copy from memory to scratch). Each read covers one memory line's worth of scratch lines and is written to scratch as soon as it returns. 0 sends a single remote read for the whole Get", "0"},
             {"backendConvertor",    "(string) Backend convertor to use for the scratchpad", "memHierarchy.scratchpadBackendConvertor"},
             {"debug",               "(uint) Where to print debug output. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
             {"debug_level",         "(uint) Debug verbosity level. Between 0 and 10", "0"} )
@@ -69,7 +70,10 @@ public:
             {"request_received_scratch_get",    "Number of scratchpad Gets received from CPU (copy from memory to scratch)", "count", 1},
             {"request_received_scratch_put",    "Number of scratchpad Puts received from CPU (copy from scratch to memory)", "count", 1},
             {"request_issued_scratch_read",     "Number of scratchpad reads issued to scratchpad", "count", 1},
-            {"request_issued_scratch_write",    "Number of scratchpad writes issued to scratchpad", "count", 1} )
+            {"request_issued_scratch_write",    "Number of scratchpad writes issued to scratchpad", "count", 1},
+            {"request_issued_remote_move_read", "Number of remote reads issued on behalf of Gets", "count", 1},
+            {"move_cycles",                     "Number of cycles with at least one Get or Put in progress", "count", 1},
+            {"move_overlap_cycles",             "Number of cycles with a Get or Put in progress in which a scratch read or write was also received. Overlap efficiency is move_overlap_cycles/move_cycles", "count", 1} )
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
             {"backendConvertor", "Convertor to interface to memory timing model (backend)", "SST::MemHierarchy::ScratchBackendConvertor" },
@@ -109,6 +113,10 @@ private:
     uint64_t remoteAddrOffset_;   // Offset for remote addresses, defaults to scratchSize (i.e., CPU addr scratchSize = mem addr 0)
     uint64_t remoteLineSize_;
 
+    // Parameters - move pipelining
+    uint32_t moveOutstanding_;  // Max remote reads in flight per Get, 0 for one read per Get
+    uint64_t moveChunkSize_;    // Bytes per remote read when pipelining, a multiple of scratchLineSize_
+
     // Backend
     ScratchBackendConvertor * scratch_;
 
@@ -148,6 +156,7 @@ private:
     void doScratchWrite(MemEvent * write);
     void sendResponse(MemEventBase * event);
 
+    void issueGetReads(SST::Event::id_type id);
     bool startGet(Addr baseAddr, MoveEvent * get);
     bool startPut(Addr baseAddr, MoveEvent * put);
 
@@ -168,9 +177,11 @@ private:
             MemEvent * remoteWrite;     // For Put requests, collect scratch read responses here
             uint32_t count;             // Number of lines we are waiting on - when 0, the request is complete
                                         // i.e., for a read or write, just 1, for a get or put, the size/lineSize
+            uint32_t moveIssued;        // For Get requests, bytes requested from remote so far
+            uint32_t moveInflight;      // For Get requests, remote reads not yet returned
 
-            OutstandingEvent(MemEventBase * request, MemEventBase * response) : request(request), response(response), remoteWrite(nullptr), count(0) { }
-            OutstandingEvent(MemEventBase * request, MemEventBase * response, MemEvent * write) : request(request), response(response), remoteWrite(write), count(0) { }
+            OutstandingEvent(MemEventBase * request, MemEventBase * response) : request(request), response(response), remoteWrite(nullptr), count(0), moveIssued(0), moveInflight(0) { }
+            OutstandingEvent(MemEventBase * request, MemEventBase * response, MemEvent * write) : request(request), response(response), remoteWrite(write), count(0), moveIssued(0), moveInflight(0) { }
 
             uint32_t decrementCount() { count--; return count; }
             void incrementCount() { count++; }
@@ -234,6 +245,9 @@ private:
     std::map<SST::Event::id_type,Addr> responseIDAddrMap_;              // Map an outstanding scratch request ID to the request's baseAddr
     std::map<SST::Event::id_type,OutstandingEvent> outstandingEventList_; // List of all outstanding events
     std::map<Addr,std::list<MSHREntry> > mshr_; // MSHR for scratch accesses
+    std::map<SST::Event::id_type,std::pair<uint32_t,uint32_t> > getChunks_; // Map a Get's remote read ID to the (offset, size) it covers
+    uint32_t activeMoves_;      // Gets and Puts in progress
+    bool scratchAccessed_;      // Whether a scratch read or write arrived since the last clock
 
 
     // Outgoing message queues - map send timestamp to event
@@ -258,6 +272,9 @@ private:
     Statistic<uint64_t>* stat_ScratchPutReceived;
     Statistic<uint64_t>* stat_ScratchReadIssued;
     Statistic<uint64_t>* stat_ScratchWriteIssued;
+    Statistic<uint64_t>* stat_RemoteMoveReadIssued;
+    Statistic<uint64_t>* stat_MoveCycles;
+    Statistic<uint64_t>* stat_MoveOverlapCycles;
 };
 
 }}
@@ -0,0 +1,180 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_SHARERSET_H
+#define MEMHIERARCHY_SHARERSET_H
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sst/core/serialization/serializable.h>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Maps the names of caches that can hold a block (sharers/owners) to
+ * dense integer IDs so that per-block state can be stored compactly.
+ * IDs are assigned in order of first use and never reused.
+ */
+class SharerIdMap {
+public:
+    static constexpr int32_t NO_ID = -1;
+
+    /* Return the ID for 'name', assigning the next free ID if it has none */
+    uint32_t getId(const std::string& name) {
+        std::unordered_map<std::string, uint32_t>::iterator it = ids_.find(name);
+        if (it != ids_.end())
+            return it->second;
+        uint32_t id = names_.size();
+        ids_.insert(std::make_pair(name, id));
+        names_.push_back(name);
+        return id;
+    }
+
+    /* Return the ID for 'name' or NO_ID if it has never been used */
+    int32_t findId(const std::string& name) const {
+        std::unordered_map<std::string, uint32_t>::const_iterator it = ids_.find(name);
+        return (it == ids_.end()) ? NO_ID : (int32_t)it->second;
+    }
+
+    const std::string& getName(uint32_t id) const { return names_[id]; }
+
+    size_t size() const { return names_.size(); }
+
+    void serialize_order(SST::Core::Serialization::serializer& ser) {
+        SST_SER(names_);
+        if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
+            ids_.clear();
+            for (uint32_t i = 0; i < names_.size(); i++)
+                ids_.insert(std::make_pair(names_[i], i));
+        }
+    }
+
+private:
+    std::unordered_map<std::string, uint32_t> ids_;
+    std::vector<std::string> names_;
+};
+
+/*
+ * Exact set of sharer IDs for one block.
+ * Limited-pointer representation: up to INLINE_SHARERS IDs are stored in
+ * place, which covers the common case without a heap allocation. Larger
+ * sets overflow to a full bit vector indexed by ID, and return to the
+ * inline form once they empty.
+ */
+class SharerSet {
+public:
+    static constexpr uint32_t INLINE_SHARERS = 4;
+
+    SharerSet() : count_(0) {}
+
+    bool empty() const { return count_ == 0; }
+    size_t size() const { return count_; }
+
+    bool contains(uint32_t id) const {
+        if (bits_.empty()) {
+            for (uint32_t i = 0; i < count_; i++) {
+                if (inline_[i] == id) return true;
+            }
+            return false;
+        }
+        size_t word = id / 64;
+        return word < bits_.size() && (bits_[word] & (1ULL << (id % 64)));
+    }
+
+    void insert(uint32_t id) {
+        if (contains(id))
+            return;
+        if (bits_.empty()) {
+            if (count_ < INLINE_SHARERS) {
+                inline_[count_++] = id;
+                return;
+            }
+            // Overflow - move the inline IDs into a bit vector
+            for (uint32_t i = 0; i < count_; i++)
+                setBit(inline_[i]);
+        }
+        setBit(id);
+        count_++;
+    }
+
+    void erase(uint32_t id) {
+        if (!contains(id))
+            return;
+        count_--;
+        if (bits_.empty()) {
+            for (uint32_t i = 0; i < count_ + 1; i++) {
+                if (inline_[i] == id) {
+                    inline_[i] = inline_[count_];
+                    break;
+                }
+            }
+            return;
+        }
+        bits_[id / 64] &= ~(1ULL << (id % 64));
+        if (count_ == 0)
+            std::vector<uint64_t>().swap(bits_);
+    }
+
+    void clear() {
+        count_ = 0;
+        std::vector<uint64_t>().swap(bits_);
+    }
+
+    /* Append the IDs in the set to 'ids', in no particular order */
+    void getIds(std::vector<uint32_t>& ids) const {
+        if (bits_.empty()) {
+            ids.insert(ids.end(), inline_, inline_ + count_);
+            return;
+        }
+        for (size_t word = 0; word < bits_.size(); word++) {
+            uint64_t w = bits_[word];
+            while (w) {
+                ids.push_back(word * 64 + __builtin_ctzll(w));
+                w &= w - 1;
+            }
+        }
+    }
+
+    void serialize_order(SST::Core::Serialization::serializer& ser) {
+        std::vector<uint32_t> ids;
+        if (ser.mode() != SST::Core::Serialization::serializer::UNPACK)
+            getIds(ids);
+        SST_SER(ids);
+        if (ser.mode() == SST::Core::Serialization::serializer::UNPACK) {
+            clear();
+            for (uint32_t id : ids)
+                insert(id);
+        }
+    }
+
+private:
+    void setBit(uint32_t id) {
+        size_t word = id / 64;
+        if (word >= bits_.size())
+            bits_.resize(word + 1, 0);
+        bits_[word] |= (1ULL << (id % 64));
+    }
+
+    uint32_t inline_[INLINE_SHARERS];
+    uint32_t count_;
+    std::vector<uint64_t> bits_;    // Empty while the set fits inline
+};
+
+}}
+
+#endif /* MEMHIERARCHY_SHARERSET_H */
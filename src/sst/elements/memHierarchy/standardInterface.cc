@@ -21,10 +21,14 @@
 #include <sst/core/component.h>
 #include <sst/core/link.h>
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "sst/elements/memHierarchy/memEventBase.h"
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/moveEvent.h"
 #include "sst/elements/memHierarchy/memEventCustom.h"
+#include "sst/elements/memHierarchy/vectorMemData.h"
 
 using namespace SST;
 using namespace SST::MemHierarchy;
@@ -43,6 +47,7 @@ StandardInterface::StandardInterface(SST::ComponentId_t id, Params &params, Time
 
     rqstr_ = "";
     init_done_ = false;
+    functional_requests_ = params.find<uint64_t>("functional_warmup_requests", 0);
 
     converter_ = new StandardInterface::MemEventConverter(this);
     untimed_converter_ = new StandardInterface::UntimedMemEventConverter(this);
@@ -174,6 +179,12 @@ void StandardInterface::init(unsigned int phase) {
                     responses_[recv_req->getID()] = memEvent;
                     init_recv_queue_.push(recv_req);
                     break;
+                case Command::Write:
+                    // Untimed writes are not acked, so nothing is kept for a response
+                    recv_req = new StandardMem::Write(memEvent->getAddr(), memEvent->getSize(), memEvent->getPayload(), true);
+                    init_recv_queue_.push(recv_req);
+                    delete ev;
+                    break;
                 case Command::GetSResp:
                 case Command::GetXResp:
                 {
@@ -266,6 +277,8 @@ StandardMem::Request* StandardInterface::recvUntimedData() {
 /* This could be a request or a response. */
 void StandardInterface::send(StandardMem::Request* req) {
     MemEventBase *me = static_cast<MemEventBase*>(req->convert(converter_));
+    if (!me) // Vectored request, sendVector() has issued its line events
+        return;
 #ifdef __SST_DEBUG_OUTPUT__
       debug_.debug(_L5_, "E: %-40" PRIu64 "  %-20s Req:Convert   EventID: <%" PRIu64", %" PRIu32 "> (%s)\n", getCurrentSimCycle(), getName().c_str(), me->getID().first, me->getID().second, req->getString().c_str());
       if (me->getCmd() == Command::Write) {
@@ -275,6 +288,8 @@ void StandardInterface::send(StandardMem::Request* req) {
     fflush(stdout);
 #endif
 
+    markFunctional(me);
+
     if (req->needsResponse())
         requests_[me->getID()] = std::make_pair(req,me->getCmd());   /* Save this request so we can use it when a response is returned */
     else
@@ -304,6 +319,11 @@ void StandardInterface::receive(SST::Event* ev) {
         MemEventBase::id_type origID = me->getResponseToID();
         std::map<MemEventBase::id_type,std::pair<StandardMem::Request*,Command>>::iterator reqit = requests_.find(origID);
         if (reqit == requests_.end()) {
+            auto vecit = vector_events_.find(origID);
+            if (vecit != vector_events_.end()) {
+                handleVectorResponse(vecit, me);
+                return;
+            }
             output_.fatal(CALL_INFO, -1, "%s, Error: Received response but cannot locate matching request. Response: %s\n",
                 getName().c_str(), me->getVerboseString(debug_level_).c_str());
         }
@@ -402,21 +422,8 @@ void StandardInterface::receive(SST::Event* ev) {
  ********************************************************************************************/
 
 SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::Read* req) {
-    bool noncacheable = false;
-
-    if (req->getNoncacheable()) {
-        noncacheable = true;
-    } else if (!((iface->noncacheable_regions_).empty())) {
-        // Check if addr lies in noncacheable regions.
-        // For simplicity we are not dealing with the case where the address range splits a noncacheable + cacheable region
-        std::multimap<Addr, MemRegion>::iterator ep = (iface->noncacheable_regions_).upper_bound(req->pAddr);
-        for (std::multimap<Addr, MemRegion>::iterator it = (iface->noncacheable_regions_).begin(); it != ep; it++) {
-            if (it->second.contains(req->pAddr)) {
-                noncacheable = true;
-                break;
-            }
-        }
-    }
+    // For simplicity we are not dealing with the case where the address range splits a noncacheable + cacheable region
+    bool noncacheable = req->getNoncacheable() || iface->isNoncacheable(req->pAddr);
 
     Addr bAddr = (iface->line_size_ == 0 || noncacheable) ? req->pAddr : req->pAddr & iface->base_addr_mask_; // Line address
     MemEvent* read = new MemEvent(iface->getName(), req->pAddr, bAddr, Command::GetS, req->size);
@@ -436,21 +443,8 @@ SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::Read* req
 
 
 SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::Write* req) {
-    bool noncacheable = false;
-
-    if (req->getNoncacheable()) {
-        noncacheable = true;
-    } else if (!((iface->noncacheable_regions_).empty())) {
-        // Check if addr lies in noncacheable regions.
-        // For simplicity we are not dealing with the case where the address range splits a noncacheable + cacheable region
-        std::multimap<Addr, MemRegion>::iterator ep = (iface->noncacheable_regions_).upper_bound(req->pAddr);
-        for (std::multimap<Addr, MemRegion>::iterator it = (iface->noncacheable_regions_).begin(); it != ep; it++) {
-            if (it->second.contains(req->pAddr)) {
-                noncacheable = true;
-                break;
-            }
-        }
-    }
+    // For simplicity we are not dealing with the case where the address range splits a noncacheable + cacheable region
+    bool noncacheable = req->getNoncacheable() || iface->isNoncacheable(req->pAddr);
 
     Addr bAddr = (iface->line_size_ == 0 || noncacheable) ? req->pAddr : req->pAddr & iface->base_addr_mask_;
     MemEvent* write = new MemEvent(iface->getName(), req->pAddr, bAddr, Command::Write, req->data);
@@ -618,6 +612,12 @@ Event* StandardInterface::MemEventConverter::convert(StandardMem::MoveData* req)
 
 
 Event* StandardInterface::MemEventConverter::convert(StandardMem::CustomReq* req) {
+    VectorMemData* vec = dynamic_cast<VectorMemData*>(req->data);
+    if (vec) {
+        iface->sendVector(req, vec);
+        return nullptr;
+    }
+
     CustomMemEvent* creq = new CustomMemEvent(iface->getName(), Command::CustomReq, req->data);
     if (!req->needsResponse())
         creq->setFlag(MemEventBase::F_NORESPONSE);
@@ -661,10 +661,19 @@ SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::FlushResp
 }
 
 
-SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::CustomResp* req) {
-
-    iface->output_.fatal(CALL_INFO, -1, "%s, Error: CustomResp converter not implemented\n", iface->getName().c_str());
-    return nullptr;
+SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::CustomResp* resp) {
+    std::map<StandardMem::Request::id_t, MemEventBase*>::iterator it = iface->responses_.find(resp->getID());
+    if (it == iface->responses_.end())
+        iface->output_.fatal(CALL_INFO, -1, "%s, Error: Handling a CustomResp but no matching CustomReq found\n", iface->getName().c_str());
+    CustomMemEvent* mereq = static_cast<CustomMemEvent*>(it->second); // Matching CustomReq
+    iface->responses_.erase(it);
+    CustomMemEvent* meresp = mereq->makeResponse();
+    meresp->setCustomData(resp->data);
+    if (!resp->getSuccess()) {
+        meresp->setFlag(MemEventBase::F_FAIL);
+    }
+    delete mereq;
+    return meresp;
 }
 
 
@@ -889,9 +898,184 @@ StandardMem::Request* StandardInterface::convertRequestUnlock(MemEventBase* ev)
 }
 
 StandardMem::Request* StandardInterface::convertRequestCustom(MemEventBase* ev) {
+    CustomMemEvent* event = static_cast<CustomMemEvent*>(ev);
+    StandardMem::CustomReq* req = new StandardMem::CustomReq(event->getCustomData());
+    return req;
+}
 
-    output_.fatal(CALL_INFO, -1, "%s, Error: Not implemented\n", getName().c_str());
-    return nullptr;
+/********************************************************************************************
+ * Vectored (gather/scatter) requests
+ ********************************************************************************************/
+
+/*
+ * Split a vectored request into one event per line touched. A gather reads the
+ * span of each line covering its elements; a scatter writes each run of adjacent
+ * or overlapping elements, since a write covering a gap would clobber it.
+ */
+void StandardInterface::sendVector(StandardMem::CustomReq* req, VectorMemData* data) {
+    std::vector<Addr>& addrs = data->getAddrs();
+    uint64_t elem_size = data->getElemSize();
+    bool gather = data->isGather();
+
+    if (addrs.empty() || elem_size == 0)
+        output_.fatal(CALL_INFO, -1, "%s, Error: Vector request has no elements. Request: %s\n",
+            getName().c_str(), req->getString().c_str());
+    if (gather)
+        data->getData().assign(addrs.size() * elem_size, 0);
+    else if (data->getData().size() != addrs.size() * elem_size)
+        output_.fatal(CALL_INFO, -1, "%s, Error: Vector scatter has %zu elements of %" PRIu64 " bytes but %zu bytes of data. Request: %s\n",
+            getName().c_str(), addrs.size(), elem_size, data->getData().size(), req->getString().c_str());
+
+    // Group elements by line in first-touch order. Noncacheable elements and
+    // interfaces without a line size are grouped by exact address only.
+    std::vector<std::pair<Addr, bool>> lines;               // Line address, noncacheable
+    std::vector<std::vector<uint32_t>> line_elements;
+    std::unordered_map<Addr, size_t> line_index;
+    for (uint32_t i = 0; i < addrs.size(); i++) {
+        bool noncacheable = isNoncacheable(addrs[i]);
+        Addr line = (line_size_ == 0 || noncacheable) ? addrs[i] : addrs[i] & base_addr_mask_;
+        if (line_size_ != 0 && !noncacheable && ((addrs[i] + elem_size - 1) & base_addr_mask_) != line)
+            output_.fatal(CALL_INFO, -1, "%s, Error: Vector element 0x%" PRIx64 " (%" PRIu64 " bytes) spans multiple cache lines. Line mask = 0x%" PRIx64 ". Request: %s\n",
+                getName().c_str(), addrs[i], elem_size, base_addr_mask_, req->getString().c_str());
+        auto inserted = line_index.insert(std::make_pair(line, lines.size()));
+        if (inserted.second) {
+            lines.push_back(std::make_pair(line, noncacheable));
+            line_elements.emplace_back();
+        }
+        line_elements[inserted.first->second].push_back(i);
+    }
+
+    auto issue = [&](Addr line, bool noncacheable, Addr addr, uint64_t size, std::vector<uint32_t>& elements) {
+        MemEvent* event;
+        if (gather) {
+            event = new MemEvent(getName(), addr, line, Command::GetS, size);
+        } else {
+            // Apply the elements in request order so a later one wins where they overlap
+            std::vector<uint8_t> payload(size, 0);
+            std::sort(elements.begin(), elements.end());
+            for (uint32_t i : elements)
+                std::copy(data->getData().begin() + i * elem_size, data->getData().begin() + (i + 1) * elem_size,
+                    payload.begin() + (addrs[i] - addr));
+            event = new MemEvent(getName(), addr, line, Command::Write, payload);
+        }
+        event->setRqstr(getName());
+        event->setThreadID(req->tid);
+        event->setDst(link_->getTargetDestination(line));
+        event->setVirtualAddress(0); /* Vector elements only carry physical addresses */
+        event->setInstructionPointer(data->getInstructionPointer());
+        if (noncacheable)
+            event->setFlag(MemEvent::F_NONCACHEABLE);
+        markFunctional(event);
+
+        vector_events_[event->getID()] = std::make_pair(req, std::vector<uint32_t>());
+        vector_events_[event->getID()].second.swap(elements);
+        data->pending_++;
+#ifdef __SST_DEBUG_OUTPUT__
+        debug_.debug(_L4_, "E: %-40" PRIu64 "  %-20s Event:Send    (%s)\n",
+            getCurrentSimCycle(), getName().c_str(), event->getBriefString().c_str());
+#endif
+        link_->send(event);
+    };
+
+    for (size_t l = 0; l < lines.size(); l++) {
+        Addr line = lines[l].first;
+        bool noncacheable = lines[l].second;
+        std::vector<uint32_t>& elements = line_elements[l];
+        if (gather) {
+            Addr start = addrs[elements.front()];
+            Addr end = start + elem_size;
+            for (uint32_t i : elements) {
+                start = std::min(start, addrs[i]);
+                end = std::max(end, addrs[i] + elem_size);
+            }
+            issue(line, noncacheable, start, end - start, elements);
+            continue;
+        }
+
+        std::stable_sort(elements.begin(), elements.end(), [&addrs](uint32_t a, uint32_t b) { return addrs[a] < addrs[b]; });
+        std::vector<uint32_t> run;
+        Addr start = 0, end = 0;
+        for (uint32_t i : elements) {
+            if (!run.empty() && addrs[i] > end) {
+                issue(line, noncacheable, start, end - start, run);
+                run.clear();
+            }
+            if (run.empty()) {
+                start = addrs[i];
+                end = start;
+            }
+            end = std::max(end, addrs[i] + elem_size);
+            run.push_back(i);
+        }
+        issue(line, noncacheable, start, end - start, run);
+    }
+
+#ifdef __SST_DEBUG_OUTPUT__
+    debug_.debug(_L5_, "E: %-40" PRIu64 "  %-20s Req:Vector    %zu elements in %" PRIu32 " events (%s)\n",
+        getCurrentSimCycle(), getName().c_str(), addrs.size(), data->pending_, req->getString().c_str());
+#endif
+}
+
+void StandardInterface::handleVectorResponse(std::map<MemEventBase::id_type, std::pair<StandardMem::Request*, std::vector<uint32_t>>>::iterator it, MemEventBase* meb) {
+    if (meb->getCmd() == Command::NACK) {
+        handleNACK(meb);
+        delete meb;
+        return;
+    }
+
+    StandardMem::CustomReq* req = static_cast<StandardMem::CustomReq*>(it->second.first);
+    VectorMemData* data = static_cast<VectorMemData*>(req->data);
+    MemEvent* me = static_cast<MemEvent*>(meb);
+    if (!me->success())
+        data->failed_ = true;
+
+    if (data->isGather()) {
+        // The payload covers either the event's span or the whole line
+        uint64_t elem_size = data->getElemSize();
+        std::vector<uint8_t>& payload = me->getPayload();
+        Addr payload_start = (payload.size() == me->getSize()) ? me->getAddr() : me->getBaseAddr();
+        for (uint32_t i : it->second.second) {
+            Addr offset = data->getAddrs()[i] - payload_start;
+            if (offset + elem_size <= payload.size())
+                std::copy(payload.begin() + offset, payload.begin() + offset + elem_size, data->getData().begin() + i * elem_size);
+        }
+    }
+    vector_events_.erase(it);
+    delete meb;
+
+    if (--data->pending_ != 0)
+        return;
+
+    StandardMem::CustomResp* resp = static_cast<StandardMem::CustomResp*>(req->makeResponse());
+    if (data->getFailed())
+        resp->setFail();
+    delete req;
+#ifdef __SST_DEBUG_OUTPUT__
+    debug_.debug(_L5_, "E: %-40" PRIu64 "  %-20s Req:Deliver   (%s)\n", getCurrentSimCycle(), getName().c_str(), resp->getString().c_str());
+#endif
+    (*recv_handler_)(resp);
+}
+
+bool StandardInterface::isNoncacheable(Addr addr) {
+    if (noncacheable_regions_.empty())
+        return false;
+    std::multimap<Addr, MemRegion>::iterator ep = noncacheable_regions_.upper_bound(addr);
+    for (std::multimap<Addr, MemRegion>::iterator it = noncacheable_regions_.begin(); it != ep; it++) {
+        if (it->second.contains(addr))
+            return true;
+    }
+    return false;
+}
+
+void StandardInterface::markFunctional(MemEventBase* me) {
+    // Warm-up: flag requests functional until the count runs out, then switch to detailed timing
+    if (functional_requests_ != 0 && BasicCommandClassArr[(int)me->getCmd()] == BasicCommandClass::Request) {
+        me->setFlag(MemEventBase::F_FUNCTIONAL);
+        if (--functional_requests_ == 0) {
+            output_.verbose(CALL_INFO, 1, 0, "%s, Functional warm-up complete, switching to detailed timing at %" PRIu64 "ns\n",
+                    getName().c_str(), getCurrentSimTimeNano());
+        }
+    }
 }
 
 /********************************************************************************************
@@ -961,10 +1145,12 @@ void StandardInterface::serialize_order(SST::Core::Serialization::serializer& se
     SST_SER(rqstr_);
     SST_SER(requests_);
     SST_SER(responses_);
+    SST_SER(vector_events_);
     SST_SER(link_);
     SST_SER(cache_is_dst_);
 
     SST_SER(init_done_);
+    SST_SER(functional_requests_);
     SST_SER(init_send_queue_);
     SST_SER(init_recv_queue_);
 
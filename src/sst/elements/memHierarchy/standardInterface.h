@@ -40,6 +40,7 @@ namespace MemHierarchy {
 
 class MemEventBase;
 class MemEvent;
+class VectorMemData;
 
 /** Class is used to interface a compute mode (CPU, GPU) to MemHierarchy */
 /*
@@ -62,6 +63,8 @@ class MemEvent;
  *
  * Notes on using this interface
  *  - The parent component MUST call init(), setup(), and finish() on this subcomponent during each of SST's respective phases. In particular, failing to call init() will lead to errors.
+ *  - A CustomReq whose data is a VectorMemData (vectorMemData.h) is a gather/scatter over an address list. It is not sent
+ *    as a custom command: the interface issues one read or write per cache line touched and returns a single CustomResp.
  *
  *
  */
@@ -80,7 +83,8 @@ public:
         {"debug",       "(uint) Where to send debug output. Options: 0[none], 1[stdout], 2[stderr], 3[file]", "0"},
         {"debug_level", "(uint) Debugging level: 0 to 10. Must configure sst-core with '--enable-debug'. 1=info, 2-10=debug output", "0"},
         {"port",        "(string) port name to use for interfacing to the memory system. This must be provided if this subcomponent is being loaded anonymously. Otherwise this should not be specified and either the 'lowlink' port should be connected or the 'lowlink' subcomponent slot should be filled"},
-        {"noncacheable_regions", "(string) vector of (start, end) address pairs for noncacheable address ranges. Vector format should be [start0, end0, start1, end1, ...].", "[]"}
+        {"noncacheable_regions", "(string) vector of (start, end) address pairs for noncacheable address ranges. Vector format should be [start0, end0, start1, end1, ...].", "[]"},
+        {"functional_warmup_requests", "(uint) Issue this many requests in functional (warm-up) mode before switching to detailed timing. Functional requests update cache, directory and memory state but skip modeled latencies and the memory backend. 0 disables warm-up.", "0"}
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -132,6 +136,7 @@ protected:
     std::string rqstr_;
     std::map<MemEventBase::id_type, std::pair<StandardMem::Request*,Command>> requests_;   /* Map requests sent by the endpoint */
     std::map<StandardMem::Request::id_t, MemEventBase*> responses_;     /* Map requests received by the endpoint */
+    std::map<MemEventBase::id_type, std::pair<StandardMem::Request*, std::vector<uint32_t>>> vector_events_;  /* Line event -> vector request, elements it carries */
     SST::MemHierarchy::MemLinkBase*  link_;
     bool cache_is_dst_; // Whether we've got a cache below us to handle certain conversions or we need to do it ourselves
 
@@ -139,6 +144,8 @@ protected:
     std::queue<MemEventInit*> init_send_queue_;
     std::queue<StandardMem::Request*> init_recv_queue_;
 
+    uint64_t functional_requests_;  // Requests left to issue in functional warm-up mode
+
     MemRegion region_;   // For MMIO
     Endpoint endpoint_type_;    // Endpoint type -> CPU or MMIO
 
@@ -245,6 +252,16 @@ private:
      */
     void handleNACK(MemEventBase* meb);
 
+    /* Vectored requests: split into coalesced per-line events and reassemble the response */
+    void sendVector(StandardMem::CustomReq* req, VectorMemData* data);
+    void handleVectorResponse(std::map<MemEventBase::id_type, std::pair<StandardMem::Request*, std::vector<uint32_t>>>::iterator it, MemEventBase* meb);
+
+    /* Whether an address lies in a noncacheable region */
+    bool isNoncacheable(Addr addr);
+
+    /* Flag a request functional while the warm-up count lasts */
+    void markFunctional(MemEventBase* me);
+
     /* Record noncacheable regions (e.g., MMIO device addresses) */
     std::multimap<Addr, MemRegion> noncacheable_regions_;
 
@@ -17,6 +17,8 @@
 #include "testcpu/scratchCPU.h"
 #include "util.h"
 
+#include <algorithm>
+
 #include <sst/core/interfaces/stringEvent.h>
 
 using namespace std;
@@ -57,6 +59,21 @@ ScratchCPU::ScratchCPU(ComponentId_t id, Params& params) : Component(id), rng(id
 
     reqsToIssue = params.find<uint64_t>("reqsToIssue", 1000);
 
+    std::string mode = params.find<std::string>("mode", "random");
+    if (mode != "random" && mode != "double_buffer")
+        out.fatal(CALL_INFO, -1, "Error (%s): invalid param 'mode' - must be 'random' or 'double_buffer'. You specified '%s'\n", getName().c_str(), mode.c_str());
+    doubleBuffer = (mode == "double_buffer");
+    tileSize = params.find<uint64_t>("tileSize", 4096);
+    tileCount = params.find<uint64_t>("tileCount", 16);
+    tileComputeCycles = params.find<uint64_t>("tileComputeCycles", 1000);
+    if (doubleBuffer) {
+        if (tileSize == 0 || 2 * tileSize > scratchSize)
+            out.fatal(CALL_INFO, -1, "Error (%s): invalid param 'tileSize' - must be greater than 0 and two tiles must fit in 'scratchSize'\n", getName().c_str());
+        if (2 * tileSize > maxAddr - scratchSize)
+            out.fatal(CALL_INFO, -1, "Error (%s): invalid param 'tileSize' - two tiles must fit in memory ('maxAddr' - 'scratchSize')\n", getName().c_str());
+        tileReady.resize(tileCount, false);
+    }
+
 
     // tell the simulator not to end without us
     registerAsPrimaryComponent();
@@ -73,6 +90,7 @@ ScratchCPU::ScratchCPU(ComponentId_t id, Params& params) : Component(id), rng(id
     // Initialize local variables
     timestamp = 0;
     num_events_issued = num_events_returned = 0;
+    tileGetsIssued = tileCurrent = tileReadOffset = tileComputeStart = tileStallCycles = 0;
 }
 
 // SST Component functions
@@ -83,12 +101,19 @@ void ScratchCPU::init(unsigned int phase) {
 void ScratchCPU::finish() {
     out.output("ScratchCPU %s Finished after %" PRIu64 " issued memory events, %" PRIu64 " returned, %" PRIu64 " cycles\n",
             getName().c_str(), num_events_issued, num_events_returned, timestamp);
+    if (doubleBuffer) {
+        out.output("ScratchCPU %s processed %" PRIu64 " tiles, stalled %" PRIu64 " cycles waiting for tiles (%.1f%% of cycles not stalled)\n",
+                getName().c_str(), tileCurrent, tileStallCycles, timestamp ? 100.0 * (1.0 - (double)tileStallCycles / timestamp) : 0.0);
+    }
 }
 
 // Clock tick - create and send events here
 bool ScratchCPU::tick(Cycle_t time) {
     timestamp++;
 
+    if (doubleBuffer)
+        return tickTiles();
+
     if (num_events_issued == reqsToIssue) {
         if (requests.empty()) {
             primaryComponentOKToEndSim(); // Have issued all our requests and all have returned -> DONE!
@@ -183,11 +208,87 @@ bool ScratchCPU::tick(Cycle_t time) {
     return false;
 }
 
+/*
+ * Double-buffered tiling. Tile t is copied into scratch buffer t%2 while the
+ * CPU computes on tile t-1 in the other buffer. Computing reads every line of
+ * the tile and takes at least tileComputeCycles, after which the tile is
+ * copied back out. The scratchpad orders the copy-out of a buffer ahead of
+ * the next copy-in to it, so the next Get can be sent right after the Put.
+ */
+bool ScratchCPU::tickTiles() {
+    if (tileCurrent == tileCount) {
+        if (requests.empty()) {
+            primaryComponentOKToEndSim();
+            return true;
+        }
+        return false;
+    }
+
+    uint64_t memSize = maxAddr - scratchSize;
+    uint64_t memTiles = memSize / 2 / tileSize;  // Tiles are read from the lower half of memory and written to the upper half
+
+    // Keep the next tile's copy-in in flight
+    if (tileGetsIssued < tileCount && tileGetsIssued <= tileCurrent + 1 && requests.size() < reqQueueSize) {
+        Interfaces::StandardMem::Addr srcAddr = scratchSize + (tileGetsIssued % memTiles) * tileSize;
+        Interfaces::StandardMem::Addr dstAddr = (tileGetsIssued % 2) * tileSize;
+        Interfaces::StandardMem::Request * req = new Interfaces::StandardMem::MoveData(srcAddr, dstAddr, tileSize);
+        out.debug(_L3_, "ScratchCPU (%s) sending tile %" PRIu64 " ScratchGet. Dst Addr: %" PRIu64 ", Src Addr: %" PRIu64 "\n", getName().c_str(), tileGetsIssued, dstAddr, srcAddr);
+        tileGets[req->getID()] = tileGetsIssued;
+        tileGetsIssued++;
+        sendRequest(req);
+    }
+
+    if (!tileReady[tileCurrent]) {
+        tileStallCycles++;
+        return false;
+    }
+
+    if (tileComputeStart == 0)
+        tileComputeStart = timestamp;
+
+    Interfaces::StandardMem::Addr buffer = (tileCurrent % 2) * tileSize;
+    if (tileReadOffset < tileSize && requests.size() < reqQueueSize) {
+        uint64_t size = std::min(scratchLineSize, tileSize - tileReadOffset);
+        Interfaces::StandardMem::Request * req = new Interfaces::StandardMem::Read(buffer + tileReadOffset, size);
+        tileReads.insert(req->getID());
+        tileReadOffset += size;
+        sendRequest(req);
+    }
+
+    if (tileReadOffset == tileSize && tileReads.empty() && timestamp - tileComputeStart >= tileComputeCycles && requests.size() < reqQueueSize) {
+        Interfaces::StandardMem::Addr dstAddr = scratchSize + memSize / 2 + (tileCurrent % memTiles) * tileSize;
+        Interfaces::StandardMem::Request * req = new Interfaces::StandardMem::MoveData(buffer, dstAddr, tileSize);
+        out.debug(_L3_, "ScratchCPU (%s) sending tile %" PRIu64 " ScratchPut. Dst Addr: %" PRIu64 ", Src Addr: %" PRIu64 "\n", getName().c_str(), tileCurrent, dstAddr, buffer);
+        sendRequest(req);
+
+        tileCurrent++;
+        tileReadOffset = 0;
+        tileComputeStart = 0;
+    }
+    return false;
+}
+
+void ScratchCPU::sendRequest(Interfaces::StandardMem::Request * req) {
+    requests[req->getID()] = timestamp;
+    memory->send(req);
+    num_events_issued++;
+}
+
 // Memory response handler
 void ScratchCPU::handleEvent(Interfaces::StandardMem::Request * response) {
     std::unordered_map<uint64_t, SimTime_t>::iterator i = requests.find(response->getID());
     sst_assert(i != requests.end(), CALL_INFO, -1, "Received response but request not found! ID = %" PRIu64 "\n", response->getID());
     requests.erase(i);
+
+    if (doubleBuffer) {
+        std::unordered_map<uint64_t, uint64_t>::iterator get = tileGets.find(response->getID());
+        if (get != tileGets.end()) {
+            tileReady[get->second] = true;
+            tileGets.erase(get);
+        } else {
+            tileReads.erase(response->getID());
+        }
+    }
     num_events_returned++;
     delete response;
 }
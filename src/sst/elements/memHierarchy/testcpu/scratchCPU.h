@@ -22,6 +22,7 @@
 #include <sst/core/rng/marsaglia.h>
 
 #include <unordered_map>
+#include <unordered_set>
 
 using namespace std;
 
@@ -44,7 +45,11 @@ public:
             {"clock",                   "(string) Clock frequency in Hz or period in s", "1GHz"},
             {"maxOutstandingRequests",  "(uint) Maximum number of requests outstanding at a time", "8"},
             {"maxRequestsPerCycle",     "(uint) Maximum number of requests to issue per cycle", "2"},
-            {"reqsToIssue",             "(uint) Number of requests to issue before ending simulation", "1000"} )
+            {"reqsToIssue",             "(uint) Number of requests to issue before ending simulation", "1000"},
+            {"mode",                    "(string) 'random' issues a random mix of requests. 'double_buffer' runs a tiled kernel that copies each tile into one of two scratch buffers while computing on the other, then copies the result back to memory", "random"},
+            {"tileSize",                "(uint) For double_buffer mode, bytes per tile. Two tiles must fit in the scratchpad", "4096"},
+            {"tileCount",               "(uint) For double_buffer mode, number of tiles to process", "16"},
+            {"tileComputeCycles",       "(uint) For double_buffer mode, minimum cycles spent computing on each tile", "1000"} )
 
     SST_ELI_DOCUMENT_PORTS( {"mem_link", "Connection to cache", { "memHierarchy.MemEventBase" } } )
 
@@ -60,6 +65,8 @@ public:
 private:
     void handleEvent( Interfaces::StandardMem::Request *ev );
     virtual bool tick( Cycle_t );
+    bool tickTiles();
+    void sendRequest(Interfaces::StandardMem::Request * req);
 
     Output out;
 
@@ -85,6 +92,20 @@ private:
     uint64_t timestamp;     // current timestamp
     uint64_t num_events_issued;      // number of events that have been issued at a given time
     uint64_t num_events_returned;    // number of events that have returned
+
+    // Double-buffered tiling
+    bool doubleBuffer;
+    uint64_t tileSize;
+    uint64_t tileCount;
+    uint64_t tileComputeCycles;
+    uint64_t tileGetsIssued;         // Tiles whose copy-in has been sent
+    uint64_t tileCurrent;            // Tile being computed on
+    uint64_t tileReadOffset;         // Bytes of the current tile read so far
+    uint64_t tileComputeStart;       // Cycle at which computing on the current tile started, 0 if not started
+    uint64_t tileStallCycles;        // Cycles spent waiting for a tile to arrive
+    std::vector<bool> tileReady;
+    std::unordered_map<uint64_t, uint64_t> tileGets;    // Copy-in request ID -> tile
+    std::unordered_set<uint64_t> tileReads;             // Outstanding reads of the current tile
 };
 
 }
@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+#
+# Decodes the flow traces written by memHierarchy.networkMemoryInspector
+# (trace_file param) into a traffic matrix of network source x destination.
+#
+#   netmem-trace-decode.py trace.router0.port*.nmt
+#   netmem-trace-decode.py --class ForwardRequest --metric packets trace.*.nmt
+#   netmem-trace-decode.py --hotspots 10 trace.*.nmt
+#
+# Each inspector sees the packets leaving one router port, so a packet is
+# counted once per port it crosses. For an end-to-end matrix decode the ports
+# of one router (or the ports facing the endpoints); for link load decode all
+# of them and use --hotspots, which ranks (port, source, destination) flows.
+
+import argparse
+import collections
+import struct
+import sys
+
+MAGIC = b"MHNETTR1"
+RECORD = struct.Struct("=QqqIIQQ")  # time, src, dst, class, pad, packets, bytes
+CLASSES = ["Request", "Data", "Ack", "ForwardRequest"]
+
+def read_trace(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != MAGIC:
+        sys.exit("%s: not a networkMemoryInspector trace" % path)
+    (length,) = struct.unpack_from("=I", data, 8)
+    name = data[12:12 + length].decode()
+    offset = 12 + length
+    records = []
+    while offset + RECORD.size <= len(data):
+        records.append(RECORD.unpack_from(data, offset))
+        offset += RECORD.size
+    return name, records
+
+def main():
+    parser = argparse.ArgumentParser(description="Traffic matrix from networkMemoryInspector traces")
+    parser.add_argument("traces", nargs="+")
+    parser.add_argument("--class", dest="cmd_class", choices=CLASSES, help="only count this command class")
+    parser.add_argument("--metric", choices=["bytes", "packets"], default="bytes")
+    parser.add_argument("--start", type=int, default=0, help="ignore records written before this time (ns)")
+    parser.add_argument("--end", type=int, default=None, help="ignore records written after this time (ns)")
+    parser.add_argument("--hotspots", type=int, default=0, help="list the N heaviest (port, src, dst) flows instead")
+    parser.add_argument("--csv", action="store_true", help="print the matrix as CSV")
+    args = parser.parse_args()
+
+    metric = 6 if args.metric == "bytes" else 5
+    matrix = collections.defaultdict(int)
+    flows = collections.defaultdict(int)
+    for path in args.traces:
+        port, records = read_trace(path)
+        for rec in records:
+            if rec[0] < args.start or (args.end is not None and rec[0] > args.end):
+                continue
+            if args.cmd_class and CLASSES[rec[3]] != args.cmd_class:
+                continue
+            matrix[(rec[1], rec[2])] += rec[metric]
+            flows[(port, rec[1], rec[2], rec[3])] += rec[metric]
+
+    if args.hotspots:
+        total = sum(flows.values()) or 1
+        for (port, src, dst, cls), value in sorted(flows.items(), key=lambda x: -x[1])[:args.hotspots]:
+            print("%-32s %6d -> %-6d %-15s %14d %6.2f%%" % (port, src, dst, CLASSES[cls], value, 100.0 * value / total))
+        return
+
+    srcs = sorted(set(k[0] for k in matrix))
+    dsts = sorted(set(k[1] for k in matrix))
+    if args.csv:
+        print(",".join(["src\\dst"] + [str(d) for d in dsts]))
+        for s in srcs:
+            print(",".join([str(s)] + [str(matrix.get((s, d), 0)) for d in dsts]))
+    else:
+        print("%8s" % "src\\dst" + "".join("%12d" % d for d in dsts))
+        for s in srcs:
+            print("%8d" % s + "".join("%12d" % matrix.get((s, d), 0) for d in dsts))
+
+if __name__ == "__main__":
+    main()
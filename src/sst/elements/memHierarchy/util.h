@@ -18,7 +18,9 @@
 
 #include <sst/core/stringize.h>
 #include <sst/core/params.h>
+#include <sst/core/statapi/statbase.h>
 
+#include <chrono>
 #include <iomanip>
 #include <limits>
 #include <string>
@@ -77,6 +79,30 @@ inline void fixByteUnits(std::string &unitstr) {
     }
 }
 
+/*
+ * Host (wall clock) time profile of a handler. Construct one at the top of
+ * the handler; on destruction it adds the nanoseconds spent and one call to
+ * the statistics. Nothing is timed while the time statistic is disabled, so
+ * the profile follows the statistic's enable and startat/stopat settings.
+ */
+class HostTimeProfile {
+public:
+    HostTimeProfile(Statistics::Statistic<uint64_t>* ns, Statistics::Statistic<uint64_t>* calls) :
+        ns_(ns), calls_(calls), enabled_(!ns->isNullStatistic() && ns->isEnabled()) {
+        if (enabled_) start_ = std::chrono::steady_clock::now();
+    }
+    ~HostTimeProfile() {
+        if (!enabled_) return;
+        ns_->addData(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+        calls_->addData(1);
+    }
+private:
+    Statistics::Statistic<uint64_t>* ns_;
+    Statistics::Statistic<uint64_t>* calls_;
+    bool enabled_;
+    std::chrono::steady_clock::time_point start_;
+};
+
 inline int log2Of(int x){
     int temp = x;
     int result = 0;
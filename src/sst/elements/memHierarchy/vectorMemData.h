@@ -0,0 +1,117 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _MEMHIERARCHY_VECTORMEMDATA_H_
+#define _MEMHIERARCHY_VECTORMEMDATA_H_
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sst/core/interfaces/stdMem.h>
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Vectored (gather/scatter) access, sent as the data of a StandardMem::CustomReq.
+ *
+ * The StandardInterface does not forward it as a custom command. It splits the
+ * address list into one event per cache line, coalescing elements that share a
+ * line, and returns a single CustomResp carrying this object once every line
+ * has completed.
+ *
+ *  Gather:  read 'elemSize' bytes at each address; the response's 'data' holds
+ *           the elements packed in address-list order
+ *  Scatter: write the packed elements in 'data' to the addresses in order; a
+ *           later element wins if two overlap
+ *
+ * Elements may not span a cache line.
+ */
+class VectorMemData : public Interfaces::StandardMem::CustomData {
+    friend class StandardInterface;
+
+public:
+    typedef uint64_t Addr;
+
+    enum class Op : uint32_t { Gather = 0, Scatter };
+
+    VectorMemData(Op op, uint32_t elemSize, uint64_t iPtr = 0) :
+        CustomData(), op_(op), elemSize_(elemSize), iPtr_(iPtr), pending_(0), failed_(false) { }
+
+    virtual ~VectorMemData() { }
+
+    /* Add an element; scatters also supply its 'elemSize' bytes */
+    void addElement(Addr addr) { addrs_.push_back(addr); }
+    void addElement(Addr addr, const std::vector<uint8_t>& value) {
+        addrs_.push_back(addr);
+        data_.insert(data_.end(), value.begin(), value.end());
+    }
+
+    virtual Addr getRoutingAddress() override { return addrs_.empty() ? 0 : addrs_.front(); }
+
+    virtual uint64_t getSize() override { return addrs_.size() * elemSize_; }
+
+    /* The same object travels back to the requestor with the gathered data */
+    virtual CustomData* makeResponse() override { return this; }
+
+    virtual bool needsResponse() override { return true; }
+
+    virtual std::string getString() override {
+        std::ostringstream str;
+        str << "Vector Op: " << (op_ == Op::Gather ? "Gather" : "Scatter");
+        str << std::hex << " Addr: 0x" << getRoutingAddress();
+        str << std::dec << " Elements: " << addrs_.size() << " ElemSize: " << elemSize_;
+        return str.str();
+    }
+
+    Op getOp() { return op_; }
+    bool isGather() { return op_ == Op::Gather; }
+    uint32_t getElemSize() { return elemSize_; }
+    uint64_t getInstructionPointer() { return iPtr_; }
+    std::vector<Addr>& getAddrs() { return addrs_; }
+    std::vector<uint8_t>& getData() { return data_; }
+
+    /* True if any line event failed (e.g., a noncacheable device returned a failure) */
+    bool getFailed() { return failed_; }
+
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        SST_SER(op_);
+        SST_SER(elemSize_);
+        SST_SER(iPtr_);
+        SST_SER(addrs_);
+        SST_SER(data_);
+        SST_SER(pending_);
+        SST_SER(failed_);
+    }
+    ImplementSerializable(SST::MemHierarchy::VectorMemData);
+
+protected:
+    VectorMemData() { } /* For serialization only */
+
+    Op op_;
+    uint32_t elemSize_;
+    uint64_t iPtr_;
+    std::vector<Addr> addrs_;
+    std::vector<uint8_t> data_;
+
+    uint32_t pending_;  /* Line events still outstanding, kept by the StandardInterface */
+    bool failed_;
+};
+
+} // namespace MemHierarchy
+} // namespace SST
+
+#endif
@@ -23,6 +23,7 @@
 #include <mercury/operating_system/launch/app_launcher.h>
 #include <mercury/operating_system/libraries/unblock_event.h>
 #include <mercury/operating_system/process/app.h>
+#include <mercury/operating_system/process/memoize.h>
 #include <mercury/operating_system/process/thread_id.h>
 //#include <mercury/operating_system/threading/thread_lock.h>
 #include <mercury/operating_system/threading/stack_alloc.h>
@@ -133,6 +134,7 @@ OperatingSystem::OperatingSystem(SST::ComponentId_t id, SST::Params& params, Nod
   selfEventLink_->setDefaultTimeBase(time_converter_);
 
   StackAlloc::init(params);
+  Memoization::init(params, getRank().rank, getNumRanks().rank);
   initThreading(params);
 }
 
@@ -151,6 +153,15 @@ OperatingSystem::~OperatingSystem()
     des_context_->destroyContext();
     delete des_context_;
   }
+
+  Memoization::finalize();
+
+  static bool watermark_reported = false;
+  if (StackAlloc::watermark() && !watermark_reported){
+    watermark_reported = true;
+    out_->output("most resident stack was %zu of %zu bytes\n",
+                 StackAlloc::maxResidentBytes(), StackAlloc::stacksize());
+  }
 }
 
 void
@@ -57,6 +57,10 @@ public:
 
   void execute(COMP_FUNC, Event *data, int nthr = 1);
 
+  ComputeSchedulerAPI* computeScheduler() const {
+    return compute_sched_;
+  }
+
 private:
   ComputeScheduler *compute_sched_;
   NodeCL* nodeCL_;
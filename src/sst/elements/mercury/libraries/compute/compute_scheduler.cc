@@ -16,6 +16,7 @@
 #include <mercury/libraries/compute/compute_scheduler.h>
 #include <mercury/components/operating_system_CL.h>
 #include <mercury/operating_system/process/app.h>
+#include <mercury/common/errors.h>
 
 namespace SST {
 namespace Hg {
@@ -83,5 +84,13 @@ void ComputeScheduler::releaseCores(int ncores, Thread *thr) {
   }
 }
 
+void ComputeScheduler::dedicateCores(int ncores) {
+  if (ncores >= ncores_) {
+    sst_hg_abort_printf("cannot dedicate %d of %d cores, none would be left for compute",
+                        ncores, ncores_);
+  }
+  ncores_ -= ncores;
+}
+
 } // end namespace Hg
 } // end namespace SST
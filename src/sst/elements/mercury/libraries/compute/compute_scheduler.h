@@ -52,6 +52,8 @@ public:
 
   void releaseCores(int ncore, Thread* thr) override;
 
+  void dedicateCores(int ncore) override;
+
 private:
   int ncores_;
   int nsockets_;
@@ -27,6 +27,8 @@ public:
   virtual int nsockets() const = 0;
   virtual void reserveCores(int ncore, Thread *thr) = 0;
   virtual void releaseCores(int ncore, Thread *thr) = 0;
+  /** Take cores away from compute for good, e.g. for progress threads */
+  virtual void dedicateCores(int ncore) = 0;
 };
 
 } // end namespace Hg
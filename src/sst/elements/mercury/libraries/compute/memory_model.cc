@@ -17,6 +17,10 @@
 #include <mercury/libraries/compute/memory_model.h>
 #include <mercury/components/operating_system.h>
 #include <mercury/components/node_CL.h>
+#include <mercury/common/errors.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace SST {
 namespace Hg {
@@ -26,7 +30,8 @@ using Callback = ExecutionEvent;
 MemoryModel::MemoryModel(SST::Params &params, NodeCL* parent) :
   parent_node_(parent),
   flowId_(0),
-  channelInterleaver_(0)
+  channelInterleaver_(0),
+  fair_epoch_(0)
 {
   flow_mtu_ = params.find<SST::UnitAlgebra>("flow_mtu", "512").getRoundedValue();
 
@@ -40,6 +45,18 @@ MemoryModel::MemoryModel(SST::Params &params, NodeCL* parent) :
   }
 
   flow_rsp_id_ = initialize( makeHandler(this, &MemoryModel::flowRequestResponse) );
+
+  //packet: flows are split into MTU requests queued on the channels in turn
+  //max_min: co-located flows share the total channel bandwidth with max-min fairness
+  std::string sharing = params.find<std::string>("memory_sharing", "packet");
+  if (sharing == "max_min"){
+    max_min_ = true;
+  } else if (sharing == "packet"){
+    max_min_ = false;
+  } else {
+    sst_hg_abort_printf("invalid memory_sharing %s: must be packet or max_min", sharing.c_str());
+  }
+  total_bandwidth_ = num_channels * max_bw.getValue().toDouble();
 }
 
 int
@@ -59,6 +76,18 @@ MemoryModel::accessFlow(uint64_t bytes, TimeDelta byte_request_delay, Callback *
   }
 
   uint32_t flowId = flowId_++;
+  if (max_min_){
+    advanceFairFlows();
+    FairFlow& f = fair_flows_[flowId];
+    f.callback = cb;
+    f.bytesLeft = bytes;
+    f.maxRate = byte_request_delay.ticks() ? 1.0 / byte_request_delay.sec() : 0;
+    f.rate = 0;
+    allocateFairRates();
+    scheduleFairCompletion();
+    return;
+  }
+
   // debug("Starting flow of size %" PRIu64 " on ID %" PRIu32 " with request delay %10.5e",
   //       bytes, flowId, byte_request_delay.sec());
   uint32_t initial_bytes = bytes % flow_mtu_;
@@ -118,5 +147,89 @@ MemoryModel::accessRequest(int linkId, Request *req)
   channelInterleaver_ = (channelInterleaver_ + 1) % channels_.size();
 }
 
+void
+MemoryModel::advanceFairFlows()
+{
+  Timestamp now = parent_node_->os()->now();
+  double elapsed = (now - fair_last_update_).sec();
+  fair_last_update_ = now;
+  if (elapsed <= 0){
+    return;
+  }
+  for (auto& pair : fair_flows_){
+    FairFlow& f = pair.second;
+    f.bytesLeft = std::max(0.0, f.bytesLeft - f.rate * elapsed);
+  }
+}
+
+void
+MemoryModel::allocateFairRates()
+{
+  //a max rate of zero means the flow is limited only by memory
+  std::vector<FairFlow*> flows;
+  flows.reserve(fair_flows_.size());
+  for (auto& pair : fair_flows_){
+    flows.push_back(&pair.second);
+  }
+  std::sort(flows.begin(), flows.end(), [](FairFlow* a, FairFlow* b){
+    if (a->maxRate == 0) return false;
+    if (b->maxRate == 0) return true;
+    return a->maxRate < b->maxRate;
+  });
+
+  //flows that cannot use an equal share give up the rest to the others
+  double bw_left = total_bandwidth_;
+  size_t num_left = flows.size();
+  for (FairFlow* f : flows){
+    double share = bw_left / num_left;
+    f->rate = (f->maxRate && f->maxRate < share) ? f->maxRate : share;
+    bw_left -= f->rate;
+    --num_left;
+  }
+}
+
+void
+MemoryModel::scheduleFairCompletion()
+{
+  double next_done = -1;
+  for (auto& pair : fair_flows_){
+    FairFlow& f = pair.second;
+    double t = f.bytesLeft / f.rate;
+    if (next_done < 0 || t < next_done){
+      next_done = t;
+    }
+  }
+  //rates changed, so an already scheduled completion is stale
+  ++fair_epoch_;
+  if (next_done >= 0){
+    //round up by a tick so the flow has fully drained when the event runs
+    TimeDelta delay = TimeDelta(next_done) + TimeDelta(1, TimeDelta::exact);
+    parent_node_->os()->sendDelayedExecutionEvent(delay,
+        newCallback(this, &MemoryModel::fairFlowDone, fair_epoch_));
+  }
+}
+
+void
+MemoryModel::fairFlowDone(uint64_t epoch)
+{
+  if (epoch != fair_epoch_){
+    return;
+  }
+
+  advanceFairFlows();
+  auto iter = fair_flows_.begin();
+  while (iter != fair_flows_.end()){
+    //allow for rounding in the drained bytes
+    if (iter->second.bytesLeft < 0.5){
+      parent_node_->os()->sendExecutionEventNow(iter->second.callback);
+      iter = fair_flows_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  allocateFairRates();
+  scheduleFairCompletion();
+}
+
 } // end namespace Hg
 } // end namespace SST
@@ -61,7 +61,9 @@ public:
 
   ~MemoryModel() {}
 
-  std::string toString() const { return "packet flow memory model"; }
+  std::string toString() const {
+    return max_min_ ? "max-min fair memory model" : "packet flow memory model";
+  }
 
   void accessFlow(uint64_t bytes, TimeDelta min_byte_delay, ExecutionEvent *cb);
 
@@ -73,6 +75,16 @@ private:
 
   int initialize(RequestHandlerBase* handler);
 
+  /** Drain the fair flows at their current rates up to now */
+  void advanceFairFlows();
+
+  /** Water-fill the node bandwidth over the active flows */
+  void allocateFairRates();
+
+  void scheduleFairCompletion();
+
+  void fairFlowDone(uint64_t epoch);
+
   struct FlowRequest : public Request {
     uint32_t flowId;
   };
@@ -83,6 +95,17 @@ private:
     TimeDelta byteRequestDelay;
   };
 
+  /**
+   * With max-min sharing, flows are fluid and each gets the largest equal share
+   * of the node bandwidth that its own issue rate allows
+   */
+  struct FairFlow {
+    ExecutionEvent *callback;
+    double bytesLeft;
+    double maxRate; //bytes/s the compute block can issue on its own
+    double rate;
+  };
+
   struct ChannelQueue {
     TimeDelta byte_delay;
     std::vector<Request *> reqs;
@@ -98,6 +121,12 @@ private:
   uint32_t channelInterleaver_;
   uint32_t flow_mtu_;
   int flow_rsp_id_;
+
+  bool max_min_;
+  double total_bandwidth_;
+  std::unordered_map<uint32_t, FairFlow> fair_flows_;
+  Timestamp fair_last_update_;
+  uint64_t fair_epoch_;
 };
 
 } // end namespace Hg
@@ -82,9 +82,7 @@ static char* get_data_segment(SST::Params& params,
    }
  }
  if (allocSize != 0){
-   char* segment = new char[allocSize];
-   ::memcpy(segment, ctx.globalInit(), ctx.globalsSize());
-   return segment;
+   return ctx.allocSegment(params.find<bool>("globals_copy_on_write", false));
  } else {
    return nullptr;
  }
@@ -212,7 +210,7 @@ App::App(SST::Params& params, SoftwareId sid,
 
 App::~App()
 {
-  if (globals_storage_) delete[] globals_storage_;
+  if (globals_storage_) GlobalVariable::glblCtx.freeSegment(globals_storage_);
 }
 
 void
@@ -17,6 +17,13 @@
 #include <mercury/operating_system/process/global.h>
 #include <mercury/operating_system/process/thread.h>
 #include <mercury/operating_system/process/cppglobal.h>
+#include <mercury/operating_system/threading/thread_lock.h>
+
+#include <sys/mman.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
 
 extern "C" {
 char* static_init_glbls_segment = nullptr;
@@ -55,6 +62,73 @@ GlobalVariableContext::init()
   stackOffset = 0;
   allocSize_ = 4096;
   globalInits = nullptr;
+  templateStale_ = true;
+}
+
+static thread_lock segment_lock;
+
+void
+GlobalVariableContext::buildTemplate()
+{
+  if (haveTemplate_){
+    //segments already mapped keep the old template alive
+    ::close(templateFd_);
+  }
+
+  FILE* file = tmpfile();
+  if (file == nullptr){
+    sst_hg_abort_printf("could not create copy-on-write globals template: %s",
+                        ::strerror(errno));
+  }
+  templateFd_ = ::dup(fileno(file));
+  fclose(file);
+
+  if (::ftruncate(templateFd_, allocSize_) != 0
+      || ::pwrite(templateFd_, globalInits, stackOffset, 0) != stackOffset){
+    sst_hg_abort_printf("could not write copy-on-write globals template: %s",
+                        ::strerror(errno));
+  }
+  haveTemplate_ = true;
+  templateStale_ = false;
+}
+
+char*
+GlobalVariableContext::allocSegment(bool copyOnWrite)
+{
+  if (!copyOnWrite || stackOffset == 0){
+    char* segment = new char[allocSize_];
+    ::memcpy(segment, globalInits, stackOffset);
+    return segment;
+  }
+
+  segment_lock.lock();
+  if (!haveTemplate_ || templateStale_){
+    buildTemplate();
+  }
+  void* segment = ::mmap(nullptr, allocSize_, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE, templateFd_, 0);
+  if (segment == MAP_FAILED){
+    sst_hg_abort_printf("could not map copy-on-write globals segment of %d bytes: %s",
+                        allocSize_, ::strerror(errno));
+  }
+  cowSegments_[(char*)segment] = allocSize_;
+  segment_lock.unlock();
+  return (char*)segment;
+}
+
+void
+GlobalVariableContext::freeSegment(char* segment)
+{
+  segment_lock.lock();
+  auto iter = cowSegments_.find(segment);
+  if (iter != cowSegments_.end()){
+    ::munmap(segment, iter->second);
+    cowSegments_.erase(iter);
+    segment_lock.unlock();
+  } else {
+    segment_lock.unlock();
+    delete[] segment;
+  }
 }
 
 void
@@ -98,6 +172,7 @@ GlobalVariableContext::append(const int size, const char*  /*name*/)
   //fflush(stdout);
 
   stackOffset += offsetIncrement;
+  templateStale_ = true;
 
   return offset;
 }
@@ -135,6 +210,9 @@ GlobalVariableContext::callInitFxns(void *globals)
 
 GlobalVariableContext::~GlobalVariableContext()
 {
+  if (haveTemplate_){
+    ::close(templateFd_);
+  }
   if (globalInits){
     delete[] globalInits;
     globalInits = nullptr;
@@ -152,6 +230,7 @@ GlobalVariableContext::initGlobalSpace(void* ptr, int size, int offset)
   //also do the global init for any new threads spawned
   char* dst = ((char*)globalInits) + offset;
   ::memcpy(dst, ptr, size);
+  templateStale_ = true;
 }
 
 }
@@ -19,6 +19,7 @@
 #include <list>
 #include <map>
 #include <functional>
+#include <unordered_map>
 #include <unordered_set>
 
 extern "C" int sst_hg_global_stacksize;
@@ -68,10 +69,27 @@ class GlobalVariableContext {
 
   void registerInitFxn(int offset, std::function<void(void*)>&& fxn);
 
+  /**
+   * A segment of allocSize() bytes holding the initial values of the
+   * variables. With copyOnWrite the segment is a private mapping of a shared
+   * template, so a rank only gets its own copy of the pages it writes.
+   */
+  char* allocSegment(bool copyOnWrite);
+
+  void freeSegment(char* segment);
+
  private:
+  void buildTemplate();
+
   int stackOffset;
   char* globalInits;
   int allocSize_;
+  /// File holding the initial values that copy-on-write segments map
+  int templateFd_;
+  bool haveTemplate_;
+  /// The template no longer matches globalInits
+  bool templateStale_;
+  std::unordered_map<char*, size_t> cowSegments_;
   //these should be ordered by the offset in the data segment
   //this ensures as much as possible that global variables
   //are initialized in the same order in SST/macro as they would be in the real app
@@ -0,0 +1,303 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <mercury/common/errors.h>
+#include <mercury/common/hg_printf.h>
+#include <mercury/common/timestamp.h>
+#include <mercury/components/operating_system.h>
+#include <mercury/operating_system/process/memoize.h>
+#include <mercury/operating_system/threading/thread_lock.h>
+#include <external/json.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
+namespace SST {
+namespace Hg {
+
+Memoization::mode_t Memoization::mode_ = Memoization::off;
+std::string Memoization::file_;
+
+static thread_lock memoize_lock;
+
+typedef std::chrono::steady_clock memoize_clock;
+// blocks do not yield, but different threads can be inside the same region
+static std::map<std::pair<Thread*,std::string>, memoize_clock::time_point> memoize_starts;
+
+std::map<std::string, Memoization::region>&
+Memoization::regions()
+{
+  static std::map<std::string, region> regions;
+  return regions;
+}
+
+Memoization::Memoization(const char* name, const char* model)
+{
+  memoize_lock.lock();
+  parseModel(getRegion(name), name, model);
+  memoize_lock.unlock();
+}
+
+void
+Memoization::parseModel(region& reg, const std::string& name, const std::string& model)
+{
+  static const std::string poly = "polynomial";
+  if (model == "linear"){
+    reg.degree = 1;
+  } else if (model.compare(0, poly.size(), poly) == 0 && model.size() > poly.size()){
+    reg.degree = atoi(model.c_str() + poly.size());
+  } else {
+    reg.degree = 0;
+  }
+  if (reg.degree < 1){
+    sst_hg_abort_printf("memoized region %s has invalid model %s", name.c_str(), model.c_str());
+  }
+}
+
+Memoization::region&
+Memoization::getRegion(const std::string& name)
+{
+  return regions()[name];
+}
+
+void
+Memoization::init(SST::Params& params, int rank, int nranks)
+{
+  if (!file_.empty()){
+    return; //already done
+  }
+
+  std::string mode = params.find<std::string>("memoize_mode", "none");
+  if (mode == "none"){
+    return;
+  } else if (mode == "calibrate"){
+    mode_ = calibrate;
+  } else if (mode == "replay"){
+    mode_ = replay;
+  } else {
+    sst_hg_abort_printf("invalid memoize_mode %s: must be none, calibrate or replay", mode.c_str());
+  }
+
+  file_ = params.find<std::string>("memoize_file", "memoize.json");
+  if (mode_ == replay){
+    readModels();
+  } else if (nranks > 1){
+    // each rank fits the blocks it ran
+    file_ = sprintf("%s.%d", file_.c_str(), rank);
+  }
+}
+
+void
+Memoization::readModels()
+{
+  std::ifstream in(file_);
+  if (!in){
+    sst_hg_abort_printf("could not open memoize_file %s", file_.c_str());
+  }
+  nlohmann::json j = nlohmann::json::parse(in);
+  for (auto& it : j.items()){
+    region& reg = getRegion(it.key());
+    reg.degree = it.value().at("degree").get<int>();
+    reg.nparams = it.value().at("nparams").get<int>();
+    reg.coefs = it.value().at("coefs").get<std::vector<double>>();
+  }
+}
+
+bool
+Memoization::start(const char* name)
+{
+  if (mode_ == off){
+    return true;
+  }
+
+  memoize_lock.lock();
+  region& reg = getRegion(name);
+  // a region without a model runs and is timed
+  bool run = mode_ == calibrate || reg.coefs.empty();
+  if (run){
+    memoize_starts[std::make_pair(OperatingSystem::currentThread(), std::string(name))] = memoize_clock::now();
+  }
+  memoize_lock.unlock();
+  return run;
+}
+
+void
+Memoization::finish(const char* name, int nparams, const double* params)
+{
+  if (mode_ == off){
+    return;
+  }
+
+  memoize_clock::time_point now = memoize_clock::now();
+  double time = 0;
+  memoize_lock.lock();
+  region& reg = getRegion(name);
+  auto iter = memoize_starts.find(std::make_pair(OperatingSystem::currentThread(), std::string(name)));
+  if (iter != memoize_starts.end()){
+    time = std::chrono::duration<double>(now - iter->second).count();
+    memoize_starts.erase(iter);
+    if (mode_ == calibrate){
+      if (reg.nparams < 0){
+        reg.nparams = nparams;
+      } else if (reg.nparams != nparams){
+        sst_hg_abort_printf("memoized region %s finished with %d parameters, expected %d",
+                            name, nparams, reg.nparams);
+      }
+      reg.samples.emplace_back(params, params + nparams);
+      reg.times.push_back(time);
+    }
+  } else {
+    time = predict(name, nparams, params);
+  }
+  memoize_lock.unlock();
+
+  OperatingSystem::currentOs()->blockTimeout(TimeDelta(time));
+}
+
+void
+Memoization::features(const region& reg, int nparams, const double* params, std::vector<double>& x)
+{
+  x.assign(1, 1.0);
+  for (int d=1; d <= reg.degree; ++d){
+    for (int i=0; i < nparams; ++i){
+      x.push_back(std::pow(params[i], d));
+    }
+  }
+}
+
+double
+Memoization::predict(const std::string& name, int nparams, const double* params)
+{
+  region& reg = getRegion(name);
+  if (reg.nparams != nparams){
+    sst_hg_abort_printf("memoized region %s finished with %d parameters, model has %d",
+                        name.c_str(), nparams, reg.nparams);
+  }
+  std::vector<double> x;
+  features(reg, nparams, params, x);
+  double time = 0;
+  for (size_t i=0; i < x.size(); ++i){
+    time += reg.coefs[i] * x[i];
+  }
+  return time < 0 ? 0 : time;
+}
+
+void
+Memoization::fit(region& reg)
+{
+  size_t nsamples = reg.times.size();
+  std::vector<std::vector<double>> rows(nsamples);
+  for (size_t s=0; s < nsamples; ++s){
+    features(reg, reg.nparams, reg.samples[s].data(), rows[s]);
+  }
+  size_t nfeatures = rows[0].size();
+
+  // scale the columns so high powers of large parameters stay conditioned
+  std::vector<double> scale(nfeatures, 0.0);
+  for (auto& row : rows){
+    for (size_t i=0; i < nfeatures; ++i){
+      scale[i] = std::max(scale[i], std::fabs(row[i]));
+    }
+  }
+
+  // normal equations solved by elimination with partial pivoting,
+  // features the samples cannot tell apart get no weight
+  std::vector<std::vector<double>> m(nfeatures, std::vector<double>(nfeatures + 1, 0.0));
+  for (size_t s=0; s < nsamples; ++s){
+    for (size_t i=0; i < nfeatures; ++i){
+      double xi = scale[i] > 0 ? rows[s][i] / scale[i] : 0;
+      for (size_t k=0; k < nfeatures; ++k){
+        double xk = scale[k] > 0 ? rows[s][k] / scale[k] : 0;
+        m[i][k] += xi * xk;
+      }
+      m[i][nfeatures] += xi * reg.times[s];
+    }
+  }
+
+  std::vector<int> pivot_row(nfeatures, -1);
+  size_t row = 0;
+  for (size_t col=0; col < nfeatures && row < nfeatures; ++col){
+    size_t best = row;
+    for (size_t r=row+1; r < nfeatures; ++r){
+      if (std::fabs(m[r][col]) > std::fabs(m[best][col])) best = r;
+    }
+    if (std::fabs(m[best][col]) < 1e-12 * nsamples){
+      continue;
+    }
+    std::swap(m[row], m[best]);
+    for (size_t r=0; r < nfeatures; ++r){
+      if (r != row && m[r][col] != 0){
+        double f = m[r][col] / m[row][col];
+        for (size_t k=col; k <= nfeatures; ++k){
+          m[r][k] -= f * m[row][k];
+        }
+      }
+    }
+    pivot_row[col] = row++;
+  }
+
+  reg.coefs.assign(nfeatures, 0.0);
+  for (size_t col=0; col < nfeatures; ++col){
+    if (pivot_row[col] >= 0){
+      std::vector<double>& r = m[pivot_row[col]];
+      reg.coefs[col] = r[nfeatures] / r[col] / scale[col];
+    }
+  }
+}
+
+void
+Memoization::finalize()
+{
+  if (mode_ != calibrate){
+    return;
+  }
+  mode_ = off;
+
+  nlohmann::json j;
+  for (auto& pair : regions()){
+    region& reg = pair.second;
+    if (reg.times.empty()){
+      continue;
+    }
+    fit(reg);
+    j[pair.first]["degree"] = reg.degree;
+    j[pair.first]["nparams"] = reg.nparams;
+    j[pair.first]["samples"] = reg.times.size();
+    j[pair.first]["coefs"] = reg.coefs;
+  }
+
+  std::ofstream out(file_);
+  if (!out){
+    sst_hg_abort_printf("could not write memoize_file %s", file_.c_str());
+  }
+  out << j.dump(2) << std::endl;
+}
+
+}
+}
+
+extern "C" int
+sst_hg_memoize_start(const char* region)
+{
+  return SST::Hg::Memoization::start(region);
+}
+
+extern "C" void
+sst_hg_memoize_finish(const char* region, int nparams, const double* params)
+{
+  SST::Hg::Memoization::finish(region, nparams, params);
+}
@@ -11,16 +11,90 @@
 //
 // This file is part of the SST software package. For license
 // information, see the LICENSE file in the top level directory of the
-// distribution.#ifndef sstmac_sw_process_memoize_h
+// distribution.
 
 #pragma once
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bracket a compute block of a skeleton:
+ *
+ *   if (sst_hg_memoize_start("dgemm")){
+ *     ... the real computation ...
+ *   }
+ *   double p[] = {m, n, k};
+ *   sst_hg_memoize_finish("dgemm", 3, p);
+ *
+ * start returns whether the block must run. finish advances simulated
+ * time by the wall time of the block or by the model prediction.
+ */
+int sst_hg_memoize_start(const char* region);
+void sst_hg_memoize_finish(const char* region, int nparams, const double* params);
+
+#ifdef __cplusplus
+}
+
+#include <sst/core/params.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
 namespace SST {
 namespace Hg {
 
+/**
+ * Compute block memoization, set up by the memoize_mode of the OS.
+ * With "calibrate" every block runs and its wall time is recorded against
+ * its parameters, at the end of the run a least squares model is fit per
+ * region and written to memoize_file. With "replay" the models are read
+ * back, blocks are skipped and simulated time advances by the prediction.
+ * Otherwise blocks run and take no simulated time.
+ *
+ * A static Memoization picks the model of a region, "linear" or
+ * "polynomial<N>" without cross terms, regions default to linear.
+ */
 struct Memoization {
   Memoization(const char* name, const char* model);
+
+  static void init(SST::Params& params, int rank, int nranks);
+
+  static bool start(const char* name);
+
+  static void finish(const char* name, int nparams, const double* params);
+
+  /** Fit and write the models of a calibration run */
+  static void finalize();
+
+ private:
+  enum mode_t { off, calibrate, replay };
+
+  struct region {
+    region() : degree(1), nparams(-1) {}
+    int degree;
+    int nparams;
+    std::vector<std::vector<double>> samples;
+    std::vector<double> times;
+    std::vector<double> coefs;
+  };
+
+  static region& getRegion(const std::string& name);
+  static void parseModel(region& reg, const std::string& name, const std::string& model);
+  static void features(const region& reg, int nparams, const double* params, std::vector<double>& x);
+  static void fit(region& reg);
+  static double predict(const std::string& name, int nparams, const double* params);
+  static void readModels();
+
+  static std::map<std::string, region>& regions();
+
+  static mode_t mode_;
+  static std::string file_;
 };
 
 }
 }
+
+#endif
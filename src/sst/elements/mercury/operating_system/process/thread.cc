@@ -21,6 +21,7 @@
 #include <mercury/operating_system/process/thread.h>
 #include <mercury/operating_system/process/thread_info.h>
 #include <mercury/operating_system/process/app.h>
+#include <mercury/operating_system/threading/stack_alloc.h>
 
 #include <iostream>
 #include <exception>
@@ -150,6 +151,7 @@ Thread::Thread(SST::Params& params, SoftwareId sid, OperatingSystem* os) :
   last_bt_collect_nfxn_(0),
   bt_nfxn_(0),
   timed_out_(false),
+  stack_(nullptr),
   tls_storage_(nullptr),
   thread_id_(Thread::main_thread),
   context_(nullptr),
@@ -231,12 +233,12 @@ Thread::now()
 Thread::~Thread()
 {
   active_cores_.clear();
- // if (stack_) StackAlloc::free(stack_);
+  if (stack_) StackAlloc::retire(stack_);
   if (context_) {
     context_->destroyContext();
     delete context_;
   }
-  if (tls_storage_) delete[] tls_storage_;
+  if (tls_storage_) GlobalVariable::tlsCtx.freeSegment(tls_storage_);
   //if (host_timer_) delete host_timer_;
 }
 
@@ -22,8 +22,12 @@
 #include <mercury/operating_system/threading/stack_alloc_chunk.h>
 #include <mercury/operating_system/threading/thread_lock.h>
 
+#include <sys/mman.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace SST {
 namespace Hg {
 
@@ -31,6 +35,12 @@ StackAlloc::chunk_set StackAlloc::chunks_;
 size_t StackAlloc::suggested_chunk_ = 0;
 size_t StackAlloc::stacksize_ = 0;
 bool StackAlloc::protect_stacks_ = false;
+size_t StackAlloc::guard_pages_ = 0;
+bool StackAlloc::release_stacks_ = false;
+bool StackAlloc::watermark_ = false;
+size_t StackAlloc::max_resident_bytes_ = 0;
+
+static thread_lock stack_lock;
 
 extern "C" {
 int sst_hg_global_stacksize;
@@ -54,6 +64,16 @@ StackAlloc::init(SST::Params& params)
   stacksize_ = sst_hg_global_stacksize;
 
   protect_stacks_ = params.find<bool>("protect_stacks", false);
+  guard_pages_ = params.find<size_t>("stack_guard_pages", 0);
+  release_stacks_ = params.find<bool>("stack_release", false);
+  watermark_ = params.find<bool>("stack_watermark", false);
+
+  size_t page = sysconf(_SC_PAGESIZE);
+  if ((guard_pages_ + 2) * page > stacksize_){
+    sst_hg_throw_printf(ValueError,
+        "stack_size of %zu bytes leaves no room for %zu guard pages",
+        stacksize_, guard_pages_);
+  }
 }
 
 void
@@ -74,15 +94,15 @@ StackAlloc::chunk_set::clear()
 void*
 StackAlloc::alloc()
 {
-  static thread_lock lock;
-  lock.lock();
+  stack_lock.lock();
   if (stacksize_ == 0) {
     sst_hg_throw_printf(ValueError, "stackalloc::stacksize was not initialized");
   }
 
   if(chunks_.available.empty()){
     // grab a new chunk.
-    chunk* new_chunk = new chunk(stacksize_, suggested_chunk_, protect_stacks_);
+    chunk* new_chunk = new chunk(stacksize_, suggested_chunk_, protect_stacks_,
+                                 guard_pages_ * sysconf(_SC_PAGESIZE), release_stacks_);
     chunks_.allocations.push_back(new_chunk);
     void* buf = new_chunk->getNextStack();
     while (buf != nullptr){
@@ -92,7 +112,7 @@ StackAlloc::alloc()
   }
   void *buf = chunks_.available.back();
   chunks_.available.pop_back();
-  lock.unlock();
+  stack_lock.unlock();
   return buf;
 }
 
@@ -101,10 +121,40 @@ StackAlloc::alloc()
 //
 void StackAlloc::free(void* buf)
 {
-  static thread_lock lock;
-  lock.lock();
+  stack_lock.lock();
   chunks_.available.push_back(buf);
-  lock.unlock();
+  stack_lock.unlock();
+}
+
+//
+// Account for and possibly release the stack of a deleted thread.
+//
+void StackAlloc::retire(void* buf)
+{
+  // the thread local storage page is rewritten when the stack is next used
+  size_t page = sysconf(_SC_PAGESIZE);
+  char* start = (char*)buf + (1 + guard_pages_) * page;
+  size_t length = stacksize_ - (1 + guard_pages_) * page;
+
+  if (watermark_){
+    // a touched page stays resident until it is released, so without
+    // stack_release this is the most any thread on the stack has used
+    std::vector<unsigned char> resident(length / page);
+    if (mincore(start, length, resident.data()) == 0){
+      size_t bytes = page;
+      for (unsigned char r : resident){
+        bytes += (r & 1) ? page : 0;
+      }
+      stack_lock.lock();
+      max_resident_bytes_ = std::max(max_resident_bytes_, bytes);
+      stack_lock.unlock();
+    }
+  }
+
+  if (release_stacks_){
+    madvise(start, length, MADV_DONTNEED);
+    free(buf);
+  }
 }
 
 
@@ -31,6 +31,12 @@ namespace Hg {
  *
  * This allocator does not return memory to the system until it is
  * deleted, but regions can be allocated and free-d repeatedly.
+ *
+ * Stacks are only committed as they are touched. With stack_release the
+ * stack of a finished thread goes back to the free list and its pages back
+ * to the system, stack_guard_pages protects pages just above the thread
+ * local storage at the bottom of each stack and stack_watermark reports the
+ * most pages any stack had resident so stack_size can be tuned.
  */
 class StackAlloc
 {
@@ -52,6 +58,13 @@ class StackAlloc
   static size_t stacksize_;
   /// Optionally added a protected stack between each stack we return
   static bool protect_stacks_;
+  /// Pages protected between the thread local storage and the stack
+  static size_t guard_pages_;
+  /// Return the pages of a finished thread's stack to the system
+  static bool release_stacks_;
+  /// Track the most pages resident in any stack
+  static bool watermark_;
+  static size_t max_resident_bytes_;
 
  public:
   static size_t stacksize() {
@@ -72,6 +85,18 @@ class StackAlloc
 
   static void free(void*);
 
+  /// Called when a thread is deleted, only gives back the stack with stack_release
+  static void retire(void*);
+
+  static bool watermark() {
+    return watermark_;
+  }
+
+  /// The most bytes resident in the stacks retired so far
+  static size_t maxResidentBytes() {
+    return max_resident_bytes_;
+  }
+
   static void clear();
 
 };
@@ -29,15 +29,20 @@ namespace Hg {
 //
 // Make a new chunk.
 //
-StackAlloc::chunk::chunk(size_t stacksize, size_t suggested_chunk_size, bool protect) :
+StackAlloc::chunk::chunk(size_t stacksize, size_t suggested_chunk_size, bool protect,
+                         size_t guard_size, bool noreserve) :
   addr_(nullptr),
   protect_(protect),
   size_((protect_) ? 2 * suggested_chunk_size : suggested_chunk_size),
   stacksize_(stacksize),
-  step_size_((protect_) ? 2 * stacksize_ : stacksize_)
+  step_size_((protect_) ? 2 * stacksize_ : stacksize_),
+  guard_size_(guard_size)
 {
-  // Now allocate our chunk.
+  // Now allocate our chunk, pages are only committed when a stack touches them
   int mmap_flags = MAP_PRIVATE | MAP_ANON;
+  if (noreserve){
+    mmap_flags |= MAP_NORESERVE;
+  }
   addr_ = (char*)mmap(0, size_, PROT_READ | PROT_WRITE,
                       mmap_flags, -1, 0);
   if(addr_ == MAP_FAILED) {
@@ -75,6 +80,16 @@ StackAlloc::chunk::getNextStack() {
 
   void* rv = addr_ + next_stack_offset_;
   next_stack_offset_ += step_size_;
+
+  // the first page holds the thread local storage, the stack grows down onto the guard
+  if (guard_size_){
+    size_t page = sysconf(_SC_PAGESIZE);
+    if (mprotect((char*)rv + page, guard_size_, PROT_NONE) != 0){
+      cerrn << "Failed to protect stack guard of size " << guard_size_ << ": "
+                << strerror(errno) << "\n";
+      SST::Hg::abort("stackalloc::chunk: failed to mprotect stack guard.");
+    }
+  }
   return rv;
 }
 
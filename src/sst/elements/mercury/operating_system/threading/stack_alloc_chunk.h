@@ -41,10 +41,13 @@ class StackAlloc::chunk
   size_t step_size_;
   /// Offset for next stack (used in get_next_stack).
   size_t next_stack_offset_ = 0;
+  /// Bytes protected above the first page of each stack
+  size_t guard_size_;
 
  public:
   /// Make a new chunk.
-  chunk(size_t stacksize, size_t suggested_chunk_size, bool protect);
+  chunk(size_t stacksize, size_t suggested_chunk_size, bool protect,
+        size_t guard_size = 0, bool noreserve = false);
 
   ~chunk();
 
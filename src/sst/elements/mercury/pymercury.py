@@ -57,6 +57,7 @@ class HgNode(TemplateBase):
                                       "flow_mtu",
                                       "channel_bandwidth",
                                       "num_channels",
+                                      "memory_sharing",
                                      ])
         self._subscribeToPlatformParamSet("node")
 
@@ -105,12 +106,19 @@ class HgOS(TemplateBase):
                                            "post_rdma_delay",
                                            "post_header_delay",
                                            "poll_delay",
+                                           "progress_threads",
+                                           "progress_stats",
                                            "rdma_pin_latency",
                                            "rdma_page_delay",
                                            "rdma_page_size",
                                            "max_vshort_msg_size",
                                            "max_eager_msg_size",
                                            "use_put_window",
+                                           "datatype_transfer",
+                                           "iov_max_entries",
+                                           "iov_min_block_size",
+                                           "iov_setup_delay",
+                                           "iov_entry_delay",
                                            "compute_library_access_width",
                                            "compute_library_loop_overhead",
                                           ],
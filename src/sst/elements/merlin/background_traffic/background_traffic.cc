@@ -16,6 +16,8 @@
 #include <sst_config.h>
 #include "background_traffic/background_traffic.h"
 
+#include "sst/elements/merlin/router.h"
+
 #include <sst/core/params.h>
 
 using namespace SST::Merlin;
@@ -55,6 +57,21 @@ BackgroundTraffic::BackgroundTraffic(ComponentId_t cid, Params& params) :
     // send_interval = interval.getRoundedValue();
 
 
+    std::string mode = params.find<std::string>("mode","packets");
+    if ( mode == "analytic" ) {
+        analytic = true;
+    }
+    else if ( mode == "packets" ) {
+        analytic = false;
+    }
+    else {
+        getSimulationOutput().fatal(CALL_INFO, -1, "BackgroundTraffic: unknown mode: %s\n", mode.c_str());
+    }
+    analytic_samples = params.find<int>("analytic_samples",16);
+    if ( analytic && analytic_samples < 1 ) {
+        getSimulationOutput().fatal(CALL_INFO, -1, "BackgroundTraffic: analytic_samples must be at least 1\n");
+    }
+
     // For now, stash the pkt_size in serialization_time
     serialization_time = pkt_size;
 
@@ -116,8 +133,8 @@ void BackgroundTraffic::setup()
     // transfer.
     // link_bw = (link_bw * UnitAlgebra("1ps")).invert();
 
-    // kick things off
-    timing_link->send(0,NULL);
+    // kick things off, in analytic mode the routers carry the load
+    if ( !analytic ) timing_link->send(0,NULL);
 }
 
 void
@@ -141,13 +158,39 @@ BackgroundTraffic::init(unsigned int phase) {
         serialization_time = ((serialization_time /*pkt_size*/ / link_bw) / UnitAlgebra("1ps"));
         UnitAlgebra interval = serialization_time / offered_load;
         send_interval = interval.getRoundedValue();
+
+        if ( analytic ) send_reservations();
     }
 
+    // Reservations from other endpoints end up here
+    SimpleNetwork::Request* req;
+    while ( (req = link_if->recvUntimedData()) != NULL ) {
+        delete req;
+    }
+}
+
+// Reserve offered_load of the link bandwidth, split evenly over
+// analytic_samples destinations drawn from the pattern.  The
+// reservations are untimed requests, so they follow the routes the
+// topology gives untimed data.
+void
+BackgroundTraffic::send_reservations() {
+    double bits_per_sec = link_if->getLinkBW().getDoubleValue() * offered_load / analytic_samples;
+    for ( int i = 0; i < analytic_samples; ++i ) {
+        SimpleNetwork::nid_t dest = packetDestGen->getNextValue();
+        if ( dest == id ) continue;
+        BackgroundReservationEvent* ev = new BackgroundReservationEvent(bits_per_sec, packet_size);
+        link_if->sendUntimedData(new SimpleNetwork::Request(dest, id, packet_size, true, true, ev));
+    }
 }
 
 void
 BackgroundTraffic::complete(unsigned int phase) {
     link_if->complete(phase);
+    SimpleNetwork::Request* req;
+    while ( (req = link_if->recvUntimedData()) != NULL ) {
+        delete req;
+    }
  }
 
 
@@ -72,9 +72,13 @@ public:
 
     SST_ELI_DOCUMENT_PARAMS(
         {"num_peers",        "Total number of endpoints in network."},
-        {"packet_size",      "Packet size specified in either b or B (can include SI prefix).","32B"},
+        {"message_size",     "Packet size specified in either b or B (can include SI prefix).","64b"},
         {"pattern",          "Traffic pattern to use.","merlin.targetgen.uniform"},
         {"offered_load",     "Load to be offered to network.  Valid range: 0 < offered_load <= 1.0."},
+        {"mode",             "packets sends real packets.  analytic sends no packets: during init it reserves offered_load of its link bandwidth "
+                             "along the routed paths to analytic_samples destinations from pattern, and each router output port on those paths "
+                             "gives that share of its time to background traffic [packets | analytic].","packets"},
+        {"analytic_samples", "Number of destinations drawn from pattern in analytic mode.  Each reserves offered_load/analytic_samples of the link bandwidth.","16"},
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -115,6 +119,9 @@ private:
     uint64_t packets_sent;
     uint64_t packets_recd;
 
+    bool analytic;
+    int analytic_samples;
+
     Link* timing_link;
 
 public:
@@ -133,6 +140,7 @@ private:
 
     void output_timing(Event* ev);
     void progress_messages(SimTime_t current_time);
+    void send_reservations();
 
 };
 
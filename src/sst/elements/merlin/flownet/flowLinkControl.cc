@@ -0,0 +1,214 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+
+#include <sst_config.h>
+
+#include "flowLinkControl.h"
+
+#include "merlin.h"
+
+namespace SST {
+using namespace Interfaces;
+
+namespace Merlin {
+
+FlowLinkControl::FlowLinkControl(ComponentId_t cid, Params &params, int vns) :
+    SST::Interfaces::SimpleNetwork(cid),
+    rtr_link(nullptr),
+    req_vns(vns),
+    id(-1),
+    network_initialized(false),
+    receiveFunctor(nullptr), sendFunctor(nullptr)
+{
+    link_bw = params.find<UnitAlgebra>("link_bw", "1GB/s");
+    if ( !link_bw.hasUnits("B/s") && !link_bw.hasUnits("b/s") ) {
+        merlin_abort.fatal(CALL_INFO,1,"Error: link_bw must be specified in either B/s or b/s (SI prefix also allowed)\n");
+    }
+    if ( link_bw.hasUnits("B/s") ) {
+        link_bw *= UnitAlgebra("8b/B");
+    }
+
+    UnitAlgebra outbuf_size = params.find<UnitAlgebra>("output_buf_size", "4kB");
+    if ( !outbuf_size.hasUnits("b") && !outbuf_size.hasUnits("B") ) {
+        merlin_abort.fatal(CALL_INFO,-1,"out_buf_size must be specified in either "
+                           "bits or bytes: %s\n",outbuf_size.toStringBestSI().c_str());
+    }
+    if ( outbuf_size.hasUnits("B") ) outbuf_size *= UnitAlgebra("8b/B");
+    outbuf_bits = outbuf_size.getRoundedValue();
+    if ( outbuf_bits <= 0 ) {
+        merlin_abort.fatal(CALL_INFO,-1,"output_buf_size must be greater than zero\n");
+    }
+
+    std::string port_name("rtr_port");
+    if ( isAnonymous() ) {
+        port_name = params.find<std::string>("port_name");
+    }
+
+    rtr_link = configureLink(port_name, std::string("1GHz"), new Event::Handler2<FlowLinkControl,&FlowLinkControl::handle_input>(this));
+    if (!rtr_link) {
+        merlin_abort.fatal(CALL_INFO,-1,"In %s, port '%s' must be connected\n", getName().c_str(), port_name.c_str());
+    }
+
+    credits.resize(req_vns, outbuf_bits);
+    input_queues.resize(req_vns);
+
+    packet_latency = registerStatistic<uint64_t>("packet_latency");
+    send_bit_count = registerStatistic<uint64_t>("send_bit_count");
+}
+
+FlowLinkControl::~FlowLinkControl()
+{
+}
+
+void FlowLinkControl::setup()
+{
+    while ( init_events.size() ) {
+        delete init_events.front();
+        init_events.pop_front();
+    }
+}
+
+void FlowLinkControl::init(unsigned int phase)
+{
+    // The network reports our ID and link bandwidth in phase 0.
+    // Everything else is untimed data for the parent.
+    Event* ev;
+    while ( ( ev = rtr_link->recvUntimedData() ) != nullptr ) {
+        handle_untimed(ev);
+    }
+}
+
+void FlowLinkControl::complete(unsigned int phase)
+{
+    Event* ev;
+    while ( ( ev = rtr_link->recvUntimedData() ) != nullptr ) {
+        handle_untimed(ev);
+    }
+}
+
+void FlowLinkControl::handle_untimed(Event* ev)
+{
+    BaseRtrEvent* bev = static_cast<BaseRtrEvent*>(ev);
+    switch (bev->getType()) {
+    case BaseRtrEvent::INITIALIZATION:
+    {
+        RtrInitEvent* init_ev = static_cast<RtrInitEvent*>(ev);
+        if ( init_ev->command == RtrInitEvent::REPORT_ID ) {
+            id = init_ev->int_value;
+            network_initialized = true;
+        }
+        else if ( init_ev->command == RtrInitEvent::REPORT_BW ) {
+            link_bw = init_ev->ua_value;
+        }
+        delete ev;
+    }
+    break;
+    case BaseRtrEvent::PACKET:
+        init_events.push_back(static_cast<RtrEvent*>(ev));
+        break;
+    default:
+        merlin_abort_full.fatal(CALL_INFO, 1, "Reached state where a non-RtrEvent was not handled.  FlowLinkControl must be connected to merlin.flowNetwork.");
+        break;
+    }
+}
+
+void FlowLinkControl::finish()
+{
+    for ( auto& queue : input_queues ) {
+        while ( !queue.empty() ) {
+            delete queue.front();
+            queue.pop();
+        }
+    }
+}
+
+bool FlowLinkControl::send(SimpleNetwork::Request* req, int vn)
+{
+    if ( vn >= req_vns ) return false;
+    if ( !spaceToSend(vn, req->size_in_bits) ) return false;
+    req->vn = vn;
+
+    RtrEvent* ev = new RtrEvent(req,id,vn);
+    credits[vn] -= charge(ev->getSizeInBits());
+
+    ev->setInjectionTime(getCurrentSimTimeNano());
+    send_bit_count->addData(ev->getSizeInBits());
+    rtr_link->send(ev);
+    return true;
+}
+
+bool FlowLinkControl::spaceToSend(int vn, int bits)
+{
+    return credits[vn] >= charge(bits);
+}
+
+SimpleNetwork::Request* FlowLinkControl::recv(int vn)
+{
+    if ( input_queues[vn].empty() ) return nullptr;
+
+    RtrEvent* event = input_queues[vn].front();
+    input_queues[vn].pop();
+
+    SimpleNetwork::Request* ret = event->takeRequest();
+    delete event;
+    return ret;
+}
+
+void FlowLinkControl::sendUntimedData(SimpleNetwork::Request* req)
+{
+    rtr_link->sendUntimedData(new RtrEvent(req,id,0));
+}
+
+SimpleNetwork::Request* FlowLinkControl::recvUntimedData()
+{
+    if ( init_events.empty() ) return nullptr;
+
+    RtrEvent *ev = init_events.front();
+    init_events.pop_front();
+    SimpleNetwork::Request* ret = ev->takeRequest();
+    delete ev;
+    return ret;
+}
+
+void FlowLinkControl::handle_input(Event* ev)
+{
+    BaseRtrEvent* base_event = static_cast<BaseRtrEvent*>(ev);
+    if ( base_event->getType() == BaseRtrEvent::CREDIT ) {
+        credit_event* ce = static_cast<credit_event*>(ev);
+        int vn = ce->vc;
+        credits[vn] += charge(ce->credits);
+        delete ev;
+
+        if ( sendFunctor != nullptr ) {
+            bool keep = (*sendFunctor)(vn);
+            if ( !keep ) sendFunctor = nullptr;
+        }
+    }
+    else {
+        RtrEvent* event = static_cast<RtrEvent*>(ev);
+        int vn = event->getLogicalVN();
+        input_queues[vn].push(event);
+
+        packet_latency->addData(getCurrentSimTimeNano() - event->getInjectionTime());
+        if ( receiveFunctor != nullptr ) {
+            bool keep = (*receiveFunctor)(vn);
+            if ( !keep ) receiveFunctor = nullptr;
+        }
+    }
+}
+
+}
+}
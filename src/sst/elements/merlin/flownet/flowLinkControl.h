@@ -0,0 +1,128 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_FLOWNET_FLOWLINKCONTROL_H
+#define COMPONENTS_MERLIN_FLOWNET_FLOWLINKCONTROL_H
+
+#include <sst/core/subcomponent.h>
+#include <sst/core/unitAlgebra.h>
+
+#include <sst/core/interfaces/simpleNetwork.h>
+
+#include <sst/core/statapi/statbase.h>
+
+#include "sst/elements/merlin/router.h"
+
+#include <deque>
+#include <queue>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+// SimpleNetwork interface to merlin.flowNetwork.  Messages are handed to
+// the network whole; there are no flits or router credits.  The only flow
+// control is a per VN limit on the number of bits that can be in the
+// network at once, which the network returns when a flow completes.
+class FlowLinkControl : public SST::Interfaces::SimpleNetwork {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        FlowLinkControl,
+        "merlin",
+        "flowlinkcontrol",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Link Control module for connecting endpoints to merlin.flowNetwork",
+        SST::Interfaces::SimpleNetwork
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"port_name",          "Port name to connect to.  Only used when loaded anonymously",""},
+        {"link_bw",            "Bandwidth of the link specified in either b/s or B/s (can include SI prefix).  Replaced by the value reported by the network during init.", "1GB/s"},
+        {"output_buf_size",    "Number of bits each VN can have in the network at once, specified in b or B (can include SI prefix).  A larger message can be sent when nothing else is outstanding on the VN.", "4kB"},
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "packet_latency",     "Histogram of latencies for received packets", "latency", 1},
+        { "send_bit_count",     "Count number of bits sent on link", "bits", 1},
+    )
+
+    SST_ELI_DOCUMENT_PORTS(
+        {"rtr_port", "Port that connects to the flow network", { "merlin.RtrEvent", "merlin.credit_event", "" } },
+    )
+
+    FlowLinkControl(ComponentId_t cid, Params &params, int vns);
+
+    ~FlowLinkControl();
+
+    void setup();
+    void init(unsigned int phase);
+    void complete(unsigned int phase);
+    void finish();
+
+    bool send(SST::Interfaces::SimpleNetwork::Request* req, int vn);
+    bool spaceToSend(int vn, int bits);
+    SST::Interfaces::SimpleNetwork::Request* recv(int vn);
+    bool requestToReceive( int vn ) { return ! input_queues[vn].empty(); }
+
+    void sendUntimedData(SST::Interfaces::SimpleNetwork::Request* ev);
+    SST::Interfaces::SimpleNetwork::Request* recvUntimedData();
+
+    inline void setNotifyOnReceive(HandlerBase* functor) { receiveFunctor = functor; }
+    inline void setNotifyOnSend(HandlerBase* functor) { sendFunctor = functor; }
+
+    inline bool isNetworkInitialized() const { return network_initialized; }
+    inline nid_t getEndpointID() const { return id; }
+    inline const UnitAlgebra& getLinkBW() const { return link_bw; }
+
+private:
+
+    Link* rtr_link;
+
+    UnitAlgebra link_bw;
+    int outbuf_bits;
+
+    int req_vns;
+    // Bits each VN may still put into the network
+    std::vector<int> credits;
+    std::vector<std::queue<RtrEvent*>> input_queues;
+
+    // Initialization events received from network
+    std::deque<RtrEvent*> init_events;
+
+    nid_t id;
+    bool network_initialized;
+
+    HandlerBase* receiveFunctor;
+    HandlerBase* sendFunctor;
+
+    Statistic<uint64_t>* packet_latency;
+    Statistic<uint64_t>* send_bit_count;
+
+    // Messages larger than the buffer are charged the whole buffer
+    inline int charge(int bits) const { return bits < outbuf_bits ? bits : outbuf_bits; }
+
+    void handle_untimed(Event* ev);
+    void handle_input(Event* ev);
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_FLOWNET_FLOWLINKCONTROL_H
@@ -0,0 +1,351 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+
+#include <sst_config.h>
+
+#include "flowNetwork.h"
+
+#include <sst/core/interfaces/simpleNetwork.h>
+
+#include "merlin.h"
+
+#include <cmath>
+#include <limits>
+
+using namespace SST::Merlin;
+using namespace SST::Interfaces;
+
+FlowNetwork::FlowNetwork(ComponentId_t cid, Params& params) :
+    Component(cid),
+    last_update(0),
+    timer_link(nullptr),
+    output(getSimulationOutput())
+{
+    num_endpoints = params.find<int>("num_endpoints", -1);
+    if ( num_endpoints <= 0 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flowNetwork requires num_endpoints to be specified\n");
+    }
+
+    link_bw = params.find<UnitAlgebra>("link_bw");
+    if ( !link_bw.hasUnits("B/s") && !link_bw.hasUnits("b/s") ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flowNetwork: link_bw must be specified in either B/s or b/s (SI prefix also allowed)\n");
+    }
+    if ( link_bw.hasUnits("B/s") ) {
+        link_bw *= UnitAlgebra("8b/B");
+    }
+    double ep_bw = link_bw.getDoubleValue() / 1.0e12;
+
+    endpoints_per_group = params.find<int>("endpoints_per_group", 0);
+    if ( endpoints_per_group < 0 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flowNetwork: endpoints_per_group must not be negative\n");
+    }
+    if ( endpoints_per_group == 0 || endpoints_per_group > num_endpoints ) {
+        endpoints_per_group = num_endpoints;
+    }
+    num_groups = (num_endpoints + endpoints_per_group - 1) / endpoints_per_group;
+
+    double group_bw = ep_bw * endpoints_per_group;
+    std::string group_bw_str = params.find<std::string>("group_bw", "");
+    if ( !group_bw_str.empty() ) {
+        UnitAlgebra bw(group_bw_str);
+        if ( !bw.hasUnits("B/s") && !bw.hasUnits("b/s") ) {
+            merlin_abort.fatal(CALL_INFO, -1, "flowNetwork: group_bw must be specified in either B/s or b/s (SI prefix also allowed)\n");
+        }
+        if ( bw.hasUnits("B/s") ) bw *= UnitAlgebra("8b/B");
+        group_bw = bw.getDoubleValue() / 1.0e12;
+    }
+
+    UnitAlgebra lat = params.find<UnitAlgebra>("local_latency", "100ns");
+    if ( !lat.hasUnits("s") ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flowNetwork: local_latency must be specified in units of s (SI prefix also allowed)\n");
+    }
+    local_latency = (lat / UnitAlgebra("1ps")).getRoundedValue();
+
+    lat = params.find<UnitAlgebra>("global_latency", "300ns");
+    if ( !lat.hasUnits("s") ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flowNetwork: global_latency must be specified in units of s (SI prefix also allowed)\n");
+    }
+    global_latency = (lat / UnitAlgebra("1ps")).getRoundedValue();
+
+    // Set up the link model
+    int num_links = 2 * num_endpoints + 2 * num_groups;
+    link_capacity.resize(num_links, ep_bw);
+    for ( int g = 0; g < num_groups; ++g ) {
+        link_capacity[upLink(g)] = group_bw;
+        link_capacity[downLink(g)] = group_bw;
+    }
+    link_left.resize(num_links, 0.0);
+    link_count.resize(num_links, 0);
+    link_flows.resize(num_links);
+
+    // Configure the links to the endpoints.  Everything is done in ps
+    ps_tc = getTimeConverter("1ps");
+    ports.resize(num_endpoints);
+    for ( int i = 0; i < num_endpoints; ++i ) {
+        std::string port_name = "port" + std::to_string(i);
+        ports[i] = configureLink(port_name, "1ps", new Event::Handler2<FlowNetwork,&FlowNetwork::handle_input,int>(this, i));
+        if ( ports[i] == nullptr ) {
+            merlin_abort.fatal(CALL_INFO, -1, "flowNetwork: port %s must be connected\n", port_name.c_str());
+        }
+    }
+
+    timer_link = configureSelfLink("flow_timer", "1ps", new Event::Handler2<FlowNetwork,&FlowNetwork::handle_timer>(this));
+
+    flow_time = registerStatistic<uint64_t>("flow_time");
+    active_flows = registerStatistic<uint64_t>("active_flows");
+}
+
+FlowNetwork::~FlowNetwork()
+{
+}
+
+void
+FlowNetwork::init(unsigned int phase)
+{
+    if ( phase == 0 ) {
+        // Tell each endpoint its ID and the bandwidth of its link
+        for ( int i = 0; i < num_endpoints; ++i ) {
+            RtrInitEvent* ev = new RtrInitEvent();
+            ev->command = RtrInitEvent::REPORT_ID;
+            ev->int_value = i;
+            ports[i]->sendUntimedData(ev);
+
+            ev = new RtrInitEvent();
+            ev->command = RtrInitEvent::REPORT_BW;
+            ev->ua_value = link_bw;
+            ports[i]->sendUntimedData(ev);
+        }
+    }
+    forwardUntimedData();
+}
+
+void
+FlowNetwork::complete(unsigned int phase)
+{
+    forwardUntimedData();
+}
+
+void
+FlowNetwork::forwardUntimedData()
+{
+    for ( int i = 0; i < num_endpoints; ++i ) {
+        Event* ev;
+        while ( ( ev = ports[i]->recvUntimedData() ) != nullptr ) {
+            BaseRtrEvent* bev = static_cast<BaseRtrEvent*>(ev);
+            if ( bev->getType() != BaseRtrEvent::PACKET ) {
+                delete ev;
+                continue;
+            }
+
+            RtrEvent* rev = static_cast<RtrEvent*>(ev);
+            SimpleNetwork::nid_t dest = rev->getDest();
+            if ( dest == SimpleNetwork::INIT_BROADCAST_ADDR ) {
+                for ( int j = 0; j < num_endpoints; ++j ) {
+                    if ( j == i ) continue;
+                    ports[j]->sendUntimedData(rev->clone());
+                }
+                delete rev;
+            }
+            else {
+                if ( dest < 0 || dest >= num_endpoints ) {
+                    merlin_abort.fatal(CALL_INFO, -1, "flowNetwork: untimed data from endpoint %d sent to invalid destination %" PRI_NID "\n", i, dest);
+                }
+                ports[dest]->sendUntimedData(rev);
+            }
+        }
+    }
+}
+
+void
+FlowNetwork::finish()
+{
+    for ( auto& flow : flows ) {
+        delete flow.ev;
+    }
+    flows.clear();
+}
+
+void
+FlowNetwork::handle_input(Event* ev, int port)
+{
+    BaseRtrEvent* bev = static_cast<BaseRtrEvent*>(ev);
+    if ( bev->getType() != BaseRtrEvent::PACKET ) {
+        // Endpoints have nothing else to tell the network
+        delete ev;
+        return;
+    }
+
+    advance();
+    startFlow(static_cast<RtrEvent*>(ev), port);
+    reschedule();
+}
+
+void
+FlowNetwork::handle_timer(Event* ev)
+{
+    timers.erase(getCurrentSimTime(ps_tc));
+    advance();
+    reschedule();
+}
+
+void
+FlowNetwork::startFlow(RtrEvent* ev, int port)
+{
+    SimpleNetwork::nid_t dest = ev->getDest();
+    if ( dest < 0 || dest >= num_endpoints ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flowNetwork: endpoint %d sent a message to invalid destination %" PRI_NID "\n", port, dest);
+    }
+
+    Flow flow;
+    flow.ev = ev;
+    flow.src = port;
+    flow.dst = dest;
+    flow.remaining = ev->getSizeInBits();
+    flow.rate = 0.0;
+    flow.start = getCurrentSimTime(ps_tc);
+
+    int src_group = port / endpoints_per_group;
+    int dst_group = dest / endpoints_per_group;
+
+    flow.num_links = 0;
+    flow.links[flow.num_links++] = injectLink(port);
+    if ( src_group != dst_group ) {
+        flow.links[flow.num_links++] = upLink(src_group);
+        flow.links[flow.num_links++] = downLink(dst_group);
+        flow.latency = global_latency;
+    }
+    else {
+        flow.latency = local_latency;
+    }
+    flow.links[flow.num_links++] = ejectLink(dest);
+
+    flows.push_back(flow);
+    active_flows->addData(flows.size());
+}
+
+void
+FlowNetwork::retireFlow(Flow& flow, SimTime_t now)
+{
+    RtrEvent* ev = flow.ev;
+
+    // Give the source back the bits it injected, then deliver the
+    // message once the last bit has crossed the network
+    ports[flow.src]->send(new credit_event(ev->getLogicalVN(), ev->getSizeInBits()));
+    ports[flow.dst]->send(flow.latency, ev);
+
+    flow_time->addData((now + flow.latency - flow.start) / 1000);
+}
+
+void
+FlowNetwork::advance()
+{
+    SimTime_t now = getCurrentSimTime(ps_tc);
+    double elapsed = now - last_update;
+    last_update = now;
+
+    for ( size_t i = 0; i < flows.size(); ) {
+        Flow& flow = flows[i];
+        flow.remaining -= flow.rate * elapsed;
+        if ( flow.remaining < 1.0 ) {
+            retireFlow(flow, now);
+            // The flow moved into this slot still needs to be advanced
+            flows[i] = flows.back();
+            flows.pop_back();
+        }
+        else {
+            ++i;
+        }
+    }
+}
+
+void
+FlowNetwork::reschedule()
+{
+    computeRates();
+
+    SimTime_t now = getCurrentSimTime(ps_tc);
+    SimTime_t next = std::numeric_limits<SimTime_t>::max();
+    for ( auto& flow : flows ) {
+        if ( flow.rate <= 0.0 ) continue;
+        double delta = std::ceil(flow.remaining / flow.rate);
+        if ( delta > 1.0e18 ) delta = 1.0e18;
+        SimTime_t done = delta < 1.0 ? now + 1 : now + (SimTime_t)delta;
+        if ( done < next ) next = done;
+    }
+
+    if ( next == std::numeric_limits<SimTime_t>::max() ) return;
+    // An earlier timer will reschedule when it fires
+    if ( !timers.empty() && *timers.begin() <= next ) return;
+
+    timers.insert(next);
+    timer_link->send(next - now, nullptr);
+}
+
+void
+FlowNetwork::computeRates()
+{
+    for ( int l : used_links ) {
+        link_count[l] = 0;
+        link_flows[l].clear();
+    }
+    used_links.clear();
+
+    for ( size_t i = 0; i < flows.size(); ++i ) {
+        Flow& flow = flows[i];
+        flow.rate = 0.0;
+        for ( int j = 0; j < flow.num_links; ++j ) {
+            int l = flow.links[j];
+            if ( link_count[l] == 0 && link_flows[l].empty() ) {
+                used_links.push_back(l);
+                link_left[l] = link_capacity[l];
+            }
+            link_count[l]++;
+            link_flows[l].push_back(i);
+        }
+    }
+
+    // Progressive filling: the link with the smallest fair share is
+    // the bottleneck for every unassigned flow that crosses it.  Those
+    // flows get the fair share and their bandwidth is removed from the
+    // other links they use.  Repeat until every flow has a rate.
+    size_t unassigned = flows.size();
+    while ( unassigned > 0 ) {
+        int bottleneck = -1;
+        double share = std::numeric_limits<double>::max();
+        for ( int l : used_links ) {
+            if ( link_count[l] == 0 ) continue;
+            double s = link_left[l] / link_count[l];
+            if ( s < share ) {
+                share = s;
+                bottleneck = l;
+            }
+        }
+
+        for ( int i : link_flows[bottleneck] ) {
+            Flow& flow = flows[i];
+            if ( flow.rate > 0.0 ) continue;
+            // Guard against round off leaving a link with no bandwidth
+            flow.rate = share > 0.0 ? share : std::numeric_limits<double>::min();
+            for ( int j = 0; j < flow.num_links; ++j ) {
+                int l = flow.links[j];
+                link_left[l] -= share;
+                if ( link_left[l] < 0.0 ) link_left[l] = 0.0;
+                link_count[l]--;
+            }
+            unassigned--;
+        }
+    }
+}
@@ -0,0 +1,155 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_FLOWNET_FLOWNETWORK_H
+#define COMPONENTS_MERLIN_FLOWNET_FLOWNETWORK_H
+
+#include <sst/core/component.h>
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+#include <sst/core/unitAlgebra.h>
+
+#include "sst/elements/merlin/router.h"
+
+#include <set>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+/*
+ * Flow-level network model.
+ *
+ * Every message sent by an endpoint becomes a flow that crosses a small set
+ * of links: the injection link of the source, the uplink of the source group
+ * and the downlink of the destination group (only when the two endpoints are
+ * in different groups) and the ejection link of the destination.  Whenever a
+ * flow starts or finishes, the rates of all active flows are recomputed with
+ * max-min fair sharing (progressive filling) and a single timer event is
+ * scheduled for the next flow to complete.  A completed flow is delivered to
+ * its destination after the base latency of the path, and the source is sent
+ * a credit for the bits it injected.
+ *
+ * There are no routers, packets or clocks, so the cost of simulating a
+ * message does not depend on its size or on the number of hops it takes.
+ * Endpoints attach with merlin.flowlinkcontrol.
+ */
+class FlowNetwork : public Component {
+
+public:
+
+    SST_ELI_REGISTER_COMPONENT(
+        FlowNetwork,
+        "merlin",
+        "flowNetwork",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Flow-level network model.  Messages are modeled as flows that share link bandwidth max-min fairly.  Endpoints connect using merlin.flowlinkcontrol.",
+        COMPONENT_CATEGORY_NETWORK)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"num_endpoints",       "Number of endpoints connected to the network."},
+        {"link_bw",             "Bandwidth of the endpoint links specified in either b/s or B/s (can include SI prefix)."},
+        {"endpoints_per_group", "Number of consecutive endpoints that share a group uplink.  0 puts all endpoints in a single group.", "0"},
+        {"group_bw",            "Bandwidth of the link between each group and the rest of the network, in each direction.  Defaults to link_bw times endpoints_per_group.", ""},
+        {"local_latency",       "Base latency of a message between endpoints in the same group.", "100ns"},
+        {"global_latency",      "Base latency of a message between endpoints in different groups.", "300ns"},
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "flow_time",    "Time from when a message enters the network until it is delivered", "ns", 1},
+        { "active_flows", "Number of flows in the network, sampled each time a flow starts", "flows", 1},
+    )
+
+    SST_ELI_DOCUMENT_PORTS(
+        {"port%(num_endpoints)d", "Ports which connect to endpoints.", { "merlin.RtrEvent", "merlin.credit_event" } },
+    )
+
+    FlowNetwork(ComponentId_t cid, Params& params);
+    ~FlowNetwork();
+
+    void init(unsigned int phase);
+    void complete(unsigned int phase);
+    void finish();
+
+private:
+
+    struct Flow {
+        RtrEvent* ev;
+        int src;
+        int dst;
+        int links[4];
+        int num_links;
+        double remaining;   // bits left to transfer
+        double rate;        // bits/ps
+        SimTime_t start;    // ps
+        SimTime_t latency;  // ps
+    };
+
+    int num_endpoints;
+    int endpoints_per_group;
+    int num_groups;
+
+    // Links are numbered: injection links, ejection links, group
+    // uplinks, group downlinks
+    inline int injectLink(int ep) const { return ep; }
+    inline int ejectLink(int ep) const { return num_endpoints + ep; }
+    inline int upLink(int group) const { return 2 * num_endpoints + group; }
+    inline int downLink(int group) const { return 2 * num_endpoints + num_groups + group; }
+
+    UnitAlgebra link_bw;
+    SimTime_t local_latency;     // ps
+    SimTime_t global_latency;    // ps
+
+    std::vector<double> link_capacity;   // bits/ps
+
+    // Scratch space for computeRates(), sized to the number of links
+    std::vector<double> link_left;
+    std::vector<int> link_count;
+    std::vector<std::vector<int>> link_flows;
+    std::vector<int> used_links;
+
+    std::vector<Flow> flows;
+    SimTime_t last_update;
+    // Times at which there is already a timer event outstanding
+    std::set<SimTime_t> timers;
+
+    std::vector<Link*> ports;
+    Link* timer_link;
+    TimeConverter ps_tc;
+
+    Statistic<uint64_t>* flow_time;
+    Statistic<uint64_t>* active_flows;
+
+    Output& output;
+
+    void handle_input(Event* ev, int port);
+    void handle_timer(Event* ev);
+
+    void startFlow(RtrEvent* ev, int port);
+    void retireFlow(Flow& flow, SimTime_t now);
+    void advance();
+    void reschedule();
+    void computeRates();
+    void forwardUntimedData();
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_FLOWNET_FLOWNETWORK_H
@@ -20,6 +20,8 @@
 #include <sst/core/timeLord.h>
 #include <sst/core/unitAlgebra.h>
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
 #include <string>
 
@@ -150,7 +152,14 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
 
     topo->getVCsPerVN(vcs_per_vn);
     num_vcs = 0;
-    for ( int vcs : vcs_per_vn ) num_vcs += vcs;
+    for ( int vcs : vcs_per_vn ) {
+        vn_base_vc.push_back(num_vcs);
+        num_vcs += vcs;
+    }
+
+    collectives_enabled = params.find<bool>("collectives",false);
+    collective_out.resize(num_ports);
+    collective_out_count = 0;
 
     // Check to see if remap is on
     vn_remap_shm = params.find<std::string>("vn_remap_shm","");
@@ -230,6 +239,11 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
 
     progress_vcs = new int[num_ports];
 
+    // Track which ports have input data and which have busy xbar
+    // ports so each cycle only visits the ports with work to do
+    initActivePorts(num_ports);
+    busy_ports.assign((num_ports + 63) / 64, 0);
+
     std::string inspector_config = params.find<std::string>("network_inspectors", "");
     split(inspector_config,",",inspector_names);
 
@@ -306,6 +320,8 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
         port_name = port_name + std::to_string(i);
         xbar_stalls[i] = registerStatistic<uint64_t>("xbar_stalls",port_name);
     }
+    host_clock_ns = registerStatistic<uint64_t>("host_clock_ns");
+    host_clock_calls = registerStatistic<uint64_t>("host_clock_calls");
 
     init_vcs();
 }
@@ -328,15 +344,19 @@ hr_router::notifyEvent()
 
 #if !VERIFY_DECLOCKING
     // Fix up the busy variables
-    for ( int i = 0; i < num_ports; i++ ) {
-    	// Should stop at zero, need to find a clean way to do this
-    	// with no branch.  For now it should work.
-        int64_t tmp = in_port_busy[i] - elapsed_cycles;
-    	if ( tmp < 0 ) in_port_busy[i] = 0;
-        else in_port_busy[i] = tmp;
-        tmp = out_port_busy[i] - elapsed_cycles;
-    	if ( tmp < 0 ) out_port_busy[i] = 0;
-        else out_port_busy[i] = tmp;
+    for ( size_t w = 0; w < busy_ports.size(); w++ ) {
+        for ( uint64_t bits = busy_ports[w]; bits != 0; bits &= bits - 1 ) {
+            int i = (w << 6) + __builtin_ctzll(bits);
+            // Should stop at zero, need to find a clean way to do this
+            // with no branch.  For now it should work.
+            int64_t tmp = in_port_busy[i] - elapsed_cycles;
+            if ( tmp < 0 ) in_port_busy[i] = 0;
+            else in_port_busy[i] = tmp;
+            tmp = out_port_busy[i] - elapsed_cycles;
+            if ( tmp < 0 ) out_port_busy[i] = 0;
+            else out_port_busy[i] = tmp;
+            if ( in_port_busy[i] == 0 && out_port_busy[i] == 0 ) busy_ports[w] &= ~((uint64_t)1 << (i & 63));
+        }
     }
 #endif
     // Report skipped cycles to arbitration unit.
@@ -374,11 +394,30 @@ hr_router::printStatus(Output& out)
 
 bool
 hr_router::clock_handler(Cycle_t cycle)
+{
+    // The host time profile is only taken while host_clock_ns is enabled
+    if ( host_clock_ns->isNullStatistic() || !host_clock_ns->isEnabled() ) return clock_tick(cycle);
+
+    auto start = std::chrono::steady_clock::now();
+    bool ret = clock_tick(cycle);
+    host_clock_ns->addData(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    host_clock_calls->addData(1);
+    return ret;
+}
+
+bool
+hr_router::clock_tick(Cycle_t cycle)
 {
     // If there are no events in the input queues, then we can remove
     // ourselves from the clock queue, as long as the arbitration unit
     // says it's okay.
-    if ( get_vcs_with_data() == 0 ) {
+    if ( collective_out_count > 0 ) {
+        for ( int i = 0; i < num_ports; i++ ) {
+            if ( !collective_out[i].empty() ) drainCollectives(i);
+        }
+    }
+
+    if ( get_vcs_with_data() == 0 && collective_out_count == 0 ) {
 #if VERIFY_DECLOCKING
         if ( clocking ) {
             if ( arb->isOkayToPauseClock() ) {
@@ -407,12 +446,19 @@ hr_router::clock_handler(Cycle_t cycle)
     arb->arbitrate(ports,in_port_busy,out_port_busy,progress_vcs);
 #endif
 
-    // Move the events and decrement the busy values
-    for ( int i = 0; i < num_ports; i++ ) {
+    // Move the events.  Only ports with input data can have been
+    // chosen by the arbitration unit.  Ports made busy by the move
+    // are added to busy_ports.
+    for ( size_t w = 0; w < active_ports.size(); w++ ) {
+      for ( uint64_t bits = active_ports[w]; bits != 0; bits &= bits - 1 ) {
+        int i = (w << 6) + __builtin_ctzll(bits);
         // if ( progress_vcs[i] != -1 ) {
         if ( progress_vcs[i] > -1 ) {
             internal_router_event* ev = ports[i]->recv(progress_vcs[i]);
-            ports[ev->getNextPort()]->send(ev,ev->getVC());
+            int next_port = ev->getNextPort();
+            ports[next_port]->send(ev,ev->getVC());
+            busy_ports[w] |= (uint64_t)1 << (i & 63);
+            busy_ports[next_port >> 6] |= (uint64_t)1 << (next_port & 63);
 
             if ( ev->getTraceType() == SimpleNetwork::Request::FULL ) {
                 output.output("TRACE(%d): %" PRIu64 " ns: Copying event (src = %d, dest = %d) "
@@ -434,11 +480,19 @@ hr_router::clock_handler(Cycle_t cycle)
         else if ( progress_vcs[i] == -2 ) {
                 xbar_stalls[i]->addData(1);
         }
+      }
+    }
 
-        // Should stop at zero, need to find a clean way to do this
-        // with no branch.  For now it should work.
-        if ( in_port_busy[i] != 0 ) in_port_busy[i]--;
-        if ( out_port_busy[i] != 0 ) out_port_busy[i]--;
+    // Decrement the busy values, dropping ports that are no longer busy
+    for ( size_t w = 0; w < busy_ports.size(); w++ ) {
+        for ( uint64_t bits = busy_ports[w]; bits != 0; bits &= bits - 1 ) {
+            int i = (w << 6) + __builtin_ctzll(bits);
+            // Should stop at zero, need to find a clean way to do this
+            // with no branch.  For now it should work.
+            if ( in_port_busy[i] != 0 ) in_port_busy[i]--;
+            if ( out_port_busy[i] != 0 ) out_port_busy[i]--;
+            if ( in_port_busy[i] == 0 && out_port_busy[i] == 0 ) busy_ports[w] &= ~((uint64_t)1 << (i & 63));
+        }
     }
 
     return false;
@@ -457,11 +511,23 @@ void hr_router::finish()
     	ports[i]->finish();
     }
 
+    for ( auto& q : collective_out ) {
+        for ( auto ev : q ) delete ev;
+        q.clear();
+    }
+    collective_out_count = 0;
+    for ( auto& group : collective_groups ) {
+        for ( auto& pending : group.second.pending ) {
+            for ( auto ev : pending.second ) delete ev;
+        }
+    }
+    collective_groups.clear();
 }
 
 void
 hr_router::init(unsigned int phase)
 {
+    topo->init(phase);
     for ( int i = 0; i < num_ports; i++ ) {
         ports[i]->init(phase);
         Event *ev = NULL;
@@ -616,6 +682,7 @@ hr_router::init_vcs()
     // Now that we have the number of VCs we can finish initializing
     // arbitration logic
     arb->setPorts(num_ports,num_vcs);
+    arb->setActivePorts(active_ports.data());
 
 
 }
@@ -630,3 +697,159 @@ hr_router::reportIncomingEvent(internal_router_event* ev)
         ports[dest.second]->reportIncomingEvent(ev);
     }
 }
+
+int
+hr_router::collectiveParent(RtrEvent* ev, int port)
+{
+    // Route an empty probe packet to the root endpoint to find the
+    // next hop from this router
+    SimpleNetwork::nid_t root = Collective::getRoot(ev->getDest());
+    SimpleNetwork::Request* req = new SimpleNetwork::Request(root, ev->getLogicalSrc(), 0, true, true);
+    req->vn = ev->getLogicalVN();
+    RtrEvent* probe = new RtrEvent(req, ev->getTrustedSrc(), ev->getRouteVN());
+    probe->computeSizeInFlits(1);
+
+    internal_router_event* ire = topo->process_input(probe);
+    topo->route_packet(port, ire->getVC(), ire);
+    int next_port = ire->getNextPort();
+    delete ire;
+
+    if ( next_port < 0 || next_port >= num_ports ) {
+        merlin_abort.fatal(CALL_INFO, -1, "hr_router %d: unable to route collective JOIN toward root endpoint %" PRI_NID "\n", id, root);
+    }
+    return next_port;
+}
+
+void
+hr_router::drainCollectives(int port)
+{
+    auto& q = collective_out[port];
+    while ( !q.empty() ) {
+        internal_router_event* ire = q.front();
+        if ( !ports[port]->spaceToSend(ire->getVC(), ire->getFlitCount()) ) break;
+        ports[port]->send(ire, ire->getVC());
+        q.pop_front();
+        collective_out_count--;
+    }
+}
+
+void
+hr_router::sendCollective(int port, RtrEvent* ev)
+{
+    internal_router_event* ire = new internal_router_event(ev);
+    ire->setVC(vn_base_vc[ev->getRouteVN()]);
+    ire->setNextPort(port);
+    collective_out[port].push_back(ire);
+    collective_out_count++;
+
+    drainCollectives(port);
+    // Need the clock to retry anything that didn't fit
+    if ( collective_out_count > 0 && getRequestNotifyOnEvent() ) notifyEvent();
+}
+
+void
+hr_router::replicateCollective(const CollectiveGroup& group, int in_port, bool include_parent, RtrEvent* ev)
+{
+    std::vector<int> out_ports;
+    for ( int child : group.children ) {
+        if ( child != in_port ) out_ports.push_back(child);
+    }
+    if ( include_parent && group.parent != in_port ) out_ports.push_back(group.parent);
+
+    if ( out_ports.empty() ) {
+        delete ev;
+        return;
+    }
+    for ( size_t i = 0; i < out_ports.size() - 1; i++ ) {
+        sendCollective(out_ports[i], ev->clone());
+    }
+    sendCollective(out_ports.back(), ev);
+}
+
+void
+hr_router::recvCollective(int port, RtrEvent* ev)
+{
+    SimpleNetwork::nid_t dest = ev->getDest();
+    uint32_t group_id = Collective::getGroup(dest);
+    Collective::Op op = Collective::getOp(dest);
+
+    if ( op == Collective::JOIN ) {
+        auto it = collective_groups.find(group_id);
+        if ( it == collective_groups.end() ) {
+            CollectiveGroup& group = collective_groups[group_id];
+            group.parent = collectiveParent(ev, port);
+            group.top = topo->isHostPort(group.parent);
+            if ( port != group.parent ) group.children.push_back(port);
+            // Only the first JOIN continues toward the root
+            if ( !group.top ) {
+                sendCollective(group.parent, ev);
+                return;
+            }
+        }
+        else {
+            CollectiveGroup& group = it->second;
+            if ( port != group.parent &&
+                 std::find(group.children.begin(), group.children.end(), port) == group.children.end() ) {
+                group.children.push_back(port);
+            }
+        }
+        delete ev;
+        return;
+    }
+
+    auto it = collective_groups.find(group_id);
+    if ( it == collective_groups.end() ) {
+        merlin_abort.fatal(CALL_INFO, -1, "hr_router %d: received collective packet for group %u, which has no members through this router\n", id, group_id);
+    }
+    CollectiveGroup& group = it->second;
+
+    if ( port != group.parent &&
+         std::find(group.children.begin(), group.children.end(), port) == group.children.end() ) {
+        merlin_abort.fatal(CALL_INFO, -1, "hr_router %d: received collective packet for group %u on port %d, which is not part of the group's tree\n", id, group_id, port);
+    }
+
+    switch ( op ) {
+    case Collective::MCAST:
+        replicateCollective(group, port, true, ev);
+        break;
+    case Collective::REDUCE:
+    case Collective::ALLREDUCE:
+    {
+        if ( !group.top && port == group.parent ) {
+            // ALLREDUCE result on its way back down the tree
+            replicateCollective(group, port, false, ev);
+            break;
+        }
+
+        group.pending[port].push_back(ev);
+
+        // Wait for a contribution from every child, and from the root
+        // if it is attached to this router
+        for ( int child : group.children ) {
+            if ( group.pending[child].empty() ) return;
+        }
+        if ( group.top && group.pending[group.parent].empty() ) return;
+
+        // Combine the round.  Only timing is modeled, so the result is
+        // the first contribution and the rest are dropped.
+        RtrEvent* result = nullptr;
+        for ( auto& contrib : group.pending ) {
+            if ( contrib.second.empty() ) continue;
+            if ( result == nullptr ) result = contrib.second.front();
+            else delete contrib.second.front();
+            contrib.second.pop_front();
+        }
+
+        if ( !group.top || op == Collective::REDUCE ) {
+            sendCollective(group.parent, result);
+        }
+        else {
+            replicateCollective(group, -1, true, result);
+        }
+    }
+    break;
+    default:
+        merlin_abort.fatal(CALL_INFO, -1, "hr_router %d: unknown collective operation %d for group %u\n", id, op, group_id);
+        break;
+    }
+}
@@ -27,6 +27,8 @@
 #include <sst/core/statapi/stataccumulator.h>
 #include <sst/core/shared/sharedArray.h>
 
+#include <deque>
+#include <map>
 #include <queue>
 
 #include "sst/elements/merlin/router.h"
@@ -68,6 +70,7 @@ public:
         {"num_vns",            "Number of VNs.","2"},
         {"vn_remap",           "Array that specifies the vn remapping for each node in the systsm."},
         {"vn_remap_shm",       "Name of shared memory region for vn remapping.  If empty, no remapping is done", ""},
+        {"collectives",        "Enable in-network collectives (see the Collective namespace in merlin/router.h).  Packets addressed to a collective group are replicated and reduced along a tree built from the routes to the group's root.", "false"},
         {"debug",              "Turn on debugging for router. Set to 1 for on, 0 for off.", "0"}
     )
 
@@ -77,7 +80,11 @@ public:
         { "output_port_stalls", "Time output port is stalled (in units of core timebase)", "time in stalls", 1},
         { "xbar_stalls",        "Count number of cycles the xbar is stalled", "cycles", 1},
         { "idle_time",          "Amount of time spent idle for a given port", "units of core timebase", 1},
-        { "width_adj_count",    "Number of times that link width was increased or decreased", "width adjustment count", 1}
+        { "width_adj_count",    "Number of times that link width was increased or decreased", "width adjustment count", 1},
+        { "ecn_marks",          "Number of packets ECN marked on output", "packets", 1},
+        { "background_cycles",  "Flit cycles the output port spent on analytic background traffic reserved by background_traffic in analytic mode", "cycles", 1},
+        { "host_clock_ns",      "Host (wall clock) time spent in the crossbar clock handler", "nanoseconds", 5},
+        { "host_clock_calls",   "Calls to the crossbar clock handler, for host_clock_ns", "calls", 5}
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -116,6 +123,8 @@ private:
     int* in_port_busy;
     int* out_port_busy;
     int* progress_vcs;
+    // Bitmap of ports with a non-zero in_port_busy or out_port_busy
+    std::vector<uint64_t> busy_ports;
 
     UnitAlgebra input_buf_size;
     UnitAlgebra output_buf_size;
@@ -128,15 +137,41 @@ private:
     std::vector<std::string> inspector_names;
 
     bool clock_handler(Cycle_t cycle);
+    bool clock_tick(Cycle_t cycle);
     static void sigHandler(int signal);
 
     void init_vcs();
     Statistic<uint64_t>** xbar_stalls;
+    Statistic<uint64_t>* host_clock_ns;
+    Statistic<uint64_t>* host_clock_calls;
 
     Output& output;
 
     Shared::SharedArray<int> shared_array;
 
+    // In-network collectives
+    struct CollectiveGroup {
+        // Port toward the root.  At the top of the tree this is the
+        // host port of the root endpoint.
+        int parent;
+        bool top;
+        std::vector<int> children;
+        // Reduction contributions waiting for the rest of their
+        // round, by input port
+        std::map<int,std::deque<RtrEvent*>> pending;
+    };
+    std::map<uint32_t,CollectiveGroup> collective_groups;
+    // First VC of each VN, used for packets sent by the collective engine
+    std::vector<int> vn_base_vc;
+    // Collective packets waiting for output buffer space, by port
+    std::vector<std::deque<internal_router_event*>> collective_out;
+    int collective_out_count;
+
+    int collectiveParent(RtrEvent* ev, int port);
+    void sendCollective(int port, RtrEvent* ev);
+    void replicateCollective(const CollectiveGroup& group, int in_port, bool include_parent, RtrEvent* ev);
+    void drainCollectives(int port);
+
 public:
     hr_router(ComponentId_t cid, Params& params);
     ~hr_router();
@@ -157,6 +192,7 @@ public:
     void printStatus(Output& out);
 
     void reportIncomingEvent(internal_router_event* ev);
+    void recvCollective(int port, RtrEvent* ev);
 };
 
 }
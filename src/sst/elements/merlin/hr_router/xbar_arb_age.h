@@ -170,9 +170,9 @@ public:
         // Oldest gets top priority.
         int index = 0;
         for ( int i = 0; i < num_ports; i++ ) {
-            if ( in_port_busy[i] > 0 ) {
+            if ( in_port_busy[i] > 0 || !isPortActive(i) ) {
                 index += num_vcs;
-                continue; // No need to consider port if input to xbar is busy
+                continue; // No need to consider port if input to xbar is busy or there is no data
             }
 
             vc_heads = ports[i]->getVCHeads();
@@ -122,6 +122,13 @@ public:
             int port = check.first;
             int vc = check.second;
 
+            // Nothing to do for ports with no input data
+            if ( !isPortActive(port) ) {
+                *unsat_list = check;
+                ++unsat_list;
+                continue;
+            }
+
             // std::cout << check.first << ", " << check.second << std::endl;
 
             vc_heads = ports[port]->getVCHeads();
@@ -112,6 +112,12 @@ public:
                 continue;
             }
 
+            // No input data, so no VC to look at
+            if ( !isPortActive(port) ) {
+                rr_vcs[port] = (rr_vcs[port] + 1) % num_vcs;
+                continue;
+            }
+
             // See what we should progress for this port
             // for ( int vc = rr_vcs[port], vcount = 0; vcount < num_vcs; vc = (vc+1) % num_vcs, vcount++ ) {
             for ( int vc = rr_vcs[port], vcount = 0; vcount < num_vcs; vc = ((vc != num_vcs-1) ? (vc+1) : 0), vcount++ ) {
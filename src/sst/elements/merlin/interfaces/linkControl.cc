@@ -20,6 +20,8 @@
 
 #include <sst/core/output.h>
 
+#include <cmath>
+
 #include "merlin.h"
 
 namespace SST {
@@ -144,6 +146,52 @@ LinkControl::LinkControl(ComponentId_t cid, Params &params, int vns) :
     }
 
 
+    // Congestion control
+    std::string cc = params.find<std::string>("congestion_control","none");
+    if ( cc == "none" ) {
+        cc_enabled = false;
+    }
+    else if ( cc == "dcqcn" ) {
+        cc_enabled = true;
+    }
+    else {
+        merlin_abort.fatal(CALL_INFO,1,"LinkControl: unknown congestion_control: %s\n",cc.c_str());
+    }
+
+    if ( cc_enabled ) {
+        auto get_cycles = [&](const std::string& name, const std::string& def) -> SimTime_t {
+            UnitAlgebra ua = params.find<UnitAlgebra>(name,def);
+            if ( !ua.hasUnits("s") ) {
+                merlin_abort.fatal(CALL_INFO,1,"LinkControl: %s must be specified in units of s: %s\n",
+                                   name.c_str(),ua.toStringBestSI().c_str());
+            }
+            if ( ua.getRoundedValue() == 0 && ua.getDoubleValue() == 0.0 ) return 0;
+            return getTimeConverter(ua).getFactor();
+        };
+        cc_cnp_interval = get_cycles("cc_cnp_interval","4us");
+        cc_alpha_period = get_cycles("cc_alpha_period","55us");
+        cc_increase_period = get_cycles("cc_increase_period","55us");
+        if ( cc_alpha_period == 0 || cc_increase_period == 0 ) {
+            merlin_abort.fatal(CALL_INFO,1,"LinkControl: cc_alpha_period and cc_increase_period must be greater than zero\n");
+        }
+
+        UnitAlgebra cnp_size = params.find<UnitAlgebra>("cc_cnp_size","64B");
+        if ( !cnp_size.hasUnits("b") && !cnp_size.hasUnits("B") ) {
+            merlin_abort.fatal(CALL_INFO,1,"LinkControl: cc_cnp_size must be specified in either "
+                               "bits or bytes: %s\n",cnp_size.toStringBestSI().c_str());
+        }
+        if ( cnp_size.hasUnits("B") ) cnp_size *= UnitAlgebra("8b/B");
+        cc_cnp_size = cnp_size.getRoundedValue();
+
+        cc_g = params.find<double>("cc_alpha_g",1.0/256);
+        cc_fast_recovery = params.find<int>("cc_fast_recovery_stages",5);
+        cc_ai_rate = params.find<double>("cc_ai_rate",0.005);
+        cc_hai_rate = params.find<double>("cc_hai_rate",0.05);
+        cc_min_rate = params.find<double>("cc_min_rate",0.01);
+        if ( cc_min_rate <= 0.0 || cc_min_rate > 1.0 ) {
+            merlin_abort.fatal(CALL_INFO,1,"LinkControl: cc_min_rate must be in (0,1]\n");
+        }
+    }
 
     // Register statistics
     packet_latency = registerStatistic<uint64_t>("packet_latency");
@@ -151,6 +199,8 @@ LinkControl::LinkControl(ComponentId_t cid, Params &params, int vns) :
     output_port_stalls = registerStatistic<uint64_t>("output_port_stalls");
     idle_time = registerStatistic<uint64_t>("idle_time");
     // recv_bit_count = registerStatistic<uint64_t>("recv_bit_count");
+    cnp_sent = registerStatistic<uint64_t>("cnp_sent");
+    cnp_received = registerStatistic<uint64_t>("cnp_received");
 
     last_time = 0;
     last_recv_time = 0;
@@ -420,6 +470,10 @@ void LinkControl::finish(void)
             output_queues[i].queue.pop();
         }
     }
+    while ( !cnp_queue.empty() ) {
+        delete cnp_queue.front();
+        cnp_queue.pop();
+    }
 }
 
 
@@ -430,8 +484,17 @@ bool LinkControl::send(SimpleNetwork::Request* req, int vn) {
     if ( vn >= req_vns ) return false;
     req->vn = vn;
 
-    // Check to see if we need to do a nid translation
-    if ( use_nid_map ) req->dest = nid_map[req->dest];
+    // Check to see if we need to do a nid translation.  Collective
+    // addresses name a group, except for the root endpoint of a JOIN.
+    if ( use_nid_map ) {
+        if ( !Collective::isCollective(req->dest) ) {
+            req->dest = nid_map[req->dest];
+        }
+        else if ( Collective::getOp(req->dest) == Collective::JOIN ) {
+            req->dest = Collective::makeAddress(Collective::JOIN, Collective::getGroup(req->dest),
+                                                nid_map[Collective::getRoot(req->dest)]);
+        }
+    }
 
     // Get the output queue information for that vn
     output_queue_bundle_t& out_handle = *(vn_remap_out[vn]);
@@ -602,6 +665,17 @@ void LinkControl::handle_input(Event* ev)
     }
     else {
         RtrEvent* event = static_cast<RtrEvent*>(ev);
+
+        if ( event->isCNP() ) {
+            // Notifications never reach the endpoint, so the buffer
+            // space can be given back right away
+            rtr_link->send(1,new credit_event(event->getRouteVN(),event->getSizeInFlits()));
+            if ( cc_enabled ) recvCNP(event);
+            delete event;
+            return;
+        }
+        if ( cc_enabled && event->isCongestionMarked() ) sendCNP(event);
+
         // Simply put the event into the right virtual network queue
         // int orig_vn = event->getOriginalVN();
         int vn = event->getLogicalVN();
@@ -641,6 +715,20 @@ void LinkControl::handle_output(Event* ev)
     // For now just done automatically when events are pulled out
     // of the block
 
+    // Congestion notifications go ahead of everything else and are
+    // not rate limited
+    if ( !cnp_queue.empty() ) {
+        RtrEvent* cnp = cnp_queue.front();
+        if ( router_credits[cnp->getRouteVN()] >= cnp->getSizeInFlits() ) {
+            cnp_queue.pop();
+            router_credits[cnp->getRouteVN()] -= cnp->getSizeInFlits();
+            output_timing->send(cnp->getSizeInFlits(),nullptr);
+            rtr_link->send(cnp);
+            cnp_sent->addData(1);
+            return;
+        }
+    }
+
     // We do a round robin scheduling.  If the current vn has no
     // data, find one that does.
     int vn_to_send = -1;
@@ -657,6 +745,13 @@ void LinkControl::handle_output(Event* ev)
         if ( router_credits[output_queues[i].vn] < send_event->getSizeInFlits() ) continue;
         // Check to see if there is a congestion event
         int target = send_event->getDest();
+        if ( cc_enabled ) {
+            SimTime_t limit = rateLimitedUntil(send_event->getDest());
+            if ( limit != 0 ) {
+                if ( block_throttle < limit ) block_throttle = limit;
+                continue;
+            }
+        }
         if ( congestion_state.count(target) == 1 ) {
             // See if we can send yet
             if ( getCurrentSimCycle() < congestion_state[target].throttle_time ) {
@@ -683,6 +778,13 @@ void LinkControl::handle_output(Event* ev)
             if ( router_credits[output_queues[i].vn] < send_event->getSizeInFlits() ) continue;
             // Check to see if there is a congestion event
             int target = send_event->getDest();
+            if ( cc_enabled ) {
+                SimTime_t limit = rateLimitedUntil(send_event->getDest());
+                if ( limit != 0 ) {
+                    if ( block_throttle < limit ) block_throttle = limit;
+                    continue;
+                }
+            }
             if ( congestion_state.count(target) == 1 ) {
                 // See if we can send yet
                 if ( getCurrentSimCycle() < congestion_state[target].throttle_time ) {
@@ -721,6 +823,22 @@ void LinkControl::handle_output(Event* ev)
             }
         }
 
+        if ( cc_enabled ) {
+            // Space the next packet to a rate limited destination so
+            // that the average rate is rc times the link bandwidth
+            auto rs = rate_state.find(send_event->getDest());
+            if ( rs != rate_state.end() ) {
+                SimTime_t now = getCurrentSimCycle();
+                if ( updateRate(rs->second, now) ) {
+                    rate_state.erase(rs);
+                }
+                else {
+                    SimTime_t ser_time = size * output_timing->getDefaultTimeBase()->getFactor();
+                    rs->second.next_send = now + (SimTime_t)(ser_time / rs->second.rc);
+                }
+            }
+        }
+
         curr_out_vn = vn_to_send + 1;
         if ( curr_out_vn == used_vns ) curr_out_vn = 0;
 
@@ -788,5 +906,89 @@ void LinkControl::handle_congestion(Event* ev)
     waiting = false;
 }
 
+SimTime_t LinkControl::rateLimitedUntil(nid_t dest)
+{
+    if ( rate_state.empty() ) return 0;
+    auto rs = rate_state.find(dest);
+    if ( rs == rate_state.end() ) return 0;
+    if ( getCurrentSimCycle() >= rs->second.next_send ) return 0;
+    return rs->second.next_send;
+}
+
+bool LinkControl::updateRate(RateState& rs, SimTime_t now)
+{
+    // Alpha decays by (1-g) every period without a notification
+    SimTime_t periods = (now - rs.last_alpha) / cc_alpha_period;
+    if ( periods > 0 ) {
+        rs.alpha *= std::pow(1.0 - cc_g, (double)periods);
+        rs.last_alpha += periods * cc_alpha_period;
+    }
+
+    // Each increase period moves the current rate half way to the
+    // target.  After the fast recovery stages the target itself
+    // starts to grow, first additively and then faster.
+    periods = (now - rs.last_increase) / cc_increase_period;
+    rs.last_increase += periods * cc_increase_period;
+    while ( periods > 0 && rs.rc < 1.0 ) {
+        periods--;
+        rs.stage++;
+        if ( rs.stage > 2 * cc_fast_recovery ) rs.rt += cc_hai_rate;
+        else if ( rs.stage > cc_fast_recovery ) rs.rt += cc_ai_rate;
+        if ( rs.rt > 1.0 ) rs.rt = 1.0;
+        rs.rc = (rs.rt + rs.rc) / 2;
+        // Close enough to the link rate to stop limiting
+        if ( rs.rc > 0.999 ) rs.rc = 1.0;
+    }
+    return rs.rc >= 1.0;
+}
+
+void LinkControl::recvCNP(RtrEvent* cnp)
+{
+    cnp_received->addData(1);
+
+    SimTime_t now = getCurrentSimCycle();
+    nid_t dest = cnp->getTrustedSrc();
+    auto result = rate_state.emplace(dest,RateState(now));
+    RateState& rs = result.first->second;
+    if ( !result.second ) updateRate(rs, now);
+
+    rs.rt = rs.rc;
+    rs.rc *= (1.0 - rs.alpha / 2);
+    if ( rs.rc < cc_min_rate ) rs.rc = cc_min_rate;
+    rs.alpha = (1.0 - cc_g) * rs.alpha + cc_g;
+    rs.stage = 0;
+    rs.last_alpha = now;
+    rs.last_increase = now;
+}
+
+void LinkControl::sendCNP(RtrEvent* marked)
+{
+    nid_t src = marked->getTrustedSrc();
+    if ( src == id ) return;
+
+    // Only one notification per source per interval
+    SimTime_t now = getCurrentSimCycle();
+    auto last = last_cnp.find(src);
+    if ( last != last_cnp.end() && now - last->second < cc_cnp_interval ) return;
+    last_cnp[src] = now;
+
+    // The notification uses the physical address of the source, so it
+    // bypasses any nid remapping
+    SimpleNetwork::Request* req = new SimpleNetwork::Request(src, id, cc_cnp_size, true, true);
+    req->vn = marked->getLogicalVN();
+    RtrEvent* cnp = new RtrEvent(req,id,marked->getRouteVN());
+    cnp->computeSizeInFlits(flit_size);
+    cnp->setCNP();
+    cnp_queue.push(cnp);
+
+    if ( waiting ) {
+        output_timing->send(1,nullptr);
+        waiting = false;
+        if ( have_packets ) {
+            output_port_stalls->addData(getCurrentSimCycle() - start_block);
+        }
+    }
+}
+
 } // namespace Merlin
 } // namespace SST
@@ -69,6 +69,16 @@ public:
         {"use_nid_remap",      "If true, will remap logical nids in job to physical ids", "false" },
         {"nid_map_name",       "Base name of shared region where my NID map will be located.  If empty, no NID map will be used.",""},
         {"vn_remap",           "Remap VNs onto/off of the network.  If empty, no vn remapping is done", "" },
+        {"congestion_control", "End-to-end congestion control to use on injection.  Options are none and dcqcn.  dcqcn needs ECN marking turned on in the routers (portcontrol.ecn_kmax) and must be enabled on every endpoint.", "none" },
+        {"cc_cnp_interval",    "Minimum time between congestion notifications sent to the same source.", "4us" },
+        {"cc_cnp_size",        "Size of a congestion notification packet in b or B.", "64B" },
+        {"cc_alpha_g",         "Gain used to update the congestion estimate (alpha) for each destination.", "0.00390625" },
+        {"cc_alpha_period",    "Time without notifications after which alpha decays.", "55us" },
+        {"cc_increase_period", "Time without notifications after which the rate to a destination is increased.", "55us" },
+        {"cc_fast_recovery_stages", "Number of increase periods spent in fast recovery before additive increase starts.", "5" },
+        {"cc_ai_rate",         "Additive increase step, as a fraction of the link bandwidth.", "0.005" },
+        {"cc_hai_rate",        "Hyper increase step, as a fraction of the link bandwidth.  Used after twice cc_fast_recovery_stages increase periods.", "0.05" },
+        {"cc_min_rate",        "Lowest injection rate to a destination, as a fraction of the link bandwidth.", "0.01" },
 
     )
 
@@ -77,6 +87,8 @@ public:
         { "send_bit_count",     "Count number of bits sent on link", "bits", 1},
         { "output_port_stalls", "Time output port is stalled (in units of core timebase)", "time in stalls", 1},
         { "idle_time",          "Number of (in unites of core timebas) that port was idle", "time spent idle", 1},
+        { "cnp_sent",           "Number of congestion notifications sent in response to ECN marked packets", "packets", 1},
+        { "cnp_received",       "Number of congestion notifications received", "packets", 1},
         // { "recv_bit_count",     "Count number of bits received on the link", "bits", 1},
     )
 
@@ -197,6 +209,45 @@ private:
 
     std::map<int,CongestionState> congestion_state;
 
+    // DCQCN style rate control.  Routers ECN mark packets when their
+    // output queues build up, the destination answers marked packets
+    // with a congestion notification packet (CNP) and the source cuts
+    // its injection rate to that destination.  The rate recovers on
+    // timers, which are evaluated lazily when the destination is next
+    // sent to.  All times are in core cycles.
+    bool cc_enabled;
+    SimTime_t cc_cnp_interval;
+    int cc_cnp_size;
+    double cc_g;
+    SimTime_t cc_alpha_period;
+    SimTime_t cc_increase_period;
+    int cc_fast_recovery;
+    double cc_ai_rate;
+    double cc_hai_rate;
+    double cc_min_rate;
+
+    struct RateState {
+        // Current and target rate as a fraction of link_bw
+        double rc;
+        double rt;
+        double alpha;
+        int stage;
+        SimTime_t last_alpha;
+        SimTime_t last_increase;
+        // Earliest time the next packet to this destination can go
+        SimTime_t next_send;
+
+        RateState(SimTime_t now = 0) : rc(1.0), rt(1.0), alpha(1.0), stage(0),
+            last_alpha(now), last_increase(now), next_send(0) {}
+    };
+
+    // Only destinations that are currently rate limited have an entry
+    std::map<nid_t,RateState> rate_state;
+    // Last time a CNP was sent to each source
+    std::map<nid_t,SimTime_t> last_cnp;
+    // CNPs waiting for router credits.  These go ahead of data.
+    std::queue<RtrEvent*> cnp_queue;
+
     // Functors for notifying the parent when there is more space in
     // output queue or when a new packet arrives
     HandlerBase* receiveFunctor;
@@ -211,6 +262,8 @@ private:
     Statistic<uint64_t>* output_port_stalls;
     Statistic<uint64_t>* idle_time;
     Statistic<uint64_t>* recv_bit_count;
+    Statistic<uint64_t>* cnp_sent;
+    Statistic<uint64_t>* cnp_received;
 
     RtrInitEvent* checkInitProtocol(Event* ev, RtrInitEvent::Commands command, uint32_t line, const char* file, const char* func);
 
@@ -268,6 +321,14 @@ private:
     void handle_output(Event* ev);
     void handle_congestion(Event* ev);
 
+    void sendCNP(RtrEvent* marked);
+    void recvCNP(RtrEvent* cnp);
+    // Applies the alpha decay and rate increases due since the last
+    // update.  Returns true once the rate is back to the full link
+    // bandwidth.
+    bool updateRate(RateState& rs, SimTime_t now);
+    SimTime_t rateLimitedUntil(nid_t dest);
+
     int sent;
 
     SimTime_t foo;
@@ -0,0 +1,197 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "linkUtil.h"
+#include "merlin.h"
+
+#include <cstring>
+
+using namespace SST::Merlin;
+
+std::map<std::string,LinkUtilCollector::SharedFile> LinkUtilCollector::files;
+SST::Core::ThreadSafe::Spinlock LinkUtilCollector::files_lock;
+
+LinkUtilCollector::LinkUtilCollector(const std::string& file, SimTime_t window_cycles, uint64_t window_ps) :
+    file_name(file),
+    window(window_cycles),
+    window_ps(window_ps),
+    flits_per_window(0),
+    rtr_id(-1),
+    port_number(-1),
+    remote_rtr_id(-1),
+    remote_port_number(-1),
+    cur_window(0),
+    window_end(window_cycles),
+    busy_flits(0),
+    stall_cycles(0),
+    record_start(0),
+    pending_gap(0),
+    registered(true)
+{
+    record.reserve(2 * max_record_windows);
+
+    // The file is opened on the first write, but it can't be closed
+    // until every collector sharing it is done
+    files_lock.lock();
+    auto it = files.find(file_name);
+    if ( it == files.end() ) {
+        files[file_name] = SharedFile{nullptr, 1};
+    }
+    else {
+        it->second.users++;
+    }
+    files_lock.unlock();
+}
+
+LinkUtilCollector::~LinkUtilCollector()
+{
+    if ( registered ) release(file_name);
+}
+
+void
+LinkUtilCollector::addStall(SimTime_t start, SimTime_t end)
+{
+    if ( end <= start ) return;
+    if ( start >= window_end ) advance(start);
+
+    // Anything before the open window has already been written
+    SimTime_t window_start = window_end - window;
+    if ( start < window_start ) start = window_start;
+
+    while ( end > window_end ) {
+        stall_cycles += window_end - start;
+        start = window_end;
+        advance(start);
+    }
+    stall_cycles += end - start;
+}
+
+void
+LinkUtilCollector::finish(SimTime_t now)
+{
+    if ( !registered ) return;
+    if ( now >= window_end ) advance(now);
+    closeWindow();
+    flush();
+    release(file_name);
+    registered = false;
+}
+
+void
+LinkUtilCollector::advance(SimTime_t now)
+{
+    closeWindow();
+
+    uint64_t next = now / window;
+    uint64_t skipped = next - cur_window - 1;
+    if ( skipped > 0 && !record.empty() ) {
+        if ( skipped + pending_gap > max_inline_gap ) flush();
+        else pending_gap += skipped;
+    }
+
+    cur_window = next;
+    window_end = (next + 1) * window;
+}
+
+static inline uint8_t
+quantize(double fraction, bool any)
+{
+    double v = fraction * 255.0 + 0.5;
+    if ( v > 255.0 ) v = 255.0;
+    uint8_t q = (uint8_t)v;
+    // Don't let a little bit of activity look like none
+    if ( any && q == 0 ) q = 1;
+    return q;
+}
+
+void
+LinkUtilCollector::closeWindow()
+{
+    uint8_t busy = quantize(flits_per_window > 0 ? busy_flits / flits_per_window : 0.0, busy_flits > 0);
+    uint8_t stall = quantize((double)stall_cycles / window, stall_cycles > 0);
+    busy_flits = 0;
+    stall_cycles = 0;
+
+    if ( busy == 0 && stall == 0 ) {
+        if ( !record.empty() ) {
+            if ( ++pending_gap > max_inline_gap ) flush();
+        }
+        return;
+    }
+
+    if ( record.empty() ) {
+        record_start = cur_window;
+    }
+    else {
+        record.insert(record.end(), 2 * pending_gap, 0);
+    }
+    pending_gap = 0;
+
+    record.push_back(busy);
+    record.push_back(stall);
+    if ( record.size() >= 2 * max_record_windows ) flush();
+}
+
+void
+LinkUtilCollector::flush()
+{
+    pending_gap = 0;
+    if ( record.empty() ) return;
+
+    uint8_t header[28];
+    int32_t ids[4] = { rtr_id, port_number, remote_rtr_id, remote_port_number };
+    uint32_t count = record.size() / 2;
+    memcpy(header, ids, sizeof(ids));
+    memcpy(header + 16, &record_start, sizeof(record_start));
+    memcpy(header + 24, &count, sizeof(count));
+
+    write(file_name, window_ps, header, sizeof(header), record.data(), record.size());
+    record.clear();
+}
+
+void
+LinkUtilCollector::write(const std::string& name, uint64_t window_ps, const void* header, size_t header_size, const uint8_t* data, size_t size)
+{
+    files_lock.lock();
+    SharedFile& file = files[name];
+    if ( file.fp == nullptr ) {
+        file.fp = fopen(name.c_str(), "wb");
+        if ( file.fp == nullptr ) {
+            files_lock.unlock();
+            merlin_abort.fatal(CALL_INFO, -1, "Unable to open link utilization file %s\n", name.c_str());
+        }
+        uint32_t version = 1;
+        fwrite("MLU1", 1, 4, file.fp);
+        fwrite(&version, sizeof(version), 1, file.fp);
+        fwrite(&window_ps, sizeof(window_ps), 1, file.fp);
+    }
+    fwrite(header, 1, header_size, file.fp);
+    fwrite(data, 1, size, file.fp);
+    files_lock.unlock();
+}
+
+void
+LinkUtilCollector::release(const std::string& name)
+{
+    files_lock.lock();
+    auto it = files.find(name);
+    if ( it != files.end() && --it->second.users == 0 ) {
+        if ( it->second.fp != nullptr ) fclose(it->second.fp);
+        files.erase(it);
+    }
+    files_lock.unlock();
+}
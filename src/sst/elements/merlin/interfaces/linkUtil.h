@@ -0,0 +1,127 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_LINKUTIL_H
+#define COMPONENTS_MERLIN_LINKUTIL_H
+
+#include <sst/core/sst_types.h>
+#include <sst/core/threadsafe.h>
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+/*
+ * Windowed utilization time series for a single output link.
+ *
+ * Time is cut into fixed windows.  For each window the collector keeps
+ * the fraction of the window the link spent sending data (busy) and the
+ * fraction it spent with data queued but no credits to send it (stall),
+ * each quantized to a byte.  Runs of windows are buffered and appended
+ * to a binary file shared by every collector in the rank:
+ *
+ *   header: char magic[4] = "MLU1", uint32 version, uint64 window (ps)
+ *   record: int32 router, int32 port, int32 remote_router,
+ *           int32 remote_port, uint64 first_window, uint32 count,
+ *           uint8 busy_stall[2*count]
+ *
+ * Windows where the link did nothing are not written, so idle links cost
+ * almost nothing.  For host ports remote_router is -1 and remote_port is
+ * the endpoint id.  merlin/tools/linkutil.py reads the files.
+ */
+class LinkUtilCollector {
+public:
+
+    LinkUtilCollector(const std::string& file, SimTime_t window_cycles, uint64_t window_ps);
+    ~LinkUtilCollector();
+
+    void setLink(int rtr, int port, int remote_rtr, int remote_port) {
+        rtr_id = rtr;
+        port_number = port;
+        remote_rtr_id = remote_rtr;
+        remote_port_number = remote_port;
+    }
+
+    // Number of flits the link can send in one window
+    void setFlitsPerWindow(double flits) { flits_per_window = flits; }
+
+    // Flits are charged to the window in which they start sending
+    void addBusy(SimTime_t now, uint64_t flits) {
+        if ( now >= window_end ) advance(now);
+        busy_flits += flits;
+    }
+
+    void addStall(SimTime_t start, SimTime_t end);
+
+    // Closes the current window and writes everything that is left
+    void finish(SimTime_t now);
+
+private:
+
+    // Allow this many idle windows inside a record before starting a
+    // new one, to avoid paying for a record header on every burst
+    static const uint32_t max_inline_gap = 16;
+    static const uint32_t max_record_windows = 4096;
+
+    std::string file_name;
+    SimTime_t window;
+    uint64_t window_ps;
+    double flits_per_window;
+
+    int rtr_id;
+    int port_number;
+    int remote_rtr_id;
+    int remote_port_number;
+
+    // Current open window
+    uint64_t cur_window;
+    SimTime_t window_end;
+    uint64_t busy_flits;
+    SimTime_t stall_cycles;
+
+    // Windows waiting to be written
+    uint64_t record_start;
+    std::vector<uint8_t> record;
+    uint32_t pending_gap;
+
+    // Still counted as a user of the shared file
+    bool registered;
+
+    void advance(SimTime_t now);
+    void closeWindow();
+    void flush();
+
+    struct SharedFile {
+        FILE* fp;
+        int users;
+    };
+    static std::map<std::string,SharedFile> files;
+    static SST::Core::ThreadSafe::Spinlock files_lock;
+
+    static void write(const std::string& name, uint64_t window_ps, const void* header, size_t header_size, const uint8_t* data, size_t size);
+    static void release(const std::string& name);
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_LINKUTIL_H
@@ -17,6 +17,10 @@
 #include "portControl.h"
 #include "merlin.h"
 
+#include <sst/core/rng/xorshift.h>
+
+#include <algorithm>
+
 #include "output_arb_basic.h"
 #include "output_arb_qos_multi.h"
 
@@ -61,6 +65,7 @@ PortControl::sendCtrlEvent(CtrlRtrEvent* ev)
         // packets, we need to add stall time
         if ( have_packets) {
             output_port_stalls->addData(getCurrentSimCycle() - start_block);
+            if ( link_util ) link_util->addStall(start_block, getCurrentSimCycle());
         }
     }
 }
@@ -121,7 +126,7 @@ PortControl::recv(int vc)
 	// Need to update vc_heads
 	if ( input_buf[vc].empty() ) {
 	    vc_heads[vc] = NULL;
-	    parent->dec_vcs_with_data();
+	    parent->dec_vcs_with_data(port_number);
 	}
 	else {
         auto event = input_buf[vc].front();
@@ -248,6 +253,12 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     start_block(0),
     parent(rif),
     output(getSimulationOutput()),
+    ecn_kmin_flits(0),
+    ecn_kmax_flits(0),
+    ecn_pmax(0),
+    ecn_rng(NULL),
+    link_util(NULL),
+    util_window_cycles(0),
     cm_activated(false),
     current_incast(0),
     total_flits_incoming(0),
@@ -410,6 +421,54 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     idle_time = registerStatistic<uint64_t>("idle_time", port_name);
     width_adj_count = registerStatistic<uint64_t>("width_adj_count", port_name);
 
+    // ECN marking
+    UnitAlgebra ecn_kmin = params.find<UnitAlgebra>("ecn_kmin","0B");
+    UnitAlgebra ecn_kmax = params.find<UnitAlgebra>("ecn_kmax","0B");
+    if ( !ecn_kmin.hasUnits("b") && !ecn_kmin.hasUnits("B") ) {
+        merlin_abort.fatal(CALL_INFO,-1,"PortControl: ecn_kmin must be specified in either "
+                           "bits (b) or bytes (B): %s\n",ecn_kmin.toStringBestSI().c_str());
+    }
+    if ( !ecn_kmax.hasUnits("b") && !ecn_kmax.hasUnits("B") ) {
+        merlin_abort.fatal(CALL_INFO,-1,"PortControl: ecn_kmax must be specified in either "
+                           "bits (b) or bytes (B): %s\n",ecn_kmax.toStringBestSI().c_str());
+    }
+    if ( ecn_kmin.hasUnits("B") ) ecn_kmin *= UnitAlgebra("8b/B");
+    if ( ecn_kmax.hasUnits("B") ) ecn_kmax *= UnitAlgebra("8b/B");
+    ecn_kmin_flits = (ecn_kmin / flit_size).getRoundedValue();
+    ecn_kmax_flits = (ecn_kmax / flit_size).getRoundedValue();
+    ecn_pmax = params.find<double>("ecn_pmax",0.01);
+    if ( ecn_kmax_flits > 0 ) {
+        if ( ecn_kmin_flits > ecn_kmax_flits ) {
+            merlin_abort.fatal(CALL_INFO,-1,"PortControl: ecn_kmin must not be larger than ecn_kmax\n");
+        }
+        ecn_rng = new RNG::XORShiftRNG(rtr_id * 1024 + port_number + 1);
+    }
+    ecn_marks = registerStatistic<uint64_t>("ecn_marks", port_name);
+
+    bg_bits_per_sec = 0.0;
+    bg_weighted_bits = 0.0;
+    bg_load = 0.0;
+    bg_packet_flits = 0.0;
+    bg_stolen = 0.0;
+    bg_was_idle = true;
+    background_cycles = registerStatistic<uint64_t>("background_cycles", port_name);
+
+    // Link utilization time series.  This is much cheaper than
+    // turning on the per port statistics for every router.
+    std::string util_window_str = params.find<std::string>("util_window","");
+    if ( util_window_str != "" ) {
+        UnitAlgebra util_window(util_window_str);
+        if ( !util_window.hasUnits("s") ) {
+            merlin_abort.fatal(CALL_INFO,-1,"PortControl: util_window must be specified in units of s: %s\n",
+                               util_window.toStringBestSI().c_str());
+        }
+        util_window_cycles = getTimeConverter(util_window).getFactor();
+        uint64_t window_ps = (util_window / UnitAlgebra("1ps")).getRoundedValue();
+        std::string util_file = params.find<std::string>("util_file","link_util");
+        util_file = util_file + "." + std::to_string(getRank().rank) + ".bin";
+        link_util = new LinkUtilCollector(util_file, util_window_cycles, window_ps);
+    }
+
 	// set the SAI metrics to 0
 	stalled = 0;
 	active = 0;
@@ -428,10 +487,10 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     params.find_array<std::string>("network_inspectors",inspector_names);
 
     // Create any NetworkInspectors
+    Params inspector_params = params.get_scoped_params("inspector");
     for ( unsigned int i = 0; i < inspector_names.size(); i++ ) {
-        Params empty;
         SimpleNetwork::NetworkInspector* ni = loadAnonymousSubComponent<SimpleNetwork::NetworkInspector>
-            (inspector_names[i], "inspector_slot", i, ComponentInfo::INSERT_STATS, empty, port_name);
+            (inspector_names[i], "inspector_slot", i, ComponentInfo::INSERT_STATS, inspector_params, port_name);
         if ( ni == NULL ) {
             merlin_abort.fatal(CALL_INFO,1,"NetworkInspector: %s, not found.\n",inspector_names[i].c_str());
         }
@@ -532,6 +591,11 @@ PortControl::initVCs(int vns, int* vcs_per_vn, internal_router_event** vc_heads_
         port_ret_credits[i] = ibs.getRoundedValue();
         xbar_in_credits[i] = obs.getRoundedValue();
         port_out_credits[i] = 0;
+
+        // Every event is at least one flit, so the buffers can never
+        // hold more events than they have flits of space
+        input_buf[i].reserve(port_ret_credits[i]);
+        output_buf[i].reserve(xbar_in_credits[i]);
     }
 
 
@@ -552,6 +616,8 @@ PortControl::~PortControl() {
     for ( unsigned int i = 0; i < network_inspectors.size(); i++ ) {
         delete network_inspectors[i];
     }
+    if ( link_util != NULL ) delete link_util;
+    if ( ecn_rng != NULL ) delete ecn_rng;
 }
 
 void
@@ -562,6 +628,7 @@ PortControl::setup() {
         output_timing->replaceFunctor(new Event::Handler2<PortControl,&PortControl::handle_failed>(this));
     }
 	if (dlink_thresh >= 0) dynlink_timing->send(1,NULL);
+    updateBackgroundLoad();
     while ( init_events.size() ) {
         delete init_events.front();
         init_events.pop_front();
@@ -596,6 +663,13 @@ PortControl::finish() {
     for ( unsigned int i = 0; i < network_inspectors.size(); i++ ) {
         network_inspectors[i]->finish();
     }
+
+    if ( link_util ) {
+        if ( waiting && have_packets ) {
+            link_util->addStall(start_block, getCurrentSimCycle());
+        }
+        link_util->finish(getCurrentSimCycle());
+    }
 }
 
 RtrInitEvent* PortControl::checkInitProtocol(Event* ev, RtrInitEvent::Commands command, uint32_t line, const char* file, const char* func)
@@ -672,6 +746,9 @@ PortControl::init(unsigned int phase) {
         UnitAlgebra link_clock = link_bw / flit_size;
         flit_cycle = getTimeConverter(link_clock);
         output_timing->setDefaultTimeBase(flit_cycle);
+        if ( link_util ) {
+            link_util->setFlitsPerWindow((double)util_window_cycles / flit_cycle.getFactor());
+        }
         delete ev;
 
         // Get initialization event from endpoint, but only if I am a host port
@@ -732,6 +809,10 @@ PortControl::init(unsigned int phase) {
             remote_rdy_for_credits = true;
 
         }
+        if ( link_util ) {
+            link_util->setLink(rtr_id, port_number, remote_rtr_id,
+                               host_port ? topo->getEndpointID(port_number) : remote_port_number);
+        }
         }
         break;
 
@@ -809,10 +890,41 @@ void
 PortControl::sendUntimedData(Event *ev)
 {
     if ( connected ) {
+        // Background reservations only load links between routers
+        internal_router_event* ire = dynamic_cast<internal_router_event*>(ev);
+        if ( ire != NULL && ire->getEncapsulatedEvent() != NULL ) {
+            BackgroundReservationEvent* res = dynamic_cast<BackgroundReservationEvent*>(ire->inspectRequest()->inspectPayload());
+            if ( res != NULL ) {
+                bg_bits_per_sec += res->bits_per_sec;
+                bg_weighted_bits += res->bits_per_sec * res->packet_bits;
+            }
+        }
         port_link->sendUntimedData(ev);
     }
 }
 
+// Convert the reserved bandwidth into the fraction of the current link
+// bandwidth it takes.  The load is capped so foreground traffic always
+// makes progress.
+void
+PortControl::updateBackgroundLoad()
+{
+    if ( bg_bits_per_sec <= 0.0 ) return;
+    bg_load = std::min(bg_bits_per_sec / link_bw.getDoubleValue(), 0.95);
+    bg_packet_flits = (bg_weighted_bits / bg_bits_per_sec) / flit_size.getDoubleValue();
+}
+
+// Whole flit cycles of background work due, keeping the remainder
+int
+PortControl::backgroundCycles(double cycles)
+{
+    bg_stolen += cycles;
+    int whole = (int)bg_stolen;
+    bg_stolen -= whole;
+    if ( whole > 0 ) background_cycles->addData(whole);
+    return whole;
+}
+
 Event*
 PortControl::recvUntimedData()
 {
@@ -936,6 +1048,7 @@ PortControl::handle_input_n2r(Event* ev)
             // packets, we need to add stall time
             if ( have_packets) {
                 output_port_stalls->addData(getCurrentSimCycle() - start_block);
+                if ( link_util ) link_util->addStall(start_block, getCurrentSimCycle());
             }
 	    }
 	}
@@ -947,6 +1060,15 @@ PortControl::handle_input_n2r(Event* ev)
 
 	    // Need to process input and do the routing
         int vn = event->getRouteVN();
+
+        // Collective packets don't use the input buffers, so return
+        // their credits right away
+        if ( parent->collectivesEnabled() && Collective::isCollective(event->getDest()) ) {
+            port_link->send(1,new credit_event(vn,event->getSizeInFlits()));
+            parent->recvCollective(port_number, event);
+            break;
+        }
+
         internal_router_event* rtr_event = topo->process_input(event);
         if ( enable_congestion_management ) parent->reportIncomingEvent(rtr_event);
         rtr_event->setCreditReturnVC(vn);
@@ -960,7 +1082,7 @@ PortControl::handle_input_n2r(Event* ev)
 	    if ( vc_heads[curr_vc] == NULL ) {
             topo->route_packet(port_number, rtr_event->getVC(), rtr_event);
             vc_heads[curr_vc] = rtr_event;
-            parent->inc_vcs_with_data();
+            parent->inc_vcs_with_data(port_number);
 	    }
 
 	    if ( event->getTraceType() != SST::Interfaces::SimpleNetwork::Request::NONE ) {
@@ -1019,6 +1141,7 @@ PortControl::handle_input_r2r(Event* ev)
             // packets, we need to add stall time
             if ( have_packets) {
                 output_port_stalls->addData(getCurrentSimCycle() - start_block);
+                if ( link_util ) link_util->addStall(start_block, getCurrentSimCycle());
             }
 	    }
 	}
@@ -1029,6 +1152,14 @@ PortControl::handle_input_r2r(Event* ev)
 	case BaseRtrEvent::INTERNAL:
     {
 	    internal_router_event* event = static_cast<internal_router_event*>(ev);
+        if ( parent->collectivesEnabled() && Collective::isCollective(event->getEncapsulatedEvent()->getDest()) ) {
+            port_link->send(1,new credit_event(event->getVC(),event->getFlitCount()));
+            RtrEvent* rtr_ev = event->getEncapsulatedEvent();
+            event->setEncapsulatedEvent(NULL);
+            delete event;
+            parent->recvCollective(port_number, rtr_ev);
+            break;
+        }
         if ( enable_congestion_management ) parent->reportIncomingEvent(event);
 	    // Simply put the event into the right virtual network queue
 
@@ -1043,7 +1174,7 @@ PortControl::handle_input_r2r(Event* ev)
 	    if ( vc_heads[curr_vc] == NULL ) {
             topo->route_packet(port_number, event->getVC(), event);
             vc_heads[curr_vc] = event;
-            parent->inc_vcs_with_data();
+            parent->inc_vcs_with_data(port_number);
 	    }
 
 	    if ( event->getTraceType() != SimpleNetwork::Request::NONE ) {
@@ -1100,6 +1231,17 @@ PortControl::handle_output(Event* ev) {
     if ( !sai_port_disabled )
         vc_to_send = output_arb->arbitrate(getCurrentSimTime(flit_cycle),output_buf, port_out_credits, host_port, have_packets);
 
+    if ( vc_to_send != -1 && bg_load > 0.0 && bg_was_idle ) {
+        // The port was idle, so the packet finds whatever background
+        // packet is on the link.  Come back once it is done
+        bg_was_idle = false;
+        int wait = backgroundCycles(bg_load * bg_packet_flits / (2.0 * (1.0 - bg_load)));
+        if ( wait > 0 ) {
+            output_timing->send(wait,NULL);
+            return;
+        }
+    }
+
     if ( vc_to_send != -1 ) {
         //  We found something to send
         internal_router_event* send_event = output_buf[vc_to_send].front();
@@ -1112,6 +1254,26 @@ PortControl::handle_output(Event* ev) {
 
 	    // Need to return credits to the output buffer
 	    int size = send_event->getFlitCount();
+
+        // ECN marking is based on the queue occupancy seen by the
+        // packet as it leaves, RED style: no marks below ecn_kmin,
+        // probability rising to ecn_pmax at ecn_kmax, and every
+        // packet marked above that.
+        if ( ecn_kmax_flits > 0 ) {
+            int occupancy = output_queue_lengths[vc_to_send];
+            if ( occupancy > ecn_kmin_flits ) {
+                bool mark = occupancy >= ecn_kmax_flits;
+                if ( !mark ) {
+                    double p = ecn_pmax * (occupancy - ecn_kmin_flits) / (ecn_kmax_flits - ecn_kmin_flits);
+                    mark = ecn_rng->nextUniform() < p;
+                }
+                if ( mark ) {
+                    send_event->getEncapsulatedEvent()->markCongestion();
+                    ecn_marks->addData(1);
+                }
+            }
+        }
+
 	    xbar_in_credits[vc_to_send] += size;
         if ( !oql_track_remote ) {
             if ( oql_track_port ) {
@@ -1124,8 +1286,11 @@ PortControl::handle_output(Event* ev) {
             }
         }
 
-	    // Send an event to wake up again after this packet is sent.
-	    output_timing->send(size,NULL);
+	    // Send an event to wake up again after this packet is sent,
+	    // and after any background data that queued up behind it
+	    int bg_cycles = 0;
+	    if ( bg_load > 0.0 ) bg_cycles = backgroundCycles(size * bg_load / (1.0 - bg_load));
+	    output_timing->send(size + bg_cycles,NULL);
 
 	    // Subtract credits
 	    port_out_credits[vc_to_send] -= size;
@@ -1149,6 +1314,9 @@ PortControl::handle_output(Event* ev) {
 	    }
         send_bit_count->addData(send_event->getEncapsulatedEvent()->getSizeInBits());
         send_packet_count->addData(1);
+        if ( link_util ) {
+            link_util->addBusy(getCurrentSimCycle(), size);
+        }
 
         // Send the request to all the registered NetworkInspectors
         for ( unsigned int i = 0; i < network_inspectors.size(); i++ ) {
@@ -1178,6 +1346,7 @@ PortControl::handle_output(Event* ev) {
 	    // to know that we got to this state.
         start_block = getCurrentSimCycle();
 	    waiting = true;
+        if ( !have_packets ) bg_was_idle = true;
         // Begin counting the amount of time this port was idle
         if (!have_packets && !is_idle) {
             idle_start = getCurrentSimCycle();
@@ -1264,9 +1433,11 @@ PortControl::decreaseLinkWidth() {
     if ( cur_link_width == max_link_width ) {
         cur_link_width = cur_link_width/2;
         link_bw = link_bw/2;
+        updateBackgroundLoad();
         UnitAlgebra link_clock = link_bw / flit_size;
         TimeConverter tc = getTimeConverter(link_clock);
         output_timing->setDefaultTimeBase(tc);
+        if ( link_util ) link_util->setFlitsPerWindow((double)util_window_cycles / tc.getFactor());
         width_adj_count->addData(1);
         // I need to add a delay before messages can transmit on the link
         disable_timing->send(1,NULL);
@@ -1291,9 +1462,11 @@ PortControl::increaseLinkWidth()
     if ( cur_link_width < max_link_width ) {
         cur_link_width = max_link_width;
         link_bw = link_bw*2;
+        updateBackgroundLoad();
         UnitAlgebra link_clock = link_bw / flit_size;
         TimeConverter tc = getTimeConverter(link_clock);
         output_timing->setDefaultTimeBase(tc);
+        if ( link_util ) link_util->setFlitsPerWindow((double)util_window_cycles / tc.getFactor());
         width_adj_count->addData(1);
         // I need to add a delay before messages can transmit on the link
         disable_timing->send(1,NULL);
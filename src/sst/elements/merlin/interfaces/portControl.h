@@ -26,12 +26,14 @@
 #include <sst/core/timeConverter.h>
 #include <sst/core/unitAlgebra.h>
 #include <sst/core/shared/sharedArray.h>
+#include <sst/core/rng/rng.h>
 
 #include <sst/core/statapi/stataccumulator.h>
 
 #include <cstring>
 
 #include "sst/elements/merlin/router.h"
+#include "linkUtil.h"
 
 using namespace SST;
 
@@ -63,6 +65,7 @@ public:
         {"input_buf_size",     "Size of input buffers specified in b or B (can include SI prefix)."},
         {"output_buf_size",    "Size of output buffers specified in b or B (can include SI prefix)."},
         {"network_inspectors", "Comma separated list of network inspectors to put on output ports.", ""},
+        {"inspector.*",        "Parameters passed to the network inspectors.", ""},
         {"dlink_thresh",       ""},
         {"num_vns",            "Number of VNs set in router or python file (-1 if not set in the parent router)."},
         {"vn_remap_shm",       "Name of shared memory region for vn remapping.  If empty, no remapping is done", ""},
@@ -74,7 +77,12 @@ public:
         {"enable_congestion_management", "Turn on congestion management","false"},
         {"cm_outstanding_threshold", "Threshold for the amount of data outstanding to a host before congestion management can trigger","2*output_buf_size"},
         {"cm_pktsize_threshold", "Minimum size of a packet to be considered part of a stream with regards to congestion management","128B"},
-        {"cm_incast_threshold", "Numbr of hosts sending to an enpoint needed to trigger congestion management","6"}
+        {"cm_incast_threshold", "Numbr of hosts sending to an enpoint needed to trigger congestion management","6"},
+        {"ecn_kmin",           "Output queue occupancy, in b or B, above which packets start to be ECN marked.  Used with ecn_kmax.","0B"},
+        {"ecn_kmax",           "Output queue occupancy, in b or B, at which every packet is ECN marked.  If zero, no packets are marked.","0B"},
+        {"ecn_pmax",           "Probability of marking a packet when the output queue occupancy reaches ecn_kmax.  Rises linearly from zero at ecn_kmin.","0.01"},
+        {"util_window",        "Length of the windows used for the link utilization time series.  If empty, no time series is collected.",""},
+        {"util_file",          "Base name of the binary link utilization files.  One file named <util_file>.<rank>.bin is written per rank.","link_util"}
     )
 
     // SST_ELI_DOCUMENT_STATISTICS(
@@ -245,6 +253,37 @@ private:
 
     PortInterface::OutputArbitration* output_arb;
 
+    // ECN marking thresholds in flits.  ecn_kmax_flits == 0 means
+    // marking is off.
+    int ecn_kmin_flits;
+    int ecn_kmax_flits;
+    double ecn_pmax;
+    RNG::Random* ecn_rng;
+    Statistic<uint64_t>* ecn_marks;
+
+    // Analytic background traffic.  Reservations made during init by
+    // background_traffic in analytic mode add up to bg_bits_per_sec,
+    // which takes bg_load of the output link.  Each foreground packet
+    // is followed by the background data that arrived while it was
+    // sent, and a packet finding the port idle waits the mean M/D/1
+    // residual of a background packet of bg_packet_bits.  Fractions of
+    // a flit cycle carry over in bg_stolen.
+    double bg_bits_per_sec;
+    double bg_weighted_bits;
+    double bg_load;
+    double bg_packet_flits;
+    double bg_stolen;
+    bool bg_was_idle;
+    Statistic<uint64_t>* background_cycles;
+
+    void updateBackgroundLoad();
+    int backgroundCycles(double cycles);
+
+    // Windowed busy/stall time series for the output link, NULL if
+    // util_window was not set
+    LinkUtilCollector* link_util;
+    SimTime_t util_window_cycles;
+
     // For supporting congestion management
     struct CongestionInfo {
         const int32_t  src;
@@ -22,7 +22,10 @@ from sst.merlin.base import *
 class LinkControl(NetworkInterface):
     def __init__(self):
         NetworkInterface.__init__(self)
-        self._declareParams("params",["link_bw","input_buf_size","output_buf_size","vn_remap"])
+        self._declareParams("params",["link_bw","input_buf_size","output_buf_size","vn_remap",
+                                       "congestion_control","cc_cnp_interval","cc_cnp_size","cc_alpha_g",
+                                       "cc_alpha_period","cc_increase_period","cc_fast_recovery_stages",
+                                       "cc_ai_rate","cc_hai_rate","cc_min_rate"])
         self._subscribeToPlatformParamSet("network_interface")
 
     # returns subcomp, port_name
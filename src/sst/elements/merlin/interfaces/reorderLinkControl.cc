@@ -30,6 +30,26 @@ ReorderLinkControl::ReorderLinkControl(ComponentId_t cid, Params &params, int vn
     receiveFunctor(NULL),
     vns(vns)
 {
+    window = params.find<uint32_t>("reorder_window", 64);
+    if ( window == 0 || (window & (window - 1)) != 0 ) {
+        merlin_abort.fatal(CALL_INFO,1,"Error: reorder_window must be a power of 2\n");
+    }
+
+    unordered_vn.resize(vns, false);
+    notify_vn.resize(vns, false);
+    std::vector<int> unordered;
+    params.find_array<int>("unordered_vns", unordered);
+    for ( int vn : unordered ) {
+        if ( vn < 0 || vn >= vns ) {
+            merlin_abort.fatal(CALL_INFO,1,"Error: unordered_vns entry %d is not a valid virtual network\n", vn);
+        }
+        unordered_vn[vn] = true;
+    }
+
+    reorder_depth = registerStatistic<uint64_t>("reorder_depth");
+    reorder_overflow = registerStatistic<uint64_t>("reorder_overflow");
+    unordered_sent = registerStatistic<uint64_t>("unordered_sent");
+
     if ( isUser() ) {
         // Need to see if the network_if was loaded as a user subcomponent
         link_control = loadUserSubComponent<SimpleNetwork>("networkIF", ComponentInfo::SHARE_NONE, vns);
@@ -68,6 +88,9 @@ ReorderLinkControl::ReorderLinkControl(ComponentId_t cid, Params &params, int vn
 
 ReorderLinkControl::~ReorderLinkControl() {
     delete [] input_buf;
+    for ( auto& entry : reorder_info ) {
+        delete entry.second;
+    }
 }
 
 void
@@ -124,14 +147,15 @@ bool ReorderLinkControl::send(SimpleNetwork::Request* req, int vn) {
     ReorderRequest* my_req = new ReorderRequest(req);
     delete req;
 
-    // Need to put in the sequence number
-
-    // See if we already have reorder_info for this dest
-    if ( reorder_info.find(my_req->dest) == reorder_info.end() ) {
-        ReorderInfo* info = new ReorderInfo();
-        reorder_info[my_req->dest] = info;
+    // Unordered traffic doesn't consume sequence numbers
+    if ( unordered_vn[vn] ) {
+        my_req->ordered = false;
+        unordered_sent->addData(1);
+        return link_control->send(my_req, vn);
     }
-    ReorderInfo* info = reorder_info[my_req->dest];
+
+    // Need to put in the sequence number
+    ReorderInfo* info = getReorderInfo(my_req->dest);
     my_req->seq = info->send++;
 
     // // To test, just going to switch order
@@ -202,46 +226,103 @@ const UnitAlgebra& ReorderLinkControl::getLinkBW() const {
     return link_control->getLinkBW();
 }
 
+ReorderInfo* ReorderLinkControl::getReorderInfo(SimpleNetwork::nid_t peer) {
+    ReorderInfo*& info = reorder_info[peer];
+    if ( info == NULL ) info = new ReorderInfo();
+    return info;
+}
+
+void ReorderLinkControl::hold(ReorderInfo* info, ReorderRequest* req) {
+    // Distance ahead of the next expected packet; always > 0
+    uint32_t ahead = req->seq - info->recv;
+
+    if ( ahead < window ) {
+        if ( info->slots == NULL ) {
+            info->slots = new ReorderRequest*[window];
+            info->valid = new uint64_t[(window + 63) / 64]();
+        }
+        uint32_t slot = req->seq & (window - 1);
+        info->slots[slot] = req;
+        info->valid[slot / 64] |= (uint64_t)1 << (slot % 64);
+    }
+    else {
+        if ( info->overflow == NULL ) {
+            info->overflow = new std::unordered_map<uint32_t, ReorderRequest*>();
+        }
+        (*info->overflow)[req->seq] = req;
+        reorder_overflow->addData(1);
+    }
+
+    info->held++;
+    reorder_depth->addData(info->held);
+}
+
+ReorderRequest* ReorderLinkControl::takeNext(ReorderInfo* info) {
+    if ( info->held == 0 ) return NULL;
+
+    ReorderRequest* req = NULL;
+    uint32_t slot = info->recv & (window - 1);
+    uint64_t bit = (uint64_t)1 << (slot % 64);
+    if ( info->valid != NULL && (info->valid[slot / 64] & bit) ) {
+        info->valid[slot / 64] &= ~bit;
+        req = info->slots[slot];
+    }
+    else if ( info->overflow != NULL ) {
+        auto it = info->overflow->find(info->recv);
+        if ( it == info->overflow->end() ) return NULL;
+        req = it->second;
+        info->overflow->erase(it);
+    }
+    else {
+        return NULL;
+    }
+
+    info->held--;
+    info->recv++;
+    return req;
+}
+
+void ReorderLinkControl::deliver(ReorderRequest* req) {
+    input_buf[req->vn].push(req);
+    notify_vn[req->vn] = true;
+}
+
 bool ReorderLinkControl::handle_event(int vn) {
     ReorderRequest* my_req = static_cast<ReorderRequest*>(link_control->recv(vn));
 
     // std::cout << id << ": recieved packet with sequence number " << my_req->seq << std::endl;
 
-    if ( reorder_info.find(my_req->src) == reorder_info.end() ) {
-        ReorderInfo* info = new ReorderInfo();
-        reorder_info[my_req->src] = info;
+    if ( !my_req->ordered ) {
+        deliver(my_req);
     }
+    else {
+        ReorderInfo* info = getReorderInfo(my_req->src);
 
-    ReorderInfo* info = reorder_info[my_req->src];
+        // See if this is the expected sequence number, if not, hold
+        // it until the packets ahead of it arrive.
+        if ( my_req->seq != info->recv ) {
+            hold(info, my_req);
+            return true;
+        }
 
-    // See if this is the expected sequence number, if not, put it
-    // into the ReorderInfo.queue.
-    if ( my_req->seq == info->recv ) {
-        input_buf[vn].push(my_req);
+        deliver(my_req);
         info->recv++;
         // Need to also see if we have any other fragments which are
-        // now ready to be delivered
-        my_req = info->queue.top();
-        while ( my_req->seq == info->recv ) {
-            input_buf[vn].push(my_req);
-            info->queue.pop();
-            my_req = info->queue.top();
-            info->recv++;
+        // now ready to be delivered.  These may be on other vns.
+        while ( (my_req = takeNext(info)) != NULL ) {
+            deliver(my_req);
         }
+    }
 
-        // If there is a recv functor, need to notify parent
+    // If there is a recv functor, need to notify parent for each vn
+    // that has new packets
+    for ( int i = 0; i < vns; i++ ) {
+        if ( !notify_vn[i] ) continue;
+        notify_vn[i] = false;
         if ( receiveFunctor != NULL ) {
-            bool keep = (*receiveFunctor)(vn);
+            bool keep = (*receiveFunctor)(i);
             if (!keep) receiveFunctor = NULL;
-            // while ( keep && input_buf[vn].size() != 0 ) {
-            //     keep = (*receiveFunctor)(vn);
-            //     if (!keep) receiveFunctor = NULL;
-            // }
         }
-
-    }
-    else {
-        info->queue.push(my_req);
     }
 
     return true;
@@ -28,6 +28,7 @@
 
 #include <queue>
 #include <unordered_map>
+#include <vector>
 
 namespace SST {
 
@@ -40,10 +41,12 @@ class ReorderRequest : public SST::Interfaces::SimpleNetwork::Request {
 
 public:
     uint32_t seq;
+    bool ordered;
 
     ReorderRequest() :
         Request(),
-        seq(0)
+        seq(0),
+        ordered(true)
         {}
 
     // ReorderRequest(SST::Interfaces::SimpleNetwork::nid_t dest, SST::Interfaces::SimpleNetwork::nid_t src,
@@ -55,7 +58,8 @@ public:
 
     ReorderRequest(SST::Interfaces::SimpleNetwork::Request* req, uint32_t seq = 0) :
         Request(req->dest, req->src, req->size_in_bits, req->head, req->tail),
-        seq(seq)
+        seq(seq),
+        ordered(true)
         {
             givePayload(req->takePayload());
             trace = req->getTraceType();
@@ -65,21 +69,10 @@ public:
     ~ReorderRequest() {}
 
 
-    // This is here just for the priority_queue insertion, so is
-    // sorting based on what comes out of queue first (i.e. lowest
-    // number, which makes this look backwards)
-    class Priority {
-    public:
-        bool operator()(ReorderRequest* const& lhs, ReorderRequest* const& rhs) {
-            return lhs->seq > rhs->seq;
-        }
-    };
-
-    typedef std::priority_queue<ReorderRequest*, std::vector<ReorderRequest*>, Priority> PriorityQueue;
-
     void serialize_order(SST::Core::Serialization::serializer &ser)  override {
         SST::Interfaces::SimpleNetwork::Request::serialize_order(ser);
         SST_SER(seq);
+        SST_SER(ordered);
     }
 
 private:
@@ -88,29 +81,40 @@ private:
 
 
 
+// Per peer sequencing state.  Early arrivals within the reorder
+// window go into a slot array indexed by sequence number, with a
+// bitmap marking the occupied slots.  Both are only allocated once a
+// packet from the peer arrives out of order, and anything beyond the
+// window goes into the overflow map.  Sequence numbers are compared
+// by distance from recv, so they may wrap.
 struct ReorderInfo {
     uint32_t send;
     uint32_t recv;
-    ReorderRequest::PriorityQueue queue;
+    uint32_t held;
+    ReorderRequest** slots;
+    uint64_t* valid;
+    std::unordered_map<uint32_t, ReorderRequest*>* overflow;
 
     ReorderInfo() :
         send(0),
-        recv(0)
-    {
-        // Put a dummy entry into queue to avoid checks for NULL later
-        // on when looking for fragments to deliver.  This does mean
-        // we can't handle more than 4 billion fragments to each host
-        // with overflow.
-        ReorderRequest* req = new ReorderRequest();
-        req->seq = 0xffffffff;
-        queue.push(req);
+        recv(0),
+        held(0),
+        slots(NULL),
+        valid(NULL),
+        overflow(NULL)
+    {}
+
+    ~ReorderInfo() {
+        delete [] slots;
+        delete [] valid;
+        delete overflow;
     }
 };
 
 // Version of LinkControl that will allow out of order receive, but
-// will make things appear in order to NIC.  The current version will
-// have essentially infinite resources and is here just to get
-// functionality working.
+// will make things appear in order to NIC.  Packets are sequenced per
+// destination across all ordered vns; vns listed in unordered_vns
+// bypass sequencing entirely.
 class ReorderLinkControl : public SST::Interfaces::SimpleNetwork {
 public:
 
@@ -125,7 +129,9 @@ public:
 
     SST_ELI_DOCUMENT_PARAMS(
         {"rlc.networkIF","SimpleNetwork subcomponent to be used for connecting to network", "merlin.linkcontrol"},
-        {"networkIF","SimpleNetwork subcomponent to be used for connecting to network", "merlin.linkcontrol"}
+        {"networkIF","SimpleNetwork subcomponent to be used for connecting to network", "merlin.linkcontrol"},
+        {"reorder_window","Number of early packets per source held in the fixed reorder buffer. Packets further ahead go to an overflow map. Must be a power of 2.", "64"},
+        {"unordered_vns","Array of virtual networks whose packets are delivered as they arrive, without sequencing. Set on the sender.", "[]"}
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -136,6 +142,12 @@ public:
         {"networkIF", "Network interface", "SST::Interfaces::SimpleNetwork" }
     )
 
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "reorder_depth",   "Packets held for the source when an out of order packet arrives", "packets", 1},
+        { "reorder_overflow", "Out of order packets that arrived beyond the reorder window", "packets", 1},
+        { "unordered_sent",  "Packets sent on unordered virtual networks", "packets", 1}
+    )
+
     typedef std::queue<SST::Interfaces::SimpleNetwork::Request*> request_queue_t;
 
 private:
@@ -148,6 +160,15 @@ private:
 
     std::unordered_map<SST::Interfaces::SimpleNetwork::nid_t, ReorderInfo*> reorder_info;
 
+    uint32_t window;
+    std::vector<bool> unordered_vn;
+    // vns that received packets during the current handle_event
+    std::vector<bool> notify_vn;
+
+    Statistic<uint64_t>* reorder_depth;
+    Statistic<uint64_t>* reorder_overflow;
+    Statistic<uint64_t>* unordered_sent;
+
     // One buffer for each virtual network.  At the NIC level, we just
     // provide a virtual channel abstraction.  Don't need output
     // buffers, sends will go directly to LinkControl.  Do need input
@@ -201,6 +222,11 @@ public:
 private:
 
     bool handle_event(int vn);
+
+    ReorderInfo* getReorderInfo(SST::Interfaces::SimpleNetwork::nid_t peer);
+    void hold(ReorderInfo* info, ReorderRequest* req);
+    ReorderRequest* takeNext(ReorderInfo* info);
+    void deliver(ReorderRequest* req);
 };
 
 }
@@ -37,6 +37,7 @@
   Install the python library
  */
 #include <sst/core/model/element_python.h>
+#include "pybuilder.h"
 
 namespace SST {
 namespace Merlin {
@@ -89,6 +90,10 @@ char pymerlin_topo_polarstar[] = {
 #include "topology/pymerlin-topo-polarstar.inc"
     0x00};
 
+char pymerlin_topo_ocs[] = {
+#include "topology/pymerlin-topo-ocs.inc"
+    0x00};
+
 
 class MerlinPyModule : public SSTElementPythonModule {
 public:
@@ -107,6 +112,14 @@ public:
         primary_module->addSubModule("topology",pymerlin_topo_mesh,"topology/pymerlin-topo-mesh.py");
         primary_module->addSubModule("topology",pymerlin_topo_polarfly,"topology/pymerlin-topo-polarfly.py");
         primary_module->addSubModule("topology",pymerlin_topo_polarstar,"topology/pymerlin-topo-polarstar.py");
+        primary_module->addSubModule("topology",pymerlin_topo_ocs,"topology/pymerlin-topo-ocs.py");
+    }
+
+    void* load() override
+    {
+        void* module = SSTElementPythonModule::load();
+        addMerlinNativeBuilders(module);
+        return module;
     }
 
     SST_ELI_REGISTER_PYTHON_MODULE(
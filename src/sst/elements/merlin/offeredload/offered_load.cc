@@ -18,6 +18,9 @@
 
 #include <sst/core/params.h>
 
+#include <cmath>
+#include <fstream>
+
 using namespace SST::Merlin;
 using namespace SST::Interfaces;
 
@@ -101,6 +104,7 @@ OfferedLoad::OfferedLoad(ComponentId_t cid, Params& params) :
         out.fatal(CALL_INFO, -1, "pattern must be set!\n");
     }
 
+    pattern_name = pattern;
     pattern_params = new Params();
     // packetDestGen = static_cast<TargetGenerator*>(loadSubComponent(pattern, this, params));
     pattern_params->insert(params.get_scoped_params("pattern"));
@@ -128,6 +132,14 @@ OfferedLoad::OfferedLoad(ComponentId_t cid, Params& params) :
     }
     drain_time = (drain_time_ua / UnitAlgebra("1ps")).getRoundedValue();
 
+    csv_file = params.find<std::string>("csv_file","");
+    saturation_threshold = params.find<double>("saturation_threshold",0.95);
+    if ( saturation_threshold <= 0.0 || saturation_threshold > 1.0 ) {
+        out.fatal(CALL_INFO,-1,"saturation_threshold must be in the range (0, 1.0]\n");
+    }
+    saturation_backlog = (SimTime_t)((1.0 - saturation_threshold) * collect_time);
+    stop_at_saturation = params.find<bool>("stop_at_saturation",false);
+
     registerAsPrimaryComponent();
     primaryComponentDoNotEndSim();
     // clock_functor = new Clock::Handler2<TrafficGen,&TrafficGen::clock_handler>(this);
@@ -175,16 +187,79 @@ void OfferedLoad::finish()
 
         // Now, write out a summary table with just the latencies
 
-        out.output("%9s %9s\n","Offered","Average");
-        out.output("%9s %9s\n","Load ","Latency");
+        out.output("%9s %9s %15s %15s %15s\n","Offered","Accepted","Average","p50","p99");
+        out.output("%9s %9s %15s %15s %15s\n","Load ","Load ","Latency","Latency","Latency");
         for ( auto ev : complete_event ) {
+            // Loads reached after some endpoints stopped at
+            // saturation don't have complete results
+            if ( ev->reporters != (uint32_t)num_peers || ev->count == 0 ) continue;
+            double offered = offered_load[ev->generation];
+            double accepted = accepted_load(ev);
             UnitAlgebra average = UnitAlgebra("1ps") * ev->sum / ev->count;
-            out.output("%9.2f %15s",offered_load[ev->generation],average.toStringBestSI().c_str());
-            if ( ev->backup > 0 ) out.output("*\n");
+            UnitAlgebra p50 = UnitAlgebra("1ps") * percentile(ev->histogram, ev->count, 0.50);
+            UnitAlgebra p99 = UnitAlgebra("1ps") * percentile(ev->histogram, ev->count, 0.99);
+            out.output("%9.2f %9.2f %15s %15s %15s",offered,accepted,average.toStringBestSI().c_str(),
+                       p50.toStringBestSI().c_str(),p99.toStringBestSI().c_str());
+            if ( saturated(ev) ) out.output("*\n");
             else out.output("\n");
         }
         out.output("\n");
 
+        if ( !csv_file.empty() ) write_csv();
+    }
+}
+
+SimTime_t
+OfferedLoad::percentile(const std::vector<uint64_t>& histogram, uint64_t count, double fraction)
+{
+    uint64_t target = (uint64_t)std::ceil(fraction * count);
+    if ( target == 0 ) target = 1;
+    uint64_t seen = 0;
+    for ( size_t i = 0; i < histogram.size(); ++i ) {
+        seen += histogram[i];
+        if ( seen >= target ) return binValue(i);
+    }
+    return histogram.empty() ? 0 : binValue(histogram.size() - 1);
+}
+
+double
+OfferedLoad::accepted_load(offered_load_complete_event* ev)
+{
+    // Fraction of link bandwidth delivered per endpoint during the
+    // collection window
+    return ((double)ev->count * serialization_time.getDoubleValue()) / ((double)collect_time * num_peers);
+}
+
+bool
+OfferedLoad::saturated(offered_load_complete_event* ev)
+{
+    if ( accepted_load(ev) < saturation_threshold * offered_load[ev->generation] ) return true;
+    if ( ev->backup / ev->reporters > saturation_backlog ) return true;
+    return false;
+}
+
+void
+OfferedLoad::write_csv()
+{
+    std::ofstream csv(csv_file, std::ios::out | std::ios::app);
+    if ( !csv.is_open() ) {
+        out.fatal(CALL_INFO,-1,"Unable to open csv_file %s\n",csv_file.c_str());
+    }
+
+    csv.seekp(0, std::ios::end);
+    if ( csv.tellp() == 0 ) {
+        csv << "pattern,offered_load,accepted_load,avg_latency_ns,p50_latency_ns,p99_latency_ns,saturated\n";
+    }
+
+    for ( auto ev : complete_event ) {
+        if ( ev->reporters != (uint32_t)num_peers || ev->count == 0 ) continue;
+        csv << pattern_name << ","
+            << offered_load[ev->generation] << ","
+            << accepted_load(ev) << ","
+            << ((double)ev->sum / ev->count) / 1000.0 << ","
+            << percentile(ev->histogram, ev->count, 0.50) / 1000.0 << ","
+            << percentile(ev->histogram, ev->count, 0.99) / 1000.0 << ","
+            << (saturated(ev) ? 1 : 0) << "\n";
     }
 }
 
@@ -224,12 +299,22 @@ OfferedLoad::complete(unsigned int phase) {
         while ( req != NULL ) {
             offered_load_complete_event* ev = static_cast<offered_load_complete_event*>(req->takePayload());
             int generation = ev->generation;
+            // Other endpoints may have gotten further through the
+            // sweep if we stopped at saturation
+            while ( (int)complete_event.size() <= generation ) {
+                complete_event.push_back(new offered_load_complete_event(complete_event.size()));
+                complete_event.back()->reporters = 0;
+            }
             complete_event[generation]->sum += ev->sum;
             complete_event[generation]->sum_of_squares += ev->sum_of_squares;
             complete_event[generation]->min = ev->min < complete_event[generation]->min ? ev->min : complete_event[generation]->min;
             complete_event[generation]->max = ev->max > complete_event[generation]->max ? ev->max : complete_event[generation]->max;
             complete_event[generation]->count += ev->count;
             complete_event[generation]->backup += ev->backup;
+            complete_event[generation]->reporters += ev->reporters;
+            std::vector<uint64_t>& hist = complete_event[generation]->histogram;
+            if ( hist.size() < ev->histogram.size() ) hist.resize(ev->histogram.size(), 0);
+            for ( size_t i = 0; i < ev->histogram.size(); ++i ) hist[i] += ev->histogram[i];
 
             req = link_if->recvUntimedData();
         }
@@ -254,8 +339,9 @@ OfferedLoad::handle_receives(int vn)
     if ( req != NULL ) {
         SimTime_t current_time = getCurrentSimTime(base_tc);
         // Don't start counting until after warmup.  This is stored in
-        // start_time.
-        if ( start_time <= current_time ) {
+        // start_time.  Stop counting at the end of the collection
+        // window so accepted load can be computed from the count.
+        if ( start_time <= current_time && current_time <= end_time ) {
 
             // Get the latency and add it to the complete_event)
             SimTime_t latency = current_time - ((offered_load_event*)req->inspectPayload())->start_time;
@@ -265,6 +351,11 @@ OfferedLoad::handle_receives(int vn)
             complete_event[generation]->min = latency < complete_event[generation]->min ? latency : complete_event[generation]->min;
             complete_event[generation]->max = latency > complete_event[generation]->max ? latency : complete_event[generation]->max;
             complete_event[generation]->count++;
+
+            std::vector<uint64_t>& hist = complete_event[generation]->histogram;
+            size_t bin = latencyBin(latency);
+            if ( hist.size() <= bin ) hist.resize(bin + 1, 0);
+            hist[bin]++;
         }
         delete req;
     }
@@ -352,6 +443,12 @@ OfferedLoad::end_handler(Event* ev) {
     if ( complete_event.size() == offered_load.size() ) {
         primaryComponentOKToEndSim();
     }
+    else if ( stop_at_saturation && complete_event[generation]->backup > saturation_backlog ) {
+        // Higher loads will only saturate further.  Keep injecting at
+        // this load, as we do after the last load, so the endpoints
+        // still measuring see the same background traffic.
+        primaryComponentOKToEndSim();
+    }
     else {
 
         // Need to set things up for the next iteration
@@ -374,6 +471,7 @@ OfferedLoad::end_handler(Event* ev) {
         // Compute the new start_time for recording values (after the
         // warm up period)
         start_time = next_time + warmup_time;
+        end_time = start_time + collect_time;
 
         // Need to send the next event to end this round.  The total
         // time to the next ending is drain_time + warmup_time +
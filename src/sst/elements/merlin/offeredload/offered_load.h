@@ -36,6 +36,9 @@
 
 #include "sst/elements/merlin/target_generator/target_generator.h"
 
+#include <string>
+#include <vector>
+
 namespace SST {
 namespace Merlin {
 
@@ -72,6 +75,10 @@ public:
     SimTime_t max;
     uint64_t  count;
     SimTime_t backup;
+    // Latency histogram, binned by OfferedLoad::latencyBin()
+    std::vector<uint64_t> histogram;
+    // Number of endpoints whose results are included
+    uint32_t reporters;
 
     offered_load_complete_event(int generation) :
         Event(),
@@ -80,7 +87,9 @@ public:
         sum_of_squares(0),
         min(MAX_SIMTIME_T),
         max(0),
-        count(0)
+        count(0),
+        backup(0),
+        reporters(1)
         {}
 
     virtual ~offered_load_complete_event() {  }
@@ -100,6 +109,8 @@ public:
         SST_SER(max);
         SST_SER(count);
         SST_SER(backup);
+        SST_SER(histogram);
+        SST_SER(reporters);
     }
 
 private:
@@ -135,6 +146,9 @@ public:
         {"warmup_time",      "Time to wait before recording latencies","1us"},
         {"collect_time",     "Time to collect data after warmup","20us"},
         {"drain_time",       "Time to drain network before stating next round","50us"},
+        {"csv_file",         "If set, endpoint 0 appends a row per offered load to this file with the pattern, offered and accepted load, average/p50/p99 latency and whether the load saturated the network.  A header is written if the file is empty.",""},
+        {"saturation_threshold", "An offered load is marked saturated if the accepted load is below this fraction of it, or if endpoints fell behind their injection schedule by more than (1 - saturation_threshold) of collect_time.","0.95"},
+        {"stop_at_saturation", "Stop stepping through offered_load once an endpoint falls behind its injection schedule by more than (1 - saturation_threshold) of collect_time.  Loads should be listed in increasing order.","false"},
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -168,6 +182,12 @@ private:
 
     int generation;
 
+    std::string pattern_name;
+    std::string csv_file;
+    double saturation_threshold;
+    SimTime_t saturation_backlog;
+    bool stop_at_saturation;
+
     TimeConverter base_tc;
 
     SST::Interfaces::SimpleNetwork* link_if;
@@ -212,6 +232,28 @@ private:
 
     void end_handler(Event* ev);
 
+    double accepted_load(offered_load_complete_event* ev);
+    bool saturated(offered_load_complete_event* ev);
+    void write_csv();
+
+public:
+    // Latencies are binned with 16 linear sub-bins per power of two, so
+    // percentiles are accurate to within ~3% at any scale.
+    static inline int latencyBin(SimTime_t latency) {
+        if ( latency < 16 ) return latency;
+        int exp = 63 - __builtin_clzll(latency);
+        return 16 * (exp - 3) + ((latency >> (exp - 4)) & 15);
+    }
+
+    // Midpoint of the latencies that fall into bin
+    static inline SimTime_t binValue(int bin) {
+        if ( bin < 16 ) return bin;
+        int exp = bin / 16 + 3;
+        SimTime_t width = SimTime_t(1) << (exp - 4);
+        return (16 + bin % 16) * width + width / 2;
+    }
+
+    static SimTime_t percentile(const std::vector<uint64_t>& histogram, uint64_t count, double fraction);
 };
 
 } //namespace Merlin
@@ -0,0 +1,210 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <Python.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sst/core/warnmacros.h>
+
+#include "pybuilder.h"
+
+namespace SST {
+namespace Merlin {
+
+namespace {
+
+// Creates and caches sst.Link objects by name, like getLink() in the python builders
+class LinkCache {
+public:
+    LinkCache(PyObject* link_class, bool no_cut) : link_class(link_class), no_cut(no_cut) {}
+    ~LinkCache() {
+        for ( auto& l : links ) Py_DECREF(l.second);
+    }
+
+    // Borrowed reference, nullptr with a python error set on failure
+    PyObject* get(const char* name) {
+        auto it = links.find(name);
+        if ( it != links.end() ) return it->second;
+
+        PyObject* link = PyObject_CallFunction(link_class, "s", name);
+        if ( link == nullptr ) return nullptr;
+        if ( no_cut ) {
+            PyObject* ret = PyObject_CallMethod(link, "setNoCut", nullptr);
+            if ( ret == nullptr ) {
+                Py_DECREF(link);
+                return nullptr;
+            }
+            Py_DECREF(ret);
+        }
+        links[name] = link;
+        return link;
+    }
+
+private:
+    PyObject* link_class;
+    bool no_cut;
+    std::unordered_map<std::string, PyObject*> links;
+};
+
+bool addLink(PyObject* rtr, PyObject* link, int port, const char* latency)
+{
+    char port_name[32];
+    snprintf(port_name, sizeof(port_name), "port%d", port);
+    PyObject* ret = PyObject_CallMethod(rtr, "addLink", "Oss", link, port_name, latency);
+    if ( ret == nullptr ) return false;
+    Py_DECREF(ret);
+    return true;
+}
+
+/*
+  _wire_dragonfly(routers, hosts_per_router, routers_per_group, num_groups,
+                  intragroup_links, intergroup_per_router, global_link_map,
+                  relative, link_latency, global_link_latency, bundle_local_links)
+
+  Connects the intragroup and global ports of already instanced dragonfly
+  routers (ordered by router id). Link names and port numbers match
+  topoDragonFly._build_impl; host ports are left to the python side, which
+  builds the endpoints.
+*/
+PyObject* wireDragonfly(PyObject* UNUSED(self), PyObject* args)
+{
+    PyObject* routers;
+    int hpr, rpg, num_groups, intragroup, igpr;
+    PyObject* map_obj;
+    int relative, bundle;
+    const char* link_latency;
+    const char* global_latency;
+
+    if ( !PyArg_ParseTuple(args, "OiiiiiOpssp", &routers, &hpr, &rpg, &num_groups, &intragroup, &igpr,
+                           &map_obj, &relative, &link_latency, &global_latency, &bundle) ) {
+        return nullptr;
+    }
+
+    PyObject* rtr_seq = PySequence_Fast(routers, "routers must be a sequence");
+    if ( rtr_seq == nullptr ) return nullptr;
+    PyObject* map_seq = PySequence_Fast(map_obj, "global_link_map must be a sequence");
+    if ( map_seq == nullptr ) {
+        Py_DECREF(rtr_seq);
+        return nullptr;
+    }
+
+    PyObject* result = nullptr;
+    PyObject* sst_module = nullptr;
+    PyObject* link_class = nullptr;
+    std::vector<long> global_link_map;
+    int ng = num_groups - 1;  // Don't count my group
+
+    if ( PySequence_Fast_GET_SIZE(rtr_seq) != (Py_ssize_t)num_groups * rpg ) {
+        PyErr_SetString(PyExc_ValueError, "_wire_dragonfly: expected one router per group and position");
+        goto done;
+    }
+    if ( PySequence_Fast_GET_SIZE(map_seq) < (Py_ssize_t)igpr * rpg ) {
+        PyErr_SetString(PyExc_ValueError, "_wire_dragonfly: global_link_map is shorter than intergroup_per_router * routers_per_group");
+        goto done;
+    }
+    for ( Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(map_seq); i++ ) {
+        global_link_map.push_back(PyLong_AsLong(PySequence_Fast_GET_ITEM(map_seq, i)));
+    }
+    if ( PyErr_Occurred() ) goto done;
+
+    sst_module = PyImport_ImportModule("sst");
+    if ( sst_module == nullptr ) goto done;
+    link_class = PyObject_GetAttrString(sst_module, "Link");
+    if ( link_class == nullptr ) goto done;
+
+    {
+        // Global links are cut by design, only local ones are bundled
+        LinkCache local_links(link_class, bundle);
+        LinkCache global_links(link_class, false);
+        char name[96];
+
+        for ( int g = 0; g < num_groups; g++ ) {
+            for ( int r = 0; r < rpg; r++ ) {
+                PyObject* rtr = PySequence_Fast_GET_ITEM(rtr_seq, g * rpg + r);
+                int port = hpr;
+
+                for ( int p = 0; p < rpg; p++ ) {
+                    if ( p == r ) continue;
+                    int src = std::min(p, r);
+                    int dst = std::max(p, r);
+                    for ( int s = 0; s < intragroup; s++ ) {
+                        snprintf(name, sizeof(name), "link_g%dr%dr%ds%d", g, src, dst, s);
+                        PyObject* link = local_links.get(name);
+                        if ( link == nullptr || !addLink(rtr, link, port, link_latency) ) goto done;
+                        port++;
+                    }
+                }
+
+                for ( int p = 0; p < igpr; p++, port++ ) {
+                    long raw_dest = global_link_map[r * igpr + p];
+                    if ( raw_dest == -1 ) continue;
+
+                    // Same mapping as getGlobalLink() in the python builder
+                    long link_num = raw_dest / ng;
+                    long dest_grp = raw_dest - link_num * ng;
+                    if ( relative ) {
+                        dest_grp = (dest_grp + g + 1) % (ng + 1);
+                    }
+                    else if ( dest_grp >= g ) {
+                        dest_grp = dest_grp + 1;
+                    }
+                    snprintf(name, sizeof(name), "global_link_g%ldg%ldr%ld",
+                             std::min<long>(dest_grp, g), std::max<long>(dest_grp, g), link_num);
+                    PyObject* link = global_links.get(name);
+                    if ( link == nullptr || !addLink(rtr, link, port, global_latency) ) goto done;
+                }
+            }
+        }
+    }
+
+    Py_INCREF(Py_None);
+    result = Py_None;
+
+done:
+    Py_XDECREF(link_class);
+    Py_XDECREF(sst_module);
+    Py_DECREF(map_seq);
+    Py_DECREF(rtr_seq);
+    return result;
+}
+
+PyMethodDef native_builders[] = {
+    { "_wire_dragonfly", wireDragonfly, METH_VARARGS, "Wire the intragroup and global links of dragonfly routers" },
+    { nullptr, nullptr, 0, nullptr }
+};
+
+}
+
+void addMerlinNativeBuilders(void* module)
+{
+    PyObject* mod = static_cast<PyObject*>(module);
+    if ( mod == nullptr ) return;
+    for ( PyMethodDef* def = native_builders; def->ml_name != nullptr; def++ ) {
+        PyObject* func = PyCFunction_New(def, nullptr);
+        if ( func == nullptr || PyModule_AddObject(mod, def->ml_name, func) < 0 ) {
+            Py_XDECREF(func);
+            PyErr_Print();
+        }
+    }
+}
+
+}
+}
@@ -0,0 +1,31 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_PYBUILDER_H
+#define COMPONENTS_MERLIN_PYBUILDER_H
+
+namespace SST {
+namespace Merlin {
+
+// Add the native topology builders to the sst.merlin python module
+// (a PyObject*). Topologies that set 'native_build' call these to wire
+// their router fabric in bulk instead of link by link in python.
+void addMerlinNativeBuilders(void* module);
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_PYBUILDER_H
@@ -45,7 +45,8 @@ class TestJob(Job):
 class OfferedLoadJob(Job):
     def __init__(self,job_id,size):
         Job.__init__(self,job_id,size)
-        self._declareParams("main",["offered_load","num_peers","message_size","link_bw","warmup_time","collect_time","drain_time"])
+        self._declareParams("main",["offered_load","num_peers","message_size","link_bw","warmup_time","collect_time","drain_time",
+                                    "csv_file","saturation_threshold","stop_at_saturation"])
         self._declareClassVariables(["pattern"])
         self.num_peers = size
         self._lockVariable("num_peers")
@@ -90,3 +91,30 @@ class IncastJob(Job):
         #  Add the linkcontrol
         networkif, port_name = self.network_interface.build(nic,"networkIF",0,self.job_id,self.size,id,True)
         return (networkif, port_name)
+
+
+class BackgroundTrafficJob(Job):
+    def __init__(self,job_id,size):
+        Job.__init__(self,job_id,size)
+        self._declareParams("main",["offered_load","num_peers","message_size","mode","analytic_samples"])
+        self._declareClassVariables(["pattern"])
+        self.num_peers = size
+        self._lockVariable("num_peers")
+
+    def getName(self):
+        return "Background Traffic Job"
+
+    def build(self, nID, extraKeys):
+        nic = sst.Component("background_traffic_%d"%nID, "merlin.background_traffic")
+        self._applyStatisticsSettings(nic)
+        nic.addParams(self._getGroupParams("main"))
+        nic.addParams(extraKeys)
+
+        # Add pattern generator
+        self.pattern.addAsAnonymous(nic, "pattern", "pattern.")
+
+        #  Add the linkcontrol
+        id = self._nid_map[nID]
+        networkif, port_name = self.network_interface.build(nic,"networkIF",0,self.job_id,self.size,id,True)
+
+        return (networkif, port_name)
@@ -1091,7 +1091,7 @@ class OfferedLoadEndPoint(EndPoint):
         #self.enableAllStats = False;
         #self.statInterval = "0"
         self.epKeys.extend(["offered_load", "num_peers", "link_bw", "message_size", "buffer_size", "pattern"])
-        self.epOptKeys.extend(["linkcontrol"])
+        self.epOptKeys.extend(["linkcontrol", "warmup_time", "collect_time", "drain_time", "csv_file", "saturation_threshold", "stop_at_saturation"])
 
     def getName(self):
         return "Offered Load End Point"
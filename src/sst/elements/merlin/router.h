@@ -28,6 +28,7 @@
 #include <sst/core/interfaces/simpleNetwork.h>
 
 #include <queue>
+#include <vector>
 
 namespace SST {
 namespace Merlin {
@@ -40,8 +41,47 @@ const int UNTIMED_BROADCAST_ADDR = -1;
 
 class TopologyEvent;
 class CtrlRtrEvent;
+class RtrEvent;
 class internal_router_event;
 
+// In-network collectives.  A packet whose destination is a collective
+// address is handled by the routers instead of being routed to an
+// endpoint.  Each member of a group first sends a JOIN to the group's
+// root endpoint.  Every router on the way records the port the JOIN
+// came in on as a child, and only forwards the first JOIN it sees, so
+// the routes to the root form a spanning tree of the members.  After
+// that:
+//
+//   MCAST     - replicated along the tree to every member but the sender
+//   REDUCE    - combined at each router once every child has
+//               contributed; the root gets one packet
+//   ALLREDUCE - reduced like REDUCE, then multicast back to every member
+//
+// Only timing is modeled: a reduced packet carries the payload of one
+// of its contributions.  Members must not start an operation on a
+// group until all of its JOINs have been delivered, and the routes
+// to the root must be deterministic for the JOINs to agree on a tree.
+namespace Collective {
+
+enum Op { JOIN = 1, MCAST = 2, REDUCE = 3, ALLREDUCE = 4 };
+
+// Address layout: bit 62 set, op in bits 56-59, group in bits 32-55,
+// and for JOIN the root endpoint in bits 0-31
+const SST::Interfaces::SimpleNetwork::nid_t ADDR_FLAG = (SST::Interfaces::SimpleNetwork::nid_t)1 << 62;
+
+inline SST::Interfaces::SimpleNetwork::nid_t makeAddress(Op op, uint32_t group, uint32_t root = 0) {
+    return ADDR_FLAG | ((SST::Interfaces::SimpleNetwork::nid_t)op << 56) |
+        ((SST::Interfaces::SimpleNetwork::nid_t)(group & 0xffffff) << 32) | root;
+}
+inline bool isCollective(SST::Interfaces::SimpleNetwork::nid_t addr) {
+    return addr > 0 && (addr & ADDR_FLAG);
+}
+inline Op getOp(SST::Interfaces::SimpleNetwork::nid_t addr) { return (Op)((addr >> 56) & 0xf); }
+inline uint32_t getGroup(SST::Interfaces::SimpleNetwork::nid_t addr) { return (addr >> 32) & 0xffffff; }
+inline uint32_t getRoot(SST::Interfaces::SimpleNetwork::nid_t addr) { return addr & 0xffffffff; }
+
+}
+
 class Router : public Component {
 private:
     bool requestNotifyOnEvent;
@@ -52,12 +92,27 @@ protected:
 
     int vcs_with_data;
 
+    // Set by routers that implement in-network collectives
+    bool collectives_enabled;
+
+    // Number of input VCs with data for each port, and a bitmap of
+    // the ports where that count is non-zero.  Only maintained once
+    // initActivePorts() has been called.
+    std::vector<int> port_vcs_with_data;
+    std::vector<uint64_t> active_ports;
+
+    inline void initActivePorts(int num_ports) {
+        port_vcs_with_data.assign(num_ports, 0);
+        active_ports.assign((num_ports + 63) / 64, 0);
+    }
+
 public:
 
     Router(ComponentId_t id) :
         Component(id),
         requestNotifyOnEvent(false),
-        vcs_with_data(0)
+        vcs_with_data(0),
+        collectives_enabled(false)
     {}
 
     virtual ~Router() {}
@@ -66,16 +121,34 @@ public:
 
     virtual void notifyEvent() {}
 
-    inline void inc_vcs_with_data() { vcs_with_data++; }
-    inline void dec_vcs_with_data() { vcs_with_data--; }
+    inline void inc_vcs_with_data(int port = -1) {
+        vcs_with_data++;
+        if ( port < 0 || port_vcs_with_data.empty() ) return;
+        if ( port_vcs_with_data[port]++ == 0 ) active_ports[port >> 6] |= (uint64_t)1 << (port & 63);
+    }
+    inline void dec_vcs_with_data(int port = -1) {
+        vcs_with_data--;
+        if ( port < 0 || port_vcs_with_data.empty() ) return;
+        if ( --port_vcs_with_data[port] == 0 ) active_ports[port >> 6] &= ~((uint64_t)1 << (port & 63));
+    }
     inline int get_vcs_with_data() { return vcs_with_data; }
 
+    // Bitmap of ports with data in at least one input VC, bit
+    // (port % 64) of word (port / 64).  Empty if not maintained.
+    inline const std::vector<uint64_t>& getActivePorts() const { return active_ports; }
+
     virtual int const* getOutputBufferCredits() = 0;
     virtual void sendCtrlEvent(CtrlRtrEvent* ev, int port = -1) = 0;
     virtual void recvCtrlEvent(int port, CtrlRtrEvent* ev) = 0;
 
     virtual void reportIncomingEvent(internal_router_event* ev) = 0;
 
+    // When collectives are enabled, ports hand packets addressed to a
+    // collective group to the router instead of buffering them.  The
+    // router takes ownership of the event.
+    inline bool collectivesEnabled() const { return collectives_enabled; }
+    virtual void recvCollective(int port, RtrEvent* ev);
+
 };
 
 #define MERLIN_ENABLE_TRACE
@@ -114,9 +187,17 @@ class RtrEvent : public BaseRtrEvent {
 
 public:
 
+    // Explicit congestion notification.  CE is set by routers whose
+    // output queue is over the marking threshold.  CNP marks the
+    // notification an endpoint sends back to the source of a CE
+    // marked packet; it is consumed by the LinkControl and never
+    // delivered to the endpoint.
+    enum ECNFlags { ECN_CE = 1, ECN_CNP = 2 };
+
     RtrEvent() :
         BaseRtrEvent(BaseRtrEvent::PACKET),
-        injectionTime(0)
+        injectionTime(0),
+        ecn(0)
     {}
 
     RtrEvent(SST::Interfaces::SimpleNetwork::Request* req, SST::Interfaces::SimpleNetwork::nid_t trusted_src, int route_vn) :
@@ -124,7 +205,8 @@ public:
         request(req),
         trusted_src(trusted_src),
         route_vn(route_vn),
-        injectionTime(0)
+        injectionTime(0),
+        ecn(0)
     {}
 
 
@@ -156,6 +238,12 @@ public:
     inline SST::Interfaces::SimpleNetwork::nid_t getLogicalSrc() { return request->src; }
     inline int getRouteVN() { return route_vn; }
     inline int getLogicalVN() { return request->vn; }
+
+    inline void markCongestion() { ecn |= ECN_CE; }
+    inline bool isCongestionMarked() const { return ecn & ECN_CE; }
+    inline void setCNP() { ecn |= ECN_CNP; }
+    inline bool isCNP() const { return ecn & ECN_CNP; }
+
     SST::Interfaces::SimpleNetwork::Request* takeRequest() {
         auto ret = request;
         request = nullptr;
@@ -175,6 +263,7 @@ public:
         SST_SER(route_vn);
         SST_SER(size_in_flits);
         SST_SER(injectionTime);
+        SST_SER(ecn);
     }
 
 private:
@@ -184,11 +273,14 @@ private:
     int route_vn;
     SimTime_t injectionTime;
     int size_in_flits;
+    uint8_t ecn;
 
     ImplementSerializable(SST::Merlin::RtrEvent)
 
 };
 
+inline void Router::recvCollective(int port, RtrEvent* ev) { delete ev; }
+
 
 class CtrlRtrEvent : public BaseRtrEvent {
 
@@ -407,6 +499,35 @@ private:
     ImplementSerializable(SST::Merlin::RtrInitEvent)
 };
 
+// Payload of the untimed requests an analytic background_traffic
+// endpoint sends during init.  Every router output port the request is
+// routed through reserves bits_per_sec of its link bandwidth for
+// background packets of packet_bits.
+class BackgroundReservationEvent : public Event {
+public:
+    double bits_per_sec;
+    int packet_bits;
+
+    BackgroundReservationEvent() :
+        Event()
+    {}
+
+    BackgroundReservationEvent(double bits_per_sec, int packet_bits) :
+        Event(),
+        bits_per_sec(bits_per_sec),
+        packet_bits(packet_bits)
+    {}
+
+    void serialize_order(SST::Core::Serialization::serializer &ser)  override {
+        Event::serialize_order(ser);
+        SST_SER(bits_per_sec);
+        SST_SER(packet_bits);
+    }
+
+private:
+    ImplementSerializable(SST::Merlin::BackgroundReservationEvent)
+};
+
 class internal_router_event : public BaseRtrEvent {
     int next_port;
     int next_vc;
@@ -559,6 +680,52 @@ protected:
 };
 
 
+// FIFO backed by a circular buffer, used for the port buffers in place
+// of std::queue.  Storage is allocated up front with reserve() (the
+// port buffers are sized from their flit capacity, which bounds the
+// number of events they can hold) and only grows if that turns out to
+// be too small.
+template <typename T>
+class ring_queue {
+public:
+    ring_queue() : head(0), count(0) {}
+
+    void reserve(size_t n) { if ( n > buf.size() ) grow(n); }
+
+    inline bool empty() const { return count == 0; }
+    inline size_t size() const { return count; }
+
+    inline T& front() { return buf[head]; }
+    inline const T& front() const { return buf[head]; }
+
+    inline void push(const T& val) {
+        if ( count == buf.size() ) grow(count + 1);
+        buf[(head + count) & (buf.size() - 1)] = val;
+        count++;
+    }
+
+    inline void pop() {
+        head = (head + 1) & (buf.size() - 1);
+        count--;
+    }
+
+private:
+    std::vector<T> buf;  // size is always zero or a power of two
+    size_t head;
+    size_t count;
+
+    void grow(size_t n) {
+        size_t cap = buf.empty() ? 1 : buf.size();
+        while ( cap < n ) cap <<= 1;
+        std::vector<T> new_buf(cap);
+        for ( size_t i = 0; i < count; i++ ) {
+            new_buf[i] = buf[(head + i) & (buf.size() - 1)];
+        }
+        buf.swap(new_buf);
+        head = 0;
+    }
+};
+
 // Class to manage link between NIC and router.  A single NIC can have
 // more than one link_control (and thus link to router).
 class PortInterface : public SubComponent{
@@ -568,7 +735,7 @@ public:
     // params are: parent router, router id, port number, topology object
     SST_ELI_REGISTER_SUBCOMPONENT_API(SST::Merlin::PortInterface, Router*, int, int, Topology*)
 
-    typedef std::queue<internal_router_event*> port_queue_t;
+    typedef ring_queue<internal_router_event*> port_queue_t;
     typedef std::queue<CtrlRtrEvent*> ctrl_queue_t;
 
     virtual void recvCtrlEvent(CtrlRtrEvent* ev) = 0;
@@ -652,6 +819,17 @@ public:
     virtual void reportSkippedCycles(Cycle_t cycles) {};
     virtual void dumpState(std::ostream& stream) {};
 
+    // Optional bitmap of ports that have data in their input VCs (see
+    // Router::getActivePorts()).  When set, arbitration units can skip
+    // ports that have nothing to send.
+    void setActivePorts(const uint64_t* mask) { active_ports = mask; }
+
+protected:
+    const uint64_t* active_ports = nullptr;
+
+    inline bool isPortActive(int port) const {
+        return active_ports == nullptr || ((active_ports[port >> 6] >> (port & 63)) & 1);
+    }
 };
 
 }
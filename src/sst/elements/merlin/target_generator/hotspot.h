@@ -0,0 +1,102 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TARGET_GENERATOR_HOTSPOT_H
+#define COMPONENTS_MERLIN_TARGET_GENERATOR_HOTSPOT_H
+
+#include <sst/elements/merlin/target_generator/target_generator.h>
+
+#include <sst/core/rng/mersenne.h>
+
+namespace SST {
+namespace Merlin {
+
+
+class HotspotDist : public TargetGenerator {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        HotspotDist,
+        "merlin",
+        "targetgen.hotspot",
+        SST_ELI_ELEMENT_VERSION(0,0,1),
+        "Generates uniform random targets, except that a fraction of the traffic is sent to a set of hotspot endpoints.",
+        SST::Merlin::TargetGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"hotspots",   "Array of hotspot endpoint IDs","[0]"},
+        {"fraction",   "Fraction of traffic sent to the hotspots, spread evenly over them","0.1"}
+    )
+
+    SST::RNG::MersenneRNG* gen;
+
+    std::vector<int> hotspots;
+    double fraction;
+    int peers;
+
+public:
+
+    HotspotDist(ComponentId_t cid, Params &params, int id, int num_peers) :
+        TargetGenerator(cid),
+        peers(num_peers)
+    {
+        params.find_array<int>("hotspots", hotspots);
+        if ( hotspots.empty() ) hotspots.push_back(0);
+        for ( int spot : hotspots ) {
+            if ( spot < 0 || spot >= num_peers ) {
+                fatal(CALL_INFO,1,"ERROR: hotspot %d in targetgen.hotspot is not a valid endpoint\n", spot);
+            }
+        }
+
+        fraction = params.find<double>("fraction",0.1);
+        if ( fraction < 0.0 || fraction > 1.0 ) {
+            fatal(CALL_INFO,1,"ERROR: fraction in targetgen.hotspot must be between 0 and 1\n");
+        }
+
+        gen = new SST::RNG::MersenneRNG(id);
+    }
+
+    ~HotspotDist() {
+        delete gen;
+    }
+
+    void initialize(int id, int num_peers) {
+        delete gen;
+        gen = new SST::RNG::MersenneRNG(id);
+        peers = num_peers;
+    }
+
+    int getNextValue(void) {
+        if ( gen->nextUniform() < fraction ) {
+            return hotspots[gen->generateNextUInt32() % hotspots.size()];
+        }
+        return gen->generateNextUInt32() % peers;
+    }
+
+    void seed(uint32_t val) {
+        delete gen;
+        gen = new SST::RNG::MersenneRNG((unsigned int) val);
+    }
+};
+
+} //namespace Merlin
+} //namespace SST
+
+#endif
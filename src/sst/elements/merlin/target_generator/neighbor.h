@@ -0,0 +1,107 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TARGET_GENERATOR_NEIGHBOR_H
+#define COMPONENTS_MERLIN_TARGET_GENERATOR_NEIGHBOR_H
+
+#include <sst/elements/merlin/target_generator/target_generator.h>
+
+namespace SST {
+namespace Merlin {
+
+
+class NeighborDist : public TargetGenerator {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        NeighborDist,
+        "merlin",
+        "targetgen.neighbor",
+        SST_ELI_ELEMENT_VERSION(0,0,1),
+        "Generates a nearest neighbor pattern.  Each call returns the next of the endpoint's neighbors (-1 and +1 in every dimension of shape) in turn.",
+        SST::Merlin::TargetGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"shape",      "Shape of the endpoint array (e.g. 4x4x4).  Defaults to a single dimension of num_peers.",""},
+        {"periodic",   "Whether neighbors wrap around at the edges of the array","true"}
+    )
+
+    std::string shape;
+    bool periodic;
+    std::vector<int> neighbors;
+    size_t next;
+
+public:
+
+    NeighborDist(ComponentId_t cid, Params &params, int id, int num_peers) :
+        TargetGenerator(cid)
+    {
+        shape = params.find<std::string>("shape","");
+        periodic = params.find<bool>("periodic",true);
+        initialize(id, num_peers);
+    }
+
+    ~NeighborDist() {
+    }
+
+    void initialize(int id, int num_peers) {
+        std::vector<int> dims;
+        if ( !parseShape(shape, num_peers, dims) ) {
+            fatal(CALL_INFO,1,"ERROR: shape %s in targetgen.neighbor does not have %d endpoints\n", shape.c_str(), num_peers);
+        }
+
+        neighbors.clear();
+        next = 0;
+        int stride = 1;
+        for ( int size : dims ) {
+            int coord = (id / stride) % size;
+            if ( size == 2 ) {
+                // Both directions reach the same endpoint
+                neighbors.push_back(id + (1 - 2 * coord) * stride);
+            }
+            else if ( size > 2 ) {
+                if ( periodic || coord > 0 ) {
+                    neighbors.push_back(id + (((coord + size - 1) % size) - coord) * stride);
+                }
+                if ( periodic || coord < size - 1 ) {
+                    neighbors.push_back(id + (((coord + 1) % size) - coord) * stride);
+                }
+            }
+            stride *= size;
+        }
+        // A single endpoint has no neighbors but itself
+        if ( neighbors.empty() ) neighbors.push_back(id);
+    }
+
+    int getNextValue(void) {
+        int dest = neighbors[next];
+        next = (next + 1) % neighbors.size();
+        return dest;
+    }
+
+    void seed(uint32_t val) {
+        next = val % neighbors.size();
+    }
+};
+
+} //namespace Merlin
+} //namespace SST
+
+#endif
@@ -0,0 +1,117 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TARGET_GENERATOR_PERMUTATION_H
+#define COMPONENTS_MERLIN_TARGET_GENERATOR_PERMUTATION_H
+
+#include <sst/elements/merlin/target_generator/target_generator.h>
+
+namespace SST {
+namespace Merlin {
+
+
+class PermutationDist : public TargetGenerator {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        PermutationDist,
+        "merlin",
+        "targetgen.permutation",
+        SST_ELI_ELEMENT_VERSION(0,0,1),
+        "Generates a random permutation pattern.  Every endpoint sends to a fixed target and every endpoint is the target of exactly one sender.  All endpoints must use the same seed.",
+        SST::Merlin::TargetGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"seed",   "Seed selecting the permutation","1"}
+    )
+
+    int dest;
+    uint32_t perm_seed;
+    int my_id;
+    int peers;
+
+public:
+
+    PermutationDist(ComponentId_t cid, Params &params, int id, int num_peers) :
+        TargetGenerator(cid)
+    {
+        perm_seed = params.find<uint32_t>("seed",1);
+        initialize(id, num_peers);
+    }
+
+    ~PermutationDist() {
+    }
+
+    void initialize(int id, int num_peers) {
+        my_id = id;
+        peers = num_peers;
+        dest = permute(id);
+    }
+
+    int getNextValue(void) {
+        return dest;
+    }
+
+    // Reseeding selects a different permutation, so it must be done
+    // with the same value on every endpoint
+    void seed(uint32_t val) {
+        perm_seed = val;
+        dest = permute(my_id);
+    }
+
+private:
+
+    // Feistel network over the smallest even number of bits covering
+    // peers, cycle walking until the result is in range.  This gives
+    // each endpoint its target without building the whole permutation.
+    int permute(int id) {
+        int half = 1;
+        while ( (1ULL << (2 * half)) < (uint64_t)peers ) half++;
+        uint32_t mask = (1U << half) - 1;
+
+        uint32_t val = id;
+        do {
+            uint32_t left = val >> half;
+            uint32_t right = val & mask;
+            for ( uint32_t round = 0; round < 4; round++ ) {
+                uint32_t next = left ^ (mix(right, round) & mask);
+                left = right;
+                right = next;
+            }
+            val = (left << half) | right;
+        } while ( val >= (uint32_t)peers );
+        return val;
+    }
+
+    uint32_t mix(uint32_t val, uint32_t round) {
+        uint64_t x = ((uint64_t)perm_seed << 32) ^ ((uint64_t)round << 24) ^ val;
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return (uint32_t)x;
+    }
+};
+
+} //namespace Merlin
+} //namespace SST
+
+#endif
@@ -67,3 +67,48 @@ class ShiftTarget(TargetGenerator):
 
     def getTypeName(self):
         return "merlin.targetgen.shift"
+
+
+class PermutationTarget(TargetGenerator):
+    def __init__(self):
+        TargetGenerator.__init__(self)
+        self._declareParams("params",["seed"])
+
+    def getTypeName(self):
+        return "merlin.targetgen.permutation"
+
+
+class TornadoTarget(TargetGenerator):
+    def __init__(self):
+        TargetGenerator.__init__(self)
+        self._declareParams("params",["shape"])
+
+    def getTypeName(self):
+        return "merlin.targetgen.tornado"
+
+
+class HotspotTarget(TargetGenerator):
+    def __init__(self):
+        TargetGenerator.__init__(self)
+        self._declareParams("params",["hotspots","fraction"])
+
+    def getTypeName(self):
+        return "merlin.targetgen.hotspot"
+
+
+class NeighborTarget(TargetGenerator):
+    def __init__(self):
+        TargetGenerator.__init__(self)
+        self._declareParams("params",["shape","periodic"])
+
+    def getTypeName(self):
+        return "merlin.targetgen.neighbor"
+
+
+class TraceTarget(TargetGenerator):
+    def __init__(self):
+        TargetGenerator.__init__(self)
+        self._declareParams("params",["file","loop"])
+
+    def getTypeName(self):
+        return "merlin.targetgen.trace"
@@ -19,6 +19,11 @@
 #include <sst/elements/merlin/target_generator/uniform.h>
 #include <sst/elements/merlin/target_generator/bit_complement.h>
 #include <sst/elements/merlin/target_generator/shift.h>
+#include <sst/elements/merlin/target_generator/permutation.h>
+#include <sst/elements/merlin/target_generator/tornado.h>
+#include <sst/elements/merlin/target_generator/hotspot.h>
+#include <sst/elements/merlin/target_generator/neighbor.h>
+#include <sst/elements/merlin/target_generator/trace.h>
 
 namespace SST {
 namespace Merlin {
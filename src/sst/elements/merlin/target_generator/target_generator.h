@@ -21,6 +21,9 @@
 
 #include <sst/core/subcomponent.h>
 
+#include <string>
+#include <vector>
+
 namespace SST {
 namespace Merlin {
 
@@ -37,6 +40,39 @@ public:
     virtual void initialize(int id, int num_peers) {}
     virtual int getNextValue(void) = 0;
     virtual void seed(uint32_t val) {}
+
+    // Generators that replay a trace also supply when each message
+    // was sent, in picoseconds from the start of the trace, and its
+    // size.
+    // Returns false if the generator has no timing or the trace is
+    // exhausted.
+    virtual bool getNextMessage(SimTime_t& time, int& dest, uint64_t& bytes) { return false; }
+
+protected:
+
+    // Parses an array shape like 4x4x4 into dims.  An empty shape is
+    // a single dimension of num_peers.  Returns false if the shape
+    // doesn't hold exactly num_peers endpoints.
+    static bool parseShape(const std::string& shape, int num_peers, std::vector<int>& dims) {
+        dims.clear();
+        if ( shape.empty() ) {
+            dims.push_back(num_peers);
+            return num_peers > 0;
+        }
+
+        long total = 1;
+        size_t start = 0;
+        while ( start <= shape.size() ) {
+            size_t end = shape.find('x', start);
+            if ( end == std::string::npos ) end = shape.size();
+            int size = atoi(shape.substr(start, end - start).c_str());
+            if ( size <= 0 ) return false;
+            dims.push_back(size);
+            total *= size;
+            start = end + 1;
+        }
+        return total == num_peers;
+    }
 };
 
 } //namespace Merlin
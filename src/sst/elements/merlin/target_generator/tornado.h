@@ -0,0 +1,89 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TARGET_GENERATOR_TORNADO_H
+#define COMPONENTS_MERLIN_TARGET_GENERATOR_TORNADO_H
+
+#include <sst/elements/merlin/target_generator/target_generator.h>
+
+namespace SST {
+namespace Merlin {
+
+
+class TornadoDist : public TargetGenerator {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        TornadoDist,
+        "merlin",
+        "targetgen.tornado",
+        SST_ELI_ELEMENT_VERSION(0,0,1),
+        "Generates a tornado pattern.  Each endpoint sends ceil(n/2) - 1 endpoints ahead of itself in every dimension of shape.",
+        SST::Merlin::TargetGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"shape",   "Shape of the endpoint array (e.g. 4x4x4).  Defaults to a single dimension of num_peers.",""}
+    )
+
+    std::string shape;
+    int dest;
+
+public:
+
+    TornadoDist(ComponentId_t cid, Params &params, int id, int num_peers) :
+        TargetGenerator(cid)
+    {
+        shape = params.find<std::string>("shape","");
+        initialize(id, num_peers);
+    }
+
+    ~TornadoDist() {
+    }
+
+    void initialize(int id, int num_peers) {
+        std::vector<int> dims;
+        if ( !parseShape(shape, num_peers, dims) ) {
+            fatal(CALL_INFO,1,"ERROR: shape %s in targetgen.tornado does not have %d endpoints\n", shape.c_str(), num_peers);
+        }
+
+        dest = 0;
+        int stride = 1;
+        int rem = id;
+        for ( int size : dims ) {
+            int coord = rem % size;
+            rem /= size;
+            coord = (coord + (size + 1) / 2 - 1) % size;
+            dest += coord * stride;
+            stride *= size;
+        }
+    }
+
+    int getNextValue(void) {
+        return dest;
+    }
+
+    void seed(uint32_t val) {
+    }
+};
+
+} //namespace Merlin
+} //namespace SST
+
+#endif
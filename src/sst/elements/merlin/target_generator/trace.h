@@ -0,0 +1,150 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TARGET_GENERATOR_TRACE_H
+#define COMPONENTS_MERLIN_TARGET_GENERATOR_TRACE_H
+
+#include <sst/elements/merlin/target_generator/target_generator.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+
+namespace SST {
+namespace Merlin {
+
+
+class TraceDist : public TargetGenerator {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        TraceDist,
+        "merlin",
+        "targetgen.trace",
+        SST_ELI_ELEMENT_VERSION(0,0,1),
+        "Replays the targets of a communication trace.  The trace is a binary file of records, each holding a uint64 send time in ps, a uint32 source, a uint32 destination and a uint64 size in bytes, in native byte order.  Each endpoint replays the records whose source is its ID, in file order.",
+        SST::Merlin::TargetGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"file",   "Trace file to replay"},
+        {"loop",   "Start over once the endpoint's records are exhausted.  Otherwise the last target is repeated and getNextMessage returns false.","true"}
+    )
+
+    struct Record {
+        uint64_t time;
+        uint32_t src;
+        uint32_t dst;
+        uint64_t bytes;
+    };
+
+    std::string file;
+    bool loop;
+    std::vector<Record> records;
+    size_t next;
+    int my_id;
+
+public:
+
+    TraceDist(ComponentId_t cid, Params &params, int id, int num_peers) :
+        TargetGenerator(cid)
+    {
+        bool found;
+        file = params.find<std::string>("file",found);
+        if ( !found ) {
+            fatal(CALL_INFO,1,"ERROR: file must be specified in targetgen.trace\n");
+        }
+        loop = params.find<bool>("loop",true);
+        initialize(id, num_peers);
+    }
+
+    ~TraceDist() {
+    }
+
+    void initialize(int id, int num_peers) {
+        my_id = id;
+        next = 0;
+        records.clear();
+
+        int fd = open(file.c_str(), O_RDONLY);
+        struct stat st;
+        if ( fd < 0 || fstat(fd, &st) != 0 ) {
+            fatal(CALL_INFO,1,"ERROR: unable to open trace file %s in targetgen.trace\n", file.c_str());
+        }
+        if ( st.st_size % sizeof(Record) != 0 ) {
+            fatal(CALL_INFO,1,"ERROR: trace file %s in targetgen.trace is not a whole number of records\n", file.c_str());
+        }
+
+        size_t count = st.st_size / sizeof(Record);
+        if ( count > 0 ) {
+            const char* data = (const char*)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if ( data == MAP_FAILED ) {
+                fatal(CALL_INFO,1,"ERROR: unable to map trace file %s in targetgen.trace\n", file.c_str());
+            }
+            for ( size_t i = 0; i < count; i++ ) {
+                Record rec;
+                memcpy(&rec, data + i * sizeof(Record), sizeof(Record));
+                if ( rec.src != (uint32_t)id ) continue;
+                if ( rec.dst >= (uint32_t)num_peers ) {
+                    fatal(CALL_INFO,1,"ERROR: trace file %s in targetgen.trace has destination %" PRIu32 " but only %d endpoints\n",
+                          file.c_str(), rec.dst, num_peers);
+                }
+                records.push_back(rec);
+            }
+            munmap((void*)data, st.st_size);
+        }
+        close(fd);
+    }
+
+    // Endpoints without records send to themselves
+    int getNextValue(void) {
+        if ( records.empty() ) return my_id;
+        if ( next >= records.size() ) return records.back().dst;
+        int dest = records[next].dst;
+        advance();
+        return dest;
+    }
+
+    bool getNextMessage(SimTime_t& time, int& dest, uint64_t& bytes) {
+        if ( next >= records.size() ) return false;
+        time = records[next].time;
+        dest = records[next].dst;
+        bytes = records[next].bytes;
+        advance();
+        return true;
+    }
+
+    void seed(uint32_t val) {
+    }
+
+private:
+
+    void advance() {
+        if ( next + 1 < records.size() ) next++;
+        else if ( loop ) next = 0;
+        else next = records.size();
+    }
+};
+
+} //namespace Merlin
+} //namespace SST
+
+#endif
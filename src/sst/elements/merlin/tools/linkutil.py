@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+#
+# Copyright 2009-2025 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2025, NTESS
+# All rights reserved.
+#
+# Portions are copyright of other developers:
+# See the file CONTRIBUTORS.TXT in the top level directory
+# of the distribution for more information.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+"""Read the link utilization files written by merlin.portcontrol when
+util_window is set and map them onto topology coordinates.
+
+  linkutil.py [--topo torus|mesh|hyperx|dragonfly] [--shape 4x4x4]
+              [--routers-per-group N] [--top N] [--series FILE]
+              link_util.*.bin
+
+By default one CSV line is printed per link with the average and peak
+busy and stall fractions.  --top keeps only the N links with the most
+stall time, which is usually where a congestion tree is rooted.
+--series writes the full time series, one line per link and window.
+"""
+
+import argparse
+import struct
+import sys
+
+HEADER = struct.Struct("<4sIQ")
+RECORD = struct.Struct("<iiiiQI")
+
+
+def read_file(name, links):
+    with open(name, "rb") as f:
+        data = f.read()
+    if len(data) < HEADER.size:
+        return None
+    magic, version, window_ps = HEADER.unpack_from(data, 0)
+    if magic != b"MLU1" or version != 1:
+        sys.exit("%s: not a link utilization file" % name)
+
+    offset = HEADER.size
+    while offset < len(data):
+        rtr, port, rrtr, rport, first, count = RECORD.unpack_from(data, offset)
+        offset += RECORD.size
+        samples = data[offset:offset + 2 * count]
+        offset += 2 * count
+        link = links.setdefault((rtr, port), {"remote": (rrtr, rport), "windows": {}})
+        for i in range(count):
+            link["windows"][first + i] = (samples[2 * i], samples[2 * i + 1])
+    return window_ps
+
+
+def make_mapper(args):
+    if args.topo in ("torus", "mesh", "hyperx"):
+        if not args.shape:
+            sys.exit("--shape is required for %s" % args.topo)
+        shape = [int(x) for x in args.shape.split("x")]
+
+        def coords(rtr):
+            # First dimension varies fastest, as in the topologies
+            loc = []
+            for size in shape:
+                loc.append(rtr % size)
+                rtr //= size
+            return "x".join(str(x) for x in loc)
+        return coords
+
+    if args.topo == "dragonfly":
+        if not args.routers_per_group:
+            sys.exit("--routers-per-group is required for dragonfly")
+        a = args.routers_per_group
+        return lambda rtr: "g%d.r%d" % (rtr // a, rtr % a)
+
+    return lambda rtr: str(rtr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("files", nargs="+")
+    parser.add_argument("--topo", default="", help="torus, mesh, hyperx or dragonfly")
+    parser.add_argument("--shape", default="", help="router shape for torus, mesh and hyperx, e.g. 4x4x4")
+    parser.add_argument("--routers-per-group", type=int, default=0, help="routers per group for dragonfly")
+    parser.add_argument("--top", type=int, default=0, help="only report the N most stalled links")
+    parser.add_argument("--series", default="", help="write the per window time series to this file")
+    args = parser.parse_args()
+
+    links = {}
+    window_ps = None
+    for name in args.files:
+        w = read_file(name, links)
+        if w is None:
+            continue
+        if window_ps is not None and w != window_ps:
+            sys.exit("%s: window does not match the other files" % name)
+        window_ps = w
+    if not links:
+        return
+
+    coords = make_mapper(args)
+    last = max(max(l["windows"]) for l in links.values()) + 1
+
+    def remote_name(link):
+        rrtr, rport = link["remote"]
+        return "ep%d" % rport if rrtr < 0 else coords(rrtr)
+
+    rows = []
+    for (rtr, port), link in links.items():
+        busy = [w[0] for w in link["windows"].values()]
+        stall = [w[1] for w in link["windows"].values()]
+        rows.append((sum(stall) / (255.0 * last), rtr, port, link,
+                     sum(busy) / (255.0 * last), max(busy) / 255.0, max(stall) / 255.0))
+    rows.sort(key=lambda r: (-r[0], r[1], r[2]))
+    if args.top > 0:
+        rows = rows[:args.top]
+
+    print("router,coords,port,remote,avg_busy,peak_busy,avg_stall,peak_stall")
+    for avg_stall, rtr, port, link, avg_busy, peak_busy, peak_stall in rows:
+        print("%d,%s,%d,%s,%.3f,%.3f,%.3f,%.3f" % (rtr, coords(rtr), port, remote_name(link),
+                                                   avg_busy, peak_busy, avg_stall, peak_stall))
+
+    if args.series:
+        with open(args.series, "w") as f:
+            f.write("time_ns,router,coords,port,remote,busy,stall\n")
+            for _, rtr, port, link, _, _, _ in rows:
+                for w in sorted(link["windows"]):
+                    busy, stall = link["windows"][w]
+                    f.write("%g,%d,%s,%d,%s,%.3f,%.3f\n" % (w * window_ps / 1000.0, rtr, coords(rtr), port,
+                                                            remote_name(link), busy / 255.0, stall / 255.0))
+
+
+if __name__ == "__main__":
+    main()
@@ -26,6 +26,9 @@
 
 using namespace SST::Merlin;
 
+std::mutex topo_dragonfly::queue_registry_lock;
+std::map<std::pair<std::string,uint32_t>, int const*> topo_dragonfly::queue_registry;
+
 // const uint8_t bit_array::masks[8] = { 0xfe, 0xfd, 0xfb, 0xf7, 0xef, 0xdf, 0xbf, 0x7f };
 
 
@@ -240,8 +243,8 @@ topo_dragonfly::topo_dragonfly(ComponentId_t cid, Params &p, int num_ports, int
     params.n = p.find<uint32_t>("intergroup_links");
     params.m = p.find<uint32_t>("intragroup_links", 1);
 
-    std::string prefix = p.find<std::string>("network_name","network");
-    prefix += "_";
+    network_name = p.find<std::string>("network_name","network");
+    std::string prefix = network_name + "_";
 
     global_start = params.p + ((params.a - 1) * params.m);
 
@@ -311,10 +314,18 @@ topo_dragonfly::topo_dragonfly(ComponentId_t cid, Params &p, int num_ports, int
             vns[i].algorithm = MINIMAL;
             vns[i].num_vcs = 2;
         }
-        else if ( !vn_route_algos[i].compare("ugal") ) {
+        else if ( !vn_route_algos[i].compare("ugal") || !vn_route_algos[i].compare("ugal-l") ) {
             vns[i].algorithm = UGAL;
             vns[i].num_vcs = 3;
         }
+        else if ( !vn_route_algos[i].compare("ugal-g") ) {
+            vns[i].algorithm = UGAL_G;
+            vns[i].num_vcs = 3;
+        }
+        else if ( !vn_route_algos[i].compare("par") ) {
+            vns[i].algorithm = PAR;
+            vns[i].num_vcs = 4;
+        }
         else if ( !vn_route_algos[i].compare("min-a") ) {
             vns[i].algorithm = MIN_A;
             vns[i].num_vcs = 2;
@@ -334,6 +345,8 @@ topo_dragonfly::topo_dragonfly(ComponentId_t cid, Params &p, int num_ports, int
 
 topo_dragonfly::~topo_dragonfly()
 {
+    std::lock_guard<std::mutex> lock(queue_registry_lock);
+    queue_registry.erase(std::make_pair(network_name, rtr_id));
     delete[] vns;
 }
 
@@ -463,7 +476,9 @@ void topo_dragonfly::route_ugal(int port, int vc, internal_router_event* ev)
         else {
             // printf("Routing packet with dest.group = %d and dest.mid_group = %d\n",td_ev->dest.group,td_ev->dest.mid_group);
             // Need to find the lowest weighted route.  Loop over all
-            // the slices.
+            // the slices.  For UGAL-G, also add the occupancy of the
+            // global port when it is on another router in the group.
+            bool use_global = vns[vn].algorithm == UGAL_G;
             int min_weight = std::numeric_limits<int>::max();
             std::vector<std::pair<int,int> > min_ports;
             for ( int i = 0; i < params.n; ++i ) {
@@ -473,6 +488,7 @@ void topo_dragonfly::route_ugal(int port, int vc, internal_router_event* ev)
                     int port = port_for_group(td_ev->dest.group, i, j);
                     if ( port != -1 ) {
                         weight = output_queue_lengths[port * num_vcs + vc];
+                        if ( use_global ) weight += remote_queue_length(td_ev->dest.group, i, vc);
 
                         if ( weight == min_weight ) {
                             min_ports.emplace_back(port,i);
@@ -487,7 +503,9 @@ void topo_dragonfly::route_ugal(int port, int vc, internal_router_event* ev)
                     // Valiant routes
                     port = port_for_group(td_ev->dest.mid_group, i, j);
                     if ( port != -1 ) {
-                        weight = 2 * output_queue_lengths[port * num_vcs + vc] + vns[vn].bias;
+                        weight = output_queue_lengths[port * num_vcs + vc];
+                        if ( use_global ) weight += remote_queue_length(td_ev->dest.mid_group, i, vc);
+                        weight = 2 * weight + vns[vn].bias;
 
                         if ( weight == min_weight ) {
                             min_ports.emplace_back(port,i);
@@ -861,9 +879,132 @@ void topo_dragonfly::route_adaptive_local(int port, int vc, internal_router_even
 
 }
 
+void topo_dragonfly::route_par(int port, int vc, internal_router_event* ev)
+{
+    topo_dragonfly_event *td_ev = static_cast<topo_dragonfly_event*>(ev);
+    int vn = ev->getVN();
+
+    // Progressive adaptive routing.  The packet makes a UGAL-L
+    // decision when it is injected, recording the choice in mid_group
+    // so the rest of the route is done by route_nonadaptive().  A
+    // packet that chose the minimal route gets a second chance to
+    // switch to the valiant route at the router that owns its global
+    // link.  The extra hop in the source group uses the next VC.
+
+    if ( port < params.p ) {
+        if ( td_ev->dest.group == group_id ) {
+            if ( td_ev->dest.router != router_id ) {
+                // mid_group holds a random router in the group
+                int direct_route_port = port_for_router(td_ev->dest.router, td_ev->local_slice);
+                int direct_route_weight = output_queue_lengths[direct_route_port * num_vcs + vc];
+
+                int valiant_route_port = port_for_router(td_ev->dest.mid_group, td_ev->local_slice);
+                int valiant_route_weight = output_queue_lengths[valiant_route_port * num_vcs + vc];
+
+                if ( direct_route_weight <= 2 * valiant_route_weight + vns[vn].bias ) {
+                    td_ev->dest.mid_group = td_ev->dest.router;
+                }
+            }
+        }
+        else {
+            int min_weight = std::numeric_limits<int>::max();
+            int min_group = td_ev->dest.group;
+            int min_slice = td_ev->global_slice;
+            for ( int i = 0; i < params.n; ++i ) {
+                for ( int j = 0; j < params.m; ++j ) {
+                    int port = port_for_group(td_ev->dest.group, i, j);
+                    if ( port != -1 ) {
+                        int weight = output_queue_lengths[port * num_vcs + vc];
+                        if ( weight < min_weight ) {
+                            min_weight = weight;
+                            min_group = td_ev->dest.group;
+                            min_slice = i;
+                        }
+                    }
+
+                    port = port_for_group(td_ev->dest.mid_group_shadow, i, j);
+                    if ( port != -1 ) {
+                        int weight = 2 * output_queue_lengths[port * num_vcs + vc] + vns[vn].bias;
+                        if ( weight < min_weight ) {
+                            min_weight = weight;
+                            min_group = td_ev->dest.mid_group_shadow;
+                            min_slice = i;
+                        }
+                    }
+                }
+            }
+            td_ev->dest.mid_group = min_group;
+            td_ev->global_slice = min_slice;
+        }
+        return route_nonadaptive(port,vc,ev);
+    }
+
+    // Re-evaluate minimally routed packets at the global link router
+    // in the source group.  Packets that have already been diverted
+    // are on a higher VC and are not considered again.
+    if ( port < global_start && td_ev->src_group == group_id && td_ev->dest.group != group_id &&
+         td_ev->dest.mid_group == td_ev->dest.group && vc == vns[vn].start_vc ) {
+
+        int direct_port = port_for_group(td_ev->dest.group, td_ev->global_slice, td_ev->local_slice);
+        int direct_weight = std::numeric_limits<int>::max();
+        if ( direct_port != -1 ) direct_weight = output_queue_lengths[direct_port * num_vcs + vc];
+
+        int valiant_port = -1;
+        int valiant_slice = 0;
+        int valiant_weight = std::numeric_limits<int>::max();
+        for ( int i = 0; i < params.n; ++i ) {
+            for ( int j = 0; j < params.m; ++j ) {
+                int port = port_for_group(td_ev->dest.mid_group_shadow, i, j);
+                if ( port == -1 ) continue;
+                // Diverted packets take the next VC, so look at its queues
+                int weight = 2 * output_queue_lengths[port * num_vcs + vc + 1] + vns[vn].bias;
+                if ( weight < valiant_weight ) {
+                    valiant_weight = weight;
+                    valiant_port = port;
+                    valiant_slice = i;
+                }
+            }
+        }
+
+        if ( valiant_port != -1 && direct_weight > valiant_weight ) {
+            td_ev->dest.mid_group = td_ev->dest.mid_group_shadow;
+            td_ev->global_slice = valiant_slice;
+            td_ev->setVC(vc+1);
+            td_ev->setNextPort(valiant_port);
+            return;
+        }
+    }
+
+    route_nonadaptive(port,vc,ev);
+}
+
+int topo_dragonfly::remote_queue_length(uint32_t group, uint32_t global_slice, int vc)
+{
+    const RouterPortPair& pair = group_to_global_port.getRouterPortPair(group,global_slice);
+    if ( pair.router == router_id ) return 0;
+
+    // Find the queue arrays of the other routers in the group the
+    // first time they are needed.  They are all set during init.
+    if ( group_queue_lengths.empty() ) {
+        group_queue_lengths.resize(params.a, nullptr);
+        std::lock_guard<std::mutex> lock(queue_registry_lock);
+        for ( uint32_t i = 0; i < params.a; ++i ) {
+            auto it = queue_registry.find(std::make_pair(network_name, group_id * params.a + i));
+            if ( it != queue_registry.end() ) group_queue_lengths[i] = it->second;
+        }
+    }
+
+    // Routers on other ranks are not visible, fall back to local
+    // information only
+    int const* remote = group_queue_lengths[pair.router];
+    if ( remote == nullptr ) return 0;
+    return remote[pair.port * num_vcs + vc];
+}
+
 void topo_dragonfly::route_packet(int port, int vc, internal_router_event* ev) {
     int vn = ev->getVN();
-    if ( vns[vn].algorithm == UGAL ) return route_ugal(port,vc,ev);
+    if ( vns[vn].algorithm == UGAL || vns[vn].algorithm == UGAL_G ) return route_ugal(port,vc,ev);
+    if ( vns[vn].algorithm == PAR ) return route_par(port,vc,ev);
     if ( vns[vn].algorithm == MIN_A ) return route_mina(port,vc,ev);
     route_nonadaptive(port,vc,ev);
     route_adaptive_local(port,vc,ev);
@@ -888,6 +1029,8 @@ internal_router_event* topo_dragonfly::process_input(RtrEvent* ev)
     case VALIANT:
     case ADAPTIVE_LOCAL:
     case UGAL:
+    case UGAL_G:
+    case PAR:
         if ( dstAddr.group == group_id ) {
             // staying within group, set mid_group to be an intermediate router within group
             do {
@@ -1092,6 +1235,11 @@ topo_dragonfly::setOutputQueueLengthsArray(int const* array, int vcs)
 {
     output_queue_lengths = array;
     num_vcs = vcs;
+
+    // Make the queue lengths visible to the other routers in the rank
+    // for UGAL-G
+    std::lock_guard<std::mutex> lock(queue_registry_lock);
+    queue_registry[std::make_pair(network_name, rtr_id)] = array;
 }
 
 void topo_dragonfly::idToLocation(int id, dgnflyAddr *location)
@@ -20,6 +20,8 @@
 #define COMPONENTS_MERLIN_TOPOLOGY_DRAGONFLY_H
 
 #include <algorithm>
+#include <map>
+#include <mutex>
 
 #include <sst/core/event.h>
 #include <sst/core/link.h>
@@ -194,7 +196,7 @@ public:
         {"dragonfly.intergroup_links",      "Number of links between each pair of groups."},
         {"dragonfly.intragroup_links",      "Number of links between each pair of routers in a group."},
         {"dragonfly.num_groups",            "Number of groups in network."},
-        {"dragonfly.algorithm",             "Routing algorithm to use [minmal (default) | valiant].", "minimal"},
+        {"dragonfly.algorithm",             "Routing algorithm to use [minmal (default) | valiant | adaptive-local | ugal | ugal-l | ugal-g | par | min-a].", "minimal"},
         {"dragonfly.adaptive_threshold",    "Threshold to use when make adaptive routing decisions.", "2.0"},
         {"dragonfly.global_link_map",       "Array specifying connectivity of global links in each dragonfly group."},
         {"dragonfly.global_route_mode",     "Mode for intepreting global link map [absolute (default) | relative].","absolute"},
@@ -206,7 +208,9 @@ public:
         {"intergroup_links",      "Number of links between each pair of groups."},
         {"intragroup_links",      "Number of links between each pair of of routers in a group."},
         {"num_groups",            "Number of groups in network."},
-        {"algorithm",             "Routing algorithm to use [minmal (default) | valiant].", "minimal"},
+        {"algorithm",             "Routing algorithm to use [minmal (default) | valiant | adaptive-local | ugal | ugal-l | ugal-g | par | min-a]. "
+                                  "ugal (alias ugal-l) weighs routes by local queue lengths.  ugal-g also adds the queue length of the global port on the other routers in the group (only routers in the same rank are visible).  "
+                                  "par makes a ugal-l decision at injection and can switch a minimal route to valiant at the router owning the global link; it uses 4 VCs.", "minimal"},
         {"adaptive_threshold",    "Threshold to use when make adaptive routing decisions.", "2.0"},
         {"global_link_map",       "Array specifying connectivity of global links in each dragonfly group."},
         {"global_route_mode",     "Mode for intepreting global link map [absolute (default) | relative].","absolute"},
@@ -219,6 +223,8 @@ public:
         VALIANT,
         ADAPTIVE_LOCAL,
         UGAL,
+        UGAL_G,
+        PAR,
         MIN_A
     };
 
@@ -244,6 +250,18 @@ public:
 
     global_route_mode_t global_route_mode;
 
+    std::string network_name;
+
+    // Output queue lengths of the routers in this group, indexed by
+    // router in group.  Routers not in this rank are nullptr.  Used
+    // by UGAL-G.
+    std::vector<int const*> group_queue_lengths;
+
+    // Output queue lengths of all dragonfly routers in the rank,
+    // keyed by network name and router id
+    static std::mutex queue_registry_lock;
+    static std::map<std::pair<std::string,uint32_t>, int const*> queue_registry;
+
 public:
     struct dgnflyAddr {
         uint32_t group;
@@ -304,6 +322,9 @@ private:
     void route_adaptive_local(int port, int vc, internal_router_event* ev);
     void route_ugal(int port, int vc, internal_router_event* ev);
     void route_mina(int port, int vc, internal_router_event* ev);
+    void route_par(int port, int vc, internal_router_event* ev);
+
+    int remote_queue_length(uint32_t group, uint32_t global_slice, int vc);
 
 };
 
@@ -111,6 +111,15 @@ topo_hyperx::topo_hyperx(ComponentId_t cid, Params& params, int num_ports, int r
             vns[i].algorithm = VDAL;
             vns[i].num_vcs = 2 * dimensions;
         }
+        else if ( !vn_route_algos[i].compare("DAL") ) {
+            // At most one misroute per dimension, so no more than
+            // 2 * dimensions hops, each on the next VC
+            if ( dimensions > 32 ) {
+                output.fatal(CALL_INFO,-1,"DAL routing supports at most 32 dimensions (%d specified)\n",dimensions);
+            }
+            vns[i].algorithm = DAL;
+            vns[i].num_vcs = 2 * dimensions;
+        }
         else if ( !vn_route_algos[i].compare("DOR-ND") ) {
             vns[i].algorithm = DORND;
             vns[i].num_vcs = 1;
@@ -186,6 +195,10 @@ topo_hyperx::route_packet(int port, int vc, internal_router_event* ev)
         return routeVDAL(port,vc,tt_ev);
     }
 
+    else if ( vns[vn].algorithm == DAL ) {
+        return routeDAL(port,vc,tt_ev);
+    }
+
     // Look for opportunities to adaptively route
 
     // We will look at all the ports in unaligned dimensions and take
@@ -698,3 +711,86 @@ topo_hyperx::routeVDAL(int port, int vc, topo_hyperx_event* ev) {
     ev->setVC(next_vc);
 }
 
+
+void
+topo_hyperx::routeDAL(int port, int vc, topo_hyperx_event* ev) {
+    // Dimensionally-adaptive, load-balanced routing (Ahn et al.,
+    // SC'09).  The packet may route in any unaligned dimension, and
+    // may misroute once in each of them before aligning it.  Every
+    // hop moves to the next VC in the VN; with at most one misroute
+    // and one minimal hop per dimension the path is never longer than
+    // 2 * dimensions hops, so the VCs never run out and there is no
+    // cyclic dependency.
+    int dest_router = get_dest_router(ev->getDest());
+    if ( dest_router == router_id ) {
+        ev->setNextPort(get_dest_local_port(ev->getDest()));
+        return;
+    }
+
+    int vn = ev->getVN();
+
+    // If this is just coming into the network from an endpoint, we
+    // need to set the vc to -1 in order for the logic below to work
+    int vc_in_vn = port >= local_port_start ? -1 : vc - vns[vn].start_vc;
+    int next_vc = vns[vn].start_vc + vc_in_vn + 1;
+
+    std::vector<int> udims;
+    ev->getUnalignedDimensions(id_loc,udims);
+
+    // Minimal links are weighted by their queue length, misroutes by
+    // twice that plus one since they add a hop.  Ties are broken
+    // randomly.
+    int min_weight = 0x7fffffff;
+    std::vector<int> min_ports;
+
+    for ( int dim : udims ) {
+        bool can_deroute = !(ev->derouted_dims & (1u << dim));
+
+        int offset = 0;
+        for ( int router = 0; router < dim_size[dim]; ++router ) {
+            if ( router == id_loc[dim] ) continue;
+
+            bool minimal = router == ev->dest_loc[dim];
+            if ( !minimal && !can_deroute ) {
+                offset++;
+                continue;
+            }
+
+            for ( int link = 0; link < dim_width[dim]; ++link ) {
+                int next_port = port_start[dim] + (offset * dim_width[dim]) + link;
+                int queue = output_queue_lengths[next_port * num_vcs + next_vc];
+                int weight = minimal ? queue : 2 * queue + 1;
+
+                if ( weight == min_weight ) {
+                    min_ports.push_back(next_port);
+                }
+                else if ( weight < min_weight ) {
+                    min_weight = weight;
+                    min_ports.clear();
+                    min_ports.push_back(next_port);
+                }
+            }
+            offset++;
+        }
+    }
+
+    int min_port = min_ports[rng->generateNextUInt32() % min_ports.size()];
+
+    // Find the dimension of the chosen port and record a misroute in it
+    int dim = dimensions - 1;
+    for ( int i = 0; i < dimensions - 1; ++i ) {
+        if ( min_port < port_start[i+1] ) {
+            dim = i;
+            break;
+        }
+    }
+    int target = (min_port - port_start[dim]) / dim_width[dim];
+    if ( target >= id_loc[dim] ) target++;
+    if ( target != ev->dest_loc[dim] ) {
+        ev->derouted_dims |= (1u << dim);
+    }
+    ev->last_routing_dim = dim;
+
+    ev->setNextPort(min_port);
+    ev->setVC(next_vc);
+}
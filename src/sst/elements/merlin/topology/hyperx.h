@@ -43,13 +43,16 @@ public:
 
     id_type id;
     bool rerouted;
+    // Dimensions already misrouted in, one bit per dimension (DAL)
+    uint32_t derouted_dims;
 
     topo_hyperx_event() : internal_router_event() {}
     topo_hyperx_event(int dim) :
         internal_router_event(),
         dimensions(dim),
         last_routing_dim(-1),
-        val_route_dest(false)
+        val_route_dest(false),
+        derouted_dims(0)
     {
         dest_loc = new int[dim];
         val_loc = new int[dim];
@@ -94,6 +97,7 @@ public:
         SST_SER(val_route_dest);
         SST_SER(id);
         SST_SER(rerouted);
+        SST_SER(derouted_dims);
     }
 
 protected:
@@ -170,7 +174,8 @@ public:
         {"width", "Number of links between routers in each dimension, specified in same manner as for shape.  "
                   "For example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"local_ports", "Number of endpoints attached to each router."},
-        {"algorithm", "Routing algorithm to use.", "DOR"}
+        {"algorithm", "Routing algorithm to use: DOR, DOR-ND, MIN-A, valiant, DOAL, VDAL or DAL.  May be an "
+                      "array with one entry per VN.", "DOR"}
     )
 
     enum RouteAlgo {
@@ -179,7 +184,8 @@ public:
         MINA,
         VALIANT,
         DOAL,
-        VDAL
+        VDAL,
+        DAL
     };
 
 private:
@@ -250,6 +256,7 @@ private:
     void routeMINA(int port, int vc, topo_hyperx_event* ev);
     void routeDOAL(int port, int vc, topo_hyperx_event* ev);
     void routeVDAL(int port, int vc, topo_hyperx_event* ev);
+    void routeDAL(int port, int vc, topo_hyperx_event* ev);
     void routeValiant(int port, int vc, topo_hyperx_event* ev);
 };
 
@@ -0,0 +1,316 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include "ocs.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdlib.h>
+
+
+using namespace SST::Merlin;
+
+
+topo_ocs::topo_ocs(ComponentId_t cid, Params& params, int num_ports, int rtr_id, int num_vns) :
+    Topology(cid),
+    router_id(rtr_id),
+    num_ports(num_ports),
+    num_vns(num_vns),
+    current_slot(0),
+    slot_valid(false)
+{
+    num_tors = params.find<int>("num_tors", 0);
+    hosts_per_tor = params.find<int>("hosts_per_tor", 0);
+    circuits_per_tor = params.find<int>("circuits_per_tor", 1);
+    core_uplinks = params.find<int>("core_uplinks", 1);
+
+    if ( num_tors < 2 || hosts_per_tor < 1 || core_uplinks < 1 ) {
+        output.fatal(CALL_INFO, -1, "ocs: num_tors must be at least 2, hosts_per_tor and core_uplinks at least 1\n");
+    }
+    if ( circuits_per_tor < 0 || circuits_per_tor > num_tors - 1 ) {
+        output.fatal(CALL_INFO, -1, "ocs: circuits_per_tor must be between 0 and num_tors-1 (%d)\n", num_tors - 1);
+    }
+
+    is_core = (router_id == num_tors);
+    int needed_ports = is_core ? num_tors * core_uplinks : hosts_per_tor + (num_tors - 1) + core_uplinks;
+    if ( num_ports < needed_ports ) {
+        output.fatal(CALL_INFO, -1, "ocs: router %d needs %d ports, but only has %d\n", router_id, needed_ports, num_ports);
+    }
+
+    std::string mode_str = params.find<std::string>("schedule_mode", "rotor");
+    if ( mode_str == "rotor" ) mode = ROTOR;
+    else if ( mode_str == "schedule" ) mode = SCHEDULE;
+    else if ( mode_str == "demand" ) mode = DEMAND;
+    else {
+        output.fatal(CALL_INFO, -1, "ocs: unknown schedule_mode: %s\n", mode_str.c_str());
+    }
+
+    if ( mode == SCHEDULE ) {
+        std::vector<std::string> slots;
+        params.find_array<std::string>("schedule", slots);
+        if ( slots.empty() ) {
+            output.fatal(CALL_INFO, -1, "ocs: schedule_mode is schedule, but no schedule was given\n");
+        }
+        for ( auto& slot : slots ) {
+            std::vector<int> offsets;
+            std::stringstream ss(slot);
+            std::string offset;
+            while ( std::getline(ss, offset, ',') ) {
+                int o = strtol(offset.c_str(), NULL, 0);
+                if ( o < 1 || o >= num_tors ) {
+                    output.fatal(CALL_INFO, -1, "ocs: schedule offset %d is not between 1 and num_tors-1 (%d)\n", o, num_tors - 1);
+                }
+                offsets.push_back(o);
+            }
+            if ( (int)offsets.size() > circuits_per_tor ) {
+                output.fatal(CALL_INFO, -1, "ocs: schedule slot \"%s\" lights more than circuits_per_tor (%d) circuits\n",
+                             slot.c_str(), circuits_per_tor);
+            }
+            schedule.push_back(offsets);
+        }
+    }
+
+    UnitAlgebra slot_time = params.find<UnitAlgebra>("slot_time", "10us");
+    UnitAlgebra reconfig_time = params.find<UnitAlgebra>("reconfig_time", "100ns");
+    UnitAlgebra circuit_guard = params.find<UnitAlgebra>("circuit_guard", "0ns");
+    if ( !slot_time.hasUnits("s") || !reconfig_time.hasUnits("s") || !circuit_guard.hasUnits("s") ) {
+        output.fatal(CALL_INFO, -1, "ocs: slot_time, reconfig_time and circuit_guard must be specified in units of s (SI prefix also allowed)\n");
+    }
+    slot_ps = (slot_time / UnitAlgebra("1ps")).getRoundedValue();
+    reconfig_ps = (reconfig_time / UnitAlgebra("1ps")).getRoundedValue();
+    guard_ps = (circuit_guard / UnitAlgebra("1ps")).getRoundedValue();
+    if ( slot_ps == 0 || reconfig_ps + guard_ps >= slot_ps ) {
+        output.fatal(CALL_INFO, -1, "ocs: slot_time must be longer than reconfig_time plus circuit_guard\n");
+    }
+    ps_tc = getTimeConverter("1ps");
+
+    lit.resize(num_tors, false);
+    lit_before.resize(num_tors, false);
+    lit_after.resize(num_tors, false);
+    demand.resize(num_tors, 0);
+
+    stat_circuit_packets = registerStatistic<uint64_t>("circuit_packets");
+    stat_core_packets = registerStatistic<uint64_t>("core_packets");
+    stat_blackout_packets = registerStatistic<uint64_t>("blackout_packets");
+    stat_reconfigurations = registerStatistic<uint64_t>("reconfigurations");
+}
+
+
+topo_ocs::~topo_ocs()
+{
+}
+
+
+void
+topo_ocs::offsetsForSlot(SimTime_t slot, std::vector<bool>& out) const
+{
+    std::fill(out.begin(), out.end(), false);
+
+    if ( mode == SCHEDULE ) {
+        for ( int offset : schedule[slot % schedule.size()] ) {
+            out[(router_id + offset) % num_tors] = true;
+        }
+        return;
+    }
+
+    // Rotor: step through every offset, circuits_per_tor a slot
+    for ( int i = 0; i < circuits_per_tor; ++i ) {
+        int offset = 1 + ((slot * circuits_per_tor + i) % (num_tors - 1));
+        out[(router_id + offset) % num_tors] = true;
+    }
+}
+
+
+void
+topo_ocs::chooseByDemand(std::vector<bool>& out) const
+{
+    std::fill(out.begin(), out.end(), false);
+
+    std::vector<int> tors;
+    for ( int i = 0; i < num_tors; ++i ) {
+        if ( demand[i] > 0 ) tors.push_back(i);
+    }
+    std::stable_sort(tors.begin(), tors.end(), [this](int a, int b) { return demand[a] > demand[b]; });
+
+    int chosen = 0;
+    for ( int i = 0; i < (int)tors.size() && chosen < circuits_per_tor; ++i, ++chosen ) {
+        out[tors[i]] = true;
+    }
+
+    // Circuits not needed for new demand stay where they are
+    for ( int i = 0; i < num_tors && chosen < circuits_per_tor; ++i ) {
+        if ( lit[i] && !out[i] ) {
+            out[i] = true;
+            chosen++;
+        }
+    }
+}
+
+
+void
+topo_ocs::advanceSlot(SimTime_t now)
+{
+    SimTime_t slot = now / slot_ps;
+    if ( slot_valid && slot == current_slot ) return;
+
+    std::vector<bool> next(num_tors, false);
+    if ( mode == DEMAND && slot_valid ) chooseByDemand(next);
+    // Demand mode starts out with the rotor configuration
+    else offsetsForSlot(slot, next);
+
+    if ( !slot_valid ) {
+        // Circuits are set up before the simulation starts
+        lit_before = next;
+    }
+    else if ( slot == current_slot + 1 ) {
+        lit_before = lit;
+    }
+    else if ( mode == DEMAND ) {
+        // The estimator ran at the end of the last busy slot and, with no
+        // traffic since, kept those circuits
+        lit_before = next;
+    }
+    else {
+        offsetsForSlot(slot - 1, lit_before);
+    }
+
+    if ( slot_valid && next != lit_before ) stat_reconfigurations->addData(1);
+
+    // The demand estimator has not decided on the next slot yet, so
+    // every circuit may move at the end of this one
+    if ( mode == DEMAND ) std::fill(lit_after.begin(), lit_after.end(), false);
+    else offsetsForSlot(slot + 1, lit_after);
+
+    lit = next;
+    current_slot = slot;
+    slot_valid = true;
+    std::fill(demand.begin(), demand.end(), 0);
+}
+
+
+bool
+topo_ocs::circuitUsable(int tor, SimTime_t now) const
+{
+    SimTime_t offset = now - current_slot * slot_ps;
+
+    if ( !lit_before[tor] && offset < reconfig_ps ) return false;
+    if ( !lit_after[tor] && offset + guard_ps >= slot_ps ) return false;
+    return true;
+}
+
+
+void
+topo_ocs::route_packet(int port, int vc, internal_router_event* ev)
+{
+    int dest = ev->getDest();
+    int dest_tor = dest / hosts_per_tor;
+
+    if ( is_core ) {
+        ev->setNextPort(dest_tor * core_uplinks + (dest % core_uplinks));
+        return;
+    }
+
+    if ( dest_tor == router_id ) {
+        ev->setNextPort(dest % hosts_per_tor);
+        return;
+    }
+
+    // Only packets from local hosts leave on a circuit or the uplink,
+    // anything from the core or a circuit is delivered above
+    if ( circuits_per_tor > 0 ) {
+        SimTime_t now = getCurrentSimTime(ps_tc);
+        advanceSlot(now);
+
+        if ( port < hosts_per_tor ) demand[dest_tor] += ev->getEncapsulatedEvent()->getSizeInBits();
+
+        if ( lit[dest_tor] ) {
+            if ( circuitUsable(dest_tor, now) ) {
+                ev->setNextPort(circuitPort(dest_tor));
+                stat_circuit_packets->addData(1);
+                return;
+            }
+            stat_blackout_packets->addData(1);
+        }
+    }
+
+    ev->setNextPort(uplinkPort(dest));
+    stat_core_packets->addData(1);
+}
+
+
+internal_router_event*
+topo_ocs::process_input(RtrEvent* ev)
+{
+    internal_router_event* ire = new internal_router_event(ev);
+    ire->setVC(ire->getVN());
+    return ire;
+}
+
+
+void topo_ocs::routeUntimedData(int port, internal_router_event* ev, std::vector<int> &outPorts)
+{
+    // Untimed data always goes through the packet core
+    if ( ev->getDest() == UNTIMED_BROADCAST_ADDR ) {
+        if ( is_core ) {
+            int src_tor = port / core_uplinks;
+            for ( int i = 0; i < num_tors; ++i ) {
+                if ( i != src_tor ) outPorts.push_back(i * core_uplinks);
+            }
+            return;
+        }
+
+        for ( int i = 0; i < hosts_per_tor; ++i ) {
+            if ( i != port ) outPorts.push_back(i);
+        }
+        if ( port < hosts_per_tor ) outPorts.push_back(hosts_per_tor + (num_tors - 1));
+    }
+    else {
+        int dest = ev->getDest();
+        int dest_tor = dest / hosts_per_tor;
+
+        if ( is_core ) outPorts.push_back(dest_tor * core_uplinks + (dest % core_uplinks));
+        else if ( dest_tor == router_id ) outPorts.push_back(dest % hosts_per_tor);
+        else outPorts.push_back(uplinkPort(dest));
+    }
+}
+
+
+internal_router_event* topo_ocs::process_UntimedData_input(RtrEvent* ev)
+{
+    return new internal_router_event(ev);
+}
+
+
+Topology::PortState
+topo_ocs::getPortState(int port) const
+{
+    if ( is_core ) {
+        if ( port < num_tors * core_uplinks ) return R2R;
+        return UNCONNECTED;
+    }
+
+    if ( port < hosts_per_tor ) return R2N;
+    if ( port < hosts_per_tor + (num_tors - 1) + core_uplinks ) return R2R;
+    return UNCONNECTED;
+}
+
+
+int
+topo_ocs::getEndpointID(int port)
+{
+    if ( is_core || port >= hosts_per_tor ) return -1;
+    return router_id * hosts_per_tor + port;
+}
@@ -0,0 +1,156 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TOPOLOGY_OCS_H
+#define COMPONENTS_MERLIN_TOPOLOGY_OCS_H
+
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/params.h>
+
+#include "sst/elements/merlin/router.h"
+
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+/*
+ * Hybrid packet/optical circuit switched network.
+ *
+ * Routers 0 .. num_tors-1 are top of rack switches and router num_tors is an
+ * electrical packet core every ToR has core_uplinks links to. The optical
+ * circuit switch is modelled by a direct link between every pair of ToRs, of
+ * which only circuits_per_tor per ToR are lit at a time. Time is divided into
+ * slots of slot_time; a circuit lit at the start of a slot that was not lit
+ * in the previous one is dark for reconfig_time while the switch moves.
+ *
+ * Configurations are circulant, ToR i has a circuit to ToR (i + offset) for
+ * each lit offset, so every ToR receives on as many circuits as it sends on:
+ *   rotor    - offsets step through 1 .. num_tors-1, circuits_per_tor a slot
+ *   schedule - offsets per slot are given by the schedule parameter
+ *   demand   - each ToR lights circuits to the destinations it sent the most
+ *              traffic to in the previous slot. This is a per-ToR estimator
+ *              that does not limit how many circuits a ToR receives on.
+ *
+ * Packets use a lit circuit to their destination ToR when there is one and go
+ * through the packet core otherwise.
+ */
+class topo_ocs: public Topology {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        topo_ocs,
+        "merlin",
+        "ocs",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Top of rack switches joined by a packet core and a reconfigurable optical circuit switch",
+        SST::Merlin::Topology
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"num_tors",          "Number of top of rack switches."},
+        {"hosts_per_tor",     "Number of endpoints on each top of rack switch."},
+        {"circuits_per_tor",  "Circuits lit on each top of rack switch at a time, at most num_tors-1. 0 sends everything through the packet core.", "1"},
+        {"core_uplinks",      "Links from each top of rack switch to the packet core.", "1"},
+        {"schedule_mode",     "How circuits are chosen each slot [rotor | schedule | demand].", "rotor"},
+        {"schedule",          "For schedule mode, an array with one entry per slot, each a comma separated list of the ToR offsets lit in that slot. The schedule repeats."},
+        {"slot_time",         "Time circuits stay configured.", "10us"},
+        {"reconfig_time",     "Time a newly set up circuit is dark at the start of its slot.", "100ns"},
+        {"circuit_guard",     "Circuits stop taking packets this long before the end of their slot, so queued packets drain before the switch moves.", "0ns"}
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "circuit_packets",   "Packets sent on an optical circuit", "packets", 1},
+        { "core_packets",      "Packets sent to the packet core", "packets", 1},
+        { "blackout_packets",  "Packets sent to the packet core because their circuit was being set up or about to be torn down", "packets", 1},
+        { "reconfigurations",  "Slots that started with a different circuit configuration, counted when the router next routes a packet", "slots", 1}
+    )
+
+
+private:
+    enum ScheduleMode { ROTOR, SCHEDULE, DEMAND };
+
+    int router_id;
+    int num_ports;
+    int num_vns;
+
+    int num_tors;
+    int hosts_per_tor;
+    int circuits_per_tor;
+    int core_uplinks;
+    bool is_core;
+
+    ScheduleMode mode;
+    std::vector<std::vector<int>> schedule;
+
+    SimTime_t slot_ps;
+    SimTime_t reconfig_ps;
+    SimTime_t guard_ps;
+    TimeConverter* ps_tc;
+
+    // Circuit state, indexed by destination ToR, for the current slot
+    // and the slots either side of it
+    SimTime_t current_slot;
+    bool slot_valid;
+    std::vector<bool> lit;
+    std::vector<bool> lit_before;
+    std::vector<bool> lit_after;
+
+    // Bits sent from local hosts to each ToR in the current slot
+    std::vector<uint64_t> demand;
+
+    Statistic<uint64_t>* stat_circuit_packets;
+    Statistic<uint64_t>* stat_core_packets;
+    Statistic<uint64_t>* stat_blackout_packets;
+    Statistic<uint64_t>* stat_reconfigurations;
+
+    inline int circuitPort(int tor) const { return hosts_per_tor + (tor < router_id ? tor : tor - 1); }
+    inline int uplinkPort(int dest) const { return hosts_per_tor + (num_tors - 1) + (dest % core_uplinks); }
+
+    void offsetsForSlot(SimTime_t slot, std::vector<bool>& out) const;
+    void chooseByDemand(std::vector<bool>& out) const;
+    void advanceSlot(SimTime_t now);
+    bool circuitUsable(int tor, SimTime_t now) const;
+
+public:
+    topo_ocs(ComponentId_t cid, Params& params, int num_ports, int rtr_id, int num_vns);
+    ~topo_ocs();
+
+    virtual void route_packet(int port, int vc, internal_router_event* ev);
+    virtual internal_router_event* process_input(RtrEvent* ev);
+
+    virtual void routeUntimedData(int port, internal_router_event* ev, std::vector<int> &outPorts);
+    virtual internal_router_event* process_UntimedData_input(RtrEvent* ev);
+
+    virtual PortState getPortState(int port) const;
+
+    virtual int getEndpointID(int port);
+
+    virtual void getVCsPerVN(std::vector<int>& vcs_per_vn) {
+        for ( int i = 0; i < num_vns; ++i ) {
+            vcs_per_vn[i] = 1;
+        }
+    }
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_TOPOLOGY_OCS_H
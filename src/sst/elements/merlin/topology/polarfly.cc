@@ -56,12 +56,32 @@ topo_polarfly::topo_polarfly(ComponentId_t cid, Params& params, int num_ports, i
         output.fatal(CALL_INFO, -1, "Number of ports should be at least %d for this configuration\n", total_radix);
     }
 
-    /* first generate the polar graph, so that we can get the number of
-     nodes and links to set the globals */
-    initPolarGraph();
+    use_shared_routes   = params.find<bool>("shared_route_table", false);
 
-    /* Initialize the routing table*/
-    initRouteTable();
+    if (use_shared_routes)
+    {
+        /* Router 0 builds the tables for every router in the network,
+         the rest attach to them during init() */
+        std::string prefix = params.find<std::string>("network_name", "network") + "_polarfly_";
+        if (router_id == 0)
+        {
+            initPolarGraph();
+            shared_routes.init_write(prefix, polar);
+            std::vector<std::vector<int>> tmp;
+            polar.swap(tmp);
+        }
+        else
+            shared_routes.init(prefix, total_routers);
+    }
+    else
+    {
+        /* first generate the polar graph, so that we can get the number of
+         nodes and links to set the globals */
+        initPolarGraph();
+
+        /* Initialize the routing table*/
+        initRouteTable();
+    }
 
     /* Initialize the hopcount_map statistic
      * For now, doing it in a dumb way, should figure out an error-free way to create a vector array of statistics*/
@@ -71,7 +91,8 @@ topo_polarfly::topo_polarfly(ComponentId_t cid, Params& params, int num_ports, i
     hopcount3 = registerStatistic<uint32_t>("hopcount3");
     hopcount4 = registerStatistic<uint32_t>("hopcount4");
 
-    adaptive_bias   = 50;
+    adaptive_bias   = params.find<int>("adaptive_bias", 50);
+    ugal_port_queue = params.find<bool>("ugal_port_queue", false);
 }
 
 topo_polarfly::~topo_polarfly(){
@@ -92,8 +113,20 @@ topo_polarfly::setOutputQueueLengthsArray(int const* array, int vcs)
     assert(vcs==num_vcs);
 }
 
+void topo_polarfly::init(unsigned int phase)
+{
+    if (phase == 0 && use_shared_routes)
+    {
+        shared_routes.getNeighbors(router_id, neighbor_list);
+        node_links  = neighbor_list.size();
+    }
+}
+
 bool topo_polarfly::isNeighbor(int node)
 {
+    if (use_shared_routes)
+        return shared_routes.getDistance(router_id, node) == 1;
+
     for (int i=0; i<node_links; i++)
     {
         if (neighbor_list[i]==node)
@@ -130,7 +163,7 @@ void topo_polarfly::routeMinimal(int port, int vc, internal_router_event* ev){
         tt_ev->setVC(0);
     }
     else{
-        out_channel = route_table[dest_node] + hosts_per_router;
+        out_channel = nextHop(dest_node) + hosts_per_router;
 
         if (tt_ev->hop_count == 0)
             tt_ev->setVC(0);
@@ -174,7 +207,7 @@ void topo_polarfly::routeValiant(int port, int vc, internal_router_event* ev){
         //First check if the packet originated here and //If yes, take the valiant path
         if ((source_node == router_id) && (tt_ev->hop_count == 0) )
         {
-            minimal_channel = route_table[dest_node];
+            minimal_channel = nextHop(dest_node);
 
             int valiant;
             //Randomly select one neighbor from the neighborhood
@@ -187,7 +220,7 @@ void topo_polarfly::routeValiant(int port, int vc, internal_router_event* ev){
             tt_ev->valiant      = valiant;
             tt_ev->non_minimal  = true;
 
-            out_channel         = route_table[valiant] + hosts_per_router;
+            out_channel         = nextHop(valiant) + hosts_per_router;
 
             tt_ev->setNextPort(out_channel);
             tt_ev->setVC(0);
@@ -196,7 +229,7 @@ void topo_polarfly::routeValiant(int port, int vc, internal_router_event* ev){
         //if you've reached the intermediate valiant node, proceed to destination along the shortest path
         else if (tt_ev->valiant==router_id || (!tt_ev->non_minimal))
         {
-            minimal_channel     = route_table[dest_node];
+            minimal_channel     = nextHop(dest_node);
             tt_ev->non_minimal  = false;
             out_channel         = minimal_channel + hosts_per_router;
 
@@ -208,7 +241,7 @@ void topo_polarfly::routeValiant(int port, int vc, internal_router_event* ev){
         //If the current router is not where the packet started, first check the minimal path
         else
         {
-            minimal_channel     = route_table[tt_ev->valiant];
+            minimal_channel     = nextHop(tt_ev->valiant);
             out_channel         = minimal_channel + hosts_per_router;
 
             tt_ev->setNextPort(out_channel);
@@ -535,8 +568,8 @@ void topo_polarfly::routeUgal(int port, int vc, internal_router_event* ev){
     else if (port < hosts_per_router)
     {
         //minpath details
-        int min_channel = route_table[dest_node] + hosts_per_router;
-        int min_queue   = output_queue_lengths[min_channel*num_vcs + out_vc];
+        int min_channel = nextHop(dest_node) + hosts_per_router;
+        int min_queue   = ugalQueue(min_channel, out_vc);
 
         //find valiant intermediate node
         int valiant, val_channel;
@@ -549,8 +582,8 @@ void topo_polarfly::routeUgal(int port, int vc, internal_router_event* ev){
             {
                 candidate   = rng->generateNextUInt32() % total_routers;
             } while(candidate == router_id);
-            int candidate_channel   = route_table[candidate] + hosts_per_router;
-            int candidate_queue     = output_queue_lengths[candidate_channel*num_vcs + out_vc];
+            int candidate_channel   = nextHop(candidate) + hosts_per_router;
+            int candidate_queue     = ugalQueue(candidate_channel, out_vc);
             if (val_queue > candidate_queue)
             {
                 val_queue   = candidate_queue;
@@ -575,14 +608,14 @@ void topo_polarfly::routeUgal(int port, int vc, internal_router_event* ev){
     }
     else if ((tt_ev->valiant == router_id && tt_ev->non_minimal) || (!tt_ev->non_minimal))
     {
-        out_channel         = route_table[dest_node] + hosts_per_router;
+        out_channel         = nextHop(dest_node) + hosts_per_router;
         out_vc              = vc + 1;
         tt_ev->non_minimal  = false;
         assert(tt_ev->hop_count < 4);
     }
     else
     {
-        out_channel         = route_table[tt_ev->valiant] + hosts_per_router;
+        out_channel         = nextHop(tt_ev->valiant) + hosts_per_router;
         out_vc              = vc + 1;
         assert(tt_ev->hop_count < 3);
     }
@@ -621,8 +654,8 @@ void topo_polarfly::routeUgalpf(int port, int vc, internal_router_event* ev){
         bool adj_dst    = isNeighbor(dest_node);
 
         //minpath details
-        int min_channel = route_table[dest_node] + hosts_per_router;
-        int min_queue   = output_queue_lengths[min_channel*num_vcs + out_vc];
+        int min_channel = nextHop(dest_node) + hosts_per_router;
+        int min_queue   = ugalQueue(min_channel, out_vc);
 
         //find valiant intermediate node
         int valiant, val_channel;
@@ -640,8 +673,8 @@ void topo_polarfly::routeUgalpf(int port, int vc, internal_router_event* ev){
                 else
                     candidate   = neighbor_list[rng->generateNextUInt32() % node_links];
             } while(candidate == router_id);
-            int candidate_channel   = route_table[candidate] + hosts_per_router;
-            int candidate_queue     = output_queue_lengths[candidate_channel*num_vcs + out_vc];
+            int candidate_channel   = nextHop(candidate) + hosts_per_router;
+            int candidate_queue     = ugalQueue(candidate_channel, out_vc);
             if (val_queue > candidate_queue)
             {
                 val_queue   = candidate_queue;
@@ -666,14 +699,14 @@ void topo_polarfly::routeUgalpf(int port, int vc, internal_router_event* ev){
     }
     else if ((tt_ev->valiant == router_id && tt_ev->non_minimal) || (!tt_ev->non_minimal))
     {
-        out_channel         = route_table[dest_node] + hosts_per_router;
+        out_channel         = nextHop(dest_node) + hosts_per_router;
         out_vc              = vc + 1;
         tt_ev->non_minimal  = false;
         assert(tt_ev->hop_count < 4);
     }
     else
     {
-        out_channel         = route_table[tt_ev->valiant] + hosts_per_router;
+        out_channel         = nextHop(tt_ev->valiant) + hosts_per_router;
         out_vc              = vc + 1;
         assert(tt_ev->hop_count < 3);
     }
@@ -62,14 +62,35 @@ topo_polarstar::topo_polarstar(ComponentId_t cid, Params& params, int num_ports,
         output.fatal(CALL_INFO, -1, "Number of ports should be at least %d for this configuration\n", total_radix);
     }
 
-    /* first generate the polar graph, so that we can get the number of
-     nodes and links to set the globals */
-    initPolarGraph();
+    use_shared_routes   = params.find<bool>("shared_route_table", false);
 
-    assert(total_routers == polar.size());
+    if (use_shared_routes)
+    {
+        /* Router 0 builds the tables for every router in the network,
+         the rest attach to them during init() */
+        std::string prefix = params.find<std::string>("network_name", "network") + "_polarstar_";
+        if (router_id == 0)
+        {
+            initPolarGraph();
+            assert(total_routers == polar.size());
+            shared_routes.init_write(prefix, polar);
+            std::vector<std::vector<int>> tmp;
+            polar.swap(tmp);
+        }
+        else
+            shared_routes.init(prefix, total_routers);
+    }
+    else
+    {
+        /* first generate the polar graph, so that we can get the number of
+         nodes and links to set the globals */
+        initPolarGraph();
 
-    /* Initialize the routing table*/
-    initRouteTable();
+        assert(total_routers == polar.size());
+
+        /* Initialize the routing table*/
+        initRouteTable();
+    }
 
     /* Initialize the hopcount_map statistic
      * For now, doing it in a dumb way, should figure out an error-free way to create a vector array of statistics*/
@@ -82,13 +103,23 @@ topo_polarstar::topo_polarstar(ComponentId_t cid, Params& params, int num_ports,
     hopcount6 = registerStatistic<uint32_t>("hopcount6");
 
 
-    adaptive_bias   = 33;
+    adaptive_bias   = params.find<int>("adaptive_bias", 33);
+    ugal_port_queue = params.find<bool>("ugal_port_queue", false);
 
 }
 
 topo_polarstar::~topo_polarstar(){
 }
 
+void topo_polarstar::init(unsigned int phase)
+{
+    if (phase == 0 && use_shared_routes)
+    {
+        shared_routes.getNeighbors(router_id, neighbor_list);
+        node_links  = neighbor_list.size();
+    }
+}
+
 void topo_polarstar::route_packet(int port, int vc, internal_router_event* ev){
 
     if (routing_algo == MINIMAL) return routeMinimal(port,vc,ev);
@@ -116,7 +147,7 @@ void topo_polarstar::routeMinimal(int port, int vc, internal_router_event* ev){
         tt_ev->setVC(0);
     }
     else{
-        out_channel = route_table[dest_node] + hosts_per_router;
+        out_channel = nextHop(dest_node) + hosts_per_router;
 
         tt_ev->setNextPort(out_channel);
 
@@ -166,7 +197,7 @@ void topo_polarstar::routeValiant(int port, int vc, internal_router_event* ev){
             tt_ev->valiant      = valiant;
             tt_ev->non_minimal  = true;
 
-            out_channel = route_table[valiant] + hosts_per_router;
+            out_channel = nextHop(valiant) + hosts_per_router;
 
             tt_ev->setNextPort(out_channel);
             assert(tt_ev->hop_count < 1);
@@ -175,7 +206,7 @@ void topo_polarstar::routeValiant(int port, int vc, internal_router_event* ev){
         //if you've reached the intermediate valiant node, proceed to destination along the shortest path
         else if (tt_ev->valiant==router_id || (!tt_ev->non_minimal))
         {
-            minimal_channel     = route_table[dest_node];
+            minimal_channel     = nextHop(dest_node);
             tt_ev->non_minimal  = false;
             out_channel         = minimal_channel + hosts_per_router;
             tt_ev->setNextPort(out_channel);
@@ -186,7 +217,7 @@ void topo_polarstar::routeValiant(int port, int vc, internal_router_event* ev){
         //If the current router is not where the packet started, first check the minimal path
         else {
 
-            minimal_channel     = route_table[tt_ev->valiant];
+            minimal_channel     = nextHop(tt_ev->valiant);
             out_channel         = minimal_channel + hosts_per_router;
 
             tt_ev->setNextPort(out_channel);
@@ -225,8 +256,8 @@ void topo_polarstar::routeUgal(int port, int vc, internal_router_event* ev){
     else if (port < hosts_per_router)
     {
         //minpath details
-        int min_channel = route_table[dest_node] + hosts_per_router;
-        int min_queue   = output_queue_lengths[min_channel*num_vcs + out_vc];
+        int min_channel = nextHop(dest_node) + hosts_per_router;
+        int min_queue   = ugalQueue(min_channel, out_vc);
 
         //find valiant intermediate node
         int valiant, val_channel;
@@ -238,9 +269,9 @@ void topo_polarstar::routeUgal(int port, int vc, internal_router_event* ev){
             do
             {
                 candidate   = rng->generateNextUInt32() % total_routers;
-                candidate_channel   = route_table[candidate] + hosts_per_router;
+                candidate_channel   = nextHop(candidate) + hosts_per_router;
             } while((candidate == router_id) || (candidate_channel == min_channel));
-            int candidate_queue     = output_queue_lengths[candidate_channel*num_vcs + out_vc];
+            int candidate_queue     = ugalQueue(candidate_channel, out_vc);
             if (val_queue > candidate_queue)
             {
                 val_queue   = candidate_queue;
@@ -266,13 +297,13 @@ void topo_polarstar::routeUgal(int port, int vc, internal_router_event* ev){
     }
     else if ((tt_ev->valiant == router_id && tt_ev->non_minimal) || (!tt_ev->non_minimal))
     {
-        out_channel         = route_table[dest_node] + hosts_per_router;
+        out_channel         = nextHop(dest_node) + hosts_per_router;
         tt_ev->non_minimal  = false;
         assert(tt_ev->hop_count < 6);
     }
     else
     {
-        out_channel         = route_table[tt_ev->valiant] + hosts_per_router;
+        out_channel         = nextHop(tt_ev->valiant) + hosts_per_router;
         assert(tt_ev->hop_count < 3);
     }
 
@@ -23,6 +23,7 @@
 #include <sstream>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/topology/routeTable.h"
 
 namespace SST {
 namespace Merlin {
@@ -122,6 +123,10 @@ public:
         {"total_radix", "Radix of the router."},
         {"total_routers", "Number of total routers in the network."},
         {"total_endnodes", "Number of total endpoints in the network."},
+        {"shared_route_table", "Build the routing tables for all routers once and share them between the routers in a rank, instead of having each router load the graph and build its own.", "false"},
+        {"network_name", "Name of the network, used to name the shared routing tables.", "network"},
+        {"adaptive_bias", "Queue length a UGAL minimal path may exceed the weighted non-minimal path by before routing non-minimally.", "33"},
+        {"ugal_port_queue", "Compare the total queue length of all VCs on a port in UGAL decisions, instead of only the VC the packet will use.", "false"},
     )
     SST_ELI_DOCUMENT_STATISTICS(
         { "hopcount1",     "Number of packets with 1 switch hopcount", "hops", 0},
@@ -155,6 +160,9 @@ public:
     std::vector<int> route_table;
     std::vector<int> neighbor_list;
 
+    bool use_shared_routes;
+    SharedRouteTable shared_routes; //tables for all routers, used instead of route_table
+
     int num_vns;
     int num_vcs;
     RNG::Random* rng;
@@ -163,6 +171,7 @@ public:
     int const* output_queue_lengths;
     int output_buffer_size;
     int adaptive_bias;
+    bool ugal_port_queue;
 
     std::vector<std::vector<int>> polar;
 
@@ -180,6 +189,8 @@ public:
     topo_polarstar(ComponentId_t cid, Params& params, int num_ports, int rtr_id, int num_vns);
     ~topo_polarstar();
 
+    virtual void init(unsigned int phase);
+
     virtual void route_packet(int port, int vc, internal_router_event* ev);
     //called at injection, add metadata about packet
     virtual internal_router_event* process_input(RtrEvent* ev);
@@ -218,7 +229,20 @@ private:
    int getDestLocalPort(int node);
    void dumpHopCount(topo_polarstar_event* ev);
 
+   //neighbor index of the minimal path to router dest
+   inline int nextHop(int dest) const {
+       return use_shared_routes ? shared_routes.getNextHop(router_id, dest) : route_table[dest];
+   }
+
    void setOutputQueueLengthsArray(int const* array, int vcs);
+
+   //queue length seen by UGAL on an output port
+   inline int ugalQueue(int channel, int vc) const {
+       if (!ugal_port_queue) return output_queue_lengths[channel*num_vcs + vc];
+       int total = 0;
+       for (int i = 0; i < num_vcs; i++) total += output_queue_lengths[channel*num_vcs + i];
+       return total;
+   }
    void setOutputBufferCreditArray(int const* array, int vcs);
 
 };
@@ -15,6 +15,7 @@
 # information, see the LICENSE file in the top level directory of the
 # distribution.
 
+import sys
 import sst
 from sst.merlin.base import *
 
@@ -23,7 +24,14 @@ class topoDragonFly(Topology):
 
     def __init__(self):
         Topology.__init__(self)
-        self._declareClassVariables(["link_latency","host_link_latency","global_link_map"])
+        # bundleLocalLinks keeps each group on a single rank when the
+        # simulation is partitioned, so only global links are cut.
+        # global_link_latency (defaults to link_latency) can be set
+        # larger to give the cut links more lookahead.
+        # native_build wires the router-to-router links in C++, which
+        # cuts config time for very large networks; routers and
+        # endpoints are still built here.
+        self._declareClassVariables(["link_latency","host_link_latency","global_link_latency","global_link_map","bundleLocalLinks","native_build"])
         self._declareParams("main",["hosts_per_router","routers_per_group","intergroup_links","intragroup_links",
                                     "num_groups","algorithm","adaptive_threshold","global_routes",
                                     "config_failed_links","failed_links"])
@@ -71,6 +79,8 @@ class topoDragonFly(Topology):
 
         if self.host_link_latency is None:
             self.host_link_latency = self.link_latency
+        if self.global_link_latency is None:
+            self.global_link_latency = self.link_latency
 
         num_peers = self.hosts_per_router * self.routers_per_group * self.num_groups
 
@@ -156,6 +166,7 @@ class topoDragonFly(Topology):
 
         router_num = 0
         nic_num = 0
+        routers = []
         # GROUPS
         for g in range(self.num_groups):
             # GROUP ROUTERS
@@ -176,25 +187,41 @@ class topoDragonFly(Topology):
                 port = 0
                 for p in range(self.hosts_per_router):
                     link = sst.Link("link_g%dr%dh%d"%(g, r, p), self.host_link_latency)
+                    if self.bundleLocalLinks:
+                        link.setNoCut()
 
                     Buildable._instanceBuildableBackCompat(endpoint, rtr, "port%d"%port, nic_num, {}, link)
-                    #link.setNoCut()
                     #rtr.addLink(link,"port%d"%port,self.host_link_latency)
                     nic_num = nic_num + 1
                     port = port + 1
 
+                if self.native_build:
+                    routers.append(rtr)
+                    router_num = router_num + 1
+                    continue
+
                 for p in range(self.routers_per_group):
                     if p != r:
                         src = min(p,r)
                         dst = max(p,r)
                         for s in range(self.intragroup_links):
-                            rtr.addLink(getLink("link_g%dr%dr%ds%d"%(g, src, dst, s)), "port%d"%port, self.link_latency)
+                            link = getLink("link_g%dr%dr%ds%d"%(g, src, dst, s))
+                            if self.bundleLocalLinks:
+                                link.setNoCut()
+                            rtr.addLink(link, "port%d"%port, self.link_latency)
                             port = port + 1
 
                 for p in range(igpr):
                     link = getGlobalLink(g,r,p)
                     if link is not None:
-                        rtr.addLink(link,"port%d"%port, self.link_latency)
+                        rtr.addLink(link,"port%d"%port, self.global_link_latency)
                     port = port +1
 
                 router_num = router_num + 1
+
+        if self.native_build:
+            sys.modules["sst.merlin"]._wire_dragonfly(routers, self.hosts_per_router, self.routers_per_group,
+                                                      self.num_groups, self.intragroup_links, igpr,
+                                                      self.global_link_map, self.global_routes == "relative",
+                                                      str(self.link_latency), str(self.global_link_latency),
+                                                      bool(self.bundleLocalLinks))
@@ -23,7 +23,10 @@ class topoFatTree(Topology):
 
     def __init__(self):
         Topology.__init__(self)
-        self._declareClassVariables(["link_latency","host_link_latency","bundleEndpoints","_ups","_downs","_routers_per_level","_groups_per_level","_start_ids",
+        # bundleLocalLinks keeps each pod (a level 1 group with its
+        # edge routers and hosts) on a single rank when the simulation
+        # is partitioned.  Only links above level 1 are cut.
+        self._declareClassVariables(["link_latency","host_link_latency","bundleEndpoints","bundleLocalLinks","_ups","_downs","_routers_per_level","_groups_per_level","_start_ids",
                                      "_total_hosts"])
         self._declareParams("main",["shape","routing_alg","adaptive_threshold"])
         self._setCallbackOnWrite("shape",self._shape_callback)
@@ -132,7 +135,7 @@ class topoFatTree(Topology):
                     (ep, port_name) = endpoint.build(node_id, {})
                     if ep:
                         hlink = sst.Link("hostlink_%d"%node_id)
-                        if self.bundleEndpoints:
+                        if self.bundleEndpoints or self.bundleLocalLinks:
                            hlink.setNoCut()
                         ep.addLink(hlink, port_name, self.host_link_latency)
                         host_links.append(hlink)
@@ -156,7 +159,10 @@ class topoFatTree(Topology):
             rtr_links = [ [] for index in range(rtrs_in_group) ]
             for i in range(rtrs_in_group):
                 for j in range(self._downs[level]):
-                    rtr_links[i].append(sst.Link("link_l%d_g%d_r%d_p%d"%(level,group,i,j)));
+                    link = sst.Link("link_l%d_g%d_r%d_p%d"%(level,group,i,j))
+                    if level == 1 and self.bundleLocalLinks:
+                        link.setNoCut()
+                    rtr_links[i].append(link);
 
             # Now create group links to pass to lower level groups from router down links
             group_links = [ [] for index in range(self._downs[level]) ]
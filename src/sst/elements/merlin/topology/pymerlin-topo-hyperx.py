@@ -24,7 +24,10 @@ class topoHyperX(Topology):
 
     def __init__(self):
         Topology.__init__(self)
-        self._declareClassVariables(["link_latency","host_link_latency","bundleEndpoints","_num_dims","_dim_size","_dim_width"])
+        # bundleLocalLinks keeps the routers along the first dimension
+        # (and their hosts) on a single rank when the simulation is
+        # partitioned.  Only links in the other dimensions are cut.
+        self._declareClassVariables(["link_latency","host_link_latency","bundleEndpoints","bundleLocalLinks","_num_dims","_dim_size","_dim_width"])
         self._declareParams("main",["shape", "width", "local_ports","algorithm"])
         self._setCallbackOnWrite("shape",self._shape_callback)
         self._setCallbackOnWrite("width",self._shape_callback)
@@ -165,7 +168,10 @@ class topoHyperX(Topology):
                         theirlocstr = self._formatShape(theirdims)
                         # Hook up "width" number of links for this dimension
                         for num in range(self._dim_width[dim]):
-                            rtr.addLink(getLink(mylocstr, theirlocstr, num), "port%d"%port, self.link_latency)
+                            link = getLink(mylocstr, theirlocstr, num)
+                            if dim == 0 and self.bundleLocalLinks:
+                                link.setNoCut()
+                            rtr.addLink(link, "port%d"%port, self.link_latency)
                             #print("Wired up port %d"%port)
                             port = port + 1
 
@@ -175,7 +181,7 @@ class topoHyperX(Topology):
                 (ep, port_name) = endpoint.build(nodeID, {})
                 if ep:
                     nicLink = sst.Link("nic_%d_%d"%(i, n))
-                    if self.bundleEndpoints:
+                    if self.bundleEndpoints or self.bundleLocalLinks:
                        nicLink.setNoCut()
                     nicLink.connect( (ep, port_name, self.host_link_latency), (rtr, "port%d"%port, self.host_link_latency) )
                 port = port+1
@@ -22,7 +22,10 @@ from sst.merlin.base import *
 class _topoMeshBase(Topology):
     def __init__(self):
         Topology.__init__(self)
-        self._declareClassVariables(["link_latency","host_link_latency","bundleEndpoints","_num_dims","_dim_size","_dim_width"])
+        # bundleLocalLinks keeps the routers along the first dimension
+        # (and their hosts) on a single rank when the simulation is
+        # partitioned.  Only links in the other dimensions are cut.
+        self._declareClassVariables(["link_latency","host_link_latency","bundleEndpoints","bundleLocalLinks","_num_dims","_dim_size","_dim_width"])
         self._declareParams("main",["shape", "width", "local_ports"])
         #self._defineOptionalParams([])
         self._setCallbackOnWrite("shape",self._shape_callback)
@@ -156,7 +159,10 @@ class _topoMeshBase(Topology):
                     theirdims[dim] = (mydims[dim] +1 ) % self._dim_size[dim]
                     theirlocstr = self._formatShape(theirdims)
                     for num in range(self._dim_width[dim]):
-                        rtr.addLink(getLink(mylocstr, theirlocstr, num), "port%d"%port, self.link_latency)
+                        link = getLink(mylocstr, theirlocstr, num)
+                        if dim == 0 and self.bundleLocalLinks:
+                            link.setNoCut()
+                        rtr.addLink(link, "port%d"%port, self.link_latency)
                         port = port+1
                 else:
                     port += self._dim_width[dim]
@@ -166,7 +172,10 @@ class _topoMeshBase(Topology):
                     theirdims[dim] = ((mydims[dim] -1) + self._dim_size[dim]) % self._dim_size[dim]
                     theirlocstr = self._formatShape(theirdims)
                     for num in range(self._dim_width[dim]):
-                        rtr.addLink(getLink(theirlocstr, mylocstr, num), "port%d"%port, self.link_latency)
+                        link = getLink(theirlocstr, mylocstr, num)
+                        if dim == 0 and self.bundleLocalLinks:
+                            link.setNoCut()
+                        rtr.addLink(link, "port%d"%port, self.link_latency)
                         port = port+1
                 else:
                     port += self._dim_width[dim]
@@ -176,7 +185,7 @@ class _topoMeshBase(Topology):
                 (ep, port_name) = endpoint.build(nodeID, {})
                 if ep:
                     nicLink = sst.Link("nic_%d_%d"%(i, n))
-                    if self.bundleEndpoints:
+                    if self.bundleEndpoints or self.bundleLocalLinks:
                        nicLink.setNoCut()
                     nicLink.connect( (ep, port_name, self.host_link_latency), (rtr, "port%d"%port, self.host_link_latency) )
                 port = port+1
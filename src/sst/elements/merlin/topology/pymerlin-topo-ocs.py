@@ -0,0 +1,101 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2025 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2025, NTESS
+# All rights reserved.
+#
+# Portions are copyright of other developers:
+# See the file CONTRIBUTORS.TXT in the top level directory
+# of the distribution for more information.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+import sst
+from sst.merlin.base import *
+
+
+class topoOCS(Topology):
+
+    def __init__(self):
+        Topology.__init__(self)
+        # circuit_latency is the latency of the optical links between
+        # ToRs and defaults to link_latency
+        self._declareClassVariables(["link_latency","host_link_latency","circuit_latency","bundleEndpoints"])
+        self._declareParams("main",["num_tors","hosts_per_tor","circuits_per_tor","core_uplinks","schedule_mode",
+                                    "schedule","slot_time","reconfig_time","circuit_guard"])
+        self.circuits_per_tor = 1
+        self.core_uplinks = 1
+        self._subscribeToPlatformParamSet("topology")
+
+    def getName(self):
+        return "OCS"
+
+    def getNumNodes(self):
+        if not self.num_tors or not self.hosts_per_tor:
+            print("topoOCS: calling getNumNodes before num_tors and hosts_per_tor were set.")
+            exit(1)
+        return int(self.num_tors) * int(self.hosts_per_tor)
+
+    def getRouterNameForId(self,rtr_id):
+        if rtr_id == int(self.num_tors):
+            return "rtr_core"
+        return "rtr_tor%d"%rtr_id
+
+    def findRouterByLocation(self,rtr_id):
+        return sst.findComponentByName(self.getRouterNameForId(rtr_id))
+
+    def _build_impl(self, endpoint):
+        if self.host_link_latency is None:
+            self.host_link_latency = self.link_latency
+        if self.circuit_latency is None:
+            self.circuit_latency = self.link_latency
+
+        num_tors = int(self.num_tors)
+        hosts_per_tor = int(self.hosts_per_tor)
+        core_uplinks = int(self.core_uplinks)
+
+        core = self._instanceRouter(num_tors * core_uplinks, num_tors)
+        topology = core.setSubComponent(self.router.getTopologySlotName(),"merlin.ocs")
+        self._applyStatisticsSettings(topology)
+        topology.addParams(self._getGroupParams("main"))
+
+        links = dict()
+        def getLink(a, b):
+            name = "circuit_%d_%d"%(min(a,b), max(a,b))
+            if name not in links:
+                links[name] = sst.Link(name)
+            return links[name]
+
+        for i in range(num_tors):
+            rtr = self._instanceRouter(hosts_per_tor + (num_tors - 1) + core_uplinks, i)
+
+            topology = rtr.setSubComponent(self.router.getTopologySlotName(),"merlin.ocs")
+            self._applyStatisticsSettings(topology)
+            topology.addParams(self._getGroupParams("main"))
+
+            port = 0
+            for n in range(hosts_per_tor):
+                nodeID = hosts_per_tor * i + n
+                (ep, port_name) = endpoint.build(nodeID, {})
+                if ep:
+                    nicLink = sst.Link("nic_%d_%d"%(i, n))
+                    if self.bundleEndpoints:
+                       nicLink.setNoCut()
+                    nicLink.connect( (ep, port_name, self.host_link_latency), (rtr, "port%d"%port, self.host_link_latency) )
+                port = port + 1
+
+            # A link to every other ToR, the topology decides which are lit
+            for j in range(num_tors):
+                if j != i:
+                    rtr.addLink(getLink(i, j), "port%d"%port, self.circuit_latency)
+                    port = port + 1
+
+            for u in range(core_uplinks):
+                link = sst.Link("uplink_%d_%d"%(i, u))
+                link.connect( (rtr, "port%d"%port, self.link_latency), (core, "port%d"%(i * core_uplinks + u), self.link_latency) )
+                port = port + 1
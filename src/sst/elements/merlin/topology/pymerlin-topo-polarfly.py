@@ -229,7 +229,7 @@ class topoPolarFly(Topology):
         self._declareClassVariables(["link_latency","host_link_latency","global_link_map","bundleEndpoints"])
         self._declareParams("main",["topo","q","hosts_per_router","network_radix","total_radix","total_routers",
                                     "total_endnodes","edge","name","algorithm","adaptive_threshold","global_routes","config_failed_links",
-                                    "failed_links", "GF", "vec_len"])
+                                    "failed_links", "shared_route_table", "adaptive_bias", "ugal_port_queue", "GF", "vec_len"])
         self.global_routes = "absolute"
         self._subscribeToPlatformParamSet("topology")
 
@@ -422,6 +422,7 @@ class topoPolarFly(Topology):
     def _build_impl(self, endpoint):
         if self._check_first_build():
             sst.addGlobalParams("params_%s"%self._instance_name, self._getGroupParams("main"))
+            sst.addGlobalParam("params_%s"%self._instance_name, "network_name", self.network_name)
 
         if self.host_link_latency is None:
             self.host_link_latency = self.link_latency
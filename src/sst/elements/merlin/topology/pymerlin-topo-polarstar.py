@@ -351,7 +351,7 @@ class topoPolarStar(Topology):
         self._declareClassVariables(["link_latency", "host_link_latency", "global_link_map", "bundleEndpoints"])
         self._declareParams("main",["topo","phi","d","sn_type","pfq","snq","pfV", "snV", "phi", "hosts_per_router","network_radix","total_radix","total_routers",
                                     "total_endnodes","edge","name","algorithm","adaptive_threshold","global_routes","config_failed_links",
-                                    "failed_links"])
+                                    "failed_links", "shared_route_table", "adaptive_bias", "ugal_port_queue"])
         self.global_routes      = "absolute"
         self._subscribeToPlatformParamSet("topology")
 
@@ -614,6 +614,7 @@ class topoPolarStar(Topology):
 
         if self._check_first_build():
             sst.addGlobalParams("params_%s"%self._instance_name, self._getGroupParams("main"))
+            sst.addGlobalParam("params_%s"%self._instance_name, "network_name", self.network_name)
 
         if self.host_link_latency is None:
             self.host_link_latency  = self.link_latency
@@ -0,0 +1,124 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+
+#include <sst_config.h>
+
+#include "merlin.h"
+#include "routeTable.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace SST::Merlin;
+
+void
+SharedRouteTable::init_write(const std::string& basename, const std::vector<std::vector<int>>& graph)
+{
+    num_routers = graph.size();
+
+    size_t num_links = 0;
+    for ( auto& n : graph ) num_links += n.size();
+
+    adj_start.initialize(basename + "route_table_adj_start", num_routers + 1);
+    adj.initialize(basename + "route_table_adj", num_links);
+    next_hop.initialize(basename + "route_table_next_hop", num_routers * num_routers, -1);
+    distance.initialize(basename + "route_table_distance", num_routers * num_routers, 0);
+
+    int start = 0;
+    for ( size_t r = 0; r < num_routers; ++r ) {
+        adj_start.write(r, start);
+        for ( int n : graph[r] ) adj.write(start++, n);
+    }
+    adj_start.write(num_routers, start);
+
+    // Breadth first search from each router.  Destinations inherit
+    // the first hop of the router they were discovered from.
+    std::vector<int> hop(num_routers);
+    std::vector<int> dist(num_routers);
+    std::vector<int> frontier;
+    std::vector<int> nxt;
+    for ( size_t src = 0; src < num_routers; ++src ) {
+        std::fill(hop.begin(), hop.end(), -1);
+        std::fill(dist.begin(), dist.end(), 0);
+        frontier.clear();
+
+        for ( size_t i = 0; i < graph[src].size(); ++i ) {
+            int neighbor = graph[src][i];
+            hop[neighbor] = i;
+            dist[neighbor] = 1;
+            frontier.push_back(neighbor);
+        }
+
+        int level = 1;
+        while ( !frontier.empty() ) {
+            level++;
+            for ( int v : frontier ) {
+                for ( int neighbor : graph[v] ) {
+                    if ( hop[neighbor] < 0 && neighbor != (int)src ) {
+                        hop[neighbor] = hop[v];
+                        dist[neighbor] = level;
+                        nxt.push_back(neighbor);
+                    }
+                }
+            }
+            frontier.swap(nxt);
+            nxt.clear();
+        }
+
+        for ( size_t dst = 0; dst < num_routers; ++dst ) {
+            if ( dst == src ) continue;
+            if ( hop[dst] < 0 ) {
+                merlin_abort.fatal(CALL_INFO, -1, "Router graph is not connected: no route from router %zu to router %zu\n", src, dst);
+            }
+            if ( hop[dst] > std::numeric_limits<int16_t>::max() || dist[dst] > std::numeric_limits<uint8_t>::max() ) {
+                merlin_abort.fatal(CALL_INFO, -1, "Router graph too large for the shared route table (router %zu)\n", src);
+            }
+            next_hop.write(src * num_routers + dst, hop[dst]);
+            distance.write(src * num_routers + dst, dist[dst]);
+        }
+    }
+
+    adj_start.publish();
+    adj.publish();
+    next_hop.publish();
+    distance.publish();
+}
+
+void
+SharedRouteTable::init(const std::string& basename, int routers)
+{
+    num_routers = routers;
+
+    adj_start.initialize(basename + "route_table_adj_start");
+    adj.initialize(basename + "route_table_adj");
+    next_hop.initialize(basename + "route_table_next_hop");
+    distance.initialize(basename + "route_table_distance");
+
+    adj_start.publish();
+    adj.publish();
+    next_hop.publish();
+    distance.publish();
+}
+
+void
+SharedRouteTable::getNeighbors(int rtr, std::vector<int>& neighbors) const
+{
+    int count = getNumNeighbors(rtr);
+    neighbors.resize(count);
+    for ( int i = 0; i < count; ++i ) {
+        neighbors[i] = getNeighbor(rtr, i);
+    }
+}
@@ -0,0 +1,83 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TOPOLOGY_ROUTETABLE_H
+#define COMPONENTS_MERLIN_TOPOLOGY_ROUTETABLE_H
+
+#include <sst/core/shared/sharedArray.h>
+
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+/*
+ * Minimal-path routing table for graph based topologies, computed once at
+ * construction and shared read-only by all the routers in a rank.
+ *
+ * The router with ID 0 calls init_write() with the router graph (the list of
+ * neighbors for each router, in port order).  It runs a breadth first search
+ * from every router and publishes, for each (router, destination) pair, the
+ * index of the neighbor to forward to and the number of router hops to the
+ * destination.  Ties are broken in favor of the lowest numbered neighbor, the
+ * same choice the per-router tables make.  All other routers call init() and
+ * only read the published data, so they do not need to load the graph at all.
+ *
+ * The data is only guaranteed to be available after construction, so
+ * lookups should not be done until init().
+ */
+class SharedRouteTable {
+private:
+    Shared::SharedArray<int> adj_start;    // offset of each router's neighbors in adj
+    Shared::SharedArray<int> adj;          // neighbor lists, concatenated
+    Shared::SharedArray<int16_t> next_hop; // neighbor index for each (router, dest)
+    Shared::SharedArray<uint8_t> distance; // router hops for each (router, dest)
+    size_t num_routers;
+
+public:
+    SharedRouteTable() : num_routers(0) {}
+
+    void init_write(const std::string& basename, const std::vector<std::vector<int>>& graph);
+    void init(const std::string& basename, int routers);
+
+    // Index into src's neighbor list of the next hop to dst, -1 if src == dst
+    inline int getNextHop(int src, int dst) const {
+        return next_hop[src * num_routers + dst];
+    }
+
+    // Number of router to router hops on a minimal path from src to dst
+    inline int getDistance(int src, int dst) const {
+        return distance[src * num_routers + dst];
+    }
+
+    inline int getNumNeighbors(int rtr) const {
+        return adj_start[rtr + 1] - adj_start[rtr];
+    }
+
+    inline int getNeighbor(int rtr, int index) const {
+        return adj[adj_start[rtr] + index];
+    }
+
+    void getNeighbors(int rtr, std::vector<int>& neighbors) const;
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_TOPOLOGY_ROUTETABLE_H
@@ -45,9 +45,16 @@ class BANK
     // determines the last write request address
     long long int last_address;
 
+    // The write in progress: when its (remaining) cell programming started, when it completes, and if and how many times it has been paused
+    long long int write_start;
+    long long int write_end;
+    long long int write_remaining;
+    bool write_paused;
+    uint32_t write_pauses;
+
 public:
 
-    BANK() { locked= false; row_buff = -1; row_buffer_dirty = false; BusyUntil = 0; locked_ts = 0;}
+    BANK() { locked= false; last_read = true; row_buff = -1; row_buffer_dirty = false; BusyUntil = 0; locked_ts = 0; write_start = 0; write_end = 0; write_remaining = 0; write_paused = false; write_pauses = 0;}
 
     void setBusyUntil(long long int x) {BusyUntil = x;}
     void set_last(bool read) { last_read = read;}
@@ -67,6 +74,18 @@ public:
 
     long long int locked_since() { return locked_ts; }
 
+    void startWrite(long long int start, long long int end) { write_start = start; write_end = end; write_paused = false; write_pauses = 0;}
+    long long int getWriteStart() { return write_start;}
+    long long int getWriteEnd() { return write_end;}
+
+    // Pause the write at time x, it keeps the part of the programming it has not done yet
+    void pauseWrite(long long int x) { write_remaining = write_end - x; write_paused = true; write_pauses++;}
+    bool isWritePaused() { return write_paused;}
+    uint32_t getWritePauses() { return write_pauses;}
+
+    // Resume the paused write at time x, returns when it completes
+    long long int resumeWrite(long long int x) { write_start = x; write_end = x + write_remaining; write_paused = false; return write_end;}
+
 };
 
 #endif
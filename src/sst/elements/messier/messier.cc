@@ -54,6 +54,34 @@ void Messier::parser(NVM_PARAMS * nvm, SST::Params& params)
 
     nvm->write_cancel_th = write_cancel_th;
 
+    uint32_t write_pause = (uint32_t) params.find<uint32_t>("write_pause", 0) ;
+
+    if(write_pause)
+        nvm->write_pause = true;
+    else
+        nvm->write_pause = false;
+
+    if(nvm->write_pause && nvm->write_cancel)
+        getSimulationOutput().fatal(CALL_INFO, -1, "%s: write_pause and write_cancel are separate modes, enable only one of them\n", getName().c_str());
+
+    nvm->write_pause_max = (uint32_t) params.find<uint32_t>("write_pause_max", 4) ;
+
+    uint32_t mlc = (uint32_t) params.find<uint32_t>("mlc", 0) ;
+
+    if(mlc)
+        nvm->mlc = true;
+    else
+        nvm->mlc = false;
+
+    nvm->mlc_min_iterations = (uint32_t) params.find<uint32_t>("mlc_min_iterations", 2) ;
+    nvm->mlc_max_iterations = (uint32_t) params.find<uint32_t>("mlc_max_iterations", 8) ;
+    nvm->tPROG = (uint32_t) params.find<uint32_t>("tPROG", 150) ;
+    nvm->tVERIFY = (uint32_t) params.find<uint32_t>("tVERIFY", 50) ;
+    nvm->mlc_seed = (uint32_t) params.find<uint32_t>("mlc_seed", 1) ;
+
+    if(nvm->mlc && (nvm->mlc_min_iterations == 0 || nvm->mlc_min_iterations > nvm->mlc_max_iterations))
+        getSimulationOutput().fatal(CALL_INFO, -1, "%s: mlc_min_iterations must be at least 1 and at most mlc_max_iterations\n", getName().c_str());
+
     if(cache_enabled)
         nvm->cache_enabled = true;
     else
@@ -89,14 +89,26 @@ public:
         {"write_cancel", "This indicates that the write cancellation optimization: 0 means not enabled", "0"},
         {"write_cancel_th", "This indicates that the write cancellation threshold: 0 means dynamic", "0"},
         {"group_size", "This indicates the number of banks in each group, to be locked when draining", "0"},
-        {"lock_period", "This indicates the period of locking a group in cycles", "10000"}
+        {"lock_period", "This indicates the period of locking a group in cycles", "10000"},
+        {"write_pause", "This indicates that the write pausing optimization: a read to a bank that is writing pauses the write, which resumes after the read. 0 means not enabled", "0"},
+        {"write_pause_max", "The maximum number of times a single write can be paused", "4"},
+        {"mlc", "This indicates multi-level cells, written with iterations of program-and-verify instead of tCL_W: 0 means single-level cells", "0"},
+        {"mlc_min_iterations", "The minimum number of program-and-verify iterations of an MLC write", "2"},
+        {"mlc_max_iterations", "The maximum number of program-and-verify iterations of an MLC write", "8"},
+        {"tPROG", "The time of a programming pulse of an MLC write (in controller cycles)", "150"},
+        {"tVERIFY", "The time of verifying the cells after a programming pulse of an MLC write (in controller cycles)", "50"},
+        {"mlc_seed", "The seed for drawing the number of iterations of each MLC write", "1"}
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
         { "reads", "Determine the number of reads", "reads", 1},
         { "writes", "Determine the number of writes", "writes", 1},
         { "avg_time", "The average time spent on each read request", "cycles", 3},
-        { "histogram_idle", "The histogram of cycles length while controller is idle", "cycles",1}
+        { "histogram_idle", "The histogram of cycles length while controller is idle", "cycles",1},
+        { "read_latency", "The latency of each read serviced by the NVM chips, use a histogram for the tail", "cycles", 1},
+        { "paused_read_latency", "The latency of each read that paused a write, use a histogram for the tail", "cycles", 1},
+        { "writes_paused", "The number of times a write was paused to service a read", "writes", 1},
+        { "mlc_iterations", "The number of program-and-verify iterations of each MLC write", "iterations", 1}
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -17,6 +17,7 @@
 #include <sst/core/link.h>
 #include <sst/elements/memHierarchy/memEvent.h>
 
+#include <algorithm>
 #include <map>
 #include <cstddef>
 #include <iostream>
@@ -65,6 +66,12 @@ NVM_DIMM::NVM_DIMM(ComponentId_t id, NVM_PARAMS par) : ComponentExtension(id)
     histogram_idle = registerStatistic<uint64_t>( "histogram_idle");
     reads = registerStatistic<uint64_t>( "reads");
     writes = registerStatistic<uint64_t>( "writes");
+    read_latency = registerStatistic<uint64_t>( "read_latency");
+    paused_read_latency = registerStatistic<uint64_t>( "paused_read_latency");
+    writes_paused = registerStatistic<uint64_t>( "writes_paused");
+    mlc_iterations = registerStatistic<uint64_t>( "mlc_iterations");
+
+    mlc_rng = new SST::RNG::MarsagliaRNG(params->mlc_seed, 1);
 
     WB = new NVM_WRITE_BUFFER(params->write_buffer_size, 0, 64 /*write buffer granularity, now assume 64B */, params->flush_th, params->flush_th_low);
 
@@ -324,7 +331,7 @@ bool NVM_DIMM::try_flush_wb()
 
             if (getRank(add)->getBusyUntil() < cycles)
             {
-                if(temp_bank->getBusyUntil() < cycles)
+                if(temp_bank->getBusyUntil() < cycles && !temp_bank->isWritePaused())
                 {
                     ready = true;
                 }
@@ -338,11 +345,13 @@ bool NVM_DIMM::try_flush_wb()
                 WB->erase_entry(temp);
                 // Note that the rank will be busy for the time of sending the data to the bank, in addition to sending the command
                 getRank(add)->setBusyUntil(cycles + params->tCMD + params->tBURST);
-                (temp_bank)->setBusyUntil(cycles + params->tCMD + params->tCL_W + params->tBURST);
+                long long int write_latency = params->mlc ? mlc_write_latency() : params->tCL_W;
+                (temp_bank)->setBusyUntil(cycles + params->tCMD + write_latency + params->tBURST);
                 temp_bank->set_last(false); // setting it to write
                 temp_bank->set_last_address(temp->Address);
+                temp_bank->startWrite(cycles + params->tCMD + params->tBURST, cycles + params->tCMD + write_latency + params->tBURST);
                 curr_writes++;
-                WRITES_COMPLETE[cycles + params->tCMD + params->tCL_W + params->tBURST]++;
+                WRITES_COMPLETE[cycles + params->tCMD + write_latency + params->tBURST]++;
 
                 delete temp;
 
@@ -469,6 +478,55 @@ bool NVM_DIMM::pop_optimal()
 
 }
 
+// MLC cells are programmed with pulses, each verified, until they hold the right level
+long long int NVM_DIMM::mlc_write_latency()
+{
+    uint32_t iterations = params->mlc_min_iterations + mlc_rng->generateNextUInt32() % (params->mlc_max_iterations - params->mlc_min_iterations + 1);
+    mlc_iterations->addData(iterations);
+    return iterations * (params->tPROG + params->tVERIFY);
+}
+
+// SLC writes pause right away, MLC writes pause at the end of the current program-and-verify iteration
+long long int NVM_DIMM::pause_point(BANK * bank)
+{
+    long long int at = std::max(cycles, bank->getWriteStart());
+    if(params->mlc)
+    {
+        long long int iteration = params->tPROG + params->tVERIFY;
+        at = bank->getWriteStart() + ((at - bank->getWriteStart() + iteration - 1)/iteration)*iteration;
+    }
+    return at;
+}
+
+bool NVM_DIMM::can_pause_write(BANK * bank)
+{
+    // Only the write the bank is busy with, and not when the write buffer must be drained
+    if(!params->write_pause || bank->read() || bank->isWritePaused() || bank->getLocked() || WB->flush())
+        return false;
+
+    if(bank->getWritePauses() >= params->write_pause_max || bank->getWriteEnd() != bank->getBusyUntil())
+        return false;
+
+    return pause_point(bank) < bank->getWriteEnd();
+}
+
+void NVM_DIMM::resume_write(BANK * bank)
+{
+    if(!bank->isWritePaused())
+        return;
+
+    // The write completes later, or again if it was due to complete while paused
+    if(WRITES_COMPLETE.find(bank->getWriteEnd())!=WRITES_COMPLETE.end())
+        WRITES_COMPLETE[bank->getWriteEnd()]--;
+    else
+        curr_writes++;
+
+    long long int end = bank->resumeWrite(cycles + params->tCMD);
+    bank->setBusyUntil(end);
+    bank->set_last(false);
+    WRITES_COMPLETE[end]++;
+}
+
 long long int last_write=0;
 
 bool NVM_DIMM::submit_request_opt()
@@ -565,7 +623,7 @@ bool NVM_DIMM::submit_request_opt()
                     BANK * corresp_bank = getBank(temp->Address);
 
                     // Check if the rank is not busy
-                    if ((!params->adaptive_writes || group_locked!=(WhichBank(temp->Address)/params->group_size)) && (HOLD.find(temp->req_ID)==HOLD.end()) &&   (corresp_rank->getBusyUntil() < cycles) && (((corresp_bank->getBusyUntil() < cycles) && !corresp_bank->getLocked()) || (params->write_cancel && !WB->flush() && !corresp_bank->read() &&(corresp_bank->getBusyUntil() - cycles < (100-4*WB->getSize())*1.0*params->tCL_W/100.0 ))) && (outstanding.size() < params->max_outstanding))
+                    if ((!params->adaptive_writes || group_locked!=(WhichBank(temp->Address)/params->group_size)) && (HOLD.find(temp->req_ID)==HOLD.end()) &&   (corresp_rank->getBusyUntil() < cycles) && (((corresp_bank->getBusyUntil() < cycles) && !corresp_bank->getLocked()) || (params->write_cancel && !WB->flush() && !corresp_bank->read() &&(corresp_bank->getBusyUntil() - cycles < (100-4*WB->getSize())*1.0*params->tCL_W/100.0 )) || can_pause_write(corresp_bank)) && (outstanding.size() < params->max_outstanding))
                     {
 
 
@@ -585,12 +643,17 @@ bool NVM_DIMM::submit_request_opt()
                         }
 
 
+                        // If this comes here due to write pausing, the read starts when the write pauses
+                        bool pause = can_pause_write(corresp_bank);
+                        long long int start = pause ? pause_point(corresp_bank) : cycles;
+
                         long long int time_ready;
                         // Check if row buffer hit
                         bool issued=false;
-                        if ( row_buffer_hit(temp->Address, corresp_bank->getRB()))
+                        bool hit = row_buffer_hit(temp->Address, corresp_bank->getRB());
+                        if (hit)
                         {
-                            time_ready = cycles + 1;
+                            time_ready = start + 1;
                             issued = true;
                         }
                         else if((params->write_weight*curr_writes + params->read_weight*curr_reads) <= (params->max_current_weight - params->read_weight))
@@ -598,18 +661,27 @@ bool NVM_DIMM::submit_request_opt()
 
 
                             // Allocate the Rank circuitary to submit the command
-                            corresp_rank->setBusyUntil(cycles + params->tCMD);
+                            corresp_rank->setBusyUntil(start + params->tCMD);
                             // Set the bank busy until we read it
-                            corresp_bank->setBusyUntil(cycles + params->tCMD + params->tRCD);
+                            corresp_bank->setBusyUntil(start + params->tCMD + params->tRCD);
                             corresp_bank->set_last(true);
-                            time_ready = cycles + params->tRCD + params->tCMD;
+                            time_ready = start + params->tRCD + params->tCMD;
                             curr_reads++;
-                            READS_COMPLETE[cycles + params->tRCD + params->tCMD]++;
+                            READS_COMPLETE[start + params->tRCD + params->tCMD]++;
                             corresp_bank->setRB(temp->Address/params->row_buffer_size);
                             issued = true;
                         }
                         if(issued)
                         {
+                            if(pause)
+                            {
+                                // The write resumes once the read is done with the bank
+                                corresp_bank->pauseWrite(start);
+                                if(hit)
+                                    corresp_bank->setBusyUntil(start);
+                                PAUSED[temp->req_ID] = 1;
+                                writes_paused->addData(1);
+                            }
                             outstanding.push_back(temp);
                             transactions.erase(st);
                             removed=true;
@@ -680,6 +752,12 @@ void NVM_DIMM::handleEvent( SST::Event* e )
             NVM_Request * temp = req;
 
             histogram_idle->addData((cycles - TIME_STAMP[temp])/1000);
+            read_latency->addData(cycles - TIME_STAMP[temp]);
+            if(PAUSED.find(temp->req_ID)!=PAUSED.end())
+            {
+                paused_read_latency->addData(cycles - TIME_STAMP[temp]);
+                PAUSED.erase(temp->req_ID);
+            }
             TIME_STAMP.erase(temp);
             if(SQUASHED.find(temp->req_ID)==SQUASHED.end())
             {
@@ -747,6 +825,7 @@ void NVM_DIMM::handleEvent( SST::Event* e )
                 }
 
             (getBank(req->Address))->setLocked(false, cycles);
+            resume_write(getBank(req->Address));
             ready_trans.erase(req);
             outstanding.remove(req);
             delete req;
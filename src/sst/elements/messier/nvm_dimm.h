@@ -18,6 +18,7 @@
 #include <sst/core/componentExtension.h>
 #include <sst/core/timeConverter.h>
 #include <sst/core/link.h>
+#include <sst/core/rng/marsaglia.h>
 #include <sst/elements/memHierarchy/memEvent.h>
 
 #include <map>
@@ -113,6 +114,12 @@ namespace MessierComponent{
 
         std::map<int, int> bank_hist;
 
+        // This keeps track of the reads that paused a write
+        std::map<long long int, int> PAUSED;
+
+        // This draws the number of program-and-verify iterations of MLC writes
+        SST::RNG::MarsagliaRNG * mlc_rng;
+
         int group_locked;
 
         public:
@@ -166,10 +173,24 @@ namespace MessierComponent{
         void handleEvent(SST::Event* event);
         // This is used to check if it is a row buffer hit or miss
         bool row_buffer_hit(long long int add, long long int bank_add);
+
+        // This returns the cell programming time of an MLC write
+        long long int mlc_write_latency();
+
+        // This is used to check if the write in progress at a bank can be paused to service a read, and when it would pause
+        bool can_pause_write(BANK * bank);
+        long long int pause_point(BANK * bank);
+
+        // This resumes the write paused at a bank, if any
+        void resume_write(BANK * bank);
         Statistic<uint64_t>* histogram_idle;
 
         Statistic<uint64_t>* reads;
         Statistic<uint64_t>* writes;
+        Statistic<uint64_t>* read_latency;
+        Statistic<uint64_t>* paused_read_latency;
+        Statistic<uint64_t>* writes_paused;
+        Statistic<uint64_t>* mlc_iterations;
 
     };
 }
@@ -149,6 +149,28 @@ class NVM_PARAMS
         // This indicates the write cancellation threshold
         uint32_t write_cancel_th;
 
+        // This indicates if writes in progress can be paused to service reads, then resumed
+        bool write_pause;
+
+        // This indicates the maximum number of times a single write can be paused
+        uint32_t write_pause_max;
+
+        // This indicates if the cells are multi-level, written with iterations of program-and-verify
+        bool mlc;
+
+        // This indicates the minimum and maximum number of program-and-verify iterations of an MLC write
+        uint32_t mlc_min_iterations;
+        uint32_t mlc_max_iterations;
+
+        // The latency of a programming pulse of an MLC write
+        uint32_t tPROG;
+
+        // The latency of verifying the cells after each programming pulse of an MLC write
+        uint32_t tVERIFY;
+
+        // The seed for drawing the number of iterations of each MLC write
+        uint32_t mlc_seed;
+
 
     public:
 
@@ -229,6 +251,22 @@ class NVM_PARAMS
 
             write_cancel_th = D.write_cancel_th;
 
+            write_pause = D.write_pause;
+
+            write_pause_max = D.write_pause_max;
+
+            mlc = D.mlc;
+
+            mlc_min_iterations = D.mlc_min_iterations;
+
+            mlc_max_iterations = D.mlc_max_iterations;
+
+            tPROG = D.tPROG;
+
+            tVERIFY = D.tVERIFY;
+
+            mlc_seed = D.mlc_seed;
+
         }
 };
 
@@ -0,0 +1,170 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/bfsgen.h>
+
+using namespace SST::Miranda;
+
+BFSGenerator::BFSGenerator( ComponentId_t id, Params& params ) : RequestGenerator(id, params) {
+	const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+	out = new Output("BFSGenerator[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+	const std::string graphFile = params.find<std::string>("graph_file", "");
+	if("" == graphFile) {
+		out->fatal(CALL_INFO, -1, "BFSGenerator requires a graph_file\n");
+	}
+
+	graph = new MirandaCSRFile(graphFile, out);
+	if(graph->rows() != graph->cols()) {
+		out->fatal(CALL_INFO, -1, "BFSGenerator graph %s is not square (%" PRIu64 " x %" PRIu64 ")\n",
+			graphFile.c_str(), graph->rows(), graph->cols());
+	}
+
+	sourceVertex = params.find<uint64_t>("source_vertex", 0);
+	if(sourceVertex >= graph->rows()) {
+		out->fatal(CALL_INFO, -1, "BFSGenerator source_vertex %" PRIu64 " is not a vertex of the %" PRIu64 " vertex graph\n",
+			sourceVertex, graph->rows());
+	}
+
+	maxLevels    = params.find<uint64_t>("max_levels", 0);
+	elementWidth = params.find<uint64_t>("element_width", 8);
+	indexWidth   = graph->indexBytes();
+	limiter      = new MirandaMLPLimiter(params.find<uint64_t>("mlp", 0));
+
+	uint64_t nextStartAddr = params.find<uint64_t>("start_addr", 0);
+
+	rowStartAddr = nextStartAddr;
+	nextStartAddr += (graph->rows() + 1) * sizeof(uint64_t);
+	columnAddr = nextStartAddr;
+	nextStartAddr += graph->nnz() * indexWidth;
+	parentAddr = nextStartAddr;
+	nextStartAddr += graph->rows() * elementWidth;
+	frontierAddr[0] = nextStartAddr;
+	nextStartAddr += graph->rows() * indexWidth;
+	frontierAddr[1] = nextStartAddr;
+
+	out->verbose(CALL_INFO, 1, 0, "Searching a graph of %" PRIu64 " vertices and %" PRIu64 " edges from vertex %" PRIu64 "\n",
+		graph->rows(), graph->nnz(), sourceVertex);
+
+	visited.resize(graph->rows(), false);
+	frontierPos = 0;
+	currentFrontier = 0;
+	level = 0;
+	started = false;
+}
+
+BFSGenerator::~BFSGenerator() {
+	delete limiter;
+	delete graph;
+	delete out;
+}
+
+void BFSGenerator::expandVertex(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t vertex) {
+	MemoryOpRequest* readFrontier = new MemoryOpRequest(frontierAddr[currentFrontier] + (frontierPos * indexWidth), indexWidth, READ);
+	MemoryOpRequest* readStart = new MemoryOpRequest(rowStartAddr + (vertex * sizeof(uint64_t)), sizeof(uint64_t), READ);
+	MemoryOpRequest* readEnd   = new MemoryOpRequest(rowStartAddr + ((vertex + 1) * sizeof(uint64_t)), sizeof(uint64_t), READ);
+
+	limiter->startUnit(readFrontier);
+	readStart->addDependency(readFrontier->getRequestID());
+	readEnd->addDependency(readFrontier->getRequestID());
+
+	q->push_back(readFrontier);
+	q->push_back(readStart);
+	q->push_back(readEnd);
+
+	GeneratorRequest* last = readEnd;
+	const uint64_t edgeEnd = graph->rowEnd(vertex);
+
+	for(uint64_t edge = graph->rowStart(vertex); edge < edgeEnd; ++edge) {
+		const uint64_t neighbour = graph->column(edge);
+
+		MemoryOpRequest* readCol = new MemoryOpRequest(columnAddr + (edge * indexWidth), indexWidth, READ);
+		MemoryOpRequest* readParent = new MemoryOpRequest(parentAddr + (neighbour * elementWidth), elementWidth, READ);
+
+		readCol->addDependency(readStart->getRequestID());
+		readCol->addDependency(readEnd->getRequestID());
+		readParent->addDependency(readCol->getRequestID());
+
+		q->push_back(readCol);
+		q->push_back(readParent);
+		last = readParent;
+
+		// The search is run here as well, so a neighbour is claimed exactly when the real search would
+		if(neighbour < visited.size() && !visited[neighbour]) {
+			visited[neighbour] = true;
+
+			MemoryOpRequest* writeParent = new MemoryOpRequest(parentAddr + (neighbour * elementWidth), elementWidth, WRITE);
+			MemoryOpRequest* writeNext = new MemoryOpRequest(frontierAddr[1 - currentFrontier] + (nextFrontier.size() * indexWidth), indexWidth, WRITE);
+
+			writeParent->addDependency(readParent->getRequestID());
+			writeNext->addDependency(readParent->getRequestID());
+
+			q->push_back(writeParent);
+			q->push_back(writeNext);
+			last = writeNext;
+
+			nextFrontier.push_back(neighbour);
+		}
+	}
+
+	limiter->endUnit(last);
+}
+
+void BFSGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	if(!started) {
+		started = true;
+		visited[sourceVertex] = true;
+		frontier.push_back(sourceVertex);
+
+		q->push_back(new MemoryOpRequest(parentAddr + (sourceVertex * elementWidth), elementWidth, WRITE));
+		q->push_back(new MemoryOpRequest(frontierAddr[currentFrontier], indexWidth, WRITE));
+		return;
+	}
+
+	if(frontierPos < frontier.size()) {
+		out->verbose(CALL_INFO, 4, 0, "Level %" PRIu64 ", expanding vertex %" PRIu64 "\n", level, frontier[frontierPos]);
+		expandVertex(q, frontier[frontierPos]);
+		frontierPos++;
+		return;
+	}
+
+	// The level is complete, every vertex of the next one must wait for it
+	out->verbose(CALL_INFO, 2, 0, "Level %" PRIu64 " expanded %" PRIu64 " vertices, next level has %" PRIu64 "\n",
+		level, (uint64_t) frontier.size(), (uint64_t) nextFrontier.size());
+
+	frontier.swap(nextFrontier);
+	nextFrontier.clear();
+	frontierPos = 0;
+	currentFrontier = 1 - currentFrontier;
+	level++;
+
+	if(maxLevels > 0 && level >= maxLevels) {
+		frontier.clear();
+	}
+
+	if(!frontier.empty()) {
+		q->push_back(new FenceOpRequest());
+	}
+}
+
+bool BFSGenerator::isFinished() {
+	return started && frontierPos >= frontier.size() && nextFrontier.empty();
+}
+
+void BFSGenerator::completed() {
+
+}
@@ -0,0 +1,84 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_MIRANDA_BFS_GEN
+#define _H_SST_MIRANDA_BFS_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/elements/miranda/generators/csrfile.h>
+#include <sst/core/output.h>
+
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+class BFSGenerator : public RequestGenerator {
+
+public:
+	BFSGenerator( ComponentId_t id, Params& params );
+	~BFSGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+        BFSGenerator,
+        "miranda",
+        "BFSGenerator",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Creates the accesses of a level synchronous breadth first search over a CSR graph file",
+        SST::Miranda::RequestGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+		{ "verbose",          "Sets the verbosity output of the generator", "0" },
+		{ "graph_file",       "Graph adjacency in the Miranda binary CSR format (see miranda-csr-convert)", "" },
+		{ "source_vertex",    "Vertex the search starts from", "0" },
+		{ "max_levels",       "Stop after this many levels of the search, 0 searches the whole component", "0" },
+		{ "element_width",    "Width of an entry of the parent array", "8" },
+		{ "start_addr",       "Address the row starts, column indices, parent array and frontiers are laid out from", "0" },
+		{ "mlp",              "Maximum number of frontier vertices expanded at once, 0 leaves it to the CPU window", "0" }
+    )
+
+private:
+	void expandVertex(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t vertex);
+
+	Output* out;
+	MirandaCSRFile* graph;
+	MirandaMLPLimiter* limiter;
+
+	uint64_t elementWidth;
+	uint64_t indexWidth;
+	uint64_t rowStartAddr;
+	uint64_t columnAddr;
+	uint64_t parentAddr;
+	uint64_t frontierAddr[2];
+
+	std::vector<bool> visited;
+	std::vector<uint64_t> frontier;
+	std::vector<uint64_t> nextFrontier;
+	uint64_t frontierPos;
+	uint32_t currentFrontier;
+	uint64_t level;
+	uint64_t maxLevels;
+	uint64_t sourceVertex;
+	bool started;
+};
+
+}
+}
+
+#endif
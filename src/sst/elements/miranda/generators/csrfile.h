@@ -0,0 +1,181 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_MIRANDA_CSR_FILE
+#define _H_SST_MIRANDA_CSR_FILE
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/core/output.h>
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <deque>
+#include <string>
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * Binary compressed sparse row file read by the graph and sparse generators.
+ * miranda-csr-convert writes it from a Matrix Market file or an edge list.
+ *
+ *   char     magic[8]        "MIRCSR01"
+ *   uint64_t rows, columns, nnz
+ *   uint32_t index_width     width in bytes of a column index, 4 or 8
+ *   uint32_t reserved
+ *   uint64_t row_start[rows + 1]
+ *   column indices[nnz]
+ *
+ * The file is mapped rather than read so large graphs open immediately and
+ * only the parts a generator walks are paged in.
+ */
+#define MIRANDA_CSR_MAGIC "MIRCSR01"
+
+class MirandaCSRFile {
+public:
+	MirandaCSRFile(const std::string& path, Output* out) : mapping(NULL), mappingLength(0) {
+		int fd = open(path.c_str(), O_RDONLY);
+
+		if(fd < 0) {
+			out->fatal(CALL_INFO, -1, "Unable to open CSR file %s\n", path.c_str());
+		}
+
+		struct stat fileStat;
+		if(0 != fstat(fd, &fileStat) || (size_t) fileStat.st_size < headerLength()) {
+			out->fatal(CALL_INFO, -1, "CSR file %s is too short to hold a header\n", path.c_str());
+		}
+
+		mappingLength = (size_t) fileStat.st_size;
+		void* region = mmap(NULL, mappingLength, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+
+		if(MAP_FAILED == region) {
+			out->fatal(CALL_INFO, -1, "Unable to map CSR file %s\n", path.c_str());
+		}
+
+		mapping = (const char*) region;
+
+		uint32_t reserved;
+		memcpy(&rowCount,    mapping + 8,  sizeof(uint64_t));
+		memcpy(&columnCount, mapping + 16, sizeof(uint64_t));
+		memcpy(&nnzCount,    mapping + 24, sizeof(uint64_t));
+		memcpy(&indexWidth,  mapping + 32, sizeof(uint32_t));
+		memcpy(&reserved,    mapping + 36, sizeof(uint32_t));
+
+		if(0 != memcmp(mapping, MIRANDA_CSR_MAGIC, 8)) {
+			out->fatal(CALL_INFO, -1, "%s is not a Miranda CSR file, convert it with miranda-csr-convert\n", path.c_str());
+		}
+
+		if(4 != indexWidth && 8 != indexWidth) {
+			out->fatal(CALL_INFO, -1, "CSR file %s has an unsupported index width of %" PRIu32 " bytes\n", path.c_str(), indexWidth);
+		}
+
+		if(mappingLength < headerLength() + ((rowCount + 1) * sizeof(uint64_t)) + (nnzCount * indexWidth)) {
+			out->fatal(CALL_INFO, -1, "CSR file %s is truncated, it should hold %" PRIu64 " rows and %" PRIu64 " non-zeros\n",
+				path.c_str(), rowCount, nnzCount);
+		}
+
+		rowStarts = mapping + headerLength();
+		columns = rowStarts + ((rowCount + 1) * sizeof(uint64_t));
+
+		madvise((void*) mapping, mappingLength, MADV_SEQUENTIAL);
+	}
+
+	~MirandaCSRFile() {
+		if(NULL != mapping) {
+			munmap((void*) mapping, mappingLength);
+		}
+	}
+
+	uint64_t rows() const { return rowCount; }
+	uint64_t cols() const { return columnCount; }
+	uint64_t nnz() const { return nnzCount; }
+	uint32_t indexBytes() const { return indexWidth; }
+
+	uint64_t rowStart(const uint64_t row) const {
+		uint64_t start;
+		memcpy(&start, rowStarts + (row * sizeof(uint64_t)), sizeof(start));
+		return start;
+	}
+
+	uint64_t rowEnd(const uint64_t row) const {
+		return rowStart(row + 1);
+	}
+
+	uint64_t column(const uint64_t index) const {
+		if(4 == indexWidth) {
+			uint32_t col;
+			memcpy(&col, columns + (index * 4), sizeof(col));
+			return col;
+		}
+
+		uint64_t col;
+		memcpy(&col, columns + (index * 8), sizeof(col));
+		return col;
+	}
+
+private:
+	static size_t headerLength() { return 8 + (3 * sizeof(uint64_t)) + (2 * sizeof(uint32_t)); }
+
+	const char* mapping;
+	size_t mappingLength;
+	const char* rowStarts;
+	const char* columns;
+
+	uint64_t rowCount;
+	uint64_t columnCount;
+	uint64_t nnzCount;
+	uint32_t indexWidth;
+};
+
+/*
+ * Limits how many units of work (a vertex, a row, a sample) a generator has
+ * in flight. The first requests of a unit, those without another dependency,
+ * depend on the last request of the unit mlp places before it, 0 leaves the
+ * window to the CPU.
+ */
+class MirandaMLPLimiter {
+public:
+	MirandaMLPLimiter(const uint64_t maxUnits) : mlp(maxUnits) {}
+
+	void startUnit(GeneratorRequest* first, GeneratorRequest* second = NULL) {
+		if(mlp > 0 && unitEnds.size() == mlp) {
+			first->addDependency(unitEnds.front());
+			if(NULL != second) {
+				second->addDependency(unitEnds.front());
+			}
+			unitEnds.pop_front();
+		}
+	}
+
+	void endUnit(const GeneratorRequest* last) {
+		if(mlp > 0) {
+			unitEnds.push_back(last->getRequestID());
+		}
+	}
+
+private:
+	const uint64_t mlp;
+	std::deque<uint64_t> unitEnds;
+};
+
+}
+}
+
+#endif
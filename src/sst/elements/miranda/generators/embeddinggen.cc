@@ -0,0 +1,170 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/core/rng/marsaglia.h>
+#include <sst/elements/miranda/generators/embeddinggen.h>
+
+#include <algorithm>
+
+using namespace SST::Miranda;
+
+EmbeddingGatherGenerator::EmbeddingGatherGenerator( ComponentId_t id, Params& params ) : RequestGenerator(id, params) {
+	const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+	out = new Output("EmbeddingGatherGenerator[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+	const std::string indicesFile = params.find<std::string>("indices_file", "");
+
+	if("" == indicesFile) {
+		indices = NULL;
+		tableRows = params.find<uint64_t>("table_rows", 1048576);
+		samples = params.find<uint64_t>("samples", 1024);
+		lookupsPerSample = params.find<uint64_t>("lookups_per_sample", 32);
+		indexWidth = sizeof(uint64_t);
+	} else {
+		indices = new MirandaCSRFile(indicesFile, out);
+		tableRows = indices->cols();
+		samples = indices->rows();
+		lookupsPerSample = 0;
+		indexWidth = indices->indexBytes();
+	}
+
+	if(0 == tableRows) {
+		out->fatal(CALL_INFO, -1, "EmbeddingGatherGenerator requires a table with at least one row\n");
+	}
+
+	rowBytes   = params.find<uint64_t>("embedding_dim", 64) * params.find<uint64_t>("element_width", 4);
+	lineSize   = params.find<uint64_t>("cache_line_size", 64);
+	iterations = params.find<uint64_t>("iterations", 1);
+	limiter    = new MirandaMLPLimiter(params.find<uint64_t>("mlp", 0));
+
+	if(0 == lineSize) {
+		out->fatal(CALL_INFO, -1, "EmbeddingGatherGenerator requires a non-zero cache_line_size\n");
+	}
+
+	rng = new MarsagliaRNG(params.find<unsigned int>("seed_a", 11), params.find<unsigned int>("seed_b", 31));
+
+	const uint64_t lookups = (NULL == indices) ? (samples * lookupsPerSample) : indices->nnz();
+	uint64_t nextStartAddr = params.find<uint64_t>("start_addr", 0);
+
+	offsetAddr = nextStartAddr;
+	nextStartAddr += (samples + 1) * sizeof(uint64_t);
+	indexAddr = nextStartAddr;
+	nextStartAddr += lookups * indexWidth;
+	tableAddr = nextStartAddr;
+	nextStartAddr += tableRows * rowBytes;
+	outputAddr = nextStartAddr;
+
+	out->verbose(CALL_INFO, 1, 0, "Pooling %" PRIu64 " samples with %" PRIu64 " lookups from a %" PRIu64 " row table of %" PRIu64 " byte rows\n",
+		samples, lookups, tableRows, rowBytes);
+
+	lineReads.resize((rowBytes + lineSize - 1) / lineSize);
+	iteration = 0;
+	sample = 0;
+}
+
+EmbeddingGatherGenerator::~EmbeddingGatherGenerator() {
+	delete limiter;
+	delete rng;
+	if(NULL != indices) {
+		delete indices;
+	}
+	delete out;
+}
+
+void EmbeddingGatherGenerator::poolSample(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t s) {
+	MemoryOpRequest* readStart = new MemoryOpRequest(offsetAddr + (s * sizeof(uint64_t)), sizeof(uint64_t), READ);
+	MemoryOpRequest* readEnd   = new MemoryOpRequest(offsetAddr + ((s + 1) * sizeof(uint64_t)), sizeof(uint64_t), READ);
+
+	limiter->startUnit(readStart, readEnd);
+	q->push_back(readStart);
+	q->push_back(readEnd);
+
+	for(uint64_t line = 0; line < lineReads.size(); ++line) {
+		lineReads[line].clear();
+	}
+
+	const uint64_t first = (NULL == indices) ? (s * lookupsPerSample) : indices->rowStart(s);
+	const uint64_t last  = (NULL == indices) ? (first + lookupsPerSample) : indices->rowEnd(s);
+
+	for(uint64_t p = first; p < last; ++p) {
+		MemoryOpRequest* readIndex = new MemoryOpRequest(indexAddr + (p * indexWidth), indexWidth, READ);
+		readIndex->addDependency(readStart->getRequestID());
+		readIndex->addDependency(readEnd->getRequestID());
+		q->push_back(readIndex);
+
+		const uint64_t tableRow = (NULL == indices) ? (rng->generateNextUInt64() % tableRows) :
+			(indices->column(p) % tableRows);
+		const uint64_t rowAddr = tableAddr + (tableRow * rowBytes);
+
+		for(uint64_t line = 0; line < lineReads.size(); ++line) {
+			const uint64_t offset = line * lineSize;
+			const uint64_t length = std::min(lineSize, rowBytes - offset);
+
+			MemoryOpRequest* readLine = new MemoryOpRequest(rowAddr + offset, length, READ);
+			readLine->addDependency(readIndex->getRequestID());
+			lineReads[line].push_back(readLine->getRequestID());
+			q->push_back(readLine);
+		}
+	}
+
+	// Each line of the pooled row is the sum of that line of every gathered row
+	const uint64_t pooledAddr = outputAddr + (s * rowBytes);
+	GeneratorRequest* lastWrite = readEnd;
+
+	for(uint64_t line = 0; line < lineReads.size(); ++line) {
+		const uint64_t offset = line * lineSize;
+		MemoryOpRequest* writeLine = new MemoryOpRequest(pooledAddr + offset, std::min(lineSize, rowBytes - offset), WRITE);
+
+		writeLine->addDependency(readEnd->getRequestID());
+		for(uint64_t n = 0; n < lineReads[line].size(); ++n) {
+			writeLine->addDependency(lineReads[line][n]);
+		}
+
+		if(lastWrite != readEnd) {
+			writeLine->addDependency(lastWrite->getRequestID());
+		}
+
+		q->push_back(writeLine);
+		lastWrite = writeLine;
+	}
+
+	limiter->endUnit(lastWrite);
+}
+
+void EmbeddingGatherGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	if(0 == samples) {
+		iteration = iterations;
+		return;
+	}
+
+	out->verbose(CALL_INFO, 4, 0, "Iteration %" PRIu64 ", pooling sample %" PRIu64 "\n", iteration, sample);
+	poolSample(q, sample);
+	sample++;
+
+	if(sample == samples) {
+		sample = 0;
+		iteration++;
+	}
+}
+
+bool EmbeddingGatherGenerator::isFinished() {
+	return iteration >= iterations;
+}
+
+void EmbeddingGatherGenerator::completed() {
+
+}
@@ -0,0 +1,96 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_MIRANDA_EMBEDDING_GEN
+#define _H_SST_MIRANDA_EMBEDDING_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/elements/miranda/generators/csrfile.h>
+#include <sst/core/output.h>
+#include <sst/core/rng/rng.h>
+
+#include <vector>
+
+using namespace SST::RNG;
+
+namespace SST {
+namespace Miranda {
+
+class EmbeddingGatherGenerator : public RequestGenerator {
+
+public:
+	EmbeddingGatherGenerator( ComponentId_t id, Params& params );
+	~EmbeddingGatherGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+        EmbeddingGatherGenerator,
+        "miranda",
+        "EmbeddingGatherGenerator",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Creates the accesses of pooled embedding table lookups, as made by recommendation models",
+        SST::Miranda::RequestGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+		{ "verbose",            "Sets the verbosity output of the generator", "0" },
+		{ "indices_file",       "Lookups in the Miranda binary CSR format, one row per sample holding the table rows it pools. Random lookups are made when this is not set", "" },
+		{ "table_rows",         "Number of rows in the embedding table, taken from the indices file when one is given", "1048576" },
+		{ "embedding_dim",      "Number of elements in an embedding row", "64" },
+		{ "element_width",      "Width of an embedding element", "4" },
+		{ "samples",            "Number of samples when lookups are random", "1024" },
+		{ "lookups_per_sample", "Number of table rows pooled by each sample when lookups are random", "32" },
+		{ "iterations",         "Number of passes over the samples", "1" },
+		{ "seed_a",             "Sets the seed-a for the random lookups", "11" },
+		{ "seed_b",             "Sets the seed-b for the random lookups", "31" },
+		{ "cache_line_size",    "Size of a cache line, embedding rows are gathered a line at a time", "64" },
+		{ "start_addr",         "Address the offsets, indices, table and pooled output are laid out from", "0" },
+		{ "mlp",                "Maximum number of samples pooled at once, 0 leaves it to the CPU window", "0" }
+    )
+
+private:
+	void poolSample(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t sample);
+
+	Output* out;
+	MirandaCSRFile* indices;
+	Random* rng;
+	MirandaMLPLimiter* limiter;
+
+	uint64_t tableRows;
+	uint64_t rowBytes;
+	uint64_t lineSize;
+	uint64_t samples;
+	uint64_t lookupsPerSample;
+	uint64_t indexWidth;
+
+	uint64_t offsetAddr;
+	uint64_t indexAddr;
+	uint64_t tableAddr;
+	uint64_t outputAddr;
+
+	uint64_t iterations;
+	uint64_t iteration;
+	uint64_t sample;
+
+	// The gather of each line of the pooled row, it is written once all of them are read
+	std::vector< std::vector<uint64_t> > lineReads;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,587 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/loopnestgen.h>
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+using namespace SST::Miranda;
+
+static std::string trimSpaces(const std::string& text) {
+	const size_t first = text.find_first_not_of(" \t\n");
+	if(std::string::npos == first) {
+		return "";
+	}
+	return text.substr(first, text.find_last_not_of(" \t\n") - first + 1);
+}
+
+static std::vector<std::string> splitList(const std::string& text, const char separator) {
+	std::vector<std::string> items;
+	size_t start = 0;
+
+	while(start <= text.size()) {
+		size_t end = text.find(separator, start);
+		if(std::string::npos == end) {
+			end = text.size();
+		}
+
+		const std::string item = trimSpaces(text.substr(start, end - start));
+		if("" != item) {
+			items.push_back(item);
+		}
+		start = end + 1;
+	}
+
+	return items;
+}
+
+static void skipSpaces(const std::string& text, size_t& pos) {
+	while(pos < text.size() && isspace(text[pos])) {
+		pos++;
+	}
+}
+
+static std::string readName(const std::string& text, size_t& pos) {
+	skipSpaces(text, pos);
+	const size_t start = pos;
+	while(pos < text.size() && (isalnum(text[pos]) || '_' == text[pos])) {
+		pos++;
+	}
+	return text.substr(start, pos - start);
+}
+
+LoopNestGenerator::LoopNestGenerator( ComponentId_t id, Params& params ) : RequestGenerator(id, params) {
+	const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+	out = new Output("LoopNestGenerator[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+	batch = params.find<uint64_t>("batch", 16);
+	seed  = params.find<uint64_t>("seed", 1);
+
+	if(0 == batch) {
+		batch = 1;
+	}
+
+	parseLoops(params.find<std::string>("loops", ""));
+	parseArrays(params.find<std::string>("arrays", ""));
+	parseIndexArrays(params.find<std::string>("index_arrays", ""));
+	parseStatements(params.find<std::string>("statements", ""));
+
+	const std::string fenceAfter = trimSpaces(params.find<std::string>("fence_after", ""));
+	fenceLevel = -1;
+
+	if("" != fenceAfter) {
+		for(uint32_t i = 0; i < loops.size(); ++i) {
+			if(loops[i].name == fenceAfter) {
+				fenceLevel = (int32_t) i;
+			}
+		}
+
+		if(fenceLevel < 0) {
+			out->fatal(CALL_INFO, -1, "fence_after names %s, which is not one of the loops\n", fenceAfter.c_str());
+		}
+	}
+
+	compile();
+}
+
+LoopNestGenerator::~LoopNestGenerator() {
+	delete out;
+}
+
+void LoopNestGenerator::parseLoops(const std::string& spec) {
+	const std::vector<std::string> items = splitList(spec, ',');
+
+	if(items.empty()) {
+		out->fatal(CALL_INFO, -1, "LoopNestGenerator requires at least one loop in the loops parameter\n");
+	}
+
+	for(uint32_t i = 0; i < items.size(); ++i) {
+		const size_t equals = items[i].find('=');
+		const std::vector<std::string> bounds = splitList(std::string::npos == equals ? "" : items[i].substr(equals + 1), ':');
+
+		if(bounds.size() < 2 || bounds.size() > 3) {
+			out->fatal(CALL_INFO, -1, "Loop \"%s\" is not of the form name=start:end[:step]\n", items[i].c_str());
+		}
+
+		LoopNestLoop loop;
+		loop.name  = trimSpaces(items[i].substr(0, equals));
+		loop.start = strtoll(bounds[0].c_str(), NULL, 0);
+		loop.step  = (3 == bounds.size()) ? strtoll(bounds[2].c_str(), NULL, 0) : 1;
+
+		const int64_t end = strtoll(bounds[1].c_str(), NULL, 0);
+
+		if(0 == loop.step) {
+			out->fatal(CALL_INFO, -1, "Loop %s has a step of zero\n", loop.name.c_str());
+		}
+
+		if(loop.step > 0) {
+			loop.trips = (end > loop.start) ? (uint64_t) ((end - loop.start + loop.step - 1) / loop.step) : 0;
+		} else {
+			loop.trips = (end < loop.start) ? (uint64_t) ((loop.start - end - loop.step - 1) / (-loop.step)) : 0;
+		}
+
+		loops.push_back(loop);
+	}
+}
+
+void LoopNestGenerator::parseArrays(const std::string& spec) {
+	const std::vector<std::string> items = splitList(spec, ',');
+
+	for(uint32_t i = 0; i < items.size(); ++i) {
+		const size_t equals = items[i].find('=');
+		const std::vector<std::string> fields = splitList(std::string::npos == equals ? "" : items[i].substr(equals + 1), ':');
+
+		if(2 != fields.size()) {
+			out->fatal(CALL_INFO, -1, "Array \"%s\" is not of the form name=base_address:element_width\n", items[i].c_str());
+		}
+
+		LoopNestArray array;
+		array.name      = trimSpaces(items[i].substr(0, equals));
+		array.base      = strtoull(fields[0].c_str(), NULL, 0);
+		array.width     = strtoull(fields[1].c_str(), NULL, 0);
+		array.indexed   = false;
+		array.randomMax = 0;
+
+		if(0 == array.width || array.width > 8) {
+			out->fatal(CALL_INFO, -1, "Array %s has an element width of %" PRIu64 ", it must be between 1 and 8 bytes\n",
+				array.name.c_str(), array.width);
+		}
+
+		arrays.push_back(array);
+	}
+}
+
+void LoopNestGenerator::parseIndexArrays(const std::string& spec) {
+	const std::vector<std::string> items = splitList(spec, ',');
+
+	for(uint32_t i = 0; i < items.size(); ++i) {
+		const size_t equals = items[i].find('=');
+		const std::string contents = (std::string::npos == equals) ? "" : trimSpaces(items[i].substr(equals + 1));
+		const size_t colon = contents.find(':');
+		LoopNestArray& array = arrays[findArray(trimSpaces(items[i].substr(0, equals)), "index_arrays")];
+
+		if(std::string::npos == colon) {
+			out->fatal(CALL_INFO, -1, "Index array \"%s\" is not of the form name=random:max or name=file:path\n", items[i].c_str());
+		}
+
+		const std::string kind = trimSpaces(contents.substr(0, colon));
+		const std::string value = trimSpaces(contents.substr(colon + 1));
+
+		if("random" == kind) {
+			array.randomMax = strtoull(value.c_str(), NULL, 0);
+
+			if(0 == array.randomMax) {
+				out->fatal(CALL_INFO, -1, "Index array %s needs a maximum greater than zero\n", array.name.c_str());
+			}
+		} else if("file" == kind) {
+			FILE* indexFile = fopen(value.c_str(), "rb");
+
+			if(NULL == indexFile) {
+				out->fatal(CALL_INFO, -1, "Unable to open the contents of index array %s, %s\n", array.name.c_str(), value.c_str());
+			}
+
+			uint64_t element = 0;
+			while(1 == fread(&element, array.width, 1, indexFile)) {
+				array.values.push_back(element);
+				element = 0;
+			}
+			fclose(indexFile);
+
+			if(array.values.empty()) {
+				out->fatal(CALL_INFO, -1, "Contents of index array %s, %s, are empty\n", array.name.c_str(), value.c_str());
+			}
+		} else {
+			out->fatal(CALL_INFO, -1, "Index array %s has contents of unknown kind %s, use random or file\n", array.name.c_str(), kind.c_str());
+		}
+
+		array.indexed = true;
+	}
+}
+
+void LoopNestGenerator::parseStatements(const std::string& spec) {
+	const std::vector<std::string> items = splitList(spec, ';');
+
+	if(items.empty()) {
+		out->fatal(CALL_INFO, -1, "LoopNestGenerator requires at least one access in the statements parameter\n");
+	}
+
+	for(uint32_t i = 0; i < items.size(); ++i) {
+		const std::string& text = items[i];
+		size_t pos = 0;
+
+		LoopNestStatement statement;
+		const std::string op = readName(text, pos);
+
+		if("r" == op || "read" == op) {
+			statement.op = READ;
+		} else if("w" == op || "write" == op) {
+			statement.op = WRITE;
+		} else {
+			out->fatal(CALL_INFO, -1, "Statement %" PRIu32 " \"%s\" must start with r or w\n", i, text.c_str());
+		}
+
+		statement.array = findArray(readName(text, pos), text);
+
+		skipSpaces(text, pos);
+		if(pos >= text.size() || '[' != text[pos]) {
+			out->fatal(CALL_INFO, -1, "Statement %" PRIu32 " \"%s\" has no subscript\n", i, text.c_str());
+		}
+		pos++;
+
+		const LoopNestExpr subscript = parseSum(text, pos);
+		skipSpaces(text, pos);
+		if(pos >= text.size() || ']' != text[pos]) {
+			out->fatal(CALL_INFO, -1, "Statement %" PRIu32 " \"%s\" has an unterminated subscript\n", i, text.c_str());
+		}
+		pos++;
+
+		statement.subscript = (uint32_t) exprs.size();
+		exprs.push_back(subscript);
+
+		const size_t afterPos = pos;
+		if("after" == readName(text, pos)) {
+			while(true) {
+				skipSpaces(text, pos);
+				while(pos < text.size() && ',' == text[pos]) {
+					pos++;
+					skipSpaces(text, pos);
+				}
+				if(pos >= text.size()) {
+					break;
+				}
+
+				char* end = NULL;
+				const long dep = strtol(text.c_str() + pos, &end, 0);
+				if(end == text.c_str() + pos || dep < 0 || dep >= (long) i) {
+					out->fatal(CALL_INFO, -1, "Statement %" PRIu32 " \"%s\" may only wait for earlier statements\n", i, text.c_str());
+				}
+
+				statement.after.push_back((uint32_t) dep);
+				pos = end - text.c_str();
+			}
+		} else {
+			pos = afterPos;
+		}
+
+		skipSpaces(text, pos);
+		if(pos < text.size()) {
+			out->fatal(CALL_INFO, -1, "Statement %" PRIu32 " \"%s\" has unexpected text \"%s\"\n", i, text.c_str(), text.c_str() + pos);
+		}
+
+		statements.push_back(statement);
+	}
+}
+
+LoopNestExpr LoopNestGenerator::constantExpr(const int64_t value) const {
+	LoopNestExpr expr;
+	expr.constant = value;
+	expr.coef.resize(loops.size(), 0);
+	return expr;
+}
+
+bool LoopNestGenerator::isConstant(const LoopNestExpr& expr) const {
+	for(uint32_t i = 0; i < expr.coef.size(); ++i) {
+		if(0 != expr.coef[i]) {
+			return false;
+		}
+	}
+	return expr.indirect.empty();
+}
+
+LoopNestExpr LoopNestGenerator::parseSum(const std::string& text, size_t& pos) {
+	LoopNestExpr sum = parseProduct(text, pos);
+
+	while(true) {
+		skipSpaces(text, pos);
+		if(pos >= text.size() || ('+' != text[pos] && '-' != text[pos])) {
+			return sum;
+		}
+
+		const int64_t sign = ('-' == text[pos]) ? -1 : 1;
+		pos++;
+
+		const LoopNestExpr term = parseProduct(text, pos);
+		sum.constant += sign * term.constant;
+		for(uint32_t i = 0; i < sum.coef.size(); ++i) {
+			sum.coef[i] += sign * term.coef[i];
+		}
+		for(uint32_t i = 0; i < term.indirect.size(); ++i) {
+			sum.indirect.push_back(term.indirect[i]);
+			sum.indirect.back().scale *= sign;
+		}
+	}
+}
+
+LoopNestExpr LoopNestGenerator::parseProduct(const std::string& text, size_t& pos) {
+	LoopNestExpr product = parseFactor(text, pos);
+
+	while(true) {
+		skipSpaces(text, pos);
+		if(pos >= text.size() || '*' != text[pos]) {
+			return product;
+		}
+		pos++;
+
+		LoopNestExpr factor = parseFactor(text, pos);
+
+		// Keep the product affine, one side must be a constant
+		if(isConstant(product)) {
+			std::swap(product, factor);
+		} else if(!isConstant(factor)) {
+			out->fatal(CALL_INFO, -1, "Subscript \"%s\" multiplies two variables, subscripts must be affine\n", text.c_str());
+		}
+
+		const int64_t scale = factor.constant;
+		product.constant *= scale;
+		for(uint32_t i = 0; i < product.coef.size(); ++i) {
+			product.coef[i] *= scale;
+		}
+		for(uint32_t i = 0; i < product.indirect.size(); ++i) {
+			product.indirect[i].scale *= scale;
+		}
+	}
+}
+
+LoopNestExpr LoopNestGenerator::parseFactor(const std::string& text, size_t& pos) {
+	skipSpaces(text, pos);
+
+	if(pos >= text.size()) {
+		out->fatal(CALL_INFO, -1, "Subscript \"%s\" ends unexpectedly\n", text.c_str());
+	}
+
+	if('-' == text[pos]) {
+		pos++;
+		LoopNestExpr negated = parseFactor(text, pos);
+		negated.constant = -negated.constant;
+		for(uint32_t i = 0; i < negated.coef.size(); ++i) {
+			negated.coef[i] = -negated.coef[i];
+		}
+		for(uint32_t i = 0; i < negated.indirect.size(); ++i) {
+			negated.indirect[i].scale = -negated.indirect[i].scale;
+		}
+		return negated;
+	}
+
+	if('(' == text[pos]) {
+		pos++;
+		LoopNestExpr inner = parseSum(text, pos);
+		skipSpaces(text, pos);
+		if(pos >= text.size() || ')' != text[pos]) {
+			out->fatal(CALL_INFO, -1, "Subscript \"%s\" has an unbalanced parenthesis\n", text.c_str());
+		}
+		pos++;
+		return inner;
+	}
+
+	if(isdigit(text[pos])) {
+		char* end = NULL;
+		const int64_t value = strtoll(text.c_str() + pos, &end, 0);
+		pos = end - text.c_str();
+		return constantExpr(value);
+	}
+
+	const std::string name = readName(text, pos);
+	if("" == name) {
+		out->fatal(CALL_INFO, -1, "Subscript \"%s\" has an unexpected character '%c'\n", text.c_str(), text[pos]);
+	}
+
+	skipSpaces(text, pos);
+	if(pos < text.size() && '[' == text[pos]) {
+		pos++;
+
+		LoopNestIndirect indirect;
+		indirect.scale = 1;
+		indirect.array = findArray(name, text);
+
+		if(!arrays[indirect.array].indexed) {
+			out->fatal(CALL_INFO, -1, "Array %s is used inside a subscript but its contents are not given in index_arrays\n", name.c_str());
+		}
+
+		const LoopNestExpr subscript = parseSum(text, pos);
+		skipSpaces(text, pos);
+		if(pos >= text.size() || ']' != text[pos]) {
+			out->fatal(CALL_INFO, -1, "Subscript \"%s\" has an unterminated index into %s\n", text.c_str(), name.c_str());
+		}
+		pos++;
+
+		indirect.subscript = (uint32_t) exprs.size();
+		exprs.push_back(subscript);
+
+		LoopNestExpr lookup = constantExpr(0);
+		lookup.indirect.push_back(indirect);
+		return lookup;
+	}
+
+	for(uint32_t i = 0; i < loops.size(); ++i) {
+		if(loops[i].name == name) {
+			LoopNestExpr variable = constantExpr(0);
+			variable.coef[i] = 1;
+			return variable;
+		}
+	}
+
+	out->fatal(CALL_INFO, -1, "Subscript \"%s\" uses %s, which is not a loop variable\n", text.c_str(), name.c_str());
+	return constantExpr(0);
+}
+
+uint32_t LoopNestGenerator::findArray(const std::string& name, const std::string& context) const {
+	for(uint32_t i = 0; i < arrays.size(); ++i) {
+		if(arrays[i].name == name) {
+			return i;
+		}
+	}
+
+	out->fatal(CALL_INFO, -1, "Array \"%s\" used in \"%s\" is not declared in the arrays parameter\n", name.c_str(), context.c_str());
+	return 0;
+}
+
+void LoopNestGenerator::compile() {
+	current.resize(loops.size());
+	trip.resize(loops.size(), 0);
+	issuedIDs.resize(statements.size(), 0);
+
+	done = false;
+	uint64_t iterations = 1;
+
+	for(uint32_t i = 0; i < loops.size(); ++i) {
+		current[i] = loops[i].start;
+		iterations *= loops[i].trips;
+	}
+
+	done = (0 == iterations);
+
+	// Strength reduce the affine part of every subscript, advancing a loop
+	// adds its stride and removes the distance the loops inside it covered
+	for(uint32_t s = 0; s < statements.size(); ++s) {
+		LoopNestStatement& statement = statements[s];
+		const LoopNestExpr& subscript = exprs[statement.subscript];
+
+		statement.linear = subscript.constant;
+		statement.carry.resize(loops.size(), 0);
+
+		for(uint32_t k = 0; k < loops.size(); ++k) {
+			statement.linear += subscript.coef[k] * loops[k].start;
+			statement.carry[k] = subscript.coef[k] * loops[k].step;
+
+			for(uint32_t inner = k + 1; inner < loops.size(); ++inner) {
+				statement.carry[k] -= subscript.coef[inner] * loops[inner].step * (int64_t) (loops[inner].trips - 1);
+			}
+		}
+	}
+
+	out->verbose(CALL_INFO, 1, 0, "Compiled %" PRIu32 " loops and %" PRIu32 " statements, %" PRIu64 " iterations\n",
+		(uint32_t) loops.size(), (uint32_t) statements.size(), iterations);
+}
+
+uint64_t LoopNestGenerator::indexValue(const LoopNestArray& array, const int64_t index) const {
+	if(array.values.empty()) {
+		// Random contents are a hash of the position, so nothing is stored
+		uint64_t z = seed + ((uint64_t) index * 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return (z ^ (z >> 31)) % array.randomMax;
+	}
+
+	const int64_t count = (int64_t) array.values.size();
+	return array.values[((index % count) + count) % count];
+}
+
+int64_t LoopNestGenerator::evaluateIndirect(const LoopNestExpr& expr) const {
+	int64_t value = 0;
+
+	for(uint32_t i = 0; i < expr.indirect.size(); ++i) {
+		const LoopNestIndirect& indirect = expr.indirect[i];
+		value += indirect.scale * (int64_t) indexValue(arrays[indirect.array], evaluate(indirect.subscript));
+	}
+
+	return value;
+}
+
+int64_t LoopNestGenerator::evaluate(const uint32_t index) const {
+	const LoopNestExpr& expr = exprs[index];
+	int64_t value = expr.constant;
+
+	for(uint32_t i = 0; i < expr.coef.size(); ++i) {
+		value += expr.coef[i] * current[i];
+	}
+
+	return value + evaluateIndirect(expr);
+}
+
+void LoopNestGenerator::advance(MirandaRequestQueue<GeneratorRequest*>* q) {
+	int32_t level = (int32_t) loops.size() - 1;
+
+	for(; level >= 0; --level) {
+		trip[level]++;
+		current[level] += loops[level].step;
+
+		if(trip[level] < loops[level].trips) {
+			for(uint32_t s = 0; s < statements.size(); ++s) {
+				statements[s].linear += statements[s].carry[level];
+			}
+			break;
+		}
+
+		trip[level] = 0;
+		current[level] = loops[level].start;
+	}
+
+	if(level < 0) {
+		done = true;
+		return;
+	}
+
+	if(level <= fenceLevel) {
+		q->push_back(new FenceOpRequest());
+	}
+}
+
+void LoopNestGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	for(uint64_t b = 0; b < batch && !done; ++b) {
+		for(uint32_t s = 0; s < statements.size(); ++s) {
+			const LoopNestStatement& statement = statements[s];
+			const LoopNestArray& array = arrays[statement.array];
+
+			int64_t index = statement.linear;
+			if(!exprs[statement.subscript].indirect.empty()) {
+				index += evaluateIndirect(exprs[statement.subscript]);
+			}
+
+			MemoryOpRequest* request = new MemoryOpRequest(array.base + ((uint64_t) index * array.width), array.width, statement.op);
+
+			for(uint32_t d = 0; d < statement.after.size(); ++d) {
+				request->addDependency(issuedIDs[statement.after[d]]);
+			}
+
+			issuedIDs[s] = request->getRequestID();
+			q->push_back(request);
+		}
+
+		advance(q);
+	}
+}
+
+bool LoopNestGenerator::isFinished() {
+	return done;
+}
+
+void LoopNestGenerator::completed() {
+
+}
@@ -0,0 +1,142 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_MIRANDA_LOOP_NEST_GEN
+#define _H_SST_MIRANDA_LOOP_NEST_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/core/output.h>
+
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * A subscript is a constant, a multiple of each loop variable and any number
+ * of scaled index array lookups, whose own subscripts are held in the same
+ * pool of expressions.
+ */
+struct LoopNestIndirect {
+	int64_t scale;
+	uint32_t array;
+	uint32_t subscript;
+};
+
+struct LoopNestExpr {
+	int64_t constant;
+	std::vector<int64_t> coef;
+	std::vector<LoopNestIndirect> indirect;
+};
+
+struct LoopNestLoop {
+	std::string name;
+	int64_t start;
+	int64_t step;
+	uint64_t trips;
+};
+
+struct LoopNestArray {
+	std::string name;
+	uint64_t base;
+	uint64_t width;
+
+	// Contents, when the array is used in a subscript
+	bool indexed;
+	uint64_t randomMax;
+	std::vector<uint64_t> values;
+};
+
+struct LoopNestStatement {
+	ReqOperation op;
+	uint32_t array;
+	uint32_t subscript;
+	std::vector<uint32_t> after;
+
+	// Affine part of the subscript at the current iteration and its change
+	// when each loop level advances, with the loops inside it wrapping round
+	int64_t linear;
+	std::vector<int64_t> carry;
+};
+
+class LoopNestGenerator : public RequestGenerator {
+
+public:
+	LoopNestGenerator( ComponentId_t id, Params& params );
+	~LoopNestGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+        LoopNestGenerator,
+        "miranda",
+        "LoopNestGenerator",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Creates the accesses of a loop nest described in its parameters",
+        SST::Miranda::RequestGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+		{ "verbose",          "Sets the verbosity output of the generator", "0" },
+		{ "loops",            "Loops from outermost to innermost as name=start:end[:step], for example \"i=0:128, j=0:128\"", "" },
+		{ "arrays",           "Arrays as name=base_address:element_width, for example \"A=0:8, B=0x100000:8\"", "" },
+		{ "index_arrays",     "Contents of arrays used inside subscripts, name=random:max or name=file:path of little endian elements", "" },
+		{ "statements",       "Accesses of one innermost iteration separated by ';', r or w then array[subscript], optionally followed by 'after' and the statements it waits for, for example \"r idx[j]; r B[idx[j]]; w A[128*i+j] after 1\"", "" },
+		{ "fence_after",      "Insert a fence each time an iteration of this loop completes", "" },
+		{ "batch",            "Number of innermost iterations emitted each time the generator is called", "16" },
+		{ "seed",             "Seed of randomly filled index arrays", "1" }
+    )
+
+private:
+	void parseLoops(const std::string& spec);
+	void parseArrays(const std::string& spec);
+	void parseIndexArrays(const std::string& spec);
+	void parseStatements(const std::string& spec);
+	LoopNestExpr parseSum(const std::string& text, size_t& pos);
+	LoopNestExpr parseProduct(const std::string& text, size_t& pos);
+	LoopNestExpr parseFactor(const std::string& text, size_t& pos);
+	LoopNestExpr constantExpr(const int64_t value) const;
+	bool isConstant(const LoopNestExpr& expr) const;
+	uint32_t findArray(const std::string& name, const std::string& context) const;
+	void compile();
+
+	int64_t evaluate(const uint32_t expr) const;
+	int64_t evaluateIndirect(const LoopNestExpr& expr) const;
+	uint64_t indexValue(const LoopNestArray& array, const int64_t index) const;
+	void advance(MirandaRequestQueue<GeneratorRequest*>* q);
+
+	Output* out;
+
+	std::vector<LoopNestLoop> loops;
+	std::vector<LoopNestArray> arrays;
+	std::vector<LoopNestExpr> exprs;
+	std::vector<LoopNestStatement> statements;
+
+	std::vector<int64_t> current;
+	std::vector<uint64_t> trip;
+	std::vector<uint64_t> issuedIDs;
+
+	int32_t fenceLevel;
+	uint64_t batch;
+	uint64_t seed;
+	bool done;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,149 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/pagerankgen.h>
+
+using namespace SST::Miranda;
+
+PageRankGenerator::PageRankGenerator( ComponentId_t id, Params& params ) : RequestGenerator(id, params) {
+	const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+	out = new Output("PageRankGenerator[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+	const std::string graphFile = params.find<std::string>("graph_file", "");
+	if("" == graphFile) {
+		out->fatal(CALL_INFO, -1, "PageRankGenerator requires a graph_file\n");
+	}
+
+	graph = new MirandaCSRFile(graphFile, out);
+	if(graph->rows() != graph->cols()) {
+		out->fatal(CALL_INFO, -1, "PageRankGenerator graph %s is not square (%" PRIu64 " x %" PRIu64 ")\n",
+			graphFile.c_str(), graph->rows(), graph->cols());
+	}
+
+	iterations   = params.find<uint64_t>("iterations", 1);
+	elementWidth = params.find<uint64_t>("element_width", 8);
+	indexWidth   = graph->indexBytes();
+	limiter      = new MirandaMLPLimiter(params.find<uint64_t>("mlp", 0));
+
+	uint64_t nextStartAddr = params.find<uint64_t>("start_addr", 0);
+
+	rowStartAddr = nextStartAddr;
+	nextStartAddr += (graph->rows() + 1) * sizeof(uint64_t);
+	columnAddr = nextStartAddr;
+	nextStartAddr += graph->nnz() * indexWidth;
+	degreeAddr = nextStartAddr;
+	nextStartAddr += graph->rows() * elementWidth;
+	contribAddr = nextStartAddr;
+	nextStartAddr += graph->rows() * elementWidth;
+	scoreAddr = nextStartAddr;
+
+	out->verbose(CALL_INFO, 1, 0, "Ranking a graph of %" PRIu64 " vertices and %" PRIu64 " edges for %" PRIu64 " iterations\n",
+		graph->rows(), graph->nnz(), iterations);
+
+	iteration = 0;
+	vertex = 0;
+	pulling = false;
+}
+
+PageRankGenerator::~PageRankGenerator() {
+	delete limiter;
+	delete graph;
+	delete out;
+}
+
+void PageRankGenerator::contributeVertex(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t v) {
+	// contrib[v] = score[v] / out_degree[v]
+	MemoryOpRequest* readScore  = new MemoryOpRequest(scoreAddr + (v * elementWidth), elementWidth, READ);
+	MemoryOpRequest* readDegree = new MemoryOpRequest(degreeAddr + (v * elementWidth), elementWidth, READ);
+	MemoryOpRequest* writeContrib = new MemoryOpRequest(contribAddr + (v * elementWidth), elementWidth, WRITE);
+
+	limiter->startUnit(readScore, readDegree);
+	writeContrib->addDependency(readScore->getRequestID());
+	writeContrib->addDependency(readDegree->getRequestID());
+
+	q->push_back(readScore);
+	q->push_back(readDegree);
+	q->push_back(writeContrib);
+
+	limiter->endUnit(writeContrib);
+}
+
+void PageRankGenerator::pullVertex(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t v) {
+	// score[v] = base + damping * sum(contrib[u]) over the incoming edges u
+	MemoryOpRequest* readStart = new MemoryOpRequest(rowStartAddr + (v * sizeof(uint64_t)), sizeof(uint64_t), READ);
+	MemoryOpRequest* readEnd   = new MemoryOpRequest(rowStartAddr + ((v + 1) * sizeof(uint64_t)), sizeof(uint64_t), READ);
+	MemoryOpRequest* writeScore = new MemoryOpRequest(scoreAddr + (v * elementWidth), elementWidth, WRITE);
+
+	limiter->startUnit(readStart, readEnd);
+	writeScore->addDependency(readStart->getRequestID());
+	writeScore->addDependency(readEnd->getRequestID());
+
+	q->push_back(readStart);
+	q->push_back(readEnd);
+
+	const uint64_t edgeEnd = graph->rowEnd(v);
+
+	for(uint64_t edge = graph->rowStart(v); edge < edgeEnd; ++edge) {
+		MemoryOpRequest* readCol = new MemoryOpRequest(columnAddr + (edge * indexWidth), indexWidth, READ);
+		MemoryOpRequest* readContrib = new MemoryOpRequest(contribAddr + (graph->column(edge) * elementWidth), elementWidth, READ);
+
+		readCol->addDependency(readStart->getRequestID());
+		readCol->addDependency(readEnd->getRequestID());
+		readContrib->addDependency(readCol->getRequestID());
+		writeScore->addDependency(readContrib->getRequestID());
+
+		q->push_back(readCol);
+		q->push_back(readContrib);
+	}
+
+	q->push_back(writeScore);
+	limiter->endUnit(writeScore);
+}
+
+void PageRankGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	if(vertex < graph->rows()) {
+		if(pulling) {
+			pullVertex(q, vertex);
+		} else {
+			contributeVertex(q, vertex);
+		}
+
+		vertex++;
+		return;
+	}
+
+	// Each phase reads what the previous one wrote
+	if(pulling) {
+		out->verbose(CALL_INFO, 2, 0, "Completed iteration %" PRIu64 "\n", iteration);
+		iteration++;
+	}
+
+	pulling = !pulling;
+	vertex = 0;
+
+	if(iteration < iterations) {
+		q->push_back(new FenceOpRequest());
+	}
+}
+
+bool PageRankGenerator::isFinished() {
+	return iteration >= iterations;
+}
+
+void PageRankGenerator::completed() {
+
+}
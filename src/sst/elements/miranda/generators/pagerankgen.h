@@ -0,0 +1,78 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_MIRANDA_PAGERANK_GEN
+#define _H_SST_MIRANDA_PAGERANK_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/elements/miranda/generators/csrfile.h>
+#include <sst/core/output.h>
+
+namespace SST {
+namespace Miranda {
+
+class PageRankGenerator : public RequestGenerator {
+
+public:
+	PageRankGenerator( ComponentId_t id, Params& params );
+	~PageRankGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+        PageRankGenerator,
+        "miranda",
+        "PageRankGenerator",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Creates the accesses of pull based PageRank iterations over a CSR graph file",
+        SST::Miranda::RequestGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+		{ "verbose",          "Sets the verbosity output of the generator", "0" },
+		{ "graph_file",       "Incoming edges of each vertex in the Miranda binary CSR format (see miranda-csr-convert)", "" },
+		{ "iterations",       "Number of PageRank iterations to perform", "1" },
+		{ "element_width",    "Width of a score, contribution or degree entry", "8" },
+		{ "start_addr",       "Address the row starts, column indices, degrees, contributions and scores are laid out from", "0" },
+		{ "mlp",              "Maximum number of vertices processed at once, 0 leaves it to the CPU window", "0" }
+    )
+
+private:
+	void contributeVertex(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t vertex);
+	void pullVertex(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t vertex);
+
+	Output* out;
+	MirandaCSRFile* graph;
+	MirandaMLPLimiter* limiter;
+
+	uint64_t elementWidth;
+	uint64_t indexWidth;
+	uint64_t rowStartAddr;
+	uint64_t columnAddr;
+	uint64_t degreeAddr;
+	uint64_t contribAddr;
+	uint64_t scoreAddr;
+
+	uint64_t iterations;
+	uint64_t iteration;
+	uint64_t vertex;
+	bool pulling;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,148 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_PIM_BENCH_GEN
+#define _H_SST_MIRANDA_PIM_BENCH_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/elements/memHierarchy/customcmd/pimCustomCmd.h>
+#include <sst/core/output.h>
+
+#include <algorithm>
+#include <queue>
+
+namespace SST {
+namespace Miranda {
+
+class PIMBenchGenerator : public RequestGenerator {
+
+public:
+    typedef SST::MemHierarchy::PIMCustomData PIMCustomData;
+
+    PIMBenchGenerator( ComponentId_t id, Params& params) : RequestGenerator(id, params) {
+        build(params);
+    }
+
+    void build(Params& params) {
+        const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+	out = new Output("PIMBenchGenerator[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+	std::string opName = params.find<std::string>("op", "sum");
+	if (opName == "sum") op = PIMCustomData::Op::ReduceSum;
+	else if (opName == "min") op = PIMCustomData::Op::ReduceMin;
+	else if (opName == "max") op = PIMCustomData::Op::ReduceMax;
+	else if (opName == "gather") op = PIMCustomData::Op::Gather;
+	else if (opName == "scatter") op = PIMCustomData::Op::Scatter;
+	else if (opName == "memcpy") op = PIMCustomData::Op::Memcpy;
+	else if (opName == "memset") op = PIMCustomData::Op::Memset;
+	else out->fatal(CALL_INFO, -1, "Unknown op %s, valid ops are sum, min, max, gather, scatter, memcpy and memset\n", opName.c_str());
+
+	n = params.find<uint64_t>("n", 65536);
+	elemSize = params.find<uint32_t>("elem_size", 8);
+	chunk = params.find<uint64_t>("chunk", 1024);
+	stride = params.find<uint64_t>("stride", 0);
+	value = params.find<uint64_t>("value", 0);
+	fp = params.find<bool>("fp", false);
+	n_per_call = params.find<uint64_t>("n_per_call", 1);
+	if (chunk == 0) {
+	    out->fatal(CALL_INFO, -1, "chunk must be greater than 0\n");
+	}
+
+	startA = params.find<uint64_t>("start_a", 0);
+	// Strided operands of gather and scatter span stride bytes per element
+	startB = params.find<uint64_t>("start_b", startA + n * std::max<uint64_t>(stride, elemSize));
+
+	nextElem = 0;
+
+	out->verbose(CALL_INFO, 1, 0, "PIM op             %s\n", opName.c_str());
+	out->verbose(CALL_INFO, 1, 0, "Elements           %" PRIu64 " of %" PRIu32 " bytes\n", n, elemSize);
+	out->verbose(CALL_INFO, 1, 0, "Elements per cmd   %" PRIu64 "\n", chunk);
+	out->verbose(CALL_INFO, 1, 0, "Start of a       0x%" PRIx64 "\n", startA);
+	out->verbose(CALL_INFO, 1, 0, "Start of b       0x%" PRIx64 "\n", startB);
+    }
+
+    ~PIMBenchGenerator() {
+	delete out;
+    }
+
+    void generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	for (uint64_t i = 0; i < n_per_call; i++) {
+	    if (nextElem == n) {
+		return;
+	    }
+
+	    uint64_t count = std::min(chunk, n - nextElem);
+	    // a is the source (or memset target) and b the destination, each
+	    // command continues where the previous one stopped in both
+	    uint64_t aStep = (op == PIMCustomData::Op::Scatter || op == PIMCustomData::Op::Memcpy) ? elemSize : (stride ? stride : elemSize);
+	    uint64_t bStep = (op == PIMCustomData::Op::Scatter) ? (stride ? stride : elemSize) : elemSize;
+	    PIMCustomData* cmd = new PIMCustomData(op, startA + nextElem * aStep, count, elemSize,
+		    startB + nextElem * bStep, stride, value, fp);
+	    q->push_back(new CustomOpRequest(cmd));
+
+	    nextElem += count;
+	}
+    }
+
+    bool isFinished() {
+	return (nextElem == n);
+    }
+
+    void completed() {}
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        PIMBenchGenerator,
+        "miranda",
+        "PIMBenchGenerator",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+   	    "Offloads reductions, gather/scatter or memcpy/memset over an array to processing-in-memory units as custom commands",
+        SST::Miranda::RequestGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "op",          "PIM operation: sum, min, max, gather, scatter, memcpy or memset", "sum" },
+        { "n",           "Number of elements operated on", "65536" },
+        { "elem_size",   "Bytes per element, 1, 2, 4 or 8", "8" },
+        { "chunk",       "Number of elements per PIM command", "1024" },
+        { "stride",      "Bytes between strided elements of gather and scatter and of reductions. 0 is packed", "0" },
+        { "value",       "Value written by memset", "0" },
+        { "fp",          "Reductions operate on floating point elements", "false" },
+        { "start_a",     "Start address of the source array (the target of memset)", "0" },
+        { "start_b",     "Start address of the destination array", "start_a + n * max(stride, elem_size)" },
+        { "n_per_call",  "Number of commands to generate per call to the generation function", "1" },
+        { "verbose",     "Sets the verbosity of the output", "0" }
+    )
+
+private:
+    PIMCustomData::Op op;
+    uint64_t n;
+    uint32_t elemSize;
+    uint64_t chunk;
+    uint64_t stride;
+    uint64_t value;
+    bool fp;
+    uint64_t startA;
+    uint64_t startB;
+    uint64_t nextElem;
+    uint64_t n_per_call;
+    Output*  out;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,209 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/spgemmgen.h>
+
+using namespace SST::Miranda;
+
+SpGEMMGenerator::SpGEMMGenerator( ComponentId_t id, Params& params ) : RequestGenerator(id, params) {
+	const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+	out = new Output("SpGEMMGenerator[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+	const std::string fileA = params.find<std::string>("matrix_a_file", "");
+	const std::string fileB = params.find<std::string>("matrix_b_file", "");
+	if("" == fileA) {
+		out->fatal(CALL_INFO, -1, "SpGEMMGenerator requires a matrix_a_file\n");
+	}
+
+	matrixA = new MirandaCSRFile(fileA, out);
+	matrixB = ("" == fileB) ? matrixA : new MirandaCSRFile(fileB, out);
+
+	if(matrixA->cols() != matrixB->rows()) {
+		out->fatal(CALL_INFO, -1, "SpGEMMGenerator cannot multiply a %" PRIu64 " x %" PRIu64 " matrix by a %" PRIu64 " x %" PRIu64 " matrix\n",
+			matrixA->rows(), matrixA->cols(), matrixB->rows(), matrixB->cols());
+	}
+
+	row    = params.find<uint64_t>("local_row_start", 0);
+	rowEnd = params.find<uint64_t>("local_row_end", 0);
+	if(0 == rowEnd || rowEnd > matrixA->rows()) {
+		rowEnd = matrixA->rows();
+	}
+
+	elementWidth = params.find<uint64_t>("element_width", 8);
+	limiter      = new MirandaMLPLimiter(params.find<uint64_t>("mlp", 0));
+
+	uint64_t nextStartAddr = params.find<uint64_t>("start_addr", 0);
+
+	aRowStartAddr = nextStartAddr;
+	nextStartAddr += (matrixA->rows() + 1) * sizeof(uint64_t);
+	aColumnAddr = nextStartAddr;
+	nextStartAddr += matrixA->nnz() * matrixA->indexBytes();
+	aValueAddr = nextStartAddr;
+	nextStartAddr += matrixA->nnz() * elementWidth;
+
+	if(matrixB == matrixA) {
+		bRowStartAddr = aRowStartAddr;
+		bColumnAddr   = aColumnAddr;
+		bValueAddr    = aValueAddr;
+	} else {
+		bRowStartAddr = nextStartAddr;
+		nextStartAddr += (matrixB->rows() + 1) * sizeof(uint64_t);
+		bColumnAddr = nextStartAddr;
+		nextStartAddr += matrixB->nnz() * matrixB->indexBytes();
+		bValueAddr = nextStartAddr;
+		nextStartAddr += matrixB->nnz() * elementWidth;
+	}
+
+	accumAddr = nextStartAddr;
+	nextStartAddr += matrixB->cols() * elementWidth;
+	cRowStartAddr = nextStartAddr;
+	nextStartAddr += (matrixA->rows() + 1) * sizeof(uint64_t);
+
+	// The size of C is only known once it is computed, so it is written as (column, value) pairs
+	cEntryAddr = nextStartAddr;
+
+	out->verbose(CALL_INFO, 1, 0, "Multiplying rows %" PRIu64 " to %" PRIu64 " of a %" PRIu64 " x %" PRIu64 " matrix with %" PRIu64 " non-zeros\n",
+		row, rowEnd, matrixA->rows(), matrixA->cols(), matrixA->nnz());
+
+	accumRow.resize(matrixB->cols(), UINT64_MAX);
+	accumWrite.resize(matrixB->cols(), 0);
+	outputNNZ = 0;
+}
+
+SpGEMMGenerator::~SpGEMMGenerator() {
+	delete limiter;
+	if(matrixB != matrixA) {
+		delete matrixB;
+	}
+	delete matrixA;
+	delete out;
+}
+
+void SpGEMMGenerator::multiplyRow(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t i) {
+	const uint64_t aIndexWidth = matrixA->indexBytes();
+	const uint64_t bIndexWidth = matrixB->indexBytes();
+
+	MemoryOpRequest* readStart = new MemoryOpRequest(aRowStartAddr + (i * sizeof(uint64_t)), sizeof(uint64_t), READ);
+	MemoryOpRequest* readEnd   = new MemoryOpRequest(aRowStartAddr + ((i + 1) * sizeof(uint64_t)), sizeof(uint64_t), READ);
+
+	limiter->startUnit(readStart, readEnd);
+	q->push_back(readStart);
+	q->push_back(readEnd);
+
+	rowColumns.clear();
+
+	const uint64_t aEnd = matrixA->rowEnd(i);
+	for(uint64_t p = matrixA->rowStart(i); p < aEnd; ++p) {
+		const uint64_t k = matrixA->column(p);
+
+		MemoryOpRequest* readACol = new MemoryOpRequest(aColumnAddr + (p * aIndexWidth), aIndexWidth, READ);
+		MemoryOpRequest* readAVal = new MemoryOpRequest(aValueAddr + (p * elementWidth), elementWidth, READ);
+		readACol->addDependency(readStart->getRequestID());
+		readACol->addDependency(readEnd->getRequestID());
+		readAVal->addDependency(readStart->getRequestID());
+		readAVal->addDependency(readEnd->getRequestID());
+
+		MemoryOpRequest* readBStart = new MemoryOpRequest(bRowStartAddr + (k * sizeof(uint64_t)), sizeof(uint64_t), READ);
+		MemoryOpRequest* readBEnd   = new MemoryOpRequest(bRowStartAddr + ((k + 1) * sizeof(uint64_t)), sizeof(uint64_t), READ);
+		readBStart->addDependency(readACol->getRequestID());
+		readBEnd->addDependency(readACol->getRequestID());
+
+		q->push_back(readACol);
+		q->push_back(readAVal);
+		q->push_back(readBStart);
+		q->push_back(readBEnd);
+
+		const uint64_t bEnd = matrixB->rowEnd(k);
+		for(uint64_t r = matrixB->rowStart(k); r < bEnd; ++r) {
+			const uint64_t j = matrixB->column(r);
+
+			MemoryOpRequest* readBCol = new MemoryOpRequest(bColumnAddr + (r * bIndexWidth), bIndexWidth, READ);
+			MemoryOpRequest* readBVal = new MemoryOpRequest(bValueAddr + (r * elementWidth), elementWidth, READ);
+			readBCol->addDependency(readBStart->getRequestID());
+			readBCol->addDependency(readBEnd->getRequestID());
+			readBVal->addDependency(readBStart->getRequestID());
+			readBVal->addDependency(readBEnd->getRequestID());
+
+			// accum[j] += a[i][k] * b[k][j]
+			MemoryOpRequest* readAccum  = new MemoryOpRequest(accumAddr + (j * elementWidth), elementWidth, READ);
+			MemoryOpRequest* writeAccum = new MemoryOpRequest(accumAddr + (j * elementWidth), elementWidth, WRITE);
+			readAccum->addDependency(readBCol->getRequestID());
+			writeAccum->addDependency(readAccum->getRequestID());
+			writeAccum->addDependency(readAVal->getRequestID());
+			writeAccum->addDependency(readBVal->getRequestID());
+
+			if(accumRow[j] == i) {
+				readAccum->addDependency(accumWrite[j]);
+			} else {
+				accumRow[j] = i;
+				rowColumns.push_back(j);
+			}
+			accumWrite[j] = writeAccum->getRequestID();
+
+			q->push_back(readBCol);
+			q->push_back(readBVal);
+			q->push_back(readAccum);
+			q->push_back(writeAccum);
+		}
+	}
+
+	// Gather the accumulator into C and record where the next row starts
+	MemoryOpRequest* writeRowStart = new MemoryOpRequest(cRowStartAddr + ((i + 1) * sizeof(uint64_t)), sizeof(uint64_t), WRITE);
+	writeRowStart->addDependency(readEnd->getRequestID());
+
+	for(uint64_t n = 0; n < rowColumns.size(); ++n) {
+		const uint64_t j = rowColumns[n];
+
+		MemoryOpRequest* readAccum = new MemoryOpRequest(accumAddr + (j * elementWidth), elementWidth, READ);
+		MemoryOpRequest* writeCol = new MemoryOpRequest(cEntryAddr + (outputNNZ * (sizeof(uint64_t) + elementWidth)),
+			sizeof(uint64_t), WRITE);
+		MemoryOpRequest* writeVal = new MemoryOpRequest(cEntryAddr + (outputNNZ * (sizeof(uint64_t) + elementWidth)) + sizeof(uint64_t),
+			elementWidth, WRITE);
+
+		readAccum->addDependency(accumWrite[j]);
+		writeVal->addDependency(readAccum->getRequestID());
+		writeRowStart->addDependency(writeCol->getRequestID());
+		writeRowStart->addDependency(writeVal->getRequestID());
+
+		q->push_back(readAccum);
+		q->push_back(writeCol);
+		q->push_back(writeVal);
+
+		outputNNZ++;
+	}
+
+	q->push_back(writeRowStart);
+	limiter->endUnit(writeRowStart);
+}
+
+void SpGEMMGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	out->verbose(CALL_INFO, 4, 0, "Multiplying row %" PRIu64 "\n", row);
+	multiplyRow(q, row);
+	row++;
+
+	if(row == rowEnd) {
+		out->verbose(CALL_INFO, 1, 0, "Product has %" PRIu64 " non-zeros\n", outputNNZ);
+	}
+}
+
+bool SpGEMMGenerator::isFinished() {
+	return row >= rowEnd;
+}
+
+void SpGEMMGenerator::completed() {
+
+}
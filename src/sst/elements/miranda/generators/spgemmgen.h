@@ -0,0 +1,89 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_MIRANDA_SPGEMM_GEN
+#define _H_SST_MIRANDA_SPGEMM_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/elements/miranda/generators/csrfile.h>
+#include <sst/core/output.h>
+
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+class SpGEMMGenerator : public RequestGenerator {
+
+public:
+	SpGEMMGenerator( ComponentId_t id, Params& params );
+	~SpGEMMGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+        SpGEMMGenerator,
+        "miranda",
+        "SpGEMMGenerator",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Creates the accesses of a row by row sparse matrix product C = A x B held in CSR files",
+        SST::Miranda::RequestGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+		{ "verbose",          "Sets the verbosity output of the generator", "0" },
+		{ "matrix_a_file",    "Matrix A in the Miranda binary CSR format (see miranda-csr-convert)", "" },
+		{ "matrix_b_file",    "Matrix B in the Miranda binary CSR format, A is squared when this is not set", "" },
+		{ "local_row_start",  "First row of A this generator multiplies", "0" },
+		{ "local_row_end",    "Row of A after the last one this generator multiplies, 0 means the last row", "0" },
+		{ "element_width",    "Width of a matrix value", "8" },
+		{ "start_addr",       "Address A, B, the accumulator and C are laid out from", "0" },
+		{ "mlp",              "Maximum number of rows of C produced at once, 0 leaves it to the CPU window", "0" }
+    )
+
+private:
+	void multiplyRow(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t row);
+
+	Output* out;
+	MirandaCSRFile* matrixA;
+	MirandaCSRFile* matrixB;
+	MirandaMLPLimiter* limiter;
+
+	uint64_t elementWidth;
+	uint64_t aRowStartAddr;
+	uint64_t aColumnAddr;
+	uint64_t aValueAddr;
+	uint64_t bRowStartAddr;
+	uint64_t bColumnAddr;
+	uint64_t bValueAddr;
+	uint64_t accumAddr;
+	uint64_t cRowStartAddr;
+	uint64_t cEntryAddr;
+
+	uint64_t row;
+	uint64_t rowEnd;
+	uint64_t outputNNZ;
+
+	// Row of C each accumulator entry was last written for, and the request that wrote it
+	std::vector<uint64_t> accumRow;
+	std::vector<uint64_t> accumWrite;
+	std::vector<uint64_t> rowColumns;
+};
+
+}
+}
+
+#endif
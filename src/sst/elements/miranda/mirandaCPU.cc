@@ -40,6 +40,9 @@ RequestGenCPU::RequestGenCPU(SST::ComponentId_t id, SST::Params& params) :
 
         requestsPending[READ] = requestsPending[WRITE] = requestsPending[CUSTOM] = 0;
 
+	// Split requests occupy two entries, size the table so that a full window never rehashes
+	requestsInFlight.reserve(2 * ((size_t) maxRequestsPending[READ] + maxRequestsPending[WRITE] + maxRequestsPending[CUSTOM]));
+
 	out->verbose(CALL_INFO, 1, 0, "Configured CPU to allow %" PRIu32 " maximum Load requests to be memory to be outstanding.\n",
 		maxRequestsPending[READ]);
 	out->verbose(CALL_INFO, 1, 0, "Configured CPU to allow %" PRIu32 " maximum Store requests to be memory to be outstanding.\n",
@@ -216,7 +219,7 @@ void RequestGenCPU::handleEvent( Interfaces::StandardMem::Request* ev) {
 	out->verbose(CALL_INFO, 2, 0, "Recv event for processing from interface\n");
 
         Interfaces::StandardMem::Request::id_t reqID = ev->getID();
-	std::map<Interfaces::StandardMem::Request::id_t, CPURequest*>::iterator reqFind = requestsInFlight.find(reqID);
+	std::unordered_map<Interfaces::StandardMem::Request::id_t, CPURequest*>::iterator reqFind = requestsInFlight.find(reqID);
 
 	if(reqFind == requestsInFlight.end()) {
 		out->fatal(CALL_INFO, -1, "Unable to find request %" PRIu64 " in request map.\n", reqID);
@@ -241,10 +244,8 @@ void RequestGenCPU::handleEvent( Interfaces::StandardMem::Request* ev) {
 			out->verbose(CALL_INFO, 4, 0, "-> Entry has all parts satisfied, removing ID=%" PRIu64 ", total processing time: %" PRIu64 "ns\n",
 				cpuReq->getOriginalReqID(), (getCurrentSimTimeNano() - cpuReq->getIssueTime()));
 
-			// Notify every pending request that there may be a satisfied dependency
-			for(uint32_t i = 0; i < pendingRequests.size(); ++i) {
-				pendingRequests.at(i)->satisfyDependency(cpuReq->getOriginalReqID());
-			}
+			// Notify the pending requests which depend on this one
+			dependencyGraph.complete(cpuReq->getOriginalReqID());
 
 			delete cpuReq;
 		}
@@ -441,6 +442,7 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
 
     // We need to generate at least as many requests as can be looked up in the OoO window
     // otherwise the issue will have starvation.
+    const uint32_t queuedBeforeGenerate = pendingRequests.size();
     for(int i = pendingRequests.size(); i < maxOpLookup; ++i) {
         if( reqGen->isFinished()) {
             break;
@@ -449,6 +451,14 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
     	}
     }
 
+    // New requests are always appended, record what they depend on once they are all known
+    for(uint32_t i = queuedBeforeGenerate; i < pendingRequests.size(); ++i) {
+        dependencyGraph.queue(pendingRequests.at(i));
+    }
+    for(uint32_t i = queuedBeforeGenerate; i < pendingRequests.size(); ++i) {
+        dependencyGraph.add(pendingRequests.at(i));
+    }
+
     for(uint32_t i = 0; i < pendingRequests.size(); ++i) {
         if(reqsIssuedThisCycle == reqMaxPerCycle) {
             statMaxIssuePerCycle->addData(1);
@@ -473,7 +483,8 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
                 // Keep record we will delete fence at i
     		delReqs.push_back(i);
 
-                // Delete the fence
+                // Delete the fence, requests behind it may depend on it
+                dependencyGraph.complete(nxtRq->getRequestID());
     		delete nxtRq;
             } else {
                 out->verbose(CALL_INFO, 4, 0, "Fence operation in flight (>0 pending requests), stall.\n");
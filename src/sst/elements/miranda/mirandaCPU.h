@@ -20,6 +20,8 @@
 #include <sst/core/interfaces/stdMem.h>
 #include <sst/core/statapi/stataccumulator.h>
 
+#include <unordered_map>
+
 #include "mirandaGenerator.h"
 #include "mirandaEvent.h"
 #include "mirandaMemMgr.h"
@@ -141,13 +143,14 @@ private:
     TimeConverter timeConverter;
     Clock::HandlerBase* clockHandler;
     RequestGenerator* reqGen;
-    std::map<StandardMem::Request::id_t, CPURequest*> requestsInFlight;
+    std::unordered_map<StandardMem::Request::id_t, CPURequest*> requestsInFlight;
     StandardMem* cache_link;
     Link* srcLink;
     MirandaReqEvent* srcReqEvent;
     StdMemHandler* stdMemHandlers;
 
     MirandaRequestQueue<GeneratorRequest*> pendingRequests;
+    MirandaDependencyGraph dependencyGraph;
     MirandaMemoryManager* memMgr;
 
     uint32_t maxRequestsPending[OPCOUNT];
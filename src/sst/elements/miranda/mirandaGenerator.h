@@ -24,6 +24,9 @@
 #include <sst/core/interfaces/stdMem.h>
 
 #include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace SST {
 namespace Miranda {
@@ -39,7 +42,7 @@ typedef enum {
 
 class GeneratorRequest {
 public:
-	GeneratorRequest() {
+	GeneratorRequest() : unsatisfiedDeps(0) {
 		reqID = nextGeneratorRequestID++;
 	}
 
@@ -49,6 +52,11 @@ public:
 
 	void addDependency(uint64_t depReq) {
 		dependsOn.push_back(depReq);
+		unsatisfiedDeps++;
+	}
+
+	const std::vector<uint64_t>& getDependencies() const {
+		return dependsOn;
 	}
 
 	void satisfyDependency(const GeneratorRequest* req) {
@@ -61,13 +69,19 @@ public:
 		for(searchDeps = dependsOn.begin(); searchDeps != dependsOn.end(); searchDeps++) {
 			if( req == (*searchDeps) ) {
 				dependsOn.erase(searchDeps);
+				unsatisfiedDeps--;
 				break;
 			}
 		}
 	}
 
+	// Called by the dependency graph when one of the requests we depend on completes
+	void dependencyCompleted() {
+		unsatisfiedDeps--;
+	}
+
 	bool canIssue() {
-		return dependsOn.empty();
+		return 0 == unsatisfiedDeps;
 	}
 
 	uint64_t getIssueTime() const {
@@ -81,10 +95,60 @@ protected:
 	uint64_t reqID;
 	uint64_t issueTime;
 	std::vector<uint64_t> dependsOn;
+	uint32_t unsatisfiedDeps;
 private:
 	static std::atomic<uint64_t> nextGeneratorRequestID;
 };
 
+/*
+ * Maps each request that others depend on to its dependents, so that when it
+ * completes only those are updated instead of searching every pending
+ * request. Each request counts its own unsatisfied dependencies. A
+ * dependency on a request that is no longer queued or in flight is already
+ * satisfied.
+ */
+class MirandaDependencyGraph {
+public:
+	// A request has been queued, it is live until it completes
+	void queue(GeneratorRequest* req) {
+		live.insert(req->getRequestID());
+	}
+
+	// Record the dependencies of a queued request
+	void add(GeneratorRequest* req) {
+		const std::vector<uint64_t>& deps = req->getDependencies();
+
+		for(uint32_t i = 0; i < deps.size(); ++i) {
+			if(live.find(deps[i]) == live.end()) {
+				req->dependencyCompleted();
+			} else {
+				dependents[deps[i]].push_back(req);
+			}
+		}
+	}
+
+	// A request has completed, its dependents have one fewer dependency left
+	void complete(const uint64_t reqID) {
+		live.erase(reqID);
+
+		std::unordered_map<uint64_t, std::vector<GeneratorRequest*> >::iterator findDeps = dependents.find(reqID);
+
+		if(findDeps == dependents.end()) {
+			return;
+		}
+
+		for(uint32_t i = 0; i < findDeps->second.size(); ++i) {
+			findDeps->second[i]->dependencyCompleted();
+		}
+
+		dependents.erase(findDeps);
+	}
+
+private:
+	std::unordered_set<uint64_t> live;
+	std::unordered_map<uint64_t, std::vector<GeneratorRequest*> > dependents;
+};
+
 template<typename QueueType>
 class MirandaRequestQueue {
 public:
@@ -128,13 +192,12 @@ public:
                	return theQ[index];
        	}
 
-       	void erase(const std::vector<uint32_t> eraseList) {
+       	void erase(const std::vector<uint32_t>& eraseList) {
 		if(0 == eraseList.size()) {
 			return;
 		}
 
-               	QueueType* newQ = (QueueType*) malloc(sizeof(QueueType) * maxCapacity);
-
+		// The list is in ascending order so the survivors can be moved down in place
                	uint32_t nextSkipIndex = 0;
                	uint32_t nextSkip = eraseList.at(nextSkipIndex);
                 uint32_t nextNewQIndex = 0;
@@ -149,20 +212,18 @@ public:
                                        	nextSkip = eraseList.at(nextSkipIndex);
                                 }
                        	} else {
-                               	newQ[nextNewQIndex] = theQ[i];
+                               	theQ[nextNewQIndex] = theQ[i];
                                 nextNewQIndex++;
                        	}
                	}
 
-                free(theQ);
-
-               	theQ = newQ;
 		curSize = nextNewQIndex;
         }
 
 	void push_back(QueueType t) {
+                // Grow geometrically, large issue windows would otherwise copy the queue on every push
                 if(curSize == maxCapacity) {
-                        resize(maxCapacity + 16);
+                        resize(maxCapacity * 2);
                 }
 
                 theQ[curSize] = t;
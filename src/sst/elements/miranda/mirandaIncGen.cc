@@ -15,13 +15,19 @@
 
 #include <sst_config.h>
 
+#include "generators/bfsgen.h"
 #include "generators/copygen.h"
+#include "generators/embeddinggen.h"
 #include "generators/gupsgen.h"
 #include "generators/inorderstreambench.h"
+#include "generators/loopnestgen.h"
 #include "generators/nullgen.h"
+#include "generators/pagerankgen.h"
+#include "generators/pimbench.h"
 #include "generators/randomgen.h"
 #include "generators/revsinglestream.h"
 #include "generators/singlestream.h"
+#include "generators/spgemmgen.h"
 #include "generators/spmvgen.h"
 #include "generators/stencil3dbench.h"
 #include "generators/streambench.h"
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+#
+# Converts a Matrix Market file or an edge list into the binary CSR file read
+# by the Miranda graph and sparse generators (see generators/csrfile.h).
+#
+#   miranda-csr-convert.py input.mtx output.csr
+#   miranda-csr-convert.py --transpose edges.txt output.csr
+#
+# Edge lists hold one "source destination" pair per line, lines starting with
+# '#' or '%' are skipped. Values are dropped, the generators only need the
+# structure of the matrix. PageRank reads the incoming edges of a vertex, so
+# convert its graph with --transpose.
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"MIRCSR01"
+
+def read_matrix_market(lines, symmetric_ok):
+    header = lines[0].lower().split()
+    symmetric = len(header) >= 5 and header[4] in ("symmetric", "skew-symmetric", "hermitian")
+    body = [l for l in lines[1:] if l.strip() and not l.startswith("%")]
+    rows, cols, _ = [int(x) for x in body[0].split()[:3]]
+    edges = []
+    for line in body[1:]:
+        fields = line.split()
+        r, c = int(fields[0]) - 1, int(fields[1]) - 1
+        edges.append((r, c))
+        if symmetric and symmetric_ok and r != c:
+            edges.append((c, r))
+    return rows, cols, edges
+
+def read_edge_list(lines):
+    edges = []
+    for line in lines:
+        if not line.strip() or line[0] in "#%":
+            continue
+        fields = line.split()
+        edges.append((int(fields[0]), int(fields[1])))
+    vertices = 1 + max([max(e) for e in edges]) if edges else 0
+    return vertices, vertices, edges
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a matrix or graph to the Miranda CSR format")
+    parser.add_argument("input", help="Matrix Market (.mtx) file or edge list")
+    parser.add_argument("output", help="CSR file to write")
+    parser.add_argument("--transpose", action="store_true", help="store the transpose, the incoming edges of each vertex")
+    parser.add_argument("--no-symmetric", action="store_true", help="do not expand symmetric Matrix Market files")
+    parser.add_argument("--index-width", type=int, choices=(4, 8), default=0, help="width of a column index, chosen from the size when not given")
+    args = parser.parse_args()
+
+    with open(args.input) as f:
+        lines = f.readlines()
+
+    if lines and lines[0].startswith("%%MatrixMarket"):
+        rows, cols, edges = read_matrix_market(lines, not args.no_symmetric)
+    else:
+        rows, cols, edges = read_edge_list(lines)
+
+    if args.transpose:
+        rows, cols = cols, rows
+        edges = [(c, r) for (r, c) in edges]
+
+    edges = sorted(set(edges))
+    width = args.index_width if args.index_width else (4 if cols < 2**32 else 8)
+
+    row_start = [0] * (rows + 1)
+    for (r, _) in edges:
+        row_start[r + 1] += 1
+    for r in range(rows):
+        row_start[r + 1] += row_start[r]
+
+    with open(args.output, "wb") as f:
+        f.write(MAGIC)
+        f.write(struct.pack("<QQQII", rows, cols, len(edges), width, 0))
+        f.write(struct.pack("<%dQ" % (rows + 1), *row_start))
+        f.write(struct.pack("<%d%s" % (len(edges), "I" if 4 == width else "Q"), *[c for (_, c) in edges]))
+
+    print("Wrote %d x %d matrix with %d non-zeros to %s" % (rows, cols, len(edges), args.output))
+
+if __name__ == "__main__":
+    sys.exit(main())
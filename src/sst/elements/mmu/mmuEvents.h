@@ -84,14 +84,16 @@ class TlbMissEvent  : public SST::Event {
 
       public:
         TlbFillEvent() : Event() {}
-        TlbFillEvent( RequestID id, PTE pte ) : Event(), id(id), perms(pte.perms), ppn(pte.ppn), success(true) { }
-        TlbFillEvent( RequestID id ) : Event(), id(id), success(false) { }
+        // pageShift is set when the translation is part of a large page, 0 for a base page
+        TlbFillEvent( RequestID id, PTE pte, int pageShift = 0 ) : Event(), id(id), perms(pte.perms), ppn(pte.ppn), pageShift(pageShift), success(true) { }
+        TlbFillEvent( RequestID id ) : Event(), id(id), pageShift(0), success(false) { }
         virtual ~TlbFillEvent() {}
 
 
     RequestID getReqId() { return id; }
     size_t getPPN() { return ppn; }
     int32_t getPerms() { return perms; }
+    int getPageShift() { return pageShift; }
     bool isSuccess() { return success; }
 
   private:
@@ -100,6 +102,7 @@ class TlbMissEvent  : public SST::Event {
         SST_SER(id);
         SST_SER(perms);
         SST_SER(ppn);
+        SST_SER(pageShift);
         SST_SER(success);
     }
     ImplementSerializable(TlbFillEvent);
@@ -107,6 +110,7 @@ class TlbMissEvent  : public SST::Event {
     RequestID id;
     uint32_t ppn;
     uint32_t perms;
+    int pageShift;
     bool success;
 
 };
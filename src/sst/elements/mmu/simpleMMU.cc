@@ -14,6 +14,7 @@
 // distribution.
 
 #include <sst_config.h>
+#include <math.h>
 #include "simpleMMU.h"
 #include "mmuEvents.h"
 #include "utils.h"
@@ -35,6 +36,12 @@ SimpleMMU::SimpleMMU(SST::ComponentId_t id, SST::Params& params) : MMU(id,params
     for ( unsigned i = 0; i < m_coreToPid.size(); i++ ) {
         m_coreToPid[i].resize( m_numHwThreads, -1 );
     }
+
+    int walkCacheEntries = params.find<int>("page_walk_cache_entries", 64);
+    if ( walkCacheEntries & ( walkCacheEntries - 1 ) ) {
+        m_dbg.fatal(CALL_INFO, -1, "Error: %s, page_walk_cache_entries must be a power of two\n",getName().c_str());
+    }
+    m_walkCache.resize( walkCacheEntries );
 }
 
 void SimpleMMU::handleNicTlbEvent( Event* ev )
@@ -91,7 +98,32 @@ void SimpleMMU::map( unsigned pid, uint32_t vpn, uint32_t ppn, int pageSize, uin
     auto pageTable = getPageTable(pid);
     assert( pageTable );
 
-    pageTable->add( vpn, PTE( ppn, flags ) );
+    if ( pageSize > ( 1 << m_pageShift ) ) {
+        uint32_t numPages = pageSize >> m_pageShift;
+        if ( ( pageSize & ( pageSize - 1 ) ) || ( vpn & ( numPages - 1 ) ) || ( ppn & ( numPages - 1 ) ) ) {
+            m_dbg.fatal(CALL_INFO, -1, "Error: %s, large page vpn=%#x ppn=%#x is not aligned to pageSize=%d\n",
+                getName().c_str(), vpn, ppn, pageSize );
+        }
+        for ( uint32_t i = 0; i < numPages; i++ ) {
+            pageTable->add( vpn + i, PTE( ppn + i, flags ) );
+        }
+        pageTable->addLarge( vpn, log2( pageSize ) );
+    } else {
+        // remapping a base page inside a large page splits it, the TLBs of threads running pid may still hold the large entry
+        if ( pageTable->getLargePageShift( vpn, m_pageShift ) ) {
+            m_dbg.debug(CALL_INFO_LONG,1,0,"pid=%d vpn=%d splits large page\n", pid, vpn );
+            pageTable->removeLarge( vpn, m_pageShift );
+            for ( unsigned core = 0; core < m_coreToPid.size(); core++ ) {
+                for ( unsigned hwThread = 0; hwThread < m_coreToPid[core].size(); hwThread++ ) {
+                    if ( m_coreToPid[core][hwThread] == pid ) {
+                        flushTlb( core, hwThread );
+                    }
+                }
+            }
+        }
+        invalidateWalk( pageTable, vpn );
+        pageTable->add( vpn, PTE( ppn, flags ) );
+    }
 }
 
 void SimpleMMU::map( unsigned pid, uint32_t vpn, std::vector<uint32_t>& ppns, int pageSize, uint64_t flags ) {
@@ -105,6 +137,8 @@ void SimpleMMU::unmap( unsigned pid, uint32_t vpn, size_t numPages ) {
     auto pageTable = getPageTable(pid);
     assert( pageTable );
     for ( auto i = 0; i < numPages; i++ ) {
+        invalidateWalk( pageTable, vpn + i );
+        pageTable->removeLarge( vpn + i, m_pageShift );
         pageTable->remove( vpn + i );
     }
 }
@@ -142,9 +176,11 @@ void SimpleMMU::faultHandled( RequestID requestId, unsigned link, unsigned pid,
     if ( success ) {
         auto pageTable = getPageTable(pid);
         assert( pageTable );
-        m_dbg.debug(CALL_INFO_LONG,1,0,"link=%d vpn=%#x virtAddr=%#" PRIx64 " ppn=%#x\n",
-            link, vpn, (uint64_t) vpn<<12, pageTable->find( vpn )->ppn );
-        sendEvent( link, new TlbFillEvent( requestId, *pageTable->find( vpn ) ) );
+        PTE* pte = walk( pageTable, vpn );
+        int pageShift = pageTable->getLargePageShift( vpn, m_pageShift );
+        m_dbg.debug(CALL_INFO_LONG,1,0,"link=%d vpn=%#x virtAddr=%#" PRIx64 " ppn=%#x pageShift=%d\n",
+            link, vpn, (uint64_t) vpn<<12, pte->ppn, pageShift );
+        sendEvent( link, new TlbFillEvent( requestId, *pte, pageShift ) );
     } else {
         m_dbg.debug(CALL_INFO_LONG,1,0,"link=%d vpn=%#x failed\n",link,vpn);
         sendEvent( link, new TlbFillEvent( requestId ) );
@@ -154,7 +190,7 @@ void SimpleMMU::faultHandled( RequestID requestId, unsigned link, unsigned pid,
 int SimpleMMU::getPerms( unsigned pid, uint32_t vpn ) {
     auto pageTable = getPageTable(pid);
     assert( pageTable );
-    PTE* pte = pageTable->find( vpn );
+    PTE* pte = walk( pageTable, vpn );
     if ( nullptr == pte ) {
         return -1;
     }
@@ -204,6 +240,7 @@ void SimpleMMU::checkpointLoad( std::string dir ) {
         m_dbg.debug(CALL_INFO_LONG,1,MMU_DBG_CHECKPOINT,"pid: %d\n",pid);
         m_pageTableMap[pid] = new PageTable( &m_dbg, fp );
     }
+    std::fill( m_walkCache.begin(), m_walkCache.end(), WalkCacheEntry() );
 
     assert( 1 == fscanf( fp, "m_coreToPid.size() %d\n", &size) );
     m_dbg.debug(CALL_INFO_LONG,1,MMU_DBG_CHECKPOINT,"m_coreToPid.size() %d\n",size );
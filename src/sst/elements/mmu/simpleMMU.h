@@ -41,6 +41,7 @@ class SimpleMMU : public MMU {
 #if 0
         {"hitLatency", "latency of MMU hit in ns","0"},
 #endif
+        {"page_walk_cache_entries", "number of recently walked page table entries cached, a power of two, 0 disables the cache","64"},
     )
 
     SimpleMMU(SST::ComponentId_t id, SST::Params& params);
@@ -78,7 +79,7 @@ class SimpleMMU : public MMU {
         assert( pageTable );
         uint32_t perms = -1;
         PTE* pte = nullptr;
-        if ( ( pte = pageTable->find( vpn ) ) ) {
+        if ( ( pte = walk( pageTable, vpn ) ) ) {
             m_dbg.debug(CALL_INFO_LONG,1,0,"found PTE ppn %d, perms %#x\n",pte->ppn,pte->perms);
             perms = pte->perms;
         }
@@ -91,7 +92,7 @@ class SimpleMMU : public MMU {
         assert( pageTable );
         uint32_t ppn= -1;
         PTE* pte = nullptr;
-        if ( ( pte = pageTable->find( vpn ) ) ) {
+        if ( ( pte = walk( pageTable, vpn ) ) ) {
             m_dbg.debug(CALL_INFO_LONG,1,0,"found PTE ppn %d, perms %#x\n",pte->ppn,pte->perms);
             ppn = pte->ppn;
         }
@@ -117,6 +118,16 @@ class SimpleMMU : public MMU {
                 output->debug(CALL_INFO_LONG,1,MMU_DBG_CHECKPOINT,"vpn: %d, ppn: %d, perms: %x\n", vpn, ppn, perms );
                 pteMap[vpn] = PTE( ppn, perms );
             }
+
+            assert( 1 == fscanf( fp, "largeMap.size() %d\n", &size ) );
+            output->debug(CALL_INFO_LONG,1,MMU_DBG_CHECKPOINT,"largeMap.size() %d\n",size);
+            for ( auto i = 0; i < size; i++ ) {
+                uint32_t vpn;
+                int pageShift;
+                assert( 2 == fscanf( fp, "vpn: %d, pageShift: %d\n", &vpn, &pageShift ) );
+                output->debug(CALL_INFO_LONG,1,MMU_DBG_CHECKPOINT,"vpn: %d, pageShift: %d\n", vpn, pageShift );
+                largeMap[vpn] = pageShift;
+            }
         }
 
         void add( uint32_t vpn, PTE pte ) {
@@ -125,6 +136,26 @@ class SimpleMMU : public MMU {
         void remove( uint32_t vpn ) {
             pteMap.erase(vpn);
         }
+
+        // large pages are held as the base pages they cover, largeMap records
+        // the first vpn and page shift of each one
+        void addLarge( uint32_t vpn, int pageShift ) {
+            largeMap[vpn] = pageShift;
+        }
+
+        // the shift of the large page covering vpn, 0 if it is a base page
+        int getLargePageShift( uint32_t vpn, int basePageShift ) {
+            auto iter = findLarge( vpn, basePageShift );
+            return iter == largeMap.end() ? 0 : iter->second;
+        }
+
+        // unmapping part of a large page leaves the rest as base pages
+        void removeLarge( uint32_t vpn, int basePageShift ) {
+            auto iter = findLarge( vpn, basePageShift );
+            if ( iter != largeMap.end() ) {
+                largeMap.erase( iter );
+            }
+        }
         PTE* find( uint32_t vpn ) {
             if ( pteMap.find( vpn ) == pteMap.end() ) {
                 return nullptr;
@@ -147,11 +178,68 @@ class SimpleMMU : public MMU {
             for ( auto & x : pteMap ) {
                 fprintf(fp,"vpn: %d, ppn: %d, perms: %d \n", x.first,x.second.ppn,x.second.perms );
             }
+            fprintf(fp,"largeMap.size() %zu\n",largeMap.size());
+            for ( auto & x : largeMap ) {
+                fprintf(fp,"vpn: %d, pageShift: %d\n", x.first,x.second );
+            }
         }
       private:
+        std::map<uint32_t,int>::iterator findLarge( uint32_t vpn, int basePageShift ) {
+            if ( largeMap.empty() ) {
+                return largeMap.end();
+            }
+            auto iter = largeMap.upper_bound( vpn );
+            if ( iter == largeMap.begin() ) {
+                return largeMap.end();
+            }
+            --iter;
+            if ( vpn - iter->first < ( 1u << ( iter->second - basePageShift ) ) ) {
+                return iter;
+            }
+            return largeMap.end();
+        }
+
         std::map<uint32_t,PTE> pteMap;
+        std::map<uint32_t,int> largeMap;
+    };
+
+    // Page walk cache, a direct mapped cache of recent page table lookups.
+    // PTE pointers stay valid until the entry is removed from its table.
+    struct WalkCacheEntry {
+        WalkCacheEntry() : table(nullptr), vpn(0), pte(nullptr) {}
+        PageTable* table;
+        uint32_t vpn;
+        PTE* pte;
     };
 
+    PTE* walk( PageTable* table, uint32_t vpn ) {
+        if ( m_walkCache.empty() ) {
+            return table->find( vpn );
+        }
+
+        auto& entry = m_walkCache[ vpn & ( m_walkCache.size() - 1 ) ];
+        if ( entry.table == table && entry.vpn == vpn ) {
+            return entry.pte;
+        }
+
+        PTE* pte = table->find( vpn );
+        if ( pte ) {
+            entry.table = table;
+            entry.vpn = vpn;
+            entry.pte = pte;
+        }
+        return pte;
+    }
+
+    void invalidateWalk( PageTable* table, uint32_t vpn ) {
+        if ( ! m_walkCache.empty() ) {
+            auto& entry = m_walkCache[ vpn & ( m_walkCache.size() - 1 ) ];
+            if ( entry.table == table && entry.vpn == vpn ) {
+                entry = WalkCacheEntry();
+            }
+        }
+    }
+
     void initPageTable( unsigned pid, PageTable* table = nullptr ) {
         m_dbg.debug(CALL_INFO_LONG,1,0,"pid=%d\n",pid);
         auto iter = m_pageTableMap.find(pid);
@@ -190,6 +278,7 @@ class SimpleMMU : public MMU {
     }
 
     std::map< unsigned, PageTable* > m_pageTableMap;
+    std::vector< WalkCacheEntry > m_walkCache;
 
     std::vector< std::vector< unsigned > > m_coreToPid;
 };
@@ -39,16 +39,40 @@ SimpleTLB::SimpleTLB(SST::ComponentId_t id, SST::Params& params) : TLB(id,params
         m_dbg.fatal(CALL_INFO, -1, "Error: num_hardware threads not set\n");
     }
 
-    m_tlbSize = params.find<int>("num_tlb_entries_per_thread", 0 );
-    if ( 0 == m_tlbSize ) {
+    size_t tlbSize = params.find<int>("num_tlb_entries_per_thread", 0 );
+    if ( 0 == tlbSize ) {
         m_dbg.fatal(CALL_INFO, -1, "Error: num_tlb_entreis_per_thread is not set\n");
     }
 
-    m_tlbSetSize = params.find<int>("tlb_set_size", 0 );
-    if ( 0 == m_tlbSetSize ) {
+    int tlbSetSize = params.find<int>("tlb_set_size", 0 );
+    if ( 0 == tlbSetSize ) {
         m_dbg.fatal(CALL_INFO, -1, "Error: tlb_set_size is not set\n");
     }
 
+    // the base page shift is not known until init()
+    m_tlbArrays.push_back( TlbArray( numHwThreads, tlbSize, tlbSetSize, 0 ) );
+    m_dbg.debug(CALL_INFO,1,0,"numHwTHreads=%d tlbSize=%zu tlbSetSize=%d\n",numHwThreads,tlbSize,tlbSetSize);
+
+    size_t tlb2MBSize = params.find<int>("num_2mb_tlb_entries_per_thread", 0 );
+    if ( tlb2MBSize ) {
+        int tlb2MBSetSize = params.find<int>("tlb_2mb_set_size", 4 );
+        m_tlbArrays.push_back( TlbArray( numHwThreads, tlb2MBSize, tlb2MBSetSize, 21 ) );
+        m_dbg.debug(CALL_INFO,1,0,"tlb2MBSize=%zu tlb2MBSetSize=%d\n",tlb2MBSize,tlb2MBSetSize);
+    }
+
+    size_t tlb1GBSize = params.find<int>("num_1gb_tlb_entries_per_thread", 0 );
+    if ( tlb1GBSize ) {
+        int tlb1GBSetSize = params.find<int>("tlb_1gb_set_size", 4 );
+        m_tlbArrays.push_back( TlbArray( numHwThreads, tlb1GBSize, tlb1GBSetSize, 30 ) );
+        m_dbg.debug(CALL_INFO,1,0,"tlb1GBSize=%zu tlb1GBSetSize=%d\n",tlb1GBSize,tlb1GBSetSize);
+    }
+
+    for ( auto& array : m_tlbArrays ) {
+        if ( 0 == array.m_setSize || ( array.m_numSets & ( array.m_numSets - 1 ) ) ) {
+            m_dbg.fatal(CALL_INFO, -1, "Error: the number of TLB entries per thread must be a power of two and the set size non zero\n");
+        }
+    }
+
     m_minVirtAddr = params.find<uint64_t>("minVirtAddr",4096);
     m_maxVirtAddr = params.find<uint64_t>("maxVirtAddr",0x80000000);
 
@@ -58,15 +82,6 @@ SimpleTLB::SimpleTLB(SST::ComponentId_t id, SST::Params& params) : TLB(id,params
     }
 
     m_waitingMiss.resize( numHwThreads );
-    m_tlbData.resize( numHwThreads );
-    for ( int i=0; i < m_tlbData.size(); i++ ) {
-        m_tlbData[i].resize( m_tlbSize );
-        for ( int j=0; j < m_tlbData[i].size(); j++ ) {
-            m_tlbData[i][j].resize( m_tlbSetSize );
-        }
-    }
-    m_dbg.debug(CALL_INFO,1,0,"numHwTHreads=%d tlbSize=%zu tlbSetSize=%d\n",numHwThreads,m_tlbSize,m_tlbSetSize);
-    m_tlbIndexShift = log2( m_tlbSize );
 }
 
 void SimpleTLB::init(unsigned int phase)
@@ -80,7 +95,15 @@ void SimpleTLB::init(unsigned int phase)
         }
         m_pageShift = initEvent->getPageShift();
         m_pageSize = 1 << m_pageShift;
+        m_tlbArrays[0].m_pageShift = m_pageShift;
         m_dbg.debug(CALL_INFO,1,0,"pageShift=%d pageSize=%d\n",m_pageShift, 1 << m_pageShift);
+
+        for ( int i = 1; i < m_tlbArrays.size(); i++ ) {
+            if ( m_tlbArrays[i].m_pageShift <= m_pageShift ) {
+                m_dbg.fatal(CALL_INFO, -1, "Error: large page TLB with page shift %d is not larger than the page size\n",
+                    m_tlbArrays[i].m_pageShift);
+            }
+        }
         delete ev;
     }
 }
@@ -98,7 +121,7 @@ void SimpleTLB::handleMMUEvent( Event* ev ) {
         }
     }
 
-    m_dbg.debug(CALL_INFO,1,0,"reqId=%#" PRIx64 " ppn=%zu perms=%#x\n", req->getReqId(), req->getPPN(), req->getPerms() );
+    m_dbg.debug(CALL_INFO,1,0,"reqId=%#" PRIx64 " ppn=%zu perms=%#x pageShift=%d\n", req->getReqId(), req->getPPN(), req->getPerms(), req->getPageShift() );
 
     auto record = reinterpret_cast<TlbRecord*>(req->getReqId());
     size_t vpn = record->virtAddr >> m_pageShift;
@@ -106,7 +129,7 @@ void SimpleTLB::handleMMUEvent( Event* ev ) {
     uint64_t physAddr;
     if( req->isSuccess() ) {
         physAddr = req->getPPN() << m_pageShift | blockOffset( record->virtAddr );
-        fillTlbEntry( record->hwThreadId, vpn, req->getPPN(), req->getPerms() );
+        fillTlbEntry( record->hwThreadId, record->virtAddr, req->getPPN(), req->getPerms(), req->getPageShift() );
     } else {
         physAddr = -1;
     }
@@ -127,7 +150,8 @@ void SimpleTLB::handleMMUEvent( Event* ev ) {
         if( ! req->isSuccess() ) {
             physAddr = -1;
         } else {
-            TlbEntry* entry = findTlbEntry( record->hwThreadId, vpn );
+            int pageShift;
+            TlbEntry* entry = findTlbEntry( record->hwThreadId, record->virtAddr, pageShift );
             assert(entry);
             if ( ! checkPerms( record->perms, entry->perms() ) ) {
                 m_dbg.debug(CALL_INFO,1,0,"miss vpn=%zu want=%#" PRIx32 " have=%#" PRIx32 "\n",vpn, record->perms, entry->perms());
@@ -161,12 +185,13 @@ void SimpleTLB::getVirtToPhys( RequestID reqId, int hwThreadId, uint64_t virtAdd
 
     auto& waiting = m_waitingMiss[hwThreadId];
 
-    TlbEntry* entry = findTlbEntry( hwThreadId, vpn );
+    int pageShift;
+    TlbEntry* entry = findTlbEntry( hwThreadId, virtAddr, pageShift );
 
     if ( nullptr != entry && checkPerms( perms, entry->perms() ) && waiting.find( vpn ) == waiting.end()) {
 
-        m_dbg.debug(CALL_INFO,1,0,"hit ppn=%zu\n", entry->ppn() );
-        uint64_t physAddr = entry->ppn() << m_pageShift | blockOffset( virtAddr );
+        m_dbg.debug(CALL_INFO,1,0,"hit ppn=%zu pageShift=%d\n", entry->ppn(), pageShift );
+        uint64_t physAddr = entry->ppn() << pageShift | ( virtAddr & ( ( 1ULL << pageShift ) - 1 ) );
         m_selfLink->send( m_hitLatency, new SelfEvent( reqId, physAddr ));
 
     } else {
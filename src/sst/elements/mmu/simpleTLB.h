@@ -21,7 +21,9 @@
 
 #include "mmuEvents.h"
 #include "tlb.h"
+#include <math.h>
 #include <queue>
+#include <unordered_map>
 
 namespace SST {
 
@@ -90,6 +92,15 @@ class SimpleTLB : public TLB {
 
     SST_ELI_DOCUMENT_PARAMS(
         {"hitLatency", "latency of TLB hit in ns","0"},
+        {"num_hardware_threads", "number of hardware threads sharing the TLB","0"},
+        {"num_tlb_entries_per_thread", "number of base page sets per hardware thread","0"},
+        {"tlb_set_size", "associativity of the base page sets","0"},
+        {"num_2mb_tlb_entries_per_thread", "number of 2MB page sets per hardware thread, 0 holds 2MB pages as base pages","0"},
+        {"tlb_2mb_set_size", "associativity of the 2MB page sets","4"},
+        {"num_1gb_tlb_entries_per_thread", "number of 1GB page sets per hardware thread, 0 holds 1GB pages as base pages","0"},
+        {"tlb_1gb_set_size", "associativity of the 1GB page sets","4"},
+        {"minVirtAddr", "lowest valid virtual address","4096"},
+        {"maxVirtAddr", "highest valid virtual address","0x80000000"},
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -119,48 +130,90 @@ class SimpleTLB : public TLB {
         return addr & ( m_pageSize - 1 );
     }
 
-    int pickVictim() {
-        return rng.generateNextUInt32() % m_tlbSetSize;
+    // One set-associative array for a single page size. The sets of every
+    // hardware thread are held back to back in one vector.
+    class TlbArray {
+      public:
+        TlbArray( int numHwThreads, size_t numSets, int setSize, int pageShift ) :
+            m_numSets(numSets), m_setSize(setSize), m_pageShift(pageShift), m_indexShift( log2( numSets ) ),
+            m_entries( numHwThreads * numSets * setSize ) {}
+
+        TlbEntry* getSet( int hwThreadId, size_t index ) {
+            return &m_entries[ ( hwThreadId * m_numSets + index ) * m_setSize ];
+        }
+
+        size_t m_numSets;
+        int m_setSize;
+        int m_pageShift;
+        int m_indexShift;
+        std::vector< TlbEntry > m_entries;
+    };
+
+    int pickVictim( TlbArray& array ) {
+        return rng.generateNextUInt32() % array.m_setSize;
     }
 
-    void fillTlbEntry( int hwThreadId, size_t vpn, size_t ppn, uint32_t perms ) {
-        size_t tag = vpn >> m_tlbIndexShift;
-        int index = vpn & ( m_tlbSize - 1 );
-        auto& vec = m_tlbData[ hwThreadId ][ index ];
+    // the array holding pages of pageShift, large pages without an array of
+    // their own are held as base pages
+    TlbArray& getTlbArray( int pageShift ) {
+        for ( auto& array : m_tlbArrays ) {
+            if ( array.m_pageShift == pageShift ) {
+                return array;
+            }
+        }
+        return m_tlbArrays[0];
+    }
 
-        for ( int i = 0; i<vec.size(); i++ ) {
-            if ( vec[i].isValid() ) {
+    void fillTlbEntry( int hwThreadId, uint64_t virtAddr, size_t ppn, uint32_t perms, int pageShift ) {
+        auto& array = getTlbArray( pageShift );
+
+        // the MMU returns the ppn of the base page, convert it to a frame of this page size
+        size_t vpn = virtAddr >> array.m_pageShift;
+        ppn >>= array.m_pageShift - m_pageShift;
+
+        size_t tag = vpn >> array.m_indexShift;
+        int index = vpn & ( array.m_numSets - 1 );
+        TlbEntry* set = array.getSet( hwThreadId, index );
+
+        for ( int i = 0; i < array.m_setSize; i++ ) {
+            if ( set[i].isValid() ) {
                 m_dbg.debug(CALL_INFO,1,0,"vpn=%zu, tag=%#" PRIx64 " ppn %#lx -> %zu, perms %#x -> %#x \n",
-                        vpn, (uint64_t) vec[i].tag(), vec[i].ppn(), ppn, vec[i].perms(), perms  );
+                        vpn, (uint64_t) set[i].tag(), set[i].ppn(), ppn, set[i].perms(), perms  );
 
-                if ( tag == vec[i].tag() ) {
-                    vec[ i ].init( tag, ppn, perms );
+                if ( tag == set[i].tag() ) {
+                    set[ i ].init( tag, ppn, perms );
                     return;
                 }
             }
         }
 
-        assert(vpn);
-        int slot = pickVictim();
-        m_dbg.debug(CALL_INFO,1,0,"hwThread=%d vpn=%zu ppn=%zu tag%#" PRIx64 " index=%#x slot=%d\n",hwThreadId,
-            vpn, ppn, (uint64_t) tag, index, slot );
-        vec[ slot ].init( tag, ppn, perms );
+        assert(virtAddr >> m_pageShift);
+        int slot = pickVictim( array );
+        m_dbg.debug(CALL_INFO,1,0,"hwThread=%d vpn=%zu ppn=%zu tag%#" PRIx64 " index=%#x slot=%d pageShift=%d\n",hwThreadId,
+            vpn, ppn, (uint64_t) tag, index, slot, array.m_pageShift );
+        set[ slot ].init( tag, ppn, perms );
     }
 
-    TlbEntry* findTlbEntry( int hwThreadId, size_t vpn ) {
-        size_t tag = vpn >> m_tlbIndexShift;
-        int index = vpn & ( m_tlbSize - 1 );
-
-        m_dbg.debug(CALL_INFO,1,0,"hwThread=%d vpn=%zu tag=%#" PRIx64 " index=%#x\n",
-            hwThreadId, vpn, (uint64_t) tag, index );
-
-        auto& vec = m_tlbData[ hwThreadId ][ index ];
-        for ( int i = 0; i < vec.size(); i++ ) {
-
-            m_dbg.debug(CALL_INFO,2,0,"check valid=%d wantTag=%#" PRIx64 "\n",vec[i].isValid(), (uint64_t) tag );
-            if ( vec[i].isValid() && tag == vec[i].tag() ) {
-                m_dbg.debug(CALL_INFO,1,0,"found tag=%#" PRIx64 " index=%#x slot=%d\n",(uint64_t) tag, index, i );
-                return& vec[i];
+    // looks in the base page array first, then the large page arrays,
+    // pageShift is set to the size of the page that hit
+    TlbEntry* findTlbEntry( int hwThreadId, uint64_t virtAddr, int& pageShift ) {
+        for ( auto& array : m_tlbArrays ) {
+            size_t vpn = virtAddr >> array.m_pageShift;
+            size_t tag = vpn >> array.m_indexShift;
+            int index = vpn & ( array.m_numSets - 1 );
+
+            m_dbg.debug(CALL_INFO,1,0,"hwThread=%d vpn=%zu tag=%#" PRIx64 " index=%#x pageShift=%d\n",
+                hwThreadId, vpn, (uint64_t) tag, index, array.m_pageShift );
+
+            TlbEntry* set = array.getSet( hwThreadId, index );
+            for ( int i = 0; i < array.m_setSize; i++ ) {
+
+                m_dbg.debug(CALL_INFO,2,0,"check valid=%d wantTag=%#" PRIx64 "\n",set[i].isValid(), (uint64_t) tag );
+                if ( set[i].isValid() && tag == set[i].tag() ) {
+                    m_dbg.debug(CALL_INFO,1,0,"found tag=%#" PRIx64 " index=%#x slot=%d\n",(uint64_t) tag, index, i );
+                    pageShift = array.m_pageShift;
+                    return &set[i];
+                }
             }
         }
         return nullptr;
@@ -168,17 +221,17 @@ class SimpleTLB : public TLB {
 
     void flushThread( int hwThread ) {
 
-        auto& slice = m_tlbData[ hwThread ];
-        m_dbg.debug(CALL_INFO,1,0,"hwThread=%d size=%zu\n",hwThread,slice.size() );
-
-        for ( int i = 0; i < slice.size(); i++ ) {
-            auto& set = slice[i];
-            //m_dbg.debug(CALL_INFO,1,0,"size=%zu\n",set.size() );
-            for ( int j = 0; j < set.size(); j++ ) {
-                if ( set[j].isValid() ) {
-                    m_dbg.debug(CALL_INFO,1,0,"hwThread=%d index=%d set=%d vpn=%zu\n",
-                            hwThread,i,j, (size_t) ( set[j].tag() << m_tlbIndexShift | i ));
-                    set[j].setInvalid();
+        for ( auto& array : m_tlbArrays ) {
+            m_dbg.debug(CALL_INFO,1,0,"hwThread=%d size=%zu pageShift=%d\n",hwThread,array.m_numSets,array.m_pageShift );
+
+            for ( int i = 0; i < array.m_numSets; i++ ) {
+                TlbEntry* set = array.getSet( hwThread, i );
+                for ( int j = 0; j < array.m_setSize; j++ ) {
+                    if ( set[j].isValid() ) {
+                        m_dbg.debug(CALL_INFO,1,0,"hwThread=%d index=%d set=%d vpn=%zu\n",
+                                hwThread,i,j, (size_t) ( set[j].tag() << array.m_indexShift | i ));
+                        set[j].setInvalid();
+                    }
                 }
             }
         }
@@ -187,19 +240,18 @@ class SimpleTLB : public TLB {
     Link* m_selfLink;
     Link* m_mmuLink;
     uint64_t m_hitLatency;
-    size_t m_tlbSize;
 
-    int m_tlbSetSize;
     int m_pageSize;
     int m_pageShift;
-    int m_tlbIndexShift;
-    std::vector< std::vector< std::vector< TlbEntry > > > m_tlbData;
+
+    // m_tlbArrays[0] holds base pages, followed by the configured 2MB and 1GB arrays
+    std::vector< TlbArray > m_tlbArrays;
     RNG::XORShiftRNG rng;
 
     uint64_t m_minVirtAddr;
     uint64_t m_maxVirtAddr;
 
-    std::vector< std::map<size_t,std::queue<RequestID> > > m_waitingMiss;
+    std::vector< std::unordered_map<size_t,std::queue<RequestID> > > m_waitingMiss;
 };
 
 } //namespace MMU_Lib
@@ -0,0 +1,133 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+
+#include "buddy_allocator.h"
+
+BuddyAllocator::BuddyAllocator(uint64_t frames, int order) : num_frames(frames), max_order(0)
+{
+	while(max_order < order && ((uint64_t) 2 << max_order) <= num_frames)
+		max_order++;
+
+	free_blocks.resize(max_order + 1);
+	free_count.assign(max_order + 1, 0);
+	hint.assign(max_order + 1, 0);
+
+	for(int k = 0; k <= max_order; k++)
+		free_blocks[k].assign(((num_frames >> k) + 63) / 64, 0);
+
+	allocated.assign((num_frames + 63) / 64, 0);
+	block_start.assign((num_frames + 63) / 64, 0);
+
+	// Cover the pool with the largest aligned blocks that fit
+	uint64_t frame = 0;
+	while(frame < num_frames) {
+		int k = max_order;
+		while(k > 0 && ((frame & (((uint64_t) 1 << k) - 1)) != 0 || frame + ((uint64_t) 1 << k) > num_frames))
+			k--;
+
+		markFree(k, frame >> k);
+		frame += (uint64_t) 1 << k;
+	}
+}
+
+void BuddyAllocator::markFree(int order, uint64_t block)
+{
+	setBit(free_blocks[order], block);
+	free_count[order]++;
+
+	if((block >> 6) < hint[order])
+		hint[order] = block >> 6;
+}
+
+void BuddyAllocator::markUsed(int order, uint64_t block)
+{
+	clearBit(free_blocks[order], block);
+	free_count[order]--;
+}
+
+void BuddyAllocator::markAllocated(uint64_t frame, uint64_t count, bool value)
+{
+	for(uint64_t i = frame; i < frame + count; i++) {
+		if(value)
+			setBit(allocated, i);
+		else
+			clearBit(allocated, i);
+	}
+}
+
+int64_t BuddyAllocator::allocate(int order)
+{
+	if(order < 0 || order > max_order)
+		return -1;
+
+	int k = order;
+	while(k <= max_order && free_count[k] == 0)
+		k++;
+
+	if(k > max_order)
+		return -1;
+
+	std::vector<uint64_t>& map = free_blocks[k];
+	while(map[hint[k]] == 0)
+		hint[k]++;
+
+	uint64_t block = (hint[k] << 6) + __builtin_ctzll(map[hint[k]]);
+	markUsed(k, block);
+
+	// Split down to the requested order, freeing the upper half each time
+	while(k > order) {
+		k--;
+		block <<= 1;
+		markFree(k, block + 1);
+	}
+
+	const uint64_t frame = block << order;
+	markAllocated(frame, (uint64_t) 1 << order, true);
+	setBit(block_start, frame);
+	if(order > 0)
+		block_order[frame] = order;
+
+	return frame;
+}
+
+uint64_t BuddyAllocator::deallocate(uint64_t frame)
+{
+	if(frame >= num_frames || !testBit(block_start, frame))
+		return 0;
+
+	clearBit(block_start, frame);
+
+	int order = 0;
+	std::map<uint64_t, int>::iterator it = block_order.find(frame);
+	if(it != block_order.end()) {
+		order = it->second;
+		block_order.erase(it);
+	}
+
+	const uint64_t frames = (uint64_t) 1 << order;
+	markAllocated(frame, frames, false);
+
+	// Merge with the buddy while it is free at the same order
+	uint64_t block = frame >> order;
+	while(order < max_order) {
+		const uint64_t buddy = block ^ 1;
+		if(((buddy + 1) << order) > num_frames || !testBit(free_blocks[order], buddy))
+			break;
+
+		markUsed(order, buddy);
+		block >>= 1;
+		order++;
+	}
+
+	markFree(order, block);
+	return frames;
+}
@@ -0,0 +1,70 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+
+#ifndef _H_SST_OPAL_BUDDY_ALLOCATOR
+#define _H_SST_OPAL_BUDDY_ALLOCATOR
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/*
+ * Buddy allocator over the frames of a memory pool. Each order k keeps a
+ * bitmap with one bit per aligned block of 2^k frames that marks the free
+ * blocks, two more bitmaps mark every allocated frame and the first frame
+ * of every allocation. Allocations take
+ * the lowest free block of the smallest order that fits and split it, frees
+ * merge a block with its free buddy as far up as possible. Only blocks
+ * larger than one frame keep a record of their order, so memory is about
+ * 4 bits per frame and building a pool does not touch every frame.
+ */
+class BuddyAllocator {
+
+	public:
+		BuddyAllocator(uint64_t frames, int max_order);
+
+		// Returns the first frame of a free block of 2^order frames, or -1 if there is none
+		int64_t allocate(int order);
+
+		// Frees the block allocated at frame, returns its number of frames or 0 if no block starts there
+		uint64_t deallocate(uint64_t frame);
+
+		bool isAllocated(uint64_t frame) const { return frame < num_frames && testBit(allocated, frame); }
+
+		int getMaxOrder() const { return max_order; }
+
+	private:
+		uint64_t num_frames;
+		int max_order;
+
+		// free_blocks[k] has one bit per block of 2^k frames
+		std::vector<std::vector<uint64_t> > free_blocks;
+		std::vector<uint64_t> free_count;
+		// Lowest word of free_blocks[k] that may hold a free block
+		std::vector<uint64_t> hint;
+
+		std::vector<uint64_t> allocated;
+		std::vector<uint64_t> block_start;
+
+		// Order of the allocated blocks bigger than one frame, keyed by first frame
+		std::map<uint64_t, int> block_order;
+
+		static bool testBit(const std::vector<uint64_t>& map, uint64_t i) { return (map[i >> 6] >> (i & 63)) & 1; }
+		static void setBit(std::vector<uint64_t>& map, uint64_t i) { map[i >> 6] |= (uint64_t) 1 << (i & 63); }
+		static void clearBit(std::vector<uint64_t>& map, uint64_t i) { map[i >> 6] &= ~((uint64_t) 1 << (i & 63)); }
+
+		void markFree(int order, uint64_t block);
+		void markUsed(int order, uint64_t block);
+		void markAllocated(uint64_t frame, uint64_t count, bool value);
+};
+
+#endif
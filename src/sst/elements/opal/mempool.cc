@@ -23,12 +23,24 @@ Pool::Pool(Params params, SST::OpalComponent::MemType mem_type, int id)
 
 	output = new SST::Output("OpalMemPool[@f:@l:@p] ", 16, 0, SST::Output::STDOUT);
 
-	size = params.find<uint32_t>("size", 0); // in KB's
+	size = params.find<uint64_t>("size", 0); // in KB's
 
 	start = params.find<uint64_t>("start", 0);
 
 	frsize = params.find<int>("frame_size", 4); //4KB frame size
 
+	/* frame allocator
+	 * list: one free list entry and one Frame per frame, single frame allocations
+	 * buddy: bitmaps per block order, contiguous allocations of up to 2^buddy_max_order frames
+	 */
+	std::string allocator = params.find<std::string>("allocator", "list");
+	buddy_max_order = params.find<int>("buddy_max_order", 18);
+	use_buddy = (allocator == "buddy");
+	buddy = nullptr;
+
+	if(allocator != "list" && allocator != "buddy")
+		output->fatal(CALL_INFO, -1, "Opal: unknown memory pool allocator '%s', use list or buddy\n", allocator.c_str());
+
 	memType = mem_type;
 
 	poolId = id;
@@ -74,10 +86,17 @@ Pool::Pool(Params params, SST::OpalComponent::MemType mem_type, int id)
 //Create free frames of size framesize, note that the size is in KB
 void Pool::build_mem()
 {
-	int i=0;
+	uint64_t i=0;
 	num_frames = ceil(size/frsize);
 	real_size = num_frames * frsize;
 
+	// The buddy allocator keeps its own bitmaps instead of a free list entry per frame
+	if(use_buddy) {
+		buddy = new BuddyAllocator(num_frames, buddy_max_order);
+		available_frames = num_frames;
+		return;
+	}
+
 	//std::vector<int> numbers;
 	//for(int i=0; i<num_frames; i++)       // add 0-99 to the vector
     //	numbers.push_back(i);
@@ -106,6 +125,10 @@ REQRESPONSE Pool::allocate_frames(int pages)
 		return response;
 	}
 
+	// The buddy allocator can hand out the frames as one contiguous block
+	if(buddy)
+		return allocate_frame(pages);
+
 	int frames = pages;
 	std::list<Frame*> frames_allocated;
 
@@ -153,6 +176,25 @@ REQRESPONSE Pool::allocate_frame(int N)
 	REQRESPONSE response;
 	response.status = 0;
 
+	// Allocate the smallest power of two block of frames that holds N frames
+	if(buddy) {
+		if(N < 1)
+			return response;
+
+		int order = 0;
+		while(((int64_t) 1 << order) < N)
+			order++;
+
+		int64_t frame = buddy->allocate(order);
+		if(frame < 0)
+			return response;
+
+		available_frames -= (int64_t) 1 << order;
+		response.address = frameAddress(frame);
+		response.pages = 1 << order;
+		response.status = 1;
+		return response;
+	}
 
 	// Make sure we have free frames first
 	if(freelist.empty())
@@ -185,6 +227,10 @@ REQRESPONSE Pool::allocate_frame(int N)
 REQRESPONSE Pool::deallocate_frames(int pages, uint64_t starting_pAddress)
 {
 
+	// Blocks from the buddy allocator are freed as a whole
+	if(buddy)
+		return deallocate_frame(starting_pAddress, pages);
+
 	REQRESPONSE response;
 	int frames = pages;
 	uint64_t pAddress = starting_pAddress;
@@ -227,6 +273,18 @@ REQRESPONSE Pool::deallocate_frame(uint64_t X, int N)
 	REQRESPONSE response;
 	response.status = 0;
 
+	// Frees the whole block allocated at X, whatever its size
+	if(buddy) {
+		uint64_t frames = 0;
+		if(X >= start && (X - start) % ((uint64_t) frsize * 1024) == 0)
+			frames = buddy->deallocate((X - start) / ((uint64_t) frsize * 1024));
+
+		available_frames += frames;
+		response.address = X;
+		response.pages = frames;
+		response.status = frames ? 1 : 0;
+		return response;
+	}
 
 	// For now, we will assume you can free only 1 frame, TODO: We will implemenet a buddy-allocator style that enables allocating and freeing contigous physical spaces
 	if(N>1)
@@ -254,6 +312,9 @@ REQRESPONSE Pool::deallocate_frame(uint64_t X, int N)
 
 bool Pool::isAllocated(uint64_t address)
 {
+	if(buddy)
+		return address >= start && buddy->isAllocated((address - start) / ((uint64_t) frsize * 1024));
+
 	if(alloclist.find(address)==alloclist.end())
 		return false;
 
@@ -11,6 +11,7 @@
 //
 
 #include "opal_event.h"
+#include "buddy_allocator.h"
 
 #include <list>
 #include <map>
@@ -69,12 +70,13 @@ class Pool{
 				Frame* frame = it->second;
 				delete frame;
 			}
+			delete buddy;
 		}
 
 		void finish() {}
 
 		// The size of the memory pool in KBs
-		uint32_t size;
+		uint64_t size;
 
 		// The starting address of the memory pool
 		uint64_t start;
@@ -96,19 +98,19 @@ class Pool{
 		bool isAllocated(uint64_t address);
 
 		// Current number of free frames
-		int freeframes() { return freelist.size(); }
+		int64_t freeframes() { return buddy ? available_frames : (int64_t) freelist.size(); }
 
 		// Frame size in KBs
 		int frsize;
 
 		//Total number of frames
-		int num_frames;
+		uint64_t num_frames;
 
 		//real size of the memory pool
-		uint32_t real_size;
+		uint64_t real_size;
 
 		//number of free frames
-		int available_frames;
+		int64_t available_frames;
 
 		void set_memPool_type(SST::OpalComponent::MemType _memType) { memType = _memType; }
 
@@ -139,6 +141,15 @@ class Pool{
 		//Memory technology
 		SST::OpalComponent::MemTech memTech;
 
+		// With the buddy allocator the frames are tracked in its bitmaps and the lists below stay empty
+		BuddyAllocator *buddy;
+
+		// Largest block of the buddy allocator is 2^buddy_max_order frames
+		int buddy_max_order;
+		bool use_buddy;
+
+		uint64_t frameAddress(uint64_t frame) { return (frame * frsize * 1024) + start; }
+
 		// The list of free frames
 		std::list<uint64_t> freelist;
 
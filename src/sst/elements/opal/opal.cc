@@ -39,6 +39,16 @@ Opal::Opal(SST::ComponentId_t id, SST::Params& params): Component(id) {
 
 	cycles = 0;
 
+	page_migration = params.find<bool>("page_migration", false);
+	shootdown_batch_size = params.find<uint32_t>("shootdown_batch_size", 16);
+	shootdown_batch_timeout = params.find<uint64_t>("shootdown_batch_timeout", 10000);
+	shootdown_latency = params.find<uint64_t>("shootdown_latency", 2000);
+	invalidation_latency = params.find<uint64_t>("invalidation_latency", 100);
+	migration_latency = params.find<uint64_t>("migration_latency", 1000);
+
+	if(page_migration && 0 == shootdown_batch_size)
+		output->fatal(CALL_INFO, -1, "Opal(%s): shootdown_batch_size must be at least 1\n", getName().c_str());
+
 	opalBase = new OpalBase();
 
 	char* buffer = (char*) malloc(sizeof(char) * 256);
@@ -93,6 +103,10 @@ Opal::Opal(SST::ComponentId_t id, SST::Params& params): Component(id) {
 		snprintf(subID, sizeof(char) * 32, "%" PRIu32, i);
 		nodeInfo[i]->statLocalMemUsage = registerStatistic<uint64_t>("local_mem_usage", subID );
 		nodeInfo[i]->statSharedMemUsage = registerStatistic<uint64_t>("shared_mem_usage", subID );
+		nodeInfo[i]->statPagesMigrated = registerStatistic<uint64_t>("pages_migrated", subID );
+		nodeInfo[i]->statMigrationBytes = registerStatistic<uint64_t>("migration_bytes", subID );
+		nodeInfo[i]->statShootdowns = registerStatistic<uint64_t>("tlb_shootdowns", subID );
+		nodeInfo[i]->statInvalidationsPerShootdown = registerStatistic<uint64_t>("invalidations_per_shootdown", subID );
 		free(subID);
 	}
 
@@ -424,6 +438,7 @@ bool Opal::processRequest(int node, int coreId, uint64_t vAddress, int fault_lev
 	response.status = 0;
 
 	int pages = ceil(size/(nodeInfo[node]->page_size));
+	bool trackPage = false;
 
 	// If multiple pages are requested how are the physical addresses sent to the requester as in future sue to opal parallelization continuous addresses cannot be allocated
 	if(pages != 1)
@@ -442,7 +457,15 @@ bool Opal::processRequest(int node, int coreId, uint64_t vAddress, int fault_lev
 			response = allocateFromReservedMemory(node, response.address, vAddress, pages);
 
 		else {
-			if( !nodeInfo[node]->allocatedmempool ) {
+			// Data pages are placed in the hinted memory and tracked so that later hints can migrate them
+			trackPage = page_migration && 0 == fault_level;
+			int memPool = trackPage ? hintedPool(node, vAddress) : -1;
+			if( memPool >= 0 )
+				response = allocateFromPool(node, memPool);
+
+			if( response.status )
+				response.pages = pages;
+			else if( !nodeInfo[node]->allocatedmempool ) {
 				response = allocateLocalMemory(node, coreId, vAddress, fault_level, pages);
 				//std::cerr << getName() << " Node: " << node << " core " << coreId << " response page address: " << vAddress << " allocated local address: " << response.address << " pages: "<< pages << " level: " << fault_level  << std::endl;
 			}
@@ -454,6 +477,9 @@ bool Opal::processRequest(int node, int coreId, uint64_t vAddress, int fault_lev
 	}
 
 	if( response.status ) {
+		if(trackPage)
+			recordMapping(node, vAddress, response.address);
+
 		OpalEvent *tse = new OpalEvent(EventType::RESPONSE);
 		tse->setResp(vAddress, response.address, response.pages*nodeInfo[node]->page_size);
 		tse->setCoreId(coreId);
@@ -481,6 +507,8 @@ bool Opal::tick(SST::Cycle_t x)
 			case SST::OpalComponent::EventType::HINT:
 			{
 				std::cerr << getName().c_str() << " node: " << ev->getNodeId() << " core: "<< ev->getCoreId() << " request page address: " << ev->getAddress() << " hint" << std::endl;
+				if(page_migration)
+					processMigrationHint(ev->getNodeId(), ev->getAddress(), ev->getSize(), ev->getFaultLevel());
 			}
 			break;
 
@@ -529,6 +557,18 @@ bool Opal::tick(SST::Cycle_t x)
 		}
 	}
 
+	// Issue the shootdown of a node once its batch is full or has waited long enough, one round at a time
+	if(page_migration) {
+		uint64_t now = getCurrentSimTimeNano();
+		for(uint32_t i = 0; i < num_nodes; i++) {
+			NodePrivateInfo *n = nodeInfo[i];
+			if( n->pendingInvalidations.empty() || now < n->shootdownDoneAt )
+				continue;
+			if( n->pendingInvalidations.size() >= shootdown_batch_size || cycles - n->batchStartCycle >= shootdown_batch_timeout )
+				flushShootdowns(i);
+		}
+	}
+
 	return false;
 }
 
@@ -552,3 +592,170 @@ void Opal::deallocateSharedMemory(uint64_t page, int N)
 		}
 }
 
+
+int Opal::memPoolOf(int node, uint64_t pAddress)
+{
+	Pool *pool = nodeInfo[node]->pool;
+	if( pool->start <= pAddress && pAddress < pool->start + pool->num_frames * pool->frsize * 1024 )
+		return 0;
+
+	for(uint32_t sm = 0; sm < num_shared_mempools; sm++) {
+		pool = sharedMemoryInfo[sm]->pool;
+		if( pool->start <= pAddress && pAddress < pool->start + pool->num_frames * pool->frsize * 1024 )
+			return sm + 1;
+	}
+
+	return -1;
+}
+
+void Opal::recordMapping(int node, uint64_t vpage, uint64_t pAddress)
+{
+	int memPool = memPoolOf(node, pAddress);
+	if( memPool >= 0 )
+		nodeInfo[node]->pageMap[vpage] = std::make_pair(pAddress, memPool);
+}
+
+// Returns the kind of memory hinted for a virtual page: 0 for local, 1 for shared and -1 if the page was not hinted
+int Opal::hintedPool(int node, uint64_t vpage)
+{
+	std::map<uint64_t, std::pair<uint64_t, int> >::iterator it = nodeInfo[node]->hintRanges.upper_bound(vpage);
+	if( it == nodeInfo[node]->hintRanges.begin() )
+		return -1;
+
+	--it;
+	return vpage < (it->second).first ? (it->second).second : -1;
+}
+
+// Allocates one frame from local memory (0) or from the first shared pool with a free frame (1), status is 0 if none is free
+REQRESPONSE Opal::allocateFromPool(int node, int memPool)
+{
+	REQRESPONSE response;
+	response.status = 0;
+
+	if( 0 == memPool ) {
+		if( nodeInfo[node]->pool->available_frames > 0 ) {
+			response = nodeInfo[node]->pool->allocate_frame(1);
+			if( response.status )
+				nodeInfo[node]->profileEvent(SST::OpalComponent::MemType::LOCAL);
+		}
+		return response;
+	}
+
+	for(uint32_t sm = 0; sm < num_shared_mempools; sm++) {
+		if( sharedMemoryInfo[sm]->pool->available_frames > 0 ) {
+			response = sharedMemoryInfo[sm]->pool->allocate_frame(1);
+			if( response.status ) {
+				nodeInfo[node]->profileEvent(SST::OpalComponent::MemType::SHARED);
+				break;
+			}
+		}
+	}
+
+	return response;
+}
+
+void Opal::processMigrationHint(int node, uint64_t vAddress, uint64_t size, int level)
+{
+	NodePrivateInfo *n = nodeInfo[node];
+	uint64_t first = vAddress / n->page_size;
+	uint64_t end = (vAddress + size + n->page_size - 1) / n->page_size;
+	if( end <= first )
+		return;
+
+	int memPool = level ? 1 : 0;
+	n->hintRanges[first] = std::make_pair(end, memPool);
+
+	// Pages of the range already mapped in the other kind of memory move to the hinted one
+	std::map<uint64_t, std::pair<uint64_t, int> >::iterator it;
+	for(it = n->pageMap.lower_bound(first); it != n->pageMap.end() && it->first < end; it++) {
+		if( ((it->second).second != 0) != (memPool != 0) && !migratePage(node, it->first, memPool) ) {
+			OPAL_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Node%d no free frame to migrate page %" PRIu64 "\n", node, it->first));
+			break;
+		}
+	}
+}
+
+bool Opal::migratePage(int node, uint64_t vpage, int memPool)
+{
+	NodePrivateInfo *n = nodeInfo[node];
+	std::pair<uint64_t, int> &mapping = n->pageMap[vpage];
+
+	REQRESPONSE response = allocateFromPool(node, memPool);
+	if( !response.status )
+		return false;
+
+	int newPool = memPoolOf(node, response.address);
+
+	// The copy reads the old frame through its memory controller and writes the new one through its own
+	sendMigrationTraffic(node, mapping.second, mapping.first, false);
+	sendMigrationTraffic(node, newPool, response.address, true);
+
+	if( 0 == mapping.second )
+		n->pool->deallocate_frame(mapping.first, 1);
+	else
+		sharedMemoryInfo[mapping.second - 1]->pool->deallocate_frame(mapping.first, 1);
+
+	OPAL_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Node%d migrating page %" PRIu64 " from pool %d to pool %d\n", node, vpage, mapping.second, newPool));
+
+	mapping = std::make_pair(response.address, newPool);
+
+	if( n->pendingInvalidations.empty() )
+		n->batchStartCycle = cycles;
+	n->pendingInvalidations.push_back(vpage);
+
+	n->statPagesMigrated->addData(1);
+	n->statMigrationBytes->addData(n->page_size);
+	return true;
+}
+
+void Opal::sendMigrationTraffic(int node, int memPool, uint64_t pAddress, bool write)
+{
+	NodePrivateInfo *n = nodeInfo[node];
+	SST::Link *link;
+
+	if( 0 == memPool )
+		link = n->memCntrlInfo[((pAddress - n->pool->start) / n->page_size) % n->memory_cntrls].link;
+	else
+		link = sharedMemoryInfo[memPool - 1]->link;
+
+	if( nullptr == link )
+		return;
+
+	OpalEvent *ev = new OpalEvent(EventType::REMAP);
+	ev->setResp(0, pAddress, n->page_size);
+	ev->setNodeId(node);
+	ev->setMemType(memPool ? SST::OpalComponent::MemType::SHARED : SST::OpalComponent::MemType::LOCAL);
+	if( !write )
+		ev->setInvalidate();
+	link->send(ev);
+}
+
+// One interrupt round invalidates the whole batch: every core of the node stalls until the pages are invalidated and copied
+void Opal::flushShootdowns(int node)
+{
+	NodePrivateInfo *n = nodeInfo[node];
+	uint64_t pages = n->pendingInvalidations.size();
+	uint64_t delay = shootdown_latency + pages * (invalidation_latency + migration_latency);
+
+	for(uint32_t j = 0; j < n->cores; j++) {
+		SST::Link *link = n->coreInfo[j].coreLink;
+		if( nullptr == link )
+			continue;
+
+		OpalEvent *sd = new OpalEvent(EventType::SHOOTDOWN);
+		sd->setCoreId(j);
+		sd->setSize(pages);
+		link->send(sd);
+
+		OpalEvent *ack = new OpalEvent(EventType::SDACK);
+		ack->setCoreId(j);
+		link->send(delay, ack);
+	}
+
+	OPAL_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Node%d shootdown of %" PRIu64 " pages for %" PRIu64 " ns\n", node, pages, delay));
+
+	n->shootdownDoneAt = getCurrentSimTimeNano() + delay;
+	n->statShootdowns->addData(1);
+	n->statInvalidationsPerShootdown->addData(pages);
+	n->pendingInvalidations.clear();
+}
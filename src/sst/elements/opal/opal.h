@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include <poll.h>
 #include <queue>
+#include <vector>
 
 #include <sst/core/sst_types.h>
 #include <sst/core/event.h>
@@ -194,8 +195,22 @@ public:
 
     std::map<uint64_t, std::pair<int, std::pair<int, int> > > reservedSpace; // stores pages that are reserved by nodes. these can be shared by other nodes for inter-node communication. fileds: virtual address, fileId, size
 
+    std::map<uint64_t, std::pair<uint64_t, int> > pageMap; // data pages mapped when page migration is enabled. fields: virtual page, physical address, memory pool (0 is local, i+1 is shared pool i)
+
+    std::map<uint64_t, std::pair<uint64_t, int> > hintRanges; // hinted virtual page ranges. fields: first virtual page, end virtual page, hint level
+
+    std::vector<uint64_t> pendingInvalidations; // virtual pages migrated since the last shootdown, invalidated together by the next one
+
+    uint64_t batchStartCycle; // Opal cycle when the first page of the current shootdown batch was queued
+
+    uint64_t shootdownDoneAt; // simulation time (ns) when the last shootdown is acknowledged
+
     Statistic<uint64_t>* statLocalMemUsage;
     Statistic<uint64_t>* statSharedMemUsage;
+    Statistic<uint64_t>* statPagesMigrated;
+    Statistic<uint64_t>* statMigrationBytes;
+    Statistic<uint64_t>* statShootdowns;
+    Statistic<uint64_t>* statInvalidationsPerShootdown;
 
     NodePrivateInfo(OpalBase *base, uint32_t node, Params params)
      {
@@ -209,6 +224,8 @@ public:
          memoryAllocationPolicy = (uint32_t) params.find<uint32_t>("allocation_policy", 0);
          nextallocmem = 0;
          allocatedmempool = 0;
+         batchStartCycle = 0;
+         shootdownDoneAt = 0;
 
          pool = new Pool((Params) params.get_scoped_params("memory"), SST::OpalComponent::MemType::LOCAL, node);
          memory_size = (uint32_t) params.find<uint32_t>("memory.size", 1);	// in KB's
@@ -282,6 +299,22 @@ public:
 
     void deallocateSharedMemory(uint64_t page, int N);
 
+    int memPoolOf(int node, uint64_t pAddress);
+
+    void recordMapping(int node, uint64_t vpage, uint64_t pAddress);
+
+    int hintedPool(int node, uint64_t vpage);
+
+    REQRESPONSE allocateFromPool(int node, int memPool);
+
+    void processMigrationHint(int node, uint64_t vAddress, uint64_t size, int level);
+
+    bool migratePage(int node, uint64_t vpage, int memPool);
+
+    void sendMigrationTraffic(int node, int memPool, uint64_t pAddress, bool write);
+
+    void flushShootdowns(int node);
+
     ~Opal() {
         for(uint32_t i=0; i<num_nodes; i++)
             delete nodeInfo[i];
@@ -323,27 +356,42 @@ public:
         {"shared_mem.mempool%(shared_mempools)d.size", "Size of each shared memory pool in KBs", "1024"},
         {"shared_mem.mempool%(shared_mempools)d.frame_size", "Size of each shared memory pool in KBs", "4"},
         {"shared_mem.mempool%(shared_mempools)d.mem_tech", "memory technology of each shared memory pool in KBs", "0"},
+        {"shared_mem.mempool%(shared_mempools)d.allocator", "frame allocator of each shared memory pool: list (a free list entry per frame) or buddy (bitmaps, contiguous blocks, scales to TB pools)", "list"},
+        {"shared_mem.mempool%(shared_mempools)d.buddy_max_order", "largest block of the buddy allocator is 2^buddy_max_order frames", "18"},
         {"local_mem.mempool%(num_nodes)d.start", "the starting physical address of each local memory pool in KBs", "0"},
         {"local_mem.mempool%(num_nodes)d.size", "Size of each local memory pool in KBs", "1024"},
         {"local_mem.mempool%(num_nodes)d.frame_size", "frame size of each local memory pool in KBs", "4"},
         {"local_mem.mempool%(num_nodes)d.mem_tech", "memory technology of each local memory pool in KBs", "0"},
+        {"local_mem.mempool%(num_nodes)d.allocator", "frame allocator of each local memory pool: list or buddy", "list"},
+        {"local_mem.mempool%(num_nodes)d.buddy_max_order", "largest block of the buddy allocator is 2^buddy_max_order frames", "18"},
         {"startaddress%(num_pools)d", "the starting physical address of the pool", "0"},
         {"type%(num_pools)d", "0 means private for specific NUMA domain, 1 means shared among specific NUMA domains, 2 means public", "2"},
         {"cluster_size", "This determines the number of NUMA domains in each cluster, if clustering is used", "1"},
         {"memtype%(num_pools)d", "0 for typical DRAM, 1 for die-stacked DRAM, 2 for NVM", "0"},
         {"typepriority%(num_pools)d", "0 means die-stacked, typical DRAM, then NVM", "0"},
+        {"page_migration", "1 places and migrates data pages between local and shared memory following the malloc/mmap hints (level 0 is local memory, others are shared memory)", "0"},
+        {"shootdown_batch_size", "number of migrated pages invalidated together by one TLB shootdown round", "16"},
+        {"shootdown_batch_timeout", "Opal cycles a partial batch waits before its shootdown is issued", "10000"},
+        {"shootdown_latency", "time in ns of one shootdown round (interrupts to all cores of the node and their acknowledgements)", "2000"},
+        {"invalidation_latency", "time in ns added to a shootdown round per invalidated page", "100"},
+        {"migration_latency", "time in ns to copy one page between memory pools, cores stay stalled until the batch is copied", "1000"},
     )
 
     // Optional since there is nothing to document
     SST_ELI_DOCUMENT_STATISTICS(
         { "local_mem_usage", "Number of pages allocated in local memory", "requests", 1},
         { "shared_mem_usage", "Number of pages allocated in shared memory", "requests", 1},
+        { "pages_migrated", "Number of pages migrated between local and shared memory", "pages", 5},
+        { "migration_bytes", "Bytes copied through the memory controllers by page migrations", "bytes", 5},
+        { "tlb_shootdowns", "Number of TLB shootdown rounds", "shootdowns", 5},
+        { "invalidations_per_shootdown", "Number of pages invalidated by each TLB shootdown round", "pages", 5},
     )
 
     SST_ELI_DOCUMENT_PORTS(
         {"coreLink%(num_cores)d", "Link to receive core requests", { "OpalComponent.OpalEvent", "" } },
         {"mmuLink%(num_cores)d", "Link to receive mmu requests", { "OpalComponent.OpalEvent", "" } },
         {"memCntrLink%(num_memCntrls)d", "Link to receive memory controller requests", { "OpalComponent.OpalEvent", "" } },
+        {"globalMemCntrLink%(shared_mempools)d", "Link to the memory controller of each shared memory pool", { "OpalComponent.OpalEvent", "" } },
     )
 
     // Optional since there is nothing to document
@@ -379,6 +427,18 @@ public:
 
     NodePrivateInfo **nodeInfo; // stores private information of each node
 
+    bool page_migration; // places and migrates pages following the memory hints
+
+    uint32_t shootdown_batch_size; // pages invalidated by one shootdown round
+
+    uint64_t shootdown_batch_timeout; // cycles a partial batch waits for more pages
+
+    uint64_t shootdown_latency; // ns of one shootdown round
+
+    uint64_t invalidation_latency; // ns per invalidated page
+
+    uint64_t migration_latency; // ns to copy one page
+
 };
 
 } // end namespace
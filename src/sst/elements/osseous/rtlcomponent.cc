@@ -62,6 +62,13 @@ Rtlmodel::Rtlmodel(SST::ComponentId_t id, SST::Params& params) :
     //Configure and register Event Handler for ArielRtllink
    ArielRtlLink = configureLink("ArielRtllink", new Event::Handler2<Rtlmodel,&Rtlmodel::handleArielEvent>(this));
 
+   batchCycles = params.find<uint64_t>("batchCycles", 1);
+   if (batchCycles == 0) {
+       output.fatal(CALL_INFO, -1, "Error: batchCycles must be greater than zero.\n");
+   }
+   batch_generation = 0;
+   batchLink = configureSelfLink("RtlBatch", timeConverter, new Event::Handler2<Rtlmodel,&Rtlmodel::handleBatchEvent>(this));
+
     // Find all the components loaded into the "memory" slot
     // Make sure all cores have a loaded subcomponent in their slot
     cacheLink = loadUserSubComponent<Interfaces::StandardMem>("memory", ComponentInfo::SHARE_NONE, &timeConverter, new StandardMem::Handler2<Rtlmodel,&Rtlmodel::handleMemEvent>(this));
@@ -194,9 +201,29 @@ bool Rtlmodel::clockTick( SST::Cycle_t currentCycle ) {
     //output.verbose(CALL_INFO, 1, 0, "\nSim Done is: %d", ev.sim_done);
 
     if(!isStalled) {
-        dut->eval(ev.update_registers, ev.verbose, ev.done_reset);
-        tickCount++;
+        // Nothing but the clock reaches the model until the run ends, so the
+        // cycles left in the run can be evaluated back to back
+        uint64_t batch = 1;
+        if(tickCount < sim_cycle)
+            batch = std::min(batchCycles, sim_cycle - tickCount);
+
+        for(uint64_t i = 0; i < batch; i++)
+            dut->eval(ev.update_registers, ev.verbose, ev.done_reset);
+        tickCount += batch;
+
+        // Sleep through the rest of the batch, the wakeup lands on the last evaluated cycle
+        if(batch > 1) {
+            RTLEvent* wakeup = new RTLEvent();
+            wakeup->sim_cycles = batch_generation;
+            batchLink->send(batch - 1, wakeup);
+            return true;
+        }
     }
+
+    return checkSimDone();
+}
+
+bool Rtlmodel::checkSimDone() {
 	if( tickCount >= sim_cycle) {
         if(ev.sim_done) {
             output.verbose(CALL_INFO, 1, 0, "OKToEndSim, TickCount %" PRIu64, tickCount);
@@ -210,6 +237,19 @@ bool Rtlmodel::clockTick( SST::Cycle_t currentCycle ) {
     return false;
 }
 
+void Rtlmodel::handleBatchEvent(SST::Event *event) {
+    RTLEvent* wakeup = static_cast<RTLEvent*>(event);
+    const bool stale = (wakeup->sim_cycles != batch_generation);
+    delete event;
+
+    // A new Ariel request in the meantime restarted the run
+    if(stale)
+        return;
+
+    if(!checkSimDone())
+        reregisterClock(timeConverter, clock_handler);
+}
+
 
 /*Event Handle will be called by Ariel CPU once it(Ariel CPU) puts the input and control signals in the shared memory. Now, we need to modify Ariel CPU code for that.
 Event handler will update the input and control signal based on the workload/C program to be executed.
@@ -224,6 +264,7 @@ void Rtlmodel::handleArielEvent(SST::Event *event) {
     */
 
     unregisterClock(timeConverter, clock_handler);
+    batch_generation++;
     ArielComponent::ArielRtlEvent* ariel_ev = dynamic_cast<ArielComponent::ArielRtlEvent*>(event);
     RtlAckEv->setEventRecvAck(true);
     ArielRtlLink->send(RtlAckEv);
@@ -73,6 +73,7 @@ public:
 	SST_ELI_DOCUMENT_PARAMS(
 		{ "ExecFreq", "Clock frequency of RTL design in GHz", "1GHz" },
 		{ "maxCycles", "Number of Clock ticks the simulation must atleast execute before halting", "1000" },
+		{ "batchCycles", "Maximum number of RTL cycles evaluated in one clock handler call while no memory traffic is pending. Simulated timing is unchanged", "1" },
         {"memoryinterface", "Interface to memory", "memHierarchy.standardInterface"}
 	)
 
@@ -103,9 +104,12 @@ private:
 
     //SST Links
     SST::Link* ArielRtlLink;
+    SST::Link* batchLink;
     Interfaces::StandardMem* cacheLink;
 
     void handleArielEvent(SST::Event *ev);
+    void handleBatchEvent(SST::Event *ev);
+    bool checkSimDone();
     void handleMemEvent(Interfaces::StandardMem::Request* event);
     void handleAXISignals(uint8_t);
     void commitReadEvent(const uint64_t address, const uint64_t virtAddr, const uint32_t length);
@@ -159,6 +163,10 @@ private:
 
     uint64_t tickCount;
     uint64_t dynCycles;
+
+    // Batched stepping: the clock sleeps for the rest of an evaluated batch
+    uint64_t batchCycles;
+    uint64_t batch_generation;  // wakeups from before the latest Ariel request are stale
 };
 
  } //namespace RtlComponent
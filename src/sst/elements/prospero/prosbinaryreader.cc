@@ -17,6 +17,12 @@
 #include "sst_config.h"
 #include "prosbinaryreader.h"
 
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 using namespace SST::Prospero;
 
 
@@ -24,33 +30,51 @@ ProsperoBinaryTraceReader::ProsperoBinaryTraceReader( ComponentId_t id, Params&
 	ProsperoTraceReader(id, params, out) {
 
 	std::string traceFile = params.find<std::string>("file", "");
-	traceInput = fopen(traceFile.c_str(), "rb");
+	int traceFD = open(traceFile.c_str(), O_RDONLY);
 
-	if(NULL == traceInput) {
+	if(traceFD < 0) {
             output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in binary reader.\n",
                     getName().c_str(), traceFile.c_str());
 	}
 
+	struct stat traceStat;
+	if(0 != fstat(traceFD, &traceStat)) {
+            output->fatal(CALL_INFO, -1, "%s, Fatal: Error reading the size of trace file: %s in binary reader.\n",
+                    getName().c_str(), traceFile.c_str());
+	}
+
+	traceLength = (size_t) traceStat.st_size;
+	traceOffset = 0;
+	traceData = NULL;
+
+	if(traceLength > 0) {
+		void* mapping = mmap(NULL, traceLength, PROT_READ, MAP_PRIVATE, traceFD, 0);
+
+		if(MAP_FAILED == mapping) {
+            output->fatal(CALL_INFO, -1, "%s, Fatal: Error mapping trace file: %s in binary reader.\n",
+                    getName().c_str(), traceFile.c_str());
+		}
+
+		traceData = (char*) mapping;
+		madvise(traceData, traceLength, MADV_SEQUENTIAL);
+	}
+
+	// The mapping stays valid once the descriptor is closed
+	close(traceFD);
+
 	recordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
-	buffer = (char*) malloc(sizeof(char) * recordLength);
 }
 
 ProsperoBinaryTraceReader::~ProsperoBinaryTraceReader() {
-	if(NULL != traceInput) {
-		fclose(traceInput);
-	}
-
-	if(NULL != buffer) {
-		free(buffer);
+	if(NULL != traceData) {
+		munmap(traceData, traceLength);
 	}
 }
 
 void ProsperoBinaryTraceReader::copy(char* target, const char* source,
 	const size_t bufferOffset, const size_t len) {
 
-	for(size_t i = 0; i < len; ++i) {
-		target[i] = source[bufferOffset + i];
-	}
+	memcpy(target, &source[bufferOffset], len);
 }
 
 ProsperoTraceEntry* ProsperoBinaryTraceReader::readNextEntry() {
@@ -59,22 +83,20 @@ ProsperoTraceEntry* ProsperoBinaryTraceReader::readNextEntry() {
 	char reqType = 'R';
 	uint32_t reqLength  = 0;
 
-	if(feof(traceInput)) {
+	if(traceOffset + recordLength > traceLength) {
+		// End of the trace or a partial record
 		return NULL;
 	}
 
-	if(1 == fread(buffer, (size_t) recordLength, (size_t) 1, traceInput)) {
-		// We DID read an entry
-		copy((char*) &reqCycles,  buffer, (size_t) 0, sizeof(uint64_t));
-		copy((char*) &reqType,    buffer, sizeof(uint64_t), sizeof(char));
-		copy((char*) &reqAddress, buffer, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
-		copy((char*) &reqLength,  buffer, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
-
-		return new ProsperoTraceEntry(reqCycles, reqAddress,
-			reqLength,
-			(reqType == 'R' || reqType == 'r') ? READ : WRITE);
-	} else {
-		// Did not get a full read?
-		return NULL;
-	}
+	const char* buffer = &traceData[traceOffset];
+	traceOffset += recordLength;
+
+	copy((char*) &reqCycles,  buffer, (size_t) 0, sizeof(uint64_t));
+	copy((char*) &reqType,    buffer, sizeof(uint64_t), sizeof(char));
+	copy((char*) &reqAddress, buffer, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+	copy((char*) &reqLength,  buffer, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+
+	return createEntry(reqCycles, reqAddress,
+		reqLength,
+		decodeOperation(reqType));
 }
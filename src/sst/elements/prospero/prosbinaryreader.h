@@ -45,8 +45,10 @@ public:
 private:
 	void copy(char* target, const char* source,
 		const size_t offset, const size_t len);
-	FILE* traceInput;
-	char* buffer;
+	// The whole trace is mapped and records are decoded in place
+	char* traceData;
+	size_t traceLength;
+	size_t traceOffset;
 	uint32_t recordLength;
 
 };
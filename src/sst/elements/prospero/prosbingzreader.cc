@@ -21,7 +21,7 @@ using namespace SST::Prospero;
 
 
 ProsperoCompressedBinaryTraceReader::ProsperoCompressedBinaryTraceReader( ComponentId_t id, Params& params, Output* out ) :
-	ProsperoTraceReader(id, params, out) {
+	ProsperoTraceReader(id, params, out), inputEnded(false), stopping(false), currentBlock(NULL), blockOffset(0) {
 
 	std::string traceFile = params.find<std::string>("file", "");
 	traceInput = gzopen(traceFile.c_str(), "rb");
@@ -31,17 +31,42 @@ ProsperoCompressedBinaryTraceReader::ProsperoCompressedBinaryTraceReader( Compon
 			getName().c_str(), traceFile.c_str());
 	}
 
+	const uint32_t blockRecords = params.find<uint32_t>("block_records", 65536);
+	const uint32_t prefetchBlocks = params.find<uint32_t>("prefetch_blocks", 4);
+
+	if(0 == blockRecords || 0 == prefetchBlocks) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: block_records and prefetch_blocks must both be at least 1.\n",
+			getName().c_str());
+	}
+
 	recordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
-	buffer = (char*) malloc(sizeof(char) * recordLength);
+	blockLength = ((size_t) blockRecords) * recordLength;
+
+	for(uint32_t i = 0; i < prefetchBlocks; ++i) {
+		freeBlocks.push_back(new std::vector<char>(blockLength));
+	}
+
+	decompressor = std::thread(&ProsperoCompressedBinaryTraceReader::decompressBlocks, this);
 }
 
 ProsperoCompressedBinaryTraceReader::~ProsperoCompressedBinaryTraceReader() {
+	{
+		std::lock_guard<std::mutex> lock(blockLock);
+		stopping = true;
+	}
+	blockFree.notify_all();
+	decompressor.join();
+
 	if(NULL != traceInput) {
 		gzclose(traceInput);
 	}
 
-	if(NULL != buffer) {
-		free(buffer);
+	delete currentBlock;
+	for(size_t i = 0; i < fullBlocks.size(); ++i) {
+		delete fullBlocks[i];
+	}
+	for(size_t i = 0; i < freeBlocks.size(); ++i) {
+		delete freeBlocks[i];
 	}
 }
 
@@ -53,6 +78,69 @@ void ProsperoCompressedBinaryTraceReader::copy(char* target, const char* source,
 	}
 }
 
+void ProsperoCompressedBinaryTraceReader::decompressBlocks() {
+	while(true) {
+		std::vector<char>* block = NULL;
+
+		{
+			std::unique_lock<std::mutex> lock(blockLock);
+			blockFree.wait(lock, [this] { return stopping || !freeBlocks.empty(); });
+
+			if(stopping) {
+				return;
+			}
+
+			block = freeBlocks.back();
+			freeBlocks.pop_back();
+		}
+
+		block->resize(blockLength);
+		const int bytesRead = gzread(traceInput, &(*block)[0], (unsigned int) blockLength);
+
+		// A partial record at the end of the trace is dropped
+		const size_t wholeRecords = (bytesRead > 0) ? (((size_t) bytesRead) / recordLength) : 0;
+		block->resize(wholeRecords * recordLength);
+
+		{
+			std::lock_guard<std::mutex> lock(blockLock);
+
+			if(wholeRecords > 0) {
+				fullBlocks.push_back(block);
+			} else {
+				freeBlocks.push_back(block);
+			}
+
+			inputEnded = (bytesRead <= 0) || (((size_t) bytesRead) < blockLength);
+		}
+		blockFull.notify_one();
+
+		if(inputEnded) {
+			return;
+		}
+	}
+}
+
+bool ProsperoCompressedBinaryTraceReader::nextBlock() {
+	std::unique_lock<std::mutex> lock(blockLock);
+
+	if(NULL != currentBlock) {
+		freeBlocks.push_back(currentBlock);
+		currentBlock = NULL;
+		blockFree.notify_one();
+	}
+
+	blockFull.wait(lock, [this] { return inputEnded || !fullBlocks.empty(); });
+
+	if(fullBlocks.empty()) {
+		return false;
+	}
+
+	currentBlock = fullBlocks.front();
+	fullBlocks.pop_front();
+	blockOffset = 0;
+	return true;
+}
+
 ProsperoTraceEntry* ProsperoCompressedBinaryTraceReader::readNextEntry() {
 	output->verbose(CALL_INFO, 4, 0, "Reading next trace entry...\n");
 
@@ -61,26 +149,22 @@ ProsperoTraceEntry* ProsperoCompressedBinaryTraceReader::readNextEntry() {
 	char reqType = 'R';
 	uint32_t reqLength  = 0;
 
-	if(gzeof(traceInput)) {
-		output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
-		return NULL;
+	if(NULL == currentBlock || blockOffset >= currentBlock->size()) {
+		if(!nextBlock()) {
+			output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
+			return NULL;
+		}
 	}
 
-	unsigned int bytesRead = gzread(traceInput, buffer, (unsigned int) recordLength);
-
-	if(bytesRead == recordLength) {
-		// We DID read an entry
-		copy((char*) &reqCycles,  buffer, (size_t) 0, sizeof(uint64_t));
-		copy((char*) &reqType,    buffer, sizeof(uint64_t), sizeof(char));
-		copy((char*) &reqAddress, buffer, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
-		copy((char*) &reqLength,  buffer, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
-
-		return new ProsperoTraceEntry(reqCycles, reqAddress,
-			reqLength,
-			(reqType == 'R' || reqType == 'r') ? READ : WRITE);
-	} else {
-		output->verbose(CALL_INFO, 2, 0, "Did not read a full record from the compressed trace, returning empty request.\n");
-		// Did not get a full read?
-		return NULL;
-	}
+	const char* buffer = &(*currentBlock)[blockOffset];
+	blockOffset += recordLength;
+
+	copy((char*) &reqCycles,  buffer, (size_t) 0, sizeof(uint64_t));
+	copy((char*) &reqType,    buffer, sizeof(uint64_t), sizeof(char));
+	copy((char*) &reqAddress, buffer, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+	copy((char*) &reqLength,  buffer, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+
+	return createEntry(reqCycles, reqAddress,
+		reqLength,
+		decodeOperation(reqType));
 }
@@ -20,6 +20,12 @@
 #include "prosreader.h"
 #include "zlib.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace SST {
 namespace Prospero {
 
@@ -40,14 +46,33 @@ public:
 	)
 
     SST_ELI_DOCUMENT_PARAMS(
-        { "file", "Sets the file for the trace reader to use", "" }
+        { "file", "Sets the file for the trace reader to use", "" },
+        { "block_records", "Number of records decompressed at a time by the background thread", "65536" },
+        { "prefetch_blocks", "Number of decompressed blocks the background thread may run ahead by", "4" }
     )
 
 private:
 	void copy(char* target, const char* source, const size_t buffOffset, const size_t len);
+	void decompressBlocks();
+	bool nextBlock();
+
 	gzFile traceInput;
-	char* buffer;
 	uint32_t recordLength;
+	size_t blockLength;
+
+	// Blocks of whole records are decompressed on a separate thread, full
+	// blocks are queued for readNextEntry() and handed back once read
+	std::thread decompressor;
+	std::mutex blockLock;
+	std::condition_variable blockFull;
+	std::condition_variable blockFree;
+	std::deque<std::vector<char>*> fullBlocks;
+	std::vector<std::vector<char>*> freeBlocks;
+	bool inputEnded;
+	bool stopping;
+
+	std::vector<char>* currentBlock;
+	size_t blockOffset;
 
 };
 
@@ -0,0 +1,76 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "proscolumnarreader.h"
+
+using namespace SST::Prospero;
+
+
+ProsperoColumnarTraceReader::ProsperoColumnarTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoTraceReader(id, params, out) {
+
+	std::string traceFile = params.find<std::string>("file", "");
+	startCycle = params.find<uint64_t>("start_cycle", 0);
+	endCycle = params.find<uint64_t>("end_cycle", 0);
+	core = params.find<int64_t>("core", -1);
+
+	if(!trace.open(traceFile)) {
+            output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in columnar reader, %s.\n",
+                    getName().c_str(), traceFile.c_str(), trace.getError().c_str());
+	}
+
+	if(endCycle > 0 && endCycle <= startCycle) {
+            output->fatal(CALL_INFO, -1, "%s, Fatal: end_cycle (%" PRIu64 ") must be after start_cycle (%" PRIu64 ") in columnar reader.\n",
+                    getName().c_str(), endCycle, startCycle);
+	}
+
+	if(startCycle > 0 && !trace.seekToTime(startCycle)) {
+            output->fatal(CALL_INFO, -1, "%s, Fatal: Error seeking to cycle %" PRIu64 " in trace file: %s, %s.\n",
+                    getName().c_str(), startCycle, traceFile.c_str(), trace.getError().c_str());
+	}
+
+	output->verbose(CALL_INFO, 1, 0, "Columnar trace %s holds %" PRIu64 " records in %" PRIu64 " blocks\n",
+		traceFile.c_str(), trace.getRecordCount(), trace.getBlockCount());
+}
+
+ProsperoColumnarTraceReader::~ProsperoColumnarTraceReader() {
+
+}
+
+ProsperoTraceEntry* ProsperoColumnarTraceReader::readNextEntry() {
+	ColumnarTraceRecord record;
+
+	while(trace.next(&record)) {
+		if(endCycle > 0 && record.time >= endCycle) {
+			return NULL;
+		}
+
+		if(core >= 0 && record.core != (uint64_t) core) {
+			continue;
+		}
+
+		return createEntry(record.time - startCycle, record.address, record.size,
+			(COLUMNAR_TRACE_OP_READ == record.op) ? READ :
+			(COLUMNAR_TRACE_OP_BARRIER == record.op) ? BARRIER : WRITE);
+	}
+
+	if(!trace.getError().empty()) {
+            output->fatal(CALL_INFO, -1, "%s, Fatal: Error reading the columnar trace, %s.\n",
+                    getName().c_str(), trace.getError().c_str());
+	}
+
+	return NULL;
+}
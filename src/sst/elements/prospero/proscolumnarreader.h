@@ -0,0 +1,59 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_PROSPERO_COLUMNAR_READER
+#define _H_SST_PROSPERO_COLUMNAR_READER
+
+#include "prosreader.h"
+#include "prostraceformat.h"
+
+namespace SST {
+namespace Prospero {
+
+class ProsperoColumnarTraceReader : public ProsperoTraceReader {
+
+public:
+    ProsperoColumnarTraceReader( ComponentId_t id, Params& params, Output* out );
+    ~ProsperoColumnarTraceReader();
+    ProsperoTraceEntry* readNextEntry();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+        ProsperoColumnarTraceReader,
+        "prospero",
+        "ProsperoColumnarTraceReader",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Columnar Trace Reader",
+        SST::Prospero::ProsperoTraceReader
+    )
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "file", "Sets the columnar trace file for the trace reader to use", "" },
+		{ "start_cycle", "Replay only the records at or after this time, the reader seeks straight to them and replays them relative to this time", "0" },
+		{ "end_cycle", "Stop the replay before the first record at or after this time, 0 replays to the end of the trace", "0" },
+		{ "core", "Replay only the records of this core, -1 replays the records of every core", "-1" }
+	)
+
+private:
+	ColumnarTraceReader trace;
+	uint64_t startCycle;
+	uint64_t endCycle;
+	int64_t core;
+
+};
+
+}
+}
+
+#endif
@@ -32,23 +32,13 @@ ProsperoComponent::ProsperoComponent(ComponentId_t id, Params& params) :
 	const uint32_t output_level = (uint32_t) params.find<uint32_t>("verbose", 0);
 	output = new SST::Output("Prospero[@p:@l]: ", output_level, 0, SST::Output::STDOUT);
 
-    // Load Reader the new way
-    reader = loadUserSubComponent<ProsperoTraceReader>("reader", ComponentInfo::SHARE_NONE, output);
-
-    // Load Reader the old way
-    if (!reader) {
-	    std::string traceModule = params.find<std::string>("reader", "prospero.ProsperoTextTraceReader");
-	    output->verbose(CALL_INFO, 1, 0, "Reader module is: %s\n", traceModule.c_str());
-
-	    Params readerParams = params.get_scoped_params("readerParams");
-	    reader = loadAnonymousSubComponent<ProsperoTraceReader>(traceModule, "reader", 0, ComponentInfo::INSERT_STATS, readerParams, output);
-
+	const uint32_t cores = (uint32_t) params.find<uint32_t>("cores", 1);
+	if(0 == cores) {
+	    output->fatal(CALL_INFO, -1, "%s, Fatal: cores must be at least 1\n", getName().c_str());
 	}
+	streams.resize(cores);
 
-	if (NULL == reader)
-	    output->fatal(CALL_INFO, -1, "%s, Fatal: Failed to load reader module\n", getName().c_str());
-
-    reader->setOutput(output);
+	loadReaders(params);
 
 	pageSize = (uint64_t) params.find<uint64_t>("pagesize", 4096);
 	output->verbose(CALL_INFO, 1, 0, "Configured Prospero page size for %" PRIu64 " bytes.\n", pageSize);
@@ -74,29 +64,28 @@ ProsperoComponent::ProsperoComponent(ComponentId_t id, Params& params) :
 
 	output->verbose(CALL_INFO, 1, 0, "Configuring Prospero cache connection...\n");
 
-    // Check for interface in the input config; if not, load an anonymous interface (must use our port instead of its own)
-    cache_link = loadUserSubComponent<Interfaces::StandardMem>("memory", ComponentInfo::SHARE_NONE, &time,
-            new StandardMem::Handler2<ProsperoComponent,&ProsperoComponent::handleResponse>(this));
-    if (!cache_link) {
-        Params par;
-        par.insert("port", "cache_link");
-        cache_link = loadAnonymousSubComponent<Interfaces::StandardMem>("memHierarchy.standardInterface", "memory", 0, ComponentInfo::INSERT_STATS | ComponentInfo::SHARE_PORTS, par,
-                    &time, new StandardMem::Handler2<ProsperoComponent,&ProsperoComponent::handleResponse>(this));
-    }
+	loadMemoryLinks(&time);
 	output->verbose(CALL_INFO, 1, 0, "Configuration of memory interface completed.\n");
 
 	output->verbose(CALL_INFO, 1, 0, "Reading first entry from the trace reader...\n");
-	currentEntry = reader->readNextEntry();
+	streamsEnded = 0;
+	streamsAtBarrier = 0;
+	for(uint32_t i = 0; i < streams.size(); ++i) {
+		streams[i].currentEntry = streams[i].reader->readNextEntry();
+
+		// We start by telling the system to continue to process as long as the first entry
+		// is not NULL
+		streams[i].traceEnded = streams[i].currentEntry == NULL;
+		if(streams[i].traceEnded) {
+			streamsEnded++;
+		}
+	}
 	output->verbose(CALL_INFO, 1, 0, "Read of first entry complete.\n");
 
 	output->verbose(CALL_INFO, 1, 0, "Creating memory manager with page size %" PRIu64 "...\n", pageSize);
 	memMgr = new ProsperoMemoryManager(pageSize, output);
 	output->verbose(CALL_INFO, 1, 0, "Created memory manager successfully.\n");
 
-	// We start by telling the system to continue to process as long as the first entry
-	// is not NULL
-	traceEnded = currentEntry == NULL;
-
 	readsIssued = 0;
 	writesIssued = 0;
 	splitReadsIssued = 0;
@@ -104,22 +93,94 @@ ProsperoComponent::ProsperoComponent(ComponentId_t id, Params& params) :
 	totalBytesRead = 0;
 	totalBytesWritten = 0;
 
-	currentOutstanding = 0;
 	cyclesWithNoIssue = 0;
 	cyclesWithIssue = 0;
+	barriersCompleted = 0;
 
 	output->verbose(CALL_INFO, 1, 0, "Prospero configuration completed successfully.\n");
 
 
 }
 
+void ProsperoComponent::loadReaders(Params& params) {
+	const uint32_t cores = (uint32_t) streams.size();
+
+    // Load Reader the new way
+    SubComponentSlotInfo* readers = getSubComponentSlotInfo("reader");
+    if (readers) {
+        if (!readers->isAllPopulated() || readers->getMaxPopulatedSlotNumber() != (int) cores - 1)
+            output->fatal(CALL_INFO, -1, "%s, Fatal: a reader must be loaded into every 'reader' slot from 0 to cores-1 (%" PRIu32 " cores). Check your input config.\n",
+                    getName().c_str(), cores);
+
+        for (uint32_t i = 0; i < cores; i++) {
+            streams[i].reader = readers->create<ProsperoTraceReader>(i, ComponentInfo::SHARE_NONE, output);
+        }
+    } else {
+    // Load Reader the old way
+	    std::string traceModule = params.find<std::string>("reader", "prospero.ProsperoTextTraceReader");
+	    output->verbose(CALL_INFO, 1, 0, "Reader module is: %s\n", traceModule.c_str());
+
+	    Params readerParams = params.get_scoped_params("readerParams");
+	    const std::string traceFile = readerParams.find<std::string>("file", "");
+	    const size_t coreMarker = traceFile.find("%d");
+
+	    for (uint32_t i = 0; i < cores; i++) {
+		    if (cores > 1) {
+			    // Each core reads its own file, or its records of one interleaved file
+			    if (std::string::npos != coreMarker) {
+				    std::string coreFile = traceFile;
+				    coreFile.replace(coreMarker, 2, std::to_string(i));
+				    readerParams.insert("file", coreFile);
+			    } else {
+				    readerParams.insert("core", std::to_string(i));
+			    }
+		    }
+
+		    streams[i].reader = loadAnonymousSubComponent<ProsperoTraceReader>(traceModule, "reader", i, ComponentInfo::INSERT_STATS, readerParams, output);
+	    }
+	}
+
+	for (uint32_t i = 0; i < cores; i++) {
+	    if (NULL == streams[i].reader)
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Failed to load reader module\n", getName().c_str());
+
+	    streams[i].reader->setOutput(output);
+	}
+}
+
+void ProsperoComponent::loadMemoryLinks(TimeConverter* time) {
+	const uint32_t cores = (uint32_t) streams.size();
+
+    // Check for interface in the input config; if not, load an anonymous interface (must use our port instead of its own)
+    SubComponentSlotInfo* mem = getSubComponentSlotInfo("memory");
+    if (mem) {
+        if (!mem->isAllPopulated() || mem->getMaxPopulatedSlotNumber() != (int) cores - 1)
+            output->fatal(CALL_INFO, -1, "%s, Fatal: a memory interface must be loaded into every 'memory' slot from 0 to cores-1 (%" PRIu32 " cores). Check your input config.\n",
+                    getName().c_str(), cores);
+
+        for (uint32_t i = 0; i < cores; i++) {
+            streams[i].cache_link = mem->create<Interfaces::StandardMem>(i, ComponentInfo::SHARE_NONE, time,
+                    new StandardMem::Handler2<ProsperoComponent,&ProsperoComponent::handleResponse,uint32_t>(this, i));
+        }
+    } else {
+        for (uint32_t i = 0; i < cores; i++) {
+            Params par;
+            par.insert("port", (1 == cores) ? std::string("cache_link") : "cache_link_" + std::to_string(i));
+            streams[i].cache_link = loadAnonymousSubComponent<Interfaces::StandardMem>("memHierarchy.standardInterface", "memory", i, ComponentInfo::INSERT_STATS | ComponentInfo::SHARE_PORTS, par,
+                    time, new StandardMem::Handler2<ProsperoComponent,&ProsperoComponent::handleResponse,uint32_t>(this, i));
+        }
+    }
+}
+
 ProsperoComponent::~ProsperoComponent() {
 	delete memMgr;
 	delete output;
 }
 
 void ProsperoComponent::init(unsigned int phase) {
-    cache_link->init(phase);
+    for (uint32_t i = 0; i < streams.size(); i++) {
+        streams[i].cache_link->init(phase);
+    }
 }
 
 void ProsperoComponent::finish() {
@@ -143,6 +204,17 @@ void ProsperoComponent::finish() {
 
 	output->output("------------------------------------------------------------------------\n");
 
+	if(streams.size() > 1) {
+		output->output("- Barriers completed:                    %" PRIu64 "\n", barriersCompleted);
+
+		for(uint32_t i = 0; i < streams.size(); ++i) {
+			output->output("- Core %4" PRIu32 " reads/writes issued:         %" PRIu64 " / %" PRIu64 ", cycles at barriers: %" PRIu64 "\n",
+				i, streams[i].readsIssued, streams[i].writesIssued, streams[i].cyclesAtBarrier);
+		}
+
+		output->output("------------------------------------------------------------------------\n");
+	}
+
 	const double totalBytesReadDbl = (double) totalBytesRead;
 	const double totalBytesWrittenDbl = (double) totalBytesWritten;
 	const double secondsDbl = ((double) nanoSeconds) / 1000000000.0;
@@ -182,53 +254,95 @@ void ProsperoComponent::finish() {
 	output->output("\n");
 }
 
-void ProsperoComponent::handleResponse(StandardMem::Request *ev) {
-	output->verbose(CALL_INFO, 4, 0, "Handle response from memory subsystem.\n");
+void ProsperoComponent::handleResponse(StandardMem::Request *ev, uint32_t core) {
+	output->verbose(CALL_INFO, 4, 0, "Handle response from memory subsystem for core %" PRIu32 ".\n", core);
 
-	currentOutstanding--;
+	streams[core].currentOutstanding--;
 
 	// Our responsibility to delete incoming event
 	delete ev;
 }
 
 bool ProsperoComponent::tick(SST::Cycle_t currentCycle) {
-	if(NULL == currentEntry) {
-		output->verbose(CALL_INFO, 16, 0, "Prospero execute on cycle %" PRIu64 ", current entry is NULL, outstanding=%" PRIu32 ", maxOut=%" PRIu32 "\n",
-			(uint64_t) currentCycle, currentOutstanding, maxOutstanding);
+	// If we have finished reading the traces we need to let the events in flight
+	// drain and the system come to a rest
+	if(streamsEnded == streams.size()) {
+		for(uint32_t i = 0; i < streams.size(); ++i) {
+			if(0 != streams[i].currentOutstanding) {
+				return false;
+			}
+		}
+
+		primaryComponentOKToEndSim();
+		return true;
+	}
+
+	bool issuedThisCycle = false;
+
+	for(uint32_t i = 0; i < streams.size(); ++i) {
+		issuedThisCycle = tickStream(streams[i], i, currentCycle) || issuedThisCycle;
+	}
+
+	// Once every core that has not finished its trace is waiting at the barrier, let them all go
+	if(streamsAtBarrier > 0 && streamsAtBarrier + streamsEnded == streams.size()) {
+		releaseBarrier(currentCycle);
+	}
+
+	if(issuedThisCycle) {
+		cyclesWithIssue++;
 	} else {
-		output->verbose(CALL_INFO, 16, 0, "Prospero execute on cycle %" PRIu64 ", current entry time: %" PRIu64 ", outstanding=%" PRIu32 ", maxOut=%" PRIu32 "\n",
-			(uint64_t) currentCycle, (uint64_t) currentEntry->getIssueAtCycle(),
-			currentOutstanding, maxOutstanding);
+		cyclesWithNoIssue++;
 	}
 
-	// If we have finished reading the trace we need to let the events in flight
-	// drain and the system come to a rest
-	if(traceEnded) {
-		if(0 == currentOutstanding) {
-			primaryComponentOKToEndSim();
-                        return true;
-		}
+	// Keep simulation ticking, we have more work to do if we reach here
+	return false;
+}
 
+bool ProsperoComponent::tickStream(ProsperoStream& stream, const uint32_t core, const Cycle_t currentCycle) {
+	if(stream.traceEnded) {
+		output->verbose(CALL_INFO, 16, 0, "Prospero execute on cycle %" PRIu64 ", core %" PRIu32 " current entry is NULL, outstanding=%" PRIu32 ", maxOut=%" PRIu32 "\n",
+			(uint64_t) currentCycle, core, stream.currentOutstanding, maxOutstanding);
 		return false;
 	}
 
-	const uint64_t outstandingBeforeIssue = currentOutstanding;
+	output->verbose(CALL_INFO, 16, 0, "Prospero execute on cycle %" PRIu64 ", core %" PRIu32 " current entry time: %" PRIu64 ", outstanding=%" PRIu32 ", maxOut=%" PRIu32 "\n",
+		(uint64_t) currentCycle, core, (uint64_t) stream.currentEntry->getIssueAtCycle(),
+		stream.currentOutstanding, maxOutstanding);
+
+	if(stream.atBarrier) {
+		stream.cyclesAtBarrier++;
+		return false;
+	}
+
+	const uint64_t outstandingBeforeIssue = stream.currentOutstanding;
 
 	// Wait to see if the current operation can be issued, if yes then
 	// go ahead and issue it, otherwise we will stall
 	for(uint32_t i = 0; i < maxIssuePerCycle; ++i) {
-		if(currentCycle >= currentEntry->getIssueAtCycle()) {
-			if(currentOutstanding < maxOutstanding) {
+		const int64_t issueAt = (int64_t) stream.currentEntry->getIssueAtCycle() + stream.cycleOffset;
+
+		if((int64_t) currentCycle >= issueAt) {
+			if(stream.currentEntry->isBarrier()) {
+				// A core reaches the barrier once its own requests have completed
+				if(0 == stream.currentOutstanding) {
+					output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " reached barrier %" PRIu64 " on cycle %" PRIu64 "\n",
+						core, stream.currentEntry->getAddress(), (uint64_t) currentCycle);
+					stream.atBarrier = true;
+					streamsAtBarrier++;
+				}
+				break;
+			} else if(stream.currentOutstanding < maxOutstanding) {
 				// Issue the pending request into the memory subsystem
-				issueRequest(currentEntry);
+				issueRequest(stream, stream.currentEntry);
 
 				// Obtain the next newest request
-				currentEntry = reader->readNextEntry();
+				stream.currentEntry = stream.reader->readNextEntry();
 
 				// Trace reader has read all entries, time to begin draining
 				// the system, caches etc
-				if(NULL == currentEntry) {
-					traceEnded = true;
+				if(NULL == stream.currentEntry) {
+					stream.traceEnded = true;
+					streamsEnded++;
 					break;
 				}
 			} else {
@@ -237,27 +351,52 @@ bool ProsperoComponent::tick(SST::Cycle_t currentCycle) {
 			}
 		} else {
 			output->verbose(CALL_INFO, 8, 0, "Not issuing on cycle %" PRIu64 ", waiting for cycle: %" PRIu64 "\n",
-				(uint64_t) currentCycle, currentEntry->getIssueAtCycle());
+				(uint64_t) currentCycle, (uint64_t) issueAt);
 			// Have reached a point in the trace which is too far ahead in time
 			// so stall until we find that point
 			break;
 		}
 	}
 
-	const uint64_t outstandingAfterIssue = currentOutstanding;
-	const uint64_t issuedThisCycle = outstandingAfterIssue - outstandingBeforeIssue;
+	return stream.currentOutstanding != outstandingBeforeIssue;
+}
 
-	if(0 == issuedThisCycle) {
-		cyclesWithNoIssue++;
-	} else {
-		cyclesWithIssue++;
+void ProsperoComponent::releaseBarrier(const Cycle_t currentCycle) {
+	const uint64_t barrierID = streams[0].atBarrier ? streams[0].currentEntry->getAddress() : 0;
+
+	for(uint32_t i = 0; i < streams.size(); ++i) {
+		ProsperoStream& stream = streams[i];
+
+		if(!stream.atBarrier) {
+			continue;
+		}
+
+		if(streams[0].atBarrier && stream.currentEntry->getAddress() != barrierID) {
+			output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " released from barrier %" PRIu64 " with core 0 at barrier %" PRIu64 "\n",
+				i, stream.currentEntry->getAddress(), barrierID);
+		}
+
+		// The rest of the trace is replayed relative to the cycle every core left the barrier
+		stream.cycleOffset = (int64_t) currentCycle - (int64_t) stream.currentEntry->getIssueAtCycle();
+		stream.atBarrier = false;
+		stream.barriersPassed++;
+
+		stream.reader->releaseEntry(stream.currentEntry);
+		stream.currentEntry = stream.reader->readNextEntry();
+
+		if(NULL == stream.currentEntry) {
+			stream.traceEnded = true;
+			streamsEnded++;
+		}
 	}
 
-	// Keep simulation ticking, we have more work to do if we reach here
-	return false;
+	output->verbose(CALL_INFO, 4, 0, "Released barrier on cycle %" PRIu64 "\n", (uint64_t) currentCycle);
+
+	streamsAtBarrier = 0;
+	barriersCompleted++;
 }
 
-void ProsperoComponent::issueRequest(const ProsperoTraceEntry* entry) {
+void ProsperoComponent::issueRequest(ProsperoStream& stream, ProsperoTraceEntry* entry) {
     // Trim request size to cacheline length in case of instructions like xsave, fxsave, etc. (happens rarely)
     const uint64_t entryAddress = entry->getAddress();
     const uint64_t entryLength  = std::min((uint64_t) entry->getLength(), cacheLineSize);
@@ -293,9 +432,10 @@ void ProsperoComponent::issueRequest(const ProsperoTraceEntry* entry) {
                             0 /* instPtr */, 0 /* threadID */);
                     StandardMem::Read* readUpper = new StandardMem::Read(upperAddress, upperLength, 0 /* flags */, upperVirtualAddress,
                             0 /* instPtr */, 0 /* threadID */);
-                    cache_link->send(readLower);
-                    cache_link->send(readUpper);
+                    stream.cache_link->send(readLower);
+                    stream.cache_link->send(readUpper);
                     readsIssued += 2;
+                    stream.readsIssued += 2;
                     splitReadsIssued++;
                 } else {
                     std::vector<uint8_t> payload(lowerLength, 0);
@@ -304,30 +444,33 @@ void ProsperoComponent::issueRequest(const ProsperoTraceEntry* entry) {
                     payload.resize(upperLength, 0);
                     StandardMem::Write* writeUpper = new StandardMem::Write(upperAddress, upperLength, payload, false /* posted */,
                             0 /* flags */, upperVirtualAddress /* virtual address */, 0 /* instPtr */, 0 /* threadID */);
-                    cache_link->send(writeLower);
-                    cache_link->send(writeUpper);
+                    stream.cache_link->send(writeLower);
+                    stream.cache_link->send(writeUpper);
                     writesIssued += 2;
+                    stream.writesIssued += 2;
                     splitWritesIssued++;
                 }
 
-		currentOutstanding++;
-		currentOutstanding++;
+		stream.currentOutstanding++;
+		stream.currentOutstanding++;
 	} else {
 		// Perform a single load
                 StandardMem::Request* request;
                 if (isRead) {
                     request = new StandardMem::Read(memMgr->translate(entryAddress), entryLength, 0, entryAddress, 0, 0);
 		    readsIssued++;
+		    stream.readsIssued++;
                 } else {
                     std::vector<uint8_t> payload(entryLength, 0);
                     request = new StandardMem::Write(memMgr->translate(entryAddress), entryLength, payload, false, 0, entryAddress, 0, 0);
 		    writesIssued++;
+		    stream.writesIssued++;
                 }
-                cache_link->send(request);
+                stream.cache_link->send(request);
 
-		currentOutstanding++;
+		stream.currentOutstanding++;
 	}
 
-	// Delete this entry, we are done converting it into a request
-	delete entry;
+	// Hand this entry back to the reader, we are done converting it into a request
+	stream.reader->releaseEntry(entry);
 }
@@ -25,6 +25,8 @@
 #include "sst/core/link.h"
 #include "sst/core/interfaces/stdMem.h"
 
+#include <vector>
+
 #include "prosreader.h"
 #include "prosmemmgr.h"
 
@@ -38,6 +40,28 @@ using namespace SST::Interfaces;
 namespace SST {
 namespace Prospero {
 
+// Replay state of one trace stream, each stream is a core with its own link to memory
+class ProsperoStream {
+public:
+  ProsperoStream() : reader(NULL), currentEntry(NULL), cache_link(NULL),
+	traceEnded(false), atBarrier(false), cycleOffset(0), currentOutstanding(0),
+	readsIssued(0), writesIssued(0), barriersPassed(0), cyclesAtBarrier(0) {}
+
+  ProsperoTraceReader* reader;
+  ProsperoTraceEntry* currentEntry;
+  StandardMem* cache_link;
+  bool traceEnded;
+  bool atBarrier;
+  // Added to the cycles of the trace so that each core resumes in step after a barrier
+  int64_t cycleOffset;
+  uint32_t currentOutstanding;
+
+  uint64_t readsIssued;
+  uint64_t writesIssued;
+  uint64_t barriersPassed;
+  uint64_t cyclesAtBarrier;
+};
+
 class ProsperoComponent : public Component {
 public:
 
@@ -61,18 +85,21 @@ public:
 	{ "verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0" },
     	{ "cache_line_size", "Sets the length of the cache line in bytes, this should match the L1 cache", "64" },
     	{ "reader",  "The trace reader module to load", "prospero.ProsperoTextTraceReader" },
+    	{ "cores", "Number of trace streams replayed in step, each has its own reader and memory link. With more than one, %d in readerParams.file is replaced by the core number, a file name without %d is read by every core with the reader core parameter set to the core number (an interleaved prospero.ProsperoColumnarTraceReader trace)", "1" },
     	{ "pagesize", "Sets the page size for the Prospero simple virtual memory manager", "4096"},
     	{ "clock", "Sets the clock of the core", "2GHz"} ,
-    	{ "max_outstanding", "Sets the maximum number of outstanding transactions that the memory system will allow", "16"},
-    	{ "max_issue_per_cycle", "Sets the maximum number of new transactions that the system can issue per cycle", "2"},
+    	{ "max_outstanding", "Sets the maximum number of outstanding transactions that the memory system will allow, for each core", "16"},
+    	{ "max_issue_per_cycle", "Sets the maximum number of new transactions that the system can issue per cycle, for each core", "2"},
    )
 
    SST_ELI_DOCUMENT_PORTS(
-	{ "cache_link", "Link to the memHierarchy cache", { "memHierarchy.memEvent", "" } }
+	{ "cache_link", "Link to the memHierarchy cache", { "memHierarchy.memEvent", "" } },
+	{ "cache_link_%(cores)d", "Link to the memHierarchy cache of each core when cores is more than one", { "memHierarchy.memEvent", "" } }
    )
 
    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
-           {"memory", "Interface to the memory hierarchy (e.g., cache)", "SST::Interfaces::StandardMem" }
+           {"memory", "Interface to the memory hierarchy (e.g., cache), one per core", "SST::Interfaces::StandardMem" },
+           {"reader", "Trace reader, one per core", "SST::Prospero::ProsperoTraceReader" }
     )
 
 private:
@@ -80,24 +107,27 @@ private:
   ProsperoComponent(const ProsperoComponent&); // Do not impl.
   void operator=(const ProsperoComponent&);    // Do not impl.
 
-  void handleResponse( StandardMem::Request* ev );
+  void handleResponse( StandardMem::Request* ev, uint32_t core );
   bool tick( Cycle_t );
-  void issueRequest(const ProsperoTraceEntry* entry);
+  bool tickStream(ProsperoStream& stream, const uint32_t core, const Cycle_t currentCycle);
+  void releaseBarrier(const Cycle_t currentCycle);
+  void loadReaders(Params& params);
+  void loadMemoryLinks(TimeConverter* time);
+  void issueRequest(ProsperoStream& stream, ProsperoTraceEntry* entry);
 
   Output* output;
-  ProsperoTraceReader* reader;
-  ProsperoTraceEntry* currentEntry;
+  std::vector<ProsperoStream> streams;
+  uint32_t streamsEnded;
+  uint32_t streamsAtBarrier;
+  // All cores share one address space, as the threads of a traced process do
   ProsperoMemoryManager* memMgr;
-  StandardMem* cache_link;
   FILE* traceFile;
-  bool traceEnded;
 #ifdef HAVE_LIBZ
   gzFile traceFileZ;
 #endif
   uint64_t pageSize;
   uint64_t cacheLineSize;
   uint32_t maxOutstanding;
-  uint32_t currentOutstanding;
   uint32_t maxIssuePerCycle;
 
   uint64_t readsIssued;
@@ -108,6 +138,7 @@ private:
   uint64_t totalBytesWritten;
   uint64_t cyclesWithIssue;
   uint64_t cyclesWithNoIssue;
+  uint64_t barriersCompleted;
 
 };
 
@@ -22,12 +22,15 @@
 #include <sst/core/subcomponent.h>
 #include <sst/core/params.h>
 
+#include <vector>
+
 namespace SST {
 namespace Prospero {
 
 typedef enum {
 	READ,
-	WRITE
+	WRITE,
+	BARRIER
 } ProsperoTraceEntryOperation;
 
 class ProsperoTraceEntry {
@@ -41,17 +44,31 @@ public:
 
 		}
 
+	void reset(
+		const uint64_t eCyc,
+		const uint64_t eAddr,
+		const uint32_t eLen,
+		const ProsperoTraceEntryOperation eOp) {
+
+		cycles = eCyc;
+		address = eAddr;
+		length = eLen;
+		op = eOp;
+	}
+
 	bool isRead() const { return op == READ;  }
 	bool isWrite() const { return op == WRITE; }
+	// A barrier entry holds the barrier id in its address
+	bool isBarrier() const { return op == BARRIER; }
 	uint64_t getAddress() const { return address; }
 	uint32_t getLength() const { return length; }
 	uint64_t getIssueAtCycle() const { return cycles; }
 	ProsperoTraceEntryOperation getOperationType() const { return op; }
 private:
-	const uint64_t cycles;
-	const uint64_t address;
-	const uint32_t length;
-	const ProsperoTraceEntryOperation op;
+	uint64_t cycles;
+	uint64_t address;
+	uint32_t length;
+	ProsperoTraceEntryOperation op;
 };
 
 class ProsperoTraceReader : public SubComponent {
@@ -63,12 +80,45 @@ public:
             output = out;
         }
 
-	~ProsperoTraceReader() { };
+	~ProsperoTraceReader() {
+		for(size_t i = 0; i < entryPool.size(); ++i) {
+			delete entryPool[i];
+		}
+	};
 	virtual ProsperoTraceEntry* readNextEntry() { return NULL; };
 	void setOutput(Output* out) { output = out; }
 
+	// Entries are handed back once they have been issued and are reused by
+	// createEntry() rather than allocating one for every record of the trace
+	void releaseEntry(ProsperoTraceEntry* entry) { entryPool.push_back(entry); }
+
 protected:
+	// Trace records mark reads with R, barriers with B and anything else is a write
+	static ProsperoTraceEntryOperation decodeOperation(const char reqType) {
+		if(reqType == 'R' || reqType == 'r') {
+			return READ;
+		}
+		return (reqType == 'B' || reqType == 'b') ? BARRIER : WRITE;
+	}
+
+	ProsperoTraceEntry* createEntry(
+		const uint64_t eCyc,
+		const uint64_t eAddr,
+		const uint32_t eLen,
+		const ProsperoTraceEntryOperation eOp) {
+
+		if(entryPool.empty()) {
+			return new ProsperoTraceEntry(eCyc, eAddr, eLen, eOp);
+		}
+
+		ProsperoTraceEntry* entry = entryPool.back();
+		entryPool.pop_back();
+		entry->reset(eCyc, eAddr, eLen, eOp);
+		return entry;
+	}
+
 	Output* output;
+	std::vector<ProsperoTraceEntry*> entryPool;
 
 };
 
@@ -49,8 +49,8 @@ ProsperoTraceEntry* ProsperoTextTraceReader::readNextEntry() {
 		&reqCycles, &reqType, &reqAddress, &reqLength) ) {
 		return NULL;
 	} else {
-		return new ProsperoTraceEntry(reqCycles, reqAddress,
+		return createEntry(reqCycles, reqAddress,
 			reqLength,
-			(reqType == 'R' || reqType == 'r') ? READ : WRITE);
+			decodeOperation(reqType));
 	}
 }
@@ -0,0 +1,493 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_TRACE_FORMAT
+#define _H_SST_PROSPERO_TRACE_FORMAT
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include "zlib.h"
+#endif
+
+namespace SST {
+namespace Prospero {
+
+/*
+ * Columnar memory trace format shared by the trace writers and readers of
+ * prospero, ariel, cacheTracer and cramSim.
+ *
+ * A trace is a header, a sequence of blocks, a block index and a footer.
+ * Each block holds up to a fixed number of records stored as columns - time
+ * deltas, operations, cores, sizes and address deltas - that are each
+ * encoded as variable length integers, so neighbouring records that differ
+ * little take one or two bytes per column. A block is deflated when the
+ * writer was built with zlib and doing so makes it smaller.
+ *
+ * The index holds the offset and time range of every block, so a reader can
+ * seek to a time without decoding the blocks before it. Record times are
+ * expected to never decrease, which all of the writers guarantee.
+ *
+ *   header : magic, version, records per block
+ *   block  : codec, record count, raw length, stored length, stored bytes
+ *   index  : offset, first time, last time, record count of each block
+ *   footer : index offset, block count, magic
+ */
+#define COLUMNAR_TRACE_MAGIC   0x52544353
+#define COLUMNAR_TRACE_VERSION 1
+
+#define COLUMNAR_TRACE_CODEC_RAW     0
+#define COLUMNAR_TRACE_CODEC_DEFLATE 1
+
+#define COLUMNAR_TRACE_OP_READ  0
+#define COLUMNAR_TRACE_OP_WRITE 1
+// A barrier record holds the barrier id in its address
+#define COLUMNAR_TRACE_OP_BARRIER 2
+
+#define COLUMNAR_TRACE_COLUMNS 5
+
+struct ColumnarTraceRecord {
+	uint64_t time;
+	uint64_t address;
+	uint32_t size;
+	uint32_t core;
+	uint8_t  op;
+};
+
+struct ColumnarTraceBlockIndex {
+	uint64_t offset;
+	uint64_t firstTime;
+	uint64_t lastTime;
+	uint32_t records;
+	uint32_t reserved;
+};
+
+class ColumnarTraceCodec {
+public:
+	static void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+		while(value >= 0x80) {
+			out.push_back((uint8_t) (value | 0x80));
+			value >>= 7;
+		}
+		out.push_back((uint8_t) value);
+	}
+
+	static bool getVarint(const uint8_t*& in, const uint8_t* end, uint64_t* value) {
+		uint64_t result = 0;
+
+		for(uint32_t shift = 0; shift < 64 && in < end; shift += 7) {
+			const uint8_t next = *in++;
+			result |= ((uint64_t) (next & 0x7f)) << shift;
+
+			if(0 == (next & 0x80)) {
+				*value = result;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	static uint64_t zigzag(const uint64_t delta) {
+		return (delta << 1) ^ (uint64_t) (((int64_t) delta) >> 63);
+	}
+
+	static uint64_t unzigzag(const uint64_t value) {
+		return (value >> 1) ^ (~(value & 1) + 1);
+	}
+};
+
+class ColumnarTraceWriter {
+public:
+	ColumnarTraceWriter(const std::string& path, const uint32_t recordsPerBlock = 65536,
+		const bool compress = true) :
+		blockRecords(recordsPerBlock > 0 ? recordsPerBlock : 1), compressBlocks(compress) {
+
+		traceFile = fopen(path.c_str(), "wb");
+
+		if(NULL != traceFile) {
+			const uint32_t header[3] = { COLUMNAR_TRACE_MAGIC, COLUMNAR_TRACE_VERSION, blockRecords };
+			fwrite(header, sizeof(header), 1, traceFile);
+		}
+
+		pending.reserve(blockRecords);
+	}
+
+	~ColumnarTraceWriter() {
+		close();
+	}
+
+	bool isOpen() const { return NULL != traceFile; }
+
+	void addRecord(const uint64_t time, const uint64_t address, const uint32_t size,
+		const uint8_t op, const uint32_t core) {
+
+		ColumnarTraceRecord record;
+		record.time = time;
+		record.address = address;
+		record.size = size;
+		record.core = core;
+		record.op = op;
+		pending.push_back(record);
+
+		if(pending.size() >= blockRecords) {
+			flushBlock();
+		}
+	}
+
+	/* Write the last block, the index and the footer */
+	void close() {
+		if(NULL == traceFile) {
+			return;
+		}
+
+		flushBlock();
+
+		const uint64_t indexOffset = (uint64_t) ftello(traceFile);
+		if(!index.empty()) {
+			fwrite(&index[0], sizeof(ColumnarTraceBlockIndex), index.size(), traceFile);
+		}
+
+		const uint32_t blockCount = (uint32_t) index.size();
+		const uint32_t magic = COLUMNAR_TRACE_MAGIC;
+		fwrite(&indexOffset, sizeof(indexOffset), 1, traceFile);
+		fwrite(&blockCount, sizeof(blockCount), 1, traceFile);
+		fwrite(&magic, sizeof(magic), 1, traceFile);
+
+		fclose(traceFile);
+		traceFile = NULL;
+	}
+
+private:
+	void flushBlock() {
+		if(pending.empty()) {
+			return;
+		}
+
+		for(uint32_t i = 0; i < COLUMNAR_TRACE_COLUMNS; i++) {
+			columns[i].clear();
+		}
+
+		uint64_t prevTime = pending[0].time;
+		uint64_t prevAddr = 0;
+
+		for(size_t i = 0; i < pending.size(); i++) {
+			const ColumnarTraceRecord& record = pending[i];
+
+			ColumnarTraceCodec::putVarint(columns[0], ColumnarTraceCodec::zigzag(record.time - prevTime));
+			columns[1].push_back(record.op);
+			ColumnarTraceCodec::putVarint(columns[2], record.core);
+			ColumnarTraceCodec::putVarint(columns[3], record.size);
+			ColumnarTraceCodec::putVarint(columns[4], ColumnarTraceCodec::zigzag(record.address - prevAddr));
+
+			prevTime = record.time;
+			prevAddr = record.address;
+		}
+
+		// The block starts with the length of each of its columns
+		raw.clear();
+		for(uint32_t i = 0; i < COLUMNAR_TRACE_COLUMNS; i++) {
+			const uint32_t length = (uint32_t) columns[i].size();
+			raw.insert(raw.end(), (const uint8_t*) &length, ((const uint8_t*) &length) + sizeof(length));
+		}
+		for(uint32_t i = 0; i < COLUMNAR_TRACE_COLUMNS; i++) {
+			raw.insert(raw.end(), columns[i].begin(), columns[i].end());
+		}
+
+		uint32_t codec = COLUMNAR_TRACE_CODEC_RAW;
+		const uint8_t* stored = &raw[0];
+		uint32_t storedLength = (uint32_t) raw.size();
+
+#ifdef HAVE_LIBZ
+		if(compressBlocks) {
+			uLongf deflatedLength = compressBound((uLong) raw.size());
+			deflated.resize(deflatedLength);
+
+			if(Z_OK == compress2(&deflated[0], &deflatedLength, &raw[0], (uLong) raw.size(), Z_BEST_SPEED) &&
+				deflatedLength < raw.size()) {
+				codec = COLUMNAR_TRACE_CODEC_DEFLATE;
+				stored = &deflated[0];
+				storedLength = (uint32_t) deflatedLength;
+			}
+		}
+#endif
+
+		ColumnarTraceBlockIndex entry;
+		entry.offset = (uint64_t) ftello(traceFile);
+		entry.firstTime = pending.front().time;
+		entry.lastTime = pending.back().time;
+		entry.records = (uint32_t) pending.size();
+		entry.reserved = 0;
+		index.push_back(entry);
+
+		const uint32_t blockHeader[4] = { codec, entry.records, (uint32_t) raw.size(), storedLength };
+		fwrite(blockHeader, sizeof(blockHeader), 1, traceFile);
+		fwrite(stored, storedLength, 1, traceFile);
+
+		pending.clear();
+	}
+
+	FILE* traceFile;
+	const uint32_t blockRecords;
+	const bool compressBlocks;
+
+	std::vector<ColumnarTraceRecord> pending;
+	std::vector<ColumnarTraceBlockIndex> index;
+	std::vector<uint8_t> columns[COLUMNAR_TRACE_COLUMNS];
+	std::vector<uint8_t> raw;
+	std::vector<uint8_t> deflated;
+};
+
+class ColumnarTraceReader {
+public:
+	ColumnarTraceReader() : traceFile(NULL), nextBlock(0), nextRecord(0) {}
+
+	~ColumnarTraceReader() {
+		if(NULL != traceFile) {
+			fclose(traceFile);
+		}
+	}
+
+	/* Open a trace and load its index, on failure getError() says why */
+	bool open(const std::string& path) {
+		traceFile = fopen(path.c_str(), "rb");
+
+		if(NULL == traceFile) {
+			error = "the file could not be opened";
+			return false;
+		}
+
+		uint32_t header[3];
+		if(1 != fread(header, sizeof(header), 1, traceFile) || COLUMNAR_TRACE_MAGIC != header[0]) {
+			error = "the file is not a columnar trace";
+			return false;
+		}
+
+		if(COLUMNAR_TRACE_VERSION != header[1]) {
+			error = "the trace was written by an unsupported version of the format";
+			return false;
+		}
+
+		uint64_t indexOffset = 0;
+		uint32_t blockCount = 0;
+		uint32_t magic = 0;
+		const off_t footerLength = (off_t) (sizeof(indexOffset) + sizeof(blockCount) + sizeof(magic));
+
+		if(0 != fseeko(traceFile, -footerLength, SEEK_END) ||
+			1 != fread(&indexOffset, sizeof(indexOffset), 1, traceFile) ||
+			1 != fread(&blockCount, sizeof(blockCount), 1, traceFile) ||
+			1 != fread(&magic, sizeof(magic), 1, traceFile) ||
+			COLUMNAR_TRACE_MAGIC != magic) {
+			error = "the trace has no index, it was not closed by its writer";
+			return false;
+		}
+
+		index.resize(blockCount);
+		if(blockCount > 0 && (0 != fseeko(traceFile, (off_t) indexOffset, SEEK_SET) ||
+			blockCount != fread(&index[0], sizeof(ColumnarTraceBlockIndex), blockCount, traceFile))) {
+			error = "the block index of the trace could not be read";
+			return false;
+		}
+
+		return true;
+	}
+
+	const std::string& getError() const { return error; }
+
+	uint64_t getBlockCount() const { return index.size(); }
+
+	uint64_t getRecordCount() const {
+		uint64_t count = 0;
+		for(size_t i = 0; i < index.size(); i++) {
+			count += index[i].records;
+		}
+		return count;
+	}
+
+	/* Position the reader on the first record at or after a time */
+	bool seekToTime(const uint64_t time) {
+		size_t low = 0;
+		size_t high = index.size();
+
+		while(low < high) {
+			const size_t mid = low + (high - low) / 2;
+			if(index[mid].lastTime < time) {
+				low = mid + 1;
+			} else {
+				high = mid;
+			}
+		}
+
+		nextBlock = low;
+		records.clear();
+		nextRecord = 0;
+
+		if(nextBlock < index.size()) {
+			if(!loadBlock()) {
+				return false;
+			}
+
+			while(nextRecord < records.size() && records[nextRecord].time < time) {
+				nextRecord++;
+			}
+		}
+
+		return true;
+	}
+
+	/* Read the next record, returns false at the end of the trace or on a corrupt block */
+	bool next(ColumnarTraceRecord* record) {
+		while(nextRecord >= records.size()) {
+			if(nextBlock >= index.size() || !loadBlock()) {
+				return false;
+			}
+		}
+
+		*record = records[nextRecord++];
+		return true;
+	}
+
+private:
+	bool loadBlock() {
+		const ColumnarTraceBlockIndex& entry = index[nextBlock++];
+		uint32_t blockHeader[4];
+
+		records.clear();
+		nextRecord = 0;
+
+		if(0 != fseeko(traceFile, (off_t) entry.offset, SEEK_SET) ||
+			1 != fread(blockHeader, sizeof(blockHeader), 1, traceFile)) {
+			error = "a block of the trace could not be read";
+			return false;
+		}
+
+		const uint32_t codec = blockHeader[0];
+		const uint32_t count = blockHeader[1];
+		const uint32_t rawLength = blockHeader[2];
+		const uint32_t storedLength = blockHeader[3];
+
+		stored.resize(storedLength > 0 ? storedLength : 1);
+		if(storedLength > 0 && 1 != fread(&stored[0], storedLength, 1, traceFile)) {
+			error = "a block of the trace is truncated";
+			return false;
+		}
+
+		const uint8_t* data = &stored[0];
+
+		if(COLUMNAR_TRACE_CODEC_DEFLATE == codec) {
+#ifdef HAVE_LIBZ
+			uLongf inflatedLength = rawLength;
+			raw.resize(rawLength > 0 ? rawLength : 1);
+
+			if(Z_OK != uncompress(&raw[0], &inflatedLength, &stored[0], storedLength) ||
+				inflatedLength != rawLength) {
+				error = "a compressed block of the trace is corrupt";
+				return false;
+			}
+			data = &raw[0];
+#else
+			error = "the trace has compressed blocks and SST was built without zlib";
+			return false;
+#endif
+		} else if(COLUMNAR_TRACE_CODEC_RAW != codec || rawLength != storedLength) {
+			error = "a block of the trace uses an unknown encoding";
+			return false;
+		}
+
+		return decodeBlock(data, rawLength, count);
+	}
+
+	bool decodeBlock(const uint8_t* data, const uint32_t length, const uint32_t count) {
+		const uint8_t* column[COLUMNAR_TRACE_COLUMNS];
+		const uint8_t* columnEnd[COLUMNAR_TRACE_COLUMNS];
+		uint64_t offset = COLUMNAR_TRACE_COLUMNS * sizeof(uint32_t);
+
+		if(length < offset) {
+			error = "a block of the trace is corrupt";
+			return false;
+		}
+
+		for(uint32_t i = 0; i < COLUMNAR_TRACE_COLUMNS; i++) {
+			uint32_t columnLength;
+			memcpy(&columnLength, data + (i * sizeof(uint32_t)), sizeof(columnLength));
+
+			if(offset + columnLength > length) {
+				error = "a block of the trace is corrupt";
+				return false;
+			}
+
+			column[i] = data + offset;
+			columnEnd[i] = column[i] + columnLength;
+			offset += columnLength;
+		}
+
+		if((uint64_t) (columnEnd[1] - column[1]) != count) {
+			error = "a block of the trace is corrupt";
+			return false;
+		}
+
+		records.resize(count);
+
+		uint64_t prevTime = index[nextBlock - 1].firstTime;
+		uint64_t prevAddr = 0;
+
+		for(uint32_t i = 0; i < count; i++) {
+			uint64_t timeDelta, core, size, addrDelta;
+
+			if(!ColumnarTraceCodec::getVarint(column[0], columnEnd[0], &timeDelta) ||
+				!ColumnarTraceCodec::getVarint(column[2], columnEnd[2], &core) ||
+				!ColumnarTraceCodec::getVarint(column[3], columnEnd[3], &size) ||
+				!ColumnarTraceCodec::getVarint(column[4], columnEnd[4], &addrDelta)) {
+				records.clear();
+				error = "a block of the trace is corrupt";
+				return false;
+			}
+
+			ColumnarTraceRecord& record = records[i];
+			record.time = prevTime + ColumnarTraceCodec::unzigzag(timeDelta);
+			record.op = *column[1]++;
+			record.core = (uint32_t) core;
+			record.size = (uint32_t) size;
+			record.address = prevAddr + ColumnarTraceCodec::unzigzag(addrDelta);
+
+			prevTime = record.time;
+			prevAddr = record.address;
+		}
+
+		return true;
+	}
+
+	FILE* traceFile;
+	std::string error;
+
+	std::vector<ColumnarTraceBlockIndex> index;
+	size_t nextBlock;
+
+	std::vector<ColumnarTraceRecord> records;
+	size_t nextRecord;
+
+	std::vector<uint8_t> stored;
+	std::vector<uint8_t> raw;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,155 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_ASYNC_OP_TABLE
+#define _H_ASYNC_OP_TABLE
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace SST {
+namespace MemHierarchy {
+
+// Table of in-flight operations keyed by StandardMem request ID.
+//
+// Operations live in a slab (std::deque, so references stay valid while
+// the table grows) and released slots are recycled; the vectors inside a
+// recycled operation keep their capacity. Request IDs map to slab slots
+// through an open-addressing hash table with linear probing and
+// backward-shift deletion, sized to a power of two and kept at most
+// half full. Memory is bounded by the peak number of in-flight requests.
+template<typename Op>
+class AsyncOpTable {
+public:
+    typedef uint64_t Key;
+
+    AsyncOpTable(size_t initial_capacity = 64) : count(0) {
+        size_t cap = 16;
+        while (cap < initial_capacity * 2) cap <<= 1;
+        buckets.assign(cap, Bucket());
+    }
+
+    // Returns the operation tracked for 'key', creating it if needed
+    Op& insert(Key key) {
+        if ((count + 1) * 2 > buckets.size()) {
+            grow();
+        }
+        size_t idx = probe(key);
+        if (buckets[idx].used) {
+            return slab[buckets[idx].slot];
+        }
+        buckets[idx].used = true;
+        buckets[idx].key = key;
+        buckets[idx].slot = allocate();
+        count++;
+        return slab[buckets[idx].slot];
+    }
+
+    Op* find(Key key) {
+        size_t idx = probe(key);
+        return buckets[idx].used ? &slab[buckets[idx].slot] : nullptr;
+    }
+
+    bool contains(Key key) { return find(key) != nullptr; }
+
+    void erase(Key key) {
+        size_t idx = probe(key);
+        if (!buckets[idx].used) {
+            return;
+        }
+        release(buckets[idx].slot);
+        buckets[idx].used = false;
+        count--;
+
+        // Backward-shift the rest of the probe run so lookups never need tombstones
+        size_t mask = buckets.size() - 1;
+        size_t hole = idx;
+        size_t next = (idx + 1) & mask;
+        while (buckets[next].used) {
+            size_t home = hash(buckets[next].key) & mask;
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                buckets[hole] = buckets[next];
+                buckets[next].used = false;
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+    }
+
+    size_t size() const { return count; }
+    size_t slabSize() const { return slab.size(); }
+
+private:
+    struct Bucket {
+        Bucket() : key(0), slot(0), used(false) {}
+        Key key;
+        uint32_t slot;
+        bool used;
+    };
+
+    static size_t hash(Key key) {
+        // splitmix64 finalizer - request IDs are sequential, so spread them
+        key ^= key >> 30;
+        key *= 0xBF58476D1CE4E5B9ULL;
+        key ^= key >> 27;
+        key *= 0x94D049BB133111EBULL;
+        key ^= key >> 31;
+        return (size_t)key;
+    }
+
+    // Index of the bucket holding 'key', or the empty bucket where it belongs
+    size_t probe(Key key) const {
+        size_t mask = buckets.size() - 1;
+        size_t idx = hash(key) & mask;
+        while (buckets[idx].used && buckets[idx].key != key) {
+            idx = (idx + 1) & mask;
+        }
+        return idx;
+    }
+
+    void grow() {
+        std::vector<Bucket> old;
+        old.swap(buckets);
+        buckets.assign(old.size() * 2, Bucket());
+        for (const Bucket& b : old) {
+            if (b.used) {
+                buckets[probe(b.key)] = b;
+            }
+        }
+    }
+
+    uint32_t allocate() {
+        if (!free_slots.empty()) {
+            uint32_t slot = free_slots.back();
+            free_slots.pop_back();
+            return slot;
+        }
+        slab.emplace_back();
+        return slab.size() - 1;
+    }
+
+    void release(uint32_t slot) {
+        slab[slot].reset();
+        free_slots.push_back(slot);
+    }
+
+    std::vector<Bucket> buckets;
+    std::deque<Op> slab;
+    std::vector<uint32_t> free_slots;
+    size_t count;
+};
+
+} // namespace MemHierarchy
+} // namespace SST
+
+#endif // _H_ASYNC_OP_TABLE
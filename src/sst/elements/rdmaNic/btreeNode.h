@@ -0,0 +1,150 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_BTREE_NODE
+#define _H_BTREE_NODE
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace SST {
+namespace MemHierarchy {
+
+// Fixed-size B+tree node image, identical in remote memory and on the wire:
+//
+//   ┌──────────────────┬──────────────────┬──────────────────┬────────────────────────┐
+//   │ BTreeNodeHeader  │ keys[fanout]     │ values[fanout]   │ children[fanout + 1]   │
+//   │ 32 bytes         │ 8 bytes each     │ 8 bytes each     │ 8 bytes each           │
+//   └──────────────────┴──────────────────┴──────────────────┴────────────────────────┘
+//
+// Every field is naturally aligned, so a response payload can be read in
+// place through a BTreeNodeView without unpacking it.
+//
+// The first word packs the node version and a lock bit (version << 1 | locked)
+// so a writer can lock a node and validate its copy with one remote CAS at
+// node offset 0, and unlock it by writing the node back with the next version.
+//
+// Leaves have no children; the last child slot holds the address of the
+// leaf's right sibling (0 for the rightmost leaf), which range scans follow.
+struct BTreeNodeHeader {
+    uint64_t version_lock;      // Version << 1 | lock bit
+    uint32_t num_keys;          // Number of keys currently in node
+    uint32_t fanout;            // Maximum keys per node
+    uint32_t is_leaf;           // Leaf (1) or internal (0) node
+    uint32_t reserved;
+    uint64_t node_address;      // Address in memory server
+};
+
+const uint64_t BTREE_NODE_LOCK_BIT = 1;
+
+// Unlocked version/lock word following 'word' (used when a writer releases a node)
+inline uint64_t btree_next_version_word(uint64_t word) {
+    return ((word >> 1) + 1) << 1;
+}
+
+// Size in bytes of a node image for a given fanout
+inline size_t btree_node_image_size(uint32_t fanout) {
+    return sizeof(BTreeNodeHeader) + (3 * (size_t)fanout + 1) * sizeof(uint64_t);
+}
+
+class BTreeNode;
+
+// Read-only view of a node image owned by someone else (a response
+// payload, a cached node, ...). Valid only while the underlying bytes live.
+class BTreeNodeView {
+public:
+    BTreeNodeView() : base(nullptr), fanout_(0) {}
+    BTreeNodeView(const uint8_t* image, uint32_t fanout) : base(image), fanout_(fanout) {}
+    inline BTreeNodeView(const BTreeNode& node);
+
+    uint32_t num_keys() const { return header()->num_keys; }
+    bool is_leaf() const { return header()->is_leaf != 0; }
+    uint64_t version_lock() const { return header()->version_lock; }
+    uint64_t version() const { return header()->version_lock >> 1; }
+    bool is_locked() const { return (header()->version_lock & BTREE_NODE_LOCK_BIT) != 0; }
+    uint64_t node_address() const { return header()->node_address; }
+    uint32_t fanout() const { return fanout_; }
+
+    const uint64_t* keys() const { return reinterpret_cast<const uint64_t*>(base + sizeof(BTreeNodeHeader)); }
+    const uint64_t* values() const { return keys() + fanout_; }
+    const uint64_t* children() const { return keys() + 2 * (size_t)fanout_; }
+    uint64_t next_leaf() const { return children()[fanout_]; }
+
+    const uint8_t* data() const { return base; }
+    size_t size() const { return btree_node_image_size(fanout_); }
+
+private:
+    const BTreeNodeHeader* header() const { return reinterpret_cast<const BTreeNodeHeader*>(base); }
+
+    const uint8_t* base;
+    uint32_t fanout_;
+};
+
+// Owning, mutable node image. A single allocation holds the header and
+// all three arrays; used when a node is modified and written back.
+class BTreeNode {
+public:
+    explicit BTreeNode(uint32_t fanout_size = 16) :
+        fanout_(fanout_size), image((btree_node_image_size(fanout_size) + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0)
+    {
+        header()->fanout = fanout_;
+        header()->is_leaf = 1;
+    }
+
+    explicit BTreeNode(const BTreeNodeView& view) :
+        fanout_(view.fanout()), image((view.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0)
+    {
+        std::memcpy(image.data(), view.data(), view.size());
+    }
+
+    uint32_t& num_keys() { return header()->num_keys; }
+    uint32_t num_keys() const { return header()->num_keys; }
+    uint32_t& is_leaf() { return header()->is_leaf; }
+    bool is_leaf() const { return header()->is_leaf != 0; }
+    uint64_t& version_lock() { return header()->version_lock; }
+    uint64_t version_lock() const { return header()->version_lock; }
+    uint64_t version() const { return header()->version_lock >> 1; }
+    bool is_locked() const { return (header()->version_lock & BTREE_NODE_LOCK_BIT) != 0; }
+    uint64_t& node_address() { return header()->node_address; }
+    uint64_t node_address() const { return header()->node_address; }
+    uint32_t fanout() const { return fanout_; }
+
+    uint64_t* keys() { return reinterpret_cast<uint64_t*>(bytes() + sizeof(BTreeNodeHeader)); }
+    const uint64_t* keys() const { return reinterpret_cast<const uint64_t*>(data() + sizeof(BTreeNodeHeader)); }
+    uint64_t* values() { return keys() + fanout_; }
+    const uint64_t* values() const { return keys() + fanout_; }
+    uint64_t* children() { return keys() + 2 * (size_t)fanout_; }
+    const uint64_t* children() const { return keys() + 2 * (size_t)fanout_; }
+    uint64_t& next_leaf() { return children()[fanout_]; }
+    uint64_t next_leaf() const { return children()[fanout_]; }
+
+    const uint8_t* data() const { return reinterpret_cast<const uint8_t*>(image.data()); }
+    size_t size() const { return btree_node_image_size(fanout_); }
+
+    // Copy of the image suitable for a StandardMem::Write payload
+    std::vector<uint8_t> to_bytes() const { return std::vector<uint8_t>(data(), data() + size()); }
+
+private:
+    uint8_t* bytes() { return reinterpret_cast<uint8_t*>(image.data()); }
+    BTreeNodeHeader* header() { return reinterpret_cast<BTreeNodeHeader*>(image.data()); }
+    const BTreeNodeHeader* header() const { return reinterpret_cast<const BTreeNodeHeader*>(image.data()); }
+
+    uint32_t fanout_;
+    std::vector<uint64_t> image;    // 8-byte aligned backing store
+};
+
+inline BTreeNodeView::BTreeNodeView(const BTreeNode& node) : base(node.data()), fanout_(node.fanout()) {}
+
+} // namespace MemHierarchy
+} // namespace SST
+
+#endif // _H_BTREE_NODE
@@ -25,7 +25,8 @@
 // │                    (Disaggregated Memory Servers)                       │
 // └─────────────────────────────────────────────────────────────────────────┘
 //
-// Each Memory Server has 16 MB of address space:
+// Each Memory Server has 16 MB of address space (memory_server_window_mb,
+// which must match on compute and memory servers):
 //
 //   Memory Server 0: 0x10000000 - 0x10FFFFFF  (16 MB)
 //   Memory Server 1: 0x11000000 - 0x11FFFFFF  (16 MB)
@@ -34,20 +35,23 @@
 //   ...
 //   Memory Server N: 0x10000000 + N*0x1000000 to 0x10000000 + (N+1)*0x1000000
 //
-// Within EACH Memory Server's 16MB space, B+tree nodes are organized by level:
+// Within EACH Memory Server's space:
 //
 //   ┌──────────────────────────────────────────────────────────────┐
-//   │ Address Range        │ Tree Level      │ Size      │ Usage   │
+//   │ Address Range        │ Usage                                 │
 //   ├──────────────────────────────────────────────────────────────┤
-//   │ 0x00000 - 0x0FFFF   │ Root (Level 0)   │ 64 KB     │ Root    │
-//   │ 0x10000 - 0x1FFFF   │ Level 1          │ 64 KB     │ Internal│
-//   │ 0x20000 - 0x3FFFF   │ Level 2          │ 128 KB    │ Internal│
-//   │ 0x40000 - 0x1FFFFF  │ Level 3+         │ 1.75 MB   │ Internal│
-//   │ 0x200000 - 0xFFFFFF │ Leaves           │ 14 MB     │ Leaf    │
+//   │ 0x00000 - 0x7FFFF    │ Initial root or hash directory (srv 0)│
+//   │ 0x80000 - 0xFFFFF    │ Write-ahead log (wal_server only)     │
+//   │ 0x100000 - 0x1FFFFF  │ Lock region (memory server lock table)│
+//   │ 0x200000 - window    │ Node heap, bump-allocated node slots  │
 //   └──────────────────────────────────────────────────────────────┘
 //
+// placement_policy picks the server for each new node (round_robin, hash,
+// range or locality); the node then takes the next free slot in that
+// server's heap, so node addresses never collide.
+//
 // Example: Root node on Memory Server 0 = 0x10000000
-//          Leaf node on Memory Server 2 = 0x12200000 + offset
+//          Leaf node on Memory Server 2 = 0x12200000 + slot * node size
 //
 // ┌─────────────────────────────────────────────────────────────────────────┐
 // │                    LOCAL COMPUTE SERVER MEMORY                          │
@@ -111,7 +115,11 @@
 #include "computeServer.h"
 #include <sst/core/interfaces/stdMem.h>
 #include <cstdio>
+#include <cstdlib>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <sstream>
 
 // ═══════════════════════════════════════════════════════════════════════════
 // MEMORY ADDRESS CONSTANTS
@@ -119,16 +127,18 @@
 
 // Remote Memory Server Address Space
 const uint64_t MEMORY_BASE_ADDRESS = 0x10000000;   // Base address for all memory servers
-const uint64_t MEMORY_SERVER_SIZE  = 0x1000000;    // 16 MB per memory server
-// Memory Server N range: [MEMORY_BASE_ADDRESS + N*MEMORY_SERVER_SIZE, 
-//                         MEMORY_BASE_ADDRESS + (N+1)*MEMORY_SERVER_SIZE)
+// Memory Server N range: [MEMORY_BASE_ADDRESS + N*memory_server_window, 
+//                         MEMORY_BASE_ADDRESS + (N+1)*memory_server_window)
 
-// Per-Server B+tree Level Offsets (relative to server's base)
-const uint64_t BTREE_LEVEL0_OFFSET = 0x00000;      // Root level: 0-64KB
-const uint64_t BTREE_LEVEL1_OFFSET = 0x10000;      // Level 1: 64KB-128KB
-const uint64_t BTREE_LEVEL2_OFFSET = 0x20000;      // Level 2: 128KB-256KB
-const uint64_t BTREE_LEVEL3_OFFSET = 0x40000;      // Level 3+: 256KB-2MB
-const uint64_t BTREE_LEAF_OFFSET   = 0x200000;     // Leaves: 2MB-16MB
+// Per-Server B+tree Offsets (relative to server's base)
+const uint64_t BTREE_ROOT_OFFSET   = 0x00000;      // Initial root
+const uint64_t HASH_DIRECTORY_OFFSET = 0x00000;    // Hash index directory, in place of the root (index_engine=hash)
+const uint64_t HASH_DIRECTORY_END  = 0x80000;
+const uint64_t HASH_KV_CHUNK_SIZE  = 4096;         // KV blocks are carved from heap chunks of this size
+const uint64_t BTREE_LOG_OFFSET    = 0x80000;      // Write-ahead log space, one slice per compute server
+const uint64_t BTREE_LOG_END       = 0x100000;
+const uint64_t BTREE_HEAP_OFFSET   = 0x200000;     // Node heap, above the lock region
+const uint64_t WAL_RECORD_SIZE     = 32;           // LSN, key, value, compute server
 
 // Local Compute Server Buffers (temporary storage for remote reads)
 const uint64_t LOCAL_BUFFER_BASE       = 0x2000000;  // Base for tree traversal buffers
@@ -139,7 +149,6 @@ const uint64_t LOCAL_FINDPARENT_BUFFER = 0x5000000;  // find_parent traversal bu
 const uint64_t LOCAL_VERIFY_BUFFER     = 0x6000000;  // Parent verification buffer
 
 // Helper macros
-#define GET_MEMORY_SERVER(addr) (((addr) - MEMORY_BASE_ADDRESS) / MEMORY_SERVER_SIZE)
 #define GET_LOCAL_BUFFER(level) (LOCAL_BUFFER_BASE + (level) * LOCAL_BUFFER_SPACING)
 
 using namespace SST;
@@ -149,8 +158,28 @@ ComputeServer::ComputeServer(ComponentId_t id, Params& params) :
     SST::Component(id),
     rng(std::random_device{}() + id),  // Add component ID to ensure different seeds
     uniform_dist(0.0, 1.0),
+    next_op_valid(false),
+    workload_done(false),
+    op_interval(0),
+    next_op_time(0),
+    ops_issued(0),
+    ops_in_flight(0),
+    ops_arrived(0),
+    trace_lines_skipped(0),
+    next_scan_id(0),
+    hash_global_depth(0),
+    hash_kv_chunk(0),
+    hash_kv_chunk_used(0),
+    next_hash_id(0),
+    learned_drift(0),
+    next_lookup_id(0),
+    empty_node(params.find<uint32_t>("btree_fanout", 16)),
     last_op_time(0)
 {
+    // Setup debug output with maximum verbosity for address visibility
+    dbg.init("", 5, 0, (Output::output_location_t)1);  // Force high verbosity
+    out.init("ComputeServer[@p:@l]: ", 1, 0, Output::STDOUT);
+
     // Parse configuration parameters
     node_id = params.find<uint32_t>("node_id", 0);
     num_memory_nodes = params.find<uint32_t>("num_memory_nodes", 4);
@@ -160,14 +189,194 @@ ComputeServer::ComputeServer(ComponentId_t id, Params& params) :
     zipfian_alpha = params.find<double>("zipfian_alpha", 0.9);
     std::string key_dist = params.find<std::string>("key_distribution", "zipfian"); // New parameter
     read_ratio = params.find<double>("read_ratio", 0.95);
+    scan_ratio = params.find<double>("scan_ratio", (workload_type == "ycsb_e") ? 1.0 : 0.0);
+    scan_length = params.find<uint32_t>("scan_length", 100);
+    scan_prefetch_depth = params.find<uint32_t>("scan_prefetch_depth", 4);
+    if (scan_length == 0 || scan_prefetch_depth == 0) {
+        out.fatal(CALL_INFO, -1, "scan_length and scan_prefetch_depth must be greater than 0\n");
+    }
     btree_fanout = params.find<uint32_t>("btree_fanout", 16);
     key_range = params.find<uint64_t>("key_range", 1000000);
     verbose_level = params.find<int>("verbose", 0);
+    trace_file = params.find<std::string>("workload_trace", "");
+    index_cache_capacity = params.find<uint32_t>("index_cache_size", 0);
+    index_cache_hit_latency = params.find<SimTime_t>("index_cache_hit_latency_ns", 100);
+    index_cache_version = 0;
+    read_batch_size = params.find<uint32_t>("read_batch_size", 1);
+    read_batch_window = params.find<SimTime_t>("read_batch_window_ns", 0);
+    if (read_batch_size == 0) {
+        read_batch_size = 1;
+    }
+    path_prefetch = params.find<bool>("path_prefetch", false);
+    path_prefetch_levels = params.find<uint32_t>("path_prefetch_levels", 8);
+    path_prefetch_hint_capacity = params.find<uint32_t>("path_prefetch_hints", 65536);
+    path_hint_version = 0;
+    next_prefetch_id = 0;
+    std::string cc_mode = params.find<std::string>("concurrency_control", "none");
+    optimistic_retry_backoff = params.find<SimTime_t>("optimistic_retry_backoff_ns", 200);
+    if (cc_mode == "optimistic") {
+        optimistic_cc = true;
+    } else if (cc_mode == "none") {
+        optimistic_cc = false;
+    } else {
+        out.fatal(CALL_INFO, -1, "Unknown concurrency_control '%s' (expected none or optimistic)\n", cc_mode.c_str());
+    }
+    std::string access_mode = params.find<std::string>("access_mode", "one_sided");
+    if (access_mode == "rpc") {
+        rpc_offload = true;
+    } else if (access_mode == "one_sided") {
+        rpc_offload = false;
+    } else {
+        out.fatal(CALL_INFO, -1, "Unknown access_mode '%s' (expected one_sided or rpc)\n", access_mode.c_str());
+    }
+    lock_coalescing = params.find<bool>("lock_coalescing", false);
+    lock_handover_limit = params.find<uint32_t>("lock_handover_limit", 8);
+    write_combining = params.find<bool>("write_combining", true);
+    if (lock_coalescing && !optimistic_cc) {
+        out.fatal(CALL_INFO, -1, "lock_coalescing requires concurrency_control=optimistic\n");
+    }
+    cpu_cores = params.find<uint32_t>("cpu_cores", 0);
+    cpu_frequency_ghz = params.find<double>("cpu_frequency_ghz", 2.0);
+    cpu_cycles_per_key = params.find<double>("cpu_cycles_per_key", 4.0);
+    cpu_cycles_per_byte = params.find<double>("cpu_cycles_per_byte", 0.25);
+    cpu_cycles_per_split = params.find<double>("cpu_cycles_per_split", 2000.0);
+    if (cpu_cores > 0 && cpu_frequency_ghz <= 0.0) {
+        out.fatal(CALL_INFO, -1, "cpu_frequency_ghz must be positive, got %f\n", cpu_frequency_ghz);
+    }
+    cpu_core_free_at.resize(cpu_cores, 0);
+    cpu_busy_total = 0;
+    wal_enabled = params.find<bool>("wal_enabled", false);
+    wal_server = params.find<uint32_t>("wal_server", 0);
+    wal_size = params.find<uint64_t>("wal_log_size_kb", 8) * 1024;
+    wal_group_size = params.find<uint32_t>("wal_group_size", 1);
+    wal_group_timeout = params.find<SimTime_t>("wal_group_timeout_ns", 0);
+    wal_base = BTREE_LOG_OFFSET + node_id * wal_size;
+    wal_tail = 0;
+    wal_next_lsn = 1;
+    wal_group_seq = 0;
+    if (wal_enabled) {
+        if (wal_server >= num_memory_nodes) {
+            out.fatal(CALL_INFO, -1, "wal_server (%u) must be below num_memory_nodes (%u)\n", wal_server, num_memory_nodes);
+        }
+        if (wal_group_size == 0 || wal_group_size * WAL_RECORD_SIZE > wal_size) {
+            out.fatal(CALL_INFO, -1, "wal_group_size must be at least 1 and its records must fit in wal_log_size_kb\n");
+        }
+        if (wal_base + wal_size > BTREE_LOG_END) {
+            out.fatal(CALL_INFO, -1, "Log space for compute server %d runs past the log region; lower wal_log_size_kb\n", node_id);
+        }
+    }
+    std::string load = params.find<std::string>("load_mode", "fixed");
+    if (load == "fixed") {
+        load_mode = LOAD_FIXED;
+    } else if (load == "open") {
+        load_mode = LOAD_OPEN;
+    } else if (load == "closed") {
+        load_mode = LOAD_CLOSED;
+    } else {
+        out.fatal(CALL_INFO, -1, "Unknown load_mode '%s' (expected fixed, open or closed)\n", load.c_str());
+    }
+    max_inflight = params.find<uint32_t>("max_inflight", 0);
+    closed_loop_clients = params.find<uint32_t>("closed_loop_clients", 1);
+    think_time = params.find<SimTime_t>("think_time_ns", 0);
+    if (load_mode == LOAD_CLOSED && closed_loop_clients == 0) {
+        out.fatal(CALL_INFO, -1, "closed_loop_clients must be at least 1\n");
+    }
+    std::string placement = params.find<std::string>("placement_policy", "round_robin");
+    if (placement == "round_robin") {
+        placement_policy = PLACE_ROUND_ROBIN;
+    } else if (placement == "hash") {
+        placement_policy = PLACE_HASH;
+    } else if (placement == "range") {
+        placement_policy = PLACE_RANGE;
+    } else if (placement == "locality") {
+        placement_policy = PLACE_LOCALITY;
+    } else {
+        out.fatal(CALL_INFO, -1, "Unknown placement_policy '%s' (expected round_robin, hash, range or locality)\n",
+                  placement.c_str());
+    }
+    memory_server_window = params.find<uint64_t>("memory_server_window_mb", 16) * 1024 * 1024;
+    if (memory_server_window <= BTREE_HEAP_OFFSET) {
+        out.fatal(CALL_INFO, -1, "memory_server_window_mb must leave room for a node heap above 0x%lx\n",
+                  BTREE_HEAP_OFFSET);
+    }
+    server_slot_capacity = (memory_server_window - BTREE_HEAP_OFFSET) / btree_node_image_size(btree_fanout);
+    server_slots_used.resize(num_memory_nodes, 0);
+    server_request_counts.resize(num_memory_nodes, 0);
+
+    if (key_range == 0) {
+        out.fatal(CALL_INFO, -1, "key_range must be greater than 0\n");
+    }
+    bulk_load_keys = params.find<uint64_t>("bulk_load_keys", 0);
+    bulk_load_fill = params.find<double>("bulk_load_fill_factor", 1.0);
+    bulk_loaded = false;
+    if (bulk_load_keys > key_range) {
+        out.fatal(CALL_INFO, -1, "bulk_load_keys (%lu) cannot exceed key_range (%lu)\n", bulk_load_keys, key_range);
+    }
+    if (bulk_load_fill <= 0.0 || bulk_load_fill > 1.0) {
+        out.fatal(CALL_INFO, -1, "bulk_load_fill_factor must be in (0, 1], got %f\n", bulk_load_fill);
+    }
+    std::string index_engine = params.find<std::string>("index_engine", "btree");
+    learned_error_bound = params.find<uint32_t>("learned_error_bound", 4);
+    learned_retrain_interval = params.find<uint32_t>("learned_retrain_interval", 64);
+    hash_groups = params.find<uint32_t>("hash_subtable_groups", 64);
+    hash_initial_depth = params.find<uint32_t>("hash_initial_depth", 2);
+    hash_max_depth = params.find<uint32_t>("hash_max_depth", 12);
+    learned_index = (index_engine == "learned");
+    hash_index = (index_engine == "hash");
+    if (!learned_index && !hash_index && index_engine != "btree") {
+        out.fatal(CALL_INFO, -1, "Unknown index_engine '%s' (expected btree, hash or learned)\n", index_engine.c_str());
+    }
+    if (hash_index) {
+        if (rpc_offload) {
+            out.fatal(CALL_INFO, -1, "index_engine=hash needs access_mode=one_sided\n");
+        }
+        if (scan_ratio > 0.0) {
+            out.fatal(CALL_INFO, -1, "index_engine=hash has no key order, so scan_ratio must be 0\n");
+        }
+        if (hash_groups == 0) {
+            out.fatal(CALL_INFO, -1, "hash_subtable_groups must be greater than 0\n");
+        }
+        // The directory lives in the root region of memory server 0
+        uint64_t max_entries = (HASH_DIRECTORY_END - HASH_DIRECTORY_OFFSET - RACE_DIRECTORY_HEADER) / sizeof(uint64_t);
+        if (hash_max_depth > 15 || (1ULL << hash_max_depth) > max_entries || hash_initial_depth > hash_max_depth) {
+            out.fatal(CALL_INFO, -1, "hash_initial_depth (%u) and hash_max_depth (%u) must satisfy initial <= max <= 15\n",
+                      hash_initial_depth, hash_max_depth);
+        }
+        uint64_t subtable_bytes = race_subtable_size(hash_groups);
+        if (subtable_bytes > memory_server_window - BTREE_HEAP_OFFSET) {
+            out.fatal(CALL_INFO, -1, "A subtable of %u groups (%lu bytes) does not fit a memory server heap\n",
+                      hash_groups, subtable_bytes);
+        }
+    }
+    if (learned_index && (bulk_load_keys == 0 || rpc_offload || optimistic_cc)) {
+        out.fatal(CALL_INFO, -1, "index_engine=learned needs bulk_load_keys > 0, access_mode=one_sided and concurrency_control=none\n");
+    }
+    if (learned_retrain_interval == 0) {
+        learned_retrain_interval = 1;
+    }
 
-    // Override zipfian_alpha based on distribution type
+    // Select key distribution; zipfian_alpha <= 0 always means uniform
     if (key_dist == "uniform") {
+        key_distribution = KEY_UNIFORM;
         zipfian_alpha = 0.0;  // Force uniform distribution
+    } else if (key_dist == "zipfian") {
+        key_distribution = KEY_ZIPFIAN;
+    } else if (key_dist == "scrambled_zipfian") {
+        key_distribution = KEY_SCRAMBLED_ZIPFIAN;
+    } else if (key_dist == "latest") {
+        key_distribution = KEY_LATEST;
+    } else {
+        out.fatal(CALL_INFO, -1, "Unknown key_distribution '%s' (expected uniform, zipfian, scrambled_zipfian or latest)\n",
+                  key_dist.c_str());
+    }
+    if (zipfian_alpha <= 0.0) {
+        key_distribution = KEY_UNIFORM;
+    } else if (zipfian_alpha >= 1.0) {
+        out.fatal(CALL_INFO, -1, "zipfian_alpha must be in (0, 1) for a bounded Zipfian, got %f\n", zipfian_alpha);
+    } else {
+        zipf_gen.configure(key_range, zipfian_alpha);
     }
+    latest_key = 0;
     
     // Configure uniform integer distribution with actual key range    
     // Initialize key frequency tracking (for first 100 keys to show distribution)
@@ -178,40 +387,110 @@ ComputeServer::ComputeServer(ComponentId_t id, Params& params) :
     next_node_id = 0;  // Start node ID counter
     root_address = MEMORY_BASE_ADDRESS;  // Root always at memory server 0's base address
 
-    // Setup debug output with maximum verbosity for address visibility
-    dbg.init("", 5, 0, (Output::output_location_t)1);  // Force high verbosity
-    out.init("ComputeServer[@p:@l]: ", 1, 0, Output::STDOUT);
-
     // Initialize statistics
     stat_inserts = registerStatistic<uint64_t>("btree_inserts");
     stat_searches = registerStatistic<uint64_t>("btree_searches");
+    stat_scans = registerStatistic<uint64_t>("btree_scans");
     stat_network_reads = registerStatistic<uint64_t>("network_reads");
     stat_network_writes = registerStatistic<uint64_t>("network_writes");
     stat_total_latency = registerStatistic<uint64_t>("total_latency");
     stat_ops_completed = registerStatistic<uint64_t>("operations_completed");
+    stat_search_latency = registerStatistic<uint64_t>("search_latency");
+    stat_insert_latency = registerStatistic<uint64_t>("insert_latency");
+    stat_split_insert_latency = registerStatistic<uint64_t>("split_insert_latency");
+    stat_scan_latency = registerStatistic<uint64_t>("scan_latency");
+    stat_scan_leaves_read = registerStatistic<uint64_t>("scan_leaves_read");
+    stat_scan_leaves_overfetched = registerStatistic<uint64_t>("scan_leaves_overfetched");
+    stat_round_trips = registerStatistic<uint64_t>("round_trips_per_op");
+    stat_lock_wait = registerStatistic<uint64_t>("lock_wait_time");
+    stat_index_cache_hits = registerStatistic<uint64_t>("index_cache_hits");
+    stat_index_cache_misses = registerStatistic<uint64_t>("index_cache_misses");
+    stat_index_cache_evictions = registerStatistic<uint64_t>("index_cache_evictions");
+    stat_index_cache_invalidations = registerStatistic<uint64_t>("index_cache_invalidations");
+    stat_read_batches = registerStatistic<uint64_t>("read_batches");
+    stat_read_batch_occupancy = registerStatistic<uint64_t>("read_batch_occupancy");
+    stat_path_prefetch_reads = registerStatistic<uint64_t>("path_prefetch_reads");
+    stat_path_prefetch_hits = registerStatistic<uint64_t>("path_prefetch_hits");
+    stat_path_prefetch_mispredicts = registerStatistic<uint64_t>("path_prefetch_mispredicts");
+    stat_path_prefetch_wasted_bytes = registerStatistic<uint64_t>("path_prefetch_wasted_bytes");
+    stat_optimistic_read_retries = registerStatistic<uint64_t>("optimistic_read_retries");
+    stat_lock_cas_attempts = registerStatistic<uint64_t>("lock_cas_attempts");
+    stat_lock_cas_failures = registerStatistic<uint64_t>("lock_cas_failures");
+    stat_rpc_requests = registerStatistic<uint64_t>("rpc_requests");
+    stat_rpc_fallbacks = registerStatistic<uint64_t>("rpc_fallbacks");
+    stat_lock_handovers = registerStatistic<uint64_t>("lock_handovers");
+    stat_combined_writes = registerStatistic<uint64_t>("combined_writes");
+    stat_cpu_busy_time = registerStatistic<uint64_t>("cpu_busy_time");
+    stat_cpu_queue_delay = registerStatistic<uint64_t>("cpu_queue_delay");
+    stat_wal_records = registerStatistic<uint64_t>("wal_records");
+    stat_ops_in_flight = registerStatistic<uint64_t>("ops_in_flight");
+    stat_admission_delay = registerStatistic<uint64_t>("admission_delay");
+    stat_wal_group_records = registerStatistic<uint64_t>("wal_group_records");
+    stat_wal_commit_delay = registerStatistic<uint64_t>("wal_commit_delay");
+    stat_hash_kv_reads = registerStatistic<uint64_t>("hash_kv_reads");
+    stat_hash_fingerprint_misses = registerStatistic<uint64_t>("hash_fingerprint_misses");
+    stat_hash_cas_retries = registerStatistic<uint64_t>("hash_cas_retries");
+    stat_hash_directory_refreshes = registerStatistic<uint64_t>("hash_directory_refreshes");
+    stat_hash_resizes = registerStatistic<uint64_t>("hash_resizes");
+    stat_learned_model_segments = registerStatistic<uint64_t>("learned_model_segments");
+    stat_learned_leaves_read = registerStatistic<uint64_t>("learned_leaves_read");
+    stat_learned_delta_inserts = registerStatistic<uint64_t>("learned_delta_inserts");
+    stat_learned_merges = registerStatistic<uint64_t>("learned_merges");
+    stat_learned_retrains = registerStatistic<uint64_t>("learned_retrains");
+    stat_learned_restarts = registerStatistic<uint64_t>("learned_restarts");
+    for (uint32_t i = 0; i < num_memory_nodes; i++) {
+        stat_nodes_allocated.push_back(registerStatistic<uint64_t>("nodes_allocated", std::to_string(i)));
+        stat_server_requests.push_back(registerStatistic<uint64_t>("server_requests", std::to_string(i)));
+    }
+
+    // Index cache hits are delivered through a self link so they still cost local access time
+    index_cache_link = configureSelfLink("index_cache_link", "1ns",
+        new Event::Handler2<ComputeServer,&ComputeServer::handleIndexCacheHit>(this));
+    
+    // Partially filled read batches are posted when their window closes
+    read_batch_link = configureSelfLink("read_batch_link", "1ns",
+        new Event::Handler2<ComputeServer,&ComputeServer::handleReadBatchFlush>(this));
+    read_batches.resize(num_memory_nodes);
+    read_batch_flush_pending.resize(num_memory_nodes, false);
+    
+    // Reads that hit a locked node (or lose a lock CAS) are retried after a backoff
+    retry_link = configureSelfLink("retry_link", "1ns",
+        new Event::Handler2<ComputeServer,&ComputeServer::handleOperationRetry>(this));
+    
+    // Fetched nodes return to the traversal when their worker core is done with them
+    cpu_link = configureSelfLink("cpu_link", "1ns",
+        new Event::Handler2<ComputeServer,&ComputeServer::handleCpuWorkDone>(this));
+    
+    // Partially filled log groups are written when their group commit timeout expires
+    wal_link = configureSelfLink("wal_link", "1ns",
+        new Event::Handler2<ComputeServer,&ComputeServer::handleWalFlush>(this));
+    
+    // Open- and closed-loop modes issue operations from events rather than the clock
+    load_link = configureSelfLink("load_link", "1ns",
+        new Event::Handler2<ComputeServer,&ComputeServer::handleLoadEvent>(this));
 
-    // Setup multiple network interfaces (one per memory server)
     auto mem_handler = new SST::Interfaces::StandardMem::Handler2<ComputeServer,&ComputeServer::handleMemoryEvent>(this);
     
-    // Load network interfaces for ALL memory servers (many-to-many connectivity)
-    for (int i = 0; i < num_memory_nodes; i++) {
-        std::string interface_name = "mem_interface_" + std::to_string(i);
-        auto interface_i = loadUserSubComponent<SST::Interfaces::StandardMem>(interface_name, SST::ComponentInfo::SHARE_NONE, 
-                                                                                   registerTimeBase("1ns"), mem_handler);
-        if (interface_i) {
-            if (i == 0) {
-                memory_interface = interface_i;  // Store first interface as primary
-            } else {
-                memory_interfaces.push_back(interface_i);
+    // Either one networked interface (e.g. a MemNIC) that routes by address
+    // to every memory server, or one directly linked interface per server
+    auto network_interface = loadUserSubComponent<SST::Interfaces::StandardMem>("mem_interface", SST::ComponentInfo::SHARE_NONE,
+                                                                                registerTimeBase("1ns"), mem_handler);
+    if (network_interface) {
+        memory_interfaces.push_back(network_interface);
+        out.output("  Loaded networked interface mem_interface for %u memory servers\n", num_memory_nodes);
+    } else {
+        for (uint32_t i = 0; i < num_memory_nodes; i++) {
+            std::string interface_name = "mem_interface_" + std::to_string(i);
+            auto interface_i = loadUserSubComponent<SST::Interfaces::StandardMem>(interface_name, SST::ComponentInfo::SHARE_NONE, 
+                                                                                       registerTimeBase("1ns"), mem_handler);
+            if (!interface_i) {
+                out.fatal(CALL_INFO, -1, "Failed to load network interface %s (set mem_interface or mem_interface_0..%u)\n",
+                          interface_name.c_str(), num_memory_nodes - 1);
             }
-            out.output("  Loaded network interface to Memory Server %d: %s\n", i, interface_name.c_str());
-        } else {
-            out.fatal(CALL_INFO, -1, "Failed to load network interface %s\n", interface_name.c_str());
+            memory_interfaces.push_back(interface_i);
         }
+        out.output("  Many-to-Many connectivity: %zu interfaces loaded\n", memory_interfaces.size());
     }
-    
-    out.output("  Many-to-Many connectivity: %d interfaces loaded\n", (int)memory_interfaces.size() + 1);
-    out.output("  Can connect to ALL %d memory servers\n", num_memory_nodes);
 
     // Set up clock at high frequency (1MHz) to avoid time faults
     // We'll process operations based on their scheduled timestamps, not clock ticks
@@ -220,14 +499,55 @@ ComputeServer::ComputeServer(ComponentId_t id, Params& params) :
     registerClock(clock_freq, clock_handler);
 
     out.output("Compute Server %d initialized\n", node_id);
+    if (index_cache_capacity > 0) {
+        out.output("  Index cache: %u internal nodes, hit latency %lu ns\n",
+                   index_cache_capacity, index_cache_hit_latency);
+    }
+    if (read_batch_size > 1) {
+        out.output("  Read batching: up to %u reads per doorbell, window %lu ns\n",
+                   read_batch_size, read_batch_window);
+    }
+    if (path_prefetch) {
+        out.output("  Path prefetch: up to %u levels below the root, %u hints per level\n",
+                   path_prefetch_levels, path_prefetch_hint_capacity);
+    }
+    if (optimistic_cc) {
+        out.output("  Concurrency control: optimistic (retry backoff %lu ns)\n", optimistic_retry_backoff);
+    }
+    if (rpc_offload) {
+        out.output("  Access mode: rpc (searches and inserts run on the memory servers)\n");
+    }
+    if (lock_coalescing) {
+        out.output("  Lock coalescing: up to %u local handovers per lock, write combining %s\n",
+                   lock_handover_limit, write_combining ? "on" : "off");
+    }
+    if (wal_enabled) {
+        out.output("  Write-ahead log: server %u, %lu KB at 0x%lx, group commit %u records / %lu ns\n",
+                   wal_server, wal_size / 1024, server_base_address(wal_server) + wal_base,
+                   wal_group_size, wal_group_timeout);
+    }
+    if (cpu_cores > 0) {
+        out.output("  CPU model: %u cores at %.2f GHz, %.2f cycles/key, %.2f cycles/byte, %.0f cycles/split\n",
+                   cpu_cores, cpu_frequency_ghz, cpu_cycles_per_key, cpu_cycles_per_byte, cpu_cycles_per_split);
+    }
+    out.output("  Node placement: %s, %lu node slots per server (%lu MB window)\n",
+               placement.c_str(), server_slot_capacity, memory_server_window / (1024 * 1024));
     out.output("  Workload: %s, Ops/sec: %d, Read ratio: %.2f\n", 
                workload_type.c_str(), ops_per_second, read_ratio);
+    if (load_mode == LOAD_OPEN) {
+        out.output("  Load: open loop, Poisson arrivals, in-flight cap %u\n", max_inflight);
+    } else if (load_mode == LOAD_CLOSED) {
+        out.output("  Load: closed loop, %u clients, think time %lu ns\n", closed_loop_clients, think_time);
+    }
+    if (scan_ratio > 0.0) {
+        out.output("  Range scans: %.2f of reads, up to %u keys, %u leaf reads in flight\n",
+                   scan_ratio, scan_length, scan_prefetch_depth);
+    }
     out.output("  Key distribution: %s (alpha=%.2f), Key range: %lu\n", 
-               (zipfian_alpha <= 0.0) ? "UNIFORM" : "ZIPFIAN", zipfian_alpha, key_range);
-    
-    // DEBUG: Force output of parameters for debugging
-    out.output("DEBUG: key_dist='%s', zipfian_alpha=%.6f, key_range=%lu\n", 
-               key_dist.c_str(), zipfian_alpha, key_range);
+               (key_distribution == KEY_UNIFORM) ? "uniform" : key_dist.c_str(), zipfian_alpha, key_range);
+    if (key_distribution != KEY_UNIFORM) {
+        out.output("  Zipfian zeta(%lu, %.2f) = %.6f\n", key_range, zipfian_alpha, zipf_gen.getZetan());
+    }
 }
 
 ComputeServer::~ComputeServer() {
@@ -235,9 +555,6 @@ ComputeServer::~ComputeServer() {
 }
 
 void ComputeServer::init(unsigned int phase) {
-    memory_interface->init(phase);
-    
-    // Initialize all additional interfaces
     for (auto& interface : memory_interfaces) {
         interface->init(phase);
     }
@@ -250,28 +567,42 @@ void ComputeServer::init(unsigned int phase) {
         
         // Don't initialize B+tree here - wait for setup() after address exchange completes
         
-        // Generate initial workload
-        generate_workload();
-        out.output("Generated %zu operations for workload\n", pending_operations.size());
+        // Prepare the workload source; operations are produced lazily from tick()
+        init_workload();
+
+        // Untimed writes sent now are held by the interfaces until the
+        // memory servers are reachable, and land before setup()
+        if (hash_index) {
+            hash_build();
+        } else if (bulk_load_keys > 0) {
+            bulk_load_btree();
+        }
     }
 }
 
 void ComputeServer::setup() {
-    memory_interface->setup();
-    
-    // Setup all additional interfaces
     for (auto& interface : memory_interfaces) {
         interface->setup();
     }
     
     // NOW initialize B+tree after init() phases complete and address routing is established
-    initialize_btree();
+    if (!bulk_loaded && !hash_index) {
+        initialize_btree();
+    }
+    if (learned_index) {
+        stat_learned_model_segments->addData(learned_model.num_segments());
+    }
+    
+    if (load_mode == LOAD_OPEN) {
+        load_link->send(next_op_time, new LoadEvent(LoadEvent::ARRIVAL));
+    } else if (load_mode == LOAD_CLOSED) {
+        for (uint32_t i = 0; i < closed_loop_clients; i++) {
+            load_link->send(0, new LoadEvent(LoadEvent::CLIENT));
+        }
+    }
 }
 
 void ComputeServer::finish() {
-    memory_interface->finish();
-    
-    // Finish all additional interfaces
     for (auto& interface : memory_interfaces) {
         interface->finish();
     }
@@ -281,6 +612,86 @@ void ComputeServer::finish() {
     out.output("  Total operations: %lu\n", stat_ops_completed->getCollectionCount());
     out.output("  Network reads: %lu, Network writes: %lu\n", 
                stat_network_reads->getCollectionCount(), stat_network_writes->getCollectionCount());
+    out.output("  Operations issued: %lu\n", ops_issued);
+    SimTime_t elapsed = std::max<SimTime_t>(std::min(getCurrentSimTime(), simulation_duration), 1);
+    out.output("  Throughput: offered %.0f ops/s, achieved %.0f ops/s (%lu in flight, %zu waiting at end)\n",
+               ops_arrived * 1e9 / elapsed, stat_ops_completed->getCollectionCount() * 1e9 / elapsed,
+               ops_in_flight, admission_queue.size());
+    if (index_cache_capacity > 0) {
+        out.output("  Index cache: hits=%lu, misses=%lu, entries=%zu/%u\n",
+                   stat_index_cache_hits->getCollectionCount(), stat_index_cache_misses->getCollectionCount(),
+                   index_cache.size(), index_cache_capacity);
+    }
+    if (read_batch_size > 1) {
+        out.output("  Read batches posted: %lu\n", stat_read_batches->getCollectionCount());
+    }
+    if (optimistic_cc) {
+        out.output("  Optimistic CC: read retries=%lu, lock CAS attempts=%lu, failures=%lu\n",
+                   stat_optimistic_read_retries->getCollectionCount(), stat_lock_cas_attempts->getCollectionCount(),
+                   stat_lock_cas_failures->getCollectionCount());
+    }
+    if (rpc_offload) {
+        out.output("  RPCs sent: %lu, split fallbacks: %lu\n",
+                   stat_rpc_requests->getCollectionCount(), stat_rpc_fallbacks->getCollectionCount());
+    }
+    if (lock_coalescing) {
+        out.output("  Lock coalescing: local handovers=%lu, leaf write-backs=%lu\n",
+                   stat_lock_handovers->getCollectionCount(), stat_combined_writes->getCollectionCount());
+    }
+    if (wal_enabled) {
+        size_t not_durable = wal_group.size();
+        for (const auto& write : wal_inflight) {
+            not_durable += write.second.size();
+        }
+        out.output("  Write-ahead log: %lu records in %lu log writes, %zu records not yet durable\n",
+                   stat_wal_records->getCollectionCount(), stat_wal_group_records->getCollectionCount(),
+                   not_durable);
+    }
+    if (hash_index) {
+        out.output("  Hash index: global depth %u, KV reads=%lu (%lu fingerprint misses), CAS retries=%lu, "
+                   "directory refreshes=%lu, resizes=%lu\n",
+                   hash_global_depth, stat_hash_kv_reads->getCollectionCount(),
+                   stat_hash_fingerprint_misses->getCollectionCount(), stat_hash_cas_retries->getCollectionCount(),
+                   stat_hash_directory_refreshes->getCollectionCount(), stat_hash_resizes->getCollectionCount());
+    }
+    if (learned_index) {
+        out.output("  Learned index: %zu leaves, %zu segments, delta inserts=%lu, merges=%lu, retrains=%lu\n",
+                   learned_leaves.size(), learned_model.num_segments(),
+                   stat_learned_delta_inserts->getCollectionCount(), stat_learned_merges->getCollectionCount(),
+                   stat_learned_retrains->getCollectionCount());
+    }
+    if (cpu_cores > 0) {
+        SimTime_t run_time = std::max<SimTime_t>(getCurrentSimTime(), 1);
+        out.output("  CPU model: %lu ns busy over %u cores (%.1f%% utilisation)\n",
+                   cpu_busy_total, cpu_cores, cpu_busy_total * 100.0 / (run_time * cpu_cores));
+    }
+    if (!trace_file.empty()) {
+        out.output("  Trace records skipped: %lu\n", trace_lines_skipped);
+    }
+    
+    // Load balance: max / mean across servers (1.00 = perfectly even)
+    uint64_t total_nodes = 0, max_nodes = 0, total_requests = 0, max_requests = 0;
+    for (uint32_t i = 0; i < num_memory_nodes; i++) {
+        total_nodes += server_slots_used[i];
+        max_nodes = std::max(max_nodes, server_slots_used[i]);
+        total_requests += server_request_counts[i];
+        max_requests = std::max(max_requests, server_request_counts[i]);
+        out.output("  Memory Server %u: %lu nodes, %lu requests\n", i, server_slots_used[i], server_request_counts[i]);
+    }
+    if (total_nodes > 0 && total_requests > 0) {
+        out.output("  Placement imbalance (max/mean): nodes %.2f, requests %.2f\n",
+                   (double)max_nodes * num_memory_nodes / total_nodes,
+                   (double)max_requests * num_memory_nodes / total_requests);
+    }
+    
+    // Tail latency by operation type
+    print_latency_summary("search:", search_latency_hist);
+    print_latency_summary("insert:", insert_latency_hist);
+    print_latency_summary("split-insert:", split_insert_latency_hist);
+    print_latency_summary("scan:", scan_latency_hist);
+    if (optimistic_cc) {
+        print_latency_summary("lock wait:", lock_wait_hist);
+    }
     
     // Output key distribution analysis
     out.output("\n📊 Key Distribution Analysis:\n");
@@ -307,23 +718,35 @@ bool ComputeServer::tick(SST::Cycle_t cycle) {
     if (current_time > simulation_duration) {
         return true;  // Stop clock
     }
+    if (load_mode != LOAD_FIXED) {
+        return false;  // Issued from handleLoadEvent instead
+    }
     
-    // Process operations whose scheduled time has arrived
-    while (!pending_operations.empty()) {
-        WorkloadOp& op = pending_operations.front();
+    // Process operations whose scheduled time has arrived. Operations are
+    // pulled from the workload source one at a time so memory use stays
+    // constant regardless of simulation_duration_us.
+    while (true) {
+        if (!next_op_valid) {
+            if (workload_done || !fetch_next_operation(next_op)) {
+                workload_done = true;
+                break;
+            }
+            next_op_valid = true;
+        }
         
         // Check if it's time to process this operation
-        if (op.timestamp > current_time) {
+        if (next_op.timestamp > current_time) {
             // Not yet time for this operation
             break;
         }
         
         // Time to process this operation
         dbg.debug(CALL_INFO, 1, 0, "Processing %s operation for key %lu at time %lu\n",
-                 (op.op_type == BTREE_INSERT) ? "INSERT" : "SEARCH", op.key, current_time);
+                 (next_op.op_type == BTREE_INSERT) ? "INSERT" : (next_op.op_type == BTREE_SCAN) ? "SCAN" : "SEARCH",
+                 next_op.key, current_time);
         
-        process_btree_operation(op);
-        pending_operations.pop();
+        process_btree_operation(next_op, current_time);
+        next_op_valid = false;
     }
     
     return false;  // Continue ticking
@@ -343,33 +766,183 @@ void ComputeServer::handleMemoryEvent(SST::Interfaces::StandardMem::Request* req
         // Handle write response
         dbg.debug(CALL_INFO, 3, 0, "Network WRITE response received, req_id=%lu\n", req_id);
         handle_write_response(req_id);
+        
+    } else if (auto custom_resp = dynamic_cast<SST::Interfaces::StandardMem::CustomResp*>(req)) {
+        if (auto batch = dynamic_cast<BatchReadData*>(custom_resp->data)) {
+            dbg.debug(CALL_INFO, 3, 0, "Network BATCH READ response received, req_id=%lu, reads=%zu\n",
+                      req_id, batch->addresses.size());
+            handle_batch_read_response(req_id, batch);
+        } else if (auto atomic = dynamic_cast<RemoteAtomicData*>(custom_resp->data)) {
+            dbg.debug(CALL_INFO, 3, 0, "Network ATOMIC response received, req_id=%lu,%s\n",
+                      req_id, atomic->getString().c_str());
+            handle_atomic_response(req_id, atomic);
+        } else if (auto rpc = dynamic_cast<BTreeRpcData*>(custom_resp->data)) {
+            dbg.debug(CALL_INFO, 3, 0, "Network RPC response received, req_id=%lu,%s\n",
+                      req_id, rpc->getString().c_str());
+            handle_rpc_response(req_id, rpc);
+        } else {
+            out.fatal(CALL_INFO, -1, "Received CustomResp with unknown payload\n");
+        }
+        delete custom_resp->data;
     }
     
     delete req;
 }
 
-void ComputeServer::generate_workload() {
-    out.output("DEBUG Node %d: Starting workload generation...\n", node_id);
-    
+void ComputeServer::init_workload() {
     // Calculate time interval between operations
     // SST uses nanoseconds as base time unit (SimTime_t is in nanoseconds)
     // 1 second = 1,000,000,000 nanoseconds
     // Example: If ops_per_second = 1000:
     //   op_interval = 1,000,000,000 / 1000 = 1,000,000 ns = 1 ms
-    SimTime_t op_interval = 1000000000ULL / ops_per_second;  // Interval in nanoseconds
-    SimTime_t current_time = 0;  // Start at 0 nanoseconds
-    
-    // Generate operations for the simulation duration
-    while (current_time < simulation_duration) {
-        WorkloadOp op = generate_next_operation();
-        op.timestamp = current_time;  // When to execute (in nanoseconds)
-        op.node_id = node_id;
+    if (ops_per_second == 0) {
+        out.fatal(CALL_INFO, -1, "operations_per_second must be greater than 0\n");
+    }
+    op_interval = 1000000000ULL / ops_per_second;  // Interval in nanoseconds
+    arrival_dist = std::exponential_distribution<double>(1.0 / op_interval);
+    next_op_time = 0;  // Start at 0 nanoseconds
+    next_op_valid = false;
+    workload_done = false;
+    
+    if (!trace_file.empty()) {
+        trace_stream.open(trace_file);
+        if (!trace_stream.is_open()) {
+            out.fatal(CALL_INFO, -1, "Unable to open workload trace '%s'\n", trace_file.c_str());
+        }
+        out.output("Node %d: Replaying YCSB trace %s (1 op every %lu ns)\n",
+                   node_id, trace_file.c_str(), op_interval);
+    } else {
+        out.output("Node %d: Streaming synthetic workload (1 op every %lu ns for %lu ns)\n",
+                   node_id, op_interval, simulation_duration);
+    }
+}
+
+bool ComputeServer::fetch_next_operation(WorkloadOp& op) {
+    // Operations are only produced for the configured simulation duration
+    if (next_op_time >= simulation_duration) {
+        return false;
+    }
+    
+    if (!trace_file.empty()) {
+        if (!read_trace_operation(op)) {
+            return false;
+        }
+    } else {
+        op = generate_next_operation();
+    }
+    
+    op.timestamp = next_op_time;  // When to execute (in nanoseconds)
+    op.node_id = node_id;
+    next_op_time += next_arrival_gap();  // Add nanoseconds to schedule next operation
+    ops_arrived++;
+    return true;
+}
+
+SimTime_t ComputeServer::next_arrival_gap() {
+    switch (load_mode) {
+        case LOAD_OPEN:
+            return static_cast<SimTime_t>(arrival_dist(rng));
+        case LOAD_CLOSED:
+            return 0;  // Clients set the pace; next_op_time is moved to the issue time
+        case LOAD_FIXED:
+        default:
+            return op_interval;
+    }
+}
+
+void ComputeServer::handleLoadEvent(SST::Event* ev) {
+    LoadEvent* load = static_cast<LoadEvent*>(ev);
+    SimTime_t now = getCurrentSimTime();
+    WorkloadOp op;
+    
+    switch (load->kind) {
+        case LoadEvent::ARRIVAL:
+            // Arrivals keep coming whether or not earlier operations have finished
+            if (fetch_next_operation(op)) {
+                admission_queue.push_back(op);
+                admit_operations();
+                load_link->send(next_op_time - std::min(next_op_time, now), new LoadEvent(LoadEvent::ARRIVAL));
+            }
+            break;
+        case LoadEvent::CLIENT:
+            // A client is free: its next operation starts now
+            next_op_time = std::max(next_op_time, now);
+            if (fetch_next_operation(op)) {
+                process_btree_operation(op, now);
+            }
+            break;
+        case LoadEvent::ADMIT:
+            admit_operations();
+            break;
+    }
+    delete load;
+}
+
+void ComputeServer::admit_operations() {
+    // Waiting arrivals are charged from their arrival time, so the cap shows up as latency
+    SimTime_t now = getCurrentSimTime();
+    while (!admission_queue.empty() && (max_inflight == 0 || ops_in_flight < max_inflight)) {
+        const WorkloadOp& op = admission_queue.front();
+        stat_admission_delay->addData(now - std::min(op.timestamp, now));
+        process_btree_operation(op, std::min(op.timestamp, now));
+        admission_queue.pop_front();
+    }
+}
+
+bool ComputeServer::read_trace_operation(WorkloadOp& op) {
+    // YCSB basic-DB trace records look like:
+    //   READ usertable user6284781860667377211 [ <all fields>]
+    //   INSERT usertable user1587149765 [ field0=... ]
+    //   SCAN usertable user5 10 [ <all fields>]
+    // Reads become searches, scans become range scans of the recorded length,
+    // inserts/updates/RMWs become inserts.
+    // Keys are reduced modulo key_range so replayed traces share the tree's key space.
+    std::string line;
+    while (std::getline(trace_stream, line)) {
+        std::istringstream record(line);
+        std::string op_name, table, key_str;
+        if (!(record >> op_name >> table >> key_str)) {
+            if (!line.empty()) {
+                trace_lines_skipped++;
+            }
+            continue;
+        }
         
-        pending_operations.push(op);
-        current_time += op_interval;  // Add nanoseconds to schedule next operation
+        if (op_name == "READ") {
+            op.op_type = BTREE_SEARCH;
+        } else if (op_name == "SCAN") {
+            uint64_t length = 0;
+            if (!(record >> length) || length == 0) {
+                trace_lines_skipped++;
+                continue;
+            }
+            op.op_type = BTREE_SCAN;
+            op.scan_length = (uint32_t)std::min<uint64_t>(length, UINT32_MAX);
+        } else if (op_name == "INSERT" || op_name == "UPDATE" || op_name == "READMODIFYWRITE") {
+            op.op_type = BTREE_INSERT;
+        } else {
+            trace_lines_skipped++;
+            continue;
+        }
+        
+        size_t digits = key_str.find_first_of("0123456789");
+        if (digits == std::string::npos) {
+            trace_lines_skipped++;
+            continue;
+        }
+        
+        uint64_t key = std::strtoull(key_str.c_str() + digits, nullptr, 10);
+        op.key = (key_range > 0) ? (key % key_range) : key;
+        op.value = op.key * 1000 + node_id;
+        
+        if (op.key < key_frequencies.size()) {
+            key_frequencies[op.key]++;
+        }
+        return true;
     }
     
-    out.output("DEBUG Node %d: Generated %zu operations\n", node_id, pending_operations.size());
+    out.output("Node %d: Workload trace exhausted after %lu operations\n", node_id, ops_issued);
+    return false;
 }
 
 WorkloadOp ComputeServer::generate_next_operation() {
@@ -377,15 +950,31 @@ WorkloadOp ComputeServer::generate_next_operation() {
     
     // Determine operation type based on read ratio
     double rand_val = uniform_dist(rng);
+    op.scan_length = 0;
     if (rand_val < read_ratio) {
         op.op_type = BTREE_SEARCH;
+        // YCSB-E: scans start at a key from the distribution and return 1..scan_length keys
+        if (scan_ratio > 0.0 && uniform_dist(rng) < scan_ratio) {
+            op.op_type = BTREE_SCAN;
+            op.scan_length = 1 + static_cast<uint32_t>(uniform_dist(rng) * scan_length);
+            if (op.scan_length > scan_length) op.scan_length = scan_length;
+        }
     } else {
         // All writes are inserts
         op.op_type = BTREE_INSERT;
     }
     
-    // Generate key using Zipfian distribution
-    op.key = get_zipfian_key();
+    // Generate key using the configured distribution. Under 'latest' (YCSB-D)
+    // inserts append new keys and reads favour the most recent ones.
+    if (key_distribution == KEY_LATEST && op.op_type == BTREE_INSERT) {
+        latest_key = (latest_key + 1) % key_range;
+        op.key = latest_key;
+        if (op.key < key_frequencies.size()) {
+            key_frequencies[op.key]++;
+        }
+    } else {
+        op.key = get_zipfian_key();
+    }
     op.value = op.key * 1000 + node_id;  // Simple value generation
     
     return op;
@@ -395,23 +984,23 @@ uint64_t ComputeServer::get_zipfian_key() {
     uint64_t key;
     double rand_val = uniform_dist(rng);
     
-    if (zipfian_alpha <= 0.0) {
-        // UNIFORM distribution - force a range of keys for testing
-        key = static_cast<uint64_t>(rand_val * key_range);
-        
-        // Use SST output instead of printf for visibility
-        out.output("DEBUG UNIFORM: node=%d, rand_val=%.6f, key_range=%lu -> key=%lu (alpha=%.1f)\n", 
-                   node_id, rand_val, key_range, key, zipfian_alpha);
-    } else {
-        // Zipfian distribution using inverse power method
-        // Avoid rand_val = 0 to prevent pow(0, negative) = infinity
-        if (rand_val == 0.0) rand_val = 1e-10;
-        
-        key = static_cast<uint64_t>(pow(rand_val, -1.0 / zipfian_alpha)) % key_range;
-        
-        // Use SST output instead of printf for visibility
-        out.output("DEBUG ZIPFIAN: node=%d, rand_val=%.6f -> pow(%.6f, -1/%.1f) = %.2f -> key=%lu\n", 
-                   node_id, rand_val, rand_val, zipfian_alpha, pow(rand_val, -1.0 / zipfian_alpha), key);
+    switch (key_distribution) {
+        case KEY_ZIPFIAN:
+            key = zipf_gen.next(rand_val);
+            break;
+        case KEY_SCRAMBLED_ZIPFIAN:
+            // Spread the popular ranks so hot keys do not cluster in one leaf
+            key = fnv_hash64(zipf_gen.next(rand_val)) % key_range;
+            break;
+        case KEY_LATEST:
+            // Rank 0 is the most recently inserted key
+            key = (latest_key + key_range - zipf_gen.next(rand_val)) % key_range;
+            break;
+        case KEY_UNIFORM:
+        default:
+            key = static_cast<uint64_t>(rand_val * key_range);
+            if (key >= key_range) key = key_range - 1;
+            break;
     }
     
     // Track frequency for first 100 keys to show distribution pattern
@@ -422,13 +1011,20 @@ uint64_t ComputeServer::get_zipfian_key() {
     return key;
 }
 
-void ComputeServer::process_btree_operation(const WorkloadOp& op) {
+void ComputeServer::process_btree_operation(const WorkloadOp& op, SimTime_t start_time) {
+    ops_issued++;
+    ops_in_flight++;
+    stat_ops_in_flight->addData(ops_in_flight);
+    
     switch (op.op_type) {
         case BTREE_INSERT:
-            btree_insert_async(op.key, op.value);
+            btree_insert_async(op.key, op.value, start_time);
             break;
         case BTREE_SEARCH:
-            btree_search_async(op.key);
+            btree_search_async(op.key, start_time);
+            break;
+        case BTREE_SCAN:
+            btree_scan_async(op.key, op.scan_length, start_time);
             break;
     }
     // Note: stat_ops_completed will be updated when operation completes asynchronously
@@ -438,51 +1034,95 @@ void ComputeServer::process_btree_operation(const WorkloadOp& op) {
 // ASYNC B+TREE OPERATIONS - Entry points that start async state machines
 // ═══════════════════════════════════════════════════════════════════════════
 
-void ComputeServer::btree_insert_async(uint64_t key, uint64_t value) {
+void ComputeServer::btree_insert_async(uint64_t key, uint64_t value, SimTime_t start_time) {
     dbg.debug(CALL_INFO, 2, 0, "B+Tree INSERT (async): key=%lu, value=%lu\n", key, value);
     out.output("\n🔹 INSERT Operation (async): key=%lu, value=%lu\n", key, value);
     
-    // Create read request for root node to start traversal
-    auto req = new SST::Interfaces::StandardMem::Read(root_address, get_serialized_node_size());
-    auto req_id = req->getID();
-    
-    // Track this async operation
-    pending_ops[req_id] = AsyncOperation();
-    pending_ops[req_id].type = AsyncOperation::INSERT;
-    pending_ops[req_id].key = key;
-    pending_ops[req_id].value = value;
-    pending_ops[req_id].current_level = 0;
-    pending_ops[req_id].current_address = root_address;
-    pending_ops[req_id].start_time = getCurrentSimTime();
-    
-    // Send read request
-    SST::Interfaces::StandardMem* target_interface = get_interface_for_address(root_address);
-    target_interface->send(req);
-    stat_network_reads->addData(1);
+    // Start traversal from the root
+    AsyncOperation op;
+    op.type = AsyncOperation::INSERT;
+    op.key = key;
+    op.value = value;
+    op.current_level = 0;
+    op.current_address = root_address;
+    op.start_time = start_time;
+    if (hash_index) {
+        hash_begin(op);
+        return;
+    }
+    if (learned_index) {
+        learned_lookup_async(op);
+        return;
+    }
+    if (rpc_offload) {
+        op.via_rpc = true;
+        send_btree_rpc(op);
+    } else {
+        if (path_prefetch) {
+            path_prefetch_begin(op);
+        }
+        issue_traversal_read(op);
+    }
     
     out.output("   Started async traversal from root=0x%lx\n", root_address);
 }
 
-void ComputeServer::btree_search_async(uint64_t key) {
+void ComputeServer::btree_search_async(uint64_t key, SimTime_t start_time) {
     dbg.debug(CALL_INFO, 2, 0, "B+tree SEARCH (async): key=%lu\n", key);
     out.output("\n🔍 SEARCH Operation (async): key=%lu\n", key);
     
-    // Create read request for root node
-    auto req = new SST::Interfaces::StandardMem::Read(root_address, get_serialized_node_size());
-    auto req_id = req->getID();
-    
-    // Track this async operation
-    pending_ops[req_id] = AsyncOperation();
-    pending_ops[req_id].type = AsyncOperation::SEARCH;
-    pending_ops[req_id].key = key;
-    pending_ops[req_id].current_level = 0;
-    pending_ops[req_id].current_address = root_address;
-    pending_ops[req_id].start_time = getCurrentSimTime();
+    // Start traversal from the root
+    AsyncOperation op;
+    op.type = AsyncOperation::SEARCH;
+    op.key = key;
+    op.current_level = 0;
+    op.current_address = root_address;
+    op.start_time = start_time;
+    if (hash_index) {
+        hash_begin(op);
+        return;
+    }
+    if (learned_index) {
+        learned_lookup_async(op);
+        return;
+    }
+    if (rpc_offload) {
+        op.via_rpc = true;
+        send_btree_rpc(op);
+    } else {
+        if (path_prefetch) {
+            path_prefetch_begin(op);
+        }
+        issue_traversal_read(op);
+    }
     
-    // Send read request
-    SST::Interfaces::StandardMem* target_interface = get_interface_for_address(root_address);
-    target_interface->send(req);
-    stat_network_reads->addData(1);
+    out.output("   Started async traversal from root=0x%lx\n", root_address);
+}
+
+void ComputeServer::btree_scan_async(uint64_t key, uint32_t length, SimTime_t start_time) {
+    if (hash_index) {
+        out.fatal(CALL_INFO, -1, "Range scan of key %lu issued to index_engine=hash, which has no key order\n", key);
+    }
+
+    dbg.debug(CALL_INFO, 2, 0, "B+tree SCAN (async): key=%lu, length=%u\n", key, length);
+    out.output("\n📜 SCAN Operation (async): key=%lu, length=%u\n", key, length);
+    
+    // The traversal to the first leaf carries sequence number 0 of the scan
+    uint64_t scan_id = ++next_scan_id;
+    ScanState& scan = active_scans[scan_id];
+    scan.op.type = AsyncOperation::SCAN;
+    scan.op.key = key;
+    scan.op.start_time = start_time;
+    scan.op.scan_id = scan_id;
+    scan.remaining = length;
+    scan.descended = false;
+    scan.issued = 1;
+    scan.consumed = 0;
+    
+    AsyncOperation op = scan.op;
+    op.current_level = 0;
+    op.current_address = root_address;
+    issue_traversal_read(op);
     
     out.output("   Started async traversal from root=0x%lx\n", root_address);
 }
@@ -499,20 +1139,112 @@ void ComputeServer::initialize_btree() {
     
     // Create root node (initially a leaf)
     BTreeNode root(btree_fanout);
-    root.is_leaf = true;
-    root.num_keys = 0;
-    root.node_address = allocate_node_address(next_node_id++, 0);  // Root at level 0
+    root.is_leaf() = true;
+    root.num_keys() = 0;
+    root.node_address() = MEMORY_BASE_ADDRESS + BTREE_ROOT_OFFSET;  // Initial root at memory server 0's base
+    next_node_id++;
+    server_slots_used[0]++;
+    stat_nodes_allocated[0]->addData(1);
     
-    root_address = root.node_address;
+    root_address = root.node_address();
     
     // Write root node to memory (NOT cached locally)
     write_node_back(root);
     
     out.output("   Root address: 0x%lx (Memory Server %lu)\n", 
-               root_address, GET_MEMORY_SERVER(root_address));
+               root_address, (uint64_t)get_server_for_address(root_address));
     out.output("   ✓ Root node written to remote memory\n");
 }
 
+void ComputeServer::bulk_load_btree() {
+    // Build the tree bottom-up: sorted keys fill the leaves left to right and
+    // every internal level packs the level below it. Each compute server runs
+    // the same deterministic layout so its allocator and root agree with the
+    // image, but only node 0 writes the nodes out.
+    uint32_t leaf_keys = std::max<uint32_t>(1, (uint32_t)(btree_fanout * bulk_load_fill));
+    uint32_t node_children = std::max<uint32_t>(2, (uint32_t)((btree_fanout + 1) * bulk_load_fill));
+    auto key_at = [this](uint64_t i) {
+        return (uint64_t)((unsigned __int128)i * key_range / bulk_load_keys);
+    };
+
+    // Level 0 is the leaf level; span[l] is the number of keys under one node of level l
+    std::vector<uint64_t> level_nodes(1, (bulk_load_keys + leaf_keys - 1) / leaf_keys);
+    std::vector<uint64_t> span(1, leaf_keys);
+    while (level_nodes.back() > 1) {
+        level_nodes.push_back((level_nodes.back() + node_children - 1) / node_children);
+        span.push_back(std::min(span.back() * node_children, bulk_load_keys));
+    }
+    uint32_t levels = level_nodes.size();
+
+    // Addresses are handed out top-down so locality placement can follow parents
+    std::vector<std::vector<uint64_t>> addresses(levels);
+    addresses[levels - 1].push_back(MEMORY_BASE_ADDRESS + BTREE_ROOT_OFFSET);
+    next_node_id++;
+    server_slots_used[0]++;
+    for (int level = levels - 2; level >= 0; level--) {
+        addresses[level].resize(level_nodes[level]);
+        for (uint64_t j = 0; j < level_nodes[level]; j++) {
+            uint64_t parent = addresses[level + 1][j / node_children];
+            addresses[level][j] = place_node(next_node_id++, key_at(j * span[level]), parent);
+        }
+    }
+    root_address = addresses[levels - 1][0];
+    tree_height = levels;
+    latest_key = key_at(bulk_load_keys - 1);
+    bulk_loaded = true;
+
+    // The learned engine indexes the same leaves by their first keys
+    if (learned_index) {
+        learned_leaves = addresses[0];
+        learned_first_keys.resize(level_nodes[0]);
+        for (uint64_t j = 0; j < level_nodes[0]; j++) {
+            learned_first_keys[j] = key_at(j * leaf_keys);
+        }
+        learned_train();
+    }
+
+    if (node_id == 0) {
+        for (uint32_t level = 0; level < levels; level++) {
+            for (uint64_t j = 0; j < level_nodes[level]; j++) {
+                BTreeNode node(btree_fanout);
+                node.node_address() = addresses[level][j];
+                node.is_leaf() = (level == 0);
+                if (level == 0) {
+                    uint64_t first = j * leaf_keys;
+                    uint64_t last = std::min(first + leaf_keys, bulk_load_keys);
+                    for (uint64_t i = first; i < last; i++) {
+                        node.keys()[i - first] = key_at(i);
+                        node.values()[i - first] = key_at(i) * 1000;
+                    }
+                    node.num_keys() = last - first;
+                    node.next_leaf() = (j + 1 < level_nodes[0]) ? addresses[0][j + 1] : 0;
+                } else {
+                    // keys[i] is the smallest key under children[i+1]
+                    uint64_t first = j * node_children;
+                    uint64_t last = std::min(first + node_children, level_nodes[level - 1]);
+                    for (uint64_t c = first; c < last; c++) {
+                        node.children()[c - first] = addresses[level - 1][c];
+                        if (c > first) {
+                            node.keys()[c - first - 1] = key_at(c * span[level - 1]);
+                        }
+                    }
+                    node.num_keys() = last - first - 1;
+                }
+                interface_for_server(get_server_for_address(node.node_address()))->sendUntimedData(
+                    new SST::Interfaces::StandardMem::Write(node.node_address(), node.size(), node.to_bytes(), true));
+            }
+        }
+    }
+
+    uint64_t total_nodes = 0;
+    for (uint64_t count : level_nodes) {
+        total_nodes += count;
+    }
+    out.output("🌳 Bulk loaded B+tree: %lu keys, %lu leaves, %lu nodes, height %u (fill %.2f)%s\n",
+               bulk_load_keys, level_nodes[0], total_nodes, tree_height, bulk_load_fill,
+               (node_id == 0) ? "" : ", layout only");
+}
+
 uint64_t ComputeServer::calculate_tree_height(uint64_t num_keys) {
     // Calculate tree height needed to store num_keys
     // Each leaf can hold 'fanout' keys
@@ -532,92 +1264,113 @@ uint64_t ComputeServer::calculate_tree_height(uint64_t num_keys) {
     return height;
 }
 
-uint64_t ComputeServer::allocate_node_address(uint64_t node_id, uint32_t level) {
-    // Allocate address for a B+tree node based on:
-    // 1. Node ID (unique identifier)
-    // 2. Level in tree (0=root, tree_height-1=leaves)
-    //
-    // Memory Layout per server (16 MB):
-    // ┌────────────────────────────────────────┐
-    // │ Level 0 (Root):        0x00000 - 0x0FFFF  (64 KB)   │
-    // │ Level 1 (Internal):    0x10000 - 0x3FFFF  (192 KB)  │
-    // │ Level 2 (Internal):    0x40000 - 0x1FFFFF (1.75 MB) │
-    // │ Leaves:                0x200000 - 0xFFFFFF (14 MB)  │
-    // └────────────────────────────────────────┘
-    
-    // Determine which memory server based on node_id for load balancing
-    uint64_t memory_server = node_id % num_memory_nodes;
-    uint64_t base_address = MEMORY_BASE_ADDRESS + memory_server * MEMORY_SERVER_SIZE;
-    
-    uint64_t offset;
-    if (level == 0) {
-        // Root level: First 64 KB (only 1 node ever at level 0)
-        offset = BTREE_LEVEL0_OFFSET;
-    } else if (level < tree_height - 1) {
-        // Internal nodes: Allocate in regions based on level
-        // Each level gets more space as we go down the tree
-        uint64_t level_base = BTREE_LEVEL1_OFFSET * level;  // 64 KB per level
-        offset = level_base + (node_id % 10000) * get_serialized_node_size();
-    } else {
-        // Leaf nodes: Start at 2 MB offset, use most of the space
-        offset = BTREE_LEAF_OFFSET + (node_id % 100000) * get_serialized_node_size();
-    }
-    
-    uint64_t final_address = base_address + offset;
+uint64_t ComputeServer::allocate_node_address(uint64_t node_id, uint32_t level, uint64_t placement_key,
+                                              uint64_t parent_address) {
+    uint64_t final_address = place_node(node_id, placement_key, parent_address);
+    uint32_t memory_server = get_server_for_address(final_address);
+    stat_nodes_allocated[memory_server]->addData(1);
     
-    out.output("📍 Allocated Node %lu (Level %u) → Memory Server %lu: Address 0x%lx\n",
+    out.output("📍 Allocated Node %lu (Level %u) → Memory Server %u: Address 0x%lx\n",
                node_id, level, memory_server, final_address);
     
     return final_address;
 }
 
-uint64_t ComputeServer::get_child_index_for_key(const BTreeNode& node, uint64_t key) {
+uint64_t ComputeServer::place_node(uint64_t node_id, uint64_t placement_key, uint64_t parent_address, uint64_t slots) {
+    // The placement policy picks a server; the node takes the next free slot
+    // (or run of 'slots' slots) in that server's heap. A full server spills
+    // over to the next one.
+    uint32_t memory_server = choose_server(node_id, placement_key, parent_address);
+    for (uint32_t tried = 0; server_slots_used[memory_server] + slots > server_slot_capacity; tried++) {
+        if (tried + 1 >= num_memory_nodes) {
+            out.fatal(CALL_INFO, -1, "All %u memory servers are full (%lu node slots each); raise memory_server_window_mb\n",
+                      num_memory_nodes, server_slot_capacity);
+        }
+        memory_server = (memory_server + 1) % num_memory_nodes;
+    }
+    
+    uint64_t slot = server_slots_used[memory_server];
+    server_slots_used[memory_server] += slots;
+    return server_base_address(memory_server) + BTREE_HEAP_OFFSET + slot * get_serialized_node_size();
+}
+
+uint32_t ComputeServer::choose_server(uint64_t node_id, uint64_t placement_key, uint64_t parent_address) {
+    switch (placement_policy) {
+        case PLACE_HASH:
+            return fnv_hash64(node_id) % num_memory_nodes;
+        case PLACE_RANGE: {
+            // Server i owns keys [i * width, (i + 1) * width)
+            uint64_t width = (key_range + num_memory_nodes - 1) / num_memory_nodes;
+            uint64_t server = placement_key / width;
+            return (server < num_memory_nodes) ? server : num_memory_nodes - 1;
+        }
+        case PLACE_LOCALITY:
+            // Children of the root start a subtree on a hashed server; deeper
+            // nodes stay with their parent so a traversal below level 1 hits one server
+            if (parent_address != 0 && parent_address != root_address) {
+                return get_server_for_address(parent_address);
+            }
+            return fnv_hash64(node_id) % num_memory_nodes;
+        case PLACE_ROUND_ROBIN:
+        default:
+            return node_id % num_memory_nodes;
+    }
+}
+
+uint64_t ComputeServer::server_base_address(uint32_t server) const {
+    return MEMORY_BASE_ADDRESS + server * memory_server_window;
+}
+
+uint64_t ComputeServer::parent_in_path(const AsyncOperation& op, uint64_t address) const {
+    // The parent is the node visited just before 'address' on the way down
+    for (size_t i = 1; i < op.path.size(); i++) {
+        if (op.path[i] == address) {
+            return op.path[i - 1];
+        }
+    }
+    return 0;
+}
+
+uint64_t ComputeServer::get_child_index_for_key(const BTreeNodeView& node, uint64_t key) {
     // Find the child pointer index for a given key in an internal node
     // B+tree property: keys[i] is the minimum key in child[i+1]
     
-    if (node.num_keys == 0) {
+    if (node.num_keys() == 0) {
         return 0;  // Empty node, use first child
     }
     
     // Binary search for the right child
-    for (uint32_t i = 0; i < node.num_keys; i++) {
-        if (key < node.keys[i]) {
+    for (uint32_t i = 0; i < node.num_keys(); i++) {
+        if (key < node.keys()[i]) {
             return i;  // Key belongs in child[i]
         }
     }
     
     // Key is >= all keys, belongs in rightmost child
-    return node.num_keys;
+    return node.num_keys();
 }
 
 
 
 SST::Interfaces::StandardMem* ComputeServer::get_interface_for_address(uint64_t address) {
     // Many-to-Many: Determine which memory server this address belongs to
-    uint64_t memory_server_id = GET_MEMORY_SERVER(address);
-    
-    // Clamp to valid range - this compute server can connect to ANY memory server
-    if (memory_server_id >= num_memory_nodes) {
-        memory_server_id = 0;  // Default to primary interface
-    }
+    // (out-of-range addresses fall back to the primary interface)
+    uint64_t memory_server_id = get_server_for_address(address);
+    server_request_counts[memory_server_id]++;
+    stat_server_requests[memory_server_id]->addData(1);
     
     // Debug output for interface selection
     dbg.debug(CALL_INFO, 4, 0, "Address 0x%lx → Memory Server %lu\n", address, memory_server_id);
     
-    // Return appropriate interface for many-to-many connectivity
-    if (memory_server_id == 0) {
-        return memory_interface;  // Primary interface for memory server 0
-    } else {
-        // Use additional interfaces for other memory servers
-        size_t interface_index = memory_server_id - 1;
-        if (interface_index < memory_interfaces.size()) {
-            return memory_interfaces[interface_index];
-        } else {
-            // Fallback to primary interface if additional interface not available
-            dbg.debug(CALL_INFO, 2, 0, "WARNING: No interface for memory server %lu, using primary\n", memory_server_id);
-            return memory_interface;
-        }
+    return interface_for_server(memory_server_id);
+}
+
+SST::Interfaces::StandardMem* ComputeServer::interface_for_server(uint32_t memory_server_id) {
+    // A single networked interface reaches every server
+    if (memory_interfaces.size() == 1) {
+        return memory_interfaces[0];
     }
+    return memory_interfaces[memory_server_id];
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -627,33 +1380,60 @@ SST::Interfaces::StandardMem* ComputeServer::get_interface_for_address(uint64_t
 void ComputeServer::handle_read_response(SST::Interfaces::StandardMem::Request::id_t req_id,
                                          const std::vector<uint8_t>& data) {
     // Check if this is one of our tracked async operations
-    if (!pending_ops.count(req_id)) {
+    AsyncOperation* tracked = pending_ops.find(req_id);
+    if (!tracked) {
         dbg.debug(CALL_INFO, 2, 0, "WARNING: Received read response for unknown request\n");
         return;
     }
     
-    auto& op = pending_ops[req_id];
+    auto& op = *tracked;
+    
+    // Hash index requests continue their own operation
+    if (op.hash_id != 0) {
+        AsyncOperation tag = op;
+        pending_ops.erase(req_id);
+        hash_response(tag, data.data(), data.size(), nullptr);
+        return;
+    }
+    
+    // Speculative path reads wait for their traversal to validate them
+    if (op.speculative) {
+        AsyncOperation spec = op;
+        pending_ops.erase(req_id);
+        path_prefetch_arrived(spec, data.data(), data.size());
+        return;
+    }
     
     // Special case: READ_PARENT phase of split operation
     if (op.split_phase == AsyncOperation::READ_PARENT) {
-        BTreeNode parent = deserialize_node(data);
+        // The parent is modified in place, so take an owning copy
+        BTreeNode parent(deserialize_node(data));
+        
+        // Optimistic mode: a node a writer holds is re-read after a backoff
+        if (optimistic_cc && parent.is_locked()) {
+            stat_optimistic_read_retries->addData(1);
+            schedule_retry(op);
+            pending_ops.erase(req_id);
+            return;
+        }
+        end_lock_wait(op);
         
         // Check if we're still traversing to find the parent (when parent_address was 0)
-        if (op.parent_address == 0 && !parent.is_leaf) {
+        if (op.parent_address == 0 && !parent.is_leaf()) {
             // Still traversing internal nodes to find the parent of the split node
             // Use the separator key to find which child to follow
             uint64_t child_idx = 0;
-            while (child_idx < parent.num_keys && parent.keys[child_idx] < op.separator_key) {
+            while (child_idx < parent.num_keys() && parent.keys()[child_idx] < op.separator_key) {
                 child_idx++;
             }
             
-            uint64_t child_addr = parent.children[child_idx];
+            uint64_t child_addr = parent.children()[child_idx];
             
             // Check if this child is one of our split nodes
-            if (child_addr == op.old_node.node_address || child_addr == op.new_node.node_address) {
+            if (child_addr == op.old_node_address || child_addr == op.new_node_address) {
                 // Found the parent!
-                out.output("   ✓ Phase 3: Found parent at 0x%lx during traversal\n", parent.node_address);
-                op.parent_address = parent.node_address;
+                out.output("   ✓ Phase 3: Found parent at 0x%lx during traversal\n", parent.node_address());
+                op.parent_address = parent.node_address();
                 // Continue with inserting separator key (fall through to insertion logic below)
             } else {
                 // Continue traversing down
@@ -664,7 +1444,7 @@ void ComputeServer::handle_read_response(SST::Interfaces::StandardMem::Request::
                 
                 auto next_req = new SST::Interfaces::StandardMem::Read(child_addr, get_serialized_node_size());
                 auto next_req_id = next_req->getID();
-                pending_ops[next_req_id] = op;
+                track_request(next_req_id, op);
                 
                 SST::Interfaces::StandardMem* target_interface = get_interface_for_address(child_addr);
                 target_interface->send(next_req);
@@ -677,117 +1457,1056 @@ void ComputeServer::handle_read_response(SST::Interfaces::StandardMem::Request::
             out.output("   ✓ Phase 3: Parent node read complete\n");
         }
         
-        // Check if parent has space for separator key
-        if (parent.num_keys < btree_fanout) {
-            out.output("   Parent has space (%u/%u) - inserting separator key=%lu\n",
-                       parent.num_keys, btree_fanout, op.separator_key);
-            
-            // Find insertion position
-            uint32_t insert_pos = 0;
-            while (insert_pos < parent.num_keys && parent.keys[insert_pos] < op.separator_key) {
-                insert_pos++;
-            }
-            
-            // Shift keys and children
-            for (uint32_t i = parent.num_keys; i > insert_pos; i--) {
-                parent.keys[i] = parent.keys[i-1];
-                parent.children[i+1] = parent.children[i];
-            }
-            
-            // Insert separator key and new child
-            parent.keys[insert_pos] = op.separator_key;
-            parent.children[insert_pos + 1] = op.new_node.node_address;
-            parent.num_keys++;
-            
-            out.output("   ✓ Inserted separator at position %u (now %u keys)\n",
-                       insert_pos, parent.num_keys);
-            
-            // Write parent back
-            op.split_phase = AsyncOperation::UPDATE_PARENT_NODE;
-            
-            auto req = new SST::Interfaces::StandardMem::Write(
-                parent.node_address, get_serialized_node_size(), serialize_node(parent));
-            auto req_id_write = req->getID();
-            pending_ops[req_id_write] = op;
-            
-            SST::Interfaces::StandardMem* target_interface = get_interface_for_address(parent.node_address);
-            target_interface->send(req);
-            stat_network_writes->addData(1);
-            
-            pending_ops.erase(req_id);
-            
+        // Optimistic mode: lock the parent (validating this copy) before changing it
+        if (optimistic_cc) {
+            op.split_phase = AsyncOperation::LOCK_PARENT;
+            lock_node(op, op.parent_address, BTreeNodeView(parent));
         } else {
-            out.output("   ⚠️  Parent FULL (%u/%u) - need to split parent recursively\n",
-                       parent.num_keys, btree_fanout);
-            
-            // Parent is full - split it recursively
-            split_internal_async(op, parent, op.separator_key, op.new_node.node_address);
-            pending_ops.erase(req_id);
+            update_parent_node(op, parent);
         }
+        pending_ops.erase(req_id);
         
         return;
     }
     
-    // Regular traversal read
-    BTreeNode node = deserialize_node(data);
-    op.path.push_back(node);  // Save for potential splits
+    // Regular traversal read - the node is read in place from the payload
+    BTreeNodeView node = deserialize_node(data);
+    process_node_on_cpu(op, node, data.size());
     
-    out.output("   Level %u: Read node at 0x%lx, keys=%u, is_leaf=%d\n",
-               op.current_level, op.current_address, node.num_keys, node.is_leaf);
-    
-    // Check if we've reached a leaf node
-    if (node.is_leaf || op.current_level >= tree_height - 1) {
-        // Reached leaf - perform the actual operation
-        out.output("   ✓ Reached leaf at 0x%lx (Level %u) with %u keys\n",
-                   op.current_address, op.current_level, node.num_keys);
+    // Traversal state has moved to the next request (or the operation finished)
+    pending_ops.erase(req_id);
+}
+
+void ComputeServer::update_parent_node(AsyncOperation& op, BTreeNode& parent) {
+    // Check if parent has space for separator key
+    if (parent.num_keys() < btree_fanout) {
+        out.output("   Parent has space (%u/%u) - inserting separator key=%lu\n",
+                   parent.num_keys(), btree_fanout, op.separator_key);
+        
+        // Find insertion position
+        uint32_t insert_pos = 0;
+        while (insert_pos < parent.num_keys() && parent.keys()[insert_pos] < op.separator_key) {
+            insert_pos++;
+        }
+        
+        // Shift keys and children
+        for (uint32_t i = parent.num_keys(); i > insert_pos; i--) {
+            parent.keys()[i] = parent.keys()[i-1];
+            parent.children()[i+1] = parent.children()[i];
+        }
+        
+        // Insert separator key and new child
+        parent.keys()[insert_pos] = op.separator_key;
+        parent.children()[insert_pos + 1] = op.new_node_address;
+        parent.num_keys()++;
+        
+        out.output("   ✓ Inserted separator at position %u (now %u keys)\n",
+                   insert_pos, parent.num_keys());
+        
+        // Write parent back
+        op.split_phase = AsyncOperation::UPDATE_PARENT_NODE;
+        index_cache_invalidate(parent.node_address());
+        
+        auto req = new SST::Interfaces::StandardMem::Write(
+            parent.node_address(), get_serialized_node_size(), serialize_node(parent));
+        track_request(req->getID(), op);
+        
+        SST::Interfaces::StandardMem* target_interface = get_interface_for_address(parent.node_address());
+        target_interface->send(req);
+        stat_network_writes->addData(1);
+        
+    } else {
+        out.output("   ⚠️  Parent FULL (%u/%u) - need to split parent recursively\n",
+                   parent.num_keys(), btree_fanout);
+        
+        // Parent is full - split it recursively
+        split_internal_async(op, parent, op.separator_key, op.new_node_address);
+    }
+    
+}
+
+void ComputeServer::process_traversal_node(AsyncOperation& op, const BTreeNodeView& node) {
+    // Learned-index window reads are gathered by their lookup, not traversed
+    if (op.lookup_id != 0) {
+        learned_read_arrived(op, node);
+        return;
+    }
+    
+    // Optimistic mode: a node a writer holds may be mid-update, so read it again later
+    if (optimistic_cc && node.is_locked()) {
+        stat_optimistic_read_retries->addData(1);
+        schedule_retry(op);
+        return;
+    }
+    end_lock_wait(op);
+    
+    op.path.push_back(node.node_address());  // Save for potential splits
+    
+    out.output("   Level %u: Read node at 0x%lx, keys=%u, is_leaf=%d\n",
+               op.current_level, op.current_address, node.num_keys(), node.is_leaf());
+    
+    // Check if we've reached a leaf node (scan reads past the first leaf only ever read leaves)
+    bool scan_leaf = (op.type == AsyncOperation::SCAN && op.scan_seq > 0);
+    if (node.is_leaf() || scan_leaf || op.current_level >= tree_height - 1) {
+        // Reached leaf - perform the actual operation
+        out.output("   ✓ Reached leaf at 0x%lx (Level %u) with %u keys\n",
+                   op.current_address, op.current_level, node.num_keys());
+        if (op.prefetch_id != 0) {
+            path_prefetch_end(op.prefetch_id);
+        }
+        
+        // Optimistic mode: writers lock the leaf, validating this copy, before changing it
+        if (optimistic_cc && op.type == AsyncOperation::INSERT) {
+            if (lock_coalescing) {
+                // Another insert from this server is acquiring the leaf: wait for its handover
+                LocalLock& local = local_locks[op.current_address];
+                if (local.acquiring) {
+                    begin_lock_wait(op);
+                    local.waiters.push_back(op);
+                    return;
+                }
+                local.acquiring = true;
+            }
+            lock_node(op, op.current_address, node);
+            return;
+        }
+        
         handle_leaf_operation(op, node);
         
-        // Check if operation returned early (e.g., split started)
-        if (pending_ops.count(req_id)) {
-            // Operation complete - record statistics (only if not splitting)
-            SimTime_t latency = getCurrentSimTime() - op.start_time;
-            stat_total_latency->addData(latency);
-            stat_ops_completed->addData(1);
-            
-            // Clean up
-            pending_ops.erase(req_id);
+        // A split continues asynchronously and completes the operation later,
+        // a scan completes once it has consumed enough leaves
+        if (op.type != AsyncOperation::SPLIT_LEAF && op.type != AsyncOperation::SPLIT_INTERNAL &&
+            op.type != AsyncOperation::SCAN) {
+            complete_operation(op);
         }
         
     } else {
-        // Internal node - continue traversal
+        // Internal node - remember it so later traversals can skip the network read
+        index_cache_insert(node);
+        if (path_prefetch) {
+            path_hint_record(op, node);
+        }
+        
+        // Continue traversal
         uint64_t child_idx = get_child_index_for_key(node, op.key);
-        uint64_t child_addr = node.children[child_idx];
+        uint64_t child_addr = node.children()[child_idx];
         
         out.output("   → Continue to child[%lu] = 0x%lx\n", child_idx, child_addr);
         
-        // Record parent relationship for potential splits
-        parent_map[child_addr] = op.current_address;
+        AsyncOperation next_op = op;
+        next_op.current_level++;
+        next_op.current_address = child_addr;
+        next_op.range_lo = (child_idx == 0) ? op.range_lo : node.keys()[child_idx - 1];
+        next_op.range_hi = (child_idx == node.num_keys()) ? op.range_hi : node.keys()[child_idx];
+        // A child the path prefetch already read (or is reading) needs no dependent read
+        if (next_op.prefetch_id == 0 || !path_prefetch_take(next_op)) {
+            issue_traversal_read(next_op);
+        }
         
-        // Create next read request
-        auto next_req = new SST::Interfaces::StandardMem::Read(child_addr, get_serialized_node_size());
-        auto next_req_id = next_req->getID();
+        // A scan reaching the parent of the leaves already knows the leaves
+        // right of the first one, so their reads can start now
+        if (op.type == AsyncOperation::SCAN && op.current_level + 2 >= tree_height) {
+            auto it = active_scans.find(op.scan_id);
+            if (it != active_scans.end() && !it->second.descended) {
+                ScanState& scan = it->second;
+                scan.descended = true;
+                for (uint64_t i = child_idx + 1; i <= node.num_keys(); i++) {
+                    scan.candidates.push_back(node.children()[i]);
+                }
+                issue_scan_reads(scan);
+            }
+        }
+    }
+}
+
+void ComputeServer::issue_scan_reads(ScanState& scan) {
+    // Keep up to scan_prefetch_depth leaves ahead of the consume point, but
+    // no more than a half-full leaf per key still needed
+    uint32_t half_leaf = std::max<uint32_t>(1, btree_fanout / 2);
+    uint32_t window = std::min(scan_prefetch_depth, (scan.remaining + half_leaf - 1) / half_leaf);
+    
+    while (!scan.candidates.empty() && scan.issued - scan.consumed < window) {
+        AsyncOperation read;
+        read.type = AsyncOperation::SCAN;
+        read.key = scan.op.key;
+        read.start_time = scan.op.start_time;
+        read.scan_id = scan.op.scan_id;
+        read.scan_seq = scan.issued++;
+        read.current_level = tree_height - 1;
+        read.current_address = scan.candidates.front();
+        scan.candidates.pop_front();
         
-        // Transfer state to new request
-        pending_ops[next_req_id] = op;
-        pending_ops[next_req_id].current_level++;
-        pending_ops[next_req_id].current_address = child_addr;
+        dbg.debug(CALL_INFO, 3, 0, "Scan %lu prefetching leaf %u at 0x%lx\n",
+                  read.scan_id, read.scan_seq, read.current_address);
+        issue_traversal_read(read);
+    }
+}
+
+void ComputeServer::scan_leaf_arrived(const AsyncOperation& op, const BTreeNodeView& leaf) {
+    auto it = active_scans.find(op.scan_id);
+    if (it == active_scans.end()) {
+        // Prefetched past the end of a scan that has already completed
+        return;
+    }
+    ScanState& scan = it->second;
+    scan.op.round_trips += op.round_trips;
+    scan.op.lock_wait += op.lock_wait;
+    
+    // A sibling whose split is still being written reads as an empty node and ends the scan
+    ScanState::LeafResult result = { 0, 0 };
+    if (leaf.is_leaf()) {
+        for (uint32_t i = 0; i < leaf.num_keys(); i++) {
+            if (leaf.keys()[i] >= scan.op.key) {
+                result.keys++;
+            }
+        }
+        result.next_leaf = leaf.next_leaf();
+    }
+    scan.arrived[op.scan_seq] = result;
+    
+    // Past the parent's last child the next leaf is only known from the sibling pointer
+    if (op.scan_seq + 1 == scan.issued && scan.candidates.empty() && result.next_leaf != 0) {
+        scan.candidates.push_back(result.next_leaf);
+    }
+    
+    // Consume leaves in key order
+    while (scan.remaining > 0) {
+        auto next = scan.arrived.find(scan.consumed);
+        if (next == scan.arrived.end()) {
+            break;
+        }
+        scan.remaining -= std::min(next->second.keys, scan.remaining);
+        scan.consumed++;
+        scan.arrived.erase(next);
+    }
+    
+    // Out of keys only once every known leaf is consumed and the last had no sibling
+    if (scan.remaining > 0 && !(scan.consumed == scan.issued && scan.candidates.empty())) {
+        issue_scan_reads(scan);
+        return;
+    }
+    
+    out.output("   ✓ SCAN key=%lu complete after %u leaves (%u keys short)\n",
+               scan.op.key, scan.consumed, scan.remaining);
+    stat_scans->addData(1);
+    stat_scan_leaves_read->addData(scan.consumed);
+    stat_scan_leaves_overfetched->addData(scan.issued - scan.consumed);
+    complete_operation(scan.op);
+    active_scans.erase(it);
+}
+
+void ComputeServer::issue_traversal_read(const AsyncOperation& op) {
+    uint64_t address = op.current_address;
+    
+    // Internal nodes may be served from the local index cache
+    if (index_cache_capacity > 0) {
+        const BTreeNode* cached = index_cache_lookup(address);
+        if (cached) {
+            stat_index_cache_hits->addData(1);
+            dbg.debug(CALL_INFO, 3, 0, "Index cache hit for node 0x%lx\n", address);
+            index_cache_link->send(index_cache_hit_latency, new IndexCacheHitEvent(op, *cached));
+            return;
+        }
+        stat_index_cache_misses->addData(1);
+    }
+    
+    // Miss (or cache disabled) - read the node from its memory server
+    issue_node_read(op);
+}
+
+void ComputeServer::issue_node_read(const AsyncOperation& op) {
+    // Read the node directly or through its server's open doorbell batch
+    if (read_batch_size <= 1) {
+        send_node_read(op);
+        return;
+    }
+    
+    uint32_t server = get_server_for_address(op.current_address);
+    read_batches[server].push_back(op);
+    if (read_batches[server].size() >= read_batch_size) {
+        flush_read_batch(server);
+    } else if (!read_batch_flush_pending[server]) {
+        read_batch_flush_pending[server] = true;
+        read_batch_link->send(read_batch_window, new ReadBatchFlushEvent(server));
+    }
+}
+
+void ComputeServer::path_prefetch_begin(AsyncOperation& op) {
+    // Read the nodes below the root the hints say cover the key, in parallel
+    // with the root read, instead of one dependent read per level
+    if (path_hint_version != index_cache_version) {
+        for (auto& level : path_hints) {
+            level.clear();
+        }
+        path_hint_version = index_cache_version;
+    }
+    if (tree_height < 2) {
+        return;
+    }
+    PathPrefetch* prefetch = nullptr;
+    uint32_t last = std::min<uint32_t>(tree_height - 1, path_prefetch_levels);
+    for (uint32_t level = 1; level <= last && level < path_hints.size(); level++) {
+        auto& hints = path_hints[level];
+        auto it = hints.upper_bound(op.key);
+        if (it == hints.begin()) {
+            continue;
+        }
+        --it;
+        if (op.key >= it->second.hi) {
+            continue;
+        }
+        // Cached internal nodes are served locally without speculating
+        uint64_t address = it->second.address;
+        if (index_cache_capacity > 0 && index_cache.count(address)) {
+            continue;
+        }
         
-        // Send request
-        SST::Interfaces::StandardMem* target_interface = get_interface_for_address(child_addr);
-        target_interface->send(next_req);
-        stat_network_reads->addData(1);
+        if (!prefetch) {
+            op.prefetch_id = ++next_prefetch_id;
+            prefetch = &active_prefetches[op.prefetch_id];
+            prefetch->slots.resize(tree_height);
+        }
+        PathPrefetch::Slot& slot = prefetch->slots[level];
+        slot.state = PathPrefetch::IN_FLIGHT;
+        slot.address = address;
         
-        // Clean up old request
+        AsyncOperation read;
+        read.type = op.type;
+        read.key = op.key;
+        read.start_time = op.start_time;
+        read.prefetch_id = op.prefetch_id;
+        read.speculative = true;
+        read.current_level = level;
+        read.current_address = address;
+        issue_node_read(read);
+        stat_path_prefetch_reads->addData(1);
+    }
+}
+
+void ComputeServer::path_hint_record(const AsyncOperation& op, const BTreeNodeView& node) {
+    // Each child covers the keys between its separators, clipped to the
+    // range of the node itself
+    if (path_hint_version != index_cache_version) {
+        for (auto& level : path_hints) {
+            level.clear();
+        }
+        path_hint_version = index_cache_version;
+    }
+    uint32_t level = op.current_level + 1;
+    if (path_hints.size() <= level) {
+        path_hints.resize(level + 1);
+    }
+    auto& hints = path_hints[level];
+    for (uint32_t i = 0; i <= node.num_keys(); i++) {
+        uint64_t lo = (i == 0) ? op.range_lo : node.keys()[i - 1];
+        uint64_t hi = (i == node.num_keys()) ? op.range_hi : node.keys()[i];
+        auto it = hints.find(lo);
+        if (it != hints.end()) {
+            it->second = PathHint{hi, node.children()[i]};
+        } else if (hints.size() < path_prefetch_hint_capacity) {
+            hints.emplace(lo, PathHint{hi, node.children()[i]});
+        }
+    }
+}
+
+bool ComputeServer::path_prefetch_take(const AsyncOperation& op) {
+    // Returns true if the prefetch supplies the child op is about to read
+    auto it = active_prefetches.find(op.prefetch_id);
+    if (it == active_prefetches.end() || op.current_level >= it->second.slots.size()) {
+        return false;
+    }
+    std::vector<PathPrefetch::Slot>& slots = it->second.slots;
+    PathPrefetch::Slot& slot = slots[op.current_level];
+    if (slot.state != PathPrefetch::IN_FLIGHT && slot.state != PathPrefetch::ARRIVED) {
+        return false;
+    }
+    
+    // The real parent points elsewhere, so this and every deeper prediction
+    // were made for a path the traversal is not on
+    if (slot.address != op.current_address) {
+        stat_path_prefetch_mispredicts->addData(1);
+        for (uint32_t level = op.current_level; level < slots.size(); level++) {
+            path_prefetch_discard(slots[level]);
+        }
+        return false;
+    }
+    
+    stat_path_prefetch_hits->addData(1);
+    if (slot.state == PathPrefetch::IN_FLIGHT) {
+        slot.waiting = true;
+        slot.waiter = op;
+        return true;
+    }
+    
+    // Already here: process it as if the read had just returned
+    slot.state = PathPrefetch::USED;
+    std::vector<uint8_t> image;
+    image.swap(slot.image);
+    AsyncOperation next = op;
+    next.round_trips++;
+    process_node_on_cpu(next, deserialize_node(image), image.size());
+    return true;
+}
+
+void ComputeServer::path_prefetch_discard(PathPrefetch::Slot& slot) {
+    // Slots still in flight are charged as wasted when they arrive
+    if (slot.state == PathPrefetch::ARRIVED) {
+        stat_path_prefetch_wasted_bytes->addData(slot.image.size());
+        slot.image.clear();
+    }
+    if (slot.state == PathPrefetch::IN_FLIGHT || slot.state == PathPrefetch::ARRIVED) {
+        slot.state = PathPrefetch::DISCARDED;
+    }
+}
+
+void ComputeServer::path_prefetch_arrived(const AsyncOperation& op, const uint8_t* data, size_t size) {
+    auto it = active_prefetches.find(op.prefetch_id);
+    if (it == active_prefetches.end() || op.current_level >= it->second.slots.size() ||
+        it->second.slots[op.current_level].state != PathPrefetch::IN_FLIGHT) {
+        // Discarded, or the traversal finished without it
+        stat_path_prefetch_wasted_bytes->addData(size);
+        return;
+    }
+    
+    PathPrefetch::Slot& slot = it->second.slots[op.current_level];
+    if (!slot.waiting) {
+        slot.state = PathPrefetch::ARRIVED;
+        slot.image.assign(data, data + size);
+        return;
+    }
+    
+    // The traversal validated this node before it arrived and continues with it
+    slot.state = PathPrefetch::USED;
+    AsyncOperation next = slot.waiter;
+    next.round_trips++;
+    process_node_on_cpu(next, deserialize_node(data, size), size);
+}
+
+void ComputeServer::path_prefetch_end(uint64_t prefetch_id) {
+    // The traversal reached its leaf: predictions it did not use are wasted
+    auto it = active_prefetches.find(prefetch_id);
+    if (it == active_prefetches.end()) {
+        return;
+    }
+    for (auto& slot : it->second.slots) {
+        if (slot.state == PathPrefetch::ARRIVED) {
+            stat_path_prefetch_wasted_bytes->addData(slot.image.size());
+        }
+    }
+    active_prefetches.erase(it);
+}
+
+void ComputeServer::send_node_read(const AsyncOperation& op) {
+    auto req = new SST::Interfaces::StandardMem::Read(op.current_address, get_serialized_node_size());
+    track_request(req->getID(), op);
+    
+    SST::Interfaces::StandardMem* target_interface = get_interface_for_address(op.current_address);
+    target_interface->send(req);
+    stat_network_reads->addData(1);
+}
+
+uint32_t ComputeServer::get_server_for_address(uint64_t address) {
+    if (address < MEMORY_BASE_ADDRESS) {
+        return 0;
+    }
+    uint64_t memory_server_id = (address - MEMORY_BASE_ADDRESS) / memory_server_window;
+    return (memory_server_id < num_memory_nodes) ? memory_server_id : 0;
+}
+
+void ComputeServer::flush_read_batch(uint32_t server) {
+    std::vector<AsyncOperation>& batch = read_batches[server];
+    if (batch.empty()) {
+        return;
+    }
+    
+    stat_read_batches->addData(1);
+    stat_read_batch_occupancy->addData(batch.size());
+    
+    // A lone read needs no batch descriptor
+    if (batch.size() == 1) {
+        send_node_read(batch.front());
+        batch.clear();
+        return;
+    }
+    
+    BatchReadData* data = new BatchReadData(get_serialized_node_size());
+    for (auto& op : batch) {
+        data->addRead(op.current_address);
+        op.round_trips++;
+    }
+    
+    auto req = new SST::Interfaces::StandardMem::CustomReq(data);
+    dbg.debug(CALL_INFO, 3, 0, "Posting read batch of %zu reads to Memory Server %u\n", batch.size(), server);
+    stat_network_reads->addData(batch.size());
+    
+    pending_batches[req->getID()].swap(batch);
+    get_interface_for_address(data->getRoutingAddress())->send(req);
+}
+
+void ComputeServer::handleReadBatchFlush(SST::Event* ev) {
+    ReadBatchFlushEvent* flush = static_cast<ReadBatchFlushEvent*>(ev);
+    read_batch_flush_pending[flush->server] = false;
+    flush_read_batch(flush->server);
+    delete flush;
+}
+
+void ComputeServer::handle_batch_read_response(SST::Interfaces::StandardMem::Request::id_t req_id,
+                                               BatchReadData* batch) {
+    auto it = pending_batches.find(req_id);
+    if (it == pending_batches.end()) {
+        dbg.debug(CALL_INFO, 2, 0, "WARNING: Received batch response for unknown request\n");
+        return;
+    }
+    
+    std::vector<AsyncOperation> ops;
+    ops.swap(it->second);
+    pending_batches.erase(it);
+    
+    // Entries come back in the order they were posted
+    size_t entry_size = batch->entry_size;
+    for (size_t i = 0; i < ops.size(); i++) {
+        size_t offset = i * entry_size;
+        size_t avail = (offset < batch->payload.size()) ? batch->payload.size() - offset : 0;
+        if (ops[i].hash_id != 0) {
+            hash_response(ops[i], batch->payload.data() + offset, std::min(avail, entry_size), nullptr);
+            continue;
+        }
+        if (ops[i].speculative) {
+            path_prefetch_arrived(ops[i], batch->payload.data() + offset, std::min(avail, entry_size));
+            continue;
+        }
+        BTreeNodeView node = deserialize_node(batch->payload.data() + offset, std::min(avail, entry_size));
+        process_node_on_cpu(ops[i], node, entry_size);
+    }
+}
+
+void ComputeServer::handleIndexCacheHit(SST::Event* ev) {
+    IndexCacheHitEvent* hit = static_cast<IndexCacheHitEvent*>(ev);
+    // Cached nodes are already decoded, so only the key search costs CPU time
+    process_node_on_cpu(hit->op, BTreeNodeView(hit->node), 0);
+    delete hit;
+}
+
+void ComputeServer::process_node_on_cpu(AsyncOperation& op, const BTreeNodeView& node, size_t bytes) {
+    if (cpu_cores == 0) {
+        process_traversal_node(op, node);
+        return;
+    }
+    
+    // Nodes are searched linearly, so every key may be compared
+    SimTime_t delay = charge_cpu(cpu_cycles_per_byte * bytes + cpu_cycles_per_key * node.num_keys());
+    cpu_link->send(delay, new CpuWorkEvent(op, BTreeNode(node)));
+}
+
+SimTime_t ComputeServer::charge_cpu(double cycles) {
+    // Occupy the first free worker core; returns how long until the work is done
+    if (cpu_cores == 0) {
+        return 0;
+    }
+    SimTime_t now = getCurrentSimTime();
+    auto core = std::min_element(cpu_core_free_at.begin(), cpu_core_free_at.end());
+    SimTime_t start = std::max(now, *core);
+    SimTime_t busy = static_cast<SimTime_t>(std::ceil(cycles / cpu_frequency_ghz));
+    *core = start + busy;
+    cpu_busy_total += busy;
+    stat_cpu_busy_time->addData(busy);
+    stat_cpu_queue_delay->addData(start - now);
+    return *core - now;
+}
+
+void ComputeServer::handleCpuWorkDone(SST::Event* ev) {
+    CpuWorkEvent* work = static_cast<CpuWorkEvent*>(ev);
+    process_traversal_node(work->op, BTreeNodeView(work->node));
+    delete work;
+}
+
+void ComputeServer::complete_operation(const AsyncOperation& op) {
+    // With the log on, an insert (split or not) only counts once its record is durable
+    if (wal_enabled && (op.type == AsyncOperation::INSERT || op.type == AsyncOperation::SPLIT_LEAF ||
+                        op.type == AsyncOperation::SPLIT_INTERNAL)) {
+        wal_append(op);
+        return;
+    }
+    record_completion(op);
+}
+
+void ComputeServer::record_completion(const AsyncOperation& op) {
+    SimTime_t latency = getCurrentSimTime() - op.start_time;
+    stat_total_latency->addData(latency);
+    stat_ops_completed->addData(1);
+    
+    // Inserts that split carry the split type by the time they complete
+    switch (op.type) {
+        case AsyncOperation::SEARCH:
+            stat_search_latency->addData(latency);
+            search_latency_hist.record(latency);
+            break;
+        case AsyncOperation::INSERT:
+            stat_insert_latency->addData(latency);
+            insert_latency_hist.record(latency);
+            break;
+        case AsyncOperation::SCAN:
+            stat_scan_latency->addData(latency);
+            scan_latency_hist.record(latency);
+            break;
+        case AsyncOperation::SPLIT_LEAF:
+        case AsyncOperation::SPLIT_INTERNAL:
+            stat_split_insert_latency->addData(latency);
+            split_insert_latency_hist.record(latency);
+            break;
+        default:
+            break;
+    }
+    stat_round_trips->addData(op.round_trips);
+    stat_lock_wait->addData(op.lock_wait);
+    lock_wait_hist.record(op.lock_wait);
+    
+    // Free the operation's slot; the next issue happens from an event, not from inside this handler
+    ops_in_flight--;
+    if (load_mode == LOAD_CLOSED) {
+        load_link->send(think_time, new LoadEvent(LoadEvent::CLIENT));
+    } else if (load_mode == LOAD_OPEN && !admission_queue.empty()) {
+        load_link->send(0, new LoadEvent(LoadEvent::ADMIT));
+    }
+}
+
+void ComputeServer::wal_append(const AsyncOperation& op) {
+    // Records are appended once the insert has been applied, so the log
+    // write is the last step on the insert's critical path
+    stat_wal_records->addData(1);
+    wal_group.push_back({op, getCurrentSimTime()});
+    
+    if (wal_group.size() >= wal_group_size) {
+        wal_flush();
+    } else if (wal_group.size() == 1 && wal_group_timeout > 0) {
+        wal_link->send(wal_group_timeout, new WalFlushEvent(wal_group_seq));
+    } else if (wal_group_timeout == 0 && wal_inflight.empty()) {
+        wal_flush();  // No timeout: records only gather while a log write is in flight
+    }
+}
+
+void ComputeServer::wal_flush() {
+    if (wal_group.empty()) {
+        return;
+    }
+    
+    // One contiguous append per group; a group that would run off the end
+    // of the circular log space starts again at its beginning
+    size_t bytes = wal_group.size() * WAL_RECORD_SIZE;
+    if (wal_tail + bytes > wal_size) {
+        wal_tail = 0;
+    }
+    std::vector<uint8_t> records(bytes, 0);
+    for (size_t i = 0; i < wal_group.size(); i++) {
+        uint64_t fields[4] = {wal_next_lsn++, wal_group[i].op.key, wal_group[i].op.value,
+                              static_cast<uint64_t>(node_id)};
+        std::memcpy(records.data() + i * WAL_RECORD_SIZE, fields, WAL_RECORD_SIZE);
+    }
+    
+    uint64_t address = server_base_address(wal_server) + wal_base + wal_tail;
+    wal_tail += bytes;
+    auto req = new SST::Interfaces::StandardMem::Write(address, bytes, records);
+    stat_wal_group_records->addData(wal_group.size());
+    stat_network_writes->addData(1);
+    
+    std::vector<WalEntry>& inflight = wal_inflight[req->getID()];
+    inflight.swap(wal_group);
+    for (WalEntry& entry : inflight) {
+        entry.op.round_trips++;
+    }
+    wal_group_seq++;
+    get_interface_for_address(address)->send(req);
+}
+
+void ComputeServer::handleWalFlush(SST::Event* ev) {
+    WalFlushEvent* flush = static_cast<WalFlushEvent*>(ev);
+    // The group this timeout was set for may already have filled up and been written
+    if (flush->group == wal_group_seq) {
+        wal_flush();
+    }
+    delete flush;
+}
+
+bool ComputeServer::handle_wal_response(SST::Interfaces::StandardMem::Request::id_t req_id) {
+    auto it = wal_inflight.find(req_id);
+    if (it == wal_inflight.end()) {
+        return false;
+    }
+    
+    // The group is durable: every insert in it completes now
+    SimTime_t now = getCurrentSimTime();
+    for (const WalEntry& entry : it->second) {
+        stat_wal_commit_delay->addData(now - entry.commit_time);
+        record_completion(entry.op);
+    }
+    wal_inflight.erase(it);
+    
+    if (wal_group_timeout == 0 && wal_inflight.empty()) {
+        wal_flush();
+    }
+    return true;
+}
+
+AsyncOperation& ComputeServer::track_request(SST::Interfaces::StandardMem::Request::id_t req_id,
+                                             const AsyncOperation& op) {
+    // Every tracked request is one network round trip for the operation
+    AsyncOperation& tracked = pending_ops.insert(req_id);
+    tracked = op;
+    tracked.round_trips++;
+    return tracked;
+}
+
+void ComputeServer::print_latency_summary(const char* name, const LatencyHistogram& hist) {
+    if (hist.getCount() == 0) {
+        return;
+    }
+    out.output("  %-13s n=%lu p50=%lu p99=%lu p999=%lu max=%lu ns\n", name, hist.getCount(),
+               hist.percentile(0.50), hist.percentile(0.99), hist.percentile(0.999), hist.getMax());
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OPTIMISTIC CONCURRENCY - version-validated reads, CAS-locked writes
+// ═══════════════════════════════════════════════════════════════════════════
+
+void ComputeServer::lock_node(AsyncOperation& op, uint64_t address, const BTreeNodeView& node) {
+    // The CAS expects the unlocked word this copy was read with, so success
+    // both locks the node and proves the copy is still current
+    op.lock_address = address;
+    op.lock_word = node.version_lock();
+    op.locked_image.assign(node.data(), node.data() + node.size());
+    
+    dbg.debug(CALL_INFO, 3, 0, "Locking node 0x%lx at version %lu\n", address, node.version());
+    stat_lock_cas_attempts->addData(1);
+    begin_lock_wait(op);  // Acquiring the lock costs at least the CAS round trip
+    send_remote_atomic(RemoteAtomicData::ATOMIC_CAS, address, op.lock_word | BTREE_NODE_LOCK_BIT, op.lock_word, &op);
+}
+
+void ComputeServer::send_remote_atomic(RemoteAtomicData::Opcode opcode, uint64_t address, uint64_t operand,
+                                       uint64_t compare, const AsyncOperation* op) {
+    // One-sided: the memory server performs the read-modify-write, so no
+    // separate read round trip is needed. Untracked atomics (op == nullptr)
+    // are fire-and-forget.
+    auto req = new SST::Interfaces::StandardMem::CustomReq(new RemoteAtomicData(opcode, address, operand, compare));
+    if (op) {
+        track_request(req->getID(), *op);
+    }
+    get_interface_for_address(address)->send(req);
+}
+
+void ComputeServer::handle_atomic_response(SST::Interfaces::StandardMem::Request::id_t req_id,
+                                           RemoteAtomicData* atomic) {
+    AsyncOperation* tracked = pending_ops.find(req_id);
+    if (!tracked) {
+        // Lock releases are not tracked
+        dbg.debug(CALL_INFO, 3, 0, "Atomic completed for req_id=%lu (not tracked)\n", req_id);
+        return;
+    }
+    
+    auto& op = *tracked;
+    if (op.hash_id != 0) {
+        AsyncOperation tag = op;
         pending_ops.erase(req_id);
+        hash_response(tag, nullptr, 0, atomic);
+        return;
+    }
+    bool parent_lock = (op.split_phase == AsyncOperation::LOCK_PARENT);
+    
+    if (!atomic->success) {
+        // Locked by another writer, or changed since it was read - read it again
+        stat_lock_cas_failures->addData(1);
+        out.output("   ⚠️  Lock CAS failed on 0x%lx (expected 0x%lx, found 0x%lx) - retrying\n",
+                   atomic->addr, atomic->compare, atomic->result);
+        if (parent_lock) {
+            op.split_phase = AsyncOperation::READ_PARENT;
+        } else {
+            op.path.pop_back();  // The leaf is pushed again when it is re-read
+            if (lock_coalescing) {
+                local_locks[op.lock_address].acquiring = false;  // Queued inserts keep waiting
+            }
+        }
+        schedule_retry(op);
+        pending_ops.erase(req_id);
+        return;
+    }
+    
+    // Locked - modify the validated copy; writing it back with the next
+    // version and the lock bit clear releases the node
+    end_lock_wait(op);
+    BTreeNode node(deserialize_node(op.locked_image));
+    node.version_lock() = btree_next_version_word(op.lock_word);
+    
+    if (parent_lock) {
+        op.split_phase = AsyncOperation::READ_PARENT;
+        update_parent_node(op, node);
+    } else if (lock_coalescing) {
+        serve_local_lock(op, node);
+    } else {
+        handle_leaf_operation(op, BTreeNodeView(node));
+        if (op.type != AsyncOperation::SPLIT_LEAF && op.type != AsyncOperation::SPLIT_INTERNAL) {
+            complete_operation(op);
+        }
+    }
+    pending_ops.erase(req_id);
+}
+
+void ComputeServer::serve_local_lock(AsyncOperation& holder, BTreeNode& leaf) {
+    // The holder and up to lock_handover_limit inserts queued behind it are
+    // applied to the locked copy in turn, so only the holder paid for the CAS.
+    // With write combining the leaf is written once, releasing the lock;
+    // otherwise each insert writes it with the lock still held and the last
+    // write releases it.
+    uint64_t address = holder.lock_address;
+    uint64_t release_word = leaf.version_lock();
+    uint64_t held_word = holder.lock_word | BTREE_NODE_LOCK_BIT;
+    
+    std::deque<AsyncOperation> queue;
+    auto it = local_locks.find(address);
+    if (it != local_locks.end()) {
+        queue.swap(it->second.waiters);
+        local_locks.erase(it);
+    }
+    size_t batch = 1 + std::min<size_t>(queue.size(), lock_handover_limit);
+    
+    uint32_t unwritten = 0;
+    for (size_t i = 0; i < batch; i++) {
+        AsyncOperation& op = (i == 0) ? holder : queue[i - 1];
+        if (i > 0) {
+            end_lock_wait(op);
+            op.lock_address = address;
+            op.lock_word = holder.lock_word;
+            stat_lock_handovers->addData(1);
+        }
+        stat_inserts->addData(1);
+        
+        if (!insert_into_leaf(leaf, op.key, op.value)) {
+            // Full: this insert splits the leaf, and the split's write of the
+            // old node (carrying any combined inserts) releases the lock
+            out.output("   ⚠️  Leaf FULL (%u/%u) - initiating ASYNC SPLIT\n", leaf.num_keys(), btree_fanout);
+            leaf.version_lock() = release_word;
+            split_leaf_async(op, leaf, op.key, op.value);
+            queue.erase(queue.begin(), queue.begin() + i);
+            release_local_waiters(address, queue);
+            return;
+        }
+        unwritten++;
+        
+        bool last = (i + 1 == batch);
+        if (!write_combining || last) {
+            leaf.version_lock() = last ? release_word : held_word;
+            write_node_back(leaf);
+            op.round_trips++;
+            stat_combined_writes->addData(unwritten);
+            unwritten = 0;
+        }
+        complete_operation(op);
+    }
+    
+    queue.erase(queue.begin(), queue.begin() + (batch - 1));
+    release_local_waiters(address, queue);
+}
+
+void ComputeServer::release_local_waiters(uint64_t address, std::deque<AsyncOperation>& waiters) {
+    // Inserts left over after a release or split acquire the lock remotely:
+    // the first re-reads the leaf and CASes, the rest stay queued behind it
+    if (waiters.empty()) {
+        return;
+    }
+    AsyncOperation first = waiters.front();
+    waiters.pop_front();
+    if (!waiters.empty()) {
+        LocalLock& local = local_locks[address];
+        local.acquiring = false;
+        for (auto& op : waiters) {
+            local.waiters.push_back(op);
+        }
+    }
+    first.path.pop_back();  // The leaf is pushed again when it is re-read
+    schedule_retry(first);
+}
+
+void ComputeServer::send_btree_rpc(AsyncOperation& op) {
+    // The whole operation goes to the server owning the current node, which
+    // walks as far as it can and answers once
+    auto opcode = (op.type == AsyncOperation::INSERT) ? BTreeRpcData::RPC_INSERT : BTreeRpcData::RPC_SEARCH;
+    auto req = new SST::Interfaces::StandardMem::CustomReq(
+        new BTreeRpcData(opcode, op.current_address, op.current_level, tree_height, btree_fanout, op.key, op.value));
+    op.round_trips++;
+    track_request(req->getID(), op);
+    get_interface_for_address(op.current_address)->send(req);
+    stat_rpc_requests->addData(1);
+}
+
+void ComputeServer::handle_rpc_response(SST::Interfaces::StandardMem::Request::id_t req_id, BTreeRpcData* rpc) {
+    AsyncOperation* tracked = pending_ops.find(req_id);
+    if (!tracked) {
+        return;
+    }
+    AsyncOperation op = *tracked;
+    pending_ops.erase(req_id);
+    
+    switch (rpc->status) {
+        case BTreeRpcData::RPC_DONE:
+            end_lock_wait(op);
+            if (op.type == AsyncOperation::INSERT) {
+                stat_inserts->addData(1);
+                out.output("   ✓ RPC INSERT key=%lu done after %u nodes\n", op.key, rpc->nodes_visited);
+            } else {
+                stat_searches->addData(1);
+                out.output("   %s RPC SEARCH key=%lu after %u nodes\n", rpc->found ? "✓ FOUND" : "✗ NOT FOUND",
+                           op.key, rpc->nodes_visited);
+            }
+            complete_operation(op);
+            break;
+        case BTreeRpcData::RPC_FORWARD:
+            // The next node lives on another server; continue the walk there
+            if (rpc->start < MEMORY_BASE_ADDRESS) {
+                out.fatal(CALL_INFO, -1, "RPC for key %lu reached invalid node address 0x%lx\n", op.key, rpc->start);
+            }
+            op.current_address = rpc->start;
+            op.current_level = rpc->level;
+            send_btree_rpc(op);
+            break;
+        case BTreeRpcData::RPC_BUSY:
+            // A one-sided writer holds a node on the way; retry from that node
+            stat_optimistic_read_retries->addData(1);
+            op.current_address = rpc->start;
+            op.current_level = rpc->level;
+            schedule_retry(op);
+            break;
+        case BTreeRpcData::RPC_LEAF_FULL:
+            // Splits are driven by the compute server: redo the insert one-sided
+            stat_rpc_fallbacks->addData(1);
+            op.via_rpc = false;
+            op.current_address = root_address;
+            op.current_level = 0;
+            op.path.clear();
+            issue_traversal_read(op);
+            break;
+    }
+}
+
+void ComputeServer::schedule_retry(const AsyncOperation& op) {
+    OperationRetryEvent* retry = new OperationRetryEvent(op);
+    begin_lock_wait(retry->op);
+    retry_link->send(optimistic_retry_backoff, retry);
+}
+
+void ComputeServer::begin_lock_wait(AsyncOperation& op) {
+    if (!op.waiting_on_lock) {
+        op.waiting_on_lock = true;
+        op.lock_wait_start = getCurrentSimTime();
+    }
+}
+
+void ComputeServer::end_lock_wait(AsyncOperation& op) {
+    if (op.waiting_on_lock) {
+        op.lock_wait += getCurrentSimTime() - op.lock_wait_start;
+        op.waiting_on_lock = false;
+    }
+}
+
+void ComputeServer::handleOperationRetry(SST::Event* ev) {
+    OperationRetryEvent* retry = static_cast<OperationRetryEvent*>(ev);
+    retry->op.retries++;
+    
+    if (retry->op.hash_id != 0) {
+        // A hash split lock was held elsewhere; that split changes the directory
+        auto it = active_hash_ops.find(retry->op.hash_id);
+        if (it != active_hash_ops.end()) {
+            hash_refresh_directory(it->second);
+        }
+    } else if (retry->op.via_rpc) {
+        send_btree_rpc(retry->op);
+    } else if (retry->op.split_phase == AsyncOperation::READ_PARENT) {
+        send_parent_read(retry->op);
+    } else {
+        issue_traversal_read(retry->op);
+    }
+    delete retry;
+}
+
+void ComputeServer::send_parent_read(const AsyncOperation& op) {
+    // While the parent is still being searched for, current_address is the node on the way
+    uint64_t address = (op.parent_address != 0) ? op.parent_address : op.current_address;
+    
+    auto req = new SST::Interfaces::StandardMem::Read(address, get_serialized_node_size());
+    track_request(req->getID(), op);
+    
+    get_interface_for_address(address)->send(req);
+    stat_network_reads->addData(1);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INDEX CACHE - compute-side cache of internal nodes
+// ═══════════════════════════════════════════════════════════════════════════
+
+const BTreeNode* ComputeServer::index_cache_lookup(uint64_t address) {
+    auto it = index_cache.find(address);
+    if (it == index_cache.end()) {
+        return nullptr;
+    }
+    
+    // Entries filled before the last root change may point at a stale tree shape
+    if (it->second.version != index_cache_version) {
+        index_cache_lru.erase(it->second.lru_pos);
+        index_cache.erase(it);
+        return nullptr;
+    }
+    
+    index_cache_lru.splice(index_cache_lru.begin(), index_cache_lru, it->second.lru_pos);
+    return &it->second.node;
+}
+
+void ComputeServer::index_cache_insert(const BTreeNodeView& node) {
+    if (index_cache_capacity == 0 || node.is_leaf()) {
+        return;
+    }
+    
+    auto it = index_cache.find(node.node_address());
+    if (it != index_cache.end()) {
+        it->second.node = BTreeNode(node);
+        it->second.version = index_cache_version;
+        index_cache_lru.splice(index_cache_lru.begin(), index_cache_lru, it->second.lru_pos);
+        return;
+    }
+    
+    if (index_cache.size() >= index_cache_capacity) {
+        uint64_t victim = index_cache_lru.back();
+        index_cache_lru.pop_back();
+        index_cache.erase(victim);
+        stat_index_cache_evictions->addData(1);
+    }
+    
+    index_cache_lru.push_front(node.node_address());
+    IndexCacheEntry& entry = index_cache[node.node_address()];
+    entry.node = BTreeNode(node);
+    entry.version = index_cache_version;
+    entry.lru_pos = index_cache_lru.begin();
+}
+
+void ComputeServer::index_cache_invalidate(uint64_t address) {
+    auto it = index_cache.find(address);
+    if (it != index_cache.end()) {
+        index_cache_lru.erase(it->second.lru_pos);
+        index_cache.erase(it);
+        stat_index_cache_invalidations->addData(1);
     }
 }
 
 void ComputeServer::handle_write_response(SST::Interfaces::StandardMem::Request::id_t req_id) {
+    if (handle_wal_response(req_id) || handle_learned_write_response(req_id)) {
+        return;
+    }
+    
     // Check if this write is part of a split operation
-    if (pending_ops.count(req_id)) {
-        auto& op = pending_ops[req_id];
+    if (AsyncOperation* tracked = pending_ops.find(req_id)) {
+        auto& op = *tracked;
         
-        if (op.type == AsyncOperation::SPLIT_LEAF || op.type == AsyncOperation::SPLIT_INTERNAL) {
+        if (op.hash_id != 0) {
+            AsyncOperation tag = op;
+            pending_ops.erase(req_id);
+            hash_response(tag, nullptr, 0, nullptr);
+        } else if (op.type == AsyncOperation::SPLIT_LEAF || op.type == AsyncOperation::SPLIT_INTERNAL) {
             // This is a split operation write - continue the split state machine
             handle_split_response(op);
             pending_ops.erase(req_id);
@@ -801,42 +2520,23 @@ void ComputeServer::handle_write_response(SST::Interfaces::StandardMem::Request:
     }
 }
 
-void ComputeServer::handle_leaf_operation(AsyncOperation& op, BTreeNode& leaf) {
+void ComputeServer::handle_leaf_operation(AsyncOperation& op, const BTreeNodeView& leaf_view) {
     switch (op.type) {
         case AsyncOperation::INSERT: {
             out.output("   Executing INSERT in leaf: key=%lu, value=%lu\n", op.key, op.value);
             stat_inserts->addData(1);
             
-            if (leaf.num_keys < btree_fanout) {
-                // Space available - insert key
-                uint32_t insert_pos = 0;
-                while (insert_pos < leaf.num_keys && leaf.keys[insert_pos] < op.key) {
-                    insert_pos++;
-                }
-                
-                // Check for duplicate
-                if (insert_pos < leaf.num_keys && leaf.keys[insert_pos] == op.key) {
-                    out.output("   ⚠️  Duplicate key=%lu - updating value\n", op.key);
-                    leaf.values[insert_pos] = op.value;
-                } else {
-                    // Shift and insert
-                    for (uint32_t i = leaf.num_keys; i > insert_pos; i--) {
-                        leaf.keys[i] = leaf.keys[i-1];
-                        leaf.values[i] = leaf.values[i-1];
-                    }
-                    leaf.keys[insert_pos] = op.key;
-                    leaf.values[insert_pos] = op.value;
-                    leaf.num_keys++;
-                    out.output("   ✓ Inserted key=%lu at position %u (now %u keys)\n",
-                               op.key, insert_pos, leaf.num_keys);
-                }
-                
+            // Inserts modify the leaf, so this is the one place a copy is made
+            BTreeNode leaf(leaf_view);
+            
+            if (insert_into_leaf(leaf, op.key, op.value)) {
                 // Write back modified leaf
                 write_node_back(leaf);
+                op.round_trips++;
             } else {
                 // Leaf is full - need to split (async)
                 out.output("   ⚠️  Leaf FULL (%u/%u) - initiating ASYNC SPLIT\n", 
-                           leaf.num_keys, btree_fanout);
+                           leaf.num_keys(), btree_fanout);
                 split_leaf_async(op, leaf, op.key, op.value);
                 return;  // Don't complete operation yet, split will continue
             }
@@ -844,18 +2544,19 @@ void ComputeServer::handle_leaf_operation(AsyncOperation& op, BTreeNode& leaf) {
         }
             
         case AsyncOperation::SEARCH: {
+            const BTreeNodeView& leaf = leaf_view;
             out.output("   Executing SEARCH in leaf: key=%lu\n", op.key);
             stat_searches->addData(1);
             
             // Search for key
             bool found = false;
-            for (uint32_t i = 0; i < leaf.num_keys; i++) {
-                if (leaf.keys[i] == op.key) {
+            for (uint32_t i = 0; i < leaf.num_keys(); i++) {
+                if (leaf.keys()[i] == op.key) {
                     out.output("   ✓ FOUND key=%lu at position %u, value=%lu\n",
-                               op.key, i, leaf.values[i]);
+                               op.key, i, leaf.values()[i]);
                     found = true;
                     break;
-                } else if (leaf.keys[i] > op.key) {
+                } else if (leaf.keys()[i] > op.key) {
                     break;
                 }
             }
@@ -865,29 +2566,883 @@ void ComputeServer::handle_leaf_operation(AsyncOperation& op, BTreeNode& leaf) {
             break;
         }
             
+        case AsyncOperation::SCAN:
+            scan_leaf_arrived(op, leaf_view);
+            break;
+            
         default:
             break;
     }
 }
 
+bool ComputeServer::insert_into_leaf(BTreeNode& leaf, uint64_t key, uint64_t value) {
+    // A full leaf is split even if the key is already present
+    if (leaf.num_keys() >= btree_fanout) {
+        return false;
+    }
+    uint32_t insert_pos = 0;
+    while (insert_pos < leaf.num_keys() && leaf.keys()[insert_pos] < key) {
+        insert_pos++;
+    }
+    
+    // Check for duplicate
+    if (insert_pos < leaf.num_keys() && leaf.keys()[insert_pos] == key) {
+        out.output("   ⚠️  Duplicate key=%lu - updating value\n", key);
+        leaf.values()[insert_pos] = value;
+        return true;
+    }
+    
+    // Shift and insert
+    for (uint32_t i = leaf.num_keys(); i > insert_pos; i--) {
+        leaf.keys()[i] = leaf.keys()[i-1];
+        leaf.values()[i] = leaf.values()[i-1];
+    }
+    leaf.keys()[insert_pos] = key;
+    leaf.values()[insert_pos] = value;
+    leaf.num_keys()++;
+    out.output("   ✓ Inserted key=%lu at position %u (now %u keys)\n",
+               key, insert_pos, leaf.num_keys());
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HASH INDEX ENGINE - RACE-style one-sided hashing (layout in raceHash.h)
+// ═══════════════════════════════════════════════════════════════════════════
+
+uint64_t ComputeServer::hash_alloc_subtable() {
+    // Subtables hold scattered keys, so range placement is given a hashed one
+    uint64_t slots = (race_subtable_size(hash_groups) + get_serialized_node_size() - 1) / get_serialized_node_size();
+    uint64_t id = next_node_id++;
+    return place_node(id, fnv_hash64(id) % key_range, 0, slots);
+}
+
+uint64_t ComputeServer::hash_alloc_kv(uint64_t key) {
+    // KV blocks are bump-allocated from heap chunks owned by this compute server
+    if (hash_kv_chunk == 0 || hash_kv_chunk_used + RACE_KV_SIZE > HASH_KV_CHUNK_SIZE) {
+        uint64_t slots = (HASH_KV_CHUNK_SIZE + get_serialized_node_size() - 1) / get_serialized_node_size();
+        hash_kv_chunk = place_node(next_node_id++, key, 0, slots);
+        hash_kv_chunk_used = 0;
+    }
+    uint64_t address = hash_kv_chunk + hash_kv_chunk_used;
+    hash_kv_chunk_used += RACE_KV_SIZE;
+    return address;
+}
+
+std::vector<uint8_t> ComputeServer::hash_directory_image() const {
+    std::vector<uint8_t> image(RACE_DIRECTORY_HEADER + hash_directory.size() * sizeof(uint64_t), 0);
+    uint64_t depth = hash_global_depth;
+    std::memcpy(image.data(), &depth, sizeof(depth));
+    std::memcpy(image.data() + RACE_DIRECTORY_HEADER, hash_directory.data(), hash_directory.size() * sizeof(uint64_t));
+    return image;
+}
+
+void ComputeServer::hash_split_table(std::vector<uint64_t>& old_words, std::vector<uint64_t>& new_words,
+                                     const std::vector<uint64_t>& slot_keys, uint32_t depth, uint64_t suffix) {
+    // Bucket choices do not depend on the depth, so a pair that moves keeps
+    // its slot position and the slot is free in the new subtable
+    new_words.assign(old_words.size(), 0);
+    for (size_t w = RACE_SUBTABLE_HEADER / sizeof(uint64_t); w < old_words.size(); w++) {
+        if ((w * sizeof(uint64_t) - RACE_SUBTABLE_HEADER) % RACE_BUCKET_SIZE == 0) {
+            old_words[w] = race_header_word(depth + 1, suffix);
+            new_words[w] = race_header_word(depth + 1, suffix | (1ULL << depth));
+        } else if (old_words[w] != 0 && ((race_hash1(slot_keys[w]) >> depth) & 1)) {
+            new_words[w] = old_words[w];
+            old_words[w] = 0;
+        }
+    }
+}
+
+void ComputeServer::hash_directory_split(uint64_t suffix, uint32_t depth, uint64_t old_table, uint64_t new_table) {
+    if (depth == hash_global_depth) {
+        // Double the directory; the upper half starts as a copy of the lower
+        size_t entries = hash_directory.size();
+        hash_directory.resize(2 * entries);
+        std::copy(hash_directory.begin(), hash_directory.begin() + entries, hash_directory.begin() + entries);
+        hash_global_depth++;
+    }
+    for (uint64_t i = suffix; i < hash_directory.size(); i += 1ULL << depth) {
+        bool upper = (i >> depth) & 1;
+        hash_directory[i] = race_directory_entry(depth + 1, upper ? new_table : old_table);
+    }
+}
+
+uint64_t ComputeServer::hash_pick_slot(const uint64_t* const images[2], const uint64_t bases[2]) const {
+    // A new pair goes to whichever combined bucket has more free slots (0 = both full)
+    uint32_t free_slots[2] = { 0, 0 };
+    uint64_t first_free[2] = { 0, 0 };
+    const size_t bucket_words = RACE_BUCKET_SIZE / sizeof(uint64_t);
+    for (int side = 0; side < 2; side++) {
+        for (size_t w = 0; w < RACE_COMBINED_SIZE / sizeof(uint64_t); w++) {
+            if (w % bucket_words == 0 || images[side][w] != 0) {
+                continue;
+            }
+            if (free_slots[side]++ == 0) {
+                first_free[side] = bases[side] + w * sizeof(uint64_t);
+            }
+        }
+    }
+    return (free_slots[1] > free_slots[0]) ? first_free[1] : first_free[0];
+}
+
+void ComputeServer::hash_build() {
+    // Every compute server lays out the same initial table, so allocators
+    // and cached directories agree; only node 0 writes it out
+    hash_directory_address = server_base_address(0) + HASH_DIRECTORY_OFFSET;
+    hash_global_depth = hash_initial_depth;
+    size_t words = race_subtable_size(hash_groups) / sizeof(uint64_t);
+    std::map<uint64_t, std::vector<uint64_t>> tables;       // Subtable address -> image
+    std::map<uint64_t, std::vector<uint64_t>> table_keys;   // Subtable address -> key linked from each slot
+    std::map<uint64_t, std::vector<uint8_t>> chunks;        // KV chunk address -> image
+    
+    hash_directory.resize(1ULL << hash_global_depth);
+    for (uint64_t i = 0; i < hash_directory.size(); i++) {
+        uint64_t address = hash_alloc_subtable();
+        std::vector<uint64_t>& image = tables[address];
+        image.assign(words, 0);
+        for (size_t w = RACE_SUBTABLE_HEADER / sizeof(uint64_t); w < words; w += RACE_BUCKET_SIZE / sizeof(uint64_t)) {
+            image[w] = race_header_word(hash_global_depth, i);
+        }
+        table_keys[address].assign(words, 0);
+        hash_directory[i] = race_directory_entry(hash_global_depth, address);
+    }
+    
+    // Preloaded keys are spread over key_range like the B+tree bulk load
+    for (uint64_t i = 0; i < bulk_load_keys; i++) {
+        uint64_t key = (uint64_t)((unsigned __int128)i * key_range / bulk_load_keys);
+        uint64_t kv = hash_alloc_kv(key);
+        std::vector<uint8_t>& chunk = chunks[hash_kv_chunk];
+        chunk.resize(HASH_KV_CHUNK_SIZE);
+        uint64_t pair[2] = { key, key * 1000 };
+        std::memcpy(chunk.data() + (kv - hash_kv_chunk), pair, sizeof(pair));
+        
+        uint64_t h1 = race_hash1(key);
+        uint64_t choice[2];
+        race_bucket_choices(key, hash_groups, choice[0], choice[1]);
+        while (true) {
+            uint64_t entry = hash_directory[h1 & race_depth_mask(hash_global_depth)];
+            uint64_t address = race_header_suffix(entry);
+            std::vector<uint64_t>& image = tables[address];
+            const uint64_t* images[2] = { &image[race_combined_offset(choice[0]) / sizeof(uint64_t)],
+                                          &image[race_combined_offset(choice[1]) / sizeof(uint64_t)] };
+            uint64_t bases[2] = { address + race_combined_offset(choice[0]), address + race_combined_offset(choice[1]) };
+            uint64_t slot = hash_pick_slot(images, bases);
+            if (slot != 0) {
+                image[(slot - address) / sizeof(uint64_t)] = race_slot_word(race_fingerprint(key), kv);
+                table_keys[address][(slot - address) / sizeof(uint64_t)] = key;
+                break;
+            }
+            
+            // Both buckets are full: split the subtable as an online insert would
+            uint32_t depth = race_header_depth(entry);
+            if (depth >= hash_max_depth) {
+                out.fatal(CALL_INFO, -1, "Hash subtable full at depth %u while preloading; raise hash_max_depth or hash_subtable_groups\n",
+                          depth);
+            }
+            uint64_t suffix = h1 & race_depth_mask(depth);
+            uint64_t new_address = hash_alloc_subtable();
+            hash_split_table(image, tables[new_address], table_keys[address], depth, suffix);
+            table_keys[new_address] = table_keys[address];
+            hash_directory_split(suffix, depth, address, new_address);
+        }
+    }
+    
+    if (node_id == 0) {
+        auto write = [this](uint64_t address, const std::vector<uint8_t>& data) {
+            interface_for_server(get_server_for_address(address))->sendUntimedData(
+                new SST::Interfaces::StandardMem::Write(address, data.size(), data, true));
+        };
+        write(hash_directory_address, hash_directory_image());
+        for (const auto& table : tables) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(table.second.data());
+            write(table.first, std::vector<uint8_t>(bytes, bytes + table.second.size() * sizeof(uint64_t)));
+        }
+        for (const auto& chunk : chunks) {
+            write(chunk.first, chunk.second);
+        }
+    }
+    out.output("🔑 Built hash index: %lu keys, %zu subtables of %u groups, global depth %u%s\n",
+               bulk_load_keys, tables.size(), hash_groups, hash_global_depth,
+               (node_id == 0) ? "" : ", layout only");
+}
+
+AsyncOperation ComputeServer::hash_tag(const HashOpState& state, uint32_t tag) const {
+    AsyncOperation request;
+    request.type = state.op.type;
+    request.key = state.op.key;
+    request.hash_id = state.op.hash_id;
+    request.scan_seq = tag;
+    return request;
+}
+
+void ComputeServer::hash_read(HashOpState& state, uint64_t address, uint64_t size, uint32_t tag) {
+    auto req = new SST::Interfaces::StandardMem::Read(address, size);
+    track_request(req->getID(), hash_tag(state, tag));
+    get_interface_for_address(address)->send(req);
+    stat_network_reads->addData(1);
+    state.op.round_trips++;
+    state.outstanding++;
+}
+
+void ComputeServer::hash_write(HashOpState& state, uint64_t address, const std::vector<uint8_t>& data, uint32_t tag) {
+    auto req = new SST::Interfaces::StandardMem::Write(address, data.size(), data);
+    track_request(req->getID(), hash_tag(state, tag));
+    get_interface_for_address(address)->send(req);
+    stat_network_writes->addData(1);
+    state.op.round_trips++;
+    state.outstanding++;
+}
+
+void ComputeServer::hash_begin(const AsyncOperation& op) {
+    uint64_t hash_id = ++next_hash_id;
+    HashOpState& state = active_hash_ops[hash_id];
+    state.op = op;
+    state.op.hash_id = hash_id;
+    state.outstanding = 0;
+    state.kv_address = 0;
+    state.new_subtable = 0;
+    hash_lookup(state);
+}
+
+void ComputeServer::hash_lookup(HashOpState& state) {
+    uint64_t entry = hash_directory[race_hash1(state.op.key) & race_depth_mask(hash_global_depth)];
+    state.subtable = race_header_suffix(entry);
+    
+    // Operations on a subtable this server is splitting wait for the split
+    auto splitting = hash_split_waiters.find(state.subtable);
+    if (splitting != hash_split_waiters.end()) {
+        splitting->second.push_back(state.op.hash_id);
+        return;
+    }
+    
+    uint64_t choice[2];
+    race_bucket_choices(state.op.key, hash_groups, choice[0], choice[1]);
+    state.phase = HashOpState::BUCKETS;
+    for (int side = 0; side < 2; side++) {
+        state.buckets[side] = state.subtable + race_combined_offset(choice[side]);
+        hash_read(state, state.buckets[side], RACE_COMBINED_SIZE, side);
+    }
+    
+    // Inserts write their KV block out of place while the buckets are read
+    if (state.op.type == AsyncOperation::INSERT && state.kv_address == 0) {
+        state.kv_address = hash_alloc_kv(state.op.key);
+        uint64_t pair[2] = { state.op.key, state.op.value };
+        std::vector<uint8_t> data(RACE_KV_SIZE);
+        std::memcpy(data.data(), pair, sizeof(pair));
+        hash_write(state, state.kv_address, data, 2);
+    }
+}
+
+void ComputeServer::hash_response(const AsyncOperation& tag, const uint8_t* data, size_t size,
+                                  const RemoteAtomicData* atomic) {
+    auto it = active_hash_ops.find(tag.hash_id);
+    if (it == active_hash_ops.end()) {
+        return;
+    }
+    HashOpState& state = it->second;
+    state.outstanding--;
+    
+    // Short or missing payloads read as zero words
+    auto copy_words = [data, size](std::vector<uint64_t>& words, size_t count) {
+        words.assign(count, 0);
+        if (data) {
+            std::memcpy(words.data(), data, std::min(size, count * sizeof(uint64_t)));
+        }
+    };
+    uint64_t pair[2] = { 0, 0 };
+    if (data && (state.phase == HashOpState::KV || state.phase == HashOpState::SPLIT_KV)) {
+        std::memcpy(pair, data, std::min(size, sizeof(pair)));
+    }
+    
+    switch (state.phase) {
+        case HashOpState::BUCKETS:
+            if (tag.scan_seq < 2) {
+                copy_words(state.images[tag.scan_seq], RACE_COMBINED_SIZE / sizeof(uint64_t));
+            }
+            if (state.outstanding == 0) {
+                hash_buckets_arrived(state);
+            }
+            break;
+            
+        case HashOpState::KV:
+            if (pair[0] == state.op.key) {
+                state.match = tag.scan_seq;
+                if (state.op.type == AsyncOperation::SEARCH) {
+                    out.output("   ✓ FOUND key=%lu in KV block 0x%lx, value=%lu\n",
+                               state.op.key, race_slot_address(state.candidate_words[tag.scan_seq]), pair[1]);
+                }
+            } else {
+                stat_hash_fingerprint_misses->addData(1);
+            }
+            if (state.outstanding == 0) {
+                if (state.op.type == AsyncOperation::SEARCH) {
+                    if (state.match == ~0ULL) {
+                        out.output("   ✗ NOT FOUND key=%lu\n", state.op.key);
+                    }
+                    hash_finish(state);
+                } else {
+                    hash_link_slot(state);
+                }
+            }
+            break;
+            
+        case HashOpState::LINK:
+            if (atomic && atomic->success) {
+                out.output("   ✓ Linked key=%lu at KV block 0x%lx\n", state.op.key, state.kv_address);
+                hash_finish(state);
+            } else {
+                // Another writer changed the slot; read the buckets again
+                stat_hash_cas_retries->addData(1);
+                state.op.retries++;
+                hash_lookup(state);
+            }
+            break;
+            
+        case HashOpState::DIRECTORY: {
+            uint64_t depth = 0;
+            if (data && size >= sizeof(depth)) {
+                std::memcpy(&depth, data, sizeof(depth));
+            }
+            size_t entries = (data && size > RACE_DIRECTORY_HEADER) ? (size - RACE_DIRECTORY_HEADER) / sizeof(uint64_t) : 0;
+            if (depth > hash_max_depth) {
+                out.fatal(CALL_INFO, -1, "Hash directory reports global depth %lu above hash_max_depth %u\n",
+                          depth, hash_max_depth);
+            }
+            if ((1ULL << depth) > entries) {
+                // The directory grew past what was read
+                hash_read(state, hash_directory_address, RACE_DIRECTORY_HEADER + (sizeof(uint64_t) << depth), 0);
+                break;
+            }
+            hash_global_depth = depth;
+            hash_directory.resize(1ULL << depth);
+            std::memcpy(hash_directory.data(), data + RACE_DIRECTORY_HEADER, hash_directory.size() * sizeof(uint64_t));
+            hash_lookup(state);
+            break;
+        }
+            
+        case HashOpState::SPLIT_LOCK:
+            if (atomic && atomic->success) {
+                // Read the subtable and, since this server's cache may be behind, the directory
+                state.phase = HashOpState::SPLIT_READ;
+                hash_read(state, state.subtable, race_subtable_size(hash_groups), 0);
+                hash_read(state, hash_directory_address, RACE_DIRECTORY_HEADER + (sizeof(uint64_t) << hash_global_depth), 1);
+            } else {
+                // Another server is splitting it, which changes the directory
+                hash_release_split(state.subtable);
+                state.op.retries++;
+                retry_link->send(optimistic_retry_backoff, new OperationRetryEvent(hash_tag(state, 0)));
+            }
+            break;
+            
+        case HashOpState::SPLIT_READ:
+            if (tag.scan_seq == 0) {
+                copy_words(state.table, race_subtable_size(hash_groups) / sizeof(uint64_t));
+            } else {
+                std::vector<uint64_t> directory;
+                copy_words(directory, RACE_DIRECTORY_HEADER / sizeof(uint64_t) + hash_directory.size());
+                if (directory[0] == hash_global_depth) {
+                    std::copy(directory.begin() + RACE_DIRECTORY_HEADER / sizeof(uint64_t), directory.end(),
+                              hash_directory.begin());
+                } else {
+                    state.new_subtable = ~0ULL;   // Directory grew elsewhere: give up this split
+                }
+            }
+            if (state.outstanding == 0) {
+                hash_split_read_keys(state);
+            }
+            break;
+            
+        case HashOpState::SPLIT_KV:
+            state.table_keys[tag.scan_seq] = pair[0];
+            if (state.outstanding == 0) {
+                hash_split_apply(state);
+            }
+            break;
+            
+        case HashOpState::SPLIT_WRITE:
+            if (state.outstanding == 0) {
+                // The new subtable and the directory are in place, so writing the
+                // old subtable back with its new headers publishes the split and unlocks it
+                state.phase = HashOpState::SPLIT_RELEASE;
+                state.table[0] = 0;
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(state.table.data());
+                hash_write(state, state.subtable,
+                           std::vector<uint8_t>(bytes, bytes + state.table.size() * sizeof(uint64_t)), 0);
+            }
+            break;
+            
+        case HashOpState::SPLIT_RELEASE:
+            out.output("   ✓ Split subtable 0x%lx into 0x%lx (global depth %u)\n",
+                       state.subtable, state.new_subtable, hash_global_depth);
+            stat_hash_resizes->addData(1);
+            hash_release_split(state.subtable);
+            hash_release_split(state.new_subtable);
+            state.new_subtable = 0;
+            hash_lookup(state);
+            break;
+    }
+}
+
+void ComputeServer::hash_buckets_arrived(HashOpState& state) {
+    // A header naming another suffix means the subtable split since this
+    // server cached its directory entry
+    uint64_t h1 = race_hash1(state.op.key);
+    for (int side = 0; side < 2; side++) {
+        uint64_t header = state.images[side][0];
+        if ((h1 & race_depth_mask(race_header_depth(header))) != race_header_suffix(header)) {
+            hash_refresh_directory(state);
+            return;
+        }
+    }
+    
+    // Matching fingerprints is local work; it keeps a core busy without holding the reply back
+    charge_cpu(cpu_cycles_per_key * 4 * RACE_SLOTS_PER_BUCKET);
+    uint8_t fingerprint = race_fingerprint(state.op.key);
+    const size_t bucket_words = RACE_BUCKET_SIZE / sizeof(uint64_t);
+    state.candidates.clear();
+    state.candidate_words.clear();
+    state.match = ~0ULL;
+    for (int side = 0; side < 2; side++) {
+        for (size_t w = 0; w < RACE_COMBINED_SIZE / sizeof(uint64_t); w++) {
+            uint64_t word = state.images[side][w];
+            uint64_t slot = state.buckets[side] + w * sizeof(uint64_t);
+            // The two combined buckets may share their overflow bucket
+            if (w % bucket_words == 0 || word == 0 || race_slot_fingerprint(word) != fingerprint ||
+                std::find(state.candidates.begin(), state.candidates.end(), slot) != state.candidates.end()) {
+                continue;
+            }
+            state.candidates.push_back(slot);
+            state.candidate_words.push_back(word);
+        }
+    }
+    
+    if (state.candidates.empty()) {
+        if (state.op.type == AsyncOperation::SEARCH) {
+            out.output("   ✗ NOT FOUND key=%lu\n", state.op.key);
+            hash_finish(state);
+        } else {
+            hash_link_slot(state);
+        }
+        return;
+    }
+    
+    state.phase = HashOpState::KV;
+    for (size_t i = 0; i < state.candidates.size(); i++) {
+        hash_read(state, race_slot_address(state.candidate_words[i]), RACE_KV_SIZE, i);
+        stat_hash_kv_reads->addData(1);
+    }
+}
+
+void ComputeServer::hash_link_slot(HashOpState& state) {
+    // An existing key is relinked to the new block; otherwise take a free slot
+    uint64_t slot;
+    uint64_t expected;
+    if (state.match != ~0ULL) {
+        slot = state.candidates[state.match];
+        expected = state.candidate_words[state.match];
+    } else {
+        const uint64_t* images[2] = { state.images[0].data(), state.images[1].data() };
+        slot = hash_pick_slot(images, state.buckets);
+        expected = 0;
+        if (slot == 0) {
+            hash_split_begin(state);
+            return;
+        }
+    }
+    
+    state.phase = HashOpState::LINK;
+    AsyncOperation request = hash_tag(state, 0);
+    send_remote_atomic(RemoteAtomicData::ATOMIC_CAS, slot,
+                       race_slot_word(race_fingerprint(state.op.key), state.kv_address), expected, &request);
+    state.op.round_trips++;
+    state.outstanding++;
+}
+
+void ComputeServer::hash_refresh_directory(HashOpState& state) {
+    stat_hash_directory_refreshes->addData(1);
+    state.phase = HashOpState::DIRECTORY;
+    hash_read(state, hash_directory_address, RACE_DIRECTORY_HEADER + (sizeof(uint64_t) << hash_global_depth), 0);
+}
+
+void ComputeServer::hash_split_begin(HashOpState& state) {
+    // Only one local operation splits a subtable; the others wait for it
+    auto splitting = hash_split_waiters.find(state.subtable);
+    if (splitting != hash_split_waiters.end()) {
+        splitting->second.push_back(state.op.hash_id);
+        return;
+    }
+    hash_split_waiters[state.subtable];
+    
+    out.output("   ⚠️  Hash buckets FULL for key=%lu - splitting subtable 0x%lx\n", state.op.key, state.subtable);
+    state.phase = HashOpState::SPLIT_LOCK;
+    state.new_subtable = 0;
+    AsyncOperation request = hash_tag(state, 0);
+    send_remote_atomic(RemoteAtomicData::ATOMIC_CAS, state.subtable, node_id + 1, 0, &request);
+    state.op.round_trips++;
+    state.outstanding++;
+}
+
+void ComputeServer::hash_split_read_keys(HashOpState& state) {
+    // The split is abandoned if the directory grew elsewhere or the subtable
+    // was split between reading its buckets and locking it
+    uint64_t entry = hash_directory[race_hash1(state.op.key) & race_depth_mask(hash_global_depth)];
+    uint64_t header = state.table[RACE_SUBTABLE_HEADER / sizeof(uint64_t)];
+    if (state.new_subtable == ~0ULL || race_header_suffix(entry) != state.subtable ||
+        race_header_depth(header) != race_header_depth(entry)) {
+        std::vector<uint8_t> unlocked(sizeof(uint64_t), 0);
+        get_interface_for_address(state.subtable)->send(
+            new SST::Interfaces::StandardMem::Write(state.subtable, unlocked.size(), unlocked));
+        stat_network_writes->addData(1);
+        hash_release_split(state.subtable);
+        state.new_subtable = 0;
+        hash_refresh_directory(state);
+        return;
+    }
+    
+    // Slots only carry fingerprints, so the keys are read back to rehash
+    // them, in one doorbell batch of KV reads per memory server
+    state.phase = HashOpState::SPLIT_KV;
+    state.table_keys.assign(state.table.size(), 0);
+    std::map<uint32_t, std::pair<BatchReadData*, std::vector<AsyncOperation>>> batches;
+    for (size_t w = RACE_SUBTABLE_HEADER / sizeof(uint64_t); w < state.table.size(); w++) {
+        if ((w * sizeof(uint64_t) - RACE_SUBTABLE_HEADER) % RACE_BUCKET_SIZE == 0 || state.table[w] == 0) {
+            continue;
+        }
+        uint64_t kv = race_slot_address(state.table[w]);
+        auto& batch = batches[get_server_for_address(kv)];
+        if (!batch.first) {
+            batch.first = new BatchReadData(RACE_KV_SIZE);
+        }
+        batch.first->addRead(kv);
+        batch.second.push_back(hash_tag(state, w));
+    }
+    for (auto& batch : batches) {
+        auto req = new SST::Interfaces::StandardMem::CustomReq(batch.second.first);
+        size_t reads = batch.second.second.size();
+        stat_read_batches->addData(1);
+        stat_read_batch_occupancy->addData(reads);
+        stat_network_reads->addData(reads);
+        state.op.round_trips++;
+        state.outstanding += reads;
+        pending_batches[req->getID()].swap(batch.second.second);
+        get_interface_for_address(batch.second.first->getRoutingAddress())->send(req);
+    }
+    if (state.outstanding == 0) {
+        hash_split_apply(state);
+    }
+}
+
+void ComputeServer::hash_split_apply(HashOpState& state) {
+    uint64_t header = state.table[RACE_SUBTABLE_HEADER / sizeof(uint64_t)];
+    uint32_t depth = race_header_depth(header);
+    uint64_t suffix = race_header_suffix(header);
+    if (depth >= hash_max_depth) {
+        out.fatal(CALL_INFO, -1, "Hash subtable 0x%lx full at depth %u; raise hash_max_depth or hash_subtable_groups\n",
+                  state.subtable, depth);
+    }
+    
+    state.new_subtable = hash_alloc_subtable();
+    std::vector<uint64_t> new_words;
+    hash_split_table(state.table, new_words, state.table_keys, depth, suffix);
+    bool doubling = (depth == hash_global_depth);
+    hash_directory_split(suffix, depth, state.subtable, state.new_subtable);
+    charge_cpu(cpu_cycles_per_split + cpu_cycles_per_byte * 2 * race_subtable_size(hash_groups));
+    
+    // Keys mapping to the new subtable wait too until it is written
+    hash_split_waiters[state.new_subtable];
+    
+    // The new subtable and the directory land before the old subtable is
+    // rewritten and unlocked. A doubled directory is written whole; otherwise
+    // only the entries of the split subtable change.
+    state.phase = HashOpState::SPLIT_WRITE;
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(new_words.data());
+    hash_write(state, state.new_subtable, std::vector<uint8_t>(bytes, bytes + new_words.size() * sizeof(uint64_t)), 0);
+    if (doubling) {
+        hash_write(state, hash_directory_address, hash_directory_image(), 1);
+    } else {
+        for (uint64_t i = suffix; i < hash_directory.size(); i += 1ULL << depth) {
+            std::vector<uint8_t> entry(sizeof(uint64_t));
+            std::memcpy(entry.data(), &hash_directory[i], sizeof(uint64_t));
+            hash_write(state, hash_directory_address + RACE_DIRECTORY_HEADER + i * sizeof(uint64_t), entry, 1);
+        }
+    }
+}
+
+void ComputeServer::hash_release_split(uint64_t subtable) {
+    auto it = hash_split_waiters.find(subtable);
+    if (it == hash_split_waiters.end()) {
+        return;
+    }
+    std::vector<uint64_t> waiting;
+    waiting.swap(it->second);
+    hash_split_waiters.erase(it);
+    for (uint64_t hash_id : waiting) {
+        auto op = active_hash_ops.find(hash_id);
+        if (op != active_hash_ops.end()) {
+            hash_lookup(op->second);
+        }
+    }
+}
+
+void ComputeServer::hash_finish(HashOpState& state) {
+    if (state.op.type == AsyncOperation::INSERT) {
+        stat_inserts->addData(1);
+    } else {
+        stat_searches->addData(1);
+    }
+    // Log appends are tracked with the op, so it leaves the engine first
+    uint64_t hash_id = state.op.hash_id;
+    AsyncOperation done = state.op;
+    done.hash_id = 0;
+    active_hash_ops.erase(hash_id);
+    complete_operation(done);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LEARNED INDEX ENGINE - model-predicted leaf windows with per-leaf deltas
+// ═══════════════════════════════════════════════════════════════════════════
+
+void ComputeServer::learned_train() {
+    learned_model.train(learned_first_keys, learned_error_bound);
+    learned_drift = 0;
+    out.output("   Learned index trained: %zu leaves, %zu segments (error bound %u)\n",
+               learned_first_keys.size(), learned_model.num_segments(), learned_error_bound);
+}
+
+void ComputeServer::learned_lookup_async(const AsyncOperation& op) {
+    uint64_t lo, hi;
+    learned_model.predict(op.key, lo, hi);
+    // Leaves added since training can only move a key's leaf to the right
+    hi = std::min<uint64_t>(hi + learned_drift, learned_leaves.size() - 1);
+    lo = std::min(lo, hi);
+    uint64_t count = hi - lo + 1;
+    
+    uint64_t lookup_id = ++next_lookup_id;
+    LearnedLookup& lookup = active_lookups[lookup_id];
+    lookup.op = op;
+    lookup.leaves.assign(learned_leaves.begin() + lo, learned_leaves.begin() + hi + 1);
+    lookup.versions.resize(count);
+    lookup.images.assign(2 * count, empty_node);
+    lookup.outstanding = 0;
+    stat_learned_leaves_read->addData(count);
+    
+    dbg.debug(CALL_INFO, 3, 0, "Learned lookup %lu for key %lu reads leaves %lu-%lu\n", lookup_id, op.key, lo, hi);
+    
+    // The whole window, deltas included, is read in one round
+    AsyncOperation read = op;
+    read.lookup_id = lookup_id;
+    read.current_level = tree_height - 1;
+    read.round_trips = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        const LearnedLeaf& state = learned_leaf_state[lookup.leaves[i]];
+        lookup.versions[i] = state.version;
+        read.scan_seq = 2 * i;
+        read.current_address = lookup.leaves[i];
+        issue_node_read(read);
+        lookup.outstanding++;
+        if (state.delta != 0) {
+            read.scan_seq = 2 * i + 1;
+            read.current_address = state.delta;
+            issue_node_read(read);
+            lookup.outstanding++;
+        }
+    }
+}
+
+void ComputeServer::learned_read_arrived(const AsyncOperation& op, const BTreeNodeView& node) {
+    auto it = active_lookups.find(op.lookup_id);
+    if (it == active_lookups.end()) {
+        return;
+    }
+    LearnedLookup& lookup = it->second;
+    lookup.op.round_trips += op.round_trips;
+    lookup.images[op.scan_seq] = BTreeNode(node);
+    if (--lookup.outstanding > 0) {
+        return;
+    }
+    
+    if (lookup.op.type == AsyncOperation::INSERT) {
+        learned_resolve_insert(lookup);
+    } else {
+        out.output("   Executing learned SEARCH over %zu leaves: key=%lu\n", lookup.leaves.size(), op.key);
+        stat_searches->addData(1);
+        
+        // The key may be in any leaf of the window or in its delta node
+        bool found = false;
+        for (const BTreeNode& image : lookup.images) {
+            const uint64_t* end = image.keys() + std::min(image.num_keys(), btree_fanout);
+            const uint64_t* pos = std::lower_bound(image.keys(), end, op.key);
+            if (pos != end && *pos == op.key) {
+                out.output("   ✓ FOUND key=%lu in node 0x%lx, value=%lu\n",
+                           op.key, image.node_address(), image.values()[pos - image.keys()]);
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            out.output("   ✗ NOT FOUND key=%lu\n", op.key);
+        }
+        complete_operation(lookup.op);
+    }
+    // A restarted insert has already moved to a new lookup
+    active_lookups.erase(op.lookup_id);
+}
+
+void ComputeServer::learned_resolve_insert(LearnedLookup& lookup) {
+    AsyncOperation& op = lookup.op;
+    
+    // The key belongs to the last leaf whose first key is not above it
+    auto upper = std::upper_bound(learned_first_keys.begin(), learned_first_keys.end(), op.key);
+    uint64_t pos = (upper == learned_first_keys.begin()) ? 0 : (upper - learned_first_keys.begin()) - 1;
+    uint64_t address = learned_leaves[pos];
+    auto slot = std::find(lookup.leaves.begin(), lookup.leaves.end(), address);
+    LearnedLeaf& state = learned_leaf_state[address];
+    
+    // A local write to the leaf since it was read, or one still in flight,
+    // makes this copy stale; read the window again
+    if (slot == lookup.leaves.end() || state.writes_pending > 0 ||
+        state.version != lookup.versions[slot - lookup.leaves.begin()]) {
+        stat_learned_restarts->addData(1);
+        op.retries++;
+        learned_lookup_async(op);
+        return;
+    }
+    
+    out.output("   Executing learned INSERT in leaf 0x%lx: key=%lu, value=%lu\n", address, op.key, op.value);
+    stat_inserts->addData(1);
+    size_t i = slot - lookup.leaves.begin();
+    BTreeNode& leaf = lookup.images[2 * i];
+    BTreeNode& delta = lookup.images[2 * i + 1];
+    
+    // A key already in the leaf is updated there; otherwise the leaf takes
+    // it while it has room and the delta node once it is full
+    uint64_t* leaf_end = leaf.keys() + leaf.num_keys();
+    uint64_t* existing = std::lower_bound(leaf.keys(), leaf_end, op.key);
+    if (existing != leaf_end && *existing == op.key) {
+        leaf.values()[existing - leaf.keys()] = op.value;
+        learned_write(leaf, address);
+        op.round_trips++;
+    } else if (insert_into_leaf(leaf, op.key, op.value)) {
+        learned_first_keys[pos] = std::min(learned_first_keys[pos], op.key);
+        learned_write(leaf, address);
+        op.round_trips++;
+    } else if (state.delta == 0) {
+        // First overflow of this leaf: its delta node is placed with it
+        BTreeNode fresh(btree_fanout);
+        fresh.node_address() = allocate_node_address(next_node_id++, 0, op.key, address);
+        insert_into_leaf(fresh, op.key, op.value);
+        state.delta = fresh.node_address();
+        learned_write(fresh, address);
+        op.round_trips++;
+        stat_learned_delta_inserts->addData(1);
+    } else if (insert_into_leaf(delta, op.key, op.value)) {
+        learned_write(delta, address);
+        op.round_trips++;
+        stat_learned_delta_inserts->addData(1);
+    } else {
+        learned_merge(op, pos, leaf, delta);
+    }
+    complete_operation(op);
+}
+
+void ComputeServer::learned_merge(AsyncOperation& op, uint64_t pos, const BTreeNode& leaf, const BTreeNode& delta) {
+    // The leaf, its delta and the new key are spread over the leaf, the
+    // delta node (now a leaf of its own) and a newly placed node, so each
+    // is left about two-thirds full
+    std::map<uint64_t, uint64_t> entries;
+    for (uint32_t i = 0; i < leaf.num_keys(); i++) {
+        entries[leaf.keys()[i]] = leaf.values()[i];
+    }
+    for (uint32_t i = 0; i < delta.num_keys(); i++) {
+        entries[delta.keys()[i]] = delta.values()[i];
+    }
+    entries[op.key] = op.value;
+    
+    uint64_t pieces = std::min<uint64_t>(3, entries.size());
+    uint64_t per_piece = (entries.size() + pieces - 1) / pieces;
+    std::vector<uint64_t> addresses = { leaf.node_address(), delta.node_address() };
+    if (pieces == 3) {
+        addresses.push_back(allocate_node_address(next_node_id++, 0, op.key, leaf.node_address()));
+    }
+    out.output("   🔀 Merging delta 0x%lx into leaf 0x%lx: %zu keys over %lu leaves\n",
+               delta.node_address(), leaf.node_address(), entries.size(), pieces);
+    
+    learned_leaf_state[leaf.node_address()].delta = 0;
+    auto entry = entries.begin();
+    for (uint64_t piece = 0; piece < pieces; piece++) {
+        BTreeNode node(btree_fanout);
+        node.node_address() = addresses[piece];
+        for (uint64_t k = 0; k < per_piece && entry != entries.end(); k++, ++entry) {
+            node.keys()[k] = entry->first;
+            node.values()[k] = entry->second;
+            node.num_keys()++;
+        }
+        node.next_leaf() = (piece + 1 < pieces) ? addresses[piece + 1] : leaf.next_leaf();
+        learned_write(node, node.node_address());
+        op.round_trips++;
+        
+        if (piece == 0) {
+            learned_first_keys[pos] = node.keys()[0];
+        } else {
+            learned_leaves.insert(learned_leaves.begin() + pos + piece, node.node_address());
+            learned_first_keys.insert(learned_first_keys.begin() + pos + piece, node.keys()[0]);
+        }
+    }
+    stat_learned_merges->addData(1);
+    
+    // Retraining is local work over the whole leaf table
+    learned_drift += pieces - 1;
+    if (learned_drift >= learned_retrain_interval) {
+        charge_cpu(cpu_cycles_per_key * learned_first_keys.size());
+        learned_train();
+        stat_learned_model_segments->addData(learned_model.num_segments());
+        stat_learned_retrains->addData(1);
+    }
+}
+
+void ComputeServer::learned_write(const BTreeNode& node, uint64_t leaf_address) {
+    // Tracked so inserts can tell whether their copy of the leaf is current
+    auto data = serialize_node(node);
+    auto req = new SST::Interfaces::StandardMem::Write(node.node_address(), data.size(), data);
+    learned_writes[req->getID()] = leaf_address;
+    learned_leaf_state[leaf_address].writes_pending++;
+    
+    get_interface_for_address(node.node_address())->send(req);
+    stat_network_writes->addData(1);
+    out.output("   ✍️  Wrote node back to address 0x%lx\n", node.node_address());
+}
+
+bool ComputeServer::handle_learned_write_response(SST::Interfaces::StandardMem::Request::id_t req_id) {
+    auto it = learned_writes.find(req_id);
+    if (it == learned_writes.end()) {
+        return false;
+    }
+    LearnedLeaf& state = learned_leaf_state[it->second];
+    state.writes_pending--;
+    state.version++;
+    learned_writes.erase(it);
+    return true;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // ASYNC SPLIT OPERATIONS
 // ═══════════════════════════════════════════════════════════════════════════
 
 void ComputeServer::split_leaf_async(AsyncOperation& op, BTreeNode& old_leaf, uint64_t new_key, uint64_t new_value) {
     out.output("\n🔀 ASYNC LEAF SPLIT: old_leaf=0x%lx, keys=%u/%u\n",
-               old_leaf.node_address, old_leaf.num_keys, btree_fanout);
+               old_leaf.node_address(), old_leaf.num_keys(), btree_fanout);
+    
+    // Like serialisation, split work delays later node processing rather than this write
+    charge_cpu(cpu_cycles_per_split);
     
-    // Step 1: Create new leaf node
+    // Step 1: Create new leaf node (placed once its keys are known)
     // If splitting root, leaves will be at the NEW tree_height after split
-    uint32_t leaf_level = op.is_root_split ? tree_height : (tree_height - 1);
-    uint64_t new_node_id = next_node_id++;
-    uint64_t new_leaf_address = allocate_node_address(new_node_id, leaf_level);
+    bool splitting_root = (old_leaf.node_address() == root_address);
+    uint32_t leaf_level = splitting_root ? tree_height : (tree_height - 1);
+    uint64_t parent_address = splitting_root ? 0 : parent_in_path(op, old_leaf.node_address());
     
     BTreeNode new_leaf(btree_fanout);
-    new_leaf.node_address = new_leaf_address;
-    new_leaf.is_leaf = true;
-    new_leaf.num_keys = 0;
+    new_leaf.is_leaf() = true;
+    new_leaf.num_keys() = 0;
     
     // Step 2: Determine split point
     uint32_t split_point = btree_fanout / 2;
@@ -898,14 +3453,14 @@ void ComputeServer::split_leaf_async(AsyncOperation& op, BTreeNode& old_leaf, ui
     
     // Find insertion position for new key
     uint32_t insert_pos = 0;
-    while (insert_pos < old_leaf.num_keys && old_leaf.keys[insert_pos] < new_key) {
+    while (insert_pos < old_leaf.num_keys() && old_leaf.keys()[insert_pos] < new_key) {
         insert_pos++;
     }
     
     // Copy keys before insert position
     for (uint32_t i = 0; i < insert_pos; i++) {
-        all_keys[i] = old_leaf.keys[i];
-        all_values[i] = old_leaf.values[i];
+        all_keys[i] = old_leaf.keys()[i];
+        all_values[i] = old_leaf.values()[i];
     }
     
     // Insert new key
@@ -913,91 +3468,99 @@ void ComputeServer::split_leaf_async(AsyncOperation& op, BTreeNode& old_leaf, ui
     all_values[insert_pos] = new_value;
     
     // Copy keys after insert position
-    for (uint32_t i = insert_pos; i < old_leaf.num_keys; i++) {
-        all_keys[i + 1] = old_leaf.keys[i];
-        all_values[i + 1] = old_leaf.values[i];
+    for (uint32_t i = insert_pos; i < old_leaf.num_keys(); i++) {
+        all_keys[i + 1] = old_leaf.keys()[i];
+        all_values[i + 1] = old_leaf.values()[i];
     }
     
     // Step 4: Split keys between old and new leaf
-    old_leaf.num_keys = split_point;
+    old_leaf.num_keys() = split_point;
     for (uint32_t i = 0; i < split_point; i++) {
-        old_leaf.keys[i] = all_keys[i];
-        old_leaf.values[i] = all_values[i];
+        old_leaf.keys()[i] = all_keys[i];
+        old_leaf.values()[i] = all_values[i];
     }
     
-    new_leaf.num_keys = (btree_fanout + 1) - split_point;
-    for (uint32_t i = 0; i < new_leaf.num_keys; i++) {
-        new_leaf.keys[i] = all_keys[split_point + i];
-        new_leaf.values[i] = all_values[split_point + i];
+    new_leaf.num_keys() = (btree_fanout + 1) - split_point;
+    for (uint32_t i = 0; i < new_leaf.num_keys(); i++) {
+        new_leaf.keys()[i] = all_keys[split_point + i];
+        new_leaf.values()[i] = all_values[split_point + i];
     }
+    new_leaf.node_address() = allocate_node_address(next_node_id++, leaf_level, new_leaf.keys()[0], parent_address);
+    
+    // Link the new leaf between the old one and its right sibling
+    new_leaf.next_leaf() = old_leaf.next_leaf();
+    old_leaf.next_leaf() = new_leaf.node_address();
     
     out.output("   Split complete:\n");
     out.output("     Old leaf (0x%lx): %u keys [%lu..%lu]\n",
-               old_leaf.node_address, old_leaf.num_keys,
-               old_leaf.keys[0], old_leaf.keys[old_leaf.num_keys - 1]);
+               old_leaf.node_address(), old_leaf.num_keys(),
+               old_leaf.keys()[0], old_leaf.keys()[old_leaf.num_keys() - 1]);
     out.output("     New leaf (0x%lx): %u keys [%lu..%lu]\n",
-               new_leaf.node_address, new_leaf.num_keys,
-               new_leaf.keys[0], new_leaf.keys[new_leaf.num_keys - 1]);
+               new_leaf.node_address(), new_leaf.num_keys(),
+               new_leaf.keys()[0], new_leaf.keys()[new_leaf.num_keys() - 1]);
     
     // Step 5: Save split state in operation
     op.type = AsyncOperation::SPLIT_LEAF;
     op.split_phase = AsyncOperation::WRITE_OLD_NODE;
-    op.separator_key = new_leaf.keys[0];  // First key of new leaf
+    op.separator_key = new_leaf.keys()[0];  // First key of new leaf
     
     // Check if splitting root
-    if (old_leaf.node_address == root_address) {
+    if (splitting_root) {
         op.is_root_split = true;
         out.output("   ⚠️  Splitting ROOT node - will create new root\n");
         
         // When splitting root, allocate NEW address for old leaf (root address will be reused for new root)
-        uint64_t old_leaf_new_id = next_node_id++;
-        uint64_t old_leaf_new_address = allocate_node_address(old_leaf_new_id, leaf_level);
-        old_leaf.node_address = old_leaf_new_address;  // Update old leaf to use new address
+        uint64_t old_leaf_new_address = allocate_node_address(next_node_id++, leaf_level, old_leaf.keys()[0], 0);
+        old_leaf.node_address() = old_leaf_new_address;  // Update old leaf to use new address
         out.output("   → Moving old root to new address 0x%lx\n", old_leaf_new_address);
     } else {
         op.is_root_split = false;
-        // Parent is the second-to-last node in the traversal path
-        if (op.path.size() >= 2) {
-            BTreeNode parent = op.path[op.path.size() - 2];
-            op.parent_address = parent.node_address;
+        // Parent is the node visited before this leaf in the traversal path
+        op.parent_address = parent_address;
+        if (parent_address != 0) {
             out.output("   Parent address: 0x%lx (from traversal path)\n", op.parent_address);
         } else {
-            out.output("   ERROR: Path too short (%zu nodes), cannot find parent\n", op.path.size());
-            op.parent_address = 0;
+            out.output("   ERROR: Leaf 0x%lx not below a node in the traversal path (%zu nodes), cannot find parent\n",
+                       old_leaf.node_address(), op.path.size());
         }
     }
     
     // Save nodes to operation AFTER potentially updating old_leaf address
-    op.old_node = old_leaf;
-    op.new_node = new_leaf;
+    op.old_node_address = old_leaf.node_address();
+    op.new_node_address = new_leaf.node_address();
+    op.new_node_image = serialize_node(new_leaf);
     
     // Step 6: Start async write sequence - write old node first
     auto req = new SST::Interfaces::StandardMem::Write(
-        old_leaf.node_address, get_serialized_node_size(), serialize_node(old_leaf));
+        old_leaf.node_address(), get_serialized_node_size(), serialize_node(old_leaf));
     auto req_id = req->getID();
     
     // Transfer operation state to this request
-    pending_ops[req_id] = op;
+    track_request(req_id, op);
     
-    SST::Interfaces::StandardMem* target_interface = get_interface_for_address(old_leaf.node_address);
+    SST::Interfaces::StandardMem* target_interface = get_interface_for_address(old_leaf.node_address());
     target_interface->send(req);
     stat_network_writes->addData(1);
     
-    out.output("   → Phase 1: Writing old node 0x%lx\n", old_leaf.node_address);
+    out.output("   → Phase 1: Writing old node 0x%lx\n", old_leaf.node_address());
 }
 
 void ComputeServer::split_internal_async(AsyncOperation& op, BTreeNode& old_internal, uint64_t new_key, uint64_t new_child) {
     out.output("\n🔀 ASYNC INTERNAL SPLIT: old_internal=0x%lx, keys=%u/%u, level=%u\n",
-               old_internal.node_address, old_internal.num_keys, btree_fanout, op.current_level);
+               old_internal.node_address(), old_internal.num_keys(), btree_fanout, op.current_level);
+    
+    charge_cpu(cpu_cycles_per_split);
     
-    // Create new internal node
-    uint64_t new_node_id = next_node_id++;
-    uint64_t new_internal_address = allocate_node_address(new_node_id, op.current_level);
+    // Cached copy no longer reflects this node's separators
+    index_cache_invalidate(old_internal.node_address());
+    
+    // Create new internal node (placed once its keys are known)
+    bool splitting_root = (old_internal.node_address() == root_address);
+    uint64_t parent_address = splitting_root ? 0 : parent_in_path(op, old_internal.node_address());
     
     BTreeNode new_internal(btree_fanout);
-    new_internal.node_address = new_internal_address;
-    new_internal.is_leaf = false;
-    new_internal.num_keys = 0;
+    new_internal.is_leaf() = false;
+    new_internal.num_keys() = 0;
     
     // Determine split point
     uint32_t split_point = btree_fanout / 2;
@@ -1008,49 +3571,50 @@ void ComputeServer::split_internal_async(AsyncOperation& op, BTreeNode& old_inte
     
     // Find insertion position
     uint32_t insert_pos = 0;
-    while (insert_pos < old_internal.num_keys && old_internal.keys[insert_pos] < new_key) {
+    while (insert_pos < old_internal.num_keys() && old_internal.keys()[insert_pos] < new_key) {
         insert_pos++;
     }
     
     // Copy keys and children before insert position
     for (uint32_t i = 0; i < insert_pos; i++) {
-        all_keys[i] = old_internal.keys[i];
-        all_children[i] = old_internal.children[i];
+        all_keys[i] = old_internal.keys()[i];
+        all_children[i] = old_internal.children()[i];
     }
-    all_children[insert_pos] = old_internal.children[insert_pos];
+    all_children[insert_pos] = old_internal.children()[insert_pos];
     
     // Insert new key and child
     all_keys[insert_pos] = new_key;
     all_children[insert_pos + 1] = new_child;
     
     // Copy keys and children after insert position
-    for (uint32_t i = insert_pos; i < old_internal.num_keys; i++) {
-        all_keys[i + 1] = old_internal.keys[i];
-        all_children[i + 2] = old_internal.children[i + 1];
+    for (uint32_t i = insert_pos; i < old_internal.num_keys(); i++) {
+        all_keys[i + 1] = old_internal.keys()[i];
+        all_children[i + 2] = old_internal.children()[i + 1];
     }
     
     // Split: middle key gets promoted to parent
     uint64_t promoted_key = all_keys[split_point];
     
-    old_internal.num_keys = split_point;
+    old_internal.num_keys() = split_point;
     for (uint32_t i = 0; i < split_point; i++) {
-        old_internal.keys[i] = all_keys[i];
-        old_internal.children[i] = all_children[i];
+        old_internal.keys()[i] = all_keys[i];
+        old_internal.children()[i] = all_children[i];
     }
-    old_internal.children[split_point] = all_children[split_point];
+    old_internal.children()[split_point] = all_children[split_point];
     
-    new_internal.num_keys = btree_fanout - split_point;
-    for (uint32_t i = 0; i < new_internal.num_keys; i++) {
-        new_internal.keys[i] = all_keys[split_point + 1 + i];
-        new_internal.children[i] = all_children[split_point + 1 + i];
+    new_internal.num_keys() = btree_fanout - split_point;
+    for (uint32_t i = 0; i < new_internal.num_keys(); i++) {
+        new_internal.keys()[i] = all_keys[split_point + 1 + i];
+        new_internal.children()[i] = all_children[split_point + 1 + i];
     }
-    new_internal.children[new_internal.num_keys] = all_children[btree_fanout + 1];
+    new_internal.children()[new_internal.num_keys()] = all_children[btree_fanout + 1];
+    new_internal.node_address() = allocate_node_address(next_node_id++, op.current_level, promoted_key, parent_address);
     
     out.output("   Split complete (promoted key=%lu):\n", promoted_key);
     out.output("     Old internal (0x%lx): %u keys\n",
-               old_internal.node_address, old_internal.num_keys);
+               old_internal.node_address(), old_internal.num_keys());
     out.output("     New internal (0x%lx): %u keys\n",
-               new_internal.node_address, new_internal.num_keys);
+               new_internal.node_address(), new_internal.num_keys());
     
     // Save split state
     op.type = AsyncOperation::SPLIT_INTERNAL;
@@ -1058,61 +3622,61 @@ void ComputeServer::split_internal_async(AsyncOperation& op, BTreeNode& old_inte
     op.separator_key = promoted_key;
     
     // Check if splitting root
-    if (old_internal.node_address == root_address) {
+    if (splitting_root) {
         op.is_root_split = true;
         out.output("   ⚠️  Splitting ROOT node - will create new root\n");
         
         // When splitting root, allocate NEW address for old internal (root address will be reused for new root)
-        uint64_t old_internal_new_id = next_node_id++;
-        uint64_t old_internal_new_address = allocate_node_address(old_internal_new_id, op.current_level);
-        old_internal.node_address = old_internal_new_address;  // Update old internal to use new address
+        uint64_t old_internal_new_address = allocate_node_address(next_node_id++, op.current_level,
+                                                                  old_internal.keys()[0], 0);
+        old_internal.node_address() = old_internal_new_address;  // Update old internal to use new address
         out.output("   → Moving old root to new address 0x%lx\n", old_internal_new_address);
     } else {
         op.is_root_split = false;
-        // Parent is the second-to-last node in the traversal path
-        if (op.path.size() >= 2) {
-            BTreeNode parent = op.path[op.path.size() - 2];
-            op.parent_address = parent.node_address;
+        // Parent is the node visited before this one in the traversal path
+        op.parent_address = parent_address;
+        if (parent_address != 0) {
             out.output("   Parent address: 0x%lx (from traversal path)\n", op.parent_address);
         } else {
-            out.output("   ERROR: Path too short (%zu nodes), cannot find parent\n", op.path.size());
-            op.parent_address = 0;
+            out.output("   Node 0x%lx not found in traversal path - parent will be searched from the root\n",
+                       old_internal.node_address());
         }
     }
     
     // Save nodes to operation AFTER potentially updating old_internal address
-    op.old_node = old_internal;
-    op.new_node = new_internal;
+    op.old_node_address = old_internal.node_address();
+    op.new_node_address = new_internal.node_address();
+    op.new_node_image = serialize_node(new_internal);
     
     // Start async write sequence
     auto req = new SST::Interfaces::StandardMem::Write(
-        old_internal.node_address, get_serialized_node_size(), serialize_node(old_internal));
+        old_internal.node_address(), get_serialized_node_size(), serialize_node(old_internal));
     auto req_id = req->getID();
     
-    pending_ops[req_id] = op;
+    track_request(req_id, op);
     
-    SST::Interfaces::StandardMem* target_interface = get_interface_for_address(old_internal.node_address);
+    SST::Interfaces::StandardMem* target_interface = get_interface_for_address(old_internal.node_address());
     target_interface->send(req);
     stat_network_writes->addData(1);
     
-    out.output("   → Phase 1: Writing old node 0x%lx\n", old_internal.node_address);
+    out.output("   → Phase 1: Writing old node 0x%lx\n", old_internal.node_address());
 }
 
 void ComputeServer::handle_split_response(AsyncOperation& op) {
     switch (op.split_phase) {
         case AsyncOperation::WRITE_OLD_NODE:
             out.output("   ✓ Phase 1 complete: Old node written\n");
-            out.output("   → Phase 2: Writing new node 0x%lx\n", op.new_node.node_address);
+            out.output("   → Phase 2: Writing new node 0x%lx\n", op.new_node_address);
             
             // Write new node
             op.split_phase = AsyncOperation::WRITE_NEW_NODE;
             {
                 auto req = new SST::Interfaces::StandardMem::Write(
-                    op.new_node.node_address, get_serialized_node_size(), serialize_node(op.new_node));
+                    op.new_node_address, get_serialized_node_size(), op.new_node_image);
                 auto req_id = req->getID();
-                pending_ops[req_id] = op;
+                track_request(req_id, op);
                 
-                SST::Interfaces::StandardMem* target_interface = get_interface_for_address(op.new_node.node_address);
+                SST::Interfaces::StandardMem* target_interface = get_interface_for_address(op.new_node_address);
                 target_interface->send(req);
                 stat_network_writes->addData(1);
             }
@@ -1127,19 +3691,22 @@ void ComputeServer::handle_split_response(AsyncOperation& op) {
                            tree_height, tree_height + 1);
                 
                 // Create new root
-                uint64_t new_root_id = next_node_id++;
-                uint64_t new_root_addr = allocate_node_address(new_root_id, 0);
+                uint64_t new_root_addr = allocate_node_address(next_node_id++, 0, 0, 0);
                 
                 BTreeNode new_root(btree_fanout);
-                new_root.node_address = new_root_addr;
-                new_root.is_leaf = false;
-                new_root.num_keys = 1;
-                new_root.keys[0] = op.separator_key;
-                new_root.children[0] = op.old_node.node_address;
-                new_root.children[1] = op.new_node.node_address;
+                new_root.node_address() = new_root_addr;
+                new_root.is_leaf() = false;
+                new_root.num_keys() = 1;
+                new_root.keys()[0] = op.separator_key;
+                new_root.children()[0] = op.old_node_address;
+                new_root.children()[1] = op.new_node_address;
+                if (optimistic_cc) {
+                    // Newer than any copy of a node previously stored at this address
+                    new_root.version_lock() = btree_next_version_word(op.lock_word);
+                }
                 
                 out.output("   DEBUG: New root children: [0]=0x%lx, [1]=0x%lx\n",
-                           new_root.children[0], new_root.children[1]);
+                           new_root.children()[0], new_root.children()[1]);
                 
                 // Write new root
                 auto req = new SST::Interfaces::StandardMem::Write(
@@ -1148,18 +3715,29 @@ void ComputeServer::handle_split_response(AsyncOperation& op) {
                 SST::Interfaces::StandardMem* target_interface = get_interface_for_address(new_root_addr);
                 target_interface->send(req);
                 stat_network_writes->addData(1);
+                op.round_trips++;
+                
+                // The old root moved, so its lock is never released by a write-back.
+                // Release it so operations that read the old root address move on:
+                // adding 1 to (v << 1 | 1) clears the lock bit and bumps the version.
+                if (optimistic_cc && op.lock_address != new_root_addr) {
+                    send_remote_atomic(RemoteAtomicData::ATOMIC_FAA, op.lock_address, 1, 0, nullptr);
+                    op.round_trips++;
+                }
                 
                 // Update tree metadata
                 root_address = new_root_addr;
                 tree_height++;
                 
+                // Every cached internal node now sits one level deeper
+                index_cache_version++;
+                index_cache_invalidate(new_root_addr);
+                
                 out.output("   ✓ New root created at 0x%lx, tree height now %u\n",
                            root_address, tree_height);
                 
                 // Split complete - operation done
-                SimTime_t latency = getCurrentSimTime() - op.start_time;
-                stat_total_latency->addData(latency);
-                stat_ops_completed->addData(1);
+                complete_operation(op);
                 
             } else {
                 // Non-root split - need to update parent
@@ -1177,7 +3755,7 @@ void ComputeServer::handle_split_response(AsyncOperation& op) {
                     // Start traversal from root using separator key
                     auto req = new SST::Interfaces::StandardMem::Read(root_address, get_serialized_node_size());
                     auto req_id = req->getID();
-                    pending_ops[req_id] = op;
+                    track_request(req_id, op);
                     
                     SST::Interfaces::StandardMem* target_interface = get_interface_for_address(root_address);
                     target_interface->send(req);
@@ -1191,7 +3769,7 @@ void ComputeServer::handle_split_response(AsyncOperation& op) {
                     
                     auto req = new SST::Interfaces::StandardMem::Read(op.parent_address, get_serialized_node_size());
                     auto req_id = req->getID();
-                    pending_ops[req_id] = op;
+                    track_request(req_id, op);
                     
                     SST::Interfaces::StandardMem* target_interface = get_interface_for_address(op.parent_address);
                     target_interface->send(req);
@@ -1209,9 +3787,7 @@ void ComputeServer::handle_split_response(AsyncOperation& op) {
             out.output("   ✓ Phase 3 complete: Parent updated\n");
             
             // Split complete - operation done
-            SimTime_t latency = getCurrentSimTime() - op.start_time;
-            stat_total_latency->addData(latency);
-            stat_ops_completed->addData(1);
+            complete_operation(op);
             break;
         }
             
@@ -1224,121 +3800,47 @@ void ComputeServer::handle_split_response(AsyncOperation& op) {
 // DATA SERIALIZATION/DESERIALIZATION
 // ═══════════════════════════════════════════════════════════════════════════
 
-BTreeNode ComputeServer::deserialize_node(const std::vector<uint8_t>& data) {
-    // Deserialize BTreeNode from raw bytes
-    // Manual deserialization to handle std::vector properly
-    BTreeNode node(btree_fanout);
-    
-    if (data.size() < sizeof(uint32_t) * 2 + sizeof(bool) + sizeof(uint64_t)) {
-        out.output("   ⚠️  WARNING: Data too small: %zu bytes\n", data.size());
-        return node;
-    }
-    
-    size_t offset = 0;
-    
-    // Deserialize metadata
-    std::memcpy(&node.num_keys, data.data() + offset, sizeof(uint32_t));
-    offset += sizeof(uint32_t);
-    
-    std::memcpy(&node.fanout, data.data() + offset, sizeof(uint32_t));
-    offset += sizeof(uint32_t);
-    
-    std::memcpy(&node.is_leaf, data.data() + offset, sizeof(bool));
-    offset += sizeof(bool);
-    
-    std::memcpy(&node.node_address, data.data() + offset, sizeof(uint64_t));
-    offset += sizeof(uint64_t);
-    
-    // Deserialize keys array
-    if (node.num_keys > 0 && offset + node.num_keys * sizeof(uint64_t) <= data.size()) {
-        std::memcpy(node.keys.data(), data.data() + offset, node.num_keys * sizeof(uint64_t));
-        offset += node.fanout * sizeof(uint64_t);  // Always advance by full fanout size
-    }
-    
-    // Deserialize values array (for leaf nodes)
-    if (node.is_leaf && node.num_keys > 0 && offset + node.num_keys * sizeof(uint64_t) <= data.size()) {
-        std::memcpy(node.values.data(), data.data() + offset, node.num_keys * sizeof(uint64_t));
-    }
-    offset += node.fanout * sizeof(uint64_t);  // Always advance by full fanout size (values region)
-    
-    // Deserialize children array (for internal nodes)
-    if (!node.is_leaf && offset + (node.num_keys + 1) * sizeof(uint64_t) <= data.size()) {
-        std::memcpy(node.children.data(), data.data() + offset, (node.num_keys + 1) * sizeof(uint64_t));
-        out.output("   DEBUG DESER: Copied %u children from offset %zu\n", node.num_keys + 1, offset);
-    } else if (!node.is_leaf) {
-        out.output("   DEBUG DESER: SKIPPED children! is_leaf=%d, offset=%zu, need=%zu, data_size=%zu\n",
-                   node.is_leaf, offset, (node.num_keys + 1) * sizeof(uint64_t), data.size());
-    }
-    
-    out.output("   📦 Deserialized node: num_keys=%u, is_leaf=%d, addr=0x%lx",
-               node.num_keys, node.is_leaf, node.node_address);
-    if (node.num_keys > 0) {
-        out.output(", keys[0]=%lu", node.keys[0]);
+BTreeNodeView ComputeServer::deserialize_node(const std::vector<uint8_t>& data) {
+    return deserialize_node(data.data(), data.size());
+}
+
+BTreeNodeView ComputeServer::deserialize_node(const uint8_t* data, size_t size) {
+    // Node images are fixed-size and naturally aligned, so the payload is
+    // read in place. The view is only valid while 'data' is alive.
+    if (size < get_serialized_node_size()) {
+        out.output("   ⚠️  WARNING: Data too small: %zu bytes\n", size);
+        return BTreeNodeView(empty_node);
     }
-    out.output("\n");
     
+    BTreeNodeView node(data, btree_fanout);
+    dbg.debug(CALL_INFO, 4, 0, "Viewing node: num_keys=%u, is_leaf=%d, addr=0x%lx\n",
+              node.num_keys(), node.is_leaf(), node.node_address());
     return node;
 }
 
 size_t ComputeServer::get_serialized_node_size() const {
-    // Calculate serialized size for ANY node with this fanout
-    return sizeof(uint32_t) * 2 + sizeof(bool) + sizeof(uint64_t) +  // metadata
-           btree_fanout * sizeof(uint64_t) +  // keys
-           btree_fanout * sizeof(uint64_t) +  // values
-           (btree_fanout + 1) * sizeof(uint64_t);  // children
+    // Fixed image size for ANY node with this fanout (header + keys + values + children)
+    return btree_node_image_size(btree_fanout);
 }
 
 std::vector<uint8_t> ComputeServer::serialize_node(const BTreeNode& node) {
-    // Serialize BTreeNode to raw bytes
-    // Manual serialization to handle std::vector properly
-    size_t data_size = get_serialized_node_size();
-    
-    std::vector<uint8_t> data(data_size, 0);
-    size_t offset = 0;
-    
-    // Serialize metadata
-    std::memcpy(data.data() + offset, &node.num_keys, sizeof(uint32_t));
-    offset += sizeof(uint32_t);
-    
-    std::memcpy(data.data() + offset, &node.fanout, sizeof(uint32_t));
-    offset += sizeof(uint32_t);
-    
-    std::memcpy(data.data() + offset, &node.is_leaf, sizeof(bool));
-    offset += sizeof(bool);
-    
-    std::memcpy(data.data() + offset, &node.node_address, sizeof(uint64_t));
-    offset += sizeof(uint64_t);
-    
-    // Serialize keys array (always serialize full fanout size for fixed layout)
-    std::memcpy(data.data() + offset, node.keys.data(), node.fanout * sizeof(uint64_t));
-    offset += node.fanout * sizeof(uint64_t);
-    
-    // Serialize values array (for leaf nodes)
-    std::memcpy(data.data() + offset, node.values.data(), node.fanout * sizeof(uint64_t));
-    offset += node.fanout * sizeof(uint64_t);
-    
-    // Serialize children array (for internal nodes)
-    std::memcpy(data.data() + offset, node.children.data(), (node.fanout + 1) * sizeof(uint64_t));
-    
-    out.output("   📦 Serialized node: num_keys=%u, is_leaf=%d, addr=0x%lx",
-               node.num_keys, node.is_leaf, node.node_address);
-    if (node.num_keys > 0) {
-        out.output(", keys[0]=%lu", node.keys[0]);
-    }
-    out.output("\n");
-    
-    return data;
+    // The in-memory image already is the wire format. Writes are not held
+    // back, but the encoding keeps a worker core busy for later node work.
+    charge_cpu(cpu_cycles_per_byte * node.size());
+    dbg.debug(CALL_INFO, 4, 0, "Serializing node: num_keys=%u, is_leaf=%d, addr=0x%lx\n",
+              node.num_keys(), node.is_leaf(), node.node_address());
+    return node.to_bytes();
 }
 
 void ComputeServer::write_node_back(const BTreeNode& node) {
     // Serialize and write node back to memory
     auto data = serialize_node(node);
     
-    auto req = new SST::Interfaces::StandardMem::Write(node.node_address, data.size(), data);
+    auto req = new SST::Interfaces::StandardMem::Write(node.node_address(), data.size(), data);
     
-    SST::Interfaces::StandardMem* target_interface = get_interface_for_address(node.node_address);
+    SST::Interfaces::StandardMem* target_interface = get_interface_for_address(node.node_address());
     target_interface->send(req);
     stat_network_writes->addData(1);
     
-    out.output("   ✍️  Wrote node back to address 0x%lx\n", node.node_address);
+    out.output("   ✍️  Wrote node back to address 0x%lx\n", node.node_address());
 }
\ No newline at end of file
@@ -18,9 +18,21 @@
 #include <sst/core/statapi/stataccumulator.h>
 #include <sst/core/interfaces/stdMem.h>
 #include <random>
+#include <fstream>
+#include <queue>
+#include <deque>
 #include <map>
+#include <list>
+#include <unordered_map>
 #include <vector>
 #include <string>
+#include "asyncOpTable.h"
+#include "btreeNode.h"
+#include "keyGenerator.h"
+#include "latencyHistogram.h"
+#include "learnedIndex.h"
+#include "raceHash.h"
+#include "remoteMemOps.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -28,7 +40,31 @@ namespace MemHierarchy {
 // B+tree operation types
 enum BTreeOp {
     BTREE_INSERT,
-    BTREE_SEARCH
+    BTREE_SEARCH,
+    BTREE_SCAN               // Range scan of scan_length keys starting at key
+};
+
+// Key popularity distributions
+enum KeyDistribution {
+    KEY_UNIFORM,
+    KEY_ZIPFIAN,             // Bounded Zipfian, rank 0 hottest
+    KEY_SCRAMBLED_ZIPFIAN,   // Zipfian ranks hashed across the key space
+    KEY_LATEST               // Zipfian skew towards the most recently inserted keys
+};
+
+// Which memory server a newly allocated B+tree node is placed on
+enum NodePlacement {
+    PLACE_ROUND_ROBIN,       // Node ID modulo the number of servers
+    PLACE_HASH,              // Hashed node ID
+    PLACE_RANGE,             // Server owns a contiguous slice of the key range
+    PLACE_LOCALITY           // Subtrees below the root's children stay on one server
+};
+
+// How the compute server issues its workload
+enum LoadMode {
+    LOAD_FIXED,              // One op every 1/operations_per_second, no in-flight limit
+    LOAD_OPEN,               // Poisson arrivals, optional in-flight cap
+    LOAD_CLOSED              // Fixed client count, each waits for its previous op
 };
 
 // Workload operation structure
@@ -36,60 +72,272 @@ struct WorkloadOp {
     BTreeOp op_type;
     uint64_t key;
     uint64_t value;
+    uint32_t scan_length;  // Keys returned by a scan
     SimTime_t timestamp;
     uint64_t node_id;  // Which compute node issued this
 };
 
-// B+tree node structure (dynamic fanout) - MUST be defined before AsyncOperation
-struct BTreeNode {
-    std::vector<uint64_t> keys;        // Keys (size = fanout)
-    std::vector<uint64_t> values;      // Values for leaf nodes (size = fanout)
-    std::vector<uint64_t> children;    // Child pointers for internal nodes (size = fanout+1)
-    uint32_t num_keys;                 // Number of keys currently in node
-    uint32_t fanout;                   // Maximum keys per node
-    bool is_leaf;                      // Leaf or internal node
-    uint64_t node_address;             // Address in memory server
-    
-    // Constructor
-    BTreeNode(uint32_t fanout_size = 16) : fanout(fanout_size) {
-        keys.resize(fanout);
-        values.resize(fanout);
-        children.resize(fanout + 1);
-        num_keys = 0;
-        is_leaf = true;
-        node_address = 0;
-    }
-    
-    // Lock is located at the beginning of the node (no separate address)
-    // Lock offset: 0
-    // Data offset: sizeof(lock)
-};
-
 // Async operation tracking - state machine for multi-step operations
 struct AsyncOperation {
-    enum Type { TRAVERSAL, INSERT, SEARCH, SPLIT_LEAF, SPLIT_INTERNAL, UPDATE_PARENT };
-    enum SplitPhase { NONE, WRITE_OLD_NODE, WRITE_NEW_NODE, READ_PARENT, UPDATE_PARENT_NODE };
+    enum Type { TRAVERSAL, INSERT, SEARCH, SCAN, SPLIT_LEAF, SPLIT_INTERNAL, UPDATE_PARENT };
+    enum SplitPhase { NONE, WRITE_OLD_NODE, WRITE_NEW_NODE, READ_PARENT, LOCK_PARENT, UPDATE_PARENT_NODE };
     
     Type type;                          // What operation is this?
     uint64_t key;                       // Key being operated on
     uint64_t value;                     // Value (for inserts)
     uint32_t current_level;             // Which tree level we're at
     uint64_t current_address;           // Current node address
-    std::vector<BTreeNode> path;        // Nodes visited so far (for splits)
+    std::vector<uint64_t> path;         // Addresses of nodes visited so far (for splits)
     SimTime_t start_time;               // When operation started
     
     // Split operation state
     SplitPhase split_phase;             // Which phase of split we're in
-    BTreeNode old_node;                 // Node being split
-    BTreeNode new_node;                 // New node created from split
+    uint64_t old_node_address;          // Node being split (after any root relocation)
+    uint64_t new_node_address;          // New node created from split
+    std::vector<uint8_t> new_node_image; // New node, written once the old node is durable
     uint64_t separator_key;             // Key to insert into parent
     uint64_t parent_address;            // Address of parent node
     bool is_root_split;                 // Is this splitting the root?
     
+    // Optimistic concurrency state
+    uint64_t lock_address;              // Node most recently locked by this operation
+    uint64_t lock_word;                 // Version/lock word the lock CAS expected
+    std::vector<uint8_t> locked_image;  // Node copy validated by that CAS
+    uint32_t retries;                   // Node re-reads caused by locks or failed CAS
+    
+    // Per-operation cost accounting
+    uint32_t round_trips;               // Remote requests issued on behalf of this operation
+    SimTime_t lock_wait;                // Time spent blocked on node locks so far
+    SimTime_t lock_wait_start;          // Start of the current lock wait
+    bool waiting_on_lock;
+    
+    // Range scan state (the scan itself lives in active_scans)
+    uint64_t scan_id;                   // Scan this leaf read belongs to
+    uint32_t scan_seq;                  // Position of this leaf in the scan
+    
+    bool via_rpc;                       // Handled by memory server RPCs, not one-sided reads
+    
+    // Learned index state (the lookup itself lives in active_lookups)
+    uint64_t lookup_id;                 // Lookup this leaf or delta read belongs to (0 = none)
+    uint64_t hash_id;                   // Hash index operation this request belongs to (0 = none)
+    
+    // Speculative path prefetch state (the prefetch itself lives in active_prefetches)
+    uint64_t prefetch_id;               // Path prefetch started by this traversal (0 = none)
+    bool speculative;                   // Read of a predicted node, not validated by its parent yet
+    uint64_t range_lo;                  // Keys the current node covers, from the separators
+    uint64_t range_hi;                  // followed on the way down: [range_lo, range_hi)
+    
     // Constructor
     AsyncOperation() : type(TRAVERSAL), key(0), value(0), current_level(0), 
                       current_address(0), start_time(0), split_phase(NONE),
-                      separator_key(0), parent_address(0), is_root_split(false) {}
+                      old_node_address(0), new_node_address(0),
+                      separator_key(0), parent_address(0), is_root_split(false),
+                      lock_address(0), lock_word(0), retries(0),
+                      round_trips(0), lock_wait(0), lock_wait_start(0), waiting_on_lock(false),
+                      scan_id(0), scan_seq(0), via_rpc(false), lookup_id(0), hash_id(0),
+                      prefetch_id(0), speculative(false), range_lo(0), range_hi(~0ULL) {}
+    
+    // Return to the default state, keeping vector capacity for reuse
+    void reset() {
+        type = TRAVERSAL;
+        key = 0;
+        value = 0;
+        current_level = 0;
+        current_address = 0;
+        path.clear();
+        start_time = 0;
+        split_phase = NONE;
+        old_node_address = 0;
+        new_node_address = 0;
+        new_node_image.clear();
+        separator_key = 0;
+        parent_address = 0;
+        is_root_split = false;
+        lock_address = 0;
+        lock_word = 0;
+        locked_image.clear();
+        retries = 0;
+        round_trips = 0;
+        lock_wait = 0;
+        lock_wait_start = 0;
+        waiting_on_lock = false;
+        scan_id = 0;
+        scan_seq = 0;
+        via_rpc = false;
+        lookup_id = 0;
+        hash_id = 0;
+        prefetch_id = 0;
+        speculative = false;
+        range_lo = 0;
+        range_hi = ~0ULL;
+    }
+};
+
+// A range scan in progress. Leaf addresses come from the parent visited on
+// the way down and, past its last child, from the leaves' sibling pointers;
+// up to scan_prefetch_depth of them are read at once. Leaves may arrive in
+// any order and are consumed in key order.
+struct ScanState {
+    struct LeafResult {
+        uint32_t keys;                  // Keys of the leaf at or above the start key
+        uint64_t next_leaf;             // Sibling pointer of the leaf
+    };
+
+    AsyncOperation op;                  // Completed once enough keys are consumed
+    uint32_t remaining;                 // Keys still to return
+    bool descended;                     // Leaf candidates were taken from the parent
+    std::deque<uint64_t> candidates;    // Known leaves not read yet, in key order
+    uint32_t issued;                    // Leaf reads issued (next sequence number)
+    uint32_t consumed;                  // Leaves consumed in key order
+    std::map<uint32_t, LeafResult> arrived;  // Leaves read ahead of the consume point
+};
+
+// A learned-index search or insert waiting for its predicted window of
+// leaves. Every leaf in the window and its delta node are read at once;
+// slot 2i holds leaf i of the window and slot 2i+1 its delta node.
+struct LearnedLookup {
+    AsyncOperation op;                  // Completed once the window is resolved
+    std::vector<uint64_t> leaves;       // Leaf addresses read, in key order
+    std::vector<uint64_t> versions;     // Local write version of each leaf when read
+    std::vector<BTreeNode> images;      // Arrived leaf and delta images by slot
+    uint32_t outstanding;               // Reads not arrived yet
+};
+
+// A hash index search or insert in progress. Requests issued for it carry
+// its hash ID and a tag (in scan_seq) saying which part of the phase they
+// belong to; the phase advances once all of them have completed.
+struct HashOpState {
+    enum Phase {
+        BUCKETS,        // Reading the two combined buckets (inserts also write their KV block)
+        KV,             // Reading the KV blocks of slots whose fingerprint matched
+        LINK,           // CAS of the slot that links the KV block
+        DIRECTORY,      // Re-reading a stale directory
+        SPLIT_LOCK,     // CAS of the full subtable's lock word
+        SPLIT_READ,     // Reading the whole subtable and the directory
+        SPLIT_KV,       // Reading the keys of its slots to rehash them
+        SPLIT_WRITE,    // Writing the new subtable and the directory
+        SPLIT_RELEASE   // Writing back the old subtable, which unlocks it
+    };
+
+    AsyncOperation op;
+    Phase phase;
+    uint32_t outstanding;               // Requests of this phase not completed yet
+    uint64_t subtable;                  // Subtable the cached directory maps the key to
+    uint64_t new_subtable;              // Split: subtable taking half of the pairs
+    uint64_t buckets[2];                // Addresses of the key's combined buckets
+    std::vector<uint64_t> images[2];    // Their words: header, 7 slots, header, 7 slots
+    uint64_t kv_address;                // Insert: KV block written for the pair (0 = not yet)
+    std::vector<uint64_t> candidates;   // Slots whose fingerprint matched
+    std::vector<uint64_t> candidate_words;
+    uint64_t match;                     // Index into candidates of the slot holding the key (or ~0)
+    std::vector<uint64_t> table;        // Split: whole subtable image
+    std::vector<uint64_t> table_keys;   // Split: key linked from each slot word
+};
+
+// Speculative reads of the nodes a traversal is predicted to visit below the
+// root, one slot per tree level. A slot is used once the real parent points
+// at its address; on a mismatch it and every deeper slot are discarded.
+struct PathPrefetch {
+    enum SlotState { EMPTY, IN_FLIGHT, ARRIVED, USED, DISCARDED };
+    struct Slot {
+        SlotState state = EMPTY;
+        uint64_t address = 0;
+        bool waiting = false;           // The traversal reached this level before the read arrived
+        AsyncOperation waiter;          // Traversal to continue once it arrives
+        std::vector<uint8_t> image;     // Node read ahead of the traversal
+    };
+    std::vector<Slot> slots;            // Indexed by tree level
+};
+
+// Path prefetch hint: at its level, the node covering keys [lo, hi) was at address
+struct PathHint {
+    uint64_t hi;
+    uint64_t address;
+};
+
+// Compute-side view of one leaf of the learned index
+struct LearnedLeaf {
+    uint64_t delta = 0;                 // Delta node taking inserts the full leaf cannot (0 = none)
+    uint64_t version = 0;               // Bumped as each write to the leaf or its delta lands
+    uint32_t writes_pending = 0;        // Writes to the leaf or its delta still in flight
+};
+
+// Compute-side lock on one leaf for lock coalescing. One local insert at a
+// time CASes the remote lock; the others queue here and are applied to the
+// locked copy when it is acquired, so the lock is handed over locally.
+struct LocalLock {
+    bool acquiring = false;                 // A local insert has the lock CAS outstanding
+    std::deque<AsyncOperation> waiters;     // Inserts queued for the handover, in arrival order
+};
+
+// Cached copy of an internal node in the compute-side index cache
+struct IndexCacheEntry {
+    BTreeNode node;
+    uint64_t version;                        // index_cache_version when filled
+    std::list<uint64_t>::iterator lru_pos;   // Position in LRU order (front = most recent)
+};
+
+// Delivers an index-cache hit back to the traversal after the local access latency
+class IndexCacheHitEvent : public SST::Event {
+public:
+    IndexCacheHitEvent(const AsyncOperation& op, const BTreeNode& node) : Event(), op(op), node(node) {}
+    AsyncOperation op;
+    BTreeNode node;
+
+    NotSerializable(IndexCacheHitEvent)
+};
+
+// Hands a node back to the traversal once a worker core has finished processing it
+class CpuWorkEvent : public SST::Event {
+public:
+    CpuWorkEvent(const AsyncOperation& op, const BTreeNode& node) : Event(), op(op), node(node) {}
+    AsyncOperation op;
+    BTreeNode node;
+
+    NotSerializable(CpuWorkEvent)
+};
+
+// Re-issues a node read after the optimistic retry backoff
+class OperationRetryEvent : public SST::Event {
+public:
+    OperationRetryEvent(const AsyncOperation& op) : Event(), op(op) {}
+    AsyncOperation op;
+
+    NotSerializable(OperationRetryEvent)
+};
+
+// Fires when the doorbell batching window for a memory server closes
+class ReadBatchFlushEvent : public SST::Event {
+public:
+    ReadBatchFlushEvent(uint32_t server) : Event(), server(server) {}
+    uint32_t server;
+
+    NotSerializable(ReadBatchFlushEvent)
+};
+
+// Drives open- and closed-loop load: an arrival, a freed client, or a freed in-flight slot
+class LoadEvent : public SST::Event {
+public:
+    enum Kind { ARRIVAL, CLIENT, ADMIT };
+    LoadEvent(Kind kind) : Event(), kind(kind) {}
+    Kind kind;
+
+    NotSerializable(LoadEvent)
+};
+
+// Fires when the group commit timeout of a log group expires
+class WalFlushEvent : public SST::Event {
+public:
+    WalFlushEvent(uint64_t group) : Event(), group(group) {}
+    uint64_t group;                     // Only flushes if this group is still open
+
+    NotSerializable(WalFlushEvent)
+};
+
+// One insert waiting for its log record to become durable
+struct WalEntry {
+    AsyncOperation op;
+    SimTime_t commit_time;              // When the insert finished applying
 };
 
 class ComputeServer : public SST::Component {
@@ -106,34 +354,116 @@ public:
     SST_ELI_DOCUMENT_PARAMS(
         {"node_id", "Compute server node ID", "0"},
         {"num_memory_nodes", "Total number of memory servers to connect to", "4"},
-        {"workload_type", "Workload pattern (ycsb_a, ycsb_b, sherman_mixed)", "ycsb_a"},
-        {"operations_per_second", "Target operations per second", "10000"},
+        {"workload_type", "Workload pattern (ycsb_a, ycsb_b, ycsb_e, sherman_mixed); ycsb_e makes every read a scan unless scan_ratio is set", "ycsb_a"},
+        {"operations_per_second", "Target operations per second (mean arrival rate in open mode, unused in closed mode)", "10000"},
+        {"load_mode", "How operations are issued: 'fixed' (one every 1/operations_per_second, unbounded in flight), 'open' (Poisson arrivals, at most max_inflight in flight) or 'closed' (closed_loop_clients clients, each issuing when its previous op completes)", "fixed"},
+        {"max_inflight", "Open mode: operations in flight before later arrivals wait; latency includes the wait (0 = unbounded)", "0"},
+        {"closed_loop_clients", "Closed mode: number of clients, i.e. operations in flight", "1"},
+        {"think_time_ns", "Closed mode: delay between a client's operation completing and its next one", "0"},
         {"simulation_duration_us", "How long to run simulation", "1000000"},  // 1 second
-        {"zipfian_alpha", "Zipfian distribution parameter", "0.9"},
+        {"key_distribution", "Key popularity (uniform, zipfian, scrambled_zipfian, latest)", "zipfian"},
+        {"zipfian_alpha", "Zipfian skew parameter theta, 0 < alpha < 1 (0 selects uniform)", "0.9"},
         {"read_ratio", "Percentage of read operations (0.0-1.0)", "0.95"},
+        {"scan_ratio", "Fraction of read operations that are range scans (0.0-1.0)", "0.0"},
+        {"scan_length", "Maximum keys per range scan; each scan returns a uniform 1..scan_length keys", "100"},
+        {"scan_prefetch_depth", "Leaf reads a range scan keeps in flight", "4"},
         {"btree_fanout", "B+tree fanout (keys per node)", "16"},
         {"key_range", "Range of keys (0 to key_range)", "1000000"},
+        {"workload_trace", "Optional YCSB trace file to replay instead of the synthetic workload (one '<OP> <table> <key> ...' record per line)", ""},
+        {"index_cache_size", "Number of internal B+tree nodes cached on the compute server (0 disables the cache)", "0"},
+        {"index_cache_hit_latency_ns", "Local access latency charged for an index cache hit", "100"},
+        {"read_batch_size", "Maximum traversal reads to one memory server coalesced into a single doorbell-batched request (1 disables batching)", "1"},
+        {"read_batch_window_ns", "How long a partially filled read batch waits for more reads before it is posted", "0"},
+        {"concurrency_control", "Node concurrency control: 'none' (unsynchronized writes) or 'optimistic' (version-validated reads, CAS-locked writes)", "none"},
+        {"optimistic_retry_backoff_ns", "Delay before re-reading a node that was locked or whose lock CAS failed", "200"},
+        {"access_mode", "How searches and inserts reach remote memory: 'one_sided' (the compute server reads and writes nodes) or 'rpc' (each operation is shipped to the memory servers, which walk the tree locally)", "one_sided"},
+        {"lock_coalescing", "Queue inserts from this server that target the same leaf behind one remote lock and hand the lock over locally (needs concurrency_control=optimistic)", "false"},
+        {"lock_handover_limit", "Queued inserts served per remote lock acquisition before the lock is released", "8"},
+        {"write_combining", "With lock_coalescing, apply all handed-over inserts and write the leaf back once", "true"},
+        {"cpu_cores", "Worker cores that process fetched nodes; nodes queue when all are busy (0 makes node processing free)", "0"},
+        {"cpu_frequency_ghz", "Clock of the worker cores, used to turn cycle costs into time", "2.0"},
+        {"cpu_cycles_per_key", "Cycles per key compared while searching a node", "4"},
+        {"cpu_cycles_per_byte", "Cycles per byte of node image deserialised or serialised", "0.25"},
+        {"cpu_cycles_per_split", "Cycles to split a node, on top of serialising the halves", "2000"},
+        {"wal_enabled", "Log every insert to a write-ahead log on wal_server; an insert completes only once its log record is durable", "false"},
+        {"wal_server", "Memory server that holds the log", "0"},
+        {"wal_log_size_kb", "Circular log space per compute server, at 0x80000 + node_id * size in the log server's window", "8"},
+        {"wal_group_size", "Log records collected into one log write (group commit); 1 writes each record on its own", "1"},
+        {"wal_group_timeout_ns", "How long a partially filled log group waits for more records before it is written (0 writes it as soon as no other log write is in flight)", "0"},
+        {"placement_policy", "Memory server chosen for new nodes (round_robin, hash, range, locality)", "round_robin"},
+        {"memory_server_window_mb", "Address space per memory server; must match the memory servers' setting", "16"},
+        {"bulk_load_keys", "Keys spread evenly over key_range and bulk loaded into the tree during init (0 starts from an empty root)", "0"},
+        {"bulk_load_fill_factor", "Fraction of each bulk loaded node that is filled (0.0-1.0]", "1.0"},
+        {"index_engine", "Index searches and inserts use: 'btree' (traverse the B+tree), 'hash' (RACE-style one-sided hash table: two-choice combined buckets read in one round, KV blocks linked by slot CAS, subtables split under a directory; point operations only, bulk_load_keys preloads it) or 'learned' (a local piecewise-linear model over the bulk loaded leaves predicts a window of leaves, read in one round; needs bulk_load_keys, one_sided access and concurrency_control=none). Scans still walk the B+tree and its sibling chain. Each compute server keeps its own model, so leaves merged by another server are not seen", "btree"},
+        {"hash_subtable_groups", "Hash engine: bucket groups (three 64B buckets of 7 slots) per subtable", "64"},
+        {"hash_initial_depth", "Hash engine: initial global depth; the directory starts with 2^depth subtables", "2"},
+        {"hash_max_depth", "Hash engine: largest global depth the directory may grow to (at most 15)", "12"},
+        {"learned_error_bound", "Learned engine: maximum distance in leaves between a trained leaf's predicted and actual position", "4"},
+        {"learned_retrain_interval", "Learned engine: leaves added by delta merges before the model is retrained; until then lookup windows widen by one leaf per added leaf", "64"},
+        {"path_prefetch", "Read the nodes a one-sided B+tree search or insert is predicted to visit in parallel with the root, using key ranges recorded from internal nodes earlier traversals read. Each prediction is validated against the child pointer of the real parent; mismatches are discarded", "false"},
+        {"path_prefetch_levels", "Tree levels below the root predicted for each traversal", "8"},
+        {"path_prefetch_hints", "Key range hints kept per tree level", "65536"},
         {"verbose", "Verbose debug output", "0"}
     )
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
-        {"mem_interface_0", "Memory interface to memory server 0", "SST::Interfaces::StandardMem"},
-        {"mem_interface_1", "Memory interface to memory server 1", "SST::Interfaces::StandardMem"},
-        {"mem_interface_2", "Memory interface to memory server 2", "SST::Interfaces::StandardMem"},
-        {"mem_interface_3", "Memory interface to memory server 3", "SST::Interfaces::StandardMem"},
-        {"mem_interface_4", "Memory interface to memory server 4", "SST::Interfaces::StandardMem"},
-        {"mem_interface_5", "Memory interface to memory server 5", "SST::Interfaces::StandardMem"},
-        {"mem_interface_6", "Memory interface to memory server 6", "SST::Interfaces::StandardMem"},
-        {"mem_interface_7", "Memory interface to memory server 7", "SST::Interfaces::StandardMem"}
+        {"mem_interface", "Networked memory interface that reaches every memory server by address (takes precedence over mem_interface_%d)", "SST::Interfaces::StandardMem"},
+        {"mem_interface_%d", "Memory interface linked directly to memory server %d, one per num_memory_nodes", "SST::Interfaces::StandardMem"}
     )
     
     SST_ELI_DOCUMENT_STATISTICS(
         {"btree_inserts", "Number of B+tree insert operations", "operations", 1},
         {"btree_searches", "Number of B+tree search operations", "operations", 1},
+        {"btree_scans", "Number of B+tree range scans", "operations", 1},
         {"network_reads", "Number of remote memory read operations", "operations", 1},
         {"network_writes", "Number of remote memory write operations", "operations", 1},
         {"total_latency", "Total operation latency", "ns", 1},
-        {"operations_completed", "Total operations completed", "operations", 1}
+        {"search_latency", "Latency of each completed search (enable as sst.HistogramStatistic for percentiles)", "ns", 1},
+        {"insert_latency", "Latency of each completed insert that did not split", "ns", 1},
+        {"split_insert_latency", "Latency of each completed insert that split one or more nodes", "ns", 1},
+        {"scan_latency", "Latency of each completed range scan", "ns", 1},
+        {"scan_leaves_read", "Leaves consumed by each completed range scan", "leaves", 1},
+        {"scan_leaves_overfetched", "Leaves prefetched by range scans that completed before needing them", "leaves", 1},
+        {"round_trips_per_op", "Remote requests issued by each completed operation", "requests", 1},
+        {"lock_wait_time", "Time each completed operation spent blocked on node locks", "ns", 1},
+        {"operations_completed", "Total operations completed", "operations", 1},
+        {"index_cache_hits", "Internal node reads served by the compute-side index cache", "reads", 1},
+        {"index_cache_misses", "Internal node lookups that missed the index cache", "reads", 1},
+        {"index_cache_evictions", "Index cache entries evicted to make room", "entries", 1},
+        {"index_cache_invalidations", "Index cache entries invalidated by splits", "entries", 1},
+        {"read_batches", "Doorbell-batched read requests posted", "requests", 1},
+        {"read_batch_occupancy", "Node reads carried per posted read batch", "reads", 1},
+        {"path_prefetch_reads", "Speculative reads of predicted traversal nodes", "reads", 1},
+        {"path_prefetch_hits", "Predicted nodes the real parent pointed at, used instead of a dependent read", "reads", 1},
+        {"path_prefetch_mispredicts", "Predictions the real parent did not point at; that level and the deeper ones are discarded", "reads", 1},
+        {"path_prefetch_wasted_bytes", "Bytes of speculative reads that were discarded or never needed", "bytes", 1},
+        {"optimistic_read_retries", "Node reads retried because a writer held the node's lock", "reads", 1},
+        {"lock_cas_attempts", "Remote CAS operations issued to lock a node", "operations", 1},
+        {"lock_cas_failures", "Lock CAS operations that found the node locked or changed", "operations", 1},
+        {"rpc_requests", "B+tree RPCs sent to memory servers, including forwards and retries", "requests", 1},
+        {"rpc_fallbacks", "RPC inserts that found a full leaf and were redone one-sided to split it", "operations", 1},
+        {"lock_handovers", "Inserts that received a leaf lock from another local insert instead of by CAS", "operations", 1},
+        {"combined_writes", "Inserts carried by each leaf write-back under lock coalescing", "inserts", 1},
+        {"cpu_busy_time", "Worker core time charged for each piece of node processing", "ns", 1},
+        {"cpu_queue_delay", "Time each piece of node processing waited for a free worker core", "ns", 1},
+        {"ops_in_flight", "Operations in flight, sampled as each one is issued", "operations", 1},
+        {"admission_delay", "Open mode: time each arrival waited for an in-flight slot", "ns", 1},
+        {"wal_records", "Log records appended", "records", 1},
+        {"wal_group_records", "Log records carried by each log write", "records", 1},
+        {"wal_commit_delay", "Time each logged insert waited, after applying, for its record to become durable", "ns", 1},
+        {"learned_model_segments", "Learned engine: segments of the model after each training", "segments", 1},
+        {"learned_leaves_read", "Learned engine: leaves read by each search or insert", "leaves", 1},
+        {"learned_delta_inserts", "Learned engine: inserts placed in a leaf's delta node because the leaf was full", "operations", 1},
+        {"learned_merges", "Learned engine: full delta nodes merged with their leaf into new leaves", "operations", 1},
+        {"learned_retrains", "Learned engine: model retrains after learned_retrain_interval added leaves", "operations", 1},
+        {"learned_restarts", "Learned engine: inserts that re-read their window because a local write changed the target leaf", "operations", 1},
+        {"hash_kv_reads", "Hash engine: KV blocks read because their slot's fingerprint matched", "reads", 1},
+        {"hash_fingerprint_misses", "Hash engine: KV blocks read whose key turned out to differ", "reads", 1},
+        {"hash_cas_retries", "Hash engine: slot CASes that lost a race and re-read the buckets", "operations", 1},
+        {"hash_directory_refreshes", "Hash engine: directory re-reads after a bucket header showed the cached entry was stale", "reads", 1},
+        {"hash_resizes", "Hash engine: subtables split because both of a key's combined buckets were full", "operations", 1},
+        {"nodes_allocated", "B+tree nodes placed on each memory server (subid = server)", "nodes", 1},
+        {"server_requests", "Remote requests sent to each memory server (subid = server)", "requests", 1}
     )
 
     // Constructor
@@ -150,14 +480,26 @@ public:
     
     // Memory event handler
     void handleMemoryEvent(SST::Interfaces::StandardMem::Request* req);
+    
+    // Index cache hit completion (self link)
+    void handleIndexCacheHit(SST::Event* ev);
+    
+    // Read batching window expiry (self link)
+    void handleReadBatchFlush(SST::Event* ev);
+    
+    // Optimistic retry backoff expiry (self link)
+    void handleOperationRetry(SST::Event* ev);
 
     // ===== Application-level B+tree operations =====
     // These initiate async B+tree operations
-    void btree_insert_async(uint64_t key, uint64_t value);
-    void btree_search_async(uint64_t key);
+    void btree_insert_async(uint64_t key, uint64_t value, SimTime_t start_time);
+    void btree_search_async(uint64_t key, SimTime_t start_time);
+    void btree_scan_async(uint64_t key, uint32_t length, SimTime_t start_time);
 
-    // Workload generation
-    void generate_workload();
+    // Workload generation - operations are produced on demand from tick()
+    void init_workload();
+    bool fetch_next_operation(WorkloadOp& op);
+    bool read_trace_operation(WorkloadOp& op);
     WorkloadOp generate_next_operation();
     uint64_t get_zipfian_key();
 
@@ -170,56 +512,330 @@ private:
     SimTime_t simulation_duration;
     double zipfian_alpha;
     double read_ratio;
+    double scan_ratio;
+    uint32_t scan_length;
     uint32_t btree_fanout;
     uint64_t key_range;
     int verbose_level;
 
     // Workload state
-    std::queue<WorkloadOp> pending_operations;
     std::mt19937 rng;
     std::uniform_real_distribution<double> uniform_dist;
+    WorkloadOp next_op;                 // Next operation waiting for its issue time
+    bool next_op_valid;                 // next_op holds a not-yet-issued operation
+    bool workload_done;                 // Generator/trace is exhausted
+    SimTime_t op_interval;              // Spacing between issued operations (ns)
+    SimTime_t next_op_time;             // Issue time of the next generated operation (ns)
+    uint64_t ops_issued;                // Operations handed to the B+tree so far
+    LoadMode load_mode;
+    uint32_t max_inflight;              // Open mode in-flight cap (0 = none)
+    uint32_t closed_loop_clients;
+    SimTime_t think_time;
+    uint64_t ops_in_flight;             // Issued but not yet completed
+    uint64_t ops_arrived;               // Operations produced by the workload source
+    std::deque<WorkloadOp> admission_queue;  // Open mode arrivals waiting for a slot
+    std::exponential_distribution<double> arrival_dist;
+    SST::Link* load_link;
+    std::string trace_file;             // YCSB trace to replay (empty = synthetic)
+    std::ifstream trace_stream;
+    uint64_t trace_lines_skipped;       // Unparseable trace records
     std::vector<uint64_t> key_frequencies;  // Track key access frequency
+    KeyDistribution key_distribution;
+    ZipfianGenerator zipf_gen;              // Precomputed zeta constants over key_range
+    uint64_t latest_key;                    // Most recently inserted key (latest distribution)
+    uint64_t bulk_load_keys;                // Keys preloaded during init (0 = empty tree)
+    double bulk_load_fill;                  // Node fill factor of the preloaded tree
+    bool bulk_loaded;                       // Tree was built in init(); skip initialize_btree()
 
     // B+tree state
     uint64_t root_address;
     uint32_t tree_height;                        // Current height of the tree
     uint64_t next_node_id;                       // Counter for allocating node IDs
-    std::map<uint64_t, uint64_t> parent_map;     // Maps child_address → parent_address (for split operations)
 
-    // Network interfaces (multiple for connecting to different memory servers)
-    SST::Interfaces::StandardMem* memory_interface;  // Primary interface
-    std::vector<SST::Interfaces::StandardMem*> memory_interfaces;  // Additional interfaces
+    // Network interfaces: one per memory server, or a single networked one
+    std::vector<SST::Interfaces::StandardMem*> memory_interfaces;
+    
+    // Compute-side index cache (internal nodes only, LRU, version-checked)
+    uint32_t index_cache_capacity;
+    SimTime_t index_cache_hit_latency;
+    uint64_t index_cache_version;                // Bumped when the root changes; older entries are stale
+    std::unordered_map<uint64_t, IndexCacheEntry> index_cache;
+    std::list<uint64_t> index_cache_lru;
+    SST::Link* index_cache_link;
+    
+    // Doorbell batching of traversal reads, one open batch per memory server
+    uint32_t read_batch_size;
+    SimTime_t read_batch_window;
+    std::vector<std::vector<AsyncOperation>> read_batches;
+    std::vector<bool> read_batch_flush_pending;
+    std::map<SST::Interfaces::StandardMem::Request::id_t, std::vector<AsyncOperation>> pending_batches;
+    SST::Link* read_batch_link;
+    
+    // Speculative path prefetch, predicted from key range hints per tree level
+    bool path_prefetch;
+    uint32_t path_prefetch_levels;
+    uint32_t path_prefetch_hint_capacity;
+    uint64_t path_hint_version;                  // index_cache_version the hints were recorded under
+    std::vector<std::map<uint64_t, PathHint>> path_hints;  // Per level, keyed by the range's lowest key
+    uint64_t next_prefetch_id;
+    std::unordered_map<uint64_t, PathPrefetch> active_prefetches;
+    
+    // Optimistic concurrency control
+    bool optimistic_cc;
+    SimTime_t optimistic_retry_backoff;
+    bool rpc_offload;                       // access_mode=rpc
+    bool lock_coalescing;                   // Compute-side lock table for leaf locks
+    uint32_t lock_handover_limit;           // Local handovers per remote acquisition
+    bool write_combining;                   // One write-back per handover chain
+    std::unordered_map<uint64_t, LocalLock> local_locks;  // Leaf address -> local lock
+    SST::Link* retry_link;
+    
+    // Compute-side CPU model: node work runs on the first free worker core
+    uint32_t cpu_cores;
+    double cpu_frequency_ghz;
+    double cpu_cycles_per_key;
+    double cpu_cycles_per_byte;
+    double cpu_cycles_per_split;
+    std::vector<SimTime_t> cpu_core_free_at;
+    SimTime_t cpu_busy_total;
+    SST::Link* cpu_link;
+    
+    // Write-ahead log with group commit; inserts complete when their group is durable
+    bool wal_enabled;
+    uint32_t wal_server;
+    uint64_t wal_base;                      // Start of this server's log space
+    uint64_t wal_size;                      // Bytes of log space
+    uint64_t wal_tail;                      // Next append offset within the log space
+    uint64_t wal_next_lsn;
+    uint32_t wal_group_size;
+    SimTime_t wal_group_timeout;
+    uint64_t wal_group_seq;                 // Identifies the open group for its timeout
+    std::vector<WalEntry> wal_group;        // Open group, not yet written
+    std::map<SST::Interfaces::StandardMem::Request::id_t, std::vector<WalEntry>> wal_inflight;
+    SST::Link* wal_link;
+    
+    // Node placement across memory servers; each server's node heap is bump-allocated
+    NodePlacement placement_policy;
+    uint64_t memory_server_window;               // Bytes of address space per server
+    uint64_t server_slot_capacity;               // Node slots in each server's heap
+    std::vector<uint64_t> server_slots_used;
+    std::vector<uint64_t> server_request_counts;
+    std::vector<Statistic<uint64_t>*> stat_nodes_allocated;
+    std::vector<Statistic<uint64_t>*> stat_server_requests;
+    
+    // Range scans in progress, keyed by scan ID
+    uint32_t scan_prefetch_depth;
+    uint64_t next_scan_id;
+    std::unordered_map<uint64_t, ScanState> active_scans;
+    
+    // Learned index engine: leaf table and model on the compute server
+    bool learned_index;                          // index_engine=learned
+    uint32_t learned_error_bound;
+    uint32_t learned_retrain_interval;
+    LearnedIndexModel learned_model;
+    std::vector<uint64_t> learned_leaves;        // Leaf addresses in key order
+    std::vector<uint64_t> learned_first_keys;    // Smallest key of each leaf (the training keys)
+    std::unordered_map<uint64_t, LearnedLeaf> learned_leaf_state;  // Leaf address -> state
+    uint64_t learned_drift;                      // Leaves added since the model was trained
+    uint64_t next_lookup_id;
+    std::unordered_map<uint64_t, LearnedLookup> active_lookups;
+    std::unordered_map<SST::Interfaces::StandardMem::Request::id_t, uint64_t> learned_writes;  // Write -> leaf
+    
+    // One-sided hash index engine: cached directory and KV block allocator
+    bool hash_index;                             // index_engine=hash
+    uint32_t hash_groups;                        // Bucket groups per subtable
+    uint32_t hash_initial_depth;
+    uint32_t hash_max_depth;
+    uint32_t hash_global_depth;                  // Depth of the cached directory
+    std::vector<uint64_t> hash_directory;        // Cached directory entries
+    uint64_t hash_directory_address;
+    uint64_t hash_kv_chunk;                      // KV blocks are carved from this chunk
+    uint64_t hash_kv_chunk_used;
+    uint64_t next_hash_id;
+    std::unordered_map<uint64_t, HashOpState> active_hash_ops;
+    std::unordered_map<uint64_t, std::vector<uint64_t>> hash_split_waiters;  // Subtable being split -> waiting ops
+    
+    // Zeroed leaf returned for short or missing responses
+    BTreeNode empty_node;
     
     // Async operation tracking - state machine
-    std::map<SST::Interfaces::StandardMem::Request::id_t, AsyncOperation> pending_ops;
+    AsyncOpTable<AsyncOperation> pending_ops;
     
     // Statistics
     Statistic<uint64_t>* stat_inserts;
     Statistic<uint64_t>* stat_searches;
+    Statistic<uint64_t>* stat_scans;
     Statistic<uint64_t>* stat_network_reads;
     Statistic<uint64_t>* stat_network_writes;
     Statistic<uint64_t>* stat_total_latency;
     Statistic<uint64_t>* stat_ops_completed;
+    Statistic<uint64_t>* stat_search_latency;
+    Statistic<uint64_t>* stat_insert_latency;
+    Statistic<uint64_t>* stat_split_insert_latency;
+    Statistic<uint64_t>* stat_scan_latency;
+    Statistic<uint64_t>* stat_scan_leaves_read;
+    Statistic<uint64_t>* stat_scan_leaves_overfetched;
+    Statistic<uint64_t>* stat_round_trips;
+    Statistic<uint64_t>* stat_lock_wait;
+    Statistic<uint64_t>* stat_index_cache_hits;
+    Statistic<uint64_t>* stat_index_cache_misses;
+    Statistic<uint64_t>* stat_index_cache_evictions;
+    Statistic<uint64_t>* stat_index_cache_invalidations;
+    Statistic<uint64_t>* stat_read_batches;
+    Statistic<uint64_t>* stat_read_batch_occupancy;
+    Statistic<uint64_t>* stat_path_prefetch_reads;
+    Statistic<uint64_t>* stat_path_prefetch_hits;
+    Statistic<uint64_t>* stat_path_prefetch_mispredicts;
+    Statistic<uint64_t>* stat_path_prefetch_wasted_bytes;
+    Statistic<uint64_t>* stat_optimistic_read_retries;
+    Statistic<uint64_t>* stat_lock_cas_attempts;
+    Statistic<uint64_t>* stat_lock_cas_failures;
+    Statistic<uint64_t>* stat_rpc_requests;
+    Statistic<uint64_t>* stat_rpc_fallbacks;
+    Statistic<uint64_t>* stat_lock_handovers;
+    Statistic<uint64_t>* stat_combined_writes;
+    Statistic<uint64_t>* stat_cpu_busy_time;
+    Statistic<uint64_t>* stat_cpu_queue_delay;
+    Statistic<uint64_t>* stat_wal_records;
+    Statistic<uint64_t>* stat_ops_in_flight;
+    Statistic<uint64_t>* stat_admission_delay;
+    Statistic<uint64_t>* stat_wal_group_records;
+    Statistic<uint64_t>* stat_wal_commit_delay;
+    Statistic<uint64_t>* stat_hash_kv_reads;
+    Statistic<uint64_t>* stat_hash_fingerprint_misses;
+    Statistic<uint64_t>* stat_hash_cas_retries;
+    Statistic<uint64_t>* stat_hash_directory_refreshes;
+    Statistic<uint64_t>* stat_hash_resizes;
+    Statistic<uint64_t>* stat_learned_model_segments;
+    Statistic<uint64_t>* stat_learned_leaves_read;
+    Statistic<uint64_t>* stat_learned_delta_inserts;
+    Statistic<uint64_t>* stat_learned_merges;
+    Statistic<uint64_t>* stat_learned_retrains;
+    Statistic<uint64_t>* stat_learned_restarts;
+
+    // End-of-run percentiles, independent of statistic output settings
+    LatencyHistogram search_latency_hist;
+    LatencyHistogram insert_latency_hist;
+    LatencyHistogram split_insert_latency_hist;
+    LatencyHistogram scan_latency_hist;
+    LatencyHistogram lock_wait_hist;
 
     // Timing
     SST::Clock::HandlerBase* clock_handler;
     SimTime_t last_op_time;
     
     // Helper functions
-    uint64_t allocate_node_address(uint64_t node_id, uint32_t level);
+    uint64_t allocate_node_address(uint64_t node_id, uint32_t level, uint64_t placement_key, uint64_t parent_address);
+    uint64_t place_node(uint64_t node_id, uint64_t placement_key, uint64_t parent_address, uint64_t slots = 1);
+    uint32_t choose_server(uint64_t node_id, uint64_t placement_key, uint64_t parent_address);
+    uint64_t server_base_address(uint32_t server) const;
+    uint64_t parent_in_path(const AsyncOperation& op, uint64_t address) const;
     SST::Interfaces::StandardMem* get_interface_for_address(uint64_t address);
-    void process_btree_operation(const WorkloadOp& op);
+    SST::Interfaces::StandardMem* interface_for_server(uint32_t memory_server_id);
+    void process_btree_operation(const WorkloadOp& op, SimTime_t start_time);
+    
+    // Open- and closed-loop load generation
+    SimTime_t next_arrival_gap();
+    void handleLoadEvent(SST::Event* ev);
+    void admit_operations();
     
     // B+tree structure management
     void initialize_btree();
+    void bulk_load_btree();
     uint64_t calculate_tree_height(uint64_t num_keys);
-    uint64_t get_child_index_for_key(const BTreeNode& node, uint64_t key);
+    uint64_t get_child_index_for_key(const BTreeNodeView& node, uint64_t key);
     
     // Async operation handlers
     void handle_read_response(SST::Interfaces::StandardMem::Request::id_t req_id, 
                              const std::vector<uint8_t>& data);
     void handle_write_response(SST::Interfaces::StandardMem::Request::id_t req_id);
-    void handle_leaf_operation(AsyncOperation& op, BTreeNode& leaf);
+    void handle_batch_read_response(SST::Interfaces::StandardMem::Request::id_t req_id, BatchReadData* batch);
+    void handle_atomic_response(SST::Interfaces::StandardMem::Request::id_t req_id, RemoteAtomicData* atomic);
+    void send_node_read(const AsyncOperation& op);
+    void flush_read_batch(uint32_t server);
+    uint32_t get_server_for_address(uint64_t address);
+    void handle_leaf_operation(AsyncOperation& op, const BTreeNodeView& leaf);
+    void issue_traversal_read(const AsyncOperation& op);
+    void issue_node_read(const AsyncOperation& op);
+    void path_prefetch_begin(AsyncOperation& op);
+    void path_hint_record(const AsyncOperation& op, const BTreeNodeView& node);
+    bool path_prefetch_take(const AsyncOperation& op);
+    void path_prefetch_discard(PathPrefetch::Slot& slot);
+    void path_prefetch_arrived(const AsyncOperation& op, const uint8_t* data, size_t size);
+    void path_prefetch_end(uint64_t prefetch_id);
+    void process_traversal_node(AsyncOperation& op, const BTreeNodeView& node);
+    void process_node_on_cpu(AsyncOperation& op, const BTreeNodeView& node, size_t bytes);
+    SimTime_t charge_cpu(double cycles);
+    void handleCpuWorkDone(SST::Event* ev);
+    void complete_operation(const AsyncOperation& op);
+    void record_completion(const AsyncOperation& op);
+    
+    // Write-ahead log
+    void wal_append(const AsyncOperation& op);
+    void wal_flush();
+    void handleWalFlush(SST::Event* ev);
+    bool handle_wal_response(SST::Interfaces::StandardMem::Request::id_t req_id);
+    AsyncOperation& track_request(SST::Interfaces::StandardMem::Request::id_t req_id, const AsyncOperation& op);
+    void print_latency_summary(const char* name, const LatencyHistogram& hist);
+    void update_parent_node(AsyncOperation& op, BTreeNode& parent);
+    void send_parent_read(const AsyncOperation& op);
+    
+    // Range scans
+    void scan_leaf_arrived(const AsyncOperation& op, const BTreeNodeView& leaf);
+    void issue_scan_reads(ScanState& scan);
+    
+    // Hash index engine
+    void hash_build();
+    void hash_begin(const AsyncOperation& op);
+    void hash_lookup(HashOpState& state);
+    void hash_response(const AsyncOperation& tag, const uint8_t* data, size_t size, const RemoteAtomicData* atomic);
+    void hash_buckets_arrived(HashOpState& state);
+    void hash_link_slot(HashOpState& state);
+    void hash_refresh_directory(HashOpState& state);
+    void hash_split_begin(HashOpState& state);
+    void hash_split_read_keys(HashOpState& state);
+    void hash_split_apply(HashOpState& state);
+    void hash_release_split(uint64_t subtable);
+    void hash_finish(HashOpState& state);
+    void hash_split_table(std::vector<uint64_t>& old_words, std::vector<uint64_t>& new_words,
+                          const std::vector<uint64_t>& slot_keys, uint32_t depth, uint64_t suffix);
+    void hash_directory_split(uint64_t suffix, uint32_t depth, uint64_t old_table, uint64_t new_table);
+    uint64_t hash_pick_slot(const uint64_t* const images[2], const uint64_t bases[2]) const;
+    uint64_t hash_alloc_subtable();
+    uint64_t hash_alloc_kv(uint64_t key);
+    AsyncOperation hash_tag(const HashOpState& state, uint32_t tag) const;
+    void hash_read(HashOpState& state, uint64_t address, uint64_t size, uint32_t tag);
+    void hash_write(HashOpState& state, uint64_t address, const std::vector<uint8_t>& data, uint32_t tag);
+    std::vector<uint8_t> hash_directory_image() const;
+    
+    // Learned index engine
+    void learned_train();
+    void learned_lookup_async(const AsyncOperation& op);
+    void learned_read_arrived(const AsyncOperation& op, const BTreeNodeView& node);
+    void learned_resolve_insert(LearnedLookup& lookup);
+    void learned_merge(AsyncOperation& op, uint64_t pos, const BTreeNode& leaf, const BTreeNode& delta);
+    void learned_write(const BTreeNode& node, uint64_t leaf_address);
+    bool handle_learned_write_response(SST::Interfaces::StandardMem::Request::id_t req_id);
+    
+    // Optimistic concurrency
+    void lock_node(AsyncOperation& op, uint64_t address, const BTreeNodeView& node);
+    void schedule_retry(const AsyncOperation& op);
+    void serve_local_lock(AsyncOperation& holder, BTreeNode& leaf);
+    
+    // RPC offload
+    void send_btree_rpc(AsyncOperation& op);
+    void handle_rpc_response(SST::Interfaces::StandardMem::Request::id_t req_id, BTreeRpcData* rpc);
+    void release_local_waiters(uint64_t address, std::deque<AsyncOperation>& waiters);
+    bool insert_into_leaf(BTreeNode& leaf, uint64_t key, uint64_t value);
+    void begin_lock_wait(AsyncOperation& op);
+    void end_lock_wait(AsyncOperation& op);
+    void send_remote_atomic(RemoteAtomicData::Opcode opcode, uint64_t address, uint64_t operand,
+                            uint64_t compare, const AsyncOperation* op);
+    
+    // Index cache management
+    const BTreeNode* index_cache_lookup(uint64_t address);
+    void index_cache_insert(const BTreeNodeView& node);
+    void index_cache_invalidate(uint64_t address);
     
     // Async split operations
     void split_leaf_async(AsyncOperation& op, BTreeNode& leaf, uint64_t new_key, uint64_t new_value);
@@ -228,7 +844,8 @@ private:
     void update_parent_async(uint64_t old_node_addr, uint64_t separator_key, uint64_t new_node_addr, uint32_t level);
     
     // Data serialization/deserialization
-    BTreeNode deserialize_node(const std::vector<uint8_t>& data);
+    BTreeNodeView deserialize_node(const std::vector<uint8_t>& data);
+    BTreeNodeView deserialize_node(const uint8_t* data, size_t size);
     std::vector<uint8_t> serialize_node(const BTreeNode& node);
     size_t get_serialized_node_size() const;
     void write_node_back(const BTreeNode& node);
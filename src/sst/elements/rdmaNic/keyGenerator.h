@@ -0,0 +1,98 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_KEY_GENERATOR
+#define _H_KEY_GENERATOR
+
+#include <cmath>
+#include <cstdint>
+
+namespace SST {
+namespace MemHierarchy {
+
+// Bounded Zipfian sampler over [0, items) following the YCSB
+// ZipfianGenerator (Gray et al., "Quickly Generating Billion-Record
+// Synthetic Databases"). All constants are computed once in configure(),
+// so next() is O(1) and does no I/O.
+//
+// Rank 0 is the most popular item.
+class ZipfianGenerator {
+public:
+    // Number of zeta terms summed exactly; the remainder uses an
+    // Euler-Maclaurin tail so very large key ranges configure quickly.
+    static const uint64_t ZETA_EXACT_TERMS = 1000000;
+
+    ZipfianGenerator() : items(0), theta(0.0), alpha(0.0), zetan(0.0), eta(0.0), half_pow_theta(0.0) {}
+
+    // theta must lie in (0, 1)
+    void configure(uint64_t num_items, double zipf_theta) {
+        items = num_items;
+        theta = zipf_theta;
+        alpha = 1.0 / (1.0 - theta);
+        zetan = zeta(items, theta);
+        double zeta2 = zeta(2, theta);
+        eta = (1.0 - std::pow(2.0 / (double)items, 1.0 - theta)) / (1.0 - zeta2 / zetan);
+        half_pow_theta = 1.0 + std::pow(0.5, theta);
+    }
+
+    // u is a uniform sample in [0, 1)
+    uint64_t next(double u) const {
+        double uz = u * zetan;
+        if (uz < 1.0) return 0;
+        if (uz < half_pow_theta) return (items > 1) ? 1 : 0;
+        uint64_t rank = (uint64_t)((double)items * std::pow(eta * u - eta + 1.0, alpha));
+        return (rank < items) ? rank : items - 1;
+    }
+
+    uint64_t getItems() const { return items; }
+    double getZetan() const { return zetan; }
+
+    static double zeta(uint64_t n, double theta) {
+        uint64_t exact = (n < ZETA_EXACT_TERMS) ? n : ZETA_EXACT_TERMS;
+        double sum = 0.0;
+        for (uint64_t i = 1; i <= exact; i++) {
+            sum += 1.0 / std::pow((double)i, theta);
+        }
+        if (n > exact) {
+            // Integral of x^-theta over (exact, n] plus trapezoid correction
+            double a = (double)exact;
+            double b = (double)n;
+            sum += (std::pow(b, 1.0 - theta) - std::pow(a, 1.0 - theta)) / (1.0 - theta);
+            sum += 0.5 * (std::pow(b, -theta) - std::pow(a, -theta));
+        }
+        return sum;
+    }
+
+private:
+    uint64_t items;
+    double theta;
+    double alpha;
+    double zetan;
+    double eta;
+    double half_pow_theta;
+};
+
+// 64-bit FNV-1a over the bytes of a value, used by YCSB to scatter
+// popular Zipfian ranks across the key space.
+inline uint64_t fnv_hash64(uint64_t val) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (int i = 0; i < 8; i++) {
+        hash ^= (val & 0xff);
+        hash *= 0x100000001B3ULL;
+        val >>= 8;
+    }
+    return hash;
+}
+
+} // namespace MemHierarchy
+} // namespace SST
+
+#endif // _H_KEY_GENERATOR
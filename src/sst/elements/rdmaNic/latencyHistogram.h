@@ -0,0 +1,81 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_LATENCY_HISTOGRAM
+#define _H_LATENCY_HISTOGRAM
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace MemHierarchy {
+
+// Log-linear histogram for end-of-run percentiles. Values below 32 get
+// their own bucket; above that each power of two is split into 32 buckets,
+// so a reported percentile is within ~3% of the true value while the
+// table stays a fixed 1920 counters regardless of the number of samples.
+class LatencyHistogram {
+public:
+    static const int SUB_BITS = 5;
+    static const uint64_t SUB_BUCKETS = 1ULL << SUB_BITS;
+
+    LatencyHistogram() : buckets((64 - SUB_BITS + 1) * SUB_BUCKETS, 0), count(0), max_value(0) {}
+
+    void record(uint64_t value) {
+        buckets[index(value)]++;
+        count++;
+        if (value > max_value) max_value = value;
+    }
+
+    // Upper bound of the bucket holding the q-quantile (0 < q <= 1)
+    uint64_t percentile(double q) const {
+        if (count == 0) return 0;
+        uint64_t target = (uint64_t)(q * (double)count + 0.999999);
+        if (target == 0) target = 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < buckets.size(); i++) {
+            seen += buckets[i];
+            if (seen >= target) {
+                uint64_t upper = upper_bound(i);
+                return (upper < max_value) ? upper : max_value;
+            }
+        }
+        return max_value;
+    }
+
+    uint64_t getCount() const { return count; }
+    uint64_t getMax() const { return max_value; }
+
+private:
+    static size_t index(uint64_t value) {
+        if (value < SUB_BUCKETS) return value;
+        int msb = 63 - __builtin_clzll(value);
+        int shift = msb - SUB_BITS;
+        return ((size_t)(shift + 1) << SUB_BITS) + ((value >> shift) - SUB_BUCKETS);
+    }
+
+    static uint64_t upper_bound(size_t idx) {
+        if (idx < SUB_BUCKETS) return idx;
+        int shift = (int)(idx >> SUB_BITS) - 1;
+        uint64_t sub = idx & (SUB_BUCKETS - 1);
+        return ((sub + SUB_BUCKETS + 1) << shift) - 1;
+    }
+
+    std::vector<uint64_t> buckets;
+    uint64_t count;
+    uint64_t max_value;
+};
+
+} // namespace MemHierarchy
+} // namespace SST
+
+#endif // _H_LATENCY_HISTOGRAM
@@ -0,0 +1,104 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_LEARNED_INDEX
+#define _H_LEARNED_INDEX
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace SST {
+namespace MemHierarchy {
+
+// Piecewise-linear model from keys to positions in a sorted, duplicate-free
+// key array. Segments are fitted greedily with a shrinking slope cone, so
+// every trained key is predicted within error_bound positions of where it
+// actually is. The compute server trains it on the first key of every leaf
+// and keeps only the segments, a few words each, instead of the inner nodes.
+class LearnedIndexModel {
+public:
+    LearnedIndexModel() : error_bound(0), num_keys(0) {}
+
+    void train(const std::vector<uint64_t>& keys, uint32_t bound) {
+        segments.clear();
+        error_bound = bound;
+        num_keys = keys.size();
+        double eps = bound;
+
+        size_t start = 0;
+        while (start < keys.size()) {
+            // The segment passes through its first key; each further key
+            // narrows the range of slopes that keep all keys within eps
+            double slope_lo = 0.0;
+            double slope_hi = std::numeric_limits<double>::infinity();
+            size_t end = start + 1;
+            for (; end < keys.size(); end++) {
+                double dx = (double)(keys[end] - keys[start]);
+                double dy = (double)(end - start);
+                double lo = std::max(slope_lo, (dy - eps) / dx);
+                double hi = std::min(slope_hi, (dy + eps) / dx);
+                if (lo > hi) {
+                    break;
+                }
+                slope_lo = lo;
+                slope_hi = hi;
+            }
+            Segment seg;
+            seg.first_key = keys[start];
+            seg.first_pos = start;
+            seg.slope = std::isinf(slope_hi) ? 0.0 : (slope_lo + slope_hi) / 2;
+            segments.push_back(seg);
+            start = end;
+        }
+    }
+
+    // Positions [lo, hi] that may hold the last trained key <= key
+    void predict(uint64_t key, uint64_t& lo, uint64_t& hi) const {
+        lo = hi = 0;
+        if (segments.empty() || key < segments.front().first_key) {
+            return;
+        }
+        auto it = std::upper_bound(segments.begin(), segments.end(), key,
+            [](uint64_t k, const Segment& s) { return k < s.first_key; }) - 1;
+        uint64_t seg_end = (it + 1 == segments.end()) ? num_keys - 1 : (it + 1)->first_pos - 1;
+
+        // Between two trained keys the prediction is monotone, so the answer
+        // is within eps of it on the high side and eps + 1 on the low side;
+        // one more position each way absorbs rounding
+        double pred = it->first_pos + it->slope * (double)(key - it->first_key);
+        double low = std::floor(pred - error_bound - 2);
+        double high = std::ceil(pred + error_bound + 1);
+        hi = (high >= (double)seg_end) ? seg_end : std::max<uint64_t>(it->first_pos, (uint64_t)high);
+        lo = (low <= (double)it->first_pos) ? it->first_pos : std::min<uint64_t>(hi, (uint64_t)low);
+    }
+
+    size_t num_segments() const { return segments.size(); }
+    uint64_t trained_keys() const { return num_keys; }
+
+private:
+    struct Segment {
+        uint64_t first_key;
+        uint64_t first_pos;
+        double slope;
+    };
+
+    std::vector<Segment> segments;
+    uint32_t error_bound;
+    uint64_t num_keys;
+};
+
+} // namespace MemHierarchy
+} // namespace SST
+
+#endif // _H_LEARNED_INDEX
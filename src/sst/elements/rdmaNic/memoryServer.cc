@@ -11,13 +11,22 @@
 
 #include <sst_config.h>
 #include "memoryServer.h"
+#include "btreeNode.h"
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 using namespace SST;
 using namespace SST::MemHierarchy;
 
 MemoryServer::MemoryServer(ComponentId_t id, Params& params) :
     SST::Component(id),
+    storage(nullptr),
+    storage_mapped(false),
     memory_used(0)
 {
     // Parse configuration parameters
@@ -28,15 +37,46 @@ MemoryServer::MemoryServer(ComponentId_t id, Params& params) :
     btree_node_size = params.find<size_t>("btree_node_size", 4096);
     enable_locking = params.find<bool>("enable_locking", true);
     lock_timeout = params.find<SimTime_t>("lock_timeout_us", 10000) * 1000; // Convert to ns
+    atomic_latency = params.find<SimTime_t>("atomic_latency_ns", 300);
     verbose_level = params.find<int>("verbose", 0);
 
-    // Calculate base address for this memory server - each server gets 16MB address space
-    base_address = 0x10000000 + memory_server_id * 0x1000000;  // 16MB per server
+    // Calculate base address for this memory server - each server gets a
+    // fixed window of address space (16MB by default)
+    server_window = params.find<uint64_t>("memory_server_window_mb", 16) * 1024 * 1024;
+    base_address = 0x10000000 + memory_server_id * server_window;
 
     // Setup debug output with maximum verbosity for address visibility
     dbg.init("", 5, 0, (Output::output_location_t)1);  // Force high verbosity
     out.init("MemoryServer[@p:@l]: ", 1, 0, Output::STDOUT);
 
+    // Untouched pages of either backing read as zero without being resident
+    std::string backing = params.find<std::string>("storage_backing", "heap");
+    std::string storage_file = params.find<std::string>("storage_file", "");
+    if (backing == "heap") {
+        storage = static_cast<uint8_t*>(std::calloc(server_window, 1));
+    } else if (backing == "mmap") {
+        int fd = -1;
+        if (!storage_file.empty()) {
+            fd = open(storage_file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0 || ftruncate(fd, server_window) != 0) {
+                out.fatal(CALL_INFO, -1, "Cannot create storage_file '%s' of %lu bytes\n", storage_file.c_str(), server_window);
+            }
+        }
+        void* mapped = mmap(nullptr, server_window, PROT_READ | PROT_WRITE,
+                            (fd < 0) ? (MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE) : MAP_SHARED, fd, 0);
+        if (fd >= 0) {
+            close(fd);
+        }
+        storage = (mapped == MAP_FAILED) ? nullptr : static_cast<uint8_t*>(mapped);
+        storage_mapped = true;
+    } else {
+        out.fatal(CALL_INFO, -1, "Unknown storage_backing '%s' (expected heap or mmap)\n", backing.c_str());
+    }
+    if (!storage) {
+        out.fatal(CALL_INFO, -1, "Cannot allocate %lu bytes of %s storage\n", server_window, backing.c_str());
+    }
+    storage_touched.resize((server_window + 63) / 64, false);
+
     // Initialize statistics
     stat_network_reads = registerStatistic<uint64_t>("network_reads_received");
     stat_network_writes = registerStatistic<uint64_t>("network_writes_received");
@@ -47,62 +87,64 @@ MemoryServer::MemoryServer(ComponentId_t id, Params& params) :
     stat_lock_conflicts = registerStatistic<uint64_t>("lock_conflicts");
     stat_bytes_read = registerStatistic<uint64_t>("bytes_read");
     stat_bytes_written = registerStatistic<uint64_t>("bytes_written");
+    stat_batch_reads = registerStatistic<uint64_t>("batch_reads_received");
+    stat_atomics = registerStatistic<uint64_t>("atomics_received");
+    stat_cas_failures = registerStatistic<uint64_t>("cas_failures");
+    stat_atomic_queue_delay = registerStatistic<uint64_t>("atomic_queue_delay");
+    stat_rpcs = registerStatistic<uint64_t>("rpcs_received");
+    stat_rpc_nodes_visited = registerStatistic<uint64_t>("rpc_nodes_visited");
+    stat_rpc_queue_delay = registerStatistic<uint64_t>("rpc_queue_delay");
+    
+    // Atomic responses are held back for the atomic unit's service time
+    atomic_link = configureSelfLink("atomic_link", "1ns",
+        new Event::Handler2<MemoryServer,&MemoryServer::handleAtomicResponse>(this));
+    
+    // B+tree RPC responses are held back until a core has served the request
+    uint32_t rpc_cores = params.find<uint32_t>("rpc_cores", 1);
+    rpc_overhead = params.find<SimTime_t>("rpc_overhead_ns", 500);
+    if (rpc_cores == 0) {
+        out.fatal(CALL_INFO, -1, "rpc_cores must be at least 1\n");
+    }
+    rpc_core_free_at.resize(rpc_cores, 0);
+    rpc_link = configureSelfLink("rpc_link", "1ns",
+        new Event::Handler2<MemoryServer,&MemoryServer::handleRpcResponse>(this));
     stat_memory_utilization = registerStatistic<uint64_t>("memory_utilization");
 
-    // Setup multiple memory interfaces 
-    // Support both architectures:
-    // 1. Multi-interface: mem_interface_0, mem_interface_1, ... (shared handler)
-    // 2. Single-interface: mem_interface (dedicated handler per instance)
-    
-    // Check if we're using single-interface architecture (dedicated instances)
+    // Setup memory interfaces. Either:
+    // 1. Single-interface: mem_interface, a direct link to one compute server
+    //    or a networked interface that any number of compute servers reach by address
+    // 2. Multi-interface: mem_interface_0, mem_interface_1, ... one per compute
+    //    server; each handler carries its index so responses go back the same way
     auto single_handler = new SST::Interfaces::StandardMem::Handler2<MemoryServer,&MemoryServer::handleMemoryEvent>(this);
     auto single_interface = loadUserSubComponent<SST::Interfaces::StandardMem>("mem_interface", SST::ComponentInfo::SHARE_NONE,
                                                                                registerTimeBase("1ns"), single_handler);
     if (single_interface) {
-        // Single interface architecture - dedicated memory server instance
-        out.output("Using single-interface architecture (dedicated instance)\n");
-        mem_interface = single_interface;
-        all_mem_interfaces.push_back(mem_interface);
-        interface_to_id[mem_interface] = 0;  // Single interface uses ID 0
+        out.output("Using single-interface architecture\n");
+        mem_interfaces.push_back(single_interface);
         
         // CRITICAL: Tell the interface what address range this memory server handles
         // This allows MemLink to build proper routing tables during init()
-        mem_interface->setMemoryMappedAddressRegion(base_address, memory_capacity);
+        single_interface->setMemoryMappedAddressRegion(base_address, server_window);
         out.output("  Loaded single memory interface: mem_interface\n");
-        out.output("  Configured address region: 0x%lx - 0x%lx (%lu GB)\n", 
-                   base_address, base_address + memory_capacity - 1, memory_capacity / (1024*1024*1024));
+        out.output("  Configured address region: 0x%lx - 0x%lx (%lu MB)\n", 
+                   base_address, base_address + server_window - 1, server_window / (1024*1024));
     } else {
-        // Multi-interface architecture - shared handler
-        out.output("Using multi-interface architecture (shared handler)\n");
-        auto shared_handler = new SST::Interfaces::StandardMem::Handler2<MemoryServer,&MemoryServer::handleMemoryEvent>(this);
+        out.output("Using multi-interface architecture\n");
+        delete single_handler;
         
-        // Load memory interfaces for ALL compute servers (many-to-many connectivity)
-        for (int i = 0; i < num_compute_nodes; i++) {
+        for (uint32_t i = 0; i < num_compute_nodes; i++) {
             std::string interface_name = "mem_interface_" + std::to_string(i);
-            
+            auto handler = new SST::Interfaces::StandardMem::Handler2<MemoryServer,&MemoryServer::handleMemoryEventFromInterface,int>(this, i);
             auto mem_interface_i = loadUserSubComponent<SST::Interfaces::StandardMem>(interface_name, SST::ComponentInfo::SHARE_NONE,
-                                                                                       registerTimeBase("1ns"), shared_handler);
-            if (mem_interface_i) {
-                if (i == 0) {
-                    mem_interface = mem_interface_i;  // Store first interface as primary
-                } else {
-                    mem_interfaces.push_back(mem_interface_i);
-                }
-                all_mem_interfaces.push_back(mem_interface_i);  // Store all interfaces for lookup
-                interface_to_id[mem_interface_i] = i;  // Map interface pointer to ID
-                out.output("  Loaded memory interface from Compute Server %d: %s\n", i, interface_name.c_str());
-            } else {
-                out.fatal(CALL_INFO, -1, "Failed to load memory interface %s\n", interface_name.c_str());
+                                                                                       registerTimeBase("1ns"), handler);
+            if (!mem_interface_i) {
+                out.fatal(CALL_INFO, -1, "Failed to load memory interface %s (set mem_interface or mem_interface_0..%u)\n",
+                          interface_name.c_str(), num_compute_nodes - 1);
             }
+            mem_interfaces.push_back(mem_interface_i);
         }
-        
-        if (all_mem_interfaces.empty()) {
-            out.fatal(CALL_INFO, -1, "No memory interfaces found! Check interface configuration.\n");
-        }
+        out.output("  Many-to-Many connectivity: %zu interfaces loaded\n", mem_interfaces.size());
     }
-    
-    out.output("  Many-to-Many connectivity: %d interfaces loaded\n", (int)mem_interfaces.size() + 1);
-    out.output("  Can accept connections from ALL compute servers\n");
 
     out.output("Memory Server %d initialized\n", memory_server_id);
     out.output("  Capacity: %lu GB, Base address: 0x%lx\n", 
@@ -110,13 +152,14 @@ MemoryServer::MemoryServer(ComponentId_t id, Params& params) :
 }
 
 MemoryServer::~MemoryServer() {
-    // Cleanup will be automatic for smart pointers
+    if (storage_mapped) {
+        munmap(storage, server_window);
+    } else {
+        std::free(storage);
+    }
 }
 
 void MemoryServer::init(unsigned int phase) {
-    mem_interface->init(phase);
-    
-    // Initialize all additional interfaces
     for (auto& interface : mem_interfaces) {
         interface->init(phase);
     }
@@ -138,21 +181,30 @@ void MemoryServer::init(unsigned int phase) {
         
         out.output("Initialized sample B+tree nodes\n");
     }
+
+    // Nodes bulk loaded by a compute server arrive as untimed writes
+    uint64_t preloaded = 0;
+    for (auto interface : mem_interfaces) {
+        while (SST::Interfaces::StandardMem::Request* req = interface->recvUntimedData()) {
+            if (auto write = dynamic_cast<SST::Interfaces::StandardMem::Write*>(req)) {
+                preload_memory(write->pAddr, write->data);
+                preloaded++;
+            }
+            delete req;
+        }
+    }
+    if (preloaded > 0) {
+        out.output("Preloaded %lu B+tree nodes in init phase %u (%lu bytes in use)\n", preloaded, phase, memory_used);
+    }
 }
 
 void MemoryServer::setup() {
-    mem_interface->setup();
-    
-    // Setup all additional interfaces
     for (auto& interface : mem_interfaces) {
         interface->setup();
     }
 }
 
 void MemoryServer::finish() {
-    mem_interface->finish();
-    
-    // Finish all additional interfaces
     for (auto& interface : mem_interfaces) {
         interface->finish();
     }
@@ -169,12 +221,8 @@ void MemoryServer::handleMemoryEvent(SST::Interfaces::StandardMem::Request* req)
     dbg.debug(CALL_INFO, 2, 0, "Received memory event: %s (ID=%lu)\n", 
               req->getString().c_str(), req->getID());
     
-    // We need to determine which interface this request came from
-    // Unfortunately, the StandardMem handler doesn't provide this directly
-    // For now, we'll use a heuristic or store interface information differently
-    
-    // TODO: This is a limitation - we can't easily determine the source interface
-    // For now, default to interface 0 (will work for single interface, fail for multi)
+    // Only the single-interface architecture uses this handler; multi-interface
+    // handlers carry their index into handleMemoryEventFromInterface
     int interface_id = 0;
     
     // Handle incoming remote memory requests
@@ -182,6 +230,8 @@ void MemoryServer::handleMemoryEvent(SST::Interfaces::StandardMem::Request* req)
         handle_remote_read(read_req, interface_id);
     } else if (auto write_req = dynamic_cast<SST::Interfaces::StandardMem::Write*>(req)) {
         handle_remote_write(write_req, interface_id);
+    } else if (auto custom_req = dynamic_cast<SST::Interfaces::StandardMem::CustomReq*>(req)) {
+        handle_custom_request(custom_req, interface_id);
     }
 }
 
@@ -194,6 +244,8 @@ void MemoryServer::handleMemoryEventFromInterface(SST::Interfaces::StandardMem::
         handle_remote_read(read_req, interface_id);
     } else if (auto write_req = dynamic_cast<SST::Interfaces::StandardMem::Write*>(req)) {
         handle_remote_write(write_req, interface_id);
+    } else if (auto custom_req = dynamic_cast<SST::Interfaces::StandardMem::CustomReq*>(req)) {
+        handle_custom_request(custom_req, interface_id);
     }
 }
 
@@ -219,31 +271,18 @@ void MemoryServer::handle_remote_read(SST::Interfaces::StandardMem::Read* req, i
     
     if (!is_address_in_range(address)) {
         out.output("WARNING: Memory Server %d - Remote read to invalid address 0x%lx (range: 0x%lx-0x%lx)\n", 
-                   memory_server_id, address, base_address, base_address + 0x1000000);
+                   memory_server_id, address, base_address, base_address + server_window);
         send_response(req, false, interface_id);
         return;
     }
     
-    // Read data from memory
-    std::vector<uint8_t> data = read_memory(address, size);
-    
-    // Create and send read response 
+    // Create and send read response, filled straight from the slab
     // Route response back through the correct interface using interface_id
-    auto resp = new SST::Interfaces::StandardMem::ReadResp(req, data);
-    
-    // Get the correct interface for response based on interface_id
-    SST::Interfaces::StandardMem* response_interface = nullptr;
-    if (interface_id >= 0 && interface_id < (int)all_mem_interfaces.size()) {
-        response_interface = all_mem_interfaces[interface_id];
-        dbg.debug(CALL_INFO, 2, 0, "Sending ReadResp for request ID %lu through interface %d\n", 
-                  req->getID(), interface_id);
-    } else {
-        response_interface = mem_interface;  // Fallback to primary interface
-        dbg.debug(CALL_INFO, 1, 0, "WARNING: Invalid interface_id %d, using primary interface\n", interface_id);
-    }
+    auto resp = new SST::Interfaces::StandardMem::ReadResp(req, read_memory(address, size));
     
-    // Send response through the correct interface
-    response_interface->send(resp);
+    dbg.debug(CALL_INFO, 2, 0, "Sending ReadResp for request ID %lu through interface %d\n", 
+              req->getID(), interface_id);
+    get_response_interface(interface_id)->send(resp);
 }
 
 void MemoryServer::handle_remote_write(SST::Interfaces::StandardMem::Write* req, int interface_id) {
@@ -268,7 +307,7 @@ void MemoryServer::handle_remote_write(SST::Interfaces::StandardMem::Write* req,
     
     if (!is_address_in_range(address)) {
         out.output("WARNING: Memory Server %d - Remote write to invalid address 0x%lx (range: 0x%lx-0x%lx)\n", 
-                   memory_server_id, address, base_address, base_address + 0x1000000);
+                   memory_server_id, address, base_address, base_address + server_window);
         send_response(req, false);
         return;
     }
@@ -293,56 +332,295 @@ void MemoryServer::handle_remote_write(SST::Interfaces::StandardMem::Write* req,
     auto resp = new SST::Interfaces::StandardMem::WriteResp(req);
     
     // Send response with simulated latency  
-    mem_interface->send(resp);
+    get_response_interface(interface_id)->send(resp);
 }
 
-std::vector<uint8_t> MemoryServer::read_memory(uint64_t address, size_t size) {
-    stat_memory_reads->addData(1);
+void MemoryServer::handle_batch_read(SST::Interfaces::StandardMem::CustomReq* req, BatchReadData* batch, int interface_id) {
+    dbg.debug(CALL_INFO, 2, 0, "BATCH READ: %zu reads of %lu bytes from interface %d\n",
+              batch->addresses.size(), batch->entry_size, interface_id);
+    
+    stat_batch_reads->addData(1);
+    
+    // Serve every read in the batch; entries are laid out in request order
+    batch->payload.clear();
+    batch->payload.reserve(batch->addresses.size() * batch->entry_size);
+    for (uint64_t address : batch->addresses) {
+        stat_network_reads->addData(1);
+        stat_bytes_read->addData(batch->entry_size);
+        
+        if (!is_address_in_range(address)) {
+            out.output("WARNING: Memory Server %d - Batched read to invalid address 0x%lx\n",
+                       memory_server_id, address);
+            batch->payload.insert(batch->payload.end(), batch->entry_size, 0);
+            continue;
+        }
+        stat_memory_reads->addData(1);
+        if (const uint8_t* data = memory_at(address, batch->entry_size)) {
+            batch->payload.insert(batch->payload.end(), data, data + batch->entry_size);
+        } else {
+            batch->payload.insert(batch->payload.end(), batch->entry_size, 0);
+        }
+    }
+    
+    auto resp = new SST::Interfaces::StandardMem::CustomResp(req);
+    resp->data = batch->makeResponse();
+    
+    get_response_interface(interface_id)->send(resp);
+    delete req;
+}
+
+void MemoryServer::handle_custom_request(SST::Interfaces::StandardMem::CustomReq* req, int interface_id) {
+    if (auto batch = dynamic_cast<BatchReadData*>(req->data)) {
+        handle_batch_read(req, batch, interface_id);
+    } else if (auto atomic = dynamic_cast<RemoteAtomicData*>(req->data)) {
+        handle_remote_atomic(req, atomic, interface_id);
+    } else if (auto rpc = dynamic_cast<BTreeRpcData*>(req->data)) {
+        handle_btree_rpc(req, rpc, interface_id);
+    } else {
+        out.fatal(CALL_INFO, -1, "Memory Server %d: unsupported custom request %s\n",
+                  memory_server_id, req->getString().c_str());
+    }
+}
+
+void MemoryServer::handle_remote_atomic(SST::Interfaces::StandardMem::CustomReq* req, RemoteAtomicData* atomic, int interface_id) {
+    uint64_t address = atomic->addr;
+    
+    dbg.debug(CALL_INFO, 2, 0, "REMOTE ATOMIC:%s from interface %d\n", atomic->getString().c_str(), interface_id);
     
-    auto it = memory_blocks.find(address);
-    if (it != memory_blocks.end()) {
-        // Update access statistics
-        it->second.last_access = getCurrentSimTime();
-        it->second.access_count++;
+    stat_atomics->addData(1);
+    
+    // Atomics take effect in arrival order, which is also the order their
+    // responses leave in: each waits for the previous atomic on the same word
+    SimTime_t now = getCurrentSimTime();
+    SimTime_t start = now;
+    auto busy = atomic_busy_until.find(address);
+    if (busy != atomic_busy_until.end() && busy->second > now) {
+        start = busy->second;
+    }
+    SimTime_t done = start + atomic_latency;
+    atomic_busy_until[address] = done;
+    stat_atomic_queue_delay->addData(start - now);
+    
+    if (!is_address_in_range(address)) {
+        out.output("WARNING: Memory Server %d - Remote atomic to invalid address 0x%lx\n",
+                   memory_server_id, address);
+        atomic->result = 0;
+        atomic->success = false;
+    } else {
+        // Requests are handled one at a time, so the read-modify-write is atomic.
+        // Words in the lock region are the lock table entries (owner id, 0 = free).
+        bool lock_word = enable_locking && is_lock_address(address);
+        uint64_t old_value = lock_word ? read_lock_word(address) : read_word(address);
+        uint64_t new_value = old_value;
         
-        // Return requested data
-        const auto& block_data = it->second.data;
-        if (size <= block_data.size()) {
-            return std::vector<uint8_t>(block_data.begin(), block_data.begin() + size);
+        if (atomic->opcode == RemoteAtomicData::ATOMIC_CAS) {
+            atomic->success = (old_value == atomic->compare);
+            if (atomic->success) {
+                new_value = atomic->operand;
+            } else {
+                stat_cas_failures->addData(1);
+                if (lock_word) {
+                    stat_lock_conflicts->addData(1);
+                }
+            }
+        } else {
+            atomic->success = true;
+            new_value = old_value + atomic->operand;
+        }
+        
+        atomic->result = old_value;
+        if (atomic->success) {
+            if (lock_word) {
+                write_lock_word(address, new_value);
+            } else {
+                write_word(address, new_value);
+            }
         }
     }
     
-    // Return zeros if block doesn't exist
-    return std::vector<uint8_t>(size, 0);
+    auto resp = new SST::Interfaces::StandardMem::CustomResp(req);
+    resp->data = atomic->makeResponse();
+    atomic_link->send(done - now, new AtomicResponseEvent(resp, address, done, interface_id));
+    delete req;
+}
+
+void MemoryServer::handleAtomicResponse(SST::Event* ev) {
+    AtomicResponseEvent* completion = static_cast<AtomicResponseEvent*>(ev);
+    
+    // Forget idle words so the map only holds words with atomics in flight
+    auto busy = atomic_busy_until.find(completion->addr);
+    if (busy != atomic_busy_until.end() && busy->second == completion->done) {
+        atomic_busy_until.erase(busy);
+    }
+    
+    get_response_interface(completion->interface_id)->send(completion->resp);
+    delete completion;
+}
+
+void MemoryServer::handle_btree_rpc(SST::Interfaces::StandardMem::CustomReq* req, BTreeRpcData* rpc, int interface_id) {
+    dbg.debug(CALL_INFO, 2, 0, "B+TREE RPC:%s from interface %d\n", rpc->getString().c_str(), interface_id);
+    
+    stat_rpcs->addData(1);
+    
+    // The walk takes effect on arrival, like an atomic; the response leaves
+    // once a core has spent the dispatch overhead plus one memory access per node
+    size_t node_size = btree_node_image_size(rpc->fanout);
+    uint64_t address = rpc->start;
+    rpc->status = BTreeRpcData::RPC_DONE;
+    rpc->nodes_visited = 0;
+    while (true) {
+        if (!is_address_in_range(address)) {
+            rpc->status = BTreeRpcData::RPC_FORWARD;
+            break;
+        }
+        const uint8_t* image = memory_at(address, node_size);
+        if (!image) {
+            rpc->status = BTreeRpcData::RPC_FORWARD;  // Runs past the window: not ours
+            break;
+        }
+        stat_memory_reads->addData(1);
+        BTreeNodeView node(image, rpc->fanout);
+        rpc->nodes_visited++;
+        if (node.is_locked()) {
+            rpc->status = BTreeRpcData::RPC_BUSY;  // A one-sided writer holds it
+            break;
+        }
+        
+        if (!node.is_leaf() && rpc->level + 1 < rpc->tree_height) {
+            // keys[i] is the minimum key in children[i+1]
+            uint32_t child = 0;
+            while (child < node.num_keys() && rpc->key >= node.keys()[child]) {
+                child++;
+            }
+            address = node.children()[child];
+            rpc->level++;
+            continue;
+        }
+        
+        if (rpc->opcode == BTreeRpcData::RPC_SEARCH) {
+            for (uint32_t i = 0; i < node.num_keys() && node.keys()[i] <= rpc->key; i++) {
+                if (node.keys()[i] == rpc->key) {
+                    rpc->found = true;
+                    rpc->result = node.values()[i];
+                }
+            }
+        } else if (node.num_keys() >= rpc->fanout) {
+            rpc->status = BTreeRpcData::RPC_LEAF_FULL;  // Splits stay with the compute server
+        } else {
+            BTreeNode leaf(node);
+            uint32_t pos = 0;
+            while (pos < leaf.num_keys() && leaf.keys()[pos] < rpc->key) {
+                pos++;
+            }
+            if (pos == leaf.num_keys() || leaf.keys()[pos] != rpc->key) {
+                for (uint32_t i = leaf.num_keys(); i > pos; i--) {
+                    leaf.keys()[i] = leaf.keys()[i - 1];
+                    leaf.values()[i] = leaf.values()[i - 1];
+                }
+                leaf.keys()[pos] = rpc->key;
+                leaf.num_keys()++;
+            }
+            leaf.values()[pos] = rpc->value;
+            // A new version makes optimistic readers holding an older copy revalidate
+            leaf.version_lock() = btree_next_version_word(leaf.version_lock());
+            write_memory(address, leaf.to_bytes());
+        }
+        break;
+    }
+    rpc->start = address;
+    stat_rpc_nodes_visited->addData(rpc->nodes_visited);
+    
+    SimTime_t now = getCurrentSimTime();
+    auto core = std::min_element(rpc_core_free_at.begin(), rpc_core_free_at.end());
+    SimTime_t start = std::max(now, *core);
+    *core = start + rpc_overhead + rpc->nodes_visited * memory_latency;
+    stat_rpc_queue_delay->addData(start - now);
+    
+    auto resp = new SST::Interfaces::StandardMem::CustomResp(req);
+    resp->data = rpc->makeResponse();
+    rpc_link->send(*core - now, new RpcResponseEvent(resp, interface_id));
+    delete req;
+}
+
+void MemoryServer::handleRpcResponse(SST::Event* ev) {
+    RpcResponseEvent* completion = static_cast<RpcResponseEvent*>(ev);
+    get_response_interface(completion->interface_id)->send(completion->resp);
+    delete completion;
+}
+
+SST::Interfaces::StandardMem* MemoryServer::get_response_interface(int interface_id) {
+    if (interface_id >= 0 && interface_id < (int)mem_interfaces.size()) {
+        return mem_interfaces[interface_id];
+    }
+    return mem_interfaces[0];
+}
+
+const uint8_t* MemoryServer::memory_at(uint64_t address, size_t size) const {
+    // Bytes of [address, address + size) in the slab, or nullptr if outside the window
+    if (address < base_address || address - base_address + size > server_window) {
+        return nullptr;
+    }
+    return storage + (address - base_address);
+}
+
+void MemoryServer::mark_written(uint64_t address, size_t size) {
+    for (uint64_t chunk = (address - base_address) / 64; chunk <= (address - base_address + size - 1) / 64; chunk++) {
+        if (!storage_touched[chunk]) {
+            storage_touched[chunk] = true;
+            memory_used += 64;
+        }
+    }
+}
+
+std::vector<uint8_t> MemoryServer::read_memory(uint64_t address, size_t size) {
+    stat_memory_reads->addData(1);
+    
+    // Never written bytes read as zero
+    const uint8_t* data = memory_at(address, size);
+    return data ? std::vector<uint8_t>(data, data + size) : std::vector<uint8_t>(size, 0);
+}
+
+void MemoryServer::preload_memory(uint64_t address, const std::vector<uint8_t>& data) {
+    // Like write_memory, but before simulated time starts: no statistics
+    if (data.empty() || !memory_at(address, data.size())) {
+        out.verbose(CALL_INFO, 1, 0, "Ignoring preload outside this server's window: 0x%lx\n", address);
+        return;
+    }
+    std::memcpy(storage + (address - base_address), data.data(), data.size());
+    mark_written(address, data.size());
 }
 
 void MemoryServer::write_memory(uint64_t address, const std::vector<uint8_t>& data) {
     stat_memory_writes->addData(1);
     
-    // Find or create memory block
-    auto it = memory_blocks.find(address);
-    if (it != memory_blocks.end()) {
-        // Update existing block
-        it->second.data = data;
-        it->second.last_access = getCurrentSimTime();
-        it->second.access_count++;
-    } else {
-        // Create new block
-        MemoryBlock new_block;
-        new_block.address = address;
-        new_block.data = data;
-        new_block.last_access = getCurrentSimTime();
-        new_block.access_count = 1;
-        new_block.is_locked = false;
-        new_block.lock_owner = 0;
-        
-        memory_blocks[address] = new_block;
-        memory_used += data.size();
+    if (data.empty() || !memory_at(address, data.size())) {
+        dbg.debug(CALL_INFO, 1, 0, "WARNING: write of %zu bytes at 0x%lx runs outside the window\n", data.size(), address);
+        return;
     }
+    std::memcpy(storage + (address - base_address), data.data(), data.size());
+    mark_written(address, data.size());
     
     update_memory_stats();
 }
 
+uint64_t MemoryServer::read_word(uint64_t address) {
+    // Atomics target the first word of a stored block (e.g. a node's version/lock word)
+    stat_memory_reads->addData(1);
+    
+    uint64_t value = 0;
+    if (const uint8_t* data = memory_at(address, sizeof(value))) {
+        std::memcpy(&value, data, sizeof(value));
+    }
+    return value;
+}
+
+void MemoryServer::write_word(uint64_t address, uint64_t value) {
+    // Update the word in place; the rest of the block is left untouched
+    std::vector<uint8_t> data(sizeof(value));
+    std::memcpy(data.data(), &value, sizeof(value));
+    write_memory(address, data);
+}
+
 bool MemoryServer::acquire_lock(uint64_t lock_address, uint64_t requester_id) {
     dbg.debug(CALL_INFO, 3, 0, "Lock acquire: addr=0x%lx, requester=%lu\n", lock_address, requester_id);
     
@@ -404,6 +682,27 @@ void MemoryServer::release_lock(uint64_t lock_address, uint64_t requester_id) {
     }
 }
 
+uint64_t MemoryServer::read_lock_word(uint64_t lock_address) {
+    auto it = node_locks.find(lock_address);
+    return (it != node_locks.end() && it->second.is_locked) ? it->second.owner_id : 0;
+}
+
+void MemoryServer::write_lock_word(uint64_t lock_address, uint64_t owner) {
+    // A remote atomic on a lock word acquires (non-zero owner) or releases (0) it
+    NodeLock& lock = node_locks[lock_address];
+    lock.lock_address = lock_address;
+    if (owner != 0) {
+        stat_lock_acquisitions->addData(1);
+        lock.is_locked = true;
+        lock.owner_id = owner;
+        lock.lock_time = getCurrentSimTime();
+    } else {
+        stat_lock_releases->addData(1);
+        lock.is_locked = false;
+        lock.owner_id = 0;
+    }
+}
+
 bool MemoryServer::is_lock_address(uint64_t address) {
     // Lock addresses are at a fixed offset from node addresses
     return (address >= base_address + 0x100000) && (address < base_address + 0x200000);
@@ -420,7 +719,7 @@ std::vector<uint8_t> MemoryServer::load_btree_node(uint64_t address) {
 bool MemoryServer::is_address_in_range(uint64_t address) {
     // Check if address is within this memory server's allocated range
     uint64_t range_start = base_address;
-    uint64_t range_end = base_address + 0x1000000;  // 16MB per server
+    uint64_t range_end = base_address + server_window;
     
     bool in_range = (address >= range_start) && (address < range_end);
     
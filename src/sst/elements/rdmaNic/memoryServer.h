@@ -14,24 +14,16 @@
 
 #include <sst/core/component.h>
 #include <sst/core/event.h>
+#include <sst/core/link.h>
 #include <sst/core/sst_types.h>
 #include <sst/core/interfaces/stdMem.h>
 #include <unordered_map>
+#include "remoteMemOps.h"
 #include <vector>
 
 namespace SST {
 namespace MemHierarchy {
 
-// Memory block structure for storing B+tree nodes
-struct MemoryBlock {
-    uint64_t address;
-    std::vector<uint8_t> data;
-    SimTime_t last_access;
-    uint64_t access_count;
-    bool is_locked;
-    uint64_t lock_owner;
-};
-
 // Lock structure for B+tree node locking
 struct NodeLock {
     uint64_t lock_address;
@@ -41,6 +33,30 @@ struct NodeLock {
     std::queue<uint64_t> waiting_queue;  // Nodes waiting for lock
 };
 
+// Delivers a completed remote atomic's response after the atomic latency
+class AtomicResponseEvent : public SST::Event {
+public:
+    AtomicResponseEvent(SST::Interfaces::StandardMem::CustomResp* resp, uint64_t addr, SimTime_t done, int interface_id) :
+        Event(), resp(resp), addr(addr), done(done), interface_id(interface_id) {}
+    SST::Interfaces::StandardMem::CustomResp* resp;
+    uint64_t addr;
+    SimTime_t done;
+    int interface_id;
+
+    NotSerializable(AtomicResponseEvent)
+};
+
+// Holds a B+tree RPC response until the serving core finishes with it
+class RpcResponseEvent : public SST::Event {
+public:
+    RpcResponseEvent(SST::Interfaces::StandardMem::CustomResp* resp, int interface_id) :
+        Event(), resp(resp), interface_id(interface_id) {}
+    SST::Interfaces::StandardMem::CustomResp* resp;
+    int interface_id;
+
+    NotSerializable(RpcResponseEvent)
+};
+
 class MemoryServer : public SST::Component {
 public:
     SST_ELI_REGISTER_COMPONENT(
@@ -56,15 +72,22 @@ public:
         {"memory_server_id", "Memory server node ID", "0"},
         {"num_compute_nodes", "Total number of compute nodes to accept connections from", "8"},
         {"memory_capacity_gb", "Memory capacity in GB", "16"},
+        {"memory_server_window_mb", "Address space per memory server (server N starts at 0x10000000 + N * window); must match the compute servers' setting", "16"},
         {"memory_latency_ns", "Memory access latency in nanoseconds", "100"},
         {"btree_node_size", "Size of B+tree nodes in bytes", "4096"},
+        {"storage_backing", "Backing for the node storage slab: 'heap' (zero-filled allocation) or 'mmap' (lazily mapped pages, optionally file backed)", "heap"},
+        {"storage_file", "With storage_backing=mmap, file that backs the slab instead of anonymous memory (for trees larger than host memory)", ""},
         {"enable_locking", "Enable B+tree node locking", "true"},
         {"lock_timeout_us", "Lock timeout in microseconds", "10000"},
+        {"atomic_latency_ns", "Service time of one remote atomic (CAS/FAA). Atomics to the same 8B word are serialized; atomics to different words overlap", "300"},
+        {"rpc_cores", "Cores serving offloaded B+tree RPCs; an RPC waits for the first free core", "1"},
+        {"rpc_overhead_ns", "Core time to receive, dispatch and answer one B+tree RPC, on top of memory_latency_ns per node visited", "500"},
         {"verbose", "Verbose debug output", "0"}
     )
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
-        {"mem_interface", "Memory interface - single interface per memory server instance", "SST::Interfaces::StandardMem"}
+        {"mem_interface", "Memory interface - a direct link to one compute server, or a networked interface shared by all of them", "SST::Interfaces::StandardMem"},
+        {"mem_interface_%d", "Memory interface to compute server %d when mem_interface is not set (one per num_compute_nodes)", "SST::Interfaces::StandardMem"}
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -77,6 +100,13 @@ public:
         {"lock_conflicts", "Number of lock conflicts/waits", "conflicts", 1},
         {"bytes_read", "Total bytes read from memory", "bytes", 1},
         {"bytes_written", "Total bytes written to memory", "bytes", 1},
+        {"batch_reads_received", "Number of doorbell-batched read requests received", "requests", 1},
+        {"atomics_received", "Number of remote atomic (CAS/FAA) requests received", "requests", 1},
+        {"cas_failures", "Remote CAS requests whose compare value did not match", "requests", 1},
+        {"atomic_queue_delay", "Time an atomic waited behind earlier atomics to the same word", "ns", 1},
+        {"rpcs_received", "Number of offloaded B+tree RPCs received", "requests", 1},
+        {"rpc_nodes_visited", "Nodes read locally by each B+tree RPC", "nodes", 1},
+        {"rpc_queue_delay", "Time a B+tree RPC waited for a free core", "ns", 1},
         {"memory_utilization", "Memory utilization percentage", "percent", 1}
     )
 
@@ -96,16 +126,29 @@ public:
     // Remote memory request handlers
     void handle_remote_read(SST::Interfaces::StandardMem::Read* req, int interface_id);
     void handle_remote_write(SST::Interfaces::StandardMem::Write* req, int interface_id);
+    void handle_batch_read(SST::Interfaces::StandardMem::CustomReq* req, BatchReadData* batch, int interface_id);
+    void handle_remote_atomic(SST::Interfaces::StandardMem::CustomReq* req, RemoteAtomicData* atomic, int interface_id);
+    void handle_custom_request(SST::Interfaces::StandardMem::CustomReq* req, int interface_id);
+    void handleAtomicResponse(SST::Event* ev);
+    void handle_btree_rpc(SST::Interfaces::StandardMem::CustomReq* req, BTreeRpcData* rpc, int interface_id);
+    void handleRpcResponse(SST::Event* ev);
     void handle_remote_request(SST::Interfaces::StandardMem::Request* req);
 
     // Memory operations
     std::vector<uint8_t> read_memory(uint64_t address, size_t size);
+    const uint8_t* memory_at(uint64_t address, size_t size) const;
+    void mark_written(uint64_t address, size_t size);
     void write_memory(uint64_t address, const std::vector<uint8_t>& data);
+    void preload_memory(uint64_t address, const std::vector<uint8_t>& data);
+    uint64_t read_word(uint64_t address);
+    void write_word(uint64_t address, uint64_t value);
 
     // Lock management
     bool acquire_lock(uint64_t lock_address, uint64_t requester_id);
     void release_lock(uint64_t lock_address, uint64_t requester_id);
     bool is_lock_address(uint64_t address);
+    uint64_t read_lock_word(uint64_t lock_address);
+    void write_lock_word(uint64_t lock_address, uint64_t owner);
 
     // B+tree node management
     void store_btree_node(uint64_t address, const std::vector<uint8_t>& node_data);
@@ -120,21 +163,30 @@ private:
     size_t btree_node_size;
     bool enable_locking;
     SimTime_t lock_timeout;
+    SimTime_t atomic_latency;
     int verbose_level;
 
-    // Memory storage
-    std::unordered_map<uint64_t, MemoryBlock> memory_blocks;
+    // Memory storage: one flat slab covering this server's window, so a node
+    // address maps straight to its bytes
+    uint8_t* storage;                // base_address maps to storage[0]
+    bool storage_mapped;             // From mmap rather than calloc
+    std::vector<bool> storage_touched;  // 64B chunks written at least once
     uint64_t memory_used;            // Bytes currently used
     uint64_t base_address;           // Base address for this memory server
+    uint64_t server_window;          // Bytes of address space owned by this server
 
     // Lock management
     std::unordered_map<uint64_t, NodeLock> node_locks;
     
+    // Remote atomics: when the atomic unit finishes the last atomic queued on each word
+    std::unordered_map<uint64_t, SimTime_t> atomic_busy_until;
+    SST::Link* atomic_link;
+    std::vector<SimTime_t> rpc_core_free_at;    // When each RPC core finishes its current request
+    SimTime_t rpc_overhead;
+    SST::Link* rpc_link;
+    
     // Memory interfaces (multiple for accepting connections from different compute servers)
-    SST::Interfaces::StandardMem* mem_interface;  // Primary interface
-    std::vector<SST::Interfaces::StandardMem*> mem_interfaces;  // Additional interfaces
-    std::vector<SST::Interfaces::StandardMem*> all_mem_interfaces;  // All interfaces for easy lookup
-    std::unordered_map<SST::Interfaces::StandardMem*, int> interface_to_id;  // Map interface pointer to ID
+    std::vector<SST::Interfaces::StandardMem*> mem_interfaces;  // Indexed by compute server (multi-interface)
 
     // Statistics
     Statistic<uint64_t>* stat_network_reads;
@@ -146,6 +198,13 @@ private:
     Statistic<uint64_t>* stat_lock_conflicts;
     Statistic<uint64_t>* stat_bytes_read;
     Statistic<uint64_t>* stat_bytes_written;
+    Statistic<uint64_t>* stat_batch_reads;
+    Statistic<uint64_t>* stat_atomics;
+    Statistic<uint64_t>* stat_cas_failures;
+    Statistic<uint64_t>* stat_atomic_queue_delay;
+    Statistic<uint64_t>* stat_rpcs;
+    Statistic<uint64_t>* stat_rpc_nodes_visited;
+    Statistic<uint64_t>* stat_rpc_queue_delay;
     Statistic<uint64_t>* stat_memory_utilization;
 
     // Helper functions
@@ -154,6 +213,7 @@ private:
     void update_memory_stats();
     void cleanup_expired_locks();
     void send_response(SST::Interfaces::StandardMem::Request* req, bool success, int interface_id = -1);
+    SST::Interfaces::StandardMem* get_response_interface(int interface_id);
     
     // Debug output
     Output dbg;
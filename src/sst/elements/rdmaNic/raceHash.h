@@ -0,0 +1,94 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_RACE_HASH
+#define _H_RACE_HASH
+
+#include <cstdint>
+#include <cstddef>
+#include "keyGenerator.h"
+
+namespace SST {
+namespace MemHierarchy {
+
+// Remote layout of the one-sided hash index (RACE hashing, ATC'21).
+//
+// A directory on memory server 0 maps the low global_depth bits of a key's
+// hash to a subtable; compute servers cache it and re-read it when a bucket
+// header shows the cached entry is stale. Each subtable is one lock line
+// followed by bucket groups of three 64B buckets:
+//
+//   ┌───────────┬─────────────────┬─────────────────┬─────────────────┬─────┐
+//   │ lock line │ main 0 (grp 0)  │ overflow (grp 0)│ main 1 (grp 0)  │ ... │
+//   │ 64 bytes  │ hdr + 7 slots   │ hdr + 7 slots   │ hdr + 7 slots   │     │
+//   └───────────┴─────────────────┴─────────────────┴─────────────────┴─────┘
+//
+// A key hashes to two combined buckets (a main bucket plus the overflow
+// bucket it shares with its neighbour), each one contiguous 128B read.
+// Bucket headers hold the subtable's local depth and hash suffix. A slot
+// is one CAS-able word, (fingerprint << 56 | length << 48 | KV address),
+// 0 when empty; KV blocks are written out of place before being linked.
+const uint64_t RACE_BUCKET_SIZE       = 64;
+const uint32_t RACE_SLOTS_PER_BUCKET  = 7;
+const uint64_t RACE_GROUP_SIZE        = 3 * RACE_BUCKET_SIZE;
+const uint64_t RACE_COMBINED_SIZE     = 2 * RACE_BUCKET_SIZE;
+const uint64_t RACE_SUBTABLE_HEADER   = 64;
+const uint64_t RACE_KV_SIZE           = 16;          // Key, value
+const uint64_t RACE_DIRECTORY_HEADER  = 64;          // Global depth word, padded to a line
+const uint64_t RACE_ADDRESS_MASK      = (1ULL << 48) - 1;
+
+inline uint64_t race_subtable_size(uint32_t groups) {
+    return RACE_SUBTABLE_HEADER + groups * RACE_GROUP_SIZE;
+}
+
+// Offset within a subtable of combined bucket 'index' (0 .. 2 * groups - 1)
+inline uint64_t race_combined_offset(uint64_t index) {
+    return RACE_SUBTABLE_HEADER + (index >> 1) * RACE_GROUP_SIZE + (index & 1) * RACE_BUCKET_SIZE;
+}
+
+inline uint64_t race_hash1(uint64_t key) { return fnv_hash64(key); }
+inline uint64_t race_hash2(uint64_t key) { return fnv_hash64(key ^ 0x9E3779B97F4A7C15ULL); }
+inline uint8_t race_fingerprint(uint64_t key) { return (uint8_t)(race_hash2(key) >> 56); }
+
+// The two combined buckets of a key within any subtable, never the same one
+inline void race_bucket_choices(uint64_t key, uint32_t groups, uint64_t& first, uint64_t& second) {
+    uint64_t buckets = 2ULL * groups;
+    first = (race_hash1(key) >> 32) % buckets;
+    second = (race_hash2(key) >> 32) % buckets;
+    if (second == first && buckets > 1) {
+        second = (first + 1) % buckets;
+    }
+}
+
+inline uint64_t race_slot_word(uint8_t fingerprint, uint64_t kv_address) {
+    uint64_t length = 1;    // KV blocks fit in one 64B unit
+    return ((uint64_t)fingerprint << 56) | (length << 48) | (kv_address & RACE_ADDRESS_MASK);
+}
+inline uint8_t race_slot_fingerprint(uint64_t word) { return (uint8_t)(word >> 56); }
+inline uint64_t race_slot_address(uint64_t word) { return word & RACE_ADDRESS_MASK; }
+
+inline uint64_t race_header_word(uint32_t local_depth, uint64_t suffix) {
+    return ((uint64_t)local_depth << 56) | (suffix & RACE_ADDRESS_MASK);
+}
+inline uint32_t race_header_depth(uint64_t word) { return (uint32_t)(word >> 56); }
+inline uint64_t race_header_suffix(uint64_t word) { return word & RACE_ADDRESS_MASK; }
+
+// Directory entries use the same packing: local depth and subtable address
+inline uint64_t race_directory_entry(uint32_t local_depth, uint64_t subtable) {
+    return race_header_word(local_depth, subtable);
+}
+
+inline uint64_t race_depth_mask(uint32_t depth) { return (depth >= 64) ? ~0ULL : ((1ULL << depth) - 1); }
+
+} // namespace MemHierarchy
+} // namespace SST
+
+#endif // _H_RACE_HASH
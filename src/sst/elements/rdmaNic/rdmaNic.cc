@@ -15,6 +15,7 @@
 
 #include <sst_config.h>
 #include <sst/core/params.h>
+#include <sst/core/unitAlgebra.h>
 
 #include "rdmaNic.h"
 
@@ -59,6 +60,12 @@ RdmaNic::RdmaNic(ComponentId_t id, Params &params) : Component(id),
     auto cmdQSize = params.find<int>("cmdQSize", 64);
     assert( cmdQSize );
 
+    // number of host commands the NIC can take per clock, the tail index is written back to the host once per batch
+    m_cmdBatchSize = params.find<int>("cmdBatchSize", 1);
+    if ( m_cmdBatchSize < 1 ) {
+        out.fatal(CALL_INFO_LONG, -1, "%s, Error: cmdBatchSize must be at least 1\n", getName().c_str());
+    }
+
     // make sure a NicCmd is multiple of a ache line
     // Make this more general
     assert( sizeof( NicCmd) == 64 );
@@ -111,6 +118,24 @@ RdmaNic::RdmaNic(ComponentId_t id, Params &params) : Component(id),
     m_dmaMemChannel = 2;
     int numSrc = 3;
 
+    // the IOTLB is off unless it has entries
+    m_iotlb = nullptr;
+    auto iotlbEntries = params.find<int>("iotlbEntries", 0);
+    if ( iotlbEntries > 0 ) {
+        UnitAlgebra pageSize( params.find<std::string>("iotlbPageSize", "4KiB") );
+        UnitAlgebra missLatency( params.find<std::string>("iotlbMissLatency", "500ns") );
+        if ( ! pageSize.hasUnits("B") || ! missLatency.hasUnits("s") ) {
+            out.fatal(CALL_INFO_LONG, -1, "%s, Error: iotlbPageSize must be in bytes and iotlbMissLatency in seconds\n", getName().c_str());
+        }
+        auto maxWalks = params.find<int>("iotlbMaxWalks", 4);
+        if ( maxWalks < 1 ) {
+            out.fatal(CALL_INFO_LONG, -1, "%s, Error: iotlbMaxWalks must be at least 1\n", getName().c_str());
+        }
+        m_iotlb = new Iotlb( iotlbEntries, pageSize.getRoundedValue(), ( missLatency / UnitAlgebra("1ns") ).getRoundedValue(), maxWalks,
+                params.find<bool>("iotlbPinRegions", false), registerStatistic<uint64_t>("iotlbHits"),
+                registerStatistic<uint64_t>("iotlbMisses"), registerStatistic<uint64_t>("iotlbEvictions") );
+    }
+
     int maxPending = params.find<int>("maxMemReqs",128);
     //m_memReqQ = new MemRequestQ( this, maxPending, maxPending/numSrc, numSrc );
     m_memReqQ = loadComponentExtension<MemRequestQ>( this, maxPending, maxPending/numSrc, numSrc );
@@ -248,25 +273,41 @@ void RdmaNic::processThreadCmdQs( ) {
 && ! m_memReqQ->full( m_tailWriteQnum ) ) {
 #endif
 
-    if ( NULL == m_activeNicCmd && ! m_nicCmdQ.empty() ) {
+	for ( int i = 0; i < m_cmdBatchSize; i++ ) {
+    	if ( NULL == m_activeNicCmd && ! m_nicCmdQ.empty() ) {
 
-		m_activeNicCmd = m_nicCmdQ.front();
-		m_nicCmdQ.pop();
+			m_activeNicCmd = m_nicCmdQ.front();
+			m_nicCmdQ.pop();
 
-		NicCmdQueueInfo& info = m_nicCmdQueueV[m_activeNicCmd->getThread()];
+			NicCmdQueueInfo& info = m_nicCmdQueueV[m_activeNicCmd->getThread()];
 
-		dbg.debug( CALL_INFO_LONG,1,DBG_X_FLAG,"thread %d cmd available tail=%d %s\n",m_activeNicCmd->getThread(),info.localTailIndex, m_activeNicCmd->name().c_str() );
+			dbg.debug( CALL_INFO_LONG,1,DBG_X_FLAG,"thread %d cmd available tail=%d %s\n",m_activeNicCmd->getThread(),info.localTailIndex, m_activeNicCmd->name().c_str() );
 
-        ++info.localTailIndex;
-        info.localTailIndex %= m_backing->getCmdQSize();
-        dbg.debug( CALL_INFO_LONG,1,DBG_X_FLAG,"write tail=%d at %#" PRIx64 "\n",info.localTailIndex, info.tailAddr );
-        m_memReqQ->write( m_tailWriteQnum, info.tailAddr, 4, info.localTailIndex );
-    }
-	if ( m_activeNicCmd ) {
-		if ( m_activeNicCmd->process() ) {
-			dbg.debug( CALL_INFO_LONG,1,DBG_X_FLAG,"command %s has finished\n",m_activeNicCmd->name().c_str());
-			delete m_activeNicCmd;
-			m_activeNicCmd = NULL;
+        	++info.localTailIndex;
+        	info.localTailIndex %= m_backing->getCmdQSize();
+			info.tailDirty = true;
+
+			// the last command of a batch carries the tail write
+			if ( i + 1 == m_cmdBatchSize ) {
+				writeCmdQTails();
+			}
+    	}
+		if ( NULL == m_activeNicCmd || ! m_activeNicCmd->process() ) {
+			break;
+		}
+		dbg.debug( CALL_INFO_LONG,1,DBG_X_FLAG,"command %s has finished\n",m_activeNicCmd->name().c_str());
+		delete m_activeNicCmd;
+		m_activeNicCmd = NULL;
+	}
+	writeCmdQTails();
+}
+
+void RdmaNic::writeCmdQTails( ) {
+	for ( auto& info : m_nicCmdQueueV ) {
+		if ( info.tailDirty ) {
+        	dbg.debug( CALL_INFO_LONG,1,DBG_X_FLAG,"write tail=%d at %#" PRIx64 "\n",info.localTailIndex, info.tailAddr );
+        	m_memReqQ->write( m_tailWriteQnum, info.tailAddr, 4, info.localTailIndex );
+			info.tailDirty = false;
 		}
 	}
 }
@@ -16,8 +16,12 @@
 #ifndef MEMHIERARCHY_SHMEM_NIC_H
 #define MEMHIERARCHY_SHMEM_NIC_H
 
+#include <algorithm>
 #include <list>
+#include <map>
 #include <queue>
+#include <unordered_map>
+#include <vector>
 #include <sst/core/sst_types.h>
 
 #include <sst/core/component.h>
@@ -61,7 +65,10 @@ class RdmaNic : public SST::Component {
         { "hostCmdQ",  "",   "request", 1 },
         { "headUpdateQ",  "",   "request", 1 },
         { "FamGetLatency",  "",   "request", 1 },
-        { "hostToNicLatency",  "",   "request", 1 }
+        { "hostToNicLatency",  "",   "request", 1 },
+        { "iotlbHits",  "DMA requests whose page translation was in the IOTLB or a pinned memory region",   "request", 1 },
+        { "iotlbMisses",  "translation requests sent to the host on IOTLB misses",   "request", 1 },
+        { "iotlbEvictions",  "IOTLB entries replaced",   "entry", 1 }
     )
 
     SST_ELI_DOCUMENT_PORTS({ "dma", "Connects the NIC to a cache for DMA", {} },
@@ -113,21 +120,25 @@ class RdmaNic : public SST::Component {
 
   private:
 
+	#include "rdmaNicIotlb.h"
 	#include "rdmaNicMemRequest.h"
 	#include "rdmaNicMemRequestQ.h"
 
+    Iotlb* m_iotlb;
     MemRequestQ* m_memReqQ;
     int m_tailWriteQnum;
     int m_respQueueMemChannel;
     int m_dmaMemChannel;
 
     struct NicCmdQueueInfo {
-        NicCmdQueueInfo( ){}
+        NicCmdQueueInfo( ) : tailDirty(false) {}
         NicCmdQueueInfo( uint64_t  tailAddr ) :
-            tailAddr(tailAddr), localTailIndex(0) {}
+            tailAddr(tailAddr), localTailIndex(0), tailDirty(false) {}
 
         uint64_t  tailAddr;
         uint32_t  localTailIndex;
+        // the tail index has moved since it was last written to the host
+        bool      tailDirty;
     };
     std::vector<NicCmdQueueInfo> m_nicCmdQueueV;
 
@@ -283,6 +294,7 @@ class RdmaNic : public SST::Component {
 
     virtual bool clock( SST::Cycle_t );
     void processThreadCmdQs();
+    void writeCmdQTails();
     void sendRespToHost( Addr_t, NicResp&,int thread );
 	void writeCompletionToHost(int thread, int cqId, RdmaCompletion& comp );
 
@@ -345,6 +357,7 @@ class RdmaNic : public SST::Component {
 	Barrier* m_barrier;
 
 	NicCmdEntry* m_activeNicCmd;
+	int m_cmdBatchSize;
 	// place for command from the host as they are written into MMIO space
 	// this is used to preserve order
 	std::queue< NicCmdEntry* > m_nicCmdQ;
@@ -381,6 +394,7 @@ class RdmaNic : public SST::Component {
 		case RdmaMemWrite: return "RdmaMemWrite";
 		case RdmaMemRead: return "RdmaMemRead";
 		case RdmaBarrier: return "RdmaBarrier";
+		case RdmaSendInline: return "RdmaSendInline";
 		default: return "Unknown RDMA command";
 		}
 	}
@@ -411,6 +425,8 @@ class RdmaNic : public SST::Component {
 			return new RdmaMemReadCmd( nic, thread, cmd );
 	  	case RdmaBarrier:
 			return new RdmaBarrierCmd( nic, thread, cmd );
+	  	case RdmaSendInline:
+			return new RdmaSendInlineCmd( nic, thread, cmd );
         default:
 		    dbg.output(CALL_INFO_LONG,"Error: thread=%d %d\n",thread,cmd->type);
 		    assert(0);
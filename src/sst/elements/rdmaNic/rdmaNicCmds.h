@@ -29,7 +29,9 @@ class NicCmdEntry {
     }
     virtual bool process( ) {
         m_nic.dbg.debug( CALL_INFO_LONG,1,DBG_X_FLAG,"%s respAddr=%#" PRIx64 " retval=%x\n", name().c_str(), m_respAddr, m_resp.retval );
-        m_nic.sendRespToHost( m_respAddr, m_resp, m_thread );
+        if ( m_respAddr ) {
+            m_nic.sendRespToHost( m_respAddr, m_resp, m_thread );
+        }
         return true;
     }
     virtual bool isRecv() { return false; }
@@ -150,6 +152,24 @@ class RdmaSendCmd : public NicCmdEntry {
     virtual std::string name() { return "Send"; }
 };
 
+class RdmaSendInlineCmd : public NicCmdEntry {
+  public:
+	RdmaSendInlineCmd( RdmaNic& nic, int thread, NicCmd* x ) : NicCmdEntry(nic,thread,x)
+	{
+		m_nic.dbg.debug( CALL_INFO_LONG,1,DBG_X_FLAG,"pe=%d node=%d len=%d ctx=%#" PRIx64 "\n",
+            m_cmd->data.sendInline.pe, m_cmd->data.sendInline.node, m_cmd->data.sendInline.len, m_cmd->data.sendInline.context );
+
+		if ( m_cmd->data.sendInline.len > RDMA_MAX_INLINE ) {
+			m_nic.out.fatal(CALL_INFO_LONG, -1, "%s, Error: inline send of %d bytes is bigger than %d\n",
+					m_nic.getName().c_str(), m_cmd->data.sendInline.len, RDMA_MAX_INLINE );
+		}
+    	m_nic.m_sendEngine->add( 0, new InlineSendEntry( m_cmd, m_thread ) );
+    	// passed the cmd to the SendEntry
+        m_cmd = NULL;
+    }
+    virtual std::string name() { return "SendInline"; }
+};
+
 class RdmaRecvCmd : public NicCmdEntry {
   public:
 	RdmaRecvCmd( RdmaNic& nic, int thread, NicCmd* x ) : NicCmdEntry(nic,thread,x)
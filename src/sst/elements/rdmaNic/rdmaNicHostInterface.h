@@ -16,13 +16,17 @@
 typedef Addr_t Context;
 typedef int QueueIndex;
 typedef enum { RdmaDone=0, RdmaSend=1, RdmaRecv, RdmaFini, RdmaCreateCQ, RdmaDestroyCQ, RdmaCreateRQ,
-                    RdmaDestroyRQ, RdmaMemRgnReg, RdmaMemRgnUnreg, RdmaMemWrite, RdmaMemRead, RdmaBarrier } RdmaCmd;
+                    RdmaDestroyRQ, RdmaMemRgnReg, RdmaMemRgnUnreg, RdmaMemWrite, RdmaMemRead, RdmaBarrier, RdmaSendInline } RdmaCmd;
 
 typedef int MemRgnKey;
 typedef int RecvQueueKey;
 typedef int RecvQueueId;
 typedef int CompQueueId;
 
+// payload bytes that fit in a RdmaSendInline command
+#define RDMA_MAX_INLINE 20
+
+// a command with a respAddr of 0 is unsignalled, the NIC does not write a NicResp for it
 
 typedef struct __attribute__((aligned(64))) {
 	RdmaCmd type;
@@ -65,6 +69,15 @@ typedef struct __attribute__((aligned(64))) {
 			CompQueueId cqId;
 			Context context;
         } send;
+        struct {
+			int node;
+            int pe;
+			RecvQueueKey rqKey;
+			CompQueueId cqId;
+			Context context;
+            uint32_t len;
+            uint8_t data[RDMA_MAX_INLINE];
+        } sendInline;
         struct {
             Addr_t addr;
             uint32_t len;
@@ -0,0 +1,112 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+    // IOTLB of the NIC's address translation service. Every DMA request
+    // needs the translation of its page. A miss starts a translation request
+    // to the host, which completes after a fixed latency, and the request
+    // waits until then. A limited number of translation requests can be
+    // outstanding. If pinning is on, the pages of registered memory regions
+    // are translated at registration and never miss.
+    class Iotlb {
+      public:
+        Iotlb( int entries, uint64_t pageSize, SimTime_t missLatency, int maxWalks, bool pinRegions,
+                Statistic<uint64_t>* hits, Statistic<uint64_t>* misses, Statistic<uint64_t>* evictions ) :
+            m_entries(entries), m_pageSize(pageSize), m_missLatency(missLatency), m_maxWalks(maxWalks),
+            m_pinRegions(pinRegions), m_statHits(hits), m_statMisses(misses), m_statEvictions(evictions) {}
+
+        // returns true if the translation for addr is available at time now (ns)
+        bool translate( Addr_t addr, SimTime_t now ) {
+            Addr_t page = addr / m_pageSize;
+
+            if ( isPinned( page ) ) {
+                m_statHits->addData(1);
+                return true;
+            }
+
+            auto iter = m_map.find( page );
+            if ( iter != m_map.end() ) {
+                m_lru.splice( m_lru.begin(), m_lru, iter->second );
+                m_statHits->addData(1);
+                return true;
+            }
+
+            auto walk = m_walks.find( page );
+            if ( walk != m_walks.end() ) {
+                if ( now < walk->second ) {
+                    return false;
+                }
+                m_walks.erase( walk );
+                insert( page );
+                return true;
+            }
+
+            if ( m_walks.size() < m_maxWalks ) {
+                m_statMisses->addData(1);
+                m_walks[page] = now + m_missLatency;
+            }
+            return false;
+        }
+
+        void addRegion( Addr_t addr, size_t length ) {
+            if ( m_pinRegions && length ) {
+                m_pinned.push_back( std::make_pair( addr / m_pageSize, ( addr + length - 1 ) / m_pageSize ) );
+            }
+        }
+
+        void removeRegion( Addr_t addr, size_t length ) {
+            if ( m_pinRegions && length ) {
+                auto range = std::make_pair( addr / m_pageSize, ( addr + length - 1 ) / m_pageSize );
+                auto iter = std::find( m_pinned.begin(), m_pinned.end(), range );
+                if ( iter != m_pinned.end() ) {
+                    m_pinned.erase( iter );
+                }
+            }
+        }
+
+      private:
+        bool isPinned( Addr_t page ) {
+            for ( auto& range : m_pinned ) {
+                if ( page >= range.first && page <= range.second ) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void insert( Addr_t page ) {
+            if ( m_map.size() == m_entries ) {
+                m_map.erase( m_lru.back() );
+                m_lru.pop_back();
+                m_statEvictions->addData(1);
+            }
+            m_lru.push_front( page );
+            m_map[page] = m_lru.begin();
+        }
+
+        std::list<Addr_t> m_lru;
+        std::unordered_map< Addr_t, std::list<Addr_t>::iterator > m_map;
+        std::map< Addr_t, SimTime_t > m_walks;
+        std::vector< std::pair<Addr_t,Addr_t> > m_pinned;
+
+        size_t m_entries;
+        uint64_t m_pageSize;
+        SimTime_t m_missLatency;
+        size_t m_maxWalks;
+        bool m_pinRegions;
+
+        Statistic<uint64_t>* m_statHits;
+        Statistic<uint64_t>* m_statMisses;
+        Statistic<uint64_t>* m_statEvictions;
+    };
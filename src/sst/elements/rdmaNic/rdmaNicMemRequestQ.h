@@ -256,6 +256,11 @@
                             }
                         }
 
+                        // wait for the translation of the page, other sources can go ahead
+                        if ( Nic().m_iotlb && ! Nic().m_iotlb->translate( q.front()->addr, getCurrentSimTimeNano() ) ) {
+                            continue;
+                        }
+
                         ++m_reqSrcQs[pos].pendingCnts;
 
                         sendReq( q.front());
@@ -133,6 +133,14 @@ void RdmaNic::RecvEngine::processMsgHdr( RdmaNicNetworkEvent* pkt )
 	m_recvStreamMap[ calcNodeStreamId( pkt->getSrcNode(), pkt->getStreamId() ) ] = new RecvStream( nic, destAddr, hdr->payloadLength, entry );
 
 }
+void RdmaNic::RecvEngine::checkMemRgnBounds( MemRgnEntry* entry, MemRgnKey key, int offset, int length )
+{
+	if ( offset < 0 || length < 0 || (size_t) offset + length > entry->getPayloadLength() ) {
+		nic.out.fatal(CALL_INFO_LONG, -1, "%s, Error: access offset=%d length=%d is outside memory region key=%#x (%zu)\n",
+					nic.getName().c_str(), offset, length, key, entry->getPayloadLength() );
+	}
+}
+
 void RdmaNic::RecvEngine::processWriteHdr( RdmaNicNetworkEvent* pkt )
 {
     StreamHdr* hdr = (StreamHdr*) pkt->getData().data();
@@ -145,11 +153,11 @@ void RdmaNic::RecvEngine::processWriteHdr( RdmaNicNetworkEvent* pkt )
 		nic.out.fatal(CALL_INFO_LONG, -1, "%s, Error: could not find memory region with key %#x\n", nic.getName().c_str(), hdr->data.rdma.memRgnKey);
 	}
 
-// FIXME check for length violation
+	checkMemRgnBounds( entry, hdr->data.rdma.memRgnKey, hdr->data.rdma.offset, hdr->payloadLength );
 
 	Addr_t destAddr = entry->getAddr() + hdr->data.rdma.offset;
     nic.dbg.debug(CALL_INFO_LONG,1,DBG_X_FLAG,"destAddr=%#" PRIx64 "\n", destAddr );
-	m_recvStreamMap[ calcNodeStreamId( pkt->getSrcNode(), pkt->getStreamId() ) ] = new RecvStream( nic, destAddr, hdr->payloadLength, entry );
+	m_recvStreamMap[ calcNodeStreamId( pkt->getSrcNode(), pkt->getStreamId() ) ] = new RecvStream( nic, destAddr, hdr->payloadLength, entry, false );
 }
 
 void RdmaNic::RecvEngine::processReadReqHdr( RdmaNicNetworkEvent* pkt )
@@ -163,6 +171,8 @@ void RdmaNic::RecvEngine::processReadReqHdr( RdmaNicNetworkEvent* pkt )
 	} catch ( std::exception& e ) {
 		nic.out.fatal(CALL_INFO_LONG, -1, "%s, Error: could not find memory region with key %#x\n", nic.getName().c_str(), hdr->data.rdma.memRgnKey);
 	}
+	checkMemRgnBounds( memRgnEntry, hdr->data.rdma.memRgnKey, hdr->data.rdma.offset, hdr->data.rdma.readLength );
+
 	Addr_t srcAddr = memRgnEntry->getAddr() + hdr->data.rdma.offset;
 
 	m_recvStreamMap[ calcNodeStreamId( pkt->getSrcNode(), pkt->getStreamId() ) ] = new RecvStream( nic, 0, 0, NULL );
@@ -184,7 +194,10 @@ void RdmaNic::RecvEngine::processReadRespHdr( RdmaNicNetworkEvent* pkt )
 		nic.out.fatal(CALL_INFO_LONG, -1, "%s, Error: could not find read response buffer with key %#x\n", nic.getName().c_str(), hdr->data.rdma.readRespKey);
 	}
 
-// FIXME check for length violation
+	if ( entry->getPayloadLength() < hdr->payloadLength ) {
+		nic.out.fatal(CALL_INFO_LONG, -1, "%s, Error: read response key=%#x (%d) is too big for read buffer (%zu)\n",
+					nic.getName().c_str(), hdr->data.rdma.readRespKey, hdr->payloadLength, entry->getPayloadLength() );
+	}
 
 	m_readRespMap.erase( hdr->data.rdma.readRespKey );
 	m_recvStreamMap[ calcNodeStreamId( pkt->getSrcNode(), pkt->getStreamId() ) ] = new RecvStream( nic, entry->getAddr(), hdr->payloadLength, entry );
@@ -215,7 +228,7 @@ void RdmaNic::RecvStream::writeResp( int thread, StandardMem::Request* req ) {
 }
 
 RdmaNic::RecvStream::~RecvStream() {
-	if ( recvEntry ) {
+	if ( recvEntry && ownsEntry ) {
     	nic.dbg.debug( CALL_INFO_LONG,1,DBG_X_FLAG,"cqId=%d\n",recvEntry->getCqId());
 		if ( -1 != recvEntry->getCqId() ) {
     		RdmaCompletion comp;
@@ -76,8 +76,9 @@ class RecvQueue {
 class RecvStream {
   public:
 	// we don't need destAddr and lenght, we can get them from entry
-	RecvStream( RdmaNic& nic, Addr_t destAddr, size_t length, RecvEntry* entry = NULL ) :
-			nic(nic), destAddr(destAddr), length(length), offset(0), recvEntry(entry), bytesWritten(0), callback(NULL) {
+	// a memory region entry stays registered after the stream, so the stream only owns the entry if ownsEntry is set
+	RecvStream( RdmaNic& nic, Addr_t destAddr, size_t length, RecvEntry* entry = NULL, bool ownsEntry = true ) :
+			nic(nic), destAddr(destAddr), length(length), offset(0), recvEntry(entry), ownsEntry(ownsEntry), bytesWritten(0), callback(NULL) {
 		if ( entry ) {
 			callback = new MemRequest::Callback;
 			*callback = std::bind( &RdmaNic::RecvStream::writeResp, this, recvEntry->getThread(), std::placeholders::_1 );
@@ -100,6 +101,7 @@ class RecvStream {
     MemRequest::Callback* callback;
 
 	RecvEntry* recvEntry;
+	bool ownsEntry;
 	Addr_t destAddr;
 	size_t length;
    	std::queue<StandardMem::ReadResp*> respQ;
@@ -118,6 +120,11 @@ class RecvEngine {
 		if ( m_memRegionMap.find( key ) == m_memRegionMap.end() ) {
 			assert(0);
 		}
+		MemRgnEntry* entry = m_memRegionMap[key];
+		if ( nic.m_iotlb ) {
+			nic.m_iotlb->removeRegion( entry->getAddr(), entry->getPayloadLength() );
+		}
+		delete entry;
 		m_memRegionMap.erase(key);
 		return 0;
 	}
@@ -125,6 +132,9 @@ class RecvEngine {
 		// need to check this slot is empty
 		if ( m_memRegionMap.find( entry->getKey() ) == m_memRegionMap.end() ) {
 			m_memRegionMap[ entry->getKey() ] = entry;
+			if ( nic.m_iotlb ) {
+				nic.m_iotlb->addRegion( entry->getAddr(), entry->getPayloadLength() );
+			}
 			return 0;
 		}else{
 			return -1;
@@ -161,6 +171,7 @@ class RecvEngine {
 	void processWriteHdr( RdmaNicNetworkEvent* );
 	void processReadReqHdr( RdmaNicNetworkEvent* );
 	void processReadRespHdr( RdmaNicNetworkEvent* );
+	void checkMemRgnBounds( MemRgnEntry*, MemRgnKey, int offset, int length );
 	void processPayloadPkt( RdmaNicNetworkEvent* );
 
     void processQueuedPkts( std::queue< RdmaNicNetworkEvent* >& );
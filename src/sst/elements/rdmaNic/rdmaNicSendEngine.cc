@@ -37,7 +37,12 @@ RdmaNic::SendStream::SendStream( RdmaNic& nic, SendEntry* entry ) : m_nic(nic),
     }
 
 	// calculate the number of memory reads will will need
-	if ( entry->getLength() ) {
+	if ( entry->getInlineData() && entry->getLength() ) {
+		// the payload came with the command, it fits in the first packet
+		m_pkt->getData().insert( m_pkt->getData().end(), entry->getInlineData(), entry->getInlineData() + entry->getLength() );
+		m_offset = entry->getLength();
+		m_pkt = queuePkt( m_pkt );
+	} else if ( entry->getLength() ) {
     	// how many bytes from the address to the first cache line boundary,
     	// this may be more the total length of data
     	// this may be 0 if algined
@@ -109,7 +114,7 @@ bool RdmaNic::SendStream::process()
 	// send read requests if we need to and if we are not blocked
 	if ( m_offset < m_sendEntry->getLength() && ! m_nic.m_memReqQ->full( m_nic.m_dmaMemChannel ) ) {
 
-    	m_nic.dbg.debug( CALL_INFO_LONG,1,DBG_X_FLAG,"pe=%d node=%d addr=%" PRIx32 " len=%d offset=%zu\n",
+    	m_nic.dbg.debug( CALL_INFO_LONG,1,DBG_X_FLAG,"pe=%d node=%d addr=%" PRIx64 " len=%d offset=%zu\n",
             m_sendEntry->getDestPid(), m_sendEntry->getDestNode(), m_sendEntry->getAddr(), m_sendEntry->getLength(), m_offset );
 
        	uint64_t addr = m_sendEntry->getAddr() + m_offset;
@@ -22,12 +22,14 @@ class SendEntry {
 		}
 	}
 	StreamHdr* getStreamHdr() { return &m_streamHdr; }
-	virtual int getAddr() = 0;
+	virtual Addr_t getAddr() = 0;
 	virtual int getLength() = 0;
 	virtual int getCqId() = 0;
 	virtual int getContext() = 0;
 	virtual int getDestNode() = 0;
 	virtual int getDestPid() = 0;
+	// payload carried in the command itself, the send does not read it from host memory
+	virtual const uint8_t* getInlineData() { return NULL; }
 	int getThread() { return thread; }
 	int getVC() { return vc; }
   protected:
@@ -45,7 +47,7 @@ class MsgSendEntry : public SendEntry {
     	m_streamHdr.payloadLength = cmd->data.send.len;
 	}
 	int getCqId() { return cmd->data.send.cqId; }
-	int getAddr() { return cmd->data.send.addr; }
+	Addr_t getAddr() { return cmd->data.send.addr; }
 	int getLength() { return cmd->data.send.len; }
 	int getContext() { return cmd->data.send.context; }
 	int getDestNode() { return cmd->data.send.node; }
@@ -53,6 +55,22 @@ class MsgSendEntry : public SendEntry {
   private:
 };
 
+class InlineSendEntry : public SendEntry {
+  public:
+    InlineSendEntry( NicCmd* cmd, int thread ) : SendEntry(thread,cmd) {
+    	m_streamHdr.type = StreamHdr::Msg;
+    	m_streamHdr.data.msgKey = cmd->data.sendInline.rqKey;
+    	m_streamHdr.payloadLength = cmd->data.sendInline.len;
+	}
+	int getCqId() { return cmd->data.sendInline.cqId; }
+	Addr_t getAddr() { return 0; }
+	int getLength() { return cmd->data.sendInline.len; }
+	int getContext() { return cmd->data.sendInline.context; }
+	int getDestNode() { return cmd->data.sendInline.node; }
+	int getDestPid() { return cmd->data.sendInline.pe; }
+	const uint8_t* getInlineData() { return cmd->data.sendInline.data; }
+};
+
 class WriteSendEntry : public SendEntry {
   public:
     WriteSendEntry( NicCmd* cmd, int thread ): SendEntry(thread,cmd) {
@@ -62,7 +80,7 @@ class WriteSendEntry : public SendEntry {
     	m_streamHdr.payloadLength = cmd->data.write.len;
 	}
 	int getLength() { return cmd->data.write.len; }
-	int getAddr() { return cmd->data.write.srcAddr; }
+	Addr_t getAddr() { return cmd->data.write.srcAddr; }
 	int getCqId() { return cmd->data.write.cqId; }
 	int getContext() { return cmd->data.write.context; }
 	int getDestNode() { return cmd->data.write.node; }
@@ -82,7 +100,7 @@ class ReadSendEntry : public SendEntry {
 	// the read does send a completeion until the read completes so these are
 	// passed to the ReadRespRecvEntry
 	int getLength() { return 0; }
-	int getAddr() { return 0; }
+	Addr_t getAddr() { return 0; }
 	int getCqId() { return -1; }
 	int getContext() { return 0; }
 	int getDestNode() { return cmd->data.read.node; }
@@ -101,13 +119,13 @@ class ReadRespSendEntry : public SendEntry {
 	}
 
 	int getLength() { return m_length; }
-	int getAddr() { return m_srcAddr; }
+	Addr_t getAddr() { return m_srcAddr; }
 	int getCqId() { return -1; }
 	int getContext() { return 0; }
 	int getDestNode() { return m_destNode; }
 	int getDestPid() { return m_destPid; }
   private:
-	int m_srcAddr;
+	Addr_t m_srcAddr;
 	int m_length;
 	int m_destNode;
 	int m_destPid;
@@ -0,0 +1,220 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_REMOTE_MEM_OPS
+#define _H_REMOTE_MEM_OPS
+
+#include <sst/core/interfaces/stdMem.h>
+#include <sstream>
+#include <vector>
+
+namespace SST {
+namespace MemHierarchy {
+
+// Doorbell-batched read: several node reads to the same memory server
+// posted as one StandardMem::CustomReq. The memory server fills 'payload'
+// in place (entry i at offset i * entry_size) and returns the same object
+// in its CustomResp, so ownership ends with the requester.
+class BatchReadData : public SST::Interfaces::StandardMem::CustomData {
+public:
+    typedef uint64_t Addr;
+
+    BatchReadData(uint64_t entry_size) : CustomData(), entry_size(entry_size), is_response(false) {}
+    virtual ~BatchReadData() {}
+
+    void addRead(Addr addr) { addresses.push_back(addr); }
+
+    virtual Addr getRoutingAddress() override { return addresses.empty() ? 0 : addresses.front(); }
+
+    // Request carries one 8B descriptor per read, the response carries the data
+    virtual uint64_t getSize() override {
+        return is_response ? payload.size() : addresses.size() * sizeof(Addr);
+    }
+
+    virtual CustomData* makeResponse() override {
+        is_response = true;
+        return this;
+    }
+
+    virtual bool needsResponse() override { return true; }
+
+    virtual std::string getString() override {
+        std::ostringstream str;
+        str << std::hex << " Addr: 0x" << getRoutingAddress();
+        str << std::dec << " Reads: " << addresses.size() << " EntrySize: " << entry_size;
+        return str.str();
+    }
+
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        SST_SER(addresses);
+        SST_SER(payload);
+        SST_SER(entry_size);
+        SST_SER(is_response);
+    }
+    ImplementSerializable(SST::MemHierarchy::BatchReadData);
+
+    std::vector<Addr> addresses;
+    std::vector<uint8_t> payload;
+    uint64_t entry_size;
+    bool is_response;
+
+protected:
+    BatchReadData() {} // For serialization only
+};
+
+// One-sided 8B atomic on a remote word, modelled on the RDMA atomic verbs.
+// The memory server performs it in place and returns the same object with
+// 'result' holding the word's previous value.
+//
+//   ATOMIC_CAS: if (word == compare) word = operand
+//   ATOMIC_FAA: word += operand (always succeeds)
+class RemoteAtomicData : public SST::Interfaces::StandardMem::CustomData {
+public:
+    typedef uint64_t Addr;
+
+    enum Opcode { ATOMIC_CAS, ATOMIC_FAA };
+
+    RemoteAtomicData(Opcode opcode, Addr addr, uint64_t operand, uint64_t compare = 0) :
+        CustomData(), opcode(opcode), addr(addr), compare(compare), operand(operand),
+        result(0), success(false), is_response(false) {}
+    virtual ~RemoteAtomicData() {}
+
+    virtual Addr getRoutingAddress() override { return addr; }
+
+    // Request carries the operands, the response carries the old value
+    virtual uint64_t getSize() override {
+        if (is_response) return sizeof(uint64_t);
+        return (opcode == ATOMIC_CAS) ? 2 * sizeof(uint64_t) : sizeof(uint64_t);
+    }
+
+    virtual CustomData* makeResponse() override {
+        is_response = true;
+        return this;
+    }
+
+    virtual bool needsResponse() override { return true; }
+
+    virtual std::string getString() override {
+        std::ostringstream str;
+        str << (opcode == ATOMIC_CAS ? " CAS" : " FAA") << std::hex << " Addr: 0x" << addr;
+        if (opcode == ATOMIC_CAS) {
+            str << " Compare: 0x" << compare;
+        }
+        str << " Operand: 0x" << operand;
+        if (is_response) {
+            str << " Result: 0x" << result << (success ? " (done)" : " (failed)");
+        }
+        return str.str();
+    }
+
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        SST_SER(opcode);
+        SST_SER(addr);
+        SST_SER(compare);
+        SST_SER(operand);
+        SST_SER(result);
+        SST_SER(success);
+        SST_SER(is_response);
+    }
+    ImplementSerializable(SST::MemHierarchy::RemoteAtomicData);
+
+    Opcode opcode;
+    Addr addr;
+    uint64_t compare;       // CAS only
+    uint64_t operand;       // CAS: value stored on match, FAA: value added
+    uint64_t result;        // Value of the word before the operation
+    bool success;           // The word was updated
+    bool is_response;
+
+protected:
+    RemoteAtomicData() {} // For serialization only
+};
+
+// A whole B+tree search or insert shipped to a memory server (RPC offload).
+// The server walks from 'start' through the nodes it owns and returns the
+// same object with the outcome. The walk ends early with RPC_FORWARD when
+// the next node lives on another server, RPC_BUSY when a node is locked by
+// a one-sided writer, and RPC_LEAF_FULL when an insert needs a split; the
+// requester continues, retries, or falls back to one-sided access.
+class BTreeRpcData : public SST::Interfaces::StandardMem::CustomData {
+public:
+    typedef uint64_t Addr;
+
+    enum Opcode { RPC_SEARCH, RPC_INSERT };
+    enum Status { RPC_DONE, RPC_FORWARD, RPC_BUSY, RPC_LEAF_FULL };
+
+    BTreeRpcData(Opcode opcode, Addr start, uint32_t level, uint32_t tree_height, uint32_t fanout,
+                 uint64_t key, uint64_t value = 0) :
+        CustomData(), opcode(opcode), start(start), level(level), tree_height(tree_height), fanout(fanout),
+        key(key), value(value), status(RPC_DONE), found(false), result(0), nodes_visited(0), is_response(false) {}
+    virtual ~BTreeRpcData() {}
+
+    virtual Addr getRoutingAddress() override { return start; }
+
+    // Request carries the start node, key and value, the response the outcome
+    virtual uint64_t getSize() override {
+        return is_response ? 3 * sizeof(uint64_t) : 4 * sizeof(uint64_t);
+    }
+
+    virtual CustomData* makeResponse() override {
+        is_response = true;
+        return this;
+    }
+
+    virtual bool needsResponse() override { return true; }
+
+    virtual std::string getString() override {
+        std::ostringstream str;
+        str << (opcode == RPC_SEARCH ? " RPC_SEARCH" : " RPC_INSERT") << std::hex << " Start: 0x" << start;
+        str << std::dec << " Key: " << key;
+        if (is_response) {
+            str << " Status: " << status << " Visited: " << nodes_visited;
+        }
+        return str.str();
+    }
+
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        SST_SER(opcode);
+        SST_SER(start);
+        SST_SER(level);
+        SST_SER(tree_height);
+        SST_SER(fanout);
+        SST_SER(key);
+        SST_SER(value);
+        SST_SER(status);
+        SST_SER(found);
+        SST_SER(result);
+        SST_SER(nodes_visited);
+        SST_SER(is_response);
+    }
+    ImplementSerializable(SST::MemHierarchy::BTreeRpcData);
+
+    Opcode opcode;
+    Addr start;             // Node the walk starts at; the node it stopped at in the response
+    uint32_t level;         // Tree level of 'start'
+    uint32_t tree_height;   // Nodes at level tree_height - 1 are leaves
+    uint32_t fanout;
+    uint64_t key;
+    uint64_t value;         // Insert only
+    Status status;
+    bool found;             // Search only: key present, 'result' holds its value
+    uint64_t result;
+    uint32_t nodes_visited; // Nodes read by the server for this request
+    bool is_response;
+
+protected:
+    BTreeRpcData() {} // For serialization only
+};
+
+} // namespace MemHierarchy
+} // namespace SST
+
+#endif // _H_REMOTE_MEM_OPS
@@ -47,6 +47,13 @@ int rdma_destroy_rq( RecvQueueId );
 // Context is a void* that will be returned in the Completion Event
 int rdma_send_post( void* buf, size_t len, Node, Pid, RecvQueueKey, CompQueueId, Context );
 
+// post a send whose payload is copied into the command, len must be at most RDMA_MAX_INLINE
+int rdma_send_post_inline( void* buf, size_t len, Node, Pid, RecvQueueKey, CompQueueId, Context );
+
+// signal only every interval-th send, write or read post, the others return without waiting
+// for the NIC and do not post a completion, the default interval of 1 signals every post
+void rdma_set_signal_interval( int interval );
+
 // post a buffer into receive queue, it can receive from any source
 int rdma_recv_post( void* buf, size_t len, RecvQueueId, Context );
 
@@ -40,6 +40,9 @@ typedef struct {
 static CompletionQ s_compQ[NUM_COMP_Q];
 static int s_curCompIndex = 0;
 
+static int s_signalInterval = 1;
+static int s_postCount = 0;
+
 static int waitResp( NicResp* );
 static NicResp* getResp(NicCmd* cmd );
 
@@ -108,6 +111,42 @@ void freeCmd( NicCmd* cmd ) {
 #endif
 }
 
+void rdma_set_signal_interval( int interval ) {
+	assert( interval > 0 );
+	s_signalInterval = interval;
+	s_postCount = 0;
+}
+
+// returns 1 if this post is signalled
+static int signalPost( void ) {
+	if ( ++s_postCount < s_signalInterval ) {
+		return 0;
+	}
+	s_postCount = 0;
+	return 1;
+}
+
+// post a command, an unsignalled command has no response to wait for
+static int postCmd( NicCmd* cmd, int signalled ) {
+	int retval = 0;
+	if ( ! signalled ) {
+		cmd->respAddr = 0;
+	}
+
+	writeCmd( cmd );
+
+	if ( signalled ) {
+		NicResp* resp = getResp(cmd);
+
+		waitResp( resp );
+		retval = resp->retval;
+		dbgPrint("retval=%d\n",retval);
+	}
+
+	freeCmd(cmd);
+	return retval;
+}
+
 void rdma_fini( void ) {
 
 	NicCmd* cmd = allocCmd();
@@ -253,19 +292,34 @@ int rdma_send_post( void* buf, size_t len, Node destNode, Pid destPid, RecvQueue
 	cmd->data.send.addr = (Addr_t)buf;
 	cmd->data.send.len = len;
 	cmd->data.send.rqKey = rqKey;
-	cmd->data.send.cqId = cqId;
 	cmd->data.send.context = context;
 
-	writeCmd( cmd );
+	int signalled = signalPost();
+	cmd->data.send.cqId = signalled ? cqId : -1;
 
-	NicResp* resp = getResp(cmd);
+	return postCmd( cmd, signalled );
+}
 
-	waitResp( resp );
-	int retval = resp->retval;
-	dbgPrint("retval=%d\n",retval);
+int rdma_send_post_inline( void* buf, size_t len, Node destNode, Pid destPid, RecvQueueKey rqKey, CompQueueId cqId, Context context )
+{
+	assert( len <= RDMA_MAX_INLINE );
 
-	freeCmd(cmd);
-	return retval;
+	NicCmd* cmd = allocCmd();
+
+	dbgPrint("ptr=%p len=%zu destNode=%d destPid=%d cmdbuf=%p context=%#" PRIxBITS "\n", buf,len,destNode,destPid,cmd,context);
+
+	cmd->type = RdmaSendInline;
+	cmd->data.sendInline.pe = destPid;
+	cmd->data.sendInline.node = destNode;
+	cmd->data.sendInline.len = len;
+	cmd->data.sendInline.rqKey = rqKey;
+	cmd->data.sendInline.context = context;
+	memcpy( cmd->data.sendInline.data, buf, len );
+
+	int signalled = signalPost();
+	cmd->data.sendInline.cqId = signalled ? cqId : -1;
+
+	return postCmd( cmd, signalled );
 }
 
 int rdma_recv_post( void* buf, size_t len, RecvQueueId rqId, Context context )
@@ -368,20 +422,14 @@ int rdma_memory_write( MemRgnKey key, Node node, Pid pid, size_t offset, void* s
 	cmd->data.write.offset = offset;
 	cmd->data.write.srcAddr = (Addr_t) srcBuffer;
 	cmd->data.write.len = length;
-	cmd->data.write.cqId = id;
 	cmd->data.write.context = context;
 	cmd->data.write.pe = pid;
 	cmd->data.write.node = node;
 
-	writeCmd( cmd );
-
-	NicResp* resp = getResp(cmd);
-
-	waitResp( resp );
-	int retval = resp->retval;
-	dbgPrint(" retval=%d\n",retval);
+	int signalled = signalPost();
+	cmd->data.write.cqId = signalled ? id : -1;
 
-	freeCmd(cmd);
+	postCmd( cmd, signalled );
 	return 0;
 }
 
@@ -396,20 +444,14 @@ int rdma_memory_read( MemRgnKey key, Node node, Pid pid, size_t offset, void* de
 	cmd->data.read.offset = offset;
 	cmd->data.read.destAddr = (Addr_t) destBuffer;
 	cmd->data.read.len = length;
-	cmd->data.read.cqId = id;
 	cmd->data.read.context = context;
 	cmd->data.read.pe = pid;
 	cmd->data.read.node = node;
 
-	writeCmd( cmd );
-
-	NicResp* resp = getResp(cmd);
-
-	waitResp( resp );
-	int retval = resp->retval;
-	dbgPrint("retval=%d\n",retval);
+	int signalled = signalPost();
+	cmd->data.read.cqId = signalled ? id : -1;
 
-	freeCmd(cmd);
+	postCmd( cmd, signalled );
 	return 0;
 }
 
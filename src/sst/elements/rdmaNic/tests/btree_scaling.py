@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""
+Scaling configuration for the disaggregated B+tree.
+Every compute server reaches every memory server, so all clients share one
+tree. With --topology direct each pair gets its own link; with --topology
+network every server has one MemNIC on a single merlin router and requests
+are routed by address. Parameters come from --model-options, e.g.
+
+  sst btree_scaling.py --model-options="--compute 16 --memory 4 --alpha 0.99"
+  sst btree_scaling.py --model-options="--compute 64 --memory 64 --topology network"
+
+btree_scaling_sweep.py runs this over a grid of points and collects one CSV.
+
+Compute servers allocate split nodes independently, so shared-tree runs
+should bulk load the tree (the default) and keep writes a small fraction.
+"""
+
+import argparse
+import sys
+
+import sst
+
+parser = argparse.ArgumentParser(prog="btree_scaling.py")
+parser.add_argument("--compute", type=int, default=1, help="compute servers (1-64)")
+parser.add_argument("--memory", type=int, default=1, help="memory servers")
+parser.add_argument("--topology", default="direct", choices=["direct", "network"])
+parser.add_argument("--network-bw", default="25GB/s", help="router link bandwidth (network topology)")
+parser.add_argument("--fanout", type=int, default=16)
+parser.add_argument("--alpha", type=float, default=0.99, help="Zipfian theta, 0 for uniform")
+parser.add_argument("--read-ratio", type=float, default=0.95)
+parser.add_argument("--key-range", type=int, default=100000)
+parser.add_argument("--bulk-load", type=int, default=-1, help="keys to preload (-1 = key range)")
+parser.add_argument("--ops-per-second", type=int, default=1000000, help="offered load per compute server")
+parser.add_argument("--load-mode", default="fixed", choices=["fixed", "open", "closed"])
+parser.add_argument("--max-inflight", type=int, default=0, help="open loop in-flight cap per compute server")
+parser.add_argument("--clients", type=int, default=1, help="closed loop clients per compute server")
+parser.add_argument("--duration-us", type=int, default=200)
+parser.add_argument("--link-latency", default="1us")
+parser.add_argument("--index-cache", type=int, default=0)
+parser.add_argument("--read-batch", type=int, default=1)
+parser.add_argument("--concurrency", default="none", choices=["none", "optimistic"])
+parser.add_argument("--placement", default="round_robin")
+parser.add_argument("--wal-group", type=int, default=0, help="log inserts with this group commit size (0 = no log)")
+parser.add_argument("--cpu-cores", type=int, default=0, help="worker cores per compute server (0 = free node processing)")
+parser.add_argument("--stats", default="btree_scaling_stats.csv", help="statistics output file")
+args = parser.parse_args(sys.argv[1:])
+
+if not 1 <= args.compute <= 64:
+    sys.exit("--compute must be between 1 and 64")
+if args.memory < 1:
+    sys.exit("--memory must be at least 1")
+
+window_mb = 16
+bulk_keys = args.key_range if args.bulk_load < 0 else args.bulk_load
+
+computes = []
+for compute_id in range(args.compute):
+    compute = sst.Component("compute_%d" % compute_id, "rdmaNic.computeServer")
+    compute.addParams({
+        "verbose": 0,
+        "node_id": compute_id,
+        "num_memory_nodes": args.memory,
+        "operations_per_second": args.ops_per_second,
+        "simulation_duration_us": args.duration_us,
+        "read_ratio": args.read_ratio,
+        "key_distribution": "zipfian" if args.alpha > 0 else "uniform",
+        "zipfian_alpha": args.alpha,
+        "key_range": args.key_range,
+        "btree_fanout": args.fanout,
+        "bulk_load_keys": bulk_keys,
+        "index_cache_size": args.index_cache,
+        "read_batch_size": args.read_batch,
+        "concurrency_control": args.concurrency,
+        "placement_policy": args.placement,
+        "memory_server_window_mb": window_mb,
+        "cpu_cores": args.cpu_cores,
+        "load_mode": args.load_mode,
+        "max_inflight": args.max_inflight,
+        "closed_loop_clients": args.clients,
+        "wal_enabled": args.wal_group > 0,
+        "wal_group_size": max(args.wal_group, 1),
+    })
+    computes.append(compute)
+
+memories = []
+for memory_id in range(args.memory):
+    memory = sst.Component("memory_%d" % memory_id, "rdmaNic.memoryServer")
+    memory.addParams({
+        "verbose": 0,
+        "memory_server_id": memory_id,
+        "num_compute_nodes": args.compute,
+        "memory_server_window_mb": window_mb,
+    })
+    memories.append(memory)
+
+if args.topology == "direct":
+    for memory_id, memory in enumerate(memories):
+        for compute_id, compute in enumerate(computes):
+            compute_iface = compute.setSubComponent("mem_interface_%d" % memory_id, "memHierarchy.standardInterface")
+            memory_iface = memory.setSubComponent("mem_interface_%d" % compute_id, "memHierarchy.standardInterface")
+            link = sst.Link("link_c%d_m%d" % (compute_id, memory_id))
+            link.connect((compute_iface, "lowlink", args.link_latency), (memory_iface, "lowlink", args.link_latency))
+else:
+    router = sst.Component("network", "merlin.hr_router")
+    router.addParams({
+        "id": 0,
+        "num_ports": args.compute + args.memory,
+        "xbar_bw": args.network_bw,
+        "link_bw": args.network_bw,
+        "flit_size": "64B",
+        "input_buf_size": "4KB",
+        "output_buf_size": "4KB",
+    })
+    router.setSubComponent("topology", "merlin.singlerouter")
+
+    # Compute servers are group 1 and send to the memory servers in group 2
+    endpoints = [(c, 1) for c in computes] + [(m, 2) for m in memories]
+    for port, (component, group) in enumerate(endpoints):
+        iface = component.setSubComponent("mem_interface", "memHierarchy.standardInterface")
+        nic = iface.setSubComponent("lowlink", "memHierarchy.MemNIC")
+        nic.addParams({
+            "group": group,
+            "sources": "2" if group == 1 else "1",
+            "destinations": "2" if group == 1 else "1",
+            "network_bw": args.network_bw,
+        })
+        link = sst.Link("link_port%d" % port)
+        link.connect((nic, "port", args.link_latency), (router, "port%d" % port, "1ns"))
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputCSV", {"filepath": args.stats, "separator": ","})
+sst.enableAllStatisticsForAllComponents()
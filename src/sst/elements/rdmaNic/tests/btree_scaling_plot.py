@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+"""
+Plot throughput versus compute servers from btree_scaling_sweep.py output,
+one line per (memory servers, fanout, alpha) combination. Several CSVs can
+be given to overlay runs, e.g. a baseline and a change under test.
+
+  ./btree_scaling_plot.py baseline.csv scaling.csv -o scaling.png
+"""
+
+import argparse
+import csv
+import os
+from collections import defaultdict
+
+import matplotlib
+matplotlib.use("Agg")
+import matplotlib.pyplot as plt
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("csv", nargs="+")
+    parser.add_argument("-o", "--output", default="btree_scaling.png")
+    parser.add_argument("--metric", default="throughput_ops",
+                        help="column to plot (throughput_ops, search_p99_ns, network_bytes_per_op, ...)")
+    args = parser.parse_args()
+
+    fig, ax = plt.subplots(figsize=(8, 5))
+    for path in args.csv:
+        lines = defaultdict(list)
+        with open(path) as f:
+            for row in csv.DictReader(f):
+                label = "mem=%s fanout=%s alpha=%s" % (row["memory"], row["fanout"], row["alpha"])
+                lines[label].append((int(row["compute"]), float(row[args.metric])))
+        run = os.path.splitext(os.path.basename(path))[0]
+        for label, points in sorted(lines.items()):
+            points.sort()
+            ax.plot([p[0] for p in points], [p[1] for p in points], marker="o",
+                    label=label if len(args.csv) == 1 else "%s: %s" % (run, label))
+
+    ax.set_xscale("log", base=2)
+    ax.set_xlabel("compute servers")
+    ax.set_ylabel(args.metric)
+    ax.grid(True, which="both", alpha=0.3)
+    ax.legend(fontsize="small")
+    fig.tight_layout()
+    fig.savefig(args.output)
+    print("Wrote %s" % args.output)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+Sweep btree_scaling.py over compute servers, memory servers, fanout and
+Zipf alpha, and write one CSV row per point with throughput, p99 latency
+and network bytes per operation.
+
+  ./btree_scaling_sweep.py --compute 1,2,4,8,16,32,64 --memory 1,2,8 -o scaling.csv
+  ./btree_scaling_sweep.py --memory 8,32,64 -o network.csv -- --topology network
+
+Extra arguments after '--' go to every run (e.g. -- --index-cache 256).
+With --compare, the new results are checked against an earlier CSV and the
+script exits non-zero if throughput drops or p99 grows by more than
+--tolerance at any point both files share.
+"""
+
+import argparse
+import csv
+import itertools
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+CONFIG = os.path.join(os.path.dirname(os.path.abspath(__file__)), "btree_scaling.py")
+
+FIELDS = ["compute", "memory", "fanout", "alpha", "ops", "duration_us", "throughput_ops",
+          "search_p99_ns", "insert_p99_ns", "network_bytes_per_op", "round_trips_per_op"]
+KEY_FIELDS = ["compute", "memory", "fanout", "alpha"]
+
+LATENCY_LINE = re.compile(r"(search|insert|split-insert|scan):\s+n=(\d+) p50=(\d+) p99=(\d+)")
+
+
+def int_list(text):
+    return [int(v) for v in text.split(",")]
+
+
+def float_list(text):
+    return [float(v) for v in text.split(",")]
+
+
+def read_stats(path):
+    """Sum and count of every statistic, added up over components of a kind."""
+    totals = {}
+    with open(path) as f:
+        reader = csv.reader(f)
+        header = [h.strip() for h in next(reader)]
+        name = header.index("ComponentName")
+        stat = header.index("StatisticName")
+        total = next(i for i, h in enumerate(header) if h.startswith("Sum."))
+        count = next(i for i, h in enumerate(header) if h.startswith("Count."))
+        for row in reader:
+            kind = row[name].strip().split("_")[0]
+            key = (kind, row[stat].strip())
+            s, c = totals.get(key, (0, 0))
+            totals[key] = (s + int(row[total]), c + int(row[count]))
+    return totals
+
+
+def run_point(compute, memory, fanout, alpha, args, extra):
+    with tempfile.TemporaryDirectory() as tmp:
+        stats = os.path.join(tmp, "stats.csv")
+        options = ["--compute", str(compute), "--memory", str(memory), "--fanout", str(fanout),
+                   "--alpha", str(alpha), "--duration-us", str(args.duration_us), "--stats", stats] + extra
+        cmd = [args.sst, CONFIG, "--model-options=" + " ".join(options)]
+        result = subprocess.run(cmd, cwd=tmp, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+        if result.returncode != 0:
+            sys.stderr.write(result.stdout[-4000:])
+            raise RuntimeError("sst failed for compute=%d memory=%d fanout=%d alpha=%g" %
+                               (compute, memory, fanout, alpha))
+        totals = read_stats(stats)
+
+    p99 = {}
+    for match in LATENCY_LINE.finditer(result.stdout):
+        op = match.group(1)
+        p99[op] = max(p99.get(op, 0), int(match.group(4)))
+
+    ops = totals.get(("compute", "operations_completed"), (0, 0))[1]
+    bytes_moved = (totals.get(("memory", "bytes_read"), (0, 0))[0] +
+                   totals.get(("memory", "bytes_written"), (0, 0))[0])
+    round_trips = totals.get(("compute", "round_trips_per_op"), (0, 0))
+    return {
+        "compute": compute,
+        "memory": memory,
+        "fanout": fanout,
+        "alpha": alpha,
+        "ops": ops,
+        "duration_us": args.duration_us,
+        "throughput_ops": round(ops / (args.duration_us * 1e-6)),
+        "search_p99_ns": p99.get("search", 0),
+        "insert_p99_ns": max(p99.get("insert", 0), p99.get("split-insert", 0)),
+        "network_bytes_per_op": round(bytes_moved / ops, 1) if ops else 0,
+        "round_trips_per_op": round(round_trips[0] / round_trips[1], 2) if round_trips[1] else 0,
+    }
+
+
+def point_key(row):
+    return tuple(float(row[f]) for f in KEY_FIELDS)
+
+
+def compare(rows, baseline_path, tolerance):
+    with open(baseline_path) as f:
+        baseline = {point_key(row): row for row in csv.DictReader(f)}
+    regressions = 0
+    for row in rows:
+        base = baseline.get(point_key(row))
+        if base is None:
+            continue
+        checks = [("throughput_ops", float(row["throughput_ops"]) < float(base["throughput_ops"]) * (1 - tolerance))]
+        for field in ("search_p99_ns", "insert_p99_ns"):
+            checks.append((field, float(row[field]) > float(base[field]) * (1 + tolerance)))
+        for field, regressed in checks:
+            if regressed:
+                regressions += 1
+                print("REGRESSION compute=%s memory=%s fanout=%s alpha=%s: %s %s -> %s" %
+                      (row["compute"], row["memory"], row["fanout"], row["alpha"], field, base[field], row[field]))
+    return regressions
+
+
+def main():
+    argv = sys.argv[1:]
+    extra = []
+    if "--" in argv:
+        extra = argv[argv.index("--") + 1:]
+        argv = argv[:argv.index("--")]
+
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--compute", type=int_list, default=[1, 2, 4, 8, 16, 32, 64])
+    parser.add_argument("--memory", type=int_list, default=[1, 2, 4, 8])
+    parser.add_argument("--fanout", type=int_list, default=[16])
+    parser.add_argument("--alpha", type=float_list, default=[0.99])
+    parser.add_argument("--duration-us", type=int, default=200)
+    parser.add_argument("--sst", default="sst", help="sst executable")
+    parser.add_argument("-o", "--output", default="btree_scaling.csv")
+    parser.add_argument("--compare", help="earlier CSV to check for regressions")
+    parser.add_argument("--tolerance", type=float, default=0.05)
+    args = parser.parse_args(argv)
+
+    rows = []
+    with open(args.output, "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=FIELDS)
+        writer.writeheader()
+        for memory, fanout, alpha, compute in itertools.product(args.memory, args.fanout, args.alpha, args.compute):
+            row = run_point(compute, memory, fanout, alpha, args, extra)
+            writer.writerow(row)
+            f.flush()
+            rows.append(row)
+            print("compute=%-3d memory=%d fanout=%-3d alpha=%.2f  %10d ops/s  p99 search %6d ns  %8.1f B/op" %
+                  (compute, memory, fanout, alpha, row["throughput_ops"], row["search_p99_ns"],
+                   row["network_bytes_per_op"]))
+
+    if args.compare and compare(rows, args.compare, args.tolerance) > 0:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,54 @@
+#!/usr/bin/env python3
+"""
+Test 11: YCSB Trace Replay
+Replay a recorded YCSB trace through the streaming workload path.
+Expected: Every trace record is issued once, in file order, then the workload stops.
+"""
+
+import os
+import sst
+
+print("=" * 70)
+print("TEST 11: YCSB Trace Replay")
+print("=" * 70)
+print("Goal: Drive the compute server from a recorded YCSB trace")
+print("Expected: All 10 trace records issued in file order")
+print()
+
+trace = os.path.join(os.path.dirname(os.path.abspath(__file__)), "ycsb_sample.trace")
+
+# Create compute server
+compute = sst.Component("compute_0", "rdmaNic.computeServer")
+compute.addParams({
+    "verbose": 1,
+    "node_id": 0,
+    "num_memory_nodes": 1,
+    "operations_per_second": 100,
+    "simulation_duration_us": 200000,  # 200ms - longer than the 10 trace records need
+    "key_range": 10,
+    "btree_fanout": 16,
+    "workload_trace": trace,
+})
+
+# Create memory server
+memory = sst.Component("memory_0", "rdmaNic.memoryServer")
+memory.addParams({
+    "verbose": 1,
+    "memory_server_id": 0,
+})
+
+compute_iface = compute.setSubComponent("mem_interface_0", "memHierarchy.standardInterface")
+memory_iface = memory.setSubComponent("mem_interface", "memHierarchy.standardInterface")
+
+link = sst.Link("memory_link")
+link.connect((compute_iface, "lowlink", "1ns"), (memory_iface, "lowlink", "1ns"))
+
+print("Test Configuration:")
+print("  - Trace: %s" % trace)
+print("  - 10 records: 4 INSERT, 1 UPDATE, 4 READ, 1 SCAN")
+print()
+print("Watch for:")
+print("  ✓ 'Replaying YCSB trace' at startup")
+print("  ✓ 'Workload trace exhausted after 10 operations'")
+print("  ✓ Searches for keys 3, 7 and 1 are FOUND, key 9 is NOT FOUND")
+print("=" * 70)
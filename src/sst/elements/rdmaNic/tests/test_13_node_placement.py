@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+"""
+Test 13: Node Placement Policies
+Grow a tree across four memory servers with a selectable placement policy.
+Expected: Nodes are spread according to the policy and no two nodes share an address.
+"""
+
+import sst
+
+# round_robin, hash, range or locality
+placement = "locality"
+num_memory_nodes = 4
+
+print("=" * 70)
+print("TEST 13: Node Placement (%s)" % placement)
+print("=" * 70)
+print("Goal: Split a small-fanout tree across %d memory servers" % num_memory_nodes)
+print("Expected: Per-server node counts and imbalance reported at finish")
+print()
+
+# Create compute server
+compute = sst.Component("compute_0", "rdmaNic.computeServer")
+compute.addParams({
+    "verbose": 1,
+    "node_id": 0,
+    "num_memory_nodes": num_memory_nodes,
+    "operations_per_second": 10000,
+    "simulation_duration_us": 20000,  # 200 operations
+    "read_ratio": 0.0,                # Inserts only, so the tree keeps splitting
+    "key_distribution": "uniform",
+    "key_range": 1000,
+    "btree_fanout": 4,
+    "placement_policy": placement,
+    "memory_server_window_mb": 16,
+})
+
+# One dedicated memory server per interface
+for memory_id in range(num_memory_nodes):
+    memory = sst.Component("memory_%d" % memory_id, "rdmaNic.memoryServer")
+    memory.addParams({
+        "verbose": 1,
+        "memory_server_id": memory_id,
+        "memory_server_window_mb": 16,
+    })
+
+    compute_iface = compute.setSubComponent("mem_interface_%d" % memory_id, "memHierarchy.standardInterface")
+    memory_iface = memory.setSubComponent("mem_interface", "memHierarchy.standardInterface")
+
+    link = sst.Link("memory_link_%d" % memory_id)
+    link.connect((compute_iface, "lowlink", "1ns"), (memory_iface, "lowlink", "1ns"))
+
+sst.setStatisticLoadLevel(1)
+sst.enableAllStatisticsForAllComponents()
+
+print("Test Configuration:")
+print("  - Fanout: 4, 200 uniform inserts over 1000 keys")
+print("  - Placement policy: %s" % placement)
+print()
+print("Watch for:")
+print("  ✓ 'Node placement: %s' at startup" % placement)
+print("  ✓ 'Allocated Node ... → Memory Server N' spread over all servers")
+print("  ✓ 'Placement imbalance (max/mean)' in the summary")
+print("=" * 70)
@@ -77,8 +77,17 @@ PageTableWalker::PageTableWalker(ComponentId_t id, int tlb_id, PageTableWalker *
 
     ptw_confined  = ((uint32_t) params.find<uint32_t>("ptw_confined", 0));
 
-    // For now, we assume a typicaly x86-64 system with 4 levels of page table
-    sizes = 4;
+    // x86-64 walks 4 levels of page table by default, or 5 with LA57
+    sizes = ((uint32_t) params.find<uint32_t>("page_table_levels", 4));
+
+    if(sizes != 4 && sizes != 5)
+        output->fatal(CALL_INFO, -1, "MMU: page_table_levels must be 4 or 5, got %d\n", sizes);
+
+    // The emulated page tables only keep the PGD, PUD, PMD and PTE levels
+    if(sizes == 5 && emulate_faults)
+        output->fatal(CALL_INFO, -1, "MMU: page_table_levels=5 is not supported with emulate_faults\n");
+
+    merge_walks = ((uint32_t) params.find<uint32_t>("merge_walks_PTWC", 0));
 
     parallel_mode = ((uint32_t) params.find<uint32_t>("parallel_mode_L"+LEVEL, 0));
 
@@ -96,6 +105,8 @@ PageTableWalker::PageTableWalker(ComponentId_t id, int tlb_id, PageTableWalker *
     // The stats that will appear, not that these stats are going to be part of the Samba unit
     statPageTableWalkerHits = registerStatistic<uint64_t>( "tlb_hits", subID);
     statPageTableWalkerMisses = registerStatistic<uint64_t>( "tlb_misses", subID );
+    statPageWalkAccesses = registerStatistic<uint64_t>( "ptw_walk_accesses", subID );
+    statMergedWalks = registerStatistic<uint64_t>( "ptw_merged_walks", subID );
 
 
     size = new int[sizes];
@@ -112,6 +123,8 @@ PageTableWalker::PageTableWalker(ComponentId_t id, int tlb_id, PageTableWalker *
     page_size[1] = 512*1024*4;
     page_size[2] = (uint64_t) 512*512*1024*4;
     page_size[3] = (uint64_t) 512*512*512*1024*4;
+    if(sizes == 5)
+        page_size[4] = (uint64_t) 512*512*512*512*1024*4;
 
     for(int i=0; i < sizes; i++)
     {
@@ -359,11 +372,8 @@ void PageTableWalker::recvResp(SST::Event * event)
     MemEvent * ev = static_cast<MemEvent*>(event);
 
 
-    long long int pw_id;
-    if(!self_connected)
-        pw_id = MEM_REQ[ev->getResponseToID()];
-    else
-        pw_id = MEM_REQ[ev->getID()];
+    id_type req_id = self_connected ? ev->getID() : ev->getResponseToID();
+    long long int pw_id = MEM_REQ[req_id];
 
     //WID_Add[] is virtual address, WSR_PT_LEVEL[] is level of page table
     insert_way(WID_Add[pw_id], find_victim_way(WID_Add[pw_id], WSR_PT_LEVEL[pw_id]), WSR_PT_LEVEL[pw_id]);
@@ -373,7 +383,7 @@ void PageTableWalker::recvResp(SST::Event * event)
     WSR_READY[pw_id]=true;
 
     // Avoiding memory leak by deleting the newly generated dummy requests
-    MEM_REQ.erase(ev->getID());
+    MEM_REQ.erase(req_id);
     delete ev;
 
     if(WSR_PT_LEVEL[pw_id]==0)
@@ -381,6 +391,21 @@ void PageTableWalker::recvResp(SST::Event * event)
         ready_by[WID_EV[pw_id]] =  currTime + latency + 2*upper_link_latency;
 
         ready_by_size[WID_EV[pw_id]] = os_page_size; // FIXME: This hardcoded for now assuming the OS maps virtual pages to 4KB pages only
+
+        // Misses that were merged into this walk complete with it
+        std::map<long long int, std::vector<MemHierarchy::MemEventBase *> >::iterator merged = WALK_MERGED.find(pw_id);
+        if(merged != WALK_MERGED.end())
+        {
+            for(MemHierarchy::MemEventBase * follower : merged->second)
+            {
+                ready_by[follower] = ready_by[WID_EV[pw_id]];
+                ready_by_size[follower] = os_page_size;
+            }
+            WALK_MERGED.erase(merged);
+        }
+        std::map<Address_t, long long int>::iterator page = WALK_PAGE.find(addr/page_size[0]);
+        if(page != WALK_PAGE.end() && page->second == pw_id)
+            WALK_PAGE.erase(page);
     }
     else
     {
@@ -707,7 +732,21 @@ bool PageTableWalker::tick(SST::Cycle_t x)
                 k = max(k-2, 1);
 
 
-            if((int) pending_misses.size() < (int) max_outstanding)
+            std::map<Address_t, long long int>::iterator walk = WALK_PAGE.end();
+            if(merge_walks && to_mem!=nullptr)
+                walk = WALK_PAGE.find(addr/page_size[0]);
+
+            // A walk for the same page is already in flight, so wait for it instead of using another walker
+            if(walk != WALK_PAGE.end())
+            {
+                statPageTableWalkerMisses->addData(1);
+                statMergedWalks->addData(1);
+                misses++;
+                WALK_MERGED[walk->second].push_back(*st_1);
+
+                st_1 = not_serviced.erase(st_1);
+            }
+            else if((int) pending_misses.size() < (int) max_outstanding)
             {
                 statPageTableWalkerMisses->addData(1);
                 misses++;
@@ -748,6 +787,9 @@ bool PageTableWalker::tick(SST::Cycle_t x)
                     MemEvent *e = new MemEvent(getName(), dummy_add, dummy_base_add, Command::GetS);
 
                     // Record this walk request into WSR_ and WID_ structs
+                    statPageWalkAccesses->addData(k);
+                    if(merge_walks)
+                        WALK_PAGE[addr/page_size[0]] = mmu_id;
                     WSR_PT_LEVEL[mmu_id] = k-1;
                     //		WID_EV[mmu_id] = e;
                     WID_Add[mmu_id] = addr;
@@ -812,7 +854,7 @@ bool PageTableWalker::tick(SST::Cycle_t x)
                 update_lru(addr, 0);
 
 
-            service_back->push_back(st->first);
+            service_back->push_back({st->first, ready_by_size[st->first]});
 
 
             if(emulate_faults)
@@ -836,9 +878,6 @@ bool PageTableWalker::tick(SST::Cycle_t x)
                 }
             }
 
-            (*service_back_size)[st->first]=ready_by_size[st->first];
-
-
             ready_by_size.erase(st->first);
 
 
@@ -57,6 +57,7 @@ class PageTableWalker : public ComponentExtension
     int parallel_mode; // very specific case for L1 PageTableWalker in case of overlapping with accessing the cache
     int self_connected; // his parameter indidicates if the PTW is self-connected or actually connected to the memory hierarchy
     int page_walk_latency; // this is really nothing than the page walk latency in case of having no walkers
+    int merge_walks; // if set, a miss to a page that already has a walk in flight waits for that walk
 
     uint32_t ptw_confined;
 
@@ -137,8 +138,7 @@ class PageTableWalker : public ComponentExtension
 
     // === Holds incoming requests, "input queue"
     std::vector<MemHierarchy::MemEventBase *> not_serviced;
-    std::vector<MemHierarchy::MemEventBase *> * service_back; // This is used to pass ready requests back to the previous level
-    std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * service_back_size; // This is used to pass the size of the  requests back to the previous level
+    std::vector<TranslatedRequest> * service_back; // This is used to pass ready requests and their sizes back to the previous level
 
     // === Holds requests that have gotten the data they need, but we need to wait the duration of the latency before returning
     std::map<MemHierarchy::MemEventBase *, SST::Cycle_t, MemEventPtrCompare> ready_by;
@@ -201,7 +201,7 @@ class PageTableWalker : public ComponentExtension
     // ====== Wire-up methods
     // (for parent obj to set out pointers to their versions of the objects)
 
-    void setServiceBack( std::vector<MemHierarchy::MemEventBase *> * x) { service_back = x;}
+    void setServiceBack( std::vector<TranslatedRequest> * x) { service_back = x;}
     void setHold(int * tmp) { hold = tmp; }
     void setShootDownEvents(int * sd, int *iva, std::vector<std::pair<Address_t, int> > * x)
             { shootdown = sd; hasInvalidAddrs = iva; invalid_addrs = x;}
@@ -223,8 +223,6 @@ class PageTableWalker : public ComponentExtension
 
     bool recvPageFaultResp(PageFaultHandler::PageFaultHandlerPacket pkt);
 
-    void setServiceBackSize( std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * x) { service_back_size = x;}
-
 
     //==== JVOROBY: these appear to be unused? There's no lower-level TLB below the PTW, so noone to push-back to us
     //std::vector<MemHierarchy::MemEventBase *> * getPushedBack(){return & pushed_back;}
@@ -250,9 +248,15 @@ class PageTableWalker : public ComponentExtension
     // This maps `memevent->getID()` to the corresponding `mmu_id`  used in the WSR_ and WID_ objects
     std::map<id_type, long long int> MEM_REQ;
 
+    // With merge_walks, the walk in flight for each 4KB page and the misses waiting on each walk
+    std::map<Address_t, long long int> WALK_PAGE;
+    std::map<long long int, std::vector<MemHierarchy::MemEventBase *> > WALK_MERGED;
+
     //=== Etc
     Statistic<uint64_t>* statPageTableWalkerHits;
     Statistic<uint64_t>* statPageTableWalkerMisses;
+    Statistic<uint64_t>* statPageWalkAccesses;
+    Statistic<uint64_t>* statMergedWalks;
 
     void handleEvent(SST::Event* event);
 
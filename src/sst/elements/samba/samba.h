@@ -58,7 +58,9 @@ class Samba : public SST::Component {
             { "total_waiting",   "The total waiting time", "cycles", 1},   // Name, Desc, Enable Level
             { "write_requests",  "Stat write_requests", "requests", 1},
             { "tlb_shootdown",   "Number of TLB clears because of page-frees", "shootdowns", 2 },
-            { "tlb_page_allocs", "Number of pages allocated by the memory manager", "pages", 2 }
+            { "tlb_page_allocs", "Number of pages allocated by the memory manager", "pages", 2 },
+            { "ptw_walk_accesses", "Page table accesses issued by each page walk", "accesses", 5 },
+            { "ptw_merged_walks", "Page walk cache misses merged into a walk already in flight for the same page", "requests", 5 }
         )
 
         SST_ELI_DOCUMENT_PARAMS(
@@ -78,6 +80,13 @@ class Samba : public SST::Component {
             {"parallel_mode_L%(levels)d", "this is for the corner case of having a one cycle overlap with accessing cache","0"},
             {"page_walk_latency", "Each page table walk latency in nanoseconds", "50"},
             {"self_connected", "Determines if the page walkers are acutally connected to memory hierarchy or just add fixed latency (self-connected)", "0"},
+            {"page_table_levels", "Number of page table levels walked, 4 or 5 (5-level paging is not supported with emulate_faults)", "4"},
+            {"size%(page_table_levels)d_PTWC", "the number of entries of page walk cache level x, 1 caches PTEs", "1"},
+            {"assoc%(page_table_levels)d_PTWC", "the associativity of page walk cache level x", "1"},
+            {"latency_PTWC", "the access latency in cycles of the page walk caches", "1"},
+            {"max_outstanding_PTWC", "the number of concurrent page walks per core, each with one page table access in flight", "4"},
+            {"max_width_PTWC", "the number of requests the page walker takes per cycle", "4"},
+            {"merge_walks_PTWC", "If set, a page walk cache miss to a page whose walk is already in flight waits for that walk instead of using a walker", "0"},
             {"emulate_faults", "This indicates if the page faults should be emulated through requesting pages from page fault handler", "0"},
             {"verbose", "(uint) Output verbosity for warnings/errors. 0[fatal error only], 1[warnings], 2[full state dump on fatal error]","0"},
         )
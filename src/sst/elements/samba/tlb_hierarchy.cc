@@ -123,21 +123,17 @@ TLBhierarchy::TLBhierarchy(ComponentId_t id, int tlb_id, int Levels, Params& par
 		for(int level=2; level <=levels; level++)
 		{
 			TLB_CACHE[level]->setServiceBack(TLB_CACHE[level-1]->getPushedBack());
-			TLB_CACHE[level]->setServiceBackSize(TLB_CACHE[level-1]->getPushedBackSize());
 
 		}
 
 		timeStamp = 0;
 		PTW->setServiceBack(TLB_CACHE[levels]->getPushedBack());
-		PTW->setServiceBackSize(TLB_CACHE[levels]->getPushedBackSize());
 
 		TLB_CACHE[1]->setServiceBack(&mem_reqs);
-		TLB_CACHE[1]->setServiceBackSize(&mem_reqs_sizes);
 	}
 	else
 	{
 		PTW->setServiceBack(&mem_reqs);
-		PTW->setServiceBackSize(&mem_reqs_sizes);
 	}
 
 	PTW->setHold(&hold);
@@ -237,12 +233,11 @@ bool TLBhierarchy::tick(SST::Cycle_t x)
 	// Step 1, check if not empty, then propogate it to L1 cache
 	while(!mem_reqs.empty() && !shootdown && !hold)
 	{
-            MemHierarchy::MemEventBase * event= mem_reqs.back();
+            MemHierarchy::MemEventBase * event= mem_reqs.back().ev;
 
 		if(time_tracker.find(event) == time_tracker.end())
 		{
 			std::cout << "Danger! Something is terribly wrong..." << std::endl;
-			mem_reqs_sizes.erase(event);
 			mem_reqs.pop_back();
 			continue;
 		}
@@ -290,8 +285,7 @@ bool TLBhierarchy::tick(SST::Cycle_t x)
 
 		to_cache->send(event);
 
-		// We remove the size of that translation, we might for future versions use the translation size to obtain statistics
-		mem_reqs_sizes.erase(event);
+		// The translation size is dropped with the request, we might for future versions use it to obtain statistics
 		mem_reqs.pop_back();
 	}
 
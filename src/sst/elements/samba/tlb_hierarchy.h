@@ -85,11 +85,9 @@ class TLBhierarchy : public ComponentExtension
 
     //======== Event buffers?
 
-    std::vector<SST::MemHierarchy::MemEventBase *> mem_reqs; // holds the current requests to be translated
+    std::vector<TranslatedRequest> mem_reqs; // holds the translated requests, with their page sizes, to be sent to the cache
 
     std::vector<std::pair<Address_t, int> > invalid_addrs;  // holds the invalidation requests
-    std::map<SST::MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> mem_reqs_sizes;
-                                                    // holds the current requests to be translated
     std::map<SST::Event *, uint64_t> time_tracker;   // used to track time spent on translating each request
 
     // This represents the maximum number of outstanding requests for this structure
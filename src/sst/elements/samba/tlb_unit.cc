@@ -13,6 +13,7 @@
 #include <sst_config.h>
 #include "tlb_unit.h"
 
+#include<algorithm>
 #include<iostream>
 
 using namespace SST::MemHierarchy;
@@ -104,10 +105,10 @@ TLB::TLB(ComponentId_t id, int tlb_id, TLB * Next_level, int Level, SST::Params&
 	page_size = new uint64_t[sizes];
 	sets = new int[sizes];
 
-    // data arrays `foo[page_sizes][set][way]`
-	tags  = new Address_t**[sizes];
-	valid = new bool**[sizes];
-	lru   = new int **[sizes];
+    // data arrays `foo[page_sizes][set * assoc + way]`
+	tags  = new Address_t*[sizes];
+	valid = new bool*[sizes];
+	lru   = new int*[sizes];
 
     //Loop over each supported page size, getting params
 	for(int i=0; i < sizes; i++)
@@ -131,26 +132,25 @@ TLB::TLB(ComponentId_t id, int tlb_id, TLB * Next_level, int Level, SST::Params&
 	for(int id=0; id< sizes; id++)
 	{
 
-		tags[id]  = new Address_t*[sets[id]];
-		valid[id] = new bool*[sets[id]];
-		lru[id]   = new int*[sets[id]];
+		tags[id]  = new Address_t[sets[id] * assoc[id]];
+		valid[id] = new bool[sets[id] * assoc[id]];
+		lru[id]   = new int[sets[id] * assoc[id]];
 
 		for(int i=0; i < sets[id]; i++)
 		{
-			tags[id][i]  = new Address_t[assoc[id]];
-			valid[id][i] = new bool[assoc[id]];
-			lru[id][i]   = new int[assoc[id]];
-
 			for(int j=0; j<assoc[id];j++)
 			{
-				tags [id][i][j] = -1;
-				valid[id][i][j] = true;
-				lru  [id][i][j] = j;
+				tags [id][i * assoc[id] + j] = -1;
+				valid[id][i * assoc[id] + j] = true;
+				lru  [id][i * assoc[id] + j] = j;
 			}
 		}
 
 	}
 
+	miss_table.resize(max_outstanding > 0 ? max_outstanding : 0, MissEntry{nullptr, 0, {}});
+	pending_misses = 0;
+
 	//	registerClock( cpu_clock, new SST::Clock::Handler2<TLB,&TLB::tick>(this) );
 
 
@@ -174,7 +174,8 @@ bool TLB::tick(SST::Cycle_t x)
 	{
 
 
-        MemHierarchy::MemEventBase * ev = pushed_back.back();
+        MemHierarchy::MemEventBase * ev = pushed_back.back().ev;
+		long long int ev_size = pushed_back.back().size;
 
 		Address_t addr = ((MemEvent*) ev)->getVirtualAddress();
 
@@ -187,7 +188,7 @@ bool TLB::tick(SST::Cycle_t x)
 		lu_en=SIZE_LOOKUP.end();
 		while(lu_st!=lu_en)
 		{
-			if(pushed_back_size[ev] >= lu_st->first)
+			if(ev_size >= lu_st->first)
 			{
 				if(!check_hit(addr, lu_st->second))
 				{
@@ -200,48 +201,22 @@ bool TLB::tick(SST::Cycle_t x)
 			lu_st++;
 		}
 
-		// Deleting it from pending requests
-		std::vector<SST::MemHierarchy::MemEventBase *>::iterator st, en;
-		st = pending_misses.begin();
-		en = pending_misses.end();
-
-
-		while(st!=en)
-		{
-			if(*st == ev)
-			{
-				pending_misses.erase(st);
-				break;
-			}
-			st++;
-		}
-
 		// Note that here we are substituting for latency of checking the tag before proceeding
         // to the next level, we also add the upper link latency for the round trip
-		ready_by[ev]= x + latency + 2*upper_link_latency;
-
-		// We also track the size of tthe ready request
-		ready_by_size[ev]= pushed_back_size[ev];
+		ready.push_back({ev, x + latency + 2*upper_link_latency, ev_size});
 
-
-		// Check if there are other misses that were going to the same translation and waiting for the response of this miss
-		if((level==1) && (SAME_MISS.find(addr/4096)!=SAME_MISS.end()))
+		// Free its miss table entry, other misses that were going to the same translation and waiting for the response of this miss complete with it
+		MissEntry * miss = find_miss(ev);
+		if(miss != nullptr)
 		{
-		   auto same_st = SAME_MISS[addr/4096].begin();
-		   auto same_en = SAME_MISS[addr/4096].end();
-		   while(same_st!=same_en)
-		    {
-
-	    		ready_by[same_st->first] = x + latency + 2*upper_link_latency;
-	    		ready_by_size[same_st->first] = pushed_back_size[ev];
-			same_st++;
-		    }
-		  SAME_MISS.erase(addr/4096);
-		 // PENDING_MISS.erase(addr/4096);
+			for(MemHierarchy::MemEventBase * same : miss->same_miss)
+				ready.push_back({same, x + latency + 2*upper_link_latency, ev_size});
+
+			miss->same_miss.clear();
+			miss->ev = nullptr;
+			pending_misses--;
 		}
-		PENDING_MISS.erase(addr/4096);
 
-		pushed_back_size.erase(ev);
 		pushed_back.pop_back();
 
 	}
@@ -289,13 +264,9 @@ bool TLB::tick(SST::Cycle_t x)
 			update_lru(addr, hit_id);
 			hits++;
 			statTLBHits->addData(1);
-			if(parallel_mode)
-				ready_by[ev] = x;
-			else
-				ready_by[ev] = x + latency;
 
 			// Tracking the hit request size
-			ready_by_size[ev] = page_size[hit_id]/1024;
+			ready.push_back({ev, parallel_mode ? x : x + latency, (long long int) (page_size[hit_id]/1024)});
 
 			st_1 = not_serviced.erase(st_1);
 		}
@@ -303,49 +274,34 @@ bool TLB::tick(SST::Cycle_t x)
 		{
 
 			// Making sure we have a room for an additional miss, i.e., less than the maximum outstanding misses
-			if((int) pending_misses.size() < (int) max_outstanding)
+			if(pending_misses < (int) max_outstanding)
 			{
 
 				// Check if the miss is not currently being handled
-				bool currently_handled=false;
-				if((level==1) && (PENDING_MISS.find(addr/4096) != PENDING_MISS.end()))
-				{
-
-					SAME_MISS[addr/4096][ev]=1; // Just adding it to the 2D map, so we later hand it back once the master miss is complete
-					currently_handled = true;
-				}
-				else if(level==1)
-				{
-
-					PENDING_MISS[addr/4096]=1;
-
-				}
+				MissEntry * same = (level==1) ? find_miss_page(addr/4096) : nullptr;
 
 				statTLBMisses->addData(1);
 				misses++;
 
-				if(!currently_handled)
+				if(same == nullptr)
 				{
+					MissEntry * miss = find_miss(nullptr);
+					miss->ev = ev;
+					miss->page = addr/4096;
+					pending_misses++;
 
-					pending_misses.push_back(*st_1);
 					// Check if the last level TLB or not, if last-level, pass the request to the page table walker
 					if(next_level!=nullptr)
-					{
-
 						next_level->push_request(ev);
-						st_1 = not_serviced.erase(st_1);
-					}
 					else // Pass it to the page table walker
-					{
 						PTW->push_request(ev);
-						st_1 = not_serviced.erase(st_1);
-					}
 				}
 				else
 				{
-					st_1 = not_serviced.erase(st_1);
+					same->same_miss.push_back(ev); // We later hand it back once the master miss is complete
 				}
 
+				st_1 = not_serviced.erase(st_1);
 			}
 
 		}
@@ -356,76 +312,69 @@ bool TLB::tick(SST::Cycle_t x)
 	}
 
 
-	auto st = ready_by.begin();
-	auto en = ready_by.end();
-
-	// We iterate over the list of being serviced request to see if any has finished by this cycle
-	while(st!=en)
+	// Requests finished by this cycle leave in the order of their event ids
+	ready_now.clear();
+	size_t kept = 0;
+	for(size_t i = 0; i < ready.size(); i++)
 	{
+		if(ready[i].ready_by <= x)
+			ready_now.push_back(ready[i]);
+		else
+			ready[kept++] = ready[i];
+	}
+	ready.resize(kept);
 
-		bool deleted=false;
-		if(st->second <= x)
-		{
-
-			//	std::cout<<"The request was read at "<<st->second<<" The time now is "<<x<<std::endl;
-
-			Address_t addr = ((MemEvent*) st->first)->getVirtualAddress();
-
-
-			if(SIZE_LOOKUP.find(ready_by_size[st->first])!= SIZE_LOOKUP.end())
-			{
-				// Double checking that we actually still don't have it inserted
-				if(!check_hit(addr, SIZE_LOOKUP[ready_by_size[st->first]]))
-				{
-					insert_way(addr, find_victim_way(addr, SIZE_LOOKUP[ready_by_size[st->first]]), SIZE_LOOKUP[ready_by_size[st->first]]);
-					update_lru(addr, SIZE_LOOKUP[ready_by_size[st->first]]);
-				}
-				else
-					update_lru(addr, SIZE_LOOKUP[ready_by_size[st->first]]);
-			}
-
-
+	std::sort(ready_now.begin(), ready_now.end(), [](const ReadyEntry& a, const ReadyEntry& b) {
+		if(a.ev->getID().second != b.ev->getID().second)
+			return a.ev->getID().second < b.ev->getID().second;
+		return a.ev->getID().first < b.ev->getID().first;
+	});
 
-			service_back->push_back(st->first);
+	for(ReadyEntry& done : ready_now)
+	{
 
-			(*service_back_size)[st->first]=ready_by_size[st->first];
+		Address_t addr = ((MemEvent*) done.ev)->getVirtualAddress();
 
 
+		std::map<long long int, int>::iterator lookup = SIZE_LOOKUP.find(done.size);
+		if(lookup != SIZE_LOOKUP.end())
+		{
+			// Double checking that we actually still don't have it inserted
+			if(!check_hit(addr, lookup->second))
+				insert_way(addr, find_victim_way(addr, lookup->second), lookup->second);
 
-			ready_by_size.erase(st->first);
+			update_lru(addr, lookup->second);
+		}
 
-			deleted = true;
 
+		service_back->push_back({done.ev, done.size});
 
-			// Deleting it from pending requests
-			std::vector<MemHierarchy::MemEventBase *>::iterator st2, en2;
-			st2 = pending_misses.begin();
-			en2 = pending_misses.end();
+	}
 
 
-			while(st2!=en2)
-			{
-				if(*st2 == st->first)
-				{
-					pending_misses.erase(st2);
-					break;
-				}
-				st2++;
-			}
 
-			ready_by.erase(st);
+	return false;
+}
 
-		}
-		if(deleted)
-			st=ready_by.begin();
-		else
-			st++;
 
-	}
+// Finds the miss table entry of ev, or a free entry when ev is nullptr
+TLB::MissEntry * TLB::find_miss(MemHierarchy::MemEventBase * ev)
+{
+	for(MissEntry& miss : miss_table)
+		if(miss.ev == ev)
+			return &miss;
 
+	return nullptr;
+}
 
+// Finds the outstanding miss for a 4KB page
+TLB::MissEntry * TLB::find_miss_page(Address_t page)
+{
+	for(MissEntry& miss : miss_table)
+		if(miss.ev != nullptr && miss.page == page)
+			return &miss;
 
-	return false;
+	return nullptr;
 }
 
 
@@ -434,8 +383,8 @@ void TLB::insert_way(Address_t vaddr, int way, int struct_id)
 {
 
 	int set=abs_int((vaddr/page_size[struct_id])%sets[struct_id]);
-	tags[struct_id][set][way]=vaddr/page_size[struct_id];
-	valid[struct_id][set][way]=true;
+	tags[struct_id][set * assoc[struct_id] + way]=vaddr/page_size[struct_id];
+	valid[struct_id][set * assoc[struct_id] + way]=true;
 
 }
 
@@ -459,9 +408,9 @@ void TLB::invalidate(Address_t vadd, int id)
 		//std::cout << getName().c_str() << " TLB " << coreId << " id: " << id << " invalidate address: " << vadd << " index: " << vadd*page_size[0]/page_size[id] << std::endl;
 		int set= abs_int((vadd*page_size[0]/page_size[id])%sets[id]);
 		for(int i=0; i<assoc[id]; i++) {
-			if(tags[id][set][i]==vadd*page_size[0]/page_size[id] && valid[id][set][i]) {
+			if(tags[id][set * assoc[id] + i]==vadd*page_size[0]/page_size[id] && valid[id][set * assoc[id] + i]) {
 				//std::cout << getName().c_str() << " TLB " << coreId << " invalidate address: " << vadd << " index: " << vadd*page_size[0]/page_size[id] << " found" << std::endl;
-				valid[id][set][i] = false;
+				valid[id][set * assoc[id] + i] = false;
 				break;
 			}
 		}
@@ -479,8 +428,8 @@ bool TLB::check_hit(Address_t vadd, int struct_id)
 
 	int set= abs_int((vadd/page_size[struct_id])%sets[struct_id]);
 	for(int i=0; i<assoc[struct_id];i++)
-		if(tags[struct_id][set][i]==vadd/page_size[struct_id])
-			return valid[struct_id][set][i];
+		if(tags[struct_id][set * assoc[struct_id] + i]==vadd/page_size[struct_id])
+			return valid[struct_id][set * assoc[struct_id] + i];
 
 	return false;
 }
@@ -492,7 +441,7 @@ int TLB::find_victim_way(Address_t vadd, int struct_id)
 	int set= abs_int((vadd/page_size[struct_id])%sets[struct_id]);
 
 	for(int i=0; i<assoc[struct_id]; i++)
-		if(lru[struct_id][set][i]==(assoc[struct_id]-1))
+		if(lru[struct_id][set * assoc[struct_id] + i]==(assoc[struct_id]-1))
 			return i;
 
 
@@ -507,17 +456,17 @@ void TLB::update_lru(Address_t vaddr, int struct_id)
 
 	int set= abs_int((vaddr/page_size[struct_id])%sets[struct_id]);
 	for(int i=0; i<assoc[struct_id];i++)
-		if(tags[struct_id][set][i]==vaddr/page_size[struct_id])
+		if(tags[struct_id][set * assoc[struct_id] + i]==vaddr/page_size[struct_id])
 		{
-			lru_place = lru[struct_id][set][i];
+			lru_place = lru[struct_id][set * assoc[struct_id] + i];
 			break;
 		}
 	for(int i=0; i<assoc[struct_id];i++)
 	{
-		if(lru[struct_id][set][i]==lru_place)
-			lru[struct_id][set][i]=0;
-		else if(lru[struct_id][set][i]<lru_place)
-			lru[struct_id][set][i]++;
+		if(lru[struct_id][set * assoc[struct_id] + i]==lru_place)
+			lru[struct_id][set * assoc[struct_id] + i]=0;
+		else if(lru[struct_id][set * assoc[struct_id] + i]<lru_place)
+			lru[struct_id][set * assoc[struct_id] + i]++;
 	}
 
 
@@ -54,11 +54,11 @@ class TLB : public ComponentExtension
 	int * sets;  // stores the number of sets, by     [pg-type]
 
     // === Cache data for TLB entries
-    // - separate cache for each size of page
-    // - accessed as `tags[page_size][set][way]`
-	Address_t *** tags;
-	bool ***valid; // status of the tags
-	int *** lru;   // lru positions
+    // - separate cache for each size of page, each one flat array
+    // - accessed as `tags[page_size][set * assoc[page_size] + way]`
+	Address_t ** tags;
+	bool ** valid; // status of the tags
+	int ** lru;    // lru positions
 
 
     // === Counters
@@ -74,8 +74,19 @@ class TLB : public ComponentExtension
     // === ???
 	std::map<long long int, int> SIZE_LOOKUP; // This structure checks if a size is supported inside the structure, and its index structure
 
-	std::map< Address_t, std::map< MemHierarchy::MemEventBase *, int, MemEventPtrCompare>> SAME_MISS; // This tracks the misses for the same location and deduplicates them
-	std::map<Address_t, int> PENDING_MISS; // This tracks the addresses of the current master misses (other contained misses are tracked in SAME_MISS)
+    // === Miss table, one entry per outstanding miss sent to the next level
+    // - at L1, later misses to the 4KB page of an outstanding miss wait in its entry and complete with it
+	struct MissEntry {
+		MemHierarchy::MemEventBase * ev; // the miss sent down, nullptr if the entry is free
+		Address_t page;
+		std::vector<MemHierarchy::MemEventBase *> same_miss;
+	};
+
+	std::vector<MissEntry> miss_table; // max_outstanding entries
+	int pending_misses; // number of entries in use
+
+	MissEntry * find_miss(MemHierarchy::MemEventBase * ev);
+	MissEntry * find_miss_page(Address_t page);
 
 
     //=======================================================================
@@ -90,13 +101,15 @@ class TLB : public ComponentExtension
     // === Holds incoming requests, "input queue"
 	std::vector<MemHierarchy::MemEventBase *> not_serviced;
 
-    // === Holds a copy of requests that have missed in this level, and have been sent into the next level down.
-    //  events are erased when they are fulfilled, and returned into `this->pushed_back`
-	std::vector<MemHierarchy::MemEventBase *> pending_misses;
-
     // === Holds requests that have gotten the data they need, but we need to wait the duration of the latency before returning
-	std::map<MemHierarchy::MemEventBase *, SST::Cycle_t, MemEventPtrCompare> ready_by;
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> ready_by_size; // keeps track of requests' sizes inside this structure
+	struct ReadyEntry {
+		MemHierarchy::MemEventBase * ev;
+		SST::Cycle_t ready_by;
+		long long int size; // size of the translation inside this structure
+	};
+
+	std::vector<ReadyEntry> ready;
+	std::vector<ReadyEntry> ready_now; // scratch space for the requests leaving this cycle
 
 
     // === Buffers for sending requests up/down TLB hierarchy:
@@ -104,13 +117,11 @@ class TLB : public ComponentExtension
     // When we miss, we send requests to next level down through `next_level->push_request()` or `PTW->push_request()`
 
     // completed requests from deeper in TLB hierarchy will be returned into `this->pushed_back`
-	std::vector<MemHierarchy::MemEventBase *> pushed_back; // translation for requests, returned from lower-level structures
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> pushed_back_size; // page_sizes of the returned translations
+	std::vector<TranslatedRequest> pushed_back; // translation for requests and their page sizes, returned from lower-level structures
 
     // when we're finished with a request, we send it back up the hierarchy by inserting into `service_back`
     // - pointer is wired up to `pushed_back` buffers of the next level up at TLB in constructor of TLBHierarchy
-	std::vector<MemHierarchy::MemEventBase *> * service_back; // used to pass ready requests back to the previous level
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * service_back_size; // page_size of ready requests for next level up
+	std::vector<TranslatedRequest> * service_back; // used to pass ready requests and their page sizes back to the previous level
 
 
 
@@ -138,12 +149,10 @@ class TLB : public ComponentExtension
 
     // === Called by parent to wire up TLB levels to each other
     // this TLB will push completed requests into service_back (sending them back up the levels towards core)
-	void setServiceBack( std::vector<MemHierarchy::MemEventBase *> * x) { service_back = x;}
-	void setServiceBackSize( std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * x) { service_back_size = x;}
+	void setServiceBack( std::vector<TranslatedRequest> * x) { service_back = x;}
 
     // lower-levels will return answered requests into this->pushed_back
-	std::vector<MemHierarchy::MemEventBase *> * getPushedBack(){return & pushed_back;}
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * getPushedBackSize(){return & pushed_back_size;}
+	std::vector<TranslatedRequest> * getPushedBack(){return & pushed_back;}
 
 	void update_lru(Address_t vaddr, int struct_id);
 
@@ -29,6 +29,12 @@ namespace SambaComponent {
             }
         }
     };
+
+    // A translated request handed back up the TLB hierarchy, with the size of the page it was translated with
+    struct TranslatedRequest {
+        MemHierarchy::MemEventBase* ev;
+        long long int size;
+    };
 }
 }
 
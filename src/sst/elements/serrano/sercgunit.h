@@ -58,6 +58,9 @@ public:
 	virtual bool stillProcessing() = 0;
 	virtual void execute( const uint64_t current_cycle ) = 0;
 
+	// Return to the state after construction, so the graph can run another kernel
+	virtual void reset() {}
+
 	void addInputQueue( SerranoCircularQueue<SerranoMessage*>* new_q ) {
 		output->verbose(CALL_INFO, 4, 0, "Added input queue.\n");
 		input_qs.push_back( new_q );
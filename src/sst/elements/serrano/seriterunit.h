@@ -106,6 +106,18 @@ public:
 		}
 	}
 
+	virtual void reset() {
+		keep_processing = true;
+
+		switch( d_type ) {
+		case TYPE_INT32: resetIterations<int32_t>(); break;
+		case TYPE_INT64: resetIterations<int64_t>(); break;
+		case TYPE_FP32:  resetIterations<float>();   break;
+		case TYPE_FP64:  resetIterations<double>();  break;
+		default: break;
+		}
+	}
+
 	virtual void execute( const uint64_t currentCycle ) {
 		output->verbose(CALL_INFO, 8, 0, "Executing iteration generator...\n");
 
@@ -117,6 +129,7 @@ public:
 protected:
 	SerranoStandardType d_type;
 	std::function<void()> func;
+	void* start_value;
 	void* current_value;
 	void* max_value;
 	void* step_value;
@@ -154,7 +167,12 @@ protected:
 		}
 	}
 
+	template<class T> void resetIterations() {
+		(*( (T*) current_value )) = (*( (T*) start_value ));
+	}
+
 	template<class T> void configureIterations( const T start, const T step, const T end ) {
+		start_value         = (void*) ( new T[1] );
 		current_value       = (void*) ( new T[1] );
 		max_value           = (void*) ( new T[1] );
 		step_value          = (void*) ( new T[1] );
@@ -163,6 +181,7 @@ protected:
 		T* t_max_value      = (T*) max_value;
 		T* t_step_value     = (T*) step_value;
 
+		(*( (T*) start_value )) = start;
 		(*t_current_value ) = start;
 		(*t_max_value     ) = end;
 		(*t_step_value    ) = step;
@@ -21,6 +21,7 @@
 #include "serprintunit.h"
 
 #include <limits>
+#include <map>
 
 using namespace SST::Serrano;
 
@@ -47,15 +48,21 @@ SerranoComponent::SerranoComponent( SST::ComponentId_t id, SST::Params& params )
 		if( "" != kernel_name_file) {
 			output->verbose(CALL_INFO, 4, 0, "Found Kernel (%s): %s\n", kernel_name, kernel_name_file.c_str());
 			kernel_queue.push_back( kernel_name_file );
+
+			// Subcomponents are loaded here, kernels launched later reuse them
+			if( kernel_graphs.find( kernel_name_file ) == kernel_graphs.end() ) {
+				kernel_graphs.insert( std::pair< std::string, SerranoGraph* >( kernel_name_file,
+					constructGraph( output, kernel_name_file.c_str() ) ) );
+			}
 		} else {
 			break;
 		}
 	}
 	delete[] kernel_name;
 
+	graph = nullptr;
 	if( kernel_queue.size() > 0 ) {
-		constructGraph( output, kernel_queue.front().c_str() );
-		kernel_queue.pop_front();
+		launchNextKernel();
 	}
 
 	registerAsPrimaryComponent();
@@ -63,6 +70,7 @@ SerranoComponent::SerranoComponent( SST::ComponentId_t id, SST::Params& params )
 }
 
 SerranoComponent::~SerranoComponent() {
+	clearGraph();
 	delete output;
 }
 
@@ -70,24 +78,34 @@ bool SerranoComponent::tick( SST::Cycle_t currentCycle ) {
 
 	output->verbose(CALL_INFO, 4, 0, "Clocking Serrano cycle %" PRIu64 "...\n", currentCycle );
 
+	if( nullptr == graph ) {
+		primaryComponentOKToEndSim();
+		return true;
+	}
+
+	const std::vector< SerranoCoarseUnit* >& units = graph->units;
+	const std::vector< SerranoCircularQueue<SerranoMessage*>* >& msg_queues = graph->msg_queues;
+
 	// Tick all units
-	for( auto next_unit : units ) {
-		next_unit.second->execute( currentCycle );
+	const size_t unit_count = units.size();
+	for( size_t i = 0; i < unit_count; ++i ) {
+		units[i]->execute( currentCycle );
 	}
 
 	bool units_continue  = false;
 	bool queues_continue = false;
 
 	// Do we have any units which want to continue processing
-	for( auto next_unit : units ) {
-		output->verbose(CALL_INFO, 16, 0, "Unit-ID: %" PRIu64 " status: %s\n", next_unit.first,
-			( next_unit.second->stillProcessing() ? "keep-processing" : "completed" ) );
-		units_continue |= next_unit.second->stillProcessing();
+	for( size_t i = 0; i < unit_count; ++i ) {
+		const bool unit_continue = units[i]->stillProcessing();
+		output->verbose(CALL_INFO, 16, 0, "Unit-ID: %" PRIu64 " status: %s\n", graph->unit_ids[i],
+			( unit_continue ? "keep-processing" : "completed" ) );
+		units_continue |= unit_continue;
 	}
 
 	// Check that any queue is not empty
-	for( auto next_q : msg_queues ) {
-		queues_continue |= ( ! next_q.second->empty() );
+	for( size_t i = 0; ( ! queues_continue ) && ( i < msg_queues.size() ); ++i ) {
+		queues_continue |= ( ! msg_queues[i]->empty() );
 	}
 
 	if( units_continue ) {
@@ -97,6 +115,10 @@ bool SerranoComponent::tick( SST::Cycle_t currentCycle ) {
 		if( queues_continue ) {
 			output->verbose(CALL_INFO, 4, 0, "Queues contain entries that may need processing, continue for another cycle.\n");
 			return false;
+		} else if( kernel_queue.size() > 0 ) {
+			output->verbose(CALL_INFO, 4, 0, "Kernel is complete, launching the next kernel next cycle.\n");
+			launchNextKernel();
+			return false;
 		} else {
 			output->verbose(CALL_INFO, 4, 0, "Neither queues or units have no work, no need to continue processing.\n");
 			primaryComponentOKToEndSim();
@@ -106,7 +128,22 @@ bool SerranoComponent::tick( SST::Cycle_t currentCycle ) {
 
 }
 
-void SerranoComponent::constructGraph( SST::Output* output, const char* kernel_file ) {
+// Kernels run back to back on graphs configured at construction. Relaunching
+// a graph only resets the state of its units and drains its queues.
+void SerranoComponent::launchNextKernel() {
+	const std::string next_kernel = kernel_queue.front();
+	kernel_queue.pop_front();
+
+	graph = kernel_graphs[ next_kernel ];
+	output->verbose(CALL_INFO, 2, 0, "Launching kernel %s\n", next_kernel.c_str());
+
+	if( graph->launched ) {
+		resetGraph( graph );
+	}
+	graph->launched = true;
+}
+
+SerranoGraph* SerranoComponent::constructGraph( SST::Output* output, const char* kernel_file ) {
 	output->verbose(CALL_INFO, 4, 0, "Parsing kernel at: %s...\n", kernel_file);
 	FILE* graph_file = fopen( kernel_file, "rt" );
 
@@ -120,6 +157,12 @@ void SerranoComponent::constructGraph( SST::Output* output, const char* kernel_f
 
 	Params empty_params;
 
+	SerranoGraph* new_graph = new SerranoGraph();
+	std::vector< SerranoCoarseUnit* >& units = new_graph->units;
+
+	// Graph file ids to unit slots, only needed while constructing
+	std::map< uint64_t, size_t > unit_slots;
+
 	while( ! feof( graph_file ) ) {
 		read_line( graph_file, line, buff_max);
 		printf("Line[%s]\n", line);
@@ -193,7 +236,13 @@ void SerranoComponent::constructGraph( SST::Output* output, const char* kernel_f
 				output->fatal(CALL_INFO, -1, "Error: unable to parse node type (%s)\n", token );
 			}
 
-			units.insert( std::pair< uint64_t, SerranoCoarseUnit* >( id, new_unit ) );
+			if( unit_slots.find( id ) != unit_slots.end() ) {
+				output->fatal(CALL_INFO, -1, "Error: node id %" PRIu64 " is defined more than once.\n", id );
+			}
+
+			unit_slots.insert( std::pair< uint64_t, size_t >( id, units.size() ) );
+			units.push_back( new_unit );
+			new_graph->unit_ids.push_back( id );
 		} else if( 0 == strcmp( token, "LINK" ) ) {
 			char* in_unit      = strtok( nullptr, " " );
 			char* out_unit     = strtok( nullptr, " " );
@@ -203,12 +252,16 @@ void SerranoComponent::constructGraph( SST::Output* output, const char* kernel_f
 
 			SerranoCircularQueue<SerranoMessage*>* new_q = new SerranoCircularQueue<SerranoMessage*>(2);
 
-			if( ( units.find( u64_in_unit ) != units.end() ) && ( units.find( u64_out_unit ) != units.end() ) ) {
+			auto in_slot  = unit_slots.find( u64_in_unit );
+			auto out_slot = unit_slots.find( u64_out_unit );
+
+			if( ( in_slot != unit_slots.end() ) && ( out_slot != unit_slots.end() ) ) {
 				output->verbose(CALL_INFO, 4, 0, "Connecting %" PRIu64 " -> %" PRIu64 " (link-id: %" PRIu64 ")\n",
 					u64_in_unit, u64_out_unit, id);
 				// These are swapped, input to the link is the output of a unit and vice versa
-				units[ u64_in_unit  ]->addOutputQueue( new_q );
-				units[ u64_out_unit ]->addInputQueue( new_q );
+				units[ in_slot->second  ]->addOutputQueue( new_q );
+				units[ out_slot->second ]->addInputQueue( new_q );
+				new_graph->msg_queues.push_back( new_q );
 			} else {
 				output->fatal(CALL_INFO, -1, "Error: link does not connect an existing input or output component.\n");
 			}
@@ -220,10 +273,21 @@ void SerranoComponent::constructGraph( SST::Output* output, const char* kernel_f
 	delete[] line;
 	fclose( graph_file );
 
+	/* units tick in ascending id order, whatever order the file lists them in */
+	std::vector< SerranoCoarseUnit* > file_order( units );
+	size_t next_slot = 0;
+	for( auto next_id : unit_slots ) {
+		units[ next_slot ] = file_order[ next_id.second ];
+		new_graph->unit_ids[ next_slot ] = next_id.first;
+		next_slot++;
+	}
+
 	/* cycle over and check queues are good, these will fatal */
-	for( auto next_unit : units ) {
-		next_unit.second->checkRequiredQueues( output );
+	for( SerranoCoarseUnit* next_unit : units ) {
+		next_unit->checkRequiredQueues( output );
 	}
+
+	return new_graph;
 }
 
 int SerranoComponent::read_line( FILE* file_h, char* buffer, const size_t buffer_max ) {
@@ -254,17 +318,38 @@ int SerranoComponent::read_line( FILE* file_h, char* buffer, const size_t buffer
 void SerranoComponent::clearGraph() {
 	output->verbose(CALL_INFO, 2, 0, "Clearing current graph...\n");
 
-	for( auto next_q : msg_queues ) {
-		delete next_q.second;;
-	}
+	for( auto next_graph : kernel_graphs ) {
+		for( SerranoCircularQueue<SerranoMessage*>* next_q : next_graph.second->msg_queues ) {
+			while( ! next_q->empty() ) {
+				delete next_q->pop();
+			}
+			delete next_q;
+		}
 
-	msg_queues.clear();
+		for( SerranoCoarseUnit* next_unit : next_graph.second->units ) {
+			delete next_unit;
+		}
 
-	for( auto next_unit : units ) {
-		delete next_unit.second;
+		delete next_graph.second;
 	}
 
-	units.clear();
+	kernel_graphs.clear();
+	kernel_queue.clear();
+	graph = nullptr;
 
 	output->verbose(CALL_INFO, 2, 0, "Graph clear done. Reset is complete\n");
 }
+
+void SerranoComponent::resetGraph( SerranoGraph* kernel_graph ) {
+	output->verbose(CALL_INFO, 2, 0, "Resetting graph for relaunch...\n");
+
+	for( SerranoCircularQueue<SerranoMessage*>* next_q : kernel_graph->msg_queues ) {
+		while( ! next_q->empty() ) {
+			delete next_q->pop();
+		}
+	}
+
+	for( SerranoCoarseUnit* next_unit : kernel_graph->units ) {
+		next_unit->reset();
+	}
+}
@@ -23,6 +23,8 @@
 #include <cstdio>
 #include <list>
 #include <map>
+#include <string>
+#include <vector>
 
 #include "smsg.h"
 #include "scircq.h"
@@ -32,6 +34,15 @@
 namespace SST {
 namespace Serrano {
 
+// A configured kernel graph. Units are kept in ascending id order,
+// unit_ids holds the graph file id of each unit slot.
+struct SerranoGraph {
+	std::vector< SerranoCoarseUnit* > units;
+	std::vector< uint64_t > unit_ids;
+	std::vector< SerranoCircularQueue<SerranoMessage*>* > msg_queues;
+	bool launched = false;
+};
+
 class SerranoComponent : public SST::Component {
 
 public:
@@ -58,15 +69,19 @@ public:
 		)
 
 	void clearGraph();
-	void constructGraph( SST::Output* output, const char* kernel_file );
+	void resetGraph( SerranoGraph* kernel_graph );
+	SerranoGraph* constructGraph( SST::Output* output, const char* kernel_file );
 
 private:
 	int read_line( FILE* file_h, char* buffer, const size_t buffer_max );
+	void launchNextKernel();
 
 	SST::Output* output;
 	std::list< std::string > kernel_queue;
-	std::map< uint64_t, SerranoCoarseUnit* > units;
-	std::map< uint64_t, SerranoCircularQueue<SerranoMessage*>* > msg_queues;
+
+	// One graph per distinct kernel file, all configured at construction
+	std::map< std::string, SerranoGraph* > kernel_graphs;
+	SerranoGraph* graph;
 
 
 };
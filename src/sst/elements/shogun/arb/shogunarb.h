@@ -16,6 +16,8 @@
 #ifndef _H_SHOGUN_ARB_H
 #define _H_SHOGUN_ARB_H
 
+#include <vector>
+
 #include "shogun_event.h"
 #include "shogun_q.h"
 
@@ -51,6 +53,56 @@ namespace Shogun {
         }
 
     protected:
+        /*
+         * Virtual output queues are kept over the shared input buffer: the
+         * oldest event for each destination is the head of that destination's
+         * queue. Fills heads[dest] with its index in the buffer, -1 if empty.
+         */
+        void findVOQHeads(ShogunQueue<ShogunEvent*>* q, const int port_count, std::vector<int>& heads) const
+        {
+            heads.assign(port_count, -1);
+
+            for (int i = 0; i < q->count(); ++i) {
+                const int dest = q->peekAt(i)->getDestination();
+
+                if (heads[dest] < 0) {
+                    heads[dest] = i;
+                }
+            }
+        }
+
+        // Index of a free output slot for dest, -1 if all are taken
+        int freeOutputSlot(ShogunEvent*** outputEvents, const int32_t output_slots, const int dest) const
+        {
+            for (int32_t k = 0; k < output_slots; ++k) {
+                if (nullptr == outputEvents[dest][k]) {
+                    return k;
+                }
+            }
+
+            return -1;
+        }
+
+        int freeOutputSlotCount(ShogunEvent*** outputEvents, const int32_t output_slots, const int dest) const
+        {
+            int free_slots = 0;
+
+            for (int32_t k = 0; k < output_slots; ++k) {
+                if (nullptr == outputEvents[dest][k]) {
+                    free_slots++;
+                }
+            }
+
+            return free_slots;
+        }
+
+        // Moves the event at index in the input buffer to a free slot of its destination
+        void moveVOQEvent(ShogunQueue<ShogunEvent*>* q, const int index, ShogunEvent*** outputEvents, const int32_t output_slots)
+        {
+            ShogunEvent* ev = q->removeAt(index);
+            outputEvents[ev->getDestination()][freeOutputSlot(outputEvents, output_slots, ev->getDestination())] = ev;
+        }
+
         SST::Output* output;
         ShogunStatisticsBundle* bundle;
     };
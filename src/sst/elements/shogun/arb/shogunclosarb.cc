@@ -0,0 +1,118 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "shogun_event.h"
+#include "shogunclosarb.h"
+#include "shogun_stat_bundle.h"
+
+using namespace SST::Shogun;
+
+ShogunClosArbitrator::ShogunClosArbitrator(const int port_count, const int switch_ports, const int middle_switches)
+    : switchPorts(switch_ports)
+    , middleSwitches(middle_switches)
+    , edgeSwitches((port_count + switch_ports - 1) / switch_ports)
+    , lastStart(0)
+    , lastMiddle(0)
+{
+    ingressBusy.resize(edgeSwitches * middleSwitches);
+    egressBusy.resize(edgeSwitches * middleSwitches);
+}
+
+ShogunClosArbitrator::~ShogunClosArbitrator() {}
+
+void ShogunClosArbitrator::moveEvents(const int num_events,
+                                      const int port_count,
+                                      ShogunQueue<ShogunEvent*>** inputQueues,
+                                      int32_t output_slots,
+                                      ShogunEvent*** outputEvents,
+                                      uint64_t cycle ) {
+
+    output->verbose(CALL_INFO, 4, 0, "BEGIN: Clos Arbitration ---------------------------------------------\n");
+    output->verbose(CALL_INFO, 4, 0, "-> start: %" PRIi32 "\n", lastStart);
+
+    ingressBusy.assign(ingressBusy.size(), false);
+    egressBusy.assign(egressBusy.size(), false);
+
+    std::vector<bool> offered(port_count);
+    int32_t currentPort = lastStart;
+    int32_t moved_count = 0;
+
+    for (int32_t i = 0; i < port_count; ++i) {
+        ShogunQueue<ShogunEvent*>* q = inputQueues[currentPort];
+        const int ingress = currentPort / switchPorts;
+        int32_t sent = 0;
+
+        offered.assign(port_count, false);
+
+        // Walk the buffer oldest first, offering only the head of each destination
+        int32_t index = 0;
+        while (index < q->count() && (sent < num_events || num_events == -1)) {
+            const int dest = q->peekAt(index)->getDestination();
+
+            if (offered[dest]) {
+                ++index;
+                continue;
+            }
+
+            offered[dest] = true;
+
+            if (freeOutputSlot(outputEvents, output_slots, dest) < 0) {
+                output->verbose(CALL_INFO, 4, 0, "  -> output %" PRIi32 " full...\n", dest);
+                ++index;
+                continue;
+            }
+
+            const int egress = dest / switchPorts;
+            int middle = -1;
+
+            for (int32_t m = 0; m < middleSwitches; ++m) {
+                const int candidate = (lastMiddle + m) % middleSwitches;
+
+                if (!ingressBusy[ingress * middleSwitches + candidate] && !egressBusy[egress * middleSwitches + candidate]) {
+                    middle = candidate;
+                    break;
+                }
+            }
+
+            if (middle < 0) {
+                output->verbose(CALL_INFO, 4, 0, "  -> no middle switch free from: %" PRIi32 " to: %" PRIi32 "\n", currentPort, dest);
+                ++index;
+                continue;
+            }
+
+            output->verbose(CALL_INFO, 4, 0, "  -> moving event from: %" PRIi32 " to: %" PRIi32 " via middle switch %d\n",
+                currentPort, dest, middle);
+
+            ingressBusy[ingress * middleSwitches + middle] = true;
+            egressBusy[egress * middleSwitches + middle] = true;
+            lastMiddle = (middle + 1) % middleSwitches;
+
+            // The next event now sits at index, so it is examined without advancing
+            moveVOQEvent(q, index, outputEvents, output_slots);
+            moved_count++;
+            sent++;
+        }
+
+        currentPort = (currentPort + 1) % port_count;
+    }
+
+    lastStart = (lastStart + 1) % port_count;
+
+    bundle->getPacketsMoved()->addData(moved_count);
+    output->verbose(CALL_INFO, 4, 0, "-> next-start: %" PRIi32 "\n", lastStart);
+    output->verbose(CALL_INFO, 4, 0, "END: Clos Arbitration -----------------------------------------------\n");
+}
@@ -0,0 +1,65 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SHOGUN_CLOS_ARB_H
+#define _H_SHOGUN_CLOS_ARB_H
+
+#include <vector>
+
+#include "shogun_event.h"
+#include "shogunarb.h"
+
+namespace SST {
+namespace Shogun {
+
+    /*
+     * Three stage Clos crossbar. Ports are grouped into ingress and egress
+     * switches of switch_ports ports each, joined by middle_switches middle
+     * switches. Every ingress to middle and middle to egress link carries one
+     * event per cycle, so an event moves only if some middle switch has both
+     * of its links free. Inputs are served round-robin, each offering its
+     * virtual output queue heads oldest first, and take the first fitting
+     * middle switch from a rotating start.
+     */
+    class ShogunClosArbitrator : public ShogunArbitrator {
+
+    public:
+        ShogunClosArbitrator(const int port_count, const int switch_ports, const int middle_switches);
+        ~ShogunClosArbitrator();
+
+        void moveEvents(const int num_events,
+                        const int port_count,
+                        ShogunQueue<ShogunEvent*>** inputQueues,
+                        int32_t output_slots,
+                        ShogunEvent*** outputEvents,
+                        uint64_t cycle ) override;
+
+    private:
+        const int switchPorts;
+        const int middleSwitches;
+        const int edgeSwitches;
+
+        int lastStart;
+        int lastMiddle;
+
+        // Links in use this cycle, indexed [edge switch * middleSwitches + middle switch]
+        std::vector<bool> ingressBusy;
+        std::vector<bool> egressBusy;
+    };
+
+}
+}
+
+#endif
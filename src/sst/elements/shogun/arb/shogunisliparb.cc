@@ -0,0 +1,116 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "shogun_event.h"
+#include "shogunisliparb.h"
+#include "shogun_stat_bundle.h"
+
+using namespace SST::Shogun;
+
+ShogunISLIPArbitrator::ShogunISLIPArbitrator(const int iterations)
+    : iterations(iterations)
+{
+}
+
+ShogunISLIPArbitrator::~ShogunISLIPArbitrator() {}
+
+void ShogunISLIPArbitrator::moveEvents(const int num_events,
+                                       const int port_count,
+                                       ShogunQueue<ShogunEvent*>** inputQueues,
+                                       int32_t output_slots,
+                                       ShogunEvent*** outputEvents,
+                                       uint64_t cycle ) {
+
+    output->verbose(CALL_INFO, 4, 0, "BEGIN: iSLIP Arbitration --------------------------------------------\n");
+
+    if (grantPtr.empty()) {
+        grantPtr.assign(port_count, 0);
+        acceptPtr.assign(port_count, 0);
+    }
+
+    std::vector<int> input_left(port_count);
+    std::vector<int> output_left(port_count);
+    std::vector<int> grants(port_count);
+    std::vector<std::vector<int>> heads(port_count);
+
+    for (int32_t i = 0; i < port_count; ++i) {
+        input_left[i] = (num_events < 0) ? inputQueues[i]->count() : num_events;
+        output_left[i] = freeOutputSlotCount(outputEvents, output_slots, i);
+    }
+
+    int32_t moved_count = 0;
+
+    for (int it = 0; it < iterations; ++it) {
+        for (int32_t i = 0; i < port_count; ++i) {
+            findVOQHeads(inputQueues[i], port_count, heads[i]);
+        }
+
+        // Grant: each free output picks the first requesting input from its pointer
+        for (int32_t o = 0; o < port_count; ++o) {
+            grants[o] = -1;
+
+            if (output_left[o] == 0) {
+                continue;
+            }
+
+            for (int32_t k = 0; k < port_count; ++k) {
+                const int32_t in = (grantPtr[o] + k) % port_count;
+
+                if (input_left[in] > 0 && heads[in][o] >= 0) {
+                    grants[o] = in;
+                    break;
+                }
+            }
+        }
+
+        // Accept: each input takes the first granting output from its pointer
+        bool matched = false;
+
+        for (int32_t in = 0; in < port_count; ++in) {
+            if (input_left[in] == 0) {
+                continue;
+            }
+
+            for (int32_t k = 0; k < port_count; ++k) {
+                const int32_t o = (acceptPtr[in] + k) % port_count;
+
+                if (grants[o] == in) {
+                    output->verbose(CALL_INFO, 4, 0, "  (%d)-> moving event from: %" PRIi32 " to: %" PRIi32 "\n", it, in, o);
+                    moveVOQEvent(inputQueues[in], heads[in][o], outputEvents, output_slots);
+
+                    if (it == 0) {
+                        acceptPtr[in] = (o + 1) % port_count;
+                        grantPtr[o] = (in + 1) % port_count;
+                    }
+
+                    input_left[in]--;
+                    output_left[o]--;
+                    moved_count++;
+                    matched = true;
+                    break;
+                }
+            }
+        }
+
+        if (!matched) {
+            break;
+        }
+    }
+
+    bundle->getPacketsMoved()->addData(moved_count);
+    output->verbose(CALL_INFO, 4, 0, "END: iSLIP Arbitration ----------------------------------------------\n");
+}
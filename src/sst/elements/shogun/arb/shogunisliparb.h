@@ -0,0 +1,58 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SHOGUN_ISLIP_ARB_H
+#define _H_SHOGUN_ISLIP_ARB_H
+
+#include <vector>
+
+#include "shogun_event.h"
+#include "shogunarb.h"
+
+namespace SST {
+namespace Shogun {
+
+    /*
+     * iSLIP allocator [McKeown 1999] over virtual output queues. Every
+     * iteration each input requests all outputs it holds events for, each
+     * output grants the requesting input at or after its grant pointer and
+     * each input accepts the granting output at or after its accept pointer.
+     * Pointers only move past an accepted match of the first iteration, so
+     * they desynchronise under load.
+     */
+    class ShogunISLIPArbitrator : public ShogunArbitrator {
+
+    public:
+        ShogunISLIPArbitrator(const int iterations);
+        ~ShogunISLIPArbitrator();
+
+        void moveEvents(const int num_events,
+                        const int port_count,
+                        ShogunQueue<ShogunEvent*>** inputQueues,
+                        int32_t output_slots,
+                        ShogunEvent*** outputEvents,
+                        uint64_t cycle ) override;
+
+    private:
+        const int iterations;
+
+        std::vector<int> grantPtr;
+        std::vector<int> acceptPtr;
+    };
+
+}
+}
+
+#endif
@@ -0,0 +1,77 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "shogun_event.h"
+#include "shogunwavefrontarb.h"
+#include "shogun_stat_bundle.h"
+
+using namespace SST::Shogun;
+
+ShogunWavefrontArbitrator::ShogunWavefrontArbitrator()
+    : priorityDiagonal(0)
+{
+}
+
+ShogunWavefrontArbitrator::~ShogunWavefrontArbitrator() {}
+
+void ShogunWavefrontArbitrator::moveEvents(const int num_events,
+                                           const int port_count,
+                                           ShogunQueue<ShogunEvent*>** inputQueues,
+                                           int32_t output_slots,
+                                           ShogunEvent*** outputEvents,
+                                           uint64_t cycle ) {
+
+    output->verbose(CALL_INFO, 4, 0, "BEGIN: Wavefront Arbitration ----------------------------------------\n");
+    output->verbose(CALL_INFO, 4, 0, "-> priority diagonal: %" PRIi32 "\n", priorityDiagonal);
+
+    std::vector<int> input_left(port_count);
+    std::vector<int> output_left(port_count);
+    std::vector<std::vector<int>> heads(port_count);
+
+    for (int32_t i = 0; i < port_count; ++i) {
+        input_left[i] = (num_events < 0) ? inputQueues[i]->count() : num_events;
+        output_left[i] = freeOutputSlotCount(outputEvents, output_slots, i);
+        findVOQHeads(inputQueues[i], port_count, heads[i]);
+    }
+
+    int32_t moved_count = 0;
+
+    for (int32_t d = 0; d < port_count; ++d) {
+        const int32_t diagonal = (priorityDiagonal + d) % port_count;
+
+        for (int32_t in = 0; in < port_count; ++in) {
+            const int32_t o = (in + diagonal) % port_count;
+
+            if (input_left[in] > 0 && output_left[o] > 0 && heads[in][o] >= 0) {
+                output->verbose(CALL_INFO, 4, 0, "  -> moving event from: %" PRIi32 " to: %" PRIi32 "\n", in, o);
+                moveVOQEvent(inputQueues[in], heads[in][o], outputEvents, output_slots);
+
+                // Events behind the one moved are now one slot closer to the head
+                findVOQHeads(inputQueues[in], port_count, heads[in]);
+
+                input_left[in]--;
+                output_left[o]--;
+                moved_count++;
+            }
+        }
+    }
+
+    priorityDiagonal = (priorityDiagonal + 1) % port_count;
+
+    bundle->getPacketsMoved()->addData(moved_count);
+    output->verbose(CALL_INFO, 4, 0, "END: Wavefront Arbitration ------------------------------------------\n");
+}
@@ -0,0 +1,54 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SHOGUN_WAVEFRONT_ARB_H
+#define _H_SHOGUN_WAVEFRONT_ARB_H
+
+#include <vector>
+
+#include "shogun_event.h"
+#include "shogunarb.h"
+
+namespace SST {
+namespace Shogun {
+
+    /*
+     * Wavefront allocator [Tamir and Chi 1993] over virtual output queues.
+     * The request matrix of inputs by outputs is swept one wrapped diagonal
+     * at a time; cells on a diagonal never share an input or an output so
+     * each can be granted independently while both still have capacity. The
+     * diagonal that goes first rotates every cycle.
+     */
+    class ShogunWavefrontArbitrator : public ShogunArbitrator {
+
+    public:
+        ShogunWavefrontArbitrator();
+        ~ShogunWavefrontArbitrator();
+
+        void moveEvents(const int num_events,
+                        const int port_count,
+                        ShogunQueue<ShogunEvent*>** inputQueues,
+                        int32_t output_slots,
+                        ShogunEvent*** outputEvents,
+                        uint64_t cycle ) override;
+
+    private:
+        int priorityDiagonal;
+    };
+
+}
+}
+
+#endif
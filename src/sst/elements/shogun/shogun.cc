@@ -19,7 +19,10 @@
 #include <sst/core/output.h>
 #include <sst/core/unitAlgebra.h>
 
+#include "arb/shogunclosarb.h"
+#include "arb/shogunisliparb.h"
 #include "arb/shogunrrarb.h"
+#include "arb/shogunwavefrontarb.h"
 #include "shogun.h"
 #include "shogun_credit_event.h"
 #include "shogun_init_event.h"
@@ -43,14 +46,11 @@ ShogunComponent::ShogunComponent(ComponentId_t id, Params& params)
     previousCycle = 0;
     pending_events = 0;
 
-    arb = new ShogunRoundRobinArbitrator();
-
     const int32_t verbosity = params.find<uint32_t>("verbose", 0);
 
     char prefix[256];
     snprintf(prefix, 256, "[t=@t][%s]: ", getName().c_str());
     output = new SST::Output(prefix, verbosity, 0, Output::STDOUT);
-    arb->setOutput(output);
 
     port_count = params.find<int32_t>("port_count", -1);
 
@@ -65,6 +65,48 @@ ShogunComponent::ShogunComponent(ComponentId_t id, Params& params)
         output->fatal(CALL_INFO, -1, "Error: you specified a port count of less than or equal to zero.\n");
     }
 
+    const std::string arbitration = params.find<std::string>("arbitration", "roundrobin");
+
+    if (arbitration == "roundrobin") {
+        arb = new ShogunRoundRobinArbitrator();
+    } else if (arbitration == "islip") {
+        const int32_t iterations = params.find<int32_t>("islip_iterations", 4);
+
+        if (iterations <= 0) {
+            output->fatal(CALL_INFO, -1, "Error: islip_iterations must be at least 1.\n");
+        }
+
+        arb = new ShogunISLIPArbitrator(iterations);
+    } else if (arbitration == "wavefront") {
+        arb = new ShogunWavefrontArbitrator();
+    } else if (arbitration == "clos") {
+        int32_t switch_ports = params.find<int32_t>("clos_switch_ports", 0);
+        int32_t middle_switches = params.find<int32_t>("clos_middle_switches", 0);
+
+        if (switch_ports < 0 || middle_switches < 0) {
+            output->fatal(CALL_INFO, -1, "Error: clos_switch_ports and clos_middle_switches cannot be negative.\n");
+        }
+
+        if (0 == switch_ports) {
+            while (switch_ports * switch_ports < port_count) {
+                switch_ports++;
+            }
+        }
+
+        if (0 == middle_switches) {
+            middle_switches = switch_ports;
+        }
+
+        output->verbose(CALL_INFO, 1, 0, "Clos crossbar with %" PRIi32 " ports per edge switch and %" PRIi32 " middle switches\n",
+            switch_ports, middle_switches);
+
+        arb = new ShogunClosArbitrator(port_count, switch_ports, middle_switches);
+    } else {
+        output->fatal(CALL_INFO, -1, "Error: unknown arbitration scheme '%s'.\n", arbitration.c_str());
+    }
+
+    arb->setOutput(output);
+
     output->verbose(CALL_INFO, 1, 0, "Connecting %" PRIi32 " links...\n", port_count);
     links = (SST::Link**)malloc(sizeof(SST::Link*) * (port_count));
     char* linkName = new char[256];
@@ -45,7 +45,10 @@ public:
     SST_ELI_DOCUMENT_PARAMS(
         { "verbose",                "Level of output verbosity, higher is more output, 0 is no output", 0 },
         { "port_count",             "Number of ports on the Crossbar", "0" },
-        { "arbitration",            "Select the arbitration scheme", "roundrobin" },
+        { "arbitration",            "Select the arbitration scheme: roundrobin (head of input queue), or over virtual output queues islip, wavefront or clos (three stage crossbar)", "roundrobin" },
+        { "islip_iterations",       "Request-grant-accept iterations per cycle for islip arbitration", "4" },
+        { "clos_switch_ports",      "Ports per ingress/egress switch for clos arbitration; 0 is the square root of port_count", "0" },
+        { "clos_middle_switches",   "Middle switches for clos arbitration; 0 is clos_switch_ports (rearrangeably non-blocking)", "0" },
         { "clock",                  "Clock Frequency for the crossbar", "1.0GHz" },
         { "queue_slots",            "Depth of input queue", "64" },
         { "in_msg_per_cycle",       "Number of messages injested per cycle; -1 is unlimited", "1" },
@@ -63,6 +63,12 @@ namespace Shogun {
             return item;
         }
 
+        // Returns the i-th oldest item, 0 is the head
+        T peekAt(const int i) const
+        {
+            return queue[(head + i) % buffMax];
+        }
+
         T pop()
         {
             T item = queue[head];
@@ -72,6 +78,20 @@ namespace Shogun {
             return item;
         }
 
+        // Removes the i-th oldest item, the items behind it move up one slot
+        T removeAt(const int i)
+        {
+            T item = peekAt(i);
+
+            for (int j = i; j < size - 1; ++j) {
+                queue[(head + j) % buffMax] = queue[(head + j + 1) % buffMax];
+            }
+
+            tail = (tail + buffMax - 1) % buffMax;
+            size--;
+            return item;
+        }
+
         void push(T newItem)
         {
             queue[tail] = newItem;
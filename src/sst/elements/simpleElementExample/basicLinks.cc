@@ -62,8 +62,9 @@ basicLinks::basicLinks(ComponentId_t id, Params& params) : Component(id) {
     registerAsPrimaryComponent();
     primaryComponentDoNotEndSim();
 
-    //set our clock. The simulator will call 'clockTic' at a 1GHz frequency
-    registerClock("1GHz", new Clock::Handler2<basicLinks, &basicLinks::clockTic>(this));
+    // set our clock. The simulator will call 'clockTic' at the 'clock' frequency, 1GHz by default
+    std::string clock = params.find<std::string>("clock", "1GHz");
+    registerClock(clock, new Clock::Handler2<basicLinks, &basicLinks::clockTic>(this));
 
     // This simulation will end when we have sent 'eventsToSend' events and received a 'LAST' event on every link
     lastEventReceived = 0;
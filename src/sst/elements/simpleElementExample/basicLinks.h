@@ -75,7 +75,8 @@ public:
     // { "parameter_name", "description", "default value or NULL if required" }
     SST_ELI_DOCUMENT_PARAMS(
         { "eventsToSend", "How many events this component should send.", NULL},
-        { "eventSize",    "Payload size for each event, in bytes.", "16"}
+        { "eventSize",    "Payload size for each event, in bytes.", "16"},
+        { "clock",        "Frequency of the clock, one event is sent each cycle.", "1GHz"}
     )
 
     // Document the ports that this component has
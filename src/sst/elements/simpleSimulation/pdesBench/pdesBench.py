@@ -0,0 +1,97 @@
+# Copyright 2009-2025 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2025, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Parallel scaling microbenchmark. Builds one of two small, well understood
+# models whose size and communication pattern are set on the command line:
+#
+#   links   - simpleElementExample.basicLinks components joined as a
+#             hypercube. port_handler and port_polled join component i and
+#             i^1, port_vector<j> joins i and i^(2<<j), so each component
+#             talks to fanout+1 neighbors. Every component sends one event
+#             per cycle of 'clock' to a random link, 'events' events in
+#             all, with a payload of up to 'payload' bytes.
+#   carwash - independent simpleSimulation distCarGenerator/distCarWash
+#             pairs. Cars are events and 'latency' is the link between
+#             the generator and the wash.
+#
+# The latency of every link is the lookahead the parallel core gets.
+#
+#   sst -n 4 pdesBench.py --model-options="--model links --components 256 --fanout 4 --latency 10ns"
+#
+# runPdesBench.py sweeps these options over thread and rank counts.
+
+import argparse
+import sst
+
+parser = argparse.ArgumentParser(description="SST parallel scaling microbenchmark")
+parser.add_argument("--model", choices=["links", "carwash"], default="links")
+parser.add_argument("--components", type=int, default=64, help="links: number of components, a power of two")
+parser.add_argument("--fanout", type=int, default=2, help="links: port_vector links per component")
+parser.add_argument("--events", type=int, default=10000, help="links: events each component sends")
+parser.add_argument("--payload", type=int, default=16, help="links: maximum event payload in bytes")
+parser.add_argument("--clock", default="1GHz", help="links: event rate of each component")
+parser.add_argument("--pairs", type=int, default=64, help="carwash: generator/wash pairs")
+parser.add_argument("--arrival", type=int, default=2, help="carwash: minutes between car arrival attempts")
+parser.add_argument("--time", type=int, default=4320, help="carwash: minutes each wash is open")
+parser.add_argument("--latency", default=None, help="link latency (default 1ns for links, 60s for carwash)")
+args = parser.parse_args()
+
+
+def build_links():
+    n = args.components
+    if n < 2 or (n & (n - 1)) != 0:
+        print("pdesBench: --components must be a power of two of at least 2")
+        sst.exit()
+    if (2 << args.fanout) > n:
+        print("pdesBench: --fanout %d needs at least %d components" % (args.fanout, 2 << args.fanout))
+        sst.exit()
+
+    latency = args.latency or "1ns"
+    params = {
+        "eventsToSend" : args.events,
+        "eventSize" : args.payload,
+        "clock" : args.clock,
+    }
+
+    comps = []
+    for i in range(n):
+        comp = sst.Component("c%d" % i, "simpleElementExample.basicLinks")
+        comp.addParams(params)
+        comps.append(comp)
+
+    def join(port, mask):
+        for i in range(n):
+            j = i ^ mask
+            if i < j:
+                link = sst.Link("%s_%d_%d" % (port, i, j))
+                link.connect((comps[i], port, latency), (comps[j], port, latency))
+
+    join("port_handler", 1)
+    join("port_polled", 1)
+    for v in range(args.fanout):
+        join("port_vector%d" % v, 2 << v)
+
+
+def build_carwash():
+    latency = args.latency or "60s"
+    for i in range(args.pairs):
+        gen = sst.Component("generator%d" % i, "simpleSimulation.distCarGenerator")
+        gen.addParams({ "random_seed" : 151515 + i, "arrival_frequency" : args.arrival })
+        wash = sst.Component("carwash%d" % i, "simpleSimulation.distCarWash")
+        wash.addParams({ "time" : args.time })
+        link = sst.Link("car%d" % i)
+        link.connect((gen, "car", latency), (wash, "car", latency))
+
+
+if args.model == "links":
+    build_links()
+else:
+    build_carwash()
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+# Copyright 2009-2025 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2025, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+"""
+Run pdesBench.py over a sweep of model options and thread/rank counts and
+print one CSV row per run.
+
+Every comma separated option is swept, all combinations are run:
+
+    runPdesBench.py --model links --components 256 --latency 1ns,10ns,100ns \\
+        --threads 1,2,4,8 --ranks 1,2 > links.csv
+
+Columns:
+    run_s        run loop wall time reported by --print-timing-info
+    events       events sent over links. For links this follows from the
+                 parameters, for carwash it is the cars that arrived
+    events_per_s events / run_s
+    speedup      run_s of the 1 rank, 1 thread run of the same point / run_s
+    efficiency   speedup / (ranks * threads)
+    overhead_s   run_s - serial run_s / (ranks * threads), the time lost to
+                 synchronisation and imbalance
+    sync_data    global sync data size reported by SST (bytes), if any
+
+The serial run of each point is always made, so speedup needs no separate
+baseline. --profile-sync adds SST's sync-time profiling point and keeps its
+output in --work-dir.
+"""
+
+import argparse
+import itertools
+import os
+import re
+import subprocess
+import sys
+
+def split(value, cast=str):
+    return [cast(v) for v in value.split(",") if v]
+
+def parse_seconds(text, label):
+    m = re.search(label + r"[^:\n]*:\s*([0-9.eE+-]+)\s*(\w*)", text)
+    if not m:
+        return None
+    scale = { "s" : 1.0, "ms" : 1.0e-3, "us" : 1.0e-6, "ns" : 1.0e-9 }.get(m.group(2), 1.0)
+    return float(m.group(1)) * scale
+
+def parse_bytes(text, label):
+    m = re.search(label + r"[^:\n]*:\s*([0-9.]+)\s*(\w*)", text)
+    if not m:
+        return None
+    scale = { "B" : 1, "KB" : 1e3, "KiB" : 1024, "MB" : 1e6, "MiB" : 1024 ** 2, "GB" : 1e9, "GiB" : 1024 ** 3 }.get(m.group(2), 1)
+    return int(float(m.group(1)) * scale)
+
+def count_events(args, point, text):
+    if args.model == "links":
+        # eventsToSend each, plus one 'last' event on every link
+        return point["components"] * (point["events"] + point["fanout"] + 2)
+    return sum(int(v) for v in re.findall(r"Number of cars that arrived:\s*(\d+)", text))
+
+def run(args, point, ranks, threads, tag):
+    options = " ".join("--%s %s" % (k, v) for k, v in point.items() if v is not None)
+    options += " --model %s" % args.model
+    cmd = []
+    if ranks > 1:
+        cmd += args.mpirun.split() + ["-np", str(ranks)]
+    cmd += [args.sst, "-n", str(threads), "--print-timing-info"]
+    if args.partitioner:
+        cmd += ["--partitioner", args.partitioner]
+    if args.profile_sync:
+        cmd += ["--enable-profiling=sync:sst.profile.sync.time.steady[sync]",
+                "--profiling-output=%s" % os.path.join(args.work_dir, tag + ".profile")]
+    cmd += ["--model-options=%s" % options, args.config]
+
+    result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    with open(os.path.join(args.work_dir, tag + ".out"), "w") as f:
+        f.write(" ".join(cmd) + "\n")
+        f.write(result.stdout)
+    if result.returncode != 0:
+        sys.exit("runPdesBench: '%s' failed, see %s" % (" ".join(cmd), os.path.join(args.work_dir, tag + ".out")))
+
+    run_s = parse_seconds(result.stdout, r"Run (?:stage|loop) [Tt]ime")
+    if run_s is None:
+        sys.exit("runPdesBench: no run time in the output of '%s'" % " ".join(cmd))
+    return run_s, count_events(args, point, result.stdout), parse_bytes(result.stdout, r"Global Sync data size")
+
+def main():
+    parser = argparse.ArgumentParser(description="Sweep pdesBench.py over thread and rank counts",
+                                     formatter_class=argparse.RawDescriptionHelpFormatter, epilog=__doc__)
+    parser.add_argument("--model", choices=["links", "carwash"], default="links")
+    parser.add_argument("--components", default="64")
+    parser.add_argument("--fanout", default="2")
+    parser.add_argument("--events", default="10000")
+    parser.add_argument("--payload", default="16")
+    parser.add_argument("--clock", default="1GHz")
+    parser.add_argument("--pairs", default="64")
+    parser.add_argument("--arrival", default="2")
+    parser.add_argument("--time", default="4320")
+    parser.add_argument("--latency", default=None)
+    parser.add_argument("--threads", default="1,2,4")
+    parser.add_argument("--ranks", default="1")
+    parser.add_argument("--partitioner", default=None, help="passed to sst --partitioner")
+    parser.add_argument("--profile-sync", action="store_true", help="enable SST's sync time profiling")
+    parser.add_argument("--sst", default="sst")
+    parser.add_argument("--mpirun", default="mpirun")
+    parser.add_argument("--config", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "pdesBench.py"))
+    parser.add_argument("--work-dir", default="pdesBench.runs", help="where the output of each run is kept")
+    args = parser.parse_args()
+
+    if args.model == "links":
+        sweep = { "components" : split(args.components, int), "fanout" : split(args.fanout, int),
+                  "events" : split(args.events, int), "payload" : split(args.payload, int),
+                  "clock" : split(args.clock) }
+    else:
+        sweep = { "pairs" : split(args.pairs, int), "arrival" : split(args.arrival, int),
+                  "time" : split(args.time, int) }
+    sweep["latency"] = split(args.latency) if args.latency else [None]
+
+    layouts = [(r, t) for r in split(args.ranks, int) for t in split(args.threads, int)]
+    if (1, 1) in layouts:
+        layouts.remove((1, 1))
+    layouts.insert(0, (1, 1))
+
+    os.makedirs(args.work_dir, exist_ok=True)
+    keys = list(sweep.keys())
+    print(",".join(["model"] + keys + ["ranks", "threads", "run_s", "events", "events_per_s",
+                                       "speedup", "efficiency", "overhead_s", "sync_data"]))
+
+    for n, values in enumerate(itertools.product(*[sweep[k] for k in keys])):
+        point = dict(zip(keys, values))
+        serial_s = None
+        for ranks, threads in layouts:
+            run_s, events, sync_data = run(args, point, ranks, threads, "p%d_r%d_t%d" % (n, ranks, threads))
+            if serial_s is None:
+                serial_s = run_s
+            workers = ranks * threads
+            speedup = serial_s / run_s if run_s > 0 else 0.0
+            row = [args.model] + [str(v) if v is not None else "" for v in values]
+            row += [str(ranks), str(threads), "%.6f" % run_s, str(events),
+                    "%.0f" % (events / run_s if run_s > 0 else 0.0), "%.3f" % speedup,
+                    "%.3f" % (speedup / workers), "%.6f" % (run_s - serial_s / workers),
+                    str(sync_data) if sync_data is not None else ""]
+            print(",".join(row))
+            sys.stdout.flush()
+
+if __name__ == "__main__":
+    main()
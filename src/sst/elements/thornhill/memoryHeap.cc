@@ -64,16 +64,47 @@ void MemoryHeap::eventHandler( Event* ev, int src ) {
 
     switch ( event->type ) {
       case MemoryHeapEvent::Alloc:
-        event->addr = m_currentVaddr;
+        event->addr = alloc( event->length );
         m_output.verbose(CALL_INFO,1,1,
 			"Alloc length=%zu addr=0x%" PRIx64 "\n",
 									event->length,event->addr);
-        m_currentVaddr += event->length;
+        break;
+      case MemoryHeapEvent::AllocBatch:
+        m_output.verbose(CALL_INFO,1,1,"AllocBatch num=%zu\n", event->lengths.size());
+        event->addrs.resize( event->lengths.size() );
+        for ( size_t i = 0; i < event->lengths.size(); i++ ) {
+            event->addrs[i] = alloc( event->lengths[i] );
+        }
         break;
       case MemoryHeapEvent::Free:
         m_output.verbose(CALL_INFO,1,1,"free addr=%" PRIx64 "\n", event->addr);
-		assert(0);
+        free( event->addr );
+        break;
     }
 
 	m_links[src]->send(0,event);
 }
+
+SimVAddr MemoryHeap::alloc( size_t length ) {
+    SimVAddr addr;
+    auto iter = m_freeLists.find( length );
+    if ( iter != m_freeLists.end() && ! iter->second.empty() ) {
+        addr = iter->second.back();
+        iter->second.pop_back();
+    } else {
+        addr = m_currentVaddr;
+        m_currentVaddr += length;
+    }
+    m_used[addr] = length;
+    return addr;
+}
+
+void MemoryHeap::free( SimVAddr addr ) {
+    auto iter = m_used.find( addr );
+    if ( iter == m_used.end() ) {
+        m_output.fatal(CALL_INFO,-1,"free of unallocated addr=%#" PRIx64 "\n", addr );
+    }
+    // freed regions are only reused for allocations of the same length
+    m_freeLists[iter->second].push_back( addr );
+    m_used.erase( iter );
+}
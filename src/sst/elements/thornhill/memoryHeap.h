@@ -18,6 +18,12 @@
 
 #include <sst/core/component.h>
 
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "sst/elements/thornhill/types.h"
+
 namespace SST {
 namespace Thornhill {
 
@@ -50,9 +56,13 @@ class MemoryHeap : public Component {
 
   private:
     void eventHandler( SST::Event* ev, int src );
+    SimVAddr alloc( size_t length );
+    void free( SimVAddr addr );
 
     std::vector<Link*>  		m_links;
 	uint64_t                    m_currentVaddr;
+    std::unordered_map<SimVAddr,size_t>         m_used;
+    std::map<size_t, std::vector<SimVAddr> >    m_freeLists;
 	Output						m_output;
 
 	MemoryHeap() : Component(-1) {}
@@ -18,6 +18,7 @@
 #define _H_THORNHILL_MEMORY_HEAP_EVENT_EVENT
 
 #include <stdint.h>
+#include <vector>
 #include <sst/core/event.h>
 #include <sst/core/params.h>
 
@@ -31,12 +32,16 @@ class MemoryHeapEvent : public SST::Event {
 public:
 	typedef uint64_t Key;
 
-	enum { Alloc, Free } type;
+	enum { Alloc, Free, AllocBatch } type;
 
 	Key 		key;
 	size_t		length;
 	SimVAddr    addr;
 
+	// AllocBatch, one address is returned for each length
+	std::vector<size_t>     lengths;
+	std::vector<SimVAddr>   addrs;
+
 private:
 
     void serialize_order(SST::Core::Serialization::serializer &ser)  override {
@@ -45,6 +50,8 @@ private:
         SST_SER(key);
         SST_SER(length);
         SST_SER(addr);
+        SST_SER(lengths);
+        SST_SER(addrs);
     }
 
     ImplementSerializable(SST::Thornhill::MemoryHeapEvent);
@@ -17,7 +17,11 @@
 #define _H_THORNHILL_MEMORY_HEAP_LINK
 
 
+#include <deque>
 #include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
 #include "sst/core/subcomponent.h"
 #include "sst/core/link.h"
 #include "sst/elements/thornhill/memoryHeapEvent.h"
@@ -37,18 +41,31 @@ class MemoryHeapLink : public SubComponent {
         "",
 		SST::Thornhill::MemoryHeapLink
     )
+    SST_ELI_DOCUMENT_PARAMS(
+        {"arena_size","Bytes to take from the MemoryHeap at a time for serving small allocations locally, 0 sends every allocation to the MemoryHeap","0"},
+        {"arena_max_alloc","Largest allocation, in bytes, served from the local arena","4096"},
+    )
 
 	struct Entry {
 		Entry( std::function<void(uint64_t)> _fini ) : fini( _fini ) {}
+		Entry( std::function<void(std::vector<SimVAddr>&)> _fini ) : batchFini( _fini ) {}
 		std::function<void(uint64_t)> fini;
+		std::function<void(std::vector<SimVAddr>&)> batchFini;
 	};
 
   public:
-    MemoryHeapLink( ComponentId_t id, Params& params ) : SubComponent(id)
+    MemoryHeapLink( ComponentId_t id, Params& params ) : SubComponent(id),
+        m_arenaCur(0), m_arenaEnd(0), m_arenaRefill(false)
 	{
 		m_link = configureLink( "memoryHeap", "0ps",
             new Event::Handler2<MemoryHeapLink,&MemoryHeapLink::eventHandler>( this ) );
         assert(m_link);
+        m_arenaSize = params.find<size_t>("arena_size", 0);
+        m_arenaMaxAlloc = params.find<size_t>("arena_max_alloc", 4096);
+        if ( m_arenaSize && m_arenaMaxAlloc + 15 > m_arenaSize ) {
+            // an allocation plus alignment has to fit in a fresh arena
+            m_arenaMaxAlloc = m_arenaSize > 15 ? m_arenaSize - 15 : 0;
+        }
 	}
 
     bool isConnected() {
@@ -56,17 +73,36 @@ class MemoryHeapLink : public SubComponent {
     }
 
 	void alloc( size_t length, std::function<void(uint64_t)> fini ) {
+
+		if ( m_arenaSize && length <= m_arenaMaxAlloc ) {
+			arenaAlloc( roundUp( length ), fini );
+		} else {
+			sendAlloc( length, fini );
+		}
+	}
+
+	// one round trip for many regions, fini gets the addresses in the order of lengths
+	void alloc( const std::vector<size_t>& lengths, std::function<void(std::vector<SimVAddr>&)> fini ) {
 		Entry* entry = new Entry( fini );
 
 		MemoryHeapEvent* event = new MemoryHeapEvent;
 		event->key = (MemoryHeapEvent::Key) entry;
-		event->type = MemoryHeapEvent::Alloc;
-		event->length = length;
+		event->type = MemoryHeapEvent::AllocBatch;
+		event->lengths = lengths;
 
 		m_link->send(0, event );
 	}
 
 	void free( SimVAddr addr, std::function<void(uint64_t)> fini ) {
+
+		auto iter = m_arenaUsed.find( addr );
+		if ( iter != m_arenaUsed.end() ) {
+			m_arenaFree[iter->second].push_back( addr );
+			m_arenaUsed.erase( iter );
+			fini( addr );
+			return;
+		}
+
 		Entry* entry = new Entry( fini );
 
 		MemoryHeapEvent* event = new MemoryHeapEvent;
@@ -83,11 +119,75 @@ class MemoryHeapLink : public SubComponent {
 	void eventHandler( SST::Event* ev ) {
 		MemoryHeapEvent* event = static_cast<MemoryHeapEvent*>(ev);
 		Entry* entry = (Entry*) event->key;
-		entry->fini(event->addr);
+		if ( MemoryHeapEvent::AllocBatch == event->type ) {
+			entry->batchFini(event->addrs);
+		} else {
+			entry->fini(event->addr);
+		}
 		delete entry;
 		delete ev;
 	}
+
+	void sendAlloc( size_t length, std::function<void(uint64_t)> fini ) {
+		Entry* entry = new Entry( fini );
+
+		MemoryHeapEvent* event = new MemoryHeapEvent;
+		event->key = (MemoryHeapEvent::Key) entry;
+		event->type = MemoryHeapEvent::Alloc;
+		event->length = length;
+
+		m_link->send(0, event );
+	}
+
+	size_t roundUp( size_t length ) {
+		return ( length + 15 ) & ~15;
+	}
+
+	// small allocations are carved from a chunk of the MemoryHeap, freed ones are reused by size
+	void arenaAlloc( size_t length, std::function<void(uint64_t)> fini ) {
+		SimVAddr addr;
+		auto iter = m_arenaFree.find( length );
+		if ( iter != m_arenaFree.end() && ! iter->second.empty() ) {
+			addr = iter->second.back();
+			iter->second.pop_back();
+		} else if ( ! m_arenaRefill && m_arenaCur + length <= m_arenaEnd ) {
+			addr = m_arenaCur;
+			m_arenaCur += length;
+		} else {
+			// wait, in order, for the next chunk
+			m_arenaWait.push_back( std::make_pair( length, fini ) );
+			if ( ! m_arenaRefill ) {
+				m_arenaRefill = true;
+				sendAlloc( m_arenaSize, [=]( uint64_t start ) { arenaRefilled( start ); } );
+			}
+			return;
+		}
+		m_arenaUsed[addr] = length;
+		fini( addr );
+	}
+
+	void arenaRefilled( SimVAddr start ) {
+		m_arenaCur = roundUp( start );
+		m_arenaEnd = start + m_arenaSize;
+		m_arenaRefill = false;
+
+		auto waiters = std::move( m_arenaWait );
+		m_arenaWait.clear();
+		for ( auto& waiter : waiters ) {
+			arenaAlloc( waiter.first, waiter.second );
+		}
+	}
+
     Link*  m_link;
+
+    size_t      m_arenaSize;
+    size_t      m_arenaMaxAlloc;
+    SimVAddr    m_arenaCur;
+    SimVAddr    m_arenaEnd;
+    bool        m_arenaRefill;
+    std::deque< std::pair< size_t, std::function<void(uint64_t)> > > m_arenaWait;
+    std::unordered_map<SimVAddr,size_t>             m_arenaUsed;
+    std::map<size_t, std::vector<SimVAddr> >        m_arenaFree;
 };
 
 
@@ -24,6 +24,8 @@
 #include "lsq/vlsq.h"
 #include "os/vcpuos.h"
 #include "vbranch/vbranchbasic.h"
+#include "vbranch/vbranchperceptron.h"
+#include "vbranch/vbranchtage.h"
 #include "vbranch/vbranchunit.h"
 #include "velf/velfinfo.h"
 #include "vinsloader.h"
@@ -32,6 +34,7 @@
 
 #include <cinttypes>
 #include <cstdint>
+#include <deque>
 #include <sst/core/interfaces/stdMem.h>
 #include <sst/core/subcomponent.h>
 
@@ -51,6 +54,11 @@
           "uops", 1 },                                                                                \
         { "ins_bytes_loaded", "Count the number of bytes loaded for decode operations", "bytes", 1 }, \
         { "uop_delayed_rob_full", "Number of times a micro-op cannot be added to the ROB because it is full.", "cycles", 1 }, \
+        { "frontend_bound_cycles", "Cycles in which decode sent no micro-ops to the ROB although it had space", "cycles", 1 }, \
+        { "icache_stall_cycles", "Frontend bound cycles spent waiting for an instruction cache line", "cycles", 1 }, \
+        { "ftq_prefetches", "Instruction cache lines prefetched for fetch-target queue entries", "lines", 1 }, \
+        { "ftq_late_prefetches", "Instruction cache misses at decode whose line was still being prefetched", "lines", 1 }, \
+        { "ftq_flushes", "Times the fetch-target queue was discarded because decode went elsewhere", "flushes", 1 }, \
     {                                                                                                 \
         "uops_generated",                                                                             \
             "Count number of micro-ops generated by decoder that are transfered to "                  \
@@ -80,7 +88,11 @@ public:
                               "Number of cache lines to store in the local L0 cache for instructions "
                               "pending decoding.", "4" },
                             { "loader_mode",
-                              "Operation of the loader, 0 = LRU (more accurate), 1 = INFINITE cache (faster simulation)", "0"})
+                              "Operation of the loader, 0 = LRU (more accurate), 1 = INFINITE cache (faster simulation)", "0"},
+                            { "ftq_entries",
+                              "Entries in the fetch-target queue the branch unit fills ahead of decode, each a run of "
+                              "instructions up to a predicted-taken branch or the end of a cache line. The lines of each "
+                              "entry are prefetched into the instruction cache. 0 disables run-ahead fetch.", "0"})
 
     SST_ELI_DOCUMENT_STATISTICS(
 				VANADIS_DECODER_ELI_STATISTICS
@@ -95,6 +107,12 @@ public:
 		  fpflags = nullptr;
 
         icache_line_width = params.find<uint64_t>("icache_line_width", 64);
+        ftq_max_entries   = params.find<size_t>("ftq_entries", 0);
+        ftq_ip            = 0;
+
+        // Both ISAs have fixed four byte instructions
+        ftq_ins_width        = 4;
+        ftq_delay_slot_bytes = 0;
 
         const size_t uop_cache_size          = params.find<size_t>("uop_cache_entries", 128);
         const size_t predecode_cache_entries = params.find<size_t>("predecode_cache_entries", 4);
@@ -131,6 +149,11 @@ public:
         stat_decode_fault     = registerStatistic<uint64_t>("decode_faults", "1");
         stat_ins_bytes_loaded = registerStatistic<uint64_t>("ins_bytes_loaded", "1");
         stat_uop_delayed_rob_full = registerStatistic<uint64_t>("uop_delayed_rob_full", "1");
+        stat_frontend_bound       = registerStatistic<uint64_t>("frontend_bound_cycles", "1");
+        stat_icache_stall         = registerStatistic<uint64_t>("icache_stall_cycles", "1");
+        stat_ftq_prefetches       = registerStatistic<uint64_t>("ftq_prefetches", "1");
+        stat_ftq_late_prefetches  = registerStatistic<uint64_t>("ftq_late_prefetches", "1");
+        stat_ftq_flushes          = registerStatistic<uint64_t>("ftq_flushes", "1");
     }
 
     virtual ~VanadisDecoder()
@@ -192,6 +215,8 @@ public:
         ip = newIP;
 
         // Do we need to clear here or not?
+        ftq.clear();
+        ftq_ip = newIP;
     }
 
     virtual void setStackPointer( SST::Output* output, VanadisISATable* isa_tbl, VanadisRegisterFile* regFile, const uint64_t stack_start_address ) {assert(0);}
@@ -207,6 +232,15 @@ public:
 
         output->verbose(CALL_INFO, 16, 0, "[decoder] -> clear decode-q and set new ip: 0x%" PRI_ADDR "\n", newIP);
 
+        // Everything the predictor speculated on has just been flushed
+        branch_predictor->squash();
+
+        if ( !ftq.empty() ) {
+            stat_ftq_flushes->addData(1);
+            ftq.clear();
+        }
+        ftq_ip = newIP;
+
         // Clear out the decode queue, need to restart
         // decoded_q->clear();
 
@@ -237,6 +271,85 @@ public:
 protected:
     virtual void clearDecoderAfterMisspeculate(SST::Output* output) {};
 
+    // Called by the ISA decoders at the end of each tick with the number of
+    // micro-ops sent to the ROB, whether decode stopped for ROB space and
+    // whether it stopped for an instruction line that has not arrived
+    void endFetchCycle(SST::Output* output, const size_t delivered, const bool rob_limited, const bool line_miss)
+    {
+        if ( 0 == delivered && !rob_limited ) {
+            stat_frontend_bound->addData(1);
+            if ( line_miss ) { stat_icache_stall->addData(1); }
+        }
+
+        if ( ftq_max_entries > 0 ) { advanceFetchTargets(output); }
+    }
+
+    // One prediction per cycle into the fetch-target queue and a prefetch of
+    // its lines, decode keeps following its own predictions and the queue
+    // re-synchronises with it
+    void advanceFetchTargets(SST::Output* output)
+    {
+        size_t consumed = 0;
+        while ( consumed < ftq.size() && (ip < ftq[consumed].start || ip >= ftq[consumed].end) ) {
+            consumed++;
+        }
+
+        if ( consumed < ftq.size() ) { ftq.erase(ftq.begin(), ftq.begin() + consumed); }
+        else {
+            // Decode is past every entry, if it is not where the queue was
+            // heading then run-ahead went down the wrong path
+            if ( !ftq.empty() && ip != ftq_ip ) { stat_ftq_flushes->addData(1); }
+            ftq.clear();
+            ftq_ip = ip;
+        }
+
+        if ( ftq.size() < ftq_max_entries ) {
+            const uint64_t line_end = ftq_ip - (ftq_ip % icache_line_width) + icache_line_width;
+            FetchTarget    target   = { ftq_ip, line_end };
+            uint64_t       next_ip  = line_end;
+
+            for ( uint64_t addr = ftq_ip; addr < line_end; addr += ftq_ins_width ) {
+                uint64_t taken_addr = 0;
+                if ( branch_predictor->peekTarget(addr, &taken_addr) ) {
+                    target.end = addr + ftq_ins_width + ftq_delay_slot_bytes;
+                    next_ip    = taken_addr;
+                    break;
+                }
+            }
+
+            if ( output->getVerboseLevel() >= 16 ) {
+                output->verbose(
+                    CALL_INFO, 16, 0, "[decoder] ftq <- 0x%" PRI_ADDR " - 0x%" PRI_ADDR ", next 0x%" PRI_ADDR "\n",
+                    target.start, target.end, next_ip);
+            }
+
+            ftq.push_back(target);
+            ftq_ip = next_ip;
+
+            // Already decoded code does not need its bytes again
+            if ( !ins_loader->hasBundleAt(target.start) ) {
+                for ( uint64_t line = target.start - (target.start % icache_line_width); line < target.end;
+                      line += icache_line_width ) {
+                    if ( ins_loader->prefetchLineAt(output, line) ) { stat_ftq_prefetches->addData(1); }
+                }
+            }
+        }
+
+        const uint64_t late = ins_loader->takeLatePrefetches();
+        if ( late > 0 ) { stat_ftq_late_prefetches->addData(late); }
+    }
+
+    struct FetchTarget {
+        uint64_t start;
+        uint64_t end;
+    };
+
+    std::deque<FetchTarget> ftq;
+    size_t                  ftq_max_entries;
+    uint64_t                ftq_ip;
+    uint64_t                ftq_ins_width;
+    uint64_t                ftq_delay_slot_bytes;
+
     uint64_t ip;
     uint64_t icache_line_width;
     uint32_t hw_thr;
@@ -265,6 +378,11 @@ protected:
     Statistic<uint64_t>* stat_decode_fault;
     Statistic<uint64_t>* stat_uop_generated;
     Statistic<uint64_t>* stat_ins_bytes_loaded;
+    Statistic<uint64_t>* stat_frontend_bound;
+    Statistic<uint64_t>* stat_icache_stall;
+    Statistic<uint64_t>* stat_ftq_prefetches;
+    Statistic<uint64_t>* stat_ftq_late_prefetches;
+    Statistic<uint64_t>* stat_ftq_flushes;
 };
 
 
@@ -29,11 +29,13 @@ class VanadisDecoderOptions
 public:
     VanadisDecoderOptions(
         const uint16_t reg_ignore, const uint16_t isa_int_reg_c, const uint16_t isa_fp_reg_c,
-        const uint16_t isa_sysc_reg, const VanadisFPRegisterMode fp_reg_m) :
+        const uint16_t isa_sysc_reg, const VanadisFPRegisterMode fp_reg_m,
+        const uint16_t isa_link_r = UINT16_MAX) :
         reg_ignore_writes(reg_ignore),
         isa_int_reg_count(isa_int_reg_c),
         isa_fp_reg_count(isa_fp_reg_c),
         isa_syscall_code_reg(isa_sysc_reg),
+        isa_link_reg(isa_link_r),
         fp_reg_mode(fp_reg_m)
     {}
 
@@ -42,6 +44,7 @@ public:
         isa_int_reg_count(0),
         isa_fp_reg_count(0),
         isa_syscall_code_reg(0),
+        isa_link_reg(UINT16_MAX),
         fp_reg_mode(VANADIS_REGISTER_MODE_FP32)
     {}
 
@@ -49,6 +52,7 @@ public:
     uint16_t              countISAIntRegisters() const { return isa_int_reg_count; }
     uint16_t              countISAFPRegisters() const { return isa_fp_reg_count; }
     uint16_t              getISASysCallCodeReg() const { return isa_syscall_code_reg; }
+    uint16_t              getISALinkReg() const { return isa_link_reg; }
     VanadisFPRegisterMode getFPRegisterMode() const { return fp_reg_mode; }
 
 protected:
@@ -56,6 +60,7 @@ protected:
     const uint16_t              isa_int_reg_count; // Int registers specified by the ISA
     const uint16_t              isa_fp_reg_count;  // FP registers specified by the ISA
     const uint16_t              isa_syscall_code_reg;
+    const uint16_t              isa_link_reg; // Return address register, UINT16_MAX if the ISA has none
     const VanadisFPRegisterMode fp_reg_mode;
 };
 
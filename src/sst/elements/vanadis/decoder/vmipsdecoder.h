@@ -276,9 +276,12 @@ public:
         // 32 fp + ver + status (2) = 34
         // reg-2 is for sys-call codes
         // plus 2 for LO/HI registers in INT
-        options               = new VanadisDecoderOptions((uint16_t)0, 34, 34, 2, VANADIS_REGISTER_MODE_FP32);
+        options               = new VanadisDecoderOptions((uint16_t)0, 34, 34, 2, VANADIS_REGISTER_MODE_FP32, 31);
         max_decodes_per_cycle = params.find<uint16_t>("decode_max_ins_per_cycle", 2);
 
+        // A fetch target ending in a branch carries its delay slot
+        ftq_delay_slot_bytes = 4;
+
         // See if we get an entry point the sub-component says we have to use
         // if not, we will fall back to ELF reading at the core level to work this
         // out
@@ -442,6 +445,10 @@ public:
         uint16_t decodes_performed = 0;
         uint16_t uop_bundles_used  = 0;
 
+        const size_t rob_before  = thread_rob->size();
+        bool         rob_limited = false;
+        bool         line_miss   = false;
+
         for ( uint16_t i = 0; i < max_decodes_per_cycle; ++i ) {
             // if the ROB has space, then lets go ahead and
             // decode the input, put it in the queue for issue.
@@ -519,6 +526,7 @@ public:
                                 ins_loader->requestLoadAt(output, ip + 4, 4);
                                 stat_ins_bytes_loaded->addData(4);
                                 stat_predecode_miss->addData(1);
+                                line_miss = true;
                             }
                         }
 
@@ -547,56 +555,18 @@ public:
                                         VanadisSpeculatedInstruction* speculated_ins =
                                             dynamic_cast<VanadisSpeculatedInstruction*>(next_ins);
 
-                                        // Do we have an entry for the branch instruction we just
-                                        // issued
-                                        if ( branch_predictor->contains(ip) ) {
-                                            const uint64_t predicted_address = branch_predictor->predictAddress(ip);
-                                            speculated_ins->setSpeculatedAddress(predicted_address);
-
-                                            // This is essential a predicted not taken branch
-                                            if ( predicted_address == (ip + 8) ) {
-                                                output->verbose(
-                                                    CALL_INFO, 16, VANADIS_DBG_DECODER_FLG,
-                                                    "---> Branch 0x%" PRI_ADDR " predicted not "
-                                                    "taken, ip set to: 0x%0" PRI_ADDR "\n",
-                                                    ip, predicted_address);
-                                                //												speculated_ins->setSpeculatedDirection(
-                                                // BRANCH_NOT_TAKEN );
-                                            }
-                                            else {
-                                                output->verbose(
-                                                    CALL_INFO, 16, VANADIS_DBG_DECODER_FLG,
-                                                    "---> Branch 0x%" PRI_ADDR " predicted taken, "
-                                                    "jump to 0x%0" PRI_ADDR "\n",
-                                                    ip, predicted_address);
-                                                //												speculated_ins->setSpeculatedDirection(
-                                                // BRANCH_TAKEN );
-                                            }
-
-                                            ip = predicted_address;
-                                            output->verbose(
-                                                CALL_INFO, 16, VANADIS_DBG_DECODER_FLG,
-                                                "---> Forcing IP update according to branch "
-                                                "prediction table, new-ip: %0" PRI_ADDR "\n",
-                                                ip);
-                                        }
-                                        else {
-                                            output->verbose(
-                                                CALL_INFO, 16, VANADIS_DBG_DECODER_FLG,
-                                                "---> Branch table does not contain an "
-                                                "entry for ins: 0x%0" PRI_ADDR ", continue with "
-                                                "normal ip += 8 = 0x%0" PRI_ADDR "\n",
-                                                ip, (ip + 8));
-
-                                            //											speculated_ins->setSpeculatedDirection(
-                                            // BRANCH_NOT_TAKEN );
-                                            speculated_ins->setSpeculatedAddress(ip + 8);
-
-                                            // We don't urgh.. let's just carry on
-                                            // remember we increment the IP by 2 instructions (me +
-                                            // delay)
-                                            ip += 8;
-                                        }
+                                        // Fall through is past the delay slot
+                                        const uint64_t predicted_address = branch_predictor->predict(
+                                            ip, ip + 8, speculated_ins->getBranchType());
+                                        speculated_ins->setSpeculatedAddress(predicted_address);
+
+                                        output->verbose(
+                                            CALL_INFO, 16, VANADIS_DBG_DECODER_FLG,
+                                            "---> Branch 0x%" PRI_ADDR " predicted %s, ip set to: 0x%0" PRI_ADDR "\n",
+                                            ip, predicted_address == (ip + 8) ? "not taken" : "taken",
+                                            predicted_address);
+
+                                        ip = predicted_address;
                                     }
                                 }
 
@@ -617,6 +587,7 @@ public:
                                     "---> --> micro-op for branch and delay exceed "
                                     "decode-q space. Cannot issue this cycle.\n");
                                 stat_uop_delayed_rob_full->addData(1);
+                                rob_limited = true;
                                 break;
                             }
                         }
@@ -655,6 +626,7 @@ public:
                             // We don't have enough space, so we have to stop and wait for
                             // more entries to free up.
                             stat_uop_delayed_rob_full->addData(1);
+                            rob_limited = true;
                             break;
                         }
                     }
@@ -707,6 +679,7 @@ public:
                     ins_loader->requestLoadAt(output, ip, 4);
                     stat_ins_bytes_loaded->addData(4);
                     stat_predecode_miss->addData(1);
+                    line_miss = true;
                     break;
                 }
             }
@@ -715,10 +688,13 @@ public:
                     CALL_INFO, 16, VANADIS_DBG_DECODER_FLG,
                     "---> Decoded pending issue queue is full, no more "
                     "decodes permitted.\n");
+                rob_limited = true;
                 break;
             }
         }
 
+        endFetchCycle(output, thread_rob->size() - rob_before, rob_limited, line_miss);
+
         output->verbose(
             CALL_INFO, 16, VANADIS_DBG_DECODER_FLG,
             "---> Performed %" PRIu16 " decodes this cycle, %" PRIu16 " uop-bundles used / updated-ip: 0x%" PRI_ADDR ".\n",
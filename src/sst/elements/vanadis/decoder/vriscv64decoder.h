@@ -56,12 +56,32 @@ public:
       {"halt_on_decode_fault",
 		"Fatal error if a decode fault occurs, used for debugging and not recommmended default is 0 (false)", "0"},
       { "entry_point", "Starting instruction pointer; if not specified (set to 0), "
-                      "falls back to the core's ELF reader to discover", "0"})
+                      "falls back to the core's ELF reader to discover", "0"},
+      { "vector_length", "VLEN of the vector extension in bits, a multiple of 64 up to 1024. 0 disables vector "
+                         "instructions. Each vector register element is renamed as a floating point register, "
+                         "so physical_fp_registers must cover the extra (32 * VLEN / 64) + 1 ISA registers", "0"})
 
     VanadisRISCV64Decoder(ComponentId_t id, Params& params) : VanadisDecoder(id, params)
     {
+        const uint16_t vector_length = params.find<uint16_t>("vector_length", 0);
+
+        if ( (vector_length % 64) != 0 || vector_length > 1024 ) {
+            getSimulationOutput().fatal(
+                CALL_INFO, -1, "Error: vector_length (%" PRIu16 ") must be a multiple of 64 no larger than 1024\n",
+                vector_length);
+        }
+
+        // Only 64-bit elements with LMUL=1 are decoded, so each vector
+        // register holds VLEN / 64 elements
+        vector_elements = vector_length / 64;
+
         // we need TWO additional registers for AMO microcode operations, RISC-V has 32 + 2 int for our micro-code.
-        options = new VanadisDecoderOptions(static_cast<uint16_t>(0), 35, 32, 2, VANADIS_REGISTER_MODE_FP64);
+        // With vectors enabled the vector length is held in one more, and the elements of every vector register
+        // follow the 32 FP registers, then one FP temporary used for reductions
+        options = new VanadisDecoderOptions(
+            static_cast<uint16_t>(0), (vector_elements > 0) ? 36 : 35,
+            (vector_elements > 0) ? 32 + (32 * vector_elements) + 1 : 32, 2,
+            VANADIS_REGISTER_MODE_FP64, 1);
         max_decodes_per_cycle = params.find<uint16_t>("decode_max_ins_per_cycle", 2);
 
         // See if we get an entry point the sub-component says we have to use
@@ -137,9 +157,31 @@ public:
 
         cycle_count = cycle;
 
+        // straight-line run of cached bundles being followed this cycle, so
+        // only the first bundle of the run needs a cache lookup
+        VanadisInstructionBlock* block       = nullptr;
+        uint32_t                 block_index = 0;
+
+        const size_t rob_before  = thread_rob->size();
+        bool         rob_limited = false;
+        bool         line_miss   = false;
+
         for ( uint16_t i = 0; i < max_decodes_per_cycle; ++i ) {
             if ( ! thread_rob->full() ) {
-                if ( ins_loader->hasBundleAt(ip) ) {
+                VanadisInstructionBundle* bundle = nullptr;
+
+                if ( nullptr == block || block_index >= block->getBundleCount() ||
+                     block->getBundleByIndex(block_index)->getInstructionAddress() != ip ) {
+                    block       = ins_loader->getBlockAt(ip);
+                    block_index = 0;
+                }
+
+                if ( nullptr != block ) { bundle = block->getBundleByIndex(block_index); }
+                else if ( ins_loader->hasBundleAt(ip) ) {
+                    bundle = ins_loader->getBundleAt(ip);
+                }
+
+                if ( nullptr != bundle ) {
                     // We have the instruction in our micro-op cache
                     if(output->getVerboseLevel() >= 16) {
                         output->verbose(
@@ -147,8 +189,6 @@ public:
                     }
                     stat_uop_hit->addData(1);
 
-                    VanadisInstructionBundle* bundle = ins_loader->getBundleAt(ip);
-
                     if(output->getVerboseLevel() >= 16) {
                         output->verbose(
                             CALL_INFO, 16, 0, "----> Bundle contains %" PRIu32 " entries.\n",
@@ -167,39 +207,23 @@ public:
                                 VanadisSpeculatedInstruction* next_spec_ins =
                                     dynamic_cast<VanadisSpeculatedInstruction*>(next_ins);
 
-                                if ( branch_predictor->contains(ip) ) {
-                                    // We have an address predicton from the branching unit
-                                    const uint64_t predicted_address = branch_predictor->predictAddress(ip);
-                                    next_spec_ins->setSpeculatedAddress(predicted_address);
-
-                                    if(output->getVerboseLevel() >= 16) {
-                                        output->verbose(
-                                            CALL_INFO, 16, 0,
-                                            "----> contains a branch: 0x%" PRI_ADDR " / predicted "
-                                            "(found in predictor): 0x%" PRI_ADDR "\n",
-                                            ip, predicted_address);
-                                    }
-
-                                    ip                = predicted_address;
-                                    bundle_has_branch = true;
-                                }
-                                else {
-                                    // We don't have an address prediction
-                                    // so just speculate that we are going to drop through to the
-                                    // next instruction as we aren't sure where this will go yet
-
-                                    if(output->getVerboseLevel() >= 16) {
-                                        output->verbose(
-                                            CALL_INFO, 16, 0,
-                                            "----> contains a branch: 0x%" PRI_ADDR " / predicted "
-                                            "(not-found in predictor): 0x%" PRI_ADDR ", pc-increment: %" PRIu64 "\n",
-                                            ip, ip + 4, bundle->pcIncrement());
-                                    }
-
-                                    ip += bundle->pcIncrement();
-                                    next_spec_ins->setSpeculatedAddress(ip);
-                                    bundle_has_branch = true;
+                                const uint64_t fallthrough_address = ip + bundle->pcIncrement();
+                                const uint64_t predicted_address   = branch_predictor->predict(
+                                    ip, fallthrough_address, next_spec_ins->getBranchType());
+                                next_spec_ins->setSpeculatedAddress(predicted_address);
+
+                                if(output->getVerboseLevel() >= 16) {
+                                    output->verbose(
+                                        CALL_INFO, 16, 0,
+                                        "----> contains a branch: 0x%" PRI_ADDR " / predicted: 0x%" PRI_ADDR
+                                        " (%s), pc-increment: %" PRIu64 "\n",
+                                        ip, predicted_address,
+                                        predicted_address == fallthrough_address ? "not-taken" : "taken",
+                                        bundle->pcIncrement());
                                 }
+
+                                ip                = predicted_address;
+                                bundle_has_branch = true;
                             }
 
                             thread_rob->push(next_ins->clone());
@@ -215,11 +239,13 @@ public:
                         }
 
                         ip = bundle_has_branch ? ip : ip + bundle->pcIncrement();
+                        block_index++;
                     }
                     else {
                         output->verbose(
                             CALL_INFO, 16, 0, "----> Not enough space in the ROB, will stall this cycle.\n");
                         stat_uop_delayed_rob_full->addData(1);
+                        rob_limited = true;
                     }
                 }
                 else if ( ins_loader->hasPredecodeAt(ip, 4) ) {
@@ -282,6 +308,7 @@ public:
                     ins_loader->requestLoadAt(output, ip, 4);
                     stat_ins_bytes_loaded->addData(4);
                     stat_predecode_miss->addData(1);
+                    line_miss = true;
                     break;
                 }
             }
@@ -290,10 +317,13 @@ public:
                     CALL_INFO, 16, 0,
                     "---> Decode pending queue (ROB) is full, no more "
                     "decoded permitted this cycle.\n");
+                rob_limited = true;
                 break;
             }
         }
 
+        endFetchCycle(output, thread_rob->size() - rob_before, rob_limited, line_miss);
+
         if(output->getVerboseLevel() >= 16) {
             output->verbose(CALL_INFO, 16, 0, "---> cycle is completed, ip=0x%" PRI_ADDR "\n", ip);
         }
@@ -302,6 +332,7 @@ public:
 protected:
     const VanadisDecoderOptions* options;
     bool                         fatal_decode_fault;
+    uint16_t                     vector_elements;
     uint16_t                     icache_max_bytes_per_cycle;
     uint16_t                     max_decodes_per_cycle;
     uint16_t                     decode_buffer_max_entries;
@@ -454,6 +485,11 @@ protected:
                         LOAD_FP_REGISTER));
                     decode_fault = false;
                 } break;
+                case 0x7:
+                {
+                    // Vector load of 64-bit elements
+                    decode_fault = !decodeVectorMemory(output, ins_address, ins, true, bundle);
+                } break;
                 }
             } break;
             case 0xb:
@@ -551,9 +587,17 @@ protected:
                 {
                     // SLTI
                     processI<int64_t>(ins, op_code, rd, rs1, func_code3, simm64);
-                    bundle->addInstruction(new VanadisSetRegCompareImmInstruction<
-                                           REG_COMPARE_LT, int64_t>(
-                        ins_address, hw_thr, options, rd, rs1, simm64));
+
+                    // SLTI with rd = x0 is a HINT set aside for custom use,
+                    // slti x0, x0, 1 marks the region of interest
+                    if ( 0 == rd && 0 == rs1 && 1 == simm64 ) {
+                        bundle->addInstruction(new VanadisROIMarkerInstruction(ins_address, hw_thr, options));
+                    }
+                    else {
+                        bundle->addInstruction(new VanadisSetRegCompareImmInstruction<
+                                               REG_COMPARE_LT, int64_t>(
+                            ins_address, hw_thr, options, rd, rs1, simm64));
+                    }
                     decode_fault = false;
                 } break;
                 case 3:
@@ -1596,8 +1640,23 @@ protected:
                         ins_address, hw_thr, options, rs1, simm64, rs2, 8, MEM_TRANSACTION_NONE, STORE_FP_REGISTER));
                         decode_fault = false;
 						} break;
+					case 0x7:
+						{
+							// Vector store of 64-bit elements
+							decode_fault = !decodeVectorMemory(output, ins_address, ins, false, bundle);
+						} break;
 					}
             } break;
+            case 0x57:
+            {
+                // Vector arithmetic and configuration
+                if ( 0x7 == extract_func3(ins) ) {
+                    decode_fault = !decodeVectorConfig(output, ins_address, ins, bundle);
+                }
+                else {
+                    decode_fault = !decodeVectorArith(output, ins_address, ins, bundle);
+                }
+            } break;
             case 0x53:
             {
                 // floating point arithmetic
@@ -3095,6 +3154,334 @@ protected:
     }
 
 
+    // Vector instructions are cracked into one micro-op per element.  The
+    // vector length lives in ISA integer register 35 and element e of vector
+    // register v in ISA FP register 32 + (v * vector_elements) + e.
+    uint16_t vectorLengthReg() const { return 35; }
+
+    uint16_t vectorElementReg(const uint16_t vreg, const uint16_t element) const
+    {
+        return 32 + (vreg * vector_elements) + element;
+    }
+
+    // vtype for SEW=64, LMUL=1, the only configuration cracked
+    static const uint64_t vector_type_e64_m1 = 0x18;
+
+    bool decodeVectorConfig(
+        SST::Output* output, const uint64_t ins_address, const uint32_t ins, VanadisInstructionBundle* bundle)
+    {
+        if ( 0 == vector_elements ) { return false; }
+
+        const uint16_t rd  = extract_rd(ins);
+        const uint16_t rs1 = extract_rs1(ins);
+        const uint16_t rs2 = extract_rs2(ins);
+
+        VanadisVectorLengthSource source = VECTOR_AVL_REGISTER;
+        if ( 0 == rs1 ) { source = (0 == rd) ? VECTOR_AVL_KEEP : VECTOR_AVL_MAX; }
+
+        if ( 0 == (ins & 0x80000000) ) {
+            // vsetvli
+            const uint64_t vtype = (ins >> 20) & 0x7FF;
+            output->verbose(
+                CALL_INFO, 16, 0, "----> VSETVLI %" PRIu16 " <- %" PRIu16 " vtype: 0x%" PRIx64 "\n", rd, rs1, vtype);
+
+            if ( (vtype & ~0xC0ULL) != vector_type_e64_m1 ) { return false; }
+
+            bundle->addInstruction(new VanadisSetVectorLengthInstruction(
+                ins_address, hw_thr, options, rd, vectorLengthReg(), source, rs1, 0, vector_elements));
+            return true;
+        }
+        else if ( 0xC0000000 == (ins & 0xC0000000) ) {
+            // vsetivli, the AVL is the rs1 field
+            const uint64_t vtype = (ins >> 20) & 0x3FF;
+            output->verbose(
+                CALL_INFO, 16, 0, "----> VSETIVLI %" PRIu16 " <- %" PRIu16 " vtype: 0x%" PRIx64 "\n", rd, rs1, vtype);
+
+            if ( (vtype & ~0xC0ULL) != vector_type_e64_m1 ) { return false; }
+
+            bundle->addInstruction(new VanadisSetVectorLengthInstruction(
+                ins_address, hw_thr, options, rd, vectorLengthReg(), VECTOR_AVL_IMMEDIATE, 0, rs1, vector_elements));
+            return true;
+        }
+        else if ( 0x80000000 == (ins & 0xFE000000) ) {
+            // vsetvl, vtype comes from rs2 and is checked when it executes
+            output->verbose(CALL_INFO, 16, 0, "----> VSETVL %" PRIu16 " <- %" PRIu16 " vtype: %" PRIu16 "\n", rd, rs1, rs2);
+
+            bundle->addInstruction(new VanadisSetVectorLengthInstruction(
+                ins_address, hw_thr, options, rd, vectorLengthReg(), source, rs1, 0, vector_elements, rs2,
+                vector_type_e64_m1));
+            return true;
+        }
+
+        return false;
+    }
+
+    bool decodeVectorMemory(
+        SST::Output* output, const uint64_t ins_address, const uint32_t ins, const bool is_load,
+        VanadisInstructionBundle* bundle)
+    {
+        if ( 0 == vector_elements ) { return false; }
+
+        const uint16_t vreg   = extract_rd(ins);
+        const uint16_t base   = extract_rs1(ins);
+        const uint16_t rs2    = extract_rs2(ins);
+        const uint32_t nf     = (ins >> 29) & 0x7;
+        const uint32_t mew    = (ins >> 28) & 0x1;
+        const uint32_t mop    = (ins >> 26) & 0x3;
+        const uint32_t vm     = (ins >> 25) & 0x1;
+
+        // no segments, masks or widths past 64 bits
+        if ( 0 != nf || 0 != mew || 0 == vm ) { return false; }
+
+        VanadisVectorAddressMode mode;
+        switch ( mop ) {
+        case 0x0:
+            // only the plain unit-stride form, no whole register, mask or
+            // fault-only-first loads
+            if ( 0 != rs2 ) { return false; }
+            mode = VECTOR_ADDRESS_UNIT_STRIDE;
+            break;
+        case 0x2:
+            mode = VECTOR_ADDRESS_STRIDED;
+            break;
+        default:
+            // ordered and unordered indexed accesses are the same here, the
+            // elements already go to memory in order
+            mode = VECTOR_ADDRESS_INDEXED;
+            break;
+        }
+
+        output->verbose(
+            CALL_INFO, 16, 0, "----> VECTOR-%s v%" PRIu16 " base: %" PRIu16 " mop: %" PRIu32 " rs2/vs2: %" PRIu16 "\n",
+            is_load ? "LOAD" : "STORE", vreg, base, mop, rs2);
+
+        for ( uint16_t e = 0; e < vector_elements; ++e ) {
+            const uint16_t stride_or_index = (mode == VECTOR_ADDRESS_INDEXED) ? vectorElementReg(rs2, e) : rs2;
+
+            if ( is_load ) {
+                bundle->addInstruction(new VanadisVectorLoadInstruction(
+                    ins_address, hw_thr, options, mode, e, vectorLengthReg(), base, stride_or_index,
+                    vectorElementReg(vreg, e), 8));
+            }
+            else {
+                bundle->addInstruction(new VanadisVectorStoreInstruction(
+                    ins_address, hw_thr, options, mode, e, vectorLengthReg(), base, stride_or_index,
+                    vectorElementReg(vreg, e), 8));
+            }
+        }
+
+        return true;
+    }
+
+    void addVectorElementOps(
+        const uint64_t ins_address, const VanadisVectorOp op, const VanadisVectorOperand src_kind, const uint16_t vd,
+        const uint16_t vs2, const uint16_t src, const int64_t imm, VanadisInstructionBundle* bundle)
+    {
+        for ( uint16_t e = 0; e < vector_elements; ++e ) {
+            bundle->addInstruction(new VanadisVectorArithInstruction(
+                ins_address, hw_thr, options, op, src_kind, e, vectorLengthReg(), vectorElementReg(vd, e),
+                vectorElementReg(vs2, e), (src_kind == VECTOR_OPERAND_VECTOR) ? vectorElementReg(src, e) : src, imm));
+        }
+    }
+
+    // vd[0] = vs1[0] + vs2[0] + ... + vs2[vl - 1], summed in order in a
+    // temporary so vd may overlap the sources, nothing is written when vl is 0
+    void addVectorReduction(
+        const uint64_t ins_address, const VanadisVectorOp op, const uint16_t vd, const uint16_t vs2, const uint16_t vs1,
+        VanadisInstructionBundle* bundle)
+    {
+        const uint16_t        acc  = 32 + (32 * vector_elements);
+        const VanadisVectorOp move = (op == VECTOR_OP_FADD) ? VECTOR_OP_FMOVE : VECTOR_OP_MOVE;
+
+        bundle->addInstruction(new VanadisVectorArithInstruction(
+            ins_address, hw_thr, options, move, VECTOR_OPERAND_VECTOR, 0, vectorLengthReg(), acc, 0,
+            vectorElementReg(vs1, 0)));
+
+        for ( uint16_t e = 0; e < vector_elements; ++e ) {
+            bundle->addInstruction(new VanadisVectorArithInstruction(
+                ins_address, hw_thr, options, op, VECTOR_OPERAND_VECTOR, e, vectorLengthReg(), acc,
+                vectorElementReg(vs2, e), acc));
+        }
+
+        bundle->addInstruction(new VanadisVectorArithInstruction(
+            ins_address, hw_thr, options, move, VECTOR_OPERAND_VECTOR, 0, vectorLengthReg(), vectorElementReg(vd, 0), 0,
+            acc));
+    }
+
+    bool decodeVectorArith(
+        SST::Output* output, const uint64_t ins_address, const uint32_t ins, VanadisInstructionBundle* bundle)
+    {
+        if ( 0 == vector_elements ) { return false; }
+
+        const uint16_t vd     = extract_rd(ins);
+        const uint16_t vs1    = extract_rs1(ins);
+        const uint16_t vs2    = extract_rs2(ins);
+        const uint32_t funct3 = extract_func3(ins);
+        const uint32_t funct6 = (ins >> 26) & 0x3F;
+        const uint32_t vm     = (ins >> 25) & 0x1;
+
+        // five bit signed immediate of the OPIVI forms
+        const int64_t simm5 = (vs1 & 0x10) ? static_cast<int64_t>(vs1) - 32 : static_cast<int64_t>(vs1);
+
+        output->verbose(
+            CALL_INFO, 16, 0, "----> VECTOR-ARITH funct3: %" PRIu32 " funct6: 0x%" PRIx32 " vd: %" PRIu16
+            " vs1/rs1: %" PRIu16 " vs2: %" PRIu16 " vm: %" PRIu32 "\n", funct3, funct6, vd, vs1, vs2, vm);
+
+        // masked operations are not supported
+        if ( 0 == vm ) { return false; }
+
+        VanadisVectorOperand src_kind;
+        switch ( funct3 ) {
+        case 0x0:
+        case 0x1:
+        case 0x2:
+            src_kind = VECTOR_OPERAND_VECTOR;
+            break;
+        case 0x3:
+            src_kind = VECTOR_OPERAND_IMM;
+            break;
+        case 0x4:
+        case 0x6:
+            src_kind = VECTOR_OPERAND_INT;
+            break;
+        default:
+            src_kind = VECTOR_OPERAND_FP;
+            break;
+        }
+
+        switch ( funct3 ) {
+        case 0x0: // OPIVV
+        case 0x3: // OPIVI
+        case 0x4: // OPIVX
+        {
+            VanadisVectorOp op;
+            switch ( funct6 ) {
+            case 0x00:
+                op = VECTOR_OP_ADD;
+                break;
+            case 0x02:
+                if ( 0x3 == funct3 ) { return false; }
+                op = VECTOR_OP_SUB;
+                break;
+            case 0x03:
+                if ( 0x0 == funct3 ) { return false; }
+                op = VECTOR_OP_RSUB;
+                break;
+            case 0x09:
+                op = VECTOR_OP_AND;
+                break;
+            case 0x0A:
+                op = VECTOR_OP_OR;
+                break;
+            case 0x0B:
+                op = VECTOR_OP_XOR;
+                break;
+            case 0x17:
+                // vmv.v.v / vmv.v.x / vmv.v.i
+                if ( 0 != vs2 ) { return false; }
+                op = VECTOR_OP_MOVE;
+                break;
+            default:
+                return false;
+            }
+
+            addVectorElementOps(ins_address, op, src_kind, vd, vs2, vs1, simm5, bundle);
+            return true;
+        }
+        case 0x2: // OPMVV
+        case 0x6: // OPMVX
+        {
+            switch ( funct6 ) {
+            case 0x00:
+                // vredsum.vs
+                if ( 0x6 == funct3 ) { return false; }
+                addVectorReduction(ins_address, VECTOR_OP_ADD, vd, vs2, vs1, bundle);
+                return true;
+            case 0x10:
+                if ( 0x2 == funct3 ) {
+                    // vmv.x.s
+                    if ( 0 != vs1 ) { return false; }
+                    bundle->addInstruction(new VanadisFP2GPRInstruction<uint64_t, uint64_t, true>(
+                        ins_address, hw_thr, options, fpflags, vd, vectorElementReg(vs2, 0)));
+                }
+                else {
+                    // vmv.s.x
+                    if ( 0 != vs2 ) { return false; }
+                    bundle->addInstruction(new VanadisVectorArithInstruction(
+                        ins_address, hw_thr, options, VECTOR_OP_MOVE, VECTOR_OPERAND_INT, 0, vectorLengthReg(),
+                        vectorElementReg(vd, 0), 0, vs1));
+                }
+                return true;
+            case 0x25:
+                addVectorElementOps(ins_address, VECTOR_OP_MUL, src_kind, vd, vs2, vs1, 0, bundle);
+                return true;
+            case 0x2D:
+                addVectorElementOps(ins_address, VECTOR_OP_MACC, src_kind, vd, vs2, vs1, 0, bundle);
+                return true;
+            default:
+                return false;
+            }
+        }
+        case 0x1: // OPFVV
+        case 0x5: // OPFVF
+        {
+            VanadisVectorOp op;
+            switch ( funct6 ) {
+            case 0x00:
+                op = VECTOR_OP_FADD;
+                break;
+            case 0x01:
+            case 0x03:
+                // vfredusum.vs / vfredosum.vs, both summed in order
+                if ( 0x5 == funct3 ) { return false; }
+                addVectorReduction(ins_address, VECTOR_OP_FADD, vd, vs2, vs1, bundle);
+                return true;
+            case 0x02:
+                op = VECTOR_OP_FSUB;
+                break;
+            case 0x10:
+                if ( 0x1 == funct3 ) {
+                    // vfmv.f.s
+                    if ( 0 != vs1 ) { return false; }
+                    bundle->addInstruction(
+                        new VanadisFPSignLogicInstruction<double, VanadisFPSignLogicOperation::SIGN_COPY>(
+                            ins_address, hw_thr, options, fpflags, vd, vectorElementReg(vs2, 0),
+                            vectorElementReg(vs2, 0)));
+                }
+                else {
+                    // vfmv.s.f
+                    if ( 0 != vs2 ) { return false; }
+                    bundle->addInstruction(new VanadisVectorArithInstruction(
+                        ins_address, hw_thr, options, VECTOR_OP_FMOVE, VECTOR_OPERAND_FP, 0, vectorLengthReg(),
+                        vectorElementReg(vd, 0), 0, vs1));
+                }
+                return true;
+            case 0x17:
+                // vfmv.v.f
+                if ( 0x1 == funct3 || 0 != vs2 ) { return false; }
+                op = VECTOR_OP_FMOVE;
+                break;
+            case 0x20:
+                op = VECTOR_OP_FDIV;
+                break;
+            case 0x24:
+                op = VECTOR_OP_FMUL;
+                break;
+            case 0x2C:
+                op = VECTOR_OP_FMACC;
+                break;
+            default:
+                return false;
+            }
+
+            addVectorElementOps(ins_address, op, src_kind, vd, vs2, vs1, 0, bundle);
+            return true;
+        }
+        }
+
+        return false;
+    }
+
     uint16_t expand_rvc_int_register(const uint16_t reg_in) const { return reg_in + 8; }
 
     uint16_t extract_rs2_rvc(const uint32_t ins) const { return static_cast<uint16_t>((ins & 0x1C) >> 2); }
@@ -0,0 +1,36 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_TYPE
+#define _H_VANADIS_BRANCH_TYPE
+
+namespace SST {
+namespace Vanadis {
+
+// How a branch predictor should treat a speculated instruction, calls and
+// returns are told apart using the ISA link register
+enum VanadisBranchType {
+    VANADIS_BRANCH_CONDITIONAL,
+    VANADIS_BRANCH_DIRECT_JUMP,
+    VANADIS_BRANCH_DIRECT_CALL,
+    VANADIS_BRANCH_INDIRECT_JUMP,
+    VANADIS_BRANCH_INDIRECT_CALL,
+    VANADIS_BRANCH_RETURN
+};
+
+}
+} // namespace SST
+
+#endif
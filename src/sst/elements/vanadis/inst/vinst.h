@@ -51,29 +51,7 @@ class VanadisInstruction
             count_isa_fp_reg_in(c_isa_fp_reg_in),
             count_isa_fp_reg_out(c_isa_fp_reg_out)
         {
-            phys_int_regs_in = (count_phys_int_reg_in > 0) ? new uint16_t[count_phys_int_reg_in] : nullptr;
-            std::memset(phys_int_regs_in, 0, count_phys_int_reg_in * sizeof( uint16_t ));
-
-            phys_int_regs_out = (count_phys_int_reg_out > 0) ? new uint16_t[count_phys_int_reg_out] : nullptr;
-            std::memset(phys_int_regs_out, 0, count_phys_int_reg_out * sizeof( uint16_t ) );
-
-            isa_int_regs_in = (count_isa_int_reg_in > 0) ? new uint16_t[count_isa_int_reg_in] : nullptr;
-            std::memset(isa_int_regs_in, 0, count_isa_int_reg_in * sizeof( uint16_t ));
-
-            isa_int_regs_out = (count_isa_int_reg_out > 0) ? new uint16_t[count_isa_int_reg_out] : nullptr;
-            std::memset(isa_int_regs_out, 0, count_isa_int_reg_out * sizeof( uint16_t ) );
-
-            phys_fp_regs_in = (count_phys_fp_reg_in > 0) ? new uint16_t[count_phys_fp_reg_in] : nullptr;
-            std::memset(phys_fp_regs_in, 0, count_phys_fp_reg_in * sizeof( uint16_t ));
-
-            phys_fp_regs_out = (count_phys_fp_reg_out > 0) ? new uint16_t[count_phys_fp_reg_out] : nullptr;
-            std::memset(phys_fp_regs_out, 0, count_phys_fp_reg_out * sizeof( uint16_t ));
-
-            isa_fp_regs_in = (count_isa_fp_reg_in > 0) ? new uint16_t[count_isa_fp_reg_in] : nullptr;
-            std::memset(isa_fp_regs_in, 0, count_isa_fp_reg_in * sizeof( uint16_t ) );
-
-            isa_fp_regs_out = (count_isa_fp_reg_out > 0) ? new uint16_t[count_isa_fp_reg_out] : nullptr;
-            std::memset(isa_fp_regs_out, 0, count_isa_fp_reg_out * sizeof( uint16_t ));
+            allocateRegs();
 
             trapError             = false;
             hasExecuted           = false;
@@ -81,19 +59,47 @@ class VanadisInstruction
             enduOpGroup           = false;
             isFrontOfROB          = false;
             hasROBSlot            = false;
+            orderViolation        = false;
             sw_thread = hw_thr;
         }
 
         virtual ~VanadisInstruction()
         {
-            if ( phys_int_regs_in != nullptr ) delete[] phys_int_regs_in;
-            if ( phys_int_regs_out != nullptr ) delete[] phys_int_regs_out;
-            if ( isa_int_regs_in != nullptr ) delete[] isa_int_regs_in;
-            if ( isa_int_regs_out != nullptr ) delete[] isa_int_regs_out;
-            if ( phys_fp_regs_in != nullptr ) delete[] phys_fp_regs_in;
-            if ( phys_fp_regs_out != nullptr ) delete[] phys_fp_regs_out;
-            if ( isa_fp_regs_in != nullptr ) delete[] isa_fp_regs_in;
-            if ( isa_fp_regs_out != nullptr ) delete[] isa_fp_regs_out;
+            if ( reg_storage != reg_inline ) delete[] reg_storage;
+        }
+
+        // Instructions are cloned out of the uop caches for every micro-op
+        // fetched and deleted at retire, so recycle them rather than going
+        // to the heap each time.  Every subclass picks these up, and the
+        // virtual destructor means delete is handed the size of the
+        // derived type.
+        static void* operator new(size_t size)
+        {
+            const size_t cls = (size + pool_granule - 1) / pool_granule;
+            if ( cls >= pool_classes ) return ::operator new(size);
+
+            InstructionPool* pool = getPool();
+            PoolEntry* entry = (pool == nullptr) ? nullptr : pool->free_list[cls];
+            if ( entry == nullptr ) return ::operator new(cls * pool_granule);
+
+            pool->free_list[cls] = entry->next;
+            return entry;
+        }
+
+        static void operator delete(void* ptr, size_t size)
+        {
+            if ( ptr == nullptr ) return;
+
+            const size_t cls = (size + pool_granule - 1) / pool_granule;
+            InstructionPool* pool = (cls >= pool_classes) ? nullptr : getPool();
+            if ( pool == nullptr ) {
+                ::operator delete(ptr);
+                return;
+            }
+
+            PoolEntry* entry = static_cast<PoolEntry*>(ptr);
+            entry->next = pool->free_list[cls];
+            pool->free_list[cls] = entry;
         }
 
         VanadisInstruction(const VanadisInstruction& copy_me) :
@@ -115,51 +121,11 @@ class VanadisInstruction
             enduOpGroup           = copy_me.enduOpGroup;
             isFrontOfROB          = false;
             hasROBSlot            = false;
+            orderViolation        = false;
             sw_thread             = copy_me.sw_thread;
 
-            phys_int_regs_in  = (count_phys_int_reg_in > 0) ? new uint16_t[count_phys_int_reg_in] : nullptr;
-            phys_int_regs_out = (count_phys_int_reg_out > 0) ? new uint16_t[count_phys_int_reg_out] : nullptr;
-
-            isa_int_regs_in  = (count_isa_int_reg_in > 0) ? new uint16_t[count_isa_int_reg_in] : nullptr;
-            isa_int_regs_out = (count_isa_int_reg_out > 0) ? new uint16_t[count_isa_int_reg_out] : nullptr;
-
-            phys_fp_regs_in  = (count_phys_fp_reg_in > 0) ? new uint16_t[count_phys_fp_reg_in] : nullptr;
-            phys_fp_regs_out = (count_phys_fp_reg_out > 0) ? new uint16_t[count_phys_fp_reg_out] : nullptr;
-
-            isa_fp_regs_in  = (count_isa_fp_reg_in > 0) ? new uint16_t[count_isa_fp_reg_in] : nullptr;
-            isa_fp_regs_out = (count_isa_fp_reg_out > 0) ? new uint16_t[count_isa_fp_reg_out] : nullptr;
-
-            for ( uint16_t i = 0; i < count_phys_int_reg_in; ++i ) {
-                phys_int_regs_in[i] = copy_me.phys_int_regs_in[i];
-            }
-
-            for ( uint16_t i = 0; i < count_phys_int_reg_out; ++i ) {
-                phys_int_regs_out[i] = copy_me.phys_int_regs_out[i];
-            }
-
-            for ( uint16_t i = 0; i < count_isa_int_reg_in; ++i ) {
-                isa_int_regs_in[i] = copy_me.isa_int_regs_in[i];
-            }
-
-            for ( uint16_t i = 0; i < count_isa_int_reg_out; ++i ) {
-                isa_int_regs_out[i] = copy_me.isa_int_regs_out[i];
-            }
-
-            for ( uint16_t i = 0; i < count_phys_fp_reg_in; ++i ) {
-                phys_fp_regs_in[i] = copy_me.phys_fp_regs_in[i];
-            }
-
-            for ( uint16_t i = 0; i < count_phys_fp_reg_out; ++i ) {
-                phys_fp_regs_out[i] = copy_me.phys_fp_regs_out[i];
-            }
-
-            for ( uint16_t i = 0; i < count_isa_fp_reg_in; ++i ) {
-                isa_fp_regs_in[i] = copy_me.isa_fp_regs_in[i];
-            }
-
-            for ( uint16_t i = 0; i < count_isa_fp_reg_out; ++i ) {
-                isa_fp_regs_out[i] = copy_me.isa_fp_regs_out[i];
-            }
+            allocateRegs();
+            std::memcpy(reg_storage, copy_me.reg_storage, countRegs() * sizeof(uint16_t));
         }
 
         // different
@@ -402,6 +368,9 @@ class VanadisInstruction
         // but branches and jumps will get predicte
         virtual bool isSpeculated() const { return false; }
 
+        // Marks the start of the region of interest, see fastforward_until_roi
+        virtual bool isROIMarker() const { return false; }
+
         bool completedExecution() const { return hasExecuted; }
         bool completedIssue() const { return hasIssued; }
 
@@ -418,6 +387,11 @@ class VanadisInstruction
 
         void flagError() { trapError = true; }
 
+        // Set by the LSQ on a load that issued ahead of an older store which
+        // turned out to write the same bytes, retire replays from the load
+        bool violatesMemoryOrder() const { return orderViolation; }
+        void flagMemoryOrderViolation() { orderViolation = true; }
+
         virtual bool performIntRegisterRecovery() const { return true; }
         virtual bool performFPRegisterRecovery() const { return true; }
 
@@ -463,6 +437,7 @@ class VanadisInstruction
         bool enduOpGroup;
         bool isFrontOfROB;
         bool hasROBSlot;
+        bool orderViolation;
 
         const VanadisDecoderOptions* isa_options;
         uint32_t sw_thread;
@@ -476,7 +451,122 @@ class VanadisInstruction
         uint16_t* phys_fp_regs_in;
         uint16_t* phys_fp_regs_out;
 
+        // Changes the number of integer registers after construction.  The
+        // integer registers are cleared, floating point ones are kept.
+        void resizeIntRegs(const uint16_t c_int_reg_in, const uint16_t c_int_reg_out)
+        {
+            uint16_t  old_inline[max_inline_regs];
+            uint16_t* old_storage = reg_storage;
+            if ( old_storage == reg_inline ) {
+                std::memcpy(old_inline, reg_inline, sizeof(reg_inline));
+                old_storage = old_inline;
+            }
+
+            const uint16_t old_fp[4] = { count_isa_fp_reg_in, count_isa_fp_reg_out,
+                count_phys_fp_reg_in, count_phys_fp_reg_out };
+            const uint16_t* old_fp_regs[4] = {
+                isa_fp_regs_in == nullptr ? nullptr : old_storage + (isa_fp_regs_in - reg_storage),
+                isa_fp_regs_out == nullptr ? nullptr : old_storage + (isa_fp_regs_out - reg_storage),
+                phys_fp_regs_in == nullptr ? nullptr : old_storage + (phys_fp_regs_in - reg_storage),
+                phys_fp_regs_out == nullptr ? nullptr : old_storage + (phys_fp_regs_out - reg_storage) };
+
+            count_isa_int_reg_in   = c_int_reg_in;
+            count_phys_int_reg_in  = c_int_reg_in;
+            count_isa_int_reg_out  = c_int_reg_out;
+            count_phys_int_reg_out = c_int_reg_out;
+
+            // Storage is no longer owned by reg_storage once allocateRegs runs
+            uint16_t* heap_storage = (old_storage == old_inline) ? nullptr : old_storage;
+            allocateRegs();
+
+            uint16_t* new_fp_regs[4] = { isa_fp_regs_in, isa_fp_regs_out, phys_fp_regs_in, phys_fp_regs_out };
+            for ( int i = 0; i < 4; ++i ) {
+                if ( old_fp[i] > 0 ) std::memcpy(new_fp_regs[i], old_fp_regs[i], old_fp[i] * sizeof(uint16_t));
+            }
+
+            delete[] heap_storage;
+        }
+
+    private:
+
+        // Register lists for most instructions fit in the object itself
+        static const uint32_t max_inline_regs = 16;
+
+        uint16_t  reg_inline[max_inline_regs];
+        uint16_t* reg_storage;
+
+        uint32_t countRegs() const
+        {
+            return (uint32_t)count_isa_int_reg_in + count_isa_int_reg_out + count_isa_fp_reg_in +
+                   count_isa_fp_reg_out + count_phys_int_reg_in + count_phys_int_reg_out + count_phys_fp_reg_in +
+                   count_phys_fp_reg_out;
+        }
+
+        uint16_t* carveRegs(uint16_t*& next, const uint16_t count)
+        {
+            if ( count == 0 ) return nullptr;
+            uint16_t* regs = next;
+            next += count;
+            return regs;
+        }
+
+        // All eight register lists share one zeroed block
+        void allocateRegs()
+        {
+            const uint32_t total = countRegs();
+            reg_storage = (total > max_inline_regs) ? new uint16_t[total] : reg_inline;
+            std::memset(reg_storage, 0, total * sizeof(uint16_t));
+
+            uint16_t* next    = reg_storage;
+            phys_int_regs_in  = carveRegs(next, count_phys_int_reg_in);
+            phys_int_regs_out = carveRegs(next, count_phys_int_reg_out);
+            isa_int_regs_in   = carveRegs(next, count_isa_int_reg_in);
+            isa_int_regs_out  = carveRegs(next, count_isa_int_reg_out);
+            phys_fp_regs_in   = carveRegs(next, count_phys_fp_reg_in);
+            phys_fp_regs_out  = carveRegs(next, count_phys_fp_reg_out);
+            isa_fp_regs_in    = carveRegs(next, count_isa_fp_reg_in);
+            isa_fp_regs_out   = carveRegs(next, count_isa_fp_reg_out);
+        }
 
+        // Free lists of instruction objects bucketed by size, one set per
+        // thread so no locking is needed
+        static const size_t pool_granule = 16;
+        static const size_t pool_classes = 64;
+
+        struct PoolEntry {
+            PoolEntry* next;
+        };
+
+        struct InstructionPool {
+            PoolEntry* free_list[pool_classes] = {};
+
+            ~InstructionPool()
+            {
+                poolDestroyed() = true;
+                for ( size_t i = 0; i < pool_classes; ++i ) {
+                    while ( free_list[i] != nullptr ) {
+                        PoolEntry* entry = free_list[i];
+                        free_list[i] = entry->next;
+                        ::operator delete(entry);
+                    }
+                }
+            }
+        };
+
+        // Instructions deleted during thread exit, after the pool has gone,
+        // go straight back to the heap
+        static bool& poolDestroyed()
+        {
+            static thread_local bool destroyed = false;
+            return destroyed;
+        }
+
+        static InstructionPool* getPool()
+        {
+            if ( poolDestroyed() ) return nullptr;
+            static thread_local InstructionPool pool;
+            return &pool;
+        }
 };
 
 } // namespace Vanadis
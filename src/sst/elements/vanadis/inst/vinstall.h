@@ -126,4 +126,10 @@
 // RoCC Custom
 #include "inst/vrocc.h"
 
+// Vector
+#include "inst/vsetvl.h"
+#include "inst/vvecarith.h"
+#include "inst/vvecload.h"
+#include "inst/vvecstore.h"
+
 #endif
@@ -35,7 +35,8 @@ enum VanadisFunctionalUnitType {
     INST_ROCC0,
     INST_ROCC1,
     INST_ROCC2,
-    INST_ROCC3
+    INST_ROCC3,
+    INST_VECTOR
 };
 
 inline const char*
@@ -66,6 +67,8 @@ funcTypeToString(VanadisFunctionalUnitType unit_type)
         return "FAULT";
     case INST_SYSCALL:
         return "SYSCALL";
+    case INST_VECTOR:
+        return "VECTOR";
     default:
         return "UNKNOWN";
     }
@@ -43,6 +43,12 @@ public:
 
     const char* getInstCode() const override { return "JL"; }
 
+    VanadisBranchType getBranchType() const override
+    {
+        return (isa_int_regs_out[0] == getISAOptions()->getRegisterIgnoreWrites()) ? VANADIS_BRANCH_DIRECT_JUMP
+                                                                                    : VANADIS_BRANCH_DIRECT_CALL;
+    }
+
     void printToBuffer(char* buffer, size_t buffer_size) override
     {
         snprintf(buffer, buffer_size, "JL      %" PRIu64 " (0x%" PRI_ADDR ")", takenAddress, takenAddress);
@@ -45,6 +45,15 @@ public:
 
     virtual const char* getInstCode() const { return "JLR"; }
 
+    VanadisBranchType getBranchType() const override
+    {
+        // Without a link this is a plain register jump, e.g. RISC-V ret
+        if ( isa_int_regs_out[0] != getISAOptions()->getRegisterIgnoreWrites() ) { return VANADIS_BRANCH_INDIRECT_CALL; }
+
+        return (isa_int_regs_in[0] == getISAOptions()->getISALinkReg()) ? VANADIS_BRANCH_RETURN
+                                                                        : VANADIS_BRANCH_INDIRECT_JUMP;
+    }
+
     virtual void printToBuffer(char* buffer, size_t buffer_size)
     {
         snprintf(
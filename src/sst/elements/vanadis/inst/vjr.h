@@ -38,6 +38,12 @@ public:
 
     virtual const char* getInstCode() const { return "JR"; }
 
+    VanadisBranchType getBranchType() const override
+    {
+        return (isa_int_regs_in[0] == getISAOptions()->getISALinkReg()) ? VANADIS_BRANCH_RETURN
+                                                                        : VANADIS_BRANCH_INDIRECT_JUMP;
+    }
+
     virtual void printToBuffer(char* buffer, size_t buffer_size)
     {
         snprintf(
@@ -42,6 +42,8 @@ public:
 
     const char* getInstCode() const override { return "JMP"; }
 
+    VanadisBranchType getBranchType() const override { return VANADIS_BRANCH_DIRECT_JUMP; }
+
     void printToBuffer(char* buffer, size_t buffer_size) override
     {
         snprintf(buffer, buffer_size, "JUMP    %" PRIu64 " / 0x%" PRI_ADDR "", takenAddress, takenAddress);
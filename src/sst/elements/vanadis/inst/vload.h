@@ -203,6 +203,10 @@ public:
 
     virtual uint16_t getLoadWidth() const { return load_width; }
 
+    // Called once the address is known, a load which turns out not to need
+    // memory (an inactive vector element) writes its result and returns true
+    virtual bool elidesMemoryAccess(VanadisRegisterFile* reg) { return false; }
+
     VanadisLoadRegisterType getValueRegisterType() const { return regType; }
 
     virtual uint16_t getRegisterOffset() const { return 0; }
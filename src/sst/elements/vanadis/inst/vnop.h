@@ -39,6 +39,24 @@ public:
     virtual void scalarExecute(SST::Output* output, VanadisRegisterFile* regFile) override { markExecuted(); }
 };
 
+// A no-op the program uses to mark the start of its region of interest.
+// Executes like any other no-op.
+class VanadisROIMarkerInstruction : public VanadisNoOpInstruction
+{
+public:
+    VanadisROIMarkerInstruction(const uint64_t addr, const uint32_t hw_thr, const VanadisDecoderOptions* isa_opts) :
+        VanadisNoOpInstruction(addr, hw_thr, isa_opts)
+    {}
+
+    VanadisROIMarkerInstruction* clone() override { return new VanadisROIMarkerInstruction(*this); }
+
+    virtual bool isROIMarker() const override { return true; }
+
+    virtual const char* getInstCode() const override { return "ROI"; }
+
+    virtual void printToBuffer(char* buffer, size_t buffer_size) override { snprintf(buffer, buffer_size, "ROI"); }
+};
+
 } // namespace Vanadis
 } // namespace SST
 
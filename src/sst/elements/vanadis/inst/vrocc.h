@@ -46,6 +46,7 @@ public:
         this->xs1 = xs1;
         this->xs2 = xs2;
         this->xd = xd;
+        this->tag = ROCC_UNTAGGED;
 
         switch (accelerator_id) {
             case 0:
@@ -96,6 +97,7 @@ public:
     bool xs1;
     bool xs2;
     bool xd;
+    uint64_t tag; // set when the instruction is queued for its accelerator
 };
 
 } // namespace Vanadis
@@ -0,0 +1,133 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_SET_VECTOR_LENGTH
+#define _H_VANADIS_SET_VECTOR_LENGTH
+
+#include "inst/vinst.h"
+
+namespace SST {
+namespace Vanadis {
+
+// Where the application vector length (AVL) of a vsetvl comes from
+enum VanadisVectorLengthSource {
+    VECTOR_AVL_REGISTER,  // AVL is held in an integer register
+    VECTOR_AVL_IMMEDIATE, // AVL is an immediate (vsetivli)
+    VECTOR_AVL_MAX,       // rs1 is x0 and rd is not, vl becomes VLMAX
+    VECTOR_AVL_KEEP       // rs1 and rd are x0, vl is unchanged
+};
+
+// Sets the vector length register to the number of elements the following
+// vector instructions operate on, min(AVL, VLMAX), and writes it to dest.
+// With vtype_reg given (vsetvl) the requested vtype is only known at execute
+// and must be the single one the decoder cracks, otherwise the instruction
+// traps.
+class VanadisSetVectorLengthInstruction : public virtual VanadisInstruction
+{
+public:
+    VanadisSetVectorLengthInstruction(
+        const uint64_t addr, const uint32_t hw_thr, const VanadisDecoderOptions* isa_opts, const uint16_t dest,
+        const uint16_t vl_reg, const VanadisVectorLengthSource source, const uint16_t avl_reg, const uint64_t avl_imm,
+        const uint64_t vlmax, const uint16_t vtype_reg = UINT16_MAX, const uint64_t supported_vtype = 0) :
+        VanadisInstruction(
+            addr, hw_thr, isa_opts,
+            ((source == VECTOR_AVL_REGISTER || source == VECTOR_AVL_KEEP) ? 1 : 0) + ((vtype_reg != UINT16_MAX) ? 1 : 0),
+            2,
+            ((source == VECTOR_AVL_REGISTER || source == VECTOR_AVL_KEEP) ? 1 : 0) + ((vtype_reg != UINT16_MAX) ? 1 : 0),
+            2, 0, 0, 0, 0),
+        avl_source(source),
+        avl_immediate(avl_imm),
+        max_vector_length(vlmax),
+        check_vtype(vtype_reg != UINT16_MAX),
+        supported_vector_type(supported_vtype)
+    {
+        uint16_t next_in = 0;
+
+        if ( source == VECTOR_AVL_REGISTER ) { isa_int_regs_in[next_in++] = avl_reg; }
+        if ( source == VECTOR_AVL_KEEP ) { isa_int_regs_in[next_in++] = vl_reg; }
+        if ( check_vtype ) { isa_int_regs_in[next_in++] = vtype_reg; }
+
+        isa_int_regs_out[0] = dest;
+        isa_int_regs_out[1] = vl_reg;
+    }
+
+    VanadisSetVectorLengthInstruction* clone() override { return new VanadisSetVectorLengthInstruction(*this); }
+    VanadisFunctionalUnitType          getInstFuncType() const override { return INST_INT_ARITH; }
+    const char*                        getInstCode() const override { return "VSETVL"; }
+
+    void printToBuffer(char* buffer, size_t buffer_size) override
+    {
+        snprintf(
+            buffer, buffer_size,
+            "VSETVL   %5" PRIu16 " <- min(avl, %" PRIu64 ") (phys: %5" PRIu16 ", vl phys: %5" PRIu16 ")",
+            isa_int_regs_out[0], max_vector_length, phys_int_regs_out[0], phys_int_regs_out[1]);
+    }
+
+    void scalarExecute(SST::Output* output, VanadisRegisterFile* regFile) override
+    {
+        uint64_t avl = 0;
+
+        switch ( avl_source ) {
+        case VECTOR_AVL_REGISTER:
+        case VECTOR_AVL_KEEP:
+            avl = regFile->getIntReg<uint64_t>(phys_int_regs_in[0]);
+            break;
+        case VECTOR_AVL_IMMEDIATE:
+            avl = avl_immediate;
+            break;
+        case VECTOR_AVL_MAX:
+            avl = max_vector_length;
+            break;
+        }
+
+        if ( check_vtype ) {
+            const uint64_t vtype = regFile->getIntReg<uint64_t>(phys_int_regs_in[count_isa_int_reg_in - 1]);
+
+            // ignore the tail and mask agnostic bits, undisturbed is a legal
+            // implementation of both
+            if ( (vtype & ~0xC0ULL) != supported_vector_type ) {
+                output->verbose(
+                    CALL_INFO, 16, 0, "Execute: 0x%" PRI_ADDR " VSETVL vtype 0x%" PRIx64 " is not supported\n",
+                    getInstructionAddress(), vtype);
+                flagError();
+            }
+        }
+
+        const uint64_t vl = (avl < max_vector_length) ? avl : max_vector_length;
+
+        #ifdef VANADIS_BUILD_DEBUG
+        output->verbose(
+            CALL_INFO, 16, 0, "Execute: 0x%" PRI_ADDR " VSETVL avl: %" PRIu64 " vlmax: %" PRIu64 " -> vl: %" PRIu64 "\n",
+            getInstructionAddress(), avl, max_vector_length, vl);
+        #endif
+
+        regFile->setIntReg<uint64_t>(phys_int_regs_out[0], vl);
+        regFile->setIntReg<uint64_t>(phys_int_regs_out[1], vl);
+
+        markExecuted();
+    }
+
+protected:
+    const VanadisVectorLengthSource avl_source;
+    const uint64_t                  avl_immediate;
+    const uint64_t                  max_vector_length;
+    const bool                      check_vtype;
+    const uint64_t                  supported_vector_type;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
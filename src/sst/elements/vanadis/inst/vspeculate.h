@@ -16,6 +16,7 @@
 #ifndef _H_VANADIS_SPECULATE
 #define _H_VANADIS_SPECULATE
 
+#include "inst/vbranchtype.h"
 #include "inst/vdelaytype.h"
 #include "inst/vinst.h"
 
@@ -59,8 +60,9 @@ public:
     virtual VanadisDelaySlotRequirement getDelaySlotType() const { return delayType; }
     uint64_t                            getInstructionWidth() const { return ins_width; }
 
-protected:
-    uint64_t calculateStandardNotTakenAddress()
+    virtual VanadisBranchType getBranchType() const { return VANADIS_BRANCH_CONDITIONAL; }
+
+    uint64_t getFallThroughAddress() const
     {
         uint64_t new_addr = getInstructionAddress();
 
@@ -77,6 +79,9 @@ protected:
         return new_addr;
     }
 
+protected:
+    uint64_t calculateStandardNotTakenAddress() { return getFallThroughAddress(); }
+
     VanadisDelaySlotRequirement delayType;
     uint64_t                    speculatedAddress;
     uint64_t                    takenAddress;
@@ -168,6 +168,10 @@ public:
 
     virtual uint16_t getRegisterOffset() const { return 0; }
 
+    // True for a store which turns out not to write memory (an inactive
+    // vector element)
+    virtual bool elidesMemoryAccess(VanadisRegisterFile* reg) { return false; }
+
     uint16_t getMemoryAddressRegister() const { return phys_int_regs_in[0]; }
     uint16_t getValueRegister() const
     {
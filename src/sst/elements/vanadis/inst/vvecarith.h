@@ -0,0 +1,233 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_VECTOR_ARITH
+#define _H_VANADIS_VECTOR_ARITH
+
+#include "inst/vinst.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace SST {
+namespace Vanadis {
+
+// vd = op(vs2, src), src is the vs1 element, an integer or floating point
+// scalar, or an immediate.  Subtract and divide take src from vs2 as the ISA
+// does, the multiply-accumulates add into the previous vd.
+enum VanadisVectorOp {
+    VECTOR_OP_ADD,
+    VECTOR_OP_SUB,
+    VECTOR_OP_RSUB,
+    VECTOR_OP_AND,
+    VECTOR_OP_OR,
+    VECTOR_OP_XOR,
+    VECTOR_OP_MUL,
+    VECTOR_OP_MACC,
+    VECTOR_OP_MOVE,
+    VECTOR_OP_FADD,
+    VECTOR_OP_FSUB,
+    VECTOR_OP_FMUL,
+    VECTOR_OP_FDIV,
+    VECTOR_OP_FMACC,
+    VECTOR_OP_FMOVE
+};
+
+enum VanadisVectorOperand { VECTOR_OPERAND_VECTOR, VECTOR_OPERAND_INT, VECTOR_OPERAND_FP, VECTOR_OPERAND_IMM };
+
+// One element of a vector arithmetic instruction.  The decoder cracks a
+// vector instruction into one of these per element of the register, each
+// reading the vector length so elements past it keep their old value (tail
+// undisturbed).  Vector register elements are held in floating point
+// registers, 64 bits each.
+class VanadisVectorArithInstruction : public virtual VanadisInstruction
+{
+public:
+    VanadisVectorArithInstruction(
+        const uint64_t addr, const uint32_t hw_thr, const VanadisDecoderOptions* isa_opts, const VanadisVectorOp op,
+        const VanadisVectorOperand src_kind, const uint16_t element, const uint16_t vl_reg, const uint16_t dest,
+        const uint16_t vs2, const uint16_t src, const int64_t imm = 0) :
+        VanadisInstruction(
+            addr, hw_thr, isa_opts, (src_kind == VECTOR_OPERAND_INT) ? 2 : 1, 0, (src_kind == VECTOR_OPERAND_INT) ? 2 : 1,
+            0, countFPIn(op, src_kind), 1, countFPIn(op, src_kind), 1),
+        vector_op(op),
+        operand_kind(src_kind),
+        element_index(element),
+        imm_value(imm)
+    {
+        isa_int_regs_in[0] = vl_reg;
+        if ( src_kind == VECTOR_OPERAND_INT ) { isa_int_regs_in[1] = src; }
+
+        uint16_t next_in = 0;
+        isa_fp_regs_in[next_in++] = dest;
+        if ( !isMove(op) ) { isa_fp_regs_in[next_in++] = vs2; }
+        if ( src_kind == VECTOR_OPERAND_VECTOR || src_kind == VECTOR_OPERAND_FP ) { isa_fp_regs_in[next_in++] = src; }
+
+        isa_fp_regs_out[0] = dest;
+    }
+
+    VanadisVectorArithInstruction* clone() override { return new VanadisVectorArithInstruction(*this); }
+    VanadisFunctionalUnitType      getInstFuncType() const override { return INST_VECTOR; }
+
+    const char* getInstCode() const override
+    {
+        switch ( vector_op ) {
+        case VECTOR_OP_ADD:
+            return "VADD";
+        case VECTOR_OP_SUB:
+            return "VSUB";
+        case VECTOR_OP_RSUB:
+            return "VRSUB";
+        case VECTOR_OP_AND:
+            return "VAND";
+        case VECTOR_OP_OR:
+            return "VOR";
+        case VECTOR_OP_XOR:
+            return "VXOR";
+        case VECTOR_OP_MUL:
+            return "VMUL";
+        case VECTOR_OP_MACC:
+            return "VMACC";
+        case VECTOR_OP_MOVE:
+            return "VMV";
+        case VECTOR_OP_FADD:
+            return "VFADD";
+        case VECTOR_OP_FSUB:
+            return "VFSUB";
+        case VECTOR_OP_FMUL:
+            return "VFMUL";
+        case VECTOR_OP_FDIV:
+            return "VFDIV";
+        case VECTOR_OP_FMACC:
+            return "VFMACC";
+        case VECTOR_OP_FMOVE:
+            return "VFMV";
+        }
+
+        return "VUNK";
+    }
+
+    void printToBuffer(char* buffer, size_t buffer_size) override
+    {
+        snprintf(
+            buffer, buffer_size, "%s [%" PRIu16 "]  %5" PRIu16 " <- (phys: %5" PRIu16 ", vl phys: %5" PRIu16 ")",
+            getInstCode(), element_index, isa_fp_regs_out[0], phys_fp_regs_out[0], phys_int_regs_in[0]);
+    }
+
+    void scalarExecute(SST::Output* output, VanadisRegisterFile* regFile) override
+    {
+        const uint64_t vl  = regFile->getIntReg<uint64_t>(phys_int_regs_in[0]);
+        const uint64_t old = regFile->getFPReg<uint64_t>(phys_fp_regs_in[0]);
+        uint64_t result    = old;
+
+        if ( element_index < vl ) {
+            const uint64_t vs2 = isMove(vector_op) ? 0 : regFile->getFPReg<uint64_t>(phys_fp_regs_in[1]);
+            uint64_t       src = 0;
+
+            switch ( operand_kind ) {
+            case VECTOR_OPERAND_VECTOR:
+            case VECTOR_OPERAND_FP:
+                src = regFile->getFPReg<uint64_t>(phys_fp_regs_in[count_isa_fp_reg_in - 1]);
+                break;
+            case VECTOR_OPERAND_INT:
+                src = regFile->getIntReg<uint64_t>(phys_int_regs_in[1]);
+                break;
+            case VECTOR_OPERAND_IMM:
+                src = static_cast<uint64_t>(imm_value);
+                break;
+            }
+
+            result = compute(vs2, src, old);
+        }
+
+        #ifdef VANADIS_BUILD_DEBUG
+        output->verbose(
+            CALL_INFO, 16, 0, "Execute: 0x%" PRI_ADDR " %s element %" PRIu16 " (vl: %" PRIu64 ") -> 0x%" PRIx64 "\n",
+            getInstructionAddress(), getInstCode(), element_index, vl, result);
+        #endif
+
+        regFile->setFPReg<uint64_t>(phys_fp_regs_out[0], result);
+        markExecuted();
+    }
+
+protected:
+    static bool isMove(const VanadisVectorOp op) { return op == VECTOR_OP_MOVE || op == VECTOR_OP_FMOVE; }
+
+    static uint16_t countFPIn(const VanadisVectorOp op, const VanadisVectorOperand src_kind)
+    {
+        return 1 + (isMove(op) ? 0 : 1) + ((src_kind == VECTOR_OPERAND_VECTOR || src_kind == VECTOR_OPERAND_FP) ? 1 : 0);
+    }
+
+    static double toDouble(const uint64_t bits)
+    {
+        double v;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+
+    static uint64_t fromDouble(const double v)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        return bits;
+    }
+
+    uint64_t compute(const uint64_t vs2, const uint64_t src, const uint64_t old) const
+    {
+        switch ( vector_op ) {
+        case VECTOR_OP_ADD:
+            return vs2 + src;
+        case VECTOR_OP_SUB:
+            return vs2 - src;
+        case VECTOR_OP_RSUB:
+            return src - vs2;
+        case VECTOR_OP_AND:
+            return vs2 & src;
+        case VECTOR_OP_OR:
+            return vs2 | src;
+        case VECTOR_OP_XOR:
+            return vs2 ^ src;
+        case VECTOR_OP_MUL:
+            return vs2 * src;
+        case VECTOR_OP_MACC:
+            return (vs2 * src) + old;
+        case VECTOR_OP_MOVE:
+        case VECTOR_OP_FMOVE:
+            return src;
+        case VECTOR_OP_FADD:
+            return fromDouble(toDouble(vs2) + toDouble(src));
+        case VECTOR_OP_FSUB:
+            return fromDouble(toDouble(vs2) - toDouble(src));
+        case VECTOR_OP_FMUL:
+            return fromDouble(toDouble(vs2) * toDouble(src));
+        case VECTOR_OP_FDIV:
+            return fromDouble(toDouble(vs2) / toDouble(src));
+        case VECTOR_OP_FMACC:
+            return fromDouble(std::fma(toDouble(vs2), toDouble(src), toDouble(old)));
+        }
+
+        return old;
+    }
+
+    const VanadisVectorOp      vector_op;
+    const VanadisVectorOperand operand_kind;
+    const uint16_t             element_index;
+    const int64_t              imm_value;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
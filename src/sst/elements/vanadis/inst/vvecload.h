@@ -0,0 +1,132 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_VECTOR_LOAD
+#define _H_VANADIS_VECTOR_LOAD
+
+#include "inst/vload.h"
+
+namespace SST {
+namespace Vanadis {
+
+enum VanadisVectorAddressMode {
+    VECTOR_ADDRESS_UNIT_STRIDE, // base + element * width
+    VECTOR_ADDRESS_STRIDED,     // base + element * stride register
+    VECTOR_ADDRESS_INDEXED      // base + element of an index vector register
+};
+
+// One element of a vector load, which goes through the LSQ like any other
+// load.  Elements at or past the vector length keep the old register value
+// and do not access memory.
+class VanadisVectorLoadInstruction : public VanadisLoadInstruction
+{
+public:
+    VanadisVectorLoadInstruction(
+        const uint64_t addr, const uint32_t hw_thr, const VanadisDecoderOptions* isa_opts,
+        const VanadisVectorAddressMode mode, const uint16_t element, const uint16_t vl_reg, const uint16_t base_reg,
+        const uint16_t stride_or_index_reg, const uint16_t dest, const uint16_t element_bytes) :
+        VanadisInstruction(
+            addr, hw_thr, isa_opts, (mode == VECTOR_ADDRESS_STRIDED) ? 3 : 2, 0, (mode == VECTOR_ADDRESS_STRIDED) ? 3 : 2,
+            0, (mode == VECTOR_ADDRESS_INDEXED) ? 2 : 1, 1, (mode == VECTOR_ADDRESS_INDEXED) ? 2 : 1, 1),
+        VanadisLoadInstruction(
+            addr, hw_thr, isa_opts, base_reg, 0, dest, element_bytes, false, MEM_TRANSACTION_NONE, LOAD_FP_REGISTER),
+        address_mode(mode),
+        element_index(element)
+    {
+        isa_int_regs_in[1] = vl_reg;
+        if ( mode == VECTOR_ADDRESS_STRIDED ) { isa_int_regs_in[2] = stride_or_index_reg; }
+
+        // the old value is read so inactive elements can keep it
+        isa_fp_regs_in[0] = dest;
+        if ( mode == VECTOR_ADDRESS_INDEXED ) { isa_fp_regs_in[1] = stride_or_index_reg; }
+    }
+
+    VanadisVectorLoadInstruction* clone() override { return new VanadisVectorLoadInstruction(*this); }
+
+    const char* getInstCode() const override
+    {
+        switch ( address_mode ) {
+        case VECTOR_ADDRESS_UNIT_STRIDE:
+            return "VLOAD";
+        case VECTOR_ADDRESS_STRIDED:
+            return "VLOADSTRIDE";
+        case VECTOR_ADDRESS_INDEXED:
+            return "VLOADINDEX";
+        }
+
+        return "VLOADUNK";
+    }
+
+    void printToBuffer(char* buffer, size_t buffer_size) override
+    {
+        snprintf(
+            buffer, buffer_size,
+            "%s [%" PRIu16 "] (%" PRIu16 " bytes)  %5" PRIu16 " <- memory[ %5" PRIu16 " ] (phys: %5" PRIu16
+            " <- memory[%5" PRIu16 "])",
+            getInstCode(), element_index, load_width, isa_fp_regs_out[0], isa_int_regs_in[0], phys_fp_regs_out[0],
+            phys_int_regs_in[0]);
+    }
+
+    void computeLoadAddress(VanadisRegisterFile* reg, uint64_t* out_addr, uint16_t* width) override
+    {
+        (*out_addr) = elementAddress(reg);
+        (*width)    = load_width;
+    }
+
+    void computeLoadAddress(SST::Output* output, VanadisRegisterFile* reg, uint64_t* out_addr, uint16_t* width) override
+    {
+        (*out_addr) = elementAddress(reg);
+        (*width)    = load_width;
+
+        if ( output->getVerboseLevel() >= 16 ) {
+            output->verbose(
+                CALL_INFO, 16, 0, "Execute: (0x%" PRI_ADDR ") %s element %" PRIu16 " addr: 0x%" PRI_ADDR "\n",
+                getInstructionAddress(), getInstCode(), element_index, (*out_addr));
+        }
+    }
+
+    bool elidesMemoryAccess(VanadisRegisterFile* reg) override
+    {
+        if ( element_index < reg->getIntReg<uint64_t>(phys_int_regs_in[1]) ) { return false; }
+
+        reg->setFPReg<uint64_t>(phys_fp_regs_out[0], reg->getFPReg<uint64_t>(phys_fp_regs_in[0]));
+        return true;
+    }
+
+protected:
+    uint64_t elementAddress(VanadisRegisterFile* reg)
+    {
+        const uint64_t base = reg->getIntReg<uint64_t>(phys_int_regs_in[0]);
+
+        switch ( address_mode ) {
+        case VECTOR_ADDRESS_UNIT_STRIDE:
+            return base + (static_cast<uint64_t>(element_index) * load_width);
+        case VECTOR_ADDRESS_STRIDED:
+            return base + (static_cast<uint64_t>(element_index) * reg->getIntReg<uint64_t>(phys_int_regs_in[2]));
+        case VECTOR_ADDRESS_INDEXED:
+            return base + reg->getFPReg<uint64_t>(phys_fp_regs_in[1]);
+        }
+
+        return base;
+    }
+
+    const VanadisVectorAddressMode address_mode;
+    const uint16_t                 element_index;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,111 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_VECTOR_STORE
+#define _H_VANADIS_VECTOR_STORE
+
+#include "inst/vstore.h"
+#include "inst/vvecload.h"
+
+namespace SST {
+namespace Vanadis {
+
+// One element of a vector store (or scatter).  Elements at or past the
+// vector length do not write memory.
+class VanadisVectorStoreInstruction : public VanadisStoreInstruction
+{
+public:
+    VanadisVectorStoreInstruction(
+        const uint64_t addr, const uint32_t hw_thr, const VanadisDecoderOptions* isa_opts,
+        const VanadisVectorAddressMode mode, const uint16_t element, const uint16_t vl_reg, const uint16_t base_reg,
+        const uint16_t stride_or_index_reg, const uint16_t value_reg, const uint16_t element_bytes) :
+        VanadisInstruction(
+            addr, hw_thr, isa_opts, (mode == VECTOR_ADDRESS_STRIDED) ? 3 : 2, 0, (mode == VECTOR_ADDRESS_STRIDED) ? 3 : 2,
+            0, (mode == VECTOR_ADDRESS_INDEXED) ? 2 : 1, 0, (mode == VECTOR_ADDRESS_INDEXED) ? 2 : 1, 0),
+        VanadisStoreInstruction(
+            addr, hw_thr, isa_opts, base_reg, 0, value_reg, element_bytes, MEM_TRANSACTION_NONE, STORE_FP_REGISTER),
+        address_mode(mode),
+        element_index(element)
+    {
+        isa_int_regs_in[1] = vl_reg;
+        if ( mode == VECTOR_ADDRESS_STRIDED ) { isa_int_regs_in[2] = stride_or_index_reg; }
+        if ( mode == VECTOR_ADDRESS_INDEXED ) { isa_fp_regs_in[1] = stride_or_index_reg; }
+    }
+
+    VanadisVectorStoreInstruction* clone() override { return new VanadisVectorStoreInstruction(*this); }
+
+    const char* getInstCode() const override
+    {
+        switch ( address_mode ) {
+        case VECTOR_ADDRESS_UNIT_STRIDE:
+            return "VSTORE";
+        case VECTOR_ADDRESS_STRIDED:
+            return "VSTORESTRIDE";
+        case VECTOR_ADDRESS_INDEXED:
+            return "VSTOREINDEX";
+        }
+
+        return "VSTOREUNK";
+    }
+
+    void printToBuffer(char* buffer, size_t buffer_size) override
+    {
+        snprintf(
+            buffer, buffer_size,
+            "%s [%" PRIu16 "] (%" PRIu16 " bytes)  %5" PRIu16 " -> memory[ %5" PRIu16 " ] (phys: %5" PRIu16
+            " -> memory[%5" PRIu16 "])",
+            getInstCode(), element_index, store_width, isa_fp_regs_in[0], isa_int_regs_in[0], phys_fp_regs_in[0],
+            phys_int_regs_in[0]);
+    }
+
+    void computeStoreAddress(SST::Output* output, VanadisRegisterFile* reg, uint64_t* store_addr, uint16_t* op_width) override
+    {
+        const uint64_t base = reg->getIntReg<uint64_t>(phys_int_regs_in[0]);
+
+        switch ( address_mode ) {
+        case VECTOR_ADDRESS_UNIT_STRIDE:
+            (*store_addr) = base + (static_cast<uint64_t>(element_index) * store_width);
+            break;
+        case VECTOR_ADDRESS_STRIDED:
+            (*store_addr) = base + (static_cast<uint64_t>(element_index) * reg->getIntReg<uint64_t>(phys_int_regs_in[2]));
+            break;
+        case VECTOR_ADDRESS_INDEXED:
+            (*store_addr) = base + reg->getFPReg<uint64_t>(phys_fp_regs_in[1]);
+            break;
+        }
+
+        (*op_width) = store_width;
+
+        if ( output->getVerboseLevel() >= 16 ) {
+            output->verbose(
+                CALL_INFO, 16, 0, "Execute: (0x%" PRI_ADDR ") %s element %" PRIu16 " addr: 0x%" PRI_ADDR "\n",
+                getInstructionAddress(), getInstCode(), element_index, (*store_addr));
+        }
+    }
+
+    bool elidesMemoryAccess(VanadisRegisterFile* reg) override
+    {
+        return element_index >= reg->getIntReg<uint64_t>(phys_int_regs_in[1]);
+    }
+
+protected:
+    const VanadisVectorAddressMode address_mode;
+    const uint16_t                 element_index;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
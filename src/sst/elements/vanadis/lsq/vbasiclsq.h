@@ -25,9 +25,11 @@
 #include "util/vsignx.h"
 #include "inst/vstorecond.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
 #include <cstdint>
+#include <unordered_map>
 #include <vector>
 #include <queue>
 
@@ -53,7 +55,10 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                 { "max_loads", "Set the maximum number of loads permitted in the queue", "16" },
                 { "address_mask", "Can mask off address bits if needed during construction of a operation", "0xFFFFFFFFFFFFFFFF"},
                 { "issues_per_cycle", "Maximum number of issues the LSQ can attempt per cycle.", "2"},
-                { "cache_line_width", "Number of bytes in a (L1) cache line", "64"}
+                { "cache_line_width", "Number of bytes in a (L1) cache line", "64"},
+                { "store_forwarding", "Let a load take its data from the youngest older store in the store buffer which covers it instead of waiting for the store to drain", "false"},
+                { "store_set_entries", "Number of entries in the store set table used to predict which loads may issue ahead of older stores whose address is not known. 0 keeps loads in order", "0"},
+                { "store_set_clear_interval", "Clear the store set table every this many cycles so stale dependences do not hold loads back. 0 never clears", "1000000"}
             )
 
         SST_ELI_DOCUMENT_STATISTICS({ "bytes_read", "Count all the bytes read for data operations", "bytes", 1 },
@@ -69,13 +74,19 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                                     { "stores_in_flight", "Count the number of stores which are in-flight", "operations", 1},
                                     { "store_buffer_entries", "Count the number of stores held in the store buffer", "operations", 1},
                                     { "split_stores", "Count the number of stores which are fractured due to cache boundaries", "operations", 1},
-                                    { "split_loads", "Count the number of loads which are fractured due to cache boundaries", "operations", 1})
+                                    { "split_loads", "Count the number of loads which are fractured due to cache boundaries", "operations", 1},
+                                    { "loads_forwarded", "Count the number of loads which took their data from the store buffer", "operations", 1},
+                                    { "loads_speculated", "Count the number of loads issued ahead of an older store whose address was not known", "operations", 1},
+                                    { "memory_order_violations", "Count the number of speculated loads which read memory an older store then wrote, each causes a replay from the load", "operations", 1})
 
 
         VanadisBasicLoadStoreQueue(ComponentId_t id, Params& params, int coreid, int hwthreads) : VanadisLoadStoreQueue(id, params, coreid, hwthreads),
             max_stores(params.find<size_t>("max_stores", 8)),
         max_loads(params.find<size_t>("max_loads", 16)),
-        max_issue_attempts_per_cycle(params.find("issues_per_cycle", 2))
+        max_issue_attempts_per_cycle(params.find("issues_per_cycle", 2)),
+        store_forwarding(params.find<bool>("store_forwarding", false)),
+        store_set_entries(params.find<uint32_t>("store_set_entries", 0)),
+        store_set_clear_interval(params.find<uint64_t>("store_set_clear_interval", 1000000))
         {
             std_mem_handlers = new VanadisBasicLoadStoreQueue::StandardMemHandlers(this, output);
 
@@ -95,6 +106,12 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
             stores_pending_index = 0;
             stores_pending_size = 0;
 
+            store_lines.resize(hw_threads);
+            loads_pending_count.resize(hw_threads, 0);
+            op_q_seq.resize(hw_threads, 0);
+            speculated_loads.resize(hw_threads);
+            store_sets.resize(store_set_entries, 0);
+
             stat_loads_issued = registerStatistic<uint64_t>("loads_issued", "1");
             stat_stores_issued = registerStatistic<uint64_t>("stores_issued", "1");
             stat_fences_issued = registerStatistic<uint64_t>("fences_issued", "1");
@@ -110,6 +127,10 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
             stat_stores_pending = registerStatistic<uint64_t>("stores_in_flight", "1");
             stat_loads_pending = registerStatistic<uint64_t>("loads_in_flight", "1");
             stat_op_q_size = registerStatistic<uint64_t>("operations_pending");
+
+            stat_loads_forwarded = registerStatistic<uint64_t>("loads_forwarded", "1");
+            stat_loads_speculated = registerStatistic<uint64_t>("loads_speculated", "1");
+            stat_order_violations = registerStatistic<uint64_t>("memory_order_violations", "1");
         }
 
 
@@ -133,21 +154,27 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
 
         void push(VanadisStoreInstruction* store_me) override
         {
-            op_q[store_me->getHWThread()].push_back( new VanadisBasicStoreEntry(store_me) );
+            VanadisBasicStoreEntry* entry = new VanadisBasicStoreEntry(store_me);
+            entry->setSequence(op_q_seq[store_me->getHWThread()]++);
+            op_q[store_me->getHWThread()].push_back( entry );
             op_q_size++;
             stat_stores_issued->addData(1);
         }
 
         void push(VanadisLoadInstruction* load_me) override
         {
-            op_q[load_me->getHWThread()].push_back( new VanadisBasicLoadEntry(load_me) );
+            VanadisBasicLoadEntry* entry = new VanadisBasicLoadEntry(load_me);
+            entry->setSequence(op_q_seq[load_me->getHWThread()]++);
+            op_q[load_me->getHWThread()].push_back( entry );
             op_q_size++;
             stat_loads_issued->addData(1);
         }
 
         void push(VanadisFenceInstruction* fence) override
         {
-            op_q[fence->getHWThread()].push_back( new VanadisBasicFenceEntry(fence) );
+            VanadisBasicFenceEntry* entry = new VanadisBasicFenceEntry(fence);
+            entry->setSequence(op_q_seq[fence->getHWThread()]++);
+            op_q[fence->getHWThread()].push_back( entry );
             op_q_size++;
             stat_fences_issued->addData(1);
         }
@@ -174,11 +201,17 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                 }
             }
 
+            loads_pending_count[thread] = 0;
+
             stores_pending_size -= stores_pending[thread].size();
             for(auto store_itr = stores_pending[thread].begin(); store_itr != stores_pending[thread].end(); ) {
                 delete (*store_itr);
                 store_itr = stores_pending[thread].erase(store_itr);
             }
+            store_lines[thread].clear();
+
+            // the loads recorded here have all just been squashed
+            speculated_loads[thread].clear();
         }
 
         // must be implemented to allow the memory system to initialize itself during
@@ -248,6 +281,10 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
             stat_stores_pending->addData(std_stores_in_flight.size());
             stat_store_buffer_entries->addData(stores_pending_size);
 
+            if(UNLIKELY((store_set_entries > 0) && (store_set_clear_interval > 0) && (0 == (cycle % store_set_clear_interval)))) {
+                std::fill(store_sets.begin(), store_sets.end(), 0);
+            }
+
             // this can be called multiple times per cycle
             for(uint32_t attempt = 0; attempt < max_issue_attempts_per_cycle; ++attempt) {
                 if (op_q_size == 0)
@@ -326,6 +363,98 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                     }
                 }
 
+                // Copies the bytes returned for a load (or one half of a split load) into the target
+                // register, extending the value once the last part has arrived
+                void writeLoadData(VanadisLoadInstruction* load_ins, VanadisBasicLoadPendingEntry* load_entry,
+                    const uint64_t addr_offset, const uint8_t* data, const uint16_t size, const bool last)
+                {
+                    uint16_t target_reg = 0;
+                    uint16_t target_isa_reg = 64;
+                    uint32_t target_thread     = 0;
+                    uint8_t fp = 0;
+                    const uint16_t load_width = size;
+                    const uint64_t reg_offset = load_ins->getRegisterOffset();
+                    uint32_t reg_width = 0;
+
+                    switch(load_ins->getValueRegisterType()) {
+                    case LOAD_INT_REGISTER: {
+
+                        if ( ! load_ins->trapsError() ) {;
+
+
+                        copyLoadResp(load_ins, &target_reg,&target_isa_reg,&target_thread,load_entry,fp);
+
+                        assert(target_isa_reg < load_ins->getISAOptions()->countISAIntRegisters());
+
+                        if(target_reg != load_ins->getISAOptions()->getRegisterIgnoreWrites()) {
+                            reg_width = lsq->registerFiles->at(target_thread)->getIntRegWidth();
+                            std::vector<uint8_t> register_value(reg_width);
+                            // copy entire register here
+                            lsq->registerFiles->at(target_thread)->copyFromIntRegister(target_reg, 0, &register_value[0], reg_width);
+
+                            assert((reg_offset + addr_offset + size) <= reg_width);
+
+                            for(auto i = 0; i < size; ++i) {
+                                register_value.at(reg_offset + addr_offset + i) = data[i];
+                            }
+
+                            // if we are the last request to be processed for this load (if any were split)
+                            // and we promised to do sign extension, then perform it now
+                            if(last) {
+                                if(load_ins->performSignExtension()) {
+                                    if((register_value.at(reg_offset + addr_offset + load_width - 1) & 0x80) != 0) {
+                                        for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
+                                            register_value.at(i) = 0xFF;
+                                        }
+                                    } else {
+                                        for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
+                                            register_value.at(i) = 0x00;
+                                        }
+                                    }
+                                } else {
+                                    for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
+                                        register_value.at(i) = 0x00;
+                                    }
+                                }
+                            }
+
+                            lsq->registerFiles->at(target_thread)->copyToIntRegister(target_reg, 0, &register_value[0], register_value.size());
+                        }
+                        }
+                    } break;
+                    case LOAD_FP_REGISTER: {
+
+                        if ( ! load_ins->trapsError() ) {
+                        fp=1;
+                        copyLoadResp(load_ins, &target_reg,&target_isa_reg,&target_thread,load_entry,fp);
+
+
+                        reg_width = lsq->registerFiles->at(target_thread)->getFPRegWidth();
+                        std::vector<uint8_t> register_value(reg_width);
+
+                        // copy entire register here
+                        lsq->registerFiles->at(target_thread)->copyFromFPRegister(target_reg, 0, &register_value[0], reg_width);
+
+                        assert((reg_offset + addr_offset + size) <= reg_width);
+
+                        for(auto i = reg_offset + addr_offset; i < size; ++i) {
+                            register_value.at(reg_offset + addr_offset + i) = data[i];
+                        }
+
+                        if(last) {
+                            for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
+                                register_value.at(i) = 0xff;
+                            }
+                        }
+
+                        lsq->registerFiles->at(target_thread)->copyToFPRegister(target_reg, 0, &register_value[0], reg_width);
+                        }
+                    } break;
+                    default:
+                        out->fatal(CALL_INFO, -1, "Unknown register type.\n");
+                    }
+                }
+
                 virtual void handle(StandardMem::ReadResp* ev)
                 {
                     out->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "-> handle read-response (virt-addr: 0x%" PRI_ADDR ")\n", ev->vAddr);
@@ -386,11 +515,8 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
 
                     uint16_t target_reg = 0;
                     uint16_t target_isa_reg = 64;
-                    uint32_t target_thread     = 0;
-                    uint8_t fp = 0;
                     uint64_t reg_offset  = load_ins->getRegisterOffset();
                     uint64_t addr_offset = ev->vAddr - load_address;
-                    uint32_t reg_width = 0;
 
                     if(out->getVerboseLevel() >= 0) {
                         std::ostringstream str;
@@ -408,83 +534,7 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                     }
 
 
-                    switch(load_ins->getValueRegisterType()) {
-                    case LOAD_INT_REGISTER: {
-
-                        if ( ! load_ins->trapsError() ) {;
-
-
-                        copyLoadResp(load_ins, &target_reg,&target_isa_reg,&target_thread,load_entry,fp);
-
-                        assert(target_isa_reg < load_ins->getISAOptions()->countISAIntRegisters());
-
-                        if(target_reg != load_ins->getISAOptions()->getRegisterIgnoreWrites()) {
-                            reg_width = lsq->registerFiles->at(target_thread)->getIntRegWidth();
-                            std::vector<uint8_t> register_value(reg_width);
-                            // copy entire register here
-                            lsq->registerFiles->at(target_thread)->copyFromIntRegister(target_reg, 0, &register_value[0], reg_width);
-
-                            assert((reg_offset + addr_offset + ev->size) <= reg_width);
-
-                            for(auto i = 0; i < ev->size; ++i) {
-                                register_value.at(reg_offset + addr_offset + i) = ev->data[i];
-                            }
-
-                            // if we are the last request to be processed for this load (if any were split)
-                            // and we promised to do sign extension, then perform it now
-                            if(load_entry->countRequests() == 1) {
-                                if(load_ins->performSignExtension()) {
-                                    if((register_value.at(reg_offset + addr_offset + load_width - 1) & 0x80) != 0) {
-                                        for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
-                                            register_value.at(i) = 0xFF;
-                                        }
-                                    } else {
-                                        for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
-                                            register_value.at(i) = 0x00;
-                                        }
-                                    }
-                                } else {
-                                    for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
-                                        register_value.at(i) = 0x00;
-                                    }
-                                }
-                            }
-
-                            lsq->registerFiles->at(target_thread)->copyToIntRegister(target_reg, 0, &register_value[0], register_value.size());
-                        }
-                        }
-                    } break;
-                    case LOAD_FP_REGISTER: {
-
-                        if ( ! load_ins->trapsError() ) {
-                        fp=1;
-                        copyLoadResp(load_ins, &target_reg,&target_isa_reg,&target_thread,load_entry,fp);
-
-
-                        reg_width = lsq->registerFiles->at(target_thread)->getFPRegWidth();
-                        std::vector<uint8_t> register_value(reg_width);
-
-                        // copy entire register here
-                        lsq->registerFiles->at(target_thread)->copyFromFPRegister(target_reg, 0, &register_value[0], reg_width);
-
-                        assert((reg_offset + addr_offset + ev->size) <= reg_width);
-
-                        for(auto i = reg_offset + addr_offset; i < ev->size; ++i) {
-                            register_value.at(reg_offset + addr_offset + i) = ev->data[i];
-                        }
-
-                        if(load_entry->countRequests() == 1) {
-                            for(auto i = reg_offset + addr_offset + load_width; i < reg_width; ++i) {
-                                register_value.at(i) = 0xff;
-                            }
-                        }
-
-                        lsq->registerFiles->at(target_thread)->copyToFPRegister(target_reg, 0, &register_value[0], reg_width);
-                        }
-                    } break;
-                    default:
-                        out->fatal(CALL_INFO, -1, "Unknown register type.\n");
-                    }
+                    writeLoadData(load_ins, load_entry, addr_offset, &ev->data[0], ev->size, load_entry->countRequests() == 1);
 
                     ///////////////////////////////////////////////////////////////////////////////////
 
@@ -500,6 +550,7 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
 
                         load_ins->markExecuted();
                         lsq->stat_loads_executed->addData(1);
+                        lsq->loads_pending_count[load_entry->getHWThread()]--;
                         lsq->loads_pending.erase(load_itr);
                         delete load_entry;
                     } else {
@@ -553,6 +604,7 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                                 processLLSC(ev,store_ins,store_entry);
 
                                 store_ins->markExecuted();
+                                lsq->trackStoreLines(thr, store_entry, false);
                                 lsq->stores_pending[thr].erase(lsq->stores_pending[thr].begin());
                                 lsq->stores_pending_size--;
                                 delete store_entry;
@@ -561,6 +613,7 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                             case MEM_TRANSACTION_LOCK:
                             {
                                 store_ins->markExecuted();
+                                lsq->trackStoreLines(thr, store_entry, false);
                                 lsq->stores_pending[thr].erase(lsq->stores_pending[thr].begin());
                                 lsq->stores_pending_size--;
                                 delete store_entry;
@@ -632,6 +685,7 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                     // this was a standard store (not LLSC/LOCK) and we issued into system successfully
                     if(LIKELY(issue_result))
                     {
+                        trackStoreLines(thr, current_store, false);
                         stores_pending[thr].pop_front();
                         stores_pending_size--;
 
@@ -640,12 +694,12 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                             output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_STORE_FLG, "---> issued store: 0x%" PRI_ADDR " / hw_thr: %" PRIu32 " / sw_thr: %" PRIu32 " into memory system using standard store operation\n",
                                 store_ins->getInstructionAddress(), store_ins->getHWThread(),current_store->getSWThr());
                         }
-                        delete current_store;
 
                         // mark executed
                         store_ins->markExecuted();
                         output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_STORE_FLG, "---> issued store: 0x%" PRI_ADDR " / hw_thr: %" PRIu32 " / sw_thr: %" PRIu32 " / numStores: %" PRIu32 "\n",
                                 store_ins->getInstructionAddress(), store_ins->getHWThread(),current_store->getSWThr(), store_ins->getNumStores());
+                        delete current_store;
                         stat_stores_executed->addData(1);
                     }
                     else
@@ -958,6 +1012,7 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                     load_ins->getInstructionAddress(), load_ins->getHWThread(), load_entry->countRequests());
 
                 loads_pending.push_back(load_entry);
+                loads_pending_count[load_ins->getHWThread()]++;
             }
         }
 
@@ -988,6 +1043,13 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
             VanadisStoreInstruction* store_ins = dynamic_cast<VanadisStoreInstruction*>(store_ins_temp);
             output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG,
                 "In sendstoreReq (ScalarLSQ) hw_thr:%d\n", store_ins->getHWThread());
+
+            if(UNLIKELY(store_ins->elidesMemoryAccess(registerFiles->at(store_ins->getHWThread())))) {
+                output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_STORE_FLG, "-> store ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " does not access memory\n",
+                    store_ins->getInstructionAddress(), store_ins->getHWThread());
+                store_ins->markExecuted();
+                return true;
+            }
             uint64_t store_address_last = 0;
             uint8_t trap_error = 0;
             VanadisBasicStorePendingEntry* new_pending_store= store_process(store_ins->getHWThread(),store_ins,&store_address_last, &trap_error);
@@ -1006,6 +1068,7 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                         new_pending_store->getStoreInstruction()->getInstructionAddress(), new_pending_store->getStoreInstruction()->getHWThread());
                 stores_pending[store_ins->getHWThread()].push_back(new_pending_store);
                 stores_pending_size++;
+                trackStoreLines(store_ins->getHWThread(), new_pending_store, true);
             }
             return true;
         }
@@ -1026,6 +1089,11 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                     output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "--> ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " has not completed issue, will not process this cycle.\n",
                         front_entry->getInstruction()->getInstructionAddress(), front_entry->getInstruction()->getHWThread());
                 }
+
+                // a ready load further back may be allowed to go ahead of it
+                if(store_set_entries > 0) {
+                    return issueSpeculatedLoad(thr);
+                }
                 return false;
             }
 
@@ -1089,6 +1157,11 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                             front_entry->getInstructionAddress(), front_entry->getHWThread());
                     }
 
+                    // the address is known now, check it against any younger load which went ahead
+                    if(UNLIKELY(! speculated_loads[thr].empty())) {
+                        checkOrderViolations(thr, front_entry->getSequence(), dynamic_cast<VanadisStoreInstruction*>(store_ins));
+                    }
+
                     sendStoreReq(store_ins);
                     // clear the front entry as we have just processed it
                     delete op_q[thr].front();
@@ -1168,6 +1241,15 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                     return true;
                 }
             }
+            else if(UNLIKELY(load_ins->elidesMemoryAccess(hw_thr_reg)))
+            {
+                output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "---> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " does not access memory\n",
+                    load_ins->getInstructionAddress(), load_ins->getHWThread());
+                load_ins->markExecuted();
+                load_addresses.clear();
+                load_widths.clear();
+                return true;
+            }
             else
             {
                 if(output->getVerboseLevel() >= 16)
@@ -1177,8 +1259,20 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
                 }
 
                 // check to see if loading from this address would conflict with a store which
-                // we have pending, if yes, wait for conflict to clear and then we can proceed
-                if(UNLIKELY(checkStoreConflict(load_ins->getHWThread(), load_address, load_width)))
+                // we have pending, if yes, take the data from the store when it covers the load,
+                // otherwise wait for conflict to clear and then we can proceed
+                VanadisBasicStorePendingEntry* conflict_store = checkStoreConflict(load_ins->getHWThread(), load_address, load_width);
+
+                if(UNLIKELY(nullptr != conflict_store) && store_forwarding &&
+                    forwardStoreToLoad(conflict_store, load_ins, load_address, load_width))
+                {
+                    output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "---> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " forwarded from store ins: 0x%" PRI_ADDR "\n",
+                        load_ins->getInstructionAddress(), load_ins->getHWThread(), conflict_store->getInstructionAddress());
+                    load_addresses.clear();
+                    load_widths.clear();
+                    return true;
+                }
+                else if(UNLIKELY(nullptr != conflict_store))
                 {
                     if(output->getVerboseLevel() >= 16)
                     {
@@ -1290,40 +1384,251 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
 
         bool pendingLoads(const uint32_t thr)
         {
-            bool matchID = false;
+            return loads_pending_count[thr] > 0;
+        }
 
-            for(auto load_itr = loads_pending.begin(); load_itr != loads_pending.end(); load_itr++) {
-                if((*load_itr)->getHWThread() == thr) {
-                    matchID = true;
-                    break;
+        // Counts the pending stores touching each cache line so a load which shares no
+        // line with the store buffer does not have to look through it
+        void trackStoreLines(const uint32_t thr, const VanadisBasicStorePendingEntry* store_entry, const bool add)
+        {
+            const uint64_t first_line = store_entry->getStoreAddress() / cache_line_width;
+            const uint64_t last_line  = (store_entry->getStoreAddress() + std::max(store_entry->getStoreWidth(), (uint64_t) 1) - 1) / cache_line_width;
+
+            for(uint64_t line = first_line; line <= last_line; ++line) {
+                if(add) {
+                    store_lines[thr][line]++;
+                } else {
+                    auto line_itr = store_lines[thr].find(line);
+
+                    if(line_itr != store_lines[thr].end() && (0 == --line_itr->second)) {
+                        store_lines[thr].erase(line_itr);
+                    }
                 }
             }
-
-            return matchID;
         }
 
-        bool checkStoreConflict(const uint32_t thread, const uint64_t address, const uint64_t width)
+        // Returns the youngest pending store which overlaps the load, nullptr if there are none
+        VanadisBasicStorePendingEntry* checkStoreConflict(const uint32_t thread, const uint64_t address, const uint64_t width)
         {
-            bool conflicts = false;
+            if(store_lines[thread].empty()) {
+                return nullptr;
+            }
+
+            const uint64_t first_line = address / cache_line_width;
+            const uint64_t last_line  = (address + std::max(width, (uint64_t) 1) - 1) / cache_line_width;
+            bool shares_line = false;
 
-            for(auto store_itr = stores_pending[thread].begin(); store_itr != stores_pending[thread].end(); store_itr++) {
+            for(uint64_t line = first_line; line <= last_line; ++line) {
+                if(store_lines[thread].count(line) > 0) {
+                    shares_line = true;
+                    break;
+                }
+            }
+
+            if(LIKELY(!shares_line)) {
+                return nullptr;
+            }
+
+            for(auto store_itr = stores_pending[thread].rbegin(); store_itr != stores_pending[thread].rend(); store_itr++) {
                 VanadisBasicStorePendingEntry* current_entry = (*store_itr);
 
                 if(UNLIKELY(current_entry->storeAddressOverlaps(address, width))) {
-                    conflicts = true;
-                    break;
+                    return current_entry;
                 }
             }
 
-            return conflicts;
+            return nullptr;
         }
 
+        // Writes the bytes of a store which completely covers the load straight into the load's
+        // register. Returns false when the store cannot supply the data and the load must wait
+        bool forwardStoreToLoad(VanadisBasicStorePendingEntry* store_entry, VanadisLoadInstruction* load_ins,
+            const uint64_t load_address, const uint16_t load_width)
+        {
+            VanadisStoreInstruction* store_ins = store_entry->getStoreInstruction();
+            const uint64_t store_address = store_entry->getStoreAddress();
+
+            if((load_ins->getTransactionType() != MEM_TRANSACTION_NONE) || (store_ins->getTransactionType() != MEM_TRANSACTION_NONE) ||
+                load_ins->isPartialLoad() || store_ins->isPartialStore() ||
+                (load_address < store_address) || ((load_address + load_width) > (store_address + store_entry->getStoreWidth()))) {
+                return false;
+            }
+
+            uint16_t target_thread;
+            uint16_t target_reg;
+            std::vector<uint8_t> payload(load_width);
+
+            getStoreTarget(store_entry, store_ins, &target_thread, &target_reg);
+            registerFiles->at(target_thread)->copyFromRegister(target_reg, store_ins->getRegisterOffset() + (load_address - store_address),
+                &payload[0], load_width, store_ins->getValueRegisterType() == STORE_FP_REGISTER);
+
+            VanadisBasicLoadPendingEntry load_entry(load_ins, load_address, load_width);
+            std_mem_handlers->writeLoadData(load_ins, &load_entry, 0, &payload[0], load_width, true);
+
+            load_ins->markExecuted();
+            stat_loads_executed->addData(1);
+            stat_loads_forwarded->addData(1);
+            return true;
+        }
+
+        uint32_t storeSetIndex(const uint64_t ins_addr) const
+        {
+            return ((ins_addr >> 1) ^ (ins_addr >> 11)) % store_set_entries;
+        }
+
+        // Looks past a front entry which is not ready for a load the store sets predict
+        // does not depend on any of the stores ahead of it. Loads stay ordered behind fences
+        // and atomics
+        bool issueSpeculatedLoad(const uint32_t thr)
+        {
+            bool older_store = false;
+            blocking_sets.clear();
+
+            for(auto op_itr = op_q[thr].begin(); op_itr != op_q[thr].end(); op_itr++) {
+                VanadisBasicLoadStoreEntry* entry = (*op_itr);
+
+                switch(entry->getEntryOp()) {
+                case VanadisBasicLoadStoreEntryOp::FENCE:
+                    return false;
+                case VanadisBasicLoadStoreEntryOp::STORE:
+                {
+                    VanadisStoreInstruction* store_ins = static_cast<VanadisBasicStoreEntry*>(entry)->getStoreInstruction();
+
+                    if(store_ins->getTransactionType() != MEM_TRANSACTION_NONE) {
+                        return false;
+                    }
+
+                    const uint32_t store_set = store_sets[storeSetIndex(store_ins->getInstructionAddress())];
+                    if(store_set != 0) {
+                        blocking_sets.push_back(store_set);
+                    }
+                    older_store = true;
+                } break;
+                case VanadisBasicLoadStoreEntryOp::LOAD:
+                {
+                    VanadisLoadInstruction* load_ins = static_cast<VanadisBasicLoadEntry*>(entry)->getLoadInstruction();
+
+                    if(load_ins->getTransactionType() != MEM_TRANSACTION_NONE) {
+                        return false;
+                    }
+
+                    if(! load_ins->completedIssue() || load_ins->isPartialLoad()) {
+                        break;
+                    }
+
+                    const uint32_t load_set = store_sets[storeSetIndex(load_ins->getInstructionAddress())];
+                    if((load_set != 0) && (std::find(blocking_sets.begin(), blocking_sets.end(), load_set) != blocking_sets.end())) {
+                        break;
+                    }
+
+                    if(loads_pending.size() >= max_loads) {
+                        return false;
+                    }
+
+                    uint64_t load_address = 0;
+                    uint16_t load_width = 0;
+                    load_ins->computeLoadAddress(registerFiles->at(thr), &load_address, &load_width);
+
+                    if(! sendLoadReq(load_ins)) {
+                        break;
+                    }
+
+                    output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "-> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " issued ahead of older operations (older store: %s)\n",
+                        load_ins->getInstructionAddress(), thr, older_store ? "yes" : "no");
+
+                    if(older_store) {
+                        speculated_loads[thr].push_back(VanadisSpeculatedLoad{entry->getSequence(), load_address, load_width, load_ins});
+                        stat_loads_speculated->addData(1);
+                    }
+
+                    delete entry;
+                    op_q[thr].erase(op_itr);
+                    op_q_size--;
+                    return true;
+                } break;
+                }
+            }
+
+            return false;
+        }
+
+        // A store at sequence store_seq has just resolved its address. Any load after it which
+        // already read an overlapping address has the wrong data and is flagged for replay, and
+        // the load and store are put in the same store set so the load waits next time
+        void checkOrderViolations(const uint32_t thr, const uint64_t store_seq, VanadisStoreInstruction* store_ins)
+        {
+            uint64_t store_address = 0;
+            uint16_t store_width = 0;
+            store_ins->computeStoreAddress(output, registerFiles->at(thr), &store_address, &store_width);
+
+            for(auto load_itr = speculated_loads[thr].begin(); load_itr != speculated_loads[thr].end(); ) {
+                // every store older than this load has now resolved
+                if(load_itr->sequence < store_seq) {
+                    load_itr = speculated_loads[thr].erase(load_itr);
+                    continue;
+                }
+
+                if(LIKELY(! store_ins->trapsError()) && LIKELY(! store_ins->elidesMemoryAccess(registerFiles->at(thr))) &&
+                    (load_itr->address < (store_address + store_width)) &&
+                    (store_address < (load_itr->address + load_itr->width))) {
+                    output->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "-> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " read 0x%" PRI_ADDR " before store ins: 0x%" PRI_ADDR " wrote it, replay\n",
+                        load_itr->load_ins->getInstructionAddress(), thr, load_itr->address, store_ins->getInstructionAddress());
+
+                    load_itr->load_ins->flagMemoryOrderViolation();
+                    trainStoreSets(load_itr->load_ins->getInstructionAddress(), store_ins->getInstructionAddress());
+                    stat_order_violations->addData(1);
+
+                    load_itr = speculated_loads[thr].erase(load_itr);
+                    continue;
+                }
+
+                load_itr++;
+            }
+        }
+
+        void trainStoreSets(const uint64_t load_addr, const uint64_t store_addr)
+        {
+            const uint32_t load_index = storeSetIndex(load_addr);
+            uint32_t& load_set  = store_sets[load_index];
+            uint32_t& store_set = store_sets[storeSetIndex(store_addr)];
+
+            if((0 == load_set) && (0 == store_set)) {
+                load_set  = load_index + 1;
+                store_set = load_set;
+            } else if(0 == load_set) {
+                load_set = store_set;
+            } else if(0 == store_set) {
+                store_set = load_set;
+            } else {
+                // merge, both keep the smaller set
+                load_set  = std::min(load_set, store_set);
+                store_set = load_set;
+            }
+        }
 
         // Per-hardware-thread queues
         std::vector< std::deque<VanadisBasicLoadStoreEntry*> > op_q;
         std::vector< std::deque<VanadisBasicStorePendingEntry*> > stores_pending;
         std::deque<VanadisBasicLoadPendingEntry*> loads_pending;
         std::set<StandardMem::Request::id_t> std_stores_in_flight;
+        std::vector<uint32_t> loads_pending_count; // loads_pending entries for each hw thread
+
+        // Per hw thread: number of stores_pending entries touching each cache line
+        std::vector< std::unordered_map<uint64_t, uint32_t> > store_lines;
+        std::vector<uint64_t> op_q_seq; // Next sequence number handed to an op_q entry
+
+        // Loads issued while an older store in op_q had no address yet
+        struct VanadisSpeculatedLoad {
+            uint64_t sequence;
+            uint64_t address;
+            uint16_t width;
+            VanadisLoadInstruction* load_ins;
+        };
+        std::vector< std::vector<VanadisSpeculatedLoad> > speculated_loads;
+
+        // Store set identifier table indexed by instruction address, 0 means no set
+        std::vector<uint32_t> store_sets;
+        std::vector<uint32_t> blocking_sets;
         int op_q_index; // Next hw_thread to check in op_q queues
         int stores_pending_index; // Next hw thread to check in stores_pending q's
         size_t op_q_size;
@@ -1337,6 +1642,10 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
 
         const uint32_t max_issue_attempts_per_cycle;
 
+        const bool store_forwarding;
+        const uint32_t store_set_entries;
+        const uint64_t store_set_clear_interval;
+
         uint64_t cache_line_width;
         uint64_t address_mask;
 
@@ -1354,6 +1663,9 @@ class VanadisBasicLoadStoreQueue : public SST::Vanadis::VanadisLoadStoreQueue
         Statistic<uint64_t>* stat_split_loads;
         Statistic<uint64_t>* stat_stored_bytes;
         Statistic<uint64_t>* stat_loaded_bytes;
+        Statistic<uint64_t>* stat_loads_forwarded;
+        Statistic<uint64_t>* stat_loads_speculated;
+        Statistic<uint64_t>* stat_order_violations;
 };
 
 } // namespace SST
@@ -36,7 +36,7 @@ enum class VanadisBasicLoadStoreEntryOp {
 
 class VanadisBasicLoadStoreEntry {
 public:
-    VanadisBasicLoadStoreEntry(VanadisInstruction* the_ins) : ins(the_ins) {sw_thr=65536;}
+    VanadisBasicLoadStoreEntry(VanadisInstruction* the_ins) : ins(the_ins), seq(0) {sw_thr=65536;}
     virtual ~VanadisBasicLoadStoreEntry() {}
     virtual VanadisBasicLoadStoreEntryOp getEntryOp() = 0;
     virtual VanadisInstruction* getInstruction() { return ins; }
@@ -47,6 +47,10 @@ public:
     uint32_t getHWThread() const { return ins->getHWThread(); }
     uint64_t getInstructionAddress() const { return ins->getInstructionAddress(); }
 
+    // Program order of the operation within its hardware thread
+    uint64_t getSequence() const { return seq; }
+    void setSequence(uint64_t s) { seq = s; }
+
     uint32_t getSWThr() { return sw_thr; }
     void setSWThr(uint32_t thr) { sw_thr = thr; }
     void addThr(uint16_t thr) {sw_thrs.push_back(thr);}
@@ -65,6 +69,7 @@ public:
 
 protected:
     VanadisInstruction* ins;
+    uint64_t seq;
     uint32_t sw_thr;
     std::vector<uint16_t> sw_thrs;
 
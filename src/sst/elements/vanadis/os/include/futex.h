@@ -17,8 +17,8 @@
 #define _H_VANADIS_NODE_OS_INCLUDE_FUTEX
 
 #include <string>
-
-#include <map>
+#include <deque>
+#include <vector>
 namespace SST {
 namespace Vanadis {
 
@@ -33,54 +33,95 @@ class VanadisSyscall;
 
 namespace OS {
 
+// Waiters are hashed by address into a fixed number of buckets. Each bucket
+// keeps its waiters in arrival order so wakeups on an address stay FIFO.
 class Futex {
 public:
-    void addWait( uint64_t addr, VanadisSyscall* syscall ) {
-        OSFutexDbg("Futex::%s() addr=%#" PRIx64 " syscall=%p\n", addr,syscall );
+    Futex() : m_buckets( 1 << BucketShift ), m_numWaiters(0) {}
+
+    void addWait( uint64_t addr, VanadisSyscall* syscall, uint32_t bitset = 0xffffffff ) {
+        OSFutexDbg("Futex::%s() addr=%#" PRIx64 " syscall=%p bitset=%#x\n", addr,syscall,bitset );
 
-        auto& tmp = m_futexMap[addr];
+        auto& bucket = getBucket( addr );
 
-        for ( auto iter = tmp.begin(); iter != tmp.end(); ++iter ) {
-            assert( *iter != syscall );
+        for ( auto iter = bucket.begin(); iter != bucket.end(); ++iter ) {
+            assert( iter->syscall != syscall );
         }
 
-        tmp.push_back( syscall );
-        OSFutexDbg("Futex::%s() %p %zu\n",this,tmp.size());
+        bucket.push_back( Waiter( addr, bitset, syscall ) );
+        ++m_numWaiters;
+        OSFutexDbg("Futex::%s() %p %zu\n",this,bucket.size());
     }
 
     size_t getNumWaiters( uint64_t addr ) {
         OSFutexDbg("Futex::%s() addr=%#" PRIx64 "\n", addr );
-        if ( m_futexMap.find( addr ) == m_futexMap.end() ) {
-            return 0;
+        size_t count = 0;
+        for ( auto& waiter : getBucket( addr ) ) {
+            if ( waiter.addr == addr ) {
+                ++count;
+            }
         }
-        auto& tmp = m_futexMap[addr];
-        OSFutexDbg("Futex::%s() %p %zu\n",this,tmp.size());
-        return tmp.size();
+        return count;
     }
-    VanadisSyscall* findWait( uint64_t addr ) {
-        OSFutexDbg("Futex::%s() addr=%#" PRIx64 "\n", addr );
-        if (  m_futexMap.find( addr ) == m_futexMap.end() ) {
-            return nullptr;
-        }
-
-        auto& tmp = m_futexMap[addr];
-
-        OSFutexDbg("Futex::%s() %p %zu\n",this,tmp.size());
-        assert( ! tmp.empty() );
 
-        auto syscall = tmp.front();
+    // remove and return the oldest waiter on addr whose bitset intersects bitset
+    VanadisSyscall* findWait( uint64_t addr, uint32_t bitset = 0xffffffff ) {
+        OSFutexDbg("Futex::%s() addr=%#" PRIx64 " bitset=%#x\n", addr, bitset );
+
+        auto& bucket = getBucket( addr );
+        for ( auto iter = bucket.begin(); iter != bucket.end(); ++iter ) {
+            if ( iter->addr == addr && ( iter->bitset & bitset ) ) {
+                auto syscall = iter->syscall;
+                bucket.erase( iter );
+                --m_numWaiters;
+                OSFutexDbg("Futex::%s() found addr=%#" PRIx64 " syscall=%p\n", addr,syscall );
+                return syscall;
+            }
+        }
+        return nullptr;
+    }
 
-        tmp.pop_front( );
-        if ( tmp.empty() ) {
-            m_futexMap.erase( addr );
+    // move at most num of the oldest waiters on addr to addr2, returns the number moved
+    int requeue( uint64_t addr, uint64_t addr2, int num ) {
+        OSFutexDbg("Futex::%s() addr=%#" PRIx64 " addr2=%#" PRIx64 " num=%d\n", addr, addr2, num );
+        int moved = 0;
+        auto& bucket = getBucket( addr );
+        auto& bucket2 = getBucket( addr2 );
+        auto iter = bucket.begin();
+        while ( moved < num && iter != bucket.end() ) {
+            if ( iter->addr == addr ) {
+                Waiter waiter = *iter;
+                waiter.addr = addr2;
+                iter = bucket.erase( iter );
+                bucket2.push_back( waiter );
+                ++moved;
+            } else {
+                ++iter;
+            }
         }
-        OSFutexDbg("Futex::%s() found addr=%#" PRIx64 " syscall=%p\n", addr,syscall );
-        return syscall;
+        return moved;
     }
-    bool isEmpty() { return m_futexMap.empty(); }
+
+    bool isEmpty() { return 0 == m_numWaiters; }
 
 private:
-    std::map< uint64_t, std::deque<VanadisSyscall* > > m_futexMap;
+    static const int BucketShift = 8;
+
+    struct Waiter {
+        Waiter( uint64_t addr, uint32_t bitset, VanadisSyscall* syscall ) : addr(addr), bitset(bitset), syscall(syscall) {}
+        uint64_t addr;
+        uint32_t bitset;
+        VanadisSyscall* syscall;
+    };
+
+    std::deque<Waiter>& getBucket( uint64_t addr ) {
+        // futex words are 4 byte aligned, fibonacci hash the word address
+        uint64_t hash = ( addr >> 2 ) * 0x9e3779b97f4a7c15ULL;
+        return m_buckets[ hash >> ( 64 - BucketShift ) ];
+    }
+
+    std::vector< std::deque<Waiter> > m_buckets;
+    size_t m_numWaiters;
 };
 
 }
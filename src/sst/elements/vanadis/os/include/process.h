@@ -329,14 +329,19 @@ class ProcessInfo {
     }
 
 
-    void addFutexWait( uint64_t addr, VanadisSyscall* syscall ) {
-        m_dbg.verbose(CALL_INFO,1,0,"addr=%#" PRIx64 "\n",addr);
-        m_futex->addWait( addr, syscall );
+    void addFutexWait( uint64_t addr, VanadisSyscall* syscall, uint32_t bitset = 0xffffffff ) {
+        m_dbg.verbose(CALL_INFO,1,0,"addr=%#" PRIx64 " bitset=%#x\n",addr,bitset);
+        m_futex->addWait( addr, syscall, bitset );
     }
 
-    VanadisSyscall* findFutex( uint64_t addr ) {
-        m_dbg.verbose(CALL_INFO,1,0,"addr=%#" PRIx64 "\n",addr);
-        return m_futex->findWait( addr );
+    VanadisSyscall* findFutex( uint64_t addr, uint32_t bitset = 0xffffffff ) {
+        m_dbg.verbose(CALL_INFO,1,0,"addr=%#" PRIx64 " bitset=%#x\n",addr,bitset);
+        return m_futex->findWait( addr, bitset );
+    }
+
+    int futexRequeue( uint64_t addr, uint64_t addr2, int num ) {
+        m_dbg.verbose(CALL_INFO,1,0,"addr=%#" PRIx64 " addr2=%#" PRIx64 " num=%d\n",addr,addr2,num);
+        return m_futex->requeue( addr, addr2, num );
     }
 
     int futexGetNumWaiters( uint64_t addr ) {
@@ -34,6 +34,20 @@
 #define FUTEX_WAIT_REQUEUE_PI   11
 #define FUTEX_CMP_REQUEUE_PI    12
 
+#define FUTEX_OP_SET        0
+#define FUTEX_OP_ADD        1
+#define FUTEX_OP_OR         2
+#define FUTEX_OP_ANDN       3
+#define FUTEX_OP_XOR        4
+#define FUTEX_OP_OPARG_SHIFT    8
+
+#define FUTEX_OP_CMP_EQ     0
+#define FUTEX_OP_CMP_NE     1
+#define FUTEX_OP_CMP_LT     2
+#define FUTEX_OP_CMP_LE     3
+#define FUTEX_OP_CMP_GT     4
+#define FUTEX_OP_CMP_GE     5
+
 #define FUTEX_PRIVATE_FLAG  128
 #define FUTEX_CLOCK_REALTIME    256
 #define FUTEX_CMD_MASK      ~(FUTEX_PRIVATE_FLAG | FUTEX_CLOCK_REALTIME)
@@ -56,7 +70,8 @@
 using namespace SST::Vanadis;
 
 VanadisFutexSyscall::VanadisFutexSyscall( VanadisNodeOSComponent* os, SST::Link* coreLink, OS::ProcessInfo* process, VanadisSyscallFutexEvent* event )
-        : VanadisSyscall( os, coreLink, process, event, "futex" ), m_state(ReadAddr), m_numWokeup(0), m_waitStoreConditional(false)
+        : VanadisSyscall( os, coreLink, process, event, "futex" ), m_state(ReadAddr), m_numWokeup(0), m_waitStoreConditional(false),
+          m_bitset(0xffffffff), m_val2(0), m_addr2(0), m_val3(0), m_oldVal(0)
 {
     m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL,
             "[syscall-futex] addr=%#" PRIx64 " op=%#x val=%#" PRIx32 " timeAddr=%#" PRIx64 " callStackAddr=%#" PRIx64
@@ -82,14 +97,9 @@ VanadisFutexSyscall::VanadisFutexSyscall( VanadisNodeOSComponent* os, SST::Link*
             futexWake(event);
         } break;
 
-      case FUTEX_WAIT_BITSET:
-        assert( event->getVal3() == 0xffffffff );
       case FUTEX_WAIT:
         {
-            m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL,
-                "[syscall-futex] FUTEX_WAIT tid=%d addr=%#" PRIx64 " do LoadLink\n", process->gettid(), event->getAddr());
-            m_buffer.resize(sizeof(uint32_t));
-            readMemory( event->getAddr(), m_buffer, true );
+            startWait();
         } break;
       case FUTEX_REQUEUE:
         {
@@ -99,11 +109,26 @@ VanadisFutexSyscall::VanadisFutexSyscall( VanadisNodeOSComponent* os, SST::Link*
             readMemory( event->getAddr(), m_buffer );
         } break;
 
+      case FUTEX_WAIT_BITSET:
+      case FUTEX_WAKE_BITSET:
       case FUTEX_CMP_REQUEUE:
-        assert(0);
-      case FUTEX_FD:
-        assert(0);
       case FUTEX_WAKE_OP:
+        {
+            // val2 is passed in the timeout argument
+            m_val2 = event->getTimeAddr();
+            if ( event->getStackPtr() ) {
+                // uaddr2 and val3 are the 5th and 6th arguments, on the stack after the 16 byte argument save area
+                m_buffer.resize(sizeof(uint32_t)*2);
+                readMemory( event->getStackPtr() + 16, m_buffer );
+                m_state = ReadArgs;
+            } else {
+                m_addr2 = event->getAddr2();
+                m_val3 = event->getVal3();
+                startOp();
+            }
+        } break;
+
+      case FUTEX_FD:
         assert(0);
       case FUTEX_LOCK_PI:
         assert(0);
@@ -111,8 +136,6 @@ VanadisFutexSyscall::VanadisFutexSyscall( VanadisNodeOSComponent* os, SST::Link*
         assert(0);
       case FUTEX_TRYLOCK_PI:
         assert(0);
-      case FUTEX_WAKE_BITSET:
-        assert(0);
       case FUTEX_WAIT_REQUEUE_PI:
         assert(0);
       case FUTEX_CMP_REQUEUE_PI:
@@ -121,54 +144,124 @@ VanadisFutexSyscall::VanadisFutexSyscall( VanadisNodeOSComponent* os, SST::Link*
     }
 }
 
-void VanadisFutexSyscall::wakeWaiter(VanadisSyscallFutexEvent* event) const
+// the ops that take uaddr2 or val3 start once the arguments are known
+void VanadisFutexSyscall::startOp()
 {
-    auto syscall = m_process->findFutex(event->getAddr());
-    if( !syscall )
-    {
-        m_output->fatal(CALL_INFO, 1, "syscall should not be null here. "
-                        "wakeWaiter() should not be called when no threads are waiting.\n");
+    auto event = getEvent<VanadisSyscallFutexEvent*>();
+
+    m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL,
+            "[syscall-futex] op=%d tid=%d addr=%#" PRIx64 " val2=%#" PRIx32 " addr2=%#" PRIx64 " val3=%#" PRIx32 "\n",
+            m_op, m_process->gettid(), event->getAddr(), m_val2, m_addr2, m_val3 );
+
+    switch ( m_op ) {
+      case FUTEX_WAIT_BITSET:
+        {
+            if ( 0 == m_val3 ) {
+                setReturnFail(-LINUX_EINVAL);
+                return;
+            }
+            m_bitset = m_val3;
+            startWait();
+        } break;
+
+      case FUTEX_WAKE_BITSET:
+        {
+            if ( 0 == m_val3 ) {
+                setReturnFail(-LINUX_EINVAL);
+                return;
+            }
+            setReturnSuccess( wakeWaiters( event->getAddr(), event->getVal(), m_val3 ) );
+        } break;
+
+      case FUTEX_CMP_REQUEUE:
+        {
+            m_state = ReadAddr;
+            m_buffer.resize(sizeof(uint32_t));
+            readMemory( event->getAddr(), m_buffer );
+        } break;
+
+      case FUTEX_WAKE_OP:
+        {
+            // the operation on uaddr2 is atomic, LoadLink it
+            m_state = ReadOldVal;
+            m_buffer.resize(sizeof(uint32_t));
+            readMemory( m_addr2, m_buffer, true );
+        } break;
+
+      default:
+        assert(0);
     }
+}
+
+void VanadisFutexSyscall::startWait()
+{
     m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL,
-                      "[syscall-futex] FUTEX_WAKE tid=%d addr=%#" PRIx64 " found waiter, wakeup tid=%d\n",
-                      m_process->gettid(), event->getAddr(),syscall->getTid());
-    dynamic_cast<VanadisFutexSyscall*>( syscall )->wakeup();
-    delete syscall;
+        "[syscall-futex] FUTEX_WAIT tid=%d addr=%#" PRIx64 " bitset=%#" PRIx32 " do LoadLink\n",
+        m_process->gettid(), getEvent<VanadisSyscallFutexEvent*>()->getAddr(), m_bitset);
+    m_buffer.resize(sizeof(uint32_t));
+    readMemory( getEvent<VanadisSyscallFutexEvent*>()->getAddr(), m_buffer, true );
 }
 
-int VanadisFutexSyscall::getNumWaitersToWake(VanadisSyscallFutexEvent* event) const
+int VanadisFutexSyscall::wakeWaiters( uint64_t addr, uint32_t num, uint32_t bitset ) const
 {
-    uint32_t numWaiters = m_process->futexGetNumWaiters(event->getAddr());
-    uint32_t numWaitersToWake = std::min(numWaiters, event->getVal());
-    if( numWaiters == 0 )
-    {
-        m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL,
-                          "[syscall-futex] FUTEX_WAKE tid=%d addr=%#" PRIx64 " no waiter\n", m_process->gettid(), event->getAddr());
-    }
-    else
-    {
+    uint32_t numWoken = 0;
+    while ( numWoken < num ) {
+        auto syscall = m_process->findFutex( addr, bitset );
+        if ( nullptr == syscall ) {
+            break;
+        }
         m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL,
-                          "[syscall-futex] FUTEX_WAKE tid=%d addr=%#" PRIx64 " %u waiters, "
-                          " val is %u, will wake %u threads \n",
-                          m_process->gettid(), event->getAddr(), numWaiters, event->getVal(), numWaitersToWake);
-
+                          "[syscall-futex] FUTEX_WAKE tid=%d addr=%#" PRIx64 " found waiter, wakeup tid=%d\n",
+                          m_process->gettid(), addr, syscall->getTid());
+        dynamic_cast<VanadisFutexSyscall*>( syscall )->wakeup();
+        delete syscall;
+        ++numWoken;
     }
-    return numWaitersToWake;
+    m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL,
+                      "[syscall-futex] FUTEX_WAKE tid=%d addr=%#" PRIx64 " val is %u, woke %u threads\n",
+                      m_process->gettid(), addr, num, numWoken);
+    return numWoken;
 }
 
-int VanadisFutexSyscall::wakeWaiters(VanadisSyscallFutexEvent* event) const
+// FUTEX_WAKE_OP encodes the operation, its argument and the comparison in val3
+bool VanadisFutexSyscall::wakeOpCompare( uint32_t oldVal, uint32_t* newVal ) const
 {
-    auto numWaiters = getNumWaitersToWake(event);
-    for(int curWaiter=0;curWaiter<numWaiters;curWaiter++)
-    {
-        wakeWaiter(event);
+    int op = ( m_val3 >> 28 ) & 0x7;
+    int cmp = ( m_val3 >> 24 ) & 0xf;
+    // oparg and cmparg are sign extended 12 bit fields
+    int32_t oparg = (int32_t)( m_val3 << 8 ) >> 20;
+    int32_t cmparg = (int32_t)( m_val3 << 20 ) >> 20;
+    if ( m_val3 & ( FUTEX_OP_OPARG_SHIFT << 28 ) ) {
+        oparg = 1 << ( oparg & 31 );
+    }
+
+    switch ( op ) {
+      case FUTEX_OP_SET:  *newVal = oparg; break;
+      case FUTEX_OP_ADD:  *newVal = oldVal + oparg; break;
+      case FUTEX_OP_OR:   *newVal = oldVal | oparg; break;
+      case FUTEX_OP_ANDN: *newVal = oldVal & ~oparg; break;
+      case FUTEX_OP_XOR:  *newVal = oldVal ^ oparg; break;
+      default:
+        m_output->fatal(CALL_INFO, -1, "Error: futex, FUTEX_WAKE_OP op %d not supported\n",op);
     }
-    return numWaiters;
+
+    int32_t val = oldVal;
+    switch ( cmp ) {
+      case FUTEX_OP_CMP_EQ: return val == cmparg;
+      case FUTEX_OP_CMP_NE: return val != cmparg;
+      case FUTEX_OP_CMP_LT: return val < cmparg;
+      case FUTEX_OP_CMP_LE: return val <= cmparg;
+      case FUTEX_OP_CMP_GT: return val > cmparg;
+      case FUTEX_OP_CMP_GE: return val >= cmparg;
+      default:
+        m_output->fatal(CALL_INFO, -1, "Error: futex, FUTEX_WAKE_OP cmp %d not supported\n",cmp);
+    }
+    return false;
 }
 
 void VanadisFutexSyscall::futexWake(VanadisSyscallFutexEvent* event)
 {
-    setReturnSuccess(wakeWaiters(event));
+    setReturnSuccess( wakeWaiters( event->getAddr(), event->getVal(), 0xffffffff ) );
 }
 
 void VanadisFutexSyscall::wakeup()
@@ -180,6 +273,13 @@ void VanadisFutexSyscall::wakeup()
 void VanadisFutexSyscall::memReqIsDone(bool failed )
 {
     m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL, "[syscall-futex] memReqIsDone failed=%d \n",failed);
+    if ( ReadArgs == m_state && FUTEX_REQUEUE != m_op ) {
+        m_addr2 = ((uint32_t*)m_buffer.data())[0];
+        m_val3 = ((uint32_t*)m_buffer.data())[1];
+        startOp();
+        return;
+    }
+
     switch( m_op ) {
       case FUTEX_WAIT:
       case FUTEX_WAIT_BITSET:
@@ -216,7 +316,7 @@ void VanadisFutexSyscall::memReqIsDone(bool failed )
                     m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL,
                         "[syscall-futex] FUTEX_WAIT tid=%d addr=%#" PRIx64 " vals match go to sleep\n",
                         m_process->gettid(), getEvent<VanadisSyscallFutexEvent*>()->getAddr());
-                    m_process->addFutexWait( getEvent<VanadisSyscallFutexEvent*>()->getAddr(), this );
+                    m_process->addFutexWait( getEvent<VanadisSyscallFutexEvent*>()->getAddr(), this, m_bitset );
                 }
             }
         } break;
@@ -230,17 +330,7 @@ void VanadisFutexSyscall::memReqIsDone(bool failed )
                 m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL, "[syscall-futex] FUTEX_REQUEUE numWaiters %d\n",numWaiters);
 
                 // wakeup at most val number of waiters
-                for ( int i = 0; i < val && i < numWaiters; i++ ) {
-                    printf("findFutex called from VanadisFutexSyscall::memReqIsDone FUTEX_REQUEUE\n");
-                    VanadisSyscall* syscall = m_process->findFutex( getEvent<VanadisSyscallFutexEvent*>()->getAddr() );
-                    if ( syscall ) {
-                        ++m_numWokeup;
-                        m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL, "[syscall-futex] FUTEX_REQUEUE tid=%d addr=%#" PRIx64 " wakeup tid=%d\n",
-                                    m_process->gettid(), getEvent<VanadisSyscallFutexEvent*>()->getAddr(), syscall->getTid());
-                        dynamic_cast<VanadisFutexSyscall*>( syscall )->wakeup();
-                        delete syscall;
-                    }
-                }
+                m_numWokeup = wakeWaiters( getEvent<VanadisSyscallFutexEvent*>()->getAddr(), val, 0xffffffff );
                 m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL, "[syscall-futex] FUTEX_REQUEUE numWokeup %d\n",m_numWokeup);
 
                 // if there are no more waiters, we are done
@@ -266,6 +356,51 @@ void VanadisFutexSyscall::memReqIsDone(bool failed )
                 assert(0);
             }
         } break;
+
+      case FUTEX_CMP_REQUEUE:
+        {
+            uint32_t val = *(uint32_t*)m_buffer.data();
+            auto addr = getEvent<VanadisSyscallFutexEvent*>()->getAddr();
+            if ( val != m_val3 ) {
+                m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL,
+                    "[syscall-futex] FUTEX_CMP_REQUEUE tid=%d addr=%#" PRIx64 " %u != %u, vals dont match return\n",
+                    m_process->gettid(), addr, val, m_val3);
+                setReturnFail(-LINUX_EAGAIN);
+                return;
+            }
+            int numWoken = wakeWaiters( addr, getEvent<VanadisSyscallFutexEvent*>()->getVal(), 0xffffffff );
+            int numMoved = m_process->futexRequeue( addr, m_addr2, m_val2 );
+            m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL,
+                "[syscall-futex] FUTEX_CMP_REQUEUE tid=%d addr=%#" PRIx64 " woke %d moved %d to %#" PRIx64 "\n",
+                m_process->gettid(), addr, numWoken, numMoved, m_addr2);
+            setReturnSuccess( numWoken + numMoved );
+        } break;
+
+      case FUTEX_WAKE_OP:
+        {
+            if ( ReadOldVal == m_state ) {
+                assert(!failed);
+                uint32_t newVal;
+                m_oldVal = *(uint32_t*)m_buffer.data();
+                wakeOpCompare( m_oldVal, &newVal );
+                *(uint32_t*)m_buffer.data() = newVal;
+                writeMemory( m_addr2, m_buffer, true );
+                m_state = WriteNewVal;
+            } else if ( failed ) {
+                // another store got to uaddr2 first, start over
+                m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL,
+                    "[syscall-futex] FUTEX_WAKE_OP tid=%d addr2=%#" PRIx64 " StoreConditional failed, retry\n", m_process->gettid(), m_addr2);
+                m_state = ReadOldVal;
+                readMemory( m_addr2, m_buffer, true );
+            } else {
+                uint32_t newVal;
+                int numWoken = wakeWaiters( getEvent<VanadisSyscallFutexEvent*>()->getAddr(), getEvent<VanadisSyscallFutexEvent*>()->getVal(), 0xffffffff );
+                if ( wakeOpCompare( m_oldVal, &newVal ) ) {
+                    numWoken += wakeWaiters( m_addr2, m_val2, 0xffffffff );
+                }
+                setReturnSuccess( numWoken );
+            }
+        } break;
     }
 }
 
@@ -273,16 +408,9 @@ void VanadisFutexSyscall::finish( uint32_t val2, uint64_t addr2 )
 {
     m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL, "[syscall-futex] FUTEX_REQUEUE read val2=%d addr2=%#" PRIx64 "\n",val2,addr2);
 
-    int numWaiters = m_process->futexGetNumWaiters( getEvent<VanadisSyscallFutexEvent*>()->getAddr() );
-    m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL, "[syscall-futex] FUTEX_REQUEUE numWaiters %d\n",numWaiters);
-
-    for ( int i = 0; i < val2 && i < numWaiters; i++ ) {
-        VanadisSyscall* syscall = m_process->findFutex( getEvent<VanadisSyscallFutexEvent*>()->getAddr() );
-        if ( syscall ) {
-            m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL,"[syscall-futex] FUTEX_REQUEUE tid=%d addr=%#" PRIx64 " move to %#" PRIx64 "\n",m_process->gettid(),
-                getEvent<VanadisSyscallFutexEvent*>()->getAddr(),addr2); m_process->addFutexWait( addr2, syscall );
-        }
-    }
+    int numMoved = m_process->futexRequeue( getEvent<VanadisSyscallFutexEvent*>()->getAddr(), addr2, val2 );
+    m_output->verbose(CALL_INFO, 16, VANADIS_OS_DBG_SYSCALL,"[syscall-futex] FUTEX_REQUEUE tid=%d addr=%#" PRIx64 " moved %d to %#" PRIx64 "\n",m_process->gettid(),
+        getEvent<VanadisSyscallFutexEvent*>()->getAddr(),numMoved,addr2);
 
     setReturnSuccess( m_numWokeup );
 }
@@ -30,20 +30,26 @@ public:
     void wakeup();
  private:
 
-    enum State { ReadAddr, ReadArgs } m_state;
+    enum State { ReadAddr, ReadArgs, ReadOldVal, WriteNewVal } m_state;
     void memReqIsDone(bool);
     void finish( uint32_t val2, uint64_t addr2 );
+    void startOp();
+    void startWait();
 
     uint32_t m_val;
     bool m_waitStoreConditional;
     int m_op;
     std::vector<uint8_t> m_buffer;
     int m_numWokeup;
+    uint32_t m_bitset;
+    uint32_t m_val2;
+    uint64_t m_addr2;
+    uint32_t m_val3;
+    uint32_t m_oldVal;
 
     void futexWake(VanadisSyscallFutexEvent* event);
-    int wakeWaiters(VanadisSyscallFutexEvent* event) const;
-    void wakeWaiter(VanadisSyscallFutexEvent* event) const;
-    int getNumWaitersToWake(VanadisSyscallFutexEvent* event) const;
+    int wakeWaiters( uint64_t addr, uint32_t num, uint32_t bitset ) const;
+    bool wakeOpCompare( uint32_t oldVal, uint32_t* newVal ) const;
 };
 
 } // namespace Vanadis
@@ -113,6 +113,16 @@ VanadisNodeOSComponent::VanadisNodeOSComponent(SST::ComponentId_t id, SST::Param
         // we don't use it
     }
 
+    m_preloadElf = params.find<bool>("preload_elf", false);
+    m_lazyZeroPages = params.find<bool>("lazy_zero_pages", false);
+    if ( m_preloadElf && nullptr == m_mmu ) {
+        output->fatal(CALL_INFO, -1, "Error: preload_elf requires useMMU\n");
+    }
+    m_transparentHugePages = params.find<bool>("transparent_huge_pages", false);
+    if ( m_transparentHugePages && ( nullptr == m_mmu || FOUR_KB != m_pageSize ) ) {
+        output->fatal(CALL_INFO, -1, "Error: transparent_huge_pages requires useMMU and a page_size of 4096\n");
+    }
+
     m_nodeNum = params.find<int>("node_id", -1);
 
     m_coreInfoMap.resize( m_coreCount, m_hardwareThreadCount );
@@ -220,6 +230,12 @@ VanadisNodeOSComponent::init(unsigned int phase) {
         m_mmu->init(phase);
     }
 
+    if ( 0 == phase && m_preloadElf && CHECKPOINT_LOAD != m_checkpoint ) {
+        for ( const auto kv : m_threadMap ) {
+            preloadElf( kv.second );
+        }
+    }
+
     // do we need to check for this, really?
     for (Link* next_link : core_links) {
         while (SST::Event* ev = next_link->recvUntimedData()) {
@@ -524,6 +540,43 @@ void VanadisNodeOSComponent::copyPage( uint64_t physFrom, uint64_t physTo, unsig
     readPage( physFrom, data, pageSize, tmp );
 }
 
+// Write every page of the ELF's loadable segments that holds file data straight to memory.
+// The pages are mapped when the process first faults on them, the rest of each segment (.bss)
+// is faulted in as zero pages.
+void VanadisNodeOSComponent::preloadElf( OS::ProcessInfo* process )
+{
+    VanadisELFInfo* elf_info = process->getElfInfo();
+    auto& pages = m_preloadedPages[ process->getpid() ];
+
+    for ( size_t i = 0; i < elf_info->countProgramHeaders(); ++i ) {
+        const VanadisELFProgramHeaderEntry* hdr = elf_info->getProgramHeader(i);
+        if ( PROG_HEADER_LOAD != hdr->getHeaderType() || 0 == hdr->getHeaderImageLength() ) {
+            continue;
+        }
+        uint64_t start = hdr->getVirtualMemoryStart() & ~(m_pageSize - 1);
+        uint64_t end = hdr->getVirtualMemoryStart() + hdr->getHeaderImageLength();
+
+        for ( uint64_t virtAddr = start; virtAddr < end; virtAddr += m_pageSize ) {
+            uint32_t vpn = virtAddr >> m_pageShift;
+            if ( pages.find( vpn ) != pages.end() ) {
+                continue;
+            }
+            OS::Page* page;
+            try {
+                page = allocPage( );
+            } catch ( int err ) {
+                output->fatal(CALL_INFO, -1, "Error: ran out of physical memory\n");
+            }
+            uint8_t* data = readElfPage( output, elf_info, vpn, m_pageSize );
+            std::vector<uint8_t> buffer( data, data + m_pageSize );
+            delete[] data;
+            mem_if->sendUntimedData( new StandardMem::Write( (uint64_t) page->getPPN() << m_pageShift, m_pageSize, buffer ) );
+            pages[vpn] = page;
+        }
+    }
+    output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_APP_INIT, "pid=%d preloaded %zu ELF pages\n", process->getpid(), pages.size() );
+}
+
 void
 VanadisNodeOSComponent::startProcess( OS::HwThreadID& threadID, OS::ProcessInfo* process )
 {
@@ -831,6 +884,26 @@ void VanadisNodeOSComponent::pageFault( PageFault *info )
             return;
         }
 
+        // if the page was written during init by preload_elf
+        auto preloaded = m_preloadedPages.find( thread->getpid() );
+        if ( preloaded != m_preloadedPages.end() ) {
+            auto iter = preloaded->second.find( vpn );
+            if ( iter != preloaded->second.end() ) {
+                OS::Page* page = iter->second;
+                preloaded->second.erase( iter );
+                output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT,"using preloaded page vpn=%d ppn=%d\n",vpn,page->getPPN());
+                thread->mapVirtToPage( vpn, page );
+                m_mmu->map( thread->getpid(), vpn, page->getPPN(), m_pageSize, region->perms );
+                pageFaultFini( info );
+                return;
+            }
+        }
+
+        // back an untouched, aligned 2MB piece of an anonymous region with one large page
+        if ( m_transparentHugePages && nullptr == region->backing && mapHugePage( info, thread, region, vpn ) ) {
+            return;
+        }
+
         OS::Page* page = nullptr;
 
         uint8_t* data = nullptr;
@@ -860,6 +933,7 @@ void VanadisNodeOSComponent::pageFault( PageFault *info )
         }
 
         // if there is no physical backing for this virtual page, get a page
+        bool newPage = ( nullptr == page );
         if ( nullptr == page ) {
             try {
                 page = allocPage( );
@@ -888,6 +962,13 @@ void VanadisNodeOSComponent::pageFault( PageFault *info )
             }
         }
 
+        // a zero page on physical memory no one has written to already holds zeros
+        if ( nullptr == data && newPage && m_lazyZeroPages && m_physMemMgr->isPristine( page->getPPN() ) ) {
+            output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT,"pristine zero page ppn=%d\n",page->getPPN());
+            pageFaultFini( info );
+            return;
+        }
+
         auto callback = new Callback( [=]() {
             pageFaultFini( info );
         });
@@ -908,6 +989,57 @@ void VanadisNodeOSComponent::pageFault( PageFault *info )
     }
 }
 
+bool VanadisNodeOSComponent::mapHugePage( PageFault* info, OS::ProcessInfo* thread, OS::MemoryRegion* region, uint32_t vpn )
+{
+    uint32_t numPages = TWO_MB >> m_pageShift;
+    uint32_t hugeVpn = vpn & ~( numPages - 1 );
+    uint64_t start = (uint64_t) hugeVpn << m_pageShift;
+
+    if ( start < region->addr || start + TWO_MB > region->addr + region->length ) {
+        return false;
+    }
+
+    // a huge page can't replace base pages that are already mapped
+    for ( uint32_t i = 0; i < numPages; i++ ) {
+        if ( -1 != m_mmu->getPerms( thread->getpid(), hugeVpn + i ) ) {
+            return false;
+        }
+    }
+
+    uint32_t ppn;
+    try {
+        ppn = m_physMemMgr->allocPage( PhysMemManager::PageSize::TwoMB );
+    } catch ( int err ) {
+        // no free contiguous 2MB, fall back to a base page
+        output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT,"no free huge page for vpn=%d\n",vpn);
+        return false;
+    }
+    output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT,"huge page vpn=%d ppn=%d\n",hugeVpn,ppn);
+
+    // the OS still tracks the frames as base pages so they can be split and freed one at a time
+    bool pristine = m_lazyZeroPages;
+    for ( uint32_t i = 0; i < numPages; i++ ) {
+        thread->mapVirtToPage( hugeVpn + i, new OS::Page( m_physMemMgr, ppn + i, 1 ) );
+        pristine = pristine && m_physMemMgr->isPristine( ppn + i );
+    }
+
+    m_mmu->map( thread->getpid(), hugeVpn, ppn, TWO_MB, region->perms );
+
+    if ( pristine ) {
+        pageFaultFini( info );
+        return true;
+    }
+
+    auto callback = new Callback( [=]() {
+        pageFaultFini( info );
+    });
+
+    uint8_t* data = new uint8_t[TWO_MB];
+    bzero( data, TWO_MB );
+    writePage( (uint64_t) ppn << m_pageShift, data, TWO_MB, callback );
+    return true;
+}
+
 bool VanadisNodeOSComponent::PageMemReadReq::handleResp( StandardMem::Request* ev ) {
 
     //printf("PageMemReadReq::%s()\n",__func__);
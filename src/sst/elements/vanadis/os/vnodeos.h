@@ -57,6 +57,9 @@ public:
                             { "physMemSize", "Size of available physical memory in bytes, with units. Ex: 2GiB", NULL },
                             { "page_size", "Size of a page, in bytes", "4096" },
                             { "useMMU", "Whether an MMU subcomponent is being used.", "False" },
+                            { "preload_elf", "Write the file-backed pages of each process's ELF segments to memory with untimed writes during init, instead of faulting each one in with timed writes. Requires useMMU.", "False" },
+                            { "lazy_zero_pages", "Map zero-filled pages (.bss, heap, anonymous mmap) that are on never-used physical pages without writing zeros to them. Assumes physical memory starts zeroed.", "False" },
+                            { "transparent_huge_pages", "Back aligned 2MB pieces of anonymous regions (heap, anonymous mmap) with a 2MB page on first touch. Needs a TLB with 2MB entries to pay off. Requires useMMU and a page_size of 4096.", "False" },
                             { "process%(processnum)d.env_count", "Number of environment variables to pass to the process", "0"},
                             { "process%(processnum)d.env%(argnum)d", "Environment variable to pass to the process. Example: 'OMPNUMTHREADS=64'. 'argnum' should be contiguous starting at 0 and ending at env_count-1", ""},
                             { "proccess%(processnum)d.exe", "Name of executable, including path", NULL},
@@ -170,6 +173,8 @@ private:
     void pageFaultFini( PageFault*, bool success = true );
     void startProcess( OS::HwThreadID&, OS::ProcessInfo* process );
     void copyPage(uint64_t physFrom, uint64_t physTo, unsigned pageSize, Callback* );
+    void preloadElf( OS::ProcessInfo* process );
+    bool mapHugePage( PageFault* info, OS::ProcessInfo* thread, OS::MemoryRegion* region, uint32_t vpn );
 
     void sendMemoryEvent(VanadisSyscall* syscall, StandardMem::Request* ev ) {
         m_memRespMap.insert(std::pair<StandardMem::Request::id_t, VanadisSyscall*>(ev->getID(), syscall));
@@ -388,6 +393,10 @@ private:
     std::queue<PageMemReq*>                         m_blockMemoryWriteReqQ;
 
     std::map< VanadisELFInfo*, std::map<int,OS::Page*> >            m_elfPageCache;
+    std::map< unsigned, std::map<uint32_t,OS::Page*> >              m_preloadedPages; // pid -> vpn -> page written during init, not yet mapped
+    bool m_preloadElf;
+    bool m_lazyZeroPages;
+    bool m_transparentHugePages;
     std::unordered_map<StandardMem::Request::id_t, VanadisSyscall*> m_memRespMap;
 
     std::queue< OS::HwThreadID* > m_availHwThreads;
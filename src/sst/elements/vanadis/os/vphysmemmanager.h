@@ -50,7 +50,7 @@ class PhysMemManager {
 
         size_t findFirstEmptyBit( size_t start ) {
             for ( size_t i = start/64; i < m_bitMap.size(); i++ ) {
-                if ( m_bitMap[i] != 0xffffffffffff ) {
+                if ( m_bitMap[i] != ~0UL ) {
 
                     for ( int j = i == start/64 ? start % 64: 0; j < 64; j++ ) {
                         if ( ! getBit( i * 64 + j ) ) {
@@ -62,12 +62,35 @@ class PhysMemManager {
             throw -1;
         }
 
+        // true if every bit in [start,start+numBits) is clear
         bool findEmptyBits( size_t start, int numBits ) {
-            assert(0);
+            size_t end = start + numBits;
+            if ( end > m_bitMap.size() * 64 ) return false;
+            size_t pos = start;
+            while ( pos < end ) {
+                if ( 0 == pos % 64 && pos + 64 <= end ) {
+                    if ( m_bitMap[pos/64] ) return false;
+                    pos += 64;
+                } else {
+                    if ( getBit( pos ) ) return false;
+                    ++pos;
+                }
+            }
+            return true;
         }
 
         void setBits( int start, int numBits ) {
-            assert(0);
+            size_t end = start + numBits;
+            size_t pos = start;
+            while ( pos < end ) {
+                if ( 0 == pos % 64 && pos + 64 <= end ) {
+                    m_bitMap.at( pos/64 ) = ~0UL;
+                    pos += 64;
+                } else {
+                    setBit( pos );
+                    ++pos;
+                }
+            }
         }
 
         void checkpoint( FILE* fp ) {
@@ -102,7 +125,7 @@ class PhysMemManager {
 
     typedef std::vector<uint32_t> PageList;
     enum PageSize { FourKB, TwoMB, OneGB };
-    PhysMemManager( size_t memSize ) : m_bitMap( memSize/4096), m_numAllocated(0) { }
+    PhysMemManager( size_t memSize ) : m_bitMap( memSize/4096), m_recycled( memSize/4096 ), m_allRecycled(false), m_numAllocated(0) { }
     ~PhysMemManager() {
 #if 0
         if ( m_numAllocated > 1 ) {
@@ -129,15 +152,21 @@ class PhysMemManager {
         }
     }
 
-    void freePage( size_t pageSize, size_t pageNum ) {
-        if ( FourKB == pageSize ) {
+    // large pages are allocated as a run of 4K frames and can be freed either way
+    void freePage( PageSize pageSize, size_t pageNum ) {
+        int numNeeded = calcNumNeeded( pageSize );
+        for ( int i = 0; i < numNeeded; i++ ) {
             --m_numAllocated;
-            m_bitMap.clearBit( pageNum );
-        } else {
-            assert(0);
+            m_bitMap.clearBit( pageNum + i );
+            m_recycled.setBit( pageNum + i );
         }
     }
 
+    // true if the page has never been freed, so no one has written to it and it still holds zeros
+    bool isPristine( size_t pageNum ) {
+        return ! m_allRecycled && ! m_recycled.getBit( pageNum );
+    }
+
     void checkpoint( SST::Output* output, std::string dir ) {
         std::stringstream filename;
         filename << dir << "/" << "PhysMemManager";
@@ -157,6 +186,8 @@ class PhysMemManager {
         assert( 1 == fscanf(fp,"m_numAllocated %" SCNu64 "\n",&m_numAllocated) );
         output->verbose(CALL_INFO, 0, VANADIS_DBG_CHECKPOINT,"m_numAllocated %" PRIu64 "\n",m_numAllocated);
         m_bitMap.checkpointLoad(output,fp);
+        // which pages were freed before the checkpoint is not saved
+        m_allRecycled = true;
     }
 
   private:
@@ -176,11 +207,11 @@ class PhysMemManager {
             ++m_numAllocated;
             return page;
         }
-        assert(0);
 
-        int startPage = 0;
+        size_t startPage = 0;
         int numNeeded = calcNumNeeded( pageSize );
 
+        // findFirstEmptyBit() throws when memory is exhausted
         while ( 1 ) {
             startPage = m_bitMap.findFirstEmptyBit( startPage );
 
@@ -189,19 +220,22 @@ class PhysMemManager {
                 // check to see if there are enough empty 4K pages to cover this page size
                 if ( m_bitMap.findEmptyBits( startPage, numNeeded ) ) {
                     m_bitMap.setBits( startPage, numNeeded );
+                    m_numAllocated += numNeeded;
                     return startPage;
                 } else {
                     // move the start page enough 4K pages to keep aligned
                     startPage += numNeeded;
                 }
             } else {
-                // was not aligned, move the start page by one
-                startPage += 1;
+                // was not aligned, move the start page to the next boundary
+                startPage += numNeeded - startPage % numNeeded;
             }
         }
     }
 
     BitMap m_bitMap;
+    BitMap m_recycled;      // pages that have been freed at least once
+    bool m_allRecycled;
     uint64_t m_numAllocated;
 };
 
@@ -26,6 +26,7 @@
 #include <vector>
 #include <queue>
 #include <limits>
+#include <map>
 
 using namespace SST::Interfaces;
 
@@ -44,12 +45,14 @@ public:
                                             "SST::Interfaces::StandardMem" })
 
     SST_ELI_DOCUMENT_PARAMS(
-            { "max_instructions", "Set the maximum number of RoCC instructions permitted in the queue", "8" },
+            { "max_instructions", "Set the maximum number of RoCC instructions permitted in the queue, including those in flight", "8" },
+            { "max_outstanding",  "Maximum number of commands in flight at once. Commands start in order, one per cycle, and may complete out of order", "1" },
             { "clock",            "Clock frequency for component TimeConverter. MMIOTile is Unclocked but subcomponents use the TimeConverter", "1Ghz"}
         )
 
     VanadisRoCCBasic(ComponentId_t id, Params& params) : VanadisRoCCInterface(id, params),
-        max_instructions(params.find<size_t>("max_instructions", 8)) {
+        max_instructions(params.find<size_t>("max_instructions", 8)),
+        max_outstanding(params.find<size_t>("max_outstanding", 1)) {
 
         try {
             UnitAlgebra clock = params.find<UnitAlgebra>("clock", "1GHz");
@@ -69,10 +72,15 @@ public:
                 getName().c_str(), exc.what());
         }
 
+        if (0 == max_outstanding) {
+            output->fatal(CALL_INFO, -1, "%s, Error - Invalid param: max_outstanding must be at least 1.\n",
+                getName().c_str());
+        }
+
         std_mem_handlers = new StandardMemHandlers(this, output);
 
-        busy = false;
-        curr_resp = NULL;
+        in_flight = 0;
+        loads_in_flight = 0;
 
         memInterface = loadUserSubComponent<Interfaces::StandardMem>(
             "memory_interface", ComponentInfo::SHARE_PORTS | ComponentInfo::INSERT_STATS, getTimeConverter("1ps"),
@@ -87,17 +95,22 @@ public:
     }
 
     virtual ~VanadisRoCCBasic() {
-        for(auto roccCmd_q_itr = roccCmd_q.begin(); roccCmd_q_itr != roccCmd_q.end(); ) {
-            delete (*roccCmd_q_itr);
-            roccCmd_q_itr = roccCmd_q.erase(roccCmd_q_itr);
+        for (auto cmd : roccCmd_q) {
+            deleteCommand(cmd);
+        }
+        for (auto& pending : mem_pending) {
+            deleteCommand(pending.second);
+        }
+        for (auto resp : resp_q) {
+            delete resp;
         }
     }
 
-    bool RoCCFull() override { return roccCmd_q.size() >= max_instructions; }
+    bool RoCCFull() override { return roccCmd_q.size() + in_flight >= max_instructions; }
 
-    bool isBusy() override { return busy; }
+    bool isBusy() override { return in_flight >= max_outstanding; }
 
-    size_t roccQueueSize() override { return roccCmd_q.size(); }
+    size_t roccQueueSize() override { return roccCmd_q.size() + in_flight; }
 
     void push(RoCCCommand* rocc_me) override {
         stat_rocc_issued->addData(1);
@@ -105,8 +118,11 @@ public:
     }
 
     RoCCResponse* respond() override {
-        RoCCResponse* temp = curr_resp;
-        curr_resp = NULL;
+        if (resp_q.empty()) {
+            return nullptr;
+        }
+        RoCCResponse* temp = resp_q.front();
+        resp_q.pop_front();
         return temp;
     }
 
@@ -116,101 +132,139 @@ public:
         memInterface->init(phase);
     }
 
+    // Starts the oldest queued command if a slot is free and it does not
+    // depend on a command in flight. ADD and SRAI complete when they start,
+    // loads and stores when memory responds. A fence (func7 0x4) waits until
+    // every older command has completed and holds back younger ones until then.
+    // A store writes the internal register, so it waits for loads in flight.
     void tick(uint64_t cycle) override {
         output->verbose(CALL_INFO, 16, 0, "-> tick RoCC at cycle %" PRIu64 "\n", cycle);
         if(0 == roccCmd_q.size()) {
             output->verbose(CALL_INFO, 16, 0, "--> nothing to do in RoCC\n");
             return;
         }
-        output->verbose(CALL_INFO, 16, 0, "busy? %d\n", busy);
+        output->verbose(CALL_INFO, 16, 0, "in flight: %zu / %zu\n", in_flight, max_outstanding);
 
-        if (!busy) { // are we already processing something? If not:
-            busy = true; // start processing something
-            curr_cmd = roccCmd_q.front(); // grab the command to process
+        if (isBusy()) {
+            return;
+        }
 
-            output->verbose(CALL_INFO, 9, 0, "decoding func7 of RoCC inst\n");
-            switch (curr_cmd->inst->func7) {
-                case 0x0:
-                {
-                    output->verbose(CALL_INFO, 9, 0, "performing RoCC ADD\n");
-                    performADD();
-                } break;
-                case 0x1:
-                {
-                    output->verbose(CALL_INFO, 9, 0, "performing RoCC SRAI\n");
-                    performSRAI();
-                } break;
-                case 0x2: // basic load
-                {
-                    output->verbose(CALL_INFO, 9, 0, "issuing load\n");
-                    issueLoad();
-                } break;
-                case 0x3: // basic store
-                {
-                    output->verbose(CALL_INFO, 9, 0, "issuing store\n");
-                    issueStore();
-                } break;
-                default:
-                {
-                    output->verbose(CALL_INFO, 9, 0, "ERROR: unrecognized RoCC func7\n");
-                } break;
-            }
+        RoCCCommand* cmd = roccCmd_q.front();
+        if ((0x4 == cmd->inst->func7 && in_flight > 0) || (0x3 == cmd->inst->func7 && loads_in_flight > 0)) {
+            output->verbose(CALL_INFO, 16, 0, "--> func7 0x%" PRIx8 " waits for older commands\n", cmd->inst->func7);
+            return;
+        }
+
+        roccCmd_q.pop_front();
+        ++in_flight;
+
+        output->verbose(CALL_INFO, 9, 0, "decoding func7 of RoCC inst\n");
+        switch (cmd->inst->func7) {
+            case 0x0:
+            {
+                output->verbose(CALL_INFO, 9, 0, "performing RoCC ADD\n");
+                performADD(cmd);
+            } break;
+            case 0x1:
+            {
+                output->verbose(CALL_INFO, 9, 0, "performing RoCC SRAI\n");
+                performSRAI(cmd);
+            } break;
+            case 0x2: // basic load
+            {
+                output->verbose(CALL_INFO, 9, 0, "issuing load\n");
+                issueLoad(cmd);
+            } break;
+            case 0x3: // basic store
+            {
+                output->verbose(CALL_INFO, 9, 0, "issuing store\n");
+                issueStore(cmd);
+            } break;
+            case 0x4: // fence, nothing older is in flight
+            {
+                output->verbose(CALL_INFO, 9, 0, "completing RoCC fence\n");
+                completeRoCC(cmd, 0);
+            } break;
+            default:
+            {
+                output->verbose(CALL_INFO, 9, 0, "ERROR: unrecognized RoCC func7\n");
+                completeRoCC(cmd, 1);
+            } break;
         }
     }
 
     // adds rs1 and rs2 and writes it to rd
-    void performADD() {
-        uint64_t rs1 = curr_cmd->rs1;
-        uint64_t rs2 = curr_cmd->rs2;
+    void performADD(RoCCCommand* cmd) {
+        uint64_t rs1 = cmd->rs1;
+        uint64_t rs2 = cmd->rs2;
         output->verbose(CALL_INFO, 9, 0, "EXECUTE RoCC ADD w/ rs1: %" PRIx64 ", rs2: %" PRIx64 ", result: %" PRIx64 "\n", rs1, rs2, rs1 + rs2);
-        completeRoCC(rs1 + rs2);
+        completeRoCC(cmd, rs1 + rs2);
         return;
     }
 
     // writes value of rs1 into rs2
-    void performSRAI() {
-        uint64_t src_1 = curr_cmd->rs1;
-        uint64_t shamt = curr_cmd->rs2;
+    void performSRAI(RoCCCommand* cmd) {
+        uint64_t src_1 = cmd->rs1;
+        uint64_t shamt = cmd->rs2;
         uint64_t result = src_1 >> shamt;
         output->verbose(CALL_INFO, 9, 0, "EXECUTE RoCC SRAI w/ rs1: %" PRIx64 ", shamt: %" PRIx64 ", result: %" PRIx64 "\n", src_1, shamt, result);
-        completeRoCC(result);
+        completeRoCC(cmd, result);
         return;
     }
 
     // just a generic load request based on instruction's register values
-    void issueLoad() {
+    void issueLoad(RoCCCommand* cmd) {
         StandardMem::Request* load_req = nullptr;
 
-        load_req = new StandardMem::Read(curr_cmd->rs1, 4, 0);
-        output->verbose(CALL_INFO, 9, 0, "----> Read Req: physAddr: %" PRIx64 ", size: %" PRIx64 ", vAddr: %" PRIx64 ", inst ptr: %" PRIx64 ", tid: %" PRIx64 "\n", curr_cmd->rs1, uint64_t{4}, curr_cmd->rs1, uint64_t{0}, uint64_t{0});
+        load_req = new StandardMem::Read(cmd->rs1, 4, 0);
+        output->verbose(CALL_INFO, 9, 0, "----> Read Req: physAddr: %" PRIx64 ", size: %" PRIx64 ", vAddr: %" PRIx64 ", inst ptr: %" PRIx64 ", tid: %" PRIx64 "\n", cmd->rs1, uint64_t{4}, cmd->rs1, uint64_t{0}, uint64_t{0});
 
         assert(load_req != nullptr);
 
+        ++loads_in_flight;
+        mem_pending[load_req->getID()] = cmd;
         memInterface->send(load_req);
     }
 
     // just a generic store request based on instruction's register values
-    void issueStore() {
+    void issueStore(RoCCCommand* cmd) {
         StandardMem::Request* store_req = nullptr;
         std::vector<uint8_t> payload(4);
         for (int i = 0; i < 4; ++i) {
             payload[i] = (rocc_internal_register >> (i * 8)) & 0xFF;
         }
 
-        store_req = new StandardMem::Write(curr_cmd->rs1, 4, payload,
-            false, 0, curr_cmd->rs1, 0, 0);
+        store_req = new StandardMem::Write(cmd->rs1, 4, payload,
+            false, 0, cmd->rs1, 0, 0);
+        mem_pending[store_req->getID()] = cmd;
         memInterface->send(store_req);
     }
 
+    // the command waiting on a memory response, removed from the pending set
+    RoCCCommand* takePending(StandardMem::Request::id_t id) {
+        auto pending = mem_pending.find(id);
+        if (pending == mem_pending.end()) {
+            output->fatal(CALL_INFO, -1, "%s, Error: memory response (id: %" PRIu64 ") has no RoCC command waiting on it\n",
+                getName().c_str(), (uint64_t) id);
+        }
+        RoCCCommand* cmd = pending->second;
+        mem_pending.erase(pending);
+        return cmd;
+    }
+
     // finalizes the execution of a RoCC instruction by:
-    // pop it out of the command queue so it will no longer be processed
-    // turn off busy bit so host knows this accelerator is no longer busy
-    // send RoCC response back to host
-    void completeRoCC(uint64_t rd_val) {
-        output->verbose(CALL_INFO, 9, 0, "Finalize RoCC command w/ rd %" PRIu16 ", rd_val %" PRIu64 " \n", curr_cmd->inst->rd, rd_val);
-        roccCmd_q.pop_front();
-        busy = false;
-        curr_resp = new RoCCResponse(curr_cmd->inst->rd, rd_val);
+    // freeing its slot so the accelerator can start another command
+    // queueing a RoCC response, tagged with the command's tag, for the host
+    void completeRoCC(RoCCCommand* cmd, uint64_t rd_val) {
+        output->verbose(CALL_INFO, 9, 0, "Finalize RoCC command w/ rd %" PRIu16 ", rd_val %" PRIu64 " \n", cmd->inst->rd, rd_val);
+        --in_flight;
+        resp_q.push_back(new RoCCResponse(cmd->inst->rd, rd_val, cmd->tag));
+        deleteCommand(cmd);
+    }
+
+    void deleteCommand(RoCCCommand* cmd) {
+        delete cmd->inst;
+        delete cmd;
     }
 
     class StandardMemHandlers : public Interfaces::StandardMem::RequestHandler {
@@ -224,12 +278,16 @@ public:
 
         virtual void handle(StandardMem::ReadResp* ev) {
             out->verbose(CALL_INFO, 9, 0, "-> handle read-response (virt-addr: 0x%" PRIx64 ")\n", ev->vAddr);
-            RoCCCommand* rocc_cmd = rocc->curr_cmd; // need to grab the instruction that generated the read request
+            // need to grab the command that generated the read request
             // so that we know where to store the read response results
+            RoCCCommand* rocc_cmd = rocc->takePending(ev->getID());
+            --rocc->loads_in_flight;
 
             if ( ev->getFail() ) {
                 out->verbose(CALL_INFO, 9, 0, "RoCC load failed, sending error code 1\n");
-                rocc->completeRoCC(1);
+                rocc->completeRoCC(rocc_cmd, 1);
+                delete ev;
+                return;
             }
 
             uint64_t reg_offset  = 0;
@@ -247,13 +305,13 @@ public:
                 {
                     rocc->rocc_internal_register = rocc->dataToInt(&register_value);
                     rocc->output->verbose(CALL_INFO, 9, 0, "RoCC loaded value: %d\n", rocc->rocc_internal_register);
-                    rocc->completeRoCC(0); // complete the load command
+                    rocc->completeRoCC(rocc_cmd, 0); // complete the load command
                 } break;
 
             default:
                 {
                     rocc->output->verbose(CALL_INFO, 9, 0, "ERROR: unrecognized read response flag\n");
-                    rocc->completeRoCC(1); // complete the load command
+                    rocc->completeRoCC(rocc_cmd, 1); // complete the load command
                 } break;
             }
 
@@ -264,13 +322,15 @@ public:
             // write is much simpler because we aren't handling any reponse data
             // just need to make sure it went through properly
             out->verbose(CALL_INFO, 9, 0, "-> handle write-response (virt-addr: 0x%" PRIx64 ")\n", ev->vAddr);
+            RoCCCommand* rocc_cmd = rocc->takePending(ev->getID());
             if ( ev->getFail() ) {
                 out->verbose(CALL_INFO, 9, 0, "RoCC store failed, responding with error code 1\n");
-                rocc->completeRoCC(1);
+                rocc->completeRoCC(rocc_cmd, 1);
+            } else {
+                rocc->completeRoCC(rocc_cmd, 0);
             }
 
             delete ev;
-            rocc->completeRoCC(0);
         }
 
         VanadisRoCCBasic* rocc;
@@ -299,15 +359,17 @@ public:
         return retval;
     }
 
-    std::deque<RoCCCommand*> roccCmd_q; // queue of RoCC commands issued from CPU
-    bool busy; // busy line from RoCC accelerator that keeps this interface from sending more commands
-    RoCCCommand* curr_cmd;
-    RoCCResponse* curr_resp;
+    std::deque<RoCCCommand*> roccCmd_q; // queue of RoCC commands issued from CPU, not yet started
+    std::map<StandardMem::Request::id_t, RoCCCommand*> mem_pending; // commands waiting on memory
+    std::deque<RoCCResponse*> resp_q; // completed commands, oldest completion first
+    size_t in_flight; // commands started but not completed
+    size_t loads_in_flight;
 
     StandardMemHandlers* std_mem_handlers;
     StandardMem* memInterface;
 
-    int max_instructions;
+    size_t max_instructions;
+    size_t max_outstanding;
     int rocc_internal_register;
 };
 
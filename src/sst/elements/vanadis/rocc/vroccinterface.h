@@ -46,30 +46,39 @@ public:
     bool xd;
 };
 
+// Commands are tagged by the core so that an accelerator with several
+// commands in flight can respond out of order. A response carrying
+// ROCC_UNTAGGED completes the oldest outstanding command.
+static constexpr uint64_t ROCC_UNTAGGED = UINT64_MAX;
+
 class RoCCCommand
 {
 public:
-    RoCCCommand(RoCCInstruction* inst, uint64_t rs1, uint64_t rs2) {
+    RoCCCommand(RoCCInstruction* inst, uint64_t rs1, uint64_t rs2, uint64_t tag = ROCC_UNTAGGED) {
         this->inst = inst;
         this->rs1 = rs1;
         this->rs2 = rs2;
+        this->tag = tag;
     }
     ~RoCCCommand() {}
     RoCCInstruction* inst;
     uint64_t rs1;
     uint64_t rs2;
+    uint64_t tag;
 };
 
 class RoCCResponse
 {
 public:
-    RoCCResponse(uint8_t rd, uint64_t rd_val) {
+    RoCCResponse(uint8_t rd, uint64_t rd_val, uint64_t tag = ROCC_UNTAGGED) {
         this->rd = rd;
         this->rd_val = rd_val;
+        this->tag = tag;
     }
     ~RoCCResponse() {}
     uint8_t rd;
     uint64_t rd_val;
+    uint64_t tag;
 };
 
 class VanadisRoCCInterface : public SST::SubComponent {
@@ -88,6 +97,10 @@ public:
 
     virtual ~VanadisRoCCInterface() {delete output;}
 
+    // RoCCFull: no room for another command (queued or in flight)
+    // isBusy: the accelerator cannot start another command this cycle
+    // respond: the next completed command, nullptr if none. The core calls
+    // this until it returns nullptr and owns the responses it is given
     virtual bool RoCCFull() = 0;
     virtual bool isBusy() = 0;
     virtual size_t roccQueueSize() = 0;
@@ -67,7 +67,11 @@ sst.setProgramOption("stop-at", "0 ns")
 
 # Tell SST what statistics handling we want
 sst.setStatisticLoadLevel(4)
-sst.setStatisticOutput("sst.statOutputConsole")
+stats_file = os.getenv("VANADIS_STATS_FILE", "")
+if stats_file != "":
+    sst.setStatisticOutput("sst.statOutputCSV", { "filepath" : stats_file })
+else:
+    sst.setStatisticOutput("sst.statOutputConsole")
 
 full_exe_name = os.getenv("VANADIS_EXE", "./small/" + testDir + "/" + exe +  "/" + isa + "/" + exe )
 exe_name= full_exe_name.split("/")[-1]
@@ -88,6 +92,7 @@ integer_arith_units = int(os.getenv("VANADIS_INTEGER_ARITH_UNITS", 2))
 fp_arith_cycles = int(os.getenv("VANADIS_FP_ARITH_CYCLES", 8))
 fp_arith_units = int(os.getenv("VANADIS_FP_ARITH_UNITS", 2))
 branch_arith_cycles = int(os.getenv("VANADIS_BRANCH_ARITH_CYCLES", 2))
+branch_unit = os.getenv("VANADIS_BRANCH_UNIT", "vanadis.VanadisBasicBranchUnit")
 
 cpu_clock = os.getenv("VANADIS_CPU_CLOCK", "2.3GHz")
 
@@ -267,7 +272,12 @@ cpuParams = {
     "stop_verbose_when_retire_address": stopDbg,
     "print_rob" : False,
     "checkpointDir" : checkpointDir,
-    "checkpoint" : checkpoint
+    "checkpoint" : checkpoint,
+    "fastforward_instructions" : os.getenv("VANADIS_FASTFORWARD_INSTRUCTIONS", 0),
+    "detailed_instructions" : os.getenv("VANADIS_DETAILED_INSTRUCTIONS", 0),
+    "bbv_file" : os.getenv("VANADIS_BBV_FILE", ""),
+    "bbv_interval" : os.getenv("VANADIS_BBV_INTERVAL", 100000000),
+    "host_profile_file" : os.getenv("VANADIS_HOST_PROFILE", ""),
 }
 
 lsqParams = {
@@ -354,7 +364,7 @@ class CPU_Builder:
             os_hdlr.addParams( osHdlrParams )
 
             # CPU.decocer.branch_pred
-            branch_pred = decode.setSubComponent( "branch_unit", "vanadis.VanadisBasicBranchUnit" )
+            branch_pred = decode.setSubComponent( "branch_unit", branch_unit )
             branch_pred.addParams( branchPredParams )
             branch_pred.enableAllStatistics()
 
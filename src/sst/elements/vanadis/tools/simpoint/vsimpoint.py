@@ -0,0 +1,280 @@
+#!/usr/bin/env python3
+#
+# Copyright 2009-2025 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2025, NTESS
+# All rights reserved.
+#
+# Portions are copyright of other developers:
+# See the file CONTRIBUTORS.TXT in the top level directory
+# of the distribution for more information.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+"""Sampled simulation with Vanadis.
+
+The workflow has three steps:
+
+ 1. Run the application once in fast forward with basic block vectors
+    enabled, e.g. with tests/basic_vanadis.py:
+
+      VANADIS_FASTFORWARD_INSTRUCTIONS=<more than the program> \\
+      VANADIS_BBV_FILE=app.bb VANADIS_BBV_INTERVAL=100000000 sst basic_vanadis.py
+
+ 2. Pick representative intervals.  Either run the SimPoint tool on
+    app.bb.0, or let this script cluster the vectors:
+
+      vsimpoint.py pick app.bb.0 -k 10 -o app
+
+    Both produce app.simpoints and app.weights.
+
+ 3. Write one job per simulation point, run them in parallel however you
+    like, then combine the statistics:
+
+      vsimpoint.py jobs app -i 100000000 -- sst basic_vanadis.py > jobs.sh
+      vsimpoint.py combine app -d stats
+
+Each job fast forwards to the start of its interval, which also warms the
+caches and branch predictor, and then runs the interval on the detailed
+pipeline.  combine weights each job's statistics by its cluster weight.
+"""
+
+import argparse
+import csv
+import os
+import random
+import shlex
+import sys
+
+
+def read_bbv(path):
+    vectors = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith("T"):
+                continue
+            vec = {}
+            for field in line[1:].split():
+                _, block, count = field.split(":")
+                vec[int(block)] = int(count)
+            vectors.append(vec)
+    return vectors
+
+
+def project(vectors, dims, seed):
+    # Random projection as SimPoint does, after normalizing each interval
+    # so that the vectors describe where time goes, not how much of it
+    rng = random.Random(seed)
+    cols = {}
+    points = []
+    for vec in vectors:
+        total = float(sum(vec.values())) or 1.0
+        p = [0.0] * dims
+        for block, count in vec.items():
+            if block not in cols:
+                cols[block] = [rng.uniform(-1.0, 1.0) for _ in range(dims)]
+            w = count / total
+            col = cols[block]
+            for d in range(dims):
+                p[d] += w * col[d]
+        points.append(p)
+    return points
+
+
+def dist2(a, b):
+    return sum((x - y) * (x - y) for x, y in zip(a, b))
+
+
+def kmeans(points, k, seed, iterations=100):
+    rng = random.Random(seed)
+
+    # k-means++ seeding
+    centers = [list(rng.choice(points))]
+    while len(centers) < k:
+        d = [min(dist2(p, c) for c in centers) for p in points]
+        total = sum(d)
+        if total == 0.0:
+            break
+        r = rng.uniform(0.0, total)
+        acc = 0.0
+        for p, w in zip(points, d):
+            acc += w
+            if acc >= r:
+                centers.append(list(p))
+                break
+
+    labels = [0] * len(points)
+    for _ in range(iterations):
+        changed = False
+        for i, p in enumerate(points):
+            best = min(range(len(centers)), key=lambda c: dist2(p, centers[c]))
+            if best != labels[i]:
+                labels[i] = best
+                changed = True
+
+        for c in range(len(centers)):
+            members = [points[i] for i in range(len(points)) if labels[i] == c]
+            if members:
+                centers[c] = [sum(col) / len(members) for col in zip(*members)]
+
+        if not changed:
+            break
+
+    return centers, labels
+
+
+def pick(args):
+    vectors = read_bbv(args.bbv)
+    if not vectors:
+        sys.exit("No intervals found in %s" % args.bbv)
+
+    points = project(vectors, args.dims, args.seed)
+    k = min(args.k, len(points))
+    centers, labels = kmeans(points, k, args.seed)
+
+    simpoints = []
+    for c in range(len(centers)):
+        members = [i for i in range(len(points)) if labels[i] == c]
+        if not members:
+            continue
+        rep = min(members, key=lambda i: dist2(points[i], centers[c]))
+        simpoints.append((rep, len(members) / float(len(points))))
+
+    simpoints.sort()
+    with open(args.output + ".simpoints", "w") as sp, open(args.output + ".weights", "w") as wt:
+        for cluster, (interval, weight) in enumerate(simpoints):
+            sp.write("%d %d\n" % (interval, cluster))
+            wt.write("%.6f %d\n" % (weight, cluster))
+
+    print("%d intervals, %d simulation points written to %s.simpoints and %s.weights"
+          % (len(points), len(simpoints), args.output, args.output))
+
+
+def read_simpoints(prefix):
+    # Accepts the output of the SimPoint tool as well as pick
+    intervals = {}
+    with open(prefix + ".simpoints") as f:
+        for line in f:
+            if line.strip():
+                interval, cluster = line.split()
+                intervals[int(cluster)] = int(interval)
+
+    weights = {}
+    with open(prefix + ".weights") as f:
+        for line in f:
+            if line.strip():
+                weight, cluster = line.split()
+                weights[int(cluster)] = float(weight)
+
+    return [(c, intervals[c], weights[c]) for c in sorted(intervals)]
+
+
+def jobs(args):
+    if not args.command:
+        sys.exit("A command to run each job is required after --")
+    command = " ".join(shlex.quote(c) for c in args.command)
+
+    os.makedirs(args.stats_dir, exist_ok=True)
+    for cluster, interval, weight in read_simpoints(args.simpoints):
+        env = {
+            "VANADIS_FASTFORWARD_INSTRUCTIONS": interval * args.interval,
+            "VANADIS_DETAILED_INSTRUCTIONS": args.interval,
+            "VANADIS_STATS_FILE": os.path.join(args.stats_dir, "simpoint%d.csv" % cluster),
+        }
+        print(" ".join("%s=%s" % (k, shlex.quote(str(v))) for k, v in env.items()) + " " + command)
+
+
+def read_stats(path):
+    stats = {}
+    with open(path) as f:
+        reader = csv.reader(f)
+        header = [h.strip() for h in next(reader)]
+        comp = header.index("ComponentName")
+        name = header.index("StatisticName")
+        subid = header.index("StatisticSubId")
+        total = [i for i, h in enumerate(header) if h.startswith("Sum.")][0]
+        for row in reader:
+            if not row:
+                continue
+            key = (row[comp].strip(), row[name].strip(), row[subid].strip())
+            # Periodic output repeats a statistic, the last value wins
+            stats[key] = float(row[total])
+    return stats
+
+
+def combine(args):
+    points = read_simpoints(args.simpoints)
+    weighted = {}
+    used = 0.0
+    for cluster, interval, weight in points:
+        path = os.path.join(args.stats_dir, "simpoint%d.csv" % cluster)
+        if not os.path.exists(path):
+            print("warning: %s is missing, skipping simulation point %d" % (path, cluster), file=sys.stderr)
+            continue
+        used += weight
+        for key, value in read_stats(path).items():
+            weighted[key] = weighted.get(key, 0.0) + weight * value
+
+    if used == 0.0:
+        sys.exit("No statistics found in %s" % args.stats_dir)
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    writer = csv.writer(out)
+    writer.writerow(["ComponentName", "StatisticName", "StatisticSubId", "PerInterval"])
+    for key in sorted(weighted):
+        # Renormalize in case some points did not finish
+        writer.writerow(list(key) + ["%.6g" % (weighted[key] / used)])
+    if out is not sys.stdout:
+        out.close()
+
+    for (comp, name, subid), cycles in sorted(weighted.items()):
+        if name != "cycles":
+            continue
+        retired = weighted.get((comp, "instructions_retired", subid))
+        if retired:
+            print("%s: CPI %.4f" % (comp, cycles / retired), file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="step", required=True)
+
+    p = sub.add_parser("pick", help="cluster basic block vectors into simulation points")
+    p.add_argument("bbv", help="basic block vector file written by the core")
+    p.add_argument("-k", type=int, default=10, help="number of clusters (default 10)")
+    p.add_argument("--dims", type=int, default=15, help="projected dimensions (default 15)")
+    p.add_argument("--seed", type=int, default=1)
+    p.add_argument("-o", "--output", required=True, help="prefix for the .simpoints and .weights files")
+    p.set_defaults(func=pick)
+
+    p = sub.add_parser("jobs", help="print one command per simulation point, the command follows --")
+    p.add_argument("simpoints", help="prefix of the .simpoints and .weights files")
+    p.add_argument("-i", "--interval", type=int, required=True, help="bbv_interval used to collect the vectors")
+    p.add_argument("-d", "--stats-dir", default="stats", help="where each job writes its statistics (default stats)")
+    p.set_defaults(func=jobs)
+
+    p = sub.add_parser("combine", help="weight the statistics of each simulation point")
+    p.add_argument("simpoints", help="prefix of the .simpoints and .weights files")
+    p.add_argument("-d", "--stats-dir", default="stats", help="directory holding simpoint<N>.csv (default stats)")
+    p.add_argument("-o", "--output", help="write the combined statistics to this CSV file instead of stdout")
+    p.set_defaults(func=combine)
+
+    # Everything after -- is the command each job runs
+    argv = sys.argv[1:]
+    command = []
+    if "--" in argv:
+        command = argv[argv.index("--") + 1:]
+        argv = argv[:argv.index("--")]
+
+    args = parser.parse_args(argv)
+    args.command = command
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
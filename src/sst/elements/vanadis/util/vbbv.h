@@ -0,0 +1,136 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_UTIL_BBV
+#define _H_VANADIS_UTIL_BBV
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// Basic block vectors in the SimPoint .bb format.  Every interval of
+// retired micro-ops produces one line
+//
+//   T:<block id>:<micro-ops> :<block id>:<micro-ops> ...
+//
+// where a block is identified by the address of its first instruction and
+// ids are handed out in the order blocks are first seen, starting at 1.
+// Blocks end at every speculated (branch or jump) instruction.
+class VanadisBasicBlockVector
+{
+public:
+    VanadisBasicBlockVector(FILE* bbv_file, const uint64_t interval, const uint32_t hw_threads) :
+        fp(bbv_file),
+        interval_length(interval),
+        interval_count(0),
+        intervals_written(0),
+        threads(hw_threads)
+    {}
+
+    ~VanadisBasicBlockVector()
+    {
+        // A partial last interval is still written so nothing is lost,
+        // SimPoint can ignore it
+        for ( uint32_t i = 0; i < threads.size(); ++i ) {
+            closeBlock(i);
+        }
+        writeInterval();
+        fclose(fp);
+    }
+
+    void retire(const uint32_t thr, const uint64_t ins_addr, const bool ends_block)
+    {
+        BlockState& state = threads[thr];
+
+        if ( 0 == state.length ) { state.start = ins_addr; }
+        state.length++;
+
+        if ( ends_block ) { closeBlock(thr); }
+
+        if ( ++interval_count >= interval_length ) {
+            for ( uint32_t i = 0; i < threads.size(); ++i ) {
+                closeBlock(i);
+            }
+            writeInterval();
+        }
+    }
+
+    uint64_t getIntervalsWritten() const { return intervals_written; }
+
+private:
+    struct BlockState {
+        uint64_t start  = 0;
+        uint64_t length = 0;
+    };
+
+    void closeBlock(const uint32_t thr)
+    {
+        BlockState& state = threads[thr];
+        if ( 0 == state.length ) { return; }
+
+        auto id_itr = block_ids.find(state.start);
+        uint32_t id;
+
+        if ( id_itr == block_ids.end() ) {
+            id = block_ids.size() + 1;
+            block_ids.insert(std::make_pair(state.start, id));
+        }
+        else {
+            id = id_itr->second;
+        }
+
+        if ( id >= block_counts.size() ) { block_counts.resize(id + 1, 0); }
+        if ( 0 == block_counts[id] ) { touched.push_back(id); }
+
+        block_counts[id] += state.length;
+        state.length = 0;
+    }
+
+    void writeInterval()
+    {
+        if ( touched.empty() ) { return; }
+
+        fprintf(fp, "T");
+        for ( const uint32_t id : touched ) {
+            fprintf(fp, ":%" PRIu32 ":%" PRIu64 " ", id, block_counts[id]);
+            block_counts[id] = 0;
+        }
+        fprintf(fp, "\n");
+
+        touched.clear();
+        interval_count = 0;
+        intervals_written++;
+    }
+
+    FILE*          fp;
+    const uint64_t interval_length;
+    uint64_t       interval_count;
+    uint64_t       intervals_written;
+
+    std::vector<BlockState>                threads;
+    std::unordered_map<uint64_t, uint32_t> block_ids;
+    std::vector<uint64_t>                  block_counts;
+    std::vector<uint32_t>                  touched;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,99 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_UTIL_HOST_PROFILE
+#define _H_VANADIS_UTIL_HOST_PROFILE
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+
+namespace SST {
+namespace Vanadis {
+
+enum VanadisHostProfileStage {
+    HOST_PROFILE_RETIRE,
+    HOST_PROFILE_EXECUTE,
+    HOST_PROFILE_LSQ,
+    HOST_PROFILE_ISSUE,
+    HOST_PROFILE_DECODE,
+    HOST_PROFILE_FETCH,
+    HOST_PROFILE_FASTFORWARD,
+    HOST_PROFILE_OTHER,
+    HOST_PROFILE_STAGE_COUNT
+};
+
+// Host (wall clock) time spent in each pipeline stage of a core.  Each
+// stage is charged the time since the previous stage ended, so the stages
+// add up to the time spent inside the clock handler, while fast forwarding
+// the execute and LSQ stages are still charged separately.  The totals are
+// written as one JSON object when the profile is destroyed.
+class VanadisHostProfile
+{
+public:
+    VanadisHostProfile(FILE* profile_file, const uint32_t core) : fp(profile_file), core_id(core), cycles(0), retired(0)
+    {
+        for ( uint32_t i = 0; i < HOST_PROFILE_STAGE_COUNT; ++i ) {
+            stage_ns[i] = 0;
+        }
+    }
+
+    ~VanadisHostProfile()
+    {
+        static const char* stage_names[HOST_PROFILE_STAGE_COUNT] = { "retire", "execute",     "lsq",  "issue",
+                                                                     "decode", "fetch", "fastforward", "other" };
+        uint64_t total_ns = 0;
+
+        fprintf(fp, "{\"core\": %" PRIu32 ", \"cycles\": %" PRIu64 ", \"retired\": %" PRIu64 ", \"stage_ns\": {", core_id,
+            cycles, retired);
+
+        for ( uint32_t i = 0; i < HOST_PROFILE_STAGE_COUNT; ++i ) {
+            fprintf(fp, "%s\"%s\": %" PRIu64, (i > 0) ? ", " : "", stage_names[i], stage_ns[i]);
+            total_ns += stage_ns[i];
+        }
+
+        fprintf(fp, "}, \"total_ns\": %" PRIu64 "}\n", total_ns);
+        fclose(fp);
+    }
+
+    void startCycle()
+    {
+        cycles++;
+        last = std::chrono::steady_clock::now();
+    }
+
+    void endStage(const VanadisHostProfileStage stage)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        stage_ns[stage] += std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count();
+        last = now;
+    }
+
+    void addRetired(const uint64_t count) { retired += count; }
+
+private:
+    FILE*                                 fp;
+    const uint32_t                        core_id;
+    uint64_t                              cycles;
+    uint64_t                              retired;
+    uint64_t                              stage_ns[HOST_PROFILE_STAGE_COUNT];
+    std::chrono::steady_clock::time_point last;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
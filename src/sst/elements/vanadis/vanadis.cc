@@ -22,6 +22,7 @@
 
 #include "os/resp/vosexitresp.h"
 
+#include <chrono>
 #include <cstdio>
 #include <sst/core/output.h>
 #include <vector>
@@ -75,7 +76,7 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
     std::string clock_rate = params.find<std::string>("clock", "1GHz");
     output->verbose(CALL_INFO, 2, 0, "Registering clock at %s.\n", clock_rate.c_str());
-    clock_handler_   = new Clock::Handler2<VANADIS_COMPONENT,&VANADIS_COMPONENT::tick>(this);
+    clock_handler_   = new Clock::Handler2<VANADIS_COMPONENT,&VANADIS_COMPONENT::timedTick>(this);
     clock_tc_        = registerClock(clock_rate, clock_handler_);
 
     const uint32_t rob_count = params.find<uint32_t>("reorder_slots", 64);
@@ -202,6 +203,18 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
         thread_decoders[i]->setThreadROB(rob[i]);
 
+        // The vector registers of some decoders take many ISA registers
+        if ( (int_register_stack->unused() < thread_decoders[i]->countISAIntReg()) ||
+             (fp_register_stack->unused() < thread_decoders[i]->countISAFPReg()) ) {
+            output->fatal(
+                CALL_INFO, -1,
+                "Error: thread %" PRIu32 " needs %" PRIu16 " integer and %" PRIu16 " floating point ISA registers but "
+                "only %" PRIu32 " and %" PRIu32 " physical registers are left, increase physical_integer_registers or "
+                "physical_fp_registers\n",
+                i, thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg(),
+                (uint32_t)int_register_stack->unused(), (uint32_t)fp_register_stack->unused());
+        }
+
         // Reserve ISA registers
         for ( uint16_t j = 0; j < thread_decoders[i]->countISAIntReg(); ++j ) {
             issue_isa_tables[i]->setIntPhysReg(j, int_register_stack->pop());
@@ -241,6 +254,9 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
     resetRegisterUseTemps(max_int_regs, max_fp_regs);
 
+    rob_issued_prefix.resize(hw_threads, 0);
+    rob_issued_prefix_ignored_writes.resize(hw_threads, 0);
+
     //	memDataInterface =
     // loadUserSubComponent<Interfaces::SimpleMem>("mem_interface_data",
     // ComponentInfo::SHARE_NONE, clock_tc_, 		new
@@ -271,6 +287,7 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     lsq->setRegisterFiles(&register_files);
 
     //////////////////////////////////////////////////////////////////////////////////////
+    rocc_next_tag_ = 0;
     SubComponentSlotInfo * lists = getSubComponentSlotInfo("rocc");
     if (lists) {
         for (int i = 0; i <= lists->getMaxPopulatedSlotNumber(); i++) {
@@ -341,6 +358,17 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
         fu_fp_div.push_back(new VanadisFunctionalUnit(fu_id++, INST_FP_DIV, fp_div_cycles));
     }
 
+    const uint16_t vector_lanes       = params.find<uint16_t>("vector_lanes", 1);
+    const uint16_t vector_lane_cycles = params.find<uint16_t>("vector_lane_cycles", fp_arith_cycles);
+
+    output->verbose(
+        CALL_INFO, 2, 0, "Creating %" PRIu16 " vector lanes, latency = %" PRIu16 "...\n", vector_lanes,
+        vector_lane_cycles);
+
+    for ( uint16_t i = 0; i < vector_lanes; ++i ) {
+        fu_vector.push_back(new VanadisFunctionalUnit(fu_id++, INST_VECTOR, vector_lane_cycles));
+    }
+
     //////////////////////////////////////////////////////////////////////////////////////
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
         thread_decoders[i]->getOSHandler()->setCoreID(core_id);
@@ -378,6 +406,62 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
     setVerboseWhenIssueAddress( params.find<std::string>("start_verbose_when_issue_address", "") );
 
+    fastforward_instructions  = params.find<uint64_t>("fastforward_instructions", 0);
+    fastforward_until_address = params.find<uint64_t>("fastforward_until_address", 0);
+    fastforward_until_roi     = params.find<bool>("fastforward_until_roi", false);
+    fastforward_width         = params.find<uint32_t>("fastforward_width", 64);
+    fastforward_retired       = 0;
+
+    fast_forward = (fastforward_instructions > 0) || (fastforward_until_address > 0) || fastforward_until_roi;
+
+    if ( fast_forward ) {
+        if ( 0 == fastforward_width ) {
+            output->fatal(CALL_INFO, -1, "Incorrect parameter (%s): 'fastforward_width' cannot be 0. Fix parameter in the input file\n", getName().c_str());
+        }
+
+        output->verbose(CALL_INFO, 8, 0, "-> Fast forward width:           %" PRIu32 "\n", fastforward_width);
+        output->verbose(CALL_INFO, 8, 0, "-> Fast forward instructions:    %" PRIu64 "\n", fastforward_instructions);
+        output->verbose(CALL_INFO, 8, 0, "-> Fast forward until address:   0x%" PRI_ADDR "\n", fastforward_until_address);
+        output->verbose(CALL_INFO, 8, 0, "-> Fast forward until ROI:       %s\n", fastforward_until_roi ? "yes" : "no");
+    }
+
+    detailed_instructions = params.find<uint64_t>("detailed_instructions", 0);
+    detailed_retired      = 0;
+
+    sleep_when_blocked = params.find<bool>("sleep_when_blocked", false);
+    clock_off          = false;
+    sleep_cycle        = 0;
+    syscall_blocked.resize(hw_threads, false);
+
+    bbv = nullptr;
+    std::string bbv_path = params.find<std::string>("bbv_file", "");
+
+    if ( !bbv_path.empty() ) {
+        const uint64_t bbv_interval = params.find<uint64_t>("bbv_interval", 100000000);
+        if ( 0 == bbv_interval ) {
+            output->fatal(CALL_INFO, -1, "Incorrect parameter (%s): 'bbv_interval' cannot be 0. Fix parameter in the input file\n", getName().c_str());
+        }
+
+        bbv_path += "." + std::to_string(core_id);
+        FILE* bbv_fp = fopen(bbv_path.c_str(), "wt");
+        if ( nullptr == bbv_fp ) { output->fatal(CALL_INFO, -1, "Failed to open basic block vector file %s.\n", bbv_path.c_str()); }
+
+        output->verbose(CALL_INFO, 8, 0, "Writing basic block vectors every %" PRIu64 " micro-ops to %s\n", bbv_interval, bbv_path.c_str());
+        bbv = new VanadisBasicBlockVector(bbv_fp, bbv_interval, hw_threads);
+    }
+
+    host_profile = nullptr;
+    std::string host_profile_path = params.find<std::string>("host_profile_file", "");
+
+    if ( !host_profile_path.empty() ) {
+        host_profile_path += "." + std::to_string(core_id);
+        FILE* host_profile_fp = fopen(host_profile_path.c_str(), "wt");
+        if ( nullptr == host_profile_fp ) { output->fatal(CALL_INFO, -1, "Failed to open host profile file %s.\n", host_profile_path.c_str()); }
+
+        output->verbose(CALL_INFO, 8, 0, "Writing the host time per pipeline stage to %s\n", host_profile_path.c_str());
+        host_profile = new VanadisHostProfile(host_profile_fp, core_id);
+    }
+
     // Register statistics ///////////////////////////////////////////////////////
     stat_ins_retired          = registerStatistic<uint64_t>("instructions_retired", "1");
     stat_ins_decoded          = registerStatistic<uint64_t>("instructions_decoded", "1");
@@ -392,6 +476,11 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     stat_syscall_cycles       = registerStatistic<uint64_t>("syscall-cycles", "1");
     stat_int_phys_regs_in_use = registerStatistic<uint64_t>("phys_int_reg_in_use", "1");
     stat_fp_phys_regs_in_use  = registerStatistic<uint64_t>("phys_fp_reg_in_use", "1");
+    stat_ff_cycles            = registerStatistic<uint64_t>("fastforward_cycles", "1");
+    stat_ff_ins               = registerStatistic<uint64_t>("fastforward_instructions", "1");
+    stat_sleep_cycles         = registerStatistic<uint64_t>("sleep_cycles", "1");
+    stat_host_tick_ns         = registerStatistic<uint64_t>("host_tick_ns", "1");
+    stat_host_tick_calls      = registerStatistic<uint64_t>("host_tick_calls", "1");
 
     //registerAsPrimaryComponent();
     //primaryComponentDoNotEndSim();
@@ -412,6 +501,9 @@ VANADIS_COMPONENT::~VANADIS_COMPONENT()
 
     if ( pipelineTrace != nullptr ) { fclose(pipelineTrace); }
 
+    delete bbv;
+    delete host_profile;
+
 	for( VanadisFloatingPointFlags* next_fp_flags : fp_flags ) {
 		delete next_fp_flags;
 	}
@@ -428,6 +520,7 @@ void
 VANADIS_COMPONENT::startThread(int thr, uint64_t stackStart, uint64_t instructionPointer )
 {
     halted_masks[thr]            = false;
+    syscall_blocked[thr]         = false;
     uint64_t initial_config_ip = thread_decoders[thr]->getInstructionPointer();
 
     // This wasn't provided, or its explicitly set to zero which means
@@ -512,6 +605,18 @@ VANADIS_COMPONENT::performDecode(const uint64_t cycle)
         return 0;
 }
 
+void
+VANADIS_COMPONENT::resetZeroRegister(const uint32_t thr)
+{
+    const uint16_t zero_reg = isa_options[thr]->getRegisterIgnoreWrites();
+
+    if ( zero_reg < isa_options[thr]->countISAIntRegisters() ) {
+        VanadisISATable* thr_issue_table = issue_isa_tables[thr];
+        const uint16_t   zero_phys_reg   = thr_issue_table->getIntPhysReg(zero_reg);
+        register_files[thr]->setIntReg<uint64_t>(zero_phys_reg, 0);
+    }
+}
+
 void
 VANADIS_COMPONENT::resetRegisterUseTemps(const uint16_t int_reg_count, const uint16_t fp_reg_count)
 {
@@ -523,6 +628,51 @@ VANADIS_COMPONENT::resetRegisterUseTemps(const uint16_t int_reg_count, const uin
     }
 }
 
+bool
+VANADIS_COMPONENT::writesIgnoredRegister(const uint32_t thr, VanadisInstruction* ins)
+{
+    const uint16_t ignored_reg = isa_options[thr]->getRegisterIgnoreWrites();
+
+    for ( auto k = 0; k < ins->countISAIntRegOut(); ++k ) {
+        if ( ins->getISAIntRegOut(k) == ignored_reg ) { return true; }
+    }
+
+    return false;
+}
+
+void
+VANADIS_COMPONENT::advanceIssuedPrefix(const uint32_t thr)
+{
+    VanadisCircularQueue<VanadisInstruction*>* thr_rob = rob[thr];
+    uint32_t& prefix = rob_issued_prefix[thr];
+
+    while ( prefix < thr_rob->size() ) {
+        VanadisInstruction* ins = thr_rob->peekAt(prefix);
+        if ( !ins->completedIssue() ) { break; }
+
+        if ( writesIgnoredRegister(thr, ins) ) { rob_issued_prefix_ignored_writes[thr]++; }
+        prefix++;
+    }
+}
+
+void
+VANADIS_COMPONENT::retireIssuedPrefix(const uint32_t thr, VanadisInstruction* ins)
+{
+    // Only the ROB front retires, so it is the first prefix entry if the
+    // prefix has caught up with it yet
+    if ( rob_issued_prefix[thr] > 0 ) {
+        rob_issued_prefix[thr]--;
+        if ( writesIgnoredRegister(thr, ins) ) { rob_issued_prefix_ignored_writes[thr]--; }
+    }
+}
+
+void
+VANADIS_COMPONENT::clearIssuedPrefix(const uint32_t thr)
+{
+    rob_issued_prefix[thr]                = 0;
+    rob_issued_prefix_ignored_writes[thr] = 0;
+}
+
 int
 VANADIS_COMPONENT::performIssue(const uint64_t cycle, int hwThr, uint32_t& rob_start, int& unallocated_memory_op_seen)
 {
@@ -545,9 +695,16 @@ VANADIS_COMPONENT::performIssue(const uint64_t cycle, int hwThr, uint32_t& rob_s
         issued_an_ins = false;
         VanadisCircularQueue<VanadisInstruction*>* thr_rob;
         thr_rob = rob[hwThr];
-        // Find the next instruction which has not been issued yet
+        // Find the next instruction which has not been issued yet, there
+        // is nothing to learn from the entries already known to be issued
+        // except their writes to the register which ignores writes
         const auto rob_size = thr_rob->size();
-        int k_in=0;
+        advanceIssuedPrefix(i);
+        if ( rob_issued_prefix_ignored_writes[i] > 0 ) {
+            tmp_int_reg_write[i][isa_options[i]->getRegisterIgnoreWrites()] = 1;
+        }
+        rob_start = std::max(rob_start, rob_issued_prefix[i]);
+
         for ( auto j = rob_start; j < rob_size; ++j )
         {
             VanadisInstruction* ins = thr_rob->peekAt(j);
@@ -764,6 +921,15 @@ VANADIS_COMPONENT::performExecute(const uint64_t cycle)
         #endif
     }
 
+    for ( VanadisFunctionalUnit* next_fu : fu_vector ) {
+        next_fu->tick(cycle, output, register_files);
+
+        #ifdef VANADIS_BUILD_DEBUG
+        if(verbose_level >= 16)
+            next_fu->print(output);
+        #endif
+    }
+
     for ( VanadisFunctionalUnit* next_fu : fu_branch ) {
         next_fu->tick(cycle, output, register_files);
 
@@ -773,17 +939,37 @@ VANADIS_COMPONENT::performExecute(const uint64_t cycle)
         #endif
     }
 
+    if ( UNLIKELY(nullptr != host_profile) ) host_profile->endStage(HOST_PROFILE_EXECUTE);
+
     // Tick the load/store queue
     lsq->tick((uint64_t)cycle);
 
-    // Tick the RoCC Interfaces
+    if ( UNLIKELY(nullptr != host_profile) ) host_profile->endStage(HOST_PROFILE_LSQ);
+
+    // Tick the RoCC Interfaces, collecting every response first. Responses
+    // are matched to their instruction by tag and may arrive out of order
     for (int i = 0; i < roccs_.size(); i++) {
         RoCCResponse* resp;
-        if (!(roccs_[i]->isBusy()) && (resp = roccs_[i]->respond())) {
-            VanadisInstruction* ins = rocc_queues_[i].front();
-            register_files[ins->getHWThread()]->setIntReg<uint64_t>(resp->rd, resp->rd_val);
+        while ( (resp = roccs_[i]->respond()) ) {
+            auto& queue = rocc_queues_[i];
+            auto match = queue.begin();
+            if ( ROCC_UNTAGGED != resp->tag ) {
+                while ( match != queue.end() && static_cast<VanadisRoCCInstruction*>(*match)->tag != resp->tag ) {
+                    ++match;
+                }
+            }
+            if ( match == queue.end() ) {
+                output->fatal(
+                    CALL_INFO, -1, "Error: rocc%d responded (tag: %" PRIu64 ") without a matching outstanding instruction\n",
+                    i, resp->tag);
+            }
+            VanadisInstruction* ins = *match;
+            if ( !writesIgnoredRegister(ins->getHWThread(), ins) ) {
+                register_files[ins->getHWThread()]->setIntReg<uint64_t>(ins->getPhysIntRegOut(0), resp->rd_val);
+            }
             ins->markExecuted();
-            rocc_queues_[i].pop_front();
+            queue.erase(match);
+            delete resp;
         }
         roccs_[i]->tick((uint64_t)cycle);
 
@@ -841,6 +1027,18 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
     VanadisDecoder* thr_decoder;
     thr_decoder = thread_decoders[ins_thread];
 
+    // The load read memory before an older store to the same address had
+    // written it, throw it and everything after it away and fetch it again
+    if ( UNLIKELY(rob_front->violatesMemoryOrder()) ) {
+        #ifdef VANADIS_BUILD_DEBUG
+        output->verbose(
+            CALL_INFO, 8, 0, "----> memory order violation at 0x%" PRI_ADDR " thread %" PRIu32 ", replay from the load\n",
+            rob_front->getInstructionAddress(), ins_thread);
+        #endif
+        handleMisspeculate(ins_thread, rob_front->getInstructionAddress());
+        return 1;
+    }
+
     // Instruction is flagging error, print out and halt
     if ( UNLIKELY(rob_front->trapsError()) ) {
         output->verbose(CALL_INFO, 16, 0, "Error has been detected in retired instruction. Retired "
@@ -883,7 +1081,7 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                     "perform a cast to a speculated instruction.\n");
             }
 
-            stat_branches->addData(1);
+            if ( LIKELY(!fast_forward) ) stat_branches->addData(1);
 
             switch ( spec_ins->getDelaySlotType() ) {
             case VANADIS_SINGLE_DELAY_SLOT:
@@ -953,8 +1151,9 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                 }
                 }
                 #endif
-                thr_decoder->getBranchPredictor()->push(
-                spec_ins->getInstructionAddress(), pipeline_reset_addr);
+                thr_decoder->getBranchPredictor()->update(
+                    spec_ins->getInstructionAddress(), spec_ins->getFallThroughAddress(), pipeline_reset_addr,
+                    spec_ins->getBranchType());
 
                 if ( stop_verbose_when_retire_address > 0 && (rob_front->getInstructionAddress() == stop_verbose_when_retire_address) ) {
                     output->setVerboseLevel(0);
@@ -991,6 +1190,7 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
         if ( perform_cleanup )
         {
             rob->pop();
+            retireIssuedPrefix(ins_thread, rob_front);
 
             #ifdef VANADIS_BUILD_DEBUG
             if ( output->getVerboseLevel() >= 8 )
@@ -1041,10 +1241,17 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
 
             ins_retired_this_cycle++;
 
+            if ( UNLIKELY(nullptr != bbv) ) {
+                // With a delay slot the block ends after the delay instruction
+                bbv->retire(ins_thread, rob_front->getInstructionAddress(),
+                    rob_front->isSpeculated() && !perform_delay_cleanup);
+            }
+
             if ( perform_delay_cleanup )
             {
 
                 VanadisInstruction* delay_ins = rob->pop();
+                retireIssuedPrefix(ins_thread, delay_ins);
                 #ifdef VANADIS_BUILD_DEBUG
                 output->verbose(
                     CALL_INFO, 8, VANADIS_DBG_RETIRE_FLG, "----> Retire delay: 0x%" PRI_ADDR " / %s\n", delay_ins->getInstructionAddress(),
@@ -1072,6 +1279,10 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                 #endif
                 ins_retired_this_cycle++;
 
+                if ( UNLIKELY(nullptr != bbv) ) {
+                    bbv->retire(ins_thread, delay_ins->getInstructionAddress(), true);
+                }
+
                 delete delay_ins;
             }
 
@@ -1114,7 +1325,7 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                         ins_thread, pipeline_reset_addr);
                 #endif
                 handleMisspeculate(ins_thread, pipeline_reset_addr);
-                stat_branch_mispredicts->addData(1);
+                if ( LIKELY(!fast_forward) ) stat_branch_mispredicts->addData(1);
             }
 
             delete rob_front;
@@ -1166,6 +1377,8 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                         "[syscall] -> syscallReturn not called"
                         "(ins-addr: 0x%0" PRI_ADDR " hw_thr: %d)...\n",
                         the_syscall_ins->getInstructionAddress(), ins_thread);
+                        // the thread can't make progress until the OS responds
+                        syscall_blocked[ins_thread] = true;
                     }
                     if ( flushLSQ ) {
                         output->verbose(
@@ -1189,7 +1402,7 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                 // We spent this cycle waiting on an issued SYSCALL, it has not resolved
                 // at the emulated OS component yet so we have to wait, potentiallty for
                 // a lot longer
-                stat_syscall_cycles->addData(1);
+                if ( LIKELY(!fast_forward) ) stat_syscall_cycles->addData(1);
 
                 return 3;
             }
@@ -1259,6 +1472,7 @@ VANADIS_COMPONENT::allocateFunctionalUnit(VanadisInstruction* ins)
         output->verbose(CALL_INFO, 16, 0, "allocating rocc%d instruction\n", rocc_index);
         if (!roccs_[rocc_index]->RoCCFull()) {
             output->verbose(CALL_INFO, 16, 0, "pushing to RoCC%d queue\n", rocc_index);
+            static_cast<VanadisRoCCInstruction*>(ins)->tag = rocc_next_tag_++;
             rocc_queues_[rocc_index].push_back(ins);
             allocated_fu = true;
         }
@@ -1267,7 +1481,7 @@ VANADIS_COMPONENT::allocateFunctionalUnit(VanadisInstruction* ins)
 
     case INST_LOAD:
         if ( !lsq->loadFull() ) {
-            stat_loads_issued->addData(1);
+            if ( LIKELY(!fast_forward) ) stat_loads_issued->addData(1);
             lsq->push(dynamic_cast<VanadisLoadInstruction*>(ins));
             allocated_fu = true;
         }
@@ -1275,7 +1489,7 @@ VANADIS_COMPONENT::allocateFunctionalUnit(VanadisInstruction* ins)
 
     case INST_STORE:
         if ( !lsq->storeFull() ) {
-            stat_stores_issued->addData(1);
+            if ( LIKELY(!fast_forward) ) stat_stores_issued->addData(1);
             lsq->push(dynamic_cast<VanadisStoreInstruction*>(ins));
             allocated_fu = true;
         }
@@ -1302,6 +1516,10 @@ VANADIS_COMPONENT::allocateFunctionalUnit(VanadisInstruction* ins)
         allocated_fu = mapInstructiontoFunctionalUnit(ins, fu_fp_div);
         break;
 
+    case INST_VECTOR:
+        allocated_fu = mapInstructiontoFunctionalUnit(ins, fu_vector);
+        break;
+
     case INST_FENCE:
     {
         VanadisFenceInstruction* fence_ins = dynamic_cast<VanadisFenceInstruction*>(ins);
@@ -1337,6 +1555,20 @@ VANADIS_COMPONENT::allocateFunctionalUnit(VanadisInstruction* ins)
     return allocated_fu ? 0 : 1;
 }
 
+// Clock handler, times tick() when host_tick_ns is enabled
+bool
+VANADIS_COMPONENT::timedTick(SST::Cycle_t cycle)
+{
+    if ( stat_host_tick_ns->isNullStatistic() || !stat_host_tick_ns->isEnabled() ) { return tick(cycle); }
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool unregister = tick(cycle);
+    stat_host_tick_ns->addData(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    stat_host_tick_calls->addData(1);
+    return unregister;
+}
+
 bool
 VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
 {
@@ -1350,7 +1582,9 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
     const auto output_verbosity = output->getVerboseLevel();
     #endif
 
-    stat_cycles->addData(1);
+    if ( UNLIKELY(nullptr != host_profile) ) host_profile->startCycle();
+
+    if ( LIKELY(!fast_forward) ) stat_cycles->addData(1);
     ins_issued_this_cycle  = 0;
     ins_retired_this_cycle = 0;
     ins_decoded_this_cycle = 0;
@@ -1378,6 +1612,13 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
         }
     }
 
+    if ( UNLIKELY(fast_forward) ) {
+        fastForward(cycle);
+        current_cycle++;
+        if ( UNLIKELY(nullptr != host_profile) ) host_profile->endStage(HOST_PROFILE_FASTFORWARD);
+        return false;
+    }
+
     #ifdef VANADIS_BUILD_DEBUG
     if(output_verbosity >= 2)
     {
@@ -1408,13 +1649,7 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
     #endif
 
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
-        const uint16_t zero_reg = isa_options[i]->getRegisterIgnoreWrites();
-
-        if ( zero_reg < isa_options[i]->countISAIntRegisters() ) {
-            VanadisISATable* thr_issue_table = issue_isa_tables[i];
-            const uint16_t   zero_phys_reg   = thr_issue_table->getIntPhysReg(zero_reg);
-            register_files[i]->setIntReg<uint64_t>(zero_phys_reg, 0);
-        }
+        resetZeroRegister(i);
     }
 
     #ifdef VANADIS_BUILD_DEBUG
@@ -1455,6 +1690,12 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
 
     // Record how many instructions we retired this cycle
     stat_ins_retired->addData(ins_retired_this_cycle);
+    detailed_retired += ins_retired_this_cycle;
+
+    if ( UNLIKELY(nullptr != host_profile) ) {
+        host_profile->addRetired(ins_retired_this_cycle);
+        host_profile->endStage(HOST_PROFILE_RETIRE);
+    }
 
     // Execute
     // //////////////////////////////////////////////////////////////////////////
@@ -1517,6 +1758,8 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
     // Record how many instructions we issued this cycle
     stat_ins_issued->addData(ins_issued_this_cycle);
 
+    if ( UNLIKELY(nullptr != host_profile) ) host_profile->endStage(HOST_PROFILE_ISSUE);
+
     // Decode
     // //////////////////////////////////////////////////////////////////////////
     #ifdef VANADIS_BUILD_DEBUG
@@ -1534,6 +1777,8 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
 
     stat_ins_decoded->addData(ins_decoded_this_cycle);
 
+    if ( UNLIKELY(nullptr != host_profile) ) host_profile->endStage(HOST_PROFILE_DECODE);
+
     // Fetch
     // //////////////////////////////////////////////////////////////////////////
     #ifdef VANADIS_BUILD_DEBUG
@@ -1549,6 +1794,8 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
         if ( performFetch(cycle) != 0 ) { break; }
     }
 
+    if ( UNLIKELY(nullptr != host_profile) ) host_profile->endStage(HOST_PROFILE_FETCH);
+
     uint64_t rob_total_count = 0;
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
         rob_total_count += rob[i]->size();
@@ -1570,16 +1817,190 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
     stat_int_phys_regs_in_use->addData(int_register_stack->capacity() - int_register_stack->unused());
     stat_fp_phys_regs_in_use->addData(fp_register_stack->capacity() - fp_register_stack->unused());
 
+    if ( UNLIKELY(nullptr != host_profile) ) host_profile->endStage(HOST_PROFILE_OTHER);
+
+    if ( UNLIKELY(detailed_instructions > 0) && detailed_retired >= detailed_instructions ) {
+        output->verbose(CALL_INFO, 1, 0, "Retired %" PRIu64 " micro-ops on the detailed pipeline. Core stops processing.\n", detailed_retired);
+        return true;
+    }
+
     if ( current_cycle >= max_cycle ) {
         output->verbose(CALL_INFO, 16, 0, "Reached maximum cycle %" PRIu64 ". Core stops processing.\n", current_cycle);
         //primaryComponentOKToEndSim();
         return true;
     }
+    else if ( UNLIKELY(sleep_when_blocked) && canSleep() ) {
+        output->verbose(CALL_INFO, 8, 0, "All threads are halted or blocked in the OS at cycle %" PRIu64 ", stop the clock.\n", current_cycle);
+        clock_off   = true;
+        sleep_cycle = cycle;
+        return true;
+    }
     else {
         return false;
     }
 }
 
+// A core can stop its clock when no thread can make progress until the OS
+// sends it something: every thread is halted or waiting on a syscall the OS
+// is holding (e.g., a futex wait), and nothing is left in the LSQ.
+bool
+VANADIS_COMPONENT::canSleep()
+{
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        if ( !halted_masks[i] && !syscall_blocked[i] ) { return false; }
+    }
+    for ( auto& queue : rocc_queues_ ) {
+        if ( !queue.empty() ) { return false; }
+    }
+    return 0 == lsq->storeSize() && 0 == lsq->loadSize();
+}
+
+void
+VANADIS_COMPONENT::wakeUp()
+{
+    Cycle_t next = reregisterClock(clock_tc_, clock_handler_);
+    // count the cycles that were skipped as if the core had ticked through them
+    uint64_t skipped = next - sleep_cycle - 1;
+    output->verbose(CALL_INFO, 8, 0, "Woken by the OS, restart the clock after %" PRIu64 " cycles.\n", skipped);
+    current_cycle += skipped;
+    stat_sleep_cycles->addData(skipped);
+    clock_off = false;
+}
+
+// Fast forward executes instructions one at a time in program order.
+// Arithmetic and branches execute as soon as they have registers and
+// retire straight away, so there is no issue window, functional unit
+// latency or speculation beyond what the decoder has already fetched.
+// Loads, stores, fences and system calls still go to the LSQ and OS and
+// the thread waits for them, which leaves the caches and branch predictor
+// warm when the detailed pipeline takes over.
+void
+VANADIS_COMPONENT::fastForward(const uint64_t cycle)
+{
+    stat_ff_cycles->addData(1);
+    ins_retired_this_cycle = 0;
+
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        resetZeroRegister(i);
+    }
+
+    // Only the LSQ and RoCC queues have anything in them
+    performExecute(cycle);
+
+    for ( uint32_t i = 0; i < hw_threads && fast_forward; ++i ) {
+        uint32_t count = 0;
+
+        while ( fast_forward && !halted_masks[i] && count < fastforward_width ) {
+            const uint32_t retired_before = ins_retired_this_cycle;
+            const int      issue_status   = fastForwardIssue(i, cycle);
+
+            while ( !rob[i]->empty() ) {
+                const auto rob_size = rob[i]->size();
+                performRetire(i, rob[i], cycle);
+                if ( rob[i]->size() >= rob_size ) { break; }
+            }
+
+            const uint32_t retired = ins_retired_this_cycle - retired_before;
+            fastforward_retired += retired;
+            count += retired;
+
+            if ( fastforward_instructions > 0 && fastforward_retired >= fastforward_instructions ) {
+                switchToDetailed("instruction count reached");
+            }
+
+            if ( issue_status != 0 && retired == 0 ) { break; }
+        }
+    }
+
+    stat_ff_ins->addData(ins_retired_this_cycle);
+}
+
+int
+VANADIS_COMPONENT::fastForwardIssue(const uint32_t thr, const uint64_t cycle)
+{
+    VanadisCircularQueue<VanadisInstruction*>* thr_rob = rob[thr];
+    VanadisInstruction*                        ins     = nullptr;
+
+    // Everything older than the next instruction must have finished, which
+    // keeps memory operations in program order
+    for ( size_t j = 0; j < thr_rob->size(); ++j ) {
+        VanadisInstruction* next = thr_rob->peekAt(j);
+
+        if ( !next->completedIssue() ) {
+            ins = next;
+            break;
+        }
+
+        if ( !next->completedExecution() ) { return 1; }
+    }
+
+    if ( nullptr == ins ) {
+        if ( !thr_rob->empty() ) { return 1; }
+
+        thread_decoders[thr]->tick(output, cycle);
+
+        // Still waiting on the instruction cache
+        if ( thr_rob->empty() ) { return 1; }
+
+        ins = thr_rob->peek();
+    }
+
+    // The instruction that triggers the switch is the first one to run on
+    // the detailed pipeline
+    if ( fastforward_until_address > 0 && ins->getInstructionAddress() == fastforward_until_address ) {
+        switchToDetailed("address reached");
+        return 1;
+    }
+
+    if ( fastforward_until_roi && ins->isROIMarker() ) {
+        switchToDetailed("region of interest marker reached");
+        return 1;
+    }
+
+    if ( 0 != checkInstructionResources(ins, int_register_stack, fp_register_stack, issue_isa_tables[thr]) ) {
+        return 1;
+    }
+
+    switch ( ins->getInstFuncType() ) {
+    case INST_INT_ARITH:
+    case INST_INT_DIV:
+    case INST_FP_ARITH:
+    case INST_FP_DIV:
+    case INST_VECTOR:
+    case INST_BRANCH:
+        assignRegistersToInstruction(
+            thread_decoders[thr]->countISAIntReg(), thread_decoders[thr]->countISAFPReg(), ins, int_register_stack,
+            fp_register_stack, issue_isa_tables[thr]);
+        ins->markIssued();
+        ins->execute(output, register_files);
+        resetZeroRegister(thr);
+        break;
+
+    default:
+        if ( 0 != allocateFunctionalUnit(ins) ) { return 1; }
+
+        assignRegistersToInstruction(
+            thread_decoders[thr]->countISAIntReg(), thread_decoders[thr]->countISAFPReg(), ins, int_register_stack,
+            fp_register_stack, issue_isa_tables[thr]);
+        ins->markIssued();
+        break;
+    }
+
+    return 0;
+}
+
+void
+VANADIS_COMPONENT::switchToDetailed(const char* reason)
+{
+    fast_forward = false;
+
+    output->verbose(
+        CALL_INFO, 1, 0,
+        "Fast forward finished (%s) after %" PRIu64 " instructions at cycle %" PRIu64 ", switching to the detailed "
+        "pipeline.\n",
+        reason, fastforward_retired, current_cycle);
+}
+
 int
 VANADIS_COMPONENT::checkInstructionResources(
     VanadisInstruction* ins, VanadisRegisterStack* int_regs, VanadisRegisterStack* fp_regs, VanadisISATable* isa_table)
@@ -1860,7 +2281,7 @@ VANADIS_COMPONENT::assignRegistersToInstruction(
                 vrocc_inst->func7, vrocc_inst->rd, vrocc_inst->xs1, vrocc_inst->xs2, vrocc_inst->xd
             );
 
-            roccs_[rocc_index]->push(new RoCCCommand(rocc_inst, rs1_val, rs2_val));
+            roccs_[rocc_index]->push(new RoCCCommand(rocc_inst, rs1_val, rs2_val, vrocc_inst->tag));
         }
     }
 
@@ -2103,6 +2524,7 @@ VANADIS_COMPONENT::handleMisspeculate(const uint32_t hw_thr, const uint64_t new_
     clearFuncUnit(hw_thr, fu_int_div);
     clearFuncUnit(hw_thr, fu_fp_arith);
     clearFuncUnit(hw_thr, fu_fp_div);
+    clearFuncUnit(hw_thr, fu_vector);
     clearFuncUnit(hw_thr, fu_branch);
 
     lsq->clearLSQByThreadID(hw_thr);
@@ -2147,6 +2569,7 @@ VANADIS_COMPONENT::clearROBMisspeculate(const uint32_t hw_thr)
 
     // clear the ROB entries and reset
     thr_rob->clear();
+    clearIssuedPrefix(hw_thr);
 }
 
 void
@@ -2177,6 +2600,7 @@ VANADIS_COMPONENT::syscallReturn(uint32_t thr)
         syscall_ins->getInstructionAddress());
     #endif
     syscall_ins->markExecuted();
+    syscall_blocked[thr] = false;
 
     if ( UNLIKELY( nullptr != m_checkpointing ) ) {
         if ( m_checkpointing[thr] ) {
@@ -2189,6 +2613,10 @@ VANADIS_COMPONENT::syscallReturn(uint32_t thr)
 void VANADIS_COMPONENT::recvOSEvent(SST::Event* ev) {
     output->verbose(CALL_INFO, 16, 0, "-> recv os response\n");
 
+    if ( UNLIKELY(clock_off) ) {
+        wakeUp();
+    }
+
     VanadisSyscallResponse* os_resp = dynamic_cast<VanadisSyscallResponse*>(ev);
 
     if (nullptr != os_resp) {
@@ -2320,6 +2748,7 @@ void VANADIS_COMPONENT::startThreadClone( VanadisStartThreadCloneReq* req )
     thr_decoder->setThreadPointer( output, isa_table, reg_file, req->getTlsAddr() );
 
     halted_masks[hw_thr]            = false;
+    syscall_blocked[hw_thr]         = false;
 
     output->verbose(CALL_INFO, 16, 0, "startThreadClone arrivedthrad fail HandleMissspeculate %d.\n", hw_thr);
     handleMisspeculate( hw_thr, req->getInstPtr() );
@@ -2358,6 +2787,7 @@ void VANADIS_COMPONENT::startThreadFork( VanadisStartThreadForkReq* req )
     thread_decoders[hw_thr]->setThreadLocalStoragePointer( req->getTlsAddr() );
 
     halted_masks[hw_thr]            = false;
+    syscall_blocked[hw_thr]         = false;
      output->verbose(
                     CALL_INFO, 16, 0,
                     "startThreadFork HandleMissspeculate.\n");
@@ -2449,6 +2879,7 @@ VANADIS_COMPONENT::checkpointLoad(FILE* fp)
             }
 
             halted_masks[hw_thr]            = false;
+            syscall_blocked[hw_thr]         = false;
             handleMisspeculate( hw_thr, startAddr );
         }
     }
@@ -2517,6 +2948,7 @@ VANADIS_COMPONENT::resetHwThread(uint32_t thr)
     auto thr_rob = rob[thr];
 
     thr_rob->clear();
+    clearIssuedPrefix(thr);
 
     #if 0
     output->setVerboseLevel( 16 );
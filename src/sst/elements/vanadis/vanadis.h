@@ -27,6 +27,8 @@
 #include "velf/velfinfo.h"
 #include "vfpflags.h"
 #include "vfuncunit.h"
+#include "util/vbbv.h"
+#include "util/vhostprofile.h"
 #include "rocc/vroccinterface.h"
 #include "rocc/vbasicrocc.h"
 
@@ -138,6 +140,8 @@ public:
         { "fp_arith_cycles", "Cycles per floating point arithmetic", "8" },
         { "fp_div_units", "Number of floating point division units", "1" },
         { "fp_div_cycles", "Cycles per floating point division", "80" },
+        { "vector_lanes", "Number of vector lanes, each executes one element of a vector instruction at a time", "1" },
+        { "vector_lane_cycles", "Cycles per element in a vector lane", "fp_arith_cycles" },
         { "branch_units", "Number of branch units", "1" },
         { "branch_unit_cycles", "Cycles per branch", "int_arith_cycles"},
         { "issues_per_cycle", "Number of instruction issues per cycle", "2" },
@@ -152,7 +156,16 @@ public:
         { "print_fp_reg", "Print floating-point registers true/false, auto set to "
                           "true if verbose > 16", "false" },
         { "print_rob", "Print reorder buffer state during issue and retire", "true"},
-        { "enable_simt", "Implement SIMT pipeline for multithread kernels", "false"}  )
+        { "enable_simt", "Implement SIMT pipeline for multithread kernels", "false"},
+        { "fastforward_instructions", "Execute this many instructions functionally before switching to the detailed pipeline. 0 disables the trigger.", "0"},
+        { "fastforward_until_address", "Execute functionally until an instruction at this address is reached, which is the first to run on the detailed pipeline. 0 disables the trigger.", "0"},
+        { "fastforward_until_roi", "Execute functionally until the region of interest marker (RISC-V: slti x0, x0, 1) is reached. The marker is the first instruction to run on the detailed pipeline.", "false"},
+        { "fastforward_width", "Maximum instructions per hardware thread executed each cycle while fast forwarding", "64"},
+        { "detailed_instructions", "Stop the core after this many micro-ops retire on the detailed pipeline. 0 runs to completion.", "0"},
+        { "bbv_file", "If specified, basic block vectors in SimPoint format are written to this file with the core id appended", ""},
+        { "bbv_interval", "Number of retired micro-ops in each basic block vector interval", "100000000"},
+        { "host_profile_file", "If specified, the host time spent in each pipeline stage is written as JSON to this file with the core id appended", ""},
+        { "sleep_when_blocked", "Stop clocking the core while every hardware thread is halted or blocked in a syscall the OS is holding (e.g., futex wait). The clock restarts when the OS sends the core an event.", "false"} )
 
     SST_ELI_DOCUMENT_STATISTICS(
         { "cycles", "Number of cycles the core executed", "cycles", 1 },
@@ -171,7 +184,12 @@ public:
         { "stores_issued", "Number of store instructions issued to the LSQ", "instructions", 1 },
         { "phys_int_reg_in_use", "Number of physical integer registers that are in use each cycle", "registers", 1 },
         { "phys_fp_reg_in_use", "Number of physical floating point registers than are in use each cycle", "registers",
-          1 })
+          1 },
+        { "fastforward_cycles", "Number of cycles the core spent fast forwarding. These are not included in cycles.", "cycles", 1 },
+        { "fastforward_instructions", "Number of instructions executed while fast forwarding. These are not included in the other instruction counts.", "instructions", 1 },
+        { "sleep_cycles", "Number of cycles the core's clock was stopped by sleep_when_blocked. These are not included in cycles.", "cycles", 1 },
+        { "host_tick_ns", "Host (wall clock) time spent in the clock handler. Only measured while the statistic is enabled", "nanoseconds", 5 },
+        { "host_tick_calls", "Number of clock handler calls included in host_tick_ns", "calls", 5 })
 
     SST_ELI_DOCUMENT_PORTS({ "icache_link", "Connects the CPU to the instruction cache", {} },
                            { "dcache_link", "Connects the CPU to the data cache", {} },
@@ -210,6 +228,8 @@ public:
     void clearFuncUnit(const uint32_t hw_thr, std::vector<VanadisFunctionalUnit*>& unit);
 
     void syscallReturn(uint32_t thr);
+    bool canSleep();
+    void wakeUp();
     void setHalt(uint32_t thr, int64_t halt_code);
     void startThread(int thr, uint64_t stackStart, uint64_t instructionPointer );
     void startThreadFork( VanadisStartThreadForkReq* req );
@@ -229,8 +249,15 @@ private:
 #endif
 
     virtual bool tick(SST::Cycle_t);
+    bool timedTick(SST::Cycle_t);
 
     void resetRegisterUseTemps(const uint16_t i_reg, const uint16_t f_reg);
+    void resetZeroRegister(const uint32_t thr);
+
+    void advanceIssuedPrefix(const uint32_t thr);
+    void retireIssuedPrefix(const uint32_t thr, VanadisInstruction* ins);
+    void clearIssuedPrefix(const uint32_t thr);
+    bool writesIgnoredRegister(const uint32_t thr, VanadisInstruction* ins);
 
     int assignRegistersToInstruction(
         const uint16_t int_reg_count, const uint16_t fp_reg_count, VanadisInstruction* ins,
@@ -257,6 +284,11 @@ private:
     bool mapInstructiontoFunctionalUnit(VanadisInstruction* ins, std::vector<VanadisFunctionalUnit*>& functional_units);
     void printRob(int rob_num, VanadisCircularQueue<VanadisInstruction*>* rob);
 
+    // Functional fast forward, see fastForward() in vanadis.cc
+    void fastForward(const uint64_t cycle);
+    int  fastForwardIssue(const uint32_t thr, const uint64_t cycle);
+    void switchToDetailed(const char* reason);
+
     bool checkVerboseAddr( uint64_t addr ) {
         for ( auto& it : start_verbose_when_issue_address ) {
             if ( it == addr ) return true;
@@ -307,6 +339,7 @@ private:
     std::vector<VanadisFunctionalUnit*> fu_branch;
     std::vector<VanadisFunctionalUnit*> fu_fp_arith;
     std::vector<VanadisFunctionalUnit*> fu_fp_div;
+    std::vector<VanadisFunctionalUnit*> fu_vector;
 
     std::vector<VanadisRegisterFile*>  register_files;
     VanadisRegisterStack* int_register_stack;
@@ -320,6 +353,13 @@ private:
     std::vector<uint8_t*> tmp_not_issued_fp_reg_read;
     std::vector<uint8_t*> tmp_fp_reg_write;
 
+    // Number of entries at the front of each ROB known to have issued, the
+    // issue scan starts after them.  Their writes are already pending in the
+    // issue table, apart from writes to the register which ignores writes,
+    // so the entries which make one of those are counted separately
+    std::vector<uint32_t> rob_issued_prefix;
+    std::vector<uint32_t> rob_issued_prefix_ignored_writes;
+
     std::list<VanadisInsCacheLoadRecord*>* icache_load_records;
 
     VanadisLoadStoreQueue* lsq;
@@ -327,6 +367,7 @@ private:
 
     std::vector<VanadisRoCCInterface*> roccs_;
     std::vector<std::deque<VanadisInstruction*>> rocc_queues_;
+    uint64_t rocc_next_tag_;
 
     bool* halted_masks;
     bool  print_int_reg;
@@ -358,6 +399,11 @@ private:
     Statistic<uint64_t>* stat_syscall_cycles;
     Statistic<uint64_t>* stat_int_phys_regs_in_use;
     Statistic<uint64_t>* stat_fp_phys_regs_in_use;
+    Statistic<uint64_t>* stat_ff_cycles;
+    Statistic<uint64_t>* stat_ff_ins;
+    Statistic<uint64_t>* stat_sleep_cycles;
+    Statistic<uint64_t>* stat_host_tick_ns;
+    Statistic<uint64_t>* stat_host_tick_calls;
 
     uint32_t ins_issued_this_cycle;
     uint32_t ins_retired_this_cycle;
@@ -367,6 +413,24 @@ private:
     std::deque<uint64_t> start_verbose_when_issue_address;
     uint64_t stop_verbose_when_retire_address;
 
+    bool     fast_forward;
+    uint64_t fastforward_instructions;
+    uint64_t fastforward_until_address;
+    bool     fastforward_until_roi;
+    uint32_t fastforward_width;
+    uint64_t fastforward_retired;
+
+    uint64_t detailed_instructions;
+    uint64_t detailed_retired;
+
+    bool              sleep_when_blocked;
+    bool              clock_off;
+    Cycle_t           sleep_cycle;
+    std::vector<bool> syscall_blocked;   // waiting on a syscall the OS has not answered
+
+    VanadisBasicBlockVector* bbv;
+    VanadisHostProfile*      host_profile;
+
     std::vector<VanadisFloatingPointFlags*> fp_flags;
     std::vector<VanadisStartThreadCloneReq*> cloneReqs;
 
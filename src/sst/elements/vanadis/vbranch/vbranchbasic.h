@@ -94,6 +94,17 @@ public:
         return found;
     }
 
+    virtual bool peekTarget(const uint64_t addr, uint64_t* target) {
+        auto predict_itr = predict.find(addr);
+
+        if (predict_itr == predict.end()) {
+            return false;
+        }
+
+        *target = predict_itr->second;
+        return true;
+    }
+
 protected:
     void lru_reorder(const uint64_t addr) {
         for (auto lru_itr = lru_keeper.begin(); lru_itr != lru_keeper.end();) {
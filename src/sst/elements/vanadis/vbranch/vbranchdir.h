@@ -0,0 +1,301 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_UNIT_DIRECTION
+#define _H_VANADIS_BRANCH_UNIT_DIRECTION
+
+#include "vbranch/vbranchhist.h"
+#include "vbranch/vbranchunit.h"
+#include "vbranch/vbtb.h"
+#include "vbranch/vittage.h"
+#include "vbranch/vras.h"
+
+#include <sst/core/output.h>
+#include <sst/core/unitAlgebra.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+#define VANADIS_DIRECTION_BRANCH_UNIT_ELI_PARAMS \
+    { "verbose", "Set the verbosity of output, level 1 prints the priced storage of each structure", "0" }, \
+    { "storage_budget", "Fatal error if the priced storage of the whole unit is larger than this. " \
+                        "Units of B or b with SI prefixes, 0B for no limit", "0B" }, \
+    { "btb_sets", "Number of sets in the branch target buffer", "256" }, \
+    { "btb_ways", "Associativity of the branch target buffer", "4" }, \
+    { "btb_tag_bits", "Width of the partial tags kept in the branch target buffer", "16" }, \
+    { "ras_entries", "Number of entries in the return address stack, 0 disables it", "32" }, \
+    { "ittage_tables", "Number of tagged tables in the ITTAGE indirect target predictor, 0 disables it", "6" }, \
+    { "ittage_log_entries", "Log2 of the number of entries in each ITTAGE table", "8" }, \
+    { "ittage_tag_bits", "Width of the ITTAGE tags", "11" }, \
+    { "ittage_min_history", "Shortest global history used by ITTAGE", "4" }, \
+    { "ittage_max_history", "Longest global history used by ITTAGE", "256" }
+
+#define VANADIS_DIRECTION_BRANCH_UNIT_ELI_STATS \
+    { "conditional_branches", "Conditional branches retired", "branches", 1 }, \
+    { "conditional_mispredicts", "Retired conditional branches whose direction the tables got wrong", "branches", 1 }, \
+    { "indirect_branches", "Indirect jumps and calls retired", "branches", 1 }, \
+    { "indirect_mispredicts", "Retired indirect jumps and calls whose target was predicted wrongly", "branches", 1 }, \
+    { "returns", "Returns retired", "branches", 1 }, \
+    { "return_mispredicts", "Retired returns the return address stack got wrong", "branches", 1 }, \
+    { "btb_misses", "Retired taken direct branches whose target was not in the branch target buffer", "branches", 1 }
+
+// Common part of the history based predictors.  Targets come from the BTB,
+// the return address stack and ITTAGE, so subclasses only predict the
+// direction of conditional branches.
+//
+// Predictions at decode use a speculative copy of the global history which
+// already holds the outcomes predicted for older, still in flight,
+// branches.  Training happens at retire against the retired copy.  A branch
+// only retires if every older branch was predicted correctly, so at that
+// point both copies held the same history and the tables see the same
+// indices at both ends.  Flushes copy the retired state back.
+class VanadisDirectionBranchUnit : public VanadisBranchUnit
+{
+public:
+    VanadisDirectionBranchUnit(ComponentId_t id, Params& params) :
+        VanadisBranchUnit(id, params),
+        btb(params.find<uint32_t>("btb_sets", 256), params.find<uint32_t>("btb_ways", 4),
+            params.find<uint32_t>("btb_tag_bits", 16)),
+        spec_ras(params.find<uint32_t>("ras_entries", 32)),
+        retired_ras(params.find<uint32_t>("ras_entries", 32)),
+        ittage(nullptr)
+    {
+        const uint32_t verbosity = params.find<uint32_t>("verbose", 0);
+        output                   = new SST::Output("[branch " + getName() + "]: ", verbosity, 0, SST::Output::STDOUT);
+
+        if ( params.find<uint32_t>("btb_sets", 256) == 0 || params.find<uint32_t>("btb_ways", 4) == 0 ) {
+            output->fatal(CALL_INFO, -1, "Error: btb_sets and btb_ways must be greater than zero.\n");
+        }
+
+        const uint32_t ittage_tables = params.find<uint32_t>("ittage_tables", 6);
+        if ( ittage_tables > 0 ) {
+            ittage = new VanadisITTAGE(
+                ittage_tables, params.find<uint32_t>("ittage_log_entries", 8), params.find<uint32_t>("ittage_tag_bits", 11),
+                params.find<uint32_t>("ittage_min_history", 4), params.find<uint32_t>("ittage_max_history", 256),
+                spec_hist, retired_hist);
+        }
+
+        UnitAlgebra budget = params.find<UnitAlgebra>("storage_budget", "0B");
+        if ( !budget.hasUnits("B") && !budget.hasUnits("b") ) {
+            output->fatal(CALL_INFO, -1, "Error: storage_budget must be specified in B or b (SI prefixes allowed), got %s\n",
+                budget.toStringBestSI().c_str());
+        }
+        if ( budget.hasUnits("B") ) { budget *= UnitAlgebra("8b/B"); }
+        storage_budget_bits = budget.getRoundedValue();
+
+        stat_cond_branches    = registerStatistic<uint64_t>("conditional_branches", "1");
+        stat_cond_mispredicts = registerStatistic<uint64_t>("conditional_mispredicts", "1");
+        stat_ind_branches     = registerStatistic<uint64_t>("indirect_branches", "1");
+        stat_ind_mispredicts  = registerStatistic<uint64_t>("indirect_mispredicts", "1");
+        stat_returns          = registerStatistic<uint64_t>("returns", "1");
+        stat_ret_mispredicts  = registerStatistic<uint64_t>("return_mispredicts", "1");
+        stat_btb_misses       = registerStatistic<uint64_t>("btb_misses", "1");
+    }
+
+    virtual ~VanadisDirectionBranchUnit()
+    {
+        delete ittage;
+        delete output;
+    }
+
+    uint64_t predict(const uint64_t ins_addr, const uint64_t fallthrough_addr, const VanadisBranchType type) override
+    {
+        uint64_t target = fallthrough_addr;
+
+        switch ( type ) {
+        case VANADIS_BRANCH_CONDITIONAL:
+        {
+            uint64_t btb_target = 0;
+            if ( predictTaken(ins_addr, spec_hist) && btb.lookup(ins_addr, &btb_target) ) { target = btb_target; }
+
+            // Only a redirect counts as taken, that is what the retired
+            // history will see if this prediction turns out right
+            const bool redirect = (target != fallthrough_addr);
+            speculateTaken(ins_addr, redirect);
+            spec_hist.push(redirect, ins_addr);
+        } break;
+        case VANADIS_BRANCH_DIRECT_CALL:
+            spec_ras.push(fallthrough_addr);
+            // fall through
+        case VANADIS_BRANCH_DIRECT_JUMP:
+            btb.lookup(ins_addr, &target);
+            break;
+        case VANADIS_BRANCH_INDIRECT_CALL:
+            spec_ras.push(fallthrough_addr);
+            // fall through
+        case VANADIS_BRANCH_INDIRECT_JUMP:
+            if ( nullptr == ittage || !ittage->predict(ins_addr, spec_hist, &target) ) { btb.lookup(ins_addr, &target); }
+            spec_hist.push(targetBit(target), ins_addr);
+            break;
+        case VANADIS_BRANCH_RETURN:
+            if ( !spec_ras.pop(&target) ) { btb.lookup(ins_addr, &target); }
+            break;
+        }
+
+        return target;
+    }
+
+    void update(
+        const uint64_t ins_addr, const uint64_t fallthrough_addr, const uint64_t taken_addr,
+        const VanadisBranchType type) override
+    {
+        const bool taken = (taken_addr != fallthrough_addr);
+
+        switch ( type ) {
+        case VANADIS_BRANCH_CONDITIONAL:
+            stat_cond_branches->addData(1);
+            if ( trainTaken(ins_addr, retired_hist, taken) != taken ) { stat_cond_mispredicts->addData(1); }
+            if ( taken ) { updateBTB(ins_addr, taken_addr); }
+            retired_hist.push(taken, ins_addr);
+            break;
+        case VANADIS_BRANCH_DIRECT_CALL:
+            retired_ras.push(fallthrough_addr);
+            // fall through
+        case VANADIS_BRANCH_DIRECT_JUMP:
+            updateBTB(ins_addr, taken_addr);
+            break;
+        case VANADIS_BRANCH_INDIRECT_CALL:
+            retired_ras.push(fallthrough_addr);
+            // fall through
+        case VANADIS_BRANCH_INDIRECT_JUMP:
+        {
+            stat_ind_branches->addData(1);
+
+            uint64_t predicted = fallthrough_addr;
+            if ( nullptr == ittage || !ittage->predict(ins_addr, retired_hist, &predicted) ) {
+                btb.lookup(ins_addr, &predicted);
+            }
+            if ( predicted != taken_addr ) { stat_ind_mispredicts->addData(1); }
+
+            if ( nullptr != ittage ) { ittage->update(ins_addr, retired_hist, taken_addr, predicted == taken_addr); }
+            btb.insert(ins_addr, taken_addr);
+            retired_hist.push(targetBit(taken_addr), ins_addr);
+        } break;
+        case VANADIS_BRANCH_RETURN:
+        {
+            stat_returns->addData(1);
+
+            uint64_t ras_target = 0;
+            if ( !retired_ras.pop(&ras_target) || ras_target != taken_addr ) { stat_ret_mispredicts->addData(1); }
+            btb.insert(ins_addr, taken_addr);
+        } break;
+        }
+    }
+
+    void squash() override
+    {
+        spec_hist = retired_hist;
+        spec_ras  = retired_ras;
+        squashDirection();
+    }
+
+    // The target cache interface, served from the BTB
+    void push(const uint64_t ins_addr, const uint64_t pred_addr) override { btb.insert(ins_addr, pred_addr); }
+
+    uint64_t predictAddress(const uint64_t addr) override
+    {
+        uint64_t target = 0;
+        btb.lookup(addr, &target);
+        return target;
+    }
+
+    bool contains(const uint64_t addr) override
+    {
+        uint64_t target = 0;
+        return btb.lookup(addr, &target);
+    }
+
+    // The BTB only holds targets of branches that have been taken
+    bool peekTarget(const uint64_t addr, uint64_t* target) override { return btb.peek(addr, target); }
+
+protected:
+    // Direction of a conditional branch at decode
+    virtual bool predictTaken(const uint64_t ins_addr, const VanadisBranchHistory& hist) = 0;
+
+    // Trains on a retired conditional branch, returns the direction the
+    // tables predicted before training
+    virtual bool trainTaken(const uint64_t ins_addr, const VanadisBranchHistory& hist, const bool taken) = 0;
+
+    // Direction fetch follows for a conditional branch, for speculative
+    // state the subclass keeps outside of the history
+    virtual void speculateTaken(const uint64_t ins_addr, const bool taken) {}
+    virtual void squashDirection() {}
+
+    // Size in bits of each direction predictor structure
+    virtual void priceDirection(std::vector<std::pair<std::string, uint64_t>>& prices) const = 0;
+
+    // Called at the end of the subclass constructor once every table and
+    // fold is allocated
+    void priceStorage()
+    {
+        std::vector<std::pair<std::string, uint64_t>> prices;
+        priceDirection(prices);
+        prices.emplace_back("global history", spec_hist.getStorageBits());
+        prices.emplace_back("btb", btb.getStorageBits());
+        prices.emplace_back("ras", spec_ras.getStorageBits());
+        if ( nullptr != ittage ) { prices.emplace_back("ittage", ittage->getStorageBits()); }
+
+        uint64_t total = 0;
+        for ( const auto& p : prices ) {
+            output->verbose(
+                CALL_INFO, 1, 0, "storage %-16s %10" PRIu64 " bits (%.2f KiB)\n", p.first.c_str(), p.second,
+                p.second / 8192.0);
+            total += p.second;
+        }
+        output->verbose(CALL_INFO, 1, 0, "storage %-16s %10" PRIu64 " bits (%.2f KiB)\n", "total", total, total / 8192.0);
+
+        if ( storage_budget_bits > 0 && total > storage_budget_bits ) {
+            output->fatal(
+                CALL_INFO, -1, "Error: %s needs %" PRIu64 " bits of storage, storage_budget is %" PRIu64 " bits.\n",
+                getName().c_str(), total, storage_budget_bits);
+        }
+    }
+
+    void updateBTB(const uint64_t ins_addr, const uint64_t taken_addr)
+    {
+        uint64_t btb_target = 0;
+        if ( !btb.lookup(ins_addr, &btb_target) || btb_target != taken_addr ) { stat_btb_misses->addData(1); }
+        btb.insert(ins_addr, taken_addr);
+    }
+
+    static bool targetBit(const uint64_t target) { return ((target >> 2) ^ (target >> 5)) & 1; }
+
+    SST::Output* output;
+
+    VanadisBranchHistory      spec_hist;
+    VanadisBranchHistory      retired_hist;
+    VanadisBranchTargetBuffer btb;
+    VanadisReturnAddressStack spec_ras;
+    VanadisReturnAddressStack retired_ras;
+    VanadisITTAGE*            ittage;
+    uint64_t                  storage_budget_bits;
+
+    Statistic<uint64_t>* stat_cond_branches;
+    Statistic<uint64_t>* stat_cond_mispredicts;
+    Statistic<uint64_t>* stat_ind_branches;
+    Statistic<uint64_t>* stat_ind_mispredicts;
+    Statistic<uint64_t>* stat_returns;
+    Statistic<uint64_t>* stat_ret_mispredicts;
+    Statistic<uint64_t>* stat_btb_misses;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,176 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_HISTORY
+#define _H_VANADIS_BRANCH_HISTORY
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// Global branch history shared by the tables of a predictor.  Very long
+// histories are never hashed directly, instead each table registers the
+// history length it wants folded down to the width of its index or tag
+// and the fold is kept up to date as outcomes are pushed (Seznec's
+// circular-shift folding).  A predictor keeps one copy that runs ahead
+// at decode and one that only sees retired branches, so recovering from
+// a flush is a plain copy.
+class VanadisBranchHistory
+{
+public:
+    VanadisBranchHistory() : ring(64, 0), head(0), path(0) {}
+
+    // Returns the id to pass to getFolded, only valid before the first push
+    uint32_t addFolded(const uint32_t length, const uint32_t width)
+    {
+        Folded f;
+        f.value    = 0;
+        f.length   = length;
+        f.width    = width;
+        f.outpoint = (width > 0) ? (length % width) : 0;
+        folded.push_back(f);
+
+        while ( ring.size() <= length ) {
+            ring.resize(ring.size() * 2, 0);
+        }
+
+        return folded.size() - 1;
+    }
+
+    void push(const bool taken, const uint64_t ins_addr)
+    {
+        head       = (head + ring.size() - 1) & (ring.size() - 1);
+        ring[head] = taken ? 1 : 0;
+
+        for ( Folded& f : folded ) {
+            if ( 0 == f.width ) { continue; }
+
+            f.value = (f.value << 1) | ring[head];
+            f.value ^= static_cast<uint64_t>(bit(f.length)) << f.outpoint;
+            f.value ^= (f.value >> f.width);
+            f.value &= (UINT64_C(1) << f.width) - 1;
+        }
+
+        path = (path << 1) | ((ins_addr >> 2) & 1);
+    }
+
+    // i-th most recent outcome, 0 is the newest
+    uint8_t  bit(const uint32_t i) const { return ring[(head + i) & (ring.size() - 1)]; }
+    uint64_t getFolded(const uint32_t id) const { return folded[id].value; }
+    uint64_t getPath() const { return path; }
+
+    uint64_t getStorageBits() const
+    {
+        uint64_t bits = 64;
+        uint32_t longest = 0;
+        for ( const Folded& f : folded ) {
+            bits += f.width;
+            if ( f.length > longest ) { longest = f.length; }
+        }
+        return bits + longest;
+    }
+
+protected:
+    struct Folded {
+        uint64_t value;
+        uint32_t length;
+        uint32_t width;
+        uint32_t outpoint;
+    };
+
+    std::vector<uint8_t> ring;
+    uint32_t             head;
+    uint64_t             path;
+    std::vector<Folded>  folded;
+};
+
+// History lengths in a geometric series from min_length to max_length
+// as used by TAGE and O-GEHL
+inline std::vector<uint32_t>
+vanadisGeometricHistory(const uint32_t count, const uint32_t min_length, const uint32_t max_length)
+{
+    std::vector<uint32_t> lengths(count, min_length);
+
+    for ( uint32_t i = 1; i < count; ++i ) {
+        const double ratio = std::pow(
+            static_cast<double>(max_length) / static_cast<double>(min_length),
+            static_cast<double>(i) / static_cast<double>(count - 1));
+        lengths[i] = static_cast<uint32_t>(min_length * ratio + 0.5);
+    }
+
+    return lengths;
+}
+
+// Index and tag hashing for one tagged table of a TAGE style predictor.
+// The folds are registered on both the speculative and the retired history
+// so the ids are the same in each.
+class VanadisTaggedTableHash
+{
+public:
+    VanadisTaggedTableHash(
+        const uint32_t table, const uint32_t history_length, const uint32_t log_size, const uint32_t tag_width,
+        VanadisBranchHistory& spec_hist, VanadisBranchHistory& retired_hist) :
+        table_no(table),
+        length(history_length),
+        log_entries(log_size),
+        tag_bits(tag_width)
+    {
+        idx_fold  = spec_hist.addFolded(length, log_entries);
+        tag_fold1 = spec_hist.addFolded(length, tag_bits);
+        tag_fold2 = spec_hist.addFolded(length, tag_bits - 1);
+
+        retired_hist.addFolded(length, log_entries);
+        retired_hist.addFolded(length, tag_bits);
+        retired_hist.addFolded(length, tag_bits - 1);
+    }
+
+    uint32_t index(const uint64_t ins_addr, const VanadisBranchHistory& hist) const
+    {
+        const uint64_t pc        = ins_addr >> 1;
+        const uint32_t path_bits = (length < 16) ? length : 16;
+        uint64_t       path      = hist.getPath() & ((UINT64_C(1) << path_bits) - 1);
+        path                     = path ^ (path >> log_entries) ^ (path << (table_no % log_entries));
+
+        return static_cast<uint32_t>(
+            (pc ^ (pc >> (log_entries - (table_no % log_entries))) ^ hist.getFolded(idx_fold) ^ path) &
+            ((UINT64_C(1) << log_entries) - 1));
+    }
+
+    uint32_t tag(const uint64_t ins_addr, const VanadisBranchHistory& hist) const
+    {
+        const uint64_t pc = ins_addr >> 1;
+        return static_cast<uint32_t>(
+            (pc ^ hist.getFolded(tag_fold1) ^ (hist.getFolded(tag_fold2) << 1)) & ((UINT64_C(1) << tag_bits) - 1));
+    }
+
+    uint32_t getHistoryLength() const { return length; }
+
+protected:
+    uint32_t table_no;
+    uint32_t length;
+    uint32_t log_entries;
+    uint32_t tag_bits;
+    uint32_t idx_fold;
+    uint32_t tag_fold1;
+    uint32_t tag_fold2;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,159 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_UNIT_PERCEPTRON
+#define _H_VANADIS_BRANCH_UNIT_PERCEPTRON
+
+#include "vbranch/vbranchdir.h"
+
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// Hashed perceptron (Tarjan and Skadron, with geometric history lengths as
+// in O-GEHL).  Each table holds weights indexed by a hash of the PC and
+// one global history length, the prediction is the sign of their sum.
+// Training uses Seznec's adaptive threshold.
+class VanadisPerceptronBranchUnit : public VanadisDirectionBranchUnit
+{
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(VanadisPerceptronBranchUnit, "vanadis", "VanadisPerceptronBranchUnit",
+                                  SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                  "Hashed perceptron direction predictor with a BTB, return address stack and "
+                                  "ITTAGE indirect target predictor",
+                                  SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS(VANADIS_DIRECTION_BRANCH_UNIT_ELI_PARAMS,
+                            { "perceptron_tables", "Number of weight tables, the first is indexed by the PC alone", "16" },
+                            { "perceptron_log_entries", "Log2 of the number of weights in each table", "10" },
+                            { "perceptron_weight_bits", "Width of each weight", "8" },
+                            { "perceptron_min_history", "Shortest global history used by a weight table", "3" },
+                            { "perceptron_max_history", "Longest global history used by a weight table", "256" })
+
+    SST_ELI_DOCUMENT_STATISTICS(VANADIS_DIRECTION_BRANCH_UNIT_ELI_STATS)
+
+    VanadisPerceptronBranchUnit(ComponentId_t id, Params& params) : VanadisDirectionBranchUnit(id, params)
+    {
+        const uint32_t tables = params.find<uint32_t>("perceptron_tables", 16);
+        log_entries           = params.find<uint32_t>("perceptron_log_entries", 10);
+        weight_bits           = params.find<uint32_t>("perceptron_weight_bits", 8);
+
+        if ( tables < 2 || log_entries == 0 || weight_bits < 2 || weight_bits > 8 ) {
+            output->fatal(CALL_INFO, -1,
+                "Error: perceptron_tables must be at least 2, perceptron_log_entries non-zero and "
+                "perceptron_weight_bits between 2 and 8.\n");
+        }
+
+        const std::vector<uint32_t> lengths = vanadisGeometricHistory(
+            tables - 1, params.find<uint32_t>("perceptron_min_history", 3),
+            params.find<uint32_t>("perceptron_max_history", 256));
+
+        folds.push_back(0);
+        for ( uint32_t i = 0; i + 1 < tables; ++i ) {
+            folds.push_back(spec_hist.addFolded(lengths[i], log_entries));
+            retired_hist.addFolded(lengths[i], log_entries);
+        }
+
+        weights.resize(tables, std::vector<int8_t>(static_cast<size_t>(1) << log_entries, 0));
+
+        weight_max = (1 << (weight_bits - 1)) - 1;
+        weight_min = -(1 << (weight_bits - 1));
+        threshold  = static_cast<int32_t>(1.93 * tables + 14);
+        tc         = 0;
+
+        priceStorage();
+    }
+
+protected:
+    bool predictTaken(const uint64_t ins_addr, const VanadisBranchHistory& hist) override
+    {
+        return sum(ins_addr, hist) >= 0;
+    }
+
+    bool trainTaken(const uint64_t ins_addr, const VanadisBranchHistory& hist, const bool taken) override
+    {
+        const int32_t total = sum(ins_addr, hist);
+        const bool    pred  = (total >= 0);
+
+        if ( pred != taken ) {
+            if ( ++tc >= 63 ) {
+                threshold++;
+                tc = 0;
+            }
+        }
+        else if ( std::abs(total) <= threshold ) {
+            if ( --tc <= -64 ) {
+                if ( threshold > 1 ) { threshold--; }
+                tc = 0;
+            }
+        }
+
+        if ( pred != taken || std::abs(total) <= threshold ) {
+            for ( uint32_t i = 0; i < weights.size(); ++i ) {
+                int8_t& w = weights[i][index(ins_addr, hist, i)];
+                if ( taken && w < weight_max ) { w++; }
+                else if ( !taken && w > weight_min ) {
+                    w--;
+                }
+            }
+        }
+
+        return pred;
+    }
+
+    int32_t sum(const uint64_t ins_addr, const VanadisBranchHistory& hist) const
+    {
+        int32_t total = 0;
+        for ( uint32_t i = 0; i < weights.size(); ++i ) {
+            total += weights[i][index(ins_addr, hist, i)];
+        }
+        return total;
+    }
+
+    uint32_t index(const uint64_t ins_addr, const VanadisBranchHistory& hist, const uint32_t table) const
+    {
+        const uint64_t pc = ins_addr >> 1;
+        uint64_t       h  = pc ^ (pc >> log_entries);
+        if ( table > 0 ) { h ^= hist.getFolded(folds[table]) ^ (static_cast<uint64_t>(table) * 0x9E3779B1u); }
+
+        return static_cast<uint32_t>(h & ((UINT64_C(1) << log_entries) - 1));
+    }
+
+    void priceDirection(std::vector<std::pair<std::string, uint64_t>>& prices) const override
+    {
+        prices.emplace_back(
+            "perceptron", static_cast<uint64_t>(weights.size()) * (UINT64_C(1) << log_entries) * weight_bits + 12 + 7);
+    }
+
+    uint32_t log_entries;
+    uint32_t weight_bits;
+    int32_t  weight_max;
+    int32_t  weight_min;
+    int32_t  threshold;
+    int32_t  tc;
+
+    std::vector<uint32_t>            folds;
+    std::vector<std::vector<int8_t>> weights;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,544 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_UNIT_TAGE
+#define _H_VANADIS_BRANCH_UNIT_TAGE
+
+#include "vbranch/vbranchdir.h"
+
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// TAGE-SC-L (Seznec, CBP-5): a TAGE direction predictor whose prediction
+// can be overturned by a statistical corrector (a small GEHL predictor fed
+// with the TAGE prediction) and by a loop predictor for loops with a
+// constant trip count.
+class VanadisTAGESCLBranchUnit : public VanadisDirectionBranchUnit
+{
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(VanadisTAGESCLBranchUnit, "vanadis", "VanadisTAGESCLBranchUnit",
+                                  SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                  "TAGE-SC-L direction predictor with a BTB, return address stack and ITTAGE "
+                                  "indirect target predictor",
+                                  SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS(VANADIS_DIRECTION_BRANCH_UNIT_ELI_PARAMS,
+                            { "tage_tables", "Number of tagged TAGE tables", "12" },
+                            { "tage_log_entries", "Log2 of the number of entries in each tagged table", "10" },
+                            { "tage_tag_bits", "Width of the TAGE tags", "11" },
+                            { "tage_log_bimodal", "Log2 of the number of entries in the bimodal base table", "13" },
+                            { "tage_min_history", "Shortest global history used by TAGE", "4" },
+                            { "tage_max_history", "Longest global history used by TAGE", "640" },
+                            { "tage_useful_reset_log", "Useful counters are halved every 2^N updates", "18" },
+                            { "sc_tables", "Number of statistical corrector tables including the bias table, 0 disables it", "4" },
+                            { "sc_log_entries", "Log2 of the number of entries in each statistical corrector table", "10" },
+                            { "sc_counter_bits", "Width of the statistical corrector counters", "6" },
+                            { "sc_max_history", "Longest global history used by the statistical corrector", "32" },
+                            { "loop_entries", "Number of loop predictor entries, 0 disables it", "64" },
+                            { "loop_ways", "Associativity of the loop predictor", "4" })
+
+    SST_ELI_DOCUMENT_STATISTICS(VANADIS_DIRECTION_BRANCH_UNIT_ELI_STATS,
+                                { "sc_overrides", "Retired conditional branches where the statistical corrector "
+                                  "overturned TAGE", "branches", 1 },
+                                { "loop_overrides", "Retired conditional branches where the loop predictor "
+                                  "overturned TAGE-SC", "branches", 1 })
+
+    VanadisTAGESCLBranchUnit(ComponentId_t id, Params& params) : VanadisDirectionBranchUnit(id, params)
+    {
+        const uint32_t tables = params.find<uint32_t>("tage_tables", 12);
+        tage_log_entries      = params.find<uint32_t>("tage_log_entries", 10);
+        tage_tag_bits         = params.find<uint32_t>("tage_tag_bits", 11);
+        tage_log_bimodal      = params.find<uint32_t>("tage_log_bimodal", 13);
+        useful_reset_log      = params.find<uint32_t>("tage_useful_reset_log", 18);
+
+        if ( tables == 0 || tage_log_entries == 0 || tage_tag_bits < 2 || tage_tag_bits > 16 ) {
+            output->fatal(CALL_INFO, -1, "Error: tage_tables must be non-zero and tage_tag_bits between 2 and 16.\n");
+        }
+
+        const std::vector<uint32_t> lengths = vanadisGeometricHistory(
+            tables, params.find<uint32_t>("tage_min_history", 4), params.find<uint32_t>("tage_max_history", 640));
+
+        for ( uint32_t i = 0; i < tables; ++i ) {
+            tage_hash.emplace_back(i, lengths[i], tage_log_entries, tage_tag_bits, spec_hist, retired_hist);
+            tage.emplace_back(static_cast<size_t>(1) << tage_log_entries);
+        }
+        bimodal.resize(static_cast<size_t>(1) << tage_log_bimodal, 0);
+
+        const uint32_t sc_tables = params.find<uint32_t>("sc_tables", 4);
+        sc_log_entries           = params.find<uint32_t>("sc_log_entries", 10);
+        sc_counter_bits          = params.find<uint32_t>("sc_counter_bits", 6);
+
+        if ( sc_tables > 0 ) {
+            if ( sc_log_entries < 2 || sc_counter_bits < 2 || sc_counter_bits > 8 ) {
+                output->fatal(CALL_INFO, -1, "Error: sc_log_entries must be at least 2 and sc_counter_bits between 2 and 8.\n");
+            }
+
+            // Table 0 is the bias table, the others use short geometric histories
+            sc_fold.push_back(0);
+            if ( sc_tables > 1 ) {
+                const std::vector<uint32_t> sc_lengths =
+                    vanadisGeometricHistory(sc_tables - 1, 2, params.find<uint32_t>("sc_max_history", 32));
+                for ( uint32_t i = 0; i + 1 < sc_tables; ++i ) {
+                    sc_fold.push_back(spec_hist.addFolded(sc_lengths[i], sc_log_entries - 1));
+                    retired_hist.addFolded(sc_lengths[i], sc_log_entries - 1);
+                }
+            }
+
+            for ( uint32_t i = 0; i < sc_tables; ++i ) {
+                sc.emplace_back(static_cast<size_t>(1) << sc_log_entries, 0);
+            }
+        }
+        sc_threshold = 6 * sc_tables;
+        sc_tc        = 0;
+
+        const uint32_t loop_entries = params.find<uint32_t>("loop_entries", 64);
+        loop_ways                   = params.find<uint32_t>("loop_ways", 4);
+        if ( loop_entries > 0 ) {
+            if ( loop_ways == 0 || (loop_entries % loop_ways) != 0 ) {
+                output->fatal(CALL_INFO, -1, "Error: loop_entries must be a multiple of loop_ways.\n");
+            }
+            loop.resize(loop_entries);
+        }
+        loop_sets = (loop_ways > 0) ? (loop_entries / loop_ways) : 0;
+
+        use_alt_on_na = 0;
+        with_loop     = -1;
+        update_count  = 0;
+        seed          = 0x2545;
+
+        stat_sc_overrides   = registerStatistic<uint64_t>("sc_overrides", "1");
+        stat_loop_overrides = registerStatistic<uint64_t>("loop_overrides", "1");
+
+        priceStorage();
+    }
+
+protected:
+    struct TageEntry {
+        int8_t   ctr    = 0; // 3-bit signed
+        uint16_t tag    = 0;
+        uint8_t  useful = 0; // 2-bit
+    };
+
+    struct LoopEntry {
+        bool     valid        = false;
+        uint16_t tag          = 0;
+        uint16_t past_iter    = 0;
+        uint16_t current_iter = 0; // retired
+        uint16_t spec_iter    = 0; // runs ahead at decode
+        uint8_t  confidence   = 0;
+        uint8_t  age          = 0;
+        bool     dir          = false;
+    };
+
+    struct Prediction {
+        std::vector<uint32_t> index;
+        std::vector<uint32_t> tag;
+        uint32_t              bim_index;
+        int32_t               provider = -1;
+        int32_t               alt      = -1;
+        bool                  provider_pred;
+        bool                  alt_pred;
+        bool                  weak_new;
+        bool                  tage_pred;
+        std::vector<uint32_t> sc_index;
+        int32_t               sc_sum;
+        bool                  tsc_pred;
+        LoopEntry*            loop_entry;
+        bool                  loop_valid;
+        bool                  loop_pred;
+        bool                  final_pred;
+    };
+
+    static const uint32_t loop_iter_bits = 14;
+    static const uint32_t loop_tag_bits  = 14;
+
+    bool predictTaken(const uint64_t ins_addr, const VanadisBranchHistory& hist) override
+    {
+        Prediction p;
+        lookup(ins_addr, hist, true, p);
+        return p.final_pred;
+    }
+
+    void speculateTaken(const uint64_t ins_addr, const bool taken) override
+    {
+        LoopEntry* e = findLoop(ins_addr);
+        if ( nullptr == e ) { return; }
+
+        if ( taken == e->dir ) { e->spec_iter = (e->spec_iter + 1) & ((1 << loop_iter_bits) - 1); }
+        else {
+            e->spec_iter = 0;
+        }
+    }
+
+    void squashDirection() override
+    {
+        for ( LoopEntry& e : loop ) {
+            e.spec_iter = e.current_iter;
+        }
+    }
+
+    bool trainTaken(const uint64_t ins_addr, const VanadisBranchHistory& hist, const bool taken) override
+    {
+        Prediction p;
+        lookup(ins_addr, hist, false, p);
+
+        if ( p.tsc_pred != p.tage_pred ) { stat_sc_overrides->addData(1); }
+        if ( p.final_pred != p.tsc_pred ) { stat_loop_overrides->addData(1); }
+
+        trainLoop(ins_addr, p, taken);
+        trainSC(p, taken);
+        trainTAGE(p, taken);
+
+        return p.final_pred;
+    }
+
+    void lookup(const uint64_t ins_addr, const VanadisBranchHistory& hist, const bool speculative, Prediction& p)
+    {
+        const uint32_t tables = tage.size();
+        p.index.resize(tables);
+        p.tag.resize(tables);
+        p.bim_index = (ins_addr >> 1) & ((UINT64_C(1) << tage_log_bimodal) - 1);
+
+        for ( int32_t i = tables - 1; i >= 0; --i ) {
+            p.index[i] = tage_hash[i].index(ins_addr, hist);
+            p.tag[i]   = tage_hash[i].tag(ins_addr, hist);
+
+            if ( tage[i][p.index[i]].tag == p.tag[i] ) {
+                if ( p.provider < 0 ) { p.provider = i; }
+                else if ( p.alt < 0 ) {
+                    p.alt = i;
+                }
+            }
+        }
+
+        p.alt_pred = (p.alt >= 0) ? (tage[p.alt][p.index[p.alt]].ctr >= 0) : (bimodal[p.bim_index] >= 0);
+
+        int32_t confidence;
+        if ( p.provider >= 0 ) {
+            const TageEntry& e = tage[p.provider][p.index[p.provider]];
+            p.provider_pred    = (e.ctr >= 0);
+            p.weak_new         = (e.ctr == 0 || e.ctr == -1) && (e.useful == 0);
+            p.tage_pred        = (p.weak_new && use_alt_on_na >= 0) ? p.alt_pred : p.provider_pred;
+            confidence         = std::abs(2 * e.ctr + 1);
+        }
+        else {
+            p.provider_pred = p.alt_pred;
+            p.weak_new      = false;
+            p.tage_pred     = p.alt_pred;
+            confidence      = std::abs(2 * bimodal[p.bim_index] + 1);
+        }
+
+        // Statistical corrector, the TAGE prediction is both an input to
+        // the sum (weighted by its confidence) and part of each index
+        p.tsc_pred = p.tage_pred;
+        p.sc_sum   = 0;
+        if ( !sc.empty() ) {
+            p.sc_index.resize(sc.size());
+            p.sc_sum = (p.tage_pred ? 1 : -1) * 4 * confidence;
+            for ( uint32_t i = 0; i < sc.size(); ++i ) {
+                p.sc_index[i] = scIndex(ins_addr, hist, i, p.tage_pred);
+                p.sc_sum += 2 * sc[i][p.sc_index[i]] + 1;
+            }
+
+            const bool sc_pred = (p.sc_sum >= 0);
+            if ( sc_pred != p.tage_pred && std::abs(p.sc_sum) >= sc_threshold ) { p.tsc_pred = sc_pred; }
+        }
+
+        // Loop predictor
+        p.final_pred = p.tsc_pred;
+        p.loop_entry = findLoop(ins_addr);
+        p.loop_valid = false;
+        if ( nullptr != p.loop_entry && p.loop_entry->confidence == 3 ) {
+            const uint16_t iter = speculative ? p.loop_entry->spec_iter : p.loop_entry->current_iter;
+            p.loop_valid        = true;
+            p.loop_pred         = ((iter + 1) == p.loop_entry->past_iter) ? !p.loop_entry->dir : p.loop_entry->dir;
+
+            if ( with_loop >= 0 ) { p.final_pred = p.loop_pred; }
+        }
+    }
+
+    uint32_t scIndex(const uint64_t ins_addr, const VanadisBranchHistory& hist, const uint32_t table, const bool tage_pred)
+    {
+        uint64_t h = (ins_addr >> 1) ^ ((ins_addr >> 1) >> (sc_log_entries - 1));
+        if ( table > 0 ) { h ^= hist.getFolded(sc_fold[table]) ^ (table << 3); }
+
+        return static_cast<uint32_t>(((h << 1) | (tage_pred ? 1 : 0)) & ((UINT64_C(1) << sc_log_entries) - 1));
+    }
+
+    LoopEntry* findLoop(const uint64_t ins_addr)
+    {
+        if ( loop.empty() ) { return nullptr; }
+
+        const uint64_t pc  = ins_addr >> 1;
+        const uint16_t tag = (pc / loop_sets) & ((1 << loop_tag_bits) - 1);
+        LoopEntry*     set = &loop[(pc % loop_sets) * loop_ways];
+
+        for ( uint32_t i = 0; i < loop_ways; ++i ) {
+            if ( set[i].valid && set[i].tag == tag ) { return &set[i]; }
+        }
+
+        return nullptr;
+    }
+
+    void trainLoop(const uint64_t ins_addr, const Prediction& p, const bool taken)
+    {
+        if ( loop.empty() ) { return; }
+
+        if ( p.loop_valid && p.loop_pred != p.tsc_pred ) {
+            if ( p.loop_pred == taken ) {
+                if ( with_loop < 63 ) { with_loop++; }
+            }
+            else if ( with_loop > -64 ) {
+                with_loop--;
+            }
+        }
+
+        LoopEntry* e = p.loop_entry;
+
+        if ( nullptr != e ) {
+            if ( p.loop_valid && p.loop_pred != taken ) {
+                // The trip count changed, start learning again
+                e->valid = false;
+                return;
+            }
+
+            if ( p.loop_valid && p.loop_pred != p.tsc_pred && e->age < 7 ) { e->age++; }
+
+            if ( taken == e->dir ) {
+                e->current_iter++;
+                if ( e->current_iter >= ((1 << loop_iter_bits) - 1) ) {
+                    // Too long to be worth tracking
+                    e->valid = false;
+                }
+                return;
+            }
+
+            // Loop exit
+            if ( e->past_iter == 0 ) {
+                e->past_iter  = e->current_iter + 1;
+                e->confidence = 0;
+            }
+            else if ( e->past_iter == e->current_iter + 1 ) {
+                if ( e->confidence < 3 ) { e->confidence++; }
+            }
+            else {
+                e->past_iter  = e->current_iter + 1;
+                e->confidence = 0;
+            }
+
+            e->current_iter = 0;
+            return;
+        }
+
+        // Allocate when TAGE-SC got it wrong, most likely at a loop exit
+        if ( p.tsc_pred == taken ) { return; }
+
+        const uint64_t pc  = ins_addr >> 1;
+        LoopEntry*     set = &loop[(pc % loop_sets) * loop_ways];
+        const uint32_t way = nextRandom() % loop_ways;
+
+        for ( uint32_t i = 0; i < loop_ways; ++i ) {
+            LoopEntry& victim = set[(way + i) % loop_ways];
+            if ( !victim.valid || victim.age == 0 ) {
+                victim.valid        = true;
+                victim.tag          = (pc / loop_sets) & ((1 << loop_tag_bits) - 1);
+                victim.past_iter    = 0;
+                victim.current_iter = 0;
+                victim.spec_iter    = 0;
+                victim.confidence   = 0;
+                victim.age          = 7;
+                victim.dir          = !taken;
+                return;
+            }
+        }
+
+        for ( uint32_t i = 0; i < loop_ways; ++i ) {
+            if ( set[i].age > 0 ) { set[i].age--; }
+        }
+    }
+
+    void trainSC(const Prediction& p, const bool taken)
+    {
+        if ( sc.empty() ) { return; }
+
+        const bool sc_pred = (p.sc_sum >= 0);
+
+        // Only matters when the corrector disagrees with TAGE
+        if ( sc_pred != p.tage_pred ) {
+            if ( sc_pred != taken ) {
+                if ( ++sc_tc >= 63 ) {
+                    sc_threshold++;
+                    sc_tc = 0;
+                }
+            }
+            else if ( std::abs(p.sc_sum) < sc_threshold ) {
+                if ( --sc_tc <= -64 ) {
+                    if ( sc_threshold > 1 ) { sc_threshold--; }
+                    sc_tc = 0;
+                }
+            }
+        }
+
+        if ( sc_pred != taken || std::abs(p.sc_sum) < sc_threshold ) {
+            const int32_t max = (1 << (sc_counter_bits - 1)) - 1;
+            const int32_t min = -(1 << (sc_counter_bits - 1));
+
+            for ( uint32_t i = 0; i < sc.size(); ++i ) {
+                int8_t& c = sc[i][p.sc_index[i]];
+                if ( taken && c < max ) { c++; }
+                else if ( !taken && c > min ) {
+                    c--;
+                }
+            }
+        }
+    }
+
+    void trainTAGE(const Prediction& p, const bool taken)
+    {
+        const uint32_t tables = tage.size();
+
+        if ( p.tage_pred != taken && (p.provider + 1) < static_cast<int32_t>(tables) ) { allocate(p, taken); }
+
+        if ( p.provider >= 0 ) {
+            TageEntry& e = tage[p.provider][p.index[p.provider]];
+
+            if ( p.weak_new && p.provider_pred != p.alt_pred ) {
+                if ( p.alt_pred == taken ) {
+                    if ( use_alt_on_na < 7 ) { use_alt_on_na++; }
+                }
+                else if ( use_alt_on_na > -8 ) {
+                    use_alt_on_na--;
+                }
+            }
+
+            // A new entry still learning also trains whatever predicted for it
+            if ( e.useful == 0 ) {
+                if ( p.alt >= 0 ) { updateCounter(tage[p.alt][p.index[p.alt]].ctr, taken, -4, 3); }
+                else {
+                    updateCounter(bimodal[p.bim_index], taken, -2, 1);
+                }
+            }
+
+            updateCounter(e.ctr, taken, -4, 3);
+
+            if ( p.provider_pred != p.alt_pred ) {
+                if ( p.provider_pred == taken ) {
+                    if ( e.useful < 3 ) { e.useful++; }
+                }
+                else if ( e.useful > 0 ) {
+                    e.useful--;
+                }
+            }
+        }
+        else {
+            updateCounter(bimodal[p.bim_index], taken, -2, 1);
+        }
+
+        if ( 0 == (++update_count & ((UINT64_C(1) << useful_reset_log) - 1)) ) {
+            for ( auto& table : tage ) {
+                for ( TageEntry& e : table ) {
+                    e.useful >>= 1;
+                }
+            }
+        }
+    }
+
+    void allocate(const Prediction& p, const bool taken)
+    {
+        const uint32_t tables = tage.size();
+
+        // Randomly skip one table so allocation spreads over the longer ones
+        uint32_t start = p.provider + 1;
+        if ( start + 1 < tables && (nextRandom() & 1) ) { start++; }
+
+        for ( uint32_t i = start; i < tables; ++i ) {
+            TageEntry& e = tage[i][p.index[i]];
+            if ( e.useful == 0 ) {
+                e.tag = p.tag[i];
+                e.ctr = taken ? 0 : -1;
+                return;
+            }
+        }
+
+        for ( uint32_t i = p.provider + 1; i < tables; ++i ) {
+            TageEntry& e = tage[i][p.index[i]];
+            if ( e.useful > 0 ) { e.useful--; }
+        }
+    }
+
+    static void updateCounter(int8_t& ctr, const bool taken, const int8_t min, const int8_t max)
+    {
+        if ( taken && ctr < max ) { ctr++; }
+        else if ( !taken && ctr > min ) {
+            ctr--;
+        }
+    }
+
+    uint32_t nextRandom()
+    {
+        // 16-bit Galois LFSR, deterministic across runs
+        seed = (seed >> 1) ^ (-(seed & 1u) & 0xB400u);
+        return seed;
+    }
+
+    void priceDirection(std::vector<std::pair<std::string, uint64_t>>& prices) const override
+    {
+        prices.emplace_back("tage bimodal", static_cast<uint64_t>(bimodal.size()) * 2);
+        prices.emplace_back(
+            "tage tagged", static_cast<uint64_t>(tage.size()) * (UINT64_C(1) << tage_log_entries) * (tage_tag_bits + 3 + 2) + 4);
+        prices.emplace_back(
+            "sc", static_cast<uint64_t>(sc.size()) * (UINT64_C(1) << sc_log_entries) * sc_counter_bits + 12 + 7);
+        prices.emplace_back("loop", static_cast<uint64_t>(loop.size()) * (1 + loop_tag_bits + 3 * loop_iter_bits + 2 + 3 + 1) + 7);
+    }
+
+    uint32_t tage_log_entries;
+    uint32_t tage_tag_bits;
+    uint32_t tage_log_bimodal;
+    uint32_t useful_reset_log;
+    uint32_t sc_log_entries;
+    uint32_t sc_counter_bits;
+    uint32_t loop_ways;
+    uint32_t loop_sets;
+
+    std::vector<VanadisTaggedTableHash> tage_hash;
+    std::vector<std::vector<TageEntry>> tage;
+    std::vector<int8_t>                 bimodal;
+    int8_t                              use_alt_on_na;
+
+    std::vector<uint32_t>            sc_fold;
+    std::vector<std::vector<int8_t>> sc;
+    int32_t                          sc_threshold;
+    int32_t                          sc_tc;
+
+    std::vector<LoopEntry> loop;
+    int8_t                 with_loop;
+
+    uint64_t update_count;
+    uint32_t seed;
+
+    Statistic<uint64_t>* stat_sc_overrides;
+    Statistic<uint64_t>* stat_loop_overrides;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -40,6 +40,29 @@ public:
     virtual void push(const uint64_t ins_addr, const uint64_t pred_addr) = 0;
     virtual uint64_t predictAddress(const uint64_t addr) = 0;
     virtual bool contains(const uint64_t addr) = 0;
+
+    // Called by the decoder for every branch, returns where fetch should
+    // continue.  fallthrough_addr is the not-taken path (after any delay
+    // slot).  Units that only cache targets keep the behaviour above.
+    virtual uint64_t predict(const uint64_t ins_addr, const uint64_t fallthrough_addr, const VanadisBranchType type) {
+        return contains(ins_addr) ? predictAddress(ins_addr) : fallthrough_addr;
+    }
+
+    // Called in program order as each branch retires with the address it
+    // actually went to
+    virtual void update(const uint64_t ins_addr, const uint64_t fallthrough_addr, const uint64_t taken_addr,
+                        const VanadisBranchType type) {
+        push(ins_addr, taken_addr);
+    }
+
+    // Every branch predicted but not yet retired has been thrown away by a
+    // pipeline flush, speculative state should go back to the retired state
+    virtual void squash() {}
+
+    // Target of a predicted-taken branch at addr, for the fetch-target queue
+    // running ahead of decode. Must not change predictor state; units that
+    // cannot answer without it leave run-ahead fetch sequential.
+    virtual bool peekTarget(const uint64_t addr, uint64_t* target) { return false; }
 };
 
 } // namespace Vanadis
@@ -0,0 +1,130 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_TARGET_BUFFER
+#define _H_VANADIS_BRANCH_TARGET_BUFFER
+
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// Set associative, LRU replaced branch target buffer with partial tags, so
+// two branches can alias the way they would in hardware
+class VanadisBranchTargetBuffer
+{
+public:
+    VanadisBranchTargetBuffer(const uint32_t sets, const uint32_t ways, const uint32_t tag_width) :
+        set_count(sets),
+        way_count(ways),
+        tag_bits(tag_width),
+        entries(sets * ways),
+        clock(0)
+    {}
+
+    bool lookup(const uint64_t ins_addr, uint64_t* target)
+    {
+        Entry* e = find(ins_addr);
+        if ( nullptr == e ) { return false; }
+
+        e->last_used = ++clock;
+        *target      = e->target;
+        return true;
+    }
+
+    // Lookup for the run-ahead fetch, leaves the replacement state alone
+    bool peek(const uint64_t ins_addr, uint64_t* target) const
+    {
+        const Entry* e = find(ins_addr);
+        if ( nullptr == e ) { return false; }
+
+        *target = e->target;
+        return true;
+    }
+
+    void insert(const uint64_t ins_addr, const uint64_t target)
+    {
+        Entry* e = find(ins_addr);
+
+        if ( nullptr == e ) {
+            Entry* set = &entries[setIndex(ins_addr) * way_count];
+            e          = set;
+            for ( uint32_t i = 1; i < way_count; ++i ) {
+                if ( !set[i].valid || (e->valid && set[i].last_used < e->last_used) ) { e = &set[i]; }
+            }
+
+            e->valid = true;
+            e->tag   = tag(ins_addr);
+        }
+
+        e->target    = target;
+        e->last_used = ++clock;
+    }
+
+    uint64_t getStorageBits() const
+    {
+        uint32_t lru_bits = 0;
+        while ( (1u << lru_bits) < way_count ) {
+            lru_bits++;
+        }
+        return static_cast<uint64_t>(entries.size()) * (1 + tag_bits + 64 + lru_bits);
+    }
+
+protected:
+    struct Entry {
+        bool     valid     = false;
+        uint32_t tag       = 0;
+        uint64_t target    = 0;
+        uint64_t last_used = 0;
+    };
+
+    // Instructions can be two byte aligned (RISC-V compressed)
+    uint32_t setIndex(const uint64_t ins_addr) const { return (ins_addr >> 1) % set_count; }
+
+    uint32_t tag(const uint64_t ins_addr) const
+    {
+        const uint64_t upper = (ins_addr >> 1) / set_count;
+        return static_cast<uint32_t>((upper ^ (upper >> tag_bits)) & ((UINT64_C(1) << tag_bits) - 1));
+    }
+
+    Entry* find(const uint64_t ins_addr)
+    {
+        return const_cast<Entry*>(static_cast<const VanadisBranchTargetBuffer*>(this)->find(ins_addr));
+    }
+
+    const Entry* find(const uint64_t ins_addr) const
+    {
+        const Entry*   set = &entries[setIndex(ins_addr) * way_count];
+        const uint32_t t   = tag(ins_addr);
+
+        for ( uint32_t i = 0; i < way_count; ++i ) {
+            if ( set[i].valid && set[i].tag == t ) { return &set[i]; }
+        }
+
+        return nullptr;
+    }
+
+    const uint32_t     set_count;
+    const uint32_t     way_count;
+    const uint32_t     tag_bits;
+    std::vector<Entry> entries;
+    uint64_t           clock;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,184 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_ITTAGE
+#define _H_VANADIS_ITTAGE
+
+#include "vbranch/vbranchhist.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// ITTAGE indirect target predictor (Seznec, "A 64-Kbytes ITTAGE indirect
+// branch predictor").  Tagged tables indexed with geometric history
+// lengths each hold a full target, a 2-bit confidence and a useful bit.
+// There is no tagless base table, the branch unit falls back to its BTB
+// when no table hits.
+class VanadisITTAGE
+{
+public:
+    VanadisITTAGE(
+        const uint32_t tables, const uint32_t log_size, const uint32_t tag_width, const uint32_t min_history,
+        const uint32_t max_history, VanadisBranchHistory& spec_hist, VanadisBranchHistory& retired_hist) :
+        log_entries(log_size),
+        tag_bits(tag_width),
+        update_count(0)
+    {
+        const std::vector<uint32_t> lengths = vanadisGeometricHistory(tables, min_history, max_history);
+
+        for ( uint32_t i = 0; i < tables; ++i ) {
+            hashes.emplace_back(i, lengths[i], log_entries, tag_bits, spec_hist, retired_hist);
+            entries.emplace_back(static_cast<size_t>(1) << log_entries);
+        }
+    }
+
+    // Only confident entries predict, otherwise the caller falls back to
+    // its BTB which plays the part of the tagless base table
+    bool predict(const uint64_t ins_addr, const VanadisBranchHistory& hist, uint64_t* target)
+    {
+        Lookup l = lookup(ins_addr, hist);
+        return predict(l, target);
+    }
+
+    // correct is whether the unit as a whole (ITTAGE or its fall back)
+    // predicted taken_addr, entries are only allocated when it did not
+    void update(const uint64_t ins_addr, const VanadisBranchHistory& hist, const uint64_t taken_addr, const bool correct)
+    {
+        Lookup l = lookup(ins_addr, hist);
+
+        if ( l.provider >= 0 ) {
+            Entry& p = entry(l, l.provider);
+
+            if ( p.target == taken_addr ) {
+                if ( p.confidence < 3 ) { p.confidence++; }
+                if ( !correct || (l.alt >= 0 && entry(l, l.alt).target != taken_addr) ) { p.useful = true; }
+            }
+            else if ( p.confidence > 0 ) {
+                p.confidence--;
+            }
+            else {
+                p.target = taken_addr;
+                p.useful = false;
+            }
+        }
+
+        if ( !correct ) { allocate(l, hist, taken_addr); }
+
+        // Periodically age the useful bits so stale entries can be replaced
+        if ( 0 == (++update_count & ((UINT64_C(1) << 18) - 1)) ) {
+            for ( auto& table : entries ) {
+                for ( Entry& e : table ) {
+                    e.useful = false;
+                }
+            }
+        }
+    }
+
+    uint64_t getStorageBits() const
+    {
+        return static_cast<uint64_t>(entries.size()) * (UINT64_C(1) << log_entries) * (1 + tag_bits + 64 + 2 + 1) + 18;
+    }
+
+protected:
+    struct Entry {
+        uint32_t tag        = 0;
+        uint64_t target     = 0;
+        uint8_t  confidence = 0;
+        bool     useful     = false;
+        bool     valid      = false;
+    };
+
+    struct Lookup {
+        std::vector<uint32_t> index;
+        std::vector<uint32_t> tag;
+        int32_t               provider = -1;
+        int32_t               alt      = -1;
+    };
+
+    Lookup lookup(const uint64_t ins_addr, const VanadisBranchHistory& hist)
+    {
+        Lookup l;
+        l.index.resize(hashes.size());
+        l.tag.resize(hashes.size());
+
+        for ( int32_t i = hashes.size() - 1; i >= 0; --i ) {
+            l.index[i] = hashes[i].index(ins_addr, hist);
+            l.tag[i]   = hashes[i].tag(ins_addr, hist);
+
+            const Entry& e = entries[i][l.index[i]];
+            if ( e.valid && e.tag == l.tag[i] ) {
+                if ( l.provider < 0 ) { l.provider = i; }
+                else if ( l.alt < 0 ) {
+                    l.alt = i;
+                }
+            }
+        }
+
+        return l;
+    }
+
+    Entry& entry(const Lookup& l, const int32_t table) { return entries[table][l.index[table]]; }
+
+    bool predict(const Lookup& l, uint64_t* target)
+    {
+        if ( l.provider >= 0 && entry(l, l.provider).confidence > 0 ) {
+            *target = entry(l, l.provider).target;
+            return true;
+        }
+        if ( l.alt >= 0 && entry(l, l.alt).confidence > 0 ) {
+            *target = entry(l, l.alt).target;
+            return true;
+        }
+
+        return false;
+    }
+
+    void allocate(const Lookup& l, const VanadisBranchHistory& hist, const uint64_t taken_addr)
+    {
+        // Skip a table now and then so allocation doesn't always land in
+        // the shortest free one
+        uint32_t start = l.provider + 1;
+        if ( start + 1 < hashes.size() && (hist.getPath() & 1) ) { start++; }
+
+        for ( uint32_t i = start; i < hashes.size(); ++i ) {
+            Entry& e = entries[i][l.index[i]];
+            if ( !e.useful ) {
+                e.valid      = true;
+                e.tag        = l.tag[i];
+                e.target     = taken_addr;
+                e.confidence = 0;
+                return;
+            }
+        }
+
+        for ( uint32_t i = l.provider + 1; i < hashes.size(); ++i ) {
+            entries[i][l.index[i]].useful = false;
+        }
+    }
+
+    uint32_t                            log_entries;
+    uint32_t                            tag_bits;
+    uint64_t                            update_count;
+    std::vector<VanadisTaggedTableHash> hashes;
+    std::vector<std::vector<Entry>>     entries;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
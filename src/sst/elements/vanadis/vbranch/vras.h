@@ -0,0 +1,61 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_RETURN_ADDRESS_STACK
+#define _H_VANADIS_RETURN_ADDRESS_STACK
+
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// Circular return address stack, on overflow the oldest return is lost
+class VanadisReturnAddressStack
+{
+public:
+    VanadisReturnAddressStack(const uint32_t entries) : stack(entries, 0), top(0), count(0) {}
+
+    void push(const uint64_t return_addr)
+    {
+        if ( stack.empty() ) { return; }
+
+        top        = (top + 1) % stack.size();
+        stack[top] = return_addr;
+        if ( count < stack.size() ) { count++; }
+    }
+
+    bool pop(uint64_t* return_addr)
+    {
+        if ( 0 == count ) { return false; }
+
+        *return_addr = stack[top];
+        top          = (top + stack.size() - 1) % stack.size();
+        count--;
+        return true;
+    }
+
+    uint64_t getStorageBits() const { return static_cast<uint64_t>(stack.size()) * 64; }
+
+protected:
+    std::vector<uint64_t> stack;
+    uint32_t              top;
+    uint32_t              count;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -37,6 +37,38 @@ enum class VanadisInstructionLoaderMode {
     LRU_CACHE_MODE
 };
 
+// A straight-line run of decoded bundles, it ends at the first bundle which
+// contains a branch or at the first address which has not been decoded yet
+// (an open block, which is extended once the next bundle is available).
+// The bundles are owned by the uop cache.
+class VanadisInstructionBlock {
+public:
+    VanadisInstructionBlock(const uint64_t addr) : end_address(addr), ends_in_branch(false) {}
+
+    uint32_t getBundleCount() const { return bundles.size(); }
+    VanadisInstructionBundle* getBundleByIndex(const uint32_t index) { return bundles[index]; }
+
+    uint64_t getEndAddress() const { return end_address; }
+    bool endsInBranch() const { return ends_in_branch; }
+
+    void addBundle(VanadisInstructionBundle* bundle) {
+        bundles.push_back(bundle);
+        end_address = bundle->getInstructionAddress() + bundle->pcIncrement();
+
+        for (uint32_t i = 0; i < bundle->getInstructionCount(); ++i) {
+            if (bundle->getInstructionByIndex(i)->getInstFuncType() == INST_BRANCH) {
+                ends_in_branch = true;
+                break;
+            }
+        }
+    }
+
+private:
+    std::vector<VanadisInstructionBundle*> bundles;
+    uint64_t end_address;
+    bool ends_in_branch;
+};
+
 class VanadisInstructionLoader {
 public:
     VanadisInstructionLoader(const size_t uop_cache_size, const size_t predecode_cache_entries,
@@ -47,6 +79,7 @@ public:
         predecode_cache = new VanadisCache<uint64_t, uint8_t*, SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE_ARRAY>(predecode_cache_entries);
 
         mem_if = nullptr;
+        late_prefetches = 0;
 
         loader_mode = VanadisInstructionLoaderMode::LRU_CACHE_MODE;
         switchLoaderMode();
@@ -133,9 +166,22 @@ public:
             pending_loads.erase(check_hit_local);
 
             return true;
-        } else {
-            return false;
         }
+
+        auto check_prefetch = pending_prefetches.find(req->getID());
+
+        if (check_prefetch != pending_prefetches.end()) {
+            // The line is now in the instruction cache, which is all a prefetch is for
+            if(output_verbosity >= 16) {
+                output->verbose(CALL_INFO, 16, VANADIS_DBG_INS_LDR_FLG, "[ins-loader] ---> prefetch of line 0x%" PRI_ADDR " completed\n",
+                            check_prefetch->second->pAddr);
+            }
+
+            pending_prefetches.erase(check_prefetch);
+            return true;
+        }
+
+        return false;
     }
 
     bool getPredecodeBytes(SST::Output* output, const uint64_t addr, uint8_t* buffer, const size_t buffer_req) {
@@ -222,6 +268,7 @@ public:
         uop_cache->clear();
         predecode_cache->clear();
         infinite_uop_cache.clear();
+        clearBlocks();
     }
 
     bool hasBundleAt(const uint64_t addr) const {
@@ -264,6 +311,46 @@ public:
         assert(0);
     }
 
+    // Returns the run of bundles starting at addr with a single lookup, or
+    // nullptr if there is no bundle at addr. Only the infinite cache keeps
+    // blocks, bundles in the LRU cache can be evicted individually so it has
+    // to be probed for each bundle.
+    VanadisInstructionBlock* getBlockAt(const uint64_t addr) {
+        if (loader_mode != VanadisInstructionLoaderMode::INFINITE_CACHE_MODE) {
+            return nullptr;
+        }
+
+        VanadisInstructionBlock* block = nullptr;
+        auto block_itr = infinite_block_cache.find(addr);
+
+        if (block_itr != infinite_block_cache.end()) {
+            block = block_itr->second;
+        } else {
+            auto bundle_itr = infinite_uop_cache.find(addr);
+
+            if (bundle_itr == infinite_uop_cache.end()) {
+                return nullptr;
+            }
+
+            block = new VanadisInstructionBlock(addr);
+            block->addBundle(bundle_itr->second);
+            infinite_block_cache.insert(std::pair<uint64_t, VanadisInstructionBlock*>(addr, block));
+        }
+
+        // pick up any bundles decoded since the block was last used
+        while (!block->endsInBranch()) {
+            auto next_itr = infinite_uop_cache.find(block->getEndAddress());
+
+            if (next_itr == infinite_uop_cache.end()) {
+                break;
+            }
+
+            block->addBundle(next_itr->second);
+        }
+
+        return block;
+    }
+
     void requestLoadAt(SST::Output* output, const uint64_t addr, const uint64_t len) {
         if (len > cache_line_width) {
             output->fatal(CALL_INFO, -1,
@@ -302,6 +389,19 @@ public:
 	                }
 	            }
 
+	            if (!found_pending_load) {
+	                // A prefetch of the line is on its way, let its response fill the predecoder
+	                for (auto prefetch_itr = pending_prefetches.begin(); prefetch_itr != pending_prefetches.end(); prefetch_itr++) {
+	                    if (prefetch_itr->second->pAddr == line_start) {
+	                        pending_loads.insert(*prefetch_itr);
+	                        pending_prefetches.erase(prefetch_itr);
+	                        found_pending_load = true;
+	                        late_prefetches++;
+	                        break;
+	                    }
+	                }
+	            }
+
 	            if (!found_pending_load) {
 						output->verbose(CALL_INFO, 8, VANADIS_DBG_INS_LDR_FLG, "[ins-loader] ----> creating a load for line at 0x%" PRI_ADDR ", len=%" PRIu64 "\n",
 							line_start, cache_line_width);
@@ -328,11 +428,56 @@ public:
 		printPendingLoads(output);
     }
 
+    // Reads the line holding addr into the instruction cache without keeping it
+    // in the predecoder, returns false if the line is already here or on its way
+    bool prefetchLineAt(SST::Output* output, const uint64_t addr) {
+        const uint64_t line_start = addr - (addr % cache_line_width);
+
+        if (predecode_cache->contains(line_start)) {
+            return false;
+        }
+
+        for (auto pending_load_itr : pending_loads) {
+            if (pending_load_itr.second->pAddr == line_start) {
+                return false;
+            }
+        }
+
+        for (auto pending_prefetch_itr : pending_prefetches) {
+            if (pending_prefetch_itr.second->pAddr == line_start) {
+                return false;
+            }
+        }
+
+        output->verbose(CALL_INFO, 8, VANADIS_DBG_INS_LDR_FLG, "[ins-loader] ----> prefetching line at 0x%" PRI_ADDR "\n",
+            line_start);
+
+        SST::Interfaces::StandardMem::Read* req_line = new SST::Interfaces::StandardMem::Read(
+            line_start, cache_line_width);
+
+        pending_prefetches.insert(
+            std::pair<SST::Interfaces::StandardMem::Request::id_t, SST::Interfaces::StandardMem::Read*>(
+                req_line->getID(), req_line));
+
+        mem_if->send(req_line);
+        return true;
+    }
+
+    // Number of demand loads that found a prefetch of their line still in
+    // flight since the last call
+    uint64_t takeLatePrefetches() {
+        const uint64_t late = late_prefetches;
+        late_prefetches = 0;
+        return late;
+    }
+
     void printStatus(SST::Output* output) {
         output->verbose(CALL_INFO, 8, VANADIS_DBG_INS_LDR_FLG, "Instruction Loader - Internal State Report:\n");
         output->verbose(CALL_INFO, 8, VANADIS_DBG_INS_LDR_FLG, "--> Cache Line Width:          %" PRIu64 "\n", cache_line_width);
         output->verbose(CALL_INFO, 8, VANADIS_DBG_INS_LDR_FLG, "--> Pending Loads:             %" PRIu32 "\n",
                         (uint32_t)pending_loads.size());
+        output->verbose(CALL_INFO, 8, VANADIS_DBG_INS_LDR_FLG, "--> Pending Prefetches:        %" PRIu32 "\n",
+                        (uint32_t)pending_prefetches.size());
 
         for (auto pl_itr : pending_loads) {
             output->verbose(CALL_INFO, 16, VANADIS_DBG_INS_LDR_FLG, "-----> Address:       %p\n", (void*)pl_itr.second->pAddr);
@@ -346,6 +491,14 @@ public:
 
 private:
 
+    void clearBlocks() {
+        for (auto block_itr : infinite_block_cache) {
+            delete block_itr.second;
+        }
+
+        infinite_block_cache.clear();
+    }
+
 	void printPendingLoads(SST::Output* output) {
 		output->verbose(CALL_INFO, 8, VANADIS_DBG_INS_LDR_FLG, "[ins-loader]: Pending loads table\n");
 		for( auto next_load : pending_loads ) {
@@ -362,6 +515,7 @@ private:
         }
 
         infinite_uop_cache.clear();
+        clearBlocks();
 
         // any additional mode-specific clean up which is needed
         switch(loader_mode) {
@@ -381,8 +535,11 @@ private:
     VanadisCache<uint64_t, uint8_t*, SST::Vanadis::VanadisCacheRecordDeletion::VANADIS_PERFORM_DELETE_ARRAY>* predecode_cache;
 
     std::unordered_map<uint64_t, VanadisInstructionBundle*> infinite_uop_cache;
+    std::unordered_map<uint64_t, VanadisInstructionBlock*> infinite_block_cache;
 
     std::unordered_map<SST::Interfaces::StandardMem::Request::id_t, SST::Interfaces::StandardMem::Read*> pending_loads;
+    std::unordered_map<SST::Interfaces::StandardMem::Request::id_t, SST::Interfaces::StandardMem::Read*> pending_prefetches;
+    uint64_t late_prefetches;
 
     VanadisInstructionLoaderMode loader_mode;
 };
@@ -31,7 +31,7 @@ using namespace SST::VaultSim;
 //typedef  VaultCompleteFn;
 
 logicLayer::logicLayer( ComponentId_t id, Params& params ) :
-  Component( id ), memOps(0)
+  Component( id ), memOps(0), nextVault(0)
 {
   dbg.init("@R:LogicLayer::@p():@l " + getName() + ": ", 0, 0, (Output::output_location_t)params.find("debug", 0));
   dbg.output(CALL_INFO, "making logicLayer\n");
@@ -60,6 +60,12 @@ logicLayer::logicLayer( ComponentId_t id, Params& params ) :
 
   bool terminal = params.find("terminal", 0);
 
+  xbarBW = params.find<int>("xbar_bw", 0);
+  vaultLinkBW = params.find<int>("vault_link_bw", 0);
+  if (xbarBW < 0 || vaultLinkBW < 0) {
+    dbg.fatal(CALL_INFO, -1, " xbar_bw and vault_link_bw must not be negative\n");
+  }
+
   int numVaults = params.find("vaults", -1);
   if ( -1 != numVaults) {
     // connect up our vaults
@@ -76,6 +82,7 @@ logicLayer::logicLayer( ComponentId_t id, Params& params ) :
       }
     }
     printf(" Connected %d Vaults\n", numVaults);
+    vaultQueues.resize(numVaults);
   } else {
     dbg.fatal(CALL_INFO, -1,
         " no <vaults> tag defined for LogicLayer\n");
@@ -98,6 +105,7 @@ logicLayer::logicLayer( ComponentId_t id, Params& params ) :
   bwUsedToCpu[1] = registerStatistic<uint64_t>("BW_send_to_CPU", "1");
   bwUsedToMem[0] = registerStatistic<uint64_t>("BW_recv_from_Mem", "1");
   bwUsedToMem[1] = registerStatistic<uint64_t>("BW_send_to_Mem", "1");
+  xbarWaiting = registerStatistic<uint64_t>("Xbar_Waiting", "1");
 }
 
 int logicLayer::Finish()
@@ -199,9 +207,7 @@ bool logicLayer::clock( Cycle_t current )
       // it is ours!
       unsigned int vaultID = (event->getAddr() >> VAULT_SHIFT) % m_memChans.size();
 
-      dbg.output(CALL_INFO, "ll%d sends %p to vault @ %" PRIu64 "\n", llID, event,
-        current);
-      m_memChans[vaultID]->send(event);
+      vaultQueues[vaultID].push_back(event);
     } else {
       // it is not ours
       if (toMem) {
@@ -229,11 +235,18 @@ bool logicLayer::clock( Cycle_t current )
     }
   }
 
-  // check for incoming events from the vaults
-  for (memChans_t::iterator i = m_memChans.begin();
-       i != m_memChans.end(); ++i) {
-    memChan_t *m_memChan = *i;
-    while ((e = m_memChan->recv())) {
+  sendToVaults(current);
+
+  // check for incoming events from the vaults, responses the crossbar
+  // can't take this cycle stay on the vault links
+  int xbarUsed = 0;
+  vector<int> portUsed(m_memChans.size(), 0);
+  for (unsigned n = 0; n < m_memChans.size(); ++n) {
+    unsigned v = (nextVault + n) % m_memChans.size();
+    memChan_t *m_memChan = m_memChans[v];
+    while (xbarFree(v, xbarUsed, portUsed) && (e = m_memChan->recv())) {
+      xbarUsed++;
+      portUsed[v]++;
       MemRespEvent *event  = dynamic_cast<MemRespEvent*>(e);
       if (event == NULL) {
         dbg.fatal(CALL_INFO, -1, "logic layer got bad event from vaults\n");
@@ -264,3 +277,28 @@ bool logicLayer::clock( Cycle_t current )
 
   return false;
 }
+
+// Move queued requests through the crossbar, starting from a different vault
+// each cycle so that no vault is starved when the crossbar is saturated
+void logicLayer::sendToVaults( Cycle_t current )
+{
+  int xbarUsed = 0;
+  vector<int> portUsed(m_memChans.size(), 0);
+  uint64_t waiting = 0;
+  for (unsigned n = 0; n < vaultQueues.size(); ++n) {
+    unsigned v = (nextVault + n) % vaultQueues.size();
+    deque<MemReqEvent*> &queue = vaultQueues[v];
+    while (!queue.empty() && xbarFree(v, xbarUsed, portUsed)) {
+      MemReqEvent *event = queue.front();
+      queue.pop_front();
+      dbg.output(CALL_INFO, "ll%d sends %p to vault @ %" PRIu64 "\n", llID, event,
+        current);
+      m_memChans[v]->send(event);
+      xbarUsed++;
+      portUsed[v]++;
+    }
+    waiting += queue.size();
+  }
+  nextVault = (nextVault + 1) % vaultQueues.size();
+  xbarWaiting->addData(waiting);
+}
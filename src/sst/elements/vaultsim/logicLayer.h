@@ -23,7 +23,10 @@
 #include <sst/core/statapi/stataccumulator.h>
 #include <sst/core/statapi/stathistogram.h>
 
+#include <deque>
+
 #include "globals.h"
+#include "memReqEvent.h"
 
 using namespace std;
 
@@ -51,14 +54,17 @@ public: // functions
                             {"LL_MASK",            "Bitmask to determine 'ownership' of an address by a cube. A cube 'owns' an address if ((((addr >> LL_SHIFT) & LL_MASK) == llID) || (LL_MASK == 0)). LL_SHIFT is set in vaultGlobals.h and is 8 by default."},
                             {"terminal",           "Is this the last cube in the chain?"},
                             {"vaults",             "Number of vaults per cube."},
-                            {"debug",              "0 (default): No debugging, 1: STDOUT, 2: STDERR, 3: FILE."}
+                            {"debug",              "0 (default): No debugging, 1: STDOUT, 2: STDERR, 3: FILE."},
+                            {"xbar_bw",            "Number of memory events the crossbar to the vaults can move per cycle in each direction. 0 (default) is unlimited.", "0"},
+                            {"vault_link_bw",      "Number of memory events each vault port of the crossbar can move per cycle in each direction. 0 (default) is unlimited.", "0"}
                                 );
 
    SST_ELI_DOCUMENT_STATISTICS(
       { "BW_recv_from_CPU", "Bandwidth used (recieves from the CPU by the LL) per cycle (in messages)", "reqs/cycle", 1},
       { "BW_send_to_CPU", "Bandwidth used (sends from the CPU by the LL) per cycle (in messages)", "reqs/cycle", 2},
       { "BW_recv_from_Mem", "Bandwidth used (recieves from other memories by the LL) per cycle (in messages)", "reqs/cycle", 3},
-      { "BW_send_to_Mem", "Bandwidth used (sends from other memories by the LL) per cycle (in messages)", "reqs/cycle", 4}
+      { "BW_send_to_Mem", "Bandwidth used (sends from other memories by the LL) per cycle (in messages)", "reqs/cycle", 4},
+      { "Xbar_Waiting", "Requests waiting for the crossbar to their vault per cycle", "reqs/cycle", 2}
           )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -80,6 +86,10 @@ private:
 
   logicLayer( const logicLayer& c );
   bool clock( Cycle_t );
+  void sendToVaults( Cycle_t );
+  bool xbarFree( unsigned vault, int xbarUsed, const vector<int>& portUsed ) {
+    return (xbarBW == 0 || xbarUsed < xbarBW) && (vaultLinkBW == 0 || portUsed[vault] < vaultLinkBW);
+  }
   // determine if we 'own' a given address
   bool isOurs(unsigned int addr) {
     return ((((addr >> LL_SHIFT) & LL_MASK) == llID)
@@ -95,8 +105,15 @@ private:
   unsigned int llID;
   unsigned long long memOps;
 
+  // crossbar to the vaults
+  int xbarBW;
+  int vaultLinkBW;
+  vector<deque<MemReqEvent*> > vaultQueues;
+  unsigned nextVault;   // round robin start of the crossbar arbitration
+
     Statistic<uint64_t>*  bwUsedToCpu[2];
     Statistic<uint64_t>*  bwUsedToMem[2];
+    Statistic<uint64_t>*  xbarWaiting;
 };
 
 }
@@ -20,6 +20,8 @@
 
 #include <sys/mman.h>
 
+#include <algorithm>
+
 #include "vaultsim.h"
 #include "memReqEvent.h"
 #include "globals.h"
@@ -74,7 +76,32 @@ VaultSim::VaultSim( ComponentId_t id, Params& params ) :
         dbg.fatal(CALL_INFO, -1, "Unable to MMAP backing store for Memory\n");
     }
 */
+    // bank model
+    numBanks = params.find<unsigned>("banks", 0);
+    std::string policy = params.find<std::string>("page_policy", "closed");
+    if (policy == "open") {
+        openPage = true;
+    } else if (policy == "closed") {
+        openPage = false;
+    } else {
+        dbg.fatal(CALL_INFO, -1, "page_policy must be 'open' or 'closed', got '%s'\n", policy.c_str());
+    }
+    rowSize = params.find<size_t>("row_size", 2048);
+    if (rowSize < (1 << VAULT_SHIFT) || (rowSize % (1 << VAULT_SHIFT)) != 0) {
+        dbg.fatal(CALL_INFO, -1, "row_size must be a multiple of %u bytes\n", 1 << VAULT_SHIFT);
+    }
+    tCL = params.find<Cycle_t>("tCL", 11);
+    tRCD = params.find<Cycle_t>("tRCD", 11);
+    tRP = params.find<Cycle_t>("tRP", 11);
+    tBurst = params.find<Cycle_t>("tBurst", 4);
+    busAvail = 0;
+    banks.resize(numBanks);
+
     memOutStat = registerStatistic<uint64_t>("Mem_Outstanding","1");
+    rowHitStat = registerStatistic<uint64_t>("Row_Hits");
+    rowMissStat = registerStatistic<uint64_t>("Row_Misses");
+    bankConflictStat = registerStatistic<uint64_t>("Bank_Conflicts");
+    queueDelayStat = registerStatistic<uint64_t>("Queue_Delay");
 }
 
     int VaultSim::Finish()
@@ -120,10 +147,22 @@ bool VaultSim::clock( Cycle_t current ) {
             dbg.fatal(CALL_INFO, -1, "vault got bad event\n");
         }
         // handle event...
-        delayLine->send(1, event);
+        if (numBanks == 0) {
+            delayLine->send(1, event);
+        } else {
+            // consecutive chunks of the vault go to consecutive banks
+            size_t chunk = getInternalAddress(event->getAddr()) >> VAULT_SHIFT;
+            unsigned bank = chunk % numBanks;
+            int64_t row = (chunk / numBanks) / (rowSize >> VAULT_SHIFT);
+            reqQueue.push_back(queuedReq_t(event, bank, row, current));
+        }
         numOutstanding++;
     }
 
+    if (numBanks > 0) {
+        scheduleBanks(current);
+    }
+
     e = 0;
     while (NULL != (e = delayLine->recv())) {
         // process returned events
@@ -144,4 +183,60 @@ bool VaultSim::clock( Cycle_t current ) {
     return false;
 }
 
+/*
+ * Issue at most one request per cycle to an idle bank. With the open page
+ * policy the oldest row hit goes first, otherwise the oldest request. A
+ * request holds its bank until its data is off the vault data bus, so
+ * requests to other banks overlap with it.
+ */
+void VaultSim::scheduleBanks( Cycle_t current ) {
+    deque<queuedReq_t>::iterator pick = reqQueue.end();
+    unsigned conflicts = 0;
+    for (deque<queuedReq_t>::iterator it = reqQueue.begin(); it != reqQueue.end(); ++it) {
+        bank_t &bank = banks[it->bank];
+        if (bank.busyUntil > current) {
+            conflicts++;
+            continue;
+        }
+        if (pick == reqQueue.end()) {
+            pick = it;
+            if (!openPage) break;
+        }
+        if (bank.openRow == it->row) {
+            pick = it;
+            break;
+        }
+    }
+    bankConflictStat->addData(conflicts);
+
+    if (pick == reqQueue.end()) {
+        return;
+    }
+
+    bank_t &bank = banks[pick->bank];
+    Cycle_t access;
+    if (bank.openRow == pick->row) {
+        access = tCL;
+        rowHitStat->addData(1);
+    } else {
+        access = (bank.openRow == -1 ? 0 : tRP) + tRCD + tCL;
+        rowMissStat->addData(1);
+    }
+
+    Cycle_t dataStart = std::max(current + access, busAvail);
+    busAvail = dataStart + tBurst;
+    if (openPage) {
+        bank.openRow = pick->row;
+        bank.busyUntil = busAvail;
+    } else {
+        // precharge right after the access
+        bank.openRow = -1;
+        bank.busyUntil = busAvail + tRP;
+    }
+
+    queueDelayStat->addData(current - pick->arrival);
+    delayLine->send(busAvail - current, pick->event);
+    reqQueue.erase(pick);
+}
+
 
@@ -22,7 +22,10 @@
 #include <sst/core/component.h>
 #include <sst/elements/memHierarchy/memEvent.h>
 
+#include <deque>
+
 #include "globals.h"
+#include "memReqEvent.h"
 
 using namespace std;
 
@@ -47,6 +50,14 @@ public: // functions
                             {"numVaults2",         "Number of bits to determine vault address (i.e. log_2(number of vaults per cube))"},
                             {"VaultID",            "Vault Unique ID (Unique to cube)."},
                             {"debug",              "0 (default): No debugging, 1: STDOUT, 2: STDERR, 3: FILE."},
+                            {"delay",              "Fixed latency added to every request.", "40ns"},
+                            {"banks",              "Number of banks in the vault. 0 (default) only models the fixed delay.", "0"},
+                            {"page_policy",        "Row buffer policy of the banks, 'open' or 'closed'.", "closed"},
+                            {"row_size",           "Bytes per row of a bank.", "2048"},
+                            {"tCL",                "Column access latency in vault cycles.", "11"},
+                            {"tRCD",               "Row activation latency in vault cycles.", "11"},
+                            {"tRP",                "Precharge latency in vault cycles.", "11"},
+                            {"tBurst",             "Vault cycles a request occupies the vault data bus.", "4"},
                            )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -54,7 +65,11 @@ public: // functions
                           )
 
     SST_ELI_DOCUMENT_STATISTICS(
-                                { "Mem_Outstanding", "Number of memory requests outstanding each cycle", "reqs/cycle", 1}
+                                { "Mem_Outstanding", "Number of memory requests outstanding each cycle", "reqs/cycle", 1},
+                                { "Row_Hits", "Number of requests that found their row open (banks > 0)", "reqs", 1},
+                                { "Row_Misses", "Number of requests that had to activate their row (banks > 0)", "reqs", 1},
+                                { "Bank_Conflicts", "Number of requests waiting on a busy bank each cycle (banks > 0)", "reqs/cycle", 2},
+                                { "Queue_Delay", "Cycles a request waited for its bank (banks > 0)", "cycles", 2}
                                )
 
     VaultSim( ComponentId_t id, Params& params );
@@ -66,11 +81,26 @@ private: // types
     typedef SST::Link memChan_t;
     typedef map<unsigned, MemHierarchy::MemEvent*> t2MEMap_t;
 
+    struct bank_t {
+        bank_t() : busyUntil(0), openRow(-1) {}
+        Cycle_t busyUntil;
+        int64_t openRow;    // -1 if precharged
+    };
+
+    struct queuedReq_t {
+        queuedReq_t(MemReqEvent* ev, unsigned b, int64_t r, Cycle_t t) : event(ev), bank(b), row(r), arrival(t) {}
+        MemReqEvent* event;
+        unsigned bank;
+        int64_t row;
+        Cycle_t arrival;
+    };
+
 private: // functions
 
     VaultSim( const VaultSim& c );
 
     bool clock( Cycle_t );
+    void scheduleBanks( Cycle_t );
     Link *delayLine;
     uint8_t *memBuffer;
     memChan_t* m_memChan;
@@ -87,8 +117,21 @@ private: // functions
         return out;
     }
 
+    // bank model, only used if numBanks > 0
+    unsigned numBanks;
+    bool openPage;
+    size_t rowSize;
+    Cycle_t tCL, tRCD, tRP, tBurst;
+    Cycle_t busAvail;   // cycle the vault data bus is free
+    vector<bank_t> banks;
+    deque<queuedReq_t> reqQueue;
+
     // statistics
     Statistic<uint64_t>*  memOutStat;
+    Statistic<uint64_t>*  rowHitStat;
+    Statistic<uint64_t>*  rowMissStat;
+    Statistic<uint64_t>*  bankConflictStat;
+    Statistic<uint64_t>*  queueDelayStat;
 };
 
 }
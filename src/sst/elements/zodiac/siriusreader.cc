@@ -32,7 +32,8 @@ using namespace SST::Zodiac;
 #endif
 
 
-SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t maxQLen, std::queue<ZodiacEvent*>* evQ, int verbose)
+SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t maxQLen, std::queue<ZodiacEvent*>* evQ, int verbose,
+	uint32_t prefetch)
 {
 
 	rank = focusOnRank;
@@ -49,6 +50,17 @@ SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t maxQLen, s
 	prevEventTime = 0;
 	output = new Output("SiriusReader", verbose, 0, Output::STDOUT);
 	readInit();
+
+	ringHead = 0;
+	ringCount = 0;
+	stopPrefetch = false;
+
+	if(prefetch > 0) {
+		// Read the trace in large blocks, the decoder is the only one touching it
+		setvbuf(trace, NULL, _IOFBF, 1024 * 1024);
+		ring.resize(prefetch);
+		prefetcher = std::thread(&SiriusReader::prefetchLoop, this);
+	}
 }
 
 void SiriusReader::close() {
@@ -58,6 +70,15 @@ void SiriusReader::close() {
 		output->verbose(CALL_INFO, 4, 0, "Closing trace file.\n");
 	}
 
+	if(prefetcher.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(ringLock);
+			stopPrefetch = true;
+		}
+		ringNotFull.notify_one();
+		prefetcher.join();
+	}
+
 	fclose(trace);
 }
 
@@ -80,43 +101,138 @@ uint32_t SiriusReader::getCurrentQueueSize() {
 }
 
 void SiriusReader::generateNextEvent() {
-	uint32_t call_type = readUINT32();
-	double callTime = readTime();
-	double evTimeDiff = callTime - prevEventTime;
+	SiriusRecord rec;
+
+	if(ring.empty()) {
+		decodeRecord(rec);
+	} else {
+		takeRecord(rec);
+	}
+
+	buildEvents(rec);
+}
+
+void SiriusReader::prefetchLoop() {
+	bool more = true;
+
+	while(more) {
+		SiriusRecord rec;
+
+		// Nothing follows a finalize, an unknown call stops the replay
+		more = decodeRecord(rec) && (rec.callType != SIRIUS_MPI_FINALIZE);
+
+		std::unique_lock<std::mutex> lock(ringLock);
+		ringNotFull.wait(lock, [this] { return stopPrefetch || ringCount < ring.size(); });
+
+		if(stopPrefetch) {
+			return;
+		}
+
+		ring[(ringHead + ringCount) % ring.size()] = rec;
+		ringCount++;
+		lock.unlock();
+		ringNotEmpty.notify_one();
+	}
+}
+
+void SiriusReader::takeRecord(SiriusRecord& rec) {
+	std::unique_lock<std::mutex> lock(ringLock);
+	ringNotEmpty.wait(lock, [this] { return ringCount > 0; });
+
+	rec = ring[ringHead];
+	ringHead = (ringHead + 1) % ring.size();
+	ringCount--;
+	lock.unlock();
+	ringNotFull.notify_one();
+}
+
+bool SiriusReader::decodeRecord(SiriusRecord& rec) {
+	rec.callType = readUINT32();
+	rec.callTime = readTime();
+
+	switch(rec.callType) {
+	case SIRIUS_MPI_SEND:
+	case SIRIUS_MPI_RECV:
+	case SIRIUS_MPI_IRECV:
+		readUINT64();
+		rec.count = readUINT32();
+		rec.dtype = readUINT32();
+		rec.peer  = readINT32();
+		rec.tag   = readINT32();
+		rec.comm  = readUINT32();
+		rec.req   = (rec.callType == SIRIUS_MPI_IRECV) ? readUINT64() : 0;
+		break;
+
+	case SIRIUS_MPI_ALLREDUCE:
+		readUINT64();
+		readUINT64();
+		rec.count = readUINT32();
+		rec.dtype = readUINT32();
+		rec.op    = readUINT32();
+		rec.comm  = readUINT32();
+		break;
+
+	case SIRIUS_MPI_BARRIER:
+		rec.comm = readUINT32();
+		break;
+
+	case SIRIUS_MPI_WAIT:
+		rec.req = readUINT64();
+		readUINT64();
+		break;
+
+	case SIRIUS_MPI_INIT:
+	case SIRIUS_MPI_FINALIZE:
+		break;
+
+	default:
+		rec.position = ftell(trace);
+		return false;
+	}
+
+	// Read the profiled MPI time
+	rec.mpiTime = readTime();
+	// read the MPI function result
+	readINT32();
+	return true;
+}
+
+void SiriusReader::buildEvents(const SiriusRecord& rec) {
+	double evTimeDiff = rec.callTime - prevEventTime;
 
 	if(evTimeDiff > 0) {
 		output->verbose(__LINE__, __FILE__, "generateNextEvent", 8, 0, "Generated a compute event (length=%f)\n", evTimeDiff);
-		ZodiacComputeEvent* ev = new ZodiacComputeEvent(evTimeDiff);
+		ZodiacComputeEvent* ev = new ZodiacComputeEvent(evTimeDiff, prevEventTime);
 		eventQ->push(ev);
 	} else {
 		output->verbose(__LINE__, __FILE__, "generateNextEvent", 8, 0,
 			"Did not generate next event timing prevTime=%f, callTime=%f, diff=%f\n",
-			prevEventTime, callTime, evTimeDiff);
+			prevEventTime, rec.callTime, evTimeDiff);
 	}
 
-	switch(call_type) {
+	switch(rec.callType) {
 	case SIRIUS_MPI_SEND:
-		readSend();
+		readSend(rec);
 		break;
 
 	case SIRIUS_MPI_RECV:
-		readRecv();
+		readRecv(rec);
 		break;
 
 	case SIRIUS_MPI_IRECV:
-		readIrecv();
+		readIrecv(rec);
 		break;
 
 	case SIRIUS_MPI_ALLREDUCE:
-		readAllreduce();
+		readAllreduce(rec);
 		break;
 
 	case SIRIUS_MPI_BARRIER:
-		readBarrier();
+		readBarrier(rec);
 		break;
 
 	case SIRIUS_MPI_WAIT:
-		readWait();
+		readWait(rec);
 		break;
 
 	case SIRIUS_MPI_INIT:
@@ -128,90 +244,54 @@ void SiriusReader::generateNextEvent() {
 		break;
 
 	default:
-		std::cout << "Unknown MPI command in trace (" << call_type << ") position: " <<
-			ftell(trace) << std::endl;
+		std::cout << "Unknown MPI command in trace (" << rec.callType << ") position: " <<
+			rec.position << std::endl;
 		exit(-1);
 		break;
 	}
 
-
-	// Read the profiled MPI time
-	prevEventTime = readTime();
-	// read the MPI function result
-	readINT32();
+	prevEventTime = rec.mpiTime;
 }
 
-void SiriusReader::readAllreduce() {
-	uint64_t sbuff = readUINT64();
-	uint64_t rbuff = readUINT64();
-	uint32_t length = readUINT32();
-	uint32_t dtype = readUINT32();
-	uint32_t op    = readUINT32();
-	uint32_t comm  = readUINT32();
-
+void SiriusReader::readAllreduce(const SiriusRecord& rec) {
 	output->verbose(__LINE__, __FILE__, "readAllreduce", 8, 0, "Read an MPI_Allreduce\n");
 
 	ZodiacAllreduceEvent* ev = new ZodiacAllreduceEvent(
-			length,
-			convertToHermesType(dtype),
-			convertToHermesOp(op),
-			comm);
+			rec.count,
+			convertToHermesType(rec.dtype),
+			convertToHermesOp(rec.op),
+			rec.comm);
 	eventQ->push(ev);
 }
 
-void SiriusReader::readSend() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  dest   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
-
+void SiriusReader::readSend(const SiriusRecord& rec) {
 	output->verbose(__LINE__, __FILE__, "readSend", 8, 0, "Read an MPI_Send\n");
 
-	ZodiacSendEvent* ev = new ZodiacSendEvent((uint32_t) dest, count,
-		convertToHermesType(dtype), tag, comm);
+	ZodiacSendEvent* ev = new ZodiacSendEvent((uint32_t) rec.peer, rec.count,
+		convertToHermesType(rec.dtype), rec.tag, rec.comm);
 	eventQ->push(ev);
 }
 
-void SiriusReader::readRecv() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  src   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
-
+void SiriusReader::readRecv(const SiriusRecord& rec) {
 	output->verbose(__LINE__, __FILE__, "readRecv", 8, 0, "Read an MPI_Recv\n");
 
-	ZodiacRecvEvent* ev = new ZodiacRecvEvent((uint32_t) src, count,
-		convertToHermesType(dtype), tag, comm);
+	ZodiacRecvEvent* ev = new ZodiacRecvEvent((uint32_t) rec.peer, rec.count,
+		convertToHermesType(rec.dtype), rec.tag, rec.comm);
 	eventQ->push(ev);
 }
 
-void SiriusReader::readIrecv() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  src   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
-	uint64_t req    = readUINT64();
-
+void SiriusReader::readIrecv(const SiriusRecord& rec) {
 	output->verbose(__LINE__, __FILE__, "readIrecv", 8, 0, "Read an MPI_Irecv\n");
 
-	ZodiacIRecvEvent* ev = new ZodiacIRecvEvent((uint32_t) src, count,
-		convertToHermesType(dtype), tag, comm, req);
+	ZodiacIRecvEvent* ev = new ZodiacIRecvEvent((uint32_t) rec.peer, rec.count,
+		convertToHermesType(rec.dtype), rec.tag, rec.comm, rec.req);
 	eventQ->push(ev);
 }
 
-void SiriusReader::readWait() {
-	uint64_t reqID = readUINT64();
-	uint64_t status = readUINT64();
-
+void SiriusReader::readWait(const SiriusRecord& rec) {
 	output->verbose(__LINE__, __FILE__, "readWait", 8, 0, "Read an MPI_Wait\n");
 
-	ZodiacWaitEvent* ev = new ZodiacWaitEvent(reqID);
+	ZodiacWaitEvent* ev = new ZodiacWaitEvent(rec.req);
 	eventQ->push(ev);
 }
 
@@ -230,12 +310,10 @@ void SiriusReader::readFinalize() {
 	foundFinalize = true;
 }
 
-void SiriusReader::readBarrier() {
-	uint32_t comm = readUINT32();
-
+void SiriusReader::readBarrier(const SiriusRecord& rec) {
 	output->verbose(__LINE__, __FILE__, "readRecv", 8, 0, "Read an MPI_Barrier\n");
 
-	ZodiacBarrierEvent* ev = new ZodiacBarrierEvent(comm);
+	ZodiacBarrierEvent* ev = new ZodiacBarrierEvent(rec.comm);
 	eventQ->push(ev);
 }
 
@@ -25,6 +25,10 @@
 #include <string>
 #include <iostream>
 #include <queue>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "sst/core/output.h"
 #include "sst/elements/hermes/msgapi.h"
@@ -49,9 +53,30 @@ using namespace SST::Hermes::MP;
 namespace SST {
 namespace Zodiac {
 
+// The fields of one MPI call as they are stored in a Sirius trace, decoded
+// but not yet turned into Zodiac events
+struct SiriusRecord {
+	uint32_t callType;
+	double   callTime;
+	double   mpiTime;
+	long     position;
+	uint32_t count;
+	uint32_t dtype;
+	uint32_t op;
+	uint32_t comm;
+	int32_t  peer;
+	int32_t  tag;
+	uint64_t req;
+};
+
+// With a prefetch depth the trace is decoded ahead by a thread of its own
+// into a ring of that many records, so the simulation only has to turn the
+// records into events. Events themselves are still created on the
+// simulation thread, they come from the SST core event pools.
 class SiriusReader {
     public:
-	SiriusReader(char* file, uint32_t rank, uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue, int verbose);
+	SiriusReader(char* file, uint32_t rank, uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue, int verbose,
+		uint32_t prefetch = 0);
         void close();
 	void setOutput(Output* oput);
 	uint32_t generateNextEvents();
@@ -68,19 +93,33 @@ class SiriusReader {
 	FILE* trace;
 	double prevEventTime;
 	void generateNextEvent();
+	bool decodeRecord(SiriusRecord& rec);
+	void buildEvents(const SiriusRecord& rec);
 	inline uint32_t readUINT32();
 	inline uint64_t readUINT64();
 	inline double readTime();
 	inline int32_t readINT32();
 	inline int64_t readINT64();
-	void readSend();
-	void readIrecv();
-	void readRecv();
+	void readSend(const SiriusRecord& rec);
+	void readIrecv(const SiriusRecord& rec);
+	void readRecv(const SiriusRecord& rec);
 	void readInit();
 	void readFinalize();
-	void readBarrier();
-	void readWait();
-	void readAllreduce();
+	void readBarrier(const SiriusRecord& rec);
+	void readWait(const SiriusRecord& rec);
+	void readAllreduce(const SiriusRecord& rec);
+
+	void prefetchLoop();
+	void takeRecord(SiriusRecord& rec);
+
+	std::vector<SiriusRecord> ring;
+	uint32_t ringHead;
+	uint32_t ringCount;
+	bool stopPrefetch;
+	std::thread prefetcher;
+	std::mutex ringLock;
+	std::condition_variable ringNotEmpty;
+	std::condition_variable ringNotFull;
 
 	PayloadDataType convertToHermesType(uint32_t dtype);
 	ReductionOperation convertToHermesOp(uint32_t op);
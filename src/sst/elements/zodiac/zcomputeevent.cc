@@ -21,8 +21,9 @@ using namespace SST::Hermes;
 using namespace SST::Zodiac;
 using namespace SST;
 
-ZodiacComputeEvent::ZodiacComputeEvent(double time) {
+ZodiacComputeEvent::ZodiacComputeEvent(double time, double start) {
 	computeTime = time;
+	startTime = start;
 }
 
 ZodiacEventType ZodiacComputeEvent::getEventType() {
@@ -36,3 +37,8 @@ double ZodiacComputeEvent::getComputeDuration() {
 double ZodiacComputeEvent::getComputeDurationNano() {
 	return computeTime * 1000000000.0;
 }
+
+// Trace time, in seconds, at which the compute region began
+double ZodiacComputeEvent::getComputeStart() {
+	return startTime;
+}
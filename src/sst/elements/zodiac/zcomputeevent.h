@@ -27,13 +27,15 @@ namespace Zodiac {
 class ZodiacComputeEvent : public ZodiacEvent{
 
 	public:
-		ZodiacComputeEvent(double timeSeconds);
+		ZodiacComputeEvent(double timeSeconds, double startSeconds = 0.0);
 		double getComputeDuration();
 		double getComputeDurationNano();
+		double getComputeStart();
 		ZodiacEventType getEventType();
 
 	private:
 		double computeTime;
+		double startTime;
 };
 
 }
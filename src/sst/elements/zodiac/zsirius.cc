@@ -18,6 +18,8 @@
 #include "zsirius.h"
 
 #include <assert.h>
+#include <algorithm>
+#include <limits>
 #include <memory>
 
 #include "sst/core/params.h"
@@ -81,6 +83,8 @@ ZodiacSiriusTraceReader::ZodiacSiriusTraceReader(ComponentId_t id, Params& param
     emptyBufferSize = (uint32_t) params.find("buffer", 4096);
     emptyBuffer = (char*) malloc(sizeof(char) * emptyBufferSize);
 
+    prefetchDepth = (uint32_t) params.find("prefetch", 0);
+
     // Make sure we don't stop the simulation until we are ready
     registerAsPrimaryComponent();
     primaryComponentDoNotEndSim();
@@ -88,6 +92,74 @@ ZodiacSiriusTraceReader::ZodiacSiriusTraceReader(ComponentId_t id, Params& param
     // Allow the user to control verbosity from the log file.
     verbosityLevel = params.find("verbose", 2);
     zOut.init("ZSirius", (uint32_t) verbosityLevel, (uint32_t) 1, Output::STDOUT);
+
+    callsiteScale.assign(Z_WAIT + 1, 1.0);
+    std::vector<std::pair<std::string, double> > entries;
+    parseScaleMap(params, "callsite_scale", entries);
+    for(auto& entry : entries) {
+	ZodiacEventType type = Z_SKIP;
+	if(entry.first == "send") type = Z_SEND;
+	else if(entry.first == "recv") type = Z_RECV;
+	else if(entry.first == "irecv") type = Z_IRECV;
+	else if(entry.first == "wait") type = Z_WAIT;
+	else if(entry.first == "allreduce") type = Z_ALLREDUCE;
+	else if(entry.first == "barrier") type = Z_BARRIER;
+	else if(entry.first == "init") type = Z_INIT;
+	else if(entry.first == "finalize") type = Z_FINALIZE;
+	else {
+		zOut.fatal(CALL_INFO, -1, "Error: unknown MPI call '%s' in callsite_scale\n", entry.first.c_str());
+	}
+	callsiteScale[type] = entry.second;
+    }
+
+    entries.clear();
+    parseScaleMap(params, "phase_scale", entries);
+    for(auto& entry : entries) {
+	phaseScale.push_back(std::make_pair(atof(entry.first.c_str()), entry.second));
+    }
+    std::sort(phaseScale.begin(), phaseScale.end());
+
+    memoryBoundFraction = params.find("memory_bound_fraction", 0.0);
+    memoryBandwidthScale = params.find("memory_bandwidth_scale", 1.0);
+    if(memoryBoundFraction < 0.0 || memoryBoundFraction > 1.0 || memoryBandwidthScale <= 0.0) {
+	zOut.fatal(CALL_INFO, -1, "Error: memory_bound_fraction must be in [0, 1] and memory_bandwidth_scale above 0\n");
+    }
+    projectionReport = params.find("projection_report", false);
+}
+
+void ZodiacSiriusTraceReader::parseScaleMap(Params& params, const std::string& name,
+	std::vector<std::pair<std::string, double> >& entries) {
+
+	std::vector<std::string> values;
+	params.find_array<std::string>(name, values);
+
+	for(auto& value : values) {
+		size_t split = value.find(':');
+		if(split == std::string::npos) {
+			zOut.fatal(CALL_INFO, -1, "Error: %s entry '%s' is not of the form key:factor\n",
+				name.c_str(), value.c_str());
+		}
+		double factor = atof(value.c_str() + split + 1);
+		if(factor < 0.0) {
+			zOut.fatal(CALL_INFO, -1, "Error: %s entry '%s' has a negative factor\n",
+				name.c_str(), value.c_str());
+		}
+		entries.push_back(std::make_pair(value.substr(0, split), factor));
+	}
+}
+
+double ZodiacSiriusTraceReader::projectCompute(ZodiacComputeEvent* zCEv, ZodiacEvent* nextEv) {
+	double factor = scaleCompute * callsiteScale[nextEv->getEventType()];
+
+	// The last phase starting at or before the region
+	auto phase = std::upper_bound(phaseScale.begin(), phaseScale.end(),
+		std::make_pair(zCEv->getComputeStart(), std::numeric_limits<double>::max()));
+	if(phase != phaseScale.begin()) {
+		factor *= (phase - 1)->second;
+	}
+
+	return zCEv->getComputeDurationNano() *
+		((1.0 - memoryBoundFraction) * factor + memoryBoundFraction / memoryBandwidthScale);
 }
 
 void ZodiacSiriusTraceReader::setup() {
@@ -102,7 +174,7 @@ void ZodiacSiriusTraceReader::setup() {
     snprintf(trace_name.get(), trace_file.length() + 20, "%s.%d", trace_file.c_str(), rank);
 
     printf("Opening trace file: %s\n", trace_name.get());
-    trace = new SiriusReader(trace_name.get(), rank, 64, eventQ, verbosityLevel);
+    trace = new SiriusReader(trace_name.get(), rank, 64, eventQ, verbosityLevel, prefetchDepth);
     trace->setOutput(&zOut);
 
     int count = trace->generateNextEvents();
@@ -139,6 +211,8 @@ void ZodiacSiriusTraceReader::setup() {
     nanoWait = 0;
     nanoIRecv = 0;
 
+    nanoTracedCompute = 0;
+
     accumulateTimeInto = &nanoCompute;
     nextEventStartTimeNano = 0;
 }
@@ -173,6 +247,21 @@ void ZodiacSiriusTraceReader::finish() {
         zOut.verbose(CALL_INFO, 1, 0, "- Time spend in init:         %" PRIu64 " ns\n", nanoInit);
         zOut.verbose(CALL_INFO, 1, 0, "- Time spend in finalize:     %" PRIu64 " ns\n", nanoFinalize);
 
+	if(projectionReport) {
+		// Blocking receives, waits and barriers spend their time on a partner or request
+		const uint64_t nanoComm = nanoSend + nanoIRecv + nanoAllreduce + nanoInit + nanoFinalize;
+		const uint64_t nanoBlocked = nanoRecv + nanoWait + nanoBarrier;
+		const uint64_t nanoTotal = nanoCompute + nanoComm + nanoBlocked;
+
+		zOut.output("Projected runtime: %" PRIu64 " ns\n", nanoTotal);
+		zOut.output("- Compute:       %" PRIu64 " ns (%.1f%%, traced %" PRIu64 " ns)\n", nanoCompute,
+			nanoTotal > 0 ? 100.0 * nanoCompute / nanoTotal : 0.0, nanoTracedCompute);
+		zOut.output("- Communication: %" PRIu64 " ns (%.1f%%)\n", nanoComm,
+			nanoTotal > 0 ? 100.0 * nanoComm / nanoTotal : 0.0);
+		zOut.output("- Wait:          %" PRIu64 " ns (%.1f%%)\n", nanoBlocked,
+			nanoTotal > 0 ? 100.0 * nanoBlocked / nanoTotal : 0.0);
+	}
+
 	zOut.output("Completed at %" PRIu64 " ns\n", getCurrentSimTimeNano());
 }
 
@@ -431,11 +520,13 @@ void ZodiacSiriusTraceReader::handleComputeEvent(ZodiacEvent* zEv) {
 
 	if(eventQ->size() > 0) {
 		ZodiacEvent* nextEv = eventQ->front();
+		const double projectedNano = projectCompute(zCEv, nextEv);
 		zOut.verbose(__LINE__, __FILE__, "handleComputeEvent",
-			2, 1, "Enqueuing next event at a delay of %f seconds, scaled by %f = %f seconds)\n",
-			zCEv->getComputeDuration(), scaleCompute, scaleCompute * zCEv->getComputeDuration());
+			2, 1, "Enqueuing next event at a delay of %f seconds, projected to %f seconds)\n",
+			zCEv->getComputeDuration(), projectedNano / 1000000000.0);
 		eventQ->pop();
-		selfLink->send(scaleCompute * zCEv->getComputeDurationNano(), tConv, nextEv);
+		nanoTracedCompute += (uint64_t) zCEv->getComputeDurationNano();
+		selfLink->send(projectedNano, tConv, nextEv);
 	} else {
 		zOut.output("No more events to process.\n");
 		std::cout << "ZSirius: Has no more events to process" << std::endl;
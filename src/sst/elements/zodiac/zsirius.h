@@ -60,8 +60,14 @@ public:
 	{ "trace", "Set the trace file to be read in for this end point." },
 	{ "os.module", "Sets the messaging API to use for generation and handling of the message protocol" },
 	{ "scalecompute", "Scale compute event times by a double precision value (allows dilation of times in traces), default is 1.0", "1.0" },
+	{ "callsite_scale", "Array of call:factor entries, further scaling the compute that ends in the given MPI call (send, recv, irecv, wait, allreduce, barrier, init, finalize)", "" },
+	{ "phase_scale", "Array of start:factor entries, further scaling the compute that begins at or after start seconds of trace time, up to the next entry", "" },
+	{ "memory_bound_fraction", "Fraction of each compute region limited by memory bandwidth, which is rescaled by memory_bandwidth_scale instead of the compute factors", "0.0" },
+	{ "memory_bandwidth_scale", "Memory bandwidth of the projected node relative to the traced one", "1.0" },
+	{ "projection_report", "Print the projected runtime split into compute, communication and wait at the end of the run", "false" },
 	{ "verbose", "Sets the verbosity level for the component to output debug/information messages", "0" },
 	{ "buffer", "Sets the size of the buffer to use for message data backing, default is 4096 bytes", "4096" },
+	{ "prefetch", "Number of trace records to decode ahead on a separate thread, 0 decodes the trace on demand", "0" },
     	{ "name","used internally","" },
     	{ "module","used internally","" }
   )
@@ -100,6 +106,8 @@ private:
   bool completedBarrierFunction(int val);
 
   void enqueueNextEvent();
+  void parseScaleMap(Params& params, const std::string& name, std::vector<std::pair<std::string, double> >& entries);
+  double projectCompute(ZodiacComputeEvent* zCEv, ZodiacEvent* nextEv);
 
   ////////////////////////////////////////////////////////
 
@@ -114,6 +122,7 @@ private:
   SST::TimeConverter tConv;
   char* emptyBuffer;
   uint32_t emptyBufferSize;
+  uint32_t prefetchDepth;
 
   DerivedFunctor allreduceFunctor;
   DerivedFunctor barrierFunctor;
@@ -157,6 +166,17 @@ private:
   uint64_t* accumulateTimeInto;
   double scaleCompute;
 
+  // What-if projection of the traced compute onto another node: the compute
+  // bound part of a region is scaled by scaleCompute and the factors for the
+  // call ending it and the phase it starts in, the memory bound part by the
+  // bandwidth ratio
+  std::vector<double> callsiteScale;                   // Indexed by ZodiacEventType
+  std::vector<std::pair<double, double> > phaseScale;  // (start seconds, factor), sorted
+  double memoryBoundFraction;
+  double memoryBandwidthScale;
+  bool projectionReport;
+  uint64_t nanoTracedCompute;
+
   ////////////////////////////////////////////////////////
 
 };